@@ -1,3 +1,4 @@
+#include <FEXCore/Debug/InternalThreadState.h>
 #include <FEXCore/fextl/fmt.h>
 
 #include "Common/JitSymbols.h"
@@ -5,6 +6,85 @@
 #include <fcntl.h>
 #include <unistd.h>
 
+#ifndef _WIN32
+#include <elf.h>
+#include <sys/mman.h>
+#include <time.h>
+
+namespace {
+  // Record layouts from the perf jitdump specification, tools/perf/Documentation/jitdump-specification.txt
+  constexpr uint32_t JITDUMP_MAGIC = 0x4A695444;
+  constexpr uint32_t JITDUMP_VERSION = 1;
+
+  enum JITDumpRecordType : uint32_t {
+    JIT_CODE_LOAD = 0,
+    JIT_CODE_DEBUG_INFO = 2,
+  };
+
+  struct JITDumpHeader {
+    uint32_t Magic;
+    uint32_t Version;
+    uint32_t TotalSize;
+    uint32_t ElfMach;
+    uint32_t Pad1;
+    uint32_t PID;
+    uint64_t Timestamp;
+    uint64_t Flags;
+  };
+
+  struct JITDumpRecordPrefix {
+    uint32_t ID;
+    uint32_t TotalSize;
+    uint64_t Timestamp;
+  };
+
+  struct JITDumpCodeLoad {
+    JITDumpRecordPrefix Prefix;
+    uint32_t PID;
+    uint32_t TID;
+    uint64_t VMA;
+    uint64_t CodeAddr;
+    uint64_t CodeSize;
+    uint64_t CodeIndex;
+    // Followed by the null terminated name then the code bytes
+  };
+
+  struct JITDumpDebugInfo {
+    JITDumpRecordPrefix Prefix;
+    uint64_t CodeAddr;
+    uint64_t NumEntries;
+    // Followed by the entries
+  };
+
+  struct JITDumpDebugEntry {
+    uint64_t Addr;
+    int32_t LineNumber;
+    int32_t Discriminator;
+    // Followed by the null terminated filename
+  };
+
+  // Buffered records are written out once this much is pending
+  constexpr size_t JITDUMP_FLUSH_SIZE = 64 * 1024;
+
+  // perf uses CLOCK_MONOTONIC for jitdump timestamps when recording with `-k mono`
+  uint64_t GetTimestamp() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000ULL + ts.tv_nsec;
+  }
+
+  void Append(fextl::vector<uint8_t> &Buffer, const void *Data, size_t Size) {
+    auto Bytes = reinterpret_cast<const uint8_t*>(Data);
+    Buffer.insert(Buffer.end(), Bytes, Bytes + Size);
+  }
+
+  void AppendString(fextl::vector<uint8_t> &Buffer, std::string_view String) {
+    Append(Buffer, String.data(), String.size());
+    Buffer.push_back(0);
+  }
+}
+#endif
+
 namespace FEXCore {
   JITSymbols::JITSymbols() {
   }
@@ -13,6 +93,16 @@ namespace FEXCore {
     if (fd != -1) {
       close(fd);
     }
+
+#ifndef _WIN32
+    if (DumpFD != -1) {
+      FlushJITDump();
+      if (DumpMarker) {
+        munmap(DumpMarker, sysconf(_SC_PAGESIZE));
+      }
+      close(DumpFD);
+    }
+#endif
   }
 
   void JITSymbols::InitFile() {
@@ -86,4 +176,147 @@ namespace FEXCore {
     }
   }
 
+#ifndef _WIN32
+  void JITSymbols::InitJITDump() {
+#ifdef __ANDROID__
+    const auto DumpFile = fextl::fmt::format("/data/local/tmp/jit-{}.dump", getpid());
+#else
+    const auto DumpFile = fextl::fmt::format("/tmp/jit-{}.dump", getpid());
+#endif
+    DumpFD = open(DumpFile.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0644);
+    if (DumpFD == -1) {
+      return;
+    }
+
+    DumpPID = getpid();
+
+    const JITDumpHeader Header {
+      .Magic = JITDUMP_MAGIC,
+      .Version = JITDUMP_VERSION,
+      .TotalSize = sizeof(JITDumpHeader),
+#ifdef _M_ARM_64
+      .ElfMach = EM_AARCH64,
+#else
+      .ElfMach = EM_X86_64,
+#endif
+      .PID = static_cast<uint32_t>(DumpPID),
+      .Timestamp = GetTimestamp(),
+    };
+
+    if (write(DumpFD, &Header, sizeof(Header)) != sizeof(Header)) {
+      close(DumpFD);
+      DumpFD = -1;
+      return;
+    }
+
+    // perf finds the dump through an executable mapping of it showing up in the trace
+    DumpMarker = mmap(nullptr, sysconf(_SC_PAGESIZE), PROT_READ | PROT_EXEC, MAP_PRIVATE, DumpFD, 0);
+    if (DumpMarker == MAP_FAILED) {
+      DumpMarker = nullptr;
+    }
+
+    DumpBuffer.reserve(JITDUMP_FLUSH_SIZE * 2);
+  }
+
+  void JITSymbols::RegisterJITDump(const void *HostAddr, uint32_t CodeSize, uint64_t GuestAddr,
+                                   const FEXCore::Core::DebugData *DebugData, std::string_view Filename, uint64_t FileStart) {
+    if (DumpFD == -1) return;
+
+    const auto CodeAddr = reinterpret_cast<uint64_t>(HostAddr);
+    const auto Timestamp = GetTimestamp();
+
+    std::scoped_lock lk(DumpMutex);
+
+    // Debug info for a block needs to come before its code load record.
+    // Guest instructions map to their offset in the guest file as the line number
+    if (!Filename.empty() && DebugData && !DebugData->GuestOpcodes.empty()) {
+      const size_t EntrySize = sizeof(JITDumpDebugEntry) + Filename.size() + 1;
+      const JITDumpDebugInfo DebugInfo {
+        .Prefix = {
+          .ID = JIT_CODE_DEBUG_INFO,
+          .TotalSize = static_cast<uint32_t>(sizeof(JITDumpDebugInfo) + EntrySize * DebugData->GuestOpcodes.size()),
+          .Timestamp = Timestamp,
+        },
+        .CodeAddr = CodeAddr,
+        .NumEntries = DebugData->GuestOpcodes.size(),
+      };
+      Append(DumpBuffer, &DebugInfo, sizeof(DebugInfo));
+
+      for (const auto &GuestOpcode : DebugData->GuestOpcodes) {
+        const JITDumpDebugEntry Entry {
+          .Addr = CodeAddr + GuestOpcode.HostEntryOffset,
+          .LineNumber = static_cast<int32_t>(GuestAddr + GuestOpcode.GuestEntryOffset - FileStart),
+        };
+        Append(DumpBuffer, &Entry, sizeof(Entry));
+        AppendString(DumpBuffer, Filename);
+      }
+    }
+
+    const auto Name = Filename.empty() ?
+      fextl::fmt::format("JIT_0x{:x}", GuestAddr) :
+      fextl::fmt::format("{}+0x{:x}", Filename, GuestAddr - FileStart);
+
+    const JITDumpCodeLoad CodeLoad {
+      .Prefix = {
+        .ID = JIT_CODE_LOAD,
+        .TotalSize = static_cast<uint32_t>(sizeof(JITDumpCodeLoad) + Name.size() + 1 + CodeSize),
+        .Timestamp = Timestamp,
+      },
+      .PID = static_cast<uint32_t>(DumpPID),
+      .TID = static_cast<uint32_t>(gettid()),
+      .VMA = CodeAddr,
+      .CodeAddr = CodeAddr,
+      .CodeSize = CodeSize,
+      .CodeIndex = DumpCodeIndex++,
+    };
+    Append(DumpBuffer, &CodeLoad, sizeof(CodeLoad));
+    AppendString(DumpBuffer, Name);
+    // Code bytes let `perf annotate` disassemble the block
+    Append(DumpBuffer, HostAddr, CodeSize);
+
+    if (DumpBuffer.size() >= JITDUMP_FLUSH_SIZE) {
+      FlushJITDumpLocked();
+    }
+  }
+
+  void JITSymbols::FlushJITDump() {
+    std::scoped_lock lk(DumpMutex);
+    FlushJITDumpLocked();
+  }
+
+  void JITSymbols::FlushJITDumpLocked() {
+    if (DumpFD == -1 || DumpBuffer.empty()) return;
+
+    if (getpid() != DumpPID) {
+      // A forked child would otherwise duplicate the parent's pending records in to the parent's dump
+      DumpBuffer.clear();
+      DumpFD = -1;
+      return;
+    }
+
+    size_t Offset = 0;
+    while (Offset < DumpBuffer.size()) {
+      auto Result = write(DumpFD, DumpBuffer.data() + Offset, DumpBuffer.size() - Offset);
+      if (Result == -1) {
+        if (errno == EINTR) {
+          continue;
+        }
+        if (errno == EBADF) {
+          DumpFD = -1;
+        }
+        break;
+      }
+      Offset += Result;
+    }
+
+    DumpBuffer.clear();
+  }
+#else
+  void JITSymbols::InitJITDump() {}
+  void JITSymbols::RegisterJITDump(const void *HostAddr, uint32_t CodeSize, uint64_t GuestAddr,
+                                   const FEXCore::Core::DebugData *DebugData, std::string_view Filename, uint64_t FileStart) {}
+  void JITSymbols::FlushJITDump() {}
+  void JITSymbols::FlushJITDumpLocked() {}
+#endif
+
 } // namespace FEXCore
@@ -1,10 +1,17 @@
 #pragma once
 
+#include <FEXCore/fextl/vector.h>
+
 #include <cstdint>
 #include <cstdio>
 #include <memory>
+#include <mutex>
 #include <string_view>
 
+namespace FEXCore::Core {
+  struct DebugData;
+}
+
 namespace FEXCore {
 class JITSymbols final {
 public:
@@ -18,7 +25,22 @@ public:
   void RegisterNamedRegion(const void *HostAddr, uint32_t CodeSize, std::string_view Name);
   void RegisterJITSpace(const void *HostAddr, uint32_t CodeSize);
 
+  // perf jitdump output, for `perf inject --jit`
+  void InitJITDump();
+  void RegisterJITDump(const void *HostAddr, uint32_t CodeSize, uint64_t GuestAddr,
+                       const FEXCore::Core::DebugData *DebugData, std::string_view Filename, uint64_t FileStart);
+  void FlushJITDump();
+
 private:
   int fd{-1};
+
+  int DumpFD{-1};
+  int DumpPID{};
+  void *DumpMarker{};
+  uint64_t DumpCodeIndex{};
+  fextl::vector<uint8_t> DumpBuffer;
+  std::mutex DumpMutex;
+
+  void FlushJITDumpLocked();
 };
 }
@@ -112,9 +112,10 @@ namespace DefaultValues {
   static fextl::map<FEXCore::Config::LayerType, fextl::unique_ptr<FEXCore::Config::Layer>> ConfigLayers;
   static FEXCore::Config::Layer *Meta{};
 
-  constexpr std::array<FEXCore::Config::LayerType, 9> LoadOrder = {
+  constexpr std::array<FEXCore::Config::LayerType, 10> LoadOrder = {
     FEXCore::Config::LayerType::LAYER_GLOBAL_MAIN,
     FEXCore::Config::LayerType::LAYER_MAIN,
+    FEXCore::Config::LayerType::LAYER_LEARNED_APP,
     FEXCore::Config::LayerType::LAYER_GLOBAL_STEAM_APP,
     FEXCore::Config::LayerType::LAYER_GLOBAL_APP,
     FEXCore::Config::LayerType::LAYER_LOCAL_STEAM_APP,
@@ -422,6 +423,11 @@ namespace DefaultValues {
     ConfigLayers.emplace(_Layer->GetLayerType(), std::move(_Layer));
   }
 
+  void RemoveLayer(LayerType Type) {
+    LOGMAN_THROW_A_FMT(Type != LayerType::LAYER_TOP, "The meta layer can't be removed");
+    ConfigLayers.erase(Type);
+  }
+
   bool Exists(ConfigOption Option) {
     return Meta->OptionExists(Option);
   }
@@ -7,7 +7,9 @@
 #include <FEXCore/Core/CPUID.h>
 #include <FEXCore/Core/SignalDelegator.h>
 #include "FEXCore/Debug/InternalThreadState.h"
+#include <FEXCore/Utils/LogManager.h>
 
+#include <limits>
 #include <string.h>
 #include <utility>
 
@@ -27,10 +29,42 @@ namespace FEXCore::Context {
 
   bool FEXCore::Context::ContextImpl::InitializeContext() {
     // This should be used for generating things that are shared between threads
+    SetupCycleCounter();
     CPUID.Init(this);
     return true;
   }
 
+  void FEXCore::Context::ContextImpl::SetupCycleCounter() {
+    uint64_t HostFrequency = Config.Core == FEXCore::Config::CONFIG_INTERPRETER ?
+      FEXCore::CycleCounter::InterpreterFrequency :
+      FEXCore::CycleCounter::GetHostFrequency();
+    CycleCounterFrequency = HostFrequency;
+
+    const uint64_t GuestFrequency = static_cast<uint64_t>(Config.ScaledTSCFrequency()) * 1'000'000ULL;
+    if (GuestFrequency == 0) {
+      return;
+    }
+
+    if (GuestFrequency > std::numeric_limits<uint32_t>::max()) {
+      // CPUID leaf 15h can't report anything larger
+      LogMan::Msg::EFmt("ScaledTSCFrequency of {}MHz is too large, leaving the cycle counter unscaled", Config.ScaledTSCFrequency());
+      return;
+    }
+
+    if (HostFrequency == 0) {
+      HostFrequency = FEXCore::CycleCounter::CalibrateHostFrequency();
+    }
+
+    if (HostFrequency == 0) {
+      LogMan::Msg::EFmt("Couldn't determine the host cycle counter frequency, leaving the cycle counter unscaled");
+      return;
+    }
+
+    CycleCounterScale = FEXCore::CycleCounter::CalculateScale(HostFrequency, GuestFrequency);
+    CycleCounterFrequency = GuestFrequency;
+    ScaleCycleCounter = true;
+  }
+
   void FEXCore::Context::ContextImpl::SetExitHandler(ExitHandler handler) {
     CustomExitHandler = std::move(handler);
   }
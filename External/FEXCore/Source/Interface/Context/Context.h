@@ -1,7 +1,17 @@
 #pragma once
 
 #include "Common/JitSymbols.h"
+#include "Interface/Core/BlockCorpusRecorder.h"
+#include "Interface/Core/BlockExecutionProfile.h"
+#include "Interface/Core/BlockIRDedupCache.h"
+#include "Interface/Core/RemapIRCache.h"
+#include "Interface/Core/CompileStats.h"
 #include "Interface/Core/CPUID.h"
+#include "Interface/Core/CycleCounter.h"
+#include "Interface/Core/FallbackProfile.h"
+#ifndef _WIN32
+#include "Interface/Core/NUMA.h"
+#endif
 #include "Interface/Core/X86HelperGen.h"
 #include "Interface/Core/ObjectCache/ObjectCacheService.h"
 #include "Interface/Core/Dispatcher/Dispatcher.h"
@@ -12,9 +22,12 @@
 #include <FEXCore/Core/HostFeatures.h>
 #include <FEXCore/Core/SignalDelegator.h>
 #include <FEXCore/Debug/InternalThreadState.h>
+#include <FEXCore/IR/IR.h>
 #include <FEXCore/Utils/CompilerDefs.h>
 #include <FEXCore/Utils/DeferredSignalMutex.h>
 #include <FEXCore/Utils/Event.h>
+#include <FEXCore/Utils/Telemetry.h>
+#include <FEXCore/fextl/deque.h>
 #include <FEXCore/fextl/memory.h>
 #include <FEXCore/fextl/set.h>
 #include <FEXCore/fextl/string.h>
@@ -23,6 +36,7 @@
 #include <FEXHeaderUtils/Syscalls.h>
 #include <stdint.h>
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <functional>
@@ -30,6 +44,7 @@
 #include <memory>
 #include <mutex>
 #include <shared_mutex>
+#include <span>
 #include <stddef.h>
 #include <queue>
 
@@ -37,6 +52,7 @@ namespace FEXCore {
 class CodeLoader;
 class ThunkHandler;
 class GdbServer;
+struct BlockDelinkedRange;
 
 namespace CodeSerialize {
   class CodeObjectSerializeService;
@@ -65,11 +81,6 @@ namespace Validation {
 }
 
 namespace FEXCore::Context {
-  enum CoreRunningMode {
-    MODE_RUN        = 0,
-    MODE_SINGLESTEP = 1,
-  };
-
   class ContextImpl final : public FEXCore::Context::Context {
     public:
       // Context base class implementation.
@@ -86,6 +97,7 @@ namespace FEXCore::Context {
       void Step() override;
 
       ExitReason RunUntilExit() override;
+      void DumpProfiles() override;
 
       void ExecuteThread(FEXCore::Core::InternalThreadState *Thread) override;
 
@@ -107,6 +119,8 @@ namespace FEXCore::Context {
       void HandleCallback(FEXCore::Core::InternalThreadState *Thread, uint64_t RIP) override;
 
       uint64_t RestoreRIPFromHostPC(FEXCore::Core::InternalThreadState *Thread, uint64_t HostPC) override;
+      uint32_t ReconstructCompactedEFLAGS(const FEXCore::Core::CPUState *State) const override;
+      void SetFlagsFromCompactedEFLAGS(FEXCore::Core::CPUState *State, uint32_t EFLAGS) const override;
 
       /**
        * @brief Used to create FEX thread objects in preparation for creating a true OS thread. Does set a TID or PID.
@@ -169,6 +183,9 @@ namespace FEXCore::Context {
       FEXCore::IR::AOTIRCacheEntry *LoadAOTIRCacheEntry(const fextl::string& Name) override;
       void UnloadAOTIRCacheEntry(FEXCore::IR::AOTIRCacheEntry *Entry) override;
 
+      void AddNamedRegion(uintptr_t Base, uintptr_t Size, uintptr_t Offset, const fextl::string &Filename) override;
+      void RemoveNamedRegion(uintptr_t Base, uintptr_t Size) override;
+
       void SetAOTIRLoader(AOTIRLoaderCBFn CacheReader) override {
         IRCaptureCache.SetAOTIRLoader(std::move(CacheReader));
       }
@@ -178,6 +195,19 @@ namespace FEXCore::Context {
       void SetAOTIRRenamer(AOTIRRenamerCBFn CacheRenamer) override {
         IRCaptureCache.SetAOTIRRenamer(std::move(CacheRenamer));
       }
+      void SetCodeObjectFileOpener(CodeObjectFileOpenerCBFn Opener) override {
+        CodeObjectFileOpener = std::move(Opener);
+      }
+      CodeObjectFileOpenerCBFn const &GetCodeObjectFileOpener() const {
+        return CodeObjectFileOpener;
+      }
+
+      void LoadAOTIRBundle(const fextl::string &Filename) override {
+        IRCaptureCache.LoadAOTIRBundle(Filename);
+      }
+      void WriteAOTIRBundle(const fextl::string &Filename) override {
+        IRCaptureCache.WriteAOTIRBundle(Filename);
+      }
 
       void FinalizeAOTIRCache() override {
         IRCaptureCache.FinalizeAOTIRCache();
@@ -187,9 +217,13 @@ namespace FEXCore::Context {
       }
       void InvalidateGuestCodeRange(FEXCore::Core::InternalThreadState *Thread, uint64_t Start, uint64_t Length) override;
       void InvalidateGuestCodeRange(FEXCore::Core::InternalThreadState *Thread, uint64_t Start, uint64_t Length, CodeRangeInvalidationFn callback) override;
+      void SuspendGuestCodeRange(FEXCore::Core::InternalThreadState *Thread, uint64_t Start, uint64_t Length) override;
+      void SuspendGuestCodeRange(FEXCore::Core::InternalThreadState *Thread, uint64_t Start, uint64_t Length, CodeRangeInvalidationFn callback) override;
+      void SuspendGuestCodeRanges(FEXCore::Core::InternalThreadState *Thread, const fextl::vector<CodeRange> &Ranges, std::function<void()> CallAfter) override;
+      void MigrateGuestCodeRange(uint64_t OldStart, uint64_t NewStart, uint64_t Length) override;
       void MarkMemoryShared() override;
 
-      void ConfigureAOTGen(FEXCore::Core::InternalThreadState *Thread, fextl::set<uint64_t> *ExternalBranches, uint64_t SectionMaxAddress) override;
+      void ConfigureAOTGen(FEXCore::Core::InternalThreadState *Thread, fextl::set<uint64_t> *ExternalBranches, uint64_t SectionMaxAddress, AOTGenStats *Stats) override;
       // returns false if a handler was already registered
       CustomIRResult AddCustomIREntrypoint(uintptr_t Entrypoint, CustomIREntrypointHandler Handler, void *Creator = nullptr, void *Data = nullptr) override;
 
@@ -208,26 +242,52 @@ namespace FEXCore::Context {
     friend class FEXCore::IR::Validation::IRValidation;
 
     struct {
-      CoreRunningMode RunningMode {CoreRunningMode::MODE_RUN};
       uint64_t VirtualMemSize{1ULL << 36};
 
       // this is for internal use
       bool ValidateIRarser { false };
 
       FEX_CONFIG_OPT(Multiblock, MULTIBLOCK);
+      FEX_CONFIG_OPT(ReturnStackBuffer, RETURNSTACKBUFFER);
+      FEX_CONFIG_OPT(MultiblockInlineCalls, MULTIBLOCKINLINECALLS);
       FEX_CONFIG_OPT(SingleStepConfig, SINGLESTEP);
       FEX_CONFIG_OPT(GdbServer, GDBSERVER);
       FEX_CONFIG_OPT(Is64BitMode, IS64BIT_MODE);
       FEX_CONFIG_OPT(TSOEnabled, TSOENABLED);
       FEX_CONFIG_OPT(TSOAutoMigration, TSOAUTOMIGRATION);
+      FEX_CONFIG_OPT(TSOFramePointerRelaxed, TSOFRAMEPOINTERRELAXED);
       FEX_CONFIG_OPT(ABILocalFlags, ABILOCALFLAGS);
       FEX_CONFIG_OPT(ABINoPF, ABINOPF);
       FEX_CONFIG_OPT(AOTIRCapture, AOTIRCAPTURE);
       FEX_CONFIG_OPT(AOTIRGenerate, AOTIRGENERATE);
       FEX_CONFIG_OPT(AOTIRLoad, AOTIRLOAD);
+      FEX_CONFIG_OPT(AOTIRHostCode, AOTIRHOSTCODE);
       FEX_CONFIG_OPT(SMCChecks, SMCCHECKS);
+      FEX_CONFIG_OPT(SMCRevalidateBlocks, SMCREVALIDATEBLOCKS);
       FEX_CONFIG_OPT(Core, CORE);
       FEX_CONFIG_OPT(MaxInstPerBlock, MAXINST);
+      FEX_CONFIG_OPT(DecodeCache, DECODECACHE);
+      FEX_CONFIG_OPT(SharedCodeCache, SHAREDCODECACHE);
+      FEX_CONFIG_OPT(IndirectBranchCache, INDIRECTBRANCHCACHE);
+      FEX_CONFIG_OPT(JITHugePages, JITHUGEPAGES);
+      FEX_CONFIG_OPT(NUMAPlacement, NUMAPLACEMENT);
+      FEX_CONFIG_OPT(JITCodeEviction, JITCODEEVICTION);
+      FEX_CONFIG_OPT(SealCodeOnFork, SEALCODEONFORK);
+      FEX_CONFIG_OPT(TieredCompilation, TIEREDCOMPILATION);
+      FEX_CONFIG_OPT(TierUpThreshold, TIERUPTHRESHOLD);
+      FEX_CONFIG_OPT(HotCodeLayout, HOTCODELAYOUT);
+      FEX_CONFIG_OPT(DedupBlockIR, DEDUPBLOCKIR);
+      FEX_CONFIG_OPT(RemapIRCacheSize, REMAPIRCACHESIZE);
+      FEX_CONFIG_OPT(StackMemoryForwarding, STACKMEMORYFORWARDING);
+      FEX_CONFIG_OPT(GOTLinking, GOTLINKING);
+      FEX_CONFIG_OPT(Safepoints, SAFEPOINTS);
+      FEX_CONFIG_OPT(RegisterAllocator, REGISTERALLOCATOR);
+      FEX_CONFIG_OPT(ProfileBlockExecution, PROFILEBLOCKEXECUTION);
+      FEX_CONFIG_OPT(ProfileBlockExecutionTopN, PROFILEBLOCKEXECUTIONTOPN);
+      FEX_CONFIG_OPT(ProfileCompilation, PROFILECOMPILATION);
+      FEX_CONFIG_OPT(ProfileFallbacks, PROFILEFALLBACKS);
+      FEX_CONFIG_OPT(ProfileFallbacksFile, PROFILEFALLBACKSFILE);
+      FEX_CONFIG_OPT(RecordBlockCorpus, RECORDBLOCKCORPUS);
       FEX_CONFIG_OPT(RootFSPath, ROOTFS);
       FEX_CONFIG_OPT(ThunkHostLibsPath, THUNKHOSTLIBS);
       FEX_CONFIG_OPT(ThunkHostLibsPath32, THUNKHOSTLIBS32);
@@ -236,10 +296,15 @@ namespace FEXCore::Context {
       FEX_CONFIG_OPT(GlobalJITNaming, GLOBALJITNAMING);
       FEX_CONFIG_OPT(LibraryJITNaming, LIBRARYJITNAMING);
       FEX_CONFIG_OPT(BlockJITNaming, BLOCKJITNAMING);
+      FEX_CONFIG_OPT(JITDump, JITDUMP);
       FEX_CONFIG_OPT(GDBSymbols, GDBSYMBOLS);
+      FEX_CONFIG_OPT(RetainBlockIR, RETAINBLOCKIR);
       FEX_CONFIG_OPT(ParanoidTSO, PARANOIDTSO);
       FEX_CONFIG_OPT(CacheObjectCodeCompilation, CACHEOBJECTCODECOMPILATION);
       FEX_CONFIG_OPT(x87ReducedPrecision, X87REDUCEDPRECISION);
+      FEX_CONFIG_OPT(x87AdaptivePrecision, X87ADAPTIVEPRECISION);
+      FEX_CONFIG_OPT(ScaledTSCFrequency, SCALEDTSCFREQUENCY);
+      FEX_CONFIG_OPT(SpinLoopWait, SPINLOOPWAIT);
     } Config;
 
     FEXCore::HostFeatures HostFeatures;
@@ -259,12 +324,95 @@ namespace FEXCore::Context {
 
     FEXCore::ForkableSharedMutex CodeInvalidationMutex;
 
+    // Guest ranges of the most recent invalidations, only accessed with CodeInvalidationMutex held.
+    // CodeInvalidationEpoch counts every invalidation, range N lives at N % size.
+    struct InvalidatedCodeRange {
+      uint64_t Start;
+      uint64_t End;
+    };
+    std::array<InvalidatedCodeRange, 64> RecentCodeInvalidations{};
+    uint64_t CodeInvalidationEpoch{};
+
     FEXCore::CPUIDEmu CPUID;
+
+    // Frequency in Hz of the TSC the guest reads, 0 if unknown. Also reported through CPUID.
+    uint64_t CycleCounterFrequency{};
+    // Set when ScaledTSCFrequency is enabled, backends then apply CycleCounterScale to the host counter
+    bool ScaleCycleCounter{};
+    FEXCore::CycleCounter::Scale CycleCounterScale{};
     FEXCore::HLE::SyscallHandler *SyscallHandler{};
     FEXCore::HLE::SourcecodeResolver *SourcecodeResolver{};
     fextl::unique_ptr<FEXCore::ThunkHandler> ThunkHandler;
     fextl::unique_ptr<FEXCore::CPU::Dispatcher> Dispatcher;
 
+    // Process-wide lookup cache and code arena, only allocated when SharedCodeCache is enabled.
+    // Every thread's LookupCache points at SharedLookupCache in that case.
+    fextl::unique_ptr<FEXCore::LookupCache> SharedLookupCache;
+    fextl::unique_ptr<FEXCore::CPU::CPUBackend::SharedCodeArena> SharedCodeArena;
+    bool IsCodeCacheShared() const { return SharedLookupCache != nullptr; }
+
+#ifndef _WIN32
+    // Only allocated when NUMAPlacement is enabled
+    fextl::unique_ptr<FEXCore::NUMA::Placement> ThreadPlacement;
+    // Pins the calling guest thread to a node and moves its structures there
+    void PlaceThreadOnNUMANode(FEXCore::Core::InternalThreadState *Thread);
+#endif
+
+    // Compiler state of exited threads, handed to the next thread that gets created.
+    // Saves rebuilding the pass managers, backend, code buffers and lookup cache on every guest clone.
+    // Protected by ThreadCreationMutex.
+    struct RecycledCompilerState {
+      fextl::unique_ptr<FEXCore::IR::OpDispatchBuilder> OpDispatcher;
+      fextl::unique_ptr<FEXCore::CPU::CPUBackend> CPUBackend;
+      fextl::unique_ptr<FEXCore::LookupCache> LocalLookupCache;
+      fextl::unique_ptr<FEXCore::Frontend::Decoder> FrontendDecoder;
+      fextl::unique_ptr<FEXCore::IR::PassManager> PassManager;
+      fextl::unique_ptr<FEXCore::IR::PassManager> Tier0PassManager;
+      FEXCore::Core::JITPointers Pointers;
+    };
+    static constexpr size_t MaxRecycledCompilerStates = 16;
+    fextl::vector<RecycledCompilerState> RecycledCompilerStates;
+
+    // Tiered compilation
+    // Executions of each guest block before it gets recompiled with the full pass pipeline.
+    // Tier 0 code increments these atomically in place, so counters live in a deque and never move.
+    // Invalidation erases the entries of the invalidated blocks and recycles their counters.
+    std::mutex TierUpCountersMutex;
+    fextl::unordered_map<uint64_t, uint32_t*> TierUpCounters;
+    fextl::deque<uint32_t> TierUpCounterStorage;
+    fextl::vector<uint32_t*> FreeTierUpCounters;
+    bool IsTieredCompilationEnabled() const { return Config.TieredCompilation && Config.Core == FEXCore::Config::CONFIG_IRJIT; }
+    // Returns the counter for the block if it should be compiled as tier 0, nullptr if it is hot
+    uint32_t *GetTier0Counter(uint64_t GuestRIP);
+    void EraseTierUpCounters(const fextl::vector<uint64_t> &Blocks);
+
+    // Only allocated when ProfileBlockExecution is enabled
+    fextl::unique_ptr<FEXCore::BlockExecutionProfile> BlockProfile;
+
+    // Only allocated when DedupBlockIR is enabled
+    fextl::unique_ptr<FEXCore::BlockIRDedupCache> IRDedupCache;
+    // Only allocated when RemapIRCacheSize is set
+    fextl::unique_ptr<FEXCore::RemapIRCache> RemapCache;
+    uint64_t *GetBlockProfileCounter(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP);
+
+    // Only allocated when ProfileCompilation is enabled
+    fextl::unique_ptr<FEXCore::CompileStats> CompileProfile;
+    struct CompileStageStats {
+      FEXCore::CompileStats::Stat *Frontend;
+      FEXCore::CompileStats::Stat *OpDispatcher;
+      FEXCore::CompileStats::Stat *Codegen;
+    };
+    // Indexed by whether the block is compiled as tier 0, all nullptr without a CompileProfile
+    std::array<CompileStageStats, 2> CompileStages {};
+
+    // Only allocated when ProfileFallbacks is enabled
+    fextl::unique_ptr<FEXCore::FallbackProfile> FallbackProfile;
+    // Called by the JIT backends when emitting a fallback for the guest instruction at GuestRIP
+    uint64_t *GetFallbackProfileCounter(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP, uint32_t HandlerIndex, FEXCore::IR::IROps Op);
+
+    // Only allocated when RecordBlockCorpus is set
+    fextl::unique_ptr<FEXCore::BlockCorpusRecorder> BlockCorpus;
+
     CustomCPUFactoryType CustomCPUFactory;
     FEXCore::Context::ExitHandler CustomExitHandler;
 
@@ -288,12 +436,54 @@ namespace FEXCore::Context {
     void StartGdbServer();
     void StopGdbServer();
 
+    /**
+     * @name GDB run control
+     *
+     * With the gdb server enabled every block entry checks its thread's CpuStateFrame::GdbStop.
+     * This lets the debugger stop, step and resume threads individually.
+     * @{ */
+    /**
+     * @brief Adds or removes a breakpoint
+     *
+     * Breakpoints are compiled in to the entry check of the block starting at the address.
+     * Blocks around the address are invalidated so they get split there.
+     */
+    void SetGdbBreakpoint(uint64_t Address, bool Set);
+    bool IsGdbBreakpoint(uint64_t Address) {
+      if (NumGdbBreakpoints.load(std::memory_order_relaxed) == 0) {
+        return false;
+      }
+      std::lock_guard lk(GdbBreakpointMutex);
+      return GdbBreakpoints.contains(Address);
+    }
+
+    /**
+     * @brief Compiles a single instruction block for a stepping thread
+     *
+     * These live in a per thread table and are never added to the lookup cache,
+     * so stepping doesn't disturb the blocks everything else runs.
+     */
+    uintptr_t CompileDebugStepBlock(FEXCore::Core::CpuStateFrame *Frame, uint64_t GuestRIP);
+
+    /**
+     * @brief Wakes a single thread that was stopped by the debugger
+     *
+     * @param Step - Stop again after one instruction.
+     * A thread that was paused outside of a block entry stops at its next block entry instead.
+     */
+    void ResumeGdbThread(FEXCore::Core::InternalThreadState *Thread, bool Step);
+
+    // Called by a thread that is about to sleep at a block entry
+    void ReportGdbStop(FEXCore::Core::InternalThreadState *Thread);
+    /**  @} */
+
     static void ThreadRemoveCodeEntry(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP);
-    static void ThreadAddBlockLink(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestDestination, uintptr_t HostLink, const std::function<void()> &delinker);
+    static void ThreadAddBlockLink(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestDestination, uintptr_t HostLink, FEXCore::BlockDelinkedRange (*Delinker)(uintptr_t HostLink, uintptr_t Data), uintptr_t Data);
 
     template<auto Fn>
     static uint64_t ThreadExitFunctionLink(FEXCore::Core::CpuStateFrame *Frame, uint64_t *record) {
       auto Thread = Frame->Thread;
+      FEXCORE_TELEMETRY_COUNTER_INC(COUNTER_DISPATCHER_EXITS);
       ScopedDeferredSignalWithForkableSharedLock lk(static_cast<ContextImpl*>(Thread->CTX)->CodeInvalidationMutex, Thread);
 
       return Fn(Frame, record);
@@ -307,6 +497,8 @@ namespace FEXCore::Context {
       LogMan::Throw::AFmt(Thread->ThreadManager.GetTID() == FHU::Syscalls::gettid(), "Must be called from owning thread {}, not {}", Thread->ThreadManager.GetTID(), FHU::Syscalls::gettid());
       ScopedDeferredSignalWithForkableUniqueLock lk(static_cast<ContextImpl*>(Thread->CTX)->CodeInvalidationMutex, Thread);
 
+      // Inline SMC checks call this when a block's guest code no longer matches
+      FEXCORE_TELEMETRY_COUNTER_INC(COUNTER_SMC_INVALIDATIONS);
       ThreadRemoveCodeEntry(Thread, GuestRIP);
     }
 
@@ -320,19 +512,68 @@ namespace FEXCore::Context {
       uint64_t StartAddr;
       uint64_t Length;
     };
-    [[nodiscard]] GenerateIRResult GenerateIR(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP, bool ExtendedDebugInfo);
+    /**
+     * @param Tier0Counter - When not null the block is generated as tier 0, counting down Tier0Counter on entry
+     * @param ProfileCounter - When not null the block increments ProfileCounter on entry
+     * @param DebugStep - Decode a single instruction for gdb stepping
+     */
+    [[nodiscard]] GenerateIRResult GenerateIR(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP, bool ExtendedDebugInfo, uint32_t *Tier0Counter = nullptr, uint64_t *ProfileCounter = nullptr, bool DebugStep = false);
+
+    struct FetchOrGenerateIRResult {
+      FEXCore::IR::IRListView* IRList;
+      FEXCore::Core::DebugData* DebugData;
+      FEXCore::IR::RegisterAllocationData::UniquePtr RAData;
+      bool GeneratedIR;
+      uint64_t StartAddr;
+      uint64_t Length;
+      bool Uncacheable;
+      bool Tier0;
+      bool HotBlock;
+    };
+    /**
+     * @brief Fetches the block's IR from the AOT IR cache or generates it
+     *
+     * Only reads guest memory and thread local compiler state, so doesn't need CodeInvalidationMutex held.
+     */
+    [[nodiscard]] FetchOrGenerateIRResult FetchOrGenerateIR(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP, bool DebugStep);
 
     struct CompileCodeResult {
-      void* CompiledCode;
+      FEXCore::CPU::CPUBackend::CompiledCode CompiledCode;
       FEXCore::IR::IRListView* IRData;
       FEXCore::Core::DebugData* DebugData;
       FEXCore::IR::RegisterAllocationData::UniquePtr RAData;
       bool GeneratedIR;
       uint64_t StartAddr;
       uint64_t Length;
+      // Tier 0 and profiled code embed host pointers and must not end up in any persistent cache
+      bool Uncacheable;
     };
-    [[nodiscard]] CompileCodeResult CompileCode(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP);
+    /**
+     * @param DebugStep - Compile a single instruction block for gdb stepping, bypassing every cache
+     * @param PendingIR - IR that was already generated for the block, skips the object cache
+     */
+    [[nodiscard]] CompileCodeResult CompileCode(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP, bool DebugStep = false, FetchOrGenerateIRResult *PendingIR = nullptr);
     uintptr_t CompileBlock(FEXCore::Core::CpuStateFrame *Frame, uint64_t GuestRIP);
+    // If an invalidation since Epoch overlapped the guest range, CodeInvalidationMutex must be held
+    bool IsCodeInvalidatedSince(uint64_t Epoch, uint64_t Start, uint64_t Length) const;
+    // Maps a block suspended by SuspendGuestCodeRange again if its guest code is unchanged, CodeInvalidationMutex must be held.
+    // Returns zero if there is no such block.
+    uintptr_t ReinstateSuspectBlock(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP);
+    // Registers and protects the guest range of a block whose host code didn't come from the frontend, then checks
+    // the guest code still hashes the same. CodeInvalidationMutex must be held.
+    // Returns false if the code changed or its pages need inline SMC checks, the block must be compiled again then.
+    bool ProtectCachedBlockRange(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP, uint64_t Start, uint64_t Length,
+                                 uint64_t Hash, bool Reinstated = false);
+    // Suspended blocks rely on their pages being protected again before their code is checked
+    bool CanSuspendBlocks() const {
+      return Config.SMCRevalidateBlocks &&
+        (Config.SMCChecks == FEXCore::Config::CONFIG_SMC_MTRACK || Config.SMCChecks == FEXCore::Config::CONFIG_SMC_HYBRID);
+    }
+
+    // Gives back the L1 and L2 memory of threads that have stopped compiling or missing in their lookup cache.
+    // Checked at most once per interval, Now is in CompileStats::GetTime nanoseconds.
+    void ReleaseIdleLookupCaches(uint64_t Now);
+    std::atomic<uint64_t> NextLookupCacheIdleCheck{};
 
     // same as CompileBlock, but aborts on failure
     void CompileBlockJit(FEXCore::Core::CpuStateFrame *Frame, uint64_t GuestRIP);
@@ -372,6 +613,8 @@ namespace FEXCore::Context {
 
     // If Atomic-based TSO emulation is enabled or not.
     bool IsAtomicTSOEnabled() const { return AtomicTSOEmulationEnabled; }
+    // If threads run with the host's TSO memory model, which makes every load and store TSO without emulation
+    bool IsHardwareTSOEnabled() const { return SupportsHardwareTSO; }
 
     void SetHardwareTSOSupport(bool HardwareTSOSupported) override {
       SupportsHardwareTSO = HardwareTSOSupported;
@@ -386,6 +629,11 @@ namespace FEXCore::Context {
 
   protected:
     void ClearCodeCache(FEXCore::Core::InternalThreadState *Thread);
+    // Removes every block whose host code starts in [Begin, End) so the range can be reused
+    void EvictCodeRange(FEXCore::Core::InternalThreadState *Thread, uintptr_t Begin, uintptr_t End);
+    // Sums the execution counters of the blocks whose host code starts in each of the RegionSize sized regions from Begin.
+    // Counters come from tiered compilation and the block execution profile, blocks without either count as never executed.
+    void GetCodeRegionHeat(FEXCore::Core::InternalThreadState *Thread, uintptr_t Begin, size_t RegionSize, std::span<uint64_t> Heat);
 
     void UpdateAtomicTSOEmulationConfig() {
       if (SupportsHardwareTSO) {
@@ -399,6 +647,13 @@ namespace FEXCore::Context {
     }
 
   private:
+    /**
+     * @brief Sets up the guest TSC frequency and the scale from the host counter when ScaledTSCFrequency is enabled
+     *
+     * Must run before CPUID is initialized, CPUID reports CycleCounterFrequency
+     */
+    void SetupCycleCounter();
+
     /**
      * @brief Does some final thread initialization
      *
@@ -417,18 +672,37 @@ namespace FEXCore::Context {
      */
     void InitializeCompiler(FEXCore::Core::InternalThreadState* Thread);
 
+    /**
+     * @brief Gives the thread the compiler state of a previously exited thread
+     *
+     * @return false if there was nothing to recycle and InitializeCompiler needs to be used instead
+     */
+    bool AdoptRecycledCompilerState(FEXCore::Core::InternalThreadState* Thread);
+
+    /**
+     * @brief Keeps the compiler state of an exiting thread around for AdoptRecycledCompilerState
+     */
+    void RecycleCompilerState(FEXCore::Core::InternalThreadState* Thread);
+
     void WaitForIdleWithTimeout();
 
     void NotifyPause();
 
-    void AddBlockMapping(FEXCore::Core::InternalThreadState *Thread, uint64_t Address, void *Ptr);
+    uintptr_t AddBlockMapping(FEXCore::Core::InternalThreadState *Thread, uint64_t Address, void *Ptr);
 
     // Entry Cache
     std::mutex ExitMutex;
     fextl::unique_ptr<GdbServer> DebugServer;
 
+    std::mutex GdbBreakpointMutex;
+    fextl::set<uint64_t> GdbBreakpoints;
+    // Lets block compilation skip the lock while no breakpoints are set
+    std::atomic<size_t> NumGdbBreakpoints{};
+
     IR::AOTIRCaptureCache IRCaptureCache;
     fextl::unique_ptr<FEXCore::CodeSerialize::CodeObjectSerializeService> CodeObjectCacheService;
+    // Set before any named region is added, only read by the object cache thread after that
+    CodeObjectFileOpenerCBFn CodeObjectFileOpener;
 
     bool StartPaused = false;
     bool IsMemoryShared = false;
@@ -15,6 +15,7 @@
 #include <cpu-features.h>
 #include <utils-vixl.h>
 
+#include <algorithm>
 #include <array>
 #include <tuple>
 #include <utility>
@@ -201,7 +202,7 @@ void Arm64Emitter::LoadConstant(ARMEmitter::Size s, ARMEmitter::Register Reg, ui
     movn(s, Reg, (~Constant) & 0xFFFF);
 
     if (NOPPad) {
-      nop(); nop(); nop();
+      nop(3);
     }
     return;
   }
@@ -218,7 +219,7 @@ void Arm64Emitter::LoadConstant(ARMEmitter::Size s, ARMEmitter::Register Reg, ui
   if (IsImm) {
     orr(s, Reg, ARMEmitter::Reg::zr, Constant);
     if (NOPPad) {
-      nop(); nop(); nop();
+      nop(3);
     }
     return;
   }
@@ -278,11 +279,46 @@ void Arm64Emitter::LoadConstant(ARMEmitter::Size s, ARMEmitter::Register Reg, ui
     }
   }
 
-  if (NOPPad) {
-    for (int i = NumMoves; i < Segments; ++i) {
-      nop();
+  if (NOPPad && NumMoves < Segments) {
+    nop(Segments - NumMoves);
+  }
+}
+
+int Arm64Emitter::LoadConstantInstructionCount(uint64_t Constant) const {
+  if (((~Constant)>> 16) == 0) {
+    // movn
+    return 1;
+  }
+
+  const bool Is64Bit = (Constant >> 32) != 0;
+  const int Segments = Is64Bit ? 4 : 2;
+
+  if (vixl::aarch64::Assembler::IsImmLogical(Constant, Is64Bit ? 64 : 32)) {
+    // orr
+    return 1;
+  }
+
+  int NumMoves = 1;
+  int RequiredMoveSegments{};
+  for (size_t i = 0; i < Segments; ++i) {
+    uint16_t Part = (Constant >> (i * 16)) & 0xFFFF;
+    if (Part != 0) {
+      ++RequiredMoveSegments;
+      if (i != 0) {
+        ++NumMoves;
+      }
     }
   }
+
+  const uint64_t AlignedPC = GetCursorAddress<uint64_t>() & ~0xFFFULL;
+  const int64_t AlignedOffset = static_cast<int64_t>(Constant) - static_cast<int64_t>(AlignedPC);
+  if (RequiredMoveSegments > 1 && vixl::IsInt32(AlignedOffset)) {
+    // adr, adrp or adrp+add
+    return std::min(NumMoves, 2);
+  }
+
+  // movz+movk
+  return NumMoves;
 }
 
 void Arm64Emitter::PushCalleeSavedRegisters() {
@@ -387,7 +423,7 @@ void Arm64Emitter::SpillStaticRegs(FEXCore::ARMEmitter::Register TmpReg, bool FP
   }
 
   if (FPRs) {
-    if (EmitterCTX->HostFeatures.SupportsAVX) {
+    if (EmitterCTX->HostFeatures.SupportsSVE256) {
       for (size_t i = 0; i < StaticFPRegisters.size(); i++) {
         const auto Reg = StaticFPRegisters[i];
 
@@ -396,6 +432,15 @@ void Arm64Emitter::SpillStaticRegs(FEXCore::ARMEmitter::Register TmpReg, bool FP
           st1b<ARMEmitter::SubRegSize::i8Bit>(Reg.Z(), PRED_TMP_32B, STATE.R(), TMP4.R());
         }
       }
+    } else if (EmitterCTX->HostFeatures.SupportsAVX) {
+      // Split AVX, the static registers only hold the lower halves
+      for (size_t i = 0; i < StaticFPRegisters.size(); i++) {
+        const auto Reg = StaticFPRegisters[i];
+
+        if (((1U << Reg.Idx()) & FPRSpillMask) != 0) {
+          str(Reg.Q(), STATE.R(), offsetof(FEXCore::Core::CpuStateFrame, State.xmm.avx.data[i][0]));
+        }
+      }
     } else {
       if (GPRSpillMask && FPRSpillMask == ~0U) {
         // Optimize the common case where we can spill four registers per instruction
@@ -436,7 +481,7 @@ void Arm64Emitter::FillStaticRegs(bool FPRs, uint32_t GPRFillMask, uint32_t FPRF
   }
 
   if (FPRs) {
-    if (EmitterCTX->HostFeatures.SupportsAVX) {
+    if (EmitterCTX->HostFeatures.SupportsSVE256) {
       // Set up predicate registers.
       // We don't bother spilling these in SpillStaticRegs,
       // since all that matters is we restore them on a fill.
@@ -451,6 +496,14 @@ void Arm64Emitter::FillStaticRegs(bool FPRs, uint32_t GPRFillMask, uint32_t FPRF
           ld1b<ARMEmitter::SubRegSize::i8Bit>(Reg.Z(), PRED_TMP_32B.Zeroing(), STATE.R(), TMP4.R());
         }
       }
+    } else if (EmitterCTX->HostFeatures.SupportsAVX) {
+      // Split AVX, the upper halves stay in the context
+      for (size_t i = 0; i < StaticFPRegisters.size(); i++) {
+        const auto Reg = StaticFPRegisters[i];
+        if (((1U << Reg.Idx()) & FPRFillMask) != 0) {
+          ldr(Reg.Q(), STATE.R(), offsetof(FEXCore::Core::CpuStateFrame, State.xmm.avx.data[i][0]));
+        }
+      }
     } else {
       if (GPRFillMask && FPRFillMask == ~0U) {
         // Optimize the common case where we can fill four registers per instruction.
@@ -503,8 +556,8 @@ void Arm64Emitter::FillStaticRegs(bool FPRs, uint32_t GPRFillMask, uint32_t FPRF
   }
 }
 
-void Arm64Emitter::PushDynamicRegsAndLR(FEXCore::ARMEmitter::Register TmpReg) {
-  const auto CanUseSVE = EmitterCTX->HostFeatures.SupportsAVX;
+void Arm64Emitter::PushDynamicRegsAndLR(FEXCore::ARMEmitter::Register TmpReg, uint32_t GPRSpillMask, uint32_t FPRSpillMask) {
+  const auto CanUseSVE = EmitterCTX->HostFeatures.SupportsSVE256;
   const auto GPRSize = (ConfiguredDynamicRegisterBase.size() + 1) * Core::CPUState::GPR_REG_SIZE;
   const auto FPRRegSize = CanUseSVE ? Core::CPUState::XMM_AVX_REG_SIZE
                                     : Core::CPUState::XMM_SSE_REG_SIZE;
@@ -516,63 +569,129 @@ void Arm64Emitter::PushDynamicRegsAndLR(FEXCore::ARMEmitter::Register TmpReg) {
   // rsp capable move
   add(ARMEmitter::Size::i64Bit, TmpReg, ARMEmitter::Reg::rsp, 0);
 
-  if (CanUseSVE) {
-    for (size_t i = 0; i < GeneralFPRegisters.size(); i += 4) {
-      const auto Reg1 = GeneralFPRegisters[i];
-      const auto Reg2 = GeneralFPRegisters[i + 1];
-      const auto Reg3 = GeneralFPRegisters[i + 2];
-      const auto Reg4 = GeneralFPRegisters[i + 3];
-      st4b(Reg1.Z(), Reg2.Z(), Reg3.Z(), Reg4.Z(), PRED_TMP_32B, TmpReg, 0);
-      add(ARMEmitter::Size::i64Bit, TmpReg, TmpReg, 32 * 4);
+  // Every register keeps its slot even when it isn't saved, so the layout doesn't depend on the masks.
+  // TmpReg only moves forward once a store needs it to.
+  uint64_t PendingOffset{};
+  const auto Advance = [&]() {
+    if (PendingOffset) {
+      add(ARMEmitter::Size::i64Bit, TmpReg, TmpReg, PendingOffset);
+      PendingOffset = 0;
     }
-  } else {
-    LOGMAN_THROW_A_FMT(GeneralFPRegisters.size() % 4 == 0, "Needs to have multiple of 4 FPRs for RA");
-    for (size_t i = 0; i < GeneralFPRegisters.size(); i += 4) {
-      const auto Reg1 = GeneralFPRegisters[i];
-      const auto Reg2 = GeneralFPRegisters[i + 1];
-      const auto Reg3 = GeneralFPRegisters[i + 2];
-      const auto Reg4 = GeneralFPRegisters[i + 3];
+  };
+
+  LOGMAN_THROW_A_FMT(GeneralFPRegisters.size() % 4 == 0, "Needs to have multiple of 4 FPRs for RA");
+  for (size_t i = 0; i < GeneralFPRegisters.size(); i += 4) {
+    const auto Reg1 = GeneralFPRegisters[i];
+    const auto Reg2 = GeneralFPRegisters[i + 1];
+    const auto Reg3 = GeneralFPRegisters[i + 2];
+    const auto Reg4 = GeneralFPRegisters[i + 3];
+    const uint32_t GroupMask = (1U << Reg1.Idx()) | (1U << Reg2.Idx()) | (1U << Reg3.Idx()) | (1U << Reg4.Idx());
+
+    if (CanUseSVE) {
+      if (FPRSpillMask & GroupMask) {
+        Advance();
+        st4b(Reg1.Z(), Reg2.Z(), Reg3.Z(), Reg4.Z(), PRED_TMP_32B, TmpReg, 0);
+      }
+      PendingOffset += 32 * 4;
+    } else if ((FPRSpillMask & GroupMask) == GroupMask) {
+      Advance();
       st1<ARMEmitter::SubRegSize::i64Bit>(Reg1.Q(), Reg2.Q(), Reg3.Q(), Reg4.Q(), TmpReg, 64);
+    } else {
+      for (size_t j = 0; j < 4; ++j) {
+        const auto Reg = GeneralFPRegisters[i + j];
+        if (FPRSpillMask & (1U << Reg.Idx())) {
+          str(Reg.Q(), TmpReg, PendingOffset + j * 16);
+        }
+      }
+      PendingOffset += 64;
     }
   }
 
   for (size_t i = 0; i < ConfiguredDynamicRegisterBase.size(); i += 2) {
     const auto Reg1 = ConfiguredDynamicRegisterBase[i];
     const auto Reg2 = ConfiguredDynamicRegisterBase[i + 1];
-    stp<ARMEmitter::IndexType::POST>(Reg1.X(), Reg2.X(), TmpReg, 16);
+    const bool Save1 = GPRSpillMask & (1U << Reg1.Idx());
+    const bool Save2 = GPRSpillMask & (1U << Reg2.Idx());
+
+    if (Save1 && Save2) {
+      Advance();
+      stp<ARMEmitter::IndexType::POST>(Reg1.X(), Reg2.X(), TmpReg, 16);
+      continue;
+    }
+
+    if (Save1) {
+      str(Reg1.X(), TmpReg, PendingOffset);
+    }
+    else if (Save2) {
+      str(Reg2.X(), TmpReg, PendingOffset + 8);
+    }
+    PendingOffset += 16;
   }
 
-  str(ARMEmitter::XReg::lr, TmpReg, 0);
+  str(ARMEmitter::XReg::lr, TmpReg, PendingOffset);
 }
 
-void Arm64Emitter::PopDynamicRegsAndLR() {
-  const auto CanUseSVE = EmitterCTX->HostFeatures.SupportsAVX;
-
-  if (CanUseSVE) {
-    for (size_t i = 0; i < GeneralFPRegisters.size(); i += 4) {
-      const auto Reg1 = GeneralFPRegisters[i];
-      const auto Reg2 = GeneralFPRegisters[i + 1];
-      const auto Reg3 = GeneralFPRegisters[i + 2];
-      const auto Reg4 = GeneralFPRegisters[i + 3];
-      ld4b(Reg1.Z(), Reg2.Z(), Reg3.Z(), Reg4.Z(), PRED_TMP_32B.Zeroing(), ARMEmitter::Reg::rsp);
-      add(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::rsp, ARMEmitter::Reg::rsp, 32 * 4);
+void Arm64Emitter::PopDynamicRegsAndLR(uint32_t GPRFillMask, uint32_t FPRFillMask) {
+  const auto CanUseSVE = EmitterCTX->HostFeatures.SupportsSVE256;
+
+  // Mirrors PushDynamicRegsAndLR, rsp only moves forward once a load needs it to
+  uint64_t PendingOffset{};
+  const auto Advance = [&]() {
+    if (PendingOffset) {
+      add(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::rsp, ARMEmitter::Reg::rsp, PendingOffset);
+      PendingOffset = 0;
     }
-  } else {
-    for (size_t i = 0; i < GeneralFPRegisters.size(); i += 4) {
-      const auto Reg1 = GeneralFPRegisters[i];
-      const auto Reg2 = GeneralFPRegisters[i + 1];
-      const auto Reg3 = GeneralFPRegisters[i + 2];
-      const auto Reg4 = GeneralFPRegisters[i + 3];
+  };
+
+  for (size_t i = 0; i < GeneralFPRegisters.size(); i += 4) {
+    const auto Reg1 = GeneralFPRegisters[i];
+    const auto Reg2 = GeneralFPRegisters[i + 1];
+    const auto Reg3 = GeneralFPRegisters[i + 2];
+    const auto Reg4 = GeneralFPRegisters[i + 3];
+    const uint32_t GroupMask = (1U << Reg1.Idx()) | (1U << Reg2.Idx()) | (1U << Reg3.Idx()) | (1U << Reg4.Idx());
+
+    if (CanUseSVE) {
+      if (FPRFillMask & GroupMask) {
+        Advance();
+        ld4b(Reg1.Z(), Reg2.Z(), Reg3.Z(), Reg4.Z(), PRED_TMP_32B.Zeroing(), ARMEmitter::Reg::rsp);
+      }
+      PendingOffset += 32 * 4;
+    } else if ((FPRFillMask & GroupMask) == GroupMask) {
+      Advance();
       ld1<ARMEmitter::SubRegSize::i64Bit>(Reg1.Q(), Reg2.Q(), Reg3.Q(), Reg4.Q(), ARMEmitter::Reg::rsp, 64);
+    } else {
+      for (size_t j = 0; j < 4; ++j) {
+        const auto Reg = GeneralFPRegisters[i + j];
+        if (FPRFillMask & (1U << Reg.Idx())) {
+          ldr(Reg.Q(), ARMEmitter::Reg::rsp, PendingOffset + j * 16);
+        }
+      }
+      PendingOffset += 64;
     }
   }
 
   for (size_t i = 0; i < ConfiguredDynamicRegisterBase.size(); i += 2) {
     const auto Reg1 = ConfiguredDynamicRegisterBase[i];
     const auto Reg2 = ConfiguredDynamicRegisterBase[i + 1];
-    ldp<ARMEmitter::IndexType::POST>(Reg1.X(), Reg2.X(), ARMEmitter::Reg::rsp, 16);
+    const bool Fill1 = GPRFillMask & (1U << Reg1.Idx());
+    const bool Fill2 = GPRFillMask & (1U << Reg2.Idx());
+
+    if (Fill1 && Fill2) {
+      Advance();
+      ldp<ARMEmitter::IndexType::POST>(Reg1.X(), Reg2.X(), ARMEmitter::Reg::rsp, 16);
+      continue;
+    }
+
+    if (Fill1) {
+      ldr(Reg1.X(), ARMEmitter::Reg::rsp, PendingOffset);
+    }
+    else if (Fill2) {
+      ldr(Reg2.X(), ARMEmitter::Reg::rsp, PendingOffset + 8);
+    }
+    PendingOffset += 16;
   }
 
+  Advance();
   ldr<ARMEmitter::IndexType::POST>(ARMEmitter::XReg::lr, ARMEmitter::Reg::rsp, 16);
 }
 
@@ -84,6 +84,8 @@ protected:
   constexpr static uint8_t RA_FPR = 2;
 
   void LoadConstant(FEXCore::ARMEmitter::Size s, FEXCore::ARMEmitter::Register Reg, uint64_t Constant, bool NOPPad = false);
+  // Number of instructions LoadConstant would emit for a 64-bit constant at the current cursor
+  [[nodiscard]] int LoadConstantInstructionCount(uint64_t Constant) const;
 
 
   // NOTE: These functions WILL clobber the register TMP4 if AVX support is enabled
@@ -99,8 +101,10 @@ protected:
   // We can't guarantee only the lower 64bits are used so flush everything
   static constexpr uint32_t CALLER_FPR_MASK = ~0U;
 
-  void PushDynamicRegsAndLR(FEXCore::ARMEmitter::Register TmpReg);
-  void PopDynamicRegsAndLR();
+  // Masks are host register indexes, registers outside of them aren't preserved across the call.
+  // Pop has to be given the same masks as the matching Push.
+  void PushDynamicRegsAndLR(FEXCore::ARMEmitter::Register TmpReg, uint32_t GPRSpillMask = ~0U, uint32_t FPRSpillMask = ~0U);
+  void PopDynamicRegsAndLR(uint32_t GPRFillMask = ~0U, uint32_t FPRFillMask = ~0U);
 
   void PushCalleeSavedRegisters();
   void PopCalleeSavedRegisters();
@@ -38,6 +38,15 @@ namespace FEXCore::ARMEmitter {
         CurrentOffset += sizeof(Data);
       }
 
+      // Writes the same word Count times, used for padding
+      void dc32Fill(uint32_t Data, size_t Count) {
+        uint32_t *Memory = reinterpret_cast<uint32_t*>(CurrentOffset);
+        for (size_t i = 0; i < Count; ++i) {
+          Memory[i] = Data;
+        }
+        CurrentOffset += Count * sizeof(Data);
+      }
+
       void dc64(uint64_t Data) {
         decltype(Data) *Memory = reinterpret_cast<decltype(Data)*>(CurrentOffset);
         *Memory = Data;
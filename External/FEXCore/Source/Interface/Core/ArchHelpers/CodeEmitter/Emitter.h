@@ -466,6 +466,18 @@ namespace FEXCore::ARMEmitter {
     SY     = 0b1111,
   };
 
+  // Hints and barriers have no register operands, so the whole instruction is known at compile time.
+  [[nodiscard]]
+  constexpr uint32_t HintEncoding(HintRegister Reg) {
+    return 0b1101'0101'0000'0011'0010'0000'0001'1111U | FEXCore::ToUnderlying(Reg);
+  }
+  [[nodiscard]]
+  constexpr uint32_t BarrierEncoding(BarrierRegister Reg, uint32_t CRm) {
+    return 0b1101'0101'0000'0011'0011'0000'0001'1111U | (CRm << 8) | FEXCore::ToUnderlying(Reg);
+  }
+  static_assert(HintEncoding(HintRegister::NOP) == 0xD503'201FU, "Invalid NOP encoding");
+  static_assert(BarrierEncoding(BarrierRegister::ISB, FEXCore::ToUnderlying(BarrierScope::SY)) == 0xD503'3FDFU, "Invalid ISB encoding");
+
   // This `Prefetch` enum is used for prefetch instructions.
   enum class Prefetch : uint32_t {
     // Prefetch for load
@@ -2214,7 +2214,27 @@ public:
   }
 
   // Memory copy/set
-  // TODO
+  // FEAT_MOPS, each operation is the prologue, main and epilogue instruction emitted back to back.
+  // All three registers are written back, size counts down to zero.
+  void cpyfp(XRegister rd, XRegister rs, XRegister rn) {
+    MemoryCopySet(0b0001'1001'000 << 21, rd, rs, rn);
+  }
+  void cpyfm(XRegister rd, XRegister rs, XRegister rn) {
+    MemoryCopySet(0b0001'1001'010 << 21, rd, rs, rn);
+  }
+  void cpyfe(XRegister rd, XRegister rs, XRegister rn) {
+    MemoryCopySet(0b0001'1001'100 << 21, rd, rs, rn);
+  }
+  // rs is the source byte in the low 8 bits, rn is the size
+  void setp(XRegister rd, XRegister rn, XRegister rs) {
+    MemoryCopySet((0b0001'1001'110 << 21) | (0b0000 << 12), rd, rs, rn);
+  }
+  void setm(XRegister rd, XRegister rn, XRegister rs) {
+    MemoryCopySet((0b0001'1001'110 << 21) | (0b0100 << 12), rd, rs, rn);
+  }
+  void sete(XRegister rd, XRegister rn, XRegister rs) {
+    MemoryCopySet((0b0001'1001'110 << 21) | (0b1000 << 12), rd, rs, rn);
+  }
   // Loadstore no-allocate pair
   void stnp(FEXCore::ARMEmitter::WRegister rt, FEXCore::ARMEmitter::WRegister rt2, FEXCore::ARMEmitter::Register rn, int32_t Imm) {
     LOGMAN_THROW_A_FMT(Imm >= -256 && Imm <= 252 && ((Imm & 0b11) == 0), "Unscaled offset too large");
@@ -4209,6 +4229,16 @@ private:
     Instr |= Encode_rt(rt);
     dc32(Instr);
   }
+  // Memory copy/set
+  void MemoryCopySet(uint32_t Op, XRegister rd, XRegister rs, XRegister rn) {
+    LOGMAN_THROW_AA_FMT(rd != rs && rd != rn && rs != rn, "Memory copy/set registers must be distinct");
+    uint32_t Instr = Op | (0b01 << 10);
+
+    Instr |= Encode_rs(rs);
+    Instr |= Encode_rn(rn);
+    Instr |= Encode_rd(rd);
+    dc32(Instr);
+  }
   // Loadstore register pair post-indexed
   template<typename T>
   void LoadStorePair(uint32_t Op, T rt, T rt2, FEXCore::ARMEmitter::Register rn, uint32_t Imm) {
@@ -58,6 +58,10 @@ public:
     void nop() {
       Hint(FEXCore::ARMEmitter::HintRegister::NOP);
     }
+    // Emits Count nops at once, for padding sequences out to a fixed size
+    void nop(size_t Count) {
+      dc32Fill(FEXCore::ARMEmitter::HintEncoding(FEXCore::ARMEmitter::HintRegister::NOP), Count);
+    }
     void yield() {
       Hint(FEXCore::ARMEmitter::HintRegister::YIELD);
     }
@@ -140,16 +144,11 @@ private:
 
     // Hints
     void Hint(FEXCore::ARMEmitter::HintRegister Reg) {
-      uint32_t Instr = 0b1101'0101'0000'0011'0010'0000'0001'1111U;
-      Instr |= FEXCore::ToUnderlying(Reg);
-      dc32(Instr);
+      dc32(FEXCore::ARMEmitter::HintEncoding(Reg));
     }
     // Barriers
     void Barrier(FEXCore::ARMEmitter::BarrierRegister Reg, uint32_t CRm) {
-      uint32_t Instr = 0b1101'0101'0000'0011'0011'0000'0001'1111U;
-      Instr |= CRm << 8;
-      Instr |= FEXCore::ToUnderlying(Reg);
-      dc32(Instr);
+      dc32(FEXCore::ARMEmitter::BarrierEncoding(Reg, CRm));
     }
 
     // System Instruction
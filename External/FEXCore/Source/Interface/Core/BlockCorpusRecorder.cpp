@@ -0,0 +1,64 @@
+/*
+$info$
+tags: glue|block-database
+desc: Records the guest code of compiled blocks so JIT compile throughput can be benchmarked offline
+$end_info$
+*/
+
+#include "Interface/Core/BlockCorpusRecorder.h"
+
+#include <FEXCore/Debug/BlockCorpus.h>
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/fextl/fmt.h>
+
+#include <algorithm>
+#include <cstring>
+#include <unistd.h>
+#include <xxhash.h>
+
+namespace FEXCore {
+  BlockCorpusRecorder::BlockCorpusRecorder(const fextl::string &Path, bool Is64BitMode)
+    : Output {fextl::fmt::format("{}.{}", Path, ::getpid()).c_str(),
+              FEXCore::File::FileModes::WRITE | FEXCore::File::FileModes::CREATE | FEXCore::File::FileModes::TRUNCATE} {
+    if (!Output.IsValid()) {
+      LogMan::Msg::EFmt("Block corpus: Couldn't open {}.{}", Path, ::getpid());
+      return;
+    }
+
+    BlockCorpus::FileHeader Header {};
+    memcpy(Header.Magic, BlockCorpus::Magic, sizeof(Header.Magic));
+    Header.Version = BlockCorpus::Version;
+    Header.Is64BitMode = Is64BitMode;
+    Output.Write(&Header, sizeof(Header));
+  }
+
+  void BlockCorpusRecorder::Record(uint64_t GuestRIP, uint64_t CodeStart, uint64_t CodeLength) {
+    if (!Output.IsValid() || CodeLength == 0) {
+      return;
+    }
+
+    const auto Code = reinterpret_cast<const uint8_t*>(CodeStart);
+    const auto Hash = XXH3_64bits(Code, CodeLength);
+
+    std::lock_guard lk(Lock);
+
+    auto &Hashes = Recorded[GuestRIP];
+    if (std::find(Hashes.begin(), Hashes.end(), Hash) != Hashes.end()) {
+      return;
+    }
+    Hashes.emplace_back(Hash);
+
+    const BlockCorpus::BlockHeader Header {
+      .GuestRIP = GuestRIP,
+      .CodeStart = CodeStart,
+      .CodeLength = static_cast<uint32_t>(CodeLength),
+      .Pad = 0,
+    };
+
+    // One write per block so a process killed mid-run leaves a corpus that is only missing its last blocks
+    Buffer.resize(sizeof(Header) + CodeLength);
+    memcpy(Buffer.data(), &Header, sizeof(Header));
+    memcpy(Buffer.data() + sizeof(Header), Code, CodeLength);
+    Output.Write(Buffer.data(), Buffer.size());
+  }
+}
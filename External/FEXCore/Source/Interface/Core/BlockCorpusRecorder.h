@@ -0,0 +1,42 @@
+#pragma once
+#include <FEXCore/Utils/File.h>
+#include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/unordered_map.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <cstdint>
+#include <mutex>
+
+namespace FEXCore {
+/**
+ * @brief Writes the guest code of compiled blocks to a corpus file for CompileBench
+ *
+ * The layout is described in FEXCore/Debug/BlockCorpus.h.
+ * A block is only written again if its guest code changed since it was last recorded.
+ */
+class BlockCorpusRecorder {
+public:
+  /**
+   * @param Path - Corpus file, the process ID is appended
+   * @param Is64BitMode - Recorded in the header so the replay decodes in the same mode
+   */
+  BlockCorpusRecorder(const fextl::string &Path, bool Is64BitMode);
+
+  /**
+   * @brief Records a freshly compiled block
+   *
+   * @param GuestRIP - Entry of the block
+   * @param CodeStart - Start of the guest code decoded for the block
+   * @param CodeLength - Length of the guest code decoded for the block
+   */
+  void Record(uint64_t GuestRIP, uint64_t CodeStart, uint64_t CodeLength);
+
+private:
+  std::mutex Lock;
+  FEXCore::File::File Output;
+
+  // Hashes of the guest code already recorded for each entry
+  fextl::unordered_map<uint64_t, fextl::vector<uint64_t>> Recorded;
+  fextl::vector<uint8_t> Buffer;
+};
+}
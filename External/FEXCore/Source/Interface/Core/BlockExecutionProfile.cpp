@@ -0,0 +1,73 @@
+/*
+$info$
+tags: glue|block-database
+desc: Tracks guest block execution counts fed by JIT code, and reports the hottest blocks
+$end_info$
+*/
+
+#include "Interface/Core/BlockExecutionProfile.h"
+
+#include <FEXCore/Utils/LogManager.h>
+
+#include <algorithm>
+
+namespace FEXCore {
+  uint64_t *BlockExecutionProfile::GetCounter(uint64_t GuestRIP, const fextl::string *Filename, uint64_t FileOffset) {
+    std::lock_guard lk(Lock);
+
+    auto [it, Inserted] = BlockIndex.try_emplace(GuestRIP, Counters.size());
+    if (!Inserted) {
+      return &Counters[it->second];
+    }
+
+    uint32_t FileIdx = ~0U;
+    if (Filename) {
+      auto [FileIt, FileInserted] = FileIndex.try_emplace(*Filename, Files.size());
+      if (FileInserted) {
+        Files.emplace_back(*Filename);
+      }
+      FileIdx = FileIt->second;
+    }
+
+    Counters.emplace_back(0);
+    Blocks.emplace_back(BlockInfo {
+      .GuestRIP = GuestRIP,
+      .FileOffset = FileOffset,
+      .FileIndex = FileIdx,
+    });
+
+    return &Counters.back();
+  }
+
+  uint64_t BlockExecutionProfile::GetCount(uint64_t GuestRIP) {
+    std::lock_guard lk(Lock);
+
+    auto it = BlockIndex.find(GuestRIP);
+    return it != BlockIndex.end() ? Counters[it->second] : 0;
+  }
+
+  void BlockExecutionProfile::Dump(size_t TopN) {
+    std::lock_guard lk(Lock);
+
+    fextl::vector<size_t> Order(Counters.size());
+    for (size_t i = 0; i < Order.size(); ++i) {
+      Order[i] = i;
+    }
+
+    TopN = std::min(TopN, Order.size());
+    std::partial_sort(Order.begin(), Order.begin() + TopN, Order.end(), [this](size_t lhs, size_t rhs) {
+      return Counters[lhs] > Counters[rhs];
+    });
+
+    LogMan::Msg::IFmt("Block execution profile: top {} of {} blocks", TopN, Order.size());
+    for (size_t i = 0; i < TopN; ++i) {
+      const auto &Block = Blocks[Order[i]];
+      if (Block.FileIndex != ~0U) {
+        LogMan::Msg::IFmt("  {:>16} 0x{:x} {}+0x{:x}", Counters[Order[i]], Block.GuestRIP, Files[Block.FileIndex], Block.FileOffset);
+      }
+      else {
+        LogMan::Msg::IFmt("  {:>16} 0x{:x} <anonymous>", Counters[Order[i]], Block.GuestRIP);
+      }
+    }
+  }
+}
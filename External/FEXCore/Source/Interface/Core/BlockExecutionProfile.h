@@ -0,0 +1,61 @@
+#pragma once
+#include <FEXCore/fextl/deque.h>
+#include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/unordered_map.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace FEXCore {
+/**
+ * @brief Execution counts of compiled guest blocks
+ *
+ * Each profiled block increments its counter from JIT code on entry.
+ * Counters are shared between threads and aren't atomic, counts are approximate under contention.
+ */
+class BlockExecutionProfile {
+public:
+  /**
+   * @brief Returns the counter for a guest block, creating it on first use
+   *
+   * @param GuestRIP - Entry of the block
+   * @param Filename - File backing the block, or nullptr for anonymous memory
+   * @param FileOffset - Offset of GuestRIP in to Filename
+   *
+   * @return Pointer to the counter, it remains valid for the lifetime of the profile
+   */
+  uint64_t *GetCounter(uint64_t GuestRIP, const fextl::string *Filename, uint64_t FileOffset);
+
+  /**
+   * @brief Returns the execution count of a guest block, 0 if it has no counter
+   */
+  uint64_t GetCount(uint64_t GuestRIP);
+
+  /**
+   * @brief Logs the TopN most executed blocks
+   */
+  void Dump(size_t TopN);
+
+private:
+  struct BlockInfo {
+    uint64_t GuestRIP;
+    uint64_t FileOffset;
+    // Index in to Files, ~0U for anonymous memory
+    uint32_t FileIndex;
+  };
+
+  std::mutex Lock;
+
+  // Counters and Blocks are indexed in parallel.
+  // A deque never moves its elements on growth, so JIT code can keep pointers in to Counters.
+  fextl::deque<uint64_t> Counters;
+  fextl::vector<BlockInfo> Blocks;
+  fextl::unordered_map<uint64_t, size_t> BlockIndex;
+
+  // File names are interned, most blocks come from a handful of files
+  fextl::vector<fextl::string> Files;
+  fextl::unordered_map<fextl::string, uint32_t> FileIndex;
+};
+}
@@ -0,0 +1,89 @@
+/*
+$info$
+tags: glue|block-database
+desc: Shares optimized IR between byte-identical guest blocks at different addresses
+$end_info$
+*/
+
+#include "Interface/Core/BlockIRDedupCache.h"
+
+#include <FEXCore/IR/IntrusiveIRList.h>
+
+#include <cstring>
+#include <xxhash.h>
+
+namespace FEXCore {
+  BlockIRDedupCache::~BlockIRDedupCache() {
+    for (auto &[Key, Stored] : Entries) {
+      delete Stored->Data.IRList;
+      FEXCore::IR::RegisterAllocationDataDeleter{}(Stored->Data.RAData);
+    }
+  }
+
+  uint64_t BlockIRDedupCache::Hash(uint64_t GuestRIP, uint64_t StartAddr, uint64_t Length, bool InlineSMCChecks) {
+    // The same bytes entered at a different offset, or with different SMC checks, generate different IR
+    const uint64_t Seed = ((GuestRIP - StartAddr) << 1) | InlineSMCChecks;
+    return XXH3_64bits_withSeed(reinterpret_cast<const void*>(StartAddr), Length, Seed);
+  }
+
+  const BlockIRDedupCache::Entry *BlockIRDedupCache::Find(uint64_t GuestRIP, uint64_t StartAddr, uint64_t Length, bool InlineSMCChecks) {
+    if (Length == 0 || Length > MaxGuestLength) {
+      return nullptr;
+    }
+
+    const auto Key = Hash(GuestRIP, StartAddr, Length, InlineSMCChecks);
+
+    std::lock_guard lk(Lock);
+    auto it = Entries.find(Key);
+    if (it == Entries.end()) {
+      return nullptr;
+    }
+
+    // Don't trust the hash alone, a collision would run the wrong code
+    const auto &Stored = *it->second;
+    if (Stored.EntryOffset != GuestRIP - StartAddr ||
+        Stored.InlineSMCChecks != InlineSMCChecks ||
+        Stored.GuestCode.size() != Length ||
+        memcmp(Stored.GuestCode.data(), reinterpret_cast<const void*>(StartAddr), Length) != 0) {
+      return nullptr;
+    }
+
+    return &Stored.Data;
+  }
+
+  void BlockIRDedupCache::Insert(uint64_t GuestRIP, uint64_t StartAddr, uint64_t Length, bool InlineSMCChecks,
+                                 FEXCore::IR::IRListView *IRList, FEXCore::IR::RegisterAllocationData const *RAData,
+                                 uint64_t TotalInstructions, uint64_t TotalInstructionsLength) {
+    if (Length == 0 || Length > MaxGuestLength || !RAData) {
+      return;
+    }
+
+    const auto Key = Hash(GuestRIP, StartAddr, Length, InlineSMCChecks);
+
+    std::lock_guard lk(Lock);
+    if (Entries.contains(Key)) {
+      // Another thread already stored it
+      return;
+    }
+
+    if (SeenOnce.insert(Key).second) {
+      // First time this range was compiled
+      return;
+    }
+    SeenOnce.erase(Key);
+
+    auto Stored = fextl::make_unique<StoredEntry>();
+    Stored->Data = Entry {
+      .IRList = IRList->CreateCopy(),
+      .RAData = RAData->CreateCopy().release(),
+      .TotalInstructions = TotalInstructions,
+      .TotalInstructionsLength = TotalInstructionsLength,
+    };
+    Stored->GuestCode.resize(Length);
+    memcpy(Stored->GuestCode.data(), reinterpret_cast<const void*>(StartAddr), Length);
+    Stored->EntryOffset = GuestRIP - StartAddr;
+    Stored->InlineSMCChecks = InlineSMCChecks;
+
+    Entries.emplace(Key, std::move(Stored));
+  }
+}
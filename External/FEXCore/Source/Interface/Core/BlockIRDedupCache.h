@@ -0,0 +1,76 @@
+#pragma once
+#include <FEXCore/IR/RegisterAllocationData.h>
+#include <FEXCore/fextl/memory.h>
+#include <FEXCore/fextl/unordered_map.h>
+#include <FEXCore/fextl/unordered_set.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace FEXCore::IR {
+class IRListView;
+}
+
+namespace FEXCore {
+/**
+ * @brief Shares optimized IR between guest blocks that are byte-identical at different addresses
+ *
+ * PLT stubs and similar small sequences repeat throughout a process.
+ * IR generated without tier 0 or profile counters only refers to guest addresses through EntrypointOffset,
+ * so it is valid for any block with the same bytes, entry offset and SMC check mode.
+ *
+ * Content is only stored once it has been seen twice, so unique blocks only cost a hash entry.
+ */
+class BlockIRDedupCache {
+public:
+  // Blocks larger than this are rarely duplicated and too costly to keep a copy of
+  constexpr static size_t MaxGuestLength = 256;
+
+  struct Entry {
+    FEXCore::IR::IRListView *IRList;
+    FEXCore::IR::RegisterAllocationData *RAData;
+    uint64_t TotalInstructions;
+    uint64_t TotalInstructionsLength;
+  };
+
+  BlockIRDedupCache() = default;
+  ~BlockIRDedupCache();
+
+  /**
+   * @brief Looks up IR for the decoded guest range
+   *
+   * @param GuestRIP - Entry of the block
+   * @param StartAddr - First decoded guest byte
+   * @param Length - Size of the decoded guest range
+   * @param InlineSMCChecks - If the IR would be generated with inline SMC checks
+   *
+   * @return The cached entry, nullptr if the IR needs to be generated.
+   * Entries live until the cache is destroyed.
+   */
+  const Entry *Find(uint64_t GuestRIP, uint64_t StartAddr, uint64_t Length, bool InlineSMCChecks);
+
+  /**
+   * @brief Stores a copy of freshly generated IR if its guest range has been seen before
+   */
+  void Insert(uint64_t GuestRIP, uint64_t StartAddr, uint64_t Length, bool InlineSMCChecks,
+              FEXCore::IR::IRListView *IRList, FEXCore::IR::RegisterAllocationData const *RAData,
+              uint64_t TotalInstructions, uint64_t TotalInstructionsLength);
+
+private:
+  struct StoredEntry {
+    Entry Data;
+    fextl::vector<uint8_t> GuestCode;
+    uint64_t EntryOffset;
+    bool InlineSMCChecks;
+  };
+
+  static uint64_t Hash(uint64_t GuestRIP, uint64_t StartAddr, uint64_t Length, bool InlineSMCChecks);
+
+  std::mutex Lock;
+  // Hashes of guest ranges compiled once, a second compile stores the IR
+  fextl::unordered_set<uint64_t> SeenOnce;
+  fextl::unordered_map<uint64_t, fextl::unique_ptr<StoredEntry>> Entries;
+};
+}
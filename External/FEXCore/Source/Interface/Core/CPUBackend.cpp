@@ -2,22 +2,80 @@
 #include "Interface/Context/Context.h"
 #include "Interface/Core/Dispatcher/Dispatcher.h"
 #include <FEXCore/Core/CPUBackend.h>
+#include <FEXCore/Utils/MathUtils.h>
+
+#include <algorithm>
 
 namespace FEXCore {
 namespace CPU {
 
+namespace {
+  constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+  // THP can only back 2MB aligned ranges, over-allocate and trim down to an aligned buffer.
+  // Pages are first touched by the thread that compiles in to them, which keeps them on its NUMA node.
+  void *AllocateHugePageBuffer(size_t Size) {
+#ifdef _WIN32
+    return FEXCore::Allocator::VirtualAlloc(Size, true);
+#else
+    auto Ptr = FEXCore::Allocator::VirtualAlloc(Size + HUGE_PAGE_SIZE, true);
+    if (Ptr == MAP_FAILED) {
+      return nullptr;
+    }
+
+    const auto Begin = reinterpret_cast<uintptr_t>(Ptr);
+    const auto AlignedBegin = AlignUp(Begin, HUGE_PAGE_SIZE);
+    const auto End = Begin + Size + HUGE_PAGE_SIZE;
+    const auto AlignedEnd = AlignedBegin + Size;
+
+    if (AlignedBegin != Begin) {
+      FEXCore::Allocator::VirtualFree(Ptr, AlignedBegin - Begin);
+    }
+    if (AlignedEnd != End) {
+      FEXCore::Allocator::VirtualFree(reinterpret_cast<void*>(AlignedEnd), End - AlignedEnd);
+    }
+
+    FEXCore::Allocator::VirtualHugePages(reinterpret_cast<void*>(AlignedBegin), Size);
+    return reinterpret_cast<void*>(AlignedBegin);
+#endif
+  }
+}
+
+CPUBackend::SharedCodeArena::~SharedCodeArena() {
+  if (Buffer.Ptr) {
+    FreeCodeBuffer(Buffer);
+  }
+
+  for (auto CodeBuffer : RetiredBuffers) {
+    FreeCodeBuffer(CodeBuffer);
+  }
+}
+
 CPUBackend::CPUBackend(FEXCore::Core::InternalThreadState *ThreadState, size_t InitialCodeSize, size_t MaxCodeSize)
-    : ThreadState(ThreadState), InitialCodeSize(InitialCodeSize), MaxCodeSize(MaxCodeSize) {}
+    : ThreadState(ThreadState), InitialCodeSize(InitialCodeSize), MaxCodeSize(MaxCodeSize) {
+  SharedArena = static_cast<Context::ContextImpl*>(ThreadState->CTX)->SharedCodeArena.get();
+}
 
 CPUBackend::~CPUBackend() {
   for (auto CodeBuffer : CodeBuffers) {
     FreeCodeBuffer(CodeBuffer);
   }
   CodeBuffers.clear();
+
+  if (HotCodeBuffer.Ptr) {
+    FreeCodeBuffer(HotCodeBuffer);
+  }
 }
 
 auto CPUBackend::GetEmptyCodeBuffer() -> CodeBuffer * {
+  if (SharedArena) {
+    return GetEmptySharedCodeBuffer();
+  }
+
   if (ThreadState->CurrentFrame->SignalHandlerRefCounter == 0) {
+    // The hot buffer is emptied by the same clear
+    HotCodeBuffer.VeneerOffset = 0;
+
     if (CodeBuffers.empty()) {
       auto NewCodeBuffer = AllocateNewCodeBuffer(InitialCodeSize);
       EmplaceNewCodeBuffer(NewCodeBuffer);
@@ -32,6 +90,8 @@ auto CPUBackend::GetEmptyCodeBuffer() -> CodeBuffer * {
       }
       // Set the current code buffer to the initial
       CurrentCodeBuffer = &CodeBuffers[0];
+      // Nothing links through the old veneers anymore
+      CurrentCodeBuffer->VeneerOffset = 0;
 
       if (CurrentCodeBuffer->Size != MaxCodeSize) {
         FreeCodeBuffer(*CurrentCodeBuffer);
@@ -54,27 +114,149 @@ auto CPUBackend::GetEmptyCodeBuffer() -> CodeBuffer * {
   return CurrentCodeBuffer;
 }
 
+auto CPUBackend::GetFreshCodeBuffer() -> CodeBuffer * {
+  if (SharedArena) {
+    // Retires the current arena buffer
+    return GetEmptySharedCodeBuffer();
+  }
+
+  // Same as when signal handlers keep old code alive, the extra buffer is freed on the next clear
+  const size_t Size = CurrentCodeBuffer ? CurrentCodeBuffer->Size : InitialCodeSize;
+  EmplaceNewCodeBuffer(AllocateNewCodeBuffer(Size));
+  return CurrentCodeBuffer;
+}
+
+auto CPUBackend::GetEmptySharedCodeBuffer() -> CodeBuffer * {
+  std::lock_guard lk(SharedArena->Lock);
+
+  if (!CurrentCodeBuffer) {
+    // First backend to come up allocates the arena, later ones attach to it as-is.
+    if (!SharedArena->Buffer.Ptr) {
+      SharedArena->Buffer = AllocateNewCodeBuffer(InitialCodeSize);
+      SharedArena->Offset = 0;
+    }
+  }
+  else {
+    // Other threads can still be executing code from the old buffer, it can't be reused.
+    // Grow the replacement the same way a thread local buffer grows.
+    const size_t NewSize = std::min<size_t>(SharedArena->Buffer.Size * 1.5, MaxCodeSize);
+    SharedArena->RetiredBuffers.emplace_back(SharedArena->Buffer);
+    SharedArena->Buffer = AllocateNewCodeBuffer(NewSize);
+    SharedArena->Offset = 0;
+  }
+
+  CurrentCodeBuffer = &SharedArena->Buffer;
+  return CurrentCodeBuffer;
+}
+
+auto CPUBackend::GetHotCodeBuffer() -> CodeBuffer * {
+  if (SharedArena) {
+    return nullptr;
+  }
+
+  if (!HotCodeBuffer.Ptr) {
+    // Hot code is a small part of the working set, an eighth of the cold buffer is plenty
+    HotCodeBuffer = AllocateNewCodeBuffer(MaxCodeSize / 8);
+  }
+
+  return &HotCodeBuffer;
+}
+
+std::unique_lock<std::recursive_mutex> CPUBackend::ClaimSharedCodeArena() {
+  if (!SharedArena) {
+    return {};
+  }
+
+  return std::unique_lock(SharedArena->Lock);
+}
+
 auto CPUBackend::AllocateNewCodeBuffer(size_t Size) -> CodeBuffer {
+  auto CTX = static_cast<Context::ContextImpl*>(ThreadState->CTX);
+
   CodeBuffer Buffer;
   Buffer.Size = Size;
-  Buffer.Ptr = static_cast<uint8_t *>(
-      FEXCore::Allocator::VirtualAlloc(Buffer.Size, true));
+  Buffer.VeneerOffset = 0;
+  if (CTX->Config.JITHugePages) {
+    Buffer.Ptr = static_cast<uint8_t *>(AllocateHugePageBuffer(Buffer.Size + VeneerPoolSize));
+  }
+  else {
+    Buffer.Ptr = static_cast<uint8_t *>(
+        FEXCore::Allocator::VirtualAlloc(Buffer.Size + VeneerPoolSize, true));
+  }
   LOGMAN_THROW_AA_FMT(!!Buffer.Ptr, "Couldn't allocate code buffer");
 
-  if (static_cast<Context::ContextImpl*>(ThreadState->CTX)->Config.GlobalJITNaming()) {
-    static_cast<Context::ContextImpl*>(ThreadState->CTX)->Symbols.RegisterJITSpace(Buffer.Ptr, Buffer.Size);
+  if (CTX->Config.GlobalJITNaming()) {
+    CTX->Symbols.RegisterJITSpace(Buffer.Ptr, Buffer.Size + VeneerPoolSize);
   }
   return Buffer;
 }
 
 void CPUBackend::FreeCodeBuffer(CodeBuffer Buffer) {
-  FEXCore::Allocator::VirtualFree(Buffer.Ptr, Buffer.Size);
+  FEXCore::Allocator::VirtualFree(Buffer.Ptr, Buffer.Size + VeneerPoolSize);
+}
+
+uint8_t *CPUBackend::AllocateVeneer(uintptr_t Near, size_t Size) {
+  auto Allocate = [Near, Size](CodeBuffer &Buffer) -> uint8_t* {
+    const auto start = reinterpret_cast<uintptr_t>(Buffer.Ptr);
+    if (Near < start || Near >= start + Buffer.Size || Buffer.VeneerOffset + Size > VeneerPoolSize) {
+      return nullptr;
+    }
+
+    auto Veneer = Buffer.Ptr + Buffer.Size + Buffer.VeneerOffset;
+    Buffer.VeneerOffset += Size;
+    return Veneer;
+  };
+
+  if (SharedArena) {
+    std::lock_guard lk(SharedArena->Lock);
+    if (auto Veneer = Allocate(SharedArena->Buffer)) {
+      return Veneer;
+    }
+    for (auto &Buffer : SharedArena->RetiredBuffers) {
+      if (auto Veneer = Allocate(Buffer)) {
+        return Veneer;
+      }
+    }
+    return nullptr;
+  }
+
+  if (HotCodeBuffer.Ptr) {
+    if (auto Veneer = Allocate(HotCodeBuffer)) {
+      return Veneer;
+    }
+  }
+
+  for (auto &Buffer : CodeBuffers) {
+    if (auto Veneer = Allocate(Buffer)) {
+      return Veneer;
+    }
+  }
+
+  return nullptr;
 }
 
 bool CPUBackend::IsAddressInCodeBuffer(uintptr_t Address) const {
+  if (SharedArena) {
+    auto InBuffer = [Address](const CodeBuffer &Buffer) {
+      const auto start = reinterpret_cast<uintptr_t>(Buffer.Ptr);
+      return Address >= start && Address < (start + Buffer.Size + VeneerPoolSize);
+    };
+
+    std::lock_guard lk(SharedArena->Lock);
+    return InBuffer(SharedArena->Buffer) ||
+      std::any_of(SharedArena->RetiredBuffers.begin(), SharedArena->RetiredBuffers.end(), InBuffer);
+  }
+
+  if (HotCodeBuffer.Ptr) {
+    auto start = (uintptr_t)HotCodeBuffer.Ptr;
+    if (Address >= start && Address < start + HotCodeBuffer.Size + VeneerPoolSize) {
+      return true;
+    }
+  }
+
   for (auto &Buffer: CodeBuffers) {
     auto start = (uintptr_t)Buffer.Ptr;
-    auto end = start + Buffer.Size;
+    auto end = start + Buffer.Size + VeneerPoolSize;
 
     if (Address >= start && Address < end) {
       return true;
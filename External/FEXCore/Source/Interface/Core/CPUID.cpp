@@ -95,13 +95,6 @@ constexpr uint32_t FAMILY_IDENTIFIER =
 #endif
 
 #ifdef _M_ARM_64
-static uint32_t GetCycleCounterFrequency() {
-  uint64_t Result{};
-  __asm("mrs %[Res], CNTFRQ_EL0"
-      : [Res] "=r" (Result));
-  return Result;
-}
-
 void CPUIDEmu::SetupHostHybridFlag() {
   size_t CPUs = FEXCore::CPUInfo::CalculateNumberOfCPUs();
   PerCPUData.resize(CPUs);
@@ -341,19 +334,6 @@ void CPUIDEmu::SetupHostHybridFlag() {
 }
 
 #else
-static uint32_t GetCycleCounterFrequency() {
-  uint32_t data[4];
-  Xbyak::util::Cpu::getCpuid(0, data);
-  if (data[0] >= 0x15) {
-    Xbyak::util::Cpu::getCpuid(0x15, data);
-
-    if (data[0] && data[1] && data[2]) {
-      return data[2] * data[1] / data[0];
-    }
-  }
-  return 0;
-}
-
 void CPUIDEmu::SetupHostHybridFlag() {
   uint32_t data[4];
   Xbyak::util::Cpu::getCpuid(0, data);
@@ -783,7 +763,8 @@ FEXCore::CPUID::FunctionResults CPUIDEmu::Function_0Dh(uint32_t Leaf) {
 FEXCore::CPUID::FunctionResults CPUIDEmu::Function_15h(uint32_t Leaf) {
   FEXCore::CPUID::FunctionResults Res{};
   // TSC frequency = ECX * EBX / EAX
-  uint32_t FrequencyHz = GetCycleCounterFrequency();
+  // Matches what RDTSC counts at, scaled when ScaledTSCFrequency is enabled
+  uint32_t FrequencyHz = CTX->CycleCounterFrequency;
   if (FrequencyHz) {
     Res.eax = 1;
     Res.ebx = 1;
@@ -808,7 +789,7 @@ FEXCore::CPUID::FunctionResults CPUIDEmu::Function_1Ah(uint32_t Leaf) {
 FEXCore::CPUID::FunctionResults CPUIDEmu::Function_4000_0000h(uint32_t Leaf) {
   FEXCore::CPUID::FunctionResults Res{};
   // Maximum supported hypervisor leafs
-  // We only expose the information leaf
+  // We expose the information leaf, the FEX leaf and the generic timing leaf
   //
   // Common courtesy to follow VMWare's "Hypervisor CPUID Interface proposal"
   // 4000_0000h - Information leaf. Advertising to the software which hypervisor this is
@@ -818,7 +799,7 @@ FEXCore::CPUID::FunctionResults CPUIDEmu::Function_4000_0000h(uint32_t Leaf) {
   // CPUID documentation information:
   // 4000_0000h - 4FFF_FFFFh - No existing or future CPU will return information in this range
   // Reserved entirely for VMs to do whatever they want.
-  Res.eax = 0x40000001;
+  Res.eax = 0x40000010;
 
   // EBX, EDX, ECX become the hypervisor ID signature
   constexpr static char HypervisorID[12] = "FEXIFEXIEMU";
@@ -845,6 +826,16 @@ FEXCore::CPUID::FunctionResults CPUIDEmu::Function_4000_0001h(uint32_t Leaf) {
   return Res;
 }
 
+// Generic timing information leaf
+FEXCore::CPUID::FunctionResults CPUIDEmu::Function_4000_0010h(uint32_t Leaf) {
+  FEXCore::CPUID::FunctionResults Res{};
+  // EAX = TSC frequency in kHz, same as leaf 15h reports
+  Res.eax = CTX->CycleCounterFrequency / 1000;
+  // EBX = Bus (local APIC timer) frequency in kHz, unknown
+  Res.ebx = 0;
+  return Res;
+}
+
 // Highest extended function implemented
 FEXCore::CPUID::FunctionResults CPUIDEmu::Function_8000_0000h(uint32_t Leaf) {
   FEXCore::CPUID::FunctionResults Res{};
@@ -1216,6 +1207,44 @@ FEXCore::CPUID::XCRResults CPUIDEmu::XCRFunction_0h() {
   return Res;
 }
 
+void CPUIDEmu::SetupFunctionCache() {
+  // The brand string is only per-CPU if the CPUs report different products
+  bool PerCPUProductName = false;
+  for (const auto &Data : PerCPUData) {
+    if (strcmp(Data.ProductName, PerCPUData[0].ProductName) != 0) {
+      PerCPUProductName = true;
+      break;
+    }
+  }
+
+  auto Fill = [this](CachedFunction &Cached, FunctionHandler Handler) {
+    for (uint32_t Leaf = 0; Leaf < CACHED_LEAVES; ++Leaf) {
+      Cached.Results[Leaf] = (this->*Handler)(Leaf);
+      Cached.LeafDependent |= memcmp(&Cached.Results[Leaf], &Cached.Results[0], sizeof(Cached.Results[0])) != 0;
+    }
+    Cached.Cacheable = true;
+  };
+
+  for (size_t i = 0; i < Primary.size(); ++i) {
+    // Hybrid information reports the core type of the current CPU
+    if (i == 0x1A && Hybrid) {
+      continue;
+    }
+    Fill(CachedPrimary[i], Primary[i]);
+  }
+
+  for (size_t i = 0; i < Hypervisor.size(); ++i) {
+    Fill(CachedHypervisor[i], Hypervisor[i]);
+  }
+
+  for (size_t i = 0; i < Extended.size(); ++i) {
+    if (i >= 0x2 && i <= 0x4 && PerCPUProductName) {
+      continue;
+    }
+    Fill(CachedExtended[i], Extended[i]);
+  }
+}
+
 void CPUIDEmu::Init(FEXCore::Context::ContextImpl *ctx) {
   CTX = ctx;
 
@@ -1226,6 +1255,9 @@ void CPUIDEmu::Init(FEXCore::Context::ContextImpl *ctx) {
   if (false && CTX->HostFeatures.SupportsAVX) {
     XCR0 |= XCR0_AVX;
   }
+
+  // Must be last, the cached results depend on everything above
+  SetupFunctionCache();
 }
 }
 
@@ -4,7 +4,9 @@
 #include <FEXCore/Config/Config.h>
 #include <FEXCore/fextl/vector.h>
 
+#include <array>
 #include <cstdint>
+#include <optional>
 #include <unordered_map>
 #include <utility>
 
@@ -34,6 +36,15 @@ public:
   void Init(FEXCore::Context::ContextImpl *ctx);
 
   FEXCore::CPUID::FunctionResults RunFunction(uint32_t Function, uint32_t Leaf) {
+    if (const auto Cached = GetCachedFunction(Function); Cached && Cached->Cacheable) {
+      if (!Cached->LeafDependent) {
+        return Cached->Results[0];
+      }
+      if (Leaf < CACHED_LEAVES) {
+        return Cached->Results[Leaf];
+      }
+    }
+
     if (Function < Primary.size()) {
       const auto Handler = Primary[Function];
       return (this->*Handler)(Leaf);
@@ -54,6 +65,28 @@ public:
     return Function_Reserved(Leaf);
   }
 
+  /**
+   * @brief Returns if a function gives the same result on every CPU for the lifetime of the process
+   *
+   * Such functions can be folded in to the IR when the function is known at compile time.
+   *
+   * @param Function - CPUID function
+   * @param Leaf - Sub-leaf, std::nullopt when it isn't known at compile time
+   */
+  bool IsConstantFunction(uint32_t Function, std::optional<uint32_t> Leaf) const {
+    const auto Cached = GetCachedFunction(Function);
+    if (!Cached) {
+      // Unimplemented functions always return zero
+      return true;
+    }
+
+    if (!Cached->Cacheable) {
+      return false;
+    }
+
+    return !Cached->LeafDependent || (Leaf && *Leaf < CACHED_LEAVES);
+  }
+
   FEXCore::CPUID::FunctionResults RunFunctionName(uint32_t Function, uint32_t Leaf, uint32_t CPU) {
     if (Function == 0x8000'0002U)
       return Function_8000_0002h(Leaf, CPU % PerCPUData.size());
@@ -130,6 +163,7 @@ private:
   FEXCore::CPUID::FunctionResults Function_1Ah(uint32_t Leaf);
   FEXCore::CPUID::FunctionResults Function_4000_0000h(uint32_t Leaf);
   FEXCore::CPUID::FunctionResults Function_4000_0001h(uint32_t Leaf);
+  FEXCore::CPUID::FunctionResults Function_4000_0010h(uint32_t Leaf);
   FEXCore::CPUID::FunctionResults Function_8000_0000h(uint32_t Leaf);
   FEXCore::CPUID::FunctionResults Function_8000_0001h(uint32_t Leaf);
   FEXCore::CPUID::FunctionResults Function_8000_0002h(uint32_t Leaf);
@@ -151,6 +185,7 @@ private:
   FEXCore::CPUID::XCRResults XCRFunction_0h();
 
   void SetupHostHybridFlag();
+  void SetupFunctionCache();
   static constexpr std::array<FunctionHandler, 27> Primary = {
     // 0: Highest function parameter and ID
     &CPUIDEmu::Function_0h,
@@ -221,11 +256,28 @@ private:
 #endif
   };
 
-  static constexpr std::array<FunctionHandler, 2> Hypervisor = {
+  static constexpr std::array<FunctionHandler, 0x11> Hypervisor = {
     // Hypervisor CPUID information leaf
     &CPUIDEmu::Function_4000_0000h,
     // FEX-Emu specific leaf
     &CPUIDEmu::Function_4000_0001h,
+    // 0x4000_0002 - 0x4000_000F: Reserved hypervisor specific leafs
+    &CPUIDEmu::Function_Reserved,
+    &CPUIDEmu::Function_Reserved,
+    &CPUIDEmu::Function_Reserved,
+    &CPUIDEmu::Function_Reserved,
+    &CPUIDEmu::Function_Reserved,
+    &CPUIDEmu::Function_Reserved,
+    &CPUIDEmu::Function_Reserved,
+    &CPUIDEmu::Function_Reserved,
+    &CPUIDEmu::Function_Reserved,
+    &CPUIDEmu::Function_Reserved,
+    &CPUIDEmu::Function_Reserved,
+    &CPUIDEmu::Function_Reserved,
+    &CPUIDEmu::Function_Reserved,
+    &CPUIDEmu::Function_Reserved,
+    // Generic timing information leaf
+    &CPUIDEmu::Function_4000_0010h,
   };
 
   static constexpr std::array<FunctionHandler, 32> Extended = {
@@ -302,5 +354,39 @@ private:
     // 0x8000'001F: AMD Secure Encryption
     &CPUIDEmu::Function_Reserved,
   };
+
+  // Sub-leaves cached for functions that use them, higher sub-leaves go through the handler
+  constexpr static uint32_t CACHED_LEAVES = 8;
+
+  // Results of a function, computed once at Init so RunFunction doesn't call through the handler tables
+  struct CachedFunction {
+    std::array<FEXCore::CPUID::FunctionResults, CACHED_LEAVES> Results{};
+    // Results depend on the sub-leaf, otherwise Results[0] is used for every sub-leaf
+    bool LeafDependent{};
+    // False for functions that depend on the CPU the thread is running on
+    bool Cacheable{};
+  };
+
+  std::array<CachedFunction, Primary.size()> CachedPrimary{};
+  std::array<CachedFunction, Hypervisor.size()> CachedHypervisor{};
+  std::array<CachedFunction, Extended.size()> CachedExtended{};
+
+  const CachedFunction *GetCachedFunction(uint32_t Function) const {
+    if (Function < CachedPrimary.size()) {
+      return &CachedPrimary[Function];
+    }
+
+    constexpr uint32_t HypervisorBase = 0x4000'0000;
+    if (Function >= HypervisorBase && Function < (HypervisorBase + CachedHypervisor.size())) {
+      return &CachedHypervisor[Function - HypervisorBase];
+    }
+
+    constexpr uint32_t ExtendedBase = 0x8000'0000;
+    if (Function >= ExtendedBase && Function < (ExtendedBase + CachedExtended.size())) {
+      return &CachedExtended[Function - ExtendedBase];
+    }
+
+    return nullptr;
+  }
 };
 }
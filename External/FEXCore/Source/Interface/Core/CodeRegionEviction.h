@@ -0,0 +1,68 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace FEXCore {
+/**
+ * @brief Picks which region of a full code buffer gets evicted next
+ *
+ * A thread's code buffer at its maximum size is split in to RegionCount regions that blocks never cross.
+ * Emitted code isn't relocatable, so hot blocks are kept compiled by evicting the region they ran the least in.
+ *
+ * Each region tracks when the cursor last started filling it, and the sum of the execution counters of the blocks
+ * starting in it. The regions filled most recently are never picked, their blocks haven't had the chance to run yet.
+ */
+template<size_t RegionCount>
+class CodeRegionEviction {
+public:
+  // The region the cursor is in and the one filled before it
+  constexpr static size_t ProtectedRegions = 2;
+  static_assert(RegionCount > ProtectedRegions, "Every region would be protected");
+
+  // Forgets the fill order, the cursor starts filling Region 0 again
+  void Reset() {
+    Generations = {};
+    NextGeneration = 0;
+    Filled(0);
+  }
+
+  // The cursor started filling Region
+  void Filled(size_t Region) {
+    Generations[Region] = ++NextGeneration;
+  }
+
+  /**
+   * @brief Returns the region to evict
+   *
+   * @param Heat - Execution count of the blocks in each region
+   *
+   * The coldest of the unprotected regions is picked, the one filled the longest ago on a tie.
+   * Without any counters this is the oldest region.
+   */
+  size_t Pick(const std::array<uint64_t, RegionCount> &Heat) const {
+    size_t Victim = RegionCount;
+    for (size_t Region = 0; Region < RegionCount; ++Region) {
+      if (IsProtected(Region)) {
+        continue;
+      }
+
+      if (Victim == RegionCount || Heat[Region] < Heat[Victim] ||
+          (Heat[Region] == Heat[Victim] && Generations[Region] < Generations[Victim])) {
+        Victim = Region;
+      }
+    }
+    return Victim;
+  }
+
+private:
+  bool IsProtected(size_t Region) const {
+    // Generations are handed out in order, so the newest ones are the last ProtectedRegions handed out
+    return Generations[Region] != 0 && Generations[Region] + ProtectedRegions > NextGeneration;
+  }
+
+  // 0 for regions that haven't been filled yet
+  std::array<uint64_t, RegionCount> Generations{};
+  uint64_t NextGeneration{};
+};
+}
@@ -0,0 +1,45 @@
+/*
+$info$
+tags: glue|driver
+desc: Aggregates the compile time cost of each JIT stage, and reports it at exit
+$end_info$
+*/
+
+#include "Interface/Core/CompileStats.h"
+
+#include <FEXCore/Utils/LogManager.h>
+
+namespace FEXCore {
+  CompileStats::Stat *CompileStats::GetStat(std::string_view Name) {
+    std::lock_guard lk(Lock);
+
+    auto [it, Inserted] = StatIndex.try_emplace(fextl::string(Name), Stats.size());
+    if (Inserted) {
+      Stats.emplace_back();
+      Names.emplace_back(Name);
+    }
+
+    return &Stats[it->second];
+  }
+
+  void CompileStats::Dump() {
+    std::lock_guard lk(Lock);
+
+    uint64_t TotalNanoseconds {};
+    for (const auto &Stat : Stats) {
+      TotalNanoseconds += Stat.Nanoseconds.load(std::memory_order_relaxed);
+    }
+
+    LogMan::Msg::IFmt("Compile profile: {:.3f}ms total", TotalNanoseconds / 1'000'000.0);
+    LogMan::Msg::IFmt("  {:<24} {:>10} {:>12} {:>10} {:>12}", "Stage", "Count", "Time (ms)", "Avg (us)", "IR delta");
+    for (size_t i = 0; i < Stats.size(); ++i) {
+      const auto &Stat = Stats[i];
+      const uint64_t Count = Stat.Count.load(std::memory_order_relaxed);
+      const uint64_t Nanoseconds = Stat.Nanoseconds.load(std::memory_order_relaxed);
+      const double Average = Count ? Nanoseconds / 1000.0 / Count : 0.0;
+
+      LogMan::Msg::IFmt("  {:<24} {:>10} {:>12.3f} {:>10.3f} {:>12}", Names[i], Count, Nanoseconds / 1'000'000.0, Average,
+                        Stat.SizeDelta.load(std::memory_order_relaxed));
+    }
+  }
+}
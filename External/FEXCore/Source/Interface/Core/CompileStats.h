@@ -0,0 +1,76 @@
+#pragma once
+#include <FEXCore/fextl/deque.h>
+#include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/unordered_map.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+#include <time.h>
+
+namespace FEXCore {
+/**
+ * @brief Compile time cost of each stage of the JIT, aggregated over every thread in the process
+ *
+ * Stages are the frontend decoder, the OpcodeDispatcher, each IR pass and the backend.
+ * IR passes also track how many IR ops they add or remove.
+ */
+class CompileStats {
+public:
+  struct Stat {
+    std::atomic<uint64_t> Count {};
+    std::atomic<uint64_t> Nanoseconds {};
+    // Change in live IR op count, negative when ops were removed
+    std::atomic<int64_t> SizeDelta {};
+  };
+
+  /**
+   * @brief Returns the stat for a stage, creating it on first use
+   *
+   * @return Pointer to the stat, it remains valid for the lifetime of the CompileStats
+   */
+  Stat *GetStat(std::string_view Name);
+
+  /**
+   * @brief Logs every stat in the order they were created
+   */
+  void Dump();
+
+  static uint64_t GetTime() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1'000'000'000ULL + ts.tv_nsec;
+  }
+
+private:
+  std::mutex Lock;
+
+  // A deque never moves its elements on growth, so callers can keep pointers in to Stats
+  fextl::deque<Stat> Stats;
+  fextl::vector<fextl::string> Names;
+  fextl::unordered_map<fextl::string, size_t> StatIndex;
+};
+
+/**
+ * @brief Adds the time spent in the scope to a stat, does nothing if the stat is nullptr
+ */
+class ScopedCompileStat final {
+public:
+  explicit ScopedCompileStat(CompileStats::Stat *Stat)
+    : Stat {Stat}
+    , Begin {Stat ? CompileStats::GetTime() : 0} {}
+
+  ~ScopedCompileStat() {
+    if (Stat) {
+      Stat->Count.fetch_add(1, std::memory_order_relaxed);
+      Stat->Nanoseconds.fetch_add(CompileStats::GetTime() - Begin, std::memory_order_relaxed);
+    }
+  }
+
+private:
+  CompileStats::Stat *Stat;
+  uint64_t Begin;
+};
+}
@@ -48,6 +48,7 @@ $end_info$
 #include <FEXCore/Utils/LogManager.h>
 #include <FEXCore/Utils/Threads.h>
 #include <FEXCore/Utils/Profiler.h>
+#include <FEXCore/Utils/Telemetry.h>
 #include <FEXCore/fextl/fmt.h>
 #include <FEXCore/fextl/memory.h>
 #include <FEXCore/fextl/set.h>
@@ -59,6 +60,7 @@ $end_info$
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <bit>
 #include <chrono>
 #include <condition_variable>
 #include <fcntl.h>
@@ -140,9 +142,42 @@ namespace FEXCore::Context {
 #ifdef BLOCKSTATS
     BlockData = std::make_unique<FEXCore::BlockSamplingData>();
 #endif
-    if (Config.CacheObjectCodeCompilation() != FEXCore::Config::ConfigObjectCodeHandler::CONFIG_NONE) {
+    if (Config.ProfileBlockExecution()) {
+      BlockProfile = fextl::make_unique<FEXCore::BlockExecutionProfile>();
+    }
+    if (Config.DedupBlockIR()) {
+      IRDedupCache = fextl::make_unique<FEXCore::BlockIRDedupCache>();
+    }
+    if (Config.RemapIRCacheSize()) {
+      RemapCache = fextl::make_unique<FEXCore::RemapIRCache>(static_cast<size_t>(Config.RemapIRCacheSize()) * 1024 * 1024);
+    }
+    if (Config.ProfileCompilation()) {
+      CompileProfile = fextl::make_unique<FEXCore::CompileStats>();
+      CompileStages[0] = {
+        .Frontend = CompileProfile->GetStat("Frontend"),
+        .OpDispatcher = CompileProfile->GetStat("OpDispatcher"),
+        .Codegen = CompileProfile->GetStat("Codegen"),
+      };
+      CompileStages[1] = {
+        .Frontend = CompileProfile->GetStat("Tier0 Frontend"),
+        .OpDispatcher = CompileProfile->GetStat("Tier0 OpDispatcher"),
+        .Codegen = CompileProfile->GetStat("Tier0 Codegen"),
+      };
+    }
+    if (Config.ProfileFallbacks()) {
+      FallbackProfile = fextl::make_unique<FEXCore::FallbackProfile>();
+    }
+    if (!Config.RecordBlockCorpus().empty()) {
+      BlockCorpus = fextl::make_unique<FEXCore::BlockCorpusRecorder>(Config.RecordBlockCorpus(), Config.Is64BitMode());
+    }
+    // Cached code objects don't carry fallback or block counters
+    if (Config.CacheObjectCodeCompilation() != FEXCore::Config::ConfigObjectCodeHandler::CONFIG_NONE && !FallbackProfile && !BlockProfile) {
       CodeObjectCacheService = fextl::make_unique<FEXCore::CodeSerialize::CodeObjectSerializeService>(this);
     }
+    // Same restriction for AOT host code
+    if (Config.AOTIRHostCode() && !FallbackProfile && !BlockProfile) {
+      IRCaptureCache.InitializeHostCode();
+    }
     if (!Config.Is64BitMode()) {
       // When operating in 32-bit mode, the virtual memory we care about is only the lower 32-bits.
       Config.VirtualMemSize = 1ULL << 32;
@@ -155,6 +190,15 @@ namespace FEXCore::Context {
       Symbols.InitFile();
     }
 
+    if (Config.JITDump()) {
+      Symbols.InitJITDump();
+    }
+
+    // The context is created on the thread that all guest threads descend from, they inherit the memory model
+    if (Config.TSOEnabled() && HostFeatures.SupportsHardwareTSO && FEXCore::HostFeatures::EnableHardwareTSO()) {
+      SupportsHardwareTSO = true;
+    }
+
     // Track atomic TSO emulation configuration.
     UpdateAtomicTSOEmulationConfig();
   }
@@ -180,6 +224,8 @@ namespace FEXCore::Context {
       }
       Threads.clear();
     }
+
+    RecycledCompilerStates.clear();
   }
 
   uint64_t ContextImpl::RestoreRIPFromHostPC(FEXCore::Core::InternalThreadState *Thread, uint64_t HostPC) {
@@ -221,6 +267,88 @@ namespace FEXCore::Context {
     return Frame->State.rip;
   }
 
+  namespace {
+    // Bit positions of the flags packed in to NZCV, this must match OpDispatchBuilder::IndexNZCV
+    struct NZCVMapping {
+      uint32_t EFLAGSBit;
+      uint32_t NZCVBit;
+    };
+    constexpr std::array<NZCVMapping, 4> NZCVFlags = {{
+      {FEXCore::X86State::RFLAG_OF_LOC, 28},
+      {FEXCore::X86State::RFLAG_CF_LOC, 29},
+      {FEXCore::X86State::RFLAG_ZF_LOC, 30},
+      {FEXCore::X86State::RFLAG_SF_LOC, 31},
+    }};
+  }
+
+  uint32_t ContextImpl::ReconstructCompactedEFLAGS(const FEXCore::Core::CPUState *State) const {
+    uint32_t EFLAGS{};
+
+    for (size_t i = 0; i < FEXCore::Core::CPUState::NUM_EFLAG_BITS; ++i) {
+      switch (i) {
+        case FEXCore::X86State::RFLAG_CF_LOC:
+        case FEXCore::X86State::RFLAG_ZF_LOC:
+        case FEXCore::X86State::RFLAG_SF_LOC:
+        case FEXCore::X86State::RFLAG_OF_LOC:
+          // Handled through NZCV below
+          break;
+        case FEXCore::X86State::RFLAG_PF_LOC:
+          // Stored as the inverted result, PF is its parity
+          EFLAGS |= (std::popcount(State->flags[i]) & 1) << i;
+          break;
+        case FEXCore::X86State::RFLAG_AF_LOC:
+          // Stored as Src1 ^ Src2 ^ Res, AF is bit 4 which is also its EFLAGS position
+          EFLAGS |= State->flags[i] & (1U << FEXCore::X86State::RFLAG_AF_LOC);
+          break;
+        case FEXCore::X86State::RFLAG_NZCV_LOC:
+        case FEXCore::X86State::RFLAG_NZCV_1_LOC:
+        case FEXCore::X86State::RFLAG_NZCV_2_LOC:
+        case FEXCore::X86State::RFLAG_NZCV_3_LOC:
+          // Not architectural EFLAGS bits
+          break;
+        default:
+          EFLAGS |= uint32_t{State->flags[i]} << i;
+          break;
+      }
+    }
+
+    uint32_t NZCV;
+    memcpy(&NZCV, &State->flags[FEXCore::X86State::RFLAG_NZCV_LOC], sizeof(NZCV));
+    for (const auto &Flag : NZCVFlags) {
+      EFLAGS |= ((NZCV >> Flag.NZCVBit) & 1) << Flag.EFLAGSBit;
+    }
+
+    return EFLAGS;
+  }
+
+  void ContextImpl::SetFlagsFromCompactedEFLAGS(FEXCore::Core::CPUState *State, uint32_t EFLAGS) const {
+    for (size_t i = 0; i < FEXCore::Core::CPUState::NUM_EFLAG_BITS; ++i) {
+      switch (i) {
+        case FEXCore::X86State::RFLAG_AF_LOC:
+          State->flags[i] = EFLAGS & (1U << FEXCore::X86State::RFLAG_AF_LOC);
+          break;
+        case FEXCore::X86State::RFLAG_NZCV_LOC:
+        case FEXCore::X86State::RFLAG_NZCV_1_LOC:
+        case FEXCore::X86State::RFLAG_NZCV_2_LOC:
+        case FEXCore::X86State::RFLAG_NZCV_3_LOC:
+          break;
+        default:
+          // This includes PF, a single set bit has odd parity which decodes back to PF set
+          State->flags[i] = (EFLAGS & (1U << i)) ? 1 : 0;
+          break;
+      }
+    }
+
+    uint32_t NZCV{};
+    for (const auto &Flag : NZCVFlags) {
+      NZCV |= ((EFLAGS >> Flag.EFLAGSBit) & 1) << Flag.NZCVBit;
+    }
+    memcpy(&State->flags[FEXCore::X86State::RFLAG_NZCV_LOC], &NZCV, sizeof(NZCV));
+
+    State->flags[FEXCore::X86State::RFLAG_RESERVED_LOC] = 1;
+    State->flags[FEXCore::X86State::RFLAG_IF_LOC] = 1;
+  }
+
   FEXCore::Core::InternalThreadState* ContextImpl::InitCore(uint64_t InitialRIP, uint64_t StackPointer) {
     // Initialize the CPU core signal handlers & DispatcherConfig
     switch (Config.Core) {
@@ -256,10 +384,22 @@ namespace FEXCore::Context {
     ERROR_AND_DIE_FMT("FEXCore has been compiled with an unknown target");
 #endif
 
+    if (Config.SharedCodeCache && Config.Core == FEXCore::Config::CONFIG_IRJIT) {
+      SharedLookupCache = fextl::make_unique<FEXCore::LookupCache>(this, true);
+      SharedCodeArena = fextl::make_unique<FEXCore::CPU::CPUBackend::SharedCodeArena>();
+    }
+
+#ifndef _WIN32
+    if (Config.NUMAPlacement) {
+      ThreadPlacement = fextl::make_unique<FEXCore::NUMA::Placement>();
+    }
+#endif
+
     // Set up the SignalDelegator config since core is initialized.
     FEXCore::SignalDelegator::SignalDelegatorConfig SignalConfig {
       .StaticRegisterAllocation = DispatcherConfig.StaticRegisterAllocation,
       .SupportsAVX = HostFeatures.SupportsAVX,
+      .SupportsFlushInputsToZero = HostFeatures.SupportsFlushInputsToZero,
 
       .DispatcherBegin = Dispatcher->Start,
       .DispatcherEnd = Dispatcher->End,
@@ -363,8 +503,45 @@ namespace FEXCore::Context {
 
     // Tell all the threads that they should pause
     std::lock_guard<std::mutex> lk(ThreadCreationMutex);
+    if (!Config.Safepoints) {
+      for (auto &Thread : Threads) {
+        // A thread stopped by the debugger is already asleep, a pause signal would nest a second sleep
+        if (Thread->RunningEvents.GdbStoppedAtBlockEntry.load()) {
+          continue;
+        }
+        SignalDelegation->SignalThread(Thread, FEXCore::Core::SignalEvent::Pause);
+      }
+      return;
+    }
+
+    // Ask every running thread to stop at its next block entry
+    size_t Requested{};
+    for (auto &Thread : Threads) {
+      if (Thread->RunningEvents.Running.load() && !Thread->RunningEvents.ThreadSleeping.load()) {
+        Thread->CurrentFrame->SafepointRequested.store(1);
+        ++Requested;
+      }
+    }
+
+    if (Requested) {
+      // Most threads get there almost immediately.
+      // The ones sitting in a syscall or a long running multiblock loop won't.
+      std::unique_lock<std::mutex> idlelk(IdleWaitMutex);
+      IdleWaitCV.wait_for(idlelk, std::chrono::milliseconds(10),
+        [this] {
+          return IdleWaitRefCount.load() == 0;
+      });
+    }
+
+    // Take back any request that wasn't claimed and fall back to a signal
     for (auto &Thread : Threads) {
-      SignalDelegation->SignalThread(Thread, FEXCore::Core::SignalEvent::Pause);
+      if (Thread->RunningEvents.GdbStoppedAtBlockEntry.load()) {
+        continue;
+      }
+      uint32_t Expected = 1;
+      if (Thread->CurrentFrame->SafepointRequested.compare_exchange_strong(Expected, 0)) {
+        SignalDelegation->SignalThread(Thread, FEXCore::Core::SignalEvent::Pause);
+      }
     }
   }
 
@@ -381,12 +558,16 @@ namespace FEXCore::Context {
     // Spin up all the threads
     std::lock_guard<std::mutex> lk(ThreadCreationMutex);
     for (auto &Thread : Threads) {
+      // Also drops any pending debugger stop, a thread stopped on a breakpoint runs past it once
+      Thread->CurrentFrame->GdbStop = Thread->RunningEvents.GdbStoppedAtBlockEntry.load() ?
+        FEXCore::Core::CpuStateFrame::GDB_RESUME : FEXCore::Core::CpuStateFrame::GDB_RUN;
       Thread->SignalReason.store(FEXCore::Core::SignalEvent::Return);
     }
 
     for (auto &Thread : Threads) {
       Thread->StartRunning.NotifyAll();
     }
+    Running = true;
   }
 
   void ContextImpl::WaitForThreadsToRun() {
@@ -406,23 +587,11 @@ namespace FEXCore::Context {
   }
 
   void ContextImpl::Step() {
-    {
-      std::lock_guard<std::mutex> lk(ThreadCreationMutex);
-      // Walk the threads and tell them to clear their caches
-      // Useful when our block size is set to a large number and we need to step a single instruction
-      for (auto &Thread : Threads) {
-        ClearCodeCache(Thread);
-      }
+    // Each thread stops again by itself, the gdb server reports it
+    std::lock_guard<std::mutex> lk(ThreadCreationMutex);
+    for (auto &Thread : Threads) {
+      ResumeGdbThread(Thread, true);
     }
-    CoreRunningMode PreviousRunningMode = this->Config.RunningMode;
-    int64_t PreviousMaxIntPerBlock = this->Config.MaxInstPerBlock;
-    this->Config.RunningMode = FEXCore::Context::CoreRunningMode::MODE_SINGLESTEP;
-    this->Config.MaxInstPerBlock = 1;
-    Run();
-    WaitForThreadsToRun();
-    WaitForIdle();
-    this->Config.RunningMode = PreviousRunningMode;
-    this->Config.MaxInstPerBlock = PreviousMaxIntPerBlock;
   }
 
   void ContextImpl::Stop(bool IgnoreCurrentThread) {
@@ -491,11 +660,24 @@ namespace FEXCore::Context {
 
       // Don't return if a custom exit handling the exit
       if (!CustomExitHandler || reason == ExitReason::EXIT_SHUTDOWN) {
+        DumpProfiles();
         return reason;
       }
     }
   }
 
+  void ContextImpl::DumpProfiles() {
+    if (BlockProfile) {
+      BlockProfile->Dump(Config.ProfileBlockExecutionTopN);
+    }
+    if (CompileProfile) {
+      CompileProfile->Dump();
+    }
+    if (FallbackProfile) {
+      FallbackProfile->Dump(Config.ProfileBlockExecutionTopN, Config.ProfileFallbacksFile);
+    }
+  }
+
   void ContextImpl::ExecuteThread(FEXCore::Core::InternalThreadState *Thread) {
     Dispatcher->ExecuteDispatch(Thread->CurrentFrame);
   }
@@ -550,6 +732,8 @@ namespace FEXCore::Context {
     if (ThunkHandler) {
       ThunkHandler->RegisterTLSState(Thread);
     }
+
+    Thread->CurrentFrame->Pointers.Common.TelemetryCounters = reinterpret_cast<uint64_t>(FEXCore::Telemetry::RegisterThreadCounters());
   }
 
   void ContextImpl::RunThread(FEXCore::Core::InternalThreadState *Thread) {
@@ -560,7 +744,13 @@ namespace FEXCore::Context {
   void ContextImpl::InitializeCompiler(FEXCore::Core::InternalThreadState* Thread) {
     Thread->OpDispatcher = fextl::make_unique<FEXCore::IR::OpDispatchBuilder>(this);
     Thread->OpDispatcher->SetMultiblock(Config.Multiblock);
-    Thread->LookupCache = fextl::make_unique<FEXCore::LookupCache>(this);
+    if (IsCodeCacheShared()) {
+      Thread->LookupCache = SharedLookupCache.get();
+    }
+    else {
+      Thread->LocalLookupCache = fextl::make_unique<FEXCore::LookupCache>(this);
+      Thread->LookupCache = Thread->LocalLookupCache.get();
+    }
     Thread->FrontendDecoder = fextl::make_unique<FEXCore::Frontend::Decoder>(this);
     Thread->PassManager = fextl::make_unique<FEXCore::IR::PassManager>();
     Thread->PassManager->RegisterExitHandler([this]() {
@@ -568,7 +758,12 @@ namespace FEXCore::Context {
     });
 
     Thread->CurrentFrame->Pointers.Common.L1Pointer = Thread->LookupCache->GetL1Pointer();
+    Thread->CurrentFrame->Pointers.Common.L1Mask = Thread->LookupCache->GetL1Mask();
+    if (Thread->LocalLookupCache) {
+      Thread->LocalLookupCache->SetL1MaskStorage(&Thread->CurrentFrame->Pointers.Common.L1Mask);
+    }
     Thread->CurrentFrame->Pointers.Common.L2Pointer = Thread->LookupCache->GetPagePointer();
+    Thread->CurrentFrame->Pointers.Common.LookupCacheEpochPointer = Thread->LookupCache->GetInvalidationEpochsPointer();
 
     Dispatcher->InitThreadPointers(Thread);
 
@@ -589,7 +784,19 @@ namespace FEXCore::Context {
       break;
 #endif
     case FEXCore::Config::CONFIG_IRJIT:
-      Thread->PassManager->InsertRegisterAllocationPass(DoSRA, HostFeatures.SupportsAVX);
+      Thread->PassManager->InsertRegisterAllocationPass(DoSRA, HostFeatures.SupportsAVX, Config.RegisterAllocator == FEXCore::Config::CONFIG_RA_LINEAR);
+
+      // The JIT configures the register set of every RA pass, so the tier 0 pipeline must exist before the backend
+      if (IsTieredCompilationEnabled()) {
+        Thread->Tier0PassManager = fextl::make_unique<FEXCore::IR::PassManager>();
+        Thread->Tier0PassManager->RegisterExitHandler([this]() {
+            Stop(false /* Ignore current thread */);
+        });
+        Thread->Tier0PassManager->AddMinimalPasses(this);
+        Thread->Tier0PassManager->AddDefaultValidationPasses();
+        Thread->Tier0PassManager->RegisterSyscallHandler(SyscallHandler);
+        Thread->Tier0PassManager->InsertRegisterAllocationPass(DoSRA, HostFeatures.SupportsAVX, Config.RegisterAllocator != FEXCore::Config::CONFIG_RA_GRAPH);
+      }
 
 #if (_M_X86_64 && JIT_X86_64)
       Thread->CPUBackend = FEXCore::CPU::CreateX86JITCore(this, Thread);
@@ -608,7 +815,88 @@ namespace FEXCore::Context {
       break;
     }
 
+    if (CompileProfile) {
+      Thread->PassManager->RegisterCompileStats(CompileProfile.get(), "");
+      if (Thread->Tier0PassManager) {
+        Thread->Tier0PassManager->RegisterCompileStats(CompileProfile.get(), "Tier0 ");
+      }
+    }
+
     Thread->PassManager->Finalize();
+    if (Thread->Tier0PassManager) {
+      Thread->Tier0PassManager->Finalize();
+    }
+  }
+
+  uint64_t *ContextImpl::GetBlockProfileCounter(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP) {
+    auto AOTIRCacheEntry = SyscallHandler->LookupAOTIRCacheEntry(Thread, GuestRIP);
+    if (AOTIRCacheEntry.Entry) {
+      return BlockProfile->GetCounter(GuestRIP, &AOTIRCacheEntry.Entry->Filename, GuestRIP - AOTIRCacheEntry.VAFileStart);
+    }
+    return BlockProfile->GetCounter(GuestRIP, nullptr, 0);
+  }
+
+  uint64_t *ContextImpl::GetFallbackProfileCounter(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP, uint32_t HandlerIndex, FEXCore::IR::IROps Op) {
+    // IR loaded from the AOT cache has no decoded instructions to name, the decoder may still hold an older block
+    std::string_view Instruction {};
+    for (const auto &Block : Thread->FrontendDecoder->GetDecodedBlockInfo()->Blocks) {
+      if (GuestRIP < Block.Entry || !Instruction.empty()) {
+        continue;
+      }
+      for (size_t i = 0; i < Block.NumInstructions; ++i) {
+        const auto &Inst = Block.DecodedInstructions[i];
+        if (Inst.PC == GuestRIP && Inst.TableInfo && Inst.TableInfo->Name) {
+          Instruction = Inst.TableInfo->Name;
+          break;
+        }
+      }
+    }
+
+    auto AOTIRCacheEntry = SyscallHandler->LookupAOTIRCacheEntry(Thread, GuestRIP);
+    if (AOTIRCacheEntry.Entry) {
+      return FallbackProfile->GetCounter(GuestRIP, HandlerIndex, Instruction, FEXCore::IR::GetName(Op), &AOTIRCacheEntry.Entry->Filename, GuestRIP - AOTIRCacheEntry.VAFileStart);
+    }
+    return FallbackProfile->GetCounter(GuestRIP, HandlerIndex, Instruction, FEXCore::IR::GetName(Op), nullptr, 0);
+  }
+
+  uint32_t *ContextImpl::GetTier0Counter(uint64_t GuestRIP) {
+    // The profile survives invalidation and eviction, a block that was already hot skips tier 0 when it is compiled again
+    if (BlockProfile && BlockProfile->GetCount(GuestRIP) >= Config.TierUpThreshold) {
+      return nullptr;
+    }
+
+    std::lock_guard lk(TierUpCountersMutex);
+    auto [it, Inserted] = TierUpCounters.try_emplace(GuestRIP, nullptr);
+    if (Inserted) {
+      if (FreeTierUpCounters.empty()) {
+        it->second = &TierUpCounterStorage.emplace_back();
+      }
+      else {
+        it->second = FreeTierUpCounters.back();
+        FreeTierUpCounters.pop_back();
+      }
+      *it->second = 0;
+    }
+
+    if (__atomic_load_n(it->second, __ATOMIC_RELAXED) >= Config.TierUpThreshold) {
+      // Hot block, compile with the full pipeline
+      return nullptr;
+    }
+    return it->second;
+  }
+
+  void ContextImpl::EraseTierUpCounters(const fextl::vector<uint64_t> &Blocks) {
+    std::lock_guard lk(TierUpCountersMutex);
+    for (auto Address : Blocks) {
+      auto it = TierUpCounters.find(Address);
+      if (it == TierUpCounters.end()) {
+        continue;
+      }
+
+      // Tier 0 code that is still racing the invalidation can only bump the recycled counter of another block
+      FreeTierUpCounters.push_back(it->second);
+      TierUpCounters.erase(it);
+    }
   }
 
   FEXCore::Core::InternalThreadState* ContextImpl::CreateThread(FEXCore::Core::CPUState *NewThreadState, uint64_t ParentTID) {
@@ -623,8 +911,10 @@ namespace FEXCore::Context {
     // Set up the thread manager state
     Thread->ThreadManager.parent_tid = ParentTID;
 
-    InitializeCompiler(Thread);
-    InitializeThreadData(Thread);
+    if (!AdoptRecycledCompilerState(Thread)) {
+      InitializeCompiler(Thread);
+      InitializeThreadData(Thread);
+    }
 
     Thread->CurrentFrame->State.DeferredSignalRefCount.Store(0);
     Thread->CurrentFrame->State.DeferredSignalFaultAddress = reinterpret_cast<Core::NonAtomicRefCounter<uint64_t>*>(FEXCore::Allocator::VirtualAlloc(4096));
@@ -638,6 +928,78 @@ namespace FEXCore::Context {
     return Thread;
   }
 
+  bool ContextImpl::AdoptRecycledCompilerState(FEXCore::Core::InternalThreadState *Thread) {
+    RecycledCompilerState State{};
+    {
+      std::lock_guard lk(ThreadCreationMutex);
+      if (RecycledCompilerStates.empty()) {
+        return false;
+      }
+
+      State = std::move(RecycledCompilerStates.back());
+      RecycledCompilerStates.pop_back();
+    }
+
+    Thread->OpDispatcher = std::move(State.OpDispatcher);
+    Thread->CPUBackend = std::move(State.CPUBackend);
+    Thread->LocalLookupCache = std::move(State.LocalLookupCache);
+    Thread->LookupCache = IsCodeCacheShared() ? SharedLookupCache.get() : Thread->LocalLookupCache.get();
+    Thread->FrontendDecoder = std::move(State.FrontendDecoder);
+    Thread->PassManager = std::move(State.PassManager);
+    Thread->Tier0PassManager = std::move(State.Tier0PassManager);
+
+    // Dispatcher, backend and lookup cache pointers are all still valid for the new frame
+    Thread->CurrentFrame->Pointers = State.Pointers;
+    if (Thread->LocalLookupCache) {
+      Thread->LocalLookupCache->SetL1MaskStorage(&Thread->CurrentFrame->Pointers.Common.L1Mask);
+    }
+    Thread->CPUBackend->SetThreadState(Thread);
+    Thread->CTX = this;
+    return true;
+  }
+
+  void ContextImpl::RecycleCompilerState(FEXCore::Core::InternalThreadState *Thread) {
+    // Custom backends may keep their own thread references around
+    if (CoreShuttingDown.load() || !Thread->CPUBackend || Config.Core == FEXCore::Config::CONFIG_CUSTOM) {
+      return;
+    }
+
+    {
+      std::lock_guard lk(ThreadCreationMutex);
+      if (RecycledCompilerStates.size() >= MaxRecycledCompilerStates) {
+        return;
+      }
+    }
+
+    if (!IsCodeCacheShared()) {
+      // Parked caches would miss invalidations, so they start out empty for the next thread.
+      // Nothing is executing from this thread's code anymore.
+      Thread->CurrentFrame->SignalHandlerRefCounter = 0;
+      ClearCodeCache(Thread);
+    }
+
+    std::lock_guard lk(ThreadCreationMutex);
+    if (RecycledCompilerStates.size() >= MaxRecycledCompilerStates) {
+      return;
+    }
+
+    if (Thread->LocalLookupCache) {
+      // The frame goes away with the thread, the adopting thread points the cache at its own
+      Thread->LocalLookupCache->SetL1MaskStorage(nullptr);
+    }
+
+    RecycledCompilerStates.emplace_back(RecycledCompilerState {
+      .OpDispatcher = std::move(Thread->OpDispatcher),
+      .CPUBackend = std::move(Thread->CPUBackend),
+      .LocalLookupCache = std::move(Thread->LocalLookupCache),
+      .FrontendDecoder = std::move(Thread->FrontendDecoder),
+      .PassManager = std::move(Thread->PassManager),
+      .Tier0PassManager = std::move(Thread->Tier0PassManager),
+      .Pointers = Thread->CurrentFrame->Pointers,
+    });
+    Thread->LookupCache = nullptr;
+  }
+
   void ContextImpl::DestroyThread(FEXCore::Core::InternalThreadState *Thread) {
     // remove new thread object
     {
@@ -649,6 +1011,8 @@ namespace FEXCore::Context {
       Threads.erase(It);
     }
 
+    RecycleCompilerState(Thread);
+
     if (Thread->ExecutionThread &&
         Thread->ExecutionThread->IsSelf()) {
       // To be able to delete a thread from itself, we need to detached the std::thread object
@@ -702,6 +1066,12 @@ namespace FEXCore::Context {
     Threads.clear();
     Threads.push_back(LiveThread);
 
+    if (Config.SealCodeOnFork) {
+      // Everything compiled so far is still usable and still shared with the parent.
+      // Appending to the same buffer would copy those pages one by one.
+      LiveThread->CPUBackend->SealCodeBuffer();
+    }
+
     // We now only have one thread
     IdleWaitRefCount = 1;
 
@@ -715,8 +1085,8 @@ namespace FEXCore::Context {
   }
 #endif
 
-  void ContextImpl::AddBlockMapping(FEXCore::Core::InternalThreadState *Thread, uint64_t Address, void *Ptr) {
-    Thread->LookupCache->AddBlockMapping(Address, Ptr);
+  uintptr_t ContextImpl::AddBlockMapping(FEXCore::Core::InternalThreadState *Thread, uint64_t Address, void *Ptr) {
+    return Thread->LookupCache->AddBlockMapping(Address, Ptr);
   }
 
   void ContextImpl::ClearCodeCache(FEXCore::Core::InternalThreadState *Thread) {
@@ -729,9 +1099,82 @@ namespace FEXCore::Context {
     }
     std::lock_guard<std::recursive_mutex> lk(Thread->LookupCache->WriteLock);
 
+    FEXCORE_TELEMETRY_COUNTER_INC(COUNTER_CODE_CACHE_FLUSHES);
+
     Thread->LookupCache->ClearCache();
     Thread->CPUBackend->ClearCache();
-    Thread->DebugStore.clear();
+
+    // Return stack entries point in to the code that was just thrown away
+    auto &ReturnStack = Thread->CurrentFrame->ReturnStack;
+    std::fill(std::begin(ReturnStack), std::end(ReturnStack), FEXCore::Core::CpuStateFrame::ReturnStackEntry{});
+
+    if (IsCodeCacheShared()) {
+      // Every thread's DebugStore and step blocks refer to the shared code buffer
+      std::lock_guard lkThreads(ThreadCreationMutex);
+      for (auto &ThreadEntry : Threads) {
+        ThreadEntry->DebugStore.clear();
+        ThreadEntry->DebugStepBlocks.clear();
+      }
+      // The thread might not be tracked yet
+      Thread->DebugStore.clear();
+      Thread->DebugStepBlocks.clear();
+    }
+    else {
+      Thread->DebugStore.clear();
+      Thread->DebugStepBlocks.clear();
+    }
+  }
+
+  void ContextImpl::EvictCodeRange(FEXCore::Core::InternalThreadState *Thread, uintptr_t Begin, uintptr_t End) {
+    FEXCORE_PROFILE_INSTANT("EvictCodeRange");
+    LOGMAN_THROW_AA_FMT(!IsCodeCacheShared(), "Can't evict code from a shared code cache");
+
+    {
+      // Serialization jobs can still be reading host code from the range
+      CodeSerialize::CodeObjectSerializeService::WaitForEmptyJobQueue(&Thread->ObjectCacheRefCounter);
+    }
+    std::lock_guard<std::recursive_mutex> lk(Thread->LookupCache->WriteLock);
+
+    auto Evicted = Thread->LookupCache->EvictHostRange(Begin, End);
+    for (auto GuestRIP : Evicted) {
+      Thread->DebugStore.erase(GuestRIP);
+    }
+
+    for (auto &Entry : Thread->CurrentFrame->ReturnStack) {
+      if (Entry.HostCode >= Begin && Entry.HostCode < End) {
+        Entry = {};
+      }
+    }
+
+    for (auto it = Thread->DebugStepBlocks.begin(); it != Thread->DebugStepBlocks.end();) {
+      if (it->second >= Begin && it->second < End) {
+        it = Thread->DebugStepBlocks.erase(it);
+      }
+      else {
+        ++it;
+      }
+    }
+  }
+
+  void ContextImpl::GetCodeRegionHeat(FEXCore::Core::InternalThreadState *Thread, uintptr_t Begin, size_t RegionSize, std::span<uint64_t> Heat) {
+    std::fill(Heat.begin(), Heat.end(), 0);
+    const auto Blocks = Thread->LookupCache->GetBlocksInHostRange(Begin, Begin + RegionSize * Heat.size());
+
+    if (IsTieredCompilationEnabled()) {
+      std::lock_guard lk(TierUpCountersMutex);
+      for (const auto &Block : Blocks) {
+        auto it = TierUpCounters.find(Block.GuestCode);
+        if (it != TierUpCounters.end()) {
+          Heat[(Block.HostCode - Begin) / RegionSize] += __atomic_load_n(it->second, __ATOMIC_RELAXED);
+        }
+      }
+    }
+
+    if (BlockProfile) {
+      for (const auto &Block : Blocks) {
+        Heat[(Block.HostCode - Begin) / RegionSize] += BlockProfile->GetCount(Block.GuestCode);
+      }
+    }
   }
 
   static void IRDumper(FEXCore::Core::InternalThreadState *Thread, IR::IREmitter *IREmitter, uint64_t GuestRIP, IR::RegisterAllocationData* RA) {
@@ -766,8 +1209,24 @@ namespace FEXCore::Context {
     }
   }
 
-  ContextImpl::GenerateIRResult ContextImpl::GenerateIR(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP, bool ExtendedDebugInfo) {
-    FEXCORE_PROFILE_SCOPED("GenerateIR");
+  ContextImpl::GenerateIRResult ContextImpl::GenerateIR(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP, bool ExtendedDebugInfo, uint32_t *Tier0Counter, uint64_t *ProfileCounter, bool DebugStep) {
+    FEXCORE_PROFILE_SCOPED_ARG("GenerateIR", GuestRIP);
+
+    const bool Tier0 = Tier0Counter != nullptr;
+    auto PassManager = Tier0 ? Thread->Tier0PassManager.get() : Thread->PassManager.get();
+    const auto &Stages = CompileStages[Tier0];
+
+    // A jump back to a breakpoint inside of a multiblock would skip the entry check
+    const bool NoMultiblock = Tier0 || DebugStep || IsGdbBreakpoint(GuestRIP);
+
+    // Tier 0 and debugger blocks are compiled without multiblock, restored at the end of IR generation
+    const bool FrontendMultiblock = Thread->FrontendDecoder->GetMultiblock();
+    const bool DispatcherMultiblock = Thread->OpDispatcher->GetMultiblock();
+    if (NoMultiblock) {
+      Thread->FrontendDecoder->SetMultiblock(false);
+      Thread->OpDispatcher->SetMultiblock(false);
+    }
+    Thread->FrontendDecoder->SetSingleInstruction(DebugStep);
 
     Thread->OpDispatcher->ReownOrClaimBuffer();
     Thread->OpDispatcher->ResetWorkingList();
@@ -775,11 +1234,21 @@ namespace FEXCore::Context {
     uint64_t TotalInstructions {0};
     uint64_t TotalInstructionsLength {0};
 
+    // Counters are per block, IR with them can't be shared with another address.
+    // Neither can IR built without multiblock, a byte-identical multiblock could loop without passing the entry.
+    bool DedupIR = IRDedupCache && !NoMultiblock && !ProfileCounter && !ExtendedDebugInfo;
+    // The same holds for IR kept for code moving to another address
+    bool RetainIR = RemapCache && !NoMultiblock && !ProfileCounter && !ExtendedDebugInfo;
+    bool DedupSMCChecks {};
+    // Code that has been written to after being run, always validated when validation is sampled
+    bool ModifiedCode {};
 
     std::shared_lock lk(CustomIRMutex);
 
     auto Handler = CustomIRHandlers.find(GuestRIP);
     if (Handler != CustomIRHandlers.end()) {
+      DedupIR = false;
+      RetainIR = false;
       TotalInstructions = 1;
       TotalInstructionsLength = 1;
       std::get<0>(Handler->second)(GuestRIP, Thread->OpDispatcher.get());
@@ -790,17 +1259,76 @@ namespace FEXCore::Context {
       GuestCode = reinterpret_cast<uint8_t const*>(GuestRIP);
 
       bool HadDispatchError {false};
+      bool InlineSMCChecks = Config.SMCChecks == FEXCore::Config::CONFIG_SMC_FULL;
+
+      {
+        FEXCore::ScopedCompileStat Scope(Stages.Frontend);
+        Thread->FrontendDecoder->DecodeInstructionsAtEntry(GuestCode, GuestRIP, [Thread, &InlineSMCChecks, &ModifiedCode](uint64_t BlockEntry, uint64_t Start, uint64_t Length) {
+          auto SyscallHandler = static_cast<ContextImpl*>(Thread->CTX)->SyscallHandler;
+          if (Thread->LookupCache->AddBlockExecutableRange(BlockEntry, Start, Length)) {
+            SyscallHandler->MarkGuestExecutableRange(Thread, Start, Length);
+          }
+          // Pages that were written to too often aren't protected, fall back to checking the code inline
+          ModifiedCode |= SyscallHandler->NeedsInlineSMCChecks(Start, Length);
+          InlineSMCChecks |= ModifiedCode;
+        });
+      }
+
+      DedupSMCChecks = InlineSMCChecks;
+
+      if (RetainIR) {
+        // The code might have been compiled before it was moved here
+        const auto StartAddr = Thread->FrontendDecoder->DecodedMinAddress;
+        const auto Length = Thread->FrontendDecoder->DecodedMaxAddress - StartAddr;
+
+        if (auto Cached = RemapCache->Find(GuestRIP, StartAddr, Length, InlineSMCChecks, Thread->CompileArena)) {
+          Thread->FrontendDecoder->DelayedDisownBuffer();
+          Thread->FrontendDecoder->SetMultiblock(FrontendMultiblock);
+          Thread->OpDispatcher->SetMultiblock(DispatcherMultiblock);
+          Thread->OpDispatcher->DelayedDisownBuffer();
+
+          return {
+            .IRList = Cached->IRList,
+            .RAData = std::move(Cached->RAData),
+            .TotalInstructions = Cached->TotalInstructions,
+            .TotalInstructionsLength = Cached->TotalInstructionsLength,
+            .StartAddr = StartAddr,
+            .Length = Length,
+          };
+        }
+      }
+
+      if (DedupIR) {
+        // A byte-identical block at another address might have generated this IR already
+        const auto StartAddr = Thread->FrontendDecoder->DecodedMinAddress;
+        const auto Length = Thread->FrontendDecoder->DecodedMaxAddress - StartAddr;
 
-      Thread->FrontendDecoder->DecodeInstructionsAtEntry(GuestCode, GuestRIP, [Thread](uint64_t BlockEntry, uint64_t Start, uint64_t Length) {
-        if (Thread->LookupCache->AddBlockExecutableRange(BlockEntry, Start, Length)) {
-          static_cast<ContextImpl*>(Thread->CTX)->SyscallHandler->MarkGuestExecutableRange(Thread, Start, Length);
+        if (auto Cached = IRDedupCache->Find(GuestRIP, StartAddr, Length, InlineSMCChecks)) {
+          Thread->FrontendDecoder->DelayedDisownBuffer();
+          Thread->FrontendDecoder->SetMultiblock(FrontendMultiblock);
+          Thread->OpDispatcher->SetMultiblock(DispatcherMultiblock);
+          Thread->OpDispatcher->DelayedDisownBuffer();
+
+          // The cached copies outlive the compile, the arena copy of the RA data is marked shared so it isn't freed
+          return {
+            .IRList = Thread->CompileArena.New<FEXCore::IR::IRListView>(Cached->IRList, false),
+            .RAData = Cached->RAData->CreateCopy(Thread->CompileArena),
+            .TotalInstructions = Cached->TotalInstructions,
+            .TotalInstructionsLength = Cached->TotalInstructionsLength,
+            .StartAddr = StartAddr,
+            .Length = Length,
+          };
         }
-      });
+      }
+
+      // Covers everything up to the end of this scope, including the early exit on dispatch errors
+      FEXCore::ScopedCompileStat DispatchScope(Stages.OpDispatcher);
 
       auto BlockInfo = Thread->FrontendDecoder->GetDecodedBlockInfo();
       auto CodeBlocks = &BlockInfo->Blocks;
 
       Thread->OpDispatcher->BeginFunction(GuestRIP, CodeBlocks, BlockInfo->TotalInstructionCount);
+      Thread->OpDispatcher->SetDecodedBlockInfo(BlockInfo);
 
       const uint8_t GPRSize = GetGPRSize();
 
@@ -814,6 +1342,34 @@ namespace FEXCore::Context {
         // Reset any block-specific state
         Thread->OpDispatcher->StartNewBlock();
 
+        if (Tier0 && j == 0) {
+          // Count executions of this block, once it reaches the threshold remove the block and let the dispatcher recompile it.
+          // Threads share the counter, so it is incremented atomically and only ever counts up.
+          auto CounterPtr = Thread->OpDispatcher->_Constant(reinterpret_cast<uint64_t>(Tier0Counter));
+          auto Counter = Thread->OpDispatcher->_AtomicFetchAdd(4, Thread->OpDispatcher->_Constant(1), CounterPtr);
+
+          auto TierUpCond = Thread->OpDispatcher->_CondJump(Counter, Thread->OpDispatcher->_Constant(Config.TierUpThreshold - 1),
+            Thread->OpDispatcher->Invalid(), Thread->OpDispatcher->Invalid(), {FEXCore::IR::COND_UGE}, 4);
+
+          auto CurrentBlock = Thread->OpDispatcher->GetCurrentBlock();
+          auto TierUpBlock = Thread->OpDispatcher->CreateNewCodeBlockAtEnd();
+          Thread->OpDispatcher->SetTrueJumpTarget(TierUpCond, TierUpBlock);
+
+          Thread->OpDispatcher->SetCurrentCodeBlock(TierUpBlock);
+          Thread->OpDispatcher->_ThreadRemoveCodeEntry();
+          Thread->OpDispatcher->_ExitFunction(Thread->OpDispatcher->_EntrypointOffset(Block.Entry - GuestRIP, GPRSize));
+
+          auto CountBlock = Thread->OpDispatcher->CreateNewCodeBlockAfter(CurrentBlock);
+          Thread->OpDispatcher->SetFalseJumpTarget(TierUpCond, CountBlock);
+          Thread->OpDispatcher->SetCurrentCodeBlock(CountBlock);
+        }
+
+        if (ProfileCounter && j == 0) {
+          auto CounterPtr = Thread->OpDispatcher->_Constant(reinterpret_cast<uint64_t>(ProfileCounter));
+          auto Counter = Thread->OpDispatcher->_LoadMem(FEXCore::IR::GPRClass, 8, CounterPtr, 8);
+          Thread->OpDispatcher->_StoreMem(FEXCore::IR::GPRClass, 8, CounterPtr, Thread->OpDispatcher->_Add(Counter, Thread->OpDispatcher->_Constant(1)), 8);
+        }
+
         uint64_t InstsInBlock = Block.NumInstructions;
 
         for (size_t i = 0; i < InstsInBlock; ++i) {
@@ -824,11 +1380,21 @@ namespace FEXCore::Context {
           DecodedInfo = &Block.DecodedInstructions[i];
           bool IsLocked = DecodedInfo->Flags & FEXCore::X86Tables::DecodeFlags::FLAG_LOCK;
 
-          if (ExtendedDebugInfo || Thread->OpDispatcher->CanHaveSideEffects(TableInfo, DecodedInfo)) {
+          // The x87 stack cache only lives across a run of x87 instructions.
+          // Anything else may touch the x87 and MMX registers in the context directly,
+          // and the SMC check below splits the block.
+          const bool IsX87 = TableInfo >= FEXCore::X86Tables::X87Ops.data() &&
+                             TableInfo < FEXCore::X86Tables::X87Ops.data() + FEXCore::X86Tables::X87Ops.size();
+          if (!IsX87 || InlineSMCChecks) {
+            Thread->OpDispatcher->InvalidateX87Stack();
+          }
+
+          // Fallback profiling attributes fallbacks to the guest instruction from the last GuestOpcode
+          if (ExtendedDebugInfo || FallbackProfile || Thread->OpDispatcher->CanHaveSideEffects(TableInfo, DecodedInfo)) {
             Thread->OpDispatcher->_GuestOpcode(Block.Entry + BlockInstructionsLength - GuestRIP);
           }
 
-          if (Config.SMCChecks == FEXCore::Config::CONFIG_SMC_FULL) {
+          if (InlineSMCChecks) {
             auto ExistingCodePtr = reinterpret_cast<uint64_t*>(Block.Entry + BlockInstructionsLength);
 
             auto CodeChanged = Thread->OpDispatcher->_ValidateCode(ExistingCodePtr[0], ExistingCodePtr[1], (uintptr_t)ExistingCodePtr - GuestRIP, DecodedInfo->InstSize);
@@ -851,6 +1417,9 @@ namespace FEXCore::Context {
 
           if (TableInfo && TableInfo->OpcodeDispatcher) {
             auto Fn = TableInfo->OpcodeDispatcher;
+            if (IsX87 && Thread->OpDispatcher->IsAdaptiveX87F64()) {
+              Fn = FEXCore::IR::GetX87F64OpDispatcher(TableInfo);
+            }
             Thread->OpDispatcher->ResetHandledLock();
             Thread->OpDispatcher->ResetDecodeFailure();
             std::invoke(Fn, Thread->OpDispatcher, DecodedInfo);
@@ -872,6 +1441,7 @@ namespace FEXCore::Context {
               LogMan::Msg::EFmt("Invalid or Unknown instruction: {} 0x{:x}", TableInfo->Name ?: "UND", Block.Entry - GuestRIP);
             }
             // Invalid instruction
+            Thread->OpDispatcher->FlushX87Stack();
             Thread->OpDispatcher->InvalidOp(DecodedInfo);
             Thread->OpDispatcher->_ExitFunction(Thread->OpDispatcher->_EntrypointOffset(Block.Entry - GuestRIP, GPRSize));
           }
@@ -883,11 +1453,15 @@ namespace FEXCore::Context {
           if (HadDispatchError && TotalInstructions == 0) {
             // Couldn't handle any instruction in op dispatcher
             Thread->OpDispatcher->ResetWorkingList();
+            Thread->FrontendDecoder->SetMultiblock(FrontendMultiblock);
+            Thread->OpDispatcher->SetMultiblock(DispatcherMultiblock);
+            Thread->FrontendDecoder->SetSingleInstruction(false);
             return { nullptr, nullptr, 0, 0, 0, 0 };
           }
 
           if (NeedsBlockEnd) {
             const uint8_t GPRSize = GetGPRSize();
+            Thread->OpDispatcher->FlushX87Stack();
 
             // We had some instructions. Early exit
             Thread->OpDispatcher->_ExitFunction(Thread->OpDispatcher->_EntrypointOffset(Block.Entry + BlockInstructionsLength - GuestRIP, GPRSize));
@@ -904,8 +1478,14 @@ namespace FEXCore::Context {
       Thread->OpDispatcher->Finalize();
 
       Thread->FrontendDecoder->DelayedDisownBuffer();
+
+      DedupIR &= !HadDispatchError;
     }
 
+    Thread->FrontendDecoder->SetMultiblock(FrontendMultiblock);
+    Thread->OpDispatcher->SetMultiblock(DispatcherMultiblock);
+    Thread->FrontendDecoder->SetSingleInstruction(false);
+
     IR::IREmitter *IREmitter = Thread->OpDispatcher.get();
 
     auto ShouldDump = Thread->OpDispatcher->ShouldDumpIR();
@@ -921,20 +1501,32 @@ namespace FEXCore::Context {
     }
 
     // Run the passmanager over the IR from the dispatcher
-    Thread->PassManager->Run(IREmitter);
+    PassManager->Run(IREmitter, ModifiedCode);
 
     // Debug
     {
       if (ShouldDump) {
-        IRDumper(Thread, IREmitter, GuestRIP, Thread->PassManager->HasPass("RA") ? Thread->PassManager->GetPass<IR::RegisterAllocationPass>("RA")->GetAllocationData() : nullptr);
+        IRDumper(Thread, IREmitter, GuestRIP, PassManager->HasPass("RA") ? PassManager->GetPass<IR::RegisterAllocationPass>("RA")->GetAllocationData() : nullptr);
       }
     }
 
-    auto RAData = Thread->PassManager->HasPass("RA") ? Thread->PassManager->GetPass<IR::RegisterAllocationPass>("RA")->PullAllocationData() : nullptr;
-    auto IRList = IREmitter->CreateIRCopy();
+    auto RAData = PassManager->HasPass("RA") ? PassManager->GetPass<IR::RegisterAllocationPass>("RA")->CopyAllocationData(Thread->CompileArena) : nullptr;
+    auto IRList = IREmitter->CreateIRCopy(Thread->CompileArena);
 
     IREmitter->DelayedDisownBuffer();
 
+    if (DedupIR) {
+      const auto StartAddr = Thread->FrontendDecoder->DecodedMinAddress;
+      IRDedupCache->Insert(GuestRIP, StartAddr, Thread->FrontendDecoder->DecodedMaxAddress - StartAddr, DedupSMCChecks,
+                           IRList, RAData.get(), TotalInstructions, TotalInstructionsLength);
+    }
+
+    if (RetainIR) {
+      const auto StartAddr = Thread->FrontendDecoder->DecodedMinAddress;
+      RemapCache->Insert(GuestRIP, StartAddr, Thread->FrontendDecoder->DecodedMaxAddress - StartAddr, DedupSMCChecks,
+                         IRList, RAData.get(), TotalInstructions, TotalInstructionsLength);
+    }
+
     return {
       .IRList = IRList,
       .RAData = std::move(RAData),
@@ -945,32 +1537,8 @@ namespace FEXCore::Context {
     };
   }
 
-  ContextImpl::CompileCodeResult ContextImpl::CompileCode(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP) {
-    FEXCore::IR::IRListView *IRList {};
-    FEXCore::Core::DebugData *DebugData {};
-    FEXCore::IR::RegisterAllocationData::UniquePtr RAData {};
-    bool GeneratedIR {};
-    uint64_t StartAddr {};
-    uint64_t Length {};
-
-    // JIT Code object cache lookup
-    if (CodeObjectCacheService) {
-      auto CodeCacheEntry = CodeObjectCacheService->FetchCodeObjectFromCache(GuestRIP);
-      if (CodeCacheEntry) {
-        auto CompiledCode = Thread->CPUBackend->RelocateJITObjectCode(GuestRIP, CodeCacheEntry);
-        if (CompiledCode) {
-          return {
-              .CompiledCode = CompiledCode,
-              .IRData = nullptr,    // No IR data generated
-              .DebugData = nullptr, // nullptr here ensures that code serialization doesn't occur on from cache read
-              .RAData = nullptr,    // No RA data generated
-              .GeneratedIR = false, // nullptr here ensures IR cache mechanisms won't run
-              .StartAddr = 0,       // Unused
-              .Length = 0,          // Unused
-          };
-        }
-      }
-    }
+  ContextImpl::FetchOrGenerateIRResult ContextImpl::FetchOrGenerateIR(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP, bool DebugStep) {
+    FetchOrGenerateIRResult Result {};
 
     if (SourcecodeResolver && Config.GDBSymbols()) {
       auto AOTIRCacheEntry = SyscallHandler->LookupAOTIRCacheEntry(Thread, GuestRIP);
@@ -981,53 +1549,117 @@ namespace FEXCore::Context {
     }
 
     // AOT IR bookkeeping and cache
-    {
-      auto [IRCopy, RACopy, DebugDataCopy, _StartAddr, _Length, _GeneratedIR] = IRCaptureCache.PreGenerateIRFetch(Thread, GuestRIP, IRList);
+    if (!DebugStep) {
+      auto [IRCopy, RACopy, DebugDataCopy, _StartAddr, _Length, _GeneratedIR] = IRCaptureCache.PreGenerateIRFetch(Thread, GuestRIP, nullptr);
       if (_GeneratedIR) {
         // Setup pointers to internal structures
-        IRList = IRCopy;
-        RAData = std::move(RACopy);
-        DebugData = DebugDataCopy;
-        StartAddr = _StartAddr;
-        Length = _Length;
-        GeneratedIR = _GeneratedIR;
+        Result.IRList = IRCopy;
+        Result.RAData = std::move(RACopy);
+        Result.DebugData = DebugDataCopy;
+        Result.StartAddr = _StartAddr;
+        Result.Length = _Length;
+        Result.GeneratedIR = _GeneratedIR;
+        return Result;
       }
     }
 
-    if (IRList == nullptr) {
-      // Generate IR + Meta Info
-      auto [IRCopy, RACopy, TotalInstructions, TotalInstructionsLength, _StartAddr, _Length] = GenerateIR(Thread, GuestRIP, Config.GDBSymbols());
+    // AOT IR is already fully optimized, only freshly generated IR goes through tier 0
+    // Step blocks run once, they don't count towards tiering or profiles
+    uint32_t *Tier0Counter = IsTieredCompilationEnabled() && !DebugStep ? GetTier0Counter(GuestRIP) : nullptr;
+    Result.Tier0 = Tier0Counter != nullptr;
+    // Without a tier 0 counter the block has already run TierUpThreshold times
+    Result.HotBlock = IsTieredCompilationEnabled() && !Result.Tier0 && !DebugStep && Config.HotCodeLayout;
+    uint64_t *ProfileCounter = BlockProfile && !DebugStep ? GetBlockProfileCounter(Thread, GuestRIP) : nullptr;
+    Result.Uncacheable = Tier0Counter || ProfileCounter || DebugStep;
+
+    // Generate IR + Meta Info
+    auto [IRCopy, RACopy, TotalInstructions, TotalInstructionsLength, _StartAddr, _Length] = GenerateIR(Thread, GuestRIP, Config.GDBSymbols(), Tier0Counter, ProfileCounter, DebugStep);
+
+    // Setup pointers to internal structures
+    Result.IRList = IRCopy;
+    Result.RAData = std::move(RACopy);
+    Result.DebugData = new FEXCore::Core::DebugData();
+    Result.StartAddr = _StartAddr;
+    Result.Length = _Length;
+
+    // These blocks aren't already in the cache
+    Result.GeneratedIR = true;
+    return Result;
+  }
 
-      // Setup pointers to internal structures
-      IRList = IRCopy;
-      RAData = std::move(RACopy);
-      DebugData = new FEXCore::Core::DebugData();
-      StartAddr = _StartAddr;
-      Length = _Length;
+  ContextImpl::CompileCodeResult ContextImpl::CompileCode(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP, bool DebugStep, FetchOrGenerateIRResult *PendingIR) {
+    // JIT Code object cache lookup
+    if (CodeObjectCacheService && !DebugStep && !PendingIR) {
+      auto CodeCacheEntry = CodeObjectCacheService->FetchCodeObjectFromCache(GuestRIP);
+      if (CodeCacheEntry.Section &&
+          !ProtectCachedBlockRange(Thread, GuestRIP, CodeCacheEntry.GuestCodeStart, CodeCacheEntry.GuestCodeLength,
+                                   CodeCacheEntry.Section->Data->GuestCodeHash)) {
+        // The guest code changed since this object was serialized
+        CodeCacheEntry.Section->Invalid = true;
+        CodeCacheEntry.Section = nullptr;
+      }
 
-      // These blocks aren't already in the cache
-      GeneratedIR = true;
+      if (CodeCacheEntry.Section) {
+        auto CompiledCode = Thread->CPUBackend->RelocateJITObjectCode(GuestRIP, CodeCacheEntry.Section);
+        if (CompiledCode.BlockEntry) {
+          return {
+              .CompiledCode = CompiledCode,
+              .IRData = nullptr,    // No IR data generated
+              .DebugData = nullptr, // nullptr here ensures that code serialization doesn't occur on from cache read
+              .RAData = nullptr,    // No RA data generated
+              .GeneratedIR = false, // nullptr here ensures IR cache mechanisms won't run
+              .StartAddr = CodeCacheEntry.GuestCodeStart,
+              .Length = CodeCacheEntry.GuestCodeLength,
+          };
+        }
+
+        // Usually a thunk that this process doesn't have loaded, don't try this object again
+        CodeCacheEntry.Section->Invalid = true;
+      }
+    }
+
+    // AOT host code is linked straight in, without the frontend or backend running
+    if (!DebugStep) {
+      auto HostCode = IRCaptureCache.RelocateHostCode(Thread, GuestRIP);
+      if (HostCode.Code.BlockEntry) {
+        if (PendingIR) {
+          delete PendingIR->DebugData;
+        }
+        return {
+          .CompiledCode = HostCode.Code,
+          .IRData = nullptr,
+          .DebugData = nullptr,
+          .RAData = nullptr,
+          .GeneratedIR = false,
+          .StartAddr = HostCode.StartAddr,
+          .Length = HostCode.Length,
+        };
+      }
     }
 
-    if (IRList == nullptr) {
+    auto IR = PendingIR ? std::move(*PendingIR) : FetchOrGenerateIR(Thread, GuestRIP, DebugStep);
+
+    if (IR.IRList == nullptr) {
       return {};
     }
     // Attempt to get the CPU backend to compile this code
+    FEXCore::ScopedCompileStat Scope(CompileStages[IR.Tier0].Codegen);
     return {
-      // FEX currently throws away the CPUBackend::CompiledCode object other than the entrypoint
-      // In the future with code caching getting wired up, we will pass the rest of the data forward.
-      // TODO: Pass the data forward when code caching is wired up to this.
-      .CompiledCode = Thread->CPUBackend->CompileCode(GuestRIP, IRList, DebugData, RAData.get(), GetGdbServerStatus()).BlockEntry,
-      .IRData = IRList,
-      .DebugData = DebugData,
-      .RAData = std::move(RAData),
-      .GeneratedIR = GeneratedIR,
-      .StartAddr = StartAddr,
-      .Length = Length,
+      .CompiledCode = Thread->CPUBackend->CompileCode(GuestRIP, IR.IRList, IR.DebugData, IR.RAData.get(), GetGdbServerStatus(), IR.HotBlock),
+      .IRData = IR.IRList,
+      .DebugData = IR.DebugData,
+      .RAData = std::move(IR.RAData),
+      .GeneratedIR = IR.GeneratedIR,
+      .StartAddr = IR.StartAddr,
+      .Length = IR.Length,
+      // The gdb pause check points in to the dispatcher and isn't relocatable
+      .Uncacheable = IR.Uncacheable || GetGdbServerStatus(),
     };
   }
 
   void ContextImpl::CompileBlockJit(FEXCore::Core::CpuStateFrame *Frame, uint64_t GuestRIP) {
+    FEXCORE_TELEMETRY_COUNTER_INC(COUNTER_DISPATCHER_EXITS);
+
     auto NewBlock = CompileBlock(Frame, GuestRIP);
 
     if (NewBlock == 0) {
@@ -1039,16 +1671,63 @@ namespace FEXCore::Context {
   }
 
   uintptr_t ContextImpl::CompileBlock(FEXCore::Core::CpuStateFrame *Frame, uint64_t GuestRIP) {
-    FEXCORE_PROFILE_SCOPED("CompileBlock");
+    FEXCORE_PROFILE_SCOPED_ARG("CompileBlock", GuestRIP);
     auto Thread = Frame->Thread;
 
-    // Invalidate might take a unique lock on this, to guarantee that during invalidation no code gets compiled
-    ScopedDeferredSignalWithForkableSharedLock lk(CodeInvalidationMutex, Thread);
+    // Freshly generated IR and RA data live in the arena, anything that outlives this compile makes its own copy
+    FEXCore::Utils::BumpArena::ScopedReset ArenaReset(Thread->CompileArena);
+
+    const uint64_t CompileBegin = CompileStats::GetTime();
+    ReleaseIdleLookupCaches(CompileBegin);
+
+    // The frontend and IR passes run without CodeInvalidationMutex held, so invalidations on other threads don't wait on them.
+    // Their IR is only used if no invalidation overlapped its guest range in the meantime, otherwise it's generated again.
+    // The object code cache relocates straight in to the code buffer, with it enabled everything is compiled under the lock.
+    // Signals are already deferred by the dispatcher for the whole compile.
+    // If invalidations keep overlapping, the IR is generated under the lock after a few attempts so the thread still makes progress.
+    constexpr size_t MaxUnlockedIRAttempts = 4;
+    size_t UnlockedIRAttempts {};
+    std::optional<FetchOrGenerateIRResult> PendingIR {};
+    uint64_t PendingEpoch {};
+    std::optional<ScopedDeferredSignalWithForkableSharedLock> lk {};
+    while (true) {
+      // Invalidate might take a unique lock on this, to guarantee that during invalidation no code gets compiled
+      lk.emplace(CodeInvalidationMutex, Thread);
+
+      // Is the code in the cache?
+      // The backends only check L1 and L2, not L3
+      if (auto HostCode = Thread->LookupCache->FindBlock(GuestRIP)) {
+        if (PendingIR) {
+          delete PendingIR->DebugData;
+        }
+        return HostCode;
+      }
+
+      if (!PendingIR) {
+        if (auto HostCode = ReinstateSuspectBlock(Thread, GuestRIP)) {
+          return HostCode;
+        }
+      }
+
+      if (CodeObjectCacheService ||
+          (PendingIR && !IsCodeInvalidatedSince(PendingEpoch, PendingIR->StartAddr, PendingIR->Length))) {
+        break;
+      }
+
+      if (PendingIR) {
+        delete PendingIR->DebugData;
+        PendingIR.reset();
+      }
+
+      if (UnlockedIRAttempts == MaxUnlockedIRAttempts) {
+        break;
+      }
+      ++UnlockedIRAttempts;
 
-    // Is the code in the cache?
-    // The backends only check L1 and L2, not L3
-    if (auto HostCode = Thread->LookupCache->FindBlock(GuestRIP)) {
-      return HostCode;
+      // Stable while the lock is held
+      PendingEpoch = CodeInvalidationEpoch;
+      lk.reset();
+      PendingIR = FetchOrGenerateIR(Thread, GuestRIP, false);
     }
 
     void *CodePtr {};
@@ -1058,8 +1737,8 @@ namespace FEXCore::Context {
     bool GeneratedIR {};
     uint64_t StartAddr {}, Length {};
 
-    auto [Code, IR, Data, RAData, Generated, _StartAddr, _Length] = CompileCode(Thread, GuestRIP);
-    CodePtr = Code;
+    auto [Code, IR, Data, RAData, Generated, _StartAddr, _Length, Uncacheable] = CompileCode(Thread, GuestRIP, false, PendingIR ? &*PendingIR : nullptr);
+    CodePtr = Code.BlockEntry;
     IRList = IR;
     DebugData = Data;
     GeneratedIR = Generated;
@@ -1070,6 +1749,13 @@ namespace FEXCore::Context {
       return 0;
     }
 
+    FEXCORE_TELEMETRY_COUNTER_INC(COUNTER_BLOCKS_COMPILED);
+    FEXCORE_TELEMETRY_COMPILE_TIME(CompileStats::GetTime() - CompileBegin);
+
+    if (BlockCorpus) {
+      BlockCorpus->Record(GuestRIP, StartAddr, Length);
+    }
+
     // The core managed to compile the code.
     if (Config.BlockJITNaming()) {
       auto FragmentBasePtr = reinterpret_cast<uint8_t *>(CodePtr);
@@ -1096,54 +1782,263 @@ namespace FEXCore::Context {
       }
     }
 
+    if (Config.JITDump() && DebugData) {
+      auto GuestRIPLookup = SyscallHandler->LookupAOTIRCacheEntry(Thread, GuestRIP);
+      // Guest opcode host offsets are relative to the start of the block, not its entrypoint
+      Symbols.RegisterJITDump(Code.BlockBegin, DebugData->HostCodeSize, GuestRIP, DebugData,
+                              GuestRIPLookup.Entry ? std::string_view(GuestRIPLookup.Entry->Filename) : std::string_view{},
+                              GuestRIPLookup.VAFileStart);
+    }
+
     // Tell the object cache service to serialize the code if enabled
     if (CodeObjectCacheService &&
         Config.CacheObjectCodeCompilation == FEXCore::Config::ConfigObjectCodeHandler::CONFIG_READWRITE &&
-        DebugData) {
+        DebugData && !Uncacheable) {
       CodeObjectCacheService->AsyncAddSerializationJob(fextl::make_unique<CodeSerialize::AsyncJobHandler::SerializationJobData>(
         CodeSerialize::AsyncJobHandler::SerializationJobData {
           .GuestRIP = GuestRIP,
+          .GuestCodeStart = StartAddr,
           .GuestCodeLength = Length,
           .GuestCodeHash = 0,
-          .HostCodeBegin = CodePtr,
-          .HostCodeLength = DebugData->HostCodeSize,
+          .HostCodeBegin = Code.BlockBegin,
+          .HostCodeLength = Code.Size,
+          .HostEntryOffset = static_cast<size_t>(Code.BlockEntry - Code.BlockBegin),
           .HostCodeHash = 0,
           .ThreadJobRefCount = &Thread->ObjectCacheRefCounter,
-          .Relocations = std::move(*DebugData->Relocations),
+          // Copied, AOT host code capture still needs them
+          .Relocations = *DebugData->Relocations,
         }
       ));
     }
 
-    // Clear any relocations that might have been generated
-    Thread->CPUBackend->ClearRelocations();
-
-    if (IRCaptureCache.PostCompileCode(
+    const bool AOTGenerated = IRCaptureCache.PostCompileCode(
         Thread,
-        CodePtr,
+        Code,
+        DebugData ? DebugData->Relocations : nullptr,
         GuestRIP,
         StartAddr,
         Length,
         std::move(RAData),
         IRList,
         DebugData,
-        GeneratedIR)) {
+        GeneratedIR,
+        !Uncacheable);
+
+    // Clear any relocations that might have been generated
+    Thread->CPUBackend->ClearRelocations();
+
+    if (AOTGenerated) {
       // Early exit
       return (uintptr_t)CodePtr;
     }
 
     // Insert to lookup cache
-    // Pages containing this block are added via AddBlockExecutableRange before each page gets accessed in the frontend
-    AddBlockMapping(Thread, GuestRIP, CodePtr);
+    // Pages containing this block are added via AddBlockExecutableRange before each page gets accessed in the frontend,
+    // or by ProtectCachedBlockRange for host code from the object cache or AOT cache
+    // With a shared cache another thread may have won the race to compile this block, use its code instead
+    const auto HostCode = AddBlockMapping(Thread, GuestRIP, CodePtr);
+
+    if (HostCode == reinterpret_cast<uintptr_t>(CodePtr) && Length && CanSuspendBlocks() &&
+        !SyscallHandler->NeedsInlineSMCChecks(StartAddr, Length)) {
+      // The pages are protected and invalidation is held off, the code is still what the block was compiled from
+      Thread->LookupCache->AddBlockGuestRange(GuestRIP, {
+        .Start = StartAddr,
+        .Length = Length,
+        .Hash = XXH3_64bits(reinterpret_cast<const void*>(StartAddr), Length),
+      });
+    }
 
-    return (uintptr_t)CodePtr;
+    return HostCode;
   }
 
+  uintptr_t ContextImpl::ReinstateSuspectBlock(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP) {
+    auto Suspect = Thread->LookupCache->TakeSuspectBlock(GuestRIP);
+    if (!Suspect) {
+      return 0;
+    }
+
+    const auto &Range = Suspect->Range;
+
+    if (!ProtectCachedBlockRange(Thread, GuestRIP, Range.Start, Range.Length, Range.Hash, true)) {
+      return 0;
+    }
+
+    FEXCORE_TELEMETRY_COUNTER_INC(COUNTER_BLOCKS_REINSTATED);
+
+    const auto HostCode = AddBlockMapping(Thread, GuestRIP, reinterpret_cast<void*>(Suspect->HostCode));
+    if (HostCode == Suspect->HostCode) {
+      Thread->LookupCache->AddBlockGuestRange(GuestRIP, Range);
+    }
+    return HostCode;
+  }
+
+  bool ContextImpl::ProtectCachedBlockRange(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP, uint64_t Start, uint64_t Length,
+                                            uint64_t Hash, bool Reinstated) {
+    // Pages promoted to inline checks need the block compiled with them
+    if (SyscallHandler->NeedsInlineSMCChecks(Start, Length)) {
+      return false;
+    }
+
+    // Protect the pages before reading the code, a write from another thread after this invalidates the block again
+    if (Thread->LookupCache->AddBlockExecutableRange(GuestRIP, Start, Length, Reinstated)) {
+      SyscallHandler->MarkGuestExecutableRange(Thread, Start, Length);
+    }
+
+    return XXH3_64bits(reinterpret_cast<const void*>(Start), Length) == Hash;
+  }
+
+  void ContextImpl::ReleaseIdleLookupCaches(uint64_t Now) {
+    // A thread's lookup cache is released once it has spent a whole interval parked in the same syscall.
+    // Lookup misses alone can't tell, a thread running hot code hits in L1 without ever leaving the JIT.
+    constexpr uint64_t LOOKUP_CACHE_IDLE_INTERVAL_NS = 10'000'000'000ULL;
+
+    auto Next = NextLookupCacheIdleCheck.load(std::memory_order_relaxed);
+    if (Now < Next ||
+        !NextLookupCacheIdleCheck.compare_exchange_strong(Next, Now + LOOKUP_CACHE_IDLE_INTERVAL_NS, std::memory_order_relaxed)) {
+      return;
+    }
+
+    // Not worth waiting on thread creation for, the next interval will catch up
+    std::unique_lock lk(ThreadCreationMutex, std::try_to_lock);
+    if (!lk.owns_lock()) {
+      return;
+    }
+
+    for (auto &Thread : Threads) {
+      const auto Sequence = Thread->SyscallSequence.load(std::memory_order_relaxed);
+      const bool Parked = (Sequence & 1) && Sequence == Thread->IdleCheckSyscallSequence;
+      Thread->IdleCheckSyscallSequence = Sequence;
+
+      if (Parked && Thread->LocalLookupCache) {
+        Thread->LocalLookupCache->ReleaseIfIdle();
+      }
+    }
+  }
+
+  bool ContextImpl::IsCodeInvalidatedSince(uint64_t Epoch, uint64_t Start, uint64_t Length) const {
+    if (CodeInvalidationEpoch - Epoch > RecentCodeInvalidations.size()) {
+      // The ranges have been overwritten, assume the worst
+      return true;
+    }
+
+    for (uint64_t i = Epoch; i < CodeInvalidationEpoch; ++i) {
+      const auto &Range = RecentCodeInvalidations[i % RecentCodeInvalidations.size()];
+      if (Start < Range.End && Range.Start < Start + Length) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  uintptr_t ContextImpl::CompileDebugStepBlock(FEXCore::Core::CpuStateFrame *Frame, uint64_t GuestRIP) {
+    auto Thread = Frame->Thread;
+
+    // Invalidation clears the step blocks with this held uniquely
+    ScopedDeferredSignalWithForkableSharedLock lk(CodeInvalidationMutex, Thread);
+
+    if (auto it = Thread->DebugStepBlocks.find(GuestRIP); it != Thread->DebugStepBlocks.end()) {
+      return it->second;
+    }
+
+    FEXCore::Utils::BumpArena::ScopedReset ArenaReset(Thread->CompileArena);
+
+    auto Result = CompileCode(Thread, GuestRIP, true);
+    // Nothing keeps the IR or debug data of step blocks
+    delete Result.DebugData;
+    Thread->CPUBackend->ClearRelocations();
+
+    const auto CodePtr = reinterpret_cast<uintptr_t>(Result.CompiledCode.BlockEntry);
+    if (CodePtr) {
+      Thread->DebugStepBlocks[GuestRIP] = CodePtr;
+    }
+    return CodePtr;
+  }
+
+  void ContextImpl::SetGdbBreakpoint(uint64_t Address, bool Set) {
+    {
+      std::lock_guard lk(GdbBreakpointMutex);
+      const bool Changed = Set ? GdbBreakpoints.insert(Address).second : GdbBreakpoints.erase(Address) != 0;
+      if (!Changed) {
+        return;
+      }
+      NumGdbBreakpoints = GdbBreakpoints.size();
+    }
+
+    // Recompiles the block starting here with a stopping entry check, and splits any block running through it
+    InvalidateGuestCodeRange(nullptr, Address, 1);
+  }
+
+  void ContextImpl::ResumeGdbThread(FEXCore::Core::InternalThreadState *Thread, bool Step) {
+    using FEXCore::Core::CpuStateFrame;
+    const bool AtBlockEntry = Thread->RunningEvents.GdbStoppedAtBlockEntry.load();
+
+    if (Step) {
+      // Without a block entry to step from the best that can be done is stopping at the next one
+      Thread->CurrentFrame->GdbStop = AtBlockEntry ? CpuStateFrame::GDB_STEP : CpuStateFrame::GDB_STOP;
+    }
+    else {
+      // The block the thread stopped at may have a breakpoint on it, run past that once
+      Thread->CurrentFrame->GdbStop = AtBlockEntry ? CpuStateFrame::GDB_RESUME : CpuStateFrame::GDB_RUN;
+    }
+
+    if (AtBlockEntry || Thread->RunningEvents.ThreadSleeping.load() || Thread->RunningEvents.WaitingToStart.load()) {
+      // Threads paused by a signal return through it
+      Thread->SignalReason.store(FEXCore::Core::SignalEvent::Return);
+      Thread->StartRunning.NotifyAll();
+      Running = true;
+    }
+  }
+
+  void ContextImpl::ReportGdbStop(FEXCore::Core::InternalThreadState *Thread) {
+#ifndef _WIN32
+    if (DebugServer) {
+      DebugServer->ThreadStopped(Thread);
+    }
+#endif
+  }
+
+#ifndef _WIN32
+  void ContextImpl::PlaceThreadOnNUMANode(FEXCore::Core::InternalThreadState *Thread) {
+    Thread->NUMANode = ThreadPlacement->PinCurrentThread();
+    if (Thread->NUMANode < 0) {
+      return;
+    }
+
+    // Everything here was first touched by the thread that created this one, or by the previous owner of recycled state.
+    // Memory allocated from now on is first touched on the new node.
+    const auto Node = Thread->NUMANode;
+    ThreadPlacement->MovePages(Node, Thread, sizeof(*Thread));
+    ThreadPlacement->MovePages(Node, Thread->CurrentFrame->State.DeferredSignalFaultAddress, FHU::FEX_PAGE_SIZE);
+
+    if (Thread->LocalLookupCache) {
+      for (auto [Ptr, Size] : Thread->LocalLookupCache->GetHotRanges()) {
+        ThreadPlacement->MovePages(Node, reinterpret_cast<void*>(Ptr), Size);
+      }
+    }
+
+    if (Thread->CPUBackend) {
+      Thread->CPUBackend->ForEachCodeBuffer([&](const FEXCore::CPU::CPUBackend::CodeBuffer &Buffer) {
+        ThreadPlacement->MovePages(Node, Buffer.Ptr, Buffer.Size + FEXCore::CPU::CPUBackend::VeneerPoolSize);
+      });
+    }
+  }
+#endif
+
   void ContextImpl::ExecutionThread(FEXCore::Core::InternalThreadState *Thread) {
     Thread->ExitReason = FEXCore::Context::ExitReason::EXIT_WAITING;
 
     InitializeThreadTLSData(Thread);
+
+    if (SupportsHardwareTSO && !FEXCore::HostFeatures::EnableHardwareTSO()) {
+      // Code is compiled without any TSO emulation, running it with the weaker model would break the guest
+      LogMan::Msg::AFmt("Couldn't enable hardware TSO on thread {}", Thread->ThreadManager.TID);
+    }
 #ifndef _WIN32
     Alloc::OSAllocator::RegisterTLSData(Thread);
+
+    if (ThreadPlacement) {
+      PlaceThreadOnNUMANode(Thread);
+    }
 #endif
 
     ++IdleWaitRefCount;
@@ -1191,34 +2086,87 @@ namespace FEXCore::Context {
 
 #ifndef _WIN32
     Alloc::OSAllocator::UninstallTLSData(Thread);
+
+    if (ThreadPlacement) {
+      ThreadPlacement->ReleaseNode(std::exchange(Thread->NUMANode, -1));
+    }
 #endif
     SignalDelegation->UninstallTLSState(Thread);
 
+    Thread->CurrentFrame->Pointers.Common.TelemetryCounters = 0;
+    FEXCore::Telemetry::UnregisterThreadCounters();
+
     // If the parent thread is waiting to join, then we can't destroy our thread object
     if (!Thread->DestroyedByParent && Thread != static_cast<ContextImpl*>(Thread->CTX)->ParentThread) {
       Thread->CTX->DestroyThread(Thread);
     }
   }
 
-  static void InvalidateGuestThreadCodeRange(FEXCore::Core::InternalThreadState *Thread, uint64_t Start, uint64_t Length) {
+  // Erases the blocks in the range, or keeps them as suspect blocks with Suspend
+  static void InvalidateLookupCacheRange(LookupCache *LookupCache, uint64_t Start, uint64_t Length, bool Suspend, fextl::vector<uint64_t> const &Blocks) {
+    if (Suspend) {
+      LookupCache->Suspend(Blocks);
+    }
+    else {
+      LookupCache->DropSuspectBlocks(Start, Length);
+      LookupCache->Erase(Blocks);
+    }
+  }
+
+  static void InvalidateGuestThreadCodeRange(FEXCore::Core::InternalThreadState *Thread, uint64_t Start, uint64_t Length, bool Suspend) {
     std::lock_guard<std::recursive_mutex> lk(Thread->LookupCache->WriteLock);
 
-    auto lower = Thread->LookupCache->CodePages.lower_bound(Start >> 12);
-    auto upper = Thread->LookupCache->CodePages.upper_bound((Start + Length - 1) >> 12);
+    // Every block in the range is erased in one write section, instead of one per block
+    auto Blocks = Thread->LookupCache->TakeBlocksInRange(Start, Length);
+    for (auto Address: Blocks) {
+      Thread->DebugStore.erase(Address);
+    }
+    auto CTX = static_cast<ContextImpl*>(Thread->CTX);
+    if (CTX->IsTieredCompilationEnabled()) {
+      // Rewritten code starts counting from zero again
+      CTX->EraseTierUpCounters(Blocks);
+    }
+    InvalidateLookupCacheRange(Thread->LookupCache, Start, Length, Suspend, Blocks);
 
-    for (auto it = lower; it != upper; it++) {
-      for (auto Address: it->second) {
-        ContextImpl::ThreadRemoveCodeEntry(Thread, Address);
+    // Step blocks are rare enough to not track their pages
+    Thread->DebugStepBlocks.clear();
+  }
+
+  static void InvalidateSharedCodeRange(ContextImpl *CTX, uint64_t Start, uint64_t Length, bool Suspend) {
+    auto LookupCache = CTX->SharedLookupCache.get();
+    std::lock_guard<std::recursive_mutex> lk(LookupCache->WriteLock);
+
+    auto Blocks = LookupCache->TakeBlocksInRange(Start, Length);
+    for (auto Address: Blocks) {
+      for (auto &Thread : CTX->Threads) {
+        Thread->DebugStore.erase(Address);
       }
-      it->second.clear();
+    }
+    if (CTX->IsTieredCompilationEnabled()) {
+      CTX->EraseTierUpCounters(Blocks);
+    }
+    InvalidateLookupCacheRange(LookupCache, Start, Length, Suspend, Blocks);
+
+    for (auto &Thread : CTX->Threads) {
+      Thread->DebugStepBlocks.clear();
     }
   }
 
-  static void InvalidateGuestCodeRangeInternal(ContextImpl *CTX, uint64_t Start, uint64_t Length) {
+  static void InvalidateGuestCodeRangeInternal(ContextImpl *CTX, uint64_t Start, uint64_t Length, bool Suspend = false) {
+    // Lets compiles that generated their IR without the lock notice that it may be stale
+    CTX->RecentCodeInvalidations[CTX->CodeInvalidationEpoch % CTX->RecentCodeInvalidations.size()] = {Start, Start + Length};
+    ++CTX->CodeInvalidationEpoch;
+
     std::lock_guard lk(static_cast<ContextImpl*>(CTX)->ThreadCreationMutex);
 
+    if (CTX->IsCodeCacheShared()) {
+      // Only walk the shared cache once instead of once per thread
+      InvalidateSharedCodeRange(CTX, Start, Length, Suspend);
+      return;
+    }
+
     for (auto &Thread : static_cast<ContextImpl*>(CTX)->Threads) {
-      InvalidateGuestThreadCodeRange(Thread, Start, Length);
+      InvalidateGuestThreadCodeRange(Thread, Start, Length, Suspend);
     }
   }
 
@@ -1241,6 +2189,35 @@ namespace FEXCore::Context {
     CallAfter(Start, Length);
   }
 
+  void ContextImpl::SuspendGuestCodeRange(FEXCore::Core::InternalThreadState *Thread, uint64_t Start, uint64_t Length) {
+    ScopedPotentialDeferredSignalWithForkableUniqueLock lk(CodeInvalidationMutex, Thread);
+
+    InvalidateGuestCodeRangeInternal(this, Start, Length, CanSuspendBlocks());
+  }
+
+  void ContextImpl::SuspendGuestCodeRange(FEXCore::Core::InternalThreadState *Thread, uint64_t Start, uint64_t Length, CodeRangeInvalidationFn CallAfter) {
+    ScopedPotentialDeferredSignalWithForkableUniqueLock lk(CodeInvalidationMutex, Thread);
+
+    InvalidateGuestCodeRangeInternal(this, Start, Length, CanSuspendBlocks());
+    CallAfter(Start, Length);
+  }
+
+  void ContextImpl::SuspendGuestCodeRanges(FEXCore::Core::InternalThreadState *Thread, const fextl::vector<CodeRange> &Ranges, std::function<void()> CallAfter) {
+    ScopedPotentialDeferredSignalWithForkableUniqueLock lk(CodeInvalidationMutex, Thread);
+
+    const bool Suspend = CanSuspendBlocks();
+    for (const auto &Range : Ranges) {
+      InvalidateGuestCodeRangeInternal(this, Range.Start, Range.Length, Suspend);
+    }
+    CallAfter();
+  }
+
+  void ContextImpl::MigrateGuestCodeRange(uint64_t OldStart, uint64_t NewStart, uint64_t Length) {
+    if (RemapCache) {
+      RemapCache->Migrate(OldStart, NewStart, Length);
+    }
+  }
+
   void ContextImpl::MarkMemoryShared() {
     if (!IsMemoryShared) {
       IsMemoryShared = true;
@@ -1262,10 +2239,10 @@ namespace FEXCore::Context {
     }
   }
 
-  void ContextImpl::ThreadAddBlockLink(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestDestination, uintptr_t HostLink, const std::function<void()> &delinker) {
+  void ContextImpl::ThreadAddBlockLink(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestDestination, uintptr_t HostLink, FEXCore::BlockDelinkedRange (*Delinker)(uintptr_t HostLink, uintptr_t Data), uintptr_t Data) {
     ScopedDeferredSignalWithForkableSharedLock lk(static_cast<ContextImpl*>(Thread->CTX)->CodeInvalidationMutex, Thread);
 
-    Thread->LookupCache->AddBlockLink(GuestDestination, HostLink, delinker);
+    Thread->LookupCache->AddBlockLink(GuestDestination, HostLink, Delinker, Data);
   }
 
   void ContextImpl::ThreadRemoveCodeEntry(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP) {
@@ -1304,8 +2281,16 @@ namespace FEXCore::Context {
   }
 
   uint64_t HandleSyscall(FEXCore::HLE::SyscallHandler *Handler, FEXCore::Core::CpuStateFrame *Frame, FEXCore::HLE::SyscallArguments *Args) {
+    auto &Sequence = Frame->Thread->SyscallSequence;
+
+    // A new odd value on every entry, so a syscall that was left through a signal doesn't look like the next one
+    const auto Entry = (Sequence.load(std::memory_order_relaxed) | 1) + 2;
+    Sequence.store(Entry, std::memory_order_relaxed);
+
     uint64_t Result{};
     Result = Handler->HandleSyscall(Frame, Args);
+
+    Sequence.store(Entry & ~1ULL, std::memory_order_relaxed);
     return Result;
   }
 
@@ -1324,14 +2309,27 @@ namespace FEXCore::Context {
     }
   }
 
+  void ContextImpl::AddNamedRegion(uintptr_t Base, uintptr_t Size, uintptr_t Offset, const fextl::string &Filename) {
+    if (CodeObjectCacheService) {
+      CodeObjectCacheService->AsyncAddNamedRegionJob(Base, Size, Offset, Filename);
+    }
+  }
+
+  void ContextImpl::RemoveNamedRegion(uintptr_t Base, uintptr_t Size) {
+    if (CodeObjectCacheService) {
+      CodeObjectCacheService->AsyncRemoveNamedRegionJob(Base, Size);
+    }
+  }
+
   void ContextImpl::AppendThunkDefinitions(fextl::vector<FEXCore::IR::ThunkDefinition> const& Definitions) {
     if (ThunkHandler) {
       ThunkHandler->AppendThunkDefinitions(Definitions);
     }
   }
 
-  void ContextImpl::ConfigureAOTGen(FEXCore::Core::InternalThreadState *Thread, fextl::set<uint64_t> *ExternalBranches, uint64_t SectionMaxAddress) {
+  void ContextImpl::ConfigureAOTGen(FEXCore::Core::InternalThreadState *Thread, fextl::set<uint64_t> *ExternalBranches, uint64_t SectionMaxAddress, AOTGenStats *Stats) {
     Thread->FrontendDecoder->SetExternalBranches(ExternalBranches);
     Thread->FrontendDecoder->SetSectionMaxAddress(SectionMaxAddress);
+    Thread->AOTGenStats = Stats;
   }
 }
@@ -0,0 +1,82 @@
+/*
+$info$
+tags: glue|cycle-counter
+desc: Host cycle counter frequency detection and scaling for RDTSC
+$end_info$
+*/
+
+#include "Interface/Core/CycleCounter.h"
+
+#include <time.h>
+
+#ifdef _M_X86_64
+#include <x86intrin.h>
+#include <xbyak/xbyak_util.h>
+#endif
+
+namespace FEXCore::CycleCounter {
+#ifdef _M_ARM_64
+static uint64_t ReadHostCounter() {
+  uint64_t Result{};
+  __asm volatile("mrs %[Res], CNTVCT_EL0"
+      : [Res] "=r" (Result));
+  return Result;
+}
+
+uint64_t GetHostFrequency() {
+  uint64_t Result{};
+  __asm("mrs %[Res], CNTFRQ_EL0"
+      : [Res] "=r" (Result));
+  return Result;
+}
+#else
+static uint64_t ReadHostCounter() {
+  return __rdtsc();
+}
+
+uint64_t GetHostFrequency() {
+  uint32_t data[4];
+  Xbyak::util::Cpu::getCpuid(0, data);
+  if (data[0] >= 0x15) {
+    Xbyak::util::Cpu::getCpuid(0x15, data);
+
+    if (data[0] && data[1] && data[2]) {
+      return static_cast<uint64_t>(data[2]) * data[1] / data[0];
+    }
+  }
+  return 0;
+}
+#endif
+
+static uint64_t GetMonotonicNanoseconds() {
+  timespec Time{};
+  clock_gettime(CLOCK_MONOTONIC, &Time);
+  return Time.tv_sec * 1'000'000'000ULL + Time.tv_nsec;
+}
+
+uint64_t CalibrateHostFrequency() {
+  constexpr uint64_t CalibrationNanoseconds = 10'000'000ULL;
+
+  const uint64_t StartTime = GetMonotonicNanoseconds();
+  const uint64_t StartCounter = ReadHostCounter();
+  uint64_t EndTime{};
+  do {
+    EndTime = GetMonotonicNanoseconds();
+  } while ((EndTime - StartTime) < CalibrationNanoseconds);
+  const uint64_t EndCounter = ReadHostCounter();
+
+  return static_cast<uint64_t>((static_cast<unsigned __int128>(EndCounter - StartCounter) * 1'000'000'000ULL) / (EndTime - StartTime));
+}
+
+Scale CalculateScale(uint64_t HostFrequency, uint64_t GuestFrequency) {
+  // Use the largest shift whose multiplier still fits in 64 bits
+  for (uint32_t Shift = 63; Shift > 0; --Shift) {
+    const auto Multiplier = (static_cast<unsigned __int128>(GuestFrequency) << Shift) / HostFrequency;
+    if ((Multiplier >> 64) == 0) {
+      return {static_cast<uint64_t>(Multiplier), Shift};
+    }
+  }
+
+  return {GuestFrequency / HostFrequency, 0};
+}
+}
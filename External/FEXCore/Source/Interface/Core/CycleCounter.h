@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+
+namespace FEXCore::CycleCounter {
+/**
+ * @brief Converts host cycle counter ticks to guest TSC ticks
+ *
+ * Guest ticks = (Host ticks * Multiplier) >> Shift, where the product is the full 128-bit result.
+ * Backends split it over a low and high multiply and funnel shift the two halves back together.
+ */
+struct Scale {
+  uint64_t Multiplier;
+  uint32_t Shift;
+};
+
+// The interpreter reads CLOCK_REALTIME in nanoseconds as its cycle counter
+constexpr uint64_t InterpreterFrequency = 1'000'000'000ULL;
+
+/**
+ * @brief Frequency of the cycle counter the JIT reads on this host
+ *
+ * CNTFRQ_EL0 on AArch64, CPUID leaf 15h on x86-64.
+ *
+ * @return Frequency in Hz, 0 if the host doesn't report it
+ */
+uint64_t GetHostFrequency();
+
+/**
+ * @brief Measures the frequency of the host cycle counter against CLOCK_MONOTONIC
+ *
+ * Takes a few milliseconds, only use it when GetHostFrequency returns 0.
+ */
+uint64_t CalibrateHostFrequency();
+
+/**
+ * @brief Calculates the most precise Scale that converts HostFrequency ticks to GuestFrequency ticks
+ */
+Scale CalculateScale(uint64_t HostFrequency, uint64_t GuestFrequency);
+
+inline uint64_t Apply(uint64_t Counter, const Scale &Scale) {
+  return static_cast<uint64_t>((static_cast<unsigned __int128>(Counter) * Scale.Multiplier) >> Scale.Shift);
+}
+}
@@ -32,13 +32,109 @@
 
 namespace FEXCore::CPU {
 
-constexpr size_t MAX_DISPATCHER_CODE_SIZE = 4096;
+// The safepoint and gdb stop paths spill and fill the static registers, which is a lot of code with SVE256
+constexpr size_t MAX_DISPATCHER_CODE_SIZE = 4096 * 2;
 
 Arm64Dispatcher::Arm64Dispatcher(FEXCore::Context::ContextImpl *ctx, const DispatcherConfig &config)
   : FEXCore::CPU::Dispatcher(ctx, config), Arm64Emitter(ctx, MAX_DISPATCHER_CODE_SIZE) {
   EmitDispatcher();
 }
 
+void Arm64Dispatcher::EmitLongUnsignedDivide(bool Remainder, ARMEmitter::ForwardLabel *Overflow) {
+  // x0:x1 divided by x2 with two 64-bit by 32-bit digit steps, Hacker's Delight divlu.
+  // The JIT only expects x0-x3 to be clobbered, so the other scratch registers are saved here
+  // rather than spilling the static registers like the C helper has to.
+  const auto u1 = ARMEmitter::XReg::x0;
+  const auto u0 = ARMEmitter::XReg::x1;
+  const auto v = ARMEmitter::XReg::x2;
+  const auto s = ARMEmitter::XReg::x3;
+  const auto vn1 = ARMEmitter::XReg::x4;
+  const auto vn0 = ARMEmitter::XReg::x5;
+  const auto un1 = ARMEmitter::XReg::x6;
+  const auto un0 = ARMEmitter::XReg::x7;
+  const auto q1 = ARMEmitter::XReg::x8;
+  const auto rhat = ARMEmitter::XReg::x9;
+  const auto q0 = ARMEmitter::XReg::x10;
+  const auto Tmp = ARMEmitter::XReg::x11;
+  const auto Size = ARMEmitter::Size::i64Bit;
+
+  // The quotient only fits when the upper half is below the divisor, this also catches divide by zero
+  cmp(Size, u1, v);
+  b(ARMEmitter::Condition::CC_CS, Overflow);
+
+  stp<ARMEmitter::IndexType::PRE>(ARMEmitter::XReg::x4, ARMEmitter::XReg::x5, ARMEmitter::Reg::rsp, -64);
+  stp<ARMEmitter::IndexType::OFFSET>(ARMEmitter::XReg::x6, ARMEmitter::XReg::x7, ARMEmitter::Reg::rsp, 16);
+  stp<ARMEmitter::IndexType::OFFSET>(ARMEmitter::XReg::x8, ARMEmitter::XReg::x9, ARMEmitter::Reg::rsp, 32);
+  stp<ARMEmitter::IndexType::OFFSET>(ARMEmitter::XReg::x10, ARMEmitter::XReg::x11, ARMEmitter::Reg::rsp, 48);
+
+  // Normalize so the divisor's top bit is set
+  clz(Size, s, v);
+  lslv(Size, v, v, s);
+  lsr(Size, vn1, v, 32);
+  uxtw(Size, vn0, v);
+
+  // un32 = (u1 << s) | (u0 >> (64 - s)), where the split shift keeps s == 0 from shifting by 64
+  lslv(Size, u1, u1, s);
+  lsr(Size, Tmp, u0, 1);
+  mvn(Size, un0, s);
+  lsrv(Size, Tmp, Tmp, un0);
+  orr(Size, u1, u1, Tmp);
+
+  lslv(Size, u0, u0, s);
+  lsr(Size, un1, u0, 32);
+  uxtw(Size, un0, u0);
+
+  // Estimates a quotient digit of Dividend / vn1 then corrects it downwards, at most twice
+  auto QuotientDigit = [&](ARMEmitter::XRegister q, ARMEmitter::XRegister Dividend, ARMEmitter::XRegister Digit) {
+    ARMEmitter::BackwardLabel Again{};
+    ARMEmitter::ForwardLabel Adjust{};
+    ARMEmitter::ForwardLabel Done{};
+
+    udiv(Size, q, Dividend, vn1);
+    msub(Size, rhat, q, vn1, Dividend);
+
+    Bind(&Again);
+    lsr(Size, Tmp, q, 32);
+    cbnz(Size, Tmp, &Adjust);
+    mul(Size, Tmp, q, vn0);
+    orr(Size, u0, Digit, rhat, ARMEmitter::ShiftType::LSL, 32);
+    cmp(Size, Tmp, u0);
+    b(ARMEmitter::Condition::CC_LS, &Done);
+
+    Bind(&Adjust);
+    sub(Size, q, q, 1);
+    add(Size, rhat, rhat, vn1);
+    lsr(Size, Tmp, rhat, 32);
+    cbz(Size, Tmp, &Again);
+
+    Bind(&Done);
+  };
+
+  QuotientDigit(q1, u1, un1);
+
+  // un21 = un32 * b + un1 - q1 * v
+  orr(Size, Tmp, un1, u1, ARMEmitter::ShiftType::LSL, 32);
+  msub(Size, u1, q1, v, Tmp);
+
+  QuotientDigit(q0, u1, un0);
+
+  if (Remainder) {
+    // (un21 * b + un0 - q0 * v) >> s
+    orr(Size, Tmp, un0, u1, ARMEmitter::ShiftType::LSL, 32);
+    msub(Size, u1, q0, v, Tmp);
+    lsrv(Size, ARMEmitter::XReg::x0, u1, s);
+  }
+  else {
+    orr(Size, ARMEmitter::XReg::x0, q0, q1, ARMEmitter::ShiftType::LSL, 32);
+  }
+
+  ldp<ARMEmitter::IndexType::OFFSET>(ARMEmitter::XReg::x10, ARMEmitter::XReg::x11, ARMEmitter::Reg::rsp, 48);
+  ldp<ARMEmitter::IndexType::OFFSET>(ARMEmitter::XReg::x8, ARMEmitter::XReg::x9, ARMEmitter::Reg::rsp, 32);
+  ldp<ARMEmitter::IndexType::OFFSET>(ARMEmitter::XReg::x6, ARMEmitter::XReg::x7, ARMEmitter::Reg::rsp, 16);
+  ldp<ARMEmitter::IndexType::POST>(ARMEmitter::XReg::x4, ARMEmitter::XReg::x5, ARMEmitter::Reg::rsp, 64);
+  ret();
+}
+
 void Arm64Dispatcher::EmitDispatcher() {
 #ifdef VIXL_DISASSEMBLER
   const auto DisasmBegin = GetCursorAddress<const vixl::aarch64::Instruction*>();
@@ -56,6 +152,8 @@ void Arm64Dispatcher::EmitDispatcher() {
 
   ARMEmitter::ForwardLabel l_CTX;
   ARMEmitter::ForwardLabel l_Sleep;
+  ARMEmitter::ForwardLabel l_SafepointSleep;
+  ARMEmitter::ForwardLabel l_GdbStopSleep;
   ARMEmitter::ForwardLabel l_CompileBlock;
 
   // Push all the register we need to save
@@ -94,8 +192,9 @@ void Arm64Dispatcher::EmitDispatcher() {
 
   // L1 Cache
   ldr(ARMEmitter::XReg::x0, STATE_PTR(CpuStateFrame, Pointers.Common.L1Pointer));
+  ldr(ARMEmitter::XReg::x3, STATE_PTR(CpuStateFrame, Pointers.Common.L1Mask));
 
-  and_(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r3, RipReg.R(), LookupCache::L1_ENTRIES_MASK);
+  and_(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r3, RipReg.R(), ARMEmitter::Reg::r3);
   add(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r0, ARMEmitter::Reg::r0, ARMEmitter::Reg::r3, ARMEmitter::ShiftType::LSL , 4);
   ldp<ARMEmitter::IndexType::OFFSET>(ARMEmitter::XReg::x3, ARMEmitter::XReg::x0, ARMEmitter::Reg::r0, 0);
   cmp(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r0, RipReg.R());
@@ -154,8 +253,9 @@ void Arm64Dispatcher::EmitDispatcher() {
     {
       // update L1 cache
       ldr(ARMEmitter::XReg::x0, STATE_PTR(CpuStateFrame, Pointers.Common.L1Pointer));
+      ldr(ARMEmitter::XReg::x1, STATE_PTR(CpuStateFrame, Pointers.Common.L1Mask));
 
-      and_(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r1, RipReg.R(), LookupCache::L1_ENTRIES_MASK);
+      and_(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r1, RipReg.R(), ARMEmitter::Reg::r1);
       add(ARMEmitter::XReg::x0, ARMEmitter::XReg::x0, ARMEmitter::XReg::x1, ARMEmitter::ShiftType::LSL, 4);
       stp<ARMEmitter::IndexType::OFFSET>(ARMEmitter::XReg::x3, ARMEmitter::XReg::x2, ARMEmitter::Reg::r0);
 
@@ -333,6 +433,54 @@ void Arm64Dispatcher::EmitDispatcher() {
     hlt(0);
   }
 
+  {
+    SafepointHandlerAddressSpillSRA = GetCursorAddress<uint64_t>();
+    // A block entry saw a pending safepoint and has already synchronized RIP.
+    // Nothing but guest state is live here, so sleep without a signal frame and then redispatch.
+    if (config.StaticRegisterAllocation)
+      SpillStaticRegs(TMP1);
+
+    ldr(ARMEmitter::XReg::x0, &l_CTX);
+    mov(ARMEmitter::XReg::x1, STATE);
+    ldr(ARMEmitter::XReg::x2, &l_SafepointSleep);
+#ifdef VIXL_SIMULATOR
+    GenerateIndirectRuntimeCall<void, void *, void *>(ARMEmitter::Reg::r2);
+#else
+    blr(ARMEmitter::Reg::r2);
+#endif
+
+    ldr(ARMEmitter::XReg::x0, STATE_PTR(CpuStateFrame, Pointers.Common.DispatcherLoopTopFillSRA));
+    br(ARMEmitter::Reg::r0);
+  }
+
+  {
+    GdbStopHandlerAddressSpillSRA = GetCursorAddress<uint64_t>();
+    // A block entry found this thread stopped by the debugger and has already synchronized RIP.
+    // Like the safepoint handler this sleeps without a signal frame.
+    if (config.StaticRegisterAllocation)
+      SpillStaticRegs(TMP1);
+
+    ldr(ARMEmitter::XReg::x0, &l_CTX);
+    mov(ARMEmitter::XReg::x1, STATE);
+    ldr(ARMEmitter::XReg::x2, &l_GdbStopSleep);
+#ifdef VIXL_SIMULATOR
+    GenerateIndirectRuntimeCall<uint64_t, void *, void *>(ARMEmitter::Reg::r2);
+#else
+    blr(ARMEmitter::Reg::r2);
+#endif
+
+    // A non-zero result is the single step block to run, it doesn't live in the lookup cache
+    ARMEmitter::ForwardLabel l_Redispatch;
+    cbz(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r0, &l_Redispatch);
+    if (config.StaticRegisterAllocation)
+      FillStaticRegs();
+    br(ARMEmitter::Reg::r0);
+
+    Bind(&l_Redispatch);
+    ldr(ARMEmitter::XReg::x0, STATE_PTR(CpuStateFrame, Pointers.Common.DispatcherLoopTopFillSRA));
+    br(ARMEmitter::Reg::r0);
+  }
+
   {
     // The expectation here is that a thunked function needs to call back in to the JIT in a reentrant safe way
     // To do this safely we need to do some state tracking and register saving
@@ -388,6 +536,11 @@ void Arm64Dispatcher::EmitDispatcher() {
   {
     LUDIVHandlerAddress = GetCursorAddress<uint64_t>();
 
+    ARMEmitter::ForwardLabel Overflow{};
+    EmitLongUnsignedDivide(false, &Overflow);
+
+    // Quotient doesn't fit in 64 bits, leave it to the C helper
+    Bind(&Overflow);
     PushDynamicRegsAndLR(ARMEmitter::Reg::r3);
     SpillStaticRegs(ARMEmitter::Reg::r3);
 
@@ -432,6 +585,11 @@ void Arm64Dispatcher::EmitDispatcher() {
   {
     LUREMHandlerAddress = GetCursorAddress<uint64_t>();
 
+    ARMEmitter::ForwardLabel Overflow{};
+    EmitLongUnsignedDivide(true, &Overflow);
+
+    // Quotient doesn't fit in 64 bits, leave it to the C helper
+    Bind(&Overflow);
     PushDynamicRegsAndLR(ARMEmitter::Reg::r3);
     SpillStaticRegs(ARMEmitter::Reg::r3);
 
@@ -478,6 +636,10 @@ void Arm64Dispatcher::EmitDispatcher() {
   dc64(reinterpret_cast<uintptr_t>(CTX));
   Bind(&l_Sleep);
   dc64(reinterpret_cast<uint64_t>(SleepThread));
+  Bind(&l_SafepointSleep);
+  dc64(reinterpret_cast<uint64_t>(SafepointSleep));
+  Bind(&l_GdbStopSleep);
+  dc64(reinterpret_cast<uint64_t>(GdbStopSleep));
   Bind(&l_CompileBlock);
   dc64(GetCompileBlockPtr());
 
@@ -519,21 +681,30 @@ void Arm64Dispatcher::ExecuteJITCallback(FEXCore::Core::CpuStateFrame *Frame, ui
 
 #endif
 
-size_t Arm64Dispatcher::GenerateGDBPauseCheck(uint8_t *CodeBuffer, uint64_t GuestRIP) {
+size_t Arm64Dispatcher::GenerateGDBPauseCheck(uint8_t *CodeBuffer, uint64_t GuestRIP, bool Breakpoint) {
   FEXCore::ARMEmitter::Emitter emit{CodeBuffer, MaxGDBPauseCheckSize};
 
   ARMEmitter::ForwardLabel RunBlock;
-
-  // If we have a gdb server running then run in a less efficient mode that checks if we need to exit
-  // This happens when single stepping
-
-  static_assert(sizeof(FEXCore::Context::ContextImpl::Config.RunningMode) == 4, "This is expected to be size of 4");
-  emit.ldr(ARMEmitter::XReg::x0, STATE_PTR(CpuStateFrame, Thread));
-  emit.ldr(ARMEmitter::XReg::x0, ARMEmitter::Reg::r0, offsetof(FEXCore::Core::InternalThreadState, CTX)); // Get Context
-  emit.ldr(ARMEmitter::WReg::w0, ARMEmitter::Reg::r0, offsetof(FEXCore::Context::ContextImpl, Config.RunningMode));
-
-  // If the value == 0 then we don't need to stop
-  emit.cbz(ARMEmitter::Size::i32Bit, ARMEmitter::Reg::r0, &RunBlock);
+  ARMEmitter::ForwardLabel StopThread;
+
+  // If we have a gdb server running then run in a less efficient mode that checks if this thread needs to stop
+  // This happens on breakpoints, single stepping and when the debugger interrupts the thread
+  using FEXCore::Core::CpuStateFrame;
+  static_assert(sizeof(CpuStateFrame::GdbStop) == 4, "This is expected to be size of 4");
+  emit.ldr(ARMEmitter::WReg::w0, STATE_PTR(CpuStateFrame, GdbStop));
+
+  // GDB_RUN only stops on a breakpoint
+  emit.cbz(ARMEmitter::Size::i32Bit, ARMEmitter::Reg::r0, Breakpoint ? &StopThread : &RunBlock);
+
+  // GDB_STEP runs this block and stops at the next one, GDB_RESUME runs this block and goes back to GDB_RUN
+  emit.cmp(ARMEmitter::Size::i32Bit, ARMEmitter::Reg::r0, CpuStateFrame::GDB_STOP);
+  emit.b(ARMEmitter::Condition::CC_EQ, &StopThread);
+  emit.sub(ARMEmitter::Size::i32Bit, ARMEmitter::Reg::r0, ARMEmitter::Reg::r0, CpuStateFrame::GDB_STEP);
+  emit.eor(ARMEmitter::Size::i32Bit, ARMEmitter::Reg::r0, ARMEmitter::Reg::r0, 1);
+  emit.str(ARMEmitter::WReg::w0, STATE_PTR(CpuStateFrame, GdbStop));
+  emit.b(&RunBlock);
+
+  emit.Bind(&StopThread);
   {
     ARMEmitter::ForwardLabel l_GuestRIP;
     // Make sure RIP is syncronized to the context
@@ -541,7 +712,7 @@ size_t Arm64Dispatcher::GenerateGDBPauseCheck(uint8_t *CodeBuffer, uint64_t Gues
     emit.str(ARMEmitter::XReg::x0, STATE_PTR(CpuStateFrame, State.rip));
 
     // Stop the thread
-    emit.ldr(ARMEmitter::XReg::x0, STATE_PTR(CpuStateFrame, Pointers.Common.ThreadPauseHandlerSpillSRA));
+    emit.ldr(ARMEmitter::XReg::x0, STATE_PTR(CpuStateFrame, Pointers.Common.GdbStopHandlerSpillSRA));
     emit.br(ARMEmitter::Reg::r0);
     emit.Bind(&l_GuestRIP);
     emit.dc64(GuestRIP);
@@ -585,6 +756,8 @@ void Arm64Dispatcher::InitThreadPointers(FEXCore::Core::InternalThreadState *Thr
     Common.ExitFunctionLinker = ExitFunctionLinkerAddress;
     Common.ThreadStopHandlerSpillSRA = ThreadStopHandlerAddressSpillSRA;
     Common.ThreadPauseHandlerSpillSRA = ThreadPauseHandlerAddressSpillSRA;
+    Common.SafepointHandlerSpillSRA = SafepointHandlerAddressSpillSRA;
+    Common.GdbStopHandlerSpillSRA = GdbStopHandlerAddressSpillSRA;
     Common.GuestSignal_SIGILL = GuestSignal_SIGILL;
     Common.GuestSignal_SIGTRAP = GuestSignal_SIGTRAP;
     Common.GuestSignal_SIGSEGV = GuestSignal_SIGSEGV;
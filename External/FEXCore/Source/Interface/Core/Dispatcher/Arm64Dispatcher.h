@@ -20,7 +20,7 @@ class Arm64Dispatcher final : public Dispatcher, public Arm64Emitter {
   public:
     Arm64Dispatcher(FEXCore::Context::ContextImpl *ctx, const DispatcherConfig &config);
     void InitThreadPointers(FEXCore::Core::InternalThreadState *Thread) override;
-    size_t GenerateGDBPauseCheck(uint8_t *CodeBuffer, uint64_t GuestRIP) override;
+    size_t GenerateGDBPauseCheck(uint8_t *CodeBuffer, uint64_t GuestRIP, bool Breakpoint) override;
     size_t GenerateInterpreterTrampoline(uint8_t *CodeBuffer) override;
 
 #ifdef VIXL_SIMULATOR
@@ -51,6 +51,9 @@ class Arm64Dispatcher final : public Dispatcher, public Arm64Emitter {
   }
 
   private:
+    // Inline 128-bit by 64-bit unsigned divide for LUDIV/LUREM, branches to Overflow when the quotient doesn't fit.
+    void EmitLongUnsignedDivide(bool Remainder, ARMEmitter::ForwardLabel *Overflow);
+
     // Long division helpers
     uint64_t LUDIVHandlerAddress{};
     uint64_t LDIVHandlerAddress{};
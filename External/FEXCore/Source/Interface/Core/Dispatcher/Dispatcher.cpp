@@ -38,6 +38,34 @@ void Dispatcher::SleepThread(FEXCore::Context::ContextImpl *ctx, FEXCore::Core::
   ctx->IdleWaitCV.notify_all();
 }
 
+void Dispatcher::SafepointSleep(FEXCore::Context::ContextImpl *ctx, FEXCore::Core::CpuStateFrame *Frame) {
+  // Claim the request before sleeping.
+  // If the pausing thread already took it back then a pause signal is on its way and that does the sleeping.
+  if (Frame->SafepointRequested.exchange(0) == 0) {
+    return;
+  }
+
+  SleepThread(ctx, Frame);
+}
+
+uint64_t Dispatcher::GdbStopSleep(FEXCore::Context::ContextImpl *ctx, FEXCore::Core::CpuStateFrame *Frame) {
+  auto Thread = Frame->Thread;
+
+  Thread->RunningEvents.GdbStoppedAtBlockEntry = true;
+  ctx->ReportGdbStop(Thread);
+  SleepThread(ctx, Frame);
+  Thread->RunningEvents.GdbStoppedAtBlockEntry = false;
+
+  // Resuming sets a signal return reason for threads that were paused by a signal, this one wasn't
+  Thread->SignalReason.store(FEXCore::Core::SignalEvent::Nothing);
+
+  if (Frame->GdbStop.load() != FEXCore::Core::CpuStateFrame::GDB_STEP) {
+    return 0;
+  }
+
+  return ctx->CompileDebugStepBlock(Frame, Frame->State.rip);
+}
+
 uint64_t Dispatcher::GetCompileBlockPtr() {
   using ClassPtrType = void (FEXCore::Context::ContextImpl::*)(FEXCore::Core::CpuStateFrame *, uint64_t);
   union PtrCast {
@@ -41,6 +41,8 @@ public:
   uint64_t AbsoluteLoopTopAddressFillSRA{};
   uint64_t ThreadPauseHandlerAddress{};
   uint64_t ThreadPauseHandlerAddressSpillSRA{};
+  uint64_t SafepointHandlerAddressSpillSRA{};
+  uint64_t GdbStopHandlerAddressSpillSRA{};
   uint64_t ExitFunctionLinkerAddress{};
   uint64_t SignalHandlerReturnAddress{};
   uint64_t SignalHandlerReturnAddressRT{};
@@ -62,7 +64,12 @@ public:
   static constexpr size_t MaxGDBPauseCheckSize = 128;
   static constexpr size_t MaxInterpreterTrampolineSize = 128;
 
-  virtual size_t GenerateGDBPauseCheck(uint8_t *CodeBuffer, uint64_t GuestRIP) = 0;
+  /**
+   * @brief Generates the block entry check of the thread's debugger state
+   *
+   * @param Breakpoint - The block entry has a gdb breakpoint, stop here unless the thread is resuming from it
+   */
+  virtual size_t GenerateGDBPauseCheck(uint8_t *CodeBuffer, uint64_t GuestRIP, bool Breakpoint) = 0;
   virtual size_t GenerateInterpreterTrampoline(uint8_t *CodeBuffer) = 0;
 
   static fextl::unique_ptr<Dispatcher> CreateX86(FEXCore::Context::ContextImpl *CTX, const DispatcherConfig &Config);
@@ -102,6 +109,9 @@ protected:
   DispatcherConfig config;
 
   static void SleepThread(FEXCore::Context::ContextImpl *ctx, FEXCore::Core::CpuStateFrame *Frame);
+  static void SafepointSleep(FEXCore::Context::ContextImpl *ctx, FEXCore::Core::CpuStateFrame *Frame);
+  // Returns the single step block to continue in, zero to redispatch
+  static uint64_t GdbStopSleep(FEXCore::Context::ContextImpl *ctx, FEXCore::Core::CpuStateFrame *Frame);
 
   static uint64_t GetCompileBlockPtr();
 
@@ -103,7 +103,7 @@ X86Dispatcher::X86Dispatcher(FEXCore::Context::ContextImpl *ctx, const Dispatche
     mov(r13, qword STATE_PTR(CpuStateFrame, Pointers.Common.L1Pointer));
     mov(rax, rdx);
 
-    and_(rax, LookupCache::L1_ENTRIES_MASK);
+    and_(rax, qword STATE_PTR(CpuStateFrame, Pointers.Common.L1Mask));
     shl(rax, 4);
     cmp(qword[r13 + rax + offsetof(FEXCore::LookupCache::LookupCacheEntry, GuestCode)], rdx);
     jne(FullLookup);
@@ -145,7 +145,7 @@ X86Dispatcher::X86Dispatcher(FEXCore::Context::ContextImpl *ctx, const Dispatche
     // Update L1
     mov(r13, qword STATE_PTR(CpuStateFrame, Pointers.Common.L1Pointer));
     mov(rcx, rdx);
-    and_(rcx, LookupCache::L1_ENTRIES_MASK);
+    and_(rcx, qword STATE_PTR(CpuStateFrame, Pointers.Common.L1Mask));
     shl(rcx, 1);
     mov(qword[r13 + rcx*8 + 8], rdx);
     mov(qword[r13 + rcx*8 + 0], rax);
@@ -236,6 +236,23 @@ X86Dispatcher::X86Dispatcher(FEXCore::Context::ContextImpl *ctx, const Dispatche
     ud2();
   }
 
+  {
+    // A block entry found this thread stopped by the debugger and has already synchronized RIP.
+    // Unlike the signal based pause this has no host state to restore, so it can resume.
+    GdbStopHandlerAddressSpillSRA = getCurr<uint64_t>();
+
+    mov(rdi, reinterpret_cast<uintptr_t>(CTX));
+    mov(rsi, STATE);
+    mov(rax, reinterpret_cast<uint64_t>(GdbStopSleep));
+
+    call(rax);
+
+    // A non-zero result is the single step block to run, it doesn't live in the lookup cache
+    test(rax, rax);
+    jz(LoopTop, T_NEAR);
+    jmp(rax);
+  }
+
   {
     CallbackPtr = getCurr<JITCallback>();
 
@@ -349,7 +366,7 @@ X86Dispatcher::X86Dispatcher(FEXCore::Context::ContextImpl *ctx, const Dispatche
 
 }
 
-size_t X86Dispatcher::GenerateGDBPauseCheck(uint8_t *CodeBuffer, uint64_t GuestRIP) {
+size_t X86Dispatcher::GenerateGDBPauseCheck(uint8_t *CodeBuffer, uint64_t GuestRIP, bool Breakpoint) {
   using namespace Xbyak;
   using namespace Xbyak::util;
 
@@ -357,22 +374,34 @@ size_t X86Dispatcher::GenerateGDBPauseCheck(uint8_t *CodeBuffer, uint64_t GuestR
   emit.setNewBuffer(CodeBuffer, MaxGDBPauseCheckSize);
 
   Label RunBlock;
-
-  // If we have a gdb server running then run in a less efficient mode that checks if we need to exit
-  // This happens when single stepping
-  static_assert(sizeof(CTX->Config.RunningMode) == 4, "This is expected to be size of 4");
-  emit.mov(rax, reinterpret_cast<uint64_t>(CTX));
-
-  // If the value == 0 then we don't need to stop
-  emit.cmp(dword [rax + (offsetof(FEXCore::Context::ContextImpl, Config.RunningMode))], 0);
-  emit.je(RunBlock);
+  Label StopThread;
+
+  // If we have a gdb server running then run in a less efficient mode that checks if this thread needs to stop
+  // This happens on breakpoints, single stepping and when the debugger interrupts the thread
+  using FEXCore::Core::CpuStateFrame;
+  static_assert(sizeof(CpuStateFrame::GdbStop) == 4, "This is expected to be size of 4");
+  emit.mov(eax, dword STATE_PTR(CpuStateFrame, GdbStop));
+
+  // GDB_RUN only stops on a breakpoint
+  emit.test(eax, eax);
+  emit.jz(Breakpoint ? StopThread : RunBlock);
+
+  // GDB_STEP runs this block and stops at the next one, GDB_RESUME runs this block and goes back to GDB_RUN
+  emit.cmp(eax, CpuStateFrame::GDB_STOP);
+  emit.je(StopThread);
+  emit.sub(eax, CpuStateFrame::GDB_STEP);
+  emit.xor_(eax, 1);
+  emit.mov(dword STATE_PTR(CpuStateFrame, GdbStop), eax);
+  emit.jmp(RunBlock);
+
+  emit.L(StopThread);
   {
     // Make sure RIP is syncronized to the context
     emit.mov(rax, GuestRIP);
     emit.mov(qword STATE_PTR(CpuStateFrame, State.rip), rax);
 
     // Stop the thread
-    emit.mov(rax, qword STATE_PTR(CpuStateFrame, Pointers.Common.ThreadPauseHandlerSpillSRA));
+    emit.mov(rax, qword STATE_PTR(CpuStateFrame, Pointers.Common.GdbStopHandlerSpillSRA));
     emit.jmp(rax);
   }
 
@@ -420,6 +449,7 @@ void X86Dispatcher::InitThreadPointers(FEXCore::Core::InternalThreadState *Threa
     Common.ExitFunctionLinker = ExitFunctionLinkerAddress;
     Common.ThreadStopHandlerSpillSRA = ThreadStopHandlerAddress;
     Common.ThreadPauseHandlerSpillSRA = ThreadPauseHandlerAddress;
+    Common.GdbStopHandlerSpillSRA = GdbStopHandlerAddressSpillSRA;
     Common.GuestSignal_SIGILL = GuestSignal_SIGILL;
     Common.GuestSignal_SIGTRAP = GuestSignal_SIGTRAP;
     Common.GuestSignal_SIGSEGV = GuestSignal_SIGSEGV;
@@ -0,0 +1,140 @@
+/*
+$info$
+tags: glue|driver
+desc: Tracks interpreter fallback execution counts fed by JIT code, and reports the x86 instructions hitting them
+$end_info$
+*/
+
+#include "Interface/Core/FallbackProfile.h"
+
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/fextl/fmt.h>
+
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace FEXCore {
+  uint64_t *FallbackProfile::GetCounter(uint64_t GuestRIP, uint32_t HandlerIndex, std::string_view Instruction, std::string_view Op,
+                                        const fextl::string *Filename, uint64_t FileOffset) {
+    std::lock_guard lk(Lock);
+
+    auto [it, Inserted] = SiteIndex.try_emplace({GuestRIP, HandlerIndex}, Counters.size());
+    if (!Inserted) {
+      return &Counters[it->second];
+    }
+
+    uint32_t FileIdx = ~0U;
+    if (Filename) {
+      auto [FileIt, FileInserted] = FileIndex.try_emplace(*Filename, Files.size());
+      if (FileInserted) {
+        Files.emplace_back(*Filename);
+      }
+      FileIdx = FileIt->second;
+    }
+
+    Counters.emplace_back(0);
+    Sites.emplace_back(SiteInfo {
+      .GuestRIP = GuestRIP,
+      .FileOffset = FileOffset,
+      .Instruction = Instruction.empty() ? std::string_view("<unknown>") : Instruction,
+      .Op = Op,
+      .FileIndex = FileIdx,
+    });
+
+    return &Counters.back();
+  }
+
+  fextl::string FallbackProfile::FormatLocation(const SiteInfo &Site) const {
+    if (Site.FileIndex != ~0U) {
+      return fextl::fmt::format("{}+0x{:x}", Files[Site.FileIndex], Site.FileOffset);
+    }
+    return "<anonymous>";
+  }
+
+  void FallbackProfile::Dump(size_t TopN, const fextl::string &OutputFile) {
+    std::lock_guard lk(Lock);
+
+    uint64_t Total {};
+    for (auto Count : Counters) {
+      Total += Count;
+    }
+
+    // Totals per instruction and fallback op, independent of where the instruction lives
+    struct InstructionTotal {
+      std::string_view Instruction;
+      std::string_view Op;
+      uint64_t Count;
+      size_t NumSites;
+    };
+    fextl::vector<InstructionTotal> Instructions;
+    {
+      fextl::unordered_map<fextl::string, size_t> InstructionIndex;
+      for (size_t i = 0; i < Sites.size(); ++i) {
+        const auto &Site = Sites[i];
+        auto [it, Inserted] = InstructionIndex.try_emplace(fextl::fmt::format("{} {}", Site.Instruction, Site.Op), Instructions.size());
+        if (Inserted) {
+          Instructions.emplace_back(InstructionTotal { Site.Instruction, Site.Op, 0, 0 });
+        }
+        Instructions[it->second].Count += Counters[i];
+        ++Instructions[it->second].NumSites;
+      }
+    }
+
+    std::sort(Instructions.begin(), Instructions.end(), [](const InstructionTotal &lhs, const InstructionTotal &rhs) {
+      return lhs.Count > rhs.Count;
+    });
+
+    LogMan::Msg::IFmt("Fallback profile: {} executions over {} sites", Total, Sites.size());
+    LogMan::Msg::IFmt("  By instruction:");
+    for (size_t i = 0; i < std::min(TopN, Instructions.size()); ++i) {
+      const auto &Inst = Instructions[i];
+      LogMan::Msg::IFmt("  {:>16} {:>6.2f}% {} -> {} ({} sites)", Inst.Count, Total ? Inst.Count * 100.0 / Total : 0.0,
+                        Inst.Instruction, Inst.Op, Inst.NumSites);
+    }
+
+    fextl::vector<size_t> Order(Counters.size());
+    for (size_t i = 0; i < Order.size(); ++i) {
+      Order[i] = i;
+    }
+
+    const size_t TopSites = std::min(TopN, Order.size());
+    std::partial_sort(Order.begin(), Order.begin() + TopSites, Order.end(), [this](size_t lhs, size_t rhs) {
+      return Counters[lhs] > Counters[rhs];
+    });
+
+    LogMan::Msg::IFmt("  By site:");
+    for (size_t i = 0; i < TopSites; ++i) {
+      const auto &Site = Sites[Order[i]];
+      LogMan::Msg::IFmt("  {:>16} 0x{:x} {} -> {} {}", Counters[Order[i]], Site.GuestRIP, Site.Instruction, Site.Op, FormatLocation(Site));
+    }
+
+    if (OutputFile.empty()) {
+      return;
+    }
+
+    // <count> <instruction> <op> <guest rip> <location>
+    fextl::string Output;
+    for (size_t i = 0; i < Sites.size(); ++i) {
+      const auto &Site = Sites[i];
+      Output += fextl::fmt::format("{}\t{}\t{}\t0x{:x}\t{}\n", Counters[i], Site.Instruction, Site.Op, Site.GuestRIP, FormatLocation(Site));
+    }
+
+    const auto Path = fextl::fmt::format("{}.{}", OutputFile, ::getpid());
+    int FD = open(Path.c_str(), O_CREAT | O_TRUNC | O_WRONLY | O_CLOEXEC, 0644);
+    if (FD == -1) {
+      LogMan::Msg::EFmt("Fallback profile: Couldn't open {}", Path);
+      return;
+    }
+
+    size_t Offset = 0;
+    while (Offset < Output.size()) {
+      auto Result = write(FD, Output.data() + Offset, Output.size() - Offset);
+      if (Result <= 0) {
+        break;
+      }
+      Offset += Result;
+    }
+    close(FD);
+  }
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <FEXCore/fextl/deque.h>
+#include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/unordered_map.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+
+namespace FEXCore {
+/**
+ * @brief Dynamic execution counts of interpreter fallbacks, per guest instruction
+ *
+ * Each fallback site emitted by a JIT backend increments its counter before calling the fallback handler.
+ * Counters are shared between threads and aren't atomic, counts are approximate under contention.
+ *
+ * The report groups sites by x86 instruction and IR op, which is the list of native lowerings worth writing next.
+ */
+class FallbackProfile {
+public:
+  /**
+   * @brief Returns the counter for a fallback site, creating it on first use
+   *
+   * @param GuestRIP - Guest instruction that generated the fallback IR op
+   * @param HandlerIndex - FallbackInfo::HandlerIndex of the fallback
+   * @param Instruction - x86 instruction name, empty when it isn't known
+   * @param Op - Name of the IR op without a native lowering
+   * @param Filename - File backing GuestRIP, or nullptr for anonymous memory
+   * @param FileOffset - Offset of GuestRIP in to Filename
+   *
+   * @return Pointer to the counter, it remains valid for the lifetime of the profile
+   */
+  uint64_t *GetCounter(uint64_t GuestRIP, uint32_t HandlerIndex, std::string_view Instruction, std::string_view Op,
+                       const fextl::string *Filename, uint64_t FileOffset);
+
+  /**
+   * @brief Logs the TopN most executed fallbacks, by instruction and by site
+   *
+   * @param OutputFile - When not empty every site is also written to OutputFile.<pid>, one tab separated line per site
+   */
+  void Dump(size_t TopN, const fextl::string &OutputFile);
+
+private:
+  struct SiteInfo {
+    uint64_t GuestRIP;
+    uint64_t FileOffset;
+    // Both point to static strings
+    std::string_view Instruction;
+    std::string_view Op;
+    // Index in to Files, ~0U for anonymous memory
+    uint32_t FileIndex;
+  };
+
+  std::mutex Lock;
+
+  // Counters and Sites are indexed in parallel.
+  // A deque never moves its elements on growth, so JIT code can keep pointers in to Counters.
+  fextl::deque<uint64_t> Counters;
+  fextl::vector<SiteInfo> Sites;
+  // Keyed on GuestRIP and HandlerIndex, one instruction can use multiple fallbacks
+  struct SiteKeyHash {
+    size_t operator()(const std::pair<uint64_t, uint32_t> &Key) const {
+      return Key.first ^ (static_cast<uint64_t>(Key.second) << 48);
+    }
+  };
+  fextl::unordered_map<std::pair<uint64_t, uint32_t>, size_t, SiteKeyHash> SiteIndex;
+
+  // File names are interned, most sites come from a handful of files
+  fextl::vector<fextl::string> Files;
+  fextl::unordered_map<fextl::string, uint32_t> FileIndex;
+
+  fextl::string FormatLocation(const SiteInfo &Site) const;
+};
+}
@@ -12,6 +12,7 @@ $end_info$
 #include <array>
 #include <algorithm>
 #include <cstring>
+#include <functional>
 #include <FEXCore/Config/Config.h>
 #include <FEXCore/Core/X86Enums.h>
 #include <FEXCore/HLE/SyscallHandler.h>
@@ -80,7 +81,9 @@ static uint32_t MapVEXToReg(uint8_t vvvv, bool HasXMM) {
 Decoder::Decoder(FEXCore::Context::ContextImpl *ctx)
   : CTX {ctx}
   , OSABI { ctx->SyscallHandler ? ctx->SyscallHandler->GetOSABI() : FEXCore::HLE::SyscallOSABI::OS_UNKNOWN }
-  , PoolObject {ctx->FrontendAllocator, sizeof(FEXCore::X86Tables::DecodedInst) * DefaultDecodedBufferSize} {
+  , Multiblock { ctx->Config.Multiblock }
+  , PoolObject {ctx->FrontendAllocator, sizeof(FEXCore::X86Tables::DecodedInst) * DefaultDecodedBufferSize}
+  , DecodeCacheEnabled { ctx->Config.DecodeCache } {
 }
 
 Decoder::~Decoder() {
@@ -979,8 +982,40 @@ bool Decoder::DecodeInstruction(uint64_t PC) {
   return true;
 }
 
+bool Decoder::DecodeInstructionCached(uint64_t PC) {
+  if (!DecodeCacheEnabled) {
+    return DecodeInstruction(PC);
+  }
+
+  auto it = DecodeCache.find(PC);
+  if (it != DecodeCache.end() &&
+      memcmp(it->second.Bytes.data(), InstStream, it->second.Inst.InstSize) == 0) {
+    DecodeInst = &DecodedBuffer[DecodedSize];
+    memcpy(DecodeInst, &it->second.Inst, sizeof(DecodedInst));
+    return true;
+  }
+
+  if (!DecodeInstruction(PC)) {
+    return false;
+  }
+
+  if (DecodeInst->InstSize == 0) [[unlikely]] {
+    return true;
+  }
+
+  if (DecodeCache.size() >= MaxDecodeCacheEntries) [[unlikely]] {
+    DecodeCache.clear();
+  }
+
+  auto &Entry = DecodeCache[PC];
+  memcpy(&Entry.Inst, DecodeInst, sizeof(DecodedInst));
+  // Immediates are skipped rather than read in to Instruction, copy from the stream
+  memcpy(Entry.Bytes.data(), InstStream, DecodeInst->InstSize);
+  return true;
+}
+
 void Decoder::BranchTargetInMultiblockRange() {
-  if (!CTX->Config.Multiblock)
+  if (!Multiblock)
     return;
 
   // If the RIP setting is conditional AND within our symbol range then it can be considered for multiblock
@@ -1005,11 +1040,32 @@ void Decoder::BranchTargetInMultiblockRange() {
       TargetRIP = DecodeInst->PC + DecodeInst->InstSize + DecodeInst->Src[0].Data.Literal.Value;
       Conditional = false;
     break;
-    case 0xE8: // Call - Immediate target, We don't want to inline calls
+    case 0xE8: { // Call - Immediate target, only short leaf callees are inlined
+      const uint64_t ReturnRIP = DecodeInst->PC + DecodeInst->InstSize;
       if (ExternalBranches) {
-        ExternalBranches->insert(DecodeInst->PC + DecodeInst->InstSize);
+        ExternalBranches->insert(ReturnRIP);
       }
-      [[fallthrough]];
+
+      LOGMAN_THROW_A_FMT(DecodeInst->Src[0].IsLiteral(), "Had wrong operand type");
+      TargetRIP = ReturnRIP + DecodeInst->Src[0].Data.Literal.Value;
+      if (GPRSize == 4) {
+        TargetRIP &= 0xFFFFFFFFU;
+      }
+
+      const uint64_t Distance = TargetRIP > DecodeInst->PC ? TargetRIP - DecodeInst->PC : DecodeInst->PC - TargetRIP;
+      if (CTX->Config.MultiblockInlineCalls() && TargetRIP != ReturnRIP &&
+          Distance < MaxInlineCallDistance && TargetRIP < SectionMaxAddress) {
+        // Decoded as regular blocks, ResolveInlinedCalls decides once the callee's block is known
+        PendingInlineCalls.emplace_back(PendingInlineCall {
+          .CallRIP = DecodeInst->PC,
+          .TargetRIP = TargetRIP,
+          .ReturnRIP = ReturnRIP,
+        });
+        AddBlockToDecode(TargetRIP);
+        AddBlockToDecode(ReturnRIP);
+      }
+      return;
+    }
     case 0xC2: // RET imm
     case 0xC3: // RET
     default:
@@ -1030,15 +1086,10 @@ void Decoder::BranchTargetInMultiblockRange() {
       MaxCondBranchBackwards = std::min(MaxCondBranchBackwards, TargetRIP);
 
       // If we are conditional then a target can be the instruction past the conditional instruction
-      uint64_t FallthroughRIP = DecodeInst->PC + DecodeInst->InstSize;
-      if (!HasBlocks.contains(FallthroughRIP)) {
-        BlocksToDecode.insert(FallthroughRIP);
-      }
+      AddBlockToDecode(DecodeInst->PC + DecodeInst->InstSize);
     }
 
-    if (!HasBlocks.contains(TargetRIP)) {
-      BlocksToDecode.insert(TargetRIP);
-    }
+    AddBlockToDecode(TargetRIP);
   } else {
     if (ExternalBranches) {
       ExternalBranches->insert(TargetRIP);
@@ -1046,6 +1097,252 @@ void Decoder::BranchTargetInMultiblockRange() {
   }
 }
 
+void Decoder::AddBlockToDecode(uint64_t RIP) {
+  if (HasBlocks.count(RIP)) {
+    return;
+  }
+
+  // Breakpoints need a block of their own, the stop check only runs at block entry
+  if (CTX->IsGdbBreakpoint(RIP)) {
+    return;
+  }
+
+  BlocksToDecode.push_back(RIP);
+  std::push_heap(BlocksToDecode.begin(), BlocksToDecode.end(), std::greater<>{});
+}
+
+namespace {
+  constexpr uint16_t PrimaryGroupOp(InstType Group, uint8_t Op, uint8_t Reg) {
+    return ((Group - TYPE_GROUP_1) << 6) | (OpToIndex(Op) << 3) | Reg;
+  }
+
+  bool IsInst(const DecodedInst &Inst, const X86InstInfo &Info) {
+    return Inst.TableInfo == &Info;
+  }
+
+  bool IsGPR(const DecodedOperand &Operand, uint32_t GPR) {
+    return Operand.IsGPR() && !Operand.Data.GPR.HighBits && Operand.Data.GPR.GPR == GPR;
+  }
+}
+
+/**
+ * @brief Finds how many entries the jump table indexed by IndexReg has
+ *
+ * Compilers bounds check the switch value with a cmp against the largest case and an unsigned jcc,
+ * which ends a block of its own that either falls through or jumps to the block doing the table jump.
+ *
+ * @return The number of entries, 0 if no bounds check was found
+ */
+uint64_t Decoder::FindJumpTableBound(uint64_t BlockEntry, size_t BlockStartOffset, uint32_t IndexReg) const {
+  const uint8_t GPRSize = CTX->GetGPRSize();
+
+  for (size_t i = 1; i < BlockStartOffset; ++i) {
+    const auto &Jcc = DecodedBuffer[i];
+    const auto &Cmp = DecodedBuffer[i - 1];
+
+    if (!Jcc.TableInfo || !Cmp.TableInfo || Cmp.PC + Cmp.InstSize != Jcc.PC) {
+      continue;
+    }
+
+    const uint64_t NextRIP = Jcc.PC + Jcc.InstSize;
+    uint64_t TargetRIP = Jcc.Src[0].IsLiteral() ? NextRIP + Jcc.Src[0].Data.Literal.Value : 0;
+    if (GPRSize == 4) {
+      TargetRIP &= 0xFFFFFFFFU;
+    }
+
+    // Taken when the value is in bounds, or falls through when it is
+    bool Inclusive{};
+    if ((IsInst(Jcc, BaseOps[0x77]) || IsInst(Jcc, SecondBaseOps[0x87])) && NextRIP == BlockEntry) {
+      // ja
+      Inclusive = true;
+    }
+    else if ((IsInst(Jcc, BaseOps[0x73]) || IsInst(Jcc, SecondBaseOps[0x83])) && NextRIP == BlockEntry) {
+      // jae
+      Inclusive = false;
+    }
+    else if ((IsInst(Jcc, BaseOps[0x76]) || IsInst(Jcc, SecondBaseOps[0x86])) && TargetRIP == BlockEntry) {
+      // jbe
+      Inclusive = true;
+    }
+    else if ((IsInst(Jcc, BaseOps[0x72]) || IsInst(Jcc, SecondBaseOps[0x82])) && TargetRIP == BlockEntry) {
+      // jb
+      Inclusive = false;
+    }
+    else {
+      continue;
+    }
+
+    const bool IsCmpImm = IsInst(Cmp, PrimaryInstGroupOps[PrimaryGroupOp(TYPE_GROUP_1, 0x83, 7)]) ||
+                          IsInst(Cmp, PrimaryInstGroupOps[PrimaryGroupOp(TYPE_GROUP_1, 0x81, 7)]) ||
+                          IsInst(Cmp, BaseOps[0x3D]);
+    if (!IsCmpImm || !IsGPR(Cmp.Dest, IndexReg) || !Cmp.Src[0].IsLiteral()) {
+      return 0;
+    }
+
+    const uint64_t Limit = Cmp.Src[0].Data.Literal.Value;
+    if (Limit >= MaxJumpTableEntries) {
+      return 0;
+    }
+    return Inclusive ? Limit + 1 : Limit;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Turns an indirect jump through a switch jump table in to in-region branch targets
+ *
+ * Recognizes the two forms compilers emit, with a bounds check in front of them:
+ * - `jmp *table(, %index, GPRSize)` with absolute target addresses in the table.
+ * - `lea table(%rip), %base; movslq (%base, %index, 4), %r; add %base, %r; jmp *%r` with table relative targets.
+ *
+ * The table needs to be in a private read only file mapping so its contents are fixed.
+ * The jump still loads its target at runtime and only branches in region when that matches a decoded target,
+ * so a table that is remapped later costs performance but not correctness.
+ */
+void Decoder::RecognizeJumpTable(uint64_t BlockEntry, size_t BlockStartOffset) {
+  if (!Multiblock || !IsInst(*DecodeInst, PrimaryInstGroupOps[PrimaryGroupOp(TYPE_GROUP_5, 0xFF, 4)])) {
+    return;
+  }
+
+  const uint8_t GPRSize = CTX->GetGPRSize();
+  const auto &Target = DecodeInst->Src[0];
+  const size_t JumpOffset = DecodedSize - 1;
+
+  uint64_t Table{};
+  uint32_t IndexReg{};
+  bool Relative{};
+
+  if (Target.IsSIB() && Target.Data.SIB.Base == X86State::REG_INVALID &&
+      Target.Data.SIB.Index != X86State::REG_INVALID && Target.Data.SIB.Scale == GPRSize &&
+      !(DecodeInst->Flags & (DecodeFlags::FLAG_FS_PREFIX | DecodeFlags::FLAG_GS_PREFIX))) {
+    Table = static_cast<int64_t>(Target.Data.SIB.Offset);
+    IndexReg = Target.Data.SIB.Index;
+  }
+  else if (Target.IsGPR() && GPRSize == 8 && JumpOffset >= BlockStartOffset + 3) {
+    const uint32_t ResultReg = Target.Data.GPR.GPR;
+    const auto &Add = DecodedBuffer[JumpOffset - 1];
+    const auto &Load = DecodedBuffer[JumpOffset - 2];
+
+    // add %base, %r in either encoding
+    if (!(IsInst(Add, BaseOps[0x01]) || IsInst(Add, BaseOps[0x03])) ||
+        !(Add.Flags & DecodeFlags::FLAG_REX_WIDENING) ||
+        !IsGPR(Add.Dest, ResultReg) || !Add.Src[0].IsGPR()) {
+      return;
+    }
+    const uint32_t BaseReg = Add.Src[0].Data.GPR.GPR;
+
+    if (!IsInst(Load, BaseOps[0x63]) || !IsGPR(Load.Dest, ResultReg) || !Load.Src[0].IsSIB() ||
+        Load.Src[0].Data.SIB.Base != BaseReg || Load.Src[0].Data.SIB.Scale != 4 ||
+        Load.Src[0].Data.SIB.Offset != 0 || Load.Src[0].Data.SIB.Index == X86State::REG_INVALID) {
+      return;
+    }
+    IndexReg = Load.Src[0].Data.SIB.Index;
+
+    // The last write to the base needs to be the lea of the table
+    bool FoundLea{};
+    for (size_t i = JumpOffset - 3; i + 1 > BlockStartOffset; --i) {
+      const auto &Inst = DecodedBuffer[i];
+      if (!Inst.Dest.IsGPR() || Inst.Dest.Data.GPR.GPR != BaseReg) {
+        continue;
+      }
+
+      if (IsInst(Inst, BaseOps[0x8D]) && Inst.Src[0].IsRIPRelative()) {
+        Table = Inst.PC + Inst.InstSize + Inst.Src[0].Data.RIPLiteral.Value.s;
+        FoundLea = true;
+      }
+      break;
+    }
+
+    if (!FoundLea) {
+      return;
+    }
+    Relative = true;
+  }
+  else {
+    return;
+  }
+
+  if (GPRSize == 4) {
+    Table &= 0xFFFFFFFFU;
+  }
+
+  const uint64_t Entries = FindJumpTableBound(BlockEntry, BlockStartOffset, IndexReg);
+  const uint64_t EntrySize = Relative ? 4 : GPRSize;
+  if (Entries == 0 || !CTX->SyscallHandler ||
+      !CTX->SyscallHandler->IsReadOnlyFileMapping(Table, Entries * EntrySize)) {
+    return;
+  }
+
+  fextl::vector<uint64_t> Targets;
+  for (uint64_t i = 0; i < Entries; ++i) {
+    const auto EntryAddress = reinterpret_cast<const uint8_t*>(Table + i * EntrySize);
+    uint64_t TargetRIP{};
+    if (Relative) {
+      int32_t Offset;
+      memcpy(&Offset, EntryAddress, sizeof(Offset));
+      TargetRIP = Table + Offset;
+    }
+    else {
+      memcpy(&TargetRIP, EntryAddress, EntrySize);
+    }
+
+    if (GPRSize == 4) {
+      TargetRIP &= 0xFFFFFFFFU;
+    }
+
+    // Out of range entries are left to the indirect exit
+    if (TargetRIP >= SymbolMinAddress && TargetRIP < SymbolMaxAddress) {
+      Targets.emplace_back(TargetRIP);
+    }
+  }
+
+  std::sort(Targets.begin(), Targets.end());
+  Targets.erase(std::unique(Targets.begin(), Targets.end()), Targets.end());
+  if (Targets.empty() || Targets.size() > MaxJumpTableTargets) {
+    return;
+  }
+
+  for (auto TargetRIP : Targets) {
+    AddBlockToDecode(TargetRIP);
+  }
+  BlockInfo.JumpTables.insert_or_assign(DecodeInst->PC, std::move(Targets));
+}
+
+/**
+ * @brief Inlines the pending calls whose callee block is a short straight line leaf ending in RET
+ *
+ * Expects BlockInfo.Blocks to be sorted by entry.
+ */
+void Decoder::ResolveInlinedCalls() {
+  const uint64_t MaxCalleeInstructions = CTX->Config.MultiblockInlineCalls();
+
+  for (const auto &Call : PendingInlineCalls) {
+    auto Callee = std::lower_bound(BlockInfo.Blocks.begin(), BlockInfo.Blocks.end(), Call.TargetRIP, [](const DecodedBlocks &Block, uint64_t Entry) {
+      return Block.Entry < Entry;
+    });
+
+    if (Callee == BlockInfo.Blocks.end() || Callee->Entry != Call.TargetRIP ||
+        Callee->HasInvalidInstruction || Callee->NumInstructions > MaxCalleeInstructions ||
+        !HasBlocks.count(Call.ReturnRIP)) {
+      continue;
+    }
+
+    // Blocks end at the first instruction that sets RIP, so a RET last means no other control flow.
+    // A block cut short by a branch in to the middle of the callee doesn't end in RET.
+    const auto &Ret = Callee->DecodedInstructions[Callee->NumInstructions - 1];
+    if (Ret.TableInfo != &BaseOps[0xC3]) {
+      continue;
+    }
+
+    BlockInfo.InlinedCalls.insert(Call.CallRIP);
+    auto &Returns = BlockInfo.InlinedReturns[Ret.PC];
+    if (std::find(Returns.begin(), Returns.end(), Call.ReturnRIP) == Returns.end()) {
+      Returns.insert(std::upper_bound(Returns.begin(), Returns.end(), Call.ReturnRIP), Call.ReturnRIP);
+    }
+  }
+}
+
 bool Decoder::BranchTargetCanContinue(bool FinalInstruction) const {
   if (FinalInstruction) {
     return false;
@@ -1098,6 +1395,10 @@ void Decoder::DecodeInstructionsAtEntry(uint8_t const* _InstStream, uint64_t PC,
   FEXCORE_PROFILE_SCOPED("DecodeInstructions");
   BlockInfo.TotalInstructionCount = 0;
   BlockInfo.Blocks.clear();
+  BlockInfo.JumpTables.clear();
+  BlockInfo.InlinedCalls.clear();
+  BlockInfo.InlinedReturns.clear();
+  PendingInlineCalls.clear();
   BlocksToDecode.clear();
   HasBlocks.clear();
   // Reset internal state management
@@ -1124,7 +1425,7 @@ void Decoder::DecodeInstructionsAtEntry(uint8_t const* _InstStream, uint64_t PC,
   DecodedMaxAddress = EntryPoint;
 
   // Entry is a jump target
-  BlocksToDecode.emplace(PC);
+  BlocksToDecode.push_back(PC);
 
   uint64_t CurrentCodePage = PC & FHU::FEX_PAGE_MASK;
 
@@ -1132,9 +1433,18 @@ void Decoder::DecodeInstructionsAtEntry(uint8_t const* _InstStream, uint64_t PC,
 
   AddContainedCodePage(PC, CurrentCodePage, FHU::FEX_PAGE_SIZE);
 
+  const uint64_t MaxInstPerBlock = SingleInstruction ? 1 : CTX->Config.MaxInstPerBlock();
+
   while (!BlocksToDecode.empty()) {
-    auto BlockDecodeIt = BlocksToDecode.begin();
-    uint64_t RIPToDecode = *BlockDecodeIt;
+    std::pop_heap(BlocksToDecode.begin(), BlocksToDecode.end(), std::greater<>{});
+    uint64_t RIPToDecode = BlocksToDecode.back();
+    BlocksToDecode.pop_back();
+
+    if (!HasBlocks.insert(RIPToDecode).second) {
+      // Queued again before the first copy was decoded
+      continue;
+    }
+
     BlockInfo.Blocks.emplace_back();
     DecodedBlocks &CurrentBlockDecoding = BlockInfo.Blocks.back();
 
@@ -1165,7 +1475,7 @@ void Decoder::DecodeInstructionsAtEntry(uint8_t const* _InstStream, uint64_t PC,
         CodePages.insert(CurrentCodePage);
       }
 
-      bool ErrorDuringDecoding = !DecodeInstruction(RIPToDecode + PCOffset);
+      bool ErrorDuringDecoding = !DecodeInstructionCached(RIPToDecode + PCOffset);
 
       if (ErrorDuringDecoding) [[unlikely]] {
         LogMan::Msg::DFmt("Couldn't Decode something at 0x{:x}, Started at 0x{:x}", RIPToDecode + PCOffset, PC);
@@ -1194,15 +1504,16 @@ void Decoder::DecodeInstructionsAtEntry(uint8_t const* _InstStream, uint64_t PC,
         CanContinue = true;
       }
 
-      bool FinalInstruction = DecodedSize >= CTX->Config.MaxInstPerBlock ||
+      bool FinalInstruction = DecodedSize >= MaxInstPerBlock ||
           DecodedSize >= DefaultDecodedBufferSize ||
-          TotalInstructions >= CTX->Config.MaxInstPerBlock;
+          TotalInstructions >= MaxInstPerBlock;
 
       if (DecodeInst->TableInfo->Flags & FEXCore::X86Tables::InstFlags::FLAGS_SETS_RIP) {
         // If we have multiblock enabled
         // If the branch target is within our multiblock range then we can keep going on
         // We don't want to short circuit this since we want to calculate our ranges still
         BranchTargetInMultiblockRange();
+        RecognizeJumpTable(RIPToDecode, BlockStartOffset);
 
         // Bypass branches if we can continue through them in some cases.
         CanContinue |= BranchTargetCanContinue(FinalInstruction);
@@ -1212,12 +1523,17 @@ void Decoder::DecodeInstructionsAtEntry(uint8_t const* _InstStream, uint64_t PC,
         break;
       }
 
+      if (CTX->IsGdbBreakpoint(DecodeInst->PC + DecodeInst->InstSize)) {
+        // End the block so the breakpoint starts a block with a stopping entry check
+        break;
+      }
+
       PCOffset += DecodeInst->InstSize;
       InstStream += DecodeInst->InstSize;
-    }
 
-    BlocksToDecode.erase(BlockDecodeIt);
-    HasBlocks.emplace(RIPToDecode);
+      // Guest code is usually cold in the host cache, start pulling in the line after the next instruction
+      __builtin_prefetch(InstStream + MAX_INST_SIZE);
+    }
 
     // Copy over only the number of instructions we decoded
     CurrentBlockDecoding.NumInstructions = BlockNumberOfInstructions;
@@ -1233,6 +1549,8 @@ void Decoder::DecodeInstructionsAtEntry(uint8_t const* _InstStream, uint64_t PC,
   std::sort(BlockInfo.Blocks.begin(), BlockInfo.Blocks.end(), [](const FEXCore::Frontend::Decoder::DecodedBlocks& a, const FEXCore::Frontend::Decoder::DecodedBlocks& b) {
     return a.Entry < b.Entry;
   });
+
+  ResolveInlinedCalls();
 }
 
 }
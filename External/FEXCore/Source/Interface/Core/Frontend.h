@@ -4,6 +4,8 @@
 
 #include <FEXCore/HLE/SyscallHandler.h>
 #include <FEXCore/Utils/Telemetry.h>
+#include <FEXCore/fextl/robin_map.h>
+#include <FEXCore/fextl/robin_set.h>
 #include <FEXCore/fextl/set.h>
 #include <FEXCore/fextl/vector.h>
 
@@ -26,9 +28,18 @@ public:
     bool HasInvalidInstruction{};
   };
 
+  // Indirect jumps recognized as switch jump tables, keyed by the jump's RIP.
+  // Targets are sorted and distinct, each one was also queued as a block to decode.
+  using JumpTableMap = fextl::robin_map<uint64_t, fextl::vector<uint64_t>>;
+
   struct DecodedBlockInformation final {
     uint64_t TotalInstructionCount;
     fextl::vector<DecodedBlocks> Blocks;
+    JumpTableMap JumpTables;
+    // Direct calls whose callee was decoded in to the region, keyed by the call's RIP
+    fextl::robin_set<uint64_t> InlinedCalls;
+    // The RETs ending those callees, with the return addresses of every call inlining them
+    JumpTableMap InlinedReturns;
   };
 
   Decoder(FEXCore::Context::ContextImpl *ctx);
@@ -44,6 +55,10 @@ public:
 
   void SetSectionMaxAddress(uint64_t v) { SectionMaxAddress = v; }
   void SetExternalBranches(fextl::set<uint64_t> *v) { ExternalBranches = v; }
+  void SetMultiblock(bool v) { Multiblock = v; }
+  bool GetMultiblock() const { return Multiblock; }
+  // Decode only the entry instruction, used for gdb stepping
+  void SetSingleInstruction(bool v) { SingleInstruction = v; }
 
   void DelayedDisownBuffer() {
     PoolObject.DelayedDisownBuffer();
@@ -60,10 +75,17 @@ private:
 
   FEXCore::Context::ContextImpl *CTX;
   const FEXCore::HLE::SyscallOSABI OSABI{};
+  bool Multiblock{};
+  bool SingleInstruction{};
 
   bool DecodeInstruction(uint64_t PC);
+  bool DecodeInstructionCached(uint64_t PC);
 
   void BranchTargetInMultiblockRange();
+  void RecognizeJumpTable(uint64_t BlockEntry, size_t BlockStartOffset);
+  uint64_t FindJumpTableBound(uint64_t BlockEntry, size_t BlockStartOffset, uint32_t IndexReg) const;
+  void ResolveInlinedCalls();
+  void AddBlockToDecode(uint64_t RIP);
   bool BranchTargetCanContinue(bool FinalInstruction) const;
 
   uint8_t ReadByte();
@@ -86,6 +108,16 @@ private:
   std::array<uint8_t, MAX_INST_SIZE> Instruction;
   FEXCore::X86Tables::DecodedInst *DecodeInst;
 
+  // Previously decoded instructions keyed by guest RIP.
+  // An entry is only used if the guest bytes still match, so it never needs invalidating.
+  struct CachedDecodedInst {
+    FEXCore::X86Tables::DecodedInst Inst;
+    std::array<uint8_t, MAX_INST_SIZE> Bytes;
+  };
+  static constexpr size_t MaxDecodeCacheEntries = 0x10000;
+  const bool DecodeCacheEnabled{};
+  fextl::robin_map<uint64_t, CachedDecodedInst> DecodeCache;
+
   // This is for multiblock data tracking
   bool SymbolAvailable {false};
   uint64_t EntryPoint {};
@@ -96,10 +128,27 @@ private:
   uint64_t SectionMaxAddress {~0ULL};
 
   DecodedBlockInformation BlockInfo;
-  fextl::set<uint64_t> BlocksToDecode;
-  fextl::set<uint64_t> HasBlocks;
+  // Min-heap of pending block entries, blocks are still decoded lowest address first.
+  // An entry may be queued more than once, HasBlocks filters the repeats.
+  fextl::vector<uint64_t> BlocksToDecode;
+  fextl::robin_set<uint64_t> HasBlocks;
   fextl::set<uint64_t> *ExternalBranches {nullptr};
 
+  // Bounds checks against more entries than this aren't treated as jump tables
+  static constexpr uint64_t MaxJumpTableEntries = 512;
+  // Each distinct target costs a decoded block and a compare at runtime
+  static constexpr size_t MaxJumpTableTargets = 64;
+
+  // Calls queued for inlining, only inlined once the callee's block is known to be a short leaf
+  struct PendingInlineCall {
+    uint64_t CallRIP;
+    uint64_t TargetRIP;
+    uint64_t ReturnRIP;
+  };
+  fextl::vector<PendingInlineCall> PendingInlineCalls;
+  // Keeps the decoded range of a region with inlined callees compact
+  static constexpr uint64_t MaxInlineCallDistance = 64 * 1024;
+
   // ModRM rm decoding
   using DecodeModRMPtr = void (FEXCore::Frontend::Decoder::*)(X86Tables::DecodedOperand *Operand, X86Tables::ModRMDecoded ModRM);
   void DecodeModRM_16(X86Tables::DecodedOperand *Operand, X86Tables::ModRMDecoded ModRM);
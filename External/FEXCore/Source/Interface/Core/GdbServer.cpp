@@ -34,7 +34,9 @@ $end_info$
 #include <FEXCore/fextl/string.h>
 #include <FEXCore/fextl/vector.h>
 
+#include <algorithm>
 #include <atomic>
+#include <cctype>
 #include <cstring>
 #ifndef _WIN32
 #include <elf.h>
@@ -90,7 +92,12 @@ GdbServer::GdbServer(FEXCore::Context::ContextImpl *ctx) : CTX(ctx) {
         return false;
       }
 
-      this->CTX->Config.RunningMode = FEXCore::Context::CoreRunningMode::MODE_SINGLESTEP;
+      // Stop at the next block entry once gdb lets this thread continue, unless gdb resumes it
+      Thread->CurrentFrame->GdbStop = FEXCore::Core::CpuStateFrame::GDB_STOP;
+      {
+        std::lock_guard lk(StopMutex);
+        StopReported = true;
+      }
 
       // Let GDB know that we have a signal
       this->Break(Signal);
@@ -228,6 +235,68 @@ void GdbServer::SendPacket(std::ostream &stream, const fextl::string& packet) {
   stream << str << std::flush;
 }
 
+void GdbServer::SendNotification(std::ostream &stream, const fextl::string& packet) {
+  const auto escaped = escapePacket(packet);
+  const auto str = fextl::fmt::format("%{}#{:02x}", escaped, calculateChecksum(escaped));
+
+  stream << str << std::flush;
+}
+
+void GdbServer::ThreadStopped(FEXCore::Core::InternalThreadState *Thread) {
+  const uint32_t TID = Thread->ThreadManager.GetTID();
+  std::lock_guard lk(StopMutex);
+
+  fextl::string Reply;
+  if (RequestedStops.erase(TID)) {
+    Reply = fextl::fmt::format("T00thread:{:x};", TID);
+  }
+  else {
+    Reply = fextl::fmt::format("T05thread:{:x};", TID);
+    if (Thread->CurrentFrame->GdbStop.load() == FEXCore::Core::CpuStateFrame::GDB_RUN) {
+      // Only a breakpoint stops a running thread, RIP is already at the breakpoint
+      Reply += "swbreak:;";
+    }
+  }
+  if (LibraryMapChanged) {
+    // If libraries have changed then let gdb know
+    Reply += "library:1;";
+  }
+
+  if (NonStopMode) {
+    PendingStops.emplace_back(std::move(Reply));
+    if (PendingStops.size() == 1) {
+      // Later stops are handed out through vStopped
+      std::lock_guard sendlk(sendMutex);
+      if (CommsStream) {
+        SendNotification(*CommsStream, "Stop:" + PendingStops.front());
+      }
+    }
+    return;
+  }
+
+  if (StopReported) {
+    // One of the threads this stop brings down
+    return;
+  }
+  StopReported = true;
+
+  // Bring the rest of the process down at their next block entry
+  {
+    std::lock_guard threadlk(CTX->ThreadCreationMutex);
+    for (auto &OtherThread : *CTX->GetThreads()) {
+      if (OtherThread != Thread) {
+        OtherThread->CurrentFrame->GdbStop = FEXCore::Core::CpuStateFrame::GDB_STOP;
+      }
+    }
+  }
+  CurrentDebuggingThread = TID;
+
+  std::lock_guard sendlk(sendMutex);
+  if (CommsStream) {
+    SendPacket(*CommsStream, Reply);
+  }
+}
+
 void GdbServer::SendACK(std::ostream &stream, bool NACK) {
   if (NoAckMode) {
     return;
@@ -284,10 +353,7 @@ fextl::string GdbServer::readRegs() {
   memcpy(&GDB.gregs[0], &state.gregs[0], sizeof(GDB.gregs));
   memcpy(&GDB.rip, &state.rip, sizeof(GDB.rip));
 
-  for (size_t i = 0; i < Core::CPUState::NUM_EFLAG_BITS; ++i) {
-    uint64_t Flag = state.flags[i];
-    GDB.eflags |= (Flag << i);
-  }
+  GDB.eflags = CTX->ReconstructCompactedEFLAGS(&state);
 
   for (size_t i = 0; i < Core::CPUState::NUM_MMS; ++i) {
     memcpy(&GDB.mm[i], &state.mm[i], sizeof(GDB.mm));
@@ -341,11 +407,7 @@ GdbServer::HandledPacketType GdbServer::readReg(const fextl::string& packet) {
     return {encodeHex((unsigned char *)(&state.rip), sizeof(uint64_t)), HandledPacketType::TYPE_ACK};
   }
   else if (addr == offsetof(GDBContextDefinition, eflags)) {
-    uint32_t eflags{};
-    for (size_t i = 0; i < Core::CPUState::NUM_EFLAG_BITS; ++i) {
-      uint64_t Flag = state.flags[i];
-      eflags |= (Flag << i);
-    }
+    uint32_t eflags = CTX->ReconstructCompactedEFLAGS(&state);
     return {encodeHex((unsigned char *)(&eflags), sizeof(uint32_t)), HandledPacketType::TYPE_ACK};
   }
   else if (addr >= offsetof(GDBContextDefinition, cs) &&
@@ -824,7 +886,6 @@ GdbServer::HandledPacketType GdbServer::handleQuery(const fextl::string &packet)
   if (match("QNonStop:")) {
     auto ss = fextl::istringstream(packet);
     ss.seekg(fextl::string("QNonStop:").size());
-    ss.get(); // discard colon
     ss >> NonStopMode;
     return {"OK", HandledPacketType::TYPE_ACK};
   }
@@ -975,33 +1036,120 @@ GdbServer::HandledPacketType GdbServer::handleQuery(const fextl::string &packet)
 }
 
 
-GdbServer::HandledPacketType GdbServer::ThreadAction(char action, uint32_t tid) {
-  switch (action) {
-    case 'c': {
-      CTX->Run();
-      ThreadBreakEvent.NotifyAll();
-      CTX->WaitForThreadsToRun();
-      return {"", HandledPacketType::TYPE_ONLYACK};
+GdbServer::HandledPacketType GdbServer::ThreadActions(const ThreadActionList &Actions) {
+  using FEXCore::Core::CpuStateFrame;
+
+  const auto IsAllThreads = [](uint32_t tid) { return tid == 0 || tid == ~0U; };
+
+  if (Actions.size() == 1 && Actions[0].first == 'c' && IsAllThreads(Actions[0].second)) {
+    // Plain continue, also wakes threads that never started and threads that stopped on a signal
+    {
+      std::lock_guard lk(StopMutex);
+      StopReported = false;
+    }
+    CTX->Run();
+    ThreadBreakEvent.NotifyAll();
+    return {NonStopMode ? "OK" : "", NonStopMode ? HandledPacketType::TYPE_ACK : HandledPacketType::TYPE_ONLYACK};
+  }
+
+  for (auto &[Action, tid] : Actions) {
+    if (Action != 'c' && Action != 's' && Action != 't') {
+      return {"E00", HandledPacketType::TYPE_ACK};
     }
-    case 's': {
-      CTX->Step();
-      SendPacketPair({"OK", HandledPacketType::TYPE_ACK});
-      fextl::string str = fextl::fmt::format("T05thread:{:02x};", getpid());
-      if (LibraryMapChanged) {
-        // If libraries have changed then let gdb know
-        str += "library:1;";
+  }
+
+  {
+    std::lock_guard lk(StopMutex);
+    StopReported = false;
+  }
+
+  bool Continued{};
+  for (auto &Thread : *CTX->GetThreads()) {
+    const uint32_t TID = Thread->ThreadManager.GetTID();
+    // The leftmost action naming the thread applies
+    auto it = std::find_if(Actions.begin(), Actions.end(), [&](auto &Action) {
+      return Action.second == TID || IsAllThreads(Action.second);
+    });
+
+    if (it == Actions.end()) {
+      continue;
+    }
+
+    switch (it->first) {
+      case 'c':
+        Continued = true;
+        CTX->ResumeGdbThread(Thread, false);
+        break;
+      case 's':
+        CTX->ResumeGdbThread(Thread, true);
+        break;
+      case 't': {
+        std::lock_guard lk(StopMutex);
+        if (Thread->RunningEvents.ThreadSleeping.load()) {
+          // Already stopped, it still needs a stop reply
+          PendingStops.emplace_back(fextl::fmt::format("T00thread:{:x};", TID));
+          if (PendingStops.size() == 1) {
+            std::lock_guard sendlk(sendMutex);
+            if (CommsStream) {
+              SendNotification(*CommsStream, "Stop:" + PendingStops.front());
+            }
+          }
+        }
+        else {
+          RequestedStops.insert(TID);
+          Thread->CurrentFrame->GdbStop = CpuStateFrame::GDB_STOP;
+        }
+        break;
       }
+    }
+  }
 
-      SendPacketPair({std::move(str), HandledPacketType::TYPE_ACK});
-      return {"OK", HandledPacketType::TYPE_ACK};
+  if (Continued) {
+    // Wakes a thread waiting in the signal handler after it reported a signal
+    ThreadBreakEvent.NotifyAll();
+  }
+
+  if (NonStopMode) {
+    return {"OK", HandledPacketType::TYPE_ACK};
+  }
+
+  // The stop reply is sent once a thread stops
+  return {"", HandledPacketType::TYPE_ONLYACK};
+}
+
+GdbServer::HandledPacketType GdbServer::handleStopQuery() {
+  if (!NonStopMode) {
+    // Binja doesn't support S response here
+    fextl::string str = fextl::fmt::format("T00thread:{:x};", getpid());
+    return {std::move(str), HandledPacketType::TYPE_ACK};
+  }
+
+  // Non-stop mode reports every stopped thread, the rest go out through vStopped
+  std::lock_guard lk(StopMutex);
+  PendingStops.clear();
+  for (auto &Thread : *CTX->GetThreads()) {
+    if (Thread->RunningEvents.ThreadSleeping.load() || Thread->RunningEvents.WaitingToStart.load()) {
+      PendingStops.emplace_back(fextl::fmt::format("T00thread:{:x};", Thread->ThreadManager.GetTID()));
     }
-    case 't':
-      // This thread isn't part of the thread pool
-      CTX->Stop(false /* Ignore current thread */);
-      return {"OK", HandledPacketType::TYPE_ACK};
-    default:
-      return {"E00", HandledPacketType::TYPE_ACK};
   }
+
+  if (PendingStops.empty()) {
+    return {"OK", HandledPacketType::TYPE_ACK};
+  }
+  return {PendingStops.front(), HandledPacketType::TYPE_ACK};
+}
+
+GdbServer::HandledPacketType GdbServer::handleStopped() {
+  // Acknowledges the last stop reply, answer with the next one
+  std::lock_guard lk(StopMutex);
+  if (!PendingStops.empty()) {
+    PendingStops.pop_front();
+  }
+
+  if (PendingStops.empty()) {
+    return {"OK", HandledPacketType::TYPE_ACK};
+  }
+  return {PendingStops.front(), HandledPacketType::TYPE_ACK};
 }
 
 GdbServer::HandledPacketType GdbServer::handleV(const fextl::string& packet) {
@@ -1072,25 +1220,45 @@ GdbServer::HandledPacketType GdbServer::handleV(const fextl::string& packet) {
     return {F_data(ret, data), HandledPacketType::TYPE_ACK};
   }
   if ((ss = match("vCont?"))) {
-    return {"vCont;c;t;s;r", HandledPacketType::TYPE_ACK}; // We support continue, step and terminate
+    return {"vCont;c;C;t;s;S", HandledPacketType::TYPE_ACK}; // We support continue, step and stop
     // FIXME: We also claim to support continue with signal... because it's compulsory
   }
   if ((ss = match("vCont;"))) {
-    char action{};
-    int thread{};
+    // eg: vCont;s:1f2a;c
+    ThreadActionList Actions;
 
-    action = ss->get();
+    while (true) {
+      char action = ss->get();
 
-    if (ss->peek() == ':') {
-      ss->get();
-      *ss >> std::hex >> thread;
-    }
+      if (action == 'C' || action == 'S') {
+        // The signal isn't delivered, resuming is the same as without one
+        int Signal;
+        *ss >> std::hex >> Signal;
+        action = std::tolower(action);
+      }
 
-    if (ss->fail()) {
-      return {"E00", HandledPacketType::TYPE_ACK};
+      int32_t thread{};
+      if (ss->peek() == ':') {
+        ss->get();
+        *ss >> std::hex >> thread;
+      }
+
+      if (ss->fail()) {
+        return {"E00", HandledPacketType::TYPE_ACK};
+      }
+
+      Actions.emplace_back(action, static_cast<uint32_t>(thread));
+
+      if (ss->peek() != ';') {
+        break;
+      }
+      ss->get();
     }
 
-    return ThreadAction(action, thread);
+    return ThreadActions(Actions);
+  }
+  if (match("vStopped")) {
+    return handleStopped();
   }
   return {"", HandledPacketType::TYPE_ACK};
 }
@@ -1105,7 +1273,9 @@ GdbServer::HandledPacketType GdbServer::handleThreadOp(const fextl::string &pack
     ss.seekg(fextl::string("Hc").size());
     ss >> std::hex >> CurrentDebuggingThread;
 
-    CTX->Pause();
+    if (!NonStopMode) {
+      CTX->Pause();
+    }
     return {"OK", HandledPacketType::TYPE_ACK};
   }
 
@@ -1116,7 +1286,10 @@ GdbServer::HandledPacketType GdbServer::handleThreadOp(const fextl::string &pack
     ss >> std::hex >> CurrentDebuggingThread;
 
     // This must return quick otherwise IDA complains
-    CTX->Pause();
+    // Non-stop mode only touches threads that are already stopped
+    if (!NonStopMode) {
+      CTX->Pause();
+    }
     return {"OK", HandledPacketType::TYPE_ACK};
   }
 
@@ -1126,29 +1299,34 @@ GdbServer::HandledPacketType GdbServer::handleThreadOp(const fextl::string &pack
 GdbServer::HandledPacketType GdbServer::handleBreakpoint(const fextl::string &packet) {
   auto ss = fextl::istringstream(packet);
 
-  // Don't do anything with set breakpoints yet
-  [[maybe_unused]] bool Set{};
+  bool Set{};
   uint64_t Addr;
   uint64_t Type;
   Set = ss.get() == 'Z';
 
-  ss >> std::hex >> Addr;
-  ss.get(); // discard comma
   ss >> std::hex >> Type;
+  ss.get(); // discard comma
+  ss >> std::hex >> Addr;
+
+  if (ss.fail()) {
+    return {"E00", HandledPacketType::TYPE_ACK};
+  }
+
+  // Software and hardware breakpoints are the same thing here, watchpoints aren't supported
+  if (Type != 0 && Type != 1) {
+    return {"", HandledPacketType::TYPE_UNKNOWN};
+  }
 
-  CTX->Pause();
+  CTX->SetGdbBreakpoint(Addr, Set);
   return {"OK", HandledPacketType::TYPE_ACK};
 }
 
 GdbServer::HandledPacketType GdbServer::ProcessPacket(const fextl::string &packet) {
   switch (packet[0]) {
-    case '?': {
+    case '?':
       // Indicates the reason that the thread has stopped
       // Behaviour changes if the target is in non-stop mode
-      // Binja doesn't support S response here
-      fextl::string str = fextl::fmt::format("T00thread:{:x};", getpid());
-      return {std::move(str), HandledPacketType::TYPE_ACK};
-    }
+      return handleStopQuery();
     case 'c':
       // Continue
       return ThreadAction('c', 0);
@@ -1160,8 +1338,10 @@ GdbServer::HandledPacketType GdbServer::ProcessPacket(const fextl::string &packe
       return {"OK", HandledPacketType::TYPE_ACK};
     case 'g':
       // We might be running while we try reading
-      // Pause up front
-      CTX->Pause();
+      // Pause up front, non-stop mode only reads threads that are already stopped
+      if (!NonStopMode) {
+        CTX->Pause();
+      }
       return {readRegs(), HandledPacketType::TYPE_ACK};
     case 'p':
       return readReg(packet);
@@ -1179,7 +1359,7 @@ GdbServer::HandledPacketType GdbServer::ProcessPacket(const fextl::string &packe
     case 'T': // Is a thread alive?
       return {"OK", HandledPacketType::TYPE_ACK};
     case 's': // Step
-      return ThreadAction('s', 0);
+      return ThreadAction('s', CurrentDebuggingThread ?: CTX->ParentThread->ThreadManager.GetTID());
     case 'z': // Remove breakpoint or watchpoint
     case 'Z': // Inserts breakpoint or watchpoint
       return handleBreakpoint(packet);
@@ -8,16 +8,23 @@ $end_info$
 #include <FEXCore/Config/Config.h>
 #include <FEXCore/Utils/Event.h>
 #include <FEXCore/Utils/Threads.h>
+#include <FEXCore/fextl/deque.h>
 #include <FEXCore/fextl/memory.h>
+#include <FEXCore/fextl/set.h>
 #include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/vector.h>
 
 #include <atomic>
 #include <istream>
 #include <memory>
 #include <mutex>
 #include <stdint.h>
+#include <utility>
 
 namespace FEXCore {
+namespace Core {
+  struct InternalThreadState;
+}
 
 namespace Context {
   class ContextImpl;
@@ -34,6 +41,14 @@ public:
       LibraryMapChanged = true;
     }
 
+    /**
+     * @brief Called by a thread that stopped itself at a block entry
+     *
+     * Non-stop mode queues a stop notification for it.
+     * All-stop mode reports the first thread to stop and stops the others at their next block entry.
+     */
+    void ThreadStopped(FEXCore::Core::InternalThreadState *Thread);
+
 private:
     void Break(int signal);
 
@@ -42,6 +57,7 @@ private:
     void StartThread();
     fextl::string ReadPacket(std::iostream &stream);
     void SendPacket(std::ostream &stream, const fextl::string& packet);
+    void SendNotification(std::ostream &stream, const fextl::string& packet);
 
     void SendACK(std::ostream &stream, bool NACK);
 
@@ -71,7 +87,14 @@ private:
     HandledPacketType handleBreakpoint(const fextl::string &packet);
     HandledPacketType handleProgramOffsets();
 
-    HandledPacketType ThreadAction(char action, uint32_t tid);
+    // A thread ID of 0 or -1 applies the action to every thread not named by an earlier action
+    using ThreadActionList = fextl::vector<std::pair<char, uint32_t>>;
+    HandledPacketType ThreadActions(const ThreadActionList &Actions);
+    HandledPacketType ThreadAction(char action, uint32_t tid) {
+      return ThreadActions({{action, tid}});
+    }
+    HandledPacketType handleStopQuery();
+    HandledPacketType handleStopped();
 
     fextl::string readRegs();
     HandledPacketType readReg(const fextl::string& packet);
@@ -92,6 +115,14 @@ private:
     // Used to keep track of which signals to pass to the guest
     std::array<bool, SignalDelegator::MAX_SIGNALS + 1> PassSignals{};
     uint32_t CurrentDebuggingThread{};
+
+    std::mutex StopMutex;
+    // Non-stop mode stop replies, the front one has been sent and waits for vStopped
+    fextl::deque<fextl::string> PendingStops;
+    // Threads stopped through vCont;t, reported with signal 0
+    fextl::set<uint32_t> RequestedStops;
+    // All-stop mode only reports the first thread that stops after resuming
+    bool StopReported{true};
     int ListenSocket{};
     FEX_CONFIG_OPT(Filename, APP_FILENAME);
 };
@@ -12,6 +12,14 @@
 #include "Interface/Core/Dispatcher/X86Dispatcher.h"
 #endif
 
+#ifdef _M_ARM_64
+#include <sys/auxv.h>
+#endif
+
+#if defined(_M_ARM_64) && !defined(_WIN32)
+#include <sys/prctl.h>
+#endif
+
 namespace FEXCore {
 
 // Data Zero Prohibited flag
@@ -20,6 +28,16 @@ namespace FEXCore {
 [[maybe_unused]] constexpr uint32_t DCZID_DZP_MASK = 0b1'0000;
 // Log2 of the blocksize in 32-bit words
 [[maybe_unused]] constexpr uint32_t DCZID_BS_MASK = 0b0'1111;
+// AT_HWCAP bit for the kernel's WFE event stream
+[[maybe_unused]] constexpr uint64_t HWCAP_EVTSTRM_BIT = 1ULL << 2;
+// AT_HWCAP2 bit for FEAT_MOPS
+[[maybe_unused]] constexpr uint64_t HWCAP2_MOPS_BIT = 1ULL << 43;
+
+// Memory model prctl, not in every kernel's headers yet
+[[maybe_unused]] constexpr int PR_GET_MEM_MODEL_ = 0x6d4d444c;
+[[maybe_unused]] constexpr int PR_SET_MEM_MODEL_ = 0x4d4d444c;
+[[maybe_unused]] constexpr int PR_SET_MEM_MODEL_DEFAULT_ = 0;
+[[maybe_unused]] constexpr int PR_SET_MEM_MODEL_TSO_ = 1;
 
 #ifdef _M_ARM_64
 [[maybe_unused]] static uint32_t GetDCZID() {
@@ -48,6 +66,20 @@ static uint32_t GetDCZID() {
 }
 #endif
 
+bool HostFeatures::EnableHardwareTSO() {
+#if defined(_M_ARM_64) && !defined(_WIN32)
+  const auto Model = prctl(PR_GET_MEM_MODEL_, 0, 0, 0, 0);
+  if (Model == PR_SET_MEM_MODEL_TSO_) {
+    // Already inherited from the thread that created this one
+    return true;
+  }
+
+  return Model == PR_SET_MEM_MODEL_DEFAULT_ && prctl(PR_SET_MEM_MODEL_, PR_SET_MEM_MODEL_TSO_, 0, 0, 0) == 0;
+#else
+  return false;
+#endif
+}
+
 static void OverrideFeatures(HostFeatures *Features) {
   // Override features if the user has specifically called for it.
   FEX_CONFIG_OPT(HostFeatures, HOSTFEATURES);
@@ -80,6 +112,10 @@ static void OverrideFeatures(HostFeatures *Features) {
   const bool EnableCSSC = HostFeatures() & FEXCore::Config::HostFeatures::ENABLECSSC;
   LogMan::Throw::AFmt(!(DisableCSSC && EnableCSSC), "Disabling and Enabling CPU features are mutually exclusive");
 
+  const bool DisableMOPS = HostFeatures() & FEXCore::Config::HostFeatures::DISABLEMOPS;
+  const bool EnableMOPS = HostFeatures() & FEXCore::Config::HostFeatures::ENABLEMOPS;
+  LogMan::Throw::AFmt(!(DisableMOPS && EnableMOPS), "Disabling and Enabling CPU features are mutually exclusive");
+
   const bool DisablePMULL128 = HostFeatures() & FEXCore::Config::HostFeatures::DISABLEPMULL128;
   const bool EnablePMULL128 = HostFeatures() & FEXCore::Config::HostFeatures::ENABLEPMULL128;
   LogMan::Throw::AFmt(!(DisablePMULL128 && EnablePMULL128), "Disabling and Enabling CPU features are mutually exclusive");
@@ -103,6 +139,9 @@ static void OverrideFeatures(HostFeatures *Features) {
   }
   else if (DisableSVE) {
     Features->SupportsSVE = false;
+    Features->SupportsSVE256 = false;
+    Features->SupportsSVE2 = false;
+    Features->SupportsSVEBitPerm = false;
   }
   if (EnableAFP) {
     Features->SupportsFlushInputsToZero = true;
@@ -128,6 +167,12 @@ static void OverrideFeatures(HostFeatures *Features) {
   else if (DisableCSSC) {
     Features->SupportsCSSC = false;
   }
+  if (EnableMOPS) {
+    Features->SupportsMOPS = true;
+  }
+  else if (DisableMOPS) {
+    Features->SupportsMOPS = false;
+  }
   if (EnablePMULL128) {
     Features->SupportsPMULL_128Bit = true;
   }
@@ -177,11 +222,18 @@ HostFeatures::HostFeatures() {
 #ifdef VIXL_SIMULATOR
   // Hardcode enable SVE with 256-bit wide registers.
   SupportsSVE = true;
+  SupportsSVE256 = true;
+  SupportsSVE2 = true;
+  SupportsSVEBitPerm = true;
   SupportsAVX = true;
 #else
   SupportsSVE = Features.Has(vixl::CPUFeatures::Feature::kSVE);
-  SupportsAVX = Features.Has(vixl::CPUFeatures::Feature::kSVE2) &&
-                vixl::aarch64::CPU::ReadSVEVectorLengthInBits() >= 256;
+  SupportsSVE2 = Features.Has(vixl::CPUFeatures::Feature::kSVE2);
+  SupportsSVEBitPerm = Features.Has(vixl::CPUFeatures::Feature::kSVEBitPerm);
+  SupportsSVE256 = Features.Has(vixl::CPUFeatures::Feature::kSVE2) &&
+                   vixl::aarch64::CPU::ReadSVEVectorLengthInBits() >= 256;
+  // Without 256-bit registers the IR is split in to 128-bit halves
+  SupportsAVX = true;
 #endif
   SupportsSHA = true;
   SupportsBMI1 = true;
@@ -202,6 +254,14 @@ HostFeatures::HostFeatures() {
   DCacheLineSize = 4 << ((CTR >> 16) & 0xF);
   ICacheLineSize = 4 << (CTR & 0xF);
 
+  SupportsWFEEventStream = getauxval(AT_HWCAP) & HWCAP_EVTSTRM_BIT;
+#ifndef _WIN32
+  // Kernels without the memory model prctl fail the query
+  SupportsHardwareTSO = prctl(PR_GET_MEM_MODEL_, 0, 0, 0, 0) != -1;
+#endif
+  // vixl doesn't know about FEAT_MOPS, ask the kernel
+  SupportsMOPS = getauxval(AT_HWCAP2) & HWCAP2_MOPS_BIT;
+
   // Test if this CPU supports float exception trapping by attempting to enable
   // On unsupported these bits are architecturally defined as RAZ/WI
   constexpr uint32_t ExceptionEnableTraps =
@@ -4,9 +4,11 @@ tags: backend|interpreter
 $end_info$
 */
 
+#include "Interface/Context/Context.h"
 #include "Interface/Core/Interpreter/InterpreterClass.h"
 #include "Interface/Core/Interpreter/InterpreterOps.h"
 #include "Interface/Core/Interpreter/InterpreterDefines.h"
+#include "Interface/Core/CycleCounter.h"
 
 #include <FEXCore/Utils/BitUtils.h>
 
@@ -61,7 +63,10 @@ DEF_OP(CycleCounter) {
 #else
   timespec time;
   clock_gettime(CLOCK_REALTIME, &time);
-  GD = time.tv_nsec + time.tv_sec * 1000000000;
+  const uint64_t Counter = time.tv_nsec + time.tv_sec * 1000000000;
+
+  const auto CTX = static_cast<Context::ContextImpl*>(Data->State->CTX);
+  GD = CTX->ScaleCycleCounter ? FEXCore::CycleCounter::Apply(Counter, CTX->CycleCounterScale) : Counter;
 #endif
 }
 
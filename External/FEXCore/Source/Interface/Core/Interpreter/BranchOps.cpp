@@ -14,7 +14,10 @@ $end_info$
 #include <FEXCore/HLE/SyscallHandler.h>
 
 #include <cstdint>
+#include <signal.h>
+#include <sys/syscall.h>
 #include <unistd.h>
+#include <utility>
 
 namespace FEXCore::CPU {
 #define DEF_OP(x) void InterpreterOps::Op_##x(IR::IROp_Header *IROp, IROpData *Data, IR::NodeID Node)
@@ -92,6 +95,11 @@ DEF_OP(InlineSyscall) {
     Args.Argument[j] = *GetSrc<uint64_t*>(Data->SSAData, Op->Header.Args[j]);
   }
 
+  // Have the host catch up with signals the guest masked before the syscall can block
+  if (const uint64_t Mask = std::exchange(Data->State->CurrentFrame->PendingHostSignalMask, 0)) {
+    ::syscall(SYS_rt_sigprocmask, SIG_BLOCK, &Mask, nullptr, 8);
+  }
+
   // We don't want the errno handling but I also don't want to write inline ASM atm
   uint64_t Res = syscall(
     Op->HostSyscallNumber,
@@ -46,10 +46,11 @@ InterpreterCore::InterpreterCore(Dispatcher *Dispatcher, FEXCore::Core::Internal
   ClearCache();
 }
 
-CPUBackend::CompiledCode InterpreterCore::CompileCode(uint64_t Entry, [[maybe_unused]] FEXCore::IR::IRListView const *IR, [[maybe_unused]] FEXCore::Core::DebugData *DebugData, FEXCore::IR::RegisterAllocationData *RAData, bool GDBEnabled) {
+CPUBackend::CompiledCode InterpreterCore::CompileCode(uint64_t Entry, [[maybe_unused]] FEXCore::IR::IRListView const *IR, [[maybe_unused]] FEXCore::Core::DebugData *DebugData, FEXCore::IR::RegisterAllocationData *RAData, bool GDBEnabled, [[maybe_unused]] bool HotBlock) {
 
   const auto IRSize = AlignUp(IR->GetInlineSize(), 16);
-  const auto MaxSize = IRSize + Dispatcher::MaxInterpreterTrampolineSize + GDBEnabled * Dispatcher::MaxGDBPauseCheckSize;
+  const auto ProgramSize = AlignUp(InterpreterOps::GetThreadedProgramSize(IR), 16);
+  const auto MaxSize = IRSize + ProgramSize + Dispatcher::MaxInterpreterTrampolineSize + GDBEnabled * Dispatcher::MaxGDBPauseCheckSize;
 
   if ((BufferUsed + MaxSize) > CurrentCodeBuffer->Size) {
     static_cast<Context::ContextImpl*>(ThreadState->CTX)->ClearCodeCache(ThreadState);
@@ -63,7 +64,7 @@ CPUBackend::CompiledCode InterpreterCore::CompileCode(uint64_t Entry, [[maybe_un
   auto DestBuffer = CodeData.BlockBegin;
 
   if (GDBEnabled) {
-    const auto GDBSize = Dispatch->GenerateGDBPauseCheck(DestBuffer, Entry);
+    const auto GDBSize = Dispatch->GenerateGDBPauseCheck(DestBuffer, Entry, static_cast<Context::ContextImpl*>(ThreadState->CTX)->IsGdbBreakpoint(Entry));
     DestBuffer += GDBSize;
     BufferUsed += GDBSize;
   }
@@ -77,6 +78,11 @@ CPUBackend::CompiledCode InterpreterCore::CompileCode(uint64_t Entry, [[maybe_un
   DestBuffer += IRSize;
   BufferUsed += IRSize;
 
+  // Pre-decoded handlers follow the IR, InterpretIR runs these instead of walking the IR
+  InterpreterOps::BuildThreadedProgram(IR, DestBuffer);
+  DestBuffer += ProgramSize;
+  BufferUsed += ProgramSize;
+
   CodeData.Size = BufferUsed - BufferStartOffset;
 
   return CodeData;
@@ -12,6 +12,7 @@
 #include <FEXCore/Utils/BitUtils.h>
 #include <FEXCore/Utils/CompilerDefs.h>
 #include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/Utils/MathUtils.h>
 
 #include "Interface/HLE/Thunks/Thunks.h"
 
@@ -31,7 +32,7 @@
 
 namespace FEXCore::CPU {
 
-using OpHandler = void (*)(IR::IROp_Header *IROp, InterpreterOps::IROpData *Data, IR::NodeID Node);
+using OpHandler = InterpreterOps::OpHandler;
 using OpHandlerArray = std::array<OpHandler, IR::IROps::OP_LAST + 1>;
 
 constexpr OpHandlerArray InterpreterOpHandlers = [] {
@@ -111,6 +112,8 @@ constexpr OpHandlerArray InterpreterOpHandlers = [] {
   // Branch ops
   REGISTER_OP(CALLBACKRETURN,         CallbackReturn);
   REGISTER_OP(EXITFUNCTION,           ExitFunction);
+  REGISTER_OP(PUSHRETURNSTACK,        NoOp);
+  REGISTER_OP(RETURNSTACKLOOKUP,      NoOp);
   REGISTER_OP(JUMP,                   Jump);
   REGISTER_OP(CONDJUMP,               CondJump);
   REGISTER_OP(SYSCALL,                Syscall);
@@ -151,10 +154,14 @@ constexpr OpHandlerArray InterpreterOpHandlers = [] {
   REGISTER_OP(STOREMEM,               StoreMem);
   REGISTER_OP(LOADMEMTSO,             LoadMem);
   REGISTER_OP(STOREMEMTSO,            StoreMem);
+  REGISTER_OP(STOREMEMPAIR,           StoreMemPair);
   REGISTER_OP(VLOADVECTORMASKED,      VLoadVectorMasked);
   REGISTER_OP(VSTOREVECTORMASKED,     VStoreVectorMasked);
+  REGISTER_OP(VGATHER,                VGather);
   REGISTER_OP(MEMSET,                 MemSet);
   REGISTER_OP(MEMCPY,                 MemCpy);
+  REGISTER_OP(MEMSCAN,                MemScan);
+  REGISTER_OP(MEMCMP,                 MemCmp);
   REGISTER_OP(CACHELINECLEAR,         CacheLineClear);
   REGISTER_OP(CACHELINECLEAN,         CacheLineClean);
   REGISTER_OP(CACHELINEZERO,          CacheLineZero);
@@ -177,6 +184,7 @@ constexpr OpHandlerArray InterpreterOpHandlers = [] {
   REGISTER_OP(PROCESSORID,            ProcessorID);
   REGISTER_OP(RDRAND,                 RDRAND);
   REGISTER_OP(YIELD,                  Yield);
+  REGISTER_OP(SPINWAIT,               Yield);
 
   // Move ops
   REGISTER_OP(EXTRACTELEMENTPAIR,     ExtractElementPair);
@@ -331,6 +339,58 @@ void InterpreterOps::Op_Unhandled(FEXCore::IR::IROp_Header *IROp, IROpData *Data
 void InterpreterOps::Op_NoOp(FEXCore::IR::IROp_Header *IROp, IROpData *Data, IR::NodeID Node) {
 }
 
+size_t InterpreterOps::GetThreadedProgramSize(FEXCore::IR::IRListView const *IR) {
+  size_t NumBlocks {}, NumOps {};
+  for (auto [BlockNode, BlockHeader] : IR->GetBlocks()) {
+    ++NumBlocks;
+    for (auto [CodeNode, IROp] : IR->GetCode(BlockNode)) {
+      if (InterpreterOpHandlers[IROp->Op] != &InterpreterOps::Op_NoOp) {
+        ++NumOps;
+      }
+    }
+  }
+
+  return sizeof(ThreadedProgram) + NumBlocks * sizeof(ThreadedBlock) + NumOps * sizeof(ThreadedOp);
+}
+
+void InterpreterOps::BuildThreadedProgram(FEXCore::IR::IRListView const *IR, uint8_t *Dest) {
+  const uintptr_t DataBegin = IR->GetData();
+
+  uint32_t NumBlocks {};
+  for (auto [BlockNode, BlockHeader] : IR->GetBlocks()) {
+    ++NumBlocks;
+  }
+
+  auto Program = reinterpret_cast<ThreadedProgram*>(Dest);
+  auto Blocks = reinterpret_cast<ThreadedBlock*>(Program + 1);
+  auto Ops = reinterpret_cast<ThreadedOp*>(Blocks + NumBlocks);
+
+  // Blocks are laid out in IR order, so falling off the end of a block's ops lands on the next block like the IR walk does
+  uint32_t NumOps {};
+  for (auto [BlockNode, BlockHeader] : IR->GetBlocks()) {
+    *Blocks++ = ThreadedBlock {
+      .BlockNode = IR->GetID(BlockNode),
+      .FirstOp = NumOps,
+    };
+
+    for (auto [CodeNode, IROp] : IR->GetCode(BlockNode)) {
+      const OpHandler Handler = InterpreterOpHandlers[IROp->Op];
+      if (Handler == &InterpreterOps::Op_NoOp) {
+        continue;
+      }
+
+      Ops[NumOps++] = ThreadedOp {
+        .Handler = Handler,
+        .OpOffset = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(IROp) - DataBegin),
+        .Node = IR->GetID(CodeNode),
+      };
+    }
+  }
+
+  Program->NumBlocks = NumBlocks;
+  Program->NumOps = NumOps;
+}
+
 void InterpreterOps::InterpretIR(FEXCore::Core::CpuStateFrame *Frame, FEXCore::IR::IRListView const *CurrentIR) {
   volatile void *StackEntry = alloca(0);
 
@@ -338,8 +398,6 @@ void InterpreterOps::InterpretIR(FEXCore::Core::CpuStateFrame *Frame, FEXCore::I
 
   static_assert(sizeof(FEXCore::IR::OrderedNode) == 16);
 
-  auto BlockEnd = CurrentIR->GetBlocks().end();
-
   constexpr size_t ListEntrySizeInBytes = sizeof(InterpVector256);
   const size_t SSADataSize = ListSize * ListEntrySizeInBytes;
 
@@ -356,45 +414,35 @@ void InterpreterOps::InterpretIR(FEXCore::Core::CpuStateFrame *Frame, FEXCore::I
   // Clear all SSAData entries to zero. Required for Zero-extend semantics
   memset(OpData.SSAData, 0, SSADataSize);
 
-  while (1) {
-    using namespace FEXCore::IR;
-    auto [BlockNode, BlockHeader] = OpData.BlockIterator();
-    auto BlockIROp = BlockHeader->CW<IROp_CodeBlock>();
-    LOGMAN_THROW_AA_FMT(BlockIROp->Header.Op == IR::OP_CODEBLOCK, "IR type failed to be a code block");
-
-    // Reset the block results per block
-    memset(&OpData.BlockResults, 0, sizeof(OpData.BlockResults));
-
-    auto CodeBegin = CurrentIR->at(BlockIROp->Begin);
-    auto CodeLast = CurrentIR->at(BlockIROp->Last);
-
-    for (auto [CodeNode, IROp] : CurrentIR->GetCode(BlockNode)) {
-      const auto ID = CurrentIR->GetID(CodeNode);
-      const uint32_t Op = IROp->Op;
-
-      // Execute handler
-      OpHandler Handler = InterpreterOpHandlers[Op];
-
-      Handler(IROp, &OpData, ID);
-
-      if (OpData.BlockResults.Quit ||
-          OpData.BlockResults.Redo ||
-          CodeBegin == CodeLast) {
-        break;
+  // InterpreterCore::CompileCode places the threaded program after the inline IR
+  const auto Program = reinterpret_cast<const ThreadedProgram*>(reinterpret_cast<uintptr_t>(CurrentIR) + AlignUp(CurrentIR->GetInlineSize(), 16));
+  const ThreadedBlock *Blocks = Program->Blocks();
+  const ThreadedOp *const OpsBegin = Program->Ops();
+  const ThreadedOp *const OpsEnd = OpsBegin + Program->NumOps;
+  const uintptr_t DataBegin = CurrentIR->GetData();
+
+  for (const ThreadedOp *Op = OpsBegin; Op != OpsEnd;) {
+    Op->Handler(reinterpret_cast<IR::IROp_Header*>(DataBegin + Op->OpOffset), &OpData, Op->Node);
+
+    if (OpData.BlockResults.Redo) [[unlikely]] {
+      // Branch handlers leave their target in the block iterator
+      OpData.BlockResults.Redo = false;
+      const auto Target = OpData.BlockIterator.ID();
+
+      uint32_t Block = 0;
+      while (Blocks[Block].BlockNode != Target) {
+        ++Block;
+        LOGMAN_THROW_AA_FMT(Block < Program->NumBlocks, "Branch to unknown block {}", Target.Value);
       }
-
-      ++CodeBegin;
-    }
-
-    // Iterator will have been set, go again
-    if (OpData.BlockResults.Redo) {
+      Op = OpsBegin + Blocks[Block].FirstOp;
       continue;
     }
 
-    // If we have set to early exit or at the end block then leave
-    if (OpData.BlockResults.Quit || ++OpData.BlockIterator == BlockEnd) {
+    if (OpData.BlockResults.Quit) {
       break;
     }
+
+    ++Op;
   }
 }
 
@@ -50,6 +50,18 @@ namespace FEXCore::CPU {
 
     public:
       static void InterpretIR(FEXCore::Core::CpuStateFrame *Frame, FEXCore::IR::IRListView const *IR);
+
+      /**
+       * @brief Size of the threaded program BuildThreadedProgram generates for IR
+       */
+      static size_t GetThreadedProgramSize(FEXCore::IR::IRListView const *IR);
+
+      /**
+       * @brief Pre-decodes IR in to a flat array of op handlers
+       *
+       * InterpretIR expects the program directly after the inline IR, aligned to 16 bytes.
+       */
+      static void BuildThreadedProgram(FEXCore::IR::IRListView const *IR, uint8_t *Dest);
       static void FillFallbackIndexPointers(uint64_t *Info);
       static bool GetFallbackHandler(IR::IROp_Header const *IROp, FallbackInfo *Info);
 
@@ -67,6 +79,38 @@ namespace FEXCore::CPU {
         IR::NodeIterator BlockIterator{0, 0};
       };
 
+      using OpHandler = void (*)(IR::IROp_Header *IROp, IROpData *Data, IR::NodeID Node);
+
+      // One entry per executed IR op, no-ops are dropped when building the program
+      struct ThreadedOp {
+        OpHandler Handler;
+        // Offset of the op from the start of the IR data
+        uint32_t OpOffset;
+        IR::NodeID Node;
+      };
+
+      // Maps a CodeBlock node to its first op, so branches don't have to walk the IR
+      struct ThreadedBlock {
+        IR::NodeID BlockNode;
+        uint32_t FirstOp;
+      };
+
+      // Followed by NumBlocks ThreadedBlocks then NumOps ThreadedOps
+      struct ThreadedProgram {
+        uint32_t NumBlocks;
+        uint32_t NumOps;
+
+        const ThreadedBlock *Blocks() const {
+          return reinterpret_cast<const ThreadedBlock*>(this + 1);
+        }
+        const ThreadedOp *Ops() const {
+          return reinterpret_cast<const ThreadedOp*>(Blocks() + NumBlocks);
+        }
+      };
+      static_assert(sizeof(ThreadedOp) == 16);
+      static_assert(sizeof(ThreadedBlock) == 8);
+      static_assert(sizeof(ThreadedProgram) == 8);
+
 #define DEF_OP(x) static void Op_##x(IR::IROp_Header *IROp, IROpData *Data, IR::NodeID Node)
 
   ///< Unhandled handler
@@ -185,10 +229,14 @@ namespace FEXCore::CPU {
   DEF_OP(StoreFlag);
   DEF_OP(LoadMem);
   DEF_OP(StoreMem);
+  DEF_OP(StoreMemPair);
   DEF_OP(VLoadVectorMasked);
   DEF_OP(VStoreVectorMasked);
+  DEF_OP(VGather);
   DEF_OP(MemSet);
   DEF_OP(MemCpy);
+  DEF_OP(MemScan);
+  DEF_OP(MemCmp);
   DEF_OP(CacheLineClear);
   DEF_OP(CacheLineClean);
   DEF_OP(CacheLineZero);
@@ -9,7 +9,9 @@ $end_info$
 #include "Interface/Core/Interpreter/InterpreterOps.h"
 #include "Interface/Core/Interpreter/InterpreterDefines.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <type_traits>
 
 namespace FEXCore::CPU {
 static inline void CacheLineFlush(char *Addr) {
@@ -300,6 +302,15 @@ DEF_OP(StoreMem) {
   }
 }
 
+DEF_OP(StoreMemPair) {
+  const auto Op = IROp->C<IR::IROp_StoreMemPair>();
+  const auto OpSize = IROp->Size;
+
+  auto *MemData = *GetSrc<uint8_t**>(Data->SSAData, Op->Addr) + Op->Offset;
+  memcpy(MemData, GetSrc<void*>(Data->SSAData, Op->Value1), OpSize);
+  memcpy(MemData + OpSize, GetSrc<void*>(Data->SSAData, Op->Value2), OpSize);
+}
+
 DEF_OP(VLoadVectorMasked) {
   const auto Op = IROp->C<IR::IROp_VLoadVectorMasked>();
   const auto OpSize = IROp->Size;
@@ -418,6 +429,44 @@ DEF_OP(VStoreVectorMasked) {
   }
 }
 
+DEF_OP(VGather) {
+  const auto Op = IROp->C<IR::IROp_VGather>();
+  const auto OpSize = IROp->Size;
+
+  const auto ElementSize = IROp->ElementSize;
+  const auto IndexElementSize = Op->IndexElementSize;
+  const auto NumElements = OpSize / std::max(ElementSize, IndexElementSize);
+
+  const auto Base = *GetSrc<uint64_t const*>(Data->SSAData, Op->Base);
+  const auto *Dest = GetSrc<uint8_t const*>(Data->SSAData, Op->Dest);
+  const auto *Mask = GetSrc<uint8_t const*>(Data->SSAData, Op->Mask);
+  const auto *Indices = GetSrc<uint8_t const*>(Data->SSAData, Op->Indices);
+
+  uint8_t Result[Core::CPUState::XMM_AVX_REG_SIZE]{};
+  for (size_t i = 0; i < NumElements; i++) {
+    // The mask's sign bit is the top bit of the element's last byte
+    if ((Mask[(i + 1) * ElementSize - 1] & 0x80) == 0) {
+      std::memcpy(Result + (i * ElementSize), Dest + (i * ElementSize), ElementSize);
+      continue;
+    }
+
+    int64_t Index{};
+    if (IndexElementSize == 4) {
+      int32_t Index32{};
+      std::memcpy(&Index32, Indices + (i * IndexElementSize), sizeof(Index32));
+      Index = Index32;
+    }
+    else {
+      std::memcpy(&Index, Indices + (i * IndexElementSize), sizeof(Index));
+    }
+
+    const auto Address = Base + static_cast<uint64_t>(Index * Op->Scale);
+    std::memcpy(Result + (i * ElementSize), reinterpret_cast<const void*>(Address), ElementSize);
+  }
+
+  std::memcpy(GDP, Result, sizeof(Result));
+}
+
 DEF_OP(MemSet) {
   const auto Op = IROp->C<IR::IROp_MemSet>();
   const int32_t Size = Op->Size;
@@ -660,6 +709,114 @@ DEF_OP(MemCpy) {
   }
 }
 
+DEF_OP(MemScan) {
+  const auto Op = IROp->C<IR::IROp_MemScan>();
+  const int32_t Size = Op->Size;
+
+  char *MemData = *GetSrc<char **>(Data->SSAData, Op->Addr);
+  uint64_t MemPrefix{};
+  if (!Op->Prefix.IsInvalid()) {
+    MemPrefix = *GetSrc<uint64_t*>(Data->SSAData, Op->Prefix);
+  }
+
+  const auto Value = *GetSrc<uint64_t*>(Data->SSAData, Op->Value);
+  const auto Length = *GetSrc<uint64_t*>(Data->SSAData, Op->Length);
+  const auto Direction = *GetSrc<uint8_t*>(Data->SSAData, Op->Direction);
+  const int64_t Step = Direction == 0 ? 1 : -1;
+  const bool StopOnMismatch = Op->StopOnMismatch;
+
+  auto ScanElements = [Step, StopOnMismatch](auto* Memory, uint64_t Value, size_t Length) -> uint64_t {
+    using ElementType = std::remove_cvref_t<decltype(Memory[0])>;
+    for (size_t i = 0; i < Length; ++i) {
+      const bool Equal = Memory[i * Step] == static_cast<ElementType>(Value);
+      if (Equal != StopOnMismatch) {
+        return i + 1;
+      }
+    }
+    return Length;
+  };
+
+  uint64_t Compared{};
+  switch (Size) {
+    case 1:
+      Compared = ScanElements(reinterpret_cast<volatile uint8_t*>(MemData + MemPrefix), Value, Length);
+      break;
+    case 2:
+      Compared = ScanElements(reinterpret_cast<volatile uint16_t*>(MemData + MemPrefix), Value, Length);
+      break;
+    case 4:
+      Compared = ScanElements(reinterpret_cast<volatile uint32_t*>(MemData + MemPrefix), Value, Length);
+      break;
+    case 8:
+      Compared = ScanElements(reinterpret_cast<volatile uint64_t*>(MemData + MemPrefix), Value, Length);
+      break;
+    default:
+      LOGMAN_MSG_A_FMT("Unhandled {} size: {}", __func__, Size);
+      break;
+  }
+
+  if (Op->IsAtomic) {
+    std::atomic_thread_fence(std::memory_order_acquire);
+  }
+  GD = Compared;
+}
+
+DEF_OP(MemCmp) {
+  const auto Op = IROp->C<IR::IROp_MemCmp>();
+  const int32_t Size = Op->Size;
+
+  char *MemDataA = *GetSrc<char **>(Data->SSAData, Op->AddrA);
+  char *MemDataB = *GetSrc<char **>(Data->SSAData, Op->AddrB);
+
+  uint64_t PrefixA{};
+  uint64_t PrefixB{};
+  if (!Op->PrefixA.IsInvalid()) {
+    PrefixA = *GetSrc<uint64_t*>(Data->SSAData, Op->PrefixA);
+  }
+  if (!Op->PrefixB.IsInvalid()) {
+    PrefixB = *GetSrc<uint64_t*>(Data->SSAData, Op->PrefixB);
+  }
+
+  const auto Length = *GetSrc<uint64_t*>(Data->SSAData, Op->Length);
+  const auto Direction = *GetSrc<uint8_t*>(Data->SSAData, Op->Direction);
+  const int64_t Step = Direction == 0 ? 1 : -1;
+  const bool StopOnMismatch = Op->StopOnMismatch;
+
+  auto CompareElements = [Step, StopOnMismatch](auto* MemA, auto* MemB, size_t Length) -> uint64_t {
+    for (size_t i = 0; i < Length; ++i) {
+      const bool Equal = MemA[i * Step] == MemB[i * Step];
+      if (Equal != StopOnMismatch) {
+        return i + 1;
+      }
+    }
+    return Length;
+  };
+
+  uint64_t Compared{};
+  switch (Size) {
+    case 1:
+      Compared = CompareElements(reinterpret_cast<volatile uint8_t*>(MemDataA + PrefixA), reinterpret_cast<volatile uint8_t*>(MemDataB + PrefixB), Length);
+      break;
+    case 2:
+      Compared = CompareElements(reinterpret_cast<volatile uint16_t*>(MemDataA + PrefixA), reinterpret_cast<volatile uint16_t*>(MemDataB + PrefixB), Length);
+      break;
+    case 4:
+      Compared = CompareElements(reinterpret_cast<volatile uint32_t*>(MemDataA + PrefixA), reinterpret_cast<volatile uint32_t*>(MemDataB + PrefixB), Length);
+      break;
+    case 8:
+      Compared = CompareElements(reinterpret_cast<volatile uint64_t*>(MemDataA + PrefixA), reinterpret_cast<volatile uint64_t*>(MemDataB + PrefixB), Length);
+      break;
+    default:
+      LOGMAN_MSG_A_FMT("Unhandled {} size: {}", __func__, Size);
+      break;
+  }
+
+  if (Op->IsAtomic) {
+    std::atomic_thread_fence(std::memory_order_acquire);
+  }
+  GD = Compared;
+}
+
 DEF_OP(CacheLineClear) {
   auto Op = IROp->C<IR::IROp_CacheLineClear>();
 
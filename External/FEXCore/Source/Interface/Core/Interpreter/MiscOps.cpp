@@ -73,6 +73,8 @@ DEF_OP(GetRoundingMode) {
   // Extract the rounding
   // On ARM the ordering is different than on x86
   GuestRounding |= ((Tmp >> 24) & 1) ? IR::ROUND_MODE_FLUSH_TO_ZERO : 0;
+  // FPCR.FIZ, RES0 without FEAT_AFP
+  GuestRounding |= (Tmp & 1) ? IR::ROUND_MODE_FLUSH_INPUTS_TO_ZERO : 0;
   uint8_t RoundingMode = (Tmp >> 22) & 0b11;
   if (RoundingMode == 0)
     GuestRounding |= IR::ROUND_MODE_NEAREST;
@@ -85,8 +87,8 @@ DEF_OP(GetRoundingMode) {
 #else
   GuestRounding = _mm_getcsr();
 
-  // Extract the rounding
-  GuestRounding = (GuestRounding >> 13) & 0b111;
+  // Extract the rounding and DAZ
+  GuestRounding = ((GuestRounding >> 13) & 0b111) | ((GuestRounding & (1U << 6)) ? IR::ROUND_MODE_FLUSH_INPUTS_TO_ZERO : 0);
 #endif
   memcpy(GDP, &GuestRounding, sizeof(GuestRounding));
 }
@@ -100,10 +102,11 @@ DEF_OP(SetRoundingMode) {
     mrs %[Tmp], FPCR;
   )"
   : [Tmp] "=r" (HostRounding));
-  // Mask out the rounding
-  HostRounding &= ~(0b111 << 22);
+  // Mask out the rounding and FIZ
+  HostRounding &= ~((0b111 << 22) | 1);
 
   HostRounding |= (GuestRounding & IR::ROUND_MODE_FLUSH_TO_ZERO) ? (1U << 24) : 0;
+  HostRounding |= (GuestRounding & IR::ROUND_MODE_FLUSH_INPUTS_TO_ZERO) ? 1 : 0;
 
   uint8_t RoundingMode = GuestRounding & 0b11;
   if (RoundingMode == IR::ROUND_MODE_NEAREST)
@@ -123,10 +126,11 @@ DEF_OP(SetRoundingMode) {
   uint32_t HostRounding = _mm_getcsr();
 
   // Cut out the host rounding mode
-  HostRounding &= ~(0b111 << 13);
+  HostRounding &= ~((0b111 << 13) | (1U << 6));
 
   // Insert our new rounding mode
-  HostRounding |= GuestRounding << 13;
+  HostRounding |= (GuestRounding & 0b111) << 13;
+  HostRounding |= (GuestRounding & IR::ROUND_MODE_FLUSH_INPUTS_TO_ZERO) ? (1U << 6) : 0;
   _mm_setcsr(HostRounding);
 #endif
 }
@@ -36,7 +36,7 @@ DEF_OP(TruncElementPair) {
 DEF_OP(Constant) {
   auto Op = IROp->C<IR::IROp_Constant>();
   auto Dst = GetReg(Node);
-  LoadConstant(ARMEmitter::Size::i64Bit, Dst, Op->Constant);
+  LoadPooledConstant(Dst, Op->Constant);
 }
 
 DEF_OP(EntrypointOffset) {
@@ -50,7 +50,7 @@ DEF_OP(EntrypointOffset) {
     Mask = 0xFFFF'FFFFULL;
   }
 
-  LoadConstant(ARMEmitter::Size::i64Bit, Dst, Constant & Mask);
+  LoadPooledConstant(Dst, Constant & Mask);
 }
 
 DEF_OP(InlineConstant) {
@@ -65,7 +65,18 @@ DEF_OP(CycleCounter) {
 #ifdef DEBUG_CYCLES
   movz(ARMEmitter::Size::i64Bit, GetReg(Node), 0);
 #else
-  mrs(GetReg(Node), ARMEmitter::SystemRegister::CNTVCT_EL0);
+  if (CTX->ScaleCycleCounter) {
+    // (Counter * Multiplier) >> Shift over the full 128-bit product
+    const auto &Scale = CTX->CycleCounterScale;
+    mrs(TMP1, ARMEmitter::SystemRegister::CNTVCT_EL0);
+    LoadConstant(ARMEmitter::Size::i64Bit, TMP2, Scale.Multiplier);
+    mul(ARMEmitter::Size::i64Bit, TMP3, TMP1, TMP2);
+    umulh(TMP1, TMP1, TMP2);
+    extr(ARMEmitter::Size::i64Bit, GetReg(Node), TMP1, TMP3, Scale.Shift);
+  }
+  else {
+    mrs(GetReg(Node), ARMEmitter::SystemRegister::CNTVCT_EL0);
+  }
 #endif
 }
 
@@ -99,6 +110,83 @@ DEF_OP(TestNZ) {
   mrs(Dst, ARMEmitter::SystemRegister::NZCV);
 }
 
+DEF_OP(AddNZCV) {
+  auto Op = IROp->C<IR::IROp_AddNZCV>();
+  const uint8_t OpSize = Op->Size;
+
+  LOGMAN_THROW_AA_FMT(OpSize == 4 || OpSize == 8, "Unsupported {} size: {}", __func__, OpSize);
+  const auto EmitSize = OpSize == 8 ? ARMEmitter::Size::i64Bit : ARMEmitter::Size::i32Bit;
+
+  const auto Dst = GetReg(Node);
+
+  uint64_t Const;
+  if (IsInlineConstant(Op->Src2, &Const)) {
+    cmn(EmitSize, GetReg(Op->Src1.ID()), Const);
+  } else {
+    cmn(EmitSize, GetReg(Op->Src1.ID()), GetReg(Op->Src2.ID()));
+  }
+
+  // Host carry and overflow match x86 for addition
+  mrs(Dst, ARMEmitter::SystemRegister::NZCV);
+}
+
+DEF_OP(SubNZCV) {
+  auto Op = IROp->C<IR::IROp_SubNZCV>();
+  const uint8_t OpSize = Op->Size;
+
+  LOGMAN_THROW_AA_FMT(OpSize == 4 || OpSize == 8, "Unsupported {} size: {}", __func__, OpSize);
+  const auto EmitSize = OpSize == 8 ? ARMEmitter::Size::i64Bit : ARMEmitter::Size::i32Bit;
+
+  const auto Dst = GetReg(Node);
+
+  uint64_t Const;
+  if (IsInlineConstant(Op->Src2, &Const)) {
+    cmp(EmitSize, GetReg(Op->Src1.ID()), Const);
+  } else {
+    cmp(EmitSize, GetReg(Op->Src1.ID()), GetReg(Op->Src2.ID()));
+  }
+
+  mrs(Dst, ARMEmitter::SystemRegister::NZCV);
+
+  // Host carry is set when there was no borrow, x86 CF is the borrow
+  eor(ARMEmitter::Size::i32Bit, Dst, Dst, 1U << 29);
+}
+
+DEF_OP(AdcNZCV) {
+  auto Op = IROp->C<IR::IROp_AdcNZCV>();
+  const uint8_t OpSize = Op->Size;
+
+  LOGMAN_THROW_AA_FMT(OpSize == 4 || OpSize == 8, "Unsupported {} size: {}", __func__, OpSize);
+  const auto EmitSize = OpSize == 8 ? ARMEmitter::Size::i64Bit : ARMEmitter::Size::i32Bit;
+
+  const auto Dst = GetReg(Node);
+
+  // Host carry = CarryIn >= 1
+  cmp(ARMEmitter::Size::i32Bit, GetReg(Op->CarryIn.ID()), 1);
+  adcs(EmitSize, ARMEmitter::Reg::zr, GetReg(Op->Src1.ID()), GetReg(Op->Src2.ID()));
+
+  mrs(Dst, ARMEmitter::SystemRegister::NZCV);
+}
+
+DEF_OP(SbbNZCV) {
+  auto Op = IROp->C<IR::IROp_SbbNZCV>();
+  const uint8_t OpSize = Op->Size;
+
+  LOGMAN_THROW_AA_FMT(OpSize == 4 || OpSize == 8, "Unsupported {} size: {}", __func__, OpSize);
+  const auto EmitSize = OpSize == 8 ? ARMEmitter::Size::i64Bit : ARMEmitter::Size::i32Bit;
+
+  const auto Dst = GetReg(Node);
+
+  // sbcs subtracts the inverted host carry, host carry = 0 >= BorrowIn
+  cmp(ARMEmitter::Size::i32Bit, ARMEmitter::Reg::zr, GetReg(Op->BorrowIn.ID()));
+  sbcs(EmitSize, ARMEmitter::Reg::zr, GetReg(Op->Src1.ID()), GetReg(Op->Src2.ID()));
+
+  mrs(Dst, ARMEmitter::SystemRegister::NZCV);
+
+  // Host carry is set when there was no borrow, x86 CF is the borrow
+  eor(ARMEmitter::Size::i32Bit, Dst, Dst, 1U << 29);
+}
+
 DEF_OP(Sub) {
   auto Op = IROp->C<IR::IROp_Sub>();
   const uint8_t OpSize = IROp->Size;
@@ -962,6 +1050,28 @@ DEF_OP(Popcount) {
   const auto Dst = GetReg(Node);
   const auto Src = GetReg(Op->Src.ID());
 
+  if (CTX->HostFeatures.SupportsCSSC) {
+    // CSSC has a scalar popcount, avoiding the round trip through a vector register.
+    switch (OpSize) {
+      case 0x1:
+        and_(ARMEmitter::Size::i32Bit, TMP1, Src, 0xFF);
+        cnt(ARMEmitter::Size::i32Bit, Dst, TMP1);
+        break;
+      case 0x2:
+        and_(ARMEmitter::Size::i32Bit, TMP1, Src, 0xFFFF);
+        cnt(ARMEmitter::Size::i32Bit, Dst, TMP1);
+        break;
+      case 0x4:
+        cnt(ARMEmitter::Size::i32Bit, Dst, Src);
+        break;
+      case 0x8:
+        cnt(ARMEmitter::Size::i64Bit, Dst, Src);
+        break;
+      default: LOGMAN_MSG_A_FMT("Unsupported Popcount size: {}", OpSize);
+    }
+    return;
+  }
+
   switch (OpSize) {
     case 0x1:
       fmov(ARMEmitter::Size::i32Bit, VTMP1.S(), Src);
@@ -1001,17 +1111,31 @@ DEF_OP(FindLSB) {
   const auto Dst = GetReg(Node);
   const auto Src = GetReg(Op->Src.ID());
 
-  if (OpSize != 8) {
-    ubfx(EmitSize, TMP1, Src, 0, OpSize * 8);
-    cmp(EmitSize, TMP1, 0);
-    rbit(EmitSize, TMP1, TMP1);
+  if (CTX->HostFeatures.SupportsCSSC) {
+    if (OpSize != 8) {
+      ubfx(EmitSize, TMP1, Src, 0, OpSize * 8);
+      cmp(EmitSize, TMP1, 0);
+      ctz(EmitSize, Dst, TMP1);
+    }
+    else {
+      cmp(EmitSize, Src, 0);
+      ctz(EmitSize, Dst, Src);
+    }
   }
   else {
-    rbit(EmitSize, TMP1, Src);
-    cmp(EmitSize, Src, 0);
+    if (OpSize != 8) {
+      ubfx(EmitSize, TMP1, Src, 0, OpSize * 8);
+      cmp(EmitSize, TMP1, 0);
+      rbit(EmitSize, TMP1, TMP1);
+    }
+    else {
+      rbit(EmitSize, TMP1, Src);
+      cmp(EmitSize, Src, 0);
+    }
+
+    clz(EmitSize, Dst, TMP1);
   }
 
-  clz(EmitSize, Dst, TMP1);
   csinv(EmitSize, Dst, Dst, ARMEmitter::Reg::zr, ARMEmitter::Condition::CC_NE);
 
 }
@@ -1050,6 +1174,18 @@ DEF_OP(FindTrailingZeros) {
   const auto Dst = GetReg(Node);
   const auto Src = GetReg(Op->Src.ID());
 
+  if (CTX->HostFeatures.SupportsCSSC) {
+    if (OpSize == 2) {
+      // Bit 16 stops the count for a zero source
+      orr(EmitSize, Dst, Src, 0x1'0000);
+      ctz(EmitSize, Dst, Dst);
+    }
+    else {
+      ctz(EmitSize, Dst, Src);
+    }
+    return;
+  }
+
   rbit(EmitSize, Dst, Src);
 
   if (OpSize == 2) {
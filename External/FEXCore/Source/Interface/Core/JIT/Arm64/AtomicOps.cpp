@@ -428,13 +428,43 @@ DEF_OP(AtomicFetchNeg) {
     OpSize == 2 ? ARMEmitter::SubRegSize::i16Bit :
     OpSize == 1 ? ARMEmitter::SubRegSize::i8Bit : ARMEmitter::SubRegSize::i8Bit;
 
-  ARMEmitter::BackwardLabel LoopTop;
-  Bind(&LoopTop);
-  ldaxr(SubEmitSize, TMP2, MemSrc);
-  neg(EmitSize, TMP3, TMP2);
-  stlxr(SubEmitSize, TMP4, TMP3, MemSrc);
-  cbnz(EmitSize, TMP4, &LoopTop);
-  mov(EmitSize, GetReg(Node), TMP2.R());
+  if (CTX->HostFeatures.SupportsAtomics) {
+    // No LSE op for negate, loop on CAS instead of exclusives.
+    // Exclusives fault on any unaligned address, while LSE2 makes CAS within 16 bytes work unaligned.
+    ARMEmitter::BackwardLabel LoopTop;
+    switch (OpSize) {
+      case 1:
+        ldrb(TMP2, MemSrc);
+        break;
+      case 2:
+        ldrh(TMP2, MemSrc);
+        break;
+      case 4:
+        ldr(TMP2.W(), MemSrc);
+        break;
+      case 8:
+        ldr(TMP2, MemSrc);
+        break;
+    }
+    Bind(&LoopTop);
+    neg(EmitSize, TMP3, TMP2);
+    mov(EmitSize, TMP4, TMP2.R());
+    casal(SubEmitSize, TMP4, TMP3, MemSrc);
+    // CAS zero extends the narrow sizes, the same as the load
+    cmp(EmitSize, TMP4, TMP2);
+    mov(EmitSize, TMP2, TMP4.R());
+    b(ARMEmitter::Condition::CC_NE, &LoopTop);
+    mov(EmitSize, GetReg(Node), TMP2.R());
+  }
+  else {
+    ARMEmitter::BackwardLabel LoopTop;
+    Bind(&LoopTop);
+    ldaxr(SubEmitSize, TMP2, MemSrc);
+    neg(EmitSize, TMP3, TMP2);
+    stlxr(SubEmitSize, TMP4, TMP3, MemSrc);
+    cbnz(EmitSize, TMP4, &LoopTop);
+    mov(EmitSize, GetReg(Node), TMP2.R());
+  }
 }
 
 #undef DEF_OP
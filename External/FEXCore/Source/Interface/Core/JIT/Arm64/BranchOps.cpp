@@ -17,6 +17,9 @@ $end_info$
 #include <FEXCore/Utils/MathUtils.h>
 #include <Interface/HLE/Thunks/Thunks.h>
 
+#include <signal.h>
+#include <sys/syscall.h>
+
 namespace FEXCore::CPU {
 #define DEF_OP(x) void Arm64JITCore::Op_##x(IR::IROp_Header const *IROp, IR::NodeID Node)
 
@@ -52,38 +55,162 @@ DEF_OP(ExitFunction) {
   uint64_t NewRIP;
 
   if (IsInlineConstant(Op->NewRIP, &NewRIP) || IsInlineEntrypointOffset(Op->NewRIP, &NewRIP)) {
-    ARMEmitter::ForwardLabel l_BranchHost;
+    auto l_BranchHost = InsertNamedSymbolLiteral(FEXCore::CPU::RelocNamedSymbolLiteral::NamedSymbol::SYMBOL_LITERAL_EXITFUNCTION_LINKER);
     ARMEmitter::ForwardLabel l_BranchGuest;
 
-    ldr(ARMEmitter::XReg::x0, &l_BranchHost);
+    // A conditional branch can only skip to the target if this exit is all the block does
+    uint8_t *CondBranch{};
+    if (GetCursorAddress<uint8_t *>() == CurrentBlockStart) {
+      if (auto it = CondBranchToBlock.find(CurrentBlockID); it != CondBranchToBlock.end()) {
+        CondBranch = it->second;
+      }
+    }
+
+    ldr(ARMEmitter::XReg::x0, &l_BranchHost.Loc);
     blr(ARMEmitter::Reg::r0);
 
-    Bind(&l_BranchHost);
-    dc64(ThreadState->CurrentFrame->Pointers.Common.ExitFunctionLinker);
+    // Record layout: { Linker, GuestRIP, distance from the record back to the conditional branch or 0 }
+    const auto Record = GetCursorAddress<uint8_t *>();
+    PlaceNamedSymbolLiteral(l_BranchHost);
     Bind(&l_BranchGuest);
     dc64(NewRIP);
+    dc64(CondBranch ? Record - CondBranch : 0);
 
   } else {
 
     ARMEmitter::ForwardLabel FullLookup;
     auto RipReg = GetReg(Op->NewRIP.ID());
 
+    // Code in a shared code cache can be run by multiple threads at once, which would tear the inline cache.
+    const bool InlineCache = CTX->Config.IndirectBranchCache && !CTX->IsCodeCacheShared();
+    ARMEmitter::ForwardLabel InlineCacheData;
+
+    if (InlineCache) {
+      // Inline cache layout: { GuestRIP, HostCode, Epoch }
+      ARMEmitter::ForwardLabel L1Lookup;
+
+      adr(ARMEmitter::Reg::r3, &InlineCacheData);
+      // The epoch of the target's page must be loaded before the L1 entry that may refill the inline cache.
+      ldr(ARMEmitter::XReg::x2, STATE, offsetof(FEXCore::Core::CpuStateFrame, Pointers.Common.LookupCacheEpochPointer));
+      ubfx(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r0, RipReg, 12, FEXCore::ilog2(LookupCache::INVALIDATION_EPOCH_PAGES));
+      add(ARMEmitter::XReg::x2, ARMEmitter::XReg::x2, ARMEmitter::XReg::x0, ARMEmitter::ShiftType::LSL, 3);
+      ldar(ARMEmitter::XReg::x2, ARMEmitter::Reg::r2);
+
+      ldp<ARMEmitter::IndexType::OFFSET>(ARMEmitter::XReg::x0, ARMEmitter::XReg::x1, ARMEmitter::Reg::r3, 0);
+      cmp(ARMEmitter::XReg::x0, RipReg.X());
+      b(ARMEmitter::Condition::CC_NE, &L1Lookup);
+      ldr(ARMEmitter::XReg::x0, ARMEmitter::Reg::r3, 16);
+      cmp(ARMEmitter::XReg::x0, ARMEmitter::XReg::x2);
+      b(ARMEmitter::Condition::CC_NE, &L1Lookup);
+      br(ARMEmitter::Reg::r1);
+
+      Bind(&L1Lookup);
+    }
+
     // L1 Cache
+    // x2 and x3 hold the epoch and inline cache pointer when the inline cache is used.
     ldr(ARMEmitter::XReg::x0, STATE, offsetof(FEXCore::Core::CpuStateFrame, Pointers.Common.L1Pointer));
+    ldr(ARMEmitter::XReg::x1, STATE, offsetof(FEXCore::Core::CpuStateFrame, Pointers.Common.L1Mask));
 
-    and_(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r3, RipReg, LookupCache::L1_ENTRIES_MASK);
-    add(ARMEmitter::XReg::x0, ARMEmitter::XReg::x0, ARMEmitter::XReg::x3, ARMEmitter::ShiftType::LSL, 4);
+    and_(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r1, RipReg, ARMEmitter::Reg::r1);
+    add(ARMEmitter::XReg::x0, ARMEmitter::XReg::x0, ARMEmitter::XReg::x1, ARMEmitter::ShiftType::LSL, 4);
 
     ldp<ARMEmitter::IndexType::OFFSET>(ARMEmitter::XReg::x1, ARMEmitter::XReg::x0, ARMEmitter::Reg::r0, 0);
     cmp(ARMEmitter::XReg::x0, RipReg.X());
     b(ARMEmitter::Condition::CC_NE, &FullLookup);
+    if (InlineCache) {
+      // Refill the inline cache with this target
+      stp<ARMEmitter::IndexType::OFFSET>(RipReg.X(), ARMEmitter::XReg::x1, ARMEmitter::Reg::r3, 0);
+      str(ARMEmitter::XReg::x2, ARMEmitter::Reg::r3, 16);
+    }
     br(ARMEmitter::Reg::r1);
 
     Bind(&FullLookup);
     ldr(TMP1, STATE, offsetof(FEXCore::Core::CpuStateFrame, Pointers.Common.DispatcherLoopTop));
     str(RipReg.X(), STATE, offsetof(FEXCore::Core::CpuStateFrame, State.rip));
     br(TMP1);
+
+    if (InlineCache) {
+      // Keep the entry 8-byte aligned so ldp/stp on it don't split cachelines
+      if (GetCursorAddress<uintptr_t>() & 0b111) {
+        dc32(0);
+      }
+      Bind(&InlineCacheData);
+      dc64(0);
+      dc64(0);
+      dc64(~0ULL);
+    }
+  }
+}
+
+DEF_OP(PushReturnStack) {
+  auto Op = IROp->C<IR::IROp_PushReturnStack>();
+
+  uint64_t ReturnRIP;
+  if (!IsInlineConstant(Op->ReturnRIP, &ReturnRIP) && !IsInlineEntrypointOffset(Op->ReturnRIP, &ReturnRIP)) {
+    // Without a known return address there is nothing to link against
+    return;
   }
+
+  ARMEmitter::ForwardLabel l_ReturnStub;
+  auto l_BranchHost = InsertNamedSymbolLiteral(FEXCore::CPU::RelocNamedSymbolLiteral::NamedSymbol::SYMBOL_LITERAL_EXITFUNCTION_LINKER);
+  ARMEmitter::ForwardLabel l_BranchGuest;
+  ARMEmitter::ForwardLabel l_Skip;
+
+  // ReturnStack[ReturnStackTop++ & RETURN_STACK_MASK] = { ReturnRIP, ReturnStub }
+  ldr(ARMEmitter::XReg::x0, STATE, offsetof(FEXCore::Core::CpuStateFrame, ReturnStackTop));
+  and_(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r1, ARMEmitter::Reg::r0, FEXCore::Core::CpuStateFrame::RETURN_STACK_MASK);
+  LoadConstant(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r2, offsetof(FEXCore::Core::CpuStateFrame, ReturnStack));
+  add(ARMEmitter::XReg::x2, STATE, ARMEmitter::XReg::x2);
+  add(ARMEmitter::XReg::x2, ARMEmitter::XReg::x2, ARMEmitter::XReg::x1, ARMEmitter::ShiftType::LSL, 4);
+
+  ldr(ARMEmitter::XReg::x1, &l_BranchGuest);
+  adr(ARMEmitter::Reg::r3, &l_ReturnStub);
+  stp<ARMEmitter::IndexType::OFFSET>(ARMEmitter::XReg::x1, ARMEmitter::XReg::x3, ARMEmitter::Reg::r2, 0);
+
+  add(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r0, ARMEmitter::Reg::r0, 1);
+  str(ARMEmitter::XReg::x0, STATE, offsetof(FEXCore::Core::CpuStateFrame, ReturnStackTop));
+  b(&l_Skip);
+
+  // Out of line exit to the return address, taken by a correctly predicted RET.
+  // This is a regular linkable exit, so it gets block linked and delinked like any other.
+  Bind(&l_ReturnStub);
+  ldr(ARMEmitter::XReg::x0, &l_BranchHost.Loc);
+  blr(ARMEmitter::Reg::r0);
+
+  PlaceNamedSymbolLiteral(l_BranchHost);
+  Bind(&l_BranchGuest);
+  dc64(ReturnRIP);
+
+  Bind(&l_Skip);
+}
+
+DEF_OP(ReturnStackLookup) {
+  auto Op = IROp->C<IR::IROp_ReturnStackLookup>();
+  auto RipReg = GetReg(Op->NewRIP.ID());
+
+  ARMEmitter::ForwardLabel l_Mispredict;
+
+  // Entry = ReturnStack[--ReturnStackTop & RETURN_STACK_MASK]
+  ldr(ARMEmitter::XReg::x0, STATE, offsetof(FEXCore::Core::CpuStateFrame, ReturnStackTop));
+  sub(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r0, ARMEmitter::Reg::r0, 1);
+  str(ARMEmitter::XReg::x0, STATE, offsetof(FEXCore::Core::CpuStateFrame, ReturnStackTop));
+  and_(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r0, ARMEmitter::Reg::r0, FEXCore::Core::CpuStateFrame::RETURN_STACK_MASK);
+  LoadConstant(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r2, offsetof(FEXCore::Core::CpuStateFrame, ReturnStack));
+  add(ARMEmitter::XReg::x2, STATE, ARMEmitter::XReg::x2);
+  add(ARMEmitter::XReg::x2, ARMEmitter::XReg::x2, ARMEmitter::XReg::x0, ARMEmitter::ShiftType::LSL, 4);
+  ldp<ARMEmitter::IndexType::OFFSET>(ARMEmitter::XReg::x3, ARMEmitter::XReg::x1, ARMEmitter::Reg::r2, 0);
+
+  // Stack manipulation, longjmp, or an overflowed stack. Leave through the regular exit.
+  cmp(ARMEmitter::XReg::x3, RipReg.X());
+  b(ARMEmitter::Condition::CC_NE, &l_Mispredict);
+  cbz(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r1, &l_Mispredict);
+
+  // ResetStack may clobber x0 but not x1
+  ResetStack();
+  br(ARMEmitter::Reg::r1);
+
+  Bind(&l_Mispredict);
 }
 
 DEF_OP(Jump) {
@@ -121,6 +248,13 @@ static ARMEmitter::Condition MapBranchCC(IR::CondClassType Cond) {
   }
 }
 
+void Arm64JITCore::RecordCondBranch(IR::NodeID Target) {
+  auto [it, Inserted] = CondBranchToBlock.try_emplace(Target, GetCursorAddress<uint8_t *>());
+  if (!Inserted) {
+    it->second = nullptr;
+  }
+}
+
 DEF_OP(CondJump) {
   auto Op = IROp->C<IR::IROp_CondJump>();
 
@@ -134,10 +268,26 @@ DEF_OP(CondJump) {
 
   if (isConst && Const == 0 && Op->Cond.Val == FEXCore::IR::COND_EQ) {
     LOGMAN_THROW_A_FMT(IsGPR(Op->Cmp1.ID()), "CondJump: Expected GPR");
+    RecordCondBranch(Op->TrueBlock.ID());
     cbz(Size, GetReg(Op->Cmp1.ID()), TrueTargetLabel);
   } else if (isConst && Const == 0 && Op->Cond.Val == FEXCore::IR::COND_NEQ) {
     LOGMAN_THROW_A_FMT(IsGPR(Op->Cmp1.ID()), "CondJump: Expected GPR");
+    RecordCondBranch(Op->TrueBlock.ID());
     cbnz(Size, GetReg(Op->Cmp1.ID()), TrueTargetLabel);
+  } else if (isConst && Const == 0 &&
+             (Op->Cond.Val == FEXCore::IR::COND_SLT || Op->Cond.Val == FEXCore::IR::COND_SGE) &&
+             TrueTargetLabel->Backward.Location &&
+             (GetCursorAddress<uint8_t*>() - TrueTargetLabel->Backward.Location) < 32768) {
+    // Sign checks only need the top bit. tbz only reaches +-32KB so this is limited to already bound targets in range,
+    // which covers loop back-edges.
+    LOGMAN_THROW_A_FMT(IsGPR(Op->Cmp1.ID()), "CondJump: Expected GPR");
+    const auto SignBit = Op->CompareSize == 4 ? 31 : 63;
+    if (Op->Cond.Val == FEXCore::IR::COND_SLT) {
+      tbnz(GetReg(Op->Cmp1.ID()), SignBit, TrueTargetLabel);
+    }
+    else {
+      tbz(GetReg(Op->Cmp1.ID()), SignBit, TrueTargetLabel);
+    }
   } else {
     if (IsGPR(Op->Cmp1.ID())) {
       if (isConst) {
@@ -151,6 +301,7 @@ DEF_OP(CondJump) {
       LOGMAN_MSG_A_FMT("CondJump: Expected GPR or FPR");
     }
 
+    RecordCondBranch(Op->TrueBlock.ID());
     b(MapBranchCC(Op->Cond), TrueTargetLabel);
   }
 
@@ -165,7 +316,7 @@ DEF_OP(Syscall) {
   // X2: Pointer to SyscallArguments
 
   FEXCore::IR::SyscallFlags Flags = Op->Flags;
-  PushDynamicRegsAndLR(TMP1);
+  PushLiveDynamicRegsAndLR(TMP1);
 
   uint32_t GPRSpillMask = ~0U;
   uint32_t FPRSpillMask = ~0U;
@@ -214,7 +365,7 @@ DEF_OP(Syscall) {
     // We can safely claim we are no longer in a syscall
     str(ARMEmitter::XReg::zr, STATE, offsetof(FEXCore::Core::CpuStateFrame, InSyscallInfo));
 
-    PopDynamicRegsAndLR();
+    PopLiveDynamicRegsAndLR();
 
     if ((Flags & FEXCore::IR::SyscallFlags::NORETURNEDRESULT) != FEXCore::IR::SyscallFlags::NORETURNEDRESULT) {
       // Move result to its destination register.
@@ -262,6 +413,23 @@ DEF_OP(InlineSyscall) {
   // Only spill the registers that intersect with our usage
   SpillStaticRegs(TMP1, false, SpillMask);
 
+  // Have the host catch up with signals the guest masked before the syscall can block.
+  // x0-x3 are temporaries and x8 was just spilled, so they are free until the arguments are set up.
+  ARMEmitter::ForwardLabel SkipSignalMask;
+  ldr(ARMEmitter::XReg::x1, STATE, offsetof(FEXCore::Core::CpuStateFrame, PendingHostSignalMask));
+  cbz(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r1, &SkipSignalMask);
+  // Cleared before blocking, a signal handler in between may set a new mask to apply
+  str(ARMEmitter::XReg::zr, STATE, offsetof(FEXCore::Core::CpuStateFrame, PendingHostSignalMask));
+  str<ARMEmitter::IndexType::PRE>(ARMEmitter::XReg::x1, ARMEmitter::Reg::rsp, -16);
+  LoadConstant(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r0, SIG_BLOCK);
+  add(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r1, ARMEmitter::Reg::rsp, 0);
+  LoadConstant(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r2, 0);
+  LoadConstant(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r3, 8);
+  LoadConstant(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r8, SYS_rt_sigprocmask);
+  svc(0);
+  add(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::rsp, ARMEmitter::Reg::rsp, 16);
+  Bind(&SkipSignalMask);
+
   // Now that we are spilled, store in the state that we are in a syscall
   // Still without overwriting registers that matter
   // 16bit LoadConstant to be a single instruction
@@ -330,19 +498,18 @@ DEF_OP(Thunk) {
 
   SpillStaticRegs(TMP1); // spill to ctx before ra64 spill
 
-  PushDynamicRegsAndLR(TMP1);
+  PushLiveDynamicRegsAndLR(TMP1);
 
   mov(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r0, GetReg(Op->ArgPtr.ID()));
 
-  auto thunkFn = static_cast<Context::ContextImpl*>(ThreadState->CTX)->ThunkHandler->LookupThunk(Op->ThunkNameHash);
-  LoadConstant(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r2, (uintptr_t)thunkFn);
+  InsertNamedThunkRelocation(ARMEmitter::Reg::r2, Op->ThunkNameHash);
 #ifdef VIXL_SIMULATOR
   GenerateIndirectRuntimeCall<void, void*, void*>(ARMEmitter::Reg::r2);
 #else
   blr(ARMEmitter::Reg::r2);
 #endif
 
-  PopDynamicRegsAndLR();
+  PopLiveDynamicRegsAndLR();
 
   FillStaticRegs(); // load from ctx after ra64 refill
 }
@@ -402,7 +569,7 @@ DEF_OP(ThreadRemoveCodeEntry) {
   // X0: Thread
   // X1: RIP
 
-  PushDynamicRegsAndLR(TMP1);
+  PushLiveDynamicRegsAndLR(TMP1);
   SpillStaticRegs(TMP1);
 
   mov(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r0, STATE.R());
@@ -417,13 +584,13 @@ DEF_OP(ThreadRemoveCodeEntry) {
   FillStaticRegs();
 
   // Fix the stack and any values that were stepped on
-  PopDynamicRegsAndLR();
+  PopLiveDynamicRegsAndLR();
 }
 
 DEF_OP(CPUID) {
   auto Op = IROp->C<IR::IROp_CPUID>();
 
-  PushDynamicRegsAndLR(TMP1);
+  PushLiveDynamicRegsAndLR(TMP1);
   SpillStaticRegs(TMP1);
 
   // x0 = CPUID Handler
@@ -441,7 +608,7 @@ DEF_OP(CPUID) {
 
   FillStaticRegs();
 
-  PopDynamicRegsAndLR();
+  PopLiveDynamicRegsAndLR();
 
   // Results are in x0, x1
   // Results want to be in a i64v2 vector
@@ -453,7 +620,7 @@ DEF_OP(CPUID) {
 DEF_OP(XGETBV) {
   auto Op = IROp->C<IR::IROp_XGetBV>();
 
-  PushDynamicRegsAndLR(TMP1);
+  PushLiveDynamicRegsAndLR(TMP1);
   SpillStaticRegs(TMP1);
 
   // x0 = CPUID Handler
@@ -469,7 +636,7 @@ DEF_OP(XGETBV) {
 
   FillStaticRegs();
 
-  PopDynamicRegsAndLR();
+  PopLiveDynamicRegsAndLR();
 
   // Results are in x0
   // Results want to be in a i32v2 vector
@@ -27,9 +27,10 @@ DEF_OP(AESEnc) {
   LOGMAN_THROW_AA_FMT(OpSize == Core::CPUState::XMM_SSE_REG_SIZE,
                       "Currently only supports 128-bit operations.");
 
-  eor(VTMP2.Q(), VTMP2.Q(), VTMP2.Q());
-  mov(VTMP1.Q(), State.Q());
-  aese(VTMP1, VTMP2);
+  // AESE XORs its operands before SubBytes, so zeroing the destination and passing State as the
+  // second operand saves copying State into a temporary.
+  eor(VTMP1.Q(), VTMP1.Q(), VTMP1.Q());
+  aese(VTMP1, State);
   aesmc(VTMP1, VTMP1);
   eor(Dst.Q(), VTMP1.Q(), Key.Q());
 }
@@ -45,9 +46,8 @@ DEF_OP(AESEncLast) {
   LOGMAN_THROW_AA_FMT(OpSize == Core::CPUState::XMM_SSE_REG_SIZE,
                       "Currently only supports 128-bit operations.");
 
-  eor(VTMP2.Q(), VTMP2.Q(), VTMP2.Q());
-  mov(VTMP1.Q(), State.Q());
-  aese(VTMP1, VTMP2);
+  eor(VTMP1.Q(), VTMP1.Q(), VTMP1.Q());
+  aese(VTMP1, State);
   eor(Dst.Q(), VTMP1.Q(), Key.Q());
 }
 
@@ -62,9 +62,8 @@ DEF_OP(AESDec) {
   LOGMAN_THROW_AA_FMT(OpSize == Core::CPUState::XMM_SSE_REG_SIZE,
                       "Currently only supports 128-bit operations.");
 
-  eor(VTMP2.Q(), VTMP2.Q(), VTMP2.Q());
-  mov(VTMP1.Q(), State.Q());
-  aesd(VTMP1, VTMP2);
+  eor(VTMP1.Q(), VTMP1.Q(), VTMP1.Q());
+  aesd(VTMP1, State);
   aesimc(VTMP1, VTMP1);
   eor(Dst.Q(), VTMP1.Q(), Key.Q());
 }
@@ -80,9 +79,8 @@ DEF_OP(AESDecLast) {
   LOGMAN_THROW_AA_FMT(OpSize == Core::CPUState::XMM_SSE_REG_SIZE,
                       "Currently only supports 128-bit operations.");
 
-  eor(VTMP2.Q(), VTMP2.Q(), VTMP2.Q());
-  mov(VTMP1.Q(), State.Q());
-  aesd(VTMP1, VTMP2);
+  eor(VTMP1.Q(), VTMP1.Q(), VTMP1.Q());
+  aesd(VTMP1, State);
   eor(Dst.Q(), VTMP1.Q(), Key.Q());
 }
 
@@ -93,9 +91,8 @@ DEF_OP(AESKeyGenAssist) {
   ARMEmitter::ForwardLabel PastConstant;
 
   // Do a "regular" AESE step
-  eor(VTMP2.Q(), VTMP2.Q(), VTMP2.Q());
-  mov(VTMP1.Q(), GetVReg(Op->Src.ID()).Q());
-  aese(VTMP1, VTMP2);
+  eor(VTMP1.Q(), VTMP1.Q(), VTMP1.Q());
+  aese(VTMP1, GetVReg(Op->Src.ID()));
 
   // Do a table shuffle to undo ShiftRows
   ldr(VTMP3.Q(), &Constant);
@@ -0,0 +1,260 @@
+/*
+$info$
+tags: backend|arm64
+desc: Inline fast paths for the exact x87 conversions and compares, everything else falls back to SoftFloat
+$end_info$
+*/
+
+#include "Interface/Core/ArchHelpers/CodeEmitter/Emitter.h"
+#include "Interface/Core/JIT/Arm64/JITClass.h"
+#include "Interface/IR/Passes/RegisterAllocationPass.h"
+
+namespace FEXCore::CPU {
+#define DEF_OP(x) void Arm64JITCore::Op_##x(IR::IROp_Header const *IROp, IR::NodeID Node)
+
+// The F80 is stored with the 64-bit mantissa in the lower 64 bits
+// and the sign and 15-bit exponent in the 16-bit element 4.
+// Only conversions that are exact and don't depend on the rounding mode or precision control are done inline.
+// NaNs, infinities, denormals and unnormals take the SoftFloat fallback.
+constexpr uint32_t F80_EXPONENT_BIAS = 16383;
+
+DEF_OP(F80CVTTo) {
+  auto Op = IROp->C<IR::IROp_F80CVTTo>();
+  const auto Dst = GetVReg(Node);
+  const auto Src = GetVReg(Op->X80Src.ID());
+
+  LOGMAN_THROW_AA_FMT(Op->SrcSize == 4 || Op->SrcSize == 8, "Unexpected F80CVTTo source size: {}", Op->SrcSize);
+
+  const uint32_t SrcBits = Op->SrcSize * 8;
+  const uint32_t ExponentBits = Op->SrcSize == 4 ? 8 : 11;
+  const uint32_t MantissaBits = Op->SrcSize == 4 ? 23 : 52;
+  const uint32_t ExponentBias = F80_EXPONENT_BIAS - (Op->SrcSize == 4 ? 127 : 1023);
+
+  ARMEmitter::ForwardLabel ZeroOrDenormal;
+  ARMEmitter::ForwardLabel Combine;
+  ARMEmitter::ForwardLabel Fallback;
+  ARMEmitter::ForwardLabel Done;
+
+  if (Op->SrcSize == 4) {
+    fmov(ARMEmitter::Size::i32Bit, TMP1, Src.S());
+  }
+  else {
+    fmov(ARMEmitter::Size::i64Bit, TMP1, Src.D());
+  }
+
+  // The exponent's lsb shifts in to the explicit integer bit, the sign shifts out
+  ubfx(ARMEmitter::Size::i64Bit, TMP2, TMP1, MantissaBits, ExponentBits);
+  lsl(ARMEmitter::Size::i64Bit, TMP3, TMP1, 63 - MantissaBits);
+  cbz(ARMEmitter::Size::i64Bit, TMP2, &ZeroOrDenormal);
+
+  // Exponent of all ones is an infinity or NaN
+  add(ARMEmitter::Size::i64Bit, TMP4, TMP2, 1);
+  tbnz(TMP4, ExponentBits, &Fallback);
+
+  // Normal, set the integer bit and rebias
+  orr(ARMEmitter::Size::i64Bit, TMP3, TMP3, 1ULL << 63);
+  add(ARMEmitter::Size::i64Bit, TMP2, TMP2, ExponentBias >> 12, true);
+  add(ARMEmitter::Size::i64Bit, TMP2, TMP2, ExponentBias & 0xFFF);
+  b(&Combine);
+
+  Bind(&ZeroOrDenormal);
+  // Any mantissa bits left is a denormal
+  cbnz(ARMEmitter::Size::i64Bit, TMP3, &Fallback);
+
+  Bind(&Combine);
+  lsr(ARMEmitter::Size::i64Bit, TMP4, TMP1, SrcBits - 1);
+  orr(ARMEmitter::Size::i64Bit, TMP2, TMP2, TMP4, ARMEmitter::ShiftType::LSL, 15);
+  eor(Dst.Q(), Dst.Q(), Dst.Q());
+  ins(ARMEmitter::SubRegSize::i64Bit, Dst, 0, TMP3);
+  ins(ARMEmitter::SubRegSize::i16Bit, Dst, 4, TMP2);
+  b(&Done);
+
+  Bind(&Fallback);
+  Op_Unhandled(IROp, Node);
+
+  Bind(&Done);
+  // Only the fallback path spilled the static registers
+  NextStaticRegsInContext = false;
+}
+
+DEF_OP(F80CVT) {
+  auto Op = IROp->C<IR::IROp_F80CVT>();
+  const uint8_t OpSize = IROp->Size;
+  const auto Dst = GetVReg(Node);
+  const auto Src = GetVReg(Op->X80Src.ID());
+
+  LOGMAN_THROW_AA_FMT(OpSize == 4 || OpSize == 8, "Unexpected F80CVT size: {}", OpSize);
+
+  const uint32_t DstBits = OpSize * 8;
+  const uint32_t MantissaBits = OpSize == 4 ? 23 : 52;
+  const uint32_t MaxExponent = OpSize == 4 ? 254 : 2046;
+  const uint32_t ExponentBias = F80_EXPONENT_BIAS - (OpSize == 4 ? 127 : 1023);
+
+  ARMEmitter::ForwardLabel NonZero;
+  ARMEmitter::ForwardLabel Store;
+  ARMEmitter::ForwardLabel Fallback;
+  ARMEmitter::ForwardLabel Done;
+
+  umov<ARMEmitter::SubRegSize::i64Bit>(TMP1, Src, 0);
+  umov<ARMEmitter::SubRegSize::i16Bit>(TMP2, Src, 4);
+  and_(ARMEmitter::Size::i64Bit, TMP3, TMP2, 0x7FFF);
+  cbnz(ARMEmitter::Size::i64Bit, TMP3, &NonZero);
+
+  // Zero keeps its sign, denormals and pseudo-denormals go to SoftFloat
+  cbnz(ARMEmitter::Size::i64Bit, TMP1, &Fallback);
+  lsl(ARMEmitter::Size::i64Bit, TMP1, TMP2, DstBits - 16);
+  b(&Store);
+
+  Bind(&NonZero);
+  // Unnormals, infinities and NaNs go to SoftFloat
+  tbz(TMP1, 63, &Fallback);
+
+  // Mantissa bits that would be rounded away depend on the rounding mode
+  tst(ARMEmitter::Size::i64Bit, TMP1, (1ULL << (63 - MantissaBits)) - 1);
+  b(ARMEmitter::Condition::CC_NE, &Fallback);
+
+  // Rebias, anything outside of the destination's normal range over or underflows
+  sub(ARMEmitter::Size::i64Bit, TMP3, TMP3, ExponentBias >> 12, true);
+  sub(ARMEmitter::Size::i64Bit, TMP3, TMP3, ExponentBias & 0xFFF);
+  sub(ARMEmitter::Size::i64Bit, TMP4, TMP3, 1);
+  cmp(ARMEmitter::Size::i64Bit, TMP4, MaxExponent - 1);
+  b(ARMEmitter::Condition::CC_HI, &Fallback);
+
+  ubfx(ARMEmitter::Size::i64Bit, TMP1, TMP1, 63 - MantissaBits, MantissaBits);
+  orr(ARMEmitter::Size::i64Bit, TMP1, TMP1, TMP3, ARMEmitter::ShiftType::LSL, MantissaBits);
+  lsr(ARMEmitter::Size::i64Bit, TMP2, TMP2, 15);
+  orr(ARMEmitter::Size::i64Bit, TMP1, TMP1, TMP2, ARMEmitter::ShiftType::LSL, DstBits - 1);
+
+  Bind(&Store);
+  if (OpSize == 4) {
+    fmov(ARMEmitter::Size::i32Bit, Dst.S(), TMP1);
+  }
+  else {
+    fmov(ARMEmitter::Size::i64Bit, Dst.D(), TMP1);
+  }
+  b(&Done);
+
+  Bind(&Fallback);
+  Op_Unhandled(IROp, Node);
+
+  Bind(&Done);
+  // Only the fallback path spilled the static registers
+  NextStaticRegsInContext = false;
+}
+
+DEF_OP(F80CVTToInt) {
+  auto Op = IROp->C<IR::IROp_F80CVTToInt>();
+  const auto Dst = GetVReg(Node);
+  const auto Src = GetReg(Op->Src.ID());
+
+  LOGMAN_THROW_AA_FMT(Op->SrcSize == 2 || Op->SrcSize == 4, "Unexpected F80CVTToInt source size: {}", Op->SrcSize);
+
+  // Every 16-bit and 32-bit integer is exact in an F80, so this never needs SoftFloat
+  ARMEmitter::ForwardLabel Done;
+
+  if (Op->SrcSize == 2) {
+    sxth(ARMEmitter::Size::i64Bit, TMP1, Src);
+  }
+  else {
+    sxtw(TMP1, Src.W());
+  }
+
+  eor(Dst.Q(), Dst.Q(), Dst.Q());
+  cbz(ARMEmitter::Size::i64Bit, TMP1, &Done);
+
+  // Sign and magnitude
+  lsr(ARMEmitter::Size::i64Bit, TMP2, TMP1, 63);
+  tst(ARMEmitter::Size::i64Bit, TMP1, TMP1);
+  cneg(ARMEmitter::Size::i64Bit, TMP1, TMP1, ARMEmitter::Condition::CC_MI);
+
+  // Normalize so the integer bit is set
+  clz(ARMEmitter::Size::i64Bit, TMP3, TMP1);
+  lslv(ARMEmitter::Size::i64Bit, TMP1, TMP1, TMP3);
+  movz(ARMEmitter::Size::i64Bit, TMP4, F80_EXPONENT_BIAS + 63);
+  sub(ARMEmitter::Size::i64Bit, TMP4, TMP4, TMP3);
+  orr(ARMEmitter::Size::i64Bit, TMP4, TMP4, TMP2, ARMEmitter::ShiftType::LSL, 15);
+
+  ins(ARMEmitter::SubRegSize::i64Bit, Dst, 0, TMP1);
+  ins(ARMEmitter::SubRegSize::i16Bit, Dst, 4, TMP4);
+
+  Bind(&Done);
+}
+
+DEF_OP(F80Cmp) {
+  auto Op = IROp->C<IR::IROp_F80Cmp>();
+  const auto Dst = GetReg(Node);
+  const auto Src1 = GetVReg(Op->X80Src1.ID());
+  const auto Src2 = GetVReg(Op->X80Src2.ID());
+
+  ARMEmitter::ForwardLabel Fallback;
+  ARMEmitter::ForwardLabel Done;
+
+  // Canonical F80s order the same as their sign-magnitude bits.
+  // Turn each in to a signed 128-bit key of exponent:mantissa, with both zeroes as zero.
+  // Dst is free to use as a temporary until the result is written.
+  auto LoadCompareKey = [&](ARMEmitter::VRegister Src, ARMEmitter::XRegister Low, ARMEmitter::XRegister High) {
+    ARMEmitter::ForwardLabel NonZero;
+    ARMEmitter::ForwardLabel Positive;
+    ARMEmitter::ForwardLabel KeyDone;
+
+    umov<ARMEmitter::SubRegSize::i64Bit>(Low, Src, 0);
+    umov<ARMEmitter::SubRegSize::i16Bit>(High, Src, 4);
+    and_(ARMEmitter::Size::i64Bit, Dst, High, 0x7FFF);
+    cbnz(ARMEmitter::Size::i64Bit, Dst, &NonZero);
+
+    // Only true zeroes, denormals go to SoftFloat
+    cbnz(ARMEmitter::Size::i64Bit, Low, &Fallback);
+    mov(ARMEmitter::Size::i64Bit, High, ARMEmitter::Reg::zr);
+    b(&KeyDone);
+
+    Bind(&NonZero);
+    // Unnormals, infinities and NaNs go to SoftFloat
+    tbz(Low, 63, &Fallback);
+    add(ARMEmitter::Size::i64Bit, High, Dst, 1);
+    tbnz(High, 15, &Fallback);
+    umov<ARMEmitter::SubRegSize::i16Bit>(High, Src, 4);
+    tbz(High, 15, &Positive);
+
+    // Negative, negate the 128-bit key
+    negs(ARMEmitter::Size::i64Bit, Low, Low);
+    ngc(ARMEmitter::Size::i64Bit, Dst, Dst);
+
+    Bind(&Positive);
+    mov(ARMEmitter::Size::i64Bit, High, Dst);
+
+    Bind(&KeyDone);
+  };
+
+  LoadCompareKey(Src1, TMP1, TMP2);
+  LoadCompareKey(Src2, TMP3, TMP4);
+
+  // Canonical values are never unordered, so that flag stays clear
+  mov(ARMEmitter::Size::i64Bit, Dst, ARMEmitter::Reg::zr);
+
+  if (Op->Flags & (1 << IR::FCMP_FLAG_LT)) {
+    cmp(ARMEmitter::Size::i64Bit, TMP1, TMP3);
+    sbcs(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::zr, TMP2, TMP4);
+    cset(ARMEmitter::Size::i64Bit, Dst, ARMEmitter::Condition::CC_LT);
+    if (IR::FCMP_FLAG_LT != 0) {
+      lsl(ARMEmitter::Size::i64Bit, Dst, Dst, IR::FCMP_FLAG_LT);
+    }
+  }
+
+  if (Op->Flags & (1 << IR::FCMP_FLAG_EQ)) {
+    cmp(ARMEmitter::Size::i64Bit, TMP1, TMP3);
+    ccmp(ARMEmitter::Size::i64Bit, TMP2, TMP4, ARMEmitter::StatusFlags::None, ARMEmitter::Condition::CC_EQ);
+    cset(ARMEmitter::Size::i64Bit, TMP1, ARMEmitter::Condition::CC_EQ);
+    orr(ARMEmitter::Size::i64Bit, Dst, Dst, TMP1, ARMEmitter::ShiftType::LSL, IR::FCMP_FLAG_EQ);
+  }
+  b(&Done);
+
+  Bind(&Fallback);
+  Op_Unhandled(IROp, Node);
+
+  Bind(&Done);
+  // Only the fallback path spilled the static registers
+  NextStaticRegsInContext = false;
+}
+
+#undef DEF_OP
+}
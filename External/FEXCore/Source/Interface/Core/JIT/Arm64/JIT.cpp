@@ -17,6 +17,7 @@ $end_info$
 #include "Interface/Core/Dispatcher/Arm64Dispatcher.h"
 #include "Interface/Core/JIT/Arm64/JITClass.h"
 #include "Interface/Core/InternalThreadState.h"
+#include "Interface/Core/ObjectCache/ObjectCacheService.h"
 
 #include "Interface/IR/Passes/RegisterAllocationPass.h"
 
@@ -27,9 +28,11 @@ $end_info$
 #include <FEXCore/Utils/CompilerDefs.h>
 #include <FEXCore/Utils/EnumUtils.h>
 #include <FEXCore/Utils/Profiler.h>
+#include <FEXCore/Utils/Telemetry.h>
 
 #include "Interface/Core/Interpreter/InterpreterOps.h"
 
+#include <bit>
 #include <stdio.h>
 #include <unistd.h>
 #include <string.h>
@@ -81,11 +84,37 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header const *IROp, IR::NodeID Node) {
     LOGMAN_MSG_A_FMT("Unhandled IR Op: {}", FEXCore::IR::GetName(IROp->Op));
 #endif
   } else {
+#ifndef FEX_DISABLE_TELEMETRY
+    static_assert(FEXCore::Core::OPINDEX_MAX <= FEXCore::Telemetry::MAX_FALLBACK_COUNTERS, "Not enough fallback counters");
+
+    // Count the fallback in the per-thread telemetry counters if they exist
+    ARMEmitter::ForwardLabel NoCounters;
+    ldr(TMP1, STATE_PTR(CpuStateFrame, Pointers.Common.TelemetryCounters));
+    cbz(ARMEmitter::Size::i64Bit, TMP1, &NoCounters);
+    ldr(TMP2, TMP1, offsetof(FEXCore::Telemetry::ThreadCounters, Fallbacks[Info.HandlerIndex]));
+    add(ARMEmitter::Size::i64Bit, TMP2, TMP2, 1);
+    str(TMP2, TMP1, offsetof(FEXCore::Telemetry::ThreadCounters, Fallbacks[Info.HandlerIndex]));
+    Bind(&NoCounters);
+#endif
+
+    if (CTX->FallbackProfile) {
+      // Attributed to the guest instruction of the last GuestOpcode, or the block entry without one
+      const uint64_t GuestRIP = Entry + (DebugData->GuestOpcodes.empty() ? 0 : DebugData->GuestOpcodes.back().GuestEntryOffset);
+      auto Counter = CTX->GetFallbackProfileCounter(ThreadState, GuestRIP, Info.HandlerIndex, IROp->Op);
+      LoadConstant(ARMEmitter::Size::i64Bit, TMP1, reinterpret_cast<uint64_t>(Counter));
+      ldr(TMP2, TMP1, 0);
+      add(ARMEmitter::Size::i64Bit, TMP2, TMP2, 1);
+      str(TMP2, TMP1, 0);
+    }
+
+    // A fallback directly after another one finds the context still matching the static registers
+    if (!StaticRegsInContext) {
+      SpillStaticRegs(TMP1);
+    }
+
     switch(Info.ABI) {
       case FABI_VOID_U16:{
-        SpillStaticRegs(TMP1);
-
-        PushDynamicRegsAndLR(TMP1);
+        PushLiveDynamicRegsAndLR(TMP1);
 
         const auto Src1 = GetReg(IROp->Args[0].ID());
         uxth(ARMEmitter::Size::i32Bit, ARMEmitter::Reg::r0, Src1);
@@ -96,16 +125,14 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header const *IROp, IR::NodeID Node) {
         blr(ARMEmitter::Reg::r1);
 #endif
 
-        PopDynamicRegsAndLR();
+        PopLiveDynamicRegsAndLR();
 
         FillStaticRegs();
       }
       break;
 
       case FABI_F80_F32:{
-        SpillStaticRegs(TMP1);
-
-        PushDynamicRegsAndLR(TMP1);
+        PushLiveDynamicRegsAndLR(TMP1);
         const auto Src1 = GetVReg(IROp->Args[0].ID());
         fmov(ARMEmitter::SReg::s0, Src1.S());
         ldr(ARMEmitter::XReg::x0, STATE_PTR(CpuStateFrame, Pointers.Common.FallbackHandlerPointers[Info.HandlerIndex]));
@@ -115,7 +142,7 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header const *IROp, IR::NodeID Node) {
         blr(ARMEmitter::Reg::r0);
 #endif
 
-        PopDynamicRegsAndLR();
+        PopLiveDynamicRegsAndLR();
 
         FillStaticRegs();
 
@@ -127,9 +154,7 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header const *IROp, IR::NodeID Node) {
       break;
 
       case FABI_F80_F64:{
-        SpillStaticRegs(TMP1);
-
-        PushDynamicRegsAndLR(TMP1);
+        PushLiveDynamicRegsAndLR(TMP1);
 
         const auto Src1 = GetVReg(IROp->Args[0].ID());
         mov(ARMEmitter::DReg::d0, Src1.D());
@@ -140,7 +165,7 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header const *IROp, IR::NodeID Node) {
         blr(ARMEmitter::Reg::r0);
 #endif
 
-        PopDynamicRegsAndLR();
+        PopLiveDynamicRegsAndLR();
 
         FillStaticRegs();
 
@@ -153,9 +178,7 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header const *IROp, IR::NodeID Node) {
 
       case FABI_F80_I16:
       case FABI_F80_I32: {
-        SpillStaticRegs(TMP1);
-
-        PushDynamicRegsAndLR(TMP1);
+        PushLiveDynamicRegsAndLR(TMP1);
 
         const auto Src1 = GetReg(IROp->Args[0].ID());
         if (Info.ABI == FABI_F80_I16) {
@@ -171,7 +194,7 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header const *IROp, IR::NodeID Node) {
         blr(ARMEmitter::Reg::r1);
 #endif
 
-        PopDynamicRegsAndLR();
+        PopLiveDynamicRegsAndLR();
 
         FillStaticRegs();
 
@@ -183,9 +206,7 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header const *IROp, IR::NodeID Node) {
       break;
 
       case FABI_F32_F80:{
-        SpillStaticRegs(TMP1);
-
-        PushDynamicRegsAndLR(TMP1);
+        PushLiveDynamicRegsAndLR(TMP1);
 
         const auto Src1 = GetVReg(IROp->Args[0].ID());
 
@@ -199,7 +220,7 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header const *IROp, IR::NodeID Node) {
         blr(ARMEmitter::Reg::r2);
 #endif
 
-        PopDynamicRegsAndLR();
+        PopLiveDynamicRegsAndLR();
 
         FillStaticRegs();
 
@@ -209,9 +230,7 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header const *IROp, IR::NodeID Node) {
       break;
 
       case FABI_F64_F80:{
-        SpillStaticRegs(TMP1);
-
-        PushDynamicRegsAndLR(TMP1);
+        PushLiveDynamicRegsAndLR(TMP1);
 
         const auto Src1 = GetVReg(IROp->Args[0].ID());
 
@@ -225,7 +244,7 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header const *IROp, IR::NodeID Node) {
         blr(ARMEmitter::Reg::r2);
 #endif
 
-        PopDynamicRegsAndLR();
+        PopLiveDynamicRegsAndLR();
 
         FillStaticRegs();
 
@@ -235,9 +254,7 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header const *IROp, IR::NodeID Node) {
       break;
 
       case FABI_F64_F64: {
-        SpillStaticRegs(TMP1);
-
-        PushDynamicRegsAndLR(TMP1);
+        PushLiveDynamicRegsAndLR(TMP1);
 
         const auto Src1 = GetVReg(IROp->Args[0].ID());
 
@@ -249,7 +266,7 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header const *IROp, IR::NodeID Node) {
         blr(ARMEmitter::Reg::r0);
 #endif
 
-        PopDynamicRegsAndLR();
+        PopLiveDynamicRegsAndLR();
 
         FillStaticRegs();
 
@@ -259,9 +276,7 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header const *IROp, IR::NodeID Node) {
       break;
 
       case FABI_F64_F64_F64: {
-        SpillStaticRegs(TMP1);
-
-        PushDynamicRegsAndLR(TMP1);
+        PushLiveDynamicRegsAndLR(TMP1);
 
         const auto Src1 = GetVReg(IROp->Args[0].ID());
         const auto Src2 = GetVReg(IROp->Args[1].ID());
@@ -275,7 +290,7 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header const *IROp, IR::NodeID Node) {
         blr(ARMEmitter::Reg::r0);
 #endif
 
-        PopDynamicRegsAndLR();
+        PopLiveDynamicRegsAndLR();
 
         FillStaticRegs();
 
@@ -285,9 +300,7 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header const *IROp, IR::NodeID Node) {
       break;
 
       case FABI_I16_F80:{
-        SpillStaticRegs(TMP1);
-
-        PushDynamicRegsAndLR(TMP1);
+        PushLiveDynamicRegsAndLR(TMP1);
 
         const auto Src1 = GetVReg(IROp->Args[0].ID());
 
@@ -301,7 +314,7 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header const *IROp, IR::NodeID Node) {
         blr(ARMEmitter::Reg::r2);
 #endif
 
-        PopDynamicRegsAndLR();
+        PopLiveDynamicRegsAndLR();
 
         FillStaticRegs();
 
@@ -310,9 +323,7 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header const *IROp, IR::NodeID Node) {
       }
       break;
       case FABI_I32_F80:{
-        SpillStaticRegs(TMP1);
-
-        PushDynamicRegsAndLR(TMP1);
+        PushLiveDynamicRegsAndLR(TMP1);
 
         const auto Src1 = GetVReg(IROp->Args[0].ID());
 
@@ -326,7 +337,7 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header const *IROp, IR::NodeID Node) {
         blr(ARMEmitter::Reg::r2);
 #endif
 
-        PopDynamicRegsAndLR();
+        PopLiveDynamicRegsAndLR();
 
         FillStaticRegs();
 
@@ -335,9 +346,7 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header const *IROp, IR::NodeID Node) {
       }
       break;
       case FABI_I64_F80:{
-        SpillStaticRegs(TMP1);
-
-        PushDynamicRegsAndLR(TMP1);
+        PushLiveDynamicRegsAndLR(TMP1);
 
         const auto Src1 = GetVReg(IROp->Args[0].ID());
 
@@ -351,7 +360,7 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header const *IROp, IR::NodeID Node) {
         blr(ARMEmitter::Reg::r2);
 #endif
 
-        PopDynamicRegsAndLR();
+        PopLiveDynamicRegsAndLR();
 
         FillStaticRegs();
 
@@ -360,9 +369,7 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header const *IROp, IR::NodeID Node) {
       }
       break;
       case FABI_I64_F80_F80:{
-        SpillStaticRegs(TMP1);
-
-        PushDynamicRegsAndLR(TMP1);
+        PushLiveDynamicRegsAndLR(TMP1);
 
         const auto Src1 = GetVReg(IROp->Args[0].ID());
         const auto Src2 = GetVReg(IROp->Args[1].ID());
@@ -379,7 +386,7 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header const *IROp, IR::NodeID Node) {
 #else
         blr(ARMEmitter::Reg::r4);
 #endif
-        PopDynamicRegsAndLR();
+        PopLiveDynamicRegsAndLR();
 
         FillStaticRegs();
 
@@ -388,9 +395,7 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header const *IROp, IR::NodeID Node) {
       }
       break;
       case FABI_F80_F80:{
-        SpillStaticRegs(TMP1);
-
-        PushDynamicRegsAndLR(TMP1);
+        PushLiveDynamicRegsAndLR(TMP1);
 
         const auto Src1 = GetVReg(IROp->Args[0].ID());
 
@@ -404,7 +409,7 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header const *IROp, IR::NodeID Node) {
         blr(ARMEmitter::Reg::r2);
 #endif
 
-        PopDynamicRegsAndLR();
+        PopLiveDynamicRegsAndLR();
 
         FillStaticRegs();
 
@@ -415,9 +420,7 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header const *IROp, IR::NodeID Node) {
       }
       break;
       case FABI_F80_F80_F80:{
-        SpillStaticRegs(TMP1);
-
-        PushDynamicRegsAndLR(TMP1);
+        PushLiveDynamicRegsAndLR(TMP1);
 
         const auto Src1 = GetVReg(IROp->Args[0].ID());
         const auto Src2 = GetVReg(IROp->Args[1].ID());
@@ -435,7 +438,7 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header const *IROp, IR::NodeID Node) {
         blr(ARMEmitter::Reg::r4);
 #endif
 
-        PopDynamicRegsAndLR();
+        PopLiveDynamicRegsAndLR();
 
         FillStaticRegs();
 
@@ -446,8 +449,7 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header const *IROp, IR::NodeID Node) {
       }
       break;
       case FABI_I32_I64_I64_I128_I128_I16: {
-        SpillStaticRegs(TMP1);
-        PushDynamicRegsAndLR(TMP1);
+        PushLiveDynamicRegsAndLR(TMP1);
 
         const auto Op = IROp->C<IR::IROp_VPCMPESTRX>();
         const auto Control = Op->Control;
@@ -475,7 +477,7 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header const *IROp, IR::NodeID Node) {
         blr(ARMEmitter::Reg::r7);
 #endif
 
-        PopDynamicRegsAndLR();
+        PopLiveDynamicRegsAndLR();
         FillStaticRegs();
 
         const auto Dst = GetReg(Node);
@@ -483,8 +485,7 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header const *IROp, IR::NodeID Node) {
         break;
       }
       case FABI_I32_I128_I128_I16: {
-        SpillStaticRegs(TMP1);
-        PushDynamicRegsAndLR(TMP1);
+        PushLiveDynamicRegsAndLR(TMP1);
 
         const auto Op = IROp->C<IR::IROp_VPCMPISTRX>();
 
@@ -507,7 +508,7 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header const *IROp, IR::NodeID Node) {
         blr(ARMEmitter::Reg::r5);
 #endif
 
-        PopDynamicRegsAndLR();
+        PopLiveDynamicRegsAndLR();
         FillStaticRegs();
 
         const auto Dst = GetReg(Node);
@@ -522,10 +523,40 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header const *IROp, IR::NodeID Node) {
 #endif
       break;
     }
+
+    // Handlers never touch the guest state, the context is only stale if the result went in to a static register
+    const auto Result = RAData->GetNodeRegister(Node);
+    NextStaticRegsInContext = Result.Class != IR::GPRFixedClass.Val && Result.Class != IR::FPRFixedClass.Val;
   }
 }
 
 
+// Emits a veneer that jumps to `Target`, in direct branch range of `Stub`. Returns 0 if there is no room for one.
+// Targets within +-4GB are reached without loading from memory.
+static uintptr_t EmitFarVeneer(FEXCore::CPU::CPUBackend *Backend, uintptr_t Stub, uintptr_t Target) {
+  constexpr size_t VeneerSize = 16;
+  auto Veneer = Backend->AllocateVeneer(Stub, VeneerSize);
+  if (!Veneer) {
+    return 0;
+  }
+
+  FEXCore::ARMEmitter::Emitter emit(Veneer, VeneerSize);
+  const int64_t PageOffset = static_cast<int64_t>(Target >> 12) - static_cast<int64_t>(reinterpret_cast<uintptr_t>(Veneer) >> 12);
+  if (vixl::IsInt21(PageOffset)) {
+    emit.adrp(FEXCore::ARMEmitter::Reg::r0, static_cast<uint32_t>(PageOffset));
+    emit.add(FEXCore::ARMEmitter::Size::i64Bit, FEXCore::ARMEmitter::Reg::r0, FEXCore::ARMEmitter::Reg::r0, Target & 0xFFF);
+    emit.br(FEXCore::ARMEmitter::Reg::r0);
+  }
+  else {
+    emit.ldr(FEXCore::ARMEmitter::XReg::x0, 8);
+    emit.br(FEXCore::ARMEmitter::Reg::r0);
+    emit.dc64(Target);
+  }
+  FEXCore::ARMEmitter::Emitter::ClearICache(Veneer, VeneerSize);
+
+  return reinterpret_cast<uintptr_t>(Veneer);
+}
+
 static uint64_t Arm64JITCore_ExitFunctionLink(FEXCore::Core::CpuStateFrame *Frame, uint64_t *record) {
   auto Thread = Frame->Thread;
   auto GuestRip = record[1];
@@ -540,7 +571,35 @@ static uint64_t Arm64JITCore_ExitFunctionLink(FEXCore::Core::CpuStateFrame *Fram
   uintptr_t branch = (uintptr_t)(record) - 8;
   auto LinkerAddress = Frame->Pointers.Common.ExitFunctionLinker;
 
+  // record[2] is the distance back to the conditional branch that targets this exit, if it is the only one.
+  // Retarget it directly at the block, the exit stub stays the trampoline for targets beyond +-1MB.
+  if (record[2]) {
+    const uintptr_t CondBranch = (uintptr_t)(record) - record[2];
+    const auto CondOffset = HostCode/4 - CondBranch/4;
+    if (vixl::IsInt19(CondOffset)) {
+      auto Inst = reinterpret_cast<uint32_t*>(CondBranch);
+      *Inst = (*Inst & ~(0x7'FFFFU << 5)) | ((CondOffset & 0x7'FFFF) << 5);
+      FEXCore::ARMEmitter::Emitter::ClearICache(Inst, 4);
+
+      // Point it back at the exit stub
+      Thread->LookupCache->AddBlockLink(GuestRip, CondBranch, [](uintptr_t HostLink, uintptr_t Stub) {
+        auto Inst = reinterpret_cast<uint32_t*>(HostLink);
+        const auto Offset = Stub/4 - HostLink/4;
+        *Inst = (*Inst & ~(0x7'FFFFU << 5)) | ((Offset & 0x7'FFFF) << 5);
+        return FEXCore::BlockDelinkedRange{HostLink, 4};
+      }, branch);
+    }
+  }
+
   auto offset = HostCode/4 - branch/4;
+  if (!vixl::IsInt26(offset)) {
+    // Far target, such as a block in the other of the hot and cold code buffers.
+    // Branch directly to a veneer after the end of this code buffer instead.
+    if (auto Veneer = EmitFarVeneer(Thread->CPUBackend.get(), branch, HostCode)) {
+      offset = Veneer/4 - branch/4;
+    }
+  }
+
   if (vixl::IsInt26(offset)) {
     // optimal case - can branch directly
     // patch the code
@@ -549,23 +608,25 @@ static uint64_t Arm64JITCore_ExitFunctionLink(FEXCore::Core::CpuStateFrame *Fram
     FEXCore::ARMEmitter::Emitter::ClearICache((void*)branch, 24);
 
     // Add de-linking handler
-    Thread->LookupCache->AddBlockLink(GuestRip, (uintptr_t)record, [branch, LinkerAddress]{
+    Thread->LookupCache->AddBlockLink(GuestRip, (uintptr_t)record, [](uintptr_t HostLink, uintptr_t Linker) {
+      uintptr_t branch = HostLink - 8;
       FEXCore::ARMEmitter::Emitter emit((uint8_t*)(branch), 24);
       FEXCore::ARMEmitter::ForwardLabel l_BranchHost;
       emit.ldr(FEXCore::ARMEmitter::XReg::x0, &l_BranchHost);
       emit.blr(FEXCore::ARMEmitter::Reg::r0);
       emit.Bind(&l_BranchHost);
-      emit.dc64(LinkerAddress);
-      FEXCore::ARMEmitter::Emitter::ClearICache((void*)branch, 24);
-    });
+      emit.dc64(Linker);
+      return FEXCore::BlockDelinkedRange{branch, 24};
+    }, LinkerAddress);
   } else {
     // fallback case - do a soft-er link by patching the pointer
     record[0] = HostCode;
 
     // Add de-linking handler
-    Thread->LookupCache->AddBlockLink(GuestRip, (uintptr_t)record, [record, LinkerAddress]{
-      record[0] = LinkerAddress;
-    });
+    Thread->LookupCache->AddBlockLink(GuestRip, (uintptr_t)record, [](uintptr_t HostLink, uintptr_t Linker) {
+      reinterpret_cast<uint64_t*>(HostLink)[0] = Linker;
+      return FEXCore::BlockDelinkedRange{};
+    }, LinkerAddress);
   }
 
   return HostCode;
@@ -578,23 +639,33 @@ Arm64JITCore::Arm64JITCore(FEXCore::Context::ContextImpl *ctx, FEXCore::Core::In
   : CPUBackend(Thread, INITIAL_CODE_SIZE, MAX_CODE_SIZE)
   , Arm64Emitter(ctx, 0)
   , HostSupportsSVE128{ctx->HostFeatures.SupportsSVE}
-  , HostSupportsSVE256{ctx->HostFeatures.SupportsAVX}
+  , HostSupportsSVE256{ctx->HostFeatures.SupportsSVE256}
+  , HostSupportsSVE2{ctx->HostFeatures.SupportsSVE2}
+  , HostSupportsSVEBitPerm{ctx->HostFeatures.SupportsSVEBitPerm}
+  , HostSupportsAVX{ctx->HostFeatures.SupportsAVX}
   , CTX {ctx} {
 
   RAPass = Thread->PassManager->GetPass<IR::RegisterAllocationPass>("RA");
 
-  RAPass->AllocateRegisterSet(RegisterClasses);
+  const auto SetupRegisterSet = [this](IR::RegisterAllocationPass *Pass) {
+    Pass->AllocateRegisterSet(RegisterClasses);
 
-  RAPass->AddRegisters(FEXCore::IR::GPRClass, GeneralRegisters.size());
-  RAPass->AddRegisters(FEXCore::IR::GPRFixedClass, StaticRegisters.size());
-  RAPass->AddRegisters(FEXCore::IR::FPRClass, GeneralFPRegisters.size());
-  RAPass->AddRegisters(FEXCore::IR::FPRFixedClass, StaticFPRegisters.size());
-  RAPass->AddRegisters(FEXCore::IR::GPRPairClass, GeneralPairRegisters.size());
-  RAPass->AddRegisters(FEXCore::IR::ComplexClass, 1);
+    Pass->AddRegisters(FEXCore::IR::GPRClass, GeneralRegisters.size());
+    Pass->AddRegisters(FEXCore::IR::GPRFixedClass, StaticRegisters.size());
+    Pass->AddRegisters(FEXCore::IR::FPRClass, GeneralFPRegisters.size());
+    Pass->AddRegisters(FEXCore::IR::FPRFixedClass, StaticFPRegisters.size());
+    Pass->AddRegisters(FEXCore::IR::GPRPairClass, GeneralPairRegisters.size());
+    Pass->AddRegisters(FEXCore::IR::ComplexClass, 1);
 
-  for (uint32_t i = 0; i < GeneralPairRegisters.size(); ++i) {
-    RAPass->AddRegisterConflict(FEXCore::IR::GPRClass, i * 2,     FEXCore::IR::GPRPairClass, i);
-    RAPass->AddRegisterConflict(FEXCore::IR::GPRClass, i * 2 + 1, FEXCore::IR::GPRPairClass, i);
+    for (uint32_t i = 0; i < GeneralPairRegisters.size(); ++i) {
+      Pass->AddRegisterConflict(FEXCore::IR::GPRClass, i * 2,     FEXCore::IR::GPRPairClass, i);
+      Pass->AddRegisterConflict(FEXCore::IR::GPRClass, i * 2 + 1, FEXCore::IR::GPRPairClass, i);
+    }
+  };
+
+  SetupRegisterSet(RAPass);
+  if (Thread->Tier0PassManager) {
+    SetupRegisterSet(Thread->Tier0PassManager->GetPass<IR::RegisterAllocationPass>("RA"));
   }
 
   {
@@ -665,11 +736,98 @@ void Arm64JITCore::EmitDetectionString() {
 }
 
 void Arm64JITCore::ClearCache() {
-  // Get the backing code buffer
+  auto ArenaLock = ClaimSharedCodeArena();
 
+  // Get the backing code buffer
   auto CodeBuffer = GetEmptyCodeBuffer();
   SetBuffer(CodeBuffer->Ptr, CodeBuffer->Size);
+  if (ArenaLock.owns_lock()) {
+    // Other threads may have already emitted code in to the shared arena
+    SetCursorOffset(SharedArena->Offset);
+  }
+  EmitDetectionString();
+  CodeRegionBase = GetCursorOffset();
+  RegionEviction.Reset();
+  ReleaseSharedCodeArena(GetCursorOffset());
+
+  if (ThreadState->CurrentFrame->SignalHandlerRefCounter == 0) {
+    // Nothing can be running from the hot buffer, the lookup cache no longer refers to it
+    HotCodeOffset = 0;
+  }
+}
+
+void Arm64JITCore::SealCodeBuffer() {
+  auto ArenaLock = ClaimSharedCodeArena();
+
+  auto CodeBuffer = GetFreshCodeBuffer();
+  SetBuffer(CodeBuffer->Ptr, CodeBuffer->Size);
   EmitDetectionString();
+  CodeRegionBase = GetCursorOffset();
+  RegionEviction.Reset();
+  ReleaseSharedCodeArena(GetCursorOffset());
+}
+
+bool Arm64JITCore::ReserveHotCodeSpace(size_t Size) {
+  auto HotBuffer = GetHotCodeBuffer();
+  if (!HotBuffer) {
+    return false;
+  }
+
+  if ((HotCodeOffset + Size) <= HotBuffer->Size) {
+    return true;
+  }
+
+  // Signal handler code might be running from the hot buffer, it can't be reused until the handlers return
+  if (ThreadState->CurrentFrame->SignalHandlerRefCounter != 0 || Size > HotBuffer->Size) {
+    return false;
+  }
+
+  if (CTX->Config.JITCodeEviction) {
+    const auto BufferBegin = reinterpret_cast<uintptr_t>(HotBuffer->Ptr);
+    CTX->EvictCodeRange(ThreadState, BufferBegin, BufferBegin + HotBuffer->Size);
+    HotCodeOffset = 0;
+  }
+  else {
+    // Resets HotCodeOffset
+    CTX->ClearCodeCache(ThreadState);
+  }
+  return true;
+}
+
+void Arm64JITCore::ReserveCodeSpace(size_t Size) {
+  const size_t Offset = GetCursorOffset();
+
+  if (SharedArena || !CTX->Config.JITCodeEviction || CurrentCodeBuffer->Size != MaxCodeSize) {
+    if ((Offset + Size) > CurrentCodeBuffer->Size) {
+      CTX->ClearCodeCache(ThreadState);
+    }
+    return;
+  }
+
+  // Blocks don't cross in to the next region so each region can be evicted on its own
+  const size_t RegionSize = CurrentCodeBuffer->Size / CODE_REGION_COUNT;
+  const size_t Region = (Offset - 1) / RegionSize;
+  if ((Offset + Size) <= (Region + 1) * RegionSize) {
+    return;
+  }
+
+  // Regions that haven't been filled yet are picked first, after that the coldest one is reused
+  const auto BufferBegin = reinterpret_cast<uintptr_t>(CurrentCodeBuffer->Ptr);
+  std::array<uint64_t, CODE_REGION_COUNT> Heat;
+  CTX->GetCodeRegionHeat(ThreadState, BufferBegin, RegionSize, Heat);
+  const size_t Victim = RegionEviction.Pick(Heat);
+  const size_t VictimBegin = Victim == 0 ? CodeRegionBase : Victim * RegionSize;
+  const size_t VictimEnd = (Victim + 1) * RegionSize;
+
+  // Code from signal handlers might be running from the region, and oversized blocks need the whole buffer
+  if (ThreadState->CurrentFrame->SignalHandlerRefCounter != 0 || (VictimBegin + Size) > VictimEnd) {
+    CTX->ClearCodeCache(ThreadState);
+    return;
+  }
+
+  CTX->EvictCodeRange(ThreadState, BufferBegin + VictimBegin, BufferBegin + VictimEnd);
+  RegionEviction.Filled(Victim);
+  SetCursorOffset(VictimBegin);
 }
 
 Arm64JITCore::~Arm64JITCore() {
@@ -731,25 +889,140 @@ bool Arm64JITCore::IsGPRPair(IR::NodeID Node) const {
   return Class == IR::GPRPairClass;
 }
 
+void Arm64JITCore::CalculateCallLiveness() {
+  using namespace FEXCore::IR;
+  constexpr NodeID UsedOutsideBlock{UINT32_MAX};
+
+  const auto SSACount = IR->GetSSACount();
+  fextl::vector<NodeID> DefiningBlock(SSACount);
+  LastLocalUse.assign(SSACount, NodeID{});
+  GlobalLiveGPRs = 0;
+  GlobalLiveFPRs = 0;
+
+  for (auto [BlockNode, BlockHeader] : IR->GetBlocks()) {
+    const auto BlockID = IR->GetID(BlockNode);
+    for (auto [CodeNode, IROp] : IR->GetCode(BlockNode)) {
+      DefiningBlock[IR->GetID(CodeNode).Value] = BlockID;
+    }
+  }
+
+  for (auto [BlockNode, BlockHeader] : IR->GetBlocks()) {
+    const auto BlockID = IR->GetID(BlockNode);
+    for (auto [CodeNode, IROp] : IR->GetCode(BlockNode)) {
+      const auto Node = IR->GetID(CodeNode);
+
+      if (IROp->Op == OP_PHI || IROp->Op == OP_PHIVALUE) {
+        // Phi partners share registers across blocks, don't try to follow them
+        GlobalLiveGPRs = ~0U;
+        GlobalLiveFPRs = ~0U;
+        continue;
+      }
+
+      // FillRegister's SSA arg is only there for verification, same as in RA
+      if (IROp->Op == OP_FILLREGISTER) {
+        continue;
+      }
+
+      const uint8_t NumArgs = IR::GetRAArgs(IROp->Op);
+      for (uint8_t i = 0; i < NumArgs; ++i) {
+        const auto& Arg = IROp->Args[i];
+        if (Arg.IsInvalid()) {
+          continue;
+        }
+
+        const auto ArgNode = Arg.ID();
+        auto &LastUse = LastLocalUse[ArgNode.Value];
+        if (LastUse == UsedOutsideBlock) {
+          continue;
+        }
+
+        if (DefiningBlock[ArgNode.Value] != BlockID || ArgNode >= Node) {
+          LastUse = UsedOutsideBlock;
+          AddHostRegisters(ArgNode, &GlobalLiveGPRs, &GlobalLiveFPRs);
+        }
+        else {
+          LastUse = std::max(LastUse, Node);
+        }
+      }
+    }
+  }
+}
+
+void Arm64JITCore::AddHostRegisters(IR::NodeID Node, uint32_t *GPRs, uint32_t *FPRs) const {
+  // Inline constants and ops without a destination don't have a register
+  const auto Reg = RAData->GetNodeRegister(Node);
+  if (Reg.IsInvalid()) {
+    return;
+  }
+
+  if (Reg.Class == IR::GPRClass.Val) {
+    *GPRs |= 1U << GeneralRegisters[Reg.Reg].Idx();
+  } else if (Reg.Class == IR::GPRPairClass.Val) {
+    *GPRs |= 1U << GeneralPairRegisters[Reg.Reg].first.Idx();
+    *GPRs |= 1U << GeneralPairRegisters[Reg.Reg].second.Idx();
+  } else if (Reg.Class == IR::FPRClass.Val) {
+    *FPRs |= 1U << GeneralFPRegisters[Reg.Reg].Idx();
+  }
+}
+
+std::pair<uint32_t, uint32_t> Arm64JITCore::LiveDynamicRegisters() const {
+  // A value last used by the current op is read before the call and its result is written after it
+  uint32_t GPRs = GlobalLiveGPRs;
+  uint32_t FPRs = GlobalLiveFPRs;
+  for (size_t i = 0; i < GPRLiveUntil.size(); ++i) {
+    if (GPRLiveUntil[i] > CurrentNode) {
+      GPRs |= 1U << i;
+    }
+    if (FPRLiveUntil[i] > CurrentNode) {
+      FPRs |= 1U << i;
+    }
+  }
+  return {GPRs, FPRs};
+}
+
 CPUBackend::CompiledCode Arm64JITCore::CompileCode(uint64_t Entry,
                                 FEXCore::IR::IRListView const *IR,
                                 FEXCore::Core::DebugData *DebugData,
                                 FEXCore::IR::RegisterAllocationData *RAData,
-                                bool GDBEnabled) {
+                                bool GDBEnabled,
+                                bool HotBlock) {
   FEXCORE_PROFILE_SCOPED("Arm64::CompileCode");
 
   JumpTargets.clear();
+  CondBranchToBlock.clear();
+  ConstantPool.clear();
   uint32_t SSACount = IR->GetSSACount();
 
+  // The pool goes after all of the code, keep well inside of the +-1MB literal load range
+  UseConstantPool = SSACount < 16384;
+
   this->Entry = Entry;
   this->RAData = RAData;
   this->DebugData = DebugData;
   this->IR = IR;
 
+  // Emission in to a shared code arena is serialized between threads.
+  // Another thread may have appended to or replaced the arena since this thread last compiled.
+  auto ArenaLock = ClaimSharedCodeArena();
+  if (ArenaLock.owns_lock()) {
+    SetBuffer(CurrentCodeBuffer->Ptr, CurrentCodeBuffer->Size);
+    SetCursorOffset(SharedArena->Offset);
+  }
+
   // Fairly excessive buffer range to make sure we don't overflow
-  uint32_t BufferRange = SSACount * 16 + GDBEnabled * Dispatcher::MaxGDBPauseCheckSize;
-  if ((GetCursorOffset() + BufferRange) > CurrentCodeBuffer->Size) {
-    CTX->ClearCodeCache(ThreadState);
+  uint32_t BufferRange = SSACount * 16 + GDBEnabled * Dispatcher::MaxGDBPauseCheckSize + CTX->Config.Safepoints * MaxSafepointCheckSize;
+
+  // Hot blocks are packed in their own buffer, away from code that only ran a few times
+  const bool UseHotBuffer = HotBlock && ReserveHotCodeSpace(BufferRange);
+  size_t ColdCodeOffset{};
+  if (UseHotBuffer) {
+    ColdCodeOffset = GetCursorOffset();
+    auto HotBuffer = GetHotCodeBuffer();
+    SetBuffer(HotBuffer->Ptr, HotBuffer->Size);
+    SetCursorOffset(HotCodeOffset);
+  }
+  else {
+    ReserveCodeSpace(BufferRange);
   }
 
   CodeData.BlockBegin = GetCursorAddress<uint8_t*>();
@@ -796,10 +1069,22 @@ CPUBackend::CompiledCode Arm64JITCore::CompileCode(uint64_t Entry,
                                     offsetof(FEXCore::Core::InternalThreadState, BaseFrameState));
 
   if (GDBEnabled) {
-    auto GDBSize = CTX->Dispatcher->GenerateGDBPauseCheck(CodeData.BlockEntry, Entry);
+    auto GDBSize = CTX->Dispatcher->GenerateGDBPauseCheck(CodeData.BlockEntry, Entry, CTX->IsGdbBreakpoint(Entry));
     CursorIncrement(GDBSize);
   }
 
+  if (CTX->Config.Safepoints) {
+    // Cooperative pause point, see ContextImpl::NotifyPause
+    ARMEmitter::ForwardLabel RunBlock;
+    ldr(TMP1.W(), STATE, offsetof(FEXCore::Core::CpuStateFrame, SafepointRequested));
+    cbz(ARMEmitter::Size::i32Bit, TMP1, &RunBlock);
+    LoadConstant(ARMEmitter::Size::i64Bit, TMP1, Entry);
+    str(TMP1, STATE, offsetof(FEXCore::Core::CpuStateFrame, State.rip));
+    ldr(TMP1, STATE_PTR(CpuStateFrame, Pointers.Common.SafepointHandlerSpillSRA));
+    br(TMP1);
+    Bind(&RunBlock);
+  }
+
   //LOGMAN_THROW_A_FMT(RAData->HasFullRA(), "Arm64 JIT only works with RA");
 
   SpillSlots = RAData->SpillSlots();
@@ -817,6 +1102,8 @@ CPUBackend::CompiledCode Arm64JITCore::CompileCode(uint64_t Entry,
 
   PendingTargetLabel = nullptr;
 
+  CalculateCallLiveness();
+
   for (auto [BlockNode, BlockHeader] : IR->GetBlocks()) {
     using namespace FEXCore::IR;
 #if defined(ASSERTIONS_ENABLED) && ASSERTIONS_ENABLED
@@ -837,10 +1124,18 @@ CPUBackend::CompiledCode Arm64JITCore::CompileCode(uint64_t Entry,
       PendingTargetLabel = nullptr;
 
       Bind(&IsTarget->second);
+      LoadBarrierEnd = nullptr;
+      CurrentBlockID = Node;
+      CurrentBlockStart = GetCursorAddress<uint8_t *>();
     }
 
+    NextStaticRegsInContext = false;
+    GPRLiveUntil.fill(IR::NodeID{});
+    FPRLiveUntil.fill(IR::NodeID{});
     for (auto [CodeNode, IROp] : IR->GetCode(BlockNode)) {
       const auto ID = IR->GetID(CodeNode);
+      StaticRegsInContext = std::exchange(NextStaticRegsInContext, false);
+      CurrentNode = ID;
       switch (IROp->Op) {
 #define REGISTER_OP_RT(op, x) case FEXCore::IR::IROps::OP_##op: std::invoke(RT_##x, this, IROp, ID); break
 #define REGISTER_OP(op, x) case FEXCore::IR::IROps::OP_##op: Op_##x(IROp, ID); break
@@ -853,6 +1148,10 @@ CPUBackend::CompiledCode Arm64JITCore::CompileCode(uint64_t Entry,
         REGISTER_OP(CYCLECOUNTER,      CycleCounter);
         REGISTER_OP(ADD,               Add);
         REGISTER_OP(TESTNZ,            TestNZ);
+        REGISTER_OP(ADDNZCV,           AddNZCV);
+        REGISTER_OP(SUBNZCV,           SubNZCV);
+        REGISTER_OP(ADCNZCV,           AdcNZCV);
+        REGISTER_OP(SBBNZCV,           SbbNZCV);
         REGISTER_OP(SUB,               Sub);
         REGISTER_OP(NEG,               Neg);
         REGISTER_OP(ABS,               Abs);
@@ -916,6 +1215,8 @@ CPUBackend::CompiledCode Arm64JITCore::CompileCode(uint64_t Entry,
         // Branch ops
         REGISTER_OP(CALLBACKRETURN,    CallbackReturn);
         REGISTER_OP(EXITFUNCTION,      ExitFunction);
+        REGISTER_OP(PUSHRETURNSTACK,   PushReturnStack);
+        REGISTER_OP(RETURNSTACKLOOKUP, ReturnStackLookup);
         REGISTER_OP(JUMP,              Jump);
         REGISTER_OP(CONDJUMP,          CondJump);
         REGISTER_OP(SYSCALL,           Syscall);
@@ -948,6 +1249,12 @@ CPUBackend::CompiledCode Arm64JITCore::CompileCode(uint64_t Entry,
         REGISTER_OP(CRC32,             CRC32);
         REGISTER_OP(PCLMUL,            PCLMUL);
 
+        // F80 ops
+        REGISTER_OP(F80CVTTO,          F80CVTTo);
+        REGISTER_OP(F80CVT,            F80CVT);
+        REGISTER_OP(F80CVTTOINT,       F80CVTToInt);
+        REGISTER_OP(F80CMP,            F80Cmp);
+
         // Flag ops
         REGISTER_OP(GETHOSTFLAG, GetHostFlag);
 
@@ -966,11 +1273,15 @@ CPUBackend::CompiledCode Arm64JITCore::CompileCode(uint64_t Entry,
         REGISTER_OP(STOREMEM,            StoreMem);
         REGISTER_OP_RT(LOADMEMTSO,       LoadMemTSO);
         REGISTER_OP_RT(STOREMEMTSO,      StoreMemTSO);
+        REGISTER_OP(STOREMEMPAIR,        StoreMemPair);
         REGISTER_OP(VLOADVECTORMASKED,   VLoadVectorMasked);
         REGISTER_OP(VSTOREVECTORMASKED,  VStoreVectorMasked);
+        REGISTER_OP(VGATHER,             VGather);
 
         REGISTER_OP(MEMSET,              MemSet);
         REGISTER_OP(MEMCPY,              MemCpy);
+        REGISTER_OP(MEMSCAN,             MemScan);
+        REGISTER_OP(MEMCMP,              MemCmp);
         REGISTER_OP(CACHELINECLEAR,      CacheLineClear);
         REGISTER_OP(CACHELINECLEAN,      CacheLineClean);
         REGISTER_OP(CACHELINEZERO,       CacheLineZero);
@@ -993,6 +1304,7 @@ CPUBackend::CompiledCode Arm64JITCore::CompileCode(uint64_t Entry,
         REGISTER_OP(PROCESSORID,   ProcessorID);
         REGISTER_OP(RDRAND, RDRAND);
         REGISTER_OP(YIELD, Yield);
+        REGISTER_OP(SPINWAIT, SpinWait);
 
         // Move ops
         REGISTER_OP(EXTRACTELEMENTPAIR, ExtractElementPair);
@@ -1086,12 +1398,27 @@ CPUBackend::CompiledCode Arm64JITCore::CompileCode(uint64_t Entry,
         REGISTER_OP(VUABDL2,           VUABDL2);
         REGISTER_OP(VTBL1,             VTBL1);
         REGISTER_OP(VREV64,            VRev64);
+        REGISTER_OP(VPCMPESTRX,        VPCMPESTRX);
+        REGISTER_OP(VPCMPISTRX,        VPCMPISTRX);
 #undef REGISTER_OP
 
         default:
           Op_Unhandled(IROp, ID);
           break;
       }
+
+      // The result stays live until its last use in this block
+      const auto LastUse = LastLocalUse[ID.Value];
+      if (LastUse > ID && LastUse.Value != UINT32_MAX) {
+        uint32_t GPRs{}, FPRs{};
+        AddHostRegisters(ID, &GPRs, &FPRs);
+        for (; GPRs; GPRs &= GPRs - 1) {
+          GPRLiveUntil[std::countr_zero(GPRs)] = LastUse;
+        }
+        for (; FPRs; FPRs &= FPRs - 1) {
+          FPRLiveUntil[std::countr_zero(FPRs)] = LastUse;
+        }
+      }
     }
 
     if (DebugData) {
@@ -1109,9 +1436,11 @@ CPUBackend::CompiledCode Arm64JITCore::CompileCode(uint64_t Entry,
   }
   PendingTargetLabel = nullptr;
 
-  // CodeSize not including the tail data.
+  // CodeSize not including the constant pool or tail data.
   const uint64_t CodeOnlySize = GetCursorAddress<uint8_t *>() - CodeData.BlockBegin;
 
+  EmitConstantPool();
+
   // Add the JitCodeTail
   auto JITBlockTailLocation = GetCursorAddress<uint8_t *>();
   auto JITBlockTail = GetCursorAddress<JITCodeTail*>();
@@ -1152,6 +1481,13 @@ CPUBackend::CompiledCode Arm64JITCore::CompileCode(uint64_t Entry,
 
   ClearICache(CodeData.BlockBegin, CodeOnlySize);
 
+  if (UseHotBuffer) {
+    HotCodeOffset = GetCursorOffset();
+    SetBuffer(CurrentCodeBuffer->Ptr, CurrentCodeBuffer->Size);
+    SetCursorOffset(ColdCodeOffset);
+  }
+  ReleaseSharedCodeArena(GetCursorOffset());
+
 #ifdef VIXL_DISASSEMBLER
   if (Disassemble() & FEXCore::Config::Disassemble::STATS) {
     auto HeaderOp = IR->GetHeader();
@@ -1164,7 +1500,7 @@ CPUBackend::CompiledCode Arm64JITCore::CompileCode(uint64_t Entry,
   }
 
   if (Disassemble() & FEXCore::Config::Disassemble::BLOCKS) {
-    const auto DisasmEnd = reinterpret_cast<const vixl::aarch64::Instruction*>(JITBlockTailLocation);
+    const auto DisasmEnd = reinterpret_cast<const vixl::aarch64::Instruction*>(CodeData.BlockBegin + CodeOnlySize);
     LogMan::Msg::IFmt("Disassemble Begin");
     for (auto PCToDecode = DisasmBegin; PCToDecode < DisasmEnd; PCToDecode += 4) {
       DisasmDecoder.Decode(PCToDecode);
@@ -1185,6 +1521,70 @@ CPUBackend::CompiledCode Arm64JITCore::CompileCode(uint64_t Entry,
   return CodeData;
 }
 
+CPUBackend::CompiledCode Arm64JITCore::RelocateJITObjectCode(uint64_t Entry, CodeSerialize::CodeObjectFileSection const *SerializationData) {
+  FEXCORE_PROFILE_SCOPED("Arm64::RelocateJITObjectCode");
+
+  const auto Data = SerializationData->Data;
+
+  auto ArenaLock = ClaimSharedCodeArena();
+  if (ArenaLock.owns_lock()) {
+    SetBuffer(CurrentCodeBuffer->Ptr, CurrentCodeBuffer->Size);
+    SetCursorOffset(SharedArena->Offset);
+  }
+
+  ReserveCodeSpace(Data->HostCodeLength);
+
+  const auto BlockOffset = GetCursorOffset();
+  auto BlockBegin = GetCursorAddress<uint8_t*>();
+  memcpy(BlockBegin, SerializationData->HostCode, Data->HostCodeLength);
+
+  if (!ApplyRelocations(Entry, reinterpret_cast<uint64_t>(BlockBegin), BlockOffset, SerializationData->NumRelocations, SerializationData->Relocations)) {
+    // Drop the copy
+    SetCursorOffset(BlockOffset);
+    ReleaseSharedCodeArena(BlockOffset);
+    return {};
+  }
+
+  SetCursorOffset(BlockOffset + Data->HostCodeLength);
+  ClearICache(BlockBegin, Data->HostCodeLength);
+  ReleaseSharedCodeArena(GetCursorOffset());
+
+  return CPUBackend::CompiledCode {
+    .BlockBegin = BlockBegin,
+    .BlockEntry = BlockBegin + Data->HostEntryOffset,
+    .Size = Data->HostCodeLength,
+  };
+}
+
+void Arm64JITCore::LoadPooledConstant(ARMEmitter::Register Reg, uint64_t Constant) {
+  // A literal load is one instruction and eight bytes of pool, shared by every other use of the constant.
+  // Only worth it over movz+movk+movk or longer.
+  if (UseConstantPool && LoadConstantInstructionCount(Constant) >= 3) {
+    ldr(Reg.X(), &ConstantPool[Constant]);
+    return;
+  }
+
+  LoadConstant(ARMEmitter::Size::i64Bit, Reg, Constant);
+}
+
+void Arm64JITCore::EmitConstantPool() {
+  if (ConstantPool.empty()) {
+    return;
+  }
+
+  // Keep the 64-bit literals naturally aligned
+  if (GetCursorAddress<uint64_t>() & 0b111) {
+    dc32(0);
+  }
+
+  for (auto &[Constant, Label] : ConstantPool) {
+    Bind(&Label);
+    dc64(Constant);
+  }
+
+  ConstantPool.clear();
+}
+
 void Arm64JITCore::ResetStack() {
   if (SpillSlots == 0) {
     return;
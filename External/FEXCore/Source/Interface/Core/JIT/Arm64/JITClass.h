@@ -8,6 +8,7 @@ $end_info$
 
 #include "Interface/Core/ArchHelpers/Arm64Emitter.h"
 #include "Interface/Core/ArchHelpers/CodeEmitter/Emitter.h"
+#include "Interface/Core/CodeRegionEviction.h"
 #include "Interface/Core/Dispatcher/Dispatcher.h"
 
 #include <aarch64/assembler-aarch64.h>
@@ -42,7 +43,9 @@ public:
   [[nodiscard]] CPUBackend::CompiledCode CompileCode(uint64_t Entry,
                                   FEXCore::IR::IRListView const *IR,
                                   FEXCore::Core::DebugData *DebugData,
-                                  FEXCore::IR::RegisterAllocationData *RAData, bool GDBEnabled) override;
+                                  FEXCore::IR::RegisterAllocationData *RAData, bool GDBEnabled, bool HotBlock) override;
+
+  [[nodiscard]] CPUBackend::CompiledCode RelocateJITObjectCode(uint64_t Entry, CodeSerialize::CodeObjectFileSection const *SerializationData) override;
 
   [[nodiscard]] void *MapRegion(void* HostPtr, uint64_t, uint64_t) override { return HostPtr; }
 
@@ -50,6 +53,8 @@ public:
 
   void ClearCache() override;
 
+  void SealCodeBuffer() override;
+
   void ClearRelocations() override { Relocations.clear(); }
 
 private:
@@ -57,8 +62,18 @@ private:
 
   const bool HostSupportsSVE128{};
   const bool HostSupportsSVE256{};
+  const bool HostSupportsSVE2{};
+  const bool HostSupportsSVEBitPerm{};
+  ///< Guest XMM state uses the AVX layout, even if SVE256 isn't available
+  const bool HostSupportsAVX{};
 
   ARMEmitter::BiDirectionalLabel *PendingTargetLabel;
+  ///< Set while the context still holds the static registers spilled for a fallback call.
+  ///< Carried from the fallback to the next op, and past context and flag stores.
+  bool StaticRegsInContext{};
+  bool NextStaticRegsInContext{};
+  ///< End of the last vector LoadMemTSO half-barrier, reset at each block start since a jump target can't share it
+  uint8_t *LoadBarrierEnd{};
   FEXCore::Context::ContextImpl *CTX;
   FEXCore::IR::IRListView const *IR;
   uint64_t Entry;
@@ -66,6 +81,31 @@ private:
 
   fextl::map<IR::NodeID, ARMEmitter::BiDirectionalLabel> JumpTargets;
 
+  // The imm19 conditional branch (b.cond, cbz, cbnz) to each block, so an exit block's linker can retarget it.
+  // nullptr when more than one conditional branch targets the block.
+  fextl::map<IR::NodeID, uint8_t*> CondBranchToBlock;
+  IR::NodeID CurrentBlockID{};
+  uint8_t *CurrentBlockStart{};
+
+  // Records the imm19 conditional branch about to be emitted at the cursor
+  void RecordCondBranch(IR::NodeID Target);
+
+  // Wide constants loaded PC-relative from a literal pool placed after the block's code.
+  // Keyed by value so every use in the multiblock shares one pool entry.
+  fextl::map<uint64_t, ARMEmitter::ForwardLabel> ConstantPool;
+  bool UseConstantPool{};
+
+  void LoadPooledConstant(FEXCore::ARMEmitter::Register Reg, uint64_t Constant);
+  void EmitConstantPool();
+
+  // NEON lowering of the PCMPxSTRx intermediate result, specialized on the control byte.
+  // RAX and RDX are only read for the explicit length variants.
+  void EmitPCMPXSTRX(ARMEmitter::Register Dst, ARMEmitter::VRegister LHS, ARMEmitter::VRegister RHS,
+                     bool IsExplicit, ARMEmitter::Register RAX, ARMEmitter::Register RDX, uint16_t Control);
+  // Applies the polarity and packs the flags in to Dst.
+  // Expects the intermediate result in TMP1, the string length in TMP2 and the set length in TMP3.
+  void EmitPCMPXSTRXFlags(ARMEmitter::Register Dst, uint16_t Control);
+
   [[nodiscard]] FEXCore::ARMEmitter::Register GetReg(IR::NodeID Node) const {
     const auto Reg = GetPhys(Node);
 
@@ -133,6 +173,10 @@ private:
                                                     IR::MemOffsetType OffsetType,
                                                     uint8_t OffsetScale);
 
+  // Branches to Skip when the sign bit of the mask element is clear, using TMP1.
+  // Masked memory ops without SVE handle each element on its own.
+  void EmitMaskedElementTest(ARMEmitter::VRegister Mask, uint8_t ElementSize, uint32_t Index, ARMEmitter::ForwardLabel *Skip);
+
   [[nodiscard]] bool IsInlineConstant(const IR::OrderedNodeWrapper& Node, uint64_t* Value = nullptr) const;
   [[nodiscard]] bool IsInlineEntrypointOffset(const IR::OrderedNodeWrapper& WNode, uint64_t* Value) const;
 
@@ -143,10 +187,57 @@ private:
 
   // This is purely a debugging aid for developers to see if they are in JIT code space when inspecting raw memory
   void EmitDetectionString();
+
+  // ldr + cbz on the fast path, RIP sync and the branch to the dispatcher on the slow path
+  static constexpr size_t MaxSafepointCheckSize = 32;
+
+  // A thread local code buffer at its maximum size is split in to regions, the coldest one is reused first
+  static constexpr size_t CODE_REGION_COUNT = 8;
+  ///< Offset of the first region, past the detection string
+  size_t CodeRegionBase{};
+  CodeRegionEviction<CODE_REGION_COUNT> RegionEviction;
+  // Makes room for Size bytes at the cursor, either by evicting the next region or by clearing the code cache
+  void ReserveCodeSpace(size_t Size);
+
+  ///< Emission offset in to the hot code buffer
+  size_t HotCodeOffset{};
+  // Makes room for Size bytes in the hot code buffer, returns false if the block needs to go to the regular buffer
+  [[nodiscard]] bool ReserveHotCodeSpace(size_t Size);
   IR::RegisterAllocationPass *RAPass;
   IR::RegisterAllocationData *RAData;
   FEXCore::Core::DebugData *DebugData;
 
+  /**
+   * @name Call liveness
+   * Calls out of the JIT only preserve the dynamic registers holding a value that is used after the call.
+   * Values used outside of the block defining them are treated as live everywhere.
+   * @{ */
+    ///< Last use of each value in its own block, UINT32_MAX if it is used outside of it
+    fextl::vector<IR::NodeID> LastLocalUse;
+    ///< Host registers holding a value that is used outside of its block
+    uint32_t GlobalLiveGPRs{};
+    uint32_t GlobalLiveFPRs{};
+    ///< Last use of the block local value currently in each host register
+    std::array<IR::NodeID, 32> GPRLiveUntil{};
+    std::array<IR::NodeID, 32> FPRLiveUntil{};
+    IR::NodeID CurrentNode{};
+
+    void CalculateCallLiveness();
+    // Adds Node's registers to the masks, static registers are skipped
+    void AddHostRegisters(IR::NodeID Node, uint32_t *GPRs, uint32_t *FPRs) const;
+    // Dynamic registers that have to survive a call made by the op being emitted
+    [[nodiscard]] std::pair<uint32_t, uint32_t> LiveDynamicRegisters() const;
+
+    void PushLiveDynamicRegsAndLR(ARMEmitter::Register TmpReg) {
+      const auto [GPRs, FPRs] = LiveDynamicRegisters();
+      PushDynamicRegsAndLR(TmpReg, GPRs, FPRs);
+    }
+    void PopLiveDynamicRegsAndLR() {
+      const auto [GPRs, FPRs] = LiveDynamicRegisters();
+      PopDynamicRegsAndLR(GPRs, FPRs);
+    }
+  /**  @} */
+
   void ResetStack();
   /**
    * @name Relocations
@@ -232,6 +323,10 @@ private:
   DEF_OP(CycleCounter);
   DEF_OP(Add);
   DEF_OP(TestNZ);
+  DEF_OP(AddNZCV);
+  DEF_OP(SubNZCV);
+  DEF_OP(AdcNZCV);
+  DEF_OP(SbbNZCV);
   DEF_OP(Sub);
   DEF_OP(Neg);
   DEF_OP(Abs);
@@ -298,6 +393,8 @@ private:
   ///< Branch ops
   DEF_OP(CallbackReturn);
   DEF_OP(ExitFunction);
+  DEF_OP(PushReturnStack);
+  DEF_OP(ReturnStackLookup);
   DEF_OP(Jump);
   DEF_OP(CondJump);
   DEF_OP(Syscall);
@@ -340,10 +437,14 @@ private:
   DEF_OP(StoreMem);
   DEF_OP(LoadMemTSO);
   DEF_OP(StoreMemTSO);
+  DEF_OP(StoreMemPair);
   DEF_OP(VLoadVectorMasked);
   DEF_OP(VStoreVectorMasked);
+  DEF_OP(VGather);
   DEF_OP(MemSet);
   DEF_OP(MemCpy);
+  DEF_OP(MemScan);
+  DEF_OP(MemCmp);
   DEF_OP(ParanoidLoadMemTSO);
   DEF_OP(ParanoidStoreMemTSO);
   DEF_OP(CacheLineClear);
@@ -362,6 +463,7 @@ private:
   DEF_OP(ProcessorID);
   DEF_OP(RDRAND);
   DEF_OP(Yield);
+  DEF_OP(SpinWait);
 
   ///< Move ops
   DEF_OP(ExtractElementPair);
@@ -454,6 +556,8 @@ private:
   DEF_OP(VUABDL2);
   DEF_OP(VTBL1);
   DEF_OP(VRev64);
+  DEF_OP(VPCMPESTRX);
+  DEF_OP(VPCMPISTRX);
 
   ///< Encryption ops
   DEF_OP(AESImc);
@@ -464,6 +568,12 @@ private:
   DEF_OP(AESKeyGenAssist);
   DEF_OP(CRC32);
   DEF_OP(PCLMUL);
+
+  ///< F80 ops
+  DEF_OP(F80CVTTo);
+  DEF_OP(F80CVT);
+  DEF_OP(F80CVTToInt);
+  DEF_OP(F80Cmp);
 #undef DEF_OP
 };
 
@@ -12,6 +12,8 @@ $end_info$
 #include <FEXCore/Utils/CompilerDefs.h>
 #include <FEXCore/Utils/MathUtils.h>
 
+#include <algorithm>
+
 namespace FEXCore::CPU {
 #define DEF_OP(x) void Arm64JITCore::Op_##x(IR::IROp_Header const *IROp, IR::NodeID Node)
 
@@ -123,6 +125,9 @@ DEF_OP(StoreContext) {
       break;
     }
   }
+
+  // Statically allocated state goes through StoreRegister, so a spill for a fallback call before this is still valid
+  NextStaticRegsInContext = StaticRegsInContext;
 }
 
 DEF_OP(LoadRegister) {
@@ -162,11 +167,10 @@ DEF_OP(LoadRegister) {
     }
   }
   else if (Op->Class == IR::FPRClass) {
-    const auto regSize = HostSupportsSVE256 ? Core::CPUState::XMM_AVX_REG_SIZE
-                                            : Core::CPUState::XMM_SSE_REG_SIZE;
+    const auto regSize = HostSupportsAVX ? Core::CPUState::XMM_AVX_REG_SIZE
+                                         : Core::CPUState::XMM_SSE_REG_SIZE;
     [[maybe_unused]] const auto regId = (Op->Offset - offsetof(Core::CpuStateFrame, State.xmm.avx.data[0][0])) / regSize;
 
-    LOGMAN_THROW_A_FMT(HostSupportsSVE256, "Unsupported code path!");
     LOGMAN_THROW_A_FMT(regId < StaticFPRegisters.size(), "out of range regId");
 
     const auto host = GetVReg(Node);
@@ -244,11 +248,10 @@ DEF_OP(StoreRegister) {
         break;
     }
   } else if (Op->Class == IR::FPRClass) {
-    const auto regSize = HostSupportsSVE256 ? Core::CPUState::XMM_AVX_REG_SIZE
-                                            : Core::CPUState::XMM_SSE_REG_SIZE;
+    const auto regSize = HostSupportsAVX ? Core::CPUState::XMM_AVX_REG_SIZE
+                                         : Core::CPUState::XMM_SSE_REG_SIZE;
     [[maybe_unused]] const auto regId = (Op->Offset - offsetof(Core::CpuStateFrame, State.xmm.avx.data[0][0])) / regSize;
 
-    LOGMAN_THROW_A_FMT(HostSupportsSVE256, "Unsupported code path!");
     LOGMAN_THROW_A_FMT(regId < StaticFPRegisters.size(), "regId out of range");
 
     const auto host = GetVReg(Op->Value.ID());
@@ -331,8 +334,8 @@ DEF_OP(LoadRegisterSRA) {
     }
   }
   else if (Op->Class == IR::FPRClass) {
-    const auto regSize = HostSupportsSVE256 ? Core::CPUState::XMM_AVX_REG_SIZE
-                                            : Core::CPUState::XMM_SSE_REG_SIZE;
+    const auto regSize = HostSupportsAVX ? Core::CPUState::XMM_AVX_REG_SIZE
+                                         : Core::CPUState::XMM_SSE_REG_SIZE;
     const auto regId = (Op->Offset - offsetof(Core::CpuStateFrame, State.xmm.avx.data[0][0])) / regSize;
 
     LOGMAN_THROW_A_FMT(regId < StaticFPRegisters.size(), "out of range regId");
@@ -517,8 +520,8 @@ DEF_OP(StoreRegisterSRA) {
         break;
     }
   } else if (Op->Class == IR::FPRClass) {
-    const auto regSize = HostSupportsSVE256 ? Core::CPUState::XMM_AVX_REG_SIZE
-                                            : Core::CPUState::XMM_SSE_REG_SIZE;
+    const auto regSize = HostSupportsAVX ? Core::CPUState::XMM_AVX_REG_SIZE
+                                         : Core::CPUState::XMM_SSE_REG_SIZE;
     const auto regId = (Op->Offset - offsetof(Core::CpuStateFrame, State.xmm.avx.data[0][0])) / regSize;
 
     LOGMAN_THROW_A_FMT(regId < StaticFPRegisters.size(), "regId out of range");
@@ -1065,6 +1068,9 @@ DEF_OP(StoreFlag) {
     str(GetReg(Op->Value.ID()).W(), STATE, offsetof(FEXCore::Core::CPUState, flags[0]) + Op->Flag);
   else
     strb(GetReg(Op->Value.ID()), STATE, offsetof(FEXCore::Core::CPUState, flags[0]) + Op->Flag);
+
+  // Flags are never statically allocated
+  NextStaticRegsInContext = StaticRegsInContext;
 }
 
 FEXCore::ARMEmitter::ExtendedMemOperand Arm64JITCore::GenerateMemOperand(uint8_t AccessSize,
@@ -1326,20 +1332,103 @@ DEF_OP(LoadMemTSO) {
     }
     // Half-barrier.
     dmb(FEXCore::ARMEmitter::BarrierScope::ISHLD);
+    LoadBarrierEnd = GetCursorAddress<uint8_t*>();
   }
 }
 
-DEF_OP(VLoadVectorMasked) {
-  LOGMAN_THROW_A_FMT(HostSupportsSVE256, "Need SVE support in order to use VLoadVectorMasked");
+DEF_OP(StoreMemPair) {
+  const auto Op = IROp->C<IR::IROp_StoreMemPair>();
+  const auto OpSize = IROp->Size;
+
+  const auto Value1 = GetReg(Op->Value1.ID());
+  const auto Value2 = GetReg(Op->Value2.ID());
+  const auto MemReg = GetReg(Op->Addr.ID());
+
+  switch (OpSize) {
+    case 4:
+      stp<ARMEmitter::IndexType::OFFSET>(Value1.W(), Value2.W(), MemReg, Op->Offset);
+      break;
+    case 8:
+      stp<ARMEmitter::IndexType::OFFSET>(Value1.X(), Value2.X(), MemReg, Op->Offset);
+      break;
+    default:
+      LOGMAN_MSG_A_FMT("Unhandled StoreMemPair size: {}", OpSize);
+      break;
+  }
+}
+
+void Arm64JITCore::EmitMaskedElementTest(ARMEmitter::VRegister Mask, uint8_t ElementSize, uint32_t Index, ARMEmitter::ForwardLabel *Skip) {
+  switch (ElementSize) {
+    case 1:
+      umov<ARMEmitter::SubRegSize::i8Bit>(TMP1, Mask, Index);
+      break;
+    case 2:
+      umov<ARMEmitter::SubRegSize::i16Bit>(TMP1, Mask, Index);
+      break;
+    case 4:
+      umov<ARMEmitter::SubRegSize::i32Bit>(TMP1, Mask, Index);
+      break;
+    case 8:
+      umov<ARMEmitter::SubRegSize::i64Bit>(TMP1, Mask, Index);
+      break;
+    default:
+      LOGMAN_MSG_A_FMT("Unhandled mask element size: {}", ElementSize);
+      break;
+  }
+  tbz(TMP1, ElementSize * 8 - 1, Skip);
+}
 
+DEF_OP(VLoadVectorMasked) {
   const auto Op = IROp->C<IR::IROp_VLoadVectorMasked>();
   const auto OpSize = IROp->Size;
 
   const auto Is256Bit = OpSize == Core::CPUState::XMM_AVX_REG_SIZE;
   const auto ElementSize = IROp->ElementSize;
+  LOGMAN_THROW_A_FMT(HostSupportsSVE256 || !Is256Bit, "Need SVE256 support in order to use a 256-bit VLoadVectorMasked");
+
+  if (!HostSupportsSVE128 && !HostSupportsSVE256) {
+    // No predicated loads without SVE, load each active element on its own so masked off elements can't fault
+    LOGMAN_THROW_AA_FMT(Op->Offset.IsInvalid(), "VLoadVectorMasked can't use an offset without SVE");
+    const auto Dst = GetVReg(Node);
+    const auto MaskReg = GetVReg(Op->Mask.ID());
+    const auto MemReg = GetReg(Op->Addr.ID());
+
+    movi(ARMEmitter::SubRegSize::i64Bit, VTMP1.Q(), 0);
+    for (size_t i = 0; i < OpSize / ElementSize; ++i) {
+      ARMEmitter::ForwardLabel Skip;
+      EmitMaskedElementTest(MaskReg, ElementSize, i, &Skip);
+      add(ARMEmitter::Size::i64Bit, TMP1, MemReg, i * ElementSize);
+
+      switch (ElementSize) {
+        case 1:
+          ld1<ARMEmitter::SubRegSize::i8Bit>(VTMP1, i, TMP1);
+          break;
+        case 2:
+          ld1<ARMEmitter::SubRegSize::i16Bit>(VTMP1, i, TMP1);
+          break;
+        case 4:
+          ld1<ARMEmitter::SubRegSize::i32Bit>(VTMP1, i, TMP1);
+          break;
+        case 8:
+          ld1<ARMEmitter::SubRegSize::i64Bit>(VTMP1, i, TMP1);
+          break;
+        default:
+          LOGMAN_MSG_A_FMT("Unhandled VLoadVectorMasked size: {}", ElementSize);
+          break;
+      }
+      Bind(&Skip);
+    }
+    mov(Dst.Q(), VTMP1.Q());
+    return;
+  }
 
   const auto CMPPredicate = ARMEmitter::PReg::p0;
-  const auto GoverningPredicate = Is256Bit ? PRED_TMP_32B : PRED_TMP_16B;
+  auto GoverningPredicate = Is256Bit ? PRED_TMP_32B : PRED_TMP_16B;
+  if (!HostSupportsSVE256) {
+    // The static predicates are only set up for SVE256, make a 128-bit one locally
+    GoverningPredicate = ARMEmitter::PReg::p1;
+    ptrue<ARMEmitter::SubRegSize::i8Bit>(GoverningPredicate, ARMEmitter::PredicatePattern::SVE_VL16);
+  }
 
   const auto Dst = GetVReg(Node);
   const auto MaskReg = GetVReg(Op->Mask.ID());
@@ -1380,16 +1469,54 @@ DEF_OP(VLoadVectorMasked) {
 }
 
 DEF_OP(VStoreVectorMasked) {
-  LOGMAN_THROW_A_FMT(HostSupportsSVE256, "Need SVE support in order to use VStoreVectorMasked");
-
   const auto Op = IROp->C<IR::IROp_VStoreVectorMasked>();
   const auto OpSize = IROp->Size;
 
   const auto Is256Bit = OpSize == Core::CPUState::XMM_AVX_REG_SIZE;
   const auto ElementSize = IROp->ElementSize;
+  LOGMAN_THROW_A_FMT(HostSupportsSVE256 || !Is256Bit, "Need SVE256 support in order to use a 256-bit VStoreVectorMasked");
+
+  if (!HostSupportsSVE128 && !HostSupportsSVE256) {
+    // No predicated stores without SVE, masked off elements must not be written
+    LOGMAN_THROW_AA_FMT(Op->Offset.IsInvalid(), "VStoreVectorMasked can't use an offset without SVE");
+    const auto RegData = GetVReg(Op->Data.ID());
+    const auto MaskReg = GetVReg(Op->Mask.ID());
+    const auto MemReg = GetReg(Op->Addr.ID());
+
+    for (size_t i = 0; i < OpSize / ElementSize; ++i) {
+      ARMEmitter::ForwardLabel Skip;
+      EmitMaskedElementTest(MaskReg, ElementSize, i, &Skip);
+      add(ARMEmitter::Size::i64Bit, TMP1, MemReg, i * ElementSize);
+
+      switch (ElementSize) {
+        case 1:
+          st1<ARMEmitter::SubRegSize::i8Bit>(RegData, i, TMP1);
+          break;
+        case 2:
+          st1<ARMEmitter::SubRegSize::i16Bit>(RegData, i, TMP1);
+          break;
+        case 4:
+          st1<ARMEmitter::SubRegSize::i32Bit>(RegData, i, TMP1);
+          break;
+        case 8:
+          st1<ARMEmitter::SubRegSize::i64Bit>(RegData, i, TMP1);
+          break;
+        default:
+          LOGMAN_MSG_A_FMT("Unhandled VStoreVectorMasked size: {}", ElementSize);
+          break;
+      }
+      Bind(&Skip);
+    }
+    return;
+  }
 
   const auto CMPPredicate = ARMEmitter::PReg::p0;
-  const auto GoverningPredicate = Is256Bit ? PRED_TMP_32B : PRED_TMP_16B;
+  auto GoverningPredicate = Is256Bit ? PRED_TMP_32B : PRED_TMP_16B;
+  if (!HostSupportsSVE256) {
+    // The static predicates are only set up for SVE256, make a 128-bit one locally
+    GoverningPredicate = ARMEmitter::PReg::p1;
+    ptrue<ARMEmitter::SubRegSize::i8Bit>(GoverningPredicate, ARMEmitter::PredicatePattern::SVE_VL16);
+  }
 
   const auto RegData = GetVReg(Op->Data.ID());
   const auto MaskReg = GetVReg(Op->Mask.ID());
@@ -1555,6 +1682,11 @@ DEF_OP(StoreMemTSO) {
     }
   }
   else {
+    if (GetCursorAddress<uint8_t*>() == LoadBarrierEnd) {
+      // Nothing was emitted since a load's half-barrier.
+      // A full barrier in its place orders that load against everything after, as well as this store.
+      SetCursorOffset(GetCursorOffset() - 4);
+    }
     // Half-Barrier.
     dmb(FEXCore::ARMEmitter::BarrierScope::ISH);
     const auto Src = GetVReg(Op->Value.ID());
@@ -1587,14 +1719,161 @@ DEF_OP(StoreMemTSO) {
   }
 }
 
+DEF_OP(VGather) {
+  const auto Op = IROp->C<IR::IROp_VGather>();
+  const auto OpSize = IROp->Size;
+
+  const auto Is256Bit = OpSize == Core::CPUState::XMM_AVX_REG_SIZE;
+  const auto ElementSize = IROp->ElementSize;
+  const auto IndexElementSize = Op->IndexElementSize;
+  const auto NumElements = OpSize / std::max(ElementSize, IndexElementSize);
+  LOGMAN_THROW_AA_FMT((ElementSize == 4 || ElementSize == 8) && (IndexElementSize == 4 || IndexElementSize == 8), "Invalid size");
+  LOGMAN_THROW_A_FMT(HostSupportsSVE256 || !Is256Bit, "Need SVE256 support in order to use a 256-bit VGather");
+
+  const auto Dst = GetVReg(Node);
+  const auto DestReg = GetVReg(Op->Dest.ID());
+  const auto MaskReg = GetVReg(Op->Mask.ID());
+  const auto IndexReg = GetVReg(Op->Indices.ID());
+  const auto BaseReg = GetReg(Op->Base.ID());
+  const auto ScaleShift = FEXCore::ilog2(Op->Scale);
+
+  const auto ElementSubRegSize = ElementSize == 4 ? ARMEmitter::SubRegSize::i32Bit : ARMEmitter::SubRegSize::i64Bit;
+
+  if (HostSupportsSVE128 || HostSupportsSVE256) {
+    const auto CMPPredicate = ARMEmitter::PReg::p0;
+    const auto GoverningPredicate = ARMEmitter::PReg::p1;
+
+    if (ElementSize == 4 && IndexElementSize == 4 && (Op->Scale == 1 || Op->Scale == 4)) {
+      // Word offsets can only be scaled by the element size, other scales go through 64-bit lanes below
+      ptrue<ARMEmitter::SubRegSize::i32Bit>(GoverningPredicate,
+        NumElements == 8 ? ARMEmitter::PredicatePattern::SVE_VL8 : ARMEmitter::PredicatePattern::SVE_VL4);
+      cmplt(ARMEmitter::SubRegSize::i32Bit, CMPPredicate, GoverningPredicate.Zeroing(), MaskReg.Z(), 0);
+      ld1w<ARMEmitter::SubRegSize::i32Bit>(VTMP1.Z(), CMPPredicate.Zeroing(),
+        ARMEmitter::SVEMemOperand(BaseReg.X(), IndexReg.Z(), ARMEmitter::SVEModType::MOD_SXTW, Op->Scale == 4 ? 2 : 0));
+    }
+    else {
+      // Gather in 64-bit lanes, indices are sign extended before they are scaled so offsets can't overflow.
+      // Word indices with word elements take two passes when twice as many lanes don't fit in the host vector.
+      const size_t HostLanes = (HostSupportsSVE256 ? Core::CPUState::XMM_AVX_REG_SIZE : Core::CPUState::XMM_SSE_REG_SIZE) / 8;
+      const size_t Passes = NumElements > HostLanes ? 2 : 1;
+      const size_t PassElements = NumElements / Passes;
+
+      ptrue<ARMEmitter::SubRegSize::i64Bit>(GoverningPredicate,
+        PassElements == 4 ? ARMEmitter::PredicatePattern::SVE_VL4 : ARMEmitter::PredicatePattern::SVE_VL2);
+
+      for (size_t Pass = 0; Pass < Passes; ++Pass) {
+        auto Offsets = IndexReg;
+        if (IndexElementSize == 4) {
+          if (Pass == 0) {
+            sunpklo(ARMEmitter::SubRegSize::i64Bit, VTMP2.Z(), IndexReg.Z());
+          }
+          else {
+            sunpkhi(ARMEmitter::SubRegSize::i64Bit, VTMP2.Z(), IndexReg.Z());
+          }
+          Offsets = VTMP2;
+        }
+
+        auto Mod = ARMEmitter::SVEModType::MOD_NONE;
+        uint8_t MemScale = 0;
+        if (Op->Scale == ElementSize) {
+          Mod = ARMEmitter::SVEModType::MOD_LSL;
+          MemScale = ScaleShift;
+        }
+        else if (Op->Scale != 1) {
+          lsl(ARMEmitter::SubRegSize::i64Bit, VTMP2.Z(), Offsets.Z(), ScaleShift);
+          Offsets = VTMP2;
+        }
+
+        auto LaneMask = MaskReg;
+        if (ElementSize == 4) {
+          if (Pass == 0) {
+            sunpklo(ARMEmitter::SubRegSize::i64Bit, VTMP3.Z(), MaskReg.Z());
+          }
+          else {
+            sunpkhi(ARMEmitter::SubRegSize::i64Bit, VTMP3.Z(), MaskReg.Z());
+          }
+          LaneMask = VTMP3;
+        }
+
+        // Check if the sign bit is set for the given element size.
+        cmplt(ARMEmitter::SubRegSize::i64Bit, CMPPredicate, GoverningPredicate.Zeroing(), LaneMask.Z(), 0);
+
+        // The mask was already consumed, the second pass loads over it
+        const auto PassResult = Pass == 0 ? VTMP1 : VTMP3;
+        const auto MemSrc = ARMEmitter::SVEMemOperand(BaseReg.X(), Offsets.Z(), Mod, MemScale);
+        if (ElementSize == 8) {
+          ld1d(PassResult.Z(), CMPPredicate.Zeroing(), MemSrc);
+        }
+        else {
+          ld1w<ARMEmitter::SubRegSize::i64Bit>(PassResult.Z(), CMPPredicate.Zeroing(), MemSrc);
+        }
+      }
+
+      if (ElementSize == 4) {
+        // Pack the zero extended words back together and compute the predicate at word granularity for the merge
+        uzp1(ARMEmitter::SubRegSize::i32Bit, VTMP1.Z(), VTMP1.Z(), Passes == 2 ? VTMP3.Z() : VTMP1.Z());
+        ptrue<ARMEmitter::SubRegSize::i32Bit>(GoverningPredicate,
+          NumElements == 8 ? ARMEmitter::PredicatePattern::SVE_VL8 :
+          NumElements == 4 ? ARMEmitter::PredicatePattern::SVE_VL4 : ARMEmitter::PredicatePattern::SVE_VL2);
+        cmplt(ARMEmitter::SubRegSize::i32Bit, CMPPredicate, GoverningPredicate.Zeroing(), MaskReg.Z(), 0);
+      }
+    }
+
+    // Masked off elements keep their old value
+    sel(ElementSubRegSize, VTMP1.Z(), CMPPredicate, VTMP1.Z(), DestReg.Z());
+  }
+  else {
+    // No gathers without SVE, load each active element on its own
+    mov(VTMP1.Q(), DestReg.Q());
+
+    for (size_t i = 0; i < NumElements; ++i) {
+      ARMEmitter::ForwardLabel Skip;
+      EmitMaskedElementTest(MaskReg, ElementSize, i, &Skip);
+
+      if (IndexElementSize == 4) {
+        umov<ARMEmitter::SubRegSize::i32Bit>(TMP1, IndexReg, i);
+        add(ARMEmitter::Size::i64Bit, TMP1, BaseReg, TMP1, ARMEmitter::ExtendedType::SXTW, ScaleShift);
+      }
+      else {
+        umov<ARMEmitter::SubRegSize::i64Bit>(TMP1, IndexReg, i);
+        add(ARMEmitter::Size::i64Bit, TMP1, BaseReg, TMP1, ARMEmitter::ExtendedType::SXTX, ScaleShift);
+      }
+
+      if (ElementSize == 4) {
+        ld1<ARMEmitter::SubRegSize::i32Bit>(VTMP1, i, TMP1);
+      }
+      else {
+        ld1<ARMEmitter::SubRegSize::i64Bit>(VTMP1, i, TMP1);
+      }
+
+      Bind(&Skip);
+    }
+  }
+
+  // Zero everything above the gathered elements
+  switch (NumElements * ElementSize) {
+    case 8:
+      mov(Dst.D(), VTMP1.D());
+      break;
+    case 16:
+      mov(Dst.Q(), VTMP1.Q());
+      break;
+    case 32:
+      mov(Dst.Z(), VTMP1.Z());
+      break;
+    default:
+      LOGMAN_MSG_A_FMT("Unhandled VGather size: {}", NumElements * ElementSize);
+      break;
+  }
+}
+
 DEF_OP(MemSet) {
-  // TODO: A future looking task would be to support this with ARM's MOPS instructions.
-  // The 8-bit non-atomic forward path directly matches ARM's SETP/SETM/SETE instruction,
-  // while the backward version needs some fixup to convert it to a forward direction.
+  // The non-atomic forward direction is lowered to ARM's SETP/SETM/SETE when the element is 8-bit,
+  // otherwise to a 64 byte per iteration NEON store loop.
+  // The backward direction and TSO stores keep the element loop.
   //
-  // Assuming non-atomicity and non-faulting behaviour, this can accelerate this implementation.
-  // Additionally: This is commonly used as a memset to zero. If we know up-front with an inline constant
-  // that the value is zero, we can optimize any operation larger than 8-bit down to 8-bit to use the MOPS implementation.
+  // TODO: The backward version could be converted to a forward direction with some fixup,
+  // and a zero memset of larger elements could use the 8-bit MOPS implementation.
   const auto Op = IROp->C<IR::IROp_MemSet>();
 
   const int32_t Size = Op->Size;
@@ -1678,6 +1957,67 @@ DEF_OP(MemSet) {
     }
   };
 
+  // Forward store of TMP1 elements to TMP2, 64 bytes per iteration.
+  auto BulkStore = [this, &MemStore](auto Value, uint32_t OpSize) {
+    ARMEmitter::BackwardLabel Loop64{};
+    ARMEmitter::BackwardLabel Loop16{};
+    ARMEmitter::BackwardLabel LoopElement{};
+    ARMEmitter::ForwardLabel Tail16{};
+    ARMEmitter::ForwardLabel TailElement{};
+    ARMEmitter::ForwardLabel BulkDone{};
+
+    const auto ElementSize =
+      OpSize == 1 ? ARMEmitter::SubRegSize::i8Bit :
+      OpSize == 2 ? ARMEmitter::SubRegSize::i16Bit :
+      OpSize == 4 ? ARMEmitter::SubRegSize::i32Bit :
+                    ARMEmitter::SubRegSize::i64Bit;
+
+    // Work in bytes
+    if (OpSize > 1) {
+      lsl(ARMEmitter::Size::i64Bit, TMP1, TMP1, FEXCore::ilog2(OpSize));
+    }
+    dup(ElementSize, VTMP1.Q(), Value);
+
+    cmp(ARMEmitter::Size::i64Bit, TMP1, 64);
+    b(ARMEmitter::Condition::CC_CC, &Tail16);
+
+    if (OpSize == 1) {
+      // Store the first 16 bytes unaligned then step to a 16 byte aligned destination.
+      // Only done with bytes, larger elements would shift the pattern.
+      str(VTMP1.Q(), TMP2, 0);
+      neg(TMP4, TMP2);
+      and_(ARMEmitter::Size::i64Bit, TMP4, TMP4, 15);
+      add(ARMEmitter::Size::i64Bit, TMP2, TMP2, TMP4);
+      sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, TMP4);
+    }
+
+    Bind(&Loop64);
+    cmp(ARMEmitter::Size::i64Bit, TMP1, 64);
+    b(ARMEmitter::Condition::CC_CC, &Tail16);
+    stp<ARMEmitter::IndexType::POST>(VTMP1.Q(), VTMP1.Q(), TMP2, 32);
+    stp<ARMEmitter::IndexType::POST>(VTMP1.Q(), VTMP1.Q(), TMP2, 32);
+    sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, 64);
+    b(&Loop64);
+
+    Bind(&Tail16);
+    Bind(&Loop16);
+    cmp(ARMEmitter::Size::i64Bit, TMP1, 16);
+    b(ARMEmitter::Condition::CC_CC, &TailElement);
+    str<ARMEmitter::IndexType::POST>(VTMP1.Q(), TMP2, 16);
+    sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, 16);
+    b(&Loop16);
+
+    // Less than 16 bytes left, always a whole number of elements
+    Bind(&TailElement);
+    cbz(ARMEmitter::Size::i64Bit, TMP1, &BulkDone);
+    Bind(&LoopElement);
+    MemStore(Value, OpSize, OpSize);
+    sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, OpSize);
+    cbnz(ARMEmitter::Size::i64Bit, TMP1, &LoopElement);
+
+    Bind(&BulkDone);
+  };
+
   // Emit forward direction memset then backward direction memset.
   for (int32_t Direction :  { 1, -1 }) {
     const int32_t OpSize = Size;
@@ -1686,18 +2026,30 @@ DEF_OP(MemSet) {
     ARMEmitter::BackwardLabel AgainInternal{};
     ARMEmitter::ForwardLabel DoneInternal{};
 
-    // Early exit if zero count.
-    cbz(ARMEmitter::Size::i64Bit, TMP1, &DoneInternal);
-
-    Bind(&AgainInternal);
-    if (Op->IsAtomic) {
-      MemStoreTSO(Value, OpSize, SizeDirection);
+    if (Direction == 1 && !Op->IsAtomic) {
+      if (CTX->HostFeatures.SupportsMOPS && OpSize == 1) {
+        setp(TMP2, TMP1, Value.X());
+        setm(TMP2, TMP1, Value.X());
+        sete(TMP2, TMP1, Value.X());
+      }
+      else {
+        BulkStore(Value, OpSize);
+      }
     }
     else {
-      MemStore(Value, OpSize, SizeDirection);
+      // Early exit if zero count.
+      cbz(ARMEmitter::Size::i64Bit, TMP1, &DoneInternal);
+
+      Bind(&AgainInternal);
+      if (Op->IsAtomic) {
+        MemStoreTSO(Value, OpSize, SizeDirection);
+      }
+      else {
+        MemStore(Value, OpSize, SizeDirection);
+      }
+      sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, 1);
+      cbnz(ARMEmitter::Size::i64Bit, TMP1, &AgainInternal);
     }
-    sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, 1);
-    cbnz(ARMEmitter::Size::i64Bit, TMP1, &AgainInternal);
 
     Bind(&DoneInternal);
 
@@ -1751,10 +2103,10 @@ DEF_OP(MemSet) {
 }
 
 DEF_OP(MemCpy) {
-  // TODO: A future looking task would be to support this with ARM's MOPS instructions.
-  // The 8-bit non-atomic path directly matches ARM's CPYP/CPYM/CPYE instruction,
-  //
-  // Assuming non-atomicity and non-faulting behaviour, this can accelerate this implementation.
+  // The non-atomic forward direction is lowered to ARM's CPYFP/CPYFM/CPYFE when supported,
+  // otherwise to a 64 byte per iteration NEON copy loop.
+  // Both only run when source and destination don't overlap, x86 copies one element at a time so
+  // an overlapping copy reads back its own stores. Those, the backward direction and TSO copies keep the element loop.
   const auto Op = IROp->C<IR::IROp_MemCpy>();
 
   const int32_t Size = Op->Size;
@@ -1922,6 +2274,59 @@ DEF_OP(MemCpy) {
     }
   };
 
+  // Forward copy of TMP1 bytes from TMP3 to TMP2, 64 bytes per iteration.
+  // The ranges must not overlap.
+  auto BulkCopy = [this]() {
+    ARMEmitter::BackwardLabel Loop64{};
+    ARMEmitter::BackwardLabel Loop16{};
+    ARMEmitter::BackwardLabel Loop1{};
+    ARMEmitter::ForwardLabel Tail16{};
+    ARMEmitter::ForwardLabel Tail1{};
+    ARMEmitter::ForwardLabel BulkDone{};
+
+    cmp(ARMEmitter::Size::i64Bit, TMP1, 64);
+    b(ARMEmitter::Condition::CC_CC, &Tail16);
+
+    // Copy the first 16 bytes unaligned then step to a 16 byte aligned destination.
+    // The bytes between are copied twice from the same source.
+    ldr(VTMP1.Q(), TMP3, 0);
+    str(VTMP1.Q(), TMP2, 0);
+    neg(TMP4, TMP2);
+    and_(ARMEmitter::Size::i64Bit, TMP4, TMP4, 15);
+    add(ARMEmitter::Size::i64Bit, TMP2, TMP2, TMP4);
+    add(ARMEmitter::Size::i64Bit, TMP3, TMP3, TMP4);
+    sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, TMP4);
+
+    Bind(&Loop64);
+    cmp(ARMEmitter::Size::i64Bit, TMP1, 64);
+    b(ARMEmitter::Condition::CC_CC, &Tail16);
+    ldp<ARMEmitter::IndexType::POST>(VTMP1.Q(), VTMP2.Q(), TMP3, 32);
+    ldp<ARMEmitter::IndexType::POST>(VTMP3.Q(), VTMP4.Q(), TMP3, 32);
+    stp<ARMEmitter::IndexType::POST>(VTMP1.Q(), VTMP2.Q(), TMP2, 32);
+    stp<ARMEmitter::IndexType::POST>(VTMP3.Q(), VTMP4.Q(), TMP2, 32);
+    sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, 64);
+    b(&Loop64);
+
+    Bind(&Tail16);
+    Bind(&Loop16);
+    cmp(ARMEmitter::Size::i64Bit, TMP1, 16);
+    b(ARMEmitter::Condition::CC_CC, &Tail1);
+    ldr<ARMEmitter::IndexType::POST>(VTMP1.Q(), TMP3, 16);
+    str<ARMEmitter::IndexType::POST>(VTMP1.Q(), TMP2, 16);
+    sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, 16);
+    b(&Loop16);
+
+    Bind(&Tail1);
+    cbz(ARMEmitter::Size::i64Bit, TMP1, &BulkDone);
+    Bind(&Loop1);
+    ldrb<ARMEmitter::IndexType::POST>(TMP4.W(), TMP3, 1);
+    strb<ARMEmitter::IndexType::POST>(TMP4.W(), TMP2, 1);
+    sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, 1);
+    cbnz(ARMEmitter::Size::i64Bit, TMP1, &Loop1);
+
+    Bind(&BulkDone);
+  };
+
   // Emit forward direction memset then backward direction memset.
   for (int32_t Direction :  { 1, -1 }) {
     const int32_t OpSize = Size;
@@ -1930,6 +2335,37 @@ DEF_OP(MemCpy) {
     ARMEmitter::BackwardLabel AgainInternal{};
     ARMEmitter::ForwardLabel DoneInternal{};
 
+    if (Direction == 1 && !Op->IsAtomic) {
+      ARMEmitter::ForwardLabel Overlapping{};
+      const auto ElementShift = FEXCore::ilog2(static_cast<uint32_t>(OpSize));
+
+      // Work in bytes
+      if (ElementShift) {
+        lsl(ARMEmitter::Size::i64Bit, TMP1, TMP1, ElementShift);
+      }
+
+      // |Dest - Src| < Bytes is (Dest - Src + Bytes) < Bytes * 2, unsigned
+      sub(ARMEmitter::Size::i64Bit, TMP4, TMP2, TMP3);
+      add(ARMEmitter::Size::i64Bit, TMP4, TMP4, TMP1);
+      cmp(ARMEmitter::Size::i64Bit, TMP4, TMP1, ARMEmitter::ShiftType::LSL, 1);
+      b(ARMEmitter::Condition::CC_CC, &Overlapping);
+
+      if (CTX->HostFeatures.SupportsMOPS) {
+        cpyfp(TMP2, TMP3, TMP1);
+        cpyfm(TMP2, TMP3, TMP1);
+        cpyfe(TMP2, TMP3, TMP1);
+      }
+      else {
+        BulkCopy();
+      }
+      b(&DoneInternal);
+
+      Bind(&Overlapping);
+      if (ElementShift) {
+        lsr(ARMEmitter::Size::i64Bit, TMP1, TMP1, ElementShift);
+      }
+    }
+
     // Early exit if zero count.
     cbz(ARMEmitter::Size::i64Bit, TMP1, &DoneInternal);
 
@@ -2222,6 +2658,296 @@ DEF_OP(ParanoidStoreMemTSO) {
   }
 }
 
+DEF_OP(MemScan) {
+  // The non-atomic forward direction compares 16 bytes at a time with NEON while a full vector is left
+  // and the load doesn't cross a page, so it can't fault on memory x86 wouldn't have read.
+  // The element that stopped the walk is found from the narrowed comparison mask.
+  // The backward direction, TSO scans and anything left over walk one element at a time.
+  const auto Op = IROp->C<IR::IROp_MemScan>();
+
+  const int32_t Size = Op->Size;
+  const auto MemReg = GetReg(Op->Addr.ID());
+  const auto Value = GetReg(Op->Value.ID());
+  const auto Length = GetReg(Op->Length.ID());
+  const auto Direction = GetReg(Op->Direction.ID());
+  const auto Dst = GetReg(Node);
+
+  const auto ElementSize =
+    Size == 1 ? ARMEmitter::SubRegSize::i8Bit :
+    Size == 2 ? ARMEmitter::SubRegSize::i16Bit :
+    Size == 4 ? ARMEmitter::SubRegSize::i32Bit :
+                ARMEmitter::SubRegSize::i64Bit;
+  const auto ElementShift = FEXCore::ilog2(static_cast<uint32_t>(Size));
+
+  // TMP1 = Remaining elements
+  // TMP2 = Address
+  // TMP3 = Value truncated to the element size
+  // TMP4 = Temp value
+  mov(TMP1, Length.X());
+  if (Op->Prefix.IsInvalid()) {
+    mov(TMP2, MemReg.X());
+  }
+  else {
+    const auto Prefix = GetReg(Op->Prefix.ID());
+    add(TMP2, Prefix.X(), MemReg.X());
+  }
+
+  switch (Size) {
+    case 1:
+      and_(ARMEmitter::Size::i64Bit, TMP3, Value.X(), 0xFF);
+      break;
+    case 2:
+      and_(ARMEmitter::Size::i64Bit, TMP3, Value.X(), 0xFFFF);
+      break;
+    case 4:
+      mov(ARMEmitter::Size::i32Bit, TMP3, Value);
+      break;
+    case 8:
+      mov(TMP3, Value.X());
+      break;
+    default:
+      LOGMAN_MSG_A_FMT("Unhandled {} size: {}", __func__, Size);
+      break;
+  }
+
+  ARMEmitter::ForwardLabel BackwardImpl{};
+  ARMEmitter::ForwardLabel Done{};
+
+  cbnz(ARMEmitter::Size::i64Bit, Direction, &BackwardImpl);
+
+  for (int32_t Direction : { 1, -1 }) {
+    const int32_t SizeDirection = Size * Direction;
+    const bool Vectorize = Direction == 1 && !Op->IsAtomic;
+
+    ARMEmitter::BackwardLabel Again{};
+    ARMEmitter::ForwardLabel Scalar{};
+    ARMEmitter::ForwardLabel Found{};
+
+    if (Vectorize) {
+      dup(ElementSize, VTMP3.Q(), TMP3);
+    }
+
+    Bind(&Again);
+    cbz(ARMEmitter::Size::i64Bit, TMP1, &Done);
+
+    if (Vectorize) {
+      cmp(ARMEmitter::Size::i64Bit, TMP1, 16 / Size);
+      b(ARMEmitter::Condition::CC_CC, &Scalar);
+      and_(ARMEmitter::Size::i64Bit, TMP4, TMP2, 0xFFF);
+      cmp(ARMEmitter::Size::i64Bit, TMP4, 0xFF0);
+      b(ARMEmitter::Condition::CC_HI, &Scalar);
+
+      ldr(VTMP1.Q(), TMP2, 0);
+      cmeq(ElementSize, VTMP1.Q(), VTMP1.Q(), VTMP3.Q());
+      if (Op->StopOnMismatch) {
+        mvn(ARMEmitter::SubRegSize::i8Bit, VTMP1.Q(), VTMP1.Q());
+      }
+      // One nibble per byte of the mask
+      shrn(ARMEmitter::SubRegSize::i8Bit, VTMP1.D(), VTMP1.D(), 4);
+      fmov(ARMEmitter::Size::i64Bit, TMP4, VTMP1.D());
+      cbnz(ARMEmitter::Size::i64Bit, TMP4, &Found);
+
+      add(ARMEmitter::Size::i64Bit, TMP2, TMP2, 16);
+      sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, 16 / Size);
+      b(&Again);
+
+      // Element index of the first set nibble, that element is included in the count
+      Bind(&Found);
+      rbit(ARMEmitter::Size::i64Bit, TMP4, TMP4);
+      clz(ARMEmitter::Size::i64Bit, TMP4, TMP4);
+      lsr(ARMEmitter::Size::i64Bit, TMP4, TMP4, 2 + ElementShift);
+      sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, TMP4);
+      sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, 1);
+      b(&Done);
+
+      Bind(&Scalar);
+    }
+
+    switch (Size) {
+      case 1:
+        ldrb<ARMEmitter::IndexType::POST>(TMP4.W(), TMP2, SizeDirection);
+        break;
+      case 2:
+        ldrh<ARMEmitter::IndexType::POST>(TMP4.W(), TMP2, SizeDirection);
+        break;
+      case 4:
+        ldr<ARMEmitter::IndexType::POST>(TMP4.W(), TMP2, SizeDirection);
+        break;
+      case 8:
+        ldr<ARMEmitter::IndexType::POST>(TMP4, TMP2, SizeDirection);
+        break;
+      default:
+        LOGMAN_MSG_A_FMT("Unhandled {} size: {}", __func__, Size);
+        break;
+    }
+    if (Op->IsAtomic) {
+      dmb(FEXCore::ARMEmitter::BarrierScope::ISHLD);
+    }
+
+    sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, 1);
+    cmp(ARMEmitter::Size::i64Bit, TMP4, TMP3);
+    b(Op->StopOnMismatch ? ARMEmitter::Condition::CC_NE : ARMEmitter::Condition::CC_EQ, &Done);
+    b(&Again);
+
+    if (Direction == 1) {
+      Bind(&BackwardImpl);
+    }
+  }
+
+  Bind(&Done);
+  sub(ARMEmitter::Size::i64Bit, Dst, Length.X(), TMP1);
+}
+
+DEF_OP(MemCmp) {
+  // Same walk as MemScan, with both addresses checked for page crossings before a vector compare.
+  const auto Op = IROp->C<IR::IROp_MemCmp>();
+
+  const int32_t Size = Op->Size;
+  const auto MemRegA = GetReg(Op->AddrA.ID());
+  const auto MemRegB = GetReg(Op->AddrB.ID());
+  const auto Length = GetReg(Op->Length.ID());
+  const auto Direction = GetReg(Op->Direction.ID());
+  const auto Dst = GetReg(Node);
+
+  const auto ElementSize =
+    Size == 1 ? ARMEmitter::SubRegSize::i8Bit :
+    Size == 2 ? ARMEmitter::SubRegSize::i16Bit :
+    Size == 4 ? ARMEmitter::SubRegSize::i32Bit :
+                ARMEmitter::SubRegSize::i64Bit;
+  const auto ElementShift = FEXCore::ilog2(static_cast<uint32_t>(Size));
+
+  // TMP1 = Remaining elements
+  // TMP2 = Address A
+  // TMP3 = Address B
+  // TMP4 = Temp value
+  mov(TMP1, Length.X());
+  if (Op->PrefixA.IsInvalid()) {
+    mov(TMP2, MemRegA.X());
+  }
+  else {
+    const auto Prefix = GetReg(Op->PrefixA.ID());
+    add(TMP2, Prefix.X(), MemRegA.X());
+  }
+
+  if (Op->PrefixB.IsInvalid()) {
+    mov(TMP3, MemRegB.X());
+  }
+  else {
+    const auto Prefix = GetReg(Op->PrefixB.ID());
+    add(TMP3, Prefix.X(), MemRegB.X());
+  }
+
+  // Scalar elements are compared in vector registers since there are no GPR temporaries left.
+  // The loads zero the upper lanes so only lane 0 decides.
+  auto LoadElement = [this, Size](ARMEmitter::VRegister Reg, ARMEmitter::Register Addr) {
+    switch (Size) {
+      case 1:
+        ldrb(Reg, Addr);
+        break;
+      case 2:
+        ldrh(Reg, Addr);
+        break;
+      case 4:
+        ldr(Reg.S(), Addr);
+        break;
+      case 8:
+        ldr(Reg.D(), Addr);
+        break;
+      default:
+        LOGMAN_MSG_A_FMT("Unhandled {} size: {}", __func__, Size);
+        break;
+    }
+  };
+
+  ARMEmitter::ForwardLabel BackwardImpl{};
+  ARMEmitter::ForwardLabel Done{};
+
+  cbnz(ARMEmitter::Size::i64Bit, Direction, &BackwardImpl);
+
+  for (int32_t Direction : { 1, -1 }) {
+    const int32_t SizeDirection = Size * Direction;
+    const bool Vectorize = Direction == 1 && !Op->IsAtomic;
+
+    ARMEmitter::BackwardLabel Again{};
+    ARMEmitter::ForwardLabel Scalar{};
+    ARMEmitter::ForwardLabel Found{};
+
+    Bind(&Again);
+    cbz(ARMEmitter::Size::i64Bit, TMP1, &Done);
+
+    if (Vectorize) {
+      cmp(ARMEmitter::Size::i64Bit, TMP1, 16 / Size);
+      b(ARMEmitter::Condition::CC_CC, &Scalar);
+      and_(ARMEmitter::Size::i64Bit, TMP4, TMP2, 0xFFF);
+      cmp(ARMEmitter::Size::i64Bit, TMP4, 0xFF0);
+      b(ARMEmitter::Condition::CC_HI, &Scalar);
+      and_(ARMEmitter::Size::i64Bit, TMP4, TMP3, 0xFFF);
+      cmp(ARMEmitter::Size::i64Bit, TMP4, 0xFF0);
+      b(ARMEmitter::Condition::CC_HI, &Scalar);
+
+      ldr(VTMP1.Q(), TMP2, 0);
+      ldr(VTMP2.Q(), TMP3, 0);
+      cmeq(ElementSize, VTMP1.Q(), VTMP1.Q(), VTMP2.Q());
+      if (Op->StopOnMismatch) {
+        mvn(ARMEmitter::SubRegSize::i8Bit, VTMP1.Q(), VTMP1.Q());
+      }
+      // One nibble per byte of the mask
+      shrn(ARMEmitter::SubRegSize::i8Bit, VTMP1.D(), VTMP1.D(), 4);
+      fmov(ARMEmitter::Size::i64Bit, TMP4, VTMP1.D());
+      cbnz(ARMEmitter::Size::i64Bit, TMP4, &Found);
+
+      add(ARMEmitter::Size::i64Bit, TMP2, TMP2, 16);
+      add(ARMEmitter::Size::i64Bit, TMP3, TMP3, 16);
+      sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, 16 / Size);
+      b(&Again);
+
+      // Element index of the first set nibble, that element is included in the count
+      Bind(&Found);
+      rbit(ARMEmitter::Size::i64Bit, TMP4, TMP4);
+      clz(ARMEmitter::Size::i64Bit, TMP4, TMP4);
+      lsr(ARMEmitter::Size::i64Bit, TMP4, TMP4, 2 + ElementShift);
+      sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, TMP4);
+      sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, 1);
+      b(&Done);
+
+      Bind(&Scalar);
+    }
+
+    LoadElement(VTMP1, TMP2);
+    LoadElement(VTMP2, TMP3);
+    if (Op->IsAtomic) {
+      dmb(FEXCore::ARMEmitter::BarrierScope::ISHLD);
+    }
+
+    if (SizeDirection >= 0) {
+      add(ARMEmitter::Size::i64Bit, TMP2, TMP2, Size);
+      add(ARMEmitter::Size::i64Bit, TMP3, TMP3, Size);
+    }
+    else {
+      sub(ARMEmitter::Size::i64Bit, TMP2, TMP2, Size);
+      sub(ARMEmitter::Size::i64Bit, TMP3, TMP3, Size);
+    }
+    sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, 1);
+
+    cmeq(ElementSize, VTMP1.Q(), VTMP1.Q(), VTMP2.Q());
+    fmov(ARMEmitter::Size::i64Bit, TMP4, VTMP1.D());
+    if (Op->StopOnMismatch) {
+      tbz(TMP4, 0, &Done);
+    }
+    else {
+      tbnz(TMP4, 0, &Done);
+    }
+    b(&Again);
+
+    if (Direction == 1) {
+      Bind(&BackwardImpl);
+    }
+  }
+
+  Bind(&Done);
+  sub(ARMEmitter::Size::i64Bit, Dst, Length.X(), TMP1);
+}
+
 DEF_OP(CacheLineClear) {
   auto Op = IROp->C<IR::IROp_CacheLineClear>();
 
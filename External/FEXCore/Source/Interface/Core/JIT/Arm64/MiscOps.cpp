@@ -8,6 +8,7 @@ $end_info$
 #include <syscall.h>
 #endif
 
+#include "Interface/Context/Context.h"
 #include "Interface/Core/ArchHelpers/CodeEmitter/Emitter.h"
 #include "Interface/Core/JIT/Arm64/JITClass.h"
 #include "FEXCore/Debug/InternalThreadState.h"
@@ -103,6 +104,15 @@ DEF_OP(GetRoundingMode) {
   orr(ARMEmitter::Size::i64Bit, Dst, Dst, TMP2.R());
 
   bfi(ARMEmitter::Size::i64Bit, Dst, TMP2, 0, 2);
+
+  // Only the guest visible options
+  and_(ARMEmitter::Size::i64Bit, Dst, Dst, 0b111);
+
+  if (CTX->HostFeatures.SupportsFlushInputsToZero) {
+    // Insert the FIZ flag
+    mrs(TMP1, ARMEmitter::SystemRegister::FPCR);
+    bfi(ARMEmitter::Size::i64Bit, Dst, TMP1, 3, 1);
+  }
 }
 
 DEF_OP(SetRoundingMode) {
@@ -136,6 +146,12 @@ DEF_OP(SetRoundingMode) {
   lsr(ARMEmitter::Size::i64Bit, TMP2, Src, 2);
   bfi(ARMEmitter::Size::i64Bit, TMP1, TMP2, 24, 1);
 
+  if (CTX->HostFeatures.SupportsFlushInputsToZero) {
+    // Insert the FIZ flag
+    lsr(ARMEmitter::Size::i64Bit, TMP2, Src, 3);
+    bfi(ARMEmitter::Size::i64Bit, TMP1, TMP2, 0, 1);
+  }
+
   // Now save the new FPCR
   msr(ARMEmitter::SystemRegister::FPCR, TMP1);
 }
@@ -143,7 +159,7 @@ DEF_OP(SetRoundingMode) {
 DEF_OP(Print) {
   auto Op = IROp->C<IR::IROp_Print>();
 
-  PushDynamicRegsAndLR(TMP1);
+  PushLiveDynamicRegsAndLR(TMP1);
   SpillStaticRegs(TMP1);
 
   if (IsGPR(Op->Value.ID())) {
@@ -159,7 +175,7 @@ DEF_OP(Print) {
   blr(ARMEmitter::Reg::r3);
 
   FillStaticRegs();
-  PopDynamicRegsAndLR();
+  PopLiveDynamicRegsAndLR();
 }
 
 #ifndef _WIN32
@@ -241,6 +257,31 @@ DEF_OP(Yield) {
   yield();
 }
 
+DEF_OP(SpinWait) {
+  auto Op = IROp->C<IR::IROp_SpinWait>();
+
+  auto Addr = GetReg(Op->Addr.ID());
+  ARMEmitter::ForwardLabel SkipWait;
+
+  // Arm the exclusive monitor on the polled address, a write from another core clears it and wakes the WFE.
+  // Byte sized so an unaligned guest address can't fault. The kernel event stream bounds the wait.
+  ldaxrb(TMP1, Addr);
+
+  // A write that lands between the loop's own poll and arming the monitor doesn't wake the WFE.
+  // Only wait when this loads the same byte from the same address as the thread's previous SpinWait, otherwise spin again.
+  ldr(TMP2, STATE, offsetof(FEXCore::Core::CpuStateFrame, SpinWaitAddress));
+  ldr(TMP3, STATE, offsetof(FEXCore::Core::CpuStateFrame, SpinWaitValue));
+  cmp(ARMEmitter::Size::i64Bit, TMP2, Addr);
+  ccmp(ARMEmitter::Size::i64Bit, TMP3, TMP1, ARMEmitter::StatusFlags::None, ARMEmitter::Condition::CC_EQ);
+  b(ARMEmitter::Condition::CC_NE, &SkipWait);
+  wfe();
+  Bind(&SkipWait);
+  clrex();
+
+  str(Addr.X(), STATE, offsetof(FEXCore::Core::CpuStateFrame, SpinWaitAddress));
+  str(TMP1, STATE, offsetof(FEXCore::Core::CpuStateFrame, SpinWaitValue));
+}
+
 #undef DEF_OP
 }
 
@@ -4,6 +4,7 @@ tags: backend|arm64
 $end_info$
 */
 
+#include "Interface/Context/Context.h"
 #include "Interface/Core/ArchHelpers/CodeEmitter/Emitter.h"
 #include "Interface/Core/ArchHelpers/CodeEmitter/Registers.h"
 #include "Interface/Core/JIT/Arm64/JITClass.h"
@@ -3178,6 +3179,340 @@ DEF_OP(VRev64) {
   }
 }
 
+
+void Arm64JITCore::EmitPCMPXSTRXFlags(ARMEmitter::Register Dst, uint16_t Control) {
+  const uint32_t NumElements = (Control & 1) != 0 ? 8 : 16;
+
+  switch ((Control >> 4) & 0b11) {
+    case 0b01:
+      // Negative
+      eor(ARMEmitter::Size::i32Bit, TMP1, TMP1, (1U << NumElements) - 1);
+      break;
+    case 0b11:
+      // Negative masked, only the valid elements are inverted
+      movz(ARMEmitter::Size::i32Bit, TMP4, 1);
+      lslv(ARMEmitter::Size::i32Bit, TMP4, TMP4, TMP2);
+      sub(ARMEmitter::Size::i32Bit, TMP4, TMP4, 1);
+      eor(ARMEmitter::Size::i32Bit, TMP1, TMP1, TMP4);
+      break;
+    default:
+      break;
+  }
+
+  // ZF: The string has a NUL
+  cmp(ARMEmitter::Size::i32Bit, TMP2, NumElements);
+  cset(ARMEmitter::Size::i32Bit, TMP4, ARMEmitter::Condition::CC_CC);
+  orr(ARMEmitter::Size::i32Bit, Dst, TMP1, TMP4, ARMEmitter::ShiftType::LSL, 16);
+
+  // SF: The set has a NUL
+  cmp(ARMEmitter::Size::i32Bit, TMP3, NumElements);
+  cset(ARMEmitter::Size::i32Bit, TMP4, ARMEmitter::Condition::CC_CC);
+  orr(ARMEmitter::Size::i32Bit, Dst, Dst, TMP4, ARMEmitter::ShiftType::LSL, 17);
+
+  // CF: The result is non-zero
+  tst(ARMEmitter::Size::i32Bit, TMP1, TMP1);
+  cset(ARMEmitter::Size::i32Bit, TMP4, ARMEmitter::Condition::CC_NE);
+  orr(ARMEmitter::Size::i32Bit, Dst, Dst, TMP4, ARMEmitter::ShiftType::LSL, 18);
+
+  // OF: The first bit of the result
+  and_(ARMEmitter::Size::i32Bit, TMP4, TMP1, 1);
+  orr(ARMEmitter::Size::i32Bit, Dst, Dst, TMP4, ARMEmitter::ShiftType::LSL, 19);
+}
+
+void Arm64JITCore::EmitPCMPXSTRX(ARMEmitter::Register Dst, ARMEmitter::VRegister LHS, ARMEmitter::VRegister RHS,
+                                 bool IsExplicit, ARMEmitter::Register RAX, ARMEmitter::Register RDX, uint16_t Control) {
+  const bool IsWords = (Control & 1) != 0;
+  const bool IsSigned = (Control & 0b10) != 0;
+  const auto Aggregation = (Control >> 2) & 0b11;
+
+  const auto SubRegSize = IsWords ? ARMEmitter::SubRegSize::i16Bit : ARMEmitter::SubRegSize::i8Bit;
+  const uint32_t NumElements = IsWords ? 8 : 16;
+  const uint32_t ElementBytes = IsWords ? 2 : 1;
+  const uint32_t FullMask = (1U << NumElements) - 1;
+
+  ARMEmitter::ForwardLabel Weights;
+  ARMEmitter::ForwardLabel Indices;
+  ARMEmitter::ForwardLabel PastConstants;
+  ARMEmitter::ForwardLabel Done;
+
+  // Gathers the all ones or all zero elements of Src in to a bitmask, clobbers Src and Tmp.
+  const auto PackMask = [&](ARMEmitter::Register Mask, ARMEmitter::VRegister Src, ARMEmitter::VRegister Tmp) {
+    if (IsWords) {
+      xtn(ARMEmitter::SubRegSize::i8Bit, Src, Src);
+      ldr(Tmp.D(), &Weights);
+      and_(Src.D(), Src.D(), Tmp.D());
+      addv(ARMEmitter::SubRegSize::i8Bit, Src.D(), Src.D());
+      umov<ARMEmitter::SubRegSize::i8Bit>(Mask, Src, 0);
+    }
+    else {
+      ldr(Tmp.Q(), &Weights);
+      and_(Src.Q(), Src.Q(), Tmp.Q());
+      addp(ARMEmitter::SubRegSize::i8Bit, Src.Q(), Src.Q(), Src.Q());
+      addp(ARMEmitter::SubRegSize::i8Bit, Src.D(), Src.D(), Src.D());
+      addp(ARMEmitter::SubRegSize::i8Bit, Src.D(), Src.D(), Src.D());
+      umov<ARMEmitter::SubRegSize::i16Bit>(Mask, Src, 0);
+    }
+  };
+
+  // Mask = (1 << Length) - 1
+  const auto LengthMask = [&](ARMEmitter::Register Mask, ARMEmitter::Register Length) {
+    movz(ARMEmitter::Size::i32Bit, Mask, 1);
+    lslv(ARMEmitter::Size::i32Bit, Mask, Mask, Length);
+    sub(ARMEmitter::Size::i32Bit, Mask, Mask, 1);
+  };
+
+  // String lengths, TMP3 for LHS and TMP2 for RHS.
+  if (IsExplicit) {
+    const auto ExplicitLength = [&](ARMEmitter::Register Length, ARMEmitter::Register Src) {
+      if ((Control & 0x100) != 0) {
+        mov(ARMEmitter::Size::i64Bit, Length, Src);
+      }
+      else {
+        sxtw(Length.X(), Src.W());
+      }
+
+      // The absolute value saturates to the element count, the unsigned compare also catches INT64_MIN.
+      if (CTX->HostFeatures.SupportsCSSC) {
+        abs(ARMEmitter::Size::i64Bit, Length, Length);
+        umin(ARMEmitter::Size::i64Bit, Length, Length, NumElements);
+      }
+      else {
+        cmp(ARMEmitter::Size::i64Bit, Length, 0);
+        cneg(ARMEmitter::Size::i64Bit, Length, Length, ARMEmitter::Condition::CC_MI);
+        movz(ARMEmitter::Size::i64Bit, TMP4, NumElements);
+        cmp(ARMEmitter::Size::i64Bit, Length, TMP4);
+        csel(ARMEmitter::Size::i64Bit, Length, TMP4, Length, ARMEmitter::Condition::CC_HI);
+      }
+    };
+
+    ExplicitLength(TMP3, RAX);
+    ExplicitLength(TMP2, RDX);
+  }
+  else {
+    const auto ImplicitLength = [&](ARMEmitter::Register Length, ARMEmitter::VRegister Src) {
+      // Index of the first NUL, or the element count without one.
+      cmeq(SubRegSize, VTMP1.Q(), Src.Q());
+      PackMask(Length, VTMP1, VTMP2);
+      orr(ARMEmitter::Size::i32Bit, Length, Length, 1U << NumElements);
+      rbit(ARMEmitter::Size::i32Bit, Length, Length);
+      clz(ARMEmitter::Size::i32Bit, Length, Length);
+    };
+
+    ImplicitLength(TMP3, LHS);
+    ImplicitLength(TMP2, RHS);
+  }
+
+  // Intermediate result in TMP1.
+  // The loops over the set are unrolled and stop at its length, so short sets only pay for their own elements.
+  switch (Aggregation) {
+    case 0b00: {
+      // Equal any: Compare every string element against each set element.
+      movi(ARMEmitter::SubRegSize::i64Bit, VTMP1.Q(), 0);
+      for (uint32_t i = 0; i < NumElements; ++i) {
+        cmp(ARMEmitter::Size::i32Bit, TMP3, i);
+        b(ARMEmitter::Condition::CC_LS, &Done);
+        dup(SubRegSize, VTMP2.Q(), LHS.Q(), i);
+        cmeq(SubRegSize, VTMP2.Q(), VTMP2.Q(), RHS.Q());
+        orr(VTMP1.Q(), VTMP1.Q(), VTMP2.Q());
+      }
+      Bind(&Done);
+
+      PackMask(TMP1, VTMP1, VTMP2);
+      LengthMask(TMP4, TMP2);
+      and_(ARMEmitter::Size::i32Bit, TMP1, TMP1, TMP4);
+      break;
+    }
+    case 0b01: {
+      // Ranges: Each pair of set elements is an inclusive [lower, upper] range, an odd trailing element is ignored.
+      movi(ARMEmitter::SubRegSize::i64Bit, VTMP1.Q(), 0);
+      for (uint32_t i = 0; i < NumElements; i += 2) {
+        cmp(ARMEmitter::Size::i32Bit, TMP3, i + 1);
+        b(ARMEmitter::Condition::CC_LS, &Done);
+        dup(SubRegSize, VTMP2.Q(), LHS.Q(), i);
+        dup(SubRegSize, VTMP3.Q(), LHS.Q(), i + 1);
+        if (IsSigned) {
+          cmge(SubRegSize, VTMP2.Q(), RHS.Q(), VTMP2.Q());
+          cmge(SubRegSize, VTMP3.Q(), VTMP3.Q(), RHS.Q());
+        }
+        else {
+          cmhs(SubRegSize, VTMP2.Q(), RHS.Q(), VTMP2.Q());
+          cmhs(SubRegSize, VTMP3.Q(), VTMP3.Q(), RHS.Q());
+        }
+        and_(VTMP2.Q(), VTMP2.Q(), VTMP3.Q());
+        orr(VTMP1.Q(), VTMP1.Q(), VTMP2.Q());
+      }
+      Bind(&Done);
+
+      PackMask(TMP1, VTMP1, VTMP2);
+      LengthMask(TMP4, TMP2);
+      and_(ARMEmitter::Size::i32Bit, TMP1, TMP1, TMP4);
+      break;
+    }
+    case 0b10: {
+      // Equal each: Element wise compare where both are valid, true where both are invalid.
+      cmp(ARMEmitter::Size::i32Bit, TMP3, TMP2);
+      csel(ARMEmitter::Size::i32Bit, TMP4, TMP3, TMP2, ARMEmitter::Condition::CC_LO);
+      csel(ARMEmitter::Size::i32Bit, Dst, TMP2, TMP3, ARMEmitter::Condition::CC_LO);
+
+      movz(ARMEmitter::Size::i32Bit, TMP1, 1);
+      lslv(ARMEmitter::Size::i32Bit, TMP4, TMP1, TMP4);
+      sub(ARMEmitter::Size::i32Bit, TMP4, TMP4, 1);
+      lslv(ARMEmitter::Size::i32Bit, Dst, TMP1, Dst);
+      sub(ARMEmitter::Size::i32Bit, Dst, Dst, 1);
+      eor(ARMEmitter::Size::i32Bit, Dst, Dst, FullMask);
+
+      cmeq(SubRegSize, VTMP1.Q(), LHS.Q(), RHS.Q());
+      PackMask(TMP1, VTMP1, VTMP2);
+      and_(ARMEmitter::Size::i32Bit, TMP1, TMP1, TMP4);
+      orr(ARMEmitter::Size::i32Bit, TMP1, TMP1, Dst);
+      break;
+    }
+    case 0b11: {
+      // Equal ordered: The set is a substring, each string position ANDs together the compares of
+      // the set shifted to start there. Compares past the end of the string are true, so
+      // substrings cut off by the end of a full length string still match.
+      cmp(ARMEmitter::Size::i32Bit, TMP3, TMP2);
+      csel(ARMEmitter::Size::i32Bit, TMP4, TMP3, TMP2, ARMEmitter::Condition::CC_LO);
+
+      // VTMP2 = String length - position, signed
+      ldr(VTMP3.Q(), &Indices);
+      dup(SubRegSize, VTMP2.Q(), TMP2);
+      sub(SubRegSize, VTMP2.Q(), VTMP2.Q(), VTMP3.Q());
+
+      movi(ARMEmitter::SubRegSize::i64Bit, VTMP1.Q(), ~0ULL);
+      for (uint32_t i = 0; i < NumElements; ++i) {
+        cmp(ARMEmitter::Size::i32Bit, TMP4, i);
+        b(ARMEmitter::Condition::CC_LS, &Done);
+        dup(SubRegSize, VTMP4.Q(), LHS.Q(), i);
+        if (i == 0) {
+          cmeq(SubRegSize, VTMP3.Q(), RHS.Q(), VTMP4.Q());
+        }
+        else {
+          ext(VTMP3.Q(), RHS.Q(), RHS.Q(), i * ElementBytes);
+          cmeq(SubRegSize, VTMP3.Q(), VTMP3.Q(), VTMP4.Q());
+        }
+
+        // Clear positions where the shifted string element is valid and mismatches.
+        movi(SubRegSize, VTMP4.Q(), i);
+        cmgt(SubRegSize, VTMP4.Q(), VTMP2.Q(), VTMP4.Q());
+        bic(VTMP4.Q(), VTMP4.Q(), VTMP3.Q());
+        bic(VTMP1.Q(), VTMP1.Q(), VTMP4.Q());
+      }
+      Bind(&Done);
+
+      PackMask(TMP1, VTMP1, VTMP3);
+
+      // Only positions where the whole set fits in the string can match, unless the string is
+      // full length. An empty set matches everywhere.
+      sub(ARMEmitter::Size::i32Bit, TMP4, TMP2, TMP3);
+      add(ARMEmitter::Size::i32Bit, TMP4, TMP4, 1);
+      cmp(ARMEmitter::Size::i32Bit, TMP4, 0);
+      csel(ARMEmitter::Size::i32Bit, TMP4, TMP4, ARMEmitter::Reg::zr, ARMEmitter::Condition::CC_GT);
+      LengthMask(Dst, TMP4);
+      movz(ARMEmitter::Size::i32Bit, TMP4, FullMask);
+      cmp(ARMEmitter::Size::i32Bit, TMP2, NumElements);
+      csel(ARMEmitter::Size::i32Bit, Dst, TMP4, Dst, ARMEmitter::Condition::CC_EQ);
+      cmp(ARMEmitter::Size::i32Bit, TMP3, 0);
+      csel(ARMEmitter::Size::i32Bit, Dst, TMP4, Dst, ARMEmitter::Condition::CC_EQ);
+      and_(ARMEmitter::Size::i32Bit, TMP1, TMP1, Dst);
+      break;
+    }
+  }
+
+  EmitPCMPXSTRXFlags(Dst, Control);
+
+  b(&PastConstants);
+  Bind(&Weights);
+  dc64(0x8040201008040201ULL);
+  dc64(0x8040201008040201ULL);
+  if (Aggregation == 0b11) {
+    Bind(&Indices);
+    if (IsWords) {
+      dc64(0x0003'0002'0001'0000ULL);
+      dc64(0x0007'0006'0005'0004ULL);
+    }
+    else {
+      dc64(0x0706'0504'0302'0100ULL);
+      dc64(0x0F0E'0D0C'0B0A'0908ULL);
+    }
+  }
+  Bind(&PastConstants);
+}
+
+DEF_OP(VPCMPESTRX) {
+  const auto Op = IROp->C<IR::IROp_VPCMPESTRX>();
+
+  EmitPCMPXSTRX(GetReg(Node), GetVReg(Op->LHS.ID()), GetVReg(Op->RHS.ID()),
+                true, GetReg(Op->RAX.ID()), GetReg(Op->RDX.ID()), Op->Control);
+}
+
+DEF_OP(VPCMPISTRX) {
+  const auto Op = IROp->C<IR::IROp_VPCMPISTRX>();
+  const auto Control = Op->Control;
+  const auto Aggregation = (Control >> 2) & 0b11;
+
+  const auto Dst = GetReg(Node);
+  const auto LHS = GetVReg(Op->LHS.ID());
+  const auto RHS = GetVReg(Op->RHS.ID());
+
+  // Equal any maps to MATCH and equal each to a compare, both need SVE2 and
+  // BEXT to pack the result predicate in to a mask.
+  // Everything else takes the NEON lowering.
+  const bool IsEqualAny = Aggregation == 0b00;
+  const bool IsEqualEach = Aggregation == 0b10;
+  if (!HostSupportsSVE2 || !HostSupportsSVEBitPerm || !(IsEqualAny || IsEqualEach)) {
+    EmitPCMPXSTRX(Dst, LHS, RHS, false, ARMEmitter::Reg::zr, ARMEmitter::Reg::zr, Control);
+    return;
+  }
+
+  const bool IsWords = (Control & 1) != 0;
+  const auto SubRegSize = IsWords ? ARMEmitter::SubRegSize::i16Bit : ARMEmitter::SubRegSize::i8Bit;
+  const uint32_t NumElements = IsWords ? 8 : 16;
+
+  const auto Pg = ARMEmitter::PReg::p0;
+  const auto ValidLHS = ARMEmitter::PReg::p1;
+  const auto ValidRHS = ARMEmitter::PReg::p2;
+  const auto Result = ARMEmitter::PReg::p3;
+  const auto BothInvalid = ARMEmitter::PReg::p4;
+
+  // Only the low 128-bits take part, regardless of the vector length.
+  ptrue<ARMEmitter::SubRegSize::i8Bit>(Pg, ARMEmitter::PredicatePattern::SVE_VL16);
+
+  // Elements before the first NUL are valid
+  cmpeq(SubRegSize, ValidLHS, Pg.Zeroing(), LHS.Z(), 0);
+  brkb(ValidLHS, Pg.Zeroing(), ValidLHS);
+  cmpeq(SubRegSize, ValidRHS, Pg.Zeroing(), RHS.Z(), 0);
+  brkb(ValidRHS, Pg.Zeroing(), ValidRHS);
+
+  if (IsEqualAny) {
+    // Invalid set elements become NUL, which no valid string element can be equal to.
+    movi(ARMEmitter::SubRegSize::i64Bit, VTMP2.Q(), 0);
+    sel(SubRegSize, VTMP1.Z(), ValidLHS, LHS.Z(), VTMP2.Z());
+    match(SubRegSize, Result, ValidRHS.Zeroing(), RHS.Z(), VTMP1.Z());
+  }
+  else {
+    // Equal where both are valid, true where both are invalid, false otherwise.
+    cmpeq(SubRegSize, Result, Pg.Zeroing(), LHS.Z(), RHS.Z());
+    and_(Result, ValidLHS.Zeroing(), Result, ValidRHS);
+    nor(BothInvalid, Pg.Zeroing(), ValidLHS, ValidRHS);
+    orr(Result, Pg.Zeroing(), Result, BothInvalid);
+  }
+
+  // Gather the low bit of every active element in to a bitmask, one 64-bit lane at a time.
+  cpy(SubRegSize, VTMP1.Z(), Result.Zeroing(), 1);
+  dup_imm(SubRegSize, VTMP2.Z(), 1);
+  bext(ARMEmitter::SubRegSize::i64Bit, VTMP1.Z(), VTMP1.Z(), VTMP2.Z());
+  umov<ARMEmitter::SubRegSize::i64Bit>(TMP1, VTMP1, 0);
+  umov<ARMEmitter::SubRegSize::i64Bit>(TMP2, VTMP1, 1);
+  orr(ARMEmitter::Size::i64Bit, TMP1, TMP1, TMP2, ARMEmitter::ShiftType::LSL, NumElements / 2);
+
+  // Lengths of the valid string and set
+  cntp(SubRegSize, TMP2, Pg, ValidRHS);
+  cntp(SubRegSize, TMP3, Pg, ValidLHS);
+
+  EmitPCMPXSTRXFlags(Dst, Control);
+}
+
 #undef DEF_OP
 }
 
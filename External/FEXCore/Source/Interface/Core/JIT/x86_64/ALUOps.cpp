@@ -69,6 +69,13 @@ DEF_OP(CycleCounter) {
   rdtsc();
   shl(rdx, 32);
   or_(rax, rdx);
+  if (CTX->ScaleCycleCounter) {
+    // (Counter * Multiplier) >> Shift over the full 128-bit product in rdx:rax
+    const auto &Scale = CTX->CycleCounterScale;
+    mov(rcx, Scale.Multiplier);
+    mul(rcx);
+    shrd(rax, rdx, Scale.Shift);
+  }
   mov (GetDst<RA_64>(Node), rax);
 #endif
 }
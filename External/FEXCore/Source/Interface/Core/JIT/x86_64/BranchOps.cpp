@@ -68,37 +68,77 @@ DEF_OP(ExitFunction) {
   uint64_t NewRIP;
 
   if (IsInlineConstant(Op->NewRIP, &NewRIP) || IsInlineEntrypointOffset(Op->NewRIP, &NewRIP)) {
-    Label l_BranchHost;
+    auto l_BranchHost = InsertNamedSymbolLiteral(FEXCore::CPU::RelocNamedSymbolLiteral::NamedSymbol::SYMBOL_LITERAL_EXITFUNCTION_LINKER);
     Label l_BranchGuest;
 
-    lea(rax, ptr[rip + l_BranchHost]);
+    lea(rax, ptr[rip + l_BranchHost.Offset]);
     jmp(qword[rax]);
 
-    L(l_BranchHost);
-    //FEX_TODO(this is not per thread)
-    dq(ThreadState->CurrentFrame->Pointers.Common.ExitFunctionLinker);
+    PlaceNamedSymbolLiteral(l_BranchHost);
     L(l_BranchGuest);
     dq(NewRIP);
   } else {
     Xbyak::Reg RipReg = GetSrc<RA_64>(Op->NewRIP.ID());
 
+    // Code in a shared code cache can be run by multiple threads at once, which would tear the inline cache.
+    const bool InlineCache = CTX->Config.IndirectBranchCache && !CTX->IsCodeCacheShared();
+    Label InlineCacheData;
+
+    if (InlineCache) {
+      // Inline cache layout: { GuestRIP, HostCode, Epoch }
+      Label L1Lookup;
+
+      // Epoch of the target's page
+      mov(rax, RipReg);
+      shr(rax, 12);
+      and_(eax, LookupCache::INVALIDATION_EPOCH_PAGES - 1);
+      mov(rdx, qword [STATE + offsetof(FEXCore::Core::CpuStateFrame, Pointers.Common.LookupCacheEpochPointer)]);
+      mov(rdx, qword [rdx + rax * 8]);
+
+      cmp(qword [rip + InlineCacheData], RipReg);
+      jne(L1Lookup);
+      cmp(qword [rip + InlineCacheData + 16], rdx);
+      jne(L1Lookup);
+      jmp(qword [rip + InlineCacheData + 8]);
+
+      L(L1Lookup);
+    }
+
     // L1 Cache
+    // rdx holds the epoch when the inline cache is used.
     mov(rcx, qword [STATE + offsetof(FEXCore::Core::CpuStateFrame, Pointers.Common.L1Pointer)]);
 
     mov(rax, RipReg);
 
-    and_(rax, LookupCache::L1_ENTRIES_MASK);
+    and_(rax, qword [STATE + offsetof(FEXCore::Core::CpuStateFrame, Pointers.Common.L1Mask)]);
     shl(rax, 4);
 
     Xbyak::RegExp LookupBase = rcx + rax;
 
     cmp(qword[LookupBase + 8], RipReg);
     jne(FullLookup);
-    jmp(qword[LookupBase + 0]);
+    if (InlineCache) {
+      // Refill the inline cache with this target
+      mov(rcx, qword[LookupBase + 0]);
+      mov(qword [rip + InlineCacheData], RipReg);
+      mov(qword [rip + InlineCacheData + 8], rcx);
+      mov(qword [rip + InlineCacheData + 16], rdx);
+      jmp(rcx);
+    }
+    else {
+      jmp(qword[LookupBase + 0]);
+    }
 
     L(FullLookup);
     mov(qword [STATE + offsetof(FEXCore::Core::CpuStateFrame, State.rip)], RipReg);
     jmp(qword [STATE + offsetof(FEXCore::Core::CpuStateFrame, Pointers.Common.DispatcherLoopTop)]);
+
+    if (InlineCache) {
+      L(InlineCacheData);
+      dq(0);
+      dq(0);
+      dq(~0ULL);
+    }
   }
 
 #ifdef BLOCKSTATS
@@ -106,6 +146,74 @@ DEF_OP(ExitFunction) {
 #endif
 }
 
+DEF_OP(PushReturnStack) {
+  auto Op = IROp->C<IR::IROp_PushReturnStack>();
+
+  uint64_t ReturnRIP;
+  if (!IsInlineConstant(Op->ReturnRIP, &ReturnRIP) && !IsInlineEntrypointOffset(Op->ReturnRIP, &ReturnRIP)) {
+    // Without a known return address there is nothing to link against
+    return;
+  }
+
+  Label l_ReturnStub;
+  auto l_BranchHost = InsertNamedSymbolLiteral(FEXCore::CPU::RelocNamedSymbolLiteral::NamedSymbol::SYMBOL_LITERAL_EXITFUNCTION_LINKER);
+  Label l_BranchGuest;
+  Label l_Skip;
+
+  // ReturnStack[ReturnStackTop++ & RETURN_STACK_MASK] = { ReturnRIP, ReturnStub }
+  mov(rax, qword [STATE + offsetof(FEXCore::Core::CpuStateFrame, ReturnStackTop)]);
+  mov(rcx, rax);
+  and_(rcx, FEXCore::Core::CpuStateFrame::RETURN_STACK_MASK);
+  shl(rcx, 4);
+  mov(rdx, qword [rip + l_BranchGuest]);
+  mov(qword [STATE + rcx + offsetof(FEXCore::Core::CpuStateFrame, ReturnStack)], rdx);
+  lea(rdx, ptr [rip + l_ReturnStub]);
+  mov(qword [STATE + rcx + offsetof(FEXCore::Core::CpuStateFrame, ReturnStack) + 8], rdx);
+  inc(rax);
+  mov(qword [STATE + offsetof(FEXCore::Core::CpuStateFrame, ReturnStackTop)], rax);
+  jmp(l_Skip, T_NEAR);
+
+  // Out of line exit to the return address, taken by a correctly predicted RET.
+  // This is a regular linkable exit, so it gets block linked and delinked like any other.
+  L(l_ReturnStub);
+  lea(rax, ptr[rip + l_BranchHost.Offset]);
+  jmp(qword[rax]);
+
+  PlaceNamedSymbolLiteral(l_BranchHost);
+  L(l_BranchGuest);
+  dq(ReturnRIP);
+
+  L(l_Skip);
+}
+
+DEF_OP(ReturnStackLookup) {
+  auto Op = IROp->C<IR::IROp_ReturnStackLookup>();
+  Xbyak::Reg RipReg = GetSrc<RA_64>(Op->NewRIP.ID());
+
+  Label l_Mispredict;
+
+  // Entry = ReturnStack[--ReturnStackTop & RETURN_STACK_MASK]
+  mov(rax, qword [STATE + offsetof(FEXCore::Core::CpuStateFrame, ReturnStackTop)]);
+  dec(rax);
+  mov(qword [STATE + offsetof(FEXCore::Core::CpuStateFrame, ReturnStackTop)], rax);
+  and_(rax, FEXCore::Core::CpuStateFrame::RETURN_STACK_MASK);
+  shl(rax, 4);
+
+  // Stack manipulation, longjmp, or an overflowed stack. Leave through the regular exit.
+  cmp(qword [STATE + rax + offsetof(FEXCore::Core::CpuStateFrame, ReturnStack)], RipReg);
+  jne(l_Mispredict);
+  mov(rcx, qword [STATE + rax + offsetof(FEXCore::Core::CpuStateFrame, ReturnStack) + 8]);
+  test(rcx, rcx);
+  jz(l_Mispredict);
+
+  if (SpillSlots) {
+    add(rsp, SpillSlots * MaxSpillSlotSize);
+  }
+  jmp(rcx);
+
+  L(l_Mispredict);
+}
+
 DEF_OP(Jump) {
   const auto Op = IROp->C<IR::IROp_Jump>();
   const auto Target = Op->TargetBlock.ID();
@@ -207,9 +315,7 @@ DEF_OP(Thunk) {
 
   mov(rdi, GetSrc<RA_64>(Op->ArgPtr.ID()));
 
-  auto thunkFn = static_cast<Context::ContextImpl*>(ThreadState->CTX)->ThunkHandler->LookupThunk(Op->ThunkNameHash);
-
-  mov(rax, reinterpret_cast<uintptr_t>(thunkFn));
+  InsertNamedThunkRelocation(rax, Op->ThunkNameHash);
   call(rax);
 
   if (NumPush & 1)
@@ -348,6 +454,8 @@ void X86JITCore::RegisterBranchHandlers() {
 #define REGISTER_OP(op, x) OpHandlers[FEXCore::IR::IROps::OP_##op] = &X86JITCore::Op_##x
   REGISTER_OP(CALLBACKRETURN,    CallbackReturn);
   REGISTER_OP(EXITFUNCTION,      ExitFunction);
+  REGISTER_OP(PUSHRETURNSTACK,   PushReturnStack);
+  REGISTER_OP(RETURNSTACKLOOKUP, ReturnStackLookup);
   REGISTER_OP(JUMP,              Jump);
   REGISTER_OP(CONDJUMP,          CondJump);
   REGISTER_OP(SYSCALL,           Syscall);
@@ -12,6 +12,7 @@ $end_info$
 #include "Interface/Core/Dispatcher/X86Dispatcher.h"
 #include "Interface/Core/Interpreter/InterpreterOps.h"
 #include "Interface/Core/JIT/x86_64/JITClass.h"
+#include "Interface/Core/ObjectCache/ObjectCacheService.h"
 #include "Interface/IR/PassManager.h"
 #include "Interface/IR/Passes/RegisterAllocationPass.h"
 
@@ -27,10 +28,12 @@ $end_info$
 #include <FEXCore/Utils/EnumUtils.h>
 #include <FEXCore/Utils/LogManager.h>
 #include <FEXCore/Utils/Profiler.h>
+#include <FEXCore/Utils/Telemetry.h>
 #include <FEXCore/fextl/sstream.h>
 
 #include <algorithm>
 #include <array>
+#include <cstring>
 #include <memory>
 #include <stddef.h>
 #include <stdint.h>
@@ -103,6 +106,26 @@ void X86JITCore::Op_Unhandled(IR::IROp_Header *IROp, IR::NodeID Node) {
     LOGMAN_MSG_A_FMT("Unhandled IR Op: {}", FEXCore::IR::GetName(IROp->Op));
 #endif
   } else {
+#ifndef FEX_DISABLE_TELEMETRY
+    static_assert(FEXCore::Core::OPINDEX_MAX <= FEXCore::Telemetry::MAX_FALLBACK_COUNTERS, "Not enough fallback counters");
+
+    // Count the fallback in the per-thread telemetry counters if they exist
+    Label NoCounters;
+    mov(TMP1, qword [STATE + offsetof(FEXCore::Core::CpuStateFrame, Pointers.Common.TelemetryCounters)]);
+    test(TMP1, TMP1);
+    jz(NoCounters);
+    inc(qword [TMP1 + offsetof(FEXCore::Telemetry::ThreadCounters, Fallbacks[Info.HandlerIndex])]);
+    L(NoCounters);
+#endif
+
+    if (CTX->FallbackProfile) {
+      // Attributed to the guest instruction of the last GuestOpcode, or the block entry without one
+      const uint64_t GuestRIP = Entry + (DebugData->GuestOpcodes.empty() ? 0 : DebugData->GuestOpcodes.back().GuestEntryOffset);
+      auto Counter = CTX->GetFallbackProfileCounter(ThreadState, GuestRIP, Info.HandlerIndex, IROp->Op);
+      mov(TMP1, reinterpret_cast<uint64_t>(Counter));
+      inc(qword [TMP1]);
+    }
+
     switch(Info.ABI) {
       case FABI_VOID_U16: {
         PushRegs();
@@ -384,10 +407,11 @@ static uint64_t X86JITCore_ExitFunctionLink(FEXCore::Core::CpuStateFrame *Frame,
   }
 
   auto LinkerAddress = Frame->Pointers.Common.ExitFunctionLinker;
-  Thread->LookupCache->AddBlockLink(GuestRip, (uintptr_t)record, [record, LinkerAddress]{
+  Thread->LookupCache->AddBlockLink(GuestRip, (uintptr_t)record, [](uintptr_t HostLink, uintptr_t Linker) {
     // undo the link
-    record[0] = LinkerAddress;
-  });
+    reinterpret_cast<uint64_t*>(HostLink)[0] = Linker;
+    return FEXCore::BlockDelinkedRange{};
+  }, LinkerAddress);
 
   record[0] = HostCode;
   return HostCode;
@@ -403,14 +427,21 @@ X86JITCore::X86JITCore(FEXCore::Context::ContextImpl *ctx, FEXCore::Core::Intern
 
   RAPass = Thread->PassManager->GetPass<IR::RegisterAllocationPass>("RA");
 
-  RAPass->AllocateRegisterSet(RegisterClasses);
-  RAPass->AddRegisters(FEXCore::IR::GPRClass, NumGPRs);
-  RAPass->AddRegisters(FEXCore::IR::FPRClass, NumXMMs);
-  RAPass->AddRegisters(FEXCore::IR::GPRPairClass, NumGPRPairs);
+  const auto SetupRegisterSet = [](IR::RegisterAllocationPass *Pass) {
+    Pass->AllocateRegisterSet(RegisterClasses);
+    Pass->AddRegisters(FEXCore::IR::GPRClass, NumGPRs);
+    Pass->AddRegisters(FEXCore::IR::FPRClass, NumXMMs);
+    Pass->AddRegisters(FEXCore::IR::GPRPairClass, NumGPRPairs);
+
+    for (uint32_t i = 0; i < NumGPRPairs; ++i) {
+      Pass->AddRegisterConflict(FEXCore::IR::GPRClass, i * 2,     FEXCore::IR::GPRPairClass, i);
+      Pass->AddRegisterConflict(FEXCore::IR::GPRClass, i * 2 + 1, FEXCore::IR::GPRPairClass, i);
+    }
+  };
 
-  for (uint32_t i = 0; i < NumGPRPairs; ++i) {
-    RAPass->AddRegisterConflict(FEXCore::IR::GPRClass, i * 2,     FEXCore::IR::GPRPairClass, i);
-    RAPass->AddRegisterConflict(FEXCore::IR::GPRClass, i * 2 + 1, FEXCore::IR::GPRPairClass, i);
+  SetupRegisterSet(RAPass);
+  if (Thread->Tier0PassManager) {
+    SetupRegisterSet(Thread->Tier0PassManager->GetPass<IR::RegisterAllocationPass>("RA"));
   }
 
   for (uint32_t i = 0; i < FEXCore::IR::IROps::OP_LAST + 1; ++i) {
@@ -470,9 +501,15 @@ void X86JITCore::EmitDetectionString() {
 }
 
 void X86JITCore::ClearCache() {
+  auto ArenaLock = ClaimSharedCodeArena();
   auto CodeBuffer = GetEmptyCodeBuffer();
   setNewBuffer(CodeBuffer->Ptr, CodeBuffer->Size);
+  if (ArenaLock.owns_lock()) {
+    // Other threads may have already emitted code in to the shared arena
+    setSize(SharedArena->Offset);
+  }
   EmitDetectionString();
+  ReleaseSharedCodeArena(getSize());
 }
 
 IR::PhysicalRegister X86JITCore::GetPhys(IR::NodeID Node) const {
@@ -644,7 +681,7 @@ std::tuple<X86JITCore::SetCC, X86JITCore::CMovCC, X86JITCore::JCC> X86JITCore::G
   return { &CodeGenerator::sete , &CodeGenerator::cmove , &CodeGenerator::je  };
 }
 
-CPUBackend::CompiledCode X86JITCore::CompileCode(uint64_t Entry, [[maybe_unused]] FEXCore::IR::IRListView const *IR, [[maybe_unused]] FEXCore::Core::DebugData *DebugData, FEXCore::IR::RegisterAllocationData *RAData, bool GDBEnabled) {
+CPUBackend::CompiledCode X86JITCore::CompileCode(uint64_t Entry, [[maybe_unused]] FEXCore::IR::IRListView const *IR, [[maybe_unused]] FEXCore::Core::DebugData *DebugData, FEXCore::IR::RegisterAllocationData *RAData, bool GDBEnabled, [[maybe_unused]] bool HotBlock) {
 
   FEXCORE_PROFILE_SCOPED("x86::CompileCode");
   JumpTargets.clear();
@@ -654,6 +691,14 @@ CPUBackend::CompiledCode X86JITCore::CompileCode(uint64_t Entry, [[maybe_unused]
   this->RAData = RAData;
   this->DebugData = DebugData;
 
+  // Emission in to a shared code arena is serialized between threads.
+  // Another thread may have appended to or replaced the arena since this thread last compiled.
+  auto ArenaLock = ClaimSharedCodeArena();
+  if (ArenaLock.owns_lock()) {
+    setNewBuffer(CurrentCodeBuffer->Ptr, CurrentCodeBuffer->Size);
+    setSize(SharedArena->Offset);
+  }
+
   // Fairly excessive buffer range to make sure we don't overflow
   uint32_t BufferRange = SSACount * 16 + GDBEnabled * Dispatcher::MaxGDBPauseCheckSize;
   if ((getSize() + BufferRange) > CurrentCodeBuffer->Size) {
@@ -661,6 +706,8 @@ CPUBackend::CompiledCode X86JITCore::CompileCode(uint64_t Entry, [[maybe_unused]
   }
 
   CodeData.BlockBegin = getCurr<uint8_t*>();
+  // Relocations are relative to the start of the block so the whole block can be relocated
+  CursorEntry = getSize();
 
   // Put the code header at the start of the data block.
   Label JITCodeHeaderLabel{};
@@ -676,11 +723,10 @@ CPUBackend::CompiledCode X86JITCore::CompileCode(uint64_t Entry, [[maybe_unused]
   lea(TMP1, ptr [rip + JITCodeHeaderLabel]);
   mov(qword [STATE + offsetof(FEXCore::Core::CPUState, InlineJITBlockHeader)], TMP1);
 
-  CursorEntry = getSize();
   this->IR = IR;
 
   if (GDBEnabled) {
-    auto GDBSize = CTX->Dispatcher->GenerateGDBPauseCheck(CodeData.BlockBegin, Entry);
+    auto GDBSize = CTX->Dispatcher->GenerateGDBPauseCheck(CodeData.BlockBegin, Entry, CTX->IsGdbBreakpoint(Entry));
     setSize(getSize() + GDBSize);
   }
 
@@ -863,9 +909,46 @@ CPUBackend::CompiledCode X86JITCore::CompileCode(uint64_t Entry, [[maybe_unused]
     DebugData->Relocations = &Relocations;
   }
 
+  ReleaseSharedCodeArena(getSize());
   return CodeData;
 }
 
+CPUBackend::CompiledCode X86JITCore::RelocateJITObjectCode(uint64_t Entry, CodeSerialize::CodeObjectFileSection const *SerializationData) {
+  FEXCORE_PROFILE_SCOPED("x86::RelocateJITObjectCode");
+
+  const auto Data = SerializationData->Data;
+
+  auto ArenaLock = ClaimSharedCodeArena();
+  if (ArenaLock.owns_lock()) {
+    setNewBuffer(CurrentCodeBuffer->Ptr, CurrentCodeBuffer->Size);
+    setSize(SharedArena->Offset);
+  }
+
+  if ((getSize() + Data->HostCodeLength) > CurrentCodeBuffer->Size) {
+    CTX->ClearCodeCache(ThreadState);
+  }
+
+  const auto BlockOffset = getSize();
+  auto BlockBegin = getCurr<uint8_t*>();
+  memcpy(BlockBegin, SerializationData->HostCode, Data->HostCodeLength);
+
+  if (!ApplyRelocations(Entry, reinterpret_cast<uint64_t>(BlockBegin), BlockOffset, SerializationData->NumRelocations, SerializationData->Relocations)) {
+    // Drop the copy
+    setSize(BlockOffset);
+    ReleaseSharedCodeArena(BlockOffset);
+    return {};
+  }
+
+  setSize(BlockOffset + Data->HostCodeLength);
+  ReleaseSharedCodeArena(getSize());
+
+  return CPUBackend::CompiledCode {
+    .BlockBegin = BlockBegin,
+    .BlockEntry = BlockBegin + Data->HostEntryOffset,
+    .Size = Data->HostCodeLength,
+  };
+}
+
 fextl::unique_ptr<CPUBackend> CreateX86JITCore(FEXCore::Context::ContextImpl *ctx, FEXCore::Core::InternalThreadState *Thread) {
   return fextl::make_unique<X86JITCore>(ctx, Thread);
 }
@@ -62,7 +62,9 @@ public:
   [[nodiscard]] CPUBackend::CompiledCode CompileCode(uint64_t Entry,
                                   FEXCore::IR::IRListView const *IR,
                                   FEXCore::Core::DebugData *DebugData,
-                                  FEXCore::IR::RegisterAllocationData *RAData, bool GDBEnabled) override;
+                                  FEXCore::IR::RegisterAllocationData *RAData, bool GDBEnabled, bool HotBlock) override;
+
+  [[nodiscard]] CPUBackend::CompiledCode RelocateJITObjectCode(uint64_t Entry, CodeSerialize::CodeObjectFileSection const *SerializationData) override;
 
   [[nodiscard]] void *MapRegion(void* HostPtr, uint64_t, uint64_t) override { return HostPtr; }
 
@@ -308,6 +310,8 @@ private:
   ///< Branch ops
   DEF_OP(CallbackReturn);
   DEF_OP(ExitFunction);
+  DEF_OP(PushReturnStack);
+  DEF_OP(ReturnStackLookup);
   DEF_OP(Jump);
   DEF_OP(CondJump);
   DEF_OP(Syscall);
@@ -346,10 +350,14 @@ private:
   DEF_OP(StoreFlag);
   DEF_OP(LoadMem);
   DEF_OP(StoreMem);
+  DEF_OP(StoreMemPair);
   DEF_OP(VLoadVectorMasked);
   DEF_OP(VStoreVectorMasked);
+  DEF_OP(VGather);
   DEF_OP(MemSet);
   DEF_OP(MemCpy);
+  DEF_OP(MemScan);
+  DEF_OP(MemCmp);
   DEF_OP(CacheLineClear);
   DEF_OP(CacheLineClean);
   DEF_OP(CacheLineZero);
@@ -287,19 +287,18 @@ DEF_OP(LoadContextIndexed) {
     case 2:
     case 4:
     case 8: {
-      lea(rax, dword [STATE + Op->BaseOffset]);
       switch (OpSize) {
       case 1:
-        movzx(GetDst<RA_32>(Node), byte [rax + Index * Op->Stride]);
+        movzx(GetDst<RA_32>(Node), byte [STATE + Index * Op->Stride + Op->BaseOffset]);
         break;
       case 2:
-        movzx(GetDst<RA_32>(Node), word [rax + Index * Op->Stride]);
+        movzx(GetDst<RA_32>(Node), word [STATE + Index * Op->Stride + Op->BaseOffset]);
         break;
       case 4:
-        mov(GetDst<RA_32>(Node),  dword [rax + Index * Op->Stride]);
+        mov(GetDst<RA_32>(Node),  dword [STATE + Index * Op->Stride + Op->BaseOffset]);
         break;
       case 8:
-        mov(GetDst<RA_64>(Node),  qword [rax + Index * Op->Stride]);
+        mov(GetDst<RA_64>(Node),  qword [STATE + Index * Op->Stride + Op->BaseOffset]);
         break;
       default:
         LOGMAN_MSG_A_FMT("Unhandled LoadContextIndexed size: {}", OpSize);
@@ -323,21 +322,20 @@ DEF_OP(LoadContextIndexed) {
     case 8: {
       const auto Dst = GetDst(Node);
 
-      lea(rax, dword [STATE + Op->BaseOffset]);
       switch (OpSize) {
       case 1:
-        movzx(eax, byte [rax + Index * Op->Stride]);
+        movzx(eax, byte [STATE + Index * Op->Stride + Op->BaseOffset]);
         vmovd(Dst, eax);
         break;
       case 2:
-        movzx(eax, word [rax + Index * Op->Stride]);
+        movzx(eax, word [STATE + Index * Op->Stride + Op->BaseOffset]);
         vmovd(Dst, eax);
         break;
       case 4:
-        vmovd(Dst,  dword [rax + Index * Op->Stride]);
+        vmovd(Dst,  dword [STATE + Index * Op->Stride + Op->BaseOffset]);
         break;
       case 8:
-        vmovq(Dst,  qword [rax + Index * Op->Stride]);
+        vmovq(Dst,  qword [STATE + Index * Op->Stride + Op->BaseOffset]);
         break;
       default:
         LOGMAN_MSG_A_FMT("Unhandled LoadContextIndexed size: {}", OpSize);
@@ -352,29 +350,28 @@ DEF_OP(LoadContextIndexed) {
 
       mov(rax, Index);
       shl(rax, Shift);
-      lea(rax, dword [rax + Op->BaseOffset]);
       switch (OpSize) {
       case 1:
-        pinsrb(Dst, byte [STATE + rax], 0);
+        pinsrb(Dst, byte [STATE + rax + Op->BaseOffset], 0);
         break;
       case 2:
-        pinsrw(Dst, word [STATE + rax], 0);
+        pinsrw(Dst, word [STATE + rax + Op->BaseOffset], 0);
         break;
       case 4:
-        vmovd(Dst, dword [STATE + rax]);
+        vmovd(Dst, dword [STATE + rax + Op->BaseOffset]);
         break;
       case 8:
-        vmovq(Dst, qword [STATE + rax]);
+        vmovq(Dst, qword [STATE + rax + Op->BaseOffset]);
         break;
       case 16:
         if (Op->BaseOffset % 16 == 0) {
-          vmovaps(Dst, xword [STATE + rax]);
+          vmovaps(Dst, xword [STATE + rax + Op->BaseOffset]);
         } else {
-          vmovups(Dst, xword [STATE + rax]);
+          vmovups(Dst, xword [STATE + rax + Op->BaseOffset]);
         }
         break;
       case 32:
-        vmovups(ToYMM(Dst), yword [STATE + rax]);
+        vmovups(ToYMM(Dst), yword [STATE + rax + Op->BaseOffset]);
         break;
       default:
         LOGMAN_MSG_A_FMT("Unhandled LoadContextIndexed size: {}", OpSize);
@@ -397,7 +394,6 @@ DEF_OP(StoreContextIndexed) {
 
   if (Op->Class == IR::GPRClass) {
     const auto Value = GetSrc<RA_64>(Op->Value.ID());
-    lea(rax, dword [STATE + Op->BaseOffset]);
 
     switch (Op->Stride) {
     case 1:
@@ -407,7 +403,7 @@ DEF_OP(StoreContextIndexed) {
       if (!(OpSize == 1 || OpSize == 2 || OpSize == 4 || OpSize == 8)) {
         LOGMAN_MSG_A_FMT("Unhandled StoreContextIndexed size: {}", OpSize);
       }
-      mov(AddressFrame(OpSize * 8) [rax + Index * Op->Stride], Value);
+      mov(AddressFrame(OpSize * 8) [STATE + Index * Op->Stride + Op->BaseOffset], Value);
       break;
     }
     default:
@@ -422,19 +418,18 @@ DEF_OP(StoreContextIndexed) {
     case 2:
     case 4:
     case 8: {
-      lea(rax, dword [STATE + Op->BaseOffset]);
       switch (OpSize) {
       case 1:
-        pextrb(AddressFrame(OpSize * 8) [rax + Index * Op->Stride], Value, 0);
+        pextrb(AddressFrame(OpSize * 8) [STATE + Index * Op->Stride + Op->BaseOffset], Value, 0);
         break;
       case 2:
-        pextrw(AddressFrame(OpSize * 8) [rax + Index * Op->Stride], Value, 0);
+        pextrw(AddressFrame(OpSize * 8) [STATE + Index * Op->Stride + Op->BaseOffset], Value, 0);
         break;
       case 4:
-        vmovd(AddressFrame(OpSize * 8) [rax + Index * Op->Stride], Value);
+        vmovd(AddressFrame(OpSize * 8) [STATE + Index * Op->Stride + Op->BaseOffset], Value);
         break;
       case 8:
-        vmovq(AddressFrame(OpSize * 8) [rax + Index * Op->Stride], Value);
+        vmovq(AddressFrame(OpSize * 8) [STATE + Index * Op->Stride + Op->BaseOffset], Value);
         break;
       default:
         LOGMAN_MSG_A_FMT("Unhandled StoreContextIndexed size: {}", OpSize);
@@ -448,29 +443,28 @@ DEF_OP(StoreContextIndexed) {
 
       mov(rax, Index);
       shl(rax, Shift);
-      lea(rax, dword [rax + Op->BaseOffset]);
       switch (OpSize) {
       case 1:
-        pextrb(AddressFrame(OpSize * 8) [STATE + rax], Value, 0);
+        pextrb(AddressFrame(OpSize * 8) [STATE + rax + Op->BaseOffset], Value, 0);
         break;
       case 2:
-        pextrw(AddressFrame(OpSize * 8) [STATE + rax], Value, 0);
+        pextrw(AddressFrame(OpSize * 8) [STATE + rax + Op->BaseOffset], Value, 0);
         break;
       case 4:
-        vmovd(AddressFrame(OpSize * 8) [STATE + rax], Value);
+        vmovd(AddressFrame(OpSize * 8) [STATE + rax + Op->BaseOffset], Value);
         break;
       case 8:
-        vmovq(AddressFrame(OpSize * 8) [STATE + rax], Value);
+        vmovq(AddressFrame(OpSize * 8) [STATE + rax + Op->BaseOffset], Value);
         break;
       case 16:
         if (Op->BaseOffset % 16 == 0) {
-          vmovaps(xword [STATE + rax], Value);
+          vmovaps(xword [STATE + rax + Op->BaseOffset], Value);
         } else {
-          vmovups(xword [STATE + rax], Value);
+          vmovups(xword [STATE + rax + Op->BaseOffset], Value);
         }
         break;
       case 32:
-        vmovups(yword [STATE + rax], ToYMM(Value));
+        vmovups(yword [STATE + rax + Op->BaseOffset], ToYMM(Value));
         break;
       default:
         LOGMAN_MSG_A_FMT("Unhandled StoreContextIndexed size: {}", OpSize);
@@ -611,12 +605,10 @@ DEF_OP(LoadFlag) {
 DEF_OP(StoreFlag) {
   auto Op = IROp->C<IR::IROp_StoreFlag>();
 
-  mov (rax, GetSrc<RA_64>(Op->Value.ID()));
-
   if (Op->Flag == 24 /* NZCV */)
-    mov(dword [STATE + (offsetof(FEXCore::Core::CPUState, flags[0]) + Op->Flag)], eax);
+    mov(dword [STATE + (offsetof(FEXCore::Core::CPUState, flags[0]) + Op->Flag)], GetSrc<RA_32>(Op->Value.ID()));
   else
-    mov(byte [STATE + (offsetof(FEXCore::Core::CPUState, flags[0]) + Op->Flag)], al);
+    mov(byte [STATE + (offsetof(FEXCore::Core::CPUState, flags[0]) + Op->Flag)], GetSrc<RA_8>(Op->Value.ID()));
 }
 
 Xbyak::RegExp X86JITCore::GenerateModRM(Xbyak::Reg Base, IR::OrderedNodeWrapper Offset, IR::MemOffsetType OffsetType, uint8_t OffsetScale) const {
@@ -773,6 +765,27 @@ DEF_OP(StoreMem) {
   }
 }
 
+DEF_OP(StoreMemPair) {
+  const auto Op = IROp->C<IR::IROp_StoreMemPair>();
+  const auto OpSize = IROp->Size;
+
+  const Xbyak::Reg MemReg = GetSrc<RA_64>(Op->Addr.ID());
+
+  switch (OpSize) {
+    case 4:
+      mov(dword [MemReg + Op->Offset], GetSrc<RA_32>(Op->Value1.ID()));
+      mov(dword [MemReg + Op->Offset + 4], GetSrc<RA_32>(Op->Value2.ID()));
+      break;
+    case 8:
+      mov(qword [MemReg + Op->Offset], GetSrc<RA_64>(Op->Value1.ID()));
+      mov(qword [MemReg + Op->Offset + 8], GetSrc<RA_64>(Op->Value2.ID()));
+      break;
+    default:
+      LOGMAN_MSG_A_FMT("Unhandled StoreMemPair size: {}", OpSize);
+      break;
+  }
+}
+
 DEF_OP(VLoadVectorMasked) {
   const auto Op = IROp->C<IR::IROp_VLoadVectorMasked>();
   const auto OpSize = IROp->Size;
@@ -844,6 +857,52 @@ DEF_OP(VStoreVectorMasked) {
   }
 }
 
+DEF_OP(VGather) {
+  const auto Op = IROp->C<IR::IROp_VGather>();
+  const auto OpSize = IROp->Size;
+
+  const auto Is256Bit = OpSize == Core::CPUState::XMM_AVX_REG_SIZE;
+  const auto ElementSize = IROp->ElementSize;
+  const auto IndexElementSize = Op->IndexElementSize;
+
+  const auto Dst = GetDst(Node);
+  const auto Dest = GetSrc(Op->Dest.ID());
+  const auto Mask = GetSrc(Op->Mask.ID());
+  const auto Indices = GetSrc(Op->Indices.ID());
+  const Xbyak::Reg MemReg = GetSrc<RA_64>(Op->Base.ID());
+
+  // The narrower of the element and index vectors only uses its lower half
+  const auto ResultReg = Is256Bit && ElementSize >= IndexElementSize ? Xbyak::Xmm(ToYMM(xmm14)) : xmm14;
+  const auto MaskTmp = Is256Bit && ElementSize >= IndexElementSize ? Xbyak::Xmm(ToYMM(xmm15)) : xmm15;
+  const auto IndexReg = Is256Bit && IndexElementSize >= ElementSize ? Xbyak::Xmm(ToYMM(Indices)) : Indices;
+  const auto MemPtr = ptr[MemReg + IndexReg * Op->Scale];
+
+  // The host gather consumes its mask and merges into its destination
+  vmovaps(ToYMM(xmm14), ToYMM(Dest));
+  vmovaps(ToYMM(xmm15), ToYMM(Mask));
+
+  if (ElementSize == 4) {
+    if (IndexElementSize == 4) {
+      vpgatherdd(ResultReg, MemPtr, MaskTmp);
+    } else {
+      vpgatherqd(ResultReg, MemPtr, MaskTmp);
+    }
+  } else {
+    if (IndexElementSize == 4) {
+      vpgatherdq(ResultReg, MemPtr, MaskTmp);
+    } else {
+      vpgatherqq(ResultReg, MemPtr, MaskTmp);
+    }
+  }
+
+  // VEX encoded moves zero the upper half when the result is only 128-bit
+  if (ResultReg.isYMM()) {
+    vmovaps(ToYMM(Dst), ToYMM(xmm14));
+  } else {
+    vmovaps(Dst, xmm14);
+  }
+}
+
 DEF_OP(MemSet) {
   const auto Op = IROp->C<IR::IROp_MemSet>();
 
@@ -1069,6 +1128,148 @@ DEF_OP(MemCpy) {
   L(Done);
 }
 
+DEF_OP(MemScan) {
+  const auto Op = IROp->C<IR::IROp_MemScan>();
+
+  const int32_t Size = Op->Size;
+  const auto MemReg = GetSrc<RA_64>(Op->Addr.ID());
+  const auto Value = GetSrc<RA_64>(Op->Value.ID());
+  const auto Length = GetSrc<RA_64>(Op->Length.ID());
+  const auto Direction = GetSrc<RA_64>(Op->Direction.ID());
+  const auto Dst = GetSrc<RA_64>(Node);
+
+  // The host has the same instruction, so this maps directly on to `rep scas`.
+  // TMP1 = rax
+  // TMP2 = rcx
+  // TMP4 = rdi
+  mov(rax, Value);
+  mov(rcx, Length);
+  mov(rdi, MemReg);
+
+  if (!Op->Prefix.IsInvalid()) {
+    add(rdi, GetSrc<RA_64>(Op->Prefix.ID()));
+  }
+
+  Label AfterDir;
+  cmp(Direction, 0);
+  je(AfterDir);
+  // Decrementing DF flag.
+  std();
+  L(AfterDir);
+
+  // REPE stops on the first mismatch, REPNE on the first match
+  if (Op->StopOnMismatch) {
+    repe();
+  }
+  else {
+    repne();
+  }
+
+  switch (Size) {
+    case 1:
+      scasb();
+      break;
+    case 2:
+      scasw();
+      break;
+    case 4:
+      scasd();
+      break;
+    case 8:
+      scasq();
+      break;
+    default:
+      LOGMAN_MSG_A_FMT("Unhandled {} size: {}", __func__, Size);
+      break;
+  }
+  // Ensure we set DF back to zero. Required by the ABI.
+  cld();
+
+  // Elements compared is how far the counter moved
+  mov(TMP3, Length);
+  sub(TMP3, rcx);
+  mov(Dst, TMP3);
+}
+
+DEF_OP(MemCmp) {
+  const auto Op = IROp->C<IR::IROp_MemCmp>();
+
+  const int32_t Size = Op->Size;
+  const auto MemRegA = GetSrc<RA_64>(Op->AddrA.ID());
+  const auto MemRegB = GetSrc<RA_64>(Op->AddrB.ID());
+
+  const auto Length = GetSrc<RA_64>(Op->Length.ID());
+  const auto Direction = GetSrc<RA_64>(Op->Direction.ID());
+  const auto Dst = GetSrc<RA_64>(Node);
+
+  // `cmps` would need rsi, which is allocatable, so this is a loop instead.
+  // TMP1 = Remaining
+  // TMP2 = A
+  // TMP3 = B
+  // TMP4 = Temp value
+  // TMP5 = Pointer step
+  mov(TMP1, Length);
+  mov(TMP2, MemRegA);
+  mov(TMP3, MemRegB);
+  if (!Op->PrefixA.IsInvalid()) {
+    add(TMP2, GetSrc<RA_64>(Op->PrefixA.ID()));
+  }
+  if (!Op->PrefixB.IsInvalid()) {
+    add(TMP3, GetSrc<RA_64>(Op->PrefixB.ID()));
+  }
+
+  mov(TMP5, Size);
+  mov(TMP4, -Size);
+  cmp(Direction, 0);
+  cmovne(TMP5, TMP4);
+
+  Label Done;
+  Label Again;
+  L(Again);
+  test(TMP1, TMP1);
+  je(Done);
+
+  switch (Size) {
+    case 1:
+      movzx(TMP4.cvt32(), byte [TMP2]);
+      cmp(TMP4.cvt8(), byte [TMP3]);
+      break;
+    case 2:
+      movzx(TMP4.cvt32(), word [TMP2]);
+      cmp(TMP4.cvt16(), word [TMP3]);
+      break;
+    case 4:
+      mov(TMP4.cvt32(), dword [TMP2]);
+      cmp(TMP4.cvt32(), dword [TMP3]);
+      break;
+    case 8:
+      mov(TMP4, qword [TMP2]);
+      cmp(TMP4, qword [TMP3]);
+      break;
+    default:
+      LOGMAN_MSG_A_FMT("Unhandled {} size: {}", __func__, Size);
+      break;
+  }
+
+  // lea leaves the comparison flags alone
+  lea(TMP2, ptr [TMP2 + TMP5]);
+  lea(TMP3, ptr [TMP3 + TMP5]);
+  lea(TMP1, ptr [TMP1 - 1]);
+
+  if (Op->StopOnMismatch) {
+    je(Again);
+  }
+  else {
+    jne(Again);
+  }
+  L(Done);
+
+  // Elements compared is how far the counter moved
+  mov(TMP4, Length);
+  sub(TMP4, TMP1);
+  mov(Dst, TMP4);
+}
+
 DEF_OP(CacheLineClear) {
   auto Op = IROp->C<IR::IROp_CacheLineClear>();
 
@@ -1123,10 +1324,14 @@ void X86JITCore::RegisterMemoryHandlers() {
   REGISTER_OP(STOREMEM,            StoreMem);
   REGISTER_OP(LOADMEMTSO,          LoadMem);
   REGISTER_OP(STOREMEMTSO,         StoreMem);
+  REGISTER_OP(STOREMEMPAIR,        StoreMemPair);
   REGISTER_OP(VLOADVECTORMASKED,   VLoadVectorMasked);
   REGISTER_OP(VSTOREVECTORMASKED,  VStoreVectorMasked);
+  REGISTER_OP(VGATHER,             VGather);
   REGISTER_OP(MEMSET,              MemSet);
   REGISTER_OP(MEMCPY,              MemCpy);
+  REGISTER_OP(MEMSCAN,             MemScan);
+  REGISTER_OP(MEMCMP,              MemCmp);
   REGISTER_OP(CACHELINECLEAR,      CacheLineClear);
   REGISTER_OP(CACHELINECLEAN,      CacheLineClean);
   REGISTER_OP(CACHELINEZERO,       CacheLineZero);
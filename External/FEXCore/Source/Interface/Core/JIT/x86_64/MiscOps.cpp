@@ -93,7 +93,15 @@ DEF_OP(GetRoundingMode) {
   stmxcsr(dword [rsp]);
   mov(Dst, dword [rsp]);
   add(rsp, 4);
+
+  // DAZ
+  mov(TMP1.cvt32(), Dst);
+  shr(TMP1.cvt32(), 6 - 3);
+  and_(TMP1.cvt32(), IR::ROUND_MODE_FLUSH_INPUTS_TO_ZERO);
+
   shr(Dst, 13);
+  and_(Dst, 0b111);
+  or_(Dst, TMP1.cvt32());
 }
 
 DEF_OP(SetRoundingMode) {
@@ -107,11 +115,18 @@ DEF_OP(SetRoundingMode) {
   mov(TMP1.cvt32(), dword [rsp]);
 
   // Insert the new rounding mode
-  and_(TMP1.cvt32(), ~(0b111 << 13));
+  and_(TMP1.cvt32(), ~((0b111 << 13) | (1 << 6)));
   mov(TMP2.cvt32(), Src);
+  and_(TMP2.cvt32(), 0b111);
   shl(TMP2.cvt32(), 13);
   or_(TMP1.cvt32(), TMP2.cvt32());
 
+  // Insert DAZ
+  mov(TMP2.cvt32(), Src);
+  and_(TMP2.cvt32(), IR::ROUND_MODE_FLUSH_INPUTS_TO_ZERO);
+  shl(TMP2.cvt32(), 6 - 3);
+  or_(TMP1.cvt32(), TMP2.cvt32());
+
   // Store it to mxcsr
   // Only loads from memory
   mov(dword [rsp], TMP1.cvt32());
@@ -185,6 +200,7 @@ void X86JITCore::RegisterMiscHandlers() {
   REGISTER_OP(PROCESSORID,   ProcessorID);
   REGISTER_OP(RDRAND, RDRAND);
   REGISTER_OP(YIELD, Yield);
+  REGISTER_OP(SPINWAIT, Yield);
 #undef REGISTER_OP
 }
 }
@@ -39,6 +39,28 @@ void X86JITCore::LoadConstantWithPadding(Xbyak::Reg Reg, uint64_t Constant) {
   nop(NOPPadSize);
 }
 
+void X86JITCore::InsertNamedThunkRelocation(Xbyak::Reg Reg, const IR::SHA256Sum &Sum) {
+  Relocation MoveABI{};
+  MoveABI.NamedThunkMove.Header.Type = FEXCore::CPU::RelocationTypes::RELOC_NAMED_THUNK_MOVE;
+
+  // Offset is the offset from the entrypoint of the block
+  auto CurrentCursor = getSize();
+  MoveABI.NamedThunkMove.Offset = CurrentCursor - CursorEntry;
+  MoveABI.NamedThunkMove.Symbol = Sum;
+  MoveABI.NamedThunkMove.RegisterIndex = Reg.getIdx();
+
+  uint64_t Pointer = reinterpret_cast<uint64_t>(CTX->ThunkHandler->LookupThunk(Sum));
+
+  if (CTX->Config.CacheObjectCodeCompilation() || CTX->Config.AOTIRHostCode()) {
+    LoadConstantWithPadding(Reg, Pointer);
+  }
+  else {
+    mov(Reg, Pointer);
+  }
+
+  Relocations.emplace_back(MoveABI);
+}
+
 X86JITCore::NamedSymbolLiteralPair X86JITCore::InsertNamedSymbolLiteral(FEXCore::CPU::RelocNamedSymbolLiteral::NamedSymbol Op) {
   NamedSymbolLiteralPair Lit {
     .MoveABI = {
@@ -77,7 +99,7 @@ void X86JITCore::InsertGuestRIPMove(Xbyak::Reg Reg, uint64_t Constant) {
   MoveABI.GuestRIPMove.GuestRIP = Constant;
   MoveABI.GuestRIPMove.RegisterIndex = Reg.getIdx();
 
-  if (CTX->Config.CacheObjectCodeCompilation()) {
+  if (CTX->Config.CacheObjectCodeCompilation() || CTX->Config.AOTIRHostCode()) {
     LoadConstantWithPadding(Reg, Constant);
   }
   else {
@@ -107,7 +129,8 @@ bool X86JITCore::ApplyRelocations(uint64_t GuestEntry, uint64_t CodeEntry, uint6
       }
       case FEXCore::CPU::RelocationTypes::RELOC_NAMED_THUNK_MOVE: {
         uint64_t Pointer = reinterpret_cast<uint64_t>(CTX->ThunkHandler->LookupThunk(Reloc->NamedThunkMove.Symbol));
-        if (Pointer == ~0ULL) {
+        if (Pointer == 0) {
+          // Thunk isn't loaded in this process
           return false;
         }
 
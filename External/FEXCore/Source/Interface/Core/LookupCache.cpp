@@ -11,10 +11,16 @@ $end_info$
 #include "Interface/Context/Context.h"
 #include "Interface/Core/LookupCache.h"
 
+#include <FEXHeaderUtils/TypeDefines.h>
+
+#include <algorithm>
+#include <bit>
+
 namespace FEXCore {
-LookupCache::LookupCache(FEXCore::Context::ContextImpl *CTX)
+LookupCache::LookupCache(FEXCore::Context::ContextImpl *CTX, bool Shared)
   : BlockLinks_mbr { fextl::pmr::get_default_resource() }
-  , ctx {CTX} {
+  , ctx {CTX}
+  , Shared {Shared} {
 
   TotalCacheSize = ctx->Config.VirtualMemSize / 4096 * 8 + CODE_SIZE + L1_SIZE;
   BlockLinks_pma = fextl::make_unique<std::pmr::polymorphic_allocator<std::byte>>(&BlockLinks_mbr);
@@ -47,7 +53,14 @@ LookupCache::LookupCache(FEXCore::Context::ContextImpl *CTX)
   L1Pointer = PageMemory + CODE_SIZE;
   LOGMAN_THROW_AA_FMT(L1Pointer != -1ULL, "Failed to allocate L1Pointer");
 
+  if (ctx->Config.JITHugePages) {
+    // The page pointer table is sparse, only the densely used L2 and L1 memory gains from huge pages
+    FEXCore::Allocator::VirtualHugePages(reinterpret_cast<void*>(PageMemory), CODE_SIZE + L1_SIZE);
+  }
+
   VirtualMemSize = ctx->Config.VirtualMemSize;
+  L1Mask = (Shared ? L1_MAX_ENTRIES : L1_MIN_ENTRIES) - 1;
+  CodePageShift = std::countr_zero(FHU::GetHostPageSize());
 }
 
 LookupCache::~LookupCache() {
@@ -60,14 +73,67 @@ LookupCache::~LookupCache() {
 
 void LookupCache::ClearL2Cache() {
   std::lock_guard<std::recursive_mutex> lk(WriteLock);
+  ScopedSequenceWrite SequenceWrite(WriteSequence);
   // Clear out the page memory
   // PagePointer and PageMemory are sequential with each other. Clear both at once.
   FEXCore::Allocator::VirtualDontNeed(reinterpret_cast<void*>(PagePointer), ctx->Config.VirtualMemSize / 4096 * 8 + CODE_SIZE);
   AllocateOffset = 0;
 }
 
+void LookupCache::GrowL1() {
+  const size_t OldEntries = GetL1Entries();
+  const size_t NewEntries = std::min(OldEntries * 4, L1_MAX_ENTRIES);
+
+  // The new part of the L1 has to start out empty. A lookup that raced with ReleaseIfIdle may have refilled an
+  // entry past the shrunk mask, which later erases wouldn't have cleared.
+  FEXCore::Allocator::VirtualDontNeed(reinterpret_cast<void*>(L1Pointer + OldEntries * sizeof(LookupCacheEntry)),
+                                      (NewEntries - OldEntries) * sizeof(LookupCacheEntry));
+
+  // Entries cached with the smaller mask stay valid, they are tagged with their guest address
+  SetL1Mask(NewEntries - 1);
+}
+
+bool LookupCache::ReleaseIfIdle() {
+  if (Shared) {
+    return false;
+  }
+
+  std::lock_guard<std::recursive_mutex> lk(WriteLock);
+
+  if (Released && Activity == IdleCheckActivity) {
+    return false;
+  }
+
+  ScopedSequenceWrite SequenceWrite(WriteSequence);
+
+  // Shrink before discarding, so a lookup racing with this on the owning thread indexes the small L1
+  SetL1Mask(L1_MIN_ENTRIES - 1);
+  FEXCore::Allocator::VirtualDontNeed(reinterpret_cast<void*>(L1Pointer), L1_SIZE);
+  ClearL2Cache();
+
+  IdleCheckActivity = Activity;
+  Released = true;
+  return true;
+}
+
 void LookupCache::ClearCache() {
   std::lock_guard<std::recursive_mutex> lk(WriteLock);
+  ScopedSequenceWrite SequenceWrite(WriteSequence);
+
+  if (Shared) {
+    // Other threads may still be running code that was linked against blocks in this cache.
+    // Sever the links so they fall back to the dispatcher instead of running stale code.
+    for (auto &[GuestDestination, Links] : *BlockLinks) {
+      for (auto &Link : Links) {
+        Delink(Link);
+      }
+    }
+    FlushDelinkedCode();
+  }
+
+  if (!Shared) {
+    SetL1Mask(L1_MIN_ENTRIES - 1);
+  }
 
   // Clear L1 and L2 by clearing the full cache.
   FEXCore::Allocator::VirtualDontNeed(reinterpret_cast<void*>(PagePointer), TotalCacheSize);
@@ -75,6 +141,159 @@ void LookupCache::ClearCache() {
   BlockLinks = BlockLinks_pma->new_object<BlockLinksMapType>();
   // All code is gone, clear the block list
   BlockList.clear();
+  BlockGuestRanges.clear();
+  SuspectBlocks.clear();
+  SuspectBlockReach = 0;
+
+  for (auto &Epoch : InvalidationEpochs) {
+    Epoch.fetch_add(1, std::memory_order_release);
+  }
+}
+
+void LookupCache::FlushDelinkedCode() {
+  if (PendingICacheFlush.empty()) {
+    return;
+  }
+
+  // Links to one block are spread through the code buffer, but the links of a multiblock or of neighbouring
+  // blocks often share a page. Each flush ends with barriers, so flush every touched page range once.
+  std::sort(PendingICacheFlush.begin(), PendingICacheFlush.end(), [](const BlockDelinkedRange &a, const BlockDelinkedRange &b) {
+    return a.Begin < b.Begin;
+  });
+
+  uintptr_t Begin = PendingICacheFlush[0].Begin;
+  uintptr_t End = Begin + PendingICacheFlush[0].Length;
+  for (size_t i = 1; i < PendingICacheFlush.size(); ++i) {
+    const auto &Range = PendingICacheFlush[i];
+    if ((Range.Begin & FHU::FEX_PAGE_MASK) == ((End - 1) & FHU::FEX_PAGE_MASK)) {
+      End = std::max(End, Range.Begin + Range.Length);
+      continue;
+    }
+
+    __builtin___clear_cache(reinterpret_cast<char*>(Begin), reinterpret_cast<char*>(End));
+    Begin = Range.Begin;
+    End = Range.Begin + Range.Length;
+  }
+  __builtin___clear_cache(reinterpret_cast<char*>(Begin), reinterpret_cast<char*>(End));
+
+  PendingICacheFlush.clear();
+}
+
+void LookupCache::Suspend(const fextl::vector<uint64_t> &Addresses) {
+  std::lock_guard<std::recursive_mutex> lk(WriteLock);
+
+  for (auto Address : Addresses) {
+    auto Range = BlockGuestRanges.find(Address);
+    auto HostCode = BlockList.find(Address);
+    if (Range == BlockGuestRanges.end() || HostCode == BlockList.end()) {
+      continue;
+    }
+
+    const auto &Guest = Range->second;
+    SuspectBlocks.insert_or_assign(Address, SuspectBlock {
+      .HostCode = HostCode->second,
+      .Range = Guest,
+    });
+    SuspectBlockReach = std::max({SuspectBlockReach, Address - Guest.Start, Guest.Start + Guest.Length - Address});
+  }
+
+  // Links to the blocks are severed like any other invalidation, they are linked again once reinstated
+  Erase(Addresses);
+}
+
+void LookupCache::DropSuspectBlocks(uint64_t Start, uint64_t Length) {
+  if (SuspectBlocks.empty()) {
+    return;
+  }
+
+  const uint64_t End = Start + Length;
+  auto it = SuspectBlocks.lower_bound(Start > SuspectBlockReach ? Start - SuspectBlockReach : 0);
+  while (it != SuspectBlocks.end() && it->first < End + SuspectBlockReach) {
+    const auto &Range = it->second.Range;
+    if (Range.Start < End && Start < Range.Start + Range.Length) {
+      it = SuspectBlocks.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+}
+
+fextl::vector<uint64_t> LookupCache::TakeBlocksInRange(uint64_t Start, uint64_t Length) {
+  const uint64_t StartPage = Start >> CodePageShift;
+  const uint64_t EndPage = (Start + Length - 1) >> CodePageShift;
+
+  fextl::vector<uint64_t> Blocks;
+
+  if (EndPage - StartPage < CodePages.size()) {
+    // Small ranges, like a single written page, look up each page
+    for (uint64_t Page = StartPage; Page <= EndPage; ++Page) {
+      auto it = CodePages.find(Page);
+      if (it != CodePages.end()) {
+        TakePageBlocks(it->second, &Blocks);
+        CodePages.erase(it);
+      }
+    }
+  }
+  else {
+    // Ranges larger than the number of code pages, like unmapping a whole library, walk the tracked pages instead
+    for (auto it = CodePages.begin(); it != CodePages.end();) {
+      if (it->first >= StartPage && it->first <= EndPage) {
+        TakePageBlocks(it->second, &Blocks);
+        it = CodePages.erase(it);
+      }
+      else {
+        ++it;
+      }
+    }
+  }
+
+  return Blocks;
+}
+
+fextl::vector<uint64_t> LookupCache::EvictHostRange(uintptr_t Begin, uintptr_t End) {
+  std::lock_guard<std::recursive_mutex> lk(WriteLock);
+  ScopedSequenceWrite SequenceWrite(WriteSequence);
+
+  // Links patched in to the evicted code are dropped without delinking, the memory is about to be reused
+  for (auto it = BlockLinks->begin(); it != BlockLinks->end();) {
+    std::erase_if(it->second, [Begin, End](const BlockLinkRecord &Link) {
+      return Link.HostLink >= Begin && Link.HostLink < End;
+    });
+
+    if (it->second.empty()) {
+      it = BlockLinks->erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+
+  fextl::vector<uint64_t> Evicted;
+  for (const auto &Block : GetBlocksInHostRange(Begin, End)) {
+    Evicted.push_back(Block.GuestCode);
+  }
+
+  // Erase severs the links from code outside of the range and clears L1 and L2
+  Erase(Evicted);
+
+  std::erase_if(SuspectBlocks, [Begin, End](const auto &Block) {
+    return Block.second.HostCode >= Begin && Block.second.HostCode < End;
+  });
+
+  return Evicted;
+}
+
+fextl::vector<LookupCache::LookupCacheEntry> LookupCache::GetBlocksInHostRange(uintptr_t Begin, uintptr_t End) {
+  std::lock_guard<std::recursive_mutex> lk(WriteLock);
+
+  fextl::vector<LookupCacheEntry> Blocks;
+  for (auto &[GuestCode, HostCode] : BlockList) {
+    if (HostCode >= Begin && HostCode < End) {
+      Blocks.push_back({.HostCode = HostCode, .GuestCode = GuestCode});
+    }
+  }
+  return Blocks;
 }
 
 }
@@ -1,20 +1,32 @@
 #pragma once
 #include "Interface/Context/Context.h"
 #include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/Utils/Telemetry.h>
 #include <FEXCore/fextl/map.h>
 #include <FEXCore/fextl/memory_resource.h>
 #include <FEXCore/fextl/robin_map.h>
+#include <FEXCore/fextl/unordered_map.h>
 #include <FEXCore/fextl/vector.h>
+#include <FEXHeaderUtils/TypeDefines.h>
 #include <FEXCore/fextl/memory_resource.h>
 
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <functional>
+#include <optional>
 #include <stddef.h>
 #include <utility>
 #include <mutex>
 
 namespace FEXCore {
 
+// Host code a block delinker patched. Empty when the link only patched data.
+struct BlockDelinkedRange {
+  uintptr_t Begin;
+  size_t Length;
+};
+
 class LookupCache {
 public:
   struct LookupCacheEntry {
@@ -22,18 +34,43 @@ public:
     uintptr_t GuestCode;
   };
 
-  LookupCache(FEXCore::Context::ContextImpl *CTX);
+  // The guest code a block was compiled from
+  struct GuestCodeRange {
+    uint64_t Start;
+    uint64_t Length;
+    // XXH3 of the code at compile time
+    uint64_t Hash;
+  };
+
+  // A block that was invalidated while its guest code might not have changed, its host code is still in the code buffer
+  struct SuspectBlock {
+    uintptr_t HostCode;
+    GuestCodeRange Range;
+  };
+
+  /**
+   * @param Shared - This cache is shared by every thread in the process instead of being owned by a single thread
+   */
+  LookupCache(FEXCore::Context::ContextImpl *CTX, bool Shared = false);
   ~LookupCache();
 
   uintptr_t FindBlock(uint64_t Address) {
     // Try L1, no lock needed
-    auto &L1Entry = reinterpret_cast<LookupCacheEntry*>(L1Pointer)[Address & L1_ENTRIES_MASK];
+    auto &L1Entry = GetL1Entry(Address);
     if (L1Entry.GuestCode == Address) {
+      FEXCORE_TELEMETRY_COUNTER_INC(COUNTER_LOOKUP_L1_HITS);
       return L1Entry.HostCode;
     }
 
-    // L2 and L3 need to be locked
+    // Try L2, no lock needed unless a writer is active
+    if (auto HostCode = FindBlockL2Lockless(Address, L1Entry)) {
+      FEXCORE_TELEMETRY_COUNTER_INC(COUNTER_LOOKUP_L2_HITS);
+      return HostCode;
+    }
+
+    // L3 needs to be locked, L2 is retried in case the lockless lookup raced with a writer
     std::lock_guard<std::recursive_mutex> lk(WriteLock);
+    ++Activity;
 
     // Try L2
     const auto PageIndex = (Address & (VirtualMemSize -1)) >> 12;
@@ -49,6 +86,7 @@ public:
 
       if (BlockPointers[PageOffset].GuestCode == Address)
       {
+        FEXCORE_TELEMETRY_COUNTER_INC(COUNTER_LOOKUP_L2_HITS);
         L1Entry.GuestCode = Address;
         L1Entry.HostCode = BlockPointers[PageOffset].HostCode;
         return L1Entry.HostCode;
@@ -59,117 +97,355 @@ public:
     auto HostCode = BlockList.find(Address);
 
     if (HostCode != BlockList.end()) {
+      FEXCORE_TELEMETRY_COUNTER_INC(COUNTER_LOOKUP_L3_HITS);
       CacheBlockMapping(Address, HostCode->second);
       return HostCode->second;
     }
 
     // Failed to find
+    FEXCORE_TELEMETRY_COUNTER_INC(COUNTER_LOOKUP_MISSES);
     return 0;
   }
 
-  fextl::map<uint64_t, fextl::vector<uint64_t>> CodePages;
-
-  // Appends Block {Address} to CodePages [Start, Start + Length)
+  // Appends Block {Address} to the code pages [Start, Start + Length)
+  // A reinstated suspect block may still be listed on the pages that weren't invalidated, those are skipped.
   // Returns true if new pages are marked as containing code
-  bool AddBlockExecutableRange(uint64_t Address, uint64_t Start, uint64_t Length) {
+  bool AddBlockExecutableRange(uint64_t Address, uint64_t Start, uint64_t Length, bool Reinstated = false) {
     std::lock_guard<std::recursive_mutex> lk(WriteLock);
 
     bool rv = false;
 
-    for (auto CurrentPage = Start >> 12, EndPage = (Start + Length -1) >> 12; CurrentPage <= EndPage; CurrentPage++) {
-      auto &CodePage = CodePages[CurrentPage];
-      rv |= CodePage.size() == 0;
-      CodePage.push_back(Address);
+    for (auto CurrentPage = Start >> CodePageShift, EndPage = (Start + Length -1) >> CodePageShift; CurrentPage <= EndPage; CurrentPage++) {
+      auto [Head, Inserted] = CodePages.try_emplace(CurrentPage, INVALID_CODE_PAGE_NODE);
+      rv |= Inserted;
+
+      if (Reinstated && IsOnCodePage(Head->second, Address)) {
+        continue;
+      }
+
+      const uint32_t Node = AllocateCodePageNode();
+      CodePageNodes[Node] = {
+        .Address = Address,
+        .Next = Head->second,
+      };
+      Head.value() = Node;
     }
 
     return rv;
   }
 
+  // Stops tracking the code pages overlapping [Start, Start + Length), they count as new again.
+  // Returns every block that was on them, a block spanning several of the pages may be listed more than once.
+  // Must be used with WriteLock held.
+  fextl::vector<uint64_t> TakeBlocksInRange(uint64_t Start, uint64_t Length);
+
   // Adds to Guest -> Host code mapping
-  void AddBlockMapping(uint64_t Address, void *HostCode) {
+  // Returns the host code that is now mapped for Address.
+  // With a shared cache another thread may have won the race to compile the same block, in which case its code is returned.
+  uintptr_t AddBlockMapping(uint64_t Address, void *HostCode) {
     std::lock_guard<std::recursive_mutex> lk(WriteLock);
 
-    [[maybe_unused]] auto Inserted = BlockList.emplace(Address, (uintptr_t)HostCode).second;
+    auto [Existing, Inserted] = BlockList.emplace(Address, (uintptr_t)HostCode);
+    if (!Inserted && Shared) {
+      return Existing->second;
+    }
     LOGMAN_THROW_AA_FMT(Inserted, "Duplicate block mapping added");
+    ++Activity;
+
+    if (!Shared && BlockList.size() > GetL1Entries() / 2 && GetL1Entries() < L1_MAX_ENTRIES) {
+      GrowL1();
+    }
 
     // There is no need to update L1 or L2, they will get updated on first lookup
     // However, adding to L1 here increases performance
-    auto &L1Entry = reinterpret_cast<LookupCacheEntry*>(L1Pointer)[Address & L1_ENTRIES_MASK];
+    auto &L1Entry = GetL1Entry(Address);
     L1Entry.GuestCode = Address;
     L1Entry.HostCode = (uintptr_t)HostCode;
+
+    return (uintptr_t)HostCode;
   }
 
-  void Erase(uint64_t Address) {
+  // Remembers the guest code of a block, blocks without it are erased instead of being suspended
+  void AddBlockGuestRange(uint64_t Address, const GuestCodeRange &Range) {
+    std::lock_guard<std::recursive_mutex> lk(WriteLock);
+    BlockGuestRanges.insert_or_assign(Address, Range);
+  }
+
+  // Erases a batch of blocks, keeping the ones with a known guest range as suspect blocks
+  void Suspend(const fextl::vector<uint64_t> &Addresses);
 
+  // Forgets suspect blocks whose guest code overlaps [Start, Start + Length), once it might not be readable anymore
+  // Must be used with WriteLock held.
+  void DropSuspectBlocks(uint64_t Start, uint64_t Length);
+
+  // Removes and returns the suspect block at Address
+  std::optional<SuspectBlock> TakeSuspectBlock(uint64_t Address) {
     std::lock_guard<std::recursive_mutex> lk(WriteLock);
 
-    // Sever any links to this block
-    auto lower = BlockLinks->lower_bound({Address, 0});
-    auto upper = BlockLinks->upper_bound({Address, UINTPTR_MAX});
-    for (auto it = lower; it != upper; it = BlockLinks->erase(it)) {
-      it->second();
+    auto it = SuspectBlocks.find(Address);
+    if (it == SuspectBlocks.end()) {
+      return std::nullopt;
     }
 
-    // Remove from BlockList
-    BlockList.erase(Address);
+    auto Block = it->second;
+    SuspectBlocks.erase(it);
+    return Block;
+  }
 
-    // Do L1
-    auto &L1Entry = reinterpret_cast<LookupCacheEntry*>(L1Pointer)[Address & L1_ENTRIES_MASK];
-    if (L1Entry.GuestCode == Address) {
-      L1Entry.GuestCode = 0;
-      // Leave L1Entry.HostCode as is, so that concurrent lookups won't read a null pointer
-      // This is a soft guarantee for cross thread invalidation, as atomics are not used
-      // and it hasn't been thoroughly tested
-    }
+  void Erase(uint64_t Address) {
+    std::lock_guard<std::recursive_mutex> lk(WriteLock);
+    ScopedSequenceWrite SequenceWrite(WriteSequence);
 
-    // Do full map
-    Address = Address & (VirtualMemSize -1);
-    uint64_t PageOffset = Address & (0x0FFF);
-    Address >>= 12;
+    EraseUnlocked(Address);
+    FlushDelinkedCode();
 
-    uintptr_t *Pointers = reinterpret_cast<uintptr_t*>(PagePointer);
-    uint64_t LocalPagePointer = Pointers[Address];
-    if (!LocalPagePointer) {
-      // Page for this code didn't even exist, nothing to do
+    // Inline indirect branch caches in JIT code can't be searched, invalidate the ones that may target this page
+    GetInvalidationEpoch(Address).fetch_add(1, std::memory_order_release);
+  }
+
+  // Erases a batch of blocks, such as every block on an invalidated page, in a single write section
+  void Erase(const fextl::vector<uint64_t> &Addresses) {
+    if (Addresses.empty()) {
       return;
     }
 
-    // Page exists, just set the offset to zero
-    auto BlockPointers = reinterpret_cast<LookupCacheEntry*>(LocalPagePointer);
-    BlockPointers[PageOffset].GuestCode = 0;
-    BlockPointers[PageOffset].HostCode = 0;
+    std::lock_guard<std::recursive_mutex> lk(WriteLock);
+    ScopedSequenceWrite SequenceWrite(WriteSequence);
+
+    for (auto Address : Addresses) {
+      EraseUnlocked(Address);
+    }
+    FlushDelinkedCode();
+
+    // Blocks on the same page share an epoch, bumping it more than once is harmless
+    for (auto Address : Addresses) {
+      GetInvalidationEpoch(Address).fetch_add(1, std::memory_order_release);
+    }
   }
 
+  // Restores a patched link to go through the ExitFunctionLinker again.
+  // A plain function pointer with one word of data keeps the link records free of std::function objects.
+  // Delinkers don't flush the instruction cache, they return the code they patched so it can be flushed in bulk.
+  using BlockDelinkerFn = BlockDelinkedRange(*)(uintptr_t HostLink, uintptr_t Data);
 
-  void AddBlockLink(uint64_t GuestDestination, uintptr_t HostLink, const std::function<void()> &delinker) {
+  void AddBlockLink(uint64_t GuestDestination, uintptr_t HostLink, BlockDelinkerFn Delinker, uintptr_t Data) {
     std::lock_guard<std::recursive_mutex> lk(WriteLock);
 
-    BlockLinks->insert({{GuestDestination, HostLink}, delinker});
+    (*BlockLinks)[GuestDestination].push_back({HostLink, Delinker, Data});
   }
 
   void ClearCache();
   void ClearL2Cache();
 
+  // Shrinks the L1 back to its minimum size and discards the L2. Mappings stay in L3 and are cached again on their next miss.
+  // Meant for caches whose owning thread is parked, does nothing if nothing was cached since the previous release.
+  // Safe to call from any thread, does nothing for shared caches.
+  // Returns true if the memory was released.
+  bool ReleaseIfIdle();
+
+  // Where the owning thread's JIT code reads the L1 index mask from, kept up to date as the L1 is resized
+  void SetL1MaskStorage(uint64_t *Storage) {
+    std::lock_guard<std::recursive_mutex> lk(WriteLock);
+    L1MaskStorage = Storage;
+    if (L1MaskStorage) {
+      *L1MaskStorage = L1Mask.load(std::memory_order_relaxed);
+    }
+  }
+
+  // Removes every block whose host code starts in [Begin, End), and every link patched in to that range.
+  // Returns the guest addresses of the removed blocks.
+  fextl::vector<uint64_t> EvictHostRange(uintptr_t Begin, uintptr_t End);
+
+  // Returns every block whose host code starts in [Begin, End)
+  fextl::vector<LookupCacheEntry> GetBlocksInHostRange(uintptr_t Begin, uintptr_t End);
+
   uintptr_t GetL1Pointer() const { return L1Pointer; }
+  uint64_t GetL1Mask() const { return L1Mask.load(std::memory_order_relaxed); }
   uintptr_t GetPagePointer() const { return PagePointer; }
+  uintptr_t GetInvalidationEpochsPointer() const { return reinterpret_cast<uintptr_t>(InvalidationEpochs.data()); }
   uintptr_t GetVirtualMemorySize() const { return VirtualMemSize; }
 
-  constexpr static size_t L1_ENTRIES = 1 * 1024 * 1024; // Must be a power of 2
-  constexpr static size_t L1_ENTRIES_MASK = L1_ENTRIES - 1;
+  // Memory touched by every lookup, the L1 and the used part of the L2. The sparse page pointer table isn't included.
+  std::array<std::pair<uintptr_t, size_t>, 2> GetHotRanges() const {
+    return {{ {L1Pointer, GetL1Entries() * sizeof(LookupCacheEntry)}, {PageMemory, AllocateOffset} }};
+  }
+  bool IsShared() const { return Shared; }
+
+  // The L1 of a thread's own cache starts small and grows with the number of blocks it has mapped.
+  // Shared caches are always at the maximum size, their mask is read by every thread.
+  // Both must be powers of 2.
+  constexpr static size_t L1_MIN_ENTRIES = 4 * 1024;
+  constexpr static size_t L1_MAX_ENTRIES = 1 * 1024 * 1024;
+
+  // Guest pages are hashed in to this many invalidation epochs by their low page number bits, must be a power of 2
+  constexpr static size_t INVALIDATION_EPOCH_PAGES = 1024;
 
   // This needs to be taken before reads or writes to L2, L3, CodePages, Thread::DebugStore,
   // and before writes to L1. Concurrent access from a thread that this LookupCache doesn't belong to
   // may only happen during cross thread invalidation (::Erase).
   // All other operations must be done from the owning thread.
+  // A shared LookupCache has no owning thread, every thread goes through this lock for L2 and L3.
   // Some care is taken so that L1 lookups can be done without locks, and even tearing is unlikely to lead to a crash.
   // This approach has not been fully vetted yet.
   // Also note that L1 lookups might be inlined in the JIT Dispatcher and/or block ends.
+  // L2 lookups in FindBlock are done without the lock, validated against WriteSequence.
   std::recursive_mutex WriteLock;
 
 private:
+  LookupCacheEntry &GetL1Entry(uint64_t Address) {
+    return reinterpret_cast<LookupCacheEntry*>(L1Pointer)[Address & L1Mask.load(std::memory_order_relaxed)];
+  }
+
+  size_t GetL1Entries() const {
+    return L1Mask.load(std::memory_order_relaxed) + 1;
+  }
+
+  // Must be used with WriteLock held
+  void SetL1Mask(uint64_t Mask) {
+    L1Mask.store(Mask, std::memory_order_relaxed);
+    if (L1MaskStorage) {
+      std::atomic_ref<uint64_t>(*L1MaskStorage).store(Mask, std::memory_order_relaxed);
+    }
+  }
+
+  // Must be used with WriteLock held, only by the owning thread
+  void GrowL1();
+
+  // Entries past the L1 mask are never looked up, the whole L1_MAX_ENTRIES is reserved up front
+  std::atomic<uint64_t> L1Mask{};
+  uint64_t *L1MaskStorage{};
+
+  // Bumped by lookups that missed L1 and L2 and by new blocks, needs WriteLock
+  uint64_t Activity{};
+  // Activity as of the previous release
+  uint64_t IdleCheckActivity{};
+  // Nothing has been cached since the memory was last released
+  bool Released{};
+
+  // Sequence lock guarding L2 and the L1 entries refilled from it.
+  // Odd while a writer is modifying L2, readers must retry through the lock in that case.
+  std::atomic<uint64_t> WriteSequence{};
+
+  // Bumped after a mapping on one of the guest pages hashed to the epoch is removed, ClearCache bumps all of them.
+  // JIT inline indirect branch caches tag their entry with the epoch of the target's page when it was filled in,
+  // and treat a mismatch as a miss. Invalidating one page leaves the inline caches of every other page intact.
+  // Starts at zero and never reaches the UINT64_MAX tag that empty caches are emitted with.
+  std::array<std::atomic<uint64_t>, INVALIDATION_EPOCH_PAGES> InvalidationEpochs{};
+
+  std::atomic<uint64_t> &GetInvalidationEpoch(uint64_t Address) {
+    return InvalidationEpochs[(Address >> 12) & (INVALIDATION_EPOCH_PAGES - 1)];
+  }
+
+  // Marks a write section in WriteSequence. Must be used with WriteLock held.
+  // Nested write sections, such as ClearL2Cache from CacheBlockMapping, only bump the sequence once.
+  class ScopedSequenceWrite final {
+  public:
+    explicit ScopedSequenceWrite(std::atomic<uint64_t> &Sequence)
+      : Sequence {Sequence}
+      , Outermost {(Sequence.load(std::memory_order_relaxed) & 1) == 0} {
+      if (Outermost) {
+        Sequence.fetch_add(1, std::memory_order_seq_cst);
+      }
+    }
+
+    ~ScopedSequenceWrite() {
+      if (Outermost) {
+        Sequence.fetch_add(1, std::memory_order_release);
+      }
+    }
+
+  private:
+    std::atomic<uint64_t> &Sequence;
+    bool Outermost;
+  };
+
+  uintptr_t FindBlockL2Lockless(uint64_t Address, LookupCacheEntry &L1Entry) {
+    const auto Sequence = WriteSequence.load(std::memory_order_acquire);
+    if (Sequence & 1) {
+      // Writer active
+      return 0;
+    }
+
+    const auto PageIndex = (Address & (VirtualMemSize -1)) >> 12;
+    const auto PageOffset = Address & (0x0FFF);
+
+    // L2 backing memory is never unmapped while the cache is alive, so a torn read here can't fault.
+    // It is only discarded, which makes stale reads return zero.
+    const auto Pointers = reinterpret_cast<uintptr_t*>(PagePointer);
+    auto LocalPagePointer = Pointers[PageIndex];
+    if (!LocalPagePointer) {
+      return 0;
+    }
+
+    auto BlockPointers = reinterpret_cast<LookupCacheEntry*>(LocalPagePointer);
+    const auto GuestCode = BlockPointers[PageOffset].GuestCode;
+    const auto HostCode = BlockPointers[PageOffset].HostCode;
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (GuestCode != Address || !HostCode || WriteSequence.load(std::memory_order_relaxed) != Sequence) {
+      return 0;
+    }
+
+    L1Entry.GuestCode = Address;
+    L1Entry.HostCode = HostCode;
+
+    // An Erase that started after the validation above could have missed this L1 refill.
+    // Check again, and back out of the refill if a writer snuck in.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (WriteSequence.load(std::memory_order_relaxed) != Sequence) {
+      L1Entry.GuestCode = 0;
+      return 0;
+    }
+
+    return HostCode;
+  }
+
+  // Must be used with WriteLock held, inside of a write section. The caller bumps the page's invalidation epoch.
+  void EraseUnlocked(uint64_t Address) {
+    // Sever any links to this block
+    if (auto it = BlockLinks->find(Address); it != BlockLinks->end()) {
+      for (auto &Link : it->second) {
+        Delink(Link);
+      }
+      BlockLinks->erase(it);
+    }
+
+    // Remove from BlockList
+    BlockList.erase(Address);
+    BlockGuestRanges.erase(Address);
+
+    // Do L1
+    auto &L1Entry = GetL1Entry(Address);
+    if (L1Entry.GuestCode == Address) {
+      L1Entry.GuestCode = 0;
+      // Leave L1Entry.HostCode as is, so that concurrent lookups won't read a null pointer
+      // This is a soft guarantee for cross thread invalidation, as atomics are not used
+      // and it hasn't been thoroughly tested
+    }
+
+    // Do full map
+    Address = Address & (VirtualMemSize -1);
+    uint64_t PageOffset = Address & (0x0FFF);
+    Address >>= 12;
+
+    uintptr_t *Pointers = reinterpret_cast<uintptr_t*>(PagePointer);
+    uint64_t LocalPagePointer = Pointers[Address];
+    if (!LocalPagePointer) {
+      // Page for this code didn't even exist, nothing to do
+      return;
+    }
+
+    // Page exists, just set the offset to zero
+    auto BlockPointers = reinterpret_cast<LookupCacheEntry*>(LocalPagePointer);
+    BlockPointers[PageOffset].GuestCode = 0;
+    BlockPointers[PageOffset].HostCode = 0;
+  }
+
   void CacheBlockMapping(uint64_t Address, uintptr_t HostCode) {
+    ScopedSequenceWrite SequenceWrite(WriteSequence);
+
     // Do L1
-    auto &L1Entry = reinterpret_cast<LookupCacheEntry*>(L1Pointer)[Address & L1_ENTRIES_MASK];
+    auto &L1Entry = GetL1Entry(Address);
     L1Entry.GuestCode = Address;
     L1Entry.HostCode = HostCode;
 
@@ -221,18 +497,10 @@ private:
   uintptr_t PageMemory;
   uintptr_t L1Pointer;
 
-  struct BlockLinkTag {
-    uint64_t GuestDestination;
+  struct BlockLinkRecord {
     uintptr_t HostLink;
-
-    bool operator <(const BlockLinkTag& other) const {
-      if (GuestDestination < other.GuestDestination)
-        return true;
-      else if (GuestDestination == other.GuestDestination)
-        return HostLink < other.HostLink;
-      else
-        return false;
-    }
+    BlockDelinkerFn Fn;
+    uintptr_t Data;
   };
 
   // Use a monotonic buffer resource to allocate both the std::pmr::map and its members.
@@ -242,21 +510,92 @@ private:
   //
   // This makes `BlockLinks` look like a raw pointer that could memory leak, but since it is backed by the MBR, it won't.
   std::pmr::monotonic_buffer_resource BlockLinks_mbr;
-  using BlockLinksMapType = std::pmr::map<BlockLinkTag, std::function<void()>>;
+
+  // Every link to a guest block, in a flat array per destination
+  using BlockLinksMapType = std::pmr::unordered_map<uint64_t, std::pmr::vector<BlockLinkRecord>>;
   fextl::unique_ptr<std::pmr::polymorphic_allocator<std::byte>> BlockLinks_pma;
   BlockLinksMapType *BlockLinks;
 
+  // Code patched by delinking that still needs an instruction cache flush, needs WriteLock
+  fextl::vector<BlockDelinkedRange> PendingICacheFlush;
+
+  void Delink(const BlockLinkRecord &Link) {
+    const auto Range = Link.Fn(Link.HostLink, Link.Data);
+    if (Range.Length) {
+      PendingICacheFlush.push_back(Range);
+    }
+  }
+
+  // Flushes the code patched by delinking, once per host page
+  void FlushDelinkedCode();
+
   fextl::robin_map<uint64_t, uint64_t> BlockList;
 
+  // Only filled in for blocks that can be suspended
+  fextl::robin_map<uint64_t, GuestCodeRange> BlockGuestRanges;
+
+  // Keyed by entry, the guest code of a block may start before it or end after it
+  fextl::map<uint64_t, SuspectBlock> SuspectBlocks;
+  // Furthest any suspect block's guest code reaches from its entry, bounds the search for overlapping blocks
+  uint64_t SuspectBlockReach{};
+
+  // Code page to the blocks on it. Each page's blocks are a list threaded through CodePageNodes,
+  // so tracking a block costs a slab node instead of a tree node and a vector per page.
+  constexpr static uint32_t INVALID_CODE_PAGE_NODE = ~0U;
+  struct CodePageNode {
+    uint64_t Address;
+    uint32_t Next;
+  };
+  fextl::robin_map<uint64_t, uint32_t> CodePages;
+  // Code pages are host pages, a write fault invalidates a whole host page so there is nothing to gain from finer keys
+  uint64_t CodePageShift {FHU::FEX_PAGE_SHIFT};
+  fextl::vector<CodePageNode> CodePageNodes;
+  // Freed nodes, linked through Next
+  uint32_t CodePageFreeList {INVALID_CODE_PAGE_NODE};
+
+  uint32_t AllocateCodePageNode() {
+    if (CodePageFreeList != INVALID_CODE_PAGE_NODE) {
+      const uint32_t Node = CodePageFreeList;
+      CodePageFreeList = CodePageNodes[Node].Next;
+      return Node;
+    }
+
+    CodePageNodes.emplace_back();
+    return CodePageNodes.size() - 1;
+  }
+
+  bool IsOnCodePage(uint32_t Head, uint64_t Address) const {
+    for (; Head != INVALID_CODE_PAGE_NODE; Head = CodePageNodes[Head].Next) {
+      if (CodePageNodes[Head].Address == Address) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Moves the blocks of a page to Blocks and frees its nodes
+  void TakePageBlocks(uint32_t Head, fextl::vector<uint64_t> *Blocks) {
+    while (Head != INVALID_CODE_PAGE_NODE) {
+      auto &Node = CodePageNodes[Head];
+      Blocks->push_back(Node.Address);
+
+      const uint32_t Next = Node.Next;
+      Node.Next = CodePageFreeList;
+      CodePageFreeList = Head;
+      Head = Next;
+    }
+  }
+
   size_t TotalCacheSize;
 
   constexpr static size_t CODE_SIZE = 128 * 1024 * 1024;
   constexpr static size_t SIZE_PER_PAGE = 4096 * sizeof(LookupCacheEntry);
-  constexpr static size_t L1_SIZE = L1_ENTRIES * sizeof(LookupCacheEntry);
+  constexpr static size_t L1_SIZE = L1_MAX_ENTRIES * sizeof(LookupCacheEntry);
 
   size_t AllocateOffset {};
 
   FEXCore::Context::ContextImpl *ctx;
   uint64_t VirtualMemSize{};
+  bool Shared{};
 };
 }
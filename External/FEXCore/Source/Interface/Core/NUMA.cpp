@@ -0,0 +1,145 @@
+/*
+$info$
+tags: glue|numa
+desc: Pins guest threads to NUMA nodes and migrates their FEX structures to the node
+$end_info$
+*/
+
+#include "Interface/Core/NUMA.h"
+
+#include <FEXCore/Utils/FileLoading.h>
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/Utils/MathUtils.h>
+#include <FEXCore/fextl/fmt.h>
+#include <FEXCore/fextl/string.h>
+#include <FEXHeaderUtils/TypeDefines.h>
+
+#include <charconv>
+#include <string_view>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace FEXCore::NUMA {
+// Calls Func for every entry of a sysfs list like "0-3,8,10-11"
+template<typename Fn>
+static void ForEachInList(std::string_view List, Fn Func) {
+  while (!List.empty()) {
+    const auto Comma = List.find(',');
+    const auto Range = List.substr(0, Comma);
+    List = Comma == std::string_view::npos ? std::string_view{} : List.substr(Comma + 1);
+
+    uint32_t First{}, Last{};
+    const auto Result = std::from_chars(Range.data(), Range.data() + Range.size(), First);
+    if (Result.ec != std::errc{}) {
+      return;
+    }
+
+    Last = First;
+    if (Result.ptr != Range.data() + Range.size() && *Result.ptr == '-') {
+      if (std::from_chars(Result.ptr + 1, Range.data() + Range.size(), Last).ec != std::errc{}) {
+        return;
+      }
+    }
+
+    for (uint32_t i = First; i <= Last; ++i) {
+      Func(i);
+    }
+  }
+}
+
+Placement::Placement() {
+  fextl::string Online;
+  if (!FEXCore::FileLoading::LoadFile(Online, "/sys/devices/system/node/online")) {
+    return;
+  }
+
+  cpu_set_t Allowed;
+  CPU_ZERO(&Allowed);
+  if (sched_getaffinity(0, sizeof(Allowed), &Allowed) != 0) {
+    return;
+  }
+
+  ForEachInList(Online, [&](uint32_t ID) {
+    fextl::string CPUList;
+    if (Nodes.size() == MAX_NODES ||
+        !FEXCore::FileLoading::LoadFile(CPUList, fextl::fmt::format("/sys/devices/system/node/node{}/cpulist", ID))) {
+      return;
+    }
+
+    Node NewNode {
+      .ID = ID,
+    };
+    CPU_ZERO(&NewNode.CPUs);
+    ForEachInList(CPUList, [&](uint32_t CPU) {
+      if (CPU < CPU_SETSIZE && CPU_ISSET(CPU, &Allowed)) {
+        CPU_SET(CPU, &NewNode.CPUs);
+      }
+    });
+
+    // Memory only nodes and nodes outside of our affinity can't run threads
+    if (CPU_COUNT(&NewNode.CPUs)) {
+      Nodes.emplace_back(NewNode);
+    }
+  });
+
+  if (Nodes.size() > 1) {
+    LogMan::Msg::DFmt("NUMA: Spreading guest threads over {} nodes", Nodes.size());
+  }
+}
+
+int32_t Placement::PinCurrentThread() {
+  if (Nodes.size() < 2) {
+    return -1;
+  }
+
+  // Racing thread starts may pick the same node, which only makes the spread a little uneven
+  size_t Best = 0;
+  for (size_t i = 1; i < Nodes.size(); ++i) {
+    if (ThreadCounts[i].load(std::memory_order_relaxed) < ThreadCounts[Best].load(std::memory_order_relaxed)) {
+      Best = i;
+    }
+  }
+
+  if (sched_setaffinity(0, sizeof(cpu_set_t), &Nodes[Best].CPUs) != 0) {
+    return -1;
+  }
+
+  ThreadCounts[Best].fetch_add(1, std::memory_order_relaxed);
+  return Best;
+}
+
+void Placement::ReleaseNode(int32_t Node) {
+  if (Node >= 0) {
+    ThreadCounts[Node].fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+
+void Placement::MovePages(int32_t Node, const void *Ptr, size_t Size) const {
+  if (Node < 0 || !Ptr || !Size) {
+    return;
+  }
+
+  // Same value as MPOL_MF_MOVE, only moves pages that aren't shared with another process
+  constexpr int FEX_MPOL_MF_MOVE = 1 << 1;
+  // Pages are handed to move_pages in batches from the stack so this never allocates
+  constexpr size_t BATCH_SIZE = 64;
+
+  void *Pages[BATCH_SIZE];
+  int TargetNodes[BATCH_SIZE];
+  int Status[BATCH_SIZE];
+
+  uintptr_t Page = FEXCore::AlignDown(reinterpret_cast<uintptr_t>(Ptr), FHU::FEX_PAGE_SIZE);
+  const uintptr_t End = FEXCore::AlignUp(reinterpret_cast<uintptr_t>(Ptr) + Size, FHU::FEX_PAGE_SIZE);
+
+  while (Page < End) {
+    size_t Count = 0;
+    for (; Count < BATCH_SIZE && Page < End; ++Count, Page += FHU::FEX_PAGE_SIZE) {
+      Pages[Count] = reinterpret_cast<void*>(Page);
+      TargetNodes[Count] = Nodes[Node].ID;
+    }
+
+    // Unpopulated pages report -ENOENT in Status, they land on the node when the pinned thread touches them
+    ::syscall(SYS_move_pages, 0, Count, Pages, TargetNodes, Status, FEX_MPOL_MF_MOVE);
+  }
+}
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <FEXCore/fextl/vector.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <sched.h>
+
+namespace FEXCore::NUMA {
+/**
+ * @brief Spreads guest threads over the host's NUMA nodes and keeps each thread's FEX state on its node
+ *
+ * Guest affinity requests are ignored, so otherwise the kernel is free to run a thread on a different node
+ * from the one its InternalThreadState, lookup cache and code buffers were first touched on.
+ * Each guest thread is pinned to the CPUs of the node running the fewest guest threads once it starts,
+ * its structures are then migrated there and anything allocated later is first touched locally.
+ *
+ * Nodes are limited to the CPUs FEX was allowed to run on, so an outer taskset is still respected.
+ */
+class Placement final {
+public:
+  Placement();
+
+  // Pins the calling thread to the least loaded node.
+  // Returns the node index, or -1 when there is only a single usable node.
+  int32_t PinCurrentThread();
+  // Drops a thread pinned by PinCurrentThread from its node's count
+  void ReleaseNode(int32_t Node);
+
+  // Moves the pages overlapping [Ptr, Ptr + Size) to the node, pages that aren't populated yet are skipped.
+  // Best effort, failures leave the pages where they are.
+  void MovePages(int32_t Node, const void *Ptr, size_t Size) const;
+
+private:
+  // Nodes past this are ignored
+  constexpr static size_t MAX_NODES = 64;
+
+  struct Node {
+    uint32_t ID;
+    cpu_set_t CPUs;
+  };
+
+  fextl::vector<Node> Nodes;
+  // Guest threads currently pinned to each node, indexed like Nodes
+  std::array<std::atomic<uint32_t>, MAX_NODES> ThreadCounts{};
+};
+}
@@ -44,14 +44,26 @@ namespace FEXCore::CodeSerialize {
     unsigned Is64BitMode : 1;
 
     // SMC checks style
-    unsigned SMCChecks : 2;
+    unsigned SMCChecks : 3;
 
     // x87 reduced precision
     unsigned x87ReducedPrecision : 1;
 
+    // x87 precision chosen per block
+    unsigned x87AdaptivePrecision : 1;
+
+    // Indirect branches carry an inline cache
+    unsigned IndirectBranchCache : 1;
+
+    // RBP based accesses skip TSO
+    unsigned TSOFramePointerRelaxed : 1;
+
+    // Block entries poll for safepoints
+    unsigned Safepoints : 1;
+
     // Padding to remove uninitialized data warning from asan
     // Shows remaining amount of bits available for config
-    unsigned _Pad : 17;
+    unsigned _Pad : 12;
 
     bool operator==(CodeObjectSerializationConfig const &other) const {
       return Cookie == other.Cookie &&
@@ -66,7 +78,11 @@ namespace FEXCore::CodeSerialize {
         ParanoidTSO == other.ParanoidTSO &&
         Is64BitMode == other.Is64BitMode &&
         SMCChecks == other.SMCChecks &&
-        x87ReducedPrecision == other.x87ReducedPrecision;
+        x87ReducedPrecision == other.x87ReducedPrecision &&
+        x87AdaptivePrecision == other.x87AdaptivePrecision &&
+        IndirectBranchCache == other.IndirectBranchCache &&
+        TSOFramePointerRelaxed == other.TSOFramePointerRelaxed &&
+        Safepoints == other.Safepoints;
     }
     static uint64_t GetHash(CodeObjectSerializationConfig const &other) {
       // For < 64-bits of data just pack directly
@@ -82,8 +98,12 @@ namespace FEXCore::CodeSerialize {
       Hash <<= 1;  Hash |= other.SRA;
       Hash <<= 1;  Hash |= other.ParanoidTSO;
       Hash <<= 1;  Hash |= other.Is64BitMode;
-      Hash <<= 2;  Hash |= other.SMCChecks;
+      Hash <<= 3;  Hash |= other.SMCChecks;
       Hash <<= 1;  Hash |= other.x87ReducedPrecision;
+      Hash <<= 1;  Hash |= other.x87AdaptivePrecision;
+      Hash <<= 1;  Hash |= other.IndirectBranchCache;
+      Hash <<= 1;  Hash |= other.TSOFramePointerRelaxed;
+      Hash <<= 1;  Hash |= other.Safepoints;
       return Hash;
     }
   };
@@ -6,10 +6,39 @@
 #include <FEXCore/fextl/string.h>
 #include <FEXHeaderUtils/Filesystem.h>
 
+#include <cstring>
 #include <fcntl.h>
+#include <iterator>
 #include <xxhash.h>
 
 namespace FEXCore::CodeSerialize {
+  bool PackRelocations(fextl::vector<FEXCore::CPU::Relocation> const &Relocations, fextl::vector<char> &Packed) {
+    for (auto &Reloc : Relocations) {
+      const void *RelocData{};
+      size_t RelocSize{};
+      switch (Reloc.Header.Type) {
+        case FEXCore::CPU::RelocationTypes::RELOC_NAMED_SYMBOL_LITERAL:
+          RelocData = &Reloc.NamedSymbolLiteral;
+          RelocSize = sizeof(Reloc.NamedSymbolLiteral);
+          break;
+        case FEXCore::CPU::RelocationTypes::RELOC_NAMED_THUNK_MOVE:
+          RelocData = &Reloc.NamedThunkMove;
+          RelocSize = sizeof(Reloc.NamedThunkMove);
+          break;
+        case FEXCore::CPU::RelocationTypes::RELOC_GUEST_RIP_MOVE:
+        default:
+          // Guest RIP relocation isn't supported by the loader
+          return false;
+      }
+
+      const auto Offset = Packed.size();
+      Packed.resize(Offset + RelocSize);
+      memcpy(&Packed[Offset], RelocData, RelocSize);
+    }
+
+    return true;
+  }
+
   void AsyncJobHandler::AsyncAddNamedRegionJob(uintptr_t Base, uintptr_t Size, uintptr_t Offset, const fextl::string &filename) {
 #ifndef _WIN32
     // This function adds a named region *JOB* to our named region handler
@@ -36,33 +65,37 @@ namespace FEXCore::CodeSerialize {
 
         auto &EntryMap = CodeObjectCacheService->GetEntryMap();
 
-        auto it = EntryMap.emplace(Base, std::move(Entry));
-        if (!it.second) {
+        auto it = EntryMap.find(Base);
+        if (it != EntryMap.end()) {
           // This happens when an application overwrites a previous region without unmapping what was there
 
           // Lock this entry's Named job reference counter.
           // Once this passes then we know that this section has been loaded.
-          it.first->second->NamedJobRefCountMutex.lock();
-
-          // Finalize anything the region needs to do first.
-          CodeObjectCacheService->DoCodeRegionClosure(it.first->second->Base, it.first->second.get());
+          it->second->NamedJobRefCountMutex.lock();
 
           // munmap the file that was mapped
-          FEXCore::Allocator::munmap(it.first->second->CodeData, it.first->second->FileSize);
+          if (it->second->CodeData) {
+            FEXCore::Allocator::munmap(it->second->CodeData, it->second->FileSize);
+          }
 
           // Remove this entry from the unrelocated map as well
           {
             std::unique_lock lk2 {CodeObjectCacheService->GetUnrelocatedEntryMapMutex()};
-            CodeObjectCacheService->GetUnrelocatedEntryMap().erase(it.first->second->EntryHeader.OriginalBase);
+            CodeObjectCacheService->GetUnrelocatedEntryMap().erase(it->second->EntryHeader.OriginalBase);
           }
 
+          // Serialization jobs may still be queued against the old entry.
+          // Hand it to the async thread so it is finalized in order with them.
+          const auto OldSize = it->second->Size;
+          NamedRegionHandler->AsyncRemoveNamedRegionWorkItem(Base, OldSize, std::move(it->second));
+
           // Now overwrite the entry in the map
-          it = EntryMap.insert_or_assign(Base, std::move(Entry));
-          EntryIterator = it.first;
+          it->second = std::move(Entry);
+          EntryIterator = it;
         }
         else {
           // No overwrite, just insert
-          EntryIterator = it.first;
+          EntryIterator = EntryMap.emplace(Base, std::move(Entry)).first;
         }
       }
 
@@ -82,41 +115,54 @@ namespace FEXCore::CodeSerialize {
   void AsyncJobHandler::AsyncRemoveNamedRegionJob(uintptr_t Base, uintptr_t Size) {
 #ifndef _WIN32
     // Removing a named region through the job system
-    // We need to find the entry that we are deleting first
-    fextl::unique_ptr<CodeRegionEntry> EntryPointer;
+    // Any region overlapping the range is removed, partial unmaps can't keep using the region's objects
+    bool Removed {};
     {
       std::unique_lock lk {CodeObjectCacheService->GetEntryMapMutex()};
 
       auto &EntryMap = CodeObjectCacheService->GetEntryMap();
-      auto it = EntryMap.find(Base);
-      if (it != EntryMap.end()) {
+
+      // Start from the region containing Base, if any
+      auto it = EntryMap.upper_bound(Base);
+      if (it != EntryMap.begin()) {
+        auto Prev = std::prev(it);
+        if ((Prev->second->Base + Prev->second->Size) > Base) {
+          it = Prev;
+        }
+      }
+
+      while (it != EntryMap.end() && it->first < (Base + Size) && it->first != ~0ULL) {
         // Lock the job ref counter since we are erasing it
         // Once this passes it will have been loaded
         it->second->NamedJobRefCountMutex.lock();
 
         // Take the pointer from the map
-        EntryPointer = std::move(it->second);
+        auto EntryPointer = std::move(it->second);
 
         // We can now unmap the file data
-        FEXCore::Allocator::munmap(EntryPointer->CodeData, EntryPointer->FileSize);
+        if (EntryPointer->CodeData) {
+          FEXCore::Allocator::munmap(EntryPointer->CodeData, EntryPointer->FileSize);
+        }
 
         // Remove this from the entry map
-        EntryMap.erase(it);
+        it = EntryMap.erase(it);
 
         // Remove this entry from the unrelocated map as well
         {
           std::unique_lock lk2 {CodeObjectCacheService->GetUnrelocatedEntryMapMutex()};
           CodeObjectCacheService->GetUnrelocatedEntryMap().erase(EntryPointer->EntryHeader.OriginalBase);
         }
-      }
-      else {
-        // Tried to remove something that wasn't in our code object tracking
-        return;
-      }
 
-      // Create the async work queue job now so it can finalize what it needs to do
-      NamedRegionHandler->AsyncRemoveNamedRegionWorkItem(Base, Size, std::move(EntryPointer));
+        // Create the async work queue job now so it can finalize what it needs to do
+        // This is queued behind any serialization jobs for the entry
+        const auto EntryBase = EntryPointer->Base;
+        const auto EntrySize = EntryPointer->Size;
+        NamedRegionHandler->AsyncRemoveNamedRegionWorkItem(EntryBase, EntrySize, std::move(EntryPointer));
+        Removed = true;
+      }
+    }
 
+    if (Removed) {
       // Tell the async thread that it has work to do
       CodeObjectCacheService->NotifyWork();
     }
@@ -124,6 +170,61 @@ namespace FEXCore::CodeSerialize {
   }
 
   void AsyncJobHandler::AsyncAddSerializationJob(fextl::unique_ptr<SerializationJobData> Data) {
-    // XXX: Actually add serialization job
+#ifndef _WIN32
+    // Runs on the JIT thread right after compiling, before the block has been linked or run
+
+    if (!PackRelocations(Data->Relocations, Data->PackedRelocations)) {
+      return;
+    }
+
+    {
+      std::shared_lock lk {CodeObjectCacheService->GetEntryMapMutex()};
+
+      auto &EntryMap = CodeObjectCacheService->GetEntryMap();
+      auto it = EntryMap.upper_bound(Data->GuestRIP);
+      if (it == EntryMap.begin()) {
+        return;
+      }
+      --it;
+
+      auto Region = it->second.get();
+      const auto RegionEnd = Region->Base + Region->Size;
+
+      // The whole guest code range must come from this one region
+      if (Data->GuestRIP >= RegionEnd ||
+          Data->GuestCodeStart < Region->Base ||
+          (Data->GuestCodeStart + Data->GuestCodeLength) > RegionEnd) {
+        return;
+      }
+
+      {
+        // Skip blocks that the file already holds a usable object for.
+        // A region still being loaded doesn't block the JIT, the duplicate just replaces the old record.
+        std::shared_lock Loaded {Region->NamedJobRefCountMutex, std::try_to_lock};
+        if (Loaded.owns_lock()) {
+          auto Section = Region->SectionLookupMap.find(Data->GuestRIP);
+          if (Section != Region->SectionLookupMap.end() && !Section->second->Invalid) {
+            return;
+          }
+        }
+      }
+
+      // Copy now, the JIT backpatches block links in to the live code once it runs
+      Data->Region = Region;
+      Data->HostCode.resize(Data->HostCodeLength);
+      memcpy(Data->HostCode.data(), Data->HostCodeBegin, Data->HostCodeLength);
+      Data->HostCodeHash = XXH3_64bits(Data->HostCode.data(), Data->HostCode.size());
+      Data->GuestCodeHash = XXH3_64bits(reinterpret_cast<const void*>(Data->GuestCodeStart), Data->GuestCodeLength);
+
+      // Released by the async thread once the job is written out
+      Data->ThreadJobRefCount->lock_shared();
+
+      // Queued while holding the entry map lock so a removal of this region is always queued after it
+      NamedRegionHandler->AsyncSerializeCodeWorkItem(std::move(Data));
+    }
+
+    // Tell the async thread that it has work to do
+    CodeObjectCacheService->NotifyWork();
+#endif
   }
 }
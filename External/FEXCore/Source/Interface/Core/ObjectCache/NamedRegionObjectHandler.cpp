@@ -1,44 +1,256 @@
 #include "Interface/Context/Context.h"
 #include "Interface/Core/ObjectCache/ObjectCacheService.h"
 
-
+#include <FEXCore/Config/Config.h>
+#include <FEXCore/Utils/Allocator.h>
+#include <FEXCore/fextl/fmt.h>
 #include <FEXCore/fextl/memory.h>
 #include <FEXCore/fextl/string.h>
 
+#include <array>
+#include <cstring>
+#include <fcntl.h>
+#ifndef _WIN32
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#endif
+#include <unistd.h>
+#include <xxhash.h>
+
 namespace FEXCore::CodeSerialize {
-  NamedRegionObjectHandler::NamedRegionObjectHandler(FEXCore::Context::ContextImpl *ctx) {
-    DefaultSerializationConfig.Cookie = CODE_COOKIE;
+  NamedRegionObjectHandler::NamedRegionObjectHandler(FEXCore::Context::ContextImpl *ctx)
+    : CTX {ctx}
+    , DefaultSerializationConfig {GenerateSerializationConfig(ctx)} {
+  }
+
+  CodeObjectSerializationConfig NamedRegionObjectHandler::GenerateSerializationConfig(FEXCore::Context::ContextImpl *ctx) {
+    CodeObjectSerializationConfig Config{};
+    Config.Cookie = CODE_COOKIE;
 
     // Initialize the Arch from CPUID
     uint32_t Arch = ctx->CPUID.RunFunction(0x4000'0001, 0).eax & 0xF;
-    DefaultSerializationConfig.Arch = Arch;
-
-    DefaultSerializationConfig.MaxInstPerBlock = ctx->Config.MaxInstPerBlock;
-    DefaultSerializationConfig.MultiBlock = ctx->Config.Multiblock;
-    DefaultSerializationConfig.TSOEnabled = ctx->Config.TSOEnabled;
-    DefaultSerializationConfig.ABILocalFlags = ctx->Config.ABILocalFlags;
-    DefaultSerializationConfig.ABINoPF = ctx->Config.ABINoPF;
-    DefaultSerializationConfig.SRA = ctx->Config.StaticRegisterAllocation;
-    DefaultSerializationConfig.ParanoidTSO = ctx->Config.ParanoidTSO;
-    DefaultSerializationConfig.Is64BitMode = ctx->Config.Is64BitMode;
-    DefaultSerializationConfig.SMCChecks = ctx->Config.SMCChecks;
-    DefaultSerializationConfig.x87ReducedPrecision = ctx->Config.x87ReducedPrecision;
+    Config.Arch = Arch;
+
+    Config.MaxInstPerBlock = ctx->Config.MaxInstPerBlock;
+    Config.MultiBlock = ctx->Config.Multiblock;
+    Config.TSOEnabled = ctx->Config.TSOEnabled;
+    Config.HardwareTSOEnabled = ctx->IsHardwareTSOEnabled();
+    Config.ABILocalFlags = ctx->Config.ABILocalFlags;
+    Config.ABINoPF = ctx->Config.ABINoPF;
+    Config.SRA = ctx->Config.StaticRegisterAllocation;
+    Config.ParanoidTSO = ctx->Config.ParanoidTSO;
+    Config.TSOFramePointerRelaxed = ctx->Config.TSOFramePointerRelaxed;
+    Config.Is64BitMode = ctx->Config.Is64BitMode;
+    Config.SMCChecks = ctx->Config.SMCChecks;
+    Config.x87ReducedPrecision = ctx->Config.x87ReducedPrecision;
+    Config.x87AdaptivePrecision = ctx->Config.x87AdaptivePrecision;
+    Config.Safepoints = ctx->Config.Safepoints;
+    // Matches the JIT, the inline cache is dropped when code is shared between threads
+    Config.IndirectBranchCache = ctx->Config.IndirectBranchCache && !ctx->Config.SharedCodeCache;
+    return Config;
+  }
+
+  bool NamedRegionObjectHandler::LoadNamedRegionObjects(CodeRegionEntry *Entry) {
+#ifndef _WIN32
+    int FD = Entry->ExternalObjectFile ?
+      dup(Entry->CurrentSerializedFD) :
+      open(Entry->ObjectEntrySourceFilename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (FD == -1) {
+      return false;
+    }
+
+    // Writers append whole records under an exclusive lock, a shared lock gives a consistent file size
+    flock(FD, LOCK_SH);
+    struct stat buf{};
+    void *FilePtr = MAP_FAILED;
+    if (fstat(FD, &buf) == 0 && static_cast<size_t>(buf.st_size) >= sizeof(CodeObjectSerializationHeader)) {
+      FilePtr = FEXCore::Allocator::mmap(nullptr, buf.st_size, PROT_READ, MAP_PRIVATE, FD, 0);
+    }
+    flock(FD, LOCK_UN);
+    close(FD);
+
+    if (FilePtr == MAP_FAILED) {
+      return false;
+    }
+
+    const size_t FileSize = buf.st_size;
+    auto Header = reinterpret_cast<const CodeObjectSerializationHeader*>(FilePtr);
+
+    if (!(Header->Config == DefaultSerializationConfig) ||
+        Header->OriginalOffset != Entry->Offset) {
+      // Stale file from a different code version, start over
+      FEXCore::Allocator::munmap(FilePtr, FileSize);
+      if (Entry->ExternalObjectFile) {
+        // Can't start over in a file other processes still use
+        Entry->StillSerializing = false;
+      }
+      else {
+        unlink(Entry->ObjectEntrySourceFilename.c_str());
+      }
+      return false;
+    }
+
+    if (Header->OriginalBase != Entry->Base) {
+      // Guest addresses are baked in to the host code, only a region mapped at its original base can use it.
+      // Leave the file alone for the next process that maps it there.
+      FEXCore::Allocator::munmap(FilePtr, FileSize);
+      Entry->StillSerializing = false;
+      return false;
+    }
+
+    Entry->CodeData = reinterpret_cast<char*>(FilePtr);
+    Entry->FileSize = FileSize;
+    Entry->EntryHeader = *Header;
+
+    // Walk the records once to size the section tables.
+    // A truncated record at the end is left from a crashed writer and is ignored.
+    auto ForEachRecord = [&](auto Func) {
+      size_t Offset = sizeof(CodeObjectSerializationHeader);
+      while ((Offset + sizeof(CodeSerializationData)) <= FileSize) {
+        auto Data = reinterpret_cast<const CodeSerializationData*>(Entry->CodeData + Offset);
+        if (Data->HostCodeLength > FileSize || Data->RelocationsSize > FileSize ||
+            (Offset + Data->GetRecordSize()) > FileSize) {
+          break;
+        }
+        Func(Data, Entry->CodeData + Offset + sizeof(CodeSerializationData));
+        Offset += Data->GetRecordSize();
+      }
+    };
+
+    size_t NumRecords{};
+    ForEachRecord([&](const CodeSerializationData *, const char *) { ++NumRecords; });
+
+    // SectionLookupMap points in to FileCodeSections, it must not reallocate after this.
+    Entry->FileCodeSections.reserve(NumRecords);
+    Entry->SectionLookupMap.reserve(NumRecords);
+
+    ForEachRecord([&](const CodeSerializationData *Data, const char *HostCode) {
+      auto &Section = Entry->FileCodeSections.emplace_back(CodeObjectFileSection {
+        .Serialized = true,
+        .Invalid = false,
+        .Data = Data,
+        .HostCode = HostCode,
+        .NumRelocations = Data->NumRelocations,
+        .Relocations = HostCode + FEXCore::AlignUp(Data->HostCodeLength, 8),
+      });
+
+      // Records appended later replace earlier ones for the same block
+      Entry->SectionLookupMap.insert_or_assign(Entry->Base + Data->GuestRIPOffset, &Section);
+    });
+
+    return true;
+#else
+    return false;
+#endif
   }
 
   void NamedRegionObjectHandler::AddNamedRegionObject(CodeRegionMapType::iterator Entry, const fextl::string &base_filename, const fextl::string &filename, bool Executable) {
-    // XXX: Add named region objects
+    auto Region = Entry->second.get();
 
-    // XXX: Until entry loading is complete just claim it is loaded
-    Entry->second->NamedJobRefCountMutex.unlock();
+    // Keyed by the file's identity and the offset this region maps, so the same segment finds its objects again.
+    // The config hash keeps differently configured processes from fighting over one file.
+    const auto FilenameHash = XXH3_64bits(filename.c_str(), filename.size());
+    const auto ObjectName = fextl::fmt::format("{}-{:016x}-{:x}-{:016x}.fexobj",
+      base_filename,
+      FilenameHash,
+      Region->Offset,
+      CodeObjectSerializationConfig::GetHash(DefaultSerializationConfig));
+    Region->ObjectEntrySourceFilename = fextl::fmt::format("{}/objectcache/{}", FEXCore::Config::GetDataDirectory(), ObjectName);
+
+    if (auto &Opener = CTX->GetCodeObjectFileOpener()) {
+      // The frontend can hand out one file per name to every process, eg. through FEXServer
+      Region->CurrentSerializedFD = Opener(ObjectName);
+      Region->ExternalObjectFile = Region->CurrentSerializedFD != -1;
+    }
+
+    LoadNamedRegionObjects(Region);
+
+    if (CTX->Config.CacheObjectCodeCompilation() != FEXCore::Config::ConfigObjectCodeHandler::CONFIG_READWRITE) {
+      Region->StillSerializing = false;
+    }
+
+    // Region is loaded, unblock JIT code cache lookups
+    Region->NamedJobRefCountMutex.unlock();
   }
 
   void NamedRegionObjectHandler::RemoveNamedRegionObject(uintptr_t Base, uintptr_t Size, fextl::unique_ptr<CodeRegionEntry> Entry) {
-    // XXX: Remove named region objects
+    // Every serialization job for this region was queued ahead of this removal, so the FD can be closed now
+    if (Entry->CurrentSerializedFD != -1) {
+      close(Entry->CurrentSerializedFD);
+      Entry->CurrentSerializedFD = -1;
+    }
 
-    // XXX: Until entry loading is complete just claim it is loaded
     Entry->NamedJobRefCountMutex.unlock();
   }
 
+  void NamedRegionObjectHandler::SerializeCodeObject(AsyncJobHandler::SerializationJobData *Data) {
+#ifndef _WIN32
+    auto Region = Data->Region;
+
+    if (Region->StillSerializing && Region->CurrentSerializedFD == -1) {
+      Region->CurrentSerializedFD = open(Region->ObjectEntrySourceFilename.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+      if (Region->CurrentSerializedFD == -1) {
+        Region->StillSerializing = false;
+      }
+    }
+
+    if (Region->StillSerializing) {
+      const int FD = Region->CurrentSerializedFD;
+
+      CodeSerializationData Record {
+        .GuestRIPOffset = Data->GuestRIP - Region->Base,
+        .GuestCodeOffset = Data->GuestCodeStart - Region->Base,
+        .GuestCodeLength = Data->GuestCodeLength,
+        .GuestCodeHash = Data->GuestCodeHash,
+        .HostCodeLength = Data->HostCode.size(),
+        .HostEntryOffset = Data->HostEntryOffset,
+        .HostCodeHash = Data->HostCodeHash,
+        .NumRelocations = Data->Relocations.size(),
+        .RelocationsSize = Data->PackedRelocations.size(),
+      };
+
+      const uint64_t Padding[1]{};
+      const size_t PaddingSize = FEXCore::AlignUp(Record.HostCodeLength, 8) - Record.HostCodeLength;
+
+      // Other processes append to the same file, a record must land in one piece
+      flock(FD, LOCK_EX);
+
+      struct stat buf{};
+      fstat(FD, &buf);
+
+      // The header is only written by whoever creates the file
+      const bool NeedsHeader = buf.st_size == 0;
+      std::array<iovec, 5> Vectors {{
+        { &Region->EntryHeader, NeedsHeader ? sizeof(Region->EntryHeader) : 0 },
+        { &Record, sizeof(Record) },
+        { Data->HostCode.data(), Data->HostCode.size() },
+        { const_cast<uint64_t*>(Padding), PaddingSize },
+        { Data->PackedRelocations.data(), Data->PackedRelocations.size() },
+      }};
+
+      size_t TotalSize{};
+      for (auto &Vector : Vectors) {
+        TotalSize += Vector.iov_len;
+      }
+
+      if (writev(FD, Vectors.data(), Vectors.size()) != static_cast<ssize_t>(TotalSize)) {
+        // Drop the partial record so the file stays parseable for the next writer
+        if (ftruncate(FD, buf.st_size) != 0) {
+          LogMan::Msg::EFmt("Couldn't recover object cache file '{}'", Region->ObjectEntrySourceFilename);
+        }
+        Region->StillSerializing = false;
+      }
+
+      flock(FD, LOCK_UN);
+    }
+#endif
+
+    // Job is done, let the owning thread shut down or clear its code cache
+    Data->ThreadJobRefCount->unlock_shared();
+  }
+
   void NamedRegionObjectHandler::HandleNamedRegionObjectJobs() {
     // Walk through all of our jobs sequentially until the work queue is empty
     while (NamedWorkQueueJobs.load()) {
@@ -67,6 +279,11 @@ namespace FEXCore::CodeSerialize {
           auto WorkRemove = static_cast<AsyncJobHandler::WorkItemRemoveNamedRegion *>(WorkItem.get());
           RemoveNamedRegionObject(WorkRemove->Base, WorkRemove->Size, std::move(WorkRemove->Entry));
         }
+
+        if (WorkItem->GetType() == AsyncJobHandler::NamedRegionJobType::JOB_SERIALIZE_CODE) {
+          auto WorkSerialize = static_cast<AsyncJobHandler::WorkItemSerializeCode *>(WorkItem.get());
+          SerializeCodeObject(WorkSerialize->Data.get());
+        }
       }
     }
   }
@@ -1,8 +1,13 @@
 #include "Interface/Core/ObjectCache/ObjectCacheService.h"
 
 #include <FEXCore/Config/Config.h>
+#include <FEXCore/fextl/fmt.h>
 #include <FEXCore/fextl/memory.h>
 #include <FEXCore/Utils/Threads.h>
+#include <FEXHeaderUtils/Filesystem.h>
+
+#include <unistd.h>
+#include <xxhash.h>
 
 namespace {
   static void* ThreadHandler(void *Arg) {
@@ -41,6 +46,10 @@ namespace FEXCore::CodeSerialize {
     auto it = AddressToEntryMap.insert_or_assign(~0ULL, fextl::make_unique<CodeRegionEntry>());
     UnrelocatedAddressToEntryMap.insert_or_assign(~0ULL, it.first->second.get());
 
+    if (CTX->Config.CacheObjectCodeCompilation() == FEXCore::Config::ConfigObjectCodeHandler::CONFIG_READWRITE) {
+      FHU::Filesystem::CreateDirectories(fextl::fmt::format("{}/objectcache", FEXCore::Config::GetDataDirectory()));
+    }
+
     uint64_t OldMask = FEXCore::Threads::SetSignalMask(~0ULL);
     WorkerThread = FEXCore::Threads::Thread::Create(ThreadHandler, this);
     FEXCore::Threads::SetSignalMask(OldMask);
@@ -51,12 +60,47 @@ namespace FEXCore::CodeSerialize {
       // Don't do closure on canary
       return;
     }
-    // XXX: Do code region closure
+
+    if (it->CurrentSerializedFD != -1) {
+      close(it->CurrentSerializedFD);
+      it->CurrentSerializedFD = -1;
+    }
   }
 
-  CodeObjectFileSection const *CodeObjectSerializeService::FetchCodeObjectFromCache(uint64_t GuestRIP) {
-    // XXX: Actually fetch code objects from cache
-    return nullptr;
+  CodeObjectFetchResult CodeObjectSerializeService::FetchCodeObjectFromCache(uint64_t GuestRIP) {
+    CodeObjectFetchResult Result{};
+
+    std::shared_lock lk {EntryMapMutex};
+
+    auto it = AddressToEntryMap.upper_bound(GuestRIP);
+    if (it == AddressToEntryMap.begin()) {
+      return Result;
+    }
+    --it;
+
+    auto Region = it->second.get();
+    if (GuestRIP >= (Region->Base + Region->Size)) {
+      return Result;
+    }
+
+    {
+      // Wait for the async thread to finish loading this region's objects.
+      // Regions are loaded when they are mapped, so this only blocks when code runs right after its mmap.
+      std::shared_lock Loaded {Region->NamedJobRefCountMutex};
+    }
+
+    auto SectionIt = Region->SectionLookupMap.find(GuestRIP);
+    if (SectionIt == Region->SectionLookupMap.end() || SectionIt->second->Invalid) {
+      return Result;
+    }
+
+    auto Section = SectionIt->second;
+
+    Result.RegionLock = std::move(lk);
+    Result.Section = Section;
+    Result.GuestCodeStart = Region->Base + Section->Data->GuestCodeOffset;
+    Result.GuestCodeLength = Section->Data->GuestCodeLength;
+    return Result;
   }
 
   void CodeObjectSerializeService::ExecutionThread() {
@@ -69,9 +113,12 @@ namespace FEXCore::CodeSerialize {
       // Handle named region async jobs first. Highest priority
       NamedRegionHandler.HandleNamedRegionObjectJobs();
 
-      // XXX: Handle code serialization jobs second.
+      // Code serialization jobs share the named region queue
     }
 
+    // Flush out anything queued before shutdown so this process' code makes it to disk
+    NamedRegionHandler.HandleNamedRegionObjectJobs();
+
     // Do final code region closures on thread shutdown
     for (auto &it : AddressToEntryMap) {
       DoCodeRegionClosure(it.first, it.second.get());
@@ -5,6 +5,7 @@
 #include "Interface/IR/AOTIR.h"
 
 #include <FEXCore/Utils/Event.h>
+#include <FEXCore/Utils/MathUtils.h>
 #include <FEXCore/Utils/Threads.h>
 #include <FEXCore/fextl/map.h>
 #include <FEXCore/fextl/memory.h>
@@ -18,11 +19,49 @@
 namespace FEXCore::CodeSerialize {
   // XXX: Does this need to be signal safe?
   using CodeSerializationMutex = std::shared_mutex;
+
+  /**
+   * @brief Header of a single code object inside of an object cache file
+   *
+   * Laid out in the file as:
+   * [CodeSerializationData]
+   * [Host code, padded to 8 bytes]
+   * [Relocations, `RelocationsSize` bytes]
+   */
   struct CodeSerializationData {
+    // Guest RIP of the block entry, relative to the named region base
+    uint64_t GuestRIPOffset;
+    // Guest code range the block was compiled from, relative to the named region base
+    uint64_t GuestCodeOffset;
+    uint64_t GuestCodeLength;
+    // XXH3 of the guest code range, validated before the object is used
+    uint64_t GuestCodeHash;
+
+    // Size of the host code block from its JITCodeHeader through its tail data
+    uint64_t HostCodeLength;
+    // Offset of the host entrypoint from the start of the host code block
+    uint64_t HostEntryOffset;
+    // XXH3 of the host code before relocations were applied
+    uint64_t HostCodeHash;
+
+    uint64_t NumRelocations;
+    uint64_t RelocationsSize;
+
+    uint64_t GetRecordSize() const {
+      return sizeof(CodeSerializationData) + FEXCore::AlignUp(HostCodeLength, 8) + RelocationsSize;
+    }
   };
 
+  /**
+   * @brief Packs relocations down to their per type size, as the backends consume them
+   *
+   * @return false if a relocation can't be applied by the loader, the code then can't be cached
+   */
+  bool PackRelocations(fextl::vector<FEXCore::CPU::Relocation> const &Relocations, fextl::vector<char> &Packed);
+
   struct CodeObjectFileSection {
     bool Serialized;
+    // Set when the guest code no longer matches or relocation failed, the section won't be tried again
     bool Invalid;
     const CodeSerializationData *Data;
     const char *HostCode;
@@ -30,6 +69,20 @@ namespace FEXCore::CodeSerialize {
     const char *Relocations;
   };
 
+  /**
+   * @brief Result of looking up a code object
+   *
+   * The section points in to the named region's file mapping.
+   * `RegionLock` keeps the region from being unmapped until the caller is done relocating.
+   */
+  struct CodeObjectFetchResult {
+    std::shared_lock<CodeSerializationMutex> RegionLock;
+    CodeObjectFileSection *Section{};
+    // Guest code range the object was compiled from, its hash is checked once the range is protected
+    uint64_t GuestCodeStart{};
+    uint64_t GuestCodeLength{};
+  };
+
   /**
    * @brief This is the file header that lives at the start of an object cache file
    *
@@ -75,6 +128,10 @@ namespace FEXCore::CodeSerialize {
     // The filename of the object cache for this entry
     fextl::string ObjectEntrySourceFilename{};
 
+    // The object file was provided by the frontend's opener instead of the data directory.
+    // It is already open in CurrentSerializedFD and other processes might be mapping it, so it is never removed.
+    bool ExternalObjectFile {false};
+
     // In the case of file corruption that we can detect, we can disable serialization early for an entry
     // We should be resiliant to corruption but things happen
     bool StillSerializing {true};
@@ -145,12 +202,13 @@ namespace FEXCore::CodeSerialize {
        */
       struct SerializationJobData {
         uint64_t GuestRIP;        ///< The RIP for the guest
-        // XXX: Support multiblock
+        uint64_t GuestCodeStart;  ///< Start of the guest code range, differs from GuestRIP with multiblock
         uint64_t GuestCodeLength; ///< The Guest's code length
         uint64_t GuestCodeHash;   ///< Hash of the guest code
 
         void *HostCodeBegin;      ///< Host JIT code starting memory address
         size_t HostCodeLength;    ///< Host JIT code length
+        size_t HostEntryOffset;   ///< Offset of the host entrypoint from HostCodeBegin
         uint64_t HostCodeHash;    ///< Host JIT code hash before any backpatching
 
         // This is the thread specific ref counter for outstanding jobs.
@@ -166,14 +224,15 @@ namespace FEXCore::CodeSerialize {
         /**
          * @name Objects filled in from the Code Object Serialization service when a job is added
          * @{ */
-          // This is the code region's ref counter for outstanding jobs.
-          // This shared mutex is incremented when the job is added, then decremented when the job is complete.
-          // If a named region is being removed then a unique lock will be pulled to wait for all jobs to complete and no new jobs to be added.
-          CodeSerializationMutex *ObjectJobRefCountMutexPtr;
-
-          // This is the code region iterator to reduce the number of map lookups
-          // This will remain valid while jobs are outstanding for this region
-          CodeRegionMapType::iterator CodeRegionIterator;
+          // The code region this job serializes in to.
+          // Jobs share the named region FIFO so a region is never removed before its outstanding jobs are done.
+          CodeRegionEntry *Region;
+
+          // Copy of the host code taken when the job was added, before the JIT backpatches any block links
+          fextl::vector<char> HostCode;
+
+          // Relocations packed to their per type size, as the backends consume them
+          fextl::vector<char> PackedRelocations;
         /**  @} */
       };
 
@@ -198,11 +257,12 @@ namespace FEXCore::CodeSerialize {
         /**
          * @brief The async named region jobs to handle.
          *
-         * Only two, Code serialization goes in to a different queue.
+         * Code serialization shares the queue so it is ordered against its region's removal.
          */
         enum class NamedRegionJobType {
           JOB_ADD_NAMED_REGION,
           JOB_REMOVE_NAMED_REGION,
+          JOB_SERIALIZE_CODE,
         };
 
         class NamedRegionWorkItem {
@@ -211,6 +271,8 @@ namespace FEXCore::CodeSerialize {
 
           protected:
             friend class WorkItemAddNamedRegion;
+            friend class WorkItemRemoveNamedRegion;
+            friend class WorkItemSerializeCode;
             NamedRegionWorkItem(NamedRegionJobType type)
               : Type {type} {}
 
@@ -245,6 +307,15 @@ namespace FEXCore::CodeSerialize {
             uint64_t Size;
             fextl::unique_ptr<CodeRegionEntry> Entry;
         };
+
+        class WorkItemSerializeCode : public NamedRegionWorkItem {
+          public:
+            WorkItemSerializeCode(fextl::unique_ptr<SerializationJobData> data)
+              : NamedRegionWorkItem {NamedRegionJobType::JOB_SERIALIZE_CODE}
+              , Data {std::move(data)} {}
+
+            fextl::unique_ptr<SerializationJobData> Data;
+        };
       /**  @} */
 
     private:
@@ -262,6 +333,9 @@ namespace FEXCore::CodeSerialize {
         return DefaultSerializationConfig;
       }
 
+      // Serialization config matching the code this process' configuration generates
+      static CodeObjectSerializationConfig GenerateSerializationConfig(FEXCore::Context::ContextImpl *ctx);
+
     protected:
       friend class AsyncJobHandler;
 
@@ -303,9 +377,19 @@ namespace FEXCore::CodeSerialize {
         ++NamedWorkQueueJobs;
       }
 
+      void AsyncSerializeCodeWorkItem(fextl::unique_ptr<AsyncJobHandler::SerializationJobData> Data) {
+        std::unique_lock lk {NamedWorkQueueMutex};
+        WorkQueue.emplace(fextl::make_unique<AsyncJobHandler::WorkItemSerializeCode> (
+          std::move(Data)
+        ));
+        ++NamedWorkQueueJobs;
+      }
+
     private:
       // Code version. If the code emission changes then this needs to increment
-      constexpr static uint32_t CODE_VERSION = 0x0;
+      constexpr static uint32_t CODE_VERSION = 0x2;
+
+      FEXCore::Context::ContextImpl *CTX;
 
       // Default cookie header for the file header
       constexpr static uint64_t CODE_COOKIE = FEXCore::IR::COOKIE_VERSION("FEXC", CODE_VERSION);
@@ -329,6 +413,14 @@ namespace FEXCore::CodeSerialize {
        * @{ */
         void AddNamedRegionObject(CodeRegionMapType::iterator Entry, const fextl::string &base_filename, const fextl::string &filename, bool Executable);
         void RemoveNamedRegionObject(uintptr_t Base, uintptr_t Size, fextl::unique_ptr<CodeRegionEntry> Entry);
+        void SerializeCodeObject(AsyncJobHandler::SerializationJobData *Data);
+
+        /**
+         * @brief Maps a region's object cache file and builds its section lookup map
+         *
+         * @return false if the file doesn't exist or doesn't match this region and configuration
+         */
+        bool LoadNamedRegionObjects(CodeRegionEntry *Entry);
       /**  @} */
   };
 
@@ -413,7 +505,7 @@ namespace FEXCore::CodeSerialize {
          *
          * @return Data required for the JIT to relocate the Object code.
          */
-        CodeObjectFileSection const *FetchCodeObjectFromCache(uint64_t GuestRIP);
+        CodeObjectFetchResult FetchCodeObjectFromCache(uint64_t GuestRIP);
       /**  @} */
 
       // Public for threading
@@ -430,7 +522,7 @@ namespace FEXCore::CodeSerialize {
       void DoCodeRegionClosure(uint64_t Base, CodeRegionEntry *it);
 
       CodeSerializationMutex &GetEntryMapMutex() { return EntryMapMutex; }
-      CodeSerializationMutex &GetUnrelocatedEntryMapMutex() { return EntryMapMutex; }
+      CodeSerializationMutex &GetUnrelocatedEntryMapMutex() { return UnrelocatedEntryMapMutex; }
 
       CodeRegionMapType &GetEntryMap() { return AddressToEntryMap; }
       CodeRegionPtrMapType &GetUnrelocatedEntryMap() { return UnrelocatedAddressToEntryMap; }
@@ -25,6 +25,11 @@ $end_info$
 #include <cstdint>
 #include <tuple>
 
+#ifndef _WIN32
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
 namespace FEXCore::IR {
 
 using X86Tables::OpToIndex;
@@ -130,6 +135,8 @@ void OpDispatchBuilder::SyscallOp(OpcodeArgs) {
     Arguments[5],
     Arguments[6],
     DefaultSyscallFlags);
+  // arch_prctl and set_thread_area change the segment bases
+  InvalidateSegmentBases();
 
   if (OSABI != FEXCore::HLE::SyscallOSABI::OS_HANGOVER &&
       (DefaultSyscallFlags & FEXCore::IR::SyscallFlags::NORETURNEDRESULT) != FEXCore::IR::SyscallFlags::NORETURNEDRESULT) {
@@ -153,6 +160,8 @@ void OpDispatchBuilder::ThunkOp(OpcodeArgs) {
   const uint8_t GPRSize = CTX->GetGPRSize();
   uint8_t *sha256 = (uint8_t *)(Op->PC + 2);
 
+  InvalidateSegmentBases();
+
   if (CTX->Config.Is64BitMode) {
     // x86-64 ABI puts the function argument in RDI
     _Thunk(
@@ -177,6 +186,11 @@ void OpDispatchBuilder::ThunkOp(OpcodeArgs) {
   StoreGPRRegister(X86State::REG_RSP, NewSP);
   CalculateDeferredFlags();
 
+  if (CTX->Config.ReturnStackBuffer) {
+    // Guest thunk stubs are CALLed, so returning from one is predicted like a RET
+    _ReturnStackLookup(NewRIP);
+  }
+
   // Store the new RIP
   _ExitFunction(NewRIP);
   BlockSetRIP = true;
@@ -240,6 +254,21 @@ void OpDispatchBuilder::RETOp(OpcodeArgs) {
   StoreGPRRegister(X86State::REG_RSP, NewSP);
   CalculateDeferredFlags();
 
+  // Return from a callee inlined in to this function.
+  // The inlined call skipped the return stack buffer, so a mismatch does a regular lookup.
+  if (Multiblock && BlockInfo && Op->OP == 0xC3) {
+    auto Returns = BlockInfo->InlinedReturns.find(Op->PC);
+    if (Returns != BlockInfo->InlinedReturns.end() && JumpTableDispatch(NewRIP, Returns->second)) {
+      BlockSetRIP = true;
+      return;
+    }
+  }
+
+  if (CTX->Config.ReturnStackBuffer) {
+    // Branches directly to the caller on a correct prediction
+    _ReturnStackLookup(NewRIP);
+  }
+
   // Store the new RIP
   _ExitFunction(NewRIP);
   BlockSetRIP = true;
@@ -811,7 +840,18 @@ void OpDispatchBuilder::CALLOp(OpcodeArgs) {
   const uint64_t TargetRIP = Op->PC + Op->InstSize + Op->Src[0].Data.Literal.Value;
 
   CalculateDeferredFlags();
+  if (Multiblock && BlockInfo && BlockInfo->InlinedCalls.contains(Op->PC) &&
+      JumpTargets.contains(TargetRIP) && JumpTargets.contains(NextRIP)) {
+    // The callee is a short leaf decoded in to this function, its RET branches back here
+    _Jump(GetNewJumpBlock(TargetRIP));
+    return;
+  }
+
   if (NextRIP != TargetRIP) {
+    if (CTX->Config.ReturnStackBuffer) {
+      _PushReturnStack(ConstantPCReturn);
+    }
+
     // Store the RIP
     _ExitFunction(NewRIP); // If we get here then leave the function now
   }
@@ -842,6 +882,9 @@ void OpDispatchBuilder::CALLAbsoluteOp(OpcodeArgs) {
 
   // Store the RIP
   CalculateDeferredFlags();
+  if (CTX->Config.ReturnStackBuffer) {
+    _PushReturnStack(ConstantPCReturn);
+  }
   _ExitFunction(JMPPCOffset); // If we get here then leave the function now
 }
 
@@ -1009,9 +1052,24 @@ OrderedNode *OpDispatchBuilder::SelectCC(uint8_t OP, OrderedNode *TrueValue, Ord
     }
   }
   else if (flagsOp == SelectionFlag::AND) {
+    // AND/TEST clear CF and OF, so every condition reduces to a compare of the result against zero
     switch(OP) {
-      case 0x4: SrcCond = _Select(FEXCore::IR::COND_EQ, flagsOpDest, ZeroConst, TrueValue, FalseValue, flagsOpSize); break;
-      case 0x5: SrcCond = _Select(FEXCore::IR::COND_NEQ, flagsOpDest, ZeroConst, TrueValue, FalseValue, flagsOpSize); break;
+      // EQ/Zero, UBE
+      case 0x4:
+      case 0x6: SrcCond = _Select(FEXCore::IR::COND_EQ, flagsOpDest, ZeroConst, TrueValue, FalseValue, flagsOpSize); break;
+      // NE, UAbove
+      case 0x5:
+      case 0x7: SrcCond = _Select(FEXCore::IR::COND_NEQ, flagsOpDest, ZeroConst, TrueValue, FalseValue, flagsOpSize); break;
+      // Sign, SL
+      case 0x8:
+      case 0xC: SrcCond = _Select(FEXCore::IR::COND_SLT, flagsOpDestSigned, ZeroConst, TrueValue, FalseValue, flagsOpSize); break;
+      // Not sign, SGE
+      case 0x9:
+      case 0xD: SrcCond = _Select(FEXCore::IR::COND_SGE, flagsOpDestSigned, ZeroConst, TrueValue, FalseValue, flagsOpSize); break;
+      // SLE
+      case 0xE: SrcCond = _Select(FEXCore::IR::COND_SLE, flagsOpDestSigned, ZeroConst, TrueValue, FalseValue, flagsOpSize); break;
+      // SGT
+      case 0xF: SrcCond = _Select(FEXCore::IR::COND_SGT, flagsOpDestSigned, ZeroConst, TrueValue, FalseValue, flagsOpSize); break;
       //default: printf("Missed Condition %04X OP_AND\n", OP); break;
     }
   } else if (flagsOp == SelectionFlag::FCMP) {
@@ -1382,10 +1440,120 @@ void OpDispatchBuilder::JUMPAbsoluteOp(OpcodeArgs) {
   auto RIPOffset = LoadSource(GPRClass, Op, Op->Src[0], Op->Flags, -1);
   CalculateDeferredFlags();
 
+  // A switch jump table the frontend decoded the targets of, branch in region when the loaded target is one of them
+  if (Multiblock && BlockInfo) {
+    auto Table = BlockInfo->JumpTables.find(Op->PC);
+    if (Table != BlockInfo->JumpTables.end() && JumpTableDispatch(RIPOffset, Table->second)) {
+      return;
+    }
+  }
+
+  // `jmp *foo@GOTPCREL(%rip)` is how PLT stubs and -fno-plt calls reach an import.
+  // If the GOT slot has already been resolved then guess its current value.
+  // The guess is checked against the loaded value at runtime, so lazy binding or a later
+  // rewrite of the slot just takes the indirect path.
+  uint64_t GOTTarget{};
+  if (CTX->Config.GOTLinking && CTX->Config.Is64BitMode &&
+      Op->Src[0].IsRIPRelative() && GetSrcSize(Op) == 8 &&
+      ReadGOTSlot(Op->PC + Op->InstSize + Op->Src[0].Data.RIPLiteral.Value.s, &GOTTarget) &&
+      GOTTarget != 0) {
+    auto CurrentBlock = GetCurrentBlock();
+    auto GOTTargetConst = _Constant(GOTTarget);
+    auto CondJump = _CondJump(RIPOffset, GOTTargetConst, InvalidNode, InvalidNode, {COND_EQ}, 8);
+
+    // Resolved target, a constant exit that the backend can link directly
+    auto LinkedBlock = CreateNewCodeBlockAfter(CurrentBlock);
+    SetTrueJumpTarget(CondJump, LinkedBlock);
+    SetCurrentCodeBlock(LinkedBlock);
+    _ExitFunction(GOTTargetConst);
+
+    // Slot changed since compile, do the regular lookup
+    auto IndirectBlock = CreateNewCodeBlockAfter(LinkedBlock);
+    SetFalseJumpTarget(CondJump, IndirectBlock);
+    SetCurrentCodeBlock(IndirectBlock);
+    _ExitFunction(RIPOffset);
+    return;
+  }
+
   // Store the new RIP
   _ExitFunction(RIPOffset);
 }
 
+/**
+ * @brief Branches to the block of Target when it is one of the sorted Targets, otherwise exits to it
+ *
+ * @return false if none of Targets are blocks in this function and nothing was emitted
+ */
+bool OpDispatchBuilder::JumpTableDispatch(OrderedNode *Target, fextl::vector<uint64_t> const &Targets) {
+  fextl::vector<uint64_t> InRegion;
+  for (auto TargetRIP : Targets) {
+    if (JumpTargets.contains(TargetRIP)) {
+      InRegion.emplace_back(TargetRIP);
+    }
+  }
+
+  if (InRegion.empty()) {
+    return false;
+  }
+
+  auto CurrentBlock = GetCurrentBlock();
+  auto FallbackBlock = CreateNewCodeBlockAfter(CurrentBlock);
+  SetCurrentCodeBlock(FallbackBlock);
+  _ExitFunction(Target);
+
+  SetCurrentCodeBlock(CurrentBlock);
+  JumpTableDispatch(Target, InRegion.data(), InRegion.data() + InRegion.size(), FallbackBlock);
+  return true;
+}
+
+/**
+ * @brief Emits a binary search over the sorted targets in [Begin, End)
+ *
+ * Branches to the target's block when Target matches one, otherwise to FallbackBlock.
+ * Targets are compared relative to the entry so the IR stays valid if the code moves.
+ */
+void OpDispatchBuilder::JumpTableDispatch(OrderedNode *Target, uint64_t const *Begin, uint64_t const *End, OrderedNode *FallbackBlock) {
+  const uint8_t GPRSize = CTX->GetGPRSize();
+
+  if (End - Begin == 1) {
+    auto CondJump = _CondJump(Target, _EntrypointOffset(*Begin - Entry, GPRSize), InvalidNode, InvalidNode, {COND_EQ}, GPRSize);
+    SetTrueJumpTarget(CondJump, GetNewJumpBlock(*Begin));
+    SetFalseJumpTarget(CondJump, FallbackBlock);
+    return;
+  }
+
+  auto Middle = Begin + (End - Begin) / 2;
+  auto CurrentBlock = GetCurrentBlock();
+  auto CondJump = _CondJump(Target, _EntrypointOffset(*Middle - Entry, GPRSize), InvalidNode, InvalidNode, {COND_ULT}, GPRSize);
+
+  auto LowerBlock = CreateNewCodeBlockAfter(CurrentBlock);
+  SetTrueJumpTarget(CondJump, LowerBlock);
+  SetCurrentCodeBlock(LowerBlock);
+  JumpTableDispatch(Target, Begin, Middle, FallbackBlock);
+
+  auto UpperBlock = CreateNewCodeBlockAfter(LowerBlock);
+  SetFalseJumpTarget(CondJump, UpperBlock);
+  SetCurrentCodeBlock(UpperBlock);
+  JumpTableDispatch(Target, Middle, End, FallbackBlock);
+}
+
+bool OpDispatchBuilder::ReadGOTSlot(uint64_t Address, uint64_t *Value) {
+#ifndef _WIN32
+  // The slot is guest memory that may not be mapped, read it without risking a fault
+  iovec Local {
+    .iov_base = Value,
+    .iov_len = sizeof(*Value),
+  };
+  iovec Remote {
+    .iov_base = reinterpret_cast<void*>(Address),
+    .iov_len = sizeof(*Value),
+  };
+  return process_vm_readv(::getpid(), &Local, 1, &Remote, 1, 0) == sizeof(*Value);
+#else
+  return false;
+#endif
+}
+
 template<uint32_t SrcIndex>
 void OpDispatchBuilder::TESTOp(OpcodeArgs) {
   // TEST is an instruction that does an AND between the sources
@@ -1399,11 +1567,13 @@ void OpDispatchBuilder::TESTOp(OpcodeArgs) {
   auto Size = GetDstSize(Op);
 
   flagsOp = SelectionFlag::AND;
-  flagsOpDest = ALUOp;
+  flagsOpResult = ALUOp;
   if (Size >= 4) {
     flagsOpSize = Size;
+    flagsOpDestSigned = flagsOpDest = ALUOp;
   } else {
     flagsOpSize = 4;  // assuming ZEXT semantics here
+    flagsOpDestSigned = _Sext(Size * 8, flagsOpDest = ALUOp);
   }
 }
 
@@ -1469,6 +1639,7 @@ void OpDispatchBuilder::CMPOp(OpcodeArgs) {
   GenerateFlags_SUB(Op, Result, Dest, Src);
 
   flagsOp = SelectionFlag::CMP;
+  flagsOpResult = Result;
   if (Size >= 4) {
     flagsOpSize = Size;
     flagsOpDestSigned = flagsOpDest = Dest;
@@ -1488,6 +1659,138 @@ void OpDispatchBuilder::CQOOp(OpcodeArgs) {
   StoreResult(GPRClass, Op, Upper, -1);
 }
 
+std::optional<OpDispatchBuilder::SpinLoopPoll> OpDispatchBuilder::FindSpinLoopPoll(FEXCore::X86Tables::DecodedOp Pause) const {
+  // Anything larger is unlikely to be a simple spin-wait
+  constexpr size_t MaxSpinLoopInstructions = 8;
+
+  if (!DecodedBlocks) {
+    return std::nullopt;
+  }
+
+  // Only code decoded for this function is visible
+  auto FindInst = [this](uint64_t PC) -> FEXCore::X86Tables::DecodedOp {
+    for (auto &Block : *DecodedBlocks) {
+      for (size_t i = 0; i < Block.NumInstructions; ++i) {
+        if (Block.DecodedInstructions[i].PC == PC) {
+          return &Block.DecodedInstructions[i];
+        }
+      }
+    }
+    return nullptr;
+  };
+
+  auto GetHandler = [](FEXCore::X86Tables::DecodedOp Inst) -> FEXCore::X86Tables::OpDispatchPtr {
+    return Inst->TableInfo ? Inst->TableInfo->OpcodeDispatcher : nullptr;
+  };
+
+  auto GetBranchTarget = [this](FEXCore::X86Tables::DecodedOp Inst) {
+    const uint64_t Target = Inst->PC + Inst->InstSize + Inst->Src[0].Data.Literal.Value;
+    return CTX->GetGPRSize() == 4 ? Target & 0xFFFF'FFFFU : Target;
+  };
+
+  auto IsMemory = [](FEXCore::X86Tables::DecodedOperand const &Operand) {
+    return Operand.IsGPRIndirect() || Operand.IsRIPRelative() || Operand.IsSIB();
+  };
+
+  // Find the branch back to the top of the loop
+  FEXCore::X86Tables::DecodedOp BackEdge{};
+  uint64_t LoopHead{};
+  FEXCore::X86Tables::DecodedOp Inst = Pause;
+  for (size_t i = 0; i < MaxSpinLoopInstructions && !BackEdge; ++i) {
+    Inst = FindInst(Inst->PC + Inst->InstSize);
+    if (!Inst) {
+      return std::nullopt;
+    }
+
+    const auto Handler = GetHandler(Inst);
+    if (Handler == &OpDispatchBuilder::CondJUMPOp || Handler == &OpDispatchBuilder::JUMPOp) {
+      const uint64_t Target = GetBranchTarget(Inst);
+      if (Target <= Pause->PC) {
+        BackEdge = Inst;
+        LoopHead = Target;
+      }
+      else if (Handler == &OpDispatchBuilder::JUMPOp) {
+        return std::nullopt;
+      }
+      // Forward conditional branches leave the loop
+    }
+  }
+
+  if (!BackEdge) {
+    return std::nullopt;
+  }
+
+  // Check the whole loop body
+  std::optional<SpinLoopPoll> Poll{};
+  uint32_t WrittenGPRs{};
+  bool HasPause{};
+  size_t NumInstructions{};
+  for (Inst = FindInst(LoopHead); Inst != BackEdge; Inst = FindInst(Inst->PC + Inst->InstSize)) {
+    if (!Inst || ++NumInstructions > MaxSpinLoopInstructions) {
+      return std::nullopt;
+    }
+
+    if (Inst == Pause) {
+      HasPause = true;
+      continue;
+    }
+
+    const auto Handler = GetHandler(Inst);
+    FEXCore::X86Tables::DecodedOperand const *Memory{};
+    if (Handler == &OpDispatchBuilder::CondJUMPOp) {
+      if (GetBranchTarget(Inst) <= BackEdge->PC) {
+        return std::nullopt;
+      }
+    }
+    else if (Handler == &OpDispatchBuilder::CMPOp<0> || Handler == &OpDispatchBuilder::CMPOp<1> ||
+             Handler == &OpDispatchBuilder::TESTOp<0> || Handler == &OpDispatchBuilder::TESTOp<1>) {
+      if (IsMemory(Inst->Dest)) {
+        Memory = &Inst->Dest;
+      }
+      else if (IsMemory(Inst->Src[0])) {
+        Memory = &Inst->Src[0];
+      }
+    }
+    else if (Handler == &OpDispatchBuilder::MOVGPROp<0>) {
+      if (!Inst->Dest.IsGPR()) {
+        // Stores mean this isn't just polling
+        return std::nullopt;
+      }
+      WrittenGPRs |= 1U << Inst->Dest.Data.GPR.GPR;
+      if (IsMemory(Inst->Src[0])) {
+        Memory = &Inst->Src[0];
+      }
+    }
+    else {
+      return std::nullopt;
+    }
+
+    if (Memory) {
+      if (Poll) {
+        // Only a single polled location
+        return std::nullopt;
+      }
+      Poll = SpinLoopPoll{Inst, Memory};
+    }
+  }
+
+  if (!HasPause || !Poll) {
+    return std::nullopt;
+  }
+
+  // The address is calculated at the PAUSE, so it must be the same everywhere in the loop
+  auto IsWritten = [WrittenGPRs](uint8_t GPR) {
+    return GPR < 16 && (WrittenGPRs & (1U << GPR));
+  };
+  const auto &Operand = *Poll->Operand;
+  if ((Operand.IsGPRIndirect() && IsWritten(Operand.Data.GPRIndirect.GPR)) ||
+      (Operand.IsSIB() && (IsWritten(Operand.Data.SIB.Base) || IsWritten(Operand.Data.SIB.Index)))) {
+    return std::nullopt;
+  }
+
+  return Poll;
+}
+
 void OpDispatchBuilder::XCHGOp(OpcodeArgs) {
   // Load both the source and the destination
   if (Op->OP == 0x90 &&
@@ -1506,6 +1809,14 @@ void OpDispatchBuilder::XCHGOp(OpcodeArgs) {
     if (Op->Flags & FEXCore::X86Tables::DecodeFlags::FLAG_REP_PREFIX) {
       // If this instruction has a REP prefix then this is architectually defined to be a `PAUSE` instruction.
       // On older processors this ends up being a true `REP NOP` which is why they stuck this here.
+      if (CTX->Config.SpinLoopWait && CTX->HostFeatures.SupportsWFEEventStream) {
+        if (auto Poll = FindSpinLoopPoll(Op)) {
+          // Wait on the address the loop is about to poll
+          OrderedNode *Addr = LoadSource(GPRClass, Poll->Inst, *Poll->Operand, Poll->Inst->Flags, -1, false);
+          _SpinWait(AppendSegmentOffset(Addr, Poll->Inst->Flags));
+          return;
+        }
+      }
       _Yield();
     }
     return;
@@ -2505,11 +2816,20 @@ void OpDispatchBuilder::ADXOp(OpcodeArgs) {
 
   StoreResult(GPRClass, Op, Result, -1);
 
-  auto Zero = _Constant(0);
-  auto One = _Constant(1);
-  auto SelectOpLT = _Select(IR::COND_ULT, Result, Src, One, Zero);
-  auto SelectOpLE = _Select(IR::COND_ULE, Result, Src, One, Zero);
-  auto SelectFlag = _Select(IR::COND_EQ, Flag, One, SelectOpLE, SelectOpLT);
+  const auto Size = GetDstSize(Op);
+  OrderedNode *SelectFlag{};
+  if (CTX->BackendFeatures.SupportsFlags) {
+    // Only the carry out of the host adcs is used, ADOX chains pass OF through it the same way
+    auto NZCV = _AdcNZCV(Size, Before, Src, Flag);
+    SelectFlag = _Bfe(1, IndexNZCV(X86State::RFLAG_CF_LOC), NZCV);
+  }
+  else {
+    auto Zero = _Constant(0);
+    auto One = _Constant(1);
+    auto SelectOpLT = _Select(IR::COND_ULT, Result, Src, One, Zero);
+    auto SelectOpLE = _Select(IR::COND_ULE, Result, Src, One, Zero);
+    SelectFlag = _Select(IR::COND_EQ, Flag, One, SelectOpLE, SelectOpLT);
+  }
 
   if (IsADCX) {
     SetRFLAG<X86State::RFLAG_CF_LOC>(SelectFlag);
@@ -3409,7 +3729,7 @@ void OpDispatchBuilder::PopcountOp(OpcodeArgs) {
 void OpDispatchBuilder::DAAOp(OpcodeArgs) {
   CalculateDeferredFlags();
   auto CF = GetRFLAG(FEXCore::X86State::RFLAG_CF_LOC);
-  auto AF = GetRFLAG(FEXCore::X86State::RFLAG_AF_LOC);
+  auto AF = LoadAF();
   auto AL = LoadGPRRegister(X86State::REG_RAX, 1);
 
   SetRFLAG<FEXCore::X86State::RFLAG_CF_LOC>(_Constant(0));
@@ -3438,7 +3758,7 @@ void OpDispatchBuilder::DAAOp(OpcodeArgs) {
     // The `NewCF` will be _Constant(0) stored aboved.
     // So Or(CF, _Constant(0)) ill mean CF gets updated to the old value in the true case?
     SetRFLAG<FEXCore::X86State::RFLAG_CF_LOC>(_Or(CF, NewCF));
-    SetRFLAG<FEXCore::X86State::RFLAG_AF_LOC>(_Constant(1));
+    SetRFLAG<FEXCore::X86State::RFLAG_AF_LOC>(_Constant(1U << 4));
     CalculateDeferredFlags();
     _Jump(EndBlock);
   }
@@ -3477,7 +3797,7 @@ void OpDispatchBuilder::DAAOp(OpcodeArgs) {
 void OpDispatchBuilder::DASOp(OpcodeArgs) {
   CalculateDeferredFlags();
   auto CF = GetRFLAG(FEXCore::X86State::RFLAG_CF_LOC);
-  auto AF = GetRFLAG(FEXCore::X86State::RFLAG_AF_LOC);
+  auto AF = LoadAF();
   auto AL = LoadGPRRegister(X86State::REG_RAX, 1);
 
   SetRFLAG<FEXCore::X86State::RFLAG_CF_LOC>(_Constant(0));
@@ -3506,7 +3826,7 @@ void OpDispatchBuilder::DASOp(OpcodeArgs) {
     // The `NewCF` will be _Constant(0) stored aboved.
     // So Or(CF, _Constant(0)) ill mean CF gets updated to the old value in the true case?
     SetRFLAG<FEXCore::X86State::RFLAG_CF_LOC>(_Or(CF, NewCF));
-    SetRFLAG<FEXCore::X86State::RFLAG_AF_LOC>(_Constant(1));
+    SetRFLAG<FEXCore::X86State::RFLAG_AF_LOC>(_Constant(1U << 4));
     CalculateDeferredFlags();
     _Jump(EndBlock);
   }
@@ -3543,7 +3863,7 @@ void OpDispatchBuilder::DASOp(OpcodeArgs) {
 void OpDispatchBuilder::AAAOp(OpcodeArgs) {
   InvalidateDeferredFlags();
 
-  auto AF = GetRFLAG(FEXCore::X86State::RFLAG_AF_LOC);
+  auto AF = LoadAF();
   auto AL = LoadGPRRegister(X86State::REG_RAX, 1);
   auto AX = LoadGPRRegister(X86State::REG_RAX, 2);
   auto Cond = _Or(AF, _Select(FEXCore::IR::COND_UGT, _And(AL, _Constant(0xF)), _Constant(9), _Constant(1), _Constant(0)));
@@ -3568,7 +3888,7 @@ void OpDispatchBuilder::AAAOp(OpcodeArgs) {
     auto Result = _And(NewAX, _Constant(0xFF0F));
     StoreGPRRegister(X86State::REG_RAX, Result, 2);
     SetRFLAG<FEXCore::X86State::RFLAG_CF_LOC>(_Constant(1));
-    SetRFLAG<FEXCore::X86State::RFLAG_AF_LOC>(_Constant(1));
+    SetRFLAG<FEXCore::X86State::RFLAG_AF_LOC>(_Constant(1U << 4));
     CalculateDeferredFlags();
     _Jump(EndBlock);
   }
@@ -3578,7 +3898,7 @@ void OpDispatchBuilder::AAAOp(OpcodeArgs) {
 void OpDispatchBuilder::AASOp(OpcodeArgs) {
   InvalidateDeferredFlags();
 
-  auto AF = GetRFLAG(FEXCore::X86State::RFLAG_AF_LOC);
+  auto AF = LoadAF();
   auto AL = LoadGPRRegister(X86State::REG_RAX, 1);
   auto AX = LoadGPRRegister(X86State::REG_RAX, 2);
   auto Cond = _Or(AF, _Select(FEXCore::IR::COND_UGT, _And(AL, _Constant(0xF)), _Constant(9), _Constant(1), _Constant(0)));
@@ -3604,7 +3924,7 @@ void OpDispatchBuilder::AASOp(OpcodeArgs) {
     auto Result = _And(NewAX, _Constant(0xFF0F));
     StoreGPRRegister(X86State::REG_RAX, Result, 2);
     SetRFLAG<FEXCore::X86State::RFLAG_CF_LOC>(_Constant(1));
-    SetRFLAG<FEXCore::X86State::RFLAG_AF_LOC>(_Constant(1));
+    SetRFLAG<FEXCore::X86State::RFLAG_AF_LOC>(_Constant(1U << 4));
     CalculateDeferredFlags();
     _Jump(EndBlock);
   }
@@ -3665,10 +3985,10 @@ void OpDispatchBuilder::ReadSegmentReg(OpcodeArgs) {
   auto Size = GetSrcSize(Op);
   OrderedNode *Src{};
   if constexpr (Seg == Segment::FS) {
-    Src = _LoadContext(Size, GPRClass, offsetof(FEXCore::Core::CPUState, fs_cached));
+    Src = LoadSegmentBase(Size, offsetof(FEXCore::Core::CPUState, fs_cached));
   }
   else {
-    Src = _LoadContext(Size, GPRClass, offsetof(FEXCore::Core::CPUState, gs_cached));
+    Src = LoadSegmentBase(Size, offsetof(FEXCore::Core::CPUState, gs_cached));
   }
 
   StoreResult(GPRClass, Op, Src, -1);
@@ -3680,6 +4000,7 @@ void OpDispatchBuilder::WriteSegmentReg(OpcodeArgs) {
   // This is incorrect and it instead zero extends the 32-bit value to 64-bit
   auto Size = GetDstSize(Op);
   OrderedNode *Src = LoadSource(GPRClass, Op, Op->Src[0], Op->Flags, -1);
+  InvalidateSegmentBases();
   if constexpr (Seg == Segment::FS) {
     _StoreContext(Size, GPRClass, Src, offsetof(FEXCore::Core::CPUState, fs_cached));
   }
@@ -3978,86 +4299,72 @@ void OpDispatchBuilder::CMPSOp(OpcodeArgs) {
     StoreGPRRegister(X86State::REG_RSI, Dest_RSI);
   }
   else {
-    // Calculate flags early.
+    // The element walk is done by a single `MemCmp` IR op, and the flags are only calculated for the element it stopped on.
+    // Like MOVS and STOS this doesn't support partial faulting REP instructions.
     CalculateDeferredFlags();
 
-    bool REPE = Op->Flags & FEXCore::X86Tables::DecodeFlags::FLAG_REP_PREFIX;
+    const bool REPE = Op->Flags & FEXCore::X86Tables::DecodeFlags::FLAG_REP_PREFIX;
 
-    // read DF once
     auto DF = GetRFLAG(FEXCore::X86State::RFLAG_DF_LOC);
     auto PtrDir = _Select(FEXCore::IR::COND_EQ,
         DF, _Constant(0),
         _Constant(Size), _Constant(-Size));
 
-    auto JumpStart = _Jump();
-    // Make sure to start a new block after ending this one
-    auto LoopStart = CreateNewCodeBlockAfter(GetCurrentBlock());
-    SetJumpTarget(JumpStart, LoopStart);
-    SetCurrentCodeBlock(LoopStart);
-
     OrderedNode *Counter = LoadGPRRegister(X86State::REG_RCX);
+    OrderedNode *RSI = LoadGPRRegister(X86State::REG_RSI);
+    OrderedNode *RDI = LoadGPRRegister(X86State::REG_RDI);
 
-    // Can we end the block?
-    auto CondJump = _CondJump(Counter, {COND_EQ});
-    IRPair<IROp_CondJump> InternalCondJump;
+    // Only ES prefix
+    auto DstSegment = GetSegment(0, FEXCore::X86Tables::DecodeFlags::FLAG_ES_PREFIX, true);
+    // Default DS prefix
+    auto SrcSegment = GetSegment(Op->Flags, FEXCore::X86Tables::DecodeFlags::FLAG_DS_PREFIX);
 
-    auto LoopTail = CreateNewCodeBlockAfter(LoopStart);
-    SetFalseJumpTarget(CondJump, LoopTail);
-    SetCurrentCodeBlock(LoopTail);
+    auto Compared = _MemCmp(CTX->IsAtomicTSOEnabled(), Size, REPE,
+        SrcSegment ?: InvalidNode,
+        DstSegment ?: InvalidNode,
+        RSI, RDI, Counter, DF);
 
-    // Working loop
+    // Both pointers move past every compared element
+    auto Offset = _Mul(Compared, PtrDir);
+    RSI = _Add(RSI, Offset);
+    RDI = _Add(RDI, Offset);
+    StoreGPRRegister(X86State::REG_RCX, _Sub(Counter, Compared));
+    StoreGPRRegister(X86State::REG_RSI, RSI);
+    StoreGPRRegister(X86State::REG_RDI, RDI);
+
+    // Flags are left alone if RCX was zero
+    auto CondJump = _CondJump(Compared, {COND_EQ});
+
+    auto FlagsBlock = CreateNewCodeBlockAfter(GetCurrentBlock());
+    SetFalseJumpTarget(CondJump, FlagsBlock);
+    SetCurrentCodeBlock(FlagsBlock);
+    IRPair<IROp_Jump> FlagsJump;
     {
-      OrderedNode *Dest_RSI = LoadGPRRegister(X86State::REG_RSI);
-      OrderedNode *Dest_RDI = LoadGPRRegister(X86State::REG_RDI);
+      // Redo the comparison of the last element for the flags
+      OrderedNode *Last_RSI = _Sub(RSI, PtrDir);
+      OrderedNode *Last_RDI = _Sub(RDI, PtrDir);
 
-      // Only ES prefix
-      Dest_RDI = AppendSegmentOffset(Dest_RDI, 0, FEXCore::X86Tables::DecodeFlags::FLAG_ES_PREFIX, true);
-      // Default DS prefix
-      Dest_RSI = AppendSegmentOffset(Dest_RSI, Op->Flags, FEXCore::X86Tables::DecodeFlags::FLAG_DS_PREFIX);
+      Last_RDI = AppendSegmentOffset(Last_RDI, 0, FEXCore::X86Tables::DecodeFlags::FLAG_ES_PREFIX, true);
+      Last_RSI = AppendSegmentOffset(Last_RSI, Op->Flags, FEXCore::X86Tables::DecodeFlags::FLAG_DS_PREFIX);
 
-      auto Src1 = _LoadMemAutoTSO(GPRClass, Size, Dest_RDI, Size);
-      auto Src2 = _LoadMem(GPRClass, Size, Dest_RSI, Size);
+      auto Src1 = _LoadMemAutoTSO(GPRClass, Size, Last_RDI, Size);
+      auto Src2 = _LoadMemAutoTSO(GPRClass, Size, Last_RSI, Size);
 
       OrderedNode* Result = _Sub(Src2, Src1);
       if (Size < 4)
         Result = _Bfe(Size * 8, 0, Result);
 
       GenerateFlags_SUB(Op, Result, Src2, Src1);
-
-      // Calculate flags early.
-      CalculateDeferredFlags();
-
-      OrderedNode *TailCounter = LoadGPRRegister(X86State::REG_RCX);
-
-      // Decrement counter
-      TailCounter = _Sub(TailCounter, _Constant(1));
-
-      // Store the counter so we don't have to deal with PHI here
-      StoreGPRRegister(X86State::REG_RCX, TailCounter);
-
-      // Offset the pointer
-      Dest_RDI = _Add(Dest_RDI, PtrDir);
-      StoreGPRRegister(X86State::REG_RDI, Dest_RDI);
-
-      // Offset second pointer
-      Dest_RSI = _Add(Dest_RSI, PtrDir);
-      StoreGPRRegister(X86State::REG_RSI, Dest_RSI);
-
-      OrderedNode *ZF = GetRFLAG(FEXCore::X86State::RFLAG_ZF_LOC);
       CalculateDeferredFlags();
-      InternalCondJump = _CondJump(ZF, {REPE ? COND_NEQ : COND_EQ});
 
-      // Jump back to the start if we have more work to do
-      SetTrueJumpTarget(InternalCondJump, LoopStart);
+      FlagsJump = _Jump();
     }
 
     // Make sure to start a new block after ending this one
-    auto LoopEnd = CreateNewCodeBlockAfter(LoopTail);
-    SetTrueJumpTarget(CondJump, LoopEnd);
-
-    SetFalseJumpTarget(InternalCondJump, LoopEnd);
-
-    SetCurrentCodeBlock(LoopEnd);
+    auto Done = CreateNewCodeBlockAfter(FlagsBlock);
+    SetTrueJumpTarget(CondJump, Done);
+    SetJumpTarget(FlagsJump, Done);
+    SetCurrentCodeBlock(Done);
   }
 }
 
@@ -4199,83 +4506,60 @@ void OpDispatchBuilder::SCASOp(OpcodeArgs) {
     StoreGPRRegister(X86State::REG_RDI, TailDest_RDI);
   }
   else {
-    // Calculate flags early. because end of block
+    // The element walk is done by a single `MemScan` IR op, and the flags are only calculated for the element it stopped on.
+    // Like MOVS and STOS this doesn't support partial faulting REP instructions.
     CalculateDeferredFlags();
 
-    bool REPE = Op->Flags & FEXCore::X86Tables::DecodeFlags::FLAG_REP_PREFIX;
-
-    // read DF once
-
-    auto SizeConst = _Constant(Size);
-    auto NegSizeConst = _Constant(-Size);
+    const bool REPE = Op->Flags & FEXCore::X86Tables::DecodeFlags::FLAG_REP_PREFIX;
 
     auto DF = GetRFLAG(FEXCore::X86State::RFLAG_DF_LOC);
     auto PtrDir = _Select(FEXCore::IR::COND_EQ,
         DF, _Constant(0),
-        SizeConst, NegSizeConst);
-
-    auto JumpStart = _Jump();
-    // Make sure to start a new block after ending this one
-    auto LoopStart = CreateNewCodeBlockAfter(GetCurrentBlock());
-    SetJumpTarget(JumpStart, LoopStart);
-    SetCurrentCodeBlock(LoopStart);
+        _Constant(Size), _Constant(-Size));
 
     OrderedNode *Counter = LoadGPRRegister(X86State::REG_RCX);
+    OrderedNode *RDI = LoadGPRRegister(X86State::REG_RDI);
+    auto Src1 = LoadSource(GPRClass, Op, Op->Src[0], Op->Flags, -1);
 
-    // Can we end the block?
-    // We leave if RCX = 0
-    auto CondJump = _CondJump(Counter, {COND_EQ});
-    IRPair<IROp_CondJump> InternalCondJump;
+    // Only ES prefix
+    auto Segment = GetSegment(0, FEXCore::X86Tables::DecodeFlags::FLAG_ES_PREFIX, true);
 
-    auto LoopTail = CreateNewCodeBlockAfter(LoopStart);
-    SetFalseJumpTarget(CondJump, LoopTail);
-    SetCurrentCodeBlock(LoopTail);
+    auto Compared = _MemScan(CTX->IsAtomicTSOEnabled(), Size, REPE, Segment ?: InvalidNode, RDI, Src1, Counter, DF);
 
-    // Working loop
-    {
-      OrderedNode *Dest_RDI = LoadGPRRegister(X86State::REG_RDI);
+    // The pointer moves past every compared element
+    RDI = _Add(RDI, _Mul(Compared, PtrDir));
+    StoreGPRRegister(X86State::REG_RCX, _Sub(Counter, Compared));
+    StoreGPRRegister(X86State::REG_RDI, RDI);
 
-      Dest_RDI = AppendSegmentOffset(Dest_RDI, 0, FEXCore::X86Tables::DecodeFlags::FLAG_ES_PREFIX, true);
+    // Flags are left alone if RCX was zero
+    auto CondJump = _CondJump(Compared, {COND_EQ});
 
-      auto Src1 = LoadSource(GPRClass, Op, Op->Src[0], Op->Flags, -1);
-      auto Src2 = _LoadMemAutoTSO(GPRClass, Size, Dest_RDI, Size);
+    auto FlagsBlock = CreateNewCodeBlockAfter(GetCurrentBlock());
+    SetFalseJumpTarget(CondJump, FlagsBlock);
+    SetCurrentCodeBlock(FlagsBlock);
+    IRPair<IROp_Jump> FlagsJump;
+    {
+      // Redo the comparison of the last element for the flags
+      OrderedNode *Last_RDI = _Sub(RDI, PtrDir);
+      Last_RDI = AppendSegmentOffset(Last_RDI, 0, FEXCore::X86Tables::DecodeFlags::FLAG_ES_PREFIX, true);
+
+      auto Src2 = _LoadMemAutoTSO(GPRClass, Size, Last_RDI, Size);
 
       OrderedNode* Result = _Sub(Src1, Src2);
       if (Size < 4)
         Result = _Bfe(Size * 8, 0, Result);
 
       GenerateFlags_SUB(Op, Result, Src1, Src2);
-
-      // Calculate flags early.
-      CalculateDeferredFlags();
-
-      OrderedNode *TailCounter = LoadGPRRegister(X86State::REG_RCX);
-      OrderedNode *TailDest_RDI = LoadGPRRegister(X86State::REG_RDI);
-
-      // Decrement counter
-      TailCounter = _Sub(TailCounter, _Constant(1));
-
-      // Store the counter so we don't have to deal with PHI here
-      StoreGPRRegister(X86State::REG_RCX, TailCounter);
-
-      // Offset the pointer
-      TailDest_RDI = _Add(TailDest_RDI, PtrDir);
-      StoreGPRRegister(X86State::REG_RDI, TailDest_RDI);
-
-      OrderedNode *ZF = GetRFLAG(FEXCore::X86State::RFLAG_ZF_LOC);
       CalculateDeferredFlags();
-      InternalCondJump = _CondJump(ZF, {REPE ? COND_NEQ : COND_EQ});
 
-      // Jump back to the start if we have more work to do
-      SetTrueJumpTarget(InternalCondJump, LoopStart);
+      FlagsJump = _Jump();
     }
-    // Make sure to start a new block after ending this one
-    auto LoopEnd = CreateNewCodeBlockAfter(LoopTail);
-    SetTrueJumpTarget(CondJump, LoopEnd);
 
-    SetFalseJumpTarget(InternalCondJump, LoopEnd);
-
-    SetCurrentCodeBlock(LoopEnd);
+    // Make sure to start a new block after ending this one
+    auto Done = CreateNewCodeBlockAfter(FlagsBlock);
+    SetTrueJumpTarget(CondJump, Done);
+    SetJumpTarget(FlagsJump, Done);
+    SetCurrentCodeBlock(Done);
   }
 }
 
@@ -4728,8 +5012,47 @@ void OpDispatchBuilder::CreateJumpBlocks(fextl::vector<FEXCore::Frontend::Decode
   }
 }
 
+// x87 instructions whose results differ noticeably when run at 64-bit precision,
+// or that move the 80-bit register format in and out of memory as is.
+static bool NeedsX87FullPrecision(FEXCore::X86Tables::X86InstInfo const *Info) {
+  const auto &X87Ops = FEXCore::X86Tables::X87Ops;
+  if (Info < X87Ops.data() || Info >= X87Ops.data() + X87Ops.size()) {
+    return false;
+  }
+
+  // Indexed by the opcode's low three bits and the ModRM byte
+  const size_t Index = Info - X87Ops.data();
+  const uint8_t Op = 0xD8 + (Index >> 8);
+  const uint8_t ModRM = Index & 0xFF;
+
+  if ((ModRM & 0xC0) != 0xC0) {
+    const uint8_t Reg = (ModRM >> 3) & 7;
+    switch (Op) {
+      // FLD m80, FSTP m80
+      case 0xDB: return Reg == 5 || Reg == 7;
+      // FRSTOR, FNSAVE
+      case 0xDD: return Reg == 4 || Reg == 6;
+      // FBLD, FBSTP
+      case 0xDF: return Reg == 4 || Reg == 6;
+      default: return false;
+    }
+  }
+
+  // FXAM, FPREM1, FPREM
+  return Op == 0xD9 && (ModRM == 0xE5 || ModRM == 0xF5 || ModRM == 0xF8);
+}
+
 void OpDispatchBuilder::BeginFunction(uint64_t RIP, fextl::vector<FEXCore::Frontend::Decoder::DecodedBlocks> const *Blocks, uint32_t NumInstructions) {
   Entry = RIP;
+  DecodedBlocks = Blocks;
+
+  AdaptiveX87F64 = CTX->Config.x87AdaptivePrecision && !CTX->Config.x87ReducedPrecision &&
+    std::none_of(Blocks->begin(), Blocks->end(), [](auto const &Block) {
+      return std::any_of(Block.DecodedInstructions, Block.DecodedInstructions + Block.NumInstructions, [](auto const &Inst) {
+        return NeedsX87FullPrecision(Inst.TableInfo);
+      });
+    });
+
   auto IRHeader = _IRHeader(InvalidNode, RIP, 0, NumInstructions);
   CreateJumpBlocks(Blocks);
 
@@ -4813,10 +5136,10 @@ OrderedNode *OpDispatchBuilder::GetSegment(uint32_t Flags, uint32_t DefaultPrefi
 
   if (CTX->Config.Is64BitMode) {
     if (Flags & FEXCore::X86Tables::DecodeFlags::FLAG_FS_PREFIX) {
-      return _LoadContext(GPRSize, GPRClass, offsetof(FEXCore::Core::CPUState, fs_cached));
+      return LoadSegmentBase(GPRSize, offsetof(FEXCore::Core::CPUState, fs_cached));
     }
     else if (Flags & FEXCore::X86Tables::DecodeFlags::FLAG_GS_PREFIX) {
-      return _LoadContext(GPRSize, GPRClass, offsetof(FEXCore::Core::CPUState, gs_cached));
+      return LoadSegmentBase(GPRSize, offsetof(FEXCore::Core::CPUState, gs_cached));
     }
     // If there was any other segment in 64bit then it is ignored
   }
@@ -4830,17 +5153,17 @@ OrderedNode *OpDispatchBuilder::GetSegment(uint32_t Flags, uint32_t DefaultPrefi
     // With the segment register optimization we store the GDT bases directly in the segment register to remove indexed loads
     switch (Prefix) {
       case FEXCore::X86Tables::DecodeFlags::FLAG_ES_PREFIX:
-        return _LoadContext(GPRSize, GPRClass, offsetof(FEXCore::Core::CPUState, es_cached));
+        return LoadSegmentBase(GPRSize, offsetof(FEXCore::Core::CPUState, es_cached));
       case FEXCore::X86Tables::DecodeFlags::FLAG_CS_PREFIX:
-        return _LoadContext(GPRSize, GPRClass, offsetof(FEXCore::Core::CPUState, cs_cached));
+        return LoadSegmentBase(GPRSize, offsetof(FEXCore::Core::CPUState, cs_cached));
       case FEXCore::X86Tables::DecodeFlags::FLAG_SS_PREFIX:
-        return _LoadContext(GPRSize, GPRClass, offsetof(FEXCore::Core::CPUState, ss_cached));
+        return LoadSegmentBase(GPRSize, offsetof(FEXCore::Core::CPUState, ss_cached));
       case FEXCore::X86Tables::DecodeFlags::FLAG_DS_PREFIX:
-        return _LoadContext(GPRSize, GPRClass, offsetof(FEXCore::Core::CPUState, ds_cached));
+        return LoadSegmentBase(GPRSize, offsetof(FEXCore::Core::CPUState, ds_cached));
       case FEXCore::X86Tables::DecodeFlags::FLAG_FS_PREFIX:
-        return _LoadContext(GPRSize, GPRClass, offsetof(FEXCore::Core::CPUState, fs_cached));
+        return LoadSegmentBase(GPRSize, offsetof(FEXCore::Core::CPUState, fs_cached));
       case FEXCore::X86Tables::DecodeFlags::FLAG_GS_PREFIX:
-        return _LoadContext(GPRSize, GPRClass, offsetof(FEXCore::Core::CPUState, gs_cached));
+        return LoadSegmentBase(GPRSize, offsetof(FEXCore::Core::CPUState, gs_cached));
       default:
         break; // Do nothing
     }
@@ -4848,6 +5171,29 @@ OrderedNode *OpDispatchBuilder::GetSegment(uint32_t Flags, uint32_t DefaultPrefi
   return nullptr;
 }
 
+OrderedNode *OpDispatchBuilder::LoadSegmentBase(uint8_t Size, uint32_t Offset) {
+  const size_t Index = [Offset]() -> size_t {
+    switch (Offset) {
+      case offsetof(FEXCore::Core::CPUState, es_cached): return 0;
+      case offsetof(FEXCore::Core::CPUState, cs_cached): return 1;
+      case offsetof(FEXCore::Core::CPUState, ss_cached): return 2;
+      case offsetof(FEXCore::Core::CPUState, ds_cached): return 3;
+      case offsetof(FEXCore::Core::CPUState, gs_cached): return 4;
+      case offsetof(FEXCore::Core::CPUState, fs_cached): return 5;
+      default: LOGMAN_MSG_A_FMT("Unknown segment base offset {}", Offset); return 0;
+    }
+  }();
+
+  auto &Cached = SegmentBaseCache[Index];
+  if (Cached.Value && Cached.Block == CurrentCodeBlock && Cached.Size == Size) {
+    return Cached.Value;
+  }
+
+  auto Value = _LoadContext(Size, GPRClass, Offset);
+  Cached = {Value, CurrentCodeBlock, Size};
+  return Value;
+}
+
 OrderedNode *OpDispatchBuilder::AppendSegmentOffset(OrderedNode *Value, uint32_t Flags, uint32_t DefaultPrefix, bool Override) {
   auto Segment = GetSegment(Flags, DefaultPrefix, Override);
   if (Segment) {
@@ -4862,6 +5208,7 @@ void OpDispatchBuilder::UpdatePrefixFromSegment(OrderedNode *Segment, uint32_t S
   // In some cases the upper 16-bits of the 32-bit GPR contain garbage to ignore.
   Segment = _Bfe(4, 16 - 3, 3, Segment);
   auto NewSegment = _LoadContextIndexed(Segment, 4, offsetof(FEXCore::Core::CPUState, gdt[0]), 4, GPRClass);
+  InvalidateSegmentBases();
   switch (SegmentReg) {
     case FEXCore::X86Tables::DecodeFlags::FLAG_ES_PREFIX:
       _StoreContext(4, GPRClass, NewSegment, offsetof(FEXCore::Core::CPUState, es_cached));
@@ -4937,7 +5284,7 @@ OrderedNode *OpDispatchBuilder::LoadSource_WithOpSize(FEXCore::IR::RegisterClass
     Src = LoadGPRRegister(Operand.Data.GPR.GPR, GPRSize);
 
     LoadableType = true;
-    if (Operand.Data.GPR.GPR == FEXCore::X86State::REG_RSP && AccessType == MemoryAccessType::ACCESS_DEFAULT) {
+    if (IsNonTSOBaseRegister(Operand.Data.GPR.GPR) && AccessType == MemoryAccessType::ACCESS_DEFAULT) {
       AccessType = MemoryAccessType::ACCESS_NONTSO;
     }
   }
@@ -4949,7 +5296,7 @@ OrderedNode *OpDispatchBuilder::LoadSource_WithOpSize(FEXCore::IR::RegisterClass
     Src = _Add(GPR, Constant);
 
     LoadableType = true;
-    if (Operand.Data.GPRIndirect.GPR == FEXCore::X86State::REG_RSP && AccessType == MemoryAccessType::ACCESS_DEFAULT) {
+    if (IsNonTSOBaseRegister(Operand.Data.GPRIndirect.GPR) && AccessType == MemoryAccessType::ACCESS_DEFAULT) {
       AccessType = MemoryAccessType::ACCESS_NONTSO;
     }
   }
@@ -4984,9 +5331,6 @@ OrderedNode *OpDispatchBuilder::LoadSource_WithOpSize(FEXCore::IR::RegisterClass
         auto Constant = _Constant(GPRSize * 8, Operand.Data.SIB.Scale);
         Tmp = _Mul(Tmp, Constant);
       }
-      if (Operand.Data.SIB.Index == FEXCore::X86State::REG_RSP && AccessType == MemoryAccessType::ACCESS_DEFAULT) {
-        AccessType = MemoryAccessType::ACCESS_NONTSO;
-      }
     }
 
     if (Operand.Data.SIB.Base != FEXCore::X86State::REG_INVALID) {
@@ -4999,7 +5343,7 @@ OrderedNode *OpDispatchBuilder::LoadSource_WithOpSize(FEXCore::IR::RegisterClass
         Tmp = GPR;
       }
 
-      if (Operand.Data.SIB.Base == FEXCore::X86State::REG_RSP && AccessType == MemoryAccessType::ACCESS_DEFAULT) {
+      if (IsNonTSOBaseRegister(Operand.Data.SIB.Base) && AccessType == MemoryAccessType::ACCESS_DEFAULT) {
         AccessType = MemoryAccessType::ACCESS_NONTSO;
       }
     }
@@ -5186,7 +5530,7 @@ void OpDispatchBuilder::StoreResult_WithOpSize(FEXCore::IR::RegisterClassType Cl
     MemStoreDst = LoadGPRRegister(Operand.Data.GPR.GPR, GPRSize);
 
     MemStore = true;
-    if (Operand.Data.GPR.GPR == FEXCore::X86State::REG_RSP && AccessType == MemoryAccessType::ACCESS_DEFAULT) {
+    if (IsNonTSOBaseRegister(Operand.Data.GPR.GPR) && AccessType == MemoryAccessType::ACCESS_DEFAULT) {
       AccessType = MemoryAccessType::ACCESS_NONTSO;
     }
   }
@@ -5196,7 +5540,7 @@ void OpDispatchBuilder::StoreResult_WithOpSize(FEXCore::IR::RegisterClassType Cl
 
     MemStoreDst = _Add(GPR, Constant);
     MemStore = true;
-    if (Operand.Data.GPRIndirect.GPR == FEXCore::X86State::REG_RSP && AccessType == MemoryAccessType::ACCESS_DEFAULT) {
+    if (IsNonTSOBaseRegister(Operand.Data.GPRIndirect.GPR) && AccessType == MemoryAccessType::ACCESS_DEFAULT) {
       AccessType = MemoryAccessType::ACCESS_NONTSO;
     }
   }
@@ -5230,6 +5574,10 @@ void OpDispatchBuilder::StoreResult_WithOpSize(FEXCore::IR::RegisterClassType Cl
       else {
         Tmp = GPR;
       }
+
+      if (IsNonTSOBaseRegister(Operand.Data.SIB.Base) && AccessType == MemoryAccessType::ACCESS_DEFAULT) {
+        AccessType = MemoryAccessType::ACCESS_NONTSO;
+      }
     }
 
     if (Operand.Data.SIB.Offset) {
@@ -5300,10 +5648,12 @@ OpDispatchBuilder::OpDispatchBuilder(FEXCore::Utils::IntrusivePooledAllocator &A
 void OpDispatchBuilder::ResetWorkingList() {
   IREmitter::ResetWorkingList();
   JumpTargets.clear();
+  DecodedBlocks = nullptr;
   BlockSetRIP = false;
   DecodeFailure = false;
   ShouldDump = false;
   CurrentCodeBlock = nullptr;
+  InvalidateSegmentBases();
 }
 
 void OpDispatchBuilder::UnhandledOp(OpcodeArgs) {
@@ -6042,6 +6392,11 @@ void OpDispatchBuilder::InstallHostSpecificOpcodeHandlers() {
     {OPD(2, 0b01, 0x8C), 1, &OpDispatchBuilder::VPMASKMOVOp<false>},
     {OPD(2, 0b01, 0x8E), 1, &OpDispatchBuilder::VPMASKMOVOp<true>},
 
+    {OPD(2, 0b01, 0x90), 1, &OpDispatchBuilder::VPGATHEROp<4>},
+    {OPD(2, 0b01, 0x91), 1, &OpDispatchBuilder::VPGATHEROp<8>},
+    {OPD(2, 0b01, 0x92), 1, &OpDispatchBuilder::VPGATHEROp<4>},
+    {OPD(2, 0b01, 0x93), 1, &OpDispatchBuilder::VPGATHEROp<8>},
+
     {OPD(2, 0b01, 0xDB), 1, &OpDispatchBuilder::VAESIMCOp},
     {OPD(2, 0b01, 0xDC), 1, &OpDispatchBuilder::VAESEncOp},
     {OPD(2, 0b01, 0xDD), 1, &OpDispatchBuilder::VAESEncLastOp},
@@ -6158,6 +6513,14 @@ void OpDispatchBuilder::InstallHostSpecificOpcodeHandlers() {
   Initialized = true;
 }
 
+// F64 handlers for X87AdaptivePrecision, X87Ops keeps the F80 ones
+static std::array<X86Tables::X86InstInfo, X86Tables::MAX_X87_TABLE_SIZE> X87F64Ops{};
+
+X86Tables::OpDispatchPtr GetX87F64OpDispatcher(X86Tables::X86InstInfo const *Info) {
+  const auto Dispatcher = X87F64Ops[Info - X86Tables::X87Ops.data()].OpcodeDispatcher;
+  return Dispatcher ?: Info->OpcodeDispatcher;
+}
+
 void InstallOpcodeHandlers(Context::OperatingMode Mode) {
   constexpr std::tuple<uint8_t, uint8_t, X86Tables::OpDispatchPtr> BaseOpTable[] = {
     // Instructions
@@ -7515,10 +7878,14 @@ constexpr uint16_t PF_F2 = 3;
   InstallToTable(FEXCore::X86Tables::SecondModRMTableOps, SecondaryModRMExtensionOpTable);
 
   FEX_CONFIG_OPT(ReducedPrecision, X87REDUCEDPRECISION);
+  FEX_CONFIG_OPT(AdaptivePrecision, X87ADAPTIVEPRECISION);
   if(ReducedPrecision) {
     InstallToX87Table(FEXCore::X86Tables::X87Ops, X87F64OpTable);
   } else {
     InstallToX87Table(FEXCore::X86Tables::X87Ops, X87OpTable);
+    if (AdaptivePrecision) {
+      InstallToX87Table(X87F64Ops, X87F64OpTable);
+    }
   }
 
   InstallToTable(FEXCore::X86Tables::H0F38TableOps, H0F38Table);
@@ -15,8 +15,10 @@
 #include <FEXCore/fextl/map.h>
 #include <FEXCore/fextl/vector.h>
 
+#include <array>
 #include <cstdint>
 #include <fmt/format.h>
+#include <optional>
 #include <stddef.h>
 #include <utility>
 
@@ -87,6 +89,35 @@ public:
     // If we loaded flags but didn't change them, invalidate the cached copy and move on.
     // Changes get stored out by CalculateDeferredFlags.
     CachedNZCV = nullptr;
+
+    // The x87 stack was written back before leaving the previous block
+    X87Cache = {};
+  }
+
+  /**
+   * @brief Writes the cached x87 stack and TOP back to the context
+   *
+   * The cached values stay valid, so this is free to call when nothing is dirty.
+   */
+  void FlushX87Stack();
+
+  /**
+   * @brief Writes back and then drops the x87 stack cache
+   *
+   * Needed before anything that accesses the x87 or MMX registers in the context directly.
+   */
+  void InvalidateX87Stack() {
+    FlushX87Stack();
+    X87Cache = {};
+  }
+
+  /**
+   * @brief The function being built runs the x87 at 64-bit precision under X87AdaptivePrecision
+   *
+   * The x87 registers in the context stay in the 80-bit format, so the F64 handlers convert on the way in and out.
+   */
+  bool IsAdaptiveX87F64() const {
+    return AdaptiveX87F64;
   }
 
   bool FinishOp(uint64_t NextRIP, bool LastOp) {
@@ -103,6 +134,7 @@ public:
     if (LastOp && !BlockSetRIP) {
       // Calculate flags first
       CalculateDeferredFlags();
+      FlushX87Stack();
 
       auto it = JumpTargets.find(NextRIP);
       if (it == JumpTargets.end()) {
@@ -515,6 +547,9 @@ public:
   template <size_t ElementSize>
   void VPERMILRegOp(OpcodeArgs);
 
+  template <size_t AddrElementSize>
+  void VPGATHEROp(OpcodeArgs);
+
   void VPHADDSWOp(OpcodeArgs);
 
   void VPHMINPOSUWOp(OpcodeArgs);
@@ -815,12 +850,15 @@ public:
   OrderedNode *GetPackedRFLAG(uint32_t FlagsMask = ~0U);
 
   void SetMultiblock(bool _Multiblock) { Multiblock = _Multiblock; }
+  bool GetMultiblock() const { return Multiblock; }
+  // Jump tables and inlined calls the frontend recognized for the function being built
+  void SetDecodedBlockInfo(FEXCore::Frontend::Decoder::DecodedBlockInformation const *_BlockInfo) { BlockInfo = _BlockInfo; }
 
 private:
   enum class SelectionFlag {
     Nothing,  // must rely on x86 flags
     CMP,      // flags were set by a CMP between flagsOpDest/flagsOpDestSigned and flagsOpSrc/flagsOpSrcSigned with flagsOpSize size
-    AND,      // flags were set by an AND/TEST, flagsOpDest contains the resulting value of flagsOpSize size
+    AND,      // flags were set by an AND/TEST, flagsOpDest/flagsOpDestSigned contains the resulting value of flagsOpSize size
     FCMP,     // flags were set by a ucomis* / comis*
   };
 
@@ -837,6 +875,8 @@ private:
   OrderedNode* flagsOpSrc{};
   OrderedNode* flagsOpDestSigned{};
   OrderedNode* flagsOpSrcSigned{};
+  // Deferred flags result of the CMP/TEST, materializing those flags doesn't invalidate flagsOp
+  OrderedNode* flagsOpResult{};
 
   static bool IsNZCV(unsigned BitOffset) {
     switch (BitOffset) {
@@ -854,7 +894,29 @@ private:
   OrderedNode* CachedNZCV = {};
   uint32_t PossiblySetNZCVBits = 0;
 
+  // x87 stack cache for runs of x87 instructions inside of a block.
+  // TOP isn't known until runtime, so slots are tracked relative to the TOP that was loaded
+  // at the start of the run. Relative to that, every push and pop moves TOP by a known amount.
+  struct X87StackCache {
+    ///< TOP when the cache was filled, nullptr when the cache is empty
+    OrderedNode *BaseTop;
+    OrderedNode *Top;
+    ///< Current TOP relative to BaseTop
+    uint8_t TopOffset;
+    bool TopDirty;
+    ///< Context index of each slot, created on first use so pushes, loads and the write back share them
+    std::array<OrderedNode*, 8> SlotIndices;
+    ///< Slot contents, indexed relative to BaseTop
+    std::array<OrderedNode*, 8> Slots;
+    std::array<uint8_t, 8> SlotSizes;
+    uint8_t DirtySlots;
+  };
+  X87StackCache X87Cache {};
+  bool AdaptiveX87F64{};
+
   fextl::map<uint64_t, JumpTargetInfo> JumpTargets;
+  // Guest code of the function being built, only valid between BeginFunction and Finalize
+  fextl::vector<FEXCore::Frontend::Decoder::DecodedBlocks> const *DecodedBlocks{};
   bool HandledLock{false};
   bool DecodeFailure{false};
   bool NeedsBlockEnd{false};
@@ -863,6 +925,21 @@ private:
 
   void ALUOpImpl(OpcodeArgs, FEXCore::IR::IROps ALUIROp, FEXCore::IR::IROps AtomicFetchOp, bool RequiresMask);
 
+  struct SpinLoopPoll {
+    FEXCore::X86Tables::DecodedOp Inst;
+    // Memory operand of Inst that the loop polls
+    FEXCore::X86Tables::DecodedOperand const *Operand;
+  };
+  /**
+   * @brief Checks if a PAUSE is part of a small loop that spins on a single memory location
+   *
+   * The loop may only contain compares, tests and register loads besides its branches,
+   * and the registers addressing the polled memory must not change inside of it.
+   *
+   * @return The polling instruction, or nullopt if the PAUSE isn't in a recognized spin loop
+   */
+  std::optional<SpinLoopPoll> FindSpinLoopPoll(FEXCore::X86Tables::DecodedOp Pause) const;
+
   // Opcode helpers for generalizing behavior across VEX and non-VEX variants.
 
   OrderedNode* ADDSUBPOpImpl(OpcodeArgs, size_t ElementSize,
@@ -966,6 +1043,9 @@ private:
   OrderedNode* PSRLDOpImpl(OpcodeArgs, size_t ElementSize,
                            OrderedNode *Src, OrderedNode *ShiftVec);
 
+  // Returns the single permute instruction matching a PSHUFD style shuffle of Src's 32-bit elements, or nullptr
+  OrderedNode* SinglePermuteShuffle32(OrderedNode *Src, uint8_t Shuffle);
+
   OrderedNode* SHUFOpImpl(OpcodeArgs, size_t ElementSize,
                           const X86Tables::DecodedOperand& Src1,
                           const X86Tables::DecodedOperand& Src2,
@@ -1023,6 +1103,22 @@ private:
   OrderedNode *AppendSegmentOffset(OrderedNode *Value, uint32_t Flags, uint32_t DefaultPrefix = 0, bool Override = false);
   OrderedNode *GetSegment(uint32_t Flags, uint32_t DefaultPrefix = 0, bool Override = false);
 
+  // Segment bases that were already loaded in the current block, so every %fs/%gs access after the first
+  // reuses one context load. Dropped by anything that can change a base: segment register and
+  // WRFSBASE/WRGSBASE writes, and syscalls and thunks, which cover arch_prctl and set_thread_area.
+  struct CachedSegmentBase {
+    OrderedNode *Value;
+    ///< The load only dominates later code in the block it was emitted in
+    OrderedNode *Block;
+    uint8_t Size;
+  };
+  std::array<CachedSegmentBase, 6> SegmentBaseCache{};
+
+  OrderedNode *LoadSegmentBase(uint8_t Size, uint32_t Offset);
+  void InvalidateSegmentBases() {
+    SegmentBaseCache = {};
+  }
+
   void UpdatePrefixFromSegment(OrderedNode *Segment, uint32_t SegmentReg);
 
   enum class MemoryAccessType {
@@ -1041,6 +1137,9 @@ private:
   void StoreXMMRegister(uint32_t XMM, OrderedNode *const Src);
 
   OrderedNode *GetRelocatedPC(FEXCore::X86Tables::DecodedOp const& Op, int64_t Offset = 0);
+  bool ReadGOTSlot(uint64_t Address, uint64_t *Value);
+  bool JumpTableDispatch(OrderedNode *Target, fextl::vector<uint64_t> const &Targets);
+  void JumpTableDispatch(OrderedNode *Target, uint64_t const *Begin, uint64_t const *End, OrderedNode *FallbackBlock);
   OrderedNode *LoadSource(FEXCore::IR::RegisterClassType Class, FEXCore::X86Tables::DecodedOp const& Op, FEXCore::X86Tables::DecodedOperand const& Operand, uint32_t Flags, int8_t Align, bool LoadData = true, bool ForceLoad = false, MemoryAccessType AccessType = MemoryAccessType::ACCESS_DEFAULT);
   OrderedNode *LoadSource_WithOpSize(FEXCore::IR::RegisterClassType Class, FEXCore::X86Tables::DecodedOp const& Op, FEXCore::X86Tables::DecodedOperand const& Operand, uint8_t OpSize, uint32_t Flags, int8_t Align, bool LoadData = true, bool ForceLoad = false, MemoryAccessType AccessType = MemoryAccessType::ACCESS_DEFAULT);
   void StoreResult_WithOpSize(FEXCore::IR::RegisterClassType Class, FEXCore::X86Tables::DecodedOp Op, FEXCore::X86Tables::DecodedOperand const& Operand, OrderedNode *const Src, uint8_t OpSize, int8_t Align, MemoryAccessType AccessType = MemoryAccessType::ACCESS_DEFAULT);
@@ -1283,9 +1382,13 @@ private:
    * @name These functions are used by the deferred flag handling while it is calculating and storing flags in to RFLAGs.
    * @{ */
   OrderedNode *LoadPF();
+  OrderedNode *LoadAF();
   void CalculatePFUncheckedABI(OrderedNode *Res, OrderedNode *condition = nullptr);
   void CalculatePF(OrderedNode *Res, OrderedNode *condition = nullptr);
 
+  // NZCV in the x86 layout from a host compare of Src1 and Src2, for ADD (Sub = false) or SUB (Sub = true).
+  // Only valid when the backend supports flags.
+  OrderedNode *CalculateNZCV_Host(uint8_t SrcSize, OrderedNode *Src1, OrderedNode *Src2, bool Sub);
   void CalculateOF_Add(uint8_t SrcSize, OrderedNode *Res, OrderedNode *Src1, OrderedNode *Src2);
   void CalculateFlags_ADC(uint8_t SrcSize, OrderedNode *Res, OrderedNode *Src1, OrderedNode *Src2, OrderedNode *CF);
   void CalculateFlags_SBB(uint8_t SrcSize, OrderedNode *Res, OrderedNode *Src1, OrderedNode *Src2, OrderedNode *CF);
@@ -1736,6 +1839,18 @@ private:
   OrderedNode *GetX87FTW(OrderedNode *Value);
   void SetX87Top(OrderedNode *Value);
 
+  // st(i) accesses through the x87 stack cache, Offset is relative to the current TOP
+  void AdjustX87Top(int32_t Delta);
+  OrderedNode *GetX87SlotIndex(uint8_t Slot);
+  OrderedNode *GetX87StackIndex(uint8_t Offset);
+  OrderedNode *LoadX87Stack(uint8_t Offset, uint8_t Size);
+  void StoreX87Stack(uint8_t Offset, OrderedNode *Value, uint8_t Size);
+  // Raw F64 accesses of st(i) in the context for the F64 handlers
+  OrderedNode *LoadX87F64Indexed(OrderedNode *Index);
+  void StoreX87F64Indexed(OrderedNode *Value, OrderedNode *Index);
+  // F64 handlers use the host rounding mode, with adaptive precision the F80 handlers have to keep it in sync
+  void SetX87HostRoundingMode(OrderedNode *FCW);
+
   bool DestIsLockedMem(FEXCore::X86Tables::DecodedOp Op) const {
     return DestIsMem(Op) && (Op->Flags & FEXCore::X86Tables::DecodeFlags::FLAG_LOCK) != 0;
   }
@@ -1748,6 +1863,7 @@ private:
   bool BlockSetRIP {false};
 
   bool Multiblock{};
+  FEXCore::Frontend::Decoder::DecodedBlockInformation const *BlockInfo{};
   uint64_t Entry;
 
   OrderedNode* _StoreMemAutoTSO(FEXCore::IR::RegisterClassType Class, uint8_t Size, OrderedNode *Addr, OrderedNode *Value, uint8_t Align = 1) {
@@ -1764,10 +1880,19 @@ private:
       return _LoadMem(Class, Size, ssa0, Invalid(), Align, MEM_OFFSET_SXTX, 1);
   }
 
+  // Stack memory is private to its thread in practice, accesses through it skip TSO.
+  // RBP only counts when the guest is trusted to keep it as a frame pointer.
+  bool IsNonTSOBaseRegister(uint8_t GPR) const {
+    return GPR == FEXCore::X86State::REG_RSP ||
+           (GPR == FEXCore::X86State::REG_RBP && CTX->Config.TSOFramePointerRelaxed);
+  }
+
   void InstallHostSpecificOpcodeHandlers();
 };
 
 void InstallOpcodeHandlers(Context::OperatingMode Mode);
+// F64 handler for an X87Ops entry, only installed with X87AdaptivePrecision
+FEXCore::X86Tables::OpDispatchPtr GetX87F64OpDispatcher(FEXCore::X86Tables::X86InstInfo const *Info);
 
 }
 template <>
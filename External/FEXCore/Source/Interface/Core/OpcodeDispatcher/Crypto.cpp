@@ -398,7 +398,8 @@ void OpDispatchBuilder::PCLMULQDQOp(OpcodeArgs) {
 
   OrderedNode *Dest = LoadSource(FPRClass, Op, Op->Dest, Op->Flags, -1);
   OrderedNode *Src = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
-  const auto Selector = static_cast<uint8_t>(Op->Src[1].Data.Literal.Value);
+  // Only bits 0 and 4 select the source halves, the rest of the immediate is ignored.
+  const auto Selector = static_cast<uint8_t>(Op->Src[1].Data.Literal.Value & 0b0001'0001);
 
   auto Res = _PCLMUL(16, Dest, Src, Selector);
   StoreResult(FPRClass, Op, Res, -1);
@@ -412,7 +413,8 @@ void OpDispatchBuilder::VPCLMULQDQOp(OpcodeArgs) {
 
   OrderedNode *Src1 = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
   OrderedNode *Src2 = LoadSource(FPRClass, Op, Op->Src[1], Op->Flags, -1);
-  const auto Selector = static_cast<uint8_t>(Op->Src[2].Data.Literal.Value);
+  // Only bits 0 and 4 select the source halves, the rest of the immediate is ignored.
+  const auto Selector = static_cast<uint8_t>(Op->Src[2].Data.Literal.Value & 0b0001'0001);
 
   OrderedNode *Res = _PCLMUL(DstSize, Src1, Src2, Selector);
   if (Is128Bit) {
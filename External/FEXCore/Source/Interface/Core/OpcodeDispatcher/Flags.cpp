@@ -54,6 +54,13 @@ void OpDispatchBuilder::SetPackedRFLAG(bool Lower8, OrderedNode *Src) {
 
   for (size_t i = 0; i < NumFlags; ++i) {
     const auto FlagOffset = FlagOffsets[i];
+    if (FlagOffset == FEXCore::X86State::RFLAG_AF_LOC) {
+      // AF is stored in bit 4 of its byte, which matches where it lives in EFLAGS.
+      static_assert(FEXCore::X86State::RFLAG_AF_LOC == 4);
+      SetRFLAG(_And(Src, _Constant(1U << FEXCore::X86State::RFLAG_AF_LOC)), FlagOffset);
+      continue;
+    }
+
     auto Tmp = _Bfe(4, 1, FlagOffset, Src);
     SetRFLAG(Tmp, FlagOffset);
   }
@@ -91,8 +98,8 @@ OrderedNode *OpDispatchBuilder::GetPackedRFLAG(uint32_t FlagsMask) {
 
     // Note that the Bfi only considers the bottom bit of the flag, the rest of
     // the byte is allowed to be garbage.
-    OrderedNode *Flag = FlagOffset == FEXCore::X86State::RFLAG_PF_LOC ?
-                        LoadPF() :
+    OrderedNode *Flag = FlagOffset == FEXCore::X86State::RFLAG_PF_LOC ? LoadPF() :
+                        FlagOffset == FEXCore::X86State::RFLAG_AF_LOC ? LoadAF() :
                         GetRFLAG(FlagOffset);
 
     if (CTX->BackendFeatures.SupportsShiftedBitwise)
@@ -124,6 +131,19 @@ void OpDispatchBuilder::CalculateOF_Add(uint8_t SrcSize, OrderedNode *Res, Order
   SetRFLAG<FEXCore::X86State::RFLAG_OF_LOC>(AndOp1);
 }
 
+OrderedNode *OpDispatchBuilder::CalculateNZCV_Host(uint8_t SrcSize, OrderedNode *Src1, OrderedNode *Src2, bool Sub) {
+  if (SrcSize < 4) {
+    // Moving the operands to the top of a 32-bit register gives the host compare the same
+    // N, Z, C and V as the narrow x86 operation.
+    const auto Shift = _Constant(32 - SrcSize * 8);
+    Src1 = _Lshl(Src1, Shift);
+    Src2 = _Lshl(Src2, Shift);
+    SrcSize = 4;
+  }
+
+  return Sub ? _SubNZCV(SrcSize, Src1, Src2) : _AddNZCV(SrcSize, Src1, Src2);
+}
+
 OrderedNode *OpDispatchBuilder::LoadPF() {
   // Read the stored byte. This is the original 8-bit result, it needs parity calculated.
   auto PFByte = GetRFLAG(FEXCore::X86State::RFLAG_PF_LOC);
@@ -140,6 +160,12 @@ OrderedNode *OpDispatchBuilder::LoadPF() {
   return _And(_Constant(1), Parity);
 }
 
+OrderedNode *OpDispatchBuilder::LoadAF() {
+  // The stored byte is Src1 ^ Src2 ^ Res of the last operation that set AF, the carry out of bit 3 is bit 4.
+  // Storing it raw keeps the extract out of every ALU op, AF is rarely read.
+  return _Bfe(1, 4, GetRFLAG(FEXCore::X86State::RFLAG_AF_LOC));
+}
+
 void OpDispatchBuilder::CalculatePFUncheckedABI(OrderedNode *Res, OrderedNode *condition) {
   // We will use the bottom bit of the popcount, set if an odd number of bits are set.
   // But the x86 parity flag is supposed to be set for an even number of bits.
@@ -180,6 +206,10 @@ void OpDispatchBuilder::CalculateDeferredFlags(uint32_t FlagsToCalculateMask) {
     return;
   }
 
+  // Storing the flags of the CMP/TEST that flagsOp describes doesn't change them, SelectCC can still fold it.
+  // Any other deferred flags overwrote them.
+  const auto FoldableFlagsOp = CurrentDeferredFlags.Res == flagsOpResult ? flagsOp : SelectionFlag::Nothing;
+
   switch (CurrentDeferredFlags.Type) {
     case FlagsGenerationType::TYPE_ADC:
       CalculateFlags_ADC(
@@ -359,6 +389,7 @@ void OpDispatchBuilder::CalculateDeferredFlags(uint32_t FlagsToCalculateMask) {
 
   // Done calculating
   CurrentDeferredFlags.Type = FlagsGenerationType::TYPE_NONE;
+  flagsOp = FoldableFlagsOp;
 
   if (CachedNZCV)
     _StoreFlag(CachedNZCV, FEXCore::X86State::RFLAG_NZCV_LOC);
@@ -371,13 +402,20 @@ void OpDispatchBuilder::CalculateFlags_ADC(uint8_t SrcSize, OrderedNode *Res, Or
   auto One = _Constant(1);
   // AF
   {
+    // Only bit 4 of this is AF, it gets extracted on load. See LoadAF.
     OrderedNode *AFRes = _Xor(_Xor(Src1, Src2), Res);
-    AFRes = _Bfe(1, 4, AFRes);
     SetRFLAG<FEXCore::X86State::RFLAG_AF_LOC>(AFRes);
   }
 
   CalculatePF(Res);
 
+  if (CTX->BackendFeatures.SupportsFlags && SrcSize >= 4) {
+    // SF/ZF/CF/OF straight from the host adcs, the carry goes in through the host carry flag
+    SetNZCV(_AdcNZCV(SrcSize, Src1, Src2, CF));
+    PossiblySetNZCVBits = ~0U;
+    return;
+  }
+
   // SF/ZF
   SetNZ_ZeroCV(SrcSize, Res);
 
@@ -400,13 +438,20 @@ void OpDispatchBuilder::CalculateFlags_SBB(uint8_t SrcSize, OrderedNode *Res, Or
 
   // AF
   {
+    // Only bit 4 of this is AF, it gets extracted on load. See LoadAF.
     OrderedNode *AFRes = _Xor(_Xor(Src1, Src2), Res);
-    AFRes = _Bfe(1, 4, AFRes);
     SetRFLAG<FEXCore::X86State::RFLAG_AF_LOC>(AFRes);
   }
 
   CalculatePF(Res);
 
+  if (CTX->BackendFeatures.SupportsFlags && SrcSize >= 4) {
+    // SF/ZF/CF/OF straight from the host sbcs, the carry goes in through the host carry flag
+    SetNZCV(_SbbNZCV(SrcSize, Src1, Src2, CF));
+    PossiblySetNZCVBits = ~0U;
+    return;
+  }
+
   // SF/ZF
   SetNZ_ZeroCV(SrcSize, Res);
 
@@ -436,8 +481,8 @@ void OpDispatchBuilder::CalculateFlags_SUB(uint8_t SrcSize, OrderedNode *Res, Or
 
   // AF
   {
+    // Only bit 4 of this is AF, it gets extracted on load. See LoadAF.
     OrderedNode *AFRes = _Xor(_Xor(Src1, Src2), Res);
-    AFRes = _Bfe(1, 4, AFRes);
     SetRFLAG<FEXCore::X86State::RFLAG_AF_LOC>(AFRes);
   }
 
@@ -446,6 +491,17 @@ void OpDispatchBuilder::CalculateFlags_SUB(uint8_t SrcSize, OrderedNode *Res, Or
   // Stash CF before zeroing it
   auto OldCF = GetRFLAG(FEXCore::X86State::RFLAG_CF_LOC);
 
+  if (CTX->BackendFeatures.SupportsFlags) {
+    // SF/ZF/CF/OF straight from the host compare
+    SetNZCV(CalculateNZCV_Host(SrcSize, Src1, Src2, true));
+    PossiblySetNZCVBits = ~0U;
+
+    if (!UpdateCF) {
+      SetRFLAG<FEXCore::X86State::RFLAG_CF_LOC>(OldCF);
+    }
+    return;
+  }
+
   // SF/ZF
   SetNZ_ZeroCV(SrcSize, Res);
 
@@ -477,8 +533,8 @@ void OpDispatchBuilder::CalculateFlags_ADD(uint8_t SrcSize, OrderedNode *Res, Or
 
   // AF
   {
+    // Only bit 4 of this is AF, it gets extracted on load. See LoadAF.
     OrderedNode *AFRes = _Xor(_Xor(Src1, Src2), Res);
-    AFRes = _Bfe(1, 4, AFRes);
     SetRFLAG<FEXCore::X86State::RFLAG_AF_LOC>(AFRes);
   }
 
@@ -487,6 +543,17 @@ void OpDispatchBuilder::CalculateFlags_ADD(uint8_t SrcSize, OrderedNode *Res, Or
   // Stash CF before zeroing it
   auto OldCF = GetRFLAG(FEXCore::X86State::RFLAG_CF_LOC);
 
+  if (CTX->BackendFeatures.SupportsFlags) {
+    // SF/ZF/CF/OF straight from the host compare
+    SetNZCV(CalculateNZCV_Host(SrcSize, Src1, Src2, false));
+    PossiblySetNZCVBits = ~0U;
+
+    if (!UpdateCF) {
+      SetRFLAG<FEXCore::X86State::RFLAG_CF_LOC>(OldCF);
+    }
+    return;
+  }
+
   // SF/ZF
   SetNZ_ZeroCV(SrcSize, Res);
 
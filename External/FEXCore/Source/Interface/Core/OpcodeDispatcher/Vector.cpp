@@ -1019,8 +1019,10 @@ OrderedNode* OpDispatchBuilder::PSHUFBOpImpl(OpcodeArgs, const X86Tables::Decode
     return Low;
   }
 
+  // The upper lane looks up its own indices in the upper half of the table
   OrderedNode *HighSrc1 = _VInsElement(SrcSize, 16, 0, 1, Src1Node, Src1Node);
-  OrderedNode *High = _VTBL1(SanitizedSrcSize, HighSrc1, MaskedIndices);
+  OrderedNode *HighIndices = _VInsElement(SrcSize, 16, 0, 1, MaskedIndices, MaskedIndices);
+  OrderedNode *High = _VTBL1(SanitizedSrcSize, HighSrc1, HighIndices);
   return _VInsElement(SrcSize, 16, 1, 0, Low, High);
 }
 
@@ -1034,6 +1036,32 @@ void OpDispatchBuilder::VPSHUFBOp(OpcodeArgs) {
   StoreResult(FPRClass, Op, Result, -1);
 }
 
+OrderedNode* OpDispatchBuilder::SinglePermuteShuffle32(OrderedNode *Src, uint8_t Shuffle) {
+  constexpr auto Size = Core::CPUState::XMM_SSE_REG_SIZE;
+
+  // Element i of the result is Src[(Shuffle >> (i * 2)) & 0b11]
+  switch (Shuffle) {
+    case 0b11'10'01'00: return Src;
+    case 0b00'00'00'00: return _VDupElement(Size, 4, Src, 0);
+    case 0b01'01'01'01: return _VDupElement(Size, 4, Src, 1);
+    case 0b10'10'10'10: return _VDupElement(Size, 4, Src, 2);
+    case 0b11'11'11'11: return _VDupElement(Size, 4, Src, 3);
+    case 0b01'00'01'00: return _VDupElement(Size, 8, Src, 0);
+    case 0b11'10'11'10: return _VDupElement(Size, 8, Src, 1);
+    case 0b10'11'00'01: return _VRev64(Size, 4, Src);
+    case 0b00'11'10'01: return _VExtr(Size, 1, Src, Src, 4);
+    case 0b01'00'11'10: return _VExtr(Size, 1, Src, Src, 8);
+    case 0b10'01'00'11: return _VExtr(Size, 1, Src, Src, 12);
+    case 0b01'01'00'00: return _VZip(Size, 4, Src, Src);
+    case 0b11'11'10'10: return _VZip2(Size, 4, Src, Src);
+    case 0b10'10'00'00: return _VTrn(Size, 4, Src, Src);
+    case 0b11'11'01'01: return _VTrn2(Size, 4, Src, Src);
+    case 0b10'00'10'00: return _VUnZip(Size, 4, Src, Src);
+    case 0b11'01'11'01: return _VUnZip2(Size, 4, Src, Src);
+    default: return nullptr;
+  }
+}
+
 template<size_t ElementSize, bool HalfSize, bool Low>
 void OpDispatchBuilder::PSHUFDOp(OpcodeArgs) {
   static_assert(ElementSize != 0);
@@ -1052,6 +1080,13 @@ void OpDispatchBuilder::PSHUFDOp(OpcodeArgs) {
     NumElements /= 2;
   }
 
+  if (ElementSize == 4 && !HalfSize && Size == Core::CPUState::XMM_SSE_REG_SIZE) {
+    if (auto Permute = SinglePermuteShuffle32(Src, Shuffle)) {
+      StoreResult(FPRClass, Op, Permute, -1);
+      return;
+    }
+  }
+
   uint8_t BaseElement = Low ? 0 : NumElements;
 
   auto Dest = Src;
@@ -1149,6 +1184,36 @@ OrderedNode* OpDispatchBuilder::SHUFOpImpl(OpcodeArgs, size_t ElementSize,
   const uint8_t DstSize = GetDstSize(Op);
   const bool Is256Bit = DstSize == Core::CPUState::XMM_AVX_REG_SIZE;
 
+  if (!Is256Bit) {
+    // Shuffles that map onto one permute, the upper half of the result always comes from Src2
+    if (ElementSize == 4) {
+      // Each load makes a new node, so the decoded operands tell if both sources are the same register
+      const bool SameSource = Src1.IsGPR() && Src2.IsGPR() && Src1.Data.GPR.GPR == Src2.Data.GPR.GPR;
+      if (SameSource) {
+        if (auto Permute = SinglePermuteShuffle32(Src1Node, Shuffle)) {
+          return Permute;
+        }
+      }
+
+      switch (Shuffle) {
+        case 0b01'00'01'00: return _VZip(DstSize, 8, Src1Node, Src2Node);
+        case 0b11'10'11'10: return _VZip2(DstSize, 8, Src1Node, Src2Node);
+        case 0b10'00'10'00: return _VUnZip(DstSize, 4, Src1Node, Src2Node);
+        case 0b11'01'11'01: return _VUnZip2(DstSize, 4, Src1Node, Src2Node);
+        case 0b01'00'11'10: return _VExtr(DstSize, 1, Src2Node, Src1Node, 8);
+        default: break;
+      }
+    }
+    else {
+      switch (Shuffle & 0b11) {
+        case 0b00: return _VZip(DstSize, 8, Src1Node, Src2Node);
+        case 0b11: return _VZip2(DstSize, 8, Src1Node, Src2Node);
+        case 0b01: return _VExtr(DstSize, 1, Src2Node, Src1Node, 8);
+        default: break;
+      }
+    }
+  }
+
   std::array<OrderedNode*, 4> Srcs{};
   for (size_t i = 0; i < HalfNumElements; ++i) {
     Srcs[i] = Src1Node;
@@ -2290,8 +2355,6 @@ void OpDispatchBuilder::MASKMOVOp(OpcodeArgs) {
   const auto Size = GetSrcSize(Op);
 
   OrderedNode *MaskSrc = LoadSource(GPRClass, Op, Op->Src[0], Op->Flags, -1);
-  // Mask only cares about the top bit of each byte
-  MaskSrc = _VCMPLTZ(Size, 1, MaskSrc);
 
   // Vector that will overwrite byte elements.
   OrderedNode *VectorSrc = LoadSource(GPRClass, Op, Op->Dest, Op->Flags, -1);
@@ -2302,6 +2365,15 @@ void OpDispatchBuilder::MASKMOVOp(OpcodeArgs) {
   // DS prefix by default.
   MemDest = AppendSegmentOffset(MemDest, Op->Flags, FEXCore::X86Tables::DecodeFlags::FLAG_DS_PREFIX);
 
+  if (CTX->HostFeatures.SupportsSVE && Size == Core::CPUState::XMM_SSE_REG_SIZE) {
+    // A predicated store only writes the selected bytes, matching x86 and skipping the load.
+    _VStoreVectorMasked(Size, 1, MaskSrc, VectorSrc, MemDest, Invalid(), MEM_OFFSET_SXTX, 1);
+    return;
+  }
+
+  // Mask only cares about the top bit of each byte
+  MaskSrc = _VCMPLTZ(Size, 1, MaskSrc);
+
   OrderedNode *XMMReg = _LoadMem(FPRClass, Size, MemDest, 1);
 
   // If the Mask element high bit is set then overwrite the element with the source, else keep the memory variant
@@ -2353,6 +2425,32 @@ void OpDispatchBuilder::VPMASKMOVOp<false>(OpcodeArgs);
 template
 void OpDispatchBuilder::VPMASKMOVOp<true>(OpcodeArgs);
 
+template <size_t AddrElementSize>
+void OpDispatchBuilder::VPGATHEROp(OpcodeArgs) {
+  const auto Size = GetDstSize(Op);
+  const auto ElementSize = GetSrcSize(Op);
+  const auto& AddrOp = Op->Src[0];
+  LOGMAN_THROW_A_FMT(AddrOp.IsSIB(), "Gathers need a VSIB operand");
+
+  // Only the base and displacement are added here, the vector index is scaled per element
+  OrderedNode *BaseAddr = LoadSource_WithOpSize(GPRClass, Op, AddrOp, CTX->GetGPRSize(), Op->Flags, -1, false);
+  BaseAddr = AppendSegmentOffset(BaseAddr, Op->Flags);
+
+  OrderedNode *Indices = LoadXMMRegister(AddrOp.Data.SIB.Index - X86State::REG_XMM_0);
+  OrderedNode *Dest = LoadSource_WithOpSize(FPRClass, Op, Op->Dest, Size, Op->Flags, -1);
+  OrderedNode *Mask = LoadSource_WithOpSize(FPRClass, Op, Op->Src[1], Size, Op->Flags, -1);
+
+  OrderedNode *Result = _VGather(Size, ElementSize, Dest, Mask, BaseAddr, Indices, AddrElementSize, AddrOp.Data.SIB.Scale);
+  StoreResult(FPRClass, Op, Result, -1);
+
+  // The mask is only cleared once every element is loaded, a fault part way through restarts the whole gather
+  StoreResult(FPRClass, Op, Op->Src[1], _VectorZero(Size), -1);
+}
+template
+void OpDispatchBuilder::VPGATHEROp<4>(OpcodeArgs);
+template
+void OpDispatchBuilder::VPGATHEROp<8>(OpcodeArgs);
+
 void OpDispatchBuilder::MOVBetweenGPR_FPR(OpcodeArgs) {
   if (Op->Dest.IsGPR() &&
       Op->Dest.Data.GPR.GPR >= FEXCore::X86State::REG_XMM_0) {
@@ -2501,6 +2599,8 @@ void OpDispatchBuilder::XSaveOpImpl(OpcodeArgs) {
     {
       fn();
     }
+    // The x87 stack cache can't carry values out of a conditional block
+    InvalidateX87Stack();
     auto Jump = _Jump();
     auto NextJumpTarget = CreateNewCodeBlockAfter(StoreBlock);
     SetJumpTarget(Jump, NextJumpTarget);
@@ -2675,7 +2775,12 @@ OrderedNode *OpDispatchBuilder::GetMXCSR() {
   // Default MXCSR Value
   OrderedNode *MXCSR = _Constant(0x1F80);
   OrderedNode *RoundingMode = _GetRoundingMode();
-  return _Bfi(4, 3, 13, MXCSR, RoundingMode);
+  MXCSR = _Bfi(4, 3, 13, MXCSR, RoundingMode);
+  if (CTX->HostFeatures.SupportsFlushInputsToZero) {
+    // DAZ
+    MXCSR = _Bfi(4, 1, 6, MXCSR, _Bfe(4, 1, 3, RoundingMode));
+  }
+  return MXCSR;
 }
 
 void OpDispatchBuilder::FXRStoreOp(OpcodeArgs) {
@@ -2714,6 +2819,8 @@ void OpDispatchBuilder::XRstorOpImpl(OpcodeArgs) {
     {
       restore_fn();
     }
+    // The x87 stack cache can't carry values out of a conditional block
+    InvalidateX87Stack();
     auto RestoreExitJump = _Jump();
     auto DefaultBlock = CreateNewCodeBlockAfter(RestoreBlock);
     auto ExitBlock = CreateNewCodeBlockAfter(DefaultBlock);
@@ -2723,6 +2830,7 @@ void OpDispatchBuilder::XRstorOpImpl(OpcodeArgs) {
     {
       default_fn();
     }
+    InvalidateX87Stack();
     auto DefaultExitJump = _Jump();
     SetJumpTarget(DefaultExitJump, ExitBlock);
     SetCurrentCodeBlock(ExitBlock);
@@ -2809,8 +2917,12 @@ void OpDispatchBuilder::RestoreSSEState(OrderedNode *MemBase) {
 }
 
 void OpDispatchBuilder::RestoreMXCSRState(OrderedNode *MXCSR) {
-  // We only support the rounding mode and FTZ bit being set
+  // We only support the rounding mode, FTZ and DAZ bits being set
   OrderedNode *RoundingMode = _Bfe(4, 3, 13, MXCSR);
+  if (CTX->HostFeatures.SupportsFlushInputsToZero) {
+    // DAZ maps to flushing inputs to zero, without host support denormal inputs keep being handled accurately
+    RoundingMode = _Bfi(4, 1, 3, RoundingMode, _Bfe(4, 1, 6, MXCSR));
+  }
   _SetRoundingMode(RoundingMode);
 }
 
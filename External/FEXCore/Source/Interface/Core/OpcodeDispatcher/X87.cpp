@@ -23,9 +23,118 @@ class OrderedNode;
 #define OpcodeArgs [[maybe_unused]] FEXCore::X86Tables::DecodedOp Op
 
 OrderedNode *OpDispatchBuilder::GetX87Top() {
-  // Yes, we are storing 3 bits in a single flag register.
-  // Deal with it
-  return _LoadContext(1, GPRClass, offsetof(FEXCore::Core::CPUState, flags) + FEXCore::X86State::X87FLAG_TOP_LOC);
+  // Raw users index the stack in the context themselves, so it needs to be up to date
+  // and anything they store invalidates the cached slots.
+  FlushX87Stack();
+  X87Cache.Slots = {};
+  return GetX87StackIndex(0);
+}
+
+OrderedNode *OpDispatchBuilder::GetX87StackIndex(uint8_t Offset) {
+  if (!X87Cache.BaseTop) {
+    // Yes, we are storing 3 bits in a single flag register.
+    // Deal with it
+    X87Cache.BaseTop = _LoadContext(1, GPRClass, offsetof(FEXCore::Core::CPUState, flags) + FEXCore::X86State::X87FLAG_TOP_LOC);
+    X87Cache.Top = X87Cache.BaseTop;
+    X87Cache.SlotIndices[0] = X87Cache.BaseTop;
+  }
+
+  if (Offset == 0) {
+    return X87Cache.Top;
+  }
+
+  return GetX87SlotIndex((X87Cache.TopOffset + Offset) & 7);
+}
+
+OrderedNode *OpDispatchBuilder::GetX87SlotIndex(uint8_t Slot) {
+  auto &Index = X87Cache.SlotIndices[Slot];
+  if (!Index) {
+    Index = _And(_Add(X87Cache.BaseTop, _Constant(Slot)), _Constant(7));
+  }
+  return Index;
+}
+
+void OpDispatchBuilder::AdjustX87Top(int32_t Delta) {
+  GetX87StackIndex(0);
+  X87Cache.TopOffset = (X87Cache.TopOffset + Delta) & 7;
+  X87Cache.Top = GetX87SlotIndex(X87Cache.TopOffset);
+  X87Cache.TopDirty = true;
+}
+
+OrderedNode *OpDispatchBuilder::LoadX87Stack(uint8_t Offset, uint8_t Size) {
+  GetX87StackIndex(0);
+  const uint8_t Slot = (X87Cache.TopOffset + Offset) & 7;
+
+  // With adaptive precision the context holds the 80-bit format, F64 handlers convert on the way in
+  const bool ConvertF64 = AdaptiveX87F64 && Size == 8;
+
+  if (X87Cache.Slots[Slot]) {
+    if (ConvertF64 && X87Cache.SlotSizes[Slot] == 16) {
+      // Left by one of the F80 handlers shared with the F64 table
+      return _F80CVT(8, X87Cache.Slots[Slot]);
+    }
+
+    if (X87Cache.SlotSizes[Slot] >= Size) {
+      return X87Cache.Slots[Slot];
+    }
+
+    // Only part of the register is cached, the rest has to come from the context
+    FlushX87Stack();
+  }
+
+  auto Value = ConvertF64 ? LoadX87F64Indexed(GetX87StackIndex(Offset)) :
+                            _LoadContextIndexed(GetX87StackIndex(Offset), Size, MMBaseOffset(), 16, FPRClass);
+  X87Cache.Slots[Slot] = Value;
+  X87Cache.SlotSizes[Slot] = Size;
+  return Value;
+}
+
+void OpDispatchBuilder::StoreX87Stack(uint8_t Offset, OrderedNode *Value, uint8_t Size) {
+  GetX87StackIndex(0);
+  const uint8_t Slot = (X87Cache.TopOffset + Offset) & 7;
+
+  if ((X87Cache.DirtySlots & (1U << Slot)) && X87Cache.SlotSizes[Slot] > Size) {
+    // A smaller store leaves the upper bytes of the earlier one in place
+    FlushX87Stack();
+  }
+
+  X87Cache.Slots[Slot] = Value;
+  X87Cache.SlotSizes[Slot] = Size;
+  X87Cache.DirtySlots |= 1U << Slot;
+}
+
+void OpDispatchBuilder::FlushX87Stack() {
+  if (!X87Cache.BaseTop) {
+    return;
+  }
+
+  for (uint8_t Slot = 0; Slot < X87Cache.Slots.size(); ++Slot) {
+    if (!(X87Cache.DirtySlots & (1U << Slot))) {
+      continue;
+    }
+
+    auto Index = GetX87SlotIndex(Slot);
+    if (AdaptiveX87F64 && X87Cache.SlotSizes[Slot] == 8) {
+      StoreX87F64Indexed(X87Cache.Slots[Slot], Index);
+    }
+    else {
+      _StoreContextIndexed(X87Cache.Slots[Slot], Index, X87Cache.SlotSizes[Slot], MMBaseOffset(), 16, FPRClass);
+    }
+  }
+  X87Cache.DirtySlots = 0;
+
+  if (X87Cache.TopDirty) {
+    _StoreContext(1, GPRClass, X87Cache.Top, offsetof(FEXCore::Core::CPUState, flags) + FEXCore::X86State::X87FLAG_TOP_LOC);
+    X87Cache.TopDirty = false;
+  }
+}
+
+void OpDispatchBuilder::SetX87HostRoundingMode(OrderedNode *FCW) {
+  if (!CTX->Config.x87AdaptivePrecision) {
+    return;
+  }
+
+  _SetRoundingMode(_And(_Lshr(FCW, _Constant(10)), _Constant(3)));
 }
 
 void OpDispatchBuilder::SetX87TopTag(OrderedNode *Value, X87Tag Tag) {
@@ -52,15 +161,16 @@ OrderedNode *OpDispatchBuilder::GetX87FTW(OrderedNode *Value) {
 }
 
 void OpDispatchBuilder::SetX87Top(OrderedNode *Value) {
-  _StoreContext(1, GPRClass, Value, offsetof(FEXCore::Core::CPUState, flags) + FEXCore::X86State::X87FLAG_TOP_LOC);
+  // A TOP that isn't relative to the cached one can't keep the cached slots
+  InvalidateX87Stack();
+  X87Cache.BaseTop = Value;
+  X87Cache.Top = Value;
+  X87Cache.SlotIndices[0] = Value;
+  X87Cache.TopDirty = true;
 }
 
 template<size_t width>
 void OpDispatchBuilder::FLD(OpcodeArgs) {
-  // Update TOP
-  auto orig_top = GetX87Top();
-  auto mask = _Constant(7);
-
   size_t read_width = (width == 80) ? 16 : width / 8;
 
   OrderedNode *data{};
@@ -71,9 +181,7 @@ void OpDispatchBuilder::FLD(OpcodeArgs) {
   }
   else {
     // Implicit arg
-    auto offset = _Constant(Op->OP & 7);
-    data = _And(_Add(orig_top, offset), mask);
-    data = _LoadContextIndexed(data, 16, MMBaseOffset(), 16, FPRClass);
+    data = LoadX87Stack(Op->OP & 7, 16);
   }
   OrderedNode *converted = data;
 
@@ -82,12 +190,11 @@ void OpDispatchBuilder::FLD(OpcodeArgs) {
     converted = _F80CVTTo(data, width / 8);
   }
 
-  auto top = _And(_Sub(orig_top, _Constant(1)), mask);
-  SetX87TopTag(top, X87Tag::Valid);
-  SetX87Top(top);
+  // Update TOP
+  AdjustX87Top(-1);
+  SetX87TopTag(GetX87StackIndex(0), X87Tag::Valid);
   // Write to ST[TOP]
-  _StoreContextIndexed(converted, top, 16, MMBaseOffset(), 16, FPRClass);
-  //_StoreContext(converted, 16, offsetof(FEXCore::Core::CPUState, mm[7][0]));
+  StoreX87Stack(0, converted, 16);
 }
 
 template
@@ -128,17 +235,15 @@ void OpDispatchBuilder::FBSTP(OpcodeArgs) {
 template<uint64_t Lower, uint32_t Upper>
 void OpDispatchBuilder::FLD_Const(OpcodeArgs) {
   // Update TOP
-  auto orig_top = GetX87Top();
-  auto top = _And(_Sub(orig_top, _Constant(1)), _Constant(7));
-  SetX87TopTag(top, X87Tag::Valid);
-  SetX87Top(top);
+  AdjustX87Top(-1);
+  SetX87TopTag(GetX87StackIndex(0), X87Tag::Valid);
 
   auto low = _Constant(Lower);
   auto high = _Constant(Upper);
   OrderedNode *data = _VCastFromGPR(16, 8, low);
   data = _VInsGPR(16, 8, 1, data, high);
   // Write to ST[TOP]
-  _StoreContextIndexed(data, top, 16, MMBaseOffset(), 16, FPRClass);
+  StoreX87Stack(0, data, 16);
 }
 
 template
@@ -158,10 +263,8 @@ void OpDispatchBuilder::FLD_Const<0, 0>(OpcodeArgs); // 0.0
 
 void OpDispatchBuilder::FILD(OpcodeArgs) {
   // Update TOP
-  auto orig_top = GetX87Top();
-  auto top = _And(_Sub(orig_top, _Constant(1)), _Constant(7));
-  SetX87TopTag(top, X87Tag::Valid);
-  SetX87Top(top);
+  AdjustX87Top(-1);
+  SetX87TopTag(GetX87StackIndex(0), X87Tag::Valid);
 
   size_t read_width = GetSrcSize(Op);
 
@@ -193,13 +296,12 @@ void OpDispatchBuilder::FILD(OpcodeArgs) {
   converted = _VInsElement(16, 8, 1, 0, converted, _VCastFromGPR(16, 8, upper));
 
   // Write to ST[TOP]
-  _StoreContextIndexed(converted, top, 16, MMBaseOffset(), 16, FPRClass);
+  StoreX87Stack(0, converted, 16);
 }
 
 template<size_t width>
 void OpDispatchBuilder::FST(OpcodeArgs) {
-  auto orig_top = GetX87Top();
-  auto data = _LoadContextIndexed(orig_top, 16, MMBaseOffset(), 16, FPRClass);
+  auto data = LoadX87Stack(0, 16);
   if constexpr (width == 80) {
     StoreResult_WithOpSize(FPRClass, Op, Op->Dest, data, 10, 1);
   }
@@ -210,10 +312,9 @@ void OpDispatchBuilder::FST(OpcodeArgs) {
 
   if ((Op->TableInfo->Flags & X86Tables::InstFlags::FLAGS_POP) != 0) {
     // if we are popping then we must first mark this location as empty
-    SetX87TopTag(orig_top, X87Tag::Empty);
+    SetX87TopTag(GetX87StackIndex(0), X87Tag::Empty);
     // Set the new top now
-    auto top = _And(_Add(orig_top, _Constant(1)), _Constant(7));
-    SetX87Top(top);
+    AdjustX87Top(1);
   }
 }
 
@@ -228,18 +329,16 @@ template<bool Truncate>
 void OpDispatchBuilder::FIST(OpcodeArgs) {
   auto Size = GetSrcSize(Op);
 
-  auto orig_top = GetX87Top();
-  OrderedNode *data = _LoadContextIndexed(orig_top, 16, MMBaseOffset(), 16, FPRClass);
+  OrderedNode *data = LoadX87Stack(0, 16);
   data = _F80CVTInt(Size, data, Truncate);
 
   StoreResult_WithOpSize(GPRClass, Op, Op->Dest, data, Size, 1);
 
   if ((Op->TableInfo->Flags & X86Tables::InstFlags::FLAGS_POP) != 0) {
     // if we are popping then we must first mark this location as empty
-    SetX87TopTag(orig_top, X87Tag::Empty);
+    SetX87TopTag(GetX87StackIndex(0), X87Tag::Empty);
     // Set the new top now
-    auto top = _And(_Add(orig_top, _Constant(1)), _Constant(7));
-    SetX87Top(top);
+    AdjustX87Top(1);
   }
 }
 
@@ -250,14 +349,11 @@ void OpDispatchBuilder::FIST<true>(OpcodeArgs);
 
 template <size_t width, bool Integer, OpDispatchBuilder::OpResult ResInST0>
 void OpDispatchBuilder::FADD(OpcodeArgs) {
-  auto top = GetX87Top();
-  OrderedNode *StackLocation = top;
+  uint8_t StackLocation = 0;
 
   OrderedNode *arg{};
   OrderedNode *b{};
 
-  auto mask = _Constant(7);
-
   if (!Op->Src[0].IsNone()) {
     // Memory arg
     if constexpr (width == 16 || width == 32 || width == 64) {
@@ -272,27 +368,25 @@ void OpDispatchBuilder::FADD(OpcodeArgs) {
     }
   } else {
     // Implicit arg
-    auto offset = _Constant(Op->OP & 7);
-    arg = _And(_Add(top, offset), mask);
+    const uint8_t offset = Op->OP & 7;
     if constexpr (ResInST0 == OpResult::RES_STI) {
-      StackLocation = arg;
+      StackLocation = offset;
     }
-    b = _LoadContextIndexed(arg, 16, MMBaseOffset(), 16, FPRClass);
+    b = LoadX87Stack(offset, 16);
   }
 
-  auto a = _LoadContextIndexed(top, 16, MMBaseOffset(), 16, FPRClass);
+  auto a = LoadX87Stack(0, 16);
   auto result = _F80Add(a, b);
 
+  // Write to ST[TOP], StackLocation is relative to TOP before the pop
+  StoreX87Stack(StackLocation, result, 16);
+
   if ((Op->TableInfo->Flags & X86Tables::InstFlags::FLAGS_POP) != 0) {
     // if we are popping then we must first mark this location as empty
-    SetX87TopTag(top, X87Tag::Empty);
+    SetX87TopTag(GetX87StackIndex(0), X87Tag::Empty);
     // Set the new top now
-    top = _And(_Add(top, _Constant(1)), mask);
-    SetX87Top(top);
+    AdjustX87Top(1);
   }
-
-  // Write to ST[TOP]
-  _StoreContextIndexed(result, StackLocation, 16, MMBaseOffset(), 16, FPRClass);
 }
 
 template
@@ -311,13 +405,10 @@ void OpDispatchBuilder::FADD<32, true, OpDispatchBuilder::OpResult::RES_ST0>(Opc
 
 template<size_t width, bool Integer, OpDispatchBuilder::OpResult ResInST0>
 void OpDispatchBuilder::FMUL(OpcodeArgs) {
-  auto top = GetX87Top();
-  OrderedNode *StackLocation = top;
+  uint8_t StackLocation = 0;
   OrderedNode *arg{};
   OrderedNode *b{};
 
-  auto mask = _Constant(7);
-
   if (!Op->Src[0].IsNone()) {
     // Memory arg
 
@@ -333,29 +424,26 @@ void OpDispatchBuilder::FMUL(OpcodeArgs) {
     }
   } else {
     // Implicit arg
-    auto offset = _Constant(Op->OP & 7);
-    arg = _And(_Add(top, offset), mask);
+    const uint8_t offset = Op->OP & 7;
     if constexpr (ResInST0 == OpResult::RES_STI) {
-      StackLocation = arg;
+      StackLocation = offset;
     }
-
-    b = _LoadContextIndexed(arg, 16, MMBaseOffset(), 16, FPRClass);
+    b = LoadX87Stack(offset, 16);
   }
 
-  auto a = _LoadContextIndexed(top, 16, MMBaseOffset(), 16, FPRClass);
+  auto a = LoadX87Stack(0, 16);
 
   auto result = _F80Mul(a, b);
 
+  // Write to ST[TOP], StackLocation is relative to TOP before the pop
+  StoreX87Stack(StackLocation, result, 16);
+
   if ((Op->TableInfo->Flags & X86Tables::InstFlags::FLAGS_POP) != 0) {
     // if we are popping then we must first mark this location as empty
-    SetX87TopTag(top, X87Tag::Empty);
+    SetX87TopTag(GetX87StackIndex(0), X87Tag::Empty);
     // Set the new top now
-    top = _And(_Add(top, _Constant(1)), mask);
-    SetX87Top(top);
+    AdjustX87Top(1);
   }
-
-  // Write to ST[TOP]
-  _StoreContextIndexed(result, StackLocation, 16, MMBaseOffset(), 16, FPRClass);
 }
 
 template
@@ -374,13 +462,10 @@ void OpDispatchBuilder::FMUL<32, true, OpDispatchBuilder::OpResult::RES_ST0>(Opc
 
 template<size_t width, bool Integer, bool reverse, OpDispatchBuilder::OpResult ResInST0>
 void OpDispatchBuilder::FDIV(OpcodeArgs) {
-  auto top = GetX87Top();
-  OrderedNode *StackLocation = top;
+  uint8_t StackLocation = 0;
   OrderedNode *arg{};
   OrderedNode *b{};
 
-  auto mask = _Constant(7);
-
   if (!Op->Src[0].IsNone()) {
     // Memory arg
 
@@ -396,16 +481,14 @@ void OpDispatchBuilder::FDIV(OpcodeArgs) {
     }
   } else {
     // Implicit arg
-    auto offset = _Constant(Op->OP & 7);
-    arg = _And(_Add(top, offset), mask);
+    const uint8_t offset = Op->OP & 7;
     if constexpr (ResInST0 == OpResult::RES_STI) {
-      StackLocation = arg;
+      StackLocation = offset;
     }
-
-    b = _LoadContextIndexed(arg, 16, MMBaseOffset(), 16, FPRClass);
+    b = LoadX87Stack(offset, 16);
   }
 
-  auto a = _LoadContextIndexed(top, 16, MMBaseOffset(), 16, FPRClass);
+  auto a = LoadX87Stack(0, 16);
 
   OrderedNode *result{};
   if constexpr (reverse) {
@@ -415,16 +498,15 @@ void OpDispatchBuilder::FDIV(OpcodeArgs) {
     result = _F80Div(a, b);
   }
 
+  // Write to ST[TOP], StackLocation is relative to TOP before the pop
+  StoreX87Stack(StackLocation, result, 16);
+
   if ((Op->TableInfo->Flags & X86Tables::InstFlags::FLAGS_POP) != 0) {
     // if we are popping then we must first mark this location as empty
-    SetX87TopTag(top, X87Tag::Empty);
+    SetX87TopTag(GetX87StackIndex(0), X87Tag::Empty);
     // Set the new top now
-    top = _And(_Add(top, _Constant(1)), mask);
-    SetX87Top(top);
+    AdjustX87Top(1);
   }
-
-  // Write to ST[TOP]
-  _StoreContextIndexed(result, StackLocation, 16, MMBaseOffset(), 16, FPRClass);
 }
 
 template
@@ -459,13 +541,10 @@ void OpDispatchBuilder::FDIV<32, true, true, OpDispatchBuilder::OpResult::RES_ST
 
 template<size_t width, bool Integer, bool reverse, OpDispatchBuilder::OpResult ResInST0>
 void OpDispatchBuilder::FSUB(OpcodeArgs) {
-  auto top = GetX87Top();
-  OrderedNode *StackLocation = top;
+  uint8_t StackLocation = 0;
   OrderedNode *arg{};
   OrderedNode *b{};
 
-  auto mask = _Constant(7);
-
   if (!Op->Src[0].IsNone()) {
     // Memory arg
 
@@ -481,15 +560,14 @@ void OpDispatchBuilder::FSUB(OpcodeArgs) {
     }
   } else {
     // Implicit arg
-    auto offset = _Constant(Op->OP & 7);
-    arg = _And(_Add(top, offset), mask);
+    const uint8_t offset = Op->OP & 7;
     if constexpr (ResInST0 == OpResult::RES_STI) {
-      StackLocation = arg;
+      StackLocation = offset;
     }
-    b = _LoadContextIndexed(arg, 16, MMBaseOffset(), 16, FPRClass);
+    b = LoadX87Stack(offset, 16);
   }
 
-  auto a = _LoadContextIndexed(top, 16, MMBaseOffset(), 16, FPRClass);
+  auto a = LoadX87Stack(0, 16);
 
   OrderedNode *result{};
   if constexpr (reverse) {
@@ -499,17 +577,15 @@ void OpDispatchBuilder::FSUB(OpcodeArgs) {
     result = _F80Sub(a, b);
   }
 
+  // Write to ST[TOP], StackLocation is relative to TOP before the pop
+  StoreX87Stack(StackLocation, result, 16);
+
   if ((Op->TableInfo->Flags & X86Tables::InstFlags::FLAGS_POP) != 0) {
     // if we are popping then we must first mark this location as empty
-    SetX87TopTag(top, X87Tag::Empty);
+    SetX87TopTag(GetX87StackIndex(0), X87Tag::Empty);
     // Set the new top now
-
-    top = _And(_Add(top, _Constant(1)), mask);
-    SetX87Top(top);
+    AdjustX87Top(1);
   }
-
-  // Write to ST[TOP]
-  _StoreContextIndexed(result, StackLocation, 16, MMBaseOffset(), 16, FPRClass);
 }
 
 template
@@ -543,8 +619,7 @@ template
 void OpDispatchBuilder::FSUB<32, true, true, OpDispatchBuilder::OpResult::RES_ST0>(OpcodeArgs);
 
 void OpDispatchBuilder::FCHS(OpcodeArgs) {
-  auto top = GetX87Top();
-  auto a = _LoadContextIndexed(top, 16, MMBaseOffset(), 16, FPRClass);
+  auto a = LoadX87Stack(0, 16);
 
   auto low = _Constant(0);
   auto high = _Constant(0b1'000'0000'0000'0000ULL);
@@ -554,12 +629,11 @@ void OpDispatchBuilder::FCHS(OpcodeArgs) {
   auto result = _VXor(16, 1, a, data);
 
   // Write to ST[TOP]
-  _StoreContextIndexed(result, top, 16, MMBaseOffset(), 16, FPRClass);
+  StoreX87Stack(0, result, 16);
 }
 
 void OpDispatchBuilder::FABS(OpcodeArgs) {
-  auto top = GetX87Top();
-  auto a = _LoadContextIndexed(top, 16, MMBaseOffset(), 16, FPRClass);
+  auto a = LoadX87Stack(0, 16);
 
   auto low = _Constant(~0ULL);
   auto high = _Constant(0b0'111'1111'1111'1111ULL);
@@ -569,12 +643,11 @@ void OpDispatchBuilder::FABS(OpcodeArgs) {
   auto result = _VAnd(16, 1, a, data);
 
   // Write to ST[TOP]
-  _StoreContextIndexed(result, top, 16, MMBaseOffset(), 16, FPRClass);
+  StoreX87Stack(0, result, 16);
 }
 
 void OpDispatchBuilder::FTST(OpcodeArgs) {
-  auto top = GetX87Top();
-  auto a = _LoadContextIndexed(top, 16, MMBaseOffset(), 16, FPRClass);
+  auto a = LoadX87Stack(0, 16);
 
   auto low = _Constant(0);
   OrderedNode *data = _VCastFromGPR(16, 8, low);
@@ -597,13 +670,12 @@ void OpDispatchBuilder::FTST(OpcodeArgs) {
 }
 
 void OpDispatchBuilder::FRNDINT(OpcodeArgs) {
-  auto top = GetX87Top();
-  auto a = _LoadContextIndexed(top, 16, MMBaseOffset(), 16, FPRClass);
+  auto a = LoadX87Stack(0, 16);
 
   auto result = _F80Round(a);
 
   // Write to ST[TOP]
-  _StoreContextIndexed(result, top, 16, MMBaseOffset(), 16, FPRClass);
+  StoreX87Stack(0, result, 16);
 }
 
 void OpDispatchBuilder::FXTRACT(OpcodeArgs) {
@@ -627,6 +699,7 @@ void OpDispatchBuilder::FNINIT(OpcodeArgs) {
   // Init FCW to 0x037F
   auto NewFCW = _Constant(16, 0x037F);
   _F80LoadFCW(NewFCW);
+  SetX87HostRoundingMode(NewFCW);
   _StoreContext(2, GPRClass, NewFCW, offsetof(FEXCore::Core::CPUState, FCW));
 
   // Init FSW to 0
@@ -643,9 +716,6 @@ void OpDispatchBuilder::FNINIT(OpcodeArgs) {
 
 template<size_t width, bool Integer, OpDispatchBuilder::FCOMIFlags whichflags, bool poptwice>
 void OpDispatchBuilder::FCOMI(OpcodeArgs) {
-  auto top = GetX87Top();
-  auto mask = _Constant(7);
-
   OrderedNode *arg{};
   OrderedNode *b{};
 
@@ -663,12 +733,10 @@ void OpDispatchBuilder::FCOMI(OpcodeArgs) {
     }
   } else {
     // Implicit arg
-    auto offset = _Constant(Op->OP & 7);
-    arg = _And(_Add(top, offset), mask);
-    b = _LoadContextIndexed(arg, 16, MMBaseOffset(), 16, FPRClass);
+    b = LoadX87Stack(Op->OP & 7, 16);
   }
 
-  auto a = _LoadContextIndexed(top, 16, MMBaseOffset(), 16, FPRClass);
+  auto a = LoadX87Stack(0, 16);
 
   OrderedNode *Res = _F80Cmp(a, b,
     (1 << FCMP_FLAG_EQ) |
@@ -699,19 +767,16 @@ void OpDispatchBuilder::FCOMI(OpcodeArgs) {
 
   if constexpr (poptwice) {
     // if we are popping then we must first mark this location as empty
-    SetX87TopTag(top, X87Tag::Empty);
-    top = _And(_Add(top, _Constant(1)), mask);
-    SetX87TopTag(top, X87Tag::Empty);
+    SetX87TopTag(GetX87StackIndex(0), X87Tag::Empty);
+    SetX87TopTag(GetX87StackIndex(1), X87Tag::Empty);
     // Set the new top now
-    top = _And(_Add(top, _Constant(1)), mask);
-    SetX87Top(top);
+    AdjustX87Top(2);
   }
   else if ((Op->TableInfo->Flags & X86Tables::InstFlags::FLAGS_POP) != 0) {
     // if we are popping then we must first mark this location as empty
-    SetX87TopTag(top, X87Tag::Empty);
+    SetX87TopTag(GetX87StackIndex(0), X87Tag::Empty);
     // Set the new top now
-    top = _And(_Add(top, _Constant(1)), mask);
-    SetX87Top(top);
+    AdjustX87Top(1);
   }
 }
 
@@ -736,50 +801,37 @@ void OpDispatchBuilder::FCOMI<32, true, OpDispatchBuilder::FCOMIFlags::FLAGS_X87
 
 
 void OpDispatchBuilder::FXCH(OpcodeArgs) {
-  auto top = GetX87Top();
-  OrderedNode* arg;
-
-  auto mask = _Constant(7);
-
   // Implicit arg
-  auto offset = _Constant(Op->OP & 7);
-  arg = _And(_Add(top, offset), mask);
+  const uint8_t offset = Op->OP & 7;
 
-  auto a = _LoadContextIndexed(top, 16, MMBaseOffset(), 16, FPRClass);
-  auto b = _LoadContextIndexed(arg, 16, MMBaseOffset(), 16, FPRClass);
+  auto a = LoadX87Stack(0, 16);
+  auto b = LoadX87Stack(offset, 16);
 
   // Write to ST[TOP]
-  _StoreContextIndexed(b, top, 16, MMBaseOffset(), 16, FPRClass);
-  _StoreContextIndexed(a, arg, 16, MMBaseOffset(), 16, FPRClass);
+  StoreX87Stack(0, b, 16);
+  StoreX87Stack(offset, a, 16);
 }
 
 void OpDispatchBuilder::FST(OpcodeArgs) {
-  auto top = GetX87Top();
-  OrderedNode* arg;
-
-  auto mask = _Constant(7);
-
   // Implicit arg
-  auto offset = _Constant(Op->OP & 7);
-  arg = _And(_Add(top, offset), mask);
+  const uint8_t offset = Op->OP & 7;
 
-  auto a = _LoadContextIndexed(top, 16, MMBaseOffset(), 16, FPRClass);
+  auto a = LoadX87Stack(0, 16);
 
-  // Write to ST[TOP]
-  _StoreContextIndexed(a, arg, 16, MMBaseOffset(), 16, FPRClass);
+  // Write to ST[i]
+  StoreX87Stack(offset, a, 16);
 
   if ((Op->TableInfo->Flags & X86Tables::InstFlags::FLAGS_POP) != 0) {
     // if we are popping then we must first mark this location as empty
-    SetX87TopTag(top, X87Tag::Empty);
-    top = _And(_Add(top, _Constant(1)), _Constant(7));
-    SetX87Top(top);
+    SetX87TopTag(GetX87StackIndex(0), X87Tag::Empty);
+    // Set the new top now
+    AdjustX87Top(1);
   }
 }
 
 template<FEXCore::IR::IROps IROp>
 void OpDispatchBuilder::X87UnaryOp(OpcodeArgs) {
-  auto top = GetX87Top();
-  auto a = _LoadContextIndexed(top, 16, MMBaseOffset(), 16, FPRClass);
+  auto a = LoadX87Stack(0, 16);
 
   auto result = _F80Round(a);
   // Overwrite the op
@@ -792,7 +844,7 @@ void OpDispatchBuilder::X87UnaryOp(OpcodeArgs) {
   }
 
   // Write to ST[TOP]
-  _StoreContextIndexed(result, top, 16, MMBaseOffset(), 16, FPRClass);
+  StoreX87Stack(0, result, 16);
 }
 
 template
@@ -806,13 +858,8 @@ void OpDispatchBuilder::X87UnaryOp<IR::OP_F80COS>(OpcodeArgs);
 
 template<FEXCore::IR::IROps IROp>
 void OpDispatchBuilder::X87BinaryOp(OpcodeArgs) {
-  auto top = GetX87Top();
-
-  auto mask = _Constant(7);
-  OrderedNode *st1 = _And(_Add(top, _Constant(1)), mask);
-
-  auto a = _LoadContextIndexed(top, 16, MMBaseOffset(), 16, FPRClass);
-  st1 = _LoadContextIndexed(st1, 16, MMBaseOffset(), 16, FPRClass);
+  auto a = LoadX87Stack(0, 16);
+  auto st1 = LoadX87Stack(1, 16);
 
   auto result = _F80Add(a, st1);
   // Overwrite the op
@@ -825,7 +872,7 @@ void OpDispatchBuilder::X87BinaryOp(OpcodeArgs) {
   }
 
   // Write to ST[TOP]
-  _StoreContextIndexed(result, top, 16, MMBaseOffset(), 16, FPRClass);
+  StoreX87Stack(0, result, 16);
 }
 
 template
@@ -837,15 +884,7 @@ void OpDispatchBuilder::X87BinaryOp<IR::OP_F80SCALE>(OpcodeArgs);
 
 template<bool Inc>
 void OpDispatchBuilder::X87ModifySTP(OpcodeArgs) {
-  auto orig_top = GetX87Top();
-  if (Inc) {
-    auto top = _And(_Add(orig_top, _Constant(1)), _Constant(7));
-    SetX87Top(top);
-  }
-  else {
-    auto top = _And(_Sub(orig_top, _Constant(1)), _Constant(7));
-    SetX87Top(top);
-  }
+  AdjustX87Top(Inc ? 1 : -1);
 }
 
 template
@@ -944,6 +983,7 @@ void OpDispatchBuilder::X87LDENV(OpcodeArgs) {
 
   auto NewFCW = _LoadMem(GPRClass, 2, Mem, 2);
   _F80LoadFCW(NewFCW);
+  SetX87HostRoundingMode(NewFCW);
   _StoreContext(2, GPRClass, NewFCW, offsetof(FEXCore::Core::CPUState, FCW));
 
   OrderedNode *MemLocation = _Add(Mem, _Constant(Size * 1));
@@ -1056,6 +1096,7 @@ void OpDispatchBuilder::X87FNSTENV(OpcodeArgs) {
 void OpDispatchBuilder::X87FLDCW(OpcodeArgs) {
   OrderedNode *NewFCW = LoadSource(GPRClass, Op, Op->Src[0], Op->Flags, -1);
   _F80LoadFCW(NewFCW);
+  SetX87HostRoundingMode(NewFCW);
   _StoreContext(2, GPRClass, NewFCW, offsetof(FEXCore::Core::CPUState, FCW));
 }
 
@@ -1215,6 +1256,7 @@ void OpDispatchBuilder::X87FRSTOR(OpcodeArgs) {
 
   auto NewFCW = _LoadMem(GPRClass, 2, Mem, 2);
   _F80LoadFCW(NewFCW);
+  SetX87HostRoundingMode(NewFCW);
   _StoreContext(2, GPRClass, NewFCW, offsetof(FEXCore::Core::CPUState, FCW));
 
   OrderedNode *MemLocation = _Add(Mem, _Constant(Size * 1));
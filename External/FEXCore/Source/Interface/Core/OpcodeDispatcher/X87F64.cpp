@@ -38,6 +38,22 @@ class OrderedNode;
 //FCMOV
 //FST(register to register)
 
+OrderedNode *OpDispatchBuilder::LoadX87F64Indexed(OrderedNode *Index) {
+  if (AdaptiveX87F64) {
+    return _F80CVT(8, _LoadContextIndexed(Index, 16, MMBaseOffset(), 16, FPRClass));
+  }
+  return _LoadContextIndexed(Index, 8, MMBaseOffset(), 16, FPRClass);
+}
+
+void OpDispatchBuilder::StoreX87F64Indexed(OrderedNode *Value, OrderedNode *Index) {
+  if (AdaptiveX87F64) {
+    _StoreContextIndexed(_F80CVTTo(Value, 8), Index, 16, MMBaseOffset(), 16, FPRClass);
+  }
+  else {
+    _StoreContextIndexed(Value, Index, 8, MMBaseOffset(), 16, FPRClass);
+  }
+}
+
 // State loading duplicated from X87.cpp, setting host rounding mode
 // See issue
 void OpDispatchBuilder::FNINITF64(OpcodeArgs) {
@@ -123,10 +139,6 @@ void OpDispatchBuilder::X87FLDCWF64(OpcodeArgs) {
 
 template<size_t width>
 void OpDispatchBuilder::FLDF64(OpcodeArgs) {
-  // Update TOP
-  auto orig_top = GetX87Top();
-  auto mask = _Constant(7);
-
   size_t read_width = (width == 80) ? 16 : width / 8;
 
   OrderedNode *data{};
@@ -146,17 +158,14 @@ void OpDispatchBuilder::FLDF64(OpcodeArgs) {
   }
   else {
     // Implicit arg (does this need to change with width?)
-    auto offset = _Constant(Op->OP & 7);
-    data = _And(_Add(orig_top, offset), mask);
-    data = _LoadContextIndexed(data, 8, MMBaseOffset(), 16, FPRClass);
-    converted = data;
+    converted = LoadX87Stack(Op->OP & 7, 8);
   }
 
-  auto top = _And(_Sub(orig_top, _Constant(1)), mask);
-  SetX87TopTag(top, X87Tag::Valid);
-  SetX87Top(top);
+  // Update TOP
+  AdjustX87Top(-1);
+  SetX87TopTag(GetX87StackIndex(0), X87Tag::Valid);
   // Write to ST[TOP]
-  _StoreContextIndexed(converted, top, 8, MMBaseOffset(), 16, FPRClass);
+  StoreX87Stack(0, converted, 8);
 }
 
 template
@@ -178,12 +187,12 @@ void OpDispatchBuilder::FBLDF64(OpcodeArgs) {
   OrderedNode *data = LoadSource_WithOpSize(FPRClass, Op, Op->Src[0], 16, Op->Flags, -1);
   OrderedNode *converted = _F80BCDLoad(data);
   converted = _F80CVT(8, converted);
-  _StoreContextIndexed(converted, top, 8, MMBaseOffset(), 16, FPRClass);
+  StoreX87F64Indexed(converted, top);
 }
 
 void OpDispatchBuilder::FBSTPF64(OpcodeArgs) {
   auto orig_top = GetX87Top();
-  auto data = _LoadContextIndexed(orig_top, 8, MMBaseOffset(), 16, FPRClass);
+  auto data = LoadX87F64Indexed(orig_top);
 
   OrderedNode *converted = _F80CVTTo(data, 8);
   converted = _F80BCDStore(converted);
@@ -199,13 +208,11 @@ void OpDispatchBuilder::FBSTPF64(OpcodeArgs) {
 template<uint64_t num>
 void OpDispatchBuilder::FLDF64_Const(OpcodeArgs) {
   // Update TOP
-  auto orig_top = GetX87Top();
-  auto top = _And(_Sub(orig_top, _Constant(1)), _Constant(7));
-  SetX87TopTag(top, X87Tag::Valid);
-  SetX87Top(top);
+  AdjustX87Top(-1);
+  SetX87TopTag(GetX87StackIndex(0), X87Tag::Valid);
   auto data = _VCastFromGPR(8, 8, _Constant(num));
   // Write to ST[TOP]
-  _StoreContextIndexed(data, top, 8, MMBaseOffset(), 16, FPRClass);
+  StoreX87Stack(0, data, 8);
 }
 
 template
@@ -225,10 +232,8 @@ void OpDispatchBuilder::FLDF64_Const<0>(OpcodeArgs); // 0.0
 
 void OpDispatchBuilder::FILDF64(OpcodeArgs) {
   // Update TOP
-  auto orig_top = GetX87Top();
-  auto top = _And(_Sub(orig_top, _Constant(1)), _Constant(7));
-  SetX87TopTag(top, X87Tag::Valid);
-  SetX87Top(top);
+  AdjustX87Top(-1);
+  SetX87TopTag(GetX87StackIndex(0), X87Tag::Valid);
 
   size_t read_width = GetSrcSize(Op);
   // Read from memory
@@ -238,13 +243,12 @@ void OpDispatchBuilder::FILDF64(OpcodeArgs) {
   }
   auto converted = _Float_FromGPR_S(8, read_width == 4 ? 4 : 8, data);
   // Write to ST[TOP]
-  _StoreContextIndexed(converted, top, 8, MMBaseOffset(), 16, FPRClass);
+  StoreX87Stack(0, converted, 8);
 }
 
 template<size_t width>
 void OpDispatchBuilder::FSTF64(OpcodeArgs) {
-  auto orig_top = GetX87Top();
-  auto data = _LoadContextIndexed(orig_top, 8, MMBaseOffset(), 16, FPRClass);
+  auto data = LoadX87Stack(0, 8);
   if constexpr (width == 64) {
     //Store 64-bit float directly
     StoreResult_WithOpSize(FPRClass, Op, Op->Dest, data, 8, 1);
@@ -260,10 +264,9 @@ void OpDispatchBuilder::FSTF64(OpcodeArgs) {
 
   if ((Op->TableInfo->Flags & X86Tables::InstFlags::FLAGS_POP) != 0) {
     // if we are popping then we must first mark this location as empty
-    SetX87TopTag(orig_top, X87Tag::Empty);
+    SetX87TopTag(GetX87StackIndex(0), X87Tag::Empty);
     // Set the new top now
-    auto top = _And(_Add(orig_top, _Constant(1)), _Constant(7));
-    SetX87Top(top);
+    AdjustX87Top(1);
   }
 }
 
@@ -278,8 +281,7 @@ template<bool Truncate>
 void OpDispatchBuilder::FISTF64(OpcodeArgs) {
   auto Size = GetSrcSize(Op);
 
-  auto orig_top = GetX87Top();
-  OrderedNode *data = _LoadContextIndexed(orig_top, 8, MMBaseOffset(), 16, FPRClass);
+  OrderedNode *data = LoadX87Stack(0, 8);
   if constexpr (Truncate) {
     data = _Float_ToGPR_ZS(Size == 4 ? 4 : 8, 8, data);
   } else {
@@ -289,10 +291,9 @@ void OpDispatchBuilder::FISTF64(OpcodeArgs) {
 
   if ((Op->TableInfo->Flags & X86Tables::InstFlags::FLAGS_POP) != 0) {
     // if we are popping then we must first mark this location as empty
-    SetX87TopTag(orig_top, X87Tag::Empty);
+    SetX87TopTag(GetX87StackIndex(0), X87Tag::Empty);
     // Set the new top now
-    auto top = _And(_Add(orig_top, _Constant(1)), _Constant(7));
-    SetX87Top(top);
+    AdjustX87Top(1);
   }
 }
 
@@ -303,14 +304,11 @@ void OpDispatchBuilder::FISTF64<true>(OpcodeArgs);
 
 template <size_t width, bool Integer, OpDispatchBuilder::OpResult ResInST0>
 void OpDispatchBuilder::FADDF64(OpcodeArgs) {
-  auto top = GetX87Top();
-  OrderedNode *StackLocation = top;
+  uint8_t StackLocation = 0;
 
   OrderedNode *arg{};
   OrderedNode *b{};
 
-  auto mask = _Constant(7);
-
   if (!Op->Src[0].IsNone()) {
     // Memory arg
     if constexpr (Integer) {
@@ -327,26 +325,24 @@ void OpDispatchBuilder::FADDF64(OpcodeArgs) {
     }
   } else {
     // Implicit arg
-    auto offset = _Constant(Op->OP & 7);
-    arg = _And(_Add(top, offset), mask);
+    const uint8_t offset = Op->OP & 7;
     if constexpr (ResInST0 == OpResult::RES_STI) {
-      StackLocation = arg;
+      StackLocation = offset;
     }
-    b = _LoadContextIndexed(arg, 8, MMBaseOffset(), 16, FPRClass);
+    b = LoadX87Stack(offset, 8);
   }
 
-  auto a = _LoadContextIndexed(top, 8, MMBaseOffset(), 16, FPRClass);
+  auto a = LoadX87Stack(0, 8);
   auto result = _VFAdd(8, 8, a, b);
+  // Write to ST[TOP], StackLocation is relative to TOP before the pop
+  StoreX87Stack(StackLocation, result, 8);
+
   if ((Op->TableInfo->Flags & X86Tables::InstFlags::FLAGS_POP) != 0) {
     // if we are popping then we must first mark this location as empty
-    SetX87TopTag(top, X87Tag::Empty);
+    SetX87TopTag(GetX87StackIndex(0), X87Tag::Empty);
     // Set the new top now
-    top = _And(_Add(top, _Constant(1)), mask);
-    SetX87Top(top);
+    AdjustX87Top(1);
   }
-
-  // Write to ST[TOP]
-  _StoreContextIndexed(result, StackLocation, 8, MMBaseOffset(), 16, FPRClass);
 }
 
 template
@@ -365,13 +361,10 @@ void OpDispatchBuilder::FADDF64<32, true, OpDispatchBuilder::OpResult::RES_ST0>(
 
 template<size_t width, bool Integer, OpDispatchBuilder::OpResult ResInST0>
 void OpDispatchBuilder::FMULF64(OpcodeArgs) {
-  auto top = GetX87Top();
-  OrderedNode *StackLocation = top;
+  uint8_t StackLocation = 0;
   OrderedNode *arg{};
   OrderedNode *b{};
 
-  auto mask = _Constant(7);
-
   if (!Op->Src[0].IsNone()) {
     // Memory arg
     if constexpr (Integer) {
@@ -388,29 +381,26 @@ void OpDispatchBuilder::FMULF64(OpcodeArgs) {
     }
   } else {
     // Implicit arg
-    auto offset = _Constant(Op->OP & 7);
-    arg = _And(_Add(top, offset), mask);
+    const uint8_t offset = Op->OP & 7;
     if constexpr (ResInST0 == OpResult::RES_STI) {
-      StackLocation = arg;
+      StackLocation = offset;
     }
-
-    b = _LoadContextIndexed(arg, 8, MMBaseOffset(), 16, FPRClass);
+    b = LoadX87Stack(offset, 8);
   }
 
-  auto a = _LoadContextIndexed(top, 8, MMBaseOffset(), 16, FPRClass);
+  auto a = LoadX87Stack(0, 8);
 
   auto result = _VFMul(8, 8, a, b);
 
+  // Write to ST[TOP], StackLocation is relative to TOP before the pop
+  StoreX87Stack(StackLocation, result, 8);
+
   if ((Op->TableInfo->Flags & X86Tables::InstFlags::FLAGS_POP) != 0) {
     // if we are popping then we must first mark this location as empty
-    SetX87TopTag(top, X87Tag::Empty);
+    SetX87TopTag(GetX87StackIndex(0), X87Tag::Empty);
     // Set the new top now
-    top = _And(_Add(top, _Constant(1)), mask);
-    SetX87Top(top);
+    AdjustX87Top(1);
   }
-
-  // Write to ST[TOP]
-  _StoreContextIndexed(result, StackLocation, 8, MMBaseOffset(), 16, FPRClass);
 }
 
 template
@@ -429,13 +419,10 @@ void OpDispatchBuilder::FMULF64<32, true, OpDispatchBuilder::OpResult::RES_ST0>(
 
 template<size_t width, bool Integer, bool reverse, OpDispatchBuilder::OpResult ResInST0>
 void OpDispatchBuilder::FDIVF64(OpcodeArgs) {
-  auto top = GetX87Top();
-  OrderedNode *StackLocation = top;
+  uint8_t StackLocation = 0;
   OrderedNode *arg{};
   OrderedNode *b{};
 
-  auto mask = _Constant(7);
-
  if (!Op->Src[0].IsNone()) {
     // Memory arg
     if constexpr (Integer) {
@@ -452,16 +439,14 @@ void OpDispatchBuilder::FDIVF64(OpcodeArgs) {
     }
   } else {
     // Implicit arg
-    auto offset = _Constant(Op->OP & 7);
-    arg = _And(_Add(top, offset), mask);
+    const uint8_t offset = Op->OP & 7;
     if constexpr (ResInST0 == OpResult::RES_STI) {
-      StackLocation = arg;
+      StackLocation = offset;
     }
-
-    b = _LoadContextIndexed(arg, 8, MMBaseOffset(), 16, FPRClass);
+    b = LoadX87Stack(offset, 8);
   }
 
-  auto a = _LoadContextIndexed(top, 8, MMBaseOffset(), 16, FPRClass);
+  auto a = LoadX87Stack(0, 8);
 
   OrderedNode *result{};
   if constexpr (reverse) {
@@ -471,16 +456,15 @@ void OpDispatchBuilder::FDIVF64(OpcodeArgs) {
     result = _VFDiv(8, 8, a, b);
   }
 
+  // Write to ST[TOP], StackLocation is relative to TOP before the pop
+  StoreX87Stack(StackLocation, result, 8);
+
   if ((Op->TableInfo->Flags & X86Tables::InstFlags::FLAGS_POP) != 0) {
     // if we are popping then we must first mark this location as empty
-    SetX87TopTag(top, X87Tag::Empty);
+    SetX87TopTag(GetX87StackIndex(0), X87Tag::Empty);
     // Set the new top now
-    top = _And(_Add(top, _Constant(1)), mask);
-    SetX87Top(top);
+    AdjustX87Top(1);
   }
-
-  // Write to ST[TOP]
-  _StoreContextIndexed(result, StackLocation, 8, MMBaseOffset(), 16, FPRClass);
 }
 
 template
@@ -515,13 +499,10 @@ void OpDispatchBuilder::FDIVF64<32, true, true, OpDispatchBuilder::OpResult::RES
 
 template<size_t width, bool Integer, bool reverse, OpDispatchBuilder::OpResult ResInST0>
 void OpDispatchBuilder::FSUBF64(OpcodeArgs) {
-  auto top = GetX87Top();
-  OrderedNode *StackLocation = top;
+  uint8_t StackLocation = 0;
   OrderedNode *arg{};
   OrderedNode *b{};
 
-  auto mask = _Constant(7);
-
  if (!Op->Src[0].IsNone()) {
     // Memory arg
     if constexpr (Integer) {
@@ -538,16 +519,14 @@ void OpDispatchBuilder::FSUBF64(OpcodeArgs) {
     }
   } else {
     // Implicit arg
-    auto offset = _Constant(Op->OP & 7);
-    arg = _And(_Add(top, offset), mask);
+    const uint8_t offset = Op->OP & 7;
     if constexpr (ResInST0 == OpResult::RES_STI) {
-      StackLocation = arg;
+      StackLocation = offset;
     }
-
-    b = _LoadContextIndexed(arg, 8, MMBaseOffset(), 16, FPRClass);
+    b = LoadX87Stack(offset, 8);
   }
 
-  auto a = _LoadContextIndexed(top, 8, MMBaseOffset(), 16, FPRClass);
+  auto a = LoadX87Stack(0, 8);
 
   OrderedNode *result{};
   if constexpr (reverse) {
@@ -557,17 +536,15 @@ void OpDispatchBuilder::FSUBF64(OpcodeArgs) {
     result = _VFSub(8, 8, a, b);
   }
 
+  // Write to ST[TOP], StackLocation is relative to TOP before the pop
+  StoreX87Stack(StackLocation, result, 8);
+
   if ((Op->TableInfo->Flags & X86Tables::InstFlags::FLAGS_POP) != 0) {
     // if we are popping then we must first mark this location as empty
-    SetX87TopTag(top, X87Tag::Empty);
+    SetX87TopTag(GetX87StackIndex(0), X87Tag::Empty);
     // Set the new top now
-
-    top = _And(_Add(top, _Constant(1)), mask);
-    SetX87Top(top);
+    AdjustX87Top(1);
   }
-
-  // Write to ST[TOP]
-  _StoreContextIndexed(result, StackLocation, 8, MMBaseOffset(), 16, FPRClass);
 }
 
 template
@@ -601,28 +578,25 @@ template
 void OpDispatchBuilder::FSUBF64<32, true, true, OpDispatchBuilder::OpResult::RES_ST0>(OpcodeArgs);
 
 void OpDispatchBuilder::FCHSF64(OpcodeArgs) {
-  auto top = GetX87Top();
-  auto a = _LoadContextIndexed(top, 8, MMBaseOffset(), 16, FPRClass);
+  auto a = LoadX87Stack(0, 8);
   auto b = _VCastFromGPR(8, 8, _Constant(0x8000000000000000));
 
   auto result = _VXor(8, 8, a, b);
   // Write to ST[TOP]
-  _StoreContextIndexed(result, top, 8, MMBaseOffset(), 16, FPRClass);
+  StoreX87Stack(0, result, 8);
 }
 
 void OpDispatchBuilder::FABSF64(OpcodeArgs) {
-  auto top = GetX87Top();
-  auto a = _LoadContextIndexed(top, 8, MMBaseOffset(), 16, FPRClass);
+  auto a = LoadX87Stack(0, 8);
   auto b = _VCastFromGPR(8, 8, _Constant(0x7fffffffffffffff));
   auto result = _VAnd(8, 8, a, b);
 
   // Write to ST[TOP]
-  _StoreContextIndexed(result, top, 8, MMBaseOffset(), 16, FPRClass);
+  StoreX87Stack(0, result, 8);
 }
 
 void OpDispatchBuilder::FTSTF64(OpcodeArgs) {
-  auto top = GetX87Top();
-  auto a = _LoadContextIndexed(top, 8, MMBaseOffset(), 16, FPRClass);
+  auto a = LoadX87Stack(0, 8);
 
   auto low = _Constant(0);
   OrderedNode *data = _VCastFromGPR(8, 8, low);
@@ -646,13 +620,12 @@ void OpDispatchBuilder::FTSTF64(OpcodeArgs) {
 
 //TODO: This should obey rounding mode
 void OpDispatchBuilder::FRNDINTF64(OpcodeArgs) {
-  auto top = GetX87Top();
-  auto a = _LoadContextIndexed(top, 8, MMBaseOffset(), 16, FPRClass);
+  auto a = LoadX87Stack(0, 8);
 
   auto result = _Vector_FToI(8, 8, a, FEXCore::IR::Round_Nearest);
 
   // Write to ST[TOP]
-  _StoreContextIndexed(result, top, 8, MMBaseOffset(), 16, FPRClass);
+  StoreX87Stack(0, result, 8);
 }
 
 void OpDispatchBuilder::FXTRACTF64(OpcodeArgs) {
@@ -661,7 +634,7 @@ void OpDispatchBuilder::FXTRACTF64(OpcodeArgs) {
   SetX87TopTag(top, X87Tag::Valid);
   SetX87Top(top);
 
-  auto a = _LoadContextIndexed(orig_top, 8, MMBaseOffset(), 16, FPRClass);
+  auto a = LoadX87F64Indexed(orig_top);
   auto gpr = _VExtractToGPR(8, 8, a, 0);
   OrderedNode* exp = _And(gpr, _Constant(0x7ff0000000000000LL));
   exp = _Lshr(exp, _Constant(52));
@@ -671,16 +644,13 @@ void OpDispatchBuilder::FXTRACTF64(OpcodeArgs) {
   sig = _Or(sig, _Constant(0x3ff0000000000000LL));
   sig = _VCastFromGPR(8, 8, sig);
   // Write to ST[TOP]
-  _StoreContextIndexed(exp, orig_top, 8, MMBaseOffset(), 16, FPRClass);
-  _StoreContextIndexed(sig, top, 8, MMBaseOffset(), 16, FPRClass);
+  StoreX87F64Indexed(exp, orig_top);
+  StoreX87F64Indexed(sig, top);
 }
 
 
 template<size_t width, bool Integer, OpDispatchBuilder::FCOMIFlags whichflags, bool poptwice>
 void OpDispatchBuilder::FCOMIF64(OpcodeArgs) {
-  auto top = GetX87Top();
-  auto mask = _Constant(7);
-
   OrderedNode *arg{};
   OrderedNode *b{};
 
@@ -700,12 +670,10 @@ void OpDispatchBuilder::FCOMIF64(OpcodeArgs) {
     }
   } else {
     // Implicit arg
-    auto offset = _Constant(Op->OP & 7);
-    arg = _And(_Add(top, offset), mask);
-    b = _LoadContextIndexed(arg, 8, MMBaseOffset(), 16, FPRClass);
+    b = LoadX87Stack(Op->OP & 7, 8);
   }
 
-  auto a = _LoadContextIndexed(top, 8, MMBaseOffset(), 16, FPRClass);
+  auto a = LoadX87Stack(0, 8);
 
   OrderedNode *Res = _FCmp(8, a, b,
     (1 << FCMP_FLAG_EQ) |
@@ -737,19 +705,16 @@ void OpDispatchBuilder::FCOMIF64(OpcodeArgs) {
 
   if constexpr (poptwice) {
     // if we are popping then we must first mark this location as empty
-    SetX87TopTag(top, X87Tag::Empty);
-    top = _And(_Add(top, _Constant(1)), mask);
-    SetX87TopTag(top, X87Tag::Empty);
+    SetX87TopTag(GetX87StackIndex(0), X87Tag::Empty);
+    SetX87TopTag(GetX87StackIndex(1), X87Tag::Empty);
     // Set the new top now
-    top = _And(_Add(top, _Constant(1)), mask);
-    SetX87Top(top);
+    AdjustX87Top(2);
   }
   else if ((Op->TableInfo->Flags & X86Tables::InstFlags::FLAGS_POP) != 0) {
     // if we are popping then we must first mark this location as empty
-    SetX87TopTag(top, X87Tag::Empty);
+    SetX87TopTag(GetX87StackIndex(0), X87Tag::Empty);
     // Set the new top now
-    top = _And(_Add(top, _Constant(1)), mask);
-    SetX87Top(top);
+    AdjustX87Top(1);
   }
 }
 
@@ -774,20 +739,18 @@ void OpDispatchBuilder::FCOMIF64<32, true, OpDispatchBuilder::FCOMIFlags::FLAGS_
 
 
 void OpDispatchBuilder::FSQRTF64(OpcodeArgs) {
-  auto top = GetX87Top();
-  auto a = _LoadContextIndexed(top, 8, MMBaseOffset(), 16, FPRClass);
+  auto a = LoadX87Stack(0, 8);
 
   auto result = _VFSqrt(8, 8, a);
 
   // Write to ST[TOP]
-  _StoreContextIndexed(result, top, 8, MMBaseOffset(), 16, FPRClass);
+  StoreX87Stack(0, result, 8);
 }
 
 
 template<FEXCore::IR::IROps IROp>
 void OpDispatchBuilder::X87UnaryOpF64(OpcodeArgs) {
-  auto top = GetX87Top();
-  auto a = _LoadContextIndexed(top, 8, MMBaseOffset(), 16, FPRClass);
+  auto a = LoadX87Stack(0, 8);
 
   auto result = _F64SIN(a);
   // Overwrite the op
@@ -800,7 +763,7 @@ void OpDispatchBuilder::X87UnaryOpF64(OpcodeArgs) {
   }
 
   // Write to ST[TOP]
-  _StoreContextIndexed(result, top, 8, MMBaseOffset(), 16, FPRClass);
+  StoreX87Stack(0, result, 8);
 }
 
 template
@@ -813,13 +776,8 @@ void OpDispatchBuilder::X87UnaryOpF64<IR::OP_F64COS>(OpcodeArgs);
 
 template<FEXCore::IR::IROps IROp>
 void OpDispatchBuilder::X87BinaryOpF64(OpcodeArgs) {
-  auto top = GetX87Top();
-
-  auto mask = _Constant(7);
-  OrderedNode *st1 = _And(_Add(top, _Constant(1)), mask);
-
-  auto a = _LoadContextIndexed(top, 8, MMBaseOffset(), 16, FPRClass);
-  st1 = _LoadContextIndexed(st1, 8, MMBaseOffset(), 16, FPRClass);
+  auto a = LoadX87Stack(0, 8);
+  auto st1 = LoadX87Stack(1, 8);
 
   auto result = _F64ATAN(a, st1);
   // Overwrite the op
@@ -832,7 +790,7 @@ void OpDispatchBuilder::X87BinaryOpF64(OpcodeArgs) {
   }
 
   // Write to ST[TOP]
-  _StoreContextIndexed(result, top, 8, MMBaseOffset(), 16, FPRClass);
+  StoreX87Stack(0, result, 8);
 }
 
 template
@@ -848,7 +806,7 @@ void OpDispatchBuilder::X87SinCosF64(OpcodeArgs) {
   SetX87TopTag(top, X87Tag::Valid);
   SetX87Top(top);
 
-  auto a = _LoadContextIndexed(orig_top, 8, MMBaseOffset(), 16, FPRClass);
+  auto a = LoadX87F64Indexed(orig_top);
 
   auto sin = _F64SIN(a);
   auto cos = _F64COS(a);
@@ -857,8 +815,8 @@ void OpDispatchBuilder::X87SinCosF64(OpcodeArgs) {
   SetRFLAG<FEXCore::X86State::X87FLAG_C2_LOC>(_Constant(0));
 
   // Write to ST[TOP]
-  _StoreContextIndexed(sin, orig_top, 8, MMBaseOffset(), 16, FPRClass);
-  _StoreContextIndexed(cos, top, 8, MMBaseOffset(), 16, FPRClass);
+  StoreX87F64Indexed(sin, orig_top);
+  StoreX87F64Indexed(cos, top);
 }
 
 void OpDispatchBuilder::X87FYL2XF64(OpcodeArgs) {
@@ -870,8 +828,8 @@ void OpDispatchBuilder::X87FYL2XF64(OpcodeArgs) {
   auto top = _And(_Add(orig_top, _Constant(1)), _Constant(7));
   SetX87Top(top);
 
-  OrderedNode *st0 = _LoadContextIndexed(orig_top, 8, MMBaseOffset(), 16, FPRClass);
-  OrderedNode *st1 = _LoadContextIndexed(top, 8, MMBaseOffset(), 16, FPRClass);
+  OrderedNode *st0 = LoadX87F64Indexed(orig_top);
+  OrderedNode *st1 = LoadX87F64Indexed(top);
 
   if (Plus1) {
     auto one = _VCastFromGPR(8, 8, _Constant(0x3FF0000000000000));
@@ -881,7 +839,7 @@ void OpDispatchBuilder::X87FYL2XF64(OpcodeArgs) {
   auto result = _F64FYL2X(st0, st1);
 
   // Write to ST[TOP]
-  _StoreContextIndexed(result, top, 8, MMBaseOffset(), 16, FPRClass);
+  StoreX87F64Indexed(result, top);
 }
 
 void OpDispatchBuilder::X87TANF64(OpcodeArgs) {
@@ -890,7 +848,7 @@ void OpDispatchBuilder::X87TANF64(OpcodeArgs) {
   SetX87TopTag(top, X87Tag::Valid);
   SetX87Top(top);
 
-  auto a = _LoadContextIndexed(orig_top, 8, MMBaseOffset(), 16, FPRClass);
+  auto a = LoadX87F64Indexed(orig_top);
 
   auto result = _F64TAN(a);
 
@@ -900,8 +858,8 @@ void OpDispatchBuilder::X87TANF64(OpcodeArgs) {
   SetRFLAG<FEXCore::X86State::X87FLAG_C2_LOC>(_Constant(0));
 
   // Write to ST[TOP]
-  _StoreContextIndexed(result, orig_top, 8, MMBaseOffset(), 16, FPRClass);
-  _StoreContextIndexed(one, top, 8, MMBaseOffset(), 16, FPRClass);
+  StoreX87F64Indexed(result, orig_top);
+  StoreX87F64Indexed(one, top);
 }
 
 void OpDispatchBuilder::X87ATANF64(OpcodeArgs) {
@@ -911,13 +869,13 @@ void OpDispatchBuilder::X87ATANF64(OpcodeArgs) {
   auto top = _And(_Add(orig_top, _Constant(1)), _Constant(7));
   SetX87Top(top);
 
-  auto a = _LoadContextIndexed(orig_top, 8, MMBaseOffset(), 16, FPRClass);
-  OrderedNode *st1 = _LoadContextIndexed(top, 8, MMBaseOffset(), 16, FPRClass);
+  auto a = LoadX87F64Indexed(orig_top);
+  OrderedNode *st1 = LoadX87F64Indexed(top);
 
   auto result = _F64ATAN(st1, a);
 
   // Write to ST[TOP]
-  _StoreContextIndexed(result, top, 8, MMBaseOffset(), 16, FPRClass);
+  StoreX87F64Indexed(result, top);
 }
 
 //This function converts to F80 on save for compatibility
@@ -1009,7 +967,7 @@ void OpDispatchBuilder::X87FNSAVEF64(OpcodeArgs) {
   auto SevenConst = _Constant(7);
   auto TenConst = _Constant(10);
   for (int i = 0; i < 7; ++i) {
-    OrderedNode* data = _LoadContextIndexed(Top, 8, MMBaseOffset(), 16, FPRClass);
+    OrderedNode* data = LoadX87F64Indexed(Top);
     data = _F80CVTTo(data, 8);
     _StoreMem(FPRClass, 16, ST0Location, data, 1);
     ST0Location = _Add(ST0Location, TenConst);
@@ -1017,7 +975,7 @@ void OpDispatchBuilder::X87FNSAVEF64(OpcodeArgs) {
   }
 
   // The final st(7) needs a bit of special handling here
-  OrderedNode* data = _LoadContextIndexed(Top, 8, MMBaseOffset(), 16, FPRClass);
+  OrderedNode* data = LoadX87F64Indexed(Top);
   data = _F80CVTTo(data, 8);
   // ST7 broken in to two parts
   // Lower 64bits [63:0]
@@ -1092,7 +1050,7 @@ void OpDispatchBuilder::X87FRSTORF64(OpcodeArgs) {
     Reg = _VAnd(16, 16, Reg, Mask);
     //Convert to double precision
     Reg = _F80CVT(8, Reg);
-    _StoreContextIndexed(Reg, Top, 8, MMBaseOffset(), 16, FPRClass);
+    StoreX87F64Indexed(Reg, Top);
 
     ST0Location = _Add(ST0Location, TenConst);
     Top = _And(_Add(Top, OneConst), SevenConst);
@@ -1108,14 +1066,14 @@ void OpDispatchBuilder::X87FRSTORF64(OpcodeArgs) {
   OrderedNode *RegHigh = _LoadMem(FPRClass, 2, ST0Location, 1);
   Reg = _VInsElement(16, 2, 4, 0, Reg, RegHigh);
   Reg = _F80CVT(8, Reg); //Convert to double precision
-  _StoreContextIndexed(Reg, Top, 8, MMBaseOffset(), 16, FPRClass);
+  StoreX87F64Indexed(Reg, Top);
 }
 
 
 //FXAM needs change
 void OpDispatchBuilder::X87FXAMF64(OpcodeArgs) {
   auto top = GetX87Top();
-  auto a = _LoadContextIndexed(top, 8, MMBaseOffset(), 16, FPRClass);
+  auto a = LoadX87F64Indexed(top);
   OrderedNode *Result = _VExtractToGPR(8, 8, a, 0);
 
   // Extract the sign bit
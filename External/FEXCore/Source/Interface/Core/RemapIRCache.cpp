@@ -0,0 +1,126 @@
+/*
+$info$
+tags: glue|block-database
+desc: Keeps block IR across guest code being moved with mremap
+$end_info$
+*/
+
+#include "Interface/Core/RemapIRCache.h"
+
+#include <FEXCore/IR/IntrusiveIRList.h>
+
+#include <cstring>
+#include <iterator>
+
+namespace FEXCore {
+  RemapIRCache::StoredEntry::~StoredEntry() {
+    delete IRList;
+    FEXCore::IR::RegisterAllocationDataDeleter{}(RAData);
+  }
+
+  RemapIRCache::~RemapIRCache() = default;
+
+  void RemapIRCache::Erase(EntryMap::iterator it) {
+    TotalBytes -= it->second->Bytes;
+    Entries.erase(it);
+  }
+
+  std::optional<RemapIRCache::CopiedEntry> RemapIRCache::Find(uint64_t GuestRIP, uint64_t StartAddr, uint64_t Length, bool InlineSMCChecks,
+                                                              FEXCore::Utils::BumpArena &Arena) {
+    std::lock_guard lk(Lock);
+    auto it = Entries.find(GuestRIP);
+    if (it == Entries.end()) {
+      return std::nullopt;
+    }
+
+    // The decoder already followed the current bytes, the IR is only valid if they are the ones it was generated from
+    const auto &Stored = *it->second;
+    if (Stored.EntryOffset != GuestRIP - StartAddr ||
+        Stored.InlineSMCChecks != InlineSMCChecks ||
+        Stored.GuestCode.size() != Length ||
+        memcmp(Stored.GuestCode.data(), reinterpret_cast<const void*>(StartAddr), Length) != 0) {
+      return std::nullopt;
+    }
+
+    return CopiedEntry {
+      .IRList = Arena.New<FEXCore::IR::IRListView>(Stored.IRList, Arena),
+      .RAData = Stored.RAData->CreateCopy(Arena),
+      .TotalInstructions = Stored.TotalInstructions,
+      .TotalInstructionsLength = Stored.TotalInstructionsLength,
+    };
+  }
+
+  void RemapIRCache::Insert(uint64_t GuestRIP, uint64_t StartAddr, uint64_t Length, bool InlineSMCChecks,
+                            FEXCore::IR::IRListView *IRList, FEXCore::IR::RegisterAllocationData const *RAData,
+                            uint64_t TotalInstructions, uint64_t TotalInstructionsLength) {
+    if (Length == 0 || !RAData) {
+      return;
+    }
+
+    const size_t Bytes = IRList->GetDataSize() + IRList->GetListSize() +
+                         FEXCore::IR::RegisterAllocationData::Size(RAData->MapCount) + Length;
+    if (Bytes > MaxBytes) {
+      return;
+    }
+
+    auto Stored = fextl::make_unique<StoredEntry>();
+    Stored->IRList = IRList->CreateCopy();
+    Stored->RAData = RAData->CreateCopy().release();
+    Stored->TotalInstructions = TotalInstructions;
+    Stored->TotalInstructionsLength = TotalInstructionsLength;
+    Stored->GuestCode.resize(Length);
+    memcpy(Stored->GuestCode.data(), reinterpret_cast<const void*>(StartAddr), Length);
+    Stored->EntryOffset = GuestRIP - StartAddr;
+    Stored->InlineSMCChecks = InlineSMCChecks;
+    Stored->Bytes = Bytes;
+
+    std::lock_guard lk(Lock);
+    if (auto it = Entries.find(GuestRIP); it != Entries.end()) {
+      Erase(it);
+    }
+
+    if (TotalBytes + Bytes > MaxBytes) {
+      // Like the code cache, start over instead of tracking which entries are cold
+      Entries.clear();
+      TotalBytes = 0;
+    }
+
+    TotalBytes += Bytes;
+    Entries.emplace(GuestRIP, std::move(Stored));
+  }
+
+  void RemapIRCache::Migrate(uint64_t OldStart, uint64_t NewStart, uint64_t Length) {
+    if (OldStart == NewStart || Length == 0) {
+      return;
+    }
+
+    std::lock_guard lk(Lock);
+
+    // Blocks entered from before the range are left alone, their bytes no longer match if they spanned the move
+    EntryMap Moved;
+    for (auto it = Entries.lower_bound(OldStart); it != Entries.end() && it->first < OldStart + Length;) {
+      auto &Stored = *it->second;
+      const uint64_t StartAddr = it->first - Stored.EntryOffset;
+      const bool Contained = StartAddr >= OldStart && StartAddr + Stored.GuestCode.size() <= OldStart + Length;
+
+      if (!Contained) {
+        // The part outside of the range stays behind, the block can't be rebuilt from it
+        auto Next = std::next(it);
+        Erase(it);
+        it = Next;
+        continue;
+      }
+
+      auto Node = Entries.extract(it++);
+      Node.key() = Node.key() - OldStart + NewStart;
+      Moved.insert(std::move(Node));
+    }
+
+    for (auto &Node : Moved) {
+      if (auto it = Entries.find(Node.first); it != Entries.end()) {
+        Erase(it);
+      }
+    }
+    Entries.merge(Moved);
+  }
+}
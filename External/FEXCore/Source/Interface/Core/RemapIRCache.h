@@ -0,0 +1,90 @@
+#pragma once
+#include <FEXCore/IR/RegisterAllocationData.h>
+#include <FEXCore/Utils/BumpArena.h>
+#include <FEXCore/fextl/map.h>
+#include <FEXCore/fextl/memory.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+namespace FEXCore::IR {
+class IRListView;
+}
+
+namespace FEXCore {
+/**
+ * @brief Keeps the optimized IR of compiled blocks so guest code moved with mremap skips the frontend and passes
+ *
+ * The same IR that BlockIRDedupCache shares only refers to guest addresses through EntrypointOffset,
+ * so it is still valid once its guest code has moved. Only the backend runs again at the new address.
+ *
+ * Entries are keyed by block entry and move with their code in Migrate.
+ * An entry is only used while the decoded guest range still has the bytes it was generated from,
+ * so invalidation never needs to remove one.
+ */
+class RemapIRCache {
+public:
+  struct CopiedEntry {
+    FEXCore::IR::IRListView *IRList;
+    FEXCore::IR::RegisterAllocationData::UniquePtr RAData;
+    uint64_t TotalInstructions;
+    uint64_t TotalInstructionsLength;
+  };
+
+  explicit RemapIRCache(size_t MaxBytes)
+    : MaxBytes {MaxBytes} {}
+  ~RemapIRCache();
+
+  /**
+   * @brief Looks up IR for the block at GuestRIP
+   *
+   * @param StartAddr - First decoded guest byte
+   * @param Length - Size of the decoded guest range
+   * @param InlineSMCChecks - If the IR would be generated with inline SMC checks
+   * @param Arena - Receives copies of the IR and RA data, entries can be dropped by other threads once this returns
+   */
+  std::optional<CopiedEntry> Find(uint64_t GuestRIP, uint64_t StartAddr, uint64_t Length, bool InlineSMCChecks,
+                                  FEXCore::Utils::BumpArena &Arena);
+
+  /**
+   * @brief Stores a copy of freshly generated IR, replacing any older IR for GuestRIP
+   */
+  void Insert(uint64_t GuestRIP, uint64_t StartAddr, uint64_t Length, bool InlineSMCChecks,
+              FEXCore::IR::IRListView *IRList, FEXCore::IR::RegisterAllocationData const *RAData,
+              uint64_t TotalInstructions, uint64_t TotalInstructionsLength);
+
+  /**
+   * @brief Moves the IR of blocks whose guest code lies entirely in [OldStart, OldStart + Length) to NewStart
+   *
+   * Blocks that only partially overlap the range are dropped.
+   */
+  void Migrate(uint64_t OldStart, uint64_t NewStart, uint64_t Length);
+
+private:
+  struct StoredEntry {
+    FEXCore::IR::IRListView *IRList;
+    FEXCore::IR::RegisterAllocationData *RAData;
+    uint64_t TotalInstructions;
+    uint64_t TotalInstructionsLength;
+    fextl::vector<uint8_t> GuestCode;
+    // Distance from the first decoded byte to the entry
+    uint64_t EntryOffset;
+    bool InlineSMCChecks;
+    size_t Bytes;
+
+    ~StoredEntry();
+  };
+
+  using EntryMap = fextl::map<uint64_t, fextl::unique_ptr<StoredEntry>>;
+  void Erase(EntryMap::iterator it);
+
+  const size_t MaxBytes;
+  size_t TotalBytes{};
+
+  std::mutex Lock;
+  EntryMap Entries;
+};
+}
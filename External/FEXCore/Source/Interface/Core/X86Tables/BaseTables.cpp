@@ -13,8 +13,10 @@ $end_info$
 namespace FEXCore::X86Tables {
 using namespace InstFlags;
 
-void InitializeBaseTables(Context::OperatingMode Mode) {
-  static constexpr U8U8InfoStruct BaseOpTable[] = {
+static consteval std::array<X86InstInfo, MAX_PRIMARY_TABLE_SIZE> GenerateBaseTables(Context::OperatingMode Mode) {
+  std::array<X86InstInfo, MAX_PRIMARY_TABLE_SIZE> BaseOps{};
+
+  constexpr U8U8InfoStruct BaseOpTable[] = {
     // Prefixes
     // Operand size overide
     {0x66, 1, X86InstInfo{"",      TYPE_PREFIX, FLAGS_NONE,        0, nullptr}},
@@ -232,7 +234,7 @@ void InitializeBaseTables(Context::OperatingMode Mode) {
     {0xC4, 2, X86InstInfo{"",   TYPE_VEX_TABLE_PREFIX, FLAGS_NONE, 0, nullptr}},
   };
 
-  static constexpr U8U8InfoStruct BaseOpTable_64[] = {
+  constexpr U8U8InfoStruct BaseOpTable_64[] = {
     {0x06, 2, X86InstInfo{"[INV]",  TYPE_INVALID, FLAGS_NONE,                                                                     0, nullptr}},
     {0x0E, 1, X86InstInfo{"[INV]",  TYPE_INVALID, FLAGS_NONE,                                                                     0, nullptr}},
     {0x16, 2, X86InstInfo{"[INV]",  TYPE_INVALID, FLAGS_NONE,                                                                     0, nullptr}},
@@ -259,7 +261,7 @@ void InitializeBaseTables(Context::OperatingMode Mode) {
     {0xEA, 1, X86InstInfo{"[INV]",  TYPE_INVALID, FLAGS_NONE,                                                                                                      0, nullptr}},
   };
 
-  static constexpr U8U8InfoStruct BaseOpTable_32[] = {
+  constexpr U8U8InfoStruct BaseOpTable_32[] = {
     {0x06, 1, X86InstInfo{"PUSH ES",  TYPE_INST, GenFlagsSrcSize(SIZE_16BIT) | FLAGS_DEBUG_MEM_ACCESS,            0, nullptr}},
     {0x07, 1, X86InstInfo{"POP ES",   TYPE_INST, GenFlagsSizes(SIZE_16BIT, SIZE_DEF) | FLAGS_DEBUG_MEM_ACCESS,    0, nullptr}},
     {0x0E, 1, X86InstInfo{"PUSH CS",  TYPE_INST, GenFlagsSrcSize(SIZE_16BIT) | FLAGS_DEBUG_MEM_ACCESS,            0, nullptr}},
@@ -298,6 +300,16 @@ void InitializeBaseTables(Context::OperatingMode Mode) {
   else {
     GenerateTable(&BaseOps.at(0), BaseOpTable_32, std::size(BaseOpTable_32));
   }
+
+  return BaseOps;
 }
-}
 
+constinit std::array<X86InstInfo, MAX_PRIMARY_TABLE_SIZE> BaseOps = GenerateBaseTables(Context::MODE_64BIT);
+
+void InitializeBaseTables(Context::OperatingMode Mode) {
+  if (Mode == Context::MODE_32BIT) {
+    static constexpr auto BaseOps_32 = GenerateBaseTables(Context::MODE_32BIT);
+    BaseOps = BaseOps_32;
+  }
+}
+}
@@ -11,8 +11,10 @@ $end_info$
 namespace FEXCore::X86Tables {
 using namespace InstFlags;
 
-void InitializeDDDTables() {
-  static constexpr U8U8InfoStruct DDDNowOpTable[] = {
+static consteval std::array<X86InstInfo, MAX_3DNOW_TABLE_SIZE> GenerateDDDTables() {
+  std::array<X86InstInfo, MAX_3DNOW_TABLE_SIZE> DDDNowOps{};
+
+  constexpr U8U8InfoStruct DDDNowOpTable[] = {
     {0x0C, 1, X86InstInfo{"PI2FW",    TYPE_INST, GenFlagsSameSize(SIZE_64BIT) | FLAGS_MODRM | FLAGS_XMM_FLAGS | FLAGS_SF_MMX, 0, nullptr}},
     {0x0D, 1, X86InstInfo{"PI2FD",    TYPE_INST, GenFlagsSameSize(SIZE_64BIT) | FLAGS_MODRM | FLAGS_XMM_FLAGS | FLAGS_SF_MMX, 0, nullptr}},
     {0x1C, 1, X86InstInfo{"PF2IW",    TYPE_INST, GenFlagsSameSize(SIZE_64BIT) | FLAGS_MODRM | FLAGS_XMM_FLAGS | FLAGS_SF_MMX, 0, nullptr}},
@@ -52,5 +54,8 @@ void InitializeDDDTables() {
   };
 
   GenerateTable(&DDDNowOps.at(0), DDDNowOpTable, std::size(DDDNowOpTable));
+  return DDDNowOps;
 }
+
+constinit std::array<X86InstInfo, MAX_3DNOW_TABLE_SIZE> DDDNowOps = GenerateDDDTables();
 }
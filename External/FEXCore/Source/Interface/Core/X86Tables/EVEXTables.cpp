@@ -11,8 +11,10 @@ $end_info$
 namespace FEXCore::X86Tables {
 using namespace InstFlags;
 
-void InitializeEVEXTables() {
-  static constexpr U16U8InfoStruct EVEXTable[] = {
+static consteval std::array<X86InstInfo, MAX_EVEX_TABLE_SIZE> GenerateEVEXTables() {
+  std::array<X86InstInfo, MAX_EVEX_TABLE_SIZE> EVEXTableOps{};
+
+  constexpr U16U8InfoStruct EVEXTable[] = {
     {0x10, 1, X86InstInfo{"VMOVUPS",         TYPE_INST, FLAGS_MODRM | FLAGS_XMM_FLAGS, 0, nullptr}},
     {0x11, 1, X86InstInfo{"VMOVUPS",         TYPE_INST, FLAGS_MODRM | FLAGS_SF_MOD_DST | FLAGS_XMM_FLAGS, 0, nullptr}},
     {0x18, 1, X86InstInfo{"VBROADCASTSS",    TYPE_INST, FLAGS_MODRM | FLAGS_XMM_FLAGS, 0, nullptr}},
@@ -29,5 +31,8 @@ void InitializeEVEXTables() {
   };
 
   GenerateTable(&EVEXTableOps.at(0), EVEXTable, std::size(EVEXTable));
+  return EVEXTableOps;
 }
+
+constinit std::array<X86InstInfo, MAX_EVEX_TABLE_SIZE> EVEXTableOps = GenerateEVEXTables();
 }
@@ -8,6 +8,17 @@
 #if defined(GDB_SYMBOLS_ENABLED)
 
 #include <FEXCore/Debug/GDBReaderInterface.h>
+#include <FEXCore/Utils/Event.h>
+#include <FEXCore/Utils/Threads.h>
+#include <FEXCore/fextl/memory.h>
+#include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/unordered_map.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <unistd.h>
 
 extern "C" {
 enum jit_actions_t { JIT_NOACTION = 0, JIT_REGISTER_FN, JIT_UNREGISTER_FN };
@@ -40,6 +51,116 @@ void __attribute__((noinline)) __jit_debug_register_code() {
 }
 
 namespace FEXCore {
+namespace {
+// Blocks are handed to gdb in batches, every time this many are pending or the flush interval passes
+constexpr size_t BatchBlockCount = 256;
+constexpr auto BatchFlushInterval = std::chrono::milliseconds(50);
+
+struct PendingSymfile {
+  fextl::vector<blocks_t> Blocks;
+  fextl::vector<gdb_line_mapping> Lines;
+};
+
+struct RegistrationBatcher {
+  std::mutex Lock;
+  Event WorkAvailable;
+  // Pending blocks grouped by source file, each file becomes one symfile
+  fextl::unordered_map<fextl::string, PendingSymfile> Pending;
+  size_t PendingBlocks{};
+
+  fextl::unique_ptr<FEXCore::Threads::Thread> Worker;
+  pid_t WorkerPID{};
+};
+
+RegistrationBatcher Batcher;
+
+void RegisterSymfile(const fextl::string &Filename, PendingSymfile &Symfile) {
+  // gdb wants the line table ordered by address, blocks from different compiles interleave
+  std::sort(Symfile.Lines.begin(), Symfile.Lines.end(), [](const gdb_line_mapping &a, const gdb_line_mapping &b) {
+    return a.pc < b.pc;
+  });
+
+  size_t size = sizeof(info_t) + Symfile.Blocks.size() * sizeof(blocks_t) +
+                Symfile.Lines.size() * sizeof(gdb_line_mapping);
+
+  // Ownership passes to the jit descriptor list, gdb reads it for the rest of the process
+  auto mem = (uint8_t *)malloc(size);
+  auto base = mem;
+  info_t *info = (info_t *)mem;
+  mem += sizeof(info_t);
+
+  strncpy(info->filename, Filename.c_str(), 511);
+  info->filename[511] = 0;
+
+  info->nblocks = Symfile.Blocks.size();
+  info->blocks_ofs = mem - base;
+  memcpy(mem, Symfile.Blocks.data(), info->nblocks * sizeof(blocks_t));
+  mem += info->nblocks * sizeof(blocks_t);
+
+  info->nlines = Symfile.Lines.size();
+  info->lines_ofs = mem - base;
+  if (info->nlines) {
+    memcpy(mem, Symfile.Lines.data(), info->nlines * sizeof(gdb_line_mapping));
+  }
+
+  auto entry = new jit_code_entry{0, 0, 0, 0};
+
+  entry->symfile_addr = (const char *)info;
+  entry->symfile_size = size;
+
+  if (__jit_debug_descriptor.first_entry) {
+    __jit_debug_descriptor.relevant_entry->next_entry = entry;
+    entry->prev_entry = __jit_debug_descriptor.relevant_entry;
+  } else {
+    __jit_debug_descriptor.first_entry = entry;
+  }
+
+  __jit_debug_descriptor.relevant_entry = entry;
+  __jit_debug_descriptor.action_flag = JIT_REGISTER_FN;
+  __jit_debug_register_code();
+}
+
+void *RegistrationThread(void *) {
+  FEXCore::Threads::SetThreadName("FEX:GDBJIT");
+
+  while (true) {
+    Batcher.WorkAvailable.WaitFor(BatchFlushInterval);
+
+    decltype(Batcher.Pending) Work;
+    {
+      std::lock_guard lk(Batcher.Lock);
+      Work.swap(Batcher.Pending);
+      Batcher.PendingBlocks = 0;
+    }
+
+    // Only this thread touches the descriptor list, so the gdb breakpoint is hit from one place
+    for (auto &[Filename, Symfile] : Work) {
+      RegisterSymfile(Filename, Symfile);
+    }
+  }
+
+  return nullptr;
+}
+
+// Expects Batcher.Lock to be held
+void StartWorkerIfNeeded() {
+  // A forked child doesn't inherit the worker
+  const auto PID = ::getpid();
+  if (Batcher.Worker && Batcher.WorkerPID == PID) {
+    return;
+  }
+
+  if (Batcher.Worker) {
+    Batcher.Worker.release();
+  }
+
+  uint64_t OldMask = FEXCore::Threads::SetSignalMask(~0ULL);
+  Batcher.Worker = FEXCore::Threads::Thread::Create(RegistrationThread, nullptr);
+  FEXCore::Threads::SetSignalMask(OldMask);
+  Batcher.Worker->detach();
+  Batcher.WorkerPID = PID;
+}
+}
 
 void GDBJITRegister(FEXCore::IR::AOTIRCacheEntry *Entry, uintptr_t VAFileStart,
                     uint64_t GuestRIP, uintptr_t HostEntry,
@@ -54,64 +175,29 @@ void GDBJITRegister(FEXCore::IR::AOTIRCacheEntry *Entry, uintptr_t VAFileStart,
     auto SymName = HLE::SourcecodeSymbolMapping::SymName(
         Sym, Entry->Filename, HostEntry, FileOffset);
 
-    fextl::vector<gdb_line_mapping> Lines;
+    blocks_t Block{};
+    strncpy(Block.name, SymName.c_str(), 511);
+    Block.start = HostEntry;
+    Block.end = HostEntry + DebugData->HostCodeSize;
+
+    std::lock_guard lk(Batcher.Lock);
+    StartWorkerIfNeeded();
+
+    auto &Symfile = Batcher.Pending[map->SourceFile];
+    Symfile.Blocks.emplace_back(Block);
+
     for (const auto &GuestOpcode : DebugData->GuestOpcodes) {
       auto Line = map->FindLineMapping(GuestRIP + GuestOpcode.GuestEntryOffset -
                                        VAFileStart);
       if (Line) {
-        Lines.push_back(
+        Symfile.Lines.push_back(
             {Line->LineNumber, HostEntry + GuestOpcode.HostEntryOffset});
       }
     }
 
-    size_t size = sizeof(info_t) + 1 * sizeof(blocks_t) +
-                  Lines.size() * sizeof(gdb_line_mapping);
-
-    auto mem = (uint8_t *)malloc(size);
-    auto base = mem;
-    info_t *info = (info_t *)mem;
-    mem += sizeof(info_t);
-
-    strncpy(info->filename, map->SourceFile.c_str(), 511);
-
-    info->nblocks = 1;
-
-    auto blocks = (blocks_t *)mem;
-    info->blocks_ofs = mem - base;
-
-    mem += info->nblocks * sizeof(blocks_t);
-
-    for (int i = 0; i < info->nblocks; i++) {
-      strncpy(blocks[i].name, SymName.c_str(), 511);
-      blocks[i].start = HostEntry;
-      blocks[i].end = HostEntry + DebugData->HostCodeSize;
-    }
-
-    info->nlines = Lines.size();
-
-    auto lines = (gdb_line_mapping *)mem;
-    info->lines_ofs = mem - base;
-    mem += info->nlines * sizeof(gdb_line_mapping);
-
-    if (info->nlines) {
-      memcpy(lines, &Lines.at(0), info->nlines * sizeof(gdb_line_mapping));
-    }
-
-    auto entry = new jit_code_entry{0, 0, 0, 0};
-
-    entry->symfile_addr = (const char *)info;
-    entry->symfile_size = size;
-
-    if (__jit_debug_descriptor.first_entry) {
-      __jit_debug_descriptor.relevant_entry->next_entry = entry;
-      entry->prev_entry = __jit_debug_descriptor.relevant_entry;
-    } else {
-      __jit_debug_descriptor.first_entry = entry;
+    if (++Batcher.PendingBlocks >= BatchBlockCount) {
+      Batcher.WorkAvailable.NotifyOne();
     }
-
-    __jit_debug_descriptor.relevant_entry = entry;
-    __jit_debug_descriptor.action_flag = JIT_REGISTER_FN;
-    __jit_debug_register_code();
   }
 }
 } // namespace FEXCore
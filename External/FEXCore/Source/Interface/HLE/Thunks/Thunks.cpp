@@ -17,9 +17,14 @@ $end_info$
 #include <FEXCore/fextl/unordered_map.h>
 #include "Thunks.h"
 
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
 #ifndef _WIN32
 #include <dlfcn.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 #endif
 
 #include <Interface/Context/Context.h>
@@ -38,6 +43,8 @@ extern "C" {
 // Forward declare jemalloc functions because we can't include the headers from the glibc jemalloc project.
 // This is because we can't simultaneously set up include paths for both of our internal jemalloc modules.
 FEX_DEFAULT_VISIBILITY JEMALLOC_NOTHROW extern int glibc_je_is_known_allocation(void *ptr);
+FEX_DEFAULT_VISIBILITY JEMALLOC_NOTHROW extern void glibc_je_free(void *ptr);
+FEX_DEFAULT_VISIBILITY JEMALLOC_NOTHROW extern size_t glibc_je_malloc_usable_size(void *ptr);
 }
 #endif
 
@@ -80,6 +87,98 @@ namespace FEXCore {
 
   static thread_local FEXCore::Core::InternalThreadState *Thread;
 
+    // Same futex protocol as the thunk libraries' CrossArchEvent.
+    // Wait consumes a notification, a notification sent before the wait isn't lost.
+    static void WaitForCallbackEvent(std::atomic<uint32_t> *Futex) {
+      while (true) {
+        uint32_t One = 1;
+        if (Futex->compare_exchange_strong(One, 0)) {
+          return;
+        }
+
+        ::syscall(SYS_futex, Futex, FUTEX_WAIT | FUTEX_PRIVATE_FLAG, 0, nullptr, nullptr, 0);
+      }
+    }
+
+    static void NotifyCallbackEvent(std::atomic<uint32_t> *Futex) {
+      uint32_t Zero = 0;
+      if (Futex->compare_exchange_strong(Zero, 1)) {
+        ::syscall(SYS_futex, Futex, FUTEX_WAKE | FUTEX_PRIVATE_FLAG, 1, nullptr, nullptr, 0);
+      }
+    }
+
+    /**
+     * A guest thread parked in fex:callback_worker.
+     *
+     * Lives on the worker's host stack for as long as the process runs.
+     */
+    struct CallbackWorker {
+      std::atomic<uint32_t> WorkReady{};
+      std::atomic<uint32_t> WorkDone{};
+      uintptr_t GuestUnpacker{};
+      uintptr_t GuestTarget{};
+      void *ArgsRV{};
+    };
+
+    /**
+     * Guest callbacks invoked on host library threads that FEX doesn't know about.
+     *
+     * Those threads don't have any guest state to run the callback with, so the callback is handed to an idle
+     * worker and the host thread waits for it to finish. Workers are guest threads created by the guest
+     * side of a thunk library, so they already have their thread state, guest TLS and stack.
+     */
+    struct CallbackWorkerPool {
+      std::mutex Mutex;
+      std::condition_variable IdleCV;
+      fextl::vector<CallbackWorker*> Idle;
+      uint32_t Count{};
+      // Workers don't survive a fork
+      pid_t PID{};
+
+      void Add(CallbackWorker *Worker) {
+        {
+          std::lock_guard lk(Mutex);
+          if (PID != ::getpid()) {
+            Idle.clear();
+            Count = 0;
+            PID = ::getpid();
+          }
+          ++Count;
+          Idle.emplace_back(Worker);
+        }
+        IdleCV.notify_one();
+      }
+
+      void Run(uintptr_t GuestUnpacker, uintptr_t GuestTarget, void *ArgsRV) {
+        CallbackWorker *Worker{};
+        {
+          std::unique_lock lk(Mutex);
+          if (PID != ::getpid() || Count == 0) {
+            ERROR_AND_DIE_FMT("Thunks: Guest callback {:#x} called from a host thread without guest state and without callback workers", GuestTarget);
+          }
+
+          // Every worker is busy, usually with a callback from another host thread
+          IdleCV.wait(lk, [this] { return !Idle.empty(); });
+          Worker = Idle.back();
+          Idle.pop_back();
+        }
+
+        Worker->GuestUnpacker = GuestUnpacker;
+        Worker->GuestTarget = GuestTarget;
+        Worker->ArgsRV = ArgsRV;
+        NotifyCallbackEvent(&Worker->WorkReady);
+        WaitForCallbackEvent(&Worker->WorkDone);
+
+        {
+          std::lock_guard lk(Mutex);
+          Idle.emplace_back(Worker);
+        }
+        IdleCV.notify_one();
+      }
+    };
+
+    static CallbackWorkerPool CallbackWorkers;
+
 
     struct ExportEntry { uint8_t *sha256; ThunkedFunction* Fn; };
 
@@ -144,11 +243,26 @@ namespace FEXCore {
                 { 0xf5, 0x77, 0x68, 0x43, 0xbb, 0x6b, 0x28, 0x18, 0x40, 0xb0, 0xdb, 0x8a, 0x66, 0xfb, 0x0e, 0x2d, 0x98, 0xc2, 0xad, 0xe2, 0x5a, 0x18, 0x5a, 0x37, 0x2e, 0x13, 0xc9, 0xe7, 0xb9, 0x8c, 0xa9, 0x3e },
                 &IsHostHeapAllocation
             },
+            {
+                // sha256(fex:free_host_allocation)
+                { 0x98, 0x4c, 0xa6, 0xe5, 0x6f, 0x61, 0x31, 0xbc, 0x18, 0x96, 0xf0, 0xea, 0xed, 0x12, 0xf1, 0x7a, 0x19, 0x6d, 0xa3, 0x46, 0xce, 0xf3, 0x2f, 0xd7, 0xe6, 0xa5, 0xb9, 0x70, 0xb4, 0xd1, 0xb6, 0xe5 },
+                &FreeHostAllocation
+            },
+            {
+                // sha256(fex:host_allocation_size)
+                { 0x53, 0x0a, 0x53, 0x1b, 0x96, 0xc2, 0x77, 0x97, 0x3e, 0x76, 0xe3, 0xd8, 0x98, 0x8a, 0x37, 0x48, 0x10, 0xf9, 0x2f, 0x40, 0x71, 0xa7, 0x56, 0xb1, 0x0d, 0x1a, 0x88, 0x98, 0xd9, 0x72, 0xd5, 0x82 },
+                &HostAllocationSize
+            },
             {
                 // sha256(fex:link_address_to_function)
                 { 0xe6, 0xa8, 0xec, 0x1c, 0x7b, 0x74, 0x35, 0x27, 0xe9, 0x4f, 0x5b, 0x6e, 0x2d, 0xc9, 0xa0, 0x27, 0xd6, 0x1f, 0x2b, 0x87, 0x8f, 0x2d, 0x35, 0x50, 0xea, 0x16, 0xb8, 0xc4, 0x5e, 0x42, 0xfd, 0x77 },
                 &LinkAddressToGuestFunction
             },
+            {
+                // sha256(fex:callback_worker)
+                { 0xa3, 0x3c, 0xb9, 0x48, 0x89, 0x7e, 0x94, 0x23, 0x5a, 0x60, 0xe5, 0x51, 0xe9, 0x4c, 0xb9, 0xf0, 0xf0, 0x6c, 0x86, 0xae, 0xda, 0x8d, 0x62, 0xc1, 0x35, 0x85, 0xfd, 0x37, 0xa0, 0x72, 0x61, 0x5c },
+                &CallbackWorkerLoop
+            },
             {
                 // sha256(fex:allocate_host_trampoline_for_guest_function)
                 { 0x9b, 0xb2, 0xf4, 0xb4, 0x83, 0x7d, 0x28, 0x93, 0x40, 0xcb, 0xf4, 0x7a, 0x0b, 0x47, 0x85, 0x87, 0xf9, 0xbc, 0xb5, 0x27, 0xca, 0xa6, 0x93, 0xa5, 0xc0, 0x73, 0x27, 0x24, 0xae, 0xc8, 0xb8, 0x5a },
@@ -170,12 +284,36 @@ namespace FEXCore {
             Set arg0/1 to arg regs, use CTX::HandleCallback to handle the callback
         */
         static void CallCallback(void *callback, void *arg0, void* arg1) {
+          if (!Thread) {
+            // Host library thread, run it on a guest thread instead
+            CallbackWorkers.Run((uintptr_t)callback, (uintptr_t)arg0, arg1);
+            return;
+          }
+
           Thread->CurrentFrame->State.gregs[FEXCore::X86State::REG_RDI] = (uintptr_t)arg0;
           Thread->CurrentFrame->State.gregs[FEXCore::X86State::REG_RSI] = (uintptr_t)arg1;
 
           Thread->CTX->HandleCallback(Thread, (uintptr_t)callback);
         }
 
+        /**
+         * Parks the calling guest thread to run callbacks from host library threads, never returns.
+         *
+         * The callback runs nested in this thunk call on the worker's own guest stack,
+         * the same way as a callback made during any other thunk call.
+         */
+        static void CallbackWorkerLoop(void*) {
+          CallbackWorker Worker{};
+          CallbackWorkers.Add(&Worker);
+          LogMan::Msg::DFmt("Thunks: Thread {} is running host thread callbacks", Thread->ThreadManager.TID);
+
+          while (true) {
+            WaitForCallbackEvent(&Worker.WorkReady);
+            CallCallback((void*)Worker.GuestUnpacker, (void*)Worker.GuestTarget, Worker.ArgsRV);
+            NotifyCallbackEvent(&Worker.WorkDone);
+          }
+        }
+
         /**
          * Instructs the Core to redirect calls to functions at the given
          * address to another function. The original callee address is passed
@@ -277,6 +415,40 @@ namespace FEXCore {
 #endif
         }
 
+        /**
+         * Releases an allocation made on the host heap.
+         *
+         * Lets guest code take ownership of memory returned by host libraries
+         * without needing a library specific free function.
+         */
+        static void FreeHostAllocation(void* ArgsRV) {
+#ifdef ENABLE_JEMALLOC_GLIBC
+            struct ArgsRV_t {
+                void* ptr;
+            } *args = reinterpret_cast<ArgsRV_t*>(ArgsRV);
+
+            glibc_je_free(args->ptr);
+#else
+            ERROR_AND_DIE_FMT("Unsupported: Thunks freeing host heap allocations");
+#endif
+        }
+
+        /**
+         * Returns the usable size of an allocation made on the host heap.
+         */
+        static void HostAllocationSize(void* ArgsRV) {
+#ifdef ENABLE_JEMALLOC_GLIBC
+            struct ArgsRV_t {
+                void* ptr;
+                size_t rv;
+            } *args = reinterpret_cast<ArgsRV_t*>(ArgsRV);
+
+            args->rv = glibc_je_malloc_usable_size(args->ptr);
+#else
+            ERROR_AND_DIE_FMT("Unsupported: Thunks querying for host heap allocation information");
+#endif
+        }
+
         static void LoadLib(void *ArgsV) {
             auto CTX = static_cast<Context::ContextImpl*>(Thread->CTX);
 
@@ -1,23 +1,36 @@
 #include "FEXHeaderUtils/Filesystem.h"
 #include "Interface/Context/Context.h"
+#include "Interface/Core/ObjectCache/ObjectCacheService.h"
 #include "Interface/IR/AOTIR.h"
 
 #include <FEXCore/IR/IntrusiveIRList.h>
 #include <FEXCore/IR/RegisterAllocationData.h>
 #include <FEXCore/Utils/Allocator.h>
+#include <FEXCore/Utils/MathUtils.h>
 #include <FEXCore/HLE/SyscallHandler.h>
 #include <FEXCore/fextl/fmt.h>
 #include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/vector.h>
 
 #include <Interface/Core/LookupCache.h>
 #include <Interface/GDBJIT/GDBJIT.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <iterator>
 #include <mutex>
+#include <optional>
+#include <string_view>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 #include <xxhash.h>
+#ifndef _WIN32
+#include <elf.h>
+#endif
 
 
 namespace FEXCore::IR {
@@ -45,96 +58,226 @@ namespace FEXCore::IR {
     return nullptr;
   }
 
+  AOTIRHostCode *AOTIRInlineEntry::GetHostCode() {
+    return HostCodeSize ? (AOTIRHostCode *)InlineData : nullptr;
+  }
+
   IR::RegisterAllocationData *AOTIRInlineEntry::GetRAData() {
-    return (IR::RegisterAllocationData *)InlineData;
+    return (IR::RegisterAllocationData *)&InlineData[HostCodeSize];
   }
 
   IR::IRListView *AOTIRInlineEntry::GetIRData() {
     auto RAData = GetRAData();
-    auto Offset = RAData->Size(RAData->MapCount);
+    auto Offset = HostCodeSize + FEXCore::AlignUp(RAData->Size(RAData->MapCount), AOTIR_ENTRY_ALIGNMENT);
 
     return (IR::IRListView *)&InlineData[Offset];
   }
 
-  void AOTIRCaptureCacheEntry::AppendAOTIRCaptureCache(uint64_t GuestRIP, uint64_t Start, uint64_t Length, uint64_t Hash, FEXCore::IR::IRListView *IRList, FEXCore::IR::RegisterAllocationData *RAData) {
-    auto Inserted = Index.emplace(GuestRIP, Stream->Offset());
+  static void PadStream(FEXCore::Context::AOTIRWriter &Stream, size_t Alignment) {
+    static constexpr char Zero[AOTIR_INDEX_ALIGNMENT]{};
+    const auto Offset = Stream.Offset();
+    const auto Padding = FEXCore::AlignUp(Offset, Alignment) - Offset;
+    if (Padding) {
+      Stream.Write(Zero, Padding);
+    }
+  }
+
+  // Builds an entry in memory so it can be queued for the writeout thread
+  class AOTIRBufferWriter final : public FEXCore::Context::AOTIRWriter {
+    public:
+      explicit AOTIRBufferWriter(size_t Reserve) {
+        Buffer.reserve(Reserve);
+      }
+
+      void Write(const void* Data, size_t Size) override {
+        auto Bytes = reinterpret_cast<const uint8_t*>(Data);
+        Buffer.insert(Buffer.end(), Bytes, Bytes + Size);
+      }
+      size_t Offset() override {
+        return Buffer.size();
+      }
+      void Close() override {}
 
-    if (Inserted.second) {
-      //GuestHash
-      Stream->Write((const char*)&Hash, sizeof(Hash));
+      fextl::vector<uint8_t> Buffer;
+  };
 
-      //GuestLength
-      Stream->Write((const char*)&Length, sizeof(Length));
+  // Serializes an AOTIRInlineEntry, offsets are relative to the entry which is placed at AOTIR_ENTRY_ALIGNMENT in the file
+  static fextl::vector<uint8_t> SerializeEntry(uint64_t Hash, uint64_t Length, FEXCore::IR::IRListView *IRList, FEXCore::IR::RegisterAllocationData *RAData, const fextl::vector<char> &HostCode) {
+    AOTIRBufferWriter Stream {sizeof(AOTIRInlineEntry) + HostCode.size() + RAData->Size(RAData->MapCount) + IRList->GetInlineSize() + AOTIR_ENTRY_ALIGNMENT * 3};
 
-      RAData->Serialize(*Stream);
+    //GuestHash
+    Stream.Write((const char*)&Hash, sizeof(Hash));
 
-      // IRData (inline)
-      IRList->Serialize(*Stream);
+    //GuestLength
+    Stream.Write((const char*)&Length, sizeof(Length));
+
+    //HostCodeSize, the record is padded so RAData stays aligned
+    const uint64_t HostCodeSize = FEXCore::AlignUp(HostCode.size(), AOTIR_ENTRY_ALIGNMENT);
+    Stream.Write((const char*)&HostCodeSize, sizeof(HostCodeSize));
+    PadStream(Stream, AOTIR_ENTRY_ALIGNMENT);
+
+    if (HostCodeSize) {
+      Stream.Write(HostCode.data(), HostCode.size());
+      PadStream(Stream, AOTIR_ENTRY_ALIGNMENT);
     }
-  }
 
-  static bool readAll(int fd, void *data, size_t size) {
-    int rv = read(fd, data, size);
+    RAData->Serialize(Stream);
 
-    if (rv != size)
-      return false;
-    else
-      return true;
-  }
+    // IRData (inline), aligned so IRListView can be used directly from the mapping
+    PadStream(Stream, AOTIR_ENTRY_ALIGNMENT);
+    IRList->Serialize(Stream);
 
-  static bool LoadAOTIRCache(AOTIRCacheEntry *Entry, int streamfd) {
-#ifndef _WIN32
-    uint64_t tag;
+    return std::move(Stream.Buffer);
+  }
 
-    if (!readAll(streamfd, (char*)&tag, sizeof(tag)) || tag != FEXCore::IR::AOTIR_COOKIE)
-      return false;
+  void AOTIRCaptureCacheEntry::AppendAOTIRCaptureCache(uint64_t GuestRIP, const fextl::vector<uint8_t> &Entry) {
+    if (Index.contains(GuestRIP)) {
+      return;
+    }
 
-    fextl::string Module;
-    uint64_t ModSize;
-    uint64_t IndexSize;
+    // Blocks reached through different entry points, or identical code at different addresses, often serialize the same.
+    // A content hash collision can only point the index at an entry whose GuestHash then fails to match, so it's harmless.
+    const uint64_t ContentHash = XXH3_64bits(Entry.data(), Entry.size());
+    auto Existing = ContentIndex.find(ContentHash);
+    if (Existing != ContentIndex.end()) {
+      Index.emplace(GuestRIP, Existing->second);
+      return;
+    }
 
-    lseek(streamfd, -sizeof(ModSize), SEEK_END);
+    PadStream(*Stream, AOTIR_ENTRY_ALIGNMENT);
+    const uint64_t Offset = Stream->Offset();
+    Stream->Write(Entry.data(), Entry.size());
 
-    if (!readAll(streamfd,  (char*)&ModSize, sizeof(ModSize)))
-      return false;
+    Index.emplace(GuestRIP, Offset);
+    ContentIndex.emplace(ContentHash, Offset);
+  }
 
-    Module.resize(ModSize);
+  // Every host feature that can change codegen, packed so struct padding never ends up in the key
+  static uint64_t GetHostFeaturesHash(const FEXCore::HostFeatures &Features) {
+    const bool Flags[] = {
+      Features.SupportsAES, Features.SupportsCRC, Features.SupportsCLZERO, Features.SupportsAtomics,
+      Features.SupportsRCPC, Features.SupportsTSOImm9, Features.SupportsRAND, Features.Supports3DNow,
+      Features.SupportsSSE4A, Features.SupportsAVX, Features.SupportsSVE, Features.SupportsSVE256,
+      Features.SupportsSVE2, Features.SupportsSVEBitPerm, Features.SupportsSHA, Features.SupportsBMI1,
+      Features.SupportsBMI2, Features.SupportsCLWB, Features.SupportsPMULL_128Bit, Features.SupportsCSSC,
+      Features.SupportsMOPS, Features.SupportsWFEEventStream, Features.SupportsFlushInputsToZero, Features.SupportsFloatExceptions,
+    };
+
+    uint64_t Data[3] { Features.DCacheLineSize, Features.ICacheLineSize, 0 };
+    for (size_t i = 0; i < std::size(Flags); ++i) {
+      Data[2] |= uint64_t{Flags[i]} << i;
+    }
+    return XXH3_64bits(Data, sizeof(Data));
+  }
 
-    lseek(streamfd, -sizeof(ModSize) - ModSize, SEEK_END);
+  /**
+   * @brief Builds the AOTIRHostCode record for a freshly compiled block
+   *
+   * @return An empty vector if the block has relocations the loader can't apply
+   */
+  static fextl::vector<char> SerializeHostCode(uint64_t Key, uint64_t GuestBase, const CPU::CPUBackend::CompiledCode &Code,
+                                               const fextl::vector<FEXCore::CPU::Relocation> &Relocations,
+                                               uint64_t GuestRIP, uint64_t StartAddr, uint64_t Length, uint64_t GuestHash) {
+    fextl::vector<char> PackedRelocations;
+    if (!CodeSerialize::PackRelocations(Relocations, PackedRelocations)) {
+      return {};
+    }
 
-    if (!readAll(streamfd,  (char*)&Module[0], Module.size()))
-      return false;
+    const AOTIRHostCode Header {
+      .Key = Key,
+      .GuestBase = GuestBase,
+    };
+
+    const CodeSerialize::CodeSerializationData Data {
+      .GuestRIPOffset = GuestRIP - GuestBase,
+      .GuestCodeOffset = StartAddr - GuestBase,
+      .GuestCodeLength = Length,
+      .GuestCodeHash = GuestHash,
+      .HostCodeLength = Code.Size,
+      .HostEntryOffset = static_cast<uint64_t>(Code.BlockEntry - Code.BlockBegin),
+      .HostCodeHash = XXH3_64bits(Code.BlockBegin, Code.Size),
+      .NumRelocations = Relocations.size(),
+      .RelocationsSize = PackedRelocations.size(),
+    };
+
+    // Zero initialized, so the padding after the host code is deterministic
+    fextl::vector<char> Record(sizeof(Header) + Data.GetRecordSize());
+    auto Ptr = Record.data();
+    memcpy(Ptr, &Header, sizeof(Header));
+    Ptr += sizeof(Header);
+    memcpy(Ptr, &Data, sizeof(Data));
+    Ptr += sizeof(Data);
+    memcpy(Ptr, Code.BlockBegin, Code.Size);
+    Ptr += FEXCore::AlignUp(Code.Size, 8);
+    memcpy(Ptr, PackedRelocations.data(), PackedRelocations.size());
+
+    return Record;
+  }
 
-    if (Entry->FileId != Module) {
-      return false;
+  // Checks a module file in memory, only returns the index if everything it points at stays inside of the file
+  static AOTIRInlineIndex *GetModuleIndex(const uint8_t *Base, size_t FileSize, std::string_view FileId) {
+    if (FileSize < sizeof(uint64_t) + sizeof(AOTIRFileTrailer))
+      return nullptr;
+
+    auto Trailer = reinterpret_cast<const AOTIRFileTrailer*>(Base + FileSize - sizeof(AOTIRFileTrailer));
+    const auto TrailerOffset = FileSize - sizeof(AOTIRFileTrailer);
+
+    const bool Valid =
+      *reinterpret_cast<const uint64_t*>(Base) == FEXCore::IR::AOTIR_COOKIE &&
+      Trailer->Cookie == FEXCore::IR::AOTIR_COOKIE &&
+      (Trailer->IndexOffset % AOTIR_INDEX_ALIGNMENT) == 0 &&
+      Trailer->IndexSize >= sizeof(AOTIRInlineIndex) &&
+      Trailer->IndexOffset + Trailer->IndexSize <= Trailer->ModuleOffset &&
+      Trailer->ModuleOffset + Trailer->ModuleSize <= TrailerOffset &&
+      std::string_view(reinterpret_cast<const char*>(Base + Trailer->ModuleOffset), Trailer->ModuleSize) == FileId;
+
+    if (!Valid) {
+      return nullptr;
     }
 
-    lseek(streamfd, -sizeof(ModSize) - ModSize - sizeof(IndexSize), SEEK_END);
+    auto Array = reinterpret_cast<AOTIRInlineIndex*>(const_cast<uint8_t*>(Base) + Trailer->IndexOffset);
+    if (Trailer->IndexSize != sizeof(AOTIRInlineIndex) + Array->Count * sizeof(AOTIRInlineIndexEntry)) {
+      return nullptr;
+    }
 
-    if (!readAll(streamfd,  (char*)&IndexSize, sizeof(IndexSize)))
-      return false;
+    return Array;
+  }
 
+  static bool LoadAOTIRCache(AOTIRCacheEntry *Entry, int streamfd) {
+#ifndef _WIN32
     struct stat fileinfo;
     if (fstat(streamfd, &fileinfo) < 0)
       return false;
-    size_t Size = (fileinfo.st_size + 4095) & ~4095;
 
-    size_t IndexOffset = fileinfo.st_size - IndexSize -sizeof(ModSize) - ModSize - sizeof(IndexSize);
+    const size_t FileSize = fileinfo.st_size;
+    if (FileSize < sizeof(uint64_t) + sizeof(AOTIRFileTrailer))
+      return false;
 
+    // Everything is read straight out of the mapping, the pages are shared with every other process mapping the same file
+    size_t Size = FEXCore::AlignUp(FileSize, AOTIR_INDEX_ALIGNMENT);
     void *FilePtr = FEXCore::Allocator::mmap(nullptr, Size, PROT_READ, MAP_SHARED, streamfd, 0);
 
     if (FilePtr == MAP_FAILED) {
       return false;
     }
 
-    auto Array = (AOTIRInlineIndex *)((char*)FilePtr + IndexOffset);
+    auto Base = reinterpret_cast<const uint8_t*>(FilePtr);
+    auto Array = GetModuleIndex(Base, FileSize, Entry->FileId);
+
+    if (!Array) {
+      FEXCore::Allocator::munmap(FilePtr, Size);
+      return false;
+    }
+
+    // Lookups binary search the index, lots of random access into the IR data afterwards
+    ::madvise(FilePtr, reinterpret_cast<const uint8_t*>(Array) - Base, MADV_RANDOM);
 
     LOGMAN_THROW_AA_FMT(Entry->Array == nullptr && Entry->FilePtr == nullptr, "Entry must not be initialized here");
     Entry->Array = Array;
     Entry->FilePtr = FilePtr;
     Entry->Size = Size;
 
-    LogMan::Msg::DFmt("AOTIR: Module {} has {} functions", Module, Array->Count);
+    LogMan::Msg::DFmt("AOTIR: Module {} has {} functions", Entry->FileId, Array->Count);
 
     return true;
 #else
@@ -142,8 +285,17 @@ namespace FEXCore::IR {
 #endif
   }
 
+  AOTIRCaptureCache::~AOTIRCaptureCache() {
+    StopWriteoutThread();
+  }
+
   void AOTIRCaptureCache::FinalizeAOTIRCache() {
-    AOTIRCaptureCacheWriteoutQueue_Flush();
+    StopWriteoutThread();
+
+    if (WriteoutWorker && WriteoutPID != ::getpid()) {
+      // Forked child, the files belong to the parent
+      return;
+    }
 
     std::unique_lock lk(AOTIRCacheLock);
 
@@ -152,36 +304,40 @@ namespace FEXCore::IR {
         continue;
       }
 
-      const auto ModSize = String.size();
       auto &stream = Entry.Stream;
+      AOTIRFileTrailer Trailer{};
 
-      // pad to 32 bytes
-      constexpr char Zero = 0;
-      while(stream->Offset() & 31)
-        stream->Write(&Zero, 1);
+      // The index gets its own pages
+      PadStream(*stream, AOTIR_INDEX_ALIGNMENT);
+      Trailer.IndexOffset = stream->Offset();
 
       // AOTIRInlineIndex
-      const auto FnCount = Entry.Index.size();
-      const size_t DataBase = -stream->Offset();
+      const uint64_t FnCount = Entry.Index.size();
+      const uint64_t DataBase = -Trailer.IndexOffset;
 
       stream->Write((const char*)&FnCount, sizeof(FnCount));
       stream->Write((const char*)&DataBase, sizeof(DataBase));
 
+      // fextl::map is ordered, so the index is written sorted by GuestStart for the in place binary search
       for (const auto& [GuestStart, DataOffset] : Entry.Index) {
-        //AOTIRInlineIndexEntry
+        const AOTIRInlineIndexEntry IndexEntry {
+          .GuestStart = GuestStart,
+          .DataOffset = DataOffset,
+        };
+        stream->Write((const char*)&IndexEntry, sizeof(IndexEntry));
+      }
 
-        // GuestStart
-        stream->Write((const char*)&GuestStart, sizeof(GuestStart));
+      Trailer.IndexSize = stream->Offset() - Trailer.IndexOffset;
 
-        // DataOffset
-        stream->Write((const char*)&DataOffset, sizeof(DataOffset));
-      }
+      // Module ID
+      Trailer.ModuleOffset = stream->Offset();
+      Trailer.ModuleSize = String.size();
+      stream->Write(String.c_str(), Trailer.ModuleSize);
 
-      // End of file header
-      const auto IndexSize = FnCount * sizeof(FEXCore::IR::AOTIRInlineIndexEntry) + sizeof(DataBase) + sizeof(FnCount);
-      stream->Write((const char*)&IndexSize, sizeof(IndexSize));
-      stream->Write(String.c_str(), ModSize);
-      stream->Write((const char*)&ModSize, sizeof(ModSize));
+      // End of file trailer
+      PadStream(*stream, alignof(AOTIRFileTrailer));
+      Trailer.Cookie = FEXCore::IR::AOTIR_COOKIE;
+      stream->Write((const char*)&Trailer, sizeof(Trailer));
 
       // Close the stream
       stream->Close();
@@ -191,57 +347,85 @@ namespace FEXCore::IR {
     }
   }
 
-  void AOTIRCaptureCache::AOTIRCaptureCacheWriteoutQueue_Flush() {
-    {
-      std::shared_lock lk{AOTIRCaptureCacheWriteoutLock};
-      if (AOTIRCaptureCacheWriteoutQueue.size() == 0) {
-        AOTIRCaptureCacheWriteoutFlusing.store(false);
-        return;
-      }
-    }
+  static void* WriteoutThreadHandler(void *Arg) {
+    reinterpret_cast<AOTIRCaptureCache*>(Arg)->WriteoutThread();
+    return nullptr;
+  }
+
+  void AOTIRCaptureCache::WriteoutThread() {
+    std::unique_lock lk{AOTIRCaptureCacheWriteoutLock};
 
     for (;;) {
-      // This code is tricky to refactor so it doesn't allocate memory through glibc.
-      // The moved std::function object deallocates memory at the end of scope.
-      FEXCore::Allocator::YesIKnowImNotSupposedToUseTheGlibcAllocator glibc;
+      WriteoutWork.wait(lk, [this] { return WriteoutShutdown || !AOTIRCaptureCacheWriteoutQueue.empty(); });
+
+      // Shutdown only stops the thread once everything queued is written
+      if (AOTIRCaptureCacheWriteoutQueue.empty()) {
+        return;
+      }
 
-      AOTIRCaptureCacheWriteoutLock.lock();
-      WriteOutFn fn = std::move(AOTIRCaptureCacheWriteoutQueue.front());
-      bool MaybeEmpty = false;
+      auto Writeout = std::move(AOTIRCaptureCacheWriteoutQueue.front());
       AOTIRCaptureCacheWriteoutQueue.pop();
-      MaybeEmpty = AOTIRCaptureCacheWriteoutQueue.size() == 0;
-      AOTIRCaptureCacheWriteoutLock.unlock();
-
-      fn();
-      if (MaybeEmpty) {
-        std::shared_lock lk{AOTIRCaptureCacheWriteoutLock};
-        if (AOTIRCaptureCacheWriteoutQueue.size() == 0) {
-          AOTIRCaptureCacheWriteoutFlusing.store(false);
-          return;
-        }
+      lk.unlock();
+
+      auto *AotFile = &AOTIRCaptureCacheMap[Writeout.FileId];
+
+      if (!AotFile->Stream) {
+        AotFile->Stream = AOTIRWriter(Writeout.FileId);
+        uint64_t tag = FEXCore::IR::AOTIR_COOKIE;
+        AotFile->Stream->Write(&tag, sizeof(tag));
       }
-    }
+      AotFile->AppendAOTIRCaptureCache(Writeout.GuestRIP, Writeout.Entry);
 
-    LOGMAN_MSG_A_FMT("Must never get here");
+      lk.lock();
+      PendingWriteoutBytes -= Writeout.Entry.size();
+      WriteoutSpace.notify_all();
+    }
   }
 
-  void AOTIRCaptureCache::AOTIRCaptureCacheWriteoutQueue_Append(const WriteOutFn &fn) {
-    bool Flush = false;
-
+  void AOTIRCaptureCache::StopWriteoutThread() {
     {
       std::unique_lock lk{AOTIRCaptureCacheWriteoutLock};
-      AOTIRCaptureCacheWriteoutQueue.push(fn);
-      if (AOTIRCaptureCacheWriteoutQueue.size() > 10000) {
-        Flush = true;
-      }
+      WriteoutShutdown = true;
     }
+    WriteoutWork.notify_all();
 
-    bool test_val = false;
-    if (Flush && AOTIRCaptureCacheWriteoutFlusing.compare_exchange_strong(test_val, true)) {
-      AOTIRCaptureCacheWriteoutQueue_Flush();
+    // The thread doesn't exist in a forked child
+    if (WriteoutWorker && WriteoutPID == ::getpid() && WriteoutWorker->joinable()) {
+      WriteoutWorker->join(nullptr);
     }
   }
 
+  void AOTIRCaptureCache::AOTIRCaptureCacheWriteoutQueue_Append(PendingWriteout &&Writeout) {
+    std::unique_lock lk{AOTIRCaptureCacheWriteoutLock};
+
+    if (WriteoutShutdown) {
+      return;
+    }
+
+    if (!WriteoutWorker) {
+      WriteoutPID = ::getpid();
+
+      // Signals are for the guest threads
+      uint64_t OldMask = FEXCore::Threads::SetSignalMask(~0ULL);
+      WriteoutWorker = FEXCore::Threads::Thread::Create(WriteoutThreadHandler, this);
+      FEXCore::Threads::SetSignalMask(OldMask);
+    }
+    else if (WriteoutPID != ::getpid()) {
+      // Forked child, the parent keeps capturing in to the same files
+      return;
+    }
+
+    // Blocks the compiling thread while the writeout thread catches up, rather than growing without bound
+    WriteoutSpace.wait(lk, [this] { return WriteoutShutdown || PendingWriteoutBytes < MAX_PENDING_WRITEOUT_BYTES; });
+    if (WriteoutShutdown) {
+      return;
+    }
+
+    PendingWriteoutBytes += Writeout.Entry.size();
+    AOTIRCaptureCacheWriteoutQueue.push(std::move(Writeout));
+    WriteoutWork.notify_one();
+  }
+
   void AOTIRCaptureCache::WriteFilesWithCode(const Context::AOTIRCodeFileWriterFn &Writer) {
     std::shared_lock lk(AOTIRCacheLock);
     for( const auto &Entry: AOTIRCache) {
@@ -259,7 +443,8 @@ namespace FEXCore::IR {
     if (AOTIRCacheEntry.Entry) {
       AOTIRCacheEntry.Entry->ContainsCode = true;
 
-      if (IRList == nullptr && CTX->Config.AOTIRLoad()) {
+      // Loaded IR has no block counter, with ProfileBlockExecution the block is generated again so it gets counted
+      if (IRList == nullptr && CTX->Config.AOTIRLoad() && !CTX->BlockProfile) {
         auto Mod = AOTIRCacheEntry.Entry->Array;
 
         if (Mod != nullptr)
@@ -274,7 +459,8 @@ namespace FEXCore::IR {
               Result.IRList = AOTEntry->GetIRData();
               //LogMan::Msg::DFmt("using {} + {:x} -> {:x}\n", file->second.fileid, AOTEntry->first, GuestRIP);
 
-              Result.RAData = AOTEntry->GetRAData()->CreateCopy();
+              // On disk RAData has IsShared set, so the deleter leaves the mapping alone
+              Result.RAData = FEXCore::IR::RegisterAllocationData::UniquePtr{AOTEntry->GetRAData()};
               Result.DebugData = new FEXCore::Core::DebugData();
               Result.StartAddr = MappedStart;
               Result.Length = AOTEntry->GuestLength;
@@ -292,16 +478,77 @@ namespace FEXCore::IR {
     return Result;
   }
 
+  void AOTIRCaptureCache::InitializeHostCode() {
+    // The object cache's config covers every option that changes codegen, the host features cover the rest
+    const auto Config = CodeSerialize::NamedRegionObjectHandler::GenerateSerializationConfig(CTX);
+    const uint64_t Data[] {
+      Config.Cookie,
+      CodeSerialize::CodeObjectSerializationConfig::GetHash(Config),
+      GetHostFeaturesHash(CTX->HostFeatures),
+    };
+
+    // 0 is reserved for disabled
+    HostCodeKey = std::max<uint64_t>(XXH3_64bits(Data, sizeof(Data)), 1);
+  }
+
+  AOTIRCaptureCache::RelocateHostCodeResult AOTIRCaptureCache::RelocateHostCode(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP) {
+    if (!HostCodeKey || !CTX->Config.AOTIRLoad()) {
+      return {};
+    }
+
+    auto AOTIRCacheEntry = CTX->SyscallHandler->LookupAOTIRCacheEntry(Thread, GuestRIP);
+    if (!AOTIRCacheEntry.Entry || !AOTIRCacheEntry.Entry->Array) {
+      return {};
+    }
+
+    auto AOTEntry = AOTIRCacheEntry.Entry->Array->Find(GuestRIP - AOTIRCacheEntry.VAFileStart);
+    auto HostCode = AOTEntry ? AOTEntry->GetHostCode() : nullptr;
+
+    // Different host or config, or the file is mapped somewhere else this time. The IR is still usable.
+    if (!HostCode || HostCode->Key != HostCodeKey || HostCode->GuestBase != AOTIRCacheEntry.VAFileStart) {
+      return {};
+    }
+
+    auto Data = reinterpret_cast<const CodeSerialize::CodeSerializationData*>(HostCode->InlineData);
+    const auto GuestCodeStart = AOTIRCacheEntry.VAFileStart + Data->GuestCodeOffset;
+    if (!CTX->ProtectCachedBlockRange(Thread, GuestRIP, GuestCodeStart, Data->GuestCodeLength, Data->GuestCodeHash)) {
+      return {};
+    }
+
+    AOTIRCacheEntry.Entry->ContainsCode = true;
+
+    const auto Code = reinterpret_cast<const char*>(Data + 1);
+    const CodeSerialize::CodeObjectFileSection Section {
+      .Serialized = true,
+      .Invalid = false,
+      .Data = Data,
+      .HostCode = Code,
+      .NumRelocations = Data->NumRelocations,
+      .Relocations = Code + FEXCore::AlignUp(Data->HostCodeLength, 8),
+    };
+
+    // Fails when a thunk the code calls isn't loaded in this process
+    return {
+      .Code = Thread->CPUBackend->RelocateJITObjectCode(GuestRIP, &Section),
+      .StartAddr = GuestCodeStart,
+      .Length = Data->GuestCodeLength,
+    };
+  }
+
   bool AOTIRCaptureCache::PostCompileCode(
     FEXCore::Core::InternalThreadState *Thread,
-    void* CodePtr,
+    const CPU::CPUBackend::CompiledCode &Code,
+    const fextl::vector<FEXCore::CPU::Relocation> *Relocations,
     uint64_t GuestRIP,
     uint64_t StartAddr,
     uint64_t Length,
     FEXCore::IR::RegisterAllocationData::UniquePtr RAData,
     FEXCore::IR::IRListView *IRList,
     FEXCore::Core::DebugData *DebugData,
-    bool GeneratedIR) {
+    bool GeneratedIR,
+    bool AllowCapture) {
+
+    void *CodePtr = Code.BlockEntry;
 
     // Both generated ir and LibraryJITName need a named region lookup
     if (GeneratedIR || CTX->Config.LibraryJITNaming() || CTX->Config.GDBSymbols()) {
@@ -318,40 +565,33 @@ namespace FEXCore::IR {
         }
 
         // Add to AOT cache if aot generation is enabled
-        if (GeneratedIR && RAData &&
+        if (GeneratedIR && AllowCapture && RAData &&
             (CTX->Config.AOTIRCapture() || CTX->Config.AOTIRGenerate())) {
 
           auto hash = XXH3_64bits((void*)StartAddr, Length);
 
-          auto LocalRIP = GuestRIP - AOTIRCacheEntry.VAFileStart;
-          auto LocalStartAddr = StartAddr - AOTIRCacheEntry.VAFileStart;
-          auto FileId = AOTIRCacheEntry.Entry->FileId;
-          // The underlying pointer and the unique_ptr deleter for RAData must
-          // be marshalled separately to the lambda below. Otherwise, the
-          // lambda can't be used as an std::function due to being non-copyable
-          auto RADataCopy = RAData->CreateCopy();
-          auto RADataCopyDeleter = RADataCopy.get_deleter();
-          auto IRListCopy = IRList->CreateCopy();
-
-          // The lambda is converted to std::function. This is tricky to refactor so it doesn't allocate memory through glibc.
-          FEXCore::Allocator::YesIKnowImNotSupposedToUseTheGlibcAllocator glibc;
-          AOTIRCaptureCacheWriteoutQueue_Append([this, LocalRIP, LocalStartAddr, Length, hash, IRListCopy, RADataCopy=RADataCopy.release(), RADataCopyDeleter, FileId]() {
-
-            // It is guaranteed via AOTIRCaptureCacheWriteoutLock and AOTIRCaptureCacheWriteoutFlusing that this will not run concurrently
-            // Memory coherency is guaranteed via AOTIRCaptureCacheWriteoutLock
-
-            auto *AotFile = &AOTIRCaptureCacheMap[FileId];
-
-            if (!AotFile->Stream) {
-              AotFile->Stream = AOTIRWriter(FileId);
-              uint64_t tag = FEXCore::IR::AOTIR_COOKIE;
-              AotFile->Stream->Write(&tag, sizeof(tag));
-            }
-            AotFile->AppendAOTIRCaptureCache(LocalRIP, LocalStartAddr, Length, hash, IRListCopy, RADataCopy);
-            RADataCopyDeleter(RADataCopy);
-            delete IRListCopy;
+          // Copied now, the JIT backpatches block links in to the live code once it runs
+          fextl::vector<char> HostCode;
+          if (HostCodeKey && Relocations) {
+            HostCode = SerializeHostCode(HostCodeKey, AOTIRCacheEntry.VAFileStart, Code, *Relocations, GuestRIP, StartAddr, Length, hash);
+          }
+
+          // Serialized straight from the live IR, the queue only holds the bytes that end up in the file
+          auto Entry = SerializeEntry(hash, Length, IRList, RAData.get(), HostCode);
+          const size_t EntrySize = Entry.size();
+
+          AOTIRCaptureCacheWriteoutQueue_Append(PendingWriteout {
+            .FileId = AOTIRCacheEntry.Entry->FileId,
+            .GuestRIP = GuestRIP - AOTIRCacheEntry.VAFileStart,
+            .Entry = std::move(Entry),
           });
 
+          if (Thread->AOTGenStats) {
+            Thread->AOTGenStats->Blocks.fetch_add(1, std::memory_order_relaxed);
+            Thread->AOTGenStats->GuestBytes.fetch_add(Length, std::memory_order_relaxed);
+            Thread->AOTGenStats->IRBytes.fetch_add(EntrySize, std::memory_order_relaxed);
+          }
+
           if (CTX->Config.AOTIRGenerate()) {
             // cleanup memory and early exit here -- we're not running the application
             Thread->CPUBackend->ClearCache();
@@ -362,8 +602,15 @@ namespace FEXCore::IR {
 
       // Insert to caches if we generated IR
       if (GeneratedIR) {
-        if (CTX->GetGdbServerStatus()) {
+        if (CTX->Config.RetainBlockIR) {
           // Add to thread local ir cache
+          // Shared data is either mapped from an AOT file or lives in the compile arena until the block is compiled, the debug store needs to own its copy
+          if (IRList->IsShared()) {
+            IRList = IRList->CreateCopy();
+          }
+          if (RAData && RAData->IsShared) {
+            RAData = RAData->CreateCopy();
+          }
           Core::LocalIREntry Entry = {StartAddr, Length, decltype(Entry.IR)(IRList), std::move(RAData), decltype(Entry.DebugData)(DebugData)};
 
           std::lock_guard<std::recursive_mutex> lk(Thread->LookupCache->WriteLock);
@@ -380,17 +627,125 @@ namespace FEXCore::IR {
     return false;
   }
 
+#ifndef _WIN32
+  template<typename Ehdr, typename Phdr, typename Nhdr>
+  static std::optional<uint64_t> GetELFBuildIDHash(int fd, const Ehdr &Header) {
+    for (size_t i = 0; i < Header.e_phnum; ++i) {
+      Phdr Program;
+      if (pread(fd, &Program, sizeof(Program), Header.e_phoff + i * Header.e_phentsize) != sizeof(Program)) {
+        return std::nullopt;
+      }
+
+      // Notes are tiny, anything large is not worth reading
+      if (Program.p_type != PT_NOTE || Program.p_filesz > 0x10000) {
+        continue;
+      }
+
+      fextl::vector<uint8_t> Notes(Program.p_filesz);
+      if (pread(fd, Notes.data(), Notes.size(), Program.p_offset) != static_cast<ssize_t>(Notes.size())) {
+        return std::nullopt;
+      }
+
+      for (size_t Offset = 0; Offset + sizeof(Nhdr) <= Notes.size();) {
+        Nhdr Note;
+        memcpy(&Note, &Notes[Offset], sizeof(Note));
+        const size_t NameOffset = Offset + sizeof(Nhdr);
+        const size_t DescOffset = NameOffset + FEXCore::AlignUp(Note.n_namesz, 4);
+        const size_t NextOffset = DescOffset + FEXCore::AlignUp(Note.n_descsz, 4);
+        if (DescOffset + Note.n_descsz > Notes.size()) {
+          break;
+        }
+
+        if (Note.n_type == NT_GNU_BUILD_ID && Note.n_namesz == sizeof(ELF_NOTE_GNU) &&
+            memcmp(&Notes[NameOffset], ELF_NOTE_GNU, sizeof(ELF_NOTE_GNU)) == 0) {
+          return XXH3_64bits(&Notes[DescOffset], Note.n_descsz);
+        }
+
+        Offset = NextOffset;
+      }
+    }
+
+    return std::nullopt;
+  }
+#endif
+
+  /**
+   * @brief Key identifying the contents of a file
+   *
+   * Uses the ELF build-id when there is one, so identifying a file costs a few small reads.
+   * Otherwise falls back to hashing the full file contents.
+   */
+  static uint64_t GetFileContentKey(const fextl::string &filename) {
+#ifndef _WIN32
+    int fd = open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+      return 0;
+    }
+
+    std::optional<uint64_t> Key{};
+    Elf64_Ehdr Header{};
+    if (pread(fd, &Header, sizeof(Header), 0) >= static_cast<ssize_t>(sizeof(Elf32_Ehdr)) &&
+        memcmp(Header.e_ident, ELFMAG, SELFMAG) == 0) {
+      if (Header.e_ident[EI_CLASS] == ELFCLASS64) {
+        Key = GetELFBuildIDHash<Elf64_Ehdr, Elf64_Phdr, Elf64_Nhdr>(fd, Header);
+      }
+      else if (Header.e_ident[EI_CLASS] == ELFCLASS32) {
+        Elf32_Ehdr Header32;
+        memcpy(&Header32, &Header, sizeof(Header32));
+        Key = GetELFBuildIDHash<Elf32_Ehdr, Elf32_Phdr, Elf32_Nhdr>(fd, Header32);
+      }
+    }
+
+    struct stat fileinfo;
+    if (!Key && fstat(fd, &fileinfo) == 0 && fileinfo.st_size > 0) {
+      void *FilePtr = FEXCore::Allocator::mmap(nullptr, fileinfo.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (FilePtr != MAP_FAILED) {
+        Key = XXH3_64bits(FilePtr, fileinfo.st_size);
+        FEXCore::Allocator::munmap(FilePtr, fileinfo.st_size);
+      }
+    }
+
+    close(fd);
+    return Key.value_or(0);
+#else
+    return 0;
+#endif
+  }
+
+  // Files from the rootfs are keyed by their path inside of it.
+  // A squashfs image gets a new mount point every time, caches generated against one mount need to match the next.
+  static uint64_t GetFilenameHash(std::string_view RootFS, std::string_view Filename) {
+    while (RootFS.ends_with('/')) {
+      RootFS.remove_suffix(1);
+    }
+    if (!RootFS.empty() && Filename.size() > RootFS.size() &&
+        Filename.starts_with(RootFS) && Filename[RootFS.size()] == '/') {
+      Filename.remove_prefix(RootFS.size());
+    }
+
+    return XXH3_64bits(Filename.data(), Filename.size());
+  }
+
   AOTIRCacheEntry *AOTIRCaptureCache::LoadAOTIRCacheEntry(const fextl::string &filename) {
     fextl::string base_filename = FHU::Filesystem::GetFilename(filename);
 
     if (!base_filename.empty()) {
-      auto filename_hash = XXH3_64bits(filename.c_str(), filename.size());
+      auto filename_hash = GetFilenameHash(CTX->Config.RootFSPath(), filename);
 
-      auto fileid = fextl::fmt::format("{}-{}-{}{}{}{}",
+      // Keying on the file contents means an updated file gets a fresh cache instead of a stale one.
+      // Only worth the file reads when the AOT cache is in use.
+      const bool AOTIREnabled = CTX->Config.AOTIRLoad() || CTX->Config.AOTIRCapture() || CTX->Config.AOTIRGenerate();
+      const uint64_t content_key = AOTIREnabled ? GetFileContentKey(filename) : 0;
+
+      auto fileid = fextl::fmt::format("{}-{:016x}-{:016x}-{}{}{}{}{}{}",
         base_filename,
         filename_hash,
+        content_key,
         (CTX->Config.SMCChecks == FEXCore::Config::CONFIG_SMC_FULL) ? 'S' : 's',
         CTX->Config.TSOEnabled ? 'T' : 't',
+        // IR for hardware TSO has no TSO memory ops
+        CTX->IsHardwareTSOEnabled() ? 'H' : 'h',
+        CTX->Config.TSOFramePointerRelaxed ? 'F' : 'f',
         CTX->Config.ABILocalFlags ? 'L' : 'l',
         CTX->Config.ABINoPF ? 'p' : 'P');
 
@@ -401,7 +756,7 @@ namespace FEXCore::IR {
 
       LOGMAN_THROW_AA_FMT(Entry->Array == nullptr, "Duplicate LoadAOTIRCacheEntry");
 
-      if (CTX->Config.AOTIRLoad && AOTIRLoader) {
+      if (CTX->Config.AOTIRLoad && !LoadBundledModule(Entry) && AOTIRLoader) {
         auto streamfd = AOTIRLoader(fileid);
         if (streamfd != -1) {
           FEXCore::IR::LoadAOTIRCache(Entry, streamfd);
@@ -419,11 +774,220 @@ namespace FEXCore::IR {
     LOGMAN_THROW_AA_FMT(Entry != nullptr, "Removing not existing entry");
 
     if (Entry->Array) {
-      FEXCore::Allocator::munmap(Entry->FilePtr, Entry->Size);
+      // Bundled modules stay mapped with the rest of the bundle
+      if (Entry->FilePtr) {
+        FEXCore::Allocator::munmap(Entry->FilePtr, Entry->Size);
+      }
       Entry->Array = nullptr;
       Entry->FilePtr = nullptr;
       Entry->Size = 0;
     }
+#endif
+  }
+
+  fextl::string AOTIRCaptureCache::GetBundleId(const fextl::string &Filename) const {
+    return fextl::fmt::format("{}-{:016x}.bundle",
+      FHU::Filesystem::GetFilename(Filename),
+      GetFilenameHash(CTX->Config.RootFSPath(), Filename));
+  }
+
+  bool AOTIRCaptureCache::LoadBundledModule(AOTIRCacheEntry *Entry) {
+    auto Module = BundleModules.find(std::string_view(Entry->FileId));
+    if (Module == BundleModules.end()) {
+      return false;
+    }
+
+    auto Array = GetModuleIndex(BundlePtr + Module->second->Offset, Module->second->Size, Entry->FileId);
+    if (!Array) {
+      return false;
+    }
+
+    LOGMAN_THROW_AA_FMT(Entry->Array == nullptr && Entry->FilePtr == nullptr, "Entry must not be initialized here");
+    Entry->Array = Array;
+    Entry->FilePtr = nullptr;
+    Entry->Size = 0;
+
+    LogMan::Msg::DFmt("AOTIR: Module {} has {} functions in the bundle", Entry->FileId, Array->Count);
+
+    return true;
+  }
+
+  void AOTIRCaptureCache::LoadAOTIRBundle(const fextl::string &Filename) {
+#ifndef _WIN32
+    if (!AOTIRLoader || BundlePtr) {
+      return;
+    }
+
+    const auto BundleId = GetBundleId(Filename);
+    int streamfd = AOTIRLoader(BundleId);
+    if (streamfd == -1) {
+      return;
+    }
+
+    struct stat fileinfo;
+    if (fstat(streamfd, &fileinfo) < 0 ||
+        static_cast<size_t>(fileinfo.st_size) < sizeof(uint64_t) + sizeof(AOTIRBundleTrailer)) {
+      close(streamfd);
+      return;
+    }
+
+    const size_t FileSize = fileinfo.st_size;
+    const size_t Size = FEXCore::AlignUp(FileSize, AOTIR_INDEX_ALIGNMENT);
+    void *FilePtr = FEXCore::Allocator::mmap(nullptr, Size, PROT_READ, MAP_SHARED, streamfd, 0);
+    close(streamfd);
+
+    if (FilePtr == MAP_FAILED) {
+      return;
+    }
+
+    auto Base = reinterpret_cast<const uint8_t*>(FilePtr);
+    auto Trailer = reinterpret_cast<const AOTIRBundleTrailer*>(Base + FileSize - sizeof(AOTIRBundleTrailer));
+    const auto TrailerOffset = FileSize - sizeof(AOTIRBundleTrailer);
+
+    const bool Valid =
+      *reinterpret_cast<const uint64_t*>(Base) == FEXCore::IR::AOTIR_BUNDLE_COOKIE &&
+      Trailer->Cookie == FEXCore::IR::AOTIR_BUNDLE_COOKIE &&
+      (Trailer->ModulesOffset % alignof(AOTIRBundleModule)) == 0 &&
+      Trailer->ModulesOffset <= TrailerOffset &&
+      Trailer->ModuleCount <= (TrailerOffset - Trailer->ModulesOffset) / sizeof(AOTIRBundleModule);
+
+    if (!Valid) {
+      FEXCore::Allocator::munmap(FilePtr, Size);
+      return;
+    }
+
+    // Module files themselves are only checked once a library using them is mapped
+    auto Modules = reinterpret_cast<const AOTIRBundleModule*>(Base + Trailer->ModulesOffset);
+    for (size_t i = 0; i < Trailer->ModuleCount; ++i) {
+      const auto &Module = Modules[i];
+      if ((Module.Offset % AOTIR_INDEX_ALIGNMENT) != 0 ||
+          Module.Offset > TrailerOffset || Module.Size > TrailerOffset - Module.Offset ||
+          Module.ModuleIdOffset > TrailerOffset || Module.ModuleIdSize > TrailerOffset - Module.ModuleIdOffset) {
+        continue;
+      }
+
+      BundleModules.emplace(std::string_view(reinterpret_cast<const char*>(Base + Module.ModuleIdOffset), Module.ModuleIdSize), &Module);
+    }
+
+    // Lookups binary search each module's index, lots of random access into the IR data afterwards
+    ::madvise(FilePtr, Size, MADV_RANDOM);
+
+    BundlePtr = Base;
+
+    LogMan::Msg::DFmt("AOTIR: Bundle {} has {} modules", BundleId, BundleModules.size());
+#endif
+  }
+
+  void AOTIRCaptureCache::WriteAOTIRBundle(const fextl::string &Filename) {
+#ifndef _WIN32
+    if (!AOTIRLoader || !AOTIRWriter || !AOTIRRenamer) {
+      return;
+    }
+
+    if (WriteoutWorker && WriteoutPID != ::getpid()) {
+      // Forked child, the bundle belongs to the parent
+      return;
+    }
+
+    struct BundledFile {
+      std::string_view FileId;
+      const uint8_t *Data;
+      size_t Size;
+      void *Mapping;
+    };
+    fextl::vector<BundledFile> Files;
+
+    std::shared_lock lk(AOTIRCacheLock);
+
+    for (const auto &[FileId, Entry] : AOTIRCache) {
+      // The module's own file has everything this process captured, otherwise keep what the previous bundle had
+      BundledFile File { .FileId = FileId, .Data = nullptr, .Size = 0, .Mapping = MAP_FAILED };
+
+      int streamfd = AOTIRLoader(FileId);
+      if (streamfd != -1) {
+        struct stat fileinfo;
+        if (fstat(streamfd, &fileinfo) == 0 && fileinfo.st_size > 0) {
+          File.Size = fileinfo.st_size;
+          File.Mapping = FEXCore::Allocator::mmap(nullptr, File.Size, PROT_READ, MAP_SHARED, streamfd, 0);
+          if (File.Mapping != MAP_FAILED) {
+            File.Data = reinterpret_cast<const uint8_t*>(File.Mapping);
+          }
+        }
+        close(streamfd);
+      }
+
+      if (!File.Data) {
+        auto Module = BundleModules.find(std::string_view(FileId));
+        if (Module != BundleModules.end()) {
+          File.Data = BundlePtr + Module->second->Offset;
+          File.Size = Module->second->Size;
+        }
+      }
+
+      if (File.Data && GetModuleIndex(File.Data, File.Size, FileId)) {
+        Files.emplace_back(File);
+      }
+      else if (File.Mapping != MAP_FAILED) {
+        FEXCore::Allocator::munmap(File.Mapping, File.Size);
+      }
+    }
+
+    if (Files.empty()) {
+      return;
+    }
+
+    const auto BundleId = GetBundleId(Filename);
+    auto Stream = AOTIRWriter(BundleId);
+
+    const uint64_t Tag = FEXCore::IR::AOTIR_BUNDLE_COOKIE;
+    Stream->Write(&Tag, sizeof(Tag));
+
+    fextl::vector<AOTIRBundleModule> Modules;
+    Modules.reserve(Files.size());
+
+    // Module files keep their page alignment, so their index offsets work unchanged inside the bundle
+    for (const auto &File : Files) {
+      PadStream(*Stream, AOTIR_INDEX_ALIGNMENT);
+      Modules.push_back(AOTIRBundleModule {
+        .Offset = Stream->Offset(),
+        .Size = File.Size,
+        .ModuleIdOffset = 0,
+        .ModuleIdSize = File.FileId.size(),
+      });
+      Stream->Write(File.Data, File.Size);
+
+      if (File.Mapping != MAP_FAILED) {
+        FEXCore::Allocator::munmap(File.Mapping, File.Size);
+      }
+    }
+
+    PadStream(*Stream, alignof(AOTIRBundleModule));
+    AOTIRBundleTrailer Trailer {
+      .ModulesOffset = Stream->Offset(),
+      .ModuleCount = Modules.size(),
+      .Cookie = FEXCore::IR::AOTIR_BUNDLE_COOKIE,
+    };
+
+    // Module IDs are written right after the module table
+    uint64_t ModuleIdOffset = Trailer.ModulesOffset + Modules.size() * sizeof(AOTIRBundleModule);
+    for (auto &Module : Modules) {
+      Module.ModuleIdOffset = ModuleIdOffset;
+      ModuleIdOffset += Module.ModuleIdSize;
+    }
+
+    Stream->Write(Modules.data(), Modules.size() * sizeof(AOTIRBundleModule));
+    for (const auto &File : Files) {
+      Stream->Write(File.FileId.data(), File.FileId.size());
+    }
+
+    PadStream(*Stream, alignof(AOTIRBundleTrailer));
+    Stream->Write(&Trailer, sizeof(Trailer));
+    Stream->Close();
+
+    // Rename the file to atomically update the bundle with the temporary file
+    AOTIRRenamer(BundleId);
+
+    LogMan::Msg::IFmt("AOTIR: Bundled {} modules in to {}", Modules.size(), BundleId);
 #endif
   }
 }
@@ -2,16 +2,23 @@
 
 #include "FEXCore/IR/RegisterAllocationData.h"
 #include <FEXCore/Config/Config.h>
+#include <FEXCore/Core/CPUBackend.h>
 #include <FEXCore/fextl/map.h>
 #include <FEXCore/fextl/string.h>
 #include <FEXCore/fextl/queue.h>
 #include <FEXCore/fextl/unordered_map.h>
+#include <FEXCore/fextl/vector.h>
+#include <FEXCore/Utils/Threads.h>
 
 #include <atomic>
+#include <condition_variable>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <shared_mutex>
+#include <string_view>
+#include <sys/types.h>
 #include <FEXCore/HLE/SourcecodeResolver.h>
 
 namespace FEXCore::Core {
@@ -20,6 +27,9 @@ struct DebugData;
 namespace FEXCore::Context {
   class ContextImpl;
 }
+namespace FEXCore::CPU {
+  union Relocation;
+}
 
 namespace FEXCore::IR {
   class RegisterAllocationData;
@@ -40,16 +50,77 @@ namespace FEXCore::IR {
 
     return Cookie;
   };
-  constexpr static uint32_t AOTIR_VERSION = 0x0000'00004;
+  constexpr static uint32_t AOTIR_VERSION = 0x0000'00007;
   constexpr static uint64_t AOTIR_COOKIE = COOKIE_VERSION("FEXI", AOTIR_VERSION);
+  constexpr static uint64_t AOTIR_BUNDLE_COOKIE = COOKIE_VERSION("FEXB", AOTIR_VERSION);
+
+  // Files are mapped read-only and used in place, these keep everything naturally aligned.
+  // The index starts on its own page so lookups don't fault in IR pages.
+  constexpr static size_t AOTIR_ENTRY_ALIGNMENT = 16;
+  constexpr static size_t AOTIR_INDEX_ALIGNMENT = 4096;
+
+  /*
+   * File layout:
+   * - uint64_t Cookie
+   * - AOTIRInlineEntry[], each aligned to AOTIR_ENTRY_ALIGNMENT
+   * - AOTIRInlineIndex, aligned to AOTIR_INDEX_ALIGNMENT
+   * - Module ID string
+   * - AOTIRFileTrailer
+   */
+  struct AOTIRFileTrailer {
+    uint64_t IndexOffset;
+    uint64_t IndexSize;
+    uint64_t ModuleOffset;
+    uint64_t ModuleSize;
+    uint64_t Cookie;
+  };
+
+  /*
+   * Bundle layout, the module files of every library an application loads in one mapping:
+   * - uint64_t Cookie
+   * - Module files as above, each aligned to AOTIR_INDEX_ALIGNMENT so their offsets are unchanged
+   * - AOTIRBundleModule[]
+   * - Module ID strings
+   * - AOTIRBundleTrailer
+   */
+  struct AOTIRBundleModule {
+    uint64_t Offset;
+    uint64_t Size;
+    uint64_t ModuleIdOffset;
+    uint64_t ModuleIdSize;
+  };
+
+  struct AOTIRBundleTrailer {
+    uint64_t ModulesOffset;
+    uint64_t ModuleCount;
+    uint64_t Cookie;
+  };
+
+  /*
+   * Relocatable host code for an entry, only written with AOTIRHostCode.
+   * Followed by the same record the code object cache uses:
+   * - CodeSerialize::CodeSerializationData
+   * - Host code, padded to 8 bytes
+   * - Packed relocations
+   */
+  struct AOTIRHostCode {
+    // Code generation config and host features the code was compiled with
+    uint64_t Key;
+    // Guest address the file was mapped at, guest addresses are baked in to the host code
+    uint64_t GuestBase;
+    uint8_t InlineData[0];
+  };
 
   struct AOTIRInlineEntry {
     uint64_t GuestHash;
     uint64_t GuestLength;
+    // Size of the AOTIRHostCode record at the start of InlineData, 0 when the entry only has IR
+    uint64_t HostCodeSize;
 
-    /* RAData followed by IRData */
-    uint8_t InlineData[0];
+    /* Optional AOTIRHostCode, then RAData followed by IRData, each aligned to AOTIR_ENTRY_ALIGNMENT */
+    alignas(AOTIR_ENTRY_ALIGNMENT) uint8_t InlineData[0];
 
+    AOTIRHostCode *GetHostCode();
     IR::RegisterAllocationData *GetRAData();
     IR::IRListView *GetIRData();
   };
@@ -70,13 +141,18 @@ namespace FEXCore::IR {
 
   struct AOTIRCaptureCacheEntry {
     fextl::unique_ptr<FEXCore::Context::AOTIRWriter> Stream;
+    // Guest RIP to entry offset, written out as the index
     fextl::map<uint64_t, uint64_t> Index;
+    // Hash of a serialized entry to its offset, identical entries are only written once
+    fextl::unordered_map<uint64_t, uint64_t> ContentIndex;
 
-    void AppendAOTIRCaptureCache(uint64_t GuestRIP, uint64_t Start, uint64_t Length, uint64_t Hash, FEXCore::IR::IRListView *IRList, FEXCore::IR::RegisterAllocationData *RAData);
+    // Entry is a fully serialized AOTIRInlineEntry
+    void AppendAOTIRCaptureCache(uint64_t GuestRIP, const fextl::vector<uint8_t> &Entry);
   };
 
   struct AOTIRCacheEntry {
     AOTIRInlineIndex *Array;
+    // nullptr when the module is used from the application's bundle
     void *FilePtr;
     size_t Size;
     std::unique_ptr<FEXCore::HLE::SourcecodeMap> SourcecodeMap;
@@ -89,15 +165,15 @@ namespace FEXCore::IR {
 
   class AOTIRCaptureCache final {
     public:
-      using WriteOutFn = std::function<void()>;
-
       AOTIRCaptureCache(FEXCore::Context::ContextImpl *ctx) : CTX {ctx} {}
+      ~AOTIRCaptureCache();
 
       void FinalizeAOTIRCache();
-      void AOTIRCaptureCacheWriteoutQueue_Flush();
-      void AOTIRCaptureCacheWriteoutQueue_Append(const WriteOutFn &fn);
       void WriteFilesWithCode(const Context::AOTIRCodeFileWriterFn &Writer);
 
+      // Public for threading
+      void WriteoutThread();
+
       struct PreGenerateIRFetchResult {
         FEXCore::IR::IRListView *IRList {};
         FEXCore::IR::RegisterAllocationData::UniquePtr RAData {};
@@ -108,19 +184,59 @@ namespace FEXCore::IR {
       };
       [[nodiscard]] PreGenerateIRFetchResult PreGenerateIRFetch(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP, FEXCore::IR::IRListView *IRList);
 
+      /**
+       * @brief Computes the key host code is stored and loaded with, call once the CPUID and host features are set up
+       */
+      void InitializeHostCode();
+
+      struct RelocateHostCodeResult {
+        CPU::CPUBackend::CompiledCode Code {};
+        // Guest code range the host code was compiled from, registered and protected for SMC detection
+        uint64_t StartAddr {};
+        uint64_t Length {};
+      };
+
+      /**
+       * @brief Relocates an entry's AOT host code in to the thread's code buffer, CodeInvalidationMutex must be held
+       *
+       * @return The relocated code, `Code.BlockEntry` is nullptr if the entry has no usable host code
+       */
+      [[nodiscard]] RelocateHostCodeResult RelocateHostCode(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP);
+
       bool PostCompileCode(FEXCore::Core::InternalThreadState *Thread,
-        void* CodePtr,
+        const CPU::CPUBackend::CompiledCode &Code,
+        const fextl::vector<FEXCore::CPU::Relocation> *Relocations,
         uint64_t GuestRIP,
         uint64_t StartAddr,
         uint64_t Length,
         FEXCore::IR::RegisterAllocationData::UniquePtr RAData,
         FEXCore::IR::IRListView *IRList,
         FEXCore::Core::DebugData *DebugData,
-        bool GeneratedIR);
+        bool GeneratedIR,
+        bool AllowCapture = true);
 
       AOTIRCacheEntry *LoadAOTIRCacheEntry(const fextl::string &filename);
       void UnloadAOTIRCacheEntry(AOTIRCacheEntry *Entry);
 
+      /**
+       * @brief Maps the AOT IR bundle of an application, call before any cache entries are loaded
+       *
+       * Modules in the bundle are used before their own files are opened, so a process with a bundle does
+       * one open and mmap for every library it loads.
+       *
+       * @param Filename - Path of the application's main executable
+       */
+      void LoadAOTIRBundle(const fextl::string &Filename);
+
+      /**
+       * @brief Writes the caches of every module this process loaded in to the application's bundle
+       *
+       * Call after FinalizeAOTIRCache so modules captured by this process are complete.
+       *
+       * @param Filename - Path of the application's main executable
+       */
+      void WriteAOTIRBundle(const fextl::string &Filename);
+
       // Callbacks
       void SetAOTIRLoader(Context::AOTIRLoaderCBFn CacheReader) {
         AOTIRLoader = std::move(CacheReader);
@@ -137,14 +253,56 @@ namespace FEXCore::IR {
     private:
       FEXCore::Context::ContextImpl *CTX;
 
+      // Set by InitializeHostCode, 0 when AOT host code is disabled
+      uint64_t HostCodeKey{};
+
       std::shared_mutex AOTIRCacheLock;
-      std::shared_mutex AOTIRCaptureCacheWriteoutLock;
-      std::atomic<bool> AOTIRCaptureCacheWriteoutFlusing;
 
-      fextl::queue<WriteOutFn> AOTIRCaptureCacheWriteoutQueue;
+      /**
+       * @name Capture writeout
+       *
+       * Captured entries are serialized by the compiling thread and appended to their file by a writeout thread.
+       * AOTIRCaptureCacheMap is only used by the writeout thread until FinalizeAOTIRCache joins it.
+       * @{ */
+        // A serialized entry waiting to be written
+        struct PendingWriteout {
+          fextl::string FileId;
+          uint64_t GuestRIP;
+          fextl::vector<uint8_t> Entry;
+        };
+
+        // Compiling threads wait once this much is queued, so capture memory stays bounded however long it runs
+        constexpr static size_t MAX_PENDING_WRITEOUT_BYTES = 64 * 1024 * 1024;
+
+        void AOTIRCaptureCacheWriteoutQueue_Append(PendingWriteout &&Writeout);
+        void StopWriteoutThread();
+
+        std::mutex AOTIRCaptureCacheWriteoutLock;
+        std::condition_variable WriteoutWork;
+        std::condition_variable WriteoutSpace;
+        fextl::queue<PendingWriteout> AOTIRCaptureCacheWriteoutQueue;
+        size_t PendingWriteoutBytes{};
+        bool WriteoutShutdown{};
+        fextl::unique_ptr<FEXCore::Threads::Thread> WriteoutWorker;
+        // Process the writeout thread runs in, a forked child doesn't capture
+        pid_t WriteoutPID{};
+      /**  @} */
 
       FEXCore::IR::AOTCacheType AOTIRCache;
 
+      /**
+       * @name Application bundle
+       *
+       * Only written by LoadAOTIRBundle, before any guest code runs.
+       * Keys point in to the bundle mapping, which lives as long as the process.
+       * @{ */
+        const uint8_t *BundlePtr{};
+        fextl::unordered_map<std::string_view, const AOTIRBundleModule*> BundleModules;
+
+        [[nodiscard]] fextl::string GetBundleId(const fextl::string &Filename) const;
+        bool LoadBundledModule(AOTIRCacheEntry *Entry);
+      /**  @} */
+
       Context::AOTIRLoaderCBFn AOTIRLoader;
       Context::AOTIRWriterCBFn AOTIRWriter;
       Context::AOTIRRenamerCBFn AOTIRRenamer;
@@ -93,7 +93,7 @@ static void PrintArg(fextl::stringstream *out, [[maybe_unused]] IRListView const
   else if (Arg == GPRPairClass.Val)
     *out << "GPRPair";
   else
-    *out << "Unknown Registerclass " << Arg;
+    *out << "Unknown Registerclass " << static_cast<uint32_t>(Arg);
 }
 
 static void PrintArg(fextl::stringstream *out, IRListView const* IR, OrderedNodeWrapper Arg, IR::RegisterAllocationData *RAData) {
@@ -179,6 +179,7 @@ static void PrintArg(fextl::stringstream *out, [[maybe_unused]] IRListView const
     case FEXCore::IR::SyscallFlags::NOSYNCSTATEONENTRY: *out << "No Sync State on Entry"; break;
     case FEXCore::IR::SyscallFlags::NORETURN: *out << "No Return"; break;
     case FEXCore::IR::SyscallFlags::NOSIDEEFFECTS: *out << "No Side Effects"; break;
+    case FEXCore::IR::SyscallFlags::CACHEABLE: *out << "Cacheable"; break;
     default: *out << "<Unknown Round Type>"; break;
   }
 }
@@ -12,12 +12,37 @@ $end_info$
 #include "Interface/IR/Passes/RegisterAllocationPass.h"
 
 #include <FEXCore/Config/Config.h>
+#include <FEXCore/IR/IREmitter.h>
 #include <FEXCore/Utils/Profiler.h>
 
 namespace FEXCore::IR {
 class IREmitter;
 
 void PassManager::Finalize() {
+  InsertIRDumpers();
+
+  if (CompileProfile) {
+    PassStats.clear();
+    for (auto const &Pass : Passes) {
+      auto Name = Pass->GetName();
+      PassStats.emplace_back(CompileProfile->GetStat(CompileProfilePrefix + fextl::string(Name.empty() ? "Other" : Name)));
+    }
+#if defined(ASSERTIONS_ENABLED) && ASSERTIONS_ENABLED
+    ValidationStat = CompileProfile->GetStat(CompileProfilePrefix + "Validation");
+#endif
+  }
+}
+
+void PassManager::RegisterCompileStats(FEXCore::CompileStats *Stats, std::string_view Prefix) {
+  CompileProfile = Stats;
+  CompileProfilePrefix = Prefix;
+
+  if (HasPass("RA")) {
+    GetPass<IR::RegisterAllocationPass>("RA")->RegisterSpillStat(Stats->GetStat(CompileProfilePrefix + "RA SpillOne"));
+  }
+}
+
+void PassManager::InsertIRDumpers() {
   if (!PassManagerDumpIR()) {
     // Not configured to dump any IR, just return.
     return;
@@ -65,26 +90,75 @@ void PassManager::Finalize() {
   }
 }
 
+static bool NeedsVector256Split(FEXCore::Context::ContextImpl *ctx) {
+#if (_M_ARM_64 && JIT_ARM64) || defined(VIXL_SIMULATOR)
+  // The Arm64 JIT only has 128-bit vector registers without SVE256
+  return ctx->Config.Core == FEXCore::Config::CONFIG_IRJIT &&
+         ctx->HostFeatures.SupportsAVX && !ctx->HostFeatures.SupportsSVE256;
+#else
+  return false;
+#endif
+}
+
 void PassManager::AddDefaultPasses(FEXCore::Context::ContextImpl *ctx, bool InlineConstants, bool StaticRegisterAllocation) {
   FEX_CONFIG_OPT(DisablePasses, O0);
 
   if (!DisablePasses()) {
-    InsertPass(CreateContextLoadStoreElimination(ctx->HostFeatures.SupportsAVX));
+    InsertPass(CreateContextLoadStoreElimination(ctx->HostFeatures.SupportsAVX), "RCLSE");
 
     if (Is64BitMode()) {
       // This needs to run after RCLSE
       // This only matters for 64-bit code since these instructions don't exist in 32-bit
-      InsertPass(CreateLongDivideEliminationPass());
+      InsertPass(CreateLongDivideEliminationPass(), "LongDivideRemoval");
+    }
+
+    InsertPass(CreateDeadStoreElimination(ctx->HostFeatures.SupportsAVX), "DSE");
+    if (ctx->HostFeatures.SupportsAVX) {
+      InsertPass(CreateZeroUpperElimination(), "ZeroUpperElimination");
     }
+    InsertPass(CreatePassDeadCodeElimination(), "DCE");
+    // Needs RCLSE to have forwarded RSP through the block, and runs before AddressModeSelection folds the offsets
+    if (ctx->IsTieredCompilationEnabled() && ctx->Config.StackMemoryForwarding()) {
+      InsertPass(CreateStackMemoryForwarding(), "StackMemoryForwarding");
+    }
+    // Needs to run before ConstProp so it can inline the constant offsets
+    InsertPass(CreateAddressModeSelection(), "AddressModeSelection");
+
+    // Folded CPUID results are specific to this process and config, keep them out of IR and code that gets cached to disk
+    const bool PersistentCache = ctx->Config.AOTIRCapture() || ctx->Config.AOTIRGenerate() ||
+                                 ctx->Config.CacheObjectCodeCompilation() == FEXCore::Config::ConfigObjectCodeHandler::CONFIG_READWRITE;
+    if (!PersistentCache) {
+      // Needs to run after RCLSE so the function is visible as a constant, and before ConstProp so it can fold the result extraction
+      InsertPass(CreateCPUIDOptimization(&ctx->CPUID), "CPUIDOpt");
+    }
+    // Only the JITs zero extend 32-bit results, the interpreter leaves the upper half untouched
+    InsertPass(CreateConstProp(InlineConstants, ctx->HostFeatures.SupportsTSOImm9, InlineConstants), "ConstProp");
+    // Needs ConstProp to have folded the rounding modes
+    InsertPass(CreateRoundingModeElimination(), "RoundingModeElimination");
+
+    // With tiering only hot code reaches this pass manager, so the loop passes don't cost cold code anything
+    if (ctx->IsTieredCompilationEnabled() && ctx->Config.Multiblock()) {
+      InsertPass(CreateLoopOptimization(), "LoopOpt");
+    }
+
+    InsertPass(CreateDeadFlagCalculationEliminination(), "DFE");
 
-    InsertPass(CreateDeadStoreElimination(ctx->HostFeatures.SupportsAVX));
-    InsertPass(CreatePassDeadCodeElimination());
-    InsertPass(CreateConstProp(InlineConstants, ctx->HostFeatures.SupportsTSOImm9));
+    InsertPass(CreateSyscallOptimization(), "SyscallOpt");
+    InsertPass(CreatePassDeadCodeElimination(), "DCE");
 
-    ////// InsertPass(CreateDeadFlagCalculationEliminination());
+    // Needs the offsets inlined by ConstProp, and DCE to have removed the stack pointer updates between the stores
+    if (InlineConstants) {
+      InsertPass(CreateStorePairing(), "StorePairing");
+    }
+  }
 
-    InsertPass(CreateSyscallOptimization());
-    InsertPass(CreatePassDeadCodeElimination());
+  // Required for correctness, so this runs even without optimizations
+  if (NeedsVector256Split(ctx)) {
+    InsertPass(CreateSplitVector256(), "SplitVector256");
+    if (!DisablePasses()) {
+      // Halves that nothing reads, like the zeroed upper half of a 128-bit result
+      InsertPass(CreatePassDeadCodeElimination(), "DCE");
+    }
   }
 
   // If the IR is compacted post-RA then the node indexing gets messed up and the backend isn't able to find the register assigned to a node
@@ -92,6 +166,13 @@ void PassManager::AddDefaultPasses(FEXCore::Context::ContextImpl *ctx, bool Inli
   InsertPass(CreateIRCompaction(ctx->OpDispatcherAllocator), "Compaction");
 }
 
+void PassManager::AddMinimalPasses(FEXCore::Context::ContextImpl *ctx) {
+  if (NeedsVector256Split(ctx)) {
+    InsertPass(CreateSplitVector256(), "SplitVector256");
+  }
+  InsertPass(CreateIRCompaction(ctx->OpDispatcherAllocator), "Compaction");
+}
+
 void PassManager::AddDefaultValidationPasses() {
 #if defined(ASSERTIONS_ENABLED) && ASSERTIONS_ENABLED
   InsertValidationPass(Validation::CreatePhiValidation());
@@ -101,21 +182,92 @@ void PassManager::AddDefaultValidationPasses() {
 #endif
 }
 
-void PassManager::InsertRegisterAllocationPass(bool OptimizeSRA, bool SupportsAVX) {
-  InsertPass(IR::CreateRegisterAllocationPass(GetPass("Compaction"), OptimizeSRA, SupportsAVX), "RA");
+void PassManager::InsertRegisterAllocationPass(bool OptimizeSRA, bool SupportsAVX, bool LinearScan) {
+  InsertPass(IR::CreateRegisterAllocationPass(GetPass("Compaction"), OptimizeSRA, SupportsAVX, LinearScan), "RA");
+}
+
+static int64_t CountIROps(IREmitter *IREmit) {
+  auto IR = IREmit->ViewIR();
+  int64_t Count {};
+  for ([[maybe_unused]] auto Op : IR.GetAllCode()) {
+    ++Count;
+  }
+  return Count;
 }
 
-bool PassManager::Run(IREmitter *IREmit) {
+#if defined(ASSERTIONS_ENABLED) && ASSERTIONS_ENABLED
+bool PassManager::ShouldValidate(bool ForceValidation) {
+  if (ForceValidation) {
+    return true;
+  }
+
+  if (ValidationSampleRate() == 0) {
+    return false;
+  }
+
+  // Validation can cost more than the rest of the compile, sampling keeps assertion builds usable on large guests
+  if (++ValidationCounter < ValidationSampleRate()) {
+    return false;
+  }
+
+  ValidationCounter = 0;
+  return true;
+}
+#endif
+
+bool PassManager::RunWithCompileStats(IREmitter *IREmit, [[maybe_unused]] bool Validate) {
+  bool Changed = false;
+  int64_t Size = CountIROps(IREmit);
+
+  for (size_t i = 0; i < Passes.size(); ++i) {
+    {
+      FEXCore::ScopedCompileStat Scope(PassStats[i]);
+      // Only emits a trace marker when built with the profiler
+      FEXCORE_PROFILE_SCOPED(Passes[i]->GetName());
+      Changed |= Passes[i]->Run(IREmit);
+    }
+
+    // Counted outside of the timed scope, walking the IR isn't free
+    const int64_t NewSize = CountIROps(IREmit);
+    PassStats[i]->SizeDelta.fetch_add(NewSize - Size, std::memory_order_relaxed);
+    Size = NewSize;
+  }
+
+#if defined(ASSERTIONS_ENABLED) && ASSERTIONS_ENABLED
+  if (Validate) {
+    FEXCore::ScopedCompileStat Scope(ValidationStat);
+    for (auto const &Pass : ValidationPasses) {
+      Changed |= Pass->Run(IREmit);
+    }
+  }
+#endif
+
+  return Changed;
+}
+
+bool PassManager::Run(IREmitter *IREmit, bool ForceValidation) {
   FEXCORE_PROFILE_SCOPED("PassManager::Run");
 
+#if defined(ASSERTIONS_ENABLED) && ASSERTIONS_ENABLED
+  const bool Validate = !ValidationPasses.empty() && ShouldValidate(ForceValidation);
+#else
+  const bool Validate = false;
+#endif
+
+  if (!PassStats.empty()) {
+    return RunWithCompileStats(IREmit, Validate);
+  }
+
   bool Changed = false;
   for (auto const &Pass : Passes) {
     Changed |= Pass->Run(IREmit);
   }
 
 #if defined(ASSERTIONS_ENABLED) && ASSERTIONS_ENABLED
-  for (auto const &Pass : ValidationPasses) {
-    Changed |= Pass->Run(IREmit);
+  if (Validate) {
+    for (auto const &Pass : ValidationPasses) {
+      Changed |= Pass->Run(IREmit);
+    }
   }
 #endif
 
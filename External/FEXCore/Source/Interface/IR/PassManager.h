@@ -6,6 +6,8 @@ $end_info$
 
 #pragma once
 
+#include "Interface/Core/CompileStats.h"
+
 #include <FEXCore/Config/Config.h>
 #include <FEXCore/Utils/ThreadPoolAllocator.h>
 #include <FEXCore/fextl/memory.h>
@@ -14,6 +16,7 @@ $end_info$
 #include <FEXCore/fextl/vector.h>
 
 #include <functional>
+#include <string_view>
 #include <utility>
 
 namespace FEXCore::Context {
@@ -39,8 +42,15 @@ public:
     Manager = _Manager;
   }
 
+  std::string_view GetName() const {
+    return Name;
+  }
+
 protected:
+  friend class PassManager;
   PassManager *Manager;
+  // Name given when inserted in to the PassManager, used for lookup and compile statistics
+  fextl::string Name;
 };
 
 class PassManager final {
@@ -48,7 +58,10 @@ class PassManager final {
 public:
   void AddDefaultPasses(FEXCore::Context::ContextImpl *ctx, bool InlineConstants, bool StaticRegisterAllocation);
   void AddDefaultValidationPasses();
+  // Only the passes required for the backend to consume the IR, used for quickly compiled tier 0 blocks
+  void AddMinimalPasses(FEXCore::Context::ContextImpl *ctx);
   Pass* InsertPass(fextl::unique_ptr<Pass> Pass, fextl::string Name = "") {
+    Pass->Name = Name;
     auto PassPtr = InsertAt(Passes.end(), std::move(Pass))->get();
 
     if (!Name.empty()) {
@@ -57,9 +70,10 @@ public:
     return PassPtr;
   }
 
-  void InsertRegisterAllocationPass(bool OptimizeSRA, bool SupportsAVX);
+  void InsertRegisterAllocationPass(bool OptimizeSRA, bool SupportsAVX, bool LinearScan);
 
-  bool Run(IREmitter *IREmit);
+  // ForceValidation bypasses ValidationSampleRate for blocks that are more likely to hit bugs
+  bool Run(IREmitter *IREmit, bool ForceValidation = false);
 
   void RegisterExitHandler(ShouldExitHandler Handler) {
     ExitHandler = std::move(Handler);
@@ -82,6 +96,13 @@ public:
     SyscallHandler = Handler;
   }
 
+  /**
+   * @brief Times every pass in to Stats, each stat is named Prefix followed by the pass name
+   *
+   * Must be called before Finalize.
+   */
+  void RegisterCompileStats(FEXCore::CompileStats *Stats, std::string_view Prefix);
+
   void Finalize();
 
 protected:
@@ -97,10 +118,25 @@ private:
   PassArrayType Passes;
   fextl::unordered_map<fextl::string, Pass*> NameToPassMaping;
 
+  void InsertIRDumpers();
+
+  bool RunWithCompileStats(IREmitter *IREmit, bool Validate);
+  FEXCore::CompileStats *CompileProfile {};
+  fextl::string CompileProfilePrefix;
+  // Indexed in parallel with Passes once finalized, empty when compile stats are disabled
+  fextl::vector<FEXCore::CompileStats::Stat*> PassStats;
+#if defined(ASSERTIONS_ENABLED) && ASSERTIONS_ENABLED
+  FEXCore::CompileStats::Stat *ValidationStat {};
+#endif
+
 #if defined(ASSERTIONS_ENABLED) && ASSERTIONS_ENABLED
   fextl::vector<fextl::unique_ptr<Pass>> ValidationPasses;
+  // Blocks compiled since the last sampled validation, the PassManager is per thread
+  uint32_t ValidationCounter {};
+  bool ShouldValidate(bool ForceValidation);
   void InsertValidationPass(fextl::unique_ptr<Pass> Pass, fextl::string Name = "") {
     Pass->RegisterPassManager(this);
+    Pass->Name = Name;
     auto PassPtr = ValidationPasses.emplace_back(std::move(Pass)).get();
 
     if (!Name.empty()) {
@@ -111,6 +147,7 @@ private:
 
   FEX_CONFIG_OPT(Is64BitMode, IS64BIT_MODE);
   FEX_CONFIG_OPT(PassManagerDumpIR, PASSMANAGERDUMPIR);
+  FEX_CONFIG_OPT(ValidationSampleRate, VALIDATIONSAMPLERATE);
 };
 }
 
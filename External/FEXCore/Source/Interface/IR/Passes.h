@@ -2,6 +2,10 @@
 
 #include <FEXCore/fextl/memory.h>
 
+namespace FEXCore {
+class CPUIDEmu;
+}
+
 namespace FEXCore::Utils {
 class IntrusivePooledAllocator;
 }
@@ -11,17 +15,26 @@ class Pass;
 class RegisterAllocationPass;
 class RegisterAllocationData;
 
-fextl::unique_ptr<FEXCore::IR::Pass> CreateConstProp(bool InlineConstants, bool SupportsTSOImm9);
+fextl::unique_ptr<FEXCore::IR::Pass> CreateAddressModeSelection();
+fextl::unique_ptr<FEXCore::IR::Pass> CreateConstProp(bool InlineConstants, bool SupportsTSOImm9, bool ImplicitZeroExtend);
 fextl::unique_ptr<FEXCore::IR::Pass> CreateContextLoadStoreElimination(bool SupportsAVX);
 fextl::unique_ptr<FEXCore::IR::Pass> CreateSyscallOptimization();
+fextl::unique_ptr<FEXCore::IR::Pass> CreateCPUIDOptimization(FEXCore::CPUIDEmu *CPUID);
 fextl::unique_ptr<FEXCore::IR::Pass> CreateDeadFlagCalculationEliminination();
 fextl::unique_ptr<FEXCore::IR::Pass> CreateDeadStoreElimination(bool SupportsAVX);
 fextl::unique_ptr<FEXCore::IR::Pass> CreatePassDeadCodeElimination();
 fextl::unique_ptr<FEXCore::IR::Pass> CreateIRCompaction(FEXCore::Utils::IntrusivePooledAllocator &Allocator);
 fextl::unique_ptr<FEXCore::IR::RegisterAllocationPass> CreateRegisterAllocationPass(FEXCore::IR::Pass* CompactionPass,
                                                                                   bool OptimizeSRA,
-                                                                                  bool SupportsAVX);
+                                                                                  bool SupportsAVX,
+                                                                                  bool LinearScan);
 fextl::unique_ptr<FEXCore::IR::Pass> CreateLongDivideEliminationPass();
+fextl::unique_ptr<FEXCore::IR::Pass> CreateLoopOptimization();
+fextl::unique_ptr<FEXCore::IR::Pass> CreateRoundingModeElimination();
+fextl::unique_ptr<FEXCore::IR::Pass> CreateSplitVector256();
+fextl::unique_ptr<FEXCore::IR::Pass> CreateStackMemoryForwarding();
+fextl::unique_ptr<FEXCore::IR::Pass> CreateStorePairing();
+fextl::unique_ptr<FEXCore::IR::Pass> CreateZeroUpperElimination();
 
 namespace Validation {
 fextl::unique_ptr<FEXCore::IR::Pass> CreateIRValidation();
@@ -0,0 +1,296 @@
+/*
+$info$
+tags: ir|opts
+desc: Folds address arithmetic in to the addressing modes of memory ops
+$end_info$
+*/
+
+#include "Interface/IR/PassManager.h"
+
+#include <FEXCore/IR/IR.h>
+#include <FEXCore/IR/IREmitter.h>
+#include <FEXCore/IR/IntrusiveIRList.h>
+#include <FEXCore/Utils/Profiler.h>
+#include <FEXCore/fextl/unordered_set.h>
+
+#include <memory>
+#include <optional>
+#include <stdint.h>
+
+namespace FEXCore::IR {
+
+namespace {
+#if JIT_ARM64
+  // aarch64 can only scale the index register by the access size
+  bool IsMemoryScale(uint64_t Scale, uint8_t AccessSize) {
+    return Scale == AccessSize;
+  }
+#elif JIT_X86_64
+  bool IsMemoryScale(uint64_t Scale, uint8_t AccessSize) {
+    return Scale == 1 || Scale == 2 || Scale == 4 || Scale == 8;
+  }
+#else
+#error No addressing mode heuristics for this target
+#endif
+
+  struct IndexMode {
+    MemOffsetType OffsetType;
+    uint8_t OffsetScale;
+    OrderedNode *Index;
+  };
+
+#if defined(_M_ARM_64) // x86 can't sext or zext on mem ops
+  // (u32)Index or (s32)Index
+  std::optional<IndexMode> MatchExtendedIndex(IREmitter *IREmit, OrderedNodeWrapper Value, uint8_t Scale) {
+    auto Header = IREmit->GetOpHeader(Value);
+
+    if (Header->Op == OP_BFE) {
+      auto Bfe = Header->C<IROp_Bfe>();
+      if (Bfe->lsb == 0 && Bfe->Width == 32) {
+        return IndexMode{MEM_OFFSET_UXTW, Scale, IREmit->UnwrapNode(Header->Args[0])};
+      }
+    }
+    else if (Header->Op == OP_SBFE) {
+      auto Sbfe = Header->C<IROp_Sbfe>();
+      if (Sbfe->lsb == 0 && Sbfe->Width == 32) {
+        return IndexMode{MEM_OFFSET_SXTW, Scale, IREmit->UnwrapNode(Header->Args[0])};
+      }
+    }
+
+    return std::nullopt;
+  }
+#endif
+
+  // MUL(Index, Scale), LSHL(Index, log2(Scale)) or an extended index
+  std::optional<IndexMode> MatchIndex(IREmitter *IREmit, OrderedNodeWrapper Value, uint8_t AccessSize) {
+    auto Header = IREmit->GetOpHeader(Value);
+    if (Header->Size != 8) {
+      return std::nullopt;
+    }
+
+    uint64_t Scale{};
+    uint64_t Constant{};
+    if (Header->Op == OP_MUL && IREmit->IsValueConstant(Header->Args[1], &Constant)) {
+      Scale = Constant;
+    }
+    else if (Header->Op == OP_LSHL && IREmit->IsValueConstant(Header->Args[1], &Constant) && Constant < 64) {
+      Scale = 1ULL << Constant;
+    }
+
+    if (Scale) {
+      // A scale of one is a nop mul or shift and always fits
+      if (Scale != 1 && !IsMemoryScale(Scale, AccessSize)) {
+        return std::nullopt;
+      }
+
+#if defined(_M_ARM_64)
+      if (auto Extended = MatchExtendedIndex(IREmit, Header->Args[0], Scale)) {
+        return Extended;
+      }
+#endif
+      return IndexMode{MEM_OFFSET_SXTX, static_cast<uint8_t>(Scale), IREmit->UnwrapNode(Header->Args[0])};
+    }
+
+#if defined(_M_ARM_64)
+    return MatchExtendedIndex(IREmit, Value, 1);
+#else
+    return std::nullopt;
+#endif
+  }
+
+  // Bounds the walk, a run of PUSH/POP rarely moves the stack pointer more times than this
+  constexpr size_t MAX_DISPLACEMENT_DEPTH = 16;
+
+  struct DisplacementChain {
+    OrderedNode *Root;
+    int64_t Displacement;
+  };
+
+  // Nested constant Add/Sub, like the stack pointer through a run of PUSH/POP
+  std::optional<DisplacementChain> MatchDisplacementChain(IREmitter *IREmit, OrderedNodeWrapper Value, const fextl::unordered_set<OrderedNode*> &ChainedNodes) {
+    OrderedNode *Node = IREmit->UnwrapNode(Value);
+    int64_t Displacement{};
+    size_t Depth{};
+    bool SawSub{};
+
+    for (; Depth < MAX_DISPLACEMENT_DEPTH; ++Depth) {
+      auto Header = IREmit->GetOpHeader(IREmit->WrapNode(Node));
+      uint64_t Constant{};
+
+      if (Header->Size != 8) {
+        break;
+      }
+
+      if (Header->Op == OP_ADD && IREmit->IsValueConstant(Header->Args[1], &Constant)) {
+        Displacement += Constant;
+        Node = IREmit->UnwrapNode(Header->Args[0]);
+      }
+      else if (Header->Op == OP_SUB && IREmit->IsValueConstant(Header->Args[1], &Constant)) {
+        Displacement -= Constant;
+        Node = IREmit->UnwrapNode(Header->Args[0]);
+        SawSub = true;
+      }
+      else {
+        break;
+      }
+    }
+
+    // A single Add is already handled as a plain base + offset.
+    // A single Sub is only worth rebasing when the chain continues past it, like the first PUSH of a run.
+    // A lone PUSH would keep the incoming stack pointer live across the update and cost a register move.
+    if (Depth == 0 || (Depth == 1 && (!SawSub || !ChainedNodes.contains(IREmit->UnwrapNode(Value))))) {
+      return std::nullopt;
+    }
+
+    return DisplacementChain{Node, Displacement};
+  }
+}
+
+class AddressModeSelection final : public FEXCore::IR::Pass {
+public:
+  bool Run(IREmitter *IREmit) override;
+
+private:
+  template<typename T>
+  bool SelectAddressMode(IREmitter *IREmit, OrderedNode *CodeNode, T *Op);
+
+  // Nodes that are the base of a constant Add/Sub
+  fextl::unordered_set<OrderedNode*> ChainedNodes;
+};
+
+template<typename T>
+bool AddressModeSelection::SelectAddressMode(IREmitter *IREmit, OrderedNode *CodeNode, T *Op) {
+  if (!Op->Offset.IsInvalid()) {
+    // Already selected
+    return false;
+  }
+
+  auto AddressNode = IREmit->UnwrapNode(Op->Addr);
+  auto AddressHeader = IREmit->GetOpHeader(Op->Addr);
+  if ((AddressHeader->Op != OP_ADD && AddressHeader->Op != OP_SUB) || AddressHeader->Size != 8) {
+    return false;
+  }
+
+  const uint8_t AccessSize = Op->Header.Size;
+
+  auto SetAddressMode = [&](MemOffsetType OffsetType, uint8_t OffsetScale, OrderedNode *Base, OrderedNode *Offset) {
+    Op->OffsetType = OffsetType;
+    Op->OffsetScale = OffsetScale;
+    IREmit->ReplaceNodeArgument(CodeNode, Op->Addr_Index, Base); // Addr
+    IREmit->ReplaceNodeArgument(CodeNode, Op->Offset_Index, Offset); // Offset
+  };
+
+  // Root + Displacement, every access in a run of PUSH/POP shares the incoming stack pointer as its base.
+  // The intermediate stack pointers are left for ConstProp to collapse.
+  if (auto Chain = MatchDisplacementChain(IREmit, Op->Addr, ChainedNodes)) {
+    IREmit->SetWriteCursor(AddressNode);
+    SetAddressMode(MEM_OFFSET_SXTX, 1, Chain->Root, IREmit->_Constant(Chain->Displacement));
+    return true;
+  }
+
+  if (AddressHeader->Op != OP_ADD) {
+    return false;
+  }
+
+  // Base + Index
+  for (size_t i = 0; i < 2; ++i) {
+    if (auto Index = MatchIndex(IREmit, AddressHeader->Args[i], AccessSize)) {
+      SetAddressMode(Index->OffsetType, Index->OffsetScale, IREmit->UnwrapNode(AddressHeader->Args[i ^ 1]), Index->Index);
+      return true;
+    }
+  }
+
+  // (Base + Index) + Displacement, the common x86 SIB form.
+  // Moving the displacement on to the base lets the memory op do the scaling,
+  // which saves the separate shift and add when the address isn't used anywhere else.
+  for (size_t i = 0; i < 2; ++i) {
+    if (!IREmit->IsValueConstant(AddressHeader->Args[i ^ 1])) {
+      continue;
+    }
+
+    auto InnerNode = IREmit->UnwrapNode(AddressHeader->Args[i]);
+    auto InnerHeader = IREmit->GetOpHeader(AddressHeader->Args[i]);
+    if (InnerHeader->Op != OP_ADD || InnerHeader->Size != 8 ||
+        AddressNode->GetUses() != 1 || InnerNode->GetUses() != 1) {
+      break;
+    }
+
+    for (size_t j = 0; j < 2; ++j) {
+      if (auto Index = MatchIndex(IREmit, InnerHeader->Args[j], AccessSize)) {
+        // The address dominates the memory op so the new base goes right after it
+        IREmit->SetWriteCursor(AddressNode);
+        auto NewBase = IREmit->_Add(IREmit->UnwrapNode(InnerHeader->Args[j ^ 1]), IREmit->UnwrapNode(AddressHeader->Args[i ^ 1]));
+        SetAddressMode(Index->OffsetType, Index->OffsetScale, NewBase, Index->Index);
+        return true;
+      }
+    }
+    break;
+  }
+
+  // No match anywhere, just add. A constant offset gets inlined by ConstProp
+  SetAddressMode(MEM_OFFSET_SXTX, 1, IREmit->UnwrapNode(AddressHeader->Args[0]), IREmit->UnwrapNode(AddressHeader->Args[1]));
+  return true;
+}
+
+/**
+ * @brief This pass selects the addressing mode of memory ops
+ *
+ * The OpDispatcher lowers x86 ModRM/SIB addresses to plain IR arithmetic.
+ * Where the host can do the same work inside of the load or store
+ * the arithmetic is folded in to the op's Offset, OffsetType and OffsetScale.
+ * The original nodes are left for dead code elimination.
+ *
+ * This runs before ConstProp so constant offsets are still available for inlining.
+ */
+bool AddressModeSelection::Run(IREmitter *IREmit) {
+  FEXCORE_PROFILE_SCOPED("PassManager::AddressModeSelection");
+
+  bool Changed = false;
+  auto CurrentIR = IREmit->ViewIR();
+
+  ChainedNodes.clear();
+  for (auto [CodeNode, IROp] : CurrentIR.GetAllCode()) {
+    if ((IROp->Op == OP_ADD || IROp->Op == OP_SUB) && IROp->Size == 8 && IREmit->IsValueConstant(IROp->Args[1])) {
+      ChainedNodes.insert(IREmit->UnwrapNode(IROp->Args[0]));
+    }
+  }
+
+  for (auto [CodeNode, IROp] : CurrentIR.GetAllCode()) {
+    switch (IROp->Op) {
+      case OP_LOADMEM:
+        Changed |= SelectAddressMode(IREmit, CodeNode, IROp->CW<IR::IROp_LoadMem>());
+        break;
+      case OP_STOREMEM:
+        Changed |= SelectAddressMode(IREmit, CodeNode, IROp->CW<IR::IROp_StoreMem>());
+        break;
+      case OP_LOADMEMTSO: {
+        auto Op = IROp->CW<IR::IROp_LoadMemTSO>();
+        // TODO: LRCPC3 supports a vector unscaled offset like LRCPC2.
+        // Support once hardware is available to use this.
+        if (Op->Class == FEXCore::IR::FPRClass) {
+          Changed |= SelectAddressMode(IREmit, CodeNode, Op);
+        }
+        break;
+      }
+      case OP_STOREMEMTSO: {
+        auto Op = IROp->CW<IR::IROp_StoreMemTSO>();
+        // TODO: LRCPC3 supports a vector unscaled offset like LRCPC2.
+        // Support once hardware is available to use this.
+        if (Op->Class == FEXCore::IR::FPRClass) {
+          Changed |= SelectAddressMode(IREmit, CodeNode, Op);
+        }
+        break;
+      }
+      default:
+        break;
+    }
+  }
+
+  return Changed;
+}
+
+fextl::unique_ptr<FEXCore::IR::Pass> CreateAddressModeSelection() {
+  return fextl::make_unique<AddressModeSelection>();
+}
+
+}
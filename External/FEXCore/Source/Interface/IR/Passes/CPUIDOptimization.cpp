@@ -0,0 +1,92 @@
+/*
+$info$
+tags: ir|opts
+desc: Folds CPUID with a known function in to constants
+$end_info$
+*/
+
+#include "Interface/Core/CPUID.h"
+#include "Interface/IR/PassManager.h"
+
+#include <FEXCore/IR/IR.h>
+#include <FEXCore/IR/IREmitter.h>
+#include <FEXCore/IR/IntrusiveIRList.h>
+#include <FEXCore/Utils/Profiler.h>
+#include <FEXCore/fextl/unordered_map.h>
+
+#include <memory>
+#include <optional>
+#include <stdint.h>
+
+namespace FEXCore::IR {
+
+class CPUIDOptimization final : public FEXCore::IR::Pass {
+public:
+  explicit CPUIDOptimization(FEXCore::CPUIDEmu *CPUID)
+    : CPUID {CPUID} {}
+
+  bool Run(IREmitter *IREmit) override;
+
+private:
+  FEXCore::CPUIDEmu *CPUID;
+};
+
+bool CPUIDOptimization::Run(IREmitter *IREmit) {
+  FEXCORE_PROFILE_SCOPED("PassManager::CPUIDOpt");
+
+  bool Changed = false;
+  auto CurrentIR = IREmit->ViewIR();
+
+  // Folded CPUID nodes, the op itself is left for DCE once its extracts are replaced
+  fextl::unordered_map<uint32_t, FEXCore::CPUID::FunctionResults> Folded;
+
+  for (auto [CodeNode, IROp] : CurrentIR.GetAllCode()) {
+    if (IROp->Op == OP_CPUID) {
+      auto Op = IROp->C<IR::IROp_CPUID>();
+
+      uint64_t Function;
+      if (!IREmit->IsValueConstant(Op->Function, &Function)) {
+        continue;
+      }
+
+      // Most functions ignore the sub-leaf, so it only needs to be constant for the ones that use it
+      uint64_t Leaf;
+      std::optional<uint32_t> ConstantLeaf;
+      if (IREmit->IsValueConstant(Op->Leaf, &Leaf)) {
+        ConstantLeaf = Leaf;
+      }
+
+      if (!CPUID->IsConstantFunction(Function, ConstantLeaf)) {
+        continue;
+      }
+
+      Folded.emplace(CurrentIR.GetID(CodeNode).Value, CPUID->RunFunction(Function, ConstantLeaf.value_or(0)));
+    }
+    else if (IROp->Op == OP_EXTRACTELEMENTPAIR) {
+      auto Op = IROp->C<IR::IROp_ExtractElementPair>();
+
+      auto it = Folded.find(Op->Pair.ID().Value);
+      if (it == Folded.end()) {
+        continue;
+      }
+
+      // Pair layout matches the CPUID op, EAX:EBX in the lower element and ECX:EDX in the upper
+      const auto &Results = it->second;
+      const uint64_t Value = Op->Element == 0 ?
+        (Results.eax | (static_cast<uint64_t>(Results.ebx) << 32)) :
+        (Results.ecx | (static_cast<uint64_t>(Results.edx) << 32));
+
+      IREmit->SetWriteCursor(CodeNode);
+      IREmit->ReplaceAllUsesWith(CodeNode, IREmit->_Constant(Value));
+      Changed = true;
+    }
+  }
+
+  return Changed;
+}
+
+fextl::unique_ptr<FEXCore::IR::Pass> CreateCPUIDOptimization(FEXCore::CPUIDEmu *CPUID) {
+  return fextl::make_unique<CPUIDOptimization>(CPUID);
+}
+
+}
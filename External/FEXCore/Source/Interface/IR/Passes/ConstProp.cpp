@@ -1,7 +1,7 @@
 /*
 $info$
 tags: ir|opts
-desc: ConstProp, ZExt elim, addressgen coalesce, const pooling, fcmp reduction, const inlining
+desc: ConstProp, ZExt elim, known bits, const pooling, fcmp reduction, const inlining
 $end_info$
 */
 
@@ -29,7 +29,6 @@ $end_info$
 #include <cstdint>
 #include <memory>
 #include <string.h>
-#include <tuple>
 #include <utility>
 
 namespace FEXCore::IR {
@@ -51,16 +50,10 @@ uint64_t getMask(IROp_Header* Op) {
 //aarch64 heuristics
 static bool IsImmLogical(uint64_t imm, unsigned width) { if (width < 32) width = 32; return vixl::aarch64::Assembler::IsImmLogical(imm, width); }
 static bool IsImmAddSub(uint64_t imm) { return vixl::aarch64::Assembler::IsImmAddSub(imm); }
-static bool IsMemoryScale(uint64_t Scale, uint8_t AccessSize) {
-  return Scale  == AccessSize;
-}
 #elif JIT_X86_64
 // very lazy heuristics
 static bool IsImmLogical(uint64_t imm, unsigned width) { return imm < 0x8000'0000; }
 static bool IsImmAddSub(uint64_t imm) { return imm < 0x8000'0000; }
-static bool IsMemoryScale(uint64_t Scale, uint8_t AccessSize) {
-  return Scale  == 1 || Scale  == 2 || Scale  == 4 || Scale  == 8;
-}
 #else
 #error No inline constant heuristics for this target
 #endif
@@ -84,60 +77,6 @@ static bool IsTSOImm9(uint64_t imm) {
   }
 }
 
-static std::tuple<MemOffsetType, uint8_t, OrderedNode*, OrderedNode*> MemExtendedAddressing(IREmitter *IREmit, uint8_t AccessSize,  IROp_Header* AddressHeader) {
-  auto Src0Header = IREmit->GetOpHeader(AddressHeader->Args[0]);
-  if (Src0Header->Size == 8) {
-    //Try to optimize: Base + MUL(Offset, Scale)
-    if (Src0Header->Op == OP_MUL) {
-      uint64_t Scale;
-      if (IREmit->IsValueConstant(Src0Header->Args[1], &Scale)) {
-        if (IsMemoryScale(Scale, AccessSize)) {
-          // remove mul as it can be folded to the mem op
-          return { MEM_OFFSET_SXTX, (uint8_t)Scale, IREmit->UnwrapNode(AddressHeader->Args[1]), IREmit->UnwrapNode(Src0Header->Args[0]) };
-        } else if (Scale == 1) {
-          // remove nop mul
-          return { MEM_OFFSET_SXTX, 1, IREmit->UnwrapNode(AddressHeader->Args[1]), IREmit->UnwrapNode(Src0Header->Args[0]) };
-        }
-      }
-    }
-    //Try to optimize: Base + LSHL(Offset, Scale)
-    else if (Src0Header->Op == OP_LSHL) {
-      uint64_t Constant2;
-      if (IREmit->IsValueConstant(Src0Header->Args[1], &Constant2)) {
-        uint64_t Scale = 1<<Constant2;
-        if (IsMemoryScale(Scale, AccessSize)) {
-          // remove shift as it can be folded to the mem op
-          return { MEM_OFFSET_SXTX, Scale, IREmit->UnwrapNode(AddressHeader->Args[1]), IREmit->UnwrapNode(Src0Header->Args[0]) };
-        } else if (Scale == 1) {
-          // remove nop shift
-          return { MEM_OFFSET_SXTX, 1, IREmit->UnwrapNode(AddressHeader->Args[1]), IREmit->UnwrapNode(Src0Header->Args[0]) };
-        }
-      }
-    }
-#if defined(_M_ARM_64) // x86 can't sext or zext on mem ops
-    //Try to optimize: Base + (u32)Offset
-    else if (Src0Header->Op == OP_BFE) {
-      auto Bfe = Src0Header->C<IROp_Bfe>();
-      if (Bfe->lsb == 0 && Bfe->Width == 32) {
-        //todo: arm can also scale here
-        return { MEM_OFFSET_UXTW, 1, IREmit->UnwrapNode(AddressHeader->Args[1]), IREmit->UnwrapNode(Src0Header->Args[0]) };
-      }
-    }
-    //Try to optimize: Base + (s32)Offset
-    else if (Src0Header->Op == OP_SBFE) {
-      auto Sbfe = Src0Header->C<IROp_Sbfe>();
-      if (Sbfe->lsb == 0 && Sbfe->Width == 32) {
-        //todo: arm can also scale here
-        return { MEM_OFFSET_SXTW, 1, IREmit->UnwrapNode(AddressHeader->Args[1]), IREmit->UnwrapNode(Src0Header->Args[0]) };
-      }
-    }
-#endif
-  }
-
-  // no match anywhere, just add
-  return { MEM_OFFSET_SXTX, 1, IREmit->UnwrapNode(AddressHeader->Args[0]), IREmit->UnwrapNode(AddressHeader->Args[1]) };
-}
-
 static OrderedNodeWrapper RemoveUselessMasking(IREmitter *IREmit, OrderedNodeWrapper src, uint64_t mask) {
 #if 1 // HOTFIX: We need to clear up the meaning of opsize and dest size. See #594
   return src;
@@ -178,9 +117,10 @@ static bool IsBfeAlreadyDone(IREmitter *IREmit, OrderedNodeWrapper src, uint64_t
 
 class ConstProp final : public FEXCore::IR::Pass {
 public:
-  explicit ConstProp(bool DoInlineConstants, bool SupportsTSOImm9)
+  explicit ConstProp(bool DoInlineConstants, bool SupportsTSOImm9, bool ImplicitZeroExtend)
     : InlineConstants(DoInlineConstants)
-    , SupportsTSOImm9 {SupportsTSOImm9} { }
+    , SupportsTSOImm9 {SupportsTSOImm9}
+    , ImplicitZeroExtend {ImplicitZeroExtend} { }
 
   bool Run(IREmitter *IREmit) override;
 
@@ -193,8 +133,11 @@ private:
   void LoadMemStoreMemImmediatePooling(IREmitter *IREmit, const IRListView& CurrentIR);
   bool ZextAndMaskingElimination(IREmitter *IREmit, const IRListView& CurrentIR,
       OrderedNode* CodeNode, IROp_Header* IROp);
+  uint64_t GetKnownZeroBits(IREmitter *IREmit, OrderedNodeWrapper Value, uint32_t Depth = 6) const;
   bool ConstantPropagation(IREmitter *IREmit, const IRListView& CurrentIR,
       OrderedNode* CodeNode, IROp_Header* IROp);
+  bool ReassociateConstantOffset(IREmitter *IREmit, OrderedNode* CodeNode, IROp_Header* IROp);
+  bool RedundantStoreRegister(IREmitter *IREmit, OrderedNode* CodeNode, IROp_Header* IROp);
   bool ConstantInlining(IREmitter *IREmit, const IRListView& CurrentIR);
 
   fextl::unordered_map<uint64_t, OrderedNode*> ConstPool;
@@ -211,6 +154,8 @@ private:
     return Result.first->second;
   }
   bool SupportsTSOImm9{};
+  // 32-bit GPR results are written with 32-bit host instructions, which zero the upper half
+  bool ImplicitZeroExtend{};
 };
 
 bool ConstProp::HandleConstantPools(IREmitter *IREmit, const IRListView& CurrentIR) {
@@ -359,6 +304,103 @@ void ConstProp::LoadMemStoreMemImmediatePooling(IREmitter *IREmit, const IRListV
   }
 }
 
+static uint64_t GetBitMask(uint64_t Width) {
+  return Width >= 64 ? ~0ULL : ((1ULL << Width) - 1);
+}
+
+// Returns the bits that are known to be zero in the full 64-bit register holding the value
+uint64_t ConstProp::GetKnownZeroBits(IREmitter *IREmit, OrderedNodeWrapper Value, uint32_t Depth) const {
+  uint64_t Constant{};
+  if (IREmit->IsValueConstant(Value, &Constant)) {
+    return ~Constant;
+  }
+
+  if (Depth == 0) {
+    return 0;
+  }
+  --Depth;
+
+  auto IROp = IREmit->GetOpHeader(Value);
+  const uint8_t OpSize = IROp->Size;
+
+  // Bits only defined by the op size are trusted for 64-bit ops, or for 32-bit ops when the host zero extends them
+  const bool FullWidth = OpSize == 8 || (ImplicitZeroExtend && OpSize == 4);
+  const uint64_t SizeMask = GetBitMask(OpSize * 8);
+  const uint64_t Implicit = FullWidth ? ~SizeMask : 0;
+
+  switch (IROp->Op) {
+    case OP_LOADMEM:
+    case OP_LOADMEMTSO:
+    case OP_LOADCONTEXT: {
+      // GPR loads zero extend
+      const auto Class = IROp->Op == OP_LOADCONTEXT ? IROp->C<IROp_LoadContext>()->Class :
+                         IROp->Op == OP_LOADMEM ? IROp->C<IROp_LoadMem>()->Class :
+                                                  IROp->C<IROp_LoadMemTSO>()->Class;
+      if (Class == GPRClass && OpSize < 8) {
+        return ~SizeMask;
+      }
+      return 0;
+    }
+
+    case OP_BFE: {
+      auto Op = IROp->C<IROp_Bfe>();
+      const uint64_t FieldMask = GetBitMask(Op->Width);
+      return ~FieldMask | ((GetKnownZeroBits(IREmit, Op->Src, Depth) >> Op->lsb) & FieldMask);
+    }
+
+    case OP_AND:
+      if (!FullWidth) {
+        return 0;
+      }
+      return Implicit | GetKnownZeroBits(IREmit, IROp->Args[0], Depth) | GetKnownZeroBits(IREmit, IROp->Args[1], Depth);
+
+    case OP_OR:
+    case OP_XOR:
+      if (!FullWidth) {
+        return 0;
+      }
+      return Implicit | (GetKnownZeroBits(IREmit, IROp->Args[0], Depth) & GetKnownZeroBits(IREmit, IROp->Args[1], Depth));
+
+    case OP_LSHR: {
+      uint64_t Shift{};
+      if (!FullWidth || !IREmit->IsValueConstant(IROp->Args[1], &Shift)) {
+        return Implicit;
+      }
+      Shift &= OpSize * 8 - 1;
+      const uint64_t Src = GetKnownZeroBits(IREmit, IROp->Args[0], Depth) & SizeMask;
+      return Implicit | (SizeMask & ~(SizeMask >> Shift)) | (Src >> Shift);
+    }
+
+    case OP_LSHL: {
+      uint64_t Shift{};
+      if (!FullWidth || !IREmit->IsValueConstant(IROp->Args[1], &Shift)) {
+        return Implicit;
+      }
+      Shift &= OpSize * 8 - 1;
+      const uint64_t Src = GetKnownZeroBits(IREmit, IROp->Args[0], Depth);
+      return Implicit | (((Src << Shift) | GetBitMask(Shift)) & SizeMask);
+    }
+
+    case OP_SELECT:
+      if (OpSize != 8) {
+        return 0;
+      }
+      return GetKnownZeroBits(IREmit, IROp->Args[2], Depth) & GetKnownZeroBits(IREmit, IROp->Args[3], Depth);
+
+    case OP_ADD:
+    case OP_SUB:
+    case OP_NEG:
+    case OP_NOT:
+    case OP_MUL:
+    case OP_ASHR:
+    case OP_ROR:
+      return Implicit;
+
+    default:
+      return 0;
+  }
+}
+
 bool ConstProp::ZextAndMaskingElimination(IREmitter *IREmit, const IRListView& CurrentIR,
                                           OrderedNode* CodeNode, IROp_Header* IROp) {
   bool Changed = false;
@@ -403,6 +445,19 @@ bool ConstProp::ZextAndMaskingElimination(IREmitter *IREmit, const IRListView& C
           Changed = true;
         }
       }
+
+      // Masking off bits that are already known to be zero does nothing
+      if (IROp->Size == 8 || (ImplicitZeroExtend && IROp->Size == 4)) {
+        for (int i = 0; i < 2; i++) {
+          uint64_t imm{};
+          if (IREmit->IsValueConstant(IROp->Args[i^1], &imm) &&
+              (GetKnownZeroBits(IREmit, IROp->Args[i]) | (imm & getMask(IROp))) == ~0ULL) {
+            IREmit->ReplaceAllUsesWith(CodeNode, CurrentIR.GetNode(IROp->Args[i]));
+            Changed = true;
+            break;
+          }
+        }
+      }
       break;
     }
 
@@ -432,6 +487,13 @@ bool ConstProp::ZextAndMaskingElimination(IREmitter *IREmit, const IRListView& C
         }
       }
 
+      // Is everything outside of the field already known to be zero?
+      if (Op->lsb == 0 && (GetKnownZeroBits(IREmit, Op->Src) | GetBitMask(Op->Width)) == ~0ULL) {
+        IREmit->ReplaceAllUsesWith(CodeNode, CurrentIR.GetNode(Op->Src));
+        Changed = true;
+        break;
+      }
+
       // BFE does implicit masking, remove any masks leading to this, if possible
       uint64_t imm = 1ULL << (Op->Width-1);
       imm = (imm-1) *2 + 1;
@@ -449,6 +511,16 @@ bool ConstProp::ZextAndMaskingElimination(IREmitter *IREmit, const IRListView& C
     case OP_SBFE: {
       auto Op = IROp->C<IR::IROp_Sbfe>();
 
+      // With the sign bit and everything above it known to be zero the sign extension does nothing
+      if (Op->lsb == 0) {
+        const uint64_t Upper = ~GetBitMask(Op->Width - 1);
+        if ((GetKnownZeroBits(IREmit, Op->Src) & Upper) == Upper) {
+          IREmit->ReplaceAllUsesWith(CodeNode, CurrentIR.GetNode(Op->Src));
+          Changed = true;
+          break;
+        }
+      }
+
       // BFE does implicit masking
       uint64_t imm = 1ULL << (Op->Width-1);
       imm = (imm-1) *2 + 1;
@@ -463,6 +535,22 @@ bool ConstProp::ZextAndMaskingElimination(IREmitter *IREmit, const IRListView& C
       break;
     }
 
+    case OP_BFI: {
+      auto Op = IROp->C<IR::IROp_Bfi>();
+
+      // Inserting a value in to the bottom of a destination that has nothing else set is the value itself
+      if (Op->lsb == 0 && (IROp->Size == 8 || (ImplicitZeroExtend && IROp->Size == 4))) {
+        const uint64_t FieldMask = GetBitMask(Op->Width);
+        const uint64_t DestBits = ~FieldMask & getMask(IROp);
+        if ((GetKnownZeroBits(IREmit, Op->Dest) & DestBits) == DestBits &&
+            (GetKnownZeroBits(IREmit, Op->Src) | FieldMask) == ~0ULL) {
+          IREmit->ReplaceAllUsesWith(CodeNode, CurrentIR.GetNode(Op->Src));
+          Changed = true;
+        }
+      }
+      break;
+    }
+
     case OP_VFADD:
     case OP_VFSUB:
     case OP_VFMUL:
@@ -511,6 +599,86 @@ bool ConstProp::ZextAndMaskingElimination(IREmitter *IREmit, const IRListView& C
   return Changed;
 }
 
+// (x +- c1) +- c2 => x +- (c1 +- c2)
+// Runs of PUSH/POP move the stack pointer by a constant once per instruction, this leaves a single adjustment.
+// AddressModeSelection already moved the memory accesses off of the intermediate values so they become dead.
+bool ConstProp::ReassociateConstantOffset(IREmitter *IREmit, OrderedNode* CodeNode, IROp_Header* IROp) {
+  uint64_t Outer{};
+  uint64_t Inner{};
+  if (IROp->Size != 8 || !IREmit->IsValueConstant(IROp->Args[1], &Outer)) {
+    return false;
+  }
+
+  auto InnerHeader = IREmit->GetOpHeader(IROp->Args[0]);
+  if ((InnerHeader->Op != OP_ADD && InnerHeader->Op != OP_SUB) || InnerHeader->Size != 8 ||
+      !IREmit->IsValueConstant(InnerHeader->Args[1], &Inner)) {
+    return false;
+  }
+
+  auto Root = IREmit->UnwrapNode(InnerHeader->Args[0]);
+  if (IREmit->GetOpSize(Root) != 8) {
+    return false;
+  }
+
+  const int64_t Displacement = (IROp->Op == OP_ADD ? Outer : -Outer) + (InnerHeader->Op == OP_ADD ? Inner : -Inner);
+
+  // A balanced run of PUSH and POP leaves the stack pointer where it started
+  if (Displacement == 0) {
+    IREmit->ReplaceAllUsesWith(CodeNode, Root);
+    return true;
+  }
+
+  IREmit->SetWriteCursor(CodeNode);
+  OrderedNode *Result{};
+  if (Displacement < 0) {
+    Result = IREmit->_Sub(Root, IREmit->_Constant(-Displacement));
+  }
+  else {
+    Result = IREmit->_Add(Root, IREmit->_Constant(Displacement));
+  }
+  IREmit->ReplaceAllUsesWith(CodeNode, Result);
+  return true;
+}
+
+// StoreRegister of the value that was loaded from the same static register, like the stack pointer after a
+// balanced run of PUSH/POP. RA would otherwise move the loaded value out of the static register and back.
+bool ConstProp::RedundantStoreRegister(IREmitter *IREmit, OrderedNode* CodeNode, IROp_Header* IROp) {
+  auto Op = IROp->C<IR::IROp_StoreRegister>();
+  auto ValueHeader = IREmit->GetOpHeader(Op->Value);
+  if (ValueHeader->Op != OP_LOADREGISTER || ValueHeader->Size != IROp->Size) {
+    return false;
+  }
+
+  auto LoadOp = ValueHeader->C<IR::IROp_LoadRegister>();
+  if (LoadOp->Offset != Op->Offset || LoadOp->Class != Op->Class) {
+    return false;
+  }
+
+  // Nothing between the load and the store may have written the register
+  const auto End = IREmit->GetIterator(IREmit->WrapNode(CodeNode));
+  for (auto it = IREmit->GetIterator(Op->Value); it != End; ++it) {
+    auto [Node, Header] = *it;
+    switch (Header->Op) {
+      case OP_STOREREGISTER:
+        if (Header->C<IR::IROp_StoreRegister>()->Offset == Op->Offset) {
+          return false;
+        }
+        break;
+      case OP_ENDBLOCK:
+      case OP_SYSCALL:
+      case OP_INLINESYSCALL:
+      case OP_THUNK:
+      case OP_BREAK:
+        return false;
+      default:
+        break;
+    }
+  }
+
+  IREmit->Remove(CodeNode);
+  return true;
+}
+
 // constprop + some more per instruction logic
 bool ConstProp::ConstantPropagation(IREmitter *IREmit, const IRListView& CurrentIR,
                                     OrderedNode* CodeNode, IROp_Header* IROp) {
@@ -561,78 +729,6 @@ bool ConstProp::ConstantPropagation(IREmitter *IREmit, const IRListView& Current
     }
 */
 
-    case OP_LOADMEMTSO: {
-      auto Op = IROp->CW<IR::IROp_LoadMemTSO>();
-      auto AddressHeader = IREmit->GetOpHeader(Op->Addr);
-
-      if (Op->Class == FEXCore::IR::FPRClass && AddressHeader->Op == OP_ADD && AddressHeader->Size == 8) {
-        // TODO: LRCPC3 supports a vector unscaled offset like LRCPC2.
-        // Support once hardware is available to use this.
-        auto [OffsetType, OffsetScale, Arg0, Arg1] = MemExtendedAddressing(IREmit, IROp->Size, AddressHeader);
-
-        Op->OffsetType = OffsetType;
-        Op->OffsetScale = OffsetScale;
-        IREmit->ReplaceNodeArgument(CodeNode, Op->Addr_Index, Arg0); // Addr
-        IREmit->ReplaceNodeArgument(CodeNode, Op->Offset_Index, Arg1); // Offset
-
-        Changed = true;
-      }
-      break;
-    }
-
-    case OP_STOREMEMTSO: {
-      auto Op = IROp->CW<IR::IROp_StoreMemTSO>();
-      auto AddressHeader = IREmit->GetOpHeader(Op->Addr);
-
-      if (Op->Class == FEXCore::IR::FPRClass && AddressHeader->Op == OP_ADD && AddressHeader->Size == 8) {
-        // TODO: LRCPC3 supports a vector unscaled offset like LRCPC2.
-        // Support once hardware is available to use this.
-        auto [OffsetType, OffsetScale, Arg0, Arg1] = MemExtendedAddressing(IREmit, IROp->Size, AddressHeader);
-
-        Op->OffsetType = OffsetType;
-        Op->OffsetScale = OffsetScale;
-        IREmit->ReplaceNodeArgument(CodeNode, Op->Addr_Index, Arg0); // Addr
-        IREmit->ReplaceNodeArgument(CodeNode, Op->Offset_Index, Arg1); // Offset
-
-        Changed = true;
-      }
-      break;
-    }
-
-    case OP_LOADMEM: {
-      auto Op = IROp->CW<IR::IROp_LoadMem>();
-      auto AddressHeader = IREmit->GetOpHeader(Op->Addr);
-
-      if (AddressHeader->Op == OP_ADD && AddressHeader->Size == 8) {
-        auto [OffsetType, OffsetScale, Arg0, Arg1] = MemExtendedAddressing(IREmit, IROp->Size, AddressHeader);
-
-        Op->OffsetType = OffsetType;
-        Op->OffsetScale = OffsetScale;
-        IREmit->ReplaceNodeArgument(CodeNode, Op->Addr_Index, Arg0); // Addr
-        IREmit->ReplaceNodeArgument(CodeNode, Op->Offset_Index, Arg1); // Offset
-
-        Changed = true;
-      }
-      break;
-    }
-
-    case OP_STOREMEM: {
-      auto Op = IROp->CW<IR::IROp_StoreMem>();
-      auto AddressHeader = IREmit->GetOpHeader(Op->Addr);
-
-      if (AddressHeader->Op == OP_ADD && AddressHeader->Size == 8) {
-        auto [OffsetType, OffsetScale, Arg0, Arg1] = MemExtendedAddressing(IREmit, IROp->Size, AddressHeader);
-
-        Op->OffsetType = OffsetType;
-        Op->OffsetScale = OffsetScale;
-        IREmit->ReplaceNodeArgument(CodeNode, Op->Addr_Index, Arg0); // Addr
-        IREmit->ReplaceNodeArgument(CodeNode, Op->Offset_Index, Arg1); // Offset
-
-        Changed = true;
-      }
-      break;
-    }
-
     case OP_ADD: {
       auto Op = IROp->C<IR::IROp_Add>();
       uint64_t Constant1{};
@@ -644,8 +740,15 @@ bool ConstProp::ConstantPropagation(IREmitter *IREmit, const IRListView& Current
         IREmit->ReplaceWithConstant(CodeNode, NewConstant);
         Changed = true;
       }
+      else {
+        Changed |= ReassociateConstantOffset(IREmit, CodeNode, IROp);
+      }
     break;
     }
+    case OP_STOREREGISTER: {
+      Changed |= RedundantStoreRegister(IREmit, CodeNode, IROp);
+      break;
+    }
     case OP_SUB: {
       auto Op = IROp->C<IR::IROp_Sub>();
       uint64_t Constant1{};
@@ -657,6 +760,9 @@ bool ConstProp::ConstantPropagation(IREmitter *IREmit, const IRListView& Current
         IREmit->ReplaceWithConstant(CodeNode, NewConstant);
         Changed = true;
       }
+      else {
+        Changed |= ReassociateConstantOffset(IREmit, CodeNode, IROp);
+      }
     break;
     }
     case OP_AND: {
@@ -704,6 +810,33 @@ bool ConstProp::ConstantPropagation(IREmitter *IREmit, const IRListView& Current
       }
     break;
     }
+    case OP_ADDNZCV:
+    case OP_SUBNZCV: {
+      auto Op = IROp->C<IR::IROp_SubNZCV>();
+      static_assert(offsetof(IR::IROp_AddNZCV, Size) == offsetof(IR::IROp_SubNZCV, Size));
+      uint64_t Constant1{};
+      uint64_t Constant2{};
+
+      if (IREmit->IsValueConstant(Op->Header.Args[0], &Constant1) &&
+          IREmit->IsValueConstant(Op->Header.Args[1], &Constant2)) {
+        const uint64_t Mask = Op->Size == 8 ? ~0ULL : ((1ULL << (Op->Size * 8)) - 1);
+        const uint64_t SignBit = 1ULL << ((Op->Size * 8) - 1);
+        Constant1 &= Mask;
+        Constant2 &= Mask;
+
+        const bool IsSub = IROp->Op == OP_SUBNZCV;
+        const uint64_t Res = (IsSub ? Constant1 - Constant2 : Constant1 + Constant2) & Mask;
+        const bool C = IsSub ? Constant1 < Constant2 : Res < Constant1;
+        const bool V = IsSub ? ((Constant1 ^ Constant2) & (Constant1 ^ Res) & SignBit) :
+                               (~(Constant1 ^ Constant2) & (Constant1 ^ Res) & SignBit);
+        uint32_t NZCV = ((Res & SignBit) ? (1u << 31) : 0) | (Res == 0 ? (1u << 30) : 0) |
+                        (C ? (1u << 29) : 0) | (V ? (1u << 28) : 0);
+
+        IREmit->ReplaceWithConstant(CodeNode, NZCV);
+        Changed = true;
+      }
+    break;
+    }
     case OP_OR: {
       auto Op = IROp->CW<IR::IROp_Or>();
       uint64_t Constant1{};
@@ -1006,6 +1139,8 @@ bool ConstProp::ConstantInlining(IREmitter *IREmit, const IRListView& CurrentIR)
       }
       case OP_ADD:
       case OP_SUB:
+      case OP_ADDNZCV:
+      case OP_SUBNZCV:
       {
         auto Op = IROp->C<IR::IROp_Add>();
 
@@ -1068,8 +1203,11 @@ bool ConstProp::ConstantInlining(IREmitter *IREmit, const IRListView& CurrentIR)
         break;
       }
       case OP_EXITFUNCTION:
+      case OP_PUSHRETURNSTACK:
       {
+        // Both ops only have the guest RIP argument, the backend emits a linkable exit when it is constant
         auto Op = IROp->C<IR::IROp_ExitFunction>();
+        static_assert(offsetof(IR::IROp_ExitFunction, NewRIP) == offsetof(IR::IROp_PushReturnStack, ReturnRIP));
 
         uint64_t Constant{};
         if (IREmit->IsValueConstant(Op->NewRIP, &Constant)) {
@@ -1204,6 +1342,10 @@ bool ConstProp::Run(IREmitter *IREmit) {
     if (ZextAndMaskingElimination(IREmit, CurrentIR, CodeNode, IROp)) {
       Changed = true;
     }
+    // The node may have been replaced and removed above, removing it again would drop its argument uses twice
+    if (GetHasDest(IROp->Op) && CodeNode->GetUses() == 0 && !IR::HasSideEffects(IROp->Op)) {
+      continue;
+    }
     if (ConstantPropagation(IREmit, CurrentIR, CodeNode, IROp)) {
       Changed = true;
     }
@@ -1217,8 +1359,8 @@ bool ConstProp::Run(IREmitter *IREmit) {
   return Changed;
 }
 
-fextl::unique_ptr<FEXCore::IR::Pass> CreateConstProp(bool InlineConstants, bool SupportsTSOImm9) {
-  return fextl::make_unique<ConstProp>(InlineConstants, SupportsTSOImm9);
+fextl::unique_ptr<FEXCore::IR::Pass> CreateConstProp(bool InlineConstants, bool SupportsTSOImm9, bool ImplicitZeroExtend) {
+  return fextl::make_unique<ConstProp>(InlineConstants, SupportsTSOImm9, ImplicitZeroExtend);
 }
 
 }
@@ -8,6 +8,7 @@ $end_info$
 #include "Interface/IR/Passes.h"
 #include "Interface/IR/PassManager.h"
 #include <FEXCore/Core/CoreState.h>
+#include <FEXCore/Core/X86Enums.h>
 
 #include <FEXCore/IR/IR.h>
 #include <FEXCore/IR/IREmitter.h>
@@ -17,6 +18,7 @@ $end_info$
 #include <FEXCore/fextl/unordered_map.h>
 #include <FEXCore/fextl/vector.h>
 
+#include <algorithm>
 #include <array>
 #include <memory>
 #include <stddef.h>
@@ -73,6 +75,8 @@ namespace {
     FEXCore::IR::OrderedNode *ValueNode;
     ///< With a store access, the store node that is doing the operation.
     FEXCore::IR::OrderedNode *StoreNode;
+    ///< StoreNode lives in a predecessor and may be read on another path, so it must not be removed.
+    bool CrossBlock;
   };
 
   struct ContextInfo {
@@ -374,6 +378,7 @@ namespace {
       ContextClassification->at(Offset).AccessRegClass = FEXCore::IR::InvalidClass;
       ContextClassification->at(Offset).AccessOffset = 0;
       ContextClassification->at(Offset).StoreNode = nullptr;
+      ContextClassification->at(Offset).CrossBlock = false;
     };
     size_t Offset = 0;
     SetAccess(Offset++, ACCESS_NONE);
@@ -431,11 +436,38 @@ namespace {
     SetAccess(Offset++, ACCESS_INVALID);
   }
 
+  // Snapshot of one context member at a block exit
+  struct ContextMemberState {
+    LastAccessType Accessed;
+    FEXCore::IR::RegisterClassType AccessRegClass;
+    uint32_t AccessOffset;
+    uint8_t AccessSize;
+    FEXCore::IR::OrderedNode *ValueNode;
+    FEXCore::IR::OrderedNode *StoreNode;
+
+    bool operator==(const ContextMemberState &) const = default;
+  };
+
   struct BlockInfo {
     fextl::vector<FEXCore::IR::OrderedNode *> Predecessors;
     fextl::vector<FEXCore::IR::OrderedNode *> Successors;
-    ContextInfo IncomingClassifiedStruct;
-    ContextInfo OutgoingClassifiedStruct;
+    ///< Indexed like ContextInfo::ClassificationInfo, empty until the block has been visited.
+    fextl::vector<ContextMemberState> OutgoingState;
+  };
+
+  // Values forwarded across blocks can't be spilled by RA, this keeps register pressure in check.
+  constexpr size_t MAX_CROSS_BLOCK_VALUES = 8;
+
+  constexpr uint32_t RSP_OFFSET = offsetof(FEXCore::Core::CPUState, gregs[FEXCore::X86State::REG_RSP]);
+
+  ///< GPRs live in static registers and are accessed with LoadRegister/StoreRegister instead of the context.
+  ///< Only the stack pointer is forwarded, so a run of PUSH/POP becomes one chain of constant updates.
+  struct StackPointerState {
+    ///< The last value that was loaded or stored.
+    FEXCore::IR::OrderedNode *ValueNode;
+    ///< With a store, the StoreRegister that wrote ValueNode.
+    FEXCore::IR::OrderedNode *StoreNode;
+    uint8_t Size;
   };
 
 class RCLSE final : public FEXCore::IR::Pass {
@@ -458,6 +490,10 @@ private:
   ContextMemberInfo *RecordAccess(ContextInfo *ClassifiedInfo, FEXCore::IR::RegisterClassType RegClass, uint32_t Offset, uint8_t Size, LastAccessType AccessType, FEXCore::IR::OrderedNode *Node, FEXCore::IR::OrderedNode *StoreNode = nullptr);
   void CalculateControlFlowInfo(FEXCore::IR::IREmitter *IREmit);
 
+  // Cross block state
+  void SaveBlockExitState(FEXCore::IR::NodeID BlockID, ContextInfo *ClassifiedInfo);
+  void LoadBlockEntryState(FEXCore::IR::IRListView *IR, FEXCore::IR::NodeID BlockID, ContextInfo *ClassifiedInfo);
+
   // Block local Passes
   bool RedundantStoreLoadElimination(FEXCore::IR::IREmitter *IREmit);
 };
@@ -483,8 +519,10 @@ ContextMemberInfo *RCLSE::RecordAccess(ContextMemberInfo *Info, FEXCore::IR::Reg
   Info->AccessOffset = Offset;
   Info->AccessSize = Size;
   Info->ValueNode = ValueNode;
-  if (StoreNode != nullptr)
+  if (StoreNode != nullptr) {
     Info->StoreNode = StoreNode;
+    Info->CrossBlock = false;
+  }
   return Info;
 }
 
@@ -544,6 +582,75 @@ void RCLSE::CalculateControlFlowInfo(FEXCore::IR::IREmitter *IREmit) {
   }
 }
 
+void RCLSE::SaveBlockExitState(FEXCore::IR::NodeID BlockID, ContextInfo *ClassifiedInfo) {
+  auto &OutgoingState = OffsetToBlockMap.try_emplace(BlockID).first->second.OutgoingState;
+  OutgoingState.clear();
+  OutgoingState.reserve(ClassifiedInfo->ClassificationInfo.size());
+
+  for (auto &Info : ClassifiedInfo->ClassificationInfo) {
+    // Only full accesses are forwarded, partial accesses stay block local
+    if ((IsReadAccess(Info.Accessed) || IsWriteAccess(Info.Accessed)) && IsFullAccess(Info.Accessed)) {
+      OutgoingState.emplace_back(ContextMemberState {
+        Info.Accessed, Info.AccessRegClass, Info.AccessOffset, Info.AccessSize, Info.ValueNode, Info.StoreNode,
+      });
+    }
+    else {
+      OutgoingState.emplace_back(ContextMemberState { ACCESS_NONE });
+    }
+  }
+}
+
+/**
+ * @brief Seeds a block with the context accesses that every predecessor agrees on
+ *
+ * Blocks are visited in IR order and a block with a predecessor that hasn't been visited yet (a loop back edge)
+ * starts empty. So a forwarded value is always available on every path into the block and its definition dominates it.
+ * Values that differ between predecessors would need a PHI, which RA doesn't support, so those are reloaded.
+ */
+void RCLSE::LoadBlockEntryState(FEXCore::IR::IRListView *IR, FEXCore::IR::NodeID BlockID, ContextInfo *ClassifiedInfo) {
+  ResetClassificationAccesses(ClassifiedInfo, SupportsAVX);
+
+  auto &Predecessors = OffsetToBlockMap.try_emplace(BlockID).first->second.Predecessors;
+  if (Predecessors.empty()) {
+    return;
+  }
+
+  fextl::vector<const fextl::vector<ContextMemberState>*> PredecessorStates;
+  PredecessorStates.reserve(Predecessors.size());
+  for (auto Predecessor : Predecessors) {
+    auto &State = OffsetToBlockMap[IR->GetID(Predecessor)].OutgoingState;
+    if (State.empty()) {
+      return;
+    }
+    PredecessorStates.emplace_back(&State);
+  }
+
+  size_t Forwarded{};
+  auto &Members = ClassifiedInfo->ClassificationInfo;
+  for (size_t i = 0; i < Members.size() && Forwarded < MAX_CROSS_BLOCK_VALUES; ++i) {
+    const auto &State = (*PredecessorStates[0])[i];
+    if (State.Accessed == ACCESS_NONE) {
+      continue;
+    }
+
+    const bool Agrees = std::all_of(PredecessorStates.begin() + 1, PredecessorStates.end(), [&State, i](auto *PredecessorState) {
+      return (*PredecessorState)[i] == State;
+    });
+
+    if (Agrees) {
+      auto &Info = Members[i];
+      Info.Accessed = State.Accessed;
+      Info.AccessRegClass = State.AccessRegClass;
+      Info.AccessOffset = State.AccessOffset;
+      Info.AccessSize = State.AccessSize;
+      Info.ValueNode = State.ValueNode;
+      Info.StoreNode = State.StoreNode;
+      Info.CrossBlock = true;
+      ++Forwarded;
+    }
+  }
+}
+
 /**
  * @brief This pass removes redundant pairs of storecontext and loadcontext ops
  *
@@ -584,18 +691,53 @@ bool RCLSE::RedundantStoreLoadElimination(FEXCore::IR::IREmitter *IREmit) {
   auto CurrentIR = IREmit->ViewIR();
   auto OriginalWriteCursor = IREmit->GetWriteCursor();
 
-  // XXX: Walk the list and calculate the control flow
+  CalculateControlFlowInfo(IREmit);
 
   ContextInfo &LocalInfo = ClassifiedStruct;
 
   for (auto [BlockNode, BlockHeader] : CurrentIR.GetBlocks()) {
     auto BlockOp = BlockHeader->CW<FEXCore::IR::IROp_CodeBlock>();
     auto BlockEnd = IREmit->GetIterator(BlockOp->Last);
+    const auto BlockID = CurrentIR.GetID(BlockNode);
 
-    ResetClassificationAccesses(&LocalInfo, SupportsAVX);
+    LoadBlockEntryState(&CurrentIR, BlockID, &LocalInfo);
+    // Block local, the stack pointer is cheap to reload from its static register
+    StackPointerState StackPointer{};
 
     for (auto [CodeNode, IROp] : CurrentIR.GetCode(BlockNode)) {
-      if (IROp->Op == OP_STORECONTEXT) {
+      if (IROp->Op == OP_STOREREGISTER) {
+        auto Op = IROp->CW<IR::IROp_StoreRegister>();
+        if (Op->Offset == RSP_OFFSET && Op->Class == GPRClass) {
+          if (StackPointer.StoreNode != nullptr) {
+            // Remove the last store because this one overwrites it entirely
+            IREmit->Remove(StackPointer.StoreNode);
+            Changed = true;
+          }
+
+          auto ValueNode = CurrentIR.GetNode(Op->Value);
+          if (IREmit->GetOpSize(ValueNode) == IROp->Size) {
+            StackPointer = StackPointerState{ValueNode, CodeNode, IROp->Size};
+          }
+          else {
+            // Implicit extension or truncation, keep the store but don't forward through it
+            StackPointer = StackPointerState{nullptr, CodeNode, IROp->Size};
+          }
+        }
+      }
+      else if (IROp->Op == OP_LOADREGISTER) {
+        auto Op = IROp->CW<IR::IROp_LoadRegister>();
+        if (Op->Offset == RSP_OFFSET && Op->Class == GPRClass) {
+          if (StackPointer.ValueNode != nullptr && StackPointer.Size == IROp->Size) {
+            IREmit->ReplaceAllUsesWithRange(CodeNode, StackPointer.ValueNode, IREmit->GetIterator(IREmit->WrapNode(CodeNode)), BlockEnd);
+            Changed = true;
+          }
+          else {
+            // Anything stored so far is read here and has to stay
+            StackPointer = StackPointerState{CodeNode, nullptr, IROp->Size};
+          }
+        }
+      }
+      else if (IROp->Op == OP_STORECONTEXT) {
         auto Op = IROp->CW<IR::IROp_StoreContext>();
         auto Info = FindMemberInfo(&LocalInfo, Op->Offset, IROp->Size);
         uint8_t LastClass = Info->AccessRegClass;
@@ -603,9 +745,11 @@ bool RCLSE::RedundantStoreLoadElimination(FEXCore::IR::IREmitter *IREmit) {
         uint8_t LastSize = Info->AccessSize;
         LastAccessType LastAccess = Info->Accessed;
         OrderedNode *LastStoreNode = Info->StoreNode;
+        const bool LastCrossBlock = Info->CrossBlock;
         RecordAccess(Info, Op->Class, Op->Offset, IROp->Size, ACCESS_WRITE, CurrentIR.GetNode(Op->Value), CodeNode);
 
         if (IsWriteAccess(LastAccess) &&
+            !LastCrossBlock &&
             LastClass == Op->Class &&
             LastOffset == Op->Offset &&
             LastSize <= IROp->Size) {
@@ -718,7 +862,7 @@ bool RCLSE::RedundantStoreLoadElimination(FEXCore::IR::IREmitter *IREmit) {
       else if (IROp->Op == OP_STOREFLAG) {
         auto Op = IROp->CW<IR::IROp_StoreFlag>();
         auto Info = FindMemberInfo(&LocalInfo, offsetof(FEXCore::Core::CPUState, flags[0]) + Op->Flag, 1);
-        auto LastStoreNode = Info->StoreNode;
+        auto LastStoreNode = Info->CrossBlock ? nullptr : Info->StoreNode;
         RecordAccess(&LocalInfo, FEXCore::IR::GPRClass, offsetof(FEXCore::Core::CPUState, flags[0]) + Op->Flag, 1, ACCESS_WRITE, CurrentIR.GetNode(Op->Header.Args[0]), CodeNode);
 
         // Flags don't alias, so we can take the simple route here. Kill any flags that have been overwritten
@@ -738,7 +882,7 @@ bool RCLSE::RedundantStoreLoadElimination(FEXCore::IR::IREmitter *IREmit) {
           }
 
           auto Info = FindMemberInfo(&LocalInfo, offsetof(FEXCore::Core::CPUState, flags[0]) + F, 1);
-          auto LastStoreNode = Info->StoreNode;
+          auto LastStoreNode = Info->CrossBlock ? nullptr : Info->StoreNode;
 
           // Flags don't alias, so we can take the simple route here. Kill any flags that have been invalidated without a read.
           if (LastStoreNode != nullptr)
@@ -786,14 +930,23 @@ bool RCLSE::RedundantStoreLoadElimination(FEXCore::IR::IREmitter *IREmit) {
           // We can't track through these
           ResetClassificationAccesses(&LocalInfo, SupportsAVX);
         }
+
+        // The syscall handler can read the guest stack pointer from the frame, keep its store
+        StackPointer = {};
       }
       else if (IROp->Op == OP_STORECONTEXTINDEXED ||
                IROp->Op == OP_LOADCONTEXTINDEXED ||
                IROp->Op == OP_BREAK) {
         // We can't track through these
         ResetClassificationAccesses(&LocalInfo, SupportsAVX);
+        StackPointer = {};
+      }
+      else if (IROp->Op == OP_THUNK) {
+        StackPointer = {};
       }
     }
+
+    SaveBlockExitState(BlockID, &LocalInfo);
   }
 
   IREmit->SetWriteCursor(OriginalWriteCursor);
@@ -803,8 +956,6 @@ bool RCLSE::RedundantStoreLoadElimination(FEXCore::IR::IREmitter *IREmit) {
 
 bool RCLSE::Run(FEXCore::IR::IREmitter *IREmit) {
   FEXCORE_PROFILE_SCOPED("PassManager::RCLSE");
-  // XXX: We don't do cross-block optimizations yet
-  //CalculateControlFlowInfo(IREmit);
   bool Changed = false;
 
   // Run up to 5 times
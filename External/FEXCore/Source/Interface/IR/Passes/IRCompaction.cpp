@@ -47,6 +47,29 @@ private:
   fextl::vector<CodeBlockData> GeneratedCodeBlocks{};
 };
 
+// RA and the backends only need code node IDs to increase through the blocks in order, which is true of IR
+// that was emitted front to back and only had nodes removed since.
+// Dead nodes keep their slot in the per-node arrays, so the copy is still done once too many have built up.
+static bool IsInProgramOrder(IRListView &IR) {
+  uint32_t PreviousID{};
+  // The invalid node and the IRHeader
+  uint32_t LiveNodes = 2;
+
+  for (auto [BlockNode, BlockHeader] : IR.GetBlocks()) {
+    ++LiveNodes;
+    for (auto [CodeNode, IROp] : IR.GetCode(BlockNode)) {
+      const auto ID = IR.GetID(CodeNode).Value;
+      if (ID <= PreviousID) {
+        return false;
+      }
+      PreviousID = ID;
+      ++LiveNodes;
+    }
+  }
+
+  return LiveNodes * 4 >= IR.GetSSACount() * 3;
+}
+
 IRCompaction::IRCompaction(FEXCore::Utils::IntrusivePooledAllocator &Allocator)
   : LocalBuilder {Allocator} {
   OldToNewRemap.resize(AlignSize);
@@ -55,9 +78,13 @@ IRCompaction::IRCompaction(FEXCore::Utils::IntrusivePooledAllocator &Allocator)
 bool IRCompaction::Run(IREmitter *IREmit) {
   FEXCORE_PROFILE_SCOPED("PassManager::IRCompaction");
 
+  auto CurrentIR = IREmit->ViewIR();
+  if (IsInProgramOrder(CurrentIR)) {
+    return false;
+  }
+
   LocalBuilder.ReownOrClaimBuffer();
 
-  auto CurrentIR = IREmit->ViewIR();
   uint32_t NodeCount = CurrentIR.GetSSACount();
 
   if (OldToNewRemap.size() < NodeCount) {
@@ -114,7 +114,7 @@ bool IRValidation::Run(IREmitter *IREmit) {
           if (AssignedClass != ExpectedClass &&
               ExpectedClass != IR::ComplexClass) {
             HadWarning |= true;
-            Warnings << "%" << ID << ": Destination had register class " << AssignedClass.Val << " When register class " << ExpectedClass.Val << " Was expected" << std::endl;
+            Warnings << "%" << ID << ": Destination had register class " << static_cast<uint32_t>(AssignedClass.Val) << " When register class " << static_cast<uint32_t>(ExpectedClass.Val) << " Was expected" << std::endl;
           }
         }
       }
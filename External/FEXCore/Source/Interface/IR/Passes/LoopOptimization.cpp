@@ -0,0 +1,627 @@
+/*
+$info$
+tags: ir|opts
+desc: Loop detection, loop invariant code motion and flag store sinking for multiblock IR
+$end_info$
+*/
+
+#include "Interface/IR/PassManager.h"
+
+#include <FEXCore/Core/CoreState.h>
+#include <FEXCore/IR/IR.h>
+#include <FEXCore/IR/IREmitter.h>
+#include <FEXCore/IR/IntrusiveIRList.h>
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/Utils/Profiler.h>
+#include <FEXCore/fextl/set.h>
+#include <FEXCore/fextl/unordered_map.h>
+#include <FEXCore/fextl/unordered_set.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <algorithm>
+#include <array>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace FEXCore::IR {
+
+namespace {
+  // Values that live across blocks can't be spilled by RA, so motion out of a loop is bounded.
+  constexpr size_t MAX_HOISTED_VALUES = 6;
+  constexpr size_t MAX_SUNK_FLAGS = 4;
+  // Enough for every op that is moved
+  constexpr size_t MAX_MOVED_ARGS = 4;
+
+  constexpr uint32_t FLAGS_OFFSET = offsetof(FEXCore::Core::CPUState, flags[0]);
+  constexpr uint32_t FLAGS_SIZE = sizeof(FEXCore::Core::CPUState::flags);
+
+  struct BlockInfo {
+    uint32_t Order;
+    ///< Position in reverse postorder from the entry block.
+    uint32_t RPO;
+    ///< Immediate dominator, the entry block is its own. nullptr for blocks that can't be reached from the entry.
+    OrderedNode *IDom;
+    fextl::vector<OrderedNode *> Predecessors;
+    fextl::vector<OrderedNode *> Successors;
+  };
+
+  struct LoopInfo {
+    OrderedNode *Header;
+    ///< The only block outside of the loop that enters it, nullptr if there isn't exactly one that only jumps to the header.
+    OrderedNode *Preheader;
+    fextl::set<OrderedNode *> Blocks;
+    fextl::vector<OrderedNode *> Latches;
+  };
+
+  // Pure integer operations that can't fault, these make up address and constant calculations.
+  bool IsMovableALUOp(IROps Op) {
+    switch (Op) {
+      case OP_CONSTANT:
+      case OP_ENTRYPOINTOFFSET:
+      case OP_ADD:
+      case OP_SUB:
+      case OP_NEG:
+      case OP_NOT:
+      case OP_AND:
+      case OP_ANDN:
+      case OP_OR:
+      case OP_ORLSHL:
+      case OP_ORLSHR:
+      case OP_XOR:
+      case OP_LSHL:
+      case OP_LSHR:
+      case OP_ASHR:
+      case OP_ROR:
+      case OP_MUL:
+      case OP_BFE:
+      case OP_SBFE:
+      case OP_BFI:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  // Flag calculations additionally use these
+  bool IsSinkableFlagOp(IROps Op) {
+    return IsMovableALUOp(Op) || Op == OP_SELECT || Op == OP_POPCOUNT;
+  }
+
+  bool IsInlineArg(IROps Op) {
+    return Op == OP_INLINECONSTANT || Op == OP_INLINEENTRYPOINTOFFSET;
+  }
+
+  // Operations after which the guest context can't be assumed unchanged
+  bool ClobbersContext(IROps Op) {
+    switch (Op) {
+      case OP_STORECONTEXTINDEXED:
+      case OP_STOREREGISTER:
+      case OP_SYSCALL:
+      case OP_INLINESYSCALL:
+      case OP_THUNK:
+      case OP_BREAK:
+      case OP_CALLBACKRETURN:
+      case OP_EXITFUNCTION:
+      case OP_VALIDATECODE:
+      case OP_THREADREMOVECODEENTRY:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  bool Overlaps(uint32_t OffsetA, uint32_t SizeA, uint32_t OffsetB, uint32_t SizeB) {
+    return OffsetA < (OffsetB + SizeB) && OffsetB < (OffsetA + SizeA);
+  }
+
+class LoopOptimization final : public FEXCore::IR::Pass {
+public:
+  bool Run(IREmitter *IREmit) override;
+
+private:
+  void CalculateControlFlowInfo(const IRListView &CurrentIR);
+  void CalculateDominators(const IRListView &CurrentIR);
+  bool Dominates(OrderedNode *Dominator, OrderedNode *Block);
+  void FindLoops(const IRListView &CurrentIR);
+
+  bool HoistInvariants(IREmitter *IREmit, const IRListView &CurrentIR, const LoopInfo &Loop);
+  bool SinkFlagStores(IREmitter *IREmit, const IRListView &CurrentIR, const LoopInfo &Loop);
+
+  // Copies Node in front of the write cursor, duplicating inline arguments so they stay next to their user
+  OrderedNode *CopyNode(IREmitter *IREmit, const IRListView &CurrentIR, OrderedNode *Node);
+  void MoveNode(IREmitter *IREmit, const IRListView &CurrentIR, OrderedNode *Node, OrderedNode *NewNode);
+
+  fextl::unordered_map<OrderedNode *, BlockInfo> Blocks;
+  fextl::vector<LoopInfo> Loops;
+  ///< Which block each node lives in, kept up to date as nodes move.
+  fextl::unordered_map<OrderedNode *, OrderedNode *> NodeBlock;
+};
+
+void LoopOptimization::CalculateControlFlowInfo(const IRListView &CurrentIR) {
+  Blocks.clear();
+  NodeBlock.clear();
+
+  uint32_t Order{};
+  for (auto [BlockNode, BlockHeader] : CurrentIR.GetBlocks()) {
+    Blocks[BlockNode].Order = Order++;
+  }
+
+  for (auto [BlockNode, BlockHeader] : CurrentIR.GetBlocks()) {
+    auto &CurrentBlock = Blocks[BlockNode];
+
+    for (auto [CodeNode, IROp] : CurrentIR.GetCode(BlockNode)) {
+      NodeBlock[CodeNode] = BlockNode;
+
+      auto AddEdge = [&](OrderedNodeWrapper Target) {
+        auto TargetNode = CurrentIR.GetNode(Target);
+        CurrentBlock.Successors.emplace_back(TargetNode);
+        Blocks[TargetNode].Predecessors.emplace_back(BlockNode);
+      };
+
+      if (IROp->Op == OP_JUMP) {
+        AddEdge(IROp->Args[0]);
+      }
+      else if (IROp->Op == OP_CONDJUMP) {
+        auto Op = IROp->C<IROp_CondJump>();
+        AddEdge(Op->TrueBlock);
+        AddEdge(Op->FalseBlock);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Computes the immediate dominator of every block reachable from the entry block
+ *
+ * Iterates in reverse postorder until nothing changes, as in Cooper, Harvey and Kennedy's "A Simple, Fast Dominance Algorithm".
+ */
+void LoopOptimization::CalculateDominators(const IRListView &CurrentIR) {
+  OrderedNode *Entry{};
+  for (auto [BlockNode, BlockHeader] : CurrentIR.GetBlocks()) {
+    Entry = BlockNode;
+    break;
+  }
+
+  if (!Entry) {
+    return;
+  }
+
+  // Depth first postorder with an explicit stack, the block and the next successor to visit
+  fextl::vector<OrderedNode *> PostOrder;
+  fextl::unordered_set<OrderedNode *> Visited{Entry};
+  fextl::vector<std::pair<OrderedNode *, size_t>> Stack{{Entry, 0}};
+  while (!Stack.empty()) {
+    auto [Block, NextSuccessor] = Stack.back();
+    const auto &Successors = Blocks[Block].Successors;
+    if (NextSuccessor < Successors.size()) {
+      Stack.back().second++;
+      auto Successor = Successors[NextSuccessor];
+      if (Visited.insert(Successor).second) {
+        Stack.emplace_back(Successor, 0);
+      }
+    }
+    else {
+      PostOrder.emplace_back(Block);
+      Stack.pop_back();
+    }
+  }
+
+  for (size_t i = 0; i < PostOrder.size(); ++i) {
+    Blocks[PostOrder[PostOrder.size() - 1 - i]].RPO = i;
+  }
+
+  auto Intersect = [this](OrderedNode *A, OrderedNode *B) {
+    while (A != B) {
+      while (Blocks[A].RPO > Blocks[B].RPO) {
+        A = Blocks[A].IDom;
+      }
+      while (Blocks[B].RPO > Blocks[A].RPO) {
+        B = Blocks[B].IDom;
+      }
+    }
+    return A;
+  };
+
+  Blocks[Entry].IDom = Entry;
+
+  bool Changed = true;
+  while (Changed) {
+    Changed = false;
+
+    // Reverse postorder, skipping the entry block at the end of the postorder
+    for (auto It = std::next(PostOrder.rbegin()); It != PostOrder.rend(); ++It) {
+      auto &Info = Blocks[*It];
+
+      OrderedNode *NewIDom{};
+      for (auto Predecessor : Info.Predecessors) {
+        // Not processed yet, or unreachable
+        if (!Blocks[Predecessor].IDom) {
+          continue;
+        }
+        NewIDom = NewIDom ? Intersect(Predecessor, NewIDom) : Predecessor;
+      }
+
+      if (Info.IDom != NewIDom) {
+        Info.IDom = NewIDom;
+        Changed = true;
+      }
+    }
+  }
+}
+
+bool LoopOptimization::Dominates(OrderedNode *Dominator, OrderedNode *Block) {
+  if (!Blocks[Block].IDom) {
+    return false;
+  }
+
+  for (;;) {
+    if (Block == Dominator) {
+      return true;
+    }
+
+    auto IDom = Blocks[Block].IDom;
+    if (IDom == Block) {
+      // Reached the entry block
+      return false;
+    }
+    Block = IDom;
+  }
+}
+
+/**
+ * @brief Finds the natural loops of the multiblock
+ *
+ * Only an edge to a block that dominates its source is a back edge. Other edges to earlier blocks in IR order
+ * are forward merges, treating them as loops would hoist code above the blocks that define it.
+ * Every block of a natural loop is dominated by its header, so the header is the only way in.
+ */
+void LoopOptimization::FindLoops(const IRListView &CurrentIR) {
+  Loops.clear();
+
+  fextl::unordered_map<OrderedNode *, fextl::vector<OrderedNode *>> Latches;
+  for (auto [BlockNode, BlockHeader] : CurrentIR.GetBlocks()) {
+    const auto &Info = Blocks[BlockNode];
+    for (auto Successor : Info.Successors) {
+      if (Dominates(Successor, BlockNode)) {
+        Latches[Successor].emplace_back(BlockNode);
+      }
+    }
+  }
+
+  for (auto &[Header, HeaderLatches] : Latches) {
+    LoopInfo Loop{Header, nullptr, {Header}, HeaderLatches};
+
+    // Walk backwards from the latches until the header
+    fextl::vector<OrderedNode *> WorkList{HeaderLatches.begin(), HeaderLatches.end()};
+    while (!WorkList.empty()) {
+      auto Block = WorkList.back();
+      WorkList.pop_back();
+      if (!Loop.Blocks.insert(Block).second) {
+        continue;
+      }
+      for (auto Predecessor : Blocks[Block].Predecessors) {
+        // Unreachable blocks jumping in to the body aren't part of the loop
+        if (Blocks[Predecessor].IDom) {
+          WorkList.emplace_back(Predecessor);
+        }
+      }
+    }
+
+    LOGMAN_THROW_AA_FMT(std::all_of(Loop.Blocks.begin(), Loop.Blocks.end(), [this, Header](auto Block) {
+      return Dominates(Header, Block);
+    }), "Loop header must dominate the loop body");
+
+    for (auto Predecessor : Blocks[Header].Predecessors) {
+      if (Loop.Blocks.contains(Predecessor)) {
+        continue;
+      }
+
+      if (Loop.Preheader != nullptr) {
+        // More than one way in, can't hoist
+        Loop.Preheader = nullptr;
+        break;
+      }
+      Loop.Preheader = Predecessor;
+    }
+
+    if (Loop.Preheader) {
+      // Only hoist in to blocks that always enter the loop, otherwise the work is added to paths that skip it
+      const auto &Successors = Blocks[Loop.Preheader].Successors;
+      if (Successors.size() != 1) {
+        Loop.Preheader = nullptr;
+      }
+    }
+
+    Loops.emplace_back(std::move(Loop));
+  }
+
+  // Innermost loops first so their invariants can continue up through the outer loops
+  std::sort(Loops.begin(), Loops.end(), [this](const LoopInfo &A, const LoopInfo &B) {
+    if (A.Blocks.size() != B.Blocks.size()) {
+      return A.Blocks.size() < B.Blocks.size();
+    }
+    return Blocks[A.Header].Order < Blocks[B.Header].Order;
+  });
+}
+
+OrderedNode *LoopOptimization::CopyNode(IREmitter *IREmit, const IRListView &CurrentIR, OrderedNode *Node) {
+  auto IROp = CurrentIR.GetOp<IROp_Header>(Node);
+  const uint8_t NumArgs = IR::GetArgs(IROp->Op);
+  LOGMAN_THROW_AA_FMT(NumArgs <= MAX_MOVED_ARGS, "Can't move {}", IR::GetName(IROp->Op));
+
+  std::array<OrderedNode *, MAX_MOVED_ARGS> Args{};
+  for (uint8_t i = 0; i < NumArgs; ++i) {
+    auto Arg = CurrentIR.GetNode(IROp->Args[i]);
+    Args[i] = IsInlineArg(CurrentIR.GetOp<IROp_Header>(Arg)->Op) ? CopyNode(IREmit, CurrentIR, Arg) : Arg;
+  }
+
+  size_t OpSize = FEXCore::IR::GetSize(IROp->Op);
+  auto NewOp = IREmit->AllocateRawOp(OpSize);
+  memcpy(NewOp.first, IROp, OpSize);
+
+  for (uint8_t i = 0; i < NumArgs; ++i) {
+    NewOp.first->Args[i] = IREmit->WrapNode(IREmit->Invalid());
+    IREmit->ReplaceNodeArgument(NewOp, i, Args[i]);
+  }
+
+  return NewOp;
+}
+
+void LoopOptimization::MoveNode(IREmitter *IREmit, const IRListView &CurrentIR, OrderedNode *Node, OrderedNode *NewNode) {
+  // Uses can be in blocks before the definition in IR order, so search everything
+  if (Node->GetUses()) {
+    auto AllCode = CurrentIR.GetAllCode();
+    IREmit->ReplaceAllUsesWithRange(Node, NewNode, AllCode.begin(), AllCode.end());
+  }
+
+  // Inline arguments that were only used here are dead now
+  auto IROp = CurrentIR.GetOp<IROp_Header>(Node);
+  const uint8_t NumArgs = IR::GetArgs(IROp->Op);
+  std::array<OrderedNode *, MAX_MOVED_ARGS> InlineArgs{};
+  for (uint8_t i = 0; i < NumArgs; ++i) {
+    auto Arg = CurrentIR.GetNode(IROp->Args[i]);
+    if (IsInlineArg(CurrentIR.GetOp<IROp_Header>(Arg)->Op)) {
+      InlineArgs[i] = Arg;
+    }
+  }
+
+  IREmit->Remove(Node);
+
+  for (auto Arg : InlineArgs) {
+    if (Arg && Arg->GetUses() == 0) {
+      IREmit->Remove(Arg);
+    }
+  }
+}
+
+/**
+ * @brief Moves loop invariant address and constant calculations in to the preheader
+ *
+ * A node is invariant when it is a pure ALU op and all of its arguments are defined outside of the loop.
+ * Context loads are invariant when nothing inside of the loop can write to that part of the context.
+ */
+bool LoopOptimization::HoistInvariants(IREmitter *IREmit, const IRListView &CurrentIR, const LoopInfo &Loop) {
+  if (!Loop.Preheader) {
+    return false;
+  }
+
+  // Find what the loop does to the context
+  bool ContextClobbered = false;
+  fextl::vector<std::pair<uint32_t, uint32_t>> ContextStores;
+  for (auto Block : Loop.Blocks) {
+    for (auto [CodeNode, IROp] : CurrentIR.GetCode(Block)) {
+      if (IROp->Op == OP_STORECONTEXT) {
+        auto Op = IROp->C<IROp_StoreContext>();
+        ContextStores.emplace_back(Op->Offset, IROp->Size);
+      }
+      else if (IROp->Op == OP_STOREFLAG) {
+        auto Op = IROp->C<IROp_StoreFlag>();
+        ContextStores.emplace_back(FLAGS_OFFSET + Op->Flag, 1);
+      }
+      else if (IROp->Op == OP_INVALIDATEFLAGS) {
+        ContextStores.emplace_back(FLAGS_OFFSET, FLAGS_SIZE);
+      }
+      else if (ClobbersContext(IROp->Op)) {
+        ContextClobbered = true;
+      }
+    }
+  }
+
+  auto IsInvariant = [&](OrderedNode *CodeNode, IROp_Header *IROp) {
+    if (IROp->Op == OP_LOADCONTEXT) {
+      if (ContextClobbered) {
+        return false;
+      }
+
+      auto Op = IROp->C<IROp_LoadContext>();
+      return std::none_of(ContextStores.begin(), ContextStores.end(), [Op, IROp](auto &Store) {
+        return Overlaps(Op->Offset, IROp->Size, Store.first, Store.second);
+      });
+    }
+
+    if (!IsMovableALUOp(IROp->Op)) {
+      return false;
+    }
+
+    const uint8_t NumArgs = IR::GetArgs(IROp->Op);
+    for (uint8_t i = 0; i < NumArgs; ++i) {
+      auto Arg = CurrentIR.GetNode(IROp->Args[i]);
+      if (IsInlineArg(CurrentIR.GetOp<IROp_Header>(Arg)->Op)) {
+        continue;
+      }
+
+      if (Loop.Blocks.contains(NodeBlock[Arg])) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  fextl::vector<OrderedNode *> Invariants;
+  size_t HoistedValues{};
+  for (auto [BlockNode, BlockHeader] : CurrentIR.GetBlocks()) {
+    if (!Loop.Blocks.contains(BlockNode)) {
+      continue;
+    }
+
+    for (auto [CodeNode, IROp] : CurrentIR.GetCode(BlockNode)) {
+      if (HoistedValues >= MAX_HOISTED_VALUES) {
+        break;
+      }
+
+      if (IsInvariant(CodeNode, IROp)) {
+        Invariants.emplace_back(CodeNode);
+        // Treat it as outside the loop so things depending on it can follow
+        NodeBlock[CodeNode] = Loop.Preheader;
+        ++HoistedValues;
+      }
+    }
+  }
+
+  if (Invariants.empty()) {
+    return false;
+  }
+
+  // Insert before the jump in to the loop
+  auto PreheaderOp = CurrentIR.GetOp<IROp_CodeBlock>(Loop.Preheader);
+  auto Terminator = IREmit->UnwrapNode(CurrentIR.GetNode(PreheaderOp->Last)->Header.Previous);
+  IREmit->SetWriteCursor(IREmit->UnwrapNode(Terminator->Header.Previous));
+
+  for (auto Node : Invariants) {
+    auto NewNode = CopyNode(IREmit, CurrentIR, Node);
+    NodeBlock[NewNode] = Loop.Preheader;
+    MoveNode(IREmit, CurrentIR, Node, NewNode);
+  }
+
+  return true;
+}
+
+/**
+ * @brief Sinks flag stores out of single block loops
+ *
+ * Flags that aren't read inside the loop only need the value from the last iteration.
+ * The store, and the calculation feeding only that store, move to the start of the exit block.
+ * The exit must only be reachable from the loop so the values are always available there.
+ */
+bool LoopOptimization::SinkFlagStores(IREmitter *IREmit, const IRListView &CurrentIR, const LoopInfo &Loop) {
+  if (Loop.Blocks.size() != 1) {
+    return false;
+  }
+
+  auto Block = Loop.Header;
+  const auto &Successors = Blocks[Block].Successors;
+  if (Successors.size() != 2) {
+    return false;
+  }
+
+  auto Exit = Successors[0] == Block ? Successors[1] : Successors[0];
+  if (Exit == Block || Blocks[Exit].Predecessors.size() != 1) {
+    return false;
+  }
+
+  std::array<OrderedNode *, Core::CPUState::NUM_EFLAG_BITS> LastStore{};
+  uint64_t ReadFlags{};
+  for (auto [CodeNode, IROp] : CurrentIR.GetCode(Block)) {
+    if (IROp->Op == OP_STOREFLAG) {
+      LastStore[IROp->C<IROp_StoreFlag>()->Flag] = CodeNode;
+    }
+    else if (IROp->Op == OP_LOADFLAG) {
+      ReadFlags |= 1ULL << IROp->C<IROp_LoadFlag>()->Flag;
+    }
+    else if (IROp->Op == OP_INVALIDATEFLAGS) {
+      ReadFlags |= IROp->C<IROp_InvalidateFlags>()->Flags;
+    }
+    else if (IROp->Op == OP_LOADCONTEXT) {
+      auto Op = IROp->C<IROp_LoadContext>();
+      if (Overlaps(Op->Offset, IROp->Size, FLAGS_OFFSET, FLAGS_SIZE)) {
+        return false;
+      }
+    }
+    else if (IROp->Op == OP_LOADCONTEXTINDEXED || ClobbersContext(IROp->Op)) {
+      return false;
+    }
+  }
+
+  fextl::vector<OrderedNode *> Stores;
+  for (size_t F = 0; F < LastStore.size() && Stores.size() < MAX_SUNK_FLAGS; ++F) {
+    if (LastStore[F] && !(ReadFlags & (1ULL << F))) {
+      Stores.emplace_back(LastStore[F]);
+    }
+  }
+
+  if (Stores.empty()) {
+    return false;
+  }
+
+  // Collect the calculations that only feed the sunk stores, users always come before their arguments here
+  fextl::vector<OrderedNode *> Sinking{Stores.begin(), Stores.end()};
+  fextl::unordered_set<OrderedNode *> Sunk{Stores.begin(), Stores.end()};
+  fextl::unordered_map<OrderedNode *, uint32_t> SunkUses;
+  for (size_t i = 0; i < Sinking.size(); ++i) {
+    auto IROp = CurrentIR.GetOp<IROp_Header>(Sinking[i]);
+    const uint8_t NumArgs = IR::GetArgs(IROp->Op);
+    for (uint8_t j = 0; j < NumArgs; ++j) {
+      auto Arg = CurrentIR.GetNode(IROp->Args[j]);
+      auto ArgOp = CurrentIR.GetOp<IROp_Header>(Arg);
+      if (NodeBlock[Arg] != Block || !IsSinkableFlagOp(ArgOp->Op) || Sunk.contains(Arg)) {
+        continue;
+      }
+
+      if (++SunkUses[Arg] == Arg->GetUses()) {
+        Sinking.emplace_back(Arg);
+        Sunk.insert(Arg);
+      }
+    }
+  }
+
+  // Order by position in the block so definitions are emitted before their uses
+  fextl::unordered_map<OrderedNode *, uint32_t> Position;
+  uint32_t Index{};
+  for (auto [CodeNode, IROp] : CurrentIR.GetCode(Block)) {
+    Position[CodeNode] = Index++;
+  }
+  std::sort(Sinking.begin(), Sinking.end(), [&Position](auto A, auto B) {
+    return Position[A] < Position[B];
+  });
+
+  auto ExitOp = CurrentIR.GetOp<IROp_CodeBlock>(Exit);
+  IREmit->SetWriteCursor(CurrentIR.GetNode(ExitOp->Begin));
+
+  for (auto Node : Sinking) {
+    auto NewNode = CopyNode(IREmit, CurrentIR, Node);
+    NodeBlock[NewNode] = Exit;
+    MoveNode(IREmit, CurrentIR, Node, NewNode);
+  }
+
+  return true;
+}
+
+bool LoopOptimization::Run(IREmitter *IREmit) {
+  FEXCORE_PROFILE_SCOPED("PassManager::LoopOptimization");
+
+  auto CurrentIR = IREmit->ViewIR();
+  auto OriginalWriteCursor = IREmit->GetWriteCursor();
+
+  CalculateControlFlowInfo(CurrentIR);
+  CalculateDominators(CurrentIR);
+  FindLoops(CurrentIR);
+
+  bool Changed = false;
+  for (auto &Loop : Loops) {
+    Changed |= HoistInvariants(IREmit, CurrentIR, Loop);
+    Changed |= SinkFlagStores(IREmit, CurrentIR, Loop);
+  }
+
+  IREmit->SetWriteCursor(OriginalWriteCursor);
+
+  return Changed;
+}
+
+}
+
+fextl::unique_ptr<FEXCore::IR::Pass> CreateLoopOptimization() {
+  return fextl::make_unique<LoopOptimization>();
+}
+
+}
@@ -1,68 +1,237 @@
 /*
 $info$
 tags: ir|opts
-desc: This is not used right now, possibly broken
+desc: Removes flag stores that are overwritten before they are read, using flag liveness across the multiblock
 $end_info$
 */
 
+#include <FEXCore/Core/CoreState.h>
+#include <FEXCore/Core/X86Enums.h>
 #include <FEXCore/IR/IR.h>
 #include <FEXCore/IR/IREmitter.h>
 #include <FEXCore/IR/IntrusiveIRList.h>
 #include <FEXCore/Utils/Profiler.h>
+#include <FEXCore/fextl/unordered_map.h>
+#include <FEXCore/fextl/vector.h>
 
 #include "Interface/IR/PassManager.h"
 
-#include <array>
 #include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <utility>
 
 namespace FEXCore::IR {
 
+namespace {
+  // One bit per byte of CPUState::flags
+  using FlagMask = uint64_t;
+
+  constexpr uint32_t FLAGS_OFFSET = offsetof(FEXCore::Core::CPUState, flags[0]);
+  constexpr uint32_t FLAGS_SIZE = sizeof(FEXCore::Core::CPUState::flags);
+  static_assert(FLAGS_SIZE < 64, "Flags need to fit in a FlagMask");
+  constexpr FlagMask ALL_FLAGS = (1ULL << FLAGS_SIZE) - 1;
+
+  FlagMask GetFlagBytes(uint32_t Flag) {
+    // NZCV is stored packed as a 32-bit value
+    const uint32_t Size = Flag == FEXCore::X86State::RFLAG_NZCV_LOC ? 4 : 1;
+    return ((1ULL << Size) - 1) << Flag;
+  }
+
+  FlagMask GetContextFlagBytes(uint32_t Offset, uint32_t Size) {
+    FlagMask Mask{};
+    for (uint32_t i = 0; i < FLAGS_SIZE; ++i) {
+      const uint32_t ByteOffset = FLAGS_OFFSET + i;
+      if (ByteOffset >= Offset && ByteOffset < (Offset + Size)) {
+        Mask |= 1ULL << i;
+      }
+    }
+    return Mask;
+  }
+
+  struct FlagEffect {
+    FlagMask Read;
+    FlagMask Written;
+  };
+
+  FlagEffect GetFlagEffect(const IROp_Header *IROp) {
+    switch (IROp->Op) {
+      case OP_LOADFLAG:
+        return {GetFlagBytes(IROp->C<IROp_LoadFlag>()->Flag), 0};
+      case OP_STOREFLAG:
+        return {0, GetFlagBytes(IROp->C<IROp_StoreFlag>()->Flag)};
+      case OP_INVALIDATEFLAGS:
+        // Invalidated flags are undefined, so nothing before can be observed through them
+        return {0, IROp->C<IROp_InvalidateFlags>()->Flags & ALL_FLAGS};
+      case OP_LOADCONTEXT: {
+        auto Op = IROp->C<IROp_LoadContext>();
+        return {GetContextFlagBytes(Op->Offset, IROp->Size), 0};
+      }
+      case OP_LOADCONTEXTINDEXED:
+        return {ALL_FLAGS, 0};
+
+      // Side effects that never look at the flags
+      case OP_DUMMY:
+      case OP_BEGINBLOCK:
+      case OP_ENDBLOCK:
+      case OP_GUESTOPCODE:
+      case OP_JUMP:
+      case OP_CONDJUMP:
+      case OP_PRINT:
+      case OP_SETROUNDINGMODE:
+      case OP_F80LOADFCW:
+      case OP_INLINECONSTANT:
+      case OP_INLINEENTRYPOINTOFFSET:
+      // Partial context writes are treated as not writing the flags, which keeps earlier stores alive
+      case OP_STORECONTEXT:
+      case OP_STORECONTEXTINDEXED:
+      case OP_STOREREGISTER:
+      case OP_SPILLREGISTER:
+      case OP_STOREMEM:
+      case OP_STOREMEMPAIR:
+      case OP_STOREMEMTSO:
+      case OP_VSTOREVECTORMASKED:
+      case OP_MEMSET:
+      case OP_MEMCPY:
+      case OP_MEMSCAN:
+      case OP_MEMCMP:
+      case OP_CACHELINECLEAR:
+      case OP_CACHELINECLEAN:
+      case OP_CACHELINEZERO:
+      case OP_FENCE:
+      case OP_CAS:
+      case OP_CASPAIR:
+      case OP_ATOMICADD:
+      case OP_ATOMICSUB:
+      case OP_ATOMICAND:
+      case OP_ATOMICOR:
+      case OP_ATOMICXOR:
+      case OP_ATOMICSWAP:
+      case OP_ATOMICFETCHADD:
+      case OP_ATOMICFETCHSUB:
+      case OP_ATOMICFETCHAND:
+      case OP_ATOMICFETCHOR:
+      case OP_ATOMICFETCHXOR:
+      case OP_ATOMICFETCHNEG:
+        return {};
+
+      default:
+        // Anything else with side effects (exits, syscalls, thunks, breaks) can observe the full guest state
+        if (IR::HasSideEffects(IROp->Op)) {
+          return {ALL_FLAGS, 0};
+        }
+        return {};
+    }
+  }
+
+  struct BlockInfo {
+    fextl::vector<OrderedNode *> Successors;
+    ///< Flags read before being written in this block
+    FlagMask Use;
+    ///< Flags written in this block
+    FlagMask Def;
+    FlagMask LiveIn;
+    FlagMask LiveOut;
+  };
+}
+
 class DeadFlagCalculationEliminination final : public FEXCore::IR::Pass {
 public:
   bool Run(IREmitter *IREmit) override;
+
+private:
+  void CalculateLiveness(const IRListView &CurrentIR);
+
+  fextl::vector<OrderedNode *> BlockOrder;
+  fextl::unordered_map<OrderedNode *, BlockInfo> Blocks;
 };
 
+void DeadFlagCalculationEliminination::CalculateLiveness(const IRListView &CurrentIR) {
+  BlockOrder.clear();
+  Blocks.clear();
+
+  for (auto [BlockNode, BlockHeader] : CurrentIR.GetBlocks()) {
+    BlockOrder.emplace_back(BlockNode);
+    auto &Info = Blocks[BlockNode];
+
+    for (auto [CodeNode, IROp] : CurrentIR.GetCode(BlockNode)) {
+      const auto Effect = GetFlagEffect(IROp);
+      Info.Use |= Effect.Read & ~Info.Def;
+      Info.Def |= Effect.Written;
+
+      if (IROp->Op == OP_JUMP) {
+        Info.Successors.emplace_back(CurrentIR.GetNode(IROp->Args[0]));
+      }
+      else if (IROp->Op == OP_CONDJUMP) {
+        auto Op = IROp->C<IROp_CondJump>();
+        Info.Successors.emplace_back(CurrentIR.GetNode(Op->TrueBlock));
+        Info.Successors.emplace_back(CurrentIR.GetNode(Op->FalseBlock));
+      }
+    }
+  }
+
+  // Iterate backwards to a fixed point, loops need more than one walk
+  bool Changed = true;
+  while (Changed) {
+    Changed = false;
+
+    for (auto it = BlockOrder.rbegin(); it != BlockOrder.rend(); ++it) {
+      auto &Info = Blocks[*it];
+
+      // Leaving the multiblock without an exiting op shouldn't happen, but treat it like an exit
+      FlagMask LiveOut = Info.Successors.empty() ? ALL_FLAGS : 0;
+      for (auto Successor : Info.Successors) {
+        LiveOut |= Blocks[Successor].LiveIn;
+      }
+
+      const FlagMask LiveIn = Info.Use | (LiveOut & ~Info.Def);
+      if (LiveIn != Info.LiveIn || LiveOut != Info.LiveOut) {
+        Info.LiveIn = LiveIn;
+        Info.LiveOut = LiveOut;
+        Changed = true;
+      }
+    }
+  }
+}
+
 /**
- * @brief (UNSAFE) This pass removes flag calculations that will otherwise be unused INSIDE of that block
+ * @brief This pass removes flag stores that are never observed
  *
- * Compilers don't really do any form of cross-block flag allocation like they do RA with GPRs.
- * This ends up with them recalculating flags across blocks regardless of if it is actually possible to reuse the flags.
- * This is an additional burden in x86 that most instructions change flags when called, so it is easier to recalculate anyway.
- *
- * This is unsafe since handwritten code can easily break this assumption.
- * This may be more interesting with full function level recompilation since flags definitely won't be used across function boundaries.
+ * Almost every x86 ALU op writes the flags, while very few are ever read.
+ * Flag liveness is tracked per byte of the flags array across all of the blocks in the multiblock.
+ * A flag store is dead if every path from it overwrites the flag before anything can read it.
+ * Exits, syscalls and other ops that can observe the whole guest state read every flag.
  *
+ * The calculations feeding removed stores are left for dead code elimination.
  */
 bool DeadFlagCalculationEliminination::Run(IREmitter *IREmit) {
   FEXCORE_PROFILE_SCOPED("PassManager::DFE");
 
-  std::array<OrderedNode*, 32> LastValidFlagStores{};
-
   bool Changed = false;
   auto CurrentIR = IREmit->ViewIR();
 
-  for (auto [BlockNode, BlockHeader] : CurrentIR.GetBlocks()) {
+  CalculateLiveness(CurrentIR);
+
+  fextl::vector<std::pair<OrderedNode *, IROp_Header *>> Code;
+  for (auto BlockNode : BlockOrder) {
+    Code.clear();
     for (auto [CodeNode, IROp] : CurrentIR.GetCode(BlockNode)) {
-      if (IROp->Op == OP_STOREFLAG) {
-        auto Op = IROp->CW<IR::IROp_StoreFlag>();
-        // Set this node as the last one valid for this flag
-        LastValidFlagStores[Op->Flag] = CodeNode;
-      }
-      else if (IROp->Op == OP_LOADFLAG) {
-        auto Op = IROp->CW<IR::IROp_LoadFlag>();
-        LastValidFlagStores[Op->Flag] = nullptr;
-      }
+      Code.emplace_back(CodeNode, IROp);
     }
 
-    // If any flags are stored but not loaded by the end of the block, then erase them
-    for (auto &Flag : LastValidFlagStores) {
-      if (Flag != nullptr) {
-        IREmit->Remove(Flag);
+    FlagMask Live = Blocks[BlockNode].LiveOut;
+    for (auto it = Code.rbegin(); it != Code.rend(); ++it) {
+      auto [CodeNode, IROp] = *it;
+      const auto Effect = GetFlagEffect(IROp);
+
+      if (IROp->Op == OP_STOREFLAG && !(Effect.Written & Live)) {
+        IREmit->Remove(CodeNode);
         Changed = true;
+        continue;
       }
-    }
 
-    LastValidFlagStores.fill(nullptr);
+      Live = (Live & ~Effect.Written) | Effect.Read;
+    }
   }
 
   return Changed;
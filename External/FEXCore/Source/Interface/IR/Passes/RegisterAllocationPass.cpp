@@ -92,6 +92,8 @@ namespace {
 
   struct RegisterGraph : public FEXCore::Allocator::FEXAllocOperators {
     IR::RegisterAllocationData::UniquePtr AllocData;
+    // Number of nodes AllocData was allocated for, it is reused while blocks fit
+    uint32_t AllocDataCapacity{};
     RegisterSet Set;
     fextl::vector<RegisterNode> Nodes{};
     uint32_t NodeCount{};
@@ -155,7 +157,15 @@ namespace {
     Graph->Nodes.resize(NodeCount);
 
     Graph->VisitedNodePredecessors.clear();
-    Graph->AllocData = RegisterAllocationData::Create(NodeCount);
+    if (NodeCount > Graph->AllocDataCapacity) {
+      Graph->AllocData = RegisterAllocationData::Create(NodeCount);
+      Graph->AllocDataCapacity = NodeCount;
+    }
+    else {
+      memset(&Graph->AllocData->Map[0], PhysicalRegister::Invalid().Raw, NodeCount);
+      Graph->AllocData->SpillSlotCount = 0;
+      Graph->AllocData->MapCount = NodeCount;
+    }
     Graph->NodeCount = NodeCount;
   }
 
@@ -269,7 +279,7 @@ namespace {
 
   class ConstrainedRAPass final : public RegisterAllocationPass {
     public:
-      ConstrainedRAPass(FEXCore::IR::Pass* _CompactionPass, bool OptimizeSRA, bool SupportsAVX);
+      ConstrainedRAPass(FEXCore::IR::Pass* _CompactionPass, bool OptimizeSRA, bool SupportsAVX, bool LinearScan);
       ~ConstrainedRAPass();
       bool Run(IREmitter *IREmit) override;
 
@@ -282,7 +292,7 @@ namespace {
        * Top 32bits is the class, lower 32bits is the register
        */
       RegisterAllocationData* GetAllocationData() override;
-      RegisterAllocationData::UniquePtr PullAllocationData() override;
+      RegisterAllocationData::UniquePtr CopyAllocationData(FEXCore::Utils::BumpArena &Arena) override;
 
     private:
       using BlockInterferences = fextl::vector<IR::NodeID>;
@@ -296,6 +306,7 @@ namespace {
       FEXCore::IR::Pass* CompactionPass;
       bool OptimizeSRA;
       bool SupportsAVX;
+      bool LinearScan;
 
       fextl::vector<LiveRange> LiveRanges;
 
@@ -341,10 +352,26 @@ namespace {
       uint32_t FindSpillSlot(IR::NodeID Node, FEXCore::IR::RegisterClassType RegisterClass);
 
       bool RunAllocateVirtualRegisters(IREmitter *IREmit);
+
+      /**
+       * @name Linear scan allocation
+       *
+       * Single forward walk over the live ranges with no interference graph.
+       * Every value that doesn't fit is spilled in the same walk, so a block needs a handful of rounds instead of one per spill.
+       * @{ */
+      /**
+       * @brief One linear scan round
+       *
+       * @return false if allocation isn't possible with spilling, the graph allocator needs to take over
+       */
+      bool RunLinearScan(IREmitter *IREmit);
+      bool IsLinearScanSpillCandidate(FEXCore::IR::IRListView *IR, IR::NodeID Node);
+      void InsertLinearScanSpills(IREmitter *IREmit, fextl::vector<IR::NodeID> &Spilled);
+      /**  @} */
   };
 
-  ConstrainedRAPass::ConstrainedRAPass(FEXCore::IR::Pass* _CompactionPass, bool _OptimizeSRA, bool _SupportsAVX)
-    : CompactionPass {_CompactionPass}, OptimizeSRA(_OptimizeSRA), SupportsAVX{_SupportsAVX} {
+  ConstrainedRAPass::ConstrainedRAPass(FEXCore::IR::Pass* _CompactionPass, bool _OptimizeSRA, bool _SupportsAVX, bool _LinearScan)
+    : CompactionPass {_CompactionPass}, OptimizeSRA(_OptimizeSRA), SupportsAVX{_SupportsAVX}, LinearScan{_LinearScan} {
   }
 
   ConstrainedRAPass::~ConstrainedRAPass() {
@@ -357,7 +384,7 @@ namespace {
     Graph = AllocateRegisterGraph(ClassCount);
 
     // Add identity conflicts
-    for (uint32_t Class = 0; Class < INVALID_CLASS; Class++) {
+    for (RegisterClassType::value_type Class = 0; Class < INVALID_CLASS; Class++) {
       for (uint32_t Reg = 0; Reg < INVALID_REG; Reg++) {
         AddRegisterConflict(RegisterClassType{Class}, Reg, RegisterClassType{Class}, Reg);
       }
@@ -378,8 +405,8 @@ namespace {
     return Graph->AllocData.get();
   }
 
-  RegisterAllocationData::UniquePtr ConstrainedRAPass::PullAllocationData() {
-    return std::move(Graph->AllocData);
+  RegisterAllocationData::UniquePtr ConstrainedRAPass::CopyAllocationData(FEXCore::Utils::BumpArena &Arena) {
+    return Graph->AllocData->CreateCopy(Arena);
   }
 
   void ConstrainedRAPass::RecursiveLiveRangeExpansion(IR::IRListView *IR,
@@ -1509,6 +1536,205 @@ namespace {
   }
 
 
+  bool ConstrainedRAPass::IsLinearScanSpillCandidate(FEXCore::IR::IRListView *IR, IR::NodeID Node) {
+    const auto &NodeLiveRange = LiveRanges[Node.Value];
+
+    // Values crossing blocks and statically allocated registers can't be spilled
+    if (NodeLiveRange.RematCost == -1 ||
+        !NodeLiveRange.PrefferedRegister.IsInvalid() ||
+        Graph->Nodes[Node.Value].Head.PhiPartner) {
+      return false;
+    }
+
+    // Fills are what spilling produces, spilling those again would never converge
+    switch (IR->GetOp<IROp_Header>(IR::OrderedNodeWrapper::WrapOffset(Node.Value * sizeof(IR::OrderedNode)))->Op) {
+      case IR::OP_FILLREGISTER:
+      case IR::OP_INLINECONSTANT:
+      case IR::OP_INLINEENTRYPOINTOFFSET:
+      case IR::OP_IRHEADER:
+        return false;
+      default:
+        return true;
+    }
+  }
+
+  bool ConstrainedRAPass::RunLinearScan(FEXCore::IR::IREmitter *IREmit) {
+    auto IR = IREmit->ViewIR();
+    const uint32_t SSACount = IR.GetSSACount();
+
+    ResetRegisterGraph(Graph, SSACount);
+    FindNodeClasses(Graph, &IR);
+    CalculateLiveRange(&IR);
+    if (OptimizeSRA)
+      OptimizeStaticRegisters(&IR);
+
+    // SSA IDs are in program order, so walking IDs visits live ranges sorted by start
+    fextl::vector<IR::NodeID> Active;
+    fextl::vector<IR::NodeID> Spilled;
+
+    for (uint32_t i = 0; i < SSACount; ++i) {
+      // Expire ranges first, same as the interference calculation
+      std::erase_if(Active, [this, i](IR::NodeID ActiveNode) {
+        return LiveRanges[ActiveNode.Value].End.Value <= i;
+      });
+
+      auto &CurrentRegAndClass = Graph->AllocData->Map[i];
+      const auto &CurrentLiveRange = LiveRanges[i];
+      if (CurrentRegAndClass == PhysicalRegister::Invalid() || CurrentLiveRange.Begin.Value != i) {
+        continue;
+      }
+
+      if (Graph->Nodes[i].Head.PhiPartner) {
+        LOGMAN_MSG_A_FMT("Phi nodes not supported");
+      }
+
+      if (!CurrentLiveRange.PrefferedRegister.IsInvalid()) {
+        CurrentRegAndClass = CurrentLiveRange.PrefferedRegister;
+        Active.emplace_back(IR::NodeID{i});
+        continue;
+      }
+
+      const FEXCore::IR::RegisterClassType RegClass{CurrentRegAndClass.Class};
+      const RegisterClass *RAClass = &Graph->Set.Classes[RegClass];
+
+      for (;;) {
+        uint32_t RegisterConflicts = 0;
+        for (auto ActiveNode : Active) {
+          RegisterConflicts |= GetConflicts(Graph, Graph->AllocData->Map[ActiveNode.Value], RegClass);
+        }
+        RegisterConflicts = (~RegisterConflicts) & RAClass->CountMask;
+
+        if (const int Reg = FindFirstSetBit(RegisterConflicts); Reg != 0) {
+          CurrentRegAndClass = PhysicalRegister(RegClass, Reg - 1);
+          Active.emplace_back(IR::NodeID{i});
+          break;
+        }
+
+        // Out of registers, spill whichever range ends last. Could be the current one
+        auto Victim = Active.end();
+        uint32_t VictimEnd = 0;
+        for (auto it = Active.begin(); it != Active.end(); ++it) {
+          const auto End = LiveRanges[it->Value].End.Value;
+          // Spilling it must free something the current class can use
+          if (End > VictimEnd &&
+              GetConflicts(Graph, Graph->AllocData->Map[it->Value], RegClass) != 0 &&
+              IsLinearScanSpillCandidate(&IR, *it)) {
+            Victim = it;
+            VictimEnd = End;
+          }
+        }
+
+        if (CurrentLiveRange.End.Value >= VictimEnd && IsLinearScanSpillCandidate(&IR, IR::NodeID{i})) {
+          CurrentRegAndClass = PhysicalRegister(RegClass, INVALID_REG);
+          Spilled.emplace_back(IR::NodeID{i});
+          break;
+        }
+
+        if (Victim == Active.end()) {
+          // Nothing left that linear scan knows how to spill
+          return false;
+        }
+
+        Spilled.emplace_back(*Victim);
+        Graph->AllocData->Map[Victim->Value].Reg = INVALID_REG;
+        Active.erase(Victim);
+      }
+    }
+
+    HadFullRA = Spilled.empty();
+    if (!HadFullRA) {
+      InsertLinearScanSpills(IREmit, Spilled);
+    }
+
+    return true;
+  }
+
+  void ConstrainedRAPass::InsertLinearScanSpills(FEXCore::IR::IREmitter *IREmit, fextl::vector<IR::NodeID> &Spilled) {
+    using namespace FEXCore;
+
+    auto IR = IREmit->ViewIR();
+    auto LastCursor = IREmit->GetWriteCursor();
+    const uint32_t SSACount = IR.GetSSACount();
+
+    std::sort(Spilled.begin(), Spilled.end());
+
+    // Slots from previous rounds are still live in the IR, this round only shares slots between its own spills
+    const uint32_t FirstSlot = Graph->SpillStack.size();
+    fextl::vector<IR::NodeID> SlotEnds;
+    fextl::vector<uint32_t> NodeSlot(SSACount, UINT32_MAX);
+
+    for (auto Node : Spilled) {
+      const auto &NodeLiveRange = LiveRanges[Node.Value];
+      const auto Class = IR::RegisterClassType{Graph->AllocData->Map[Node.Value].Class};
+
+      auto Slot = std::find_if(SlotEnds.begin(), SlotEnds.end(), [&NodeLiveRange](IR::NodeID End) {
+        return End < NodeLiveRange.Begin;
+      });
+
+      if (Slot == SlotEnds.end()) {
+        SlotEnds.emplace_back(NodeLiveRange.End);
+        Graph->SpillStack.emplace_back(SpillStackUnit{Node, Class});
+        SpillSlotCount++;
+        NodeSlot[Node.Value] = FirstSlot + SlotEnds.size() - 1;
+      } else {
+        *Slot = NodeLiveRange.End;
+        NodeSlot[Node.Value] = FirstSlot + std::distance(SlotEnds.begin(), Slot);
+      }
+    }
+
+    // Gather the uses before modifying the IR, new nodes don't have IDs that fit the live ranges
+    struct SpilledUse {
+      IR::OrderedNode *Use;
+      uint8_t Arg;
+    };
+    fextl::vector<SpilledUse> Uses;
+
+    for (auto [BlockNode, BlockHeader] : IR.GetBlocks()) {
+      for (auto [CodeNode, IROp] : IR.GetCode(BlockNode)) {
+        if (IROp->Op == OP_FILLREGISTER) {
+          continue;
+        }
+
+        const uint8_t NumArgs = IR::GetRAArgs(IROp->Op);
+        for (uint8_t i = 0; i < NumArgs; ++i) {
+          const auto &Arg = IROp->Args[i];
+          if (Arg.IsInvalid() || Arg.ID().Value >= SSACount) {
+            continue;
+          }
+
+          if (NodeSlot[Arg.ID().Value] != UINT32_MAX) {
+            Uses.emplace_back(SpilledUse{CodeNode, i});
+          }
+        }
+      }
+    }
+
+    // Spill everywhere: store right after the definition, fill right before every use
+    for (auto Node : Spilled) {
+      auto [DefNode, DefOp] = IR.at(Node)();
+      const auto Class = IR::RegisterClassType{Graph->AllocData->Map[Node.Value].Class};
+
+      IREmit->SetWriteCursor(DefNode);
+      auto SpillOp = IREmit->_SpillRegister(DefNode, NodeSlot[Node.Value], Class);
+      SpillOp.first->Header.Size = DefOp->Size;
+      SpillOp.first->Header.ElementSize = DefOp->ElementSize;
+    }
+
+    for (auto [UseNode, Arg] : Uses) {
+      const auto ArgID = UseNode->Op(IR.GetData())->Args[Arg].ID();
+      auto [DefNode, DefOp] = IR.at(ArgID)();
+      const auto Class = IR::RegisterClassType{Graph->AllocData->Map[ArgID.Value].Class};
+
+      IREmit->SetWriteCursor(IR.GetNode(UseNode->Header.Previous));
+      auto FillOp = IREmit->_FillRegister(DefNode, NodeSlot[ArgID.Value], Class);
+      FillOp.first->Header.Size = DefOp->Size;
+      FillOp.first->Header.ElementSize = DefOp->ElementSize;
+      IREmit->ReplaceNodeArgument(UseNode, Arg, FillOp);
+    }
+
+    IREmit->SetWriteCursor(LastCursor);
+  }
+
   void ConstrainedRAPass::CalculatePredecessors(FEXCore::IR::IRListView *IR) {
     Graph->BlockPredecessors.clear();
 
@@ -1538,6 +1764,25 @@ namespace {
 
     CalculatePredecessors(&IR);
 
+    if (LinearScan) {
+      // Each round spills everything that didn't fit in one go, more than a few rounds means the block is better off with the graph allocator
+      constexpr uint32_t MAX_LINEAR_SCAN_ROUNDS = 8;
+      for (uint32_t Round = 0; Round < MAX_LINEAR_SCAN_ROUNDS; ++Round) {
+        HadFullRA = false;
+        if (!RunLinearScan(IREmit)) {
+          break;
+        }
+
+        if (HadFullRA) {
+          Graph->AllocData->SpillSlotCount = Graph->SpillStack.size();
+          return true;
+        }
+
+        Changed = true;
+        CompactionPass->Run(IREmit);
+      }
+    }
+
     while (1) {
       HadFullRA = true;
 
@@ -1549,6 +1794,9 @@ namespace {
       }
 
       SpillOne(IREmit);
+      if (SpillStat) {
+        SpillStat->Count.fetch_add(1, std::memory_order_relaxed);
+      }
       Changed = true;
       // We need to rerun compaction after spilling
       CompactionPass->Run(IREmit);
@@ -1559,7 +1807,7 @@ namespace {
     return Changed;
   }
 
-  fextl::unique_ptr<FEXCore::IR::RegisterAllocationPass> CreateRegisterAllocationPass(FEXCore::IR::Pass* CompactionPass, bool OptimizeSRA, bool SupportsAVX) {
-    return fextl::make_unique<ConstrainedRAPass>(CompactionPass, OptimizeSRA, SupportsAVX);
+  fextl::unique_ptr<FEXCore::IR::RegisterAllocationPass> CreateRegisterAllocationPass(FEXCore::IR::Pass* CompactionPass, bool OptimizeSRA, bool SupportsAVX, bool LinearScan) {
+    return fextl::make_unique<ConstrainedRAPass>(CompactionPass, OptimizeSRA, SupportsAVX, LinearScan);
   }
 }
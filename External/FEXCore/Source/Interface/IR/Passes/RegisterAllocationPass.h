@@ -7,6 +7,8 @@ $end_info$
 #pragma once
 #include "Interface/IR/PassManager.h"
 
+#include <FEXCore/Utils/BumpArena.h>
+
 #include <memory>
 #include <stdint.h>
 
@@ -46,11 +48,18 @@ class RegisterAllocationPass : public FEXCore::IR::Pass {
     virtual RegisterAllocationData *GetAllocationData() = 0;
 
     /**
-     * @brief Returns and transfers ownership of the register and class map array
+     * @brief Returns a copy of the register and class map array allocated in Arena
+     *
+     * The pass keeps reusing its own array, the copy is valid until the arena is reset
      */
-    virtual std::unique_ptr<RegisterAllocationData, RegisterAllocationDataDeleter> PullAllocationData() = 0;
+    virtual std::unique_ptr<RegisterAllocationData, RegisterAllocationDataDeleter> CopyAllocationData(FEXCore::Utils::BumpArena &Arena) = 0;
     /**  @} */
 
+    /**
+     * @brief Counts every spill iteration in to Stat
+     */
+    void RegisterSpillStat(FEXCore::CompileStats::Stat *Stat) { SpillStat = Stat; }
+
   protected:
     bool HasSpills {};
     // Debug option to disable split slot reuse
@@ -58,6 +67,7 @@ class RegisterAllocationPass : public FEXCore::IR::Pass {
     constexpr static bool ReuseSpillSlots {true};
     uint32_t SpillSlotCount {};
     bool HadFullRA {};
+    FEXCore::CompileStats::Stat *SpillStat {};
 };
 
 }
@@ -0,0 +1,111 @@
+/*
+$info$
+tags: ir|opts
+desc: Removes redundant host rounding mode changes and folds known rounding modes in to conversions
+$end_info$
+*/
+
+#include "Interface/IR/PassManager.h"
+
+#include <FEXCore/IR/IR.h>
+#include <FEXCore/IR/IREmitter.h>
+#include <FEXCore/IR/IntrusiveIRList.h>
+#include <FEXCore/Utils/Profiler.h>
+
+#include <memory>
+#include <optional>
+#include <stdint.h>
+
+namespace FEXCore::IR {
+
+class RoundingModeElimination final : public FEXCore::IR::Pass {
+public:
+  bool Run(IREmitter *IREmit) override;
+};
+
+/**
+ * @brief Tracks the host rounding mode through each block
+ *
+ * LDMXCSR, FLDCW and friends all end up as a SetRoundingMode, which is an FPCR read-modify-write on the host.
+ * Code that switches the mode around a numeric section often sets the same mode again, which is dropped here.
+ * Once the mode is a known constant, rounds using the host mode are given the explicit mode instead
+ * and reading back the mode is folded to the constant.
+ *
+ * Nothing is known at the start of a block or after anything that leaves the JIT.
+ */
+bool RoundingModeElimination::Run(IREmitter *IREmit) {
+  FEXCORE_PROFILE_SCOPED("PassManager::RoundingModeElimination");
+
+  // Guest rounding mode bits as used by SetRoundingMode, rounding control, FTZ and DAZ
+  constexpr uint64_t ModeMask = 0b1111;
+
+  bool Changed = false;
+  auto CurrentIR = IREmit->ViewIR();
+
+  for (auto [BlockNode, BlockHeader] : CurrentIR.GetBlocks()) {
+    // Value of the last SetRoundingMode in the block
+    OrderedNode *CurrentValue {};
+    std::optional<uint64_t> CurrentConstant {};
+
+    for (auto [CodeNode, IROp] : CurrentIR.GetCode(BlockNode)) {
+      switch (IROp->Op) {
+        case OP_SETROUNDINGMODE: {
+          auto Op = IROp->C<IROp_SetRoundingMode>();
+          auto Value = IREmit->UnwrapNode(Op->RoundMode);
+
+          uint64_t Constant {};
+          std::optional<uint64_t> NewConstant {};
+          if (IREmit->IsValueConstant(Op->RoundMode, &Constant)) {
+            NewConstant = Constant & ModeMask;
+          }
+
+          if ((CurrentValue && CurrentValue == Value) || (CurrentConstant && CurrentConstant == NewConstant)) {
+            IREmit->Remove(CodeNode);
+            Changed = true;
+            break;
+          }
+
+          CurrentValue = Value;
+          CurrentConstant = NewConstant;
+          break;
+        }
+        case OP_GETROUNDINGMODE: {
+          if (CurrentConstant) {
+            IREmit->SetWriteCursor(CodeNode);
+            IREmit->ReplaceAllUsesWith(CodeNode, IREmit->_Constant(*CurrentConstant));
+            Changed = true;
+          }
+          break;
+        }
+        case OP_VECTOR_FTOI: {
+          auto Op = IROp->CW<IROp_Vector_FToI>();
+          if (CurrentConstant && Op->Round == Round_Host) {
+            // Rounding control is the same encoding as the explicit round types
+            Op->Round = RoundType{static_cast<uint8_t>(*CurrentConstant & 0b11)};
+            Changed = true;
+          }
+          break;
+        }
+        case OP_SYSCALL:
+        case OP_INLINESYSCALL:
+        case OP_THUNK:
+        case OP_CALLBACKRETURN:
+        case OP_BREAK:
+          // Host code may change the rounding mode
+          CurrentValue = nullptr;
+          CurrentConstant.reset();
+          break;
+        default:
+          break;
+      }
+    }
+  }
+
+  return Changed;
+}
+
+fextl::unique_ptr<FEXCore::IR::Pass> CreateRoundingModeElimination() {
+  return fextl::make_unique<RoundingModeElimination>();
+}
+
+}
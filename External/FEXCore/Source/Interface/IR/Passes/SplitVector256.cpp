@@ -0,0 +1,709 @@
+/*
+$info$
+tags: ir|opts
+desc: Splits 256-bit vector ops in to pairs of 128-bit ops for hosts without SVE256
+$end_info$
+*/
+
+#include "Interface/IR/PassManager.h"
+
+#include <FEXCore/Core/CoreState.h>
+#include <FEXCore/IR/IR.h>
+#include <FEXCore/IR/IREmitter.h>
+#include <FEXCore/IR/IntrusiveIRList.h>
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/Utils/Profiler.h>
+#include <FEXCore/fextl/unordered_map.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <stdint.h>
+#include <string.h>
+
+namespace FEXCore::IR {
+
+namespace {
+  constexpr uint8_t AVX_SIZE = Core::CPUState::XMM_AVX_REG_SIZE;
+  constexpr uint8_t HALF_SIZE = Core::CPUState::XMM_SSE_REG_SIZE;
+  // VBSL has the most sources of the cloned ops
+  constexpr size_t MAX_CLONE_ARGS = 3;
+
+  struct Halves {
+    OrderedNode *Lo;
+    OrderedNode *Hi;
+  };
+
+  // Ops where each element of the result only depends on the same element of the sources
+  bool IsElementWise(IROps Op) {
+    switch (Op) {
+      case OP_VMOV:
+      case OP_VNEG:
+      case OP_VNOT:
+      case OP_VABS:
+      case OP_VPOPCOUNT:
+      case OP_VFNEG:
+      case OP_VFRECP:
+      case OP_VFSQRT:
+      case OP_VFRSQRT:
+      case OP_VCMPEQZ:
+      case OP_VCMPGTZ:
+      case OP_VCMPLTZ:
+      case OP_VSHLI:
+      case OP_VUSHRI:
+      case OP_VSSHRI:
+      case OP_VREV64:
+      // Pairs of elements never cross a 128-bit lane
+      case OP_VTRN:
+      case OP_VTRN2:
+      case OP_VADD:
+      case OP_VSUB:
+      case OP_VAND:
+      case OP_VBIC:
+      case OP_VOR:
+      case OP_VXOR:
+      case OP_VUQADD:
+      case OP_VUQSUB:
+      case OP_VSQADD:
+      case OP_VSQSUB:
+      case OP_VURAVG:
+      case OP_VUMIN:
+      case OP_VUMAX:
+      case OP_VSMIN:
+      case OP_VSMAX:
+      case OP_VFADD:
+      case OP_VFSUB:
+      case OP_VFMUL:
+      case OP_VFDIV:
+      case OP_VFMIN:
+      case OP_VFMAX:
+      case OP_VUMUL:
+      case OP_VSMUL:
+      case OP_VUSHL:
+      case OP_VUSHR:
+      case OP_VSSHR:
+      case OP_VCMPEQ:
+      case OP_VCMPGT:
+      case OP_VFCMPEQ:
+      case OP_VFCMPNEQ:
+      case OP_VFCMPLT:
+      case OP_VFCMPGT:
+      case OP_VFCMPLE:
+      case OP_VFCMPORD:
+      case OP_VFCMPUNO:
+      case OP_VBSL:
+      case OP_VECTOR_STOF:
+      case OP_VECTOR_FTOS:
+      case OP_VECTOR_FTOZS:
+      case OP_VECTOR_FTOI:
+      // AES works on each 128-bit lane on its own
+      case OP_VAESENC:
+      case OP_VAESENCLAST:
+      case OP_VAESDEC:
+      case OP_VAESDECLAST:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  // Shifts by the low element of a 128-bit vector
+  bool IsScalarShift(IROps Op) {
+    return Op == OP_VUSHLS || Op == OP_VUSHRS || Op == OP_VSSHRS;
+  }
+
+  // Ops without vector sources that produce the same value in both halves
+  bool IsBroadcast(IROps Op) {
+    return Op == OP_VECTORZERO || Op == OP_VECTORIMM || Op == OP_VDUPFROMGPR;
+  }
+
+  // Widening ops, as the variants that widen the lower and upper half of a 128-bit source
+  struct WideningPair {
+    IROps Lower;
+    IROps Upper;
+  };
+
+  constexpr std::array<WideningPair, 5> WideningOps {{
+    {OP_VSXTL, OP_VSXTL2},
+    {OP_VUXTL, OP_VUXTL2},
+    {OP_VSMULL, OP_VSMULL2},
+    {OP_VUMULL, OP_VUMULL2},
+    {OP_VUABDL, OP_VUABDL2},
+  }};
+
+  const WideningPair *FindWidening(IROps Op) {
+    for (const auto &Pair : WideningOps) {
+      if (Op == Pair.Lower || Op == Pair.Upper) {
+        return &Pair;
+      }
+    }
+    return nullptr;
+  }
+}
+
+class SplitVector256 final : public FEXCore::IR::Pass {
+public:
+  bool Run(IREmitter *IREmit) override;
+
+private:
+  OrderedNode *GetZero(IREmitter *IREmit);
+  OrderedNode *GetHalf(IREmitter *IREmit, OrderedNodeWrapper Arg, bool Hi);
+  OrderedNode *CloneHalf(IREmitter *IREmit, const IROp_Header *IROp, IROps NewOp, bool Hi, uint8_t SplitArgs);
+  bool SplitOp(IREmitter *IREmit, OrderedNode *CodeNode, IROp_Header *IROp);
+
+  OrderedNode *LoadUpper(IREmitter *IREmit, uint32_t Offset);
+  void StoreUpper(IREmitter *IREmit, OrderedNode *Value, uint32_t Offset);
+  void InvalidateUppers(uint32_t Offset, uint8_t Size);
+
+  fextl::unordered_map<OrderedNode *, Halves> Split;
+  fextl::vector<OrderedNode *> Dead;
+  // Upper half of values that were never 256-bit, created once per block
+  OrderedNode *Zero{};
+  // Value the context holds for an upper half, by context offset, within the current block
+  fextl::unordered_map<uint32_t, OrderedNode *> KnownUppers;
+  // Upper half loads this pass created, removed again if nothing reads them
+  fextl::vector<OrderedNode *> UpperLoads;
+};
+
+OrderedNode *SplitVector256::GetZero(IREmitter *IREmit) {
+  if (!Zero) {
+    Zero = IREmit->_VectorZero(HALF_SIZE);
+  }
+  return Zero;
+}
+
+OrderedNode *SplitVector256::GetHalf(IREmitter *IREmit, OrderedNodeWrapper Arg, bool Hi) {
+  auto Node = IREmit->UnwrapNode(Arg);
+  if (auto it = Split.find(Node); it != Split.end()) {
+    return Hi ? it->second.Hi : it->second.Lo;
+  }
+
+  if (!Hi) {
+    return Node;
+  }
+
+  // Anything narrower than 256-bit has a zeroed upper half
+  LOGMAN_THROW_AA_FMT(IREmit->GetOpSize(Node) < AVX_SIZE, "256-bit {} wasn't split", IR::GetName(IREmit->GetOpHeader(Arg)->Op));
+  return GetZero(IREmit);
+}
+
+OrderedNode *SplitVector256::CloneHalf(IREmitter *IREmit, const IROp_Header *IROp, IROps NewOp, bool Hi, uint8_t SplitArgs) {
+  const auto OpSize = IR::GetSize(IROp->Op);
+  const uint8_t NumArgs = IR::GetArgs(IROp->Op);
+
+  // Resolve the sources first, a zero upper half needs to be emitted before the new op
+  std::array<OrderedNode *, MAX_CLONE_ARGS> Args{};
+  LOGMAN_THROW_AA_FMT(NumArgs <= Args.size(), "Too many args to split {}", IR::GetName(IROp->Op));
+  for (uint8_t i = 0; i < NumArgs; ++i) {
+    Args[i] = GetHalf(IREmit, IROp->Args[i], i < SplitArgs && Hi);
+  }
+
+  auto Clone = IREmit->AllocateRawOp(OpSize);
+  memcpy(Clone.first, IROp, OpSize);
+  Clone.first->Op = NewOp;
+  Clone.first->Size = HALF_SIZE;
+
+  for (uint8_t i = 0; i < NumArgs; ++i) {
+    // The copied args don't own a use yet
+    IREmit->UnwrapNode(IROp->Args[i])->AddUse();
+    IREmit->ReplaceNodeArgument(Clone.Node, i, Args[i]);
+  }
+
+  return Clone.Node;
+}
+
+OrderedNode *SplitVector256::LoadUpper(IREmitter *IREmit, uint32_t Offset) {
+  if (auto it = KnownUppers.find(Offset); it != KnownUppers.end()) {
+    return it->second;
+  }
+
+  auto Value = IREmit->_LoadContext(HALF_SIZE, FPRClass, Offset);
+  KnownUppers[Offset] = Value;
+  UpperLoads.emplace_back(Value);
+  return Value;
+}
+
+void SplitVector256::StoreUpper(IREmitter *IREmit, OrderedNode *Value, uint32_t Offset) {
+  // The context already holds this value, eg. a second VZEROUPPER or a 256-bit op that only changed the lower half
+  if (auto it = KnownUppers.find(Offset); it != KnownUppers.end() && it->second == Value) {
+    return;
+  }
+
+  IREmit->_StoreContext(HALF_SIZE, FPRClass, Value, Offset);
+  KnownUppers[Offset] = Value;
+}
+
+void SplitVector256::InvalidateUppers(uint32_t Offset, uint8_t Size) {
+  for (auto it = KnownUppers.begin(); it != KnownUppers.end();) {
+    if (Offset < it->first + HALF_SIZE && it->first < Offset + Size) {
+      it = KnownUppers.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+}
+
+bool SplitVector256::SplitOp(IREmitter *IREmit, OrderedNode *CodeNode, IROp_Header *IROp) {
+  const auto Op = IROp->Op;
+  const uint8_t NumArgs = IR::GetArgs(Op);
+  IREmit->SetWriteCursor(CodeNode);
+
+  auto GetOffset = [IREmit](OrderedNodeWrapper Offset) {
+    return Offset.IsInvalid() ? IREmit->Invalid() : IREmit->UnwrapNode(Offset);
+  };
+  auto GetHiAddress = [IREmit](OrderedNodeWrapper Addr) -> OrderedNode* {
+    // Base + 16 keeps any selected offset, scale and extension valid
+    return IREmit->_Add(IREmit->UnwrapNode(Addr), IREmit->_Constant(HALF_SIZE));
+  };
+  struct MemOperand {
+    OrderedNode *Addr;
+    OrderedNode *Offset;
+  };
+  // ConstProp has already run, so the upper half's +16 is folded in to the immediate offset here where LDR/STR can encode it
+  auto GetHiMemOperand = [IREmit, &GetOffset, &GetHiAddress](OrderedNodeWrapper Addr, OrderedNodeWrapper Offset, MemOffsetType OffsetType, uint8_t OffsetScale) -> MemOperand {
+    uint64_t Const = 0;
+    const bool HasConstOffset = OffsetScale == 1 &&
+      (Offset.IsInvalid() || (OffsetType == MEM_OFFSET_SXTX && IREmit->GetOpHeader(Offset)->Op == OP_INLINECONSTANT));
+    if (HasConstOffset) {
+      if (!Offset.IsInvalid()) {
+        Const = IREmit->GetOpHeader(Offset)->C<IROp_InlineConstant>()->Constant;
+      }
+      const int64_t HiConst = static_cast<int64_t>(Const) + HALF_SIZE;
+      // Same range as ConstProp's inlined offsets for 16-byte accesses
+      if ((HiConst >= -255 && HiConst <= 256) || (HiConst > 0 && (HiConst % HALF_SIZE) == 0 && HiConst / HALF_SIZE <= 4095)) {
+        return {IREmit->UnwrapNode(Addr), IREmit->_InlineConstant(HiConst)};
+      }
+    }
+    return {GetHiAddress(Addr), GetOffset(Offset)};
+  };
+
+  Halves Result{};
+  bool HasResult = true;
+
+  if (IsElementWise(Op) || IsScalarShift(Op)) {
+    const uint8_t SplitArgs = IsScalarShift(Op) ? 1 : NumArgs;
+    Result.Lo = CloneHalf(IREmit, IROp, Op, false, SplitArgs);
+    Result.Hi = CloneHalf(IREmit, IROp, Op, true, SplitArgs);
+  }
+  else if (IsBroadcast(Op)) {
+    // Both halves hold the same value
+    Result.Lo = CloneHalf(IREmit, IROp, Op, false, 0);
+    Result.Hi = Result.Lo;
+  }
+  else if (auto Widening = FindWidening(Op)) {
+    // Both halves of the result widen the same 128-bit half of the sources, the pair variants share a layout
+    const bool SrcHi = Op == Widening->Upper;
+    Result.Lo = CloneHalf(IREmit, IROp, Widening->Lower, SrcHi, NumArgs);
+    Result.Hi = CloneHalf(IREmit, IROp, Widening->Upper, SrcHi, NumArgs);
+  }
+  else {
+    switch (Op) {
+      case OP_VDUPELEMENT: {
+        auto DupOp = IROp->C<IROp_VDupElement>();
+        const uint8_t Elements = HALF_SIZE / IROp->ElementSize;
+        auto Src = GetHalf(IREmit, DupOp->Vector, DupOp->Index >= Elements);
+        if (IROp->ElementSize == HALF_SIZE) {
+          // Duplicating a whole 128-bit lane
+          Result = {Src, Src};
+          break;
+        }
+        Result.Lo = IREmit->_VDupElement(HALF_SIZE, IROp->ElementSize, Src, DupOp->Index % Elements);
+        Result.Hi = IREmit->_VDupElement(HALF_SIZE, IROp->ElementSize, Src, DupOp->Index % Elements);
+        break;
+      }
+      case OP_VINSELEMENT: {
+        auto InsOp = IROp->C<IROp_VInsElement>();
+        const uint8_t Elements = HALF_SIZE / IROp->ElementSize;
+        const bool DestHi = InsOp->DestIdx >= Elements;
+        auto Src = GetHalf(IREmit, InsOp->SrcVector, InsOp->SrcIdx >= Elements);
+        auto Dest = GetHalf(IREmit, InsOp->DestVector, DestHi);
+        // Inserting a whole 128-bit lane replaces that half
+        auto Inserted = IROp->ElementSize == HALF_SIZE ? Src :
+          IREmit->_VInsElement(HALF_SIZE, IROp->ElementSize, InsOp->DestIdx % Elements, InsOp->SrcIdx % Elements, Dest, Src);
+        auto Other = GetHalf(IREmit, InsOp->DestVector, !DestHi);
+        Result = DestHi ? Halves{Other, Inserted} : Halves{Inserted, Other};
+        break;
+      }
+      case OP_VINSGPR: {
+        auto InsOp = IROp->C<IROp_VInsGPR>();
+        const uint8_t Elements = HALF_SIZE / IROp->ElementSize;
+        const bool DestHi = InsOp->DestIdx >= Elements;
+        auto Dest = GetHalf(IREmit, InsOp->DestVector, DestHi);
+        auto Inserted = IREmit->_VInsGPR(HALF_SIZE, IROp->ElementSize, InsOp->DestIdx % Elements, Dest, IREmit->UnwrapNode(InsOp->Src));
+        auto Other = GetHalf(IREmit, InsOp->DestVector, !DestHi);
+        Result = DestHi ? Halves{Other, Inserted} : Halves{Inserted, Other};
+        break;
+      }
+      case OP_LOADCONTEXT: {
+        auto LoadOp = IROp->C<IROp_LoadContext>();
+        Result.Lo = IREmit->_LoadContext(HALF_SIZE, FPRClass, LoadOp->Offset);
+        Result.Hi = LoadUpper(IREmit, LoadOp->Offset + HALF_SIZE);
+        break;
+      }
+      case OP_STORECONTEXT: {
+        auto StoreOp = IROp->C<IROp_StoreContext>();
+        IREmit->_StoreContext(HALF_SIZE, FPRClass, GetHalf(IREmit, StoreOp->Value, false), StoreOp->Offset);
+        StoreUpper(IREmit, GetHalf(IREmit, StoreOp->Value, true), StoreOp->Offset + HALF_SIZE);
+        HasResult = false;
+        break;
+      }
+      case OP_LOADREGISTER: {
+        // Only the lower half lives in the static register, the upper half stays in the context
+        auto LoadOp = IROp->C<IROp_LoadRegister>();
+        Result.Lo = IREmit->_LoadRegister(false, LoadOp->Offset, FPRClass, FPRFixedClass, HALF_SIZE);
+        Result.Hi = LoadUpper(IREmit, LoadOp->Offset + HALF_SIZE);
+        break;
+      }
+      case OP_STOREREGISTER: {
+        auto StoreOp = IROp->C<IROp_StoreRegister>();
+        IREmit->_StoreRegister(GetHalf(IREmit, StoreOp->Value, false), false, StoreOp->Offset, FPRClass, FPRFixedClass, HALF_SIZE);
+        StoreUpper(IREmit, GetHalf(IREmit, StoreOp->Value, true), StoreOp->Offset + HALF_SIZE);
+        HasResult = false;
+        break;
+      }
+      case OP_LOADMEM:
+      case OP_LOADMEMTSO: {
+        // Both ops share a layout
+        auto LoadOp = IROp->C<IROp_LoadMem>();
+        const uint8_t Align = std::min(LoadOp->Align, HALF_SIZE);
+        auto Offset = GetOffset(LoadOp->Offset);
+        if (Op == OP_LOADMEM) {
+          auto Hi = GetHiMemOperand(LoadOp->Addr, LoadOp->Offset, LoadOp->OffsetType, LoadOp->OffsetScale);
+          Result.Lo = IREmit->_LoadMem(FPRClass, HALF_SIZE, IREmit->UnwrapNode(LoadOp->Addr), Offset, Align, LoadOp->OffsetType, LoadOp->OffsetScale);
+          Result.Hi = IREmit->_LoadMem(FPRClass, HALF_SIZE, Hi.Addr, Hi.Offset, Align, LoadOp->OffsetType, LoadOp->OffsetScale);
+        }
+        else {
+          auto HiAddr = GetHiAddress(LoadOp->Addr);
+          Result.Lo = IREmit->_LoadMemTSO(FPRClass, HALF_SIZE, IREmit->UnwrapNode(LoadOp->Addr), Offset, Align, LoadOp->OffsetType, LoadOp->OffsetScale);
+          Result.Hi = IREmit->_LoadMemTSO(FPRClass, HALF_SIZE, HiAddr, Offset, Align, LoadOp->OffsetType, LoadOp->OffsetScale);
+        }
+        break;
+      }
+      case OP_STOREMEM:
+      case OP_STOREMEMTSO: {
+        auto StoreOp = IROp->C<IROp_StoreMem>();
+        const uint8_t Align = std::min(StoreOp->Align, HALF_SIZE);
+        auto Offset = GetOffset(StoreOp->Offset);
+        auto Lo = GetHalf(IREmit, StoreOp->Value, false);
+        auto Hi = GetHalf(IREmit, StoreOp->Value, true);
+        if (Op == OP_STOREMEM) {
+          auto HiMem = GetHiMemOperand(StoreOp->Addr, StoreOp->Offset, StoreOp->OffsetType, StoreOp->OffsetScale);
+          IREmit->_StoreMem(FPRClass, HALF_SIZE, Lo, IREmit->UnwrapNode(StoreOp->Addr), Offset, Align, StoreOp->OffsetType, StoreOp->OffsetScale);
+          IREmit->_StoreMem(FPRClass, HALF_SIZE, Hi, HiMem.Addr, HiMem.Offset, Align, StoreOp->OffsetType, StoreOp->OffsetScale);
+        }
+        else {
+          auto HiAddr = GetHiAddress(StoreOp->Addr);
+          IREmit->_StoreMemTSO(FPRClass, HALF_SIZE, Lo, IREmit->UnwrapNode(StoreOp->Addr), Offset, Align, StoreOp->OffsetType, StoreOp->OffsetScale);
+          IREmit->_StoreMemTSO(FPRClass, HALF_SIZE, Hi, HiAddr, Offset, Align, StoreOp->OffsetType, StoreOp->OffsetScale);
+        }
+        HasResult = false;
+        break;
+      }
+      case OP_VSQXTN:
+      case OP_VSQXTN2:
+      case OP_VSQXTUN:
+      case OP_VSQXTUN2:
+      case OP_VUSHRNI:
+      case OP_VUSHRNI2: {
+        // Narrowing a 256-bit source fills 128 bits, the "2" variants place it above the lower half of their first source
+        const bool Upper = Op == OP_VSQXTN2 || Op == OP_VSQXTUN2 || Op == OP_VUSHRNI2;
+        // The header holds the narrowed element size, the emitters take the source element size
+        const uint8_t ElementSize = IROp->ElementSize << 1;
+        auto SrcLo = GetHalf(IREmit, IROp->Args[Upper ? 1 : 0], false);
+        auto SrcHi = GetHalf(IREmit, IROp->Args[Upper ? 1 : 0], true);
+
+        OrderedNode *Narrowed{};
+        if (Op == OP_VSQXTN || Op == OP_VSQXTN2) {
+          Narrowed = IREmit->_VSQXTN2(HALF_SIZE, ElementSize, IREmit->_VSQXTN(HALF_SIZE, ElementSize, SrcLo), SrcHi);
+        }
+        else if (Op == OP_VSQXTUN || Op == OP_VSQXTUN2) {
+          Narrowed = IREmit->_VSQXTUN2(HALF_SIZE, ElementSize, IREmit->_VSQXTUN(HALF_SIZE, ElementSize, SrcLo), SrcHi);
+        }
+        else {
+          const uint8_t BitShift = Upper ? IROp->C<IROp_VUShrNI2>()->BitShift : IROp->C<IROp_VUShrNI>()->BitShift;
+          Narrowed = IREmit->_VUShrNI2(HALF_SIZE, ElementSize, IREmit->_VUShrNI(HALF_SIZE, ElementSize, SrcLo, BitShift), SrcHi, BitShift);
+        }
+
+        // Like SVE256, the single source variants repeat the result in the upper half
+        Result = Upper ? Halves{GetHalf(IREmit, IROp->Args[0], false), Narrowed} : Halves{Narrowed, Narrowed};
+        break;
+      }
+      case OP_VZIP:
+      case OP_VZIP2: {
+        // Interleaves one half of each source across the whole result
+        const bool SrcHi = Op == OP_VZIP2;
+        auto Lower = GetHalf(IREmit, IROp->Args[0], SrcHi);
+        auto Upper = GetHalf(IREmit, IROp->Args[1], SrcHi);
+        Result.Lo = IREmit->_VZip(HALF_SIZE, IROp->ElementSize, Lower, Upper);
+        Result.Hi = IREmit->_VZip2(HALF_SIZE, IROp->ElementSize, Lower, Upper);
+        break;
+      }
+      case OP_VUNZIP:
+      case OP_VUNZIP2:
+      case OP_VADDP:
+      case OP_VFADDP: {
+        // Each half of the result only reads one of the sources, the pair variants share a layout
+        auto Lower = IROp->Args[0];
+        auto Upper = IROp->Args[1];
+        auto Combine = [&](OrderedNodeWrapper Src) -> OrderedNode* {
+          auto Lo = GetHalf(IREmit, Src, false);
+          auto Hi = GetHalf(IREmit, Src, true);
+          switch (Op) {
+            case OP_VUNZIP: return IREmit->_VUnZip(HALF_SIZE, IROp->ElementSize, Lo, Hi);
+            case OP_VUNZIP2: return IREmit->_VUnZip2(HALF_SIZE, IROp->ElementSize, Lo, Hi);
+            case OP_VADDP: return IREmit->_VAddP(HALF_SIZE, IROp->ElementSize, Lo, Hi);
+            default: return IREmit->_VFAddP(HALF_SIZE, IROp->ElementSize, Lo, Hi);
+          }
+        };
+        Result.Lo = Combine(Lower);
+        Result.Hi = Combine(Upper);
+        break;
+      }
+      case OP_VADDV: {
+        // Adding the halves first keeps the wrapping sum the same
+        auto Vector = IROp->C<IROp_VAddV>()->Vector;
+        auto Sum = IREmit->_VAdd(HALF_SIZE, IROp->ElementSize, GetHalf(IREmit, Vector, false), GetHalf(IREmit, Vector, true));
+        Result.Lo = IREmit->_VAddV(HALF_SIZE, IROp->ElementSize, Sum);
+        Result.Hi = GetZero(IREmit);
+        break;
+      }
+      case OP_VTBL1: {
+        // Indices past the first half of the table select from its upper half, out of range indices give zero in both lookups
+        auto TableOp = IROp->C<IROp_VTBL1>();
+        auto TableLo = GetHalf(IREmit, TableOp->VectorTable, false);
+        auto TableHi = GetHalf(IREmit, TableOp->VectorTable, true);
+        auto HalfIndex = IREmit->_VectorImm(HALF_SIZE, 1, HALF_SIZE);
+        auto Lookup = [&](OrderedNode *Indices) -> OrderedNode* {
+          auto Lo = IREmit->_VTBL1(HALF_SIZE, TableLo, Indices);
+          auto Hi = IREmit->_VTBL1(HALF_SIZE, TableHi, IREmit->_VSub(HALF_SIZE, 1, Indices, HalfIndex));
+          return IREmit->_VOr(HALF_SIZE, 1, Lo, Hi);
+        };
+        Result.Lo = Lookup(GetHalf(IREmit, TableOp->VectorIndices, false));
+        Result.Hi = Lookup(GetHalf(IREmit, TableOp->VectorIndices, true));
+        break;
+      }
+      case OP_VEXTR: {
+        // Reads 32 bytes from the concatenation of VectorUpper then VectorLower, past which it is zero
+        auto ExtrOp = IROp->C<IROp_VExtr>();
+        const std::array<OrderedNode *, 4> Quarters {
+          GetHalf(IREmit, ExtrOp->VectorUpper, false),
+          GetHalf(IREmit, ExtrOp->VectorUpper, true),
+          GetHalf(IREmit, ExtrOp->VectorLower, false),
+          GetHalf(IREmit, ExtrOp->VectorLower, true),
+        };
+        auto GetQuarter = [&](uint32_t Quarter) {
+          return Quarter < Quarters.size() ? Quarters[Quarter] : GetZero(IREmit);
+        };
+        auto Window = [&](uint32_t Byte) -> OrderedNode* {
+          const uint32_t Quarter = Byte / HALF_SIZE;
+          const uint8_t Offset = Byte % HALF_SIZE;
+          if (Offset == 0) {
+            return GetQuarter(Quarter);
+          }
+          return IREmit->_VExtr(HALF_SIZE, 1, GetQuarter(Quarter + 1), GetQuarter(Quarter), Offset);
+        };
+        const uint32_t Byte = ExtrOp->Index * IROp->ElementSize;
+        Result.Lo = Window(Byte);
+        Result.Hi = Window(Byte + HALF_SIZE);
+        break;
+      }
+      case OP_VECTOR_FTOF: {
+        auto ConvOp = IROp->C<IROp_Vector_FToF>();
+        const uint8_t DestElementSize = IROp->ElementSize;
+        const uint8_t SrcElementSize = ConvOp->SrcElementSize;
+        if (DestElementSize > SrcElementSize) {
+          // Widens the lower half of the source, the upper 64-bits are moved down for the upper half
+          auto Src = GetHalf(IREmit, ConvOp->Vector, false);
+          Result.Lo = IREmit->_Vector_FToF(HALF_SIZE, DestElementSize, Src, SrcElementSize);
+          Result.Hi = IREmit->_Vector_FToF(HALF_SIZE, DestElementSize, IREmit->_VDupElement(HALF_SIZE, 8, Src, 1), SrcElementSize);
+        }
+        else {
+          // Each half narrows to 64-bits, like SVE256 the result is repeated in the upper half
+          auto Lo = IREmit->_Vector_FToF(HALF_SIZE, DestElementSize, GetHalf(IREmit, ConvOp->Vector, false), SrcElementSize);
+          auto Hi = IREmit->_Vector_FToF(HALF_SIZE, DestElementSize, GetHalf(IREmit, ConvOp->Vector, true), SrcElementSize);
+          Result.Lo = IREmit->_VZip(HALF_SIZE, 8, Lo, Hi);
+          Result.Hi = Result.Lo;
+        }
+        break;
+      }
+      case OP_VLOADVECTORMASKED: {
+        auto LoadOp = IROp->C<IROp_VLoadVectorMasked>();
+        auto Offset = GetOffset(LoadOp->Offset);
+        auto HiAddr = GetHiAddress(LoadOp->Addr);
+        Result.Lo = IREmit->_VLoadVectorMasked(HALF_SIZE, IROp->ElementSize, GetHalf(IREmit, LoadOp->Mask, false),
+                                               IREmit->UnwrapNode(LoadOp->Addr), Offset, LoadOp->OffsetType, LoadOp->OffsetScale);
+        Result.Hi = IREmit->_VLoadVectorMasked(HALF_SIZE, IROp->ElementSize, GetHalf(IREmit, LoadOp->Mask, true),
+                                               HiAddr, Offset, LoadOp->OffsetType, LoadOp->OffsetScale);
+        break;
+      }
+      case OP_VSTOREVECTORMASKED: {
+        auto StoreOp = IROp->C<IROp_VStoreVectorMasked>();
+        auto Offset = GetOffset(StoreOp->Offset);
+        auto HiAddr = GetHiAddress(StoreOp->Addr);
+        IREmit->_VStoreVectorMasked(HALF_SIZE, IROp->ElementSize, GetHalf(IREmit, StoreOp->Mask, false), GetHalf(IREmit, StoreOp->Data, false),
+                                    IREmit->UnwrapNode(StoreOp->Addr), Offset, StoreOp->OffsetType, StoreOp->OffsetScale);
+        IREmit->_VStoreVectorMasked(HALF_SIZE, IROp->ElementSize, GetHalf(IREmit, StoreOp->Mask, true), GetHalf(IREmit, StoreOp->Data, true),
+                                    HiAddr, Offset, StoreOp->OffsetType, StoreOp->OffsetScale);
+        HasResult = false;
+        break;
+      }
+      case OP_VGATHER: {
+        auto GatherOp = IROp->C<IROp_VGather>();
+        const uint8_t ElementSize = IROp->ElementSize;
+        const uint8_t IndexElementSize = GatherOp->IndexElementSize;
+        auto Base = IREmit->UnwrapNode(GatherOp->Base);
+        auto Gather = [&](OrderedNode *Dest, OrderedNode *Mask, OrderedNode *Indices) -> OrderedNode* {
+          return IREmit->_VGather(HALF_SIZE, ElementSize, Dest, Mask, Base, Indices, IndexElementSize, GatherOp->Scale);
+        };
+        auto Dest = GetHalf(IREmit, GatherOp->Dest, false);
+        auto Mask = GetHalf(IREmit, GatherOp->Mask, false);
+        auto Indices = GetHalf(IREmit, GatherOp->Indices, false);
+
+        if (ElementSize == IndexElementSize) {
+          Result.Lo = Gather(Dest, Mask, Indices);
+          Result.Hi = Gather(GetHalf(IREmit, GatherOp->Dest, true), GetHalf(IREmit, GatherOp->Mask, true), GetHalf(IREmit, GatherOp->Indices, true));
+        }
+        else if (ElementSize > IndexElementSize) {
+          // The indices all come from the lower half, the upper two are moved down for the upper half
+          Result.Lo = Gather(Dest, Mask, Indices);
+          Result.Hi = Gather(GetHalf(IREmit, GatherOp->Dest, true), GetHalf(IREmit, GatherOp->Mask, true), IREmit->_VDupElement(HALF_SIZE, 8, Indices, 1));
+        }
+        else {
+          // Four words from four quadword indices, each half of the indices gathers 64-bits of the result
+          auto Lo = Gather(Dest, Mask, Indices);
+          auto Hi = Gather(IREmit->_VDupElement(HALF_SIZE, 8, Dest, 1), IREmit->_VDupElement(HALF_SIZE, 8, Mask, 1),
+                           GetHalf(IREmit, GatherOp->Indices, true));
+          Result.Lo = IREmit->_VZip(HALF_SIZE, 8, Lo, Hi);
+          Result.Hi = GetZero(IREmit);
+        }
+        break;
+      }
+      default:
+        LOGMAN_MSG_A_FMT("Can't split 256-bit {} in to 128-bit halves", IR::GetName(Op));
+        return false;
+    }
+  }
+
+  if (HasResult) {
+    Split[CodeNode] = Result;
+  }
+  Dead.emplace_back(CodeNode);
+  return true;
+}
+
+/**
+ * @brief This pass lowers 256-bit vector ops to pairs of 128-bit ops
+ *
+ * Without SVE256 the host vector registers are only 128-bit wide.
+ * When AVX is enabled on such a host every 256-bit value is split in to a lower and upper half,
+ * each its own SSA value, so the register allocator doesn't need to know about register pairs.
+ * The guest keeps the AVX register layout in the context. Static registers only hold the lower halves,
+ * the upper halves are loaded and stored through the context.
+ *
+ * Narrower users of a split value only see its lower half.
+ * A 256-bit user of a narrower value gets a zero upper half, matching what SVE256 does.
+ * Cross-lane ops are rebuilt from 128-bit ops that read the halves they need, anything else asserts.
+ *
+ * Within a block the value of each upper half in the context is tracked. After VZEROUPPER or a VEX.128 op
+ * the upper half is known to be zero, so later 256-bit reads of the register use a zero vector instead of
+ * loading it and storing zero again is dropped. Upper half loads that end up unused are removed.
+ */
+bool SplitVector256::Run(IREmitter *IREmit) {
+  FEXCORE_PROFILE_SCOPED("PassManager::SplitVector256");
+
+  bool Changed = false;
+  auto CurrentIR = IREmit->ViewIR();
+  auto OriginalWriteCursor = IREmit->GetWriteCursor();
+
+  Split.clear();
+  Dead.clear();
+  UpperLoads.clear();
+
+  for (auto [BlockNode, BlockHeader] : CurrentIR.GetBlocks()) {
+    Zero = nullptr;
+    KnownUppers.clear();
+
+    for (auto [CodeNode, IROp] : CurrentIR.GetCode(BlockNode)) {
+      switch (IROp->Op) {
+        case OP_STORECONTEXT:
+          if (IROp->Size != AVX_SIZE) {
+            // Also sees the halves this pass emits, those keep the tracked value
+            auto StoreOp = IROp->C<IROp_StoreContext>();
+            InvalidateUppers(StoreOp->Offset, IROp->Size);
+            if (IROp->Size == HALF_SIZE && StoreOp->Class == FPRClass) {
+              KnownUppers[StoreOp->Offset] = IREmit->UnwrapNode(StoreOp->Value);
+            }
+          }
+          break;
+        case OP_SYSCALL:
+        case OP_INLINESYSCALL: {
+          const auto Flags = IROp->Op == OP_SYSCALL ? IROp->C<IROp_Syscall>()->Flags : IROp->C<IROp_InlineSyscall>()->Flags;
+          if ((Flags & SyscallFlags::OPTIMIZETHROUGH) != SyscallFlags::OPTIMIZETHROUGH) {
+            KnownUppers.clear();
+          }
+          break;
+        }
+        case OP_STORECONTEXTINDEXED:
+        case OP_BREAK:
+          // Can't track through these
+          KnownUppers.clear();
+          break;
+        default:
+          break;
+      }
+
+      if (IROp->Op == OP_VEXTRACTTOGPR && Split.contains(IREmit->UnwrapNode(IROp->Args[0]))) {
+        // The op is only as wide as the element, the index decides which half is read
+        auto ExtractOp = IROp->CW<IROp_VExtractToGPR>();
+        const uint8_t Elements = HALF_SIZE / IROp->ElementSize;
+        auto Src = GetHalf(IREmit, ExtractOp->Vector, ExtractOp->Index >= Elements);
+        IREmit->ReplaceNodeArgument(CodeNode, IROp_VExtractToGPR::Vector_Index, Src);
+        ExtractOp->Index %= Elements;
+        Changed = true;
+        continue;
+      }
+
+      if (IROp->Size == AVX_SIZE) {
+        Changed |= SplitOp(IREmit, CodeNode, IROp);
+        continue;
+      }
+
+      // Narrower users only read the lower half
+      const uint8_t NumArgs = IR::GetArgs(IROp->Op);
+      for (uint8_t i = 0; i < NumArgs; ++i) {
+        if (IROp->Args[i].IsInvalid()) {
+          continue;
+        }
+
+        if (auto it = Split.find(IREmit->UnwrapNode(IROp->Args[i])); it != Split.end()) {
+          IREmit->ReplaceNodeArgument(CodeNode, i, it->second.Lo);
+          Changed = true;
+        }
+      }
+    }
+  }
+
+  // Users come after their sources, remove them first
+  for (auto it = Dead.rbegin(); it != Dead.rend(); ++it) {
+    auto Node = *it;
+    LOGMAN_THROW_AA_FMT(Node->GetUses() == 0, "Split 256-bit op still has uses");
+    IREmit->Remove(Node);
+  }
+
+  for (auto Node : UpperLoads) {
+    if (Node->GetUses() == 0) {
+      IREmit->Remove(Node);
+    }
+  }
+
+  IREmit->SetWriteCursor(OriginalWriteCursor);
+  return Changed;
+}
+
+fextl::unique_ptr<FEXCore::IR::Pass> CreateSplitVector256() {
+  return fextl::make_unique<SplitVector256>();
+}
+
+}
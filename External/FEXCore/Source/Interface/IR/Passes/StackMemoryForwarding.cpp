@@ -0,0 +1,261 @@
+/*
+$info$
+tags: ir|opts
+desc: Store to load forwarding and dead store elimination for guest stack accesses
+$end_info$
+*/
+
+#include "Interface/IR/PassManager.h"
+
+#include <FEXCore/Core/CoreState.h>
+#include <FEXCore/Core/X86Enums.h>
+#include <FEXCore/IR/IR.h>
+#include <FEXCore/IR/IREmitter.h>
+#include <FEXCore/IR/IntrusiveIRList.h>
+#include <FEXCore/Utils/Profiler.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <algorithm>
+#include <optional>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace FEXCore::IR {
+
+namespace {
+  constexpr uint32_t RSP_OFFSET = offsetof(FEXCore::Core::CPUState, gregs[FEXCore::X86State::REG_RSP]);
+  // Bounds the linear scans, blocks rarely keep more stack slots live than this
+  constexpr size_t MAX_TRACKED_SLOTS = 32;
+  // Nesting of constant Add/Sub walked back to find the stack pointer
+  constexpr size_t MAX_ADDRESS_DEPTH = 8;
+
+  struct StackAddress {
+    // The LoadRegister of RSP the address is relative to
+    OrderedNode *Root;
+    int64_t Offset;
+  };
+
+  struct StackSlot {
+    StackAddress Address;
+    uint8_t Size;
+    // The StoreMem that last wrote the slot
+    OrderedNode *Store;
+    OrderedNode *Value;
+    RegisterClassType Class;
+
+    bool Overlaps(const StackAddress &Other, uint8_t OtherSize) const {
+      return Address.Root == Other.Root &&
+             Address.Offset < Other.Offset + OtherSize &&
+             Other.Offset < Address.Offset + Size;
+    }
+  };
+
+  // Side effects that never touch guest memory
+  bool IsContextSideEffect(IROps Op) {
+    switch (Op) {
+      case OP_STOREREGISTER:
+      case OP_STORECONTEXT:
+      case OP_STORECONTEXTINDEXED:
+      case OP_STOREFLAG:
+      case OP_INVALIDATEFLAGS:
+      case OP_GUESTOPCODE:
+      // Only marked as side effects to keep DCE away from them
+      case OP_INLINECONSTANT:
+      case OP_INLINEENTRYPOINTOFFSET:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  // Memory reads that aren't marked as having side effects
+  bool ReadsMemory(IROps Op) {
+    switch (Op) {
+      case OP_LOADMEM:
+      case OP_LOADMEMTSO:
+      case OP_VLOADVECTORMASKED:
+      case OP_VGATHER:
+        return true;
+      default:
+        return false;
+    }
+  }
+}
+
+class StackMemoryForwarding final : public FEXCore::IR::Pass {
+public:
+  bool Run(IREmitter *IREmit) override;
+
+private:
+  std::optional<StackAddress> GetStackAddress(IREmitter *IREmit, OrderedNodeWrapper Addr, OrderedNodeWrapper Offset) const;
+};
+
+std::optional<StackAddress> StackMemoryForwarding::GetStackAddress(IREmitter *IREmit, OrderedNodeWrapper Addr, OrderedNodeWrapper Offset) const {
+  if (!Offset.IsInvalid()) {
+    return std::nullopt;
+  }
+
+  OrderedNode *Node = IREmit->UnwrapNode(Addr);
+  int64_t Displacement{};
+
+  for (size_t i = 0; i < MAX_ADDRESS_DEPTH; ++i) {
+    auto IROp = IREmit->GetOpHeader(IREmit->WrapNode(Node));
+    uint64_t Constant{};
+
+    if (IROp->Op == OP_ADD && IREmit->IsValueConstant(IROp->Args[1], &Constant)) {
+      Displacement += Constant;
+      Node = IREmit->UnwrapNode(IROp->Args[0]);
+    }
+    else if (IROp->Op == OP_ADD && IREmit->IsValueConstant(IROp->Args[0], &Constant)) {
+      Displacement += Constant;
+      Node = IREmit->UnwrapNode(IROp->Args[1]);
+    }
+    else if (IROp->Op == OP_SUB && IREmit->IsValueConstant(IROp->Args[1], &Constant)) {
+      Displacement -= Constant;
+      Node = IREmit->UnwrapNode(IROp->Args[0]);
+    }
+    else if (IROp->Op == OP_LOADREGISTER) {
+      auto Op = IROp->C<IROp_LoadRegister>();
+      if (Op->Offset != RSP_OFFSET || Op->Class != GPRClass) {
+        return std::nullopt;
+      }
+      return StackAddress {
+        .Root = Node,
+        .Offset = Displacement,
+      };
+    }
+    else {
+      return std::nullopt;
+    }
+  }
+
+  return std::nullopt;
+}
+
+/**
+ * @brief Forwards guest stack stores to the loads that read them back and removes stack stores that are overwritten
+ *
+ * x86 code spills and reloads through the stack constantly, every push/pop pair and [rsp+N] spill is a real memory
+ * access otherwise. Only accesses at a constant offset from RSP are tracked, on the assumption that no other thread
+ * writes a running function's stack. Anything else is treated as possibly aliasing the stack:
+ * - Any other store or side effect drops what's known about slot contents.
+ * - Any other memory read or side effect keeps the pending stores alive.
+ *
+ * Works on one block at a time, every stack store is kept alive at the end of a block.
+ */
+bool StackMemoryForwarding::Run(IREmitter *IREmit) {
+  FEXCORE_PROFILE_SCOPED("PassManager::StackMemoryForwarding");
+
+  bool Changed = false;
+  auto CurrentIR = IREmit->ViewIR();
+
+  // Slots with known contents
+  fextl::vector<StackSlot> Known;
+  // Stores that nothing has read yet, overwriting one of these completely makes it dead
+  fextl::vector<StackSlot> Pending;
+
+  for (auto [BlockNode, BlockHeader] : CurrentIR.GetBlocks()) {
+    Known.clear();
+    Pending.clear();
+
+    for (auto [CodeNode, IROp] : CurrentIR.GetCode(BlockNode)) {
+      if (IROp->Op == OP_STOREMEM) {
+        auto Op = IROp->C<IROp_StoreMem>();
+        auto Address = GetStackAddress(IREmit, Op->Addr, Op->Offset);
+
+        if (!Address) {
+          // Might write a stack slot, but doesn't read one
+          Known.clear();
+          continue;
+        }
+
+        // Stores this one completely covers are dead
+        std::erase_if(Pending, [&](const StackSlot &Slot) {
+          if (Slot.Address.Root == Address->Root &&
+              Slot.Address.Offset >= Address->Offset &&
+              Slot.Address.Offset + Slot.Size <= Address->Offset + IROp->Size) {
+            IREmit->Remove(Slot.Store);
+            Changed = true;
+            return true;
+          }
+          return false;
+        });
+
+        // A new root means RSP was changed in a way that isn't a constant adjustment, nothing older can be compared
+        std::erase_if(Known, [&](const StackSlot &Slot) { return Slot.Address.Root != Address->Root || Slot.Overlaps(*Address, IROp->Size); });
+        std::erase_if(Pending, [&](const StackSlot &Slot) { return Slot.Address.Root != Address->Root; });
+
+        const StackSlot Slot {
+          .Address = *Address,
+          .Size = IROp->Size,
+          .Store = CodeNode,
+          .Value = IREmit->UnwrapNode(Op->Value),
+          .Class = Op->Class,
+        };
+
+        if (Known.size() == MAX_TRACKED_SLOTS) {
+          Known.erase(Known.begin());
+        }
+        Known.emplace_back(Slot);
+
+        if (Pending.size() == MAX_TRACKED_SLOTS) {
+          Pending.erase(Pending.begin());
+        }
+        Pending.emplace_back(Slot);
+      }
+      else if (IROp->Op == OP_LOADMEM) {
+        auto Op = IROp->C<IROp_LoadMem>();
+        auto Address = GetStackAddress(IREmit, Op->Addr, Op->Offset);
+
+        if (!Address) {
+          // Might read any pending store
+          Pending.clear();
+          continue;
+        }
+
+        auto Slot = std::find_if(Known.begin(), Known.end(), [&](const StackSlot &Slot) {
+          // A value smaller than the store was zero extended by it
+          return Slot.Address.Root == Address->Root && Slot.Address.Offset == Address->Offset &&
+                 Slot.Size == IROp->Size && Slot.Class == Op->Class && IREmit->GetOpSize(Slot.Value) >= IROp->Size;
+        });
+
+        if (Slot == Known.end()) {
+          std::erase_if(Pending, [&](const StackSlot &Slot) { return Slot.Overlaps(*Address, IROp->Size); });
+          continue;
+        }
+
+        // The store truncated the value, the load zero extends it
+        OrderedNode *Value = Slot->Value;
+        IREmit->SetWriteCursor(CodeNode);
+        if (Op->Class == GPRClass && IROp->Size < 8) {
+          Value = IREmit->_Bfe(4, IROp->Size * 8, 0, Value);
+        }
+        else if (Op->Class == FPRClass && IREmit->GetOpSize(Value) > IROp->Size) {
+          Value = IREmit->_VMov(IROp->Size, Value);
+        }
+
+        IREmit->ReplaceAllUsesWith(CodeNode, Value);
+        Changed = true;
+      }
+      else if (IROp->Op == OP_STOREMEMTSO) {
+        Known.clear();
+      }
+      else if (ReadsMemory(IROp->Op)) {
+        Pending.clear();
+      }
+      else if (HasSideEffects(IROp->Op) && !IsContextSideEffect(IROp->Op)) {
+        // Calls out of the JIT, atomics, block exits
+        Known.clear();
+        Pending.clear();
+      }
+    }
+  }
+
+  return Changed;
+}
+
+fextl::unique_ptr<FEXCore::IR::Pass> CreateStackMemoryForwarding() {
+  return fextl::make_unique<StackMemoryForwarding>();
+}
+
+}
@@ -0,0 +1,150 @@
+/*
+$info$
+tags: ir|opts
+desc: Merges adjacent GPR stores to consecutive memory in to store pairs
+$end_info$
+*/
+
+#include "Interface/IR/PassManager.h"
+
+#include <FEXCore/IR/IR.h>
+#include <FEXCore/IR/IREmitter.h>
+#include <FEXCore/IR/IntrusiveIRList.h>
+#include <FEXCore/Utils/Profiler.h>
+
+#include <memory>
+#include <optional>
+#include <stdint.h>
+
+namespace FEXCore::IR {
+
+namespace {
+  // Side effects that never touch guest memory
+  bool IsContextSideEffect(IROps Op) {
+    switch (Op) {
+      case OP_STOREREGISTER:
+      case OP_STORECONTEXT:
+      case OP_STORECONTEXTINDEXED:
+      case OP_STOREFLAG:
+      case OP_INVALIDATEFLAGS:
+      case OP_GUESTOPCODE:
+      // Only marked as side effects to keep DCE away from them
+      case OP_INLINECONSTANT:
+      case OP_INLINEENTRYPOINTOFFSET:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  // Memory reads that aren't marked as having side effects
+  bool ReadsMemory(IROps Op) {
+    switch (Op) {
+      case OP_LOADMEM:
+      case OP_LOADMEMTSO:
+      case OP_VLOADVECTORMASKED:
+      case OP_VGATHER:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  // stp takes a signed 7-bit offset scaled by the access size
+  bool IsPairOffset(int64_t Offset, uint8_t Size) {
+    return (Offset % Size) == 0 && Offset >= -64 * Size && Offset <= 63 * Size;
+  }
+
+  struct PairableStore {
+    OrderedNode *Node;
+    OrderedNode *Value;
+    OrderedNode *Addr;
+    int64_t Offset;
+    uint8_t Size;
+  };
+}
+
+class StorePairing final : public FEXCore::IR::Pass {
+public:
+  bool Run(IREmitter *IREmit) override;
+
+private:
+  std::optional<PairableStore> GetPairableStore(IREmitter *IREmit, OrderedNode *CodeNode, IROp_Header *IROp) const;
+};
+
+std::optional<PairableStore> StorePairing::GetPairableStore(IREmitter *IREmit, OrderedNode *CodeNode, IROp_Header *IROp) const {
+  // TSO stores keep their own ordering and are never merged
+  if (IROp->Op != OP_STOREMEM) {
+    return std::nullopt;
+  }
+
+  auto Op = IROp->C<IROp_StoreMem>();
+  if (Op->Class != GPRClass || (IROp->Size != 4 && IROp->Size != 8) ||
+      Op->Offset.IsInvalid() || !IREmit->IsValueInlineConstant(Op->Offset)) {
+    return std::nullopt;
+  }
+
+  return PairableStore {
+    .Node = CodeNode,
+    .Value = IREmit->UnwrapNode(Op->Value),
+    .Addr = IREmit->UnwrapNode(Op->Addr),
+    .Offset = static_cast<int64_t>(IREmit->GetOpHeader(Op->Offset)->C<IROp_InlineConstant>()->Constant),
+    .Size = IROp->Size,
+  };
+}
+
+/**
+ * @brief Merges two GPR stores to neighbouring addresses off of the same base in to one StoreMemPair
+ *
+ * Runs of PUSH, and spills to consecutive stack slots, end up as stores at adjacent constant offsets from one
+ * base once AddressModeSelection and ConstProp are done with them. The first store of a pair is moved down to
+ * the second one, so only ops that don't touch guest memory may sit between them.
+ *
+ * Needs inline constant offsets, so this runs after ConstProp.
+ */
+bool StorePairing::Run(IREmitter *IREmit) {
+  FEXCORE_PROFILE_SCOPED("PassManager::StorePairing");
+
+  bool Changed = false;
+  auto CurrentIR = IREmit->ViewIR();
+
+  for (auto [BlockNode, BlockHeader] : CurrentIR.GetBlocks()) {
+    std::optional<PairableStore> Previous;
+
+    for (auto [CodeNode, IROp] : CurrentIR.GetCode(BlockNode)) {
+      auto Store = GetPairableStore(IREmit, CodeNode, IROp);
+
+      if (!Store) {
+        if ((HasSideEffects(IROp->Op) && !IsContextSideEffect(IROp->Op)) || ReadsMemory(IROp->Op)) {
+          Previous.reset();
+        }
+        continue;
+      }
+
+      if (Previous && Previous->Addr == Store->Addr && Previous->Size == Store->Size) {
+        const auto &Lower = Previous->Offset < Store->Offset ? *Previous : *Store;
+        const auto &Upper = Previous->Offset < Store->Offset ? *Store : *Previous;
+
+        if (Upper.Offset - Lower.Offset == Store->Size && IsPairOffset(Lower.Offset, Store->Size)) {
+          IREmit->SetWriteCursor(CodeNode);
+          IREmit->_StoreMemPair(Store->Size, Lower.Value, Upper.Value, Store->Addr, Lower.Offset);
+          IREmit->Remove(Previous->Node);
+          IREmit->Remove(CodeNode);
+          Previous.reset();
+          Changed = true;
+          continue;
+        }
+      }
+
+      Previous = Store;
+    }
+  }
+
+  return Changed;
+}
+
+fextl::unique_ptr<FEXCore::IR::Pass> CreateStorePairing() {
+  return fextl::make_unique<StorePairing>();
+}
+
+}
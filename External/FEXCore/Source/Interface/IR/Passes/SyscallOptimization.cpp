@@ -51,8 +51,25 @@ bool SyscallOptimization::Run(IREmitter *IREmit) {
             IREmit->ReplaceNodeArgument(CodeNode, Arg, IREmit->Invalid());
           }
 #ifdef _M_ARM_64
+          // Some syscalls only need argument conversion for some argument values, ask with the constant arguments
+          int32_t HostSyscallNumber = SyscallDef.HostSyscallNumber;
+          if ((SyscallFlags & FEXCore::IR::SyscallFlags::CACHEABLE) == FEXCore::IR::SyscallFlags::CACHEABLE) {
+            // Cached results are only served by the frontend
+            HostSyscallNumber = -1;
+          }
+          else if (HostSyscallNumber == -1) {
+            FEXCore::HLE::SyscallArguments ConstantArgs{};
+            uint32_t ConstantMask{};
+            for (uint8_t Arg = 0; Arg < SyscallDef.NumArgs; ++Arg) {
+              if (IREmit->IsValueConstant(IROp->Args[Arg + 1], &ConstantArgs.Argument[Arg])) {
+                ConstantMask |= 1U << Arg;
+              }
+            }
+            HostSyscallNumber = Manager->SyscallHandler->GetPassthroughHostSyscall(Constant, ConstantArgs, ConstantMask);
+          }
+
           // Replace syscall with inline passthrough syscall if we can
-          if (SyscallDef.HostSyscallNumber != -1) {
+          if (HostSyscallNumber != -1) {
             IREmit->SetWriteCursor(CodeNode);
             // Skip Args[0] since that is the syscallid
             auto InlineSyscall = IREmit->_InlineSyscall(
@@ -62,7 +79,7 @@ bool SyscallOptimization::Run(IREmitter *IREmit) {
               CurrentIR.GetNode(IROp->Args[4]),
               CurrentIR.GetNode(IROp->Args[5]),
               CurrentIR.GetNode(IROp->Args[6]),
-              SyscallDef.HostSyscallNumber,
+              HostSyscallNumber,
               Op->Flags);
 
             // Replace all syscall uses with this inline one
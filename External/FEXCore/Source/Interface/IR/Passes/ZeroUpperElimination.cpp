@@ -0,0 +1,272 @@
+/*
+$info$
+tags: ir|opts
+desc: Removes AVX upper half zeroing of registers that are known to already have a zero upper half
+$end_info$
+*/
+
+#include "Interface/IR/PassManager.h"
+
+#include <FEXCore/Core/CoreState.h>
+#include <FEXCore/IR/IR.h>
+#include <FEXCore/IR/IREmitter.h>
+#include <FEXCore/IR/IntrusiveIRList.h>
+#include <FEXCore/Utils/Profiler.h>
+#include <FEXCore/fextl/unordered_map.h>
+#include <FEXCore/fextl/unordered_set.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <optional>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace FEXCore::IR {
+
+namespace {
+  constexpr uint8_t AVX_SIZE = Core::CPUState::XMM_AVX_REG_SIZE;
+  constexpr uint8_t HALF_SIZE = Core::CPUState::XMM_SSE_REG_SIZE;
+  constexpr uint32_t NUM_XMMS = Core::CPUState::NUM_XMMS;
+  constexpr uint32_t XMM_BEGIN = offsetof(Core::CPUState, xmm.avx.data[0][0]);
+  constexpr uint32_t XMM_END = offsetof(Core::CPUState, xmm.avx.data[NUM_XMMS][0]);
+
+  // One bit per guest register
+  using RegisterMask = uint32_t;
+  constexpr RegisterMask ALL_REGISTERS = (1U << NUM_XMMS) - 1;
+
+  struct BlockInfo {
+    fextl::vector<OrderedNode *> Predecessors;
+    RegisterMask OutgoingZeroUppers{};
+    bool Visited{};
+  };
+}
+
+class ZeroUpperElimination final : public FEXCore::IR::Pass {
+public:
+  bool Run(IREmitter *IREmit) override;
+
+private:
+  void CalculatePredecessors(IREmitter *IREmit);
+  RegisterMask LoadBlockEntryState(IRListView *IR, NodeID BlockID);
+
+  // Mask of the registers an access overlaps
+  static RegisterMask AccessedRegisters(uint32_t Offset, uint32_t Size) {
+    if (Offset + Size <= XMM_BEGIN || Offset >= XMM_END) {
+      return 0;
+    }
+
+    const uint32_t Begin = (std::max(Offset, XMM_BEGIN) - XMM_BEGIN) / AVX_SIZE;
+    const uint32_t End = (std::min(Offset + Size, XMM_END) - XMM_BEGIN + AVX_SIZE - 1) / AVX_SIZE;
+    return ((1U << End) - 1) & ~((1U << Begin) - 1);
+  }
+
+  // Full register access, returns the register index
+  static std::optional<uint32_t> FullRegister(uint32_t Offset, uint8_t Size) {
+    if (Size != AVX_SIZE || Offset < XMM_BEGIN || Offset >= XMM_END || (Offset - XMM_BEGIN) % AVX_SIZE) {
+      return std::nullopt;
+    }
+    return (Offset - XMM_BEGIN) / AVX_SIZE;
+  }
+
+  fextl::unordered_map<NodeID, BlockInfo> Blocks;
+  // Values whose upper half is zero
+  fextl::unordered_set<OrderedNode *> ZeroUpperValues;
+};
+
+void ZeroUpperElimination::CalculatePredecessors(IREmitter *IREmit) {
+  auto CurrentIR = IREmit->ViewIR();
+
+  for (auto [BlockNode, BlockHeader] : CurrentIR.GetBlocks()) {
+    for (auto [CodeNode, IROp] : CurrentIR.GetCode(BlockNode)) {
+      if (IROp->Op == OP_CONDJUMP) {
+        auto Op = IROp->C<IROp_CondJump>();
+        Blocks[Op->TrueBlock.ID()].Predecessors.emplace_back(BlockNode);
+        Blocks[Op->FalseBlock.ID()].Predecessors.emplace_back(BlockNode);
+      }
+      else if (IROp->Op == OP_JUMP) {
+        Blocks[IROp->Args[0].ID()].Predecessors.emplace_back(BlockNode);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Registers with a zero upper half on every path in to the block
+ *
+ * Blocks are visited in IR order, a predecessor that hasn't been visited yet (a loop back edge) knows nothing.
+ */
+RegisterMask ZeroUpperElimination::LoadBlockEntryState(IRListView *IR, NodeID BlockID) {
+  auto &Predecessors = Blocks[BlockID].Predecessors;
+  if (Predecessors.empty()) {
+    return 0;
+  }
+
+  RegisterMask Mask = ALL_REGISTERS;
+  for (auto Predecessor : Predecessors) {
+    auto &Info = Blocks[IR->GetID(Predecessor)];
+    if (!Info.Visited) {
+      return 0;
+    }
+    Mask &= Info.OutgoingZeroUppers;
+  }
+  return Mask;
+}
+
+/**
+ * @brief This pass removes writes that only zero an AVX upper half that is already zero
+ *
+ * VZEROUPPER is emitted as a 128-bit move of every register written back to the full register,
+ * and compilers emit it at function entry and before every call. Once a register's upper half is known to be
+ * zero, storing the unchanged lower half back is a no-op.
+ * A register's upper half is known to be zero after a VEX.128 write, VZEROUPPER or VZEROALL, tracked across
+ * the blocks of a multiblock.
+ *
+ * The zeroing move of a VEX.128 op is still required, it zeroes the upper half of the new value, but zeroing
+ * a value that already had its upper half zeroed is dropped.
+ */
+bool ZeroUpperElimination::Run(IREmitter *IREmit) {
+  FEXCORE_PROFILE_SCOPED("PassManager::ZeroUpperElimination");
+
+  bool Changed = false;
+  auto CurrentIR = IREmit->ViewIR();
+
+  Blocks.clear();
+  ZeroUpperValues.clear();
+  CalculatePredecessors(IREmit);
+
+  for (auto [BlockNode, BlockHeader] : CurrentIR.GetBlocks()) {
+    const auto BlockID = CurrentIR.GetID(BlockNode);
+    RegisterMask ZeroUppers = LoadBlockEntryState(&CurrentIR, BlockID);
+    // What each register holds, only within the block
+    std::array<OrderedNode *, NUM_XMMS> Current{};
+
+    auto Invalidate = [&](RegisterMask Mask) {
+      ZeroUppers &= ~Mask;
+      for (uint32_t i = 0; i < NUM_XMMS; ++i) {
+        if (Mask & (1U << i)) {
+          Current[i] = nullptr;
+        }
+      }
+    };
+
+    auto Load = [&](OrderedNode *CodeNode, std::optional<uint32_t> Reg) {
+      if (Reg) {
+        Current[*Reg] = CodeNode;
+        if (ZeroUppers & (1U << *Reg)) {
+          ZeroUpperValues.insert(CodeNode);
+        }
+      }
+    };
+
+    auto Store = [&](OrderedNode *CodeNode, OrderedNode *Value, uint32_t Offset, uint8_t Size) -> bool {
+      const auto Reg = FullRegister(Offset, Size);
+      if (!Reg) {
+        Invalidate(AccessedRegisters(Offset, Size));
+        return false;
+      }
+
+      const auto Bit = 1U << *Reg;
+      const bool ZeroUpper = ZeroUpperValues.contains(Value);
+
+      // Writing back the zero extended lower half of a register with a zero upper half
+      auto ValueOp = IREmit->GetOpHeader(IREmit->WrapNode(Value));
+      if ((ZeroUppers & Bit) && Current[*Reg] &&
+          (Value == Current[*Reg] ||
+           (ValueOp->Op == OP_VMOV && ValueOp->Size == HALF_SIZE && IREmit->UnwrapNode(ValueOp->Args[0]) == Current[*Reg]))) {
+        IREmit->Remove(CodeNode);
+        return true;
+      }
+
+      ZeroUppers = ZeroUpper ? (ZeroUppers | Bit) : (ZeroUppers & ~Bit);
+      Current[*Reg] = Value;
+      return false;
+    };
+
+    for (auto [CodeNode, IROp] : CurrentIR.GetCode(BlockNode)) {
+      switch (IROp->Op) {
+        case OP_VECTORZERO:
+          ZeroUpperValues.insert(CodeNode);
+          break;
+        case OP_VMOV: {
+          if (IROp->Size != HALF_SIZE) {
+            break;
+          }
+
+          // Zeroing a value that was already zeroed
+          auto Src = IREmit->UnwrapNode(IROp->Args[0]);
+          auto SrcOp = IREmit->GetOpHeader(IROp->Args[0]);
+          if (SrcOp->Size == HALF_SIZE && (SrcOp->Op == OP_VMOV || SrcOp->Op == OP_VECTORZERO)) {
+            IREmit->ReplaceAllUsesWith(CodeNode, Src);
+            Changed = true;
+            break;
+          }
+          ZeroUpperValues.insert(CodeNode);
+          break;
+        }
+        case OP_LOADREGISTER: {
+          auto Op = IROp->C<IROp_LoadRegister>();
+          if (Op->Class == FPRClass) {
+            Load(CodeNode, FullRegister(Op->Offset, IROp->Size));
+          }
+          break;
+        }
+        case OP_LOADCONTEXT: {
+          auto Op = IROp->C<IROp_LoadContext>();
+          if (Op->Class == FPRClass) {
+            Load(CodeNode, FullRegister(Op->Offset, IROp->Size));
+          }
+          break;
+        }
+        case OP_STOREREGISTER: {
+          auto Op = IROp->C<IROp_StoreRegister>();
+          if (Op->Class == FPRClass && !Op->IsPrewrite) {
+            Changed |= Store(CodeNode, IREmit->UnwrapNode(Op->Value), Op->Offset, IROp->Size);
+          }
+          else {
+            Invalidate(AccessedRegisters(Op->Offset, IROp->Size));
+          }
+          break;
+        }
+        case OP_STORECONTEXT: {
+          auto Op = IROp->C<IROp_StoreContext>();
+          if (Op->Class == FPRClass) {
+            Changed |= Store(CodeNode, IREmit->UnwrapNode(Op->Value), Op->Offset, IROp->Size);
+          }
+          else {
+            Invalidate(AccessedRegisters(Op->Offset, IROp->Size));
+          }
+          break;
+        }
+        case OP_SYSCALL:
+        case OP_INLINESYSCALL: {
+          const auto Flags = IROp->Op == OP_SYSCALL ? IROp->C<IROp_Syscall>()->Flags : IROp->C<IROp_InlineSyscall>()->Flags;
+          if ((Flags & SyscallFlags::OPTIMIZETHROUGH) != SyscallFlags::OPTIMIZETHROUGH) {
+            Invalidate(ALL_REGISTERS);
+          }
+          break;
+        }
+        case OP_STORECONTEXTINDEXED:
+        case OP_BREAK:
+          // Can't track through these
+          Invalidate(ALL_REGISTERS);
+          break;
+        default:
+          break;
+      }
+    }
+
+    auto &Info = Blocks[BlockID];
+    Info.OutgoingZeroUppers = ZeroUppers;
+    Info.Visited = true;
+  }
+
+  return Changed;
+}
+
+fextl::unique_ptr<FEXCore::IR::Pass> CreateZeroUpperElimination() {
+  return fextl::make_unique<ZeroUpperElimination>();
+}
+
+}
@@ -422,9 +422,7 @@ void *OSAllocator_64Bit::Mmap(void *addr, size_t length, int prot, int flags, in
     uintptr_t RegionBegin = LiveRegion->SlabInfo->Base;
     uintptr_t MappedBegin = (AllocatedOffset - RegionBegin) >> FHU::FEX_PAGE_SHIFT;
 
-    for (size_t i = 0; i < NumberOfPages; ++i) {
-      LiveRegion->UsedPages.Set(MappedBegin + i);
-    }
+    LiveRegion->UsedPages.SetRange(MappedBegin, NumberOfPages);
 
     // Change our last allocation region
     LiveRegion->LastPageAllocation = MappedBegin + NumberOfPages;
@@ -474,13 +472,10 @@ int OSAllocator_64Bit::Munmap(void *addr, size_t length) {
         RegionEnd > PtrEnd) {
       // Live region fully encompasses slab range
 
-      uint64_t FreedPages{};
       uint32_t SlabPageBegin = (PtrBegin - RegionBegin) >> FHU::FEX_PAGE_SHIFT;
       uint64_t PagesToFree = length >> FHU::FEX_PAGE_SHIFT;
 
-      for (size_t i = 0; i < PagesToFree; ++i) {
-        FreedPages += (*it)->UsedPages.TestAndClear(SlabPageBegin + i) ? 1 : 0;
-      }
+      uint64_t FreedPages = (*it)->UsedPages.TestAndClearRange(SlabPageBegin, PagesToFree);
 
       if (FreedPages != 0)
       {
@@ -3,6 +3,8 @@
 #include <FEXCore/Utils/MathUtils.h>
 #include <FEXCore/Utils/LogManager.h>
 
+#include <algorithm>
+#include <bit>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
@@ -32,6 +34,34 @@ struct FlexBitSet final {
   void Clear(size_t Element) {
     Memory[Element / MinimumSizeBits] &= ~(1ULL << (Element % MinimumSizeBits));
   }
+  // Sets every element in [Element, Element + Count)
+  void SetRange(size_t Element, size_t Count) {
+    const size_t End = Element + Count;
+    while (Element < End) {
+      const size_t Bit = Element % MinimumSizeBits;
+      const size_t Bits = std::min(End - Element, MinimumSizeBits - Bit);
+      Memory[Element / MinimumSizeBits] |= RangeMask(Bit, Bits);
+      Element += Bits;
+    }
+  }
+
+  // Clears every element in [Element, Element + Count)
+  // @return How many of those elements were set
+  size_t TestAndClearRange(size_t Element, size_t Count) {
+    const size_t End = Element + Count;
+    size_t WasSet{};
+    while (Element < End) {
+      const size_t Bit = Element % MinimumSizeBits;
+      const size_t Bits = std::min(End - Element, MinimumSizeBits - Bit);
+      const T Mask = RangeMask(Bit, Bits);
+      T &Word = Memory[Element / MinimumSizeBits];
+      WasSet += std::popcount(static_cast<T>(Word & Mask));
+      Word &= static_cast<T>(~Mask);
+      Element += Bits;
+    }
+    return WasSet;
+  }
+
   void MemClear(size_t Elements) {
     memset(Memory, 0, FEXCore::AlignUp(Elements / MinimumSizeBits, MinimumSizeBits));
   }
@@ -47,14 +77,9 @@ struct FlexBitSet final {
     bool FoundHole;
   };
 
-  // TODO: Make {Forward,Backward}ScanForRange faster
-  // Currently these functions test a single bit at a time, which is fairly costly.
-  // The compiler emits a full element load per iteration, wasting a bunch of time on loads.
-  // If we change these functions to have a pre-amble and post-amble to align the primary loop to the element size then this can go significantly
-  // faster.
-  //
-  // Once the element scanning is aligned to the element size, we can then use native count leading zero(CLZ) and count trailing zero(CTZ)
-  // instructions on a full element to scan uint64_t elements per loop iteration.
+  // {Forward,Backward}ScanForRange work on a full element per iteration.
+  // Each candidate range is checked with a single FindFirst/FindLast for a conflicting bit
+  // and on failure the scan skips straight past that conflict, which is the same stepping the per-bit scan did.
 
   // Implementation details:
   // Template argument WantUnset
@@ -71,30 +96,24 @@ struct FlexBitSet final {
     bool FoundHole {};
     for (size_t CurrentPage = BeginningElement;
          CurrentPage >= (MinimumElement + ElementCount);) {
-      size_t Remaining = ElementCount;
-      LOGMAN_THROW_AA_FMT(Remaining <= CurrentPage, "Scanning less than available range");
-
-      while (Remaining) {
-        if (this->Get(CurrentPage - Remaining) == WantUnset) {
-          // Has an intersecting range
-          break;
-        }
-        --Remaining;
-      }
+      LOGMAN_THROW_AA_FMT(ElementCount <= CurrentPage, "Scanning less than available range");
 
-      if (Remaining) {
-        // If we found at least one Element hole then track that
-        if (Remaining != ElementCount) {
-          FoundHole = true;
-        }
+      // Lowest intersecting element in the range
+      const size_t RangeBegin = CurrentPage - ElementCount;
+      const size_t Intersect = FindFirst<WantUnset>(RangeBegin, CurrentPage);
 
-        // Didn't find a slab range
-        CurrentPage -= Remaining;
-      }
-      else {
+      if (Intersect == CurrentPage) {
         // We have a slab range
-        return BitsetScanResults{CurrentPage - ElementCount, FoundHole};
+        return BitsetScanResults{RangeBegin, FoundHole};
+      }
+
+      // If we found at least one Element hole then track that
+      if (Intersect != RangeBegin) {
+        FoundHole = true;
       }
+
+      // Didn't find a slab range
+      CurrentPage = Intersect;
     }
 
     return BitsetScanResults {~0ULL, FoundHole};
@@ -111,32 +130,24 @@ struct FlexBitSet final {
 
     for (size_t CurrentElement = BeginningElement;
          CurrentElement < (ElementsInSet - ElementCount);) {
-      // If we have enough free space, check if we have enough free pages that are contiguous
-      size_t Remaining = ElementCount;
+      LOGMAN_THROW_AA_FMT((CurrentElement + ElementCount - 1) < ElementsInSet, "Scanning less than available range");
 
-      LOGMAN_THROW_AA_FMT((CurrentElement + Remaining - 1) < ElementsInSet, "Scanning less than available range");
+      // Highest intersecting element in the range
+      const size_t RangeEnd = CurrentElement + ElementCount;
+      const size_t Intersect = FindLast<WantUnset>(CurrentElement, RangeEnd);
 
-      while (Remaining) {
-        if (this->Get(CurrentElement + Remaining - 1) == WantUnset) {
-          // Has an intersecting range
-          break;
-        }
-        --Remaining;
-      }
-
-      if (Remaining) {
-        // If we found at least one Element hole then track that
-        if (Remaining != ElementCount) {
-          FoundHole = true;
-        }
-
-        // Didn't find a slab range
-        CurrentElement += Remaining;
-      }
-      else {
+      if (Intersect == ~0ULL) {
         // We have a slab range
         return BitsetScanResults {CurrentElement, FoundHole};
       }
+
+      // If we found at least one Element hole then track that
+      if (Intersect != RangeEnd - 1) {
+        FoundHole = true;
+      }
+
+      // Didn't find a slab range
+      CurrentElement = Intersect + 1;
     }
 
     return BitsetScanResults {~0ULL, FoundHole};
@@ -151,6 +162,54 @@ struct FlexBitSet final {
   static size_t Size(uint64_t Elements) {
     return FEXCore::AlignUp(Elements / MinimumSizeBits, MinimumSizeBits);
   }
+
+private:
+  constexpr static T AllOnes = static_cast<T>(~T{});
+
+  // Mask of `Bits` bits starting at `Bit` inside of a single element
+  static T RangeMask(size_t Bit, size_t Bits) {
+    const T Mask = Bits == MinimumSizeBits ? AllOnes : static_cast<T>((T{1} << Bits) - 1);
+    return static_cast<T>(Mask << Bit);
+  }
+
+  // Loads the element containing `Element`, inverted when searching for unset bits
+  template<bool Value>
+  T LoadElement(size_t Element) const {
+    const T Word = Memory[Element / MinimumSizeBits];
+    return Value ? Word : static_cast<T>(~Word);
+  }
+
+  // @return The first element in [Begin, End) that equals Value, End if there isn't one
+  template<bool Value>
+  size_t FindFirst(size_t Begin, size_t End) const {
+    size_t Element = Begin;
+    while (Element < End) {
+      const size_t Bit = Element % MinimumSizeBits;
+      const T Word = static_cast<T>(LoadElement<Value>(Element) & static_cast<T>(AllOnes << Bit));
+      if (Word) {
+        return std::min<size_t>(Element - Bit + std::countr_zero(Word), End);
+      }
+      Element += MinimumSizeBits - Bit;
+    }
+    return End;
+  }
+
+  // @return The last element in [Begin, End) that equals Value, ~0ULL if there isn't one
+  template<bool Value>
+  size_t FindLast(size_t Begin, size_t End) const {
+    size_t Element = End;
+    while (Element > Begin) {
+      const size_t Last = Element - 1;
+      const size_t Bit = Last % MinimumSizeBits;
+      const T Word = static_cast<T>(LoadElement<Value>(Last) & RangeMask(0, Bit + 1));
+      if (Word) {
+        const size_t Found = Last - Bit + (MinimumSizeBits - 1 - std::countl_zero(Word));
+        return Found >= Begin ? Found : ~0ULL;
+      }
+      Element = Last - Bit;
+    }
+    return ~0ULL;
+  }
 };
 
 static_assert(sizeof(FlexBitSet<uint64_t>) == 0, "This needs to be a flex member");
@@ -15,6 +15,24 @@ FEXCORE_TELEMETRY_STATIC_INIT(Cas32Tear,  TYPE_CAS_32BIT_TEAR);
 FEXCORE_TELEMETRY_STATIC_INIT(Cas64Tear,  TYPE_CAS_64BIT_TEAR);
 FEXCORE_TELEMETRY_STATIC_INIT(Cas128Tear, TYPE_CAS_128BIT_TEAR);
 
+// x86 takes a bus lock for locked accesses that cross a cacheline, host atomics can't span one.
+// Emulated split accesses hold this for their whole read-modify-write so they can't tear each other.
+// Racing accesses from JIT code can still observe the two halves separately.
+static std::atomic_flag SplitLockBus = ATOMIC_FLAG_INIT;
+
+class ScopedSplitLock final {
+public:
+  ScopedSplitLock() {
+    // Only taken from the SIGBUS handler so this has to spin
+    while (SplitLockBus.test_and_set(std::memory_order_acquire)) {
+    }
+  }
+
+  ~ScopedSplitLock() {
+    SplitLockBus.clear(std::memory_order_release);
+  }
+};
+
 static void ClearICache(void* Begin, std::size_t Length) {
   __builtin___clear_cache(static_cast<char*>(Begin), static_cast<char*>(Begin) + Length);
 }
@@ -265,6 +283,7 @@ static bool RunCASPAL(uint64_t *GPRs, uint32_t Size, uint32_t DesiredReg1, uint3
     uint64_t AlignmentMask = 0b1111;
     if ((Addr & AlignmentMask) > 8) {
       FEXCORE_TELEMETRY_SET(SplitLock16B, 1);
+      ScopedSplitLock BusLock{};
 
       uint64_t Alignment = Addr & 0b111;
       Addr &= ~0b111ULL;
@@ -576,6 +595,7 @@ uint16_t DoCAS16(
   uint64_t AlignmentMask = 0b1111;
   if ((Addr & AlignmentMask) == 15) {
     FEXCORE_TELEMETRY_SET(SplitLock16B, 1);
+    ScopedSplitLock BusLock{};
 
     // Address crosses over 16byte or 64byte threshold
     // Need a dual 8bit CAS loop
@@ -860,6 +880,7 @@ uint32_t DoCAS32(
   uint64_t AlignmentMask = 0b1111;
   if ((Addr & AlignmentMask) > 12) {
     FEXCORE_TELEMETRY_SET(SplitLock16B, 1);
+    ScopedSplitLock BusLock{};
 
     // Address crosses over 16byte threshold
     // Needs dual 4 byte CAS loop
@@ -1098,6 +1119,7 @@ uint64_t DoCAS64(
   uint64_t AlignmentMask = 0b1111;
   if ((Addr & AlignmentMask) > 8) {
     FEXCORE_TELEMETRY_SET(SplitLock16B, 1);
+    ScopedSplitLock BusLock{};
 
     uint64_t Alignment = Addr & 0b111;
     Addr &= ~0b111ULL;
@@ -5,13 +5,24 @@ $end_info$
 */
 
 #include <FEXCore/Utils/CompilerDefs.h>
+#include <FEXCore/Utils/Event.h>
 #include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/Utils/MathUtils.h>
+#include <FEXCore/Utils/Threads.h>
 #include <FEXCore/fextl/fmt.h>
+#include <FEXCore/fextl/memory.h>
+#include <FEXCore/fextl/string.h>
 #include <FEXCore/fextl/vector.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstdarg>
 #include <cstdio>
+#include <cstring>
 #include <malloc.h>
+#include <mutex>
+#include <new>
 
 namespace LogMan {
 
@@ -23,6 +34,9 @@ void UnInstallHandlers() { Handlers.clear(); }
 void MFmt(const char *fmt, const fmt::format_args& args) {
   auto msg = fextl::fmt::vformat(fmt, args);
 
+  // Get everything queued out before the trap
+  Msg::FlushAsync();
+
   for (auto& Handler : Handlers) {
     Handler(msg.c_str());
   }
@@ -36,12 +50,331 @@ fextl::vector<MsgHandler> Handlers;
 void InstallHandler(MsgHandler Handler) { Handlers.emplace_back(Handler); }
 void UnInstallHandlers() { Handlers.clear(); }
 
-void MFmtImpl(DebugLevels level, const char* fmt, const fmt::format_args& args) {
-  const auto msg = fextl::fmt::vformat(fmt, args);
-
+namespace {
+void Dispatch(DebugLevels Level, const char *Message) {
   for (auto& Handler : Handlers) {
-    Handler(level, msg.c_str());
+    Handler(Level, Message);
+  }
+}
+
+namespace Async {
+  // Single producer, single consumer ring owned by one logging thread.
+  // The owning thread only moves Head, the flusher only moves Tail.
+  struct ThreadBuffer {
+    constexpr static uint64_t Size = 64 * 1024;
+
+    std::atomic<uint64_t> Head{};
+    std::atomic<uint64_t> Tail{};
+    // Set when the owning thread exits, the buffer is freed once drained
+    std::atomic<bool> Retired{};
+    // Messages thrown away because the ring was full
+    std::atomic<uint32_t> Dropped{};
+    uint8_t Data[Size];
+  };
+
+  // Each record is a header followed by the NUL terminated message, padded to 8 bytes so a header never wraps
+  struct RecordHeader {
+    uint32_t Level;
+    uint32_t Length;
+  };
+
+  uint64_t RecordSize(uint64_t Length) {
+    return FEXCore::AlignUp(sizeof(RecordHeader) + Length + 1, 8);
+  }
+
+  struct ThreadBufferOwner {
+    ThreadBuffer *Buffer{};
+
+    ~ThreadBufferOwner() {
+      if (Buffer) {
+        Buffer->Retired.store(true, std::memory_order_release);
+      }
+    }
+  };
+  thread_local ThreadBufferOwner LocalBuffer;
+
+  // Per format string message counts for the current one second window.
+  // The format string pointer identifies the call site.
+  struct CallSite {
+    std::atomic<const char*> Format{};
+    std::atomic<uint64_t> Window{};
+    std::atomic<uint32_t> Count{};
+    std::atomic<uint32_t> Suppressed{};
+  };
+  constexpr size_t CallSiteCount = 1024;
+  constexpr size_t CallSiteProbes = 4;
+  CallSite CallSites[CallSiteCount];
+
+  std::atomic<bool> Enabled{};
+  uint32_t RateLimit{};
+  std::atomic<bool> ShuttingDown{};
+  Event WorkAvailable;
+  fextl::unique_ptr<FEXCore::Threads::Thread> Flusher;
+  constexpr auto FlushInterval = std::chrono::milliseconds(10);
+
+  std::mutex BuffersLock;
+  fextl::vector<fextl::unique_ptr<ThreadBuffer>> Buffers;
+
+  // Serializes handler calls between the flusher and synchronous messages.
+  // Recursive since handlers are allowed to log.
+  std::recursive_mutex DispatchLock;
+  // Only used under DispatchLock
+  fextl::vector<ThreadBuffer*> DrainList;
+  fextl::string DrainScratch;
+
+  ThreadBuffer *GetThreadBuffer() {
+    auto &Owner = LocalBuffer;
+    if (!Owner.Buffer) {
+      auto Buffer = fextl::make_unique<ThreadBuffer>();
+      Owner.Buffer = Buffer.get();
+
+      std::lock_guard lk(BuffersLock);
+      Buffers.emplace_back(std::move(Buffer));
+    }
+    return Owner.Buffer;
+  }
+
+  void CopyIn(ThreadBuffer *Buffer, uint64_t Offset, const void *Src, uint64_t Length) {
+    const auto Start = Offset % ThreadBuffer::Size;
+    const auto First = std::min(Length, ThreadBuffer::Size - Start);
+    memcpy(&Buffer->Data[Start], Src, First);
+    memcpy(&Buffer->Data[0], reinterpret_cast<const uint8_t*>(Src) + First, Length - First);
+  }
+
+  void CopyOut(ThreadBuffer *Buffer, uint64_t Offset, void *Dst, uint64_t Length) {
+    const auto Start = Offset % ThreadBuffer::Size;
+    const auto First = std::min(Length, ThreadBuffer::Size - Start);
+    memcpy(Dst, &Buffer->Data[Start], First);
+    memcpy(reinterpret_cast<uint8_t*>(Dst) + First, &Buffer->Data[0], Length - First);
+  }
+
+  /**
+   * @brief Queues a message on the calling thread's buffer
+   *
+   * @return false if the message can't ever fit and needs to be handled synchronously
+   */
+  bool Queue(DebugLevels Level, const fextl::string &Message) {
+    const auto Size = RecordSize(Message.size());
+    if (Size > ThreadBuffer::Size / 2) {
+      return false;
+    }
+
+    auto Buffer = GetThreadBuffer();
+    const auto Head = Buffer->Head.load(std::memory_order_relaxed);
+    const auto Tail = Buffer->Tail.load(std::memory_order_acquire);
+    if (Head - Tail + Size > ThreadBuffer::Size) {
+      Buffer->Dropped.fetch_add(1, std::memory_order_relaxed);
+      WorkAvailable.NotifyOne();
+      return true;
+    }
+
+    const RecordHeader Header {
+      .Level = static_cast<uint32_t>(Level),
+      .Length = static_cast<uint32_t>(Message.size()),
+    };
+    CopyIn(Buffer, Head, &Header, sizeof(Header));
+    CopyIn(Buffer, Head + sizeof(Header), Message.c_str(), Message.size() + 1);
+    Buffer->Head.store(Head + Size, std::memory_order_release);
+
+    // Don't wait for the interval when the ring is filling up
+    if (Head + Size - Tail > ThreadBuffer::Size / 2) {
+      WorkAvailable.NotifyOne();
+    }
+    return true;
+  }
+
+  // Expects DispatchLock to be held
+  void DrainBuffer(ThreadBuffer *Buffer) {
+    auto Tail = Buffer->Tail.load(std::memory_order_relaxed);
+    const auto Head = Buffer->Head.load(std::memory_order_acquire);
+
+    while (Tail != Head) {
+      RecordHeader Header;
+      CopyOut(Buffer, Tail, &Header, sizeof(Header));
+      DrainScratch.resize(Header.Length);
+      CopyOut(Buffer, Tail + sizeof(Header), DrainScratch.data(), Header.Length);
+
+      // Free the space before calling the handler, which can be slow
+      Tail += RecordSize(Header.Length);
+      Buffer->Tail.store(Tail, std::memory_order_release);
+
+      Dispatch(static_cast<DebugLevels>(Header.Level), DrainScratch.c_str());
+    }
+
+    if (const auto Dropped = Buffer->Dropped.exchange(0, std::memory_order_relaxed)) {
+      const auto Message = fextl::fmt::format("LogMan: Dropped {} messages, log buffer full", Dropped);
+      Dispatch(ERROR, Message.c_str());
+    }
+  }
+
+  // Expects DispatchLock to be held
+  void DrainAll() {
+    DrainList.clear();
+    {
+      std::lock_guard lk(BuffersLock);
+      for (auto &Buffer : Buffers) {
+        DrainList.emplace_back(Buffer.get());
+      }
+    }
+
+    // BuffersLock isn't held while handlers run, so they can log from a thread without a buffer yet
+    for (auto Buffer : DrainList) {
+      DrainBuffer(Buffer);
+    }
+
+    std::lock_guard lk(BuffersLock);
+    std::erase_if(Buffers, [](const fextl::unique_ptr<ThreadBuffer> &Buffer) {
+      return Buffer->Retired.load(std::memory_order_acquire) &&
+             Buffer->Head.load(std::memory_order_relaxed) == Buffer->Tail.load(std::memory_order_relaxed);
+    });
+  }
+
+  /**
+   * @brief Counts a message against its call site
+   *
+   * @return true if the call site went over the limit this second and the message should be skipped
+   */
+  bool RateLimited(const char *Format) {
+    const uint64_t Now = std::chrono::duration_cast<std::chrono::seconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    const size_t Index = (reinterpret_cast<uintptr_t>(Format) >> 3) % CallSiteCount;
+    for (size_t i = 0; i < CallSiteProbes; ++i) {
+      auto &Site = CallSites[(Index + i) % CallSiteCount];
+
+      const char *Current = Site.Format.load(std::memory_order_relaxed);
+      if (!Current && Site.Format.compare_exchange_strong(Current, Format, std::memory_order_relaxed)) {
+        Current = Format;
+      }
+
+      if (Current != Format) {
+        continue;
+      }
+
+      auto Window = Site.Window.load(std::memory_order_relaxed);
+      if (Window != Now && Site.Window.compare_exchange_strong(Window, Now, std::memory_order_relaxed)) {
+        Site.Count.store(0, std::memory_order_relaxed);
+        if (const auto Suppressed = Site.Suppressed.exchange(0, std::memory_order_relaxed)) {
+          Queue(INFO, fextl::fmt::format("LogMan: Suppressed {} messages from \"{}\"", Suppressed, Format));
+        }
+      }
+
+      if (Site.Count.fetch_add(1, std::memory_order_relaxed) < RateLimit) {
+        return false;
+      }
+
+      Site.Suppressed.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+
+    // Too many call sites collided, don't limit this one
+    return false;
+  }
+
+  void *FlusherThread(void *) {
+    FEXCore::Threads::SetThreadName("FEX:LogFlush");
+
+    while (!ShuttingDown.load(std::memory_order_relaxed)) {
+      WorkAvailable.WaitFor(FlushInterval);
+
+      std::lock_guard lk(DispatchLock);
+      DrainAll();
+    }
+
+    return nullptr;
+  }
+
+  void StartFlusher() {
+    ShuttingDown = false;
+
+    uint64_t OldMask = FEXCore::Threads::SetSignalMask(~0ULL);
+    Flusher = FEXCore::Threads::Thread::Create(FlusherThread, nullptr);
+    FEXCore::Threads::SetSignalMask(OldMask);
+  }
+
+  void Log(DebugLevels Level, const char* fmt, const fmt::format_args& args) {
+    if ((Level == DEBUG || Level == INFO) && RateLimit && RateLimited(fmt)) {
+      return;
+    }
+
+    const auto msg = fextl::fmt::vformat(fmt, args);
+
+    if (Level > ERROR && Queue(Level, msg)) {
+      return;
+    }
+
+    // Errors go out immediately, after everything that was logged before them
+    std::lock_guard lk(DispatchLock);
+    DrainAll();
+    Dispatch(Level, msg.c_str());
   }
+} // namespace Async
+} // Anonymous namespace
+
+void EnableAsync(uint32_t RateLimit) {
+  if (Async::Enabled) {
+    return;
+  }
+
+  Async::RateLimit = RateLimit;
+  Async::StartFlusher();
+  Async::Enabled = true;
+}
+
+void DisableAsync() {
+  if (!Async::Enabled.exchange(false)) {
+    return;
+  }
+
+  Async::ShuttingDown = true;
+  Async::WorkAvailable.NotifyAll();
+
+  if (Async::Flusher->joinable()) {
+    Async::Flusher->join(nullptr);
+  }
+  Async::Flusher.reset();
+
+  FlushAsync();
+}
+
+void FlushAsync() {
+  std::lock_guard lk(Async::DispatchLock);
+  Async::DrainAll();
+}
+
+void AsyncAfterFork() {
+  if (!Async::Enabled) {
+    return;
+  }
+
+  // Threads that held these at the time of the fork don't exist in the child
+  new (&Async::DispatchLock) std::recursive_mutex;
+  new (&Async::BuffersLock) std::mutex;
+
+  // Everything queued before the fork is the parent's to output
+  auto Self = Async::LocalBuffer.Buffer;
+  std::erase_if(Async::Buffers, [Self](const fextl::unique_ptr<Async::ThreadBuffer> &Buffer) {
+    return Buffer.get() != Self;
+  });
+
+  if (Self) {
+    Self->Tail.store(Self->Head.load());
+    Self->Dropped = 0;
+  }
+
+  // The flusher didn't survive the fork either
+  (void)Async::Flusher.release();
+  Async::StartFlusher();
+}
+
+void MFmtImpl(DebugLevels level, const char* fmt, const fmt::format_args& args) {
+  if (Async::Enabled.load(std::memory_order_relaxed)) {
+    Async::Log(level, fmt, args);
+    return;
+  }
+
+  const auto msg = fextl::fmt::vformat(fmt, args);
+  Dispatch(level, msg.c_str());
 }
 
 } // namespace Msg
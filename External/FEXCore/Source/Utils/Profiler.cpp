@@ -8,25 +8,46 @@
 #include <sys/vfs.h>
 #endif
 
+#include <FEXCore/Config/Config.h>
+#include <FEXCore/Utils/Event.h>
 #include <FEXCore/Utils/LogManager.h>
 #include <FEXCore/Utils/Profiler.h>
+#include <FEXCore/Utils/Threads.h>
+#include <FEXCore/fextl/deque.h>
 #include <FEXCore/fextl/fmt.h>
+#include <FEXCore/fextl/memory.h>
 #include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/unordered_map.h>
+#include <FEXCore/fextl/vector.h>
+#include <FEXHeaderUtils/Syscalls.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <unistd.h>
 
 #define BACKEND_OFF 0
 #define BACKEND_GPUVIS 1
+#define BACKEND_CHROME 2
 
 #ifdef ENABLE_FEXCORE_PROFILER
 #if FEXCORE_PROFILER_BACKEND == BACKEND_GPUVIS
 namespace FEXCore::Profiler {
-  ProfilerBlock::ProfilerBlock(std::string_view const Format)
+  ProfilerBlock::ProfilerBlock(std::string_view const Format, uint64_t Arg)
     : DurationBegin {GetTime()}
-    , Format {Format} {
+    , Format {Format}
+    , Arg {Arg} {
     }
 
   ProfilerBlock::~ProfilerBlock() {
     auto Duration = GetTime() - DurationBegin;
-    TraceObject(Format, Duration);
+    if (Arg == NO_ARG) {
+      TraceObject(Format, Duration);
+    }
+    else {
+      TraceObject(fextl::fmt::format("{} {:#x}", Format, Arg), Duration);
+    }
   }
 }
 
@@ -84,6 +105,303 @@ namespace GPUVis {
     }
   }
 }
+#elif FEXCORE_PROFILER_BACKEND == BACKEND_CHROME
+namespace Chrome {
+  using FEXCore::Profiler::GetTime;
+  using FEXCore::Profiler::ProfilerBlock;
+
+  enum class EventType : uint32_t {
+    Scope,
+    Instant,
+  };
+
+  struct TraceEvent {
+    uint64_t Begin;
+    uint64_t Duration;
+    uint64_t Arg;
+    uint32_t ScopeID;
+    EventType Type;
+  };
+
+  // Single producer, single consumer ring owned by one thread.
+  // The owning thread only moves Head, the flusher only moves Tail.
+  struct ThreadRing {
+    constexpr static uint64_t Size = 16 * 1024;
+
+    std::atomic<uint64_t> Head{};
+    std::atomic<uint64_t> Tail{};
+    // Set when the owning thread exits, the ring is freed once drained
+    std::atomic<bool> Retired{};
+    // Events thrown away because the ring was full
+    std::atomic<uint32_t> Dropped{};
+    // Guest threads are host threads, so this is also the guest's TID
+    uint32_t TID{};
+    // Owning thread only, the keys point in to ScopeNames
+    fextl::unordered_map<std::string_view, uint32_t> ScopeIDs;
+    TraceEvent Events[Size];
+  };
+
+  struct ThreadRingOwner {
+    ThreadRing *Ring{};
+
+    ~ThreadRingOwner() {
+      if (Ring) {
+        Ring->Retired.store(true, std::memory_order_release);
+      }
+    }
+  };
+  thread_local ThreadRingOwner LocalRing;
+
+  // Trace output, -1 when tracing isn't enabled
+  int TraceFD {-1};
+  uint32_t PID{};
+
+  std::atomic<bool> ShuttingDown{};
+  Event WorkAvailable;
+  fextl::unique_ptr<FEXCore::Threads::Thread> Flusher;
+  constexpr auto FlushInterval = std::chrono::milliseconds(100);
+
+  std::mutex RingsLock;
+  fextl::vector<fextl::unique_ptr<ThreadRing>> Rings;
+
+  // Scope names are interned once per process, events only carry the index.
+  // A deque so the strings never move.
+  std::mutex ScopeNamesLock;
+  fextl::deque<fextl::string> ScopeNames;
+
+  // Serializes draining between the flusher and Shutdown
+  std::mutex FlushLock;
+  // Only used under FlushLock
+  fextl::vector<ThreadRing*> DrainList;
+  fextl::string Output;
+  bool FirstEvent {true};
+
+  ThreadRing *GetThreadRing() {
+    auto &Owner = LocalRing;
+    if (!Owner.Ring) {
+      auto Ring = fextl::make_unique<ThreadRing>();
+      Ring->TID = FHU::Syscalls::gettid();
+      Owner.Ring = Ring.get();
+
+      std::lock_guard lk(RingsLock);
+      Rings.emplace_back(std::move(Ring));
+    }
+    return Owner.Ring;
+  }
+
+  uint32_t GetScopeID(ThreadRing *Ring, std::string_view Name) {
+    auto it = Ring->ScopeIDs.find(Name);
+    if (it != Ring->ScopeIDs.end()) {
+      return it->second;
+    }
+
+    // First use of the name on this thread
+    std::lock_guard lk(ScopeNamesLock);
+    auto Existing = std::find(ScopeNames.begin(), ScopeNames.end(), Name);
+    if (Existing == ScopeNames.end()) {
+      Existing = ScopeNames.emplace(ScopeNames.end(), Name);
+    }
+
+    const uint32_t ID = std::distance(ScopeNames.begin(), Existing);
+    Ring->ScopeIDs.emplace(*Existing, ID);
+    return ID;
+  }
+
+  void Record(EventType Type, std::string_view Name, uint64_t Begin, uint64_t Duration, uint64_t Arg) {
+    if (TraceFD == -1) {
+      return;
+    }
+
+    auto Ring = GetThreadRing();
+    const auto Head = Ring->Head.load(std::memory_order_relaxed);
+    const auto Tail = Ring->Tail.load(std::memory_order_acquire);
+    if (Head - Tail == ThreadRing::Size) {
+      Ring->Dropped.fetch_add(1, std::memory_order_relaxed);
+      WorkAvailable.NotifyOne();
+      return;
+    }
+
+    Ring->Events[Head % ThreadRing::Size] = TraceEvent {
+      .Begin = Begin,
+      .Duration = Duration,
+      .Arg = Arg,
+      .ScopeID = GetScopeID(Ring, Name),
+      .Type = Type,
+    };
+    Ring->Head.store(Head + 1, std::memory_order_release);
+
+    // Don't wait for the interval when the ring is filling up
+    if (Head + 1 - Tail > ThreadRing::Size / 2) {
+      WorkAvailable.NotifyOne();
+    }
+  }
+
+  void AppendEscaped(std::string_view Str) {
+    for (auto c : Str) {
+      if (c == '"' || c == '\\') {
+        Output += '\\';
+      }
+      Output += c;
+    }
+  }
+
+  // Timestamps are in microseconds, keep the nanoseconds as the fraction
+  void AppendEvent(ThreadRing *Ring, const TraceEvent &Event) {
+    Output += FirstEvent ? "\n" : ",\n";
+    FirstEvent = false;
+
+    Output += "{\"name\":\"";
+    AppendEscaped(ScopeNames[Event.ScopeID]);
+    fmt::format_to(std::back_inserter(Output), "\",\"pid\":{},\"tid\":{},\"ts\":{}.{:03}",
+      PID, Ring->TID, Event.Begin / 1000, Event.Begin % 1000);
+
+    if (Event.Type == EventType::Scope) {
+      fmt::format_to(std::back_inserter(Output), ",\"ph\":\"X\",\"dur\":{}.{:03}",
+        Event.Duration / 1000, Event.Duration % 1000);
+    }
+    else {
+      Output += ",\"ph\":\"i\",\"s\":\"t\"";
+    }
+
+    if (Event.Arg != ProfilerBlock::NO_ARG) {
+      fmt::format_to(std::back_inserter(Output), ",\"args\":{{\"arg\":\"{:#x}\"}}", Event.Arg);
+    }
+    Output += "}";
+  }
+
+  void WriteOutput() {
+    size_t Written = 0;
+    while (Written < Output.size()) {
+      auto Result = write(TraceFD, Output.data() + Written, Output.size() - Written);
+      if (Result <= 0) {
+        break;
+      }
+      Written += Result;
+    }
+    Output.clear();
+  }
+
+  // Expects FlushLock to be held
+  void DrainAll() {
+    DrainList.clear();
+    {
+      std::lock_guard lk(RingsLock);
+      for (auto &Ring : Rings) {
+        DrainList.emplace_back(Ring.get());
+      }
+    }
+
+    {
+      // Held for the whole drain so new names can't move the deque's blocks around while they're read
+      std::lock_guard lk(ScopeNamesLock);
+      for (auto Ring : DrainList) {
+        auto Tail = Ring->Tail.load(std::memory_order_relaxed);
+        const auto Head = Ring->Head.load(std::memory_order_acquire);
+        for (; Tail != Head; ++Tail) {
+          AppendEvent(Ring, Ring->Events[Tail % ThreadRing::Size]);
+        }
+        Ring->Tail.store(Tail, std::memory_order_release);
+
+        if (const auto Dropped = Ring->Dropped.exchange(0, std::memory_order_relaxed)) {
+          const auto Now = GetTime();
+          Output += FirstEvent ? "\n" : ",\n";
+          FirstEvent = false;
+          fmt::format_to(std::back_inserter(Output),
+            "{{\"name\":\"Profiler: Dropped {} events, ring full\",\"pid\":{},\"tid\":{},\"ts\":{}.{:03},\"ph\":\"i\",\"s\":\"t\"}}",
+            Dropped, PID, Ring->TID, Now / 1000, Now % 1000);
+        }
+      }
+    }
+
+    WriteOutput();
+
+    std::lock_guard lk(RingsLock);
+    std::erase_if(Rings, [](const fextl::unique_ptr<ThreadRing> &Ring) {
+      return Ring->Retired.load(std::memory_order_acquire) &&
+             Ring->Head.load(std::memory_order_relaxed) == Ring->Tail.load(std::memory_order_relaxed);
+    });
+  }
+
+  void *FlusherThread(void *) {
+    FEXCore::Threads::SetThreadName("FEX:TraceFlush");
+
+    while (!ShuttingDown.load(std::memory_order_relaxed)) {
+      WorkAvailable.WaitFor(FlushInterval);
+
+      std::lock_guard lk(FlushLock);
+      DrainAll();
+    }
+
+    return nullptr;
+  }
+
+  void Init() {
+    FEX_CONFIG_OPT(ProfileTraceFile, PROFILETRACEFILE);
+    if (ProfileTraceFile().empty()) {
+      return;
+    }
+
+    PID = ::getpid();
+    fextl::string FilePath = fextl::fmt::format("{}.{}.json", ProfileTraceFile(), PID);
+    TraceFD = open(FilePath.c_str(), O_CREAT | O_TRUNC | O_WRONLY | O_CLOEXEC, 0644);
+    if (TraceFD == -1) {
+      LogMan::Msg::EFmt("Profiler: Couldn't open trace file {}", FilePath);
+      return;
+    }
+
+    // JSON array format, trace viewers accept the array without its closing bracket if the process dies
+    Output = "[";
+    WriteOutput();
+
+    ShuttingDown = false;
+    uint64_t OldMask = FEXCore::Threads::SetSignalMask(~0ULL);
+    Flusher = FEXCore::Threads::Thread::Create(FlusherThread, nullptr);
+    FEXCore::Threads::SetSignalMask(OldMask);
+  }
+
+  void Shutdown() {
+    if (TraceFD == -1) {
+      return;
+    }
+
+    ShuttingDown = true;
+    WorkAvailable.NotifyAll();
+    if (Flusher->joinable()) {
+      Flusher->join(nullptr);
+    }
+    Flusher.reset();
+
+    std::lock_guard lk(FlushLock);
+    DrainAll();
+    Output = "\n]\n";
+    WriteOutput();
+
+    close(TraceFD);
+    TraceFD = -1;
+  }
+
+  void TraceObject(std::string_view const Format, uint64_t Duration) {
+    const auto Now = GetTime();
+    Record(EventType::Scope, Format, Now - Duration, Duration, ProfilerBlock::NO_ARG);
+  }
+
+  void TraceObject(std::string_view const Format) {
+    Record(EventType::Instant, Format, GetTime(), 0, ProfilerBlock::NO_ARG);
+  }
+}
+
+namespace FEXCore::Profiler {
+  ProfilerBlock::ProfilerBlock(std::string_view const Format, uint64_t Arg)
+    : DurationBegin {GetTime()}
+    , Format {Format}
+    , Arg {Arg} {
+    }
+
+  ProfilerBlock::~ProfilerBlock() {
+    // Only a ring write, the flusher thread does the formatting and I/O
+    Chrome::Record(Chrome::EventType::Scope, Format, DurationBegin, GetTime() - DurationBegin, Arg);
+  }
+}
 #else
 #error Unknown profiler backend
 #endif
@@ -94,24 +412,32 @@ namespace FEXCore::Profiler {
   void Init() {
 #if FEXCORE_PROFILER_BACKEND == BACKEND_GPUVIS
     GPUVis::Init();
+#elif FEXCORE_PROFILER_BACKEND == BACKEND_CHROME
+    Chrome::Init();
 #endif
   }
 
   void Shutdown() {
 #if FEXCORE_PROFILER_BACKEND == BACKEND_GPUVIS
     GPUVis::Shutdown();
+#elif FEXCORE_PROFILER_BACKEND == BACKEND_CHROME
+    Chrome::Shutdown();
 #endif
   }
 
   void TraceObject(std::string_view const Format, uint64_t Duration) {
 #if FEXCORE_PROFILER_BACKEND == BACKEND_GPUVIS
     GPUVis::TraceObject(Format, Duration);
+#elif FEXCORE_PROFILER_BACKEND == BACKEND_CHROME
+    Chrome::TraceObject(Format, Duration);
 #endif
   }
 
   void TraceObject(std::string_view const Format) {
 #if FEXCORE_PROFILER_BACKEND == BACKEND_GPUVIS
     GPUVis::TraceObject(Format);
+#elif FEXCORE_PROFILER_BACKEND == BACKEND_CHROME
+    Chrome::TraceObject(Format);
 #endif
 
   }
@@ -3,13 +3,17 @@
 #include <FEXCore/Utils/LogManager.h>
 #include <FEXCore/Utils/Telemetry.h>
 #include <FEXCore/fextl/fmt.h>
+#include <FEXCore/fextl/memory.h>
 #include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/vector.h>
 #include <FEXHeaderUtils/Filesystem.h>
 
 #include <array>
+#include <mutex>
 #include <stddef.h>
 #include <string_view>
 #include <system_error>
+#include <time.h>
 
 namespace FEXCore::Telemetry {
 #ifndef FEX_DISABLE_TELEMETRY
@@ -25,6 +29,89 @@ namespace FEXCore::Telemetry {
     "128bit CAS Tear",
     "Crash mask",
   };
+
+  const std::array<std::string_view, FEXCore::Telemetry::CounterType::COUNTER_LAST> CounterNames {
+    "Blocks compiled",
+    "Code cache flushes",
+    "SMC invalidations",
+    "Blocks reinstated after invalidation",
+    "Block lookup L1 hits",
+    "Block lookup L2 hits",
+    "Block lookup L3 hits",
+    "Block lookup misses",
+    "Dispatcher exits",
+    "Signals delivered",
+    "Guest huge page mappings",
+  };
+
+  thread_local ThreadCounters *TLSThreadCounters{};
+
+  // Counters of live threads, and the sum of every thread that has already exited
+  static std::mutex ThreadCountersMutex;
+  static fextl::vector<fextl::unique_ptr<ThreadCounters>> LiveThreadCounters;
+  static ThreadCounters ExitedThreadCounters{};
+  static uint64_t StartTime{};
+
+  static uint64_t GetTime() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1'000'000'000ULL + ts.tv_nsec;
+  }
+
+  static void AccumulateCounters(ThreadCounters *Dst, const ThreadCounters *Src) {
+    for (size_t i = 0; i < COUNTER_LAST; ++i) {
+      Dst->Counters[i] += Src->Counters[i];
+    }
+    for (size_t i = 0; i < COMPILE_TIME_BUCKETS; ++i) {
+      Dst->CompileTime[i] += Src->CompileTime[i];
+    }
+    for (size_t i = 0; i < MAX_SYSCALL_COUNTERS; ++i) {
+      Dst->Syscalls[i] += Src->Syscalls[i];
+    }
+    for (size_t i = 0; i < MAX_FALLBACK_COUNTERS; ++i) {
+      Dst->Fallbacks[i] += Src->Fallbacks[i];
+    }
+  }
+
+  ThreadCounters *RegisterThreadCounters() {
+    if (TLSThreadCounters) {
+      return TLSThreadCounters;
+    }
+
+    auto Counters = fextl::make_unique<ThreadCounters>();
+    TLSThreadCounters = Counters.get();
+
+    std::scoped_lock lk(ThreadCountersMutex);
+    LiveThreadCounters.emplace_back(std::move(Counters));
+    return TLSThreadCounters;
+  }
+
+  void UnregisterThreadCounters() {
+    auto Counters = TLSThreadCounters;
+    if (!Counters) {
+      return;
+    }
+
+    TLSThreadCounters = nullptr;
+
+    std::scoped_lock lk(ThreadCountersMutex);
+    AccumulateCounters(&ExitedThreadCounters, Counters);
+    std::erase_if(LiveThreadCounters, [Counters](const auto &Live) {
+      return Live.get() == Counters;
+    });
+  }
+
+  uint64_t GetCounterTotals(ThreadCounters *Total) {
+    // Threads that are still running are read without stopping them, the counts may be slightly behind
+    std::scoped_lock lk(ThreadCountersMutex);
+    AccumulateCounters(Total, &ExitedThreadCounters);
+    for (const auto &Counters : LiveThreadCounters) {
+      AccumulateCounters(Total, Counters.get());
+    }
+
+    return GetTime() - StartTime;
+  }
+
   void Initialize() {
     auto DataDirectory = Config::GetDataDirectory();
     DataDirectory += "Telemetry/";
@@ -34,6 +121,8 @@ namespace FEXCore::Telemetry {
         !FHU::Filesystem::CreateDirectories(DataDirectory)) {
       LogMan::Msg::IFmt("Couldn't create telemetry Folder");
     }
+
+    StartTime = GetTime();
   }
 
   void Shutdown(fextl::string const &ApplicationName) {
@@ -57,6 +146,40 @@ namespace FEXCore::Telemetry {
         auto &Data = TelemetryValues.at(i);
         fextl::fmt::print(File, "{}: {}\n", Name, *Data);
       }
+
+      ThreadCounters Total {};
+      const double Seconds = static_cast<double>(GetCounterTotals(&Total)) / 1'000'000'000.0;
+
+      for (size_t i = 0; i < CounterType::COUNTER_LAST; ++i) {
+        fextl::fmt::print(File, "{}: {}\n", CounterNames.at(i), Total.Counters[i]);
+      }
+
+      if (Seconds > 0.0) {
+        fextl::fmt::print(File, "SMC invalidations per second: {:.2f}\n", Total.Counters[COUNTER_SMC_INVALIDATIONS] / Seconds);
+      }
+
+      for (size_t i = 0; i < COMPILE_TIME_BUCKETS; ++i) {
+        if (Total.CompileTime[i]) {
+          if (i == COMPILE_TIME_BUCKETS - 1) {
+            fextl::fmt::print(File, "Compile time >= {}us: {}\n", 1ULL << (i - 1), Total.CompileTime[i]);
+          }
+          else {
+            fextl::fmt::print(File, "Compile time < {}us: {}\n", 1ULL << i, Total.CompileTime[i]);
+          }
+        }
+      }
+
+      for (size_t i = 0; i < MAX_SYSCALL_COUNTERS; ++i) {
+        if (Total.Syscalls[i]) {
+          fextl::fmt::print(File, "Syscall {}: {}\n", i, Total.Syscalls[i]);
+        }
+      }
+
+      for (size_t i = 0; i < MAX_FALLBACK_COUNTERS; ++i) {
+        if (Total.Fallbacks[i]) {
+          fextl::fmt::print(File, "Interpreter fallback {}: {}\n", i, Total.Fallbacks[i]);
+        }
+      }
       File.Flush();
     }
   }
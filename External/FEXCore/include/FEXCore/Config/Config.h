@@ -38,8 +38,19 @@ namespace Handler {
       return "2";
     else if (Value == "mman")
       return "3";
+    else if (Value == "hybrid")
+      return "4";
     return "0";
   }
+  static inline std::optional<fextl::string> RegisterAllocatorHandler(std::string_view Value) {
+    if (Value == "graph")
+      return "0";
+    else if (Value == "linear")
+      return "1";
+    else if (Value == "tiered")
+      return "2";
+    return "2";
+  }
   static inline std::optional<fextl::string> CacheObjectCodeHandler(std::string_view Value) {
     if (Value == "none")
       return "0";
@@ -70,6 +81,13 @@ namespace Handler {
     CONFIG_SMC_MTRACK,
     CONFIG_SMC_FULL,
     CONFIG_SMC_MMAN,
+    CONFIG_SMC_HYBRID,
+  };
+
+  enum ConfigRegisterAllocator {
+    CONFIG_RA_GRAPH,
+    CONFIG_RA_LINEAR,
+    CONFIG_RA_TIERED,
   };
 
   enum ConfigObjectCodeHandler {
@@ -82,6 +100,7 @@ namespace Handler {
     LAYER_GLOBAL_MAIN, ///< /usr/share/fex-emu/Config.json by default
     LAYER_MAIN,
     LAYER_ARGUMENTS,
+    LAYER_LEARNED_APP, ///< Written by LearnAppConfig, below every user written app config
     LAYER_GLOBAL_STEAM_APP,
     LAYER_GLOBAL_APP,
     LAYER_LOCAL_STEAM_APP,
@@ -232,6 +251,8 @@ namespace Type {
   FEX_DEFAULT_VISIBILITY fextl::string FindContainerPrefix();
 
   FEX_DEFAULT_VISIBILITY void AddLayer(fextl::unique_ptr<FEXCore::Config::Layer> _Layer);
+  // Only takes effect on the next ReloadMetaLayer
+  FEX_DEFAULT_VISIBILITY void RemoveLayer(LayerType Type);
 
   FEX_DEFAULT_VISIBILITY bool Exists(ConfigOption Option);
   FEX_DEFAULT_VISIBILITY std::optional<LayerValue*> All(ConfigOption Option);
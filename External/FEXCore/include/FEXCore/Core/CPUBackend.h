@@ -13,6 +13,7 @@ $end_info$
 
 #include <cstdint>
 #include <memory>
+#include <mutex>
 
 namespace FEXCore {
 
@@ -44,6 +45,31 @@ namespace CPU {
     struct CodeBuffer {
       uint8_t *Ptr;
       size_t Size;
+      // Used part of the far branch veneer pool that follows the buffer
+      size_t VeneerOffset;
+    };
+
+    // Every code buffer is followed by a pool of far branch veneers, in direct branch range of all of the buffer's code.
+    // Buffers are at most 128MB, so a veneer after the end is always reachable.
+    constexpr static size_t VeneerPoolSize = 1024 * 1024;
+
+    /**
+     * @brief A code buffer that every CPUBackend in the process emits in to
+     *
+     * Only used when the `SharedCodeCache` option is enabled.
+     * Emission is serialized through `Lock`, each backend moves its cursor to `Offset` before compiling
+     * and publishes its new cursor once the block is finished.
+     */
+    struct SharedCodeArena {
+      ~SharedCodeArena();
+
+      std::recursive_mutex Lock;
+      CodeBuffer Buffer{};
+      size_t Offset{};
+
+      // Buffers that were replaced once the arena filled up.
+      // Other threads may still be executing code from these so they are only freed at shutdown.
+      fextl::vector<CodeBuffer> RetiredBuffers;
     };
 
     /**
@@ -128,13 +154,15 @@ namespace CPU {
      *
      * @param IR -  IR that maps to the IR for this RIP
      * @param DebugData - Debug data that is available for this IR indirectly
+     * @param HotBlock - The block is known to execute frequently, the backend may keep it apart from the rest of the code
      *
      * @return Information about the compiled code block.
      */
     [[nodiscard]] virtual CompiledCode CompileCode(uint64_t Entry,
                                             FEXCore::IR::IRListView const *IR,
                                             FEXCore::Core::DebugData *DebugData,
-                                            FEXCore::IR::RegisterAllocationData *RAData, bool GDBEnabled) = 0;
+                                            FEXCore::IR::RegisterAllocationData *RAData, bool GDBEnabled,
+                                            bool HotBlock) = 0;
 
     /**
      * @brief Relocates a block of code from the JIT code object cache
@@ -142,9 +170,9 @@ namespace CPU {
      * @param Entry - RIP of the entry
      * @param SerializationData - Serialization data referring to the object cache for `Entry`
      *
-     * @return An executable function pointer relocated from the cache object
+     * @return Information about the relocated code block, `BlockEntry` is nullptr if it couldn't be relocated
      */
-    [[nodiscard]] virtual void *RelocateJITObjectCode(uint64_t Entry, CodeSerialize::CodeObjectFileSection const *SerializationData) { return nullptr; }
+    [[nodiscard]] virtual CompiledCode RelocateJITObjectCode(uint64_t Entry, CodeSerialize::CodeObjectFileSection const *SerializationData) { return {}; }
 
     /**
      * @brief Function for mapping memory in to the CPUBackend's visible space. Allows setting up virtual mappings if required
@@ -178,9 +206,57 @@ namespace CPU {
      */
     virtual void ClearRelocations() {}
 
+    /**
+     * @brief Leaves the current code buffer as-is and emits all further code in to a new one
+     *
+     * Existing blocks stay valid. Used after fork so the inherited code pages remain shared with the parent.
+     */
+    virtual void SealCodeBuffer() {}
+
+    /**
+     * @brief Moves the backend over to a new thread object
+     *
+     * Used when the compiler state of an exited thread is handed to a newly created one
+     */
+    void SetThreadState(FEXCore::Core::InternalThreadState *Thread) {
+      ThreadState = Thread;
+    }
+
     bool IsAddressInCodeBuffer(uintptr_t Address) const;
 
+    /**
+     * @brief Allocates space for a far branch veneer in direct branch range of `Near`
+     *
+     * Veneers are only freed when their code buffer is cleared.
+     *
+     * @return nullptr when `Near` isn't in a code buffer or its veneer pool is full
+     */
+    uint8_t *AllocateVeneer(uintptr_t Near, size_t Size);
+
+    // Calls Func with each of the backend's own code buffers, a shared code arena isn't included
+    template<typename F>
+    void ForEachCodeBuffer(F &&Func) const {
+      for (const auto &Buffer : CodeBuffers) {
+        Func(Buffer);
+      }
+      if (HotCodeBuffer.Ptr) {
+        Func(HotCodeBuffer);
+      }
+    }
+
   protected:
+    // Claims the shared arena's lock for the duration of a compile.
+    // The backend must move its emitter cursor to `SharedArena->Offset` after claiming.
+    // Returns an unowned lock when the code cache isn't shared.
+    [[nodiscard]] std::unique_lock<std::recursive_mutex> ClaimSharedCodeArena();
+
+    // Publishes the new end of the emitted code to the shared arena.
+    void ReleaseSharedCodeArena(size_t CursorOffset) {
+      if (SharedArena) {
+        SharedArena->Offset = CursorOffset;
+      }
+    }
+
     // Max spill slot size in bytes. We need at most 32 bytes
     // to be able to handle a 256-bit vector store to a slot.
     constexpr static uint32_t MaxSpillSlotSize = 32;
@@ -189,13 +265,23 @@ namespace CPU {
 
     size_t InitialCodeSize, MaxCodeSize;
     [[nodiscard]] CodeBuffer *GetEmptyCodeBuffer();
+    // Switches to a newly allocated buffer while keeping the current one alive until the next full clear
+    [[nodiscard]] CodeBuffer *GetFreshCodeBuffer();
 
     // This is the current code buffer that we are tracking
     CodeBuffer *CurrentCodeBuffer{};
 
+    // Non-null when all threads share a single code arena
+    SharedCodeArena *SharedArena{};
+
+    // Returns the separate buffer for hot blocks, allocated on first use.
+    // Returns nullptr with a shared code arena.
+    [[nodiscard]] CodeBuffer *GetHotCodeBuffer();
+
   private:
     CodeBuffer AllocateNewCodeBuffer(size_t Size);
-    void FreeCodeBuffer(CodeBuffer Buffer);
+    static void FreeCodeBuffer(CodeBuffer Buffer);
+    CodeBuffer *GetEmptySharedCodeBuffer();
 
     void EmplaceNewCodeBuffer(CodeBuffer Buffer) {
       CurrentCodeBuffer = &CodeBuffers.emplace_back(Buffer);
@@ -204,6 +290,9 @@ namespace CPU {
     // This is the array of code buffers. Unless signals force us to keep more than
     // buffer, there will be only one entry here
     fextl::vector<CodeBuffer> CodeBuffers{};
+
+    // Backing for GetHotCodeBuffer, only freed with the backend
+    CodeBuffer HotCodeBuffer{};
   };
 
 }
@@ -1,4 +1,5 @@
 #pragma once
+#include <atomic>
 #include <functional>
 #include <stdint.h>
 
@@ -81,6 +82,13 @@ namespace FEXCore::Context {
       virtual void Close() = 0;
   };
 
+  // Per thread AOTIR generation counters, written by the compiling thread and read by progress reporting
+  struct AOTGenStats {
+    std::atomic<uint64_t> Blocks{};
+    std::atomic<uint64_t> GuestBytes{};
+    std::atomic<uint64_t> IRBytes{};
+  };
+
   struct VDSOSigReturn {
     void *VDSO_kernel_sigreturn;
     void *VDSO_kernel_rt_sigreturn;
@@ -88,6 +96,11 @@ namespace FEXCore::Context {
 
   using CodeRangeInvalidationFn = std::function<void(uint64_t start, uint64_t Length)>;
 
+  struct CodeRange {
+    uint64_t Start;
+    uint64_t Length;
+  };
+
   using CustomCPUFactoryType = std::function<fextl::unique_ptr<CPU::CPUBackend>(Context*, Core::InternalThreadState *Thread)>;
   using CustomIREntrypointHandler = std::function<void(uintptr_t Entrypoint, IR::IREmitter *)>;
 
@@ -97,6 +110,7 @@ namespace FEXCore::Context {
   using AOTIRLoaderCBFn = std::function<int(const fextl::string&)>;
   using AOTIRRenamerCBFn = std::function<void(const fextl::string&)>;
   using AOTIRWriterCBFn = std::function<fextl::unique_ptr<AOTIRWriter>(const fextl::string&)>;
+  using CodeObjectFileOpenerCBFn = std::function<int(const fextl::string&)>;
 
   class Context {
     public:
@@ -175,6 +189,13 @@ namespace FEXCore::Context {
        */
       FEX_DEFAULT_VISIBILITY virtual ExitReason RunUntilExit() = 0;
 
+      /**
+       * @brief Logs the results of every enabled profile
+       *
+       * RunUntilExit does this on exit, tools that only compile code call it themselves.
+       */
+      FEX_DEFAULT_VISIBILITY virtual void DumpProfiles() = 0;
+
       /**
        * @brief Executes the supplied thread context on the current thread until a return is requested
        */
@@ -250,6 +271,19 @@ namespace FEXCore::Context {
 
       FEX_DEFAULT_VISIBILITY virtual uint64_t RestoreRIPFromHostPC(FEXCore::Core::InternalThreadState *Thread, uint64_t HostPC) = 0;
 
+      /**
+       * @brief Builds the architectural EFLAGS value from a guest state
+       *
+       * FEX doesn't store all flags as individual bits, PF and AF are kept in their pre-calculation form
+       * and CF/ZF/SF/OF are packed in to NZCV. Anything looking at the flags outside of the JIT needs to go through this.
+       */
+      FEX_DEFAULT_VISIBILITY virtual uint32_t ReconstructCompactedEFLAGS(const FEXCore::Core::CPUState *State) const = 0;
+
+      /**
+       * @brief Sets the guest state flags from an architectural EFLAGS value
+       */
+      FEX_DEFAULT_VISIBILITY virtual void SetFlagsFromCompactedEFLAGS(FEXCore::Core::CPUState *State, uint32_t EFLAGS) const = 0;
+
       FEX_DEFAULT_VISIBILITY virtual FEXCore::Core::InternalThreadState* CreateThread(FEXCore::Core::CPUState *NewThreadState, uint64_t ParentTID) = 0;
       FEX_DEFAULT_VISIBILITY virtual void ExecutionThread(FEXCore::Core::InternalThreadState *Thread) = 0;
       FEX_DEFAULT_VISIBILITY virtual void InitializeThread(FEXCore::Core::InternalThreadState *Thread) = 0;
@@ -270,17 +304,79 @@ namespace FEXCore::Context {
       FEX_DEFAULT_VISIBILITY virtual FEXCore::IR::AOTIRCacheEntry *LoadAOTIRCacheEntry(const fextl::string& Name) = 0;
       FEX_DEFAULT_VISIBILITY virtual void UnloadAOTIRCacheEntry(FEXCore::IR::AOTIRCacheEntry *Entry) = 0;
 
+      /**
+       * @brief Maps the AOT IR bundle of an application through the AOTIR loader
+       *
+       * A bundle holds the caches of every library the application loads, behind one index.
+       * Call after SetAOTIRLoader and before any ELF is mapped.
+       *
+       * @param Filename - Path of the application's main executable
+       */
+      FEX_DEFAULT_VISIBILITY virtual void LoadAOTIRBundle(const fextl::string &Filename) = 0;
+      /**
+       * @brief Writes the AOT IR caches of every library this process loaded in to the application's bundle
+       *
+       * Call after FinalizeAOTIRCache.
+       *
+       * @param Filename - Path of the application's main executable
+       */
+      FEX_DEFAULT_VISIBILITY virtual void WriteAOTIRBundle(const fextl::string &Filename) = 0;
+
+      /**
+       * @brief Notifies the code object cache that a file backed executable region was mapped
+       *
+       * Cached host code for the region is loaded asynchronously and used for blocks compiled from it.
+       *
+       * @param Base - Guest address the region is mapped at
+       * @param Size - Size of the mapping
+       * @param Offset - Offset in to the file that is mapped at Base
+       * @param Filename - Path of the backing file
+       */
+      FEX_DEFAULT_VISIBILITY virtual void AddNamedRegion(uintptr_t Base, uintptr_t Size, uintptr_t Offset, const fextl::string &Filename) = 0;
+      /**
+       * @brief Notifies the code object cache that any named region overlapping the range was unmapped
+       */
+      FEX_DEFAULT_VISIBILITY virtual void RemoveNamedRegion(uintptr_t Base, uintptr_t Size) = 0;
+
       FEX_DEFAULT_VISIBILITY virtual void SetAOTIRLoader(AOTIRLoaderCBFn CacheReader) = 0;
       FEX_DEFAULT_VISIBILITY virtual void SetAOTIRWriter(AOTIRWriterCBFn CacheWriter) = 0;
       FEX_DEFAULT_VISIBILITY virtual void SetAOTIRRenamer(AOTIRRenamerCBFn CacheRenamer) = 0;
+      /**
+       * @brief Lets the frontend provide the object cache files of named regions
+       *
+       * @param Opener Called with the object file's name, returns an FD opened for reading and appending,
+       * or -1 to use the file in the data directory
+       */
+      FEX_DEFAULT_VISIBILITY virtual void SetCodeObjectFileOpener(CodeObjectFileOpenerCBFn Opener) = 0;
 
       FEX_DEFAULT_VISIBILITY virtual void FinalizeAOTIRCache() = 0;
       FEX_DEFAULT_VISIBILITY virtual void WriteFilesWithCode(AOTIRCodeFileWriterFn Writer) = 0;
       FEX_DEFAULT_VISIBILITY virtual void InvalidateGuestCodeRange(FEXCore::Core::InternalThreadState *Thread, uint64_t Start, uint64_t Length) = 0;
       FEX_DEFAULT_VISIBILITY virtual void InvalidateGuestCodeRange(FEXCore::Core::InternalThreadState *Thread, uint64_t Start, uint64_t Length, CodeRangeInvalidationFn callback) = 0;
+      /**
+       * @brief Invalidates like InvalidateGuestCodeRange, for when the guest code is only about to become writable
+       *
+       * Blocks compiled from the range are kept aside and used again if their guest code is unchanged the next time they run.
+       * The range must stay readable until InvalidateGuestCodeRange is called for it.
+       */
+      FEX_DEFAULT_VISIBILITY virtual void SuspendGuestCodeRange(FEXCore::Core::InternalThreadState *Thread, uint64_t Start, uint64_t Length) = 0;
+      FEX_DEFAULT_VISIBILITY virtual void SuspendGuestCodeRange(FEXCore::Core::InternalThreadState *Thread, uint64_t Start, uint64_t Length, CodeRangeInvalidationFn callback) = 0;
+      /**
+       * @brief SuspendGuestCodeRange for several ranges under a single lock, such as the mirrors of a shared page
+       *
+       * @param CallAfter Runs once every range is done, before code can be compiled from any of them again
+       */
+      FEX_DEFAULT_VISIBILITY virtual void SuspendGuestCodeRanges(FEXCore::Core::InternalThreadState *Thread, const fextl::vector<CodeRange> &Ranges, std::function<void()> CallAfter) = 0;
+      /**
+       * @brief Tells FEXCore that the guest code in [OldStart, OldStart + Length) now lives at NewStart
+       *
+       * Lets code compiled for the old range be rebuilt at the new one from its IR.
+       * Doesn't invalidate anything, the old range still needs InvalidateGuestCodeRange.
+       */
+      FEX_DEFAULT_VISIBILITY virtual void MigrateGuestCodeRange(uint64_t OldStart, uint64_t NewStart, uint64_t Length) = 0;
       FEX_DEFAULT_VISIBILITY virtual void MarkMemoryShared() = 0;
 
-      FEX_DEFAULT_VISIBILITY virtual void ConfigureAOTGen(FEXCore::Core::InternalThreadState *Thread, fextl::set<uint64_t> *ExternalBranches, uint64_t SectionMaxAddress) = 0;
+      FEX_DEFAULT_VISIBILITY virtual void ConfigureAOTGen(FEXCore::Core::InternalThreadState *Thread, fextl::set<uint64_t> *ExternalBranches, uint64_t SectionMaxAddress, AOTGenStats *Stats = nullptr) = 0;
       FEX_DEFAULT_VISIBILITY virtual CustomIRResult AddCustomIREntrypoint(uintptr_t Entrypoint, CustomIREntrypointHandler Handler, void *Creator = nullptr, void *Data = nullptr) = 0;
 
       /**
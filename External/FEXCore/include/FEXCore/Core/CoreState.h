@@ -245,6 +245,8 @@ namespace FEXCore::Core {
       uint64_t ExitFunctionLinker{};
       uint64_t ThreadStopHandlerSpillSRA{};
       uint64_t ThreadPauseHandlerSpillSRA{};
+      uint64_t SafepointHandlerSpillSRA{};
+      uint64_t GdbStopHandlerSpillSRA{};
       uint64_t UnimplementedInstructionHandler{};
       uint64_t GuestSignal_SIGILL{};
       uint64_t GuestSignal_SIGTRAP{};
@@ -252,8 +254,15 @@ namespace FEXCore::Core {
       uint64_t SignalReturnHandler{};
       uint64_t SignalReturnHandlerRT{};
       uint64_t L1Pointer{};
+      // Index mask of the L1, the L1 is resized while the thread runs
+      uint64_t L1Mask{};
       uint64_t L2Pointer{};
+      // Invalidation epochs of the lookup cache, indexed by the guest page number
+      uint64_t LookupCacheEpochPointer{};
       /**  @} */
+
+      // Telemetry::ThreadCounters of this thread, null when telemetry is disabled
+      uint64_t TelemetryCounters{};
     } Common;
 
     union {
@@ -308,8 +317,48 @@ namespace FEXCore::Core {
     */
     uint64_t InSyscallInfo{};
 
+    /**
+     * @brief Signals the host has to block before the thread's next syscall
+     *
+     * The frontend only emulates the guest signal mask. Signals the guest masked without the host following
+     * could otherwise interrupt a blocking syscall with EINTR. Cleared by whoever applies it.
+     */
+    uint64_t PendingHostSignalMask{};
+
+    /**
+     * @brief Address and byte loaded by the thread's last SpinWait
+     *
+     * SpinWait only waits for an event when it loads the same byte from the same address again.
+     */
+    uint64_t SpinWaitAddress{};
+    uint64_t SpinWaitValue{};
+
     uint32_t SignalHandlerRefCounter{};
 
+    /**
+     * @brief Set by ContextImpl::NotifyPause when the thread should pause at its next block entry
+     *
+     * Only polled by the JIT when the Safepoints option is enabled.
+     * The thread clears it when it goes to sleep, the pausing thread clears it when it falls back to a signal.
+     */
+    std::atomic<uint32_t> SafepointRequested{};
+
+    /**
+     * @brief Per thread debugger run state, only polled by the JIT when the gdb server is enabled
+     *
+     * GDB_RUN: Runs blocks, blocks with a breakpoint on their entry still stop.
+     * GDB_STOP: Stops at the next block entry.
+     * GDB_STEP: Runs the block being entered and moves to GDB_STOP.
+     * GDB_RESUME: Runs the block being entered even if it has a breakpoint and moves to GDB_RUN.
+     */
+    std::atomic<uint32_t> GdbStop{};
+    enum GdbStopState : uint32_t {
+      GDB_RUN,
+      GDB_STOP,
+      GDB_STEP,
+      GDB_RESUME,
+    };
+
     struct alignas(8) SynchronousFaultDataStruct {
       bool FaultToTopAndGeneratedException{};
       uint8_t Signal;
@@ -323,11 +372,29 @@ namespace FEXCore::Core {
 
     // Pointers that the JIT needs to load to remove relocations
     JITPointers Pointers;
+
+    /**
+     * @name Return stack buffer
+     *
+     * Circular stack of guest return addresses pushed by CALL, and the host code to resume at.
+     * RET pops an entry and only uses it if the guest address matches the real return address.
+     * Overflowing silently drops the oldest entry.
+     * @{ */
+    static constexpr size_t RETURN_STACK_ENTRIES = 32; // Must be a power of 2
+    static constexpr size_t RETURN_STACK_MASK = RETURN_STACK_ENTRIES - 1;
+    uint64_t ReturnStackTop{};
+    struct ReturnStackEntry {
+      uint64_t GuestRIP;
+      uint64_t HostCode;
+    } ReturnStack[RETURN_STACK_ENTRIES]{};
+    /**  @} */
   };
   static_assert(offsetof(CpuStateFrame, State) == 0, "CPUState must be first member in CpuStateFrame");
   static_assert(offsetof(CpuStateFrame, State.rip) == 0, "rip must be zero offset in CpuStateFrame");
   static_assert(offsetof(CpuStateFrame, Pointers) % 8 == 0, "JITPointers need to be aligned to 8 bytes");
   static_assert(offsetof(CpuStateFrame, Pointers) + sizeof(CpuStateFrame::Pointers) <= 32760, "JITPointers maximum pointer needs to be less than architecture maximum 32768");
+  static_assert(offsetof(CpuStateFrame, ReturnStackTop) <= 32760, "ReturnStackTop needs to be less than architecture maximum 32768");
+  static_assert(sizeof(CpuStateFrame::ReturnStackEntry) == 16, "JIT indexes the return stack with a shift by 4");
 
   static_assert(std::is_standard_layout<CpuStateFrame>::value, "This needs to be standard layout");
   static_assert(sizeof(CpuStateFrame::SynchronousFaultData) == 8, "This needs to be 8 bytes");
@@ -6,6 +6,15 @@ class HostFeatures final {
   public:
     HostFeatures();
 
+    /**
+     * @brief Switches the calling thread to the host's hardware TSO memory model
+     *
+     * Threads created afterwards by the calling thread inherit it.
+     *
+     * @return true if the thread now runs with hardware TSO
+     */
+    static bool EnableHardwareTSO();
+
     /**
      * @brief Backend features that change how codegen is generated from IR
      *
@@ -25,12 +34,22 @@ class HostFeatures final {
     bool SupportsSSE4A{};
     bool SupportsAVX{};
     bool SupportsSVE{};
+    ///< Host vector registers are at least 256-bit, otherwise AVX is split in to 128-bit halves
+    bool SupportsSVE256{};
+    bool SupportsSVE2{};
+    bool SupportsSVEBitPerm{};
     bool SupportsSHA{};
     bool SupportsBMI1{};
     bool SupportsBMI2{};
     bool SupportsCLWB{};
     bool SupportsPMULL_128Bit{};
     bool SupportsCSSC{};
+    ///< FEAT_MOPS memory copy and set instructions
+    bool SupportsMOPS{};
+    ///< The kernel periodically sends events to wake WFE, so a WFE without a matching SEV can't sleep forever
+    bool SupportsWFEEventStream{};
+    ///< The kernel can switch threads to a hardware TSO memory model, such as Apple's through ACTLR
+    bool SupportsHardwareTSO{};
 
     // Float exception behaviour
     bool SupportsFlushInputsToZero{};
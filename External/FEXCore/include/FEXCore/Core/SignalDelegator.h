@@ -75,6 +75,8 @@ namespace Core {
     struct SignalDelegatorConfig {
       bool StaticRegisterAllocation{};
       bool SupportsAVX{};
+      // Guest DAZ is mapped on to the host's FPCR.FIZ
+      bool SupportsFlushInputsToZero{};
 
       // Dispatcher information
       uint64_t DispatcherBegin;
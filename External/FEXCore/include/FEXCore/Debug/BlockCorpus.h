@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+
+namespace FEXCore::BlockCorpus {
+/**
+ * @brief On-disk layout of a block corpus recorded with RecordBlockCorpus
+ *
+ * A FileHeader followed by one BlockHeader per compiled block, each directly followed by CodeLength bytes of guest code.
+ * Blocks are in compile order, a block recompiled after its code changed shows up again with the new bytes.
+ */
+constexpr char Magic[8] = {'F', 'E', 'X', 'B', 'L', 'K', 'C', '1'};
+constexpr uint32_t Version = 1;
+
+struct FileHeader {
+  char Magic[8];
+  uint32_t Version;
+  // Entry state shared by every block in the corpus
+  uint32_t Is64BitMode;
+};
+
+struct BlockHeader {
+  uint64_t GuestRIP;
+  // Guest code range decoded for the block, GuestRIP lies within it
+  uint64_t CodeStart;
+  uint32_t CodeLength;
+  uint32_t Pad;
+};
+
+static_assert(sizeof(FileHeader) == 16);
+static_assert(sizeof(BlockHeader) == 24);
+}
@@ -5,6 +5,7 @@
 #include <FEXCore/Core/SignalDelegator.h>
 #include <FEXCore/IR/IntrusiveIRList.h>
 #include <FEXCore/IR/RegisterAllocationData.h>
+#include <FEXCore/Utils/BumpArena.h>
 #include <FEXCore/Utils/Event.h>
 #include <FEXCore/Utils/InterruptableConditionVariable.h>
 #include <FEXCore/Utils/Threads.h>
@@ -77,6 +78,8 @@ namespace FEXCore::Core {
       std::atomic_bool WaitingToStart {true};
       std::atomic_bool EarlyExit {false};
       std::atomic_bool ThreadSleeping {false};
+      // Sleeping in the gdb stop handler at a block entry, rather than paused by a signal
+      std::atomic_bool GdbStoppedAtBlockEntry {false};
     } RunningEvents;
 
     FEXCore::Context::Context *CTX;
@@ -90,12 +93,21 @@ namespace FEXCore::Core {
     fextl::unique_ptr<FEXCore::IR::OpDispatchBuilder> OpDispatcher;
 
     fextl::unique_ptr<FEXCore::CPU::CPUBackend> CPUBackend;
-    fextl::unique_ptr<FEXCore::LookupCache> LookupCache;
+    // Points at either LocalLookupCache or the context's shared lookup cache.
+    FEXCore::LookupCache *LookupCache{};
+    fextl::unique_ptr<FEXCore::LookupCache> LocalLookupCache;
 
+    // Only filled with RetainBlockIR, RestoreRIPFromHostPC uses the RIP table at the end of each block instead
     fextl::robin_map<uint64_t, LocalIREntry> DebugStore;
+    // Single instruction blocks for gdb stepping, kept out of the lookup cache
+    fextl::robin_map<uint64_t, uintptr_t> DebugStepBlocks;
 
     fextl::unique_ptr<FEXCore::Frontend::Decoder> FrontendDecoder;
     fextl::unique_ptr<FEXCore::IR::PassManager> PassManager;
+    // Minimal pass pipeline for tier 0 blocks, only allocated when tiered compilation is enabled
+    fextl::unique_ptr<FEXCore::IR::PassManager> Tier0PassManager;
+    // Transient data of the block currently being compiled, reset once CompileBlock finishes
+    FEXCore::Utils::BumpArena CompileArena;
     FEXCore::HLE::ThreadManagement ThreadManager;
 
     int StatusCode{};
@@ -103,7 +115,17 @@ namespace FEXCore::Core {
     std::shared_ptr<FEXCore::CompileService> CompileService;
 
     std::shared_mutex ObjectCacheRefCounter{};
+    // Only set on AOTIRGenerate compilation threads
+    FEXCore::Context::AOTGenStats *AOTGenStats{};
     bool DestroyedByParent{false};  // Should the parent destroy this thread, or it destory itself
+    // Index of the NUMA node the thread is pinned to, -1 when it isn't pinned
+    int32_t NUMANode{-1};
+
+    // Changes on every entry to a frontend syscall, odd while the thread is inside one.
+    // A syscall left through a signal keeps it odd until the next one.
+    std::atomic<uint64_t> SyscallSequence{};
+    // SyscallSequence as of the previous idle lookup cache check, only used under ThreadCreationMutex
+    uint64_t IdleCheckSyscallSequence{};
 
     struct DeferredSignalState {
 #ifndef _WIN32
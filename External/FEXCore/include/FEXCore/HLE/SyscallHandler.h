@@ -71,10 +71,23 @@ namespace FEXCore::HLE {
     virtual uint64_t HandleSyscall(FEXCore::Core::CpuStateFrame *Frame, FEXCore::HLE::SyscallArguments *Args) = 0;
     virtual SyscallABI GetSyscallABI(uint64_t Syscall) = 0;
     virtual FEXCore::IR::SyscallFlags GetSyscallFlags(uint64_t Syscall) const { return FEXCore::IR::SyscallFlags::DEFAULT; }
+    /**
+     * @brief Host syscall to pass a syscall through to given the arguments known at compile time
+     *
+     * For syscalls that need argument conversion in general but not for every argument value.
+     * Argument i of Args is only valid if bit i of ConstantMask is set.
+     *
+     * @return The host syscall number, or -1 if the syscall must go through the handler
+     */
+    virtual int32_t GetPassthroughHostSyscall(uint64_t Syscall, const SyscallArguments &Args, uint32_t ConstantMask) const { return -1; }
 
     SyscallOSABI GetOSABI() const { return OSABI; }
     virtual FEXCore::CodeLoader *GetCodeLoader() const { return nullptr; }
     virtual void MarkGuestExecutableRange(FEXCore::Core::InternalThreadState *Thread, uint64_t Start, uint64_t Length) { }
+    // Code in this range isn't write protected, blocks decoded from it need to validate their code inline
+    virtual bool NeedsInlineSMCChecks(uint64_t Start, uint64_t Length) const { return false; }
+    // The whole range is in a private file mapping without write permission, so its contents only change if it is remapped
+    virtual bool IsReadOnlyFileMapping(uint64_t Start, uint64_t Length) { return false; }
     virtual AOTIRCacheEntryLookupResult LookupAOTIRCacheEntry(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestAddr) = 0;
 
     virtual SourcecodeResolver *GetSourcecodeResolver() { return nullptr; }
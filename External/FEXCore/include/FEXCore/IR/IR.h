@@ -331,8 +331,9 @@ static_assert(std::is_trivially_copyable_v<OrderedNode>);
 static_assert(offsetof(OrderedNode, Header) == 0);
 static_assert(sizeof(OrderedNode) == (sizeof(OrderedNodeHeader) + sizeof(uint32_t)));
 
+// Stored in every memory and context access op, only needs to hold the handful of classes below.
 struct RegisterClassType final {
-  using value_type = uint32_t;
+  using value_type = uint8_t;
 
   value_type Val;
   [[nodiscard]] constexpr operator value_type() const {
@@ -509,6 +510,12 @@ enum class SyscallFlags : uint8_t {
   // Usually used with !NOSYNCSTATEONENTRY, so the syscall can modify CPU state entirely.
   // Then on return FEXCore picks up the new state.
   NORETURNEDRESULT   = 1 << 4,
+  // Syscall result is stable for the life of the process and the frontend answers it from a cache.
+  // Must always reach the frontend, so it's never replaced with an inline host syscall.
+  CACHEABLE          = 1 << 5,
+  // Syscall only changes the emulated signal mask.
+  // PendingHostSignalMask isn't applied before it, the syscall could unmask those signals again.
+  SIGNALMASK         = 1 << 6,
 };
 
 FEX_DEF_NUM_OPS(SyscallFlags)
@@ -36,6 +36,8 @@ friend class FEXCore::IR::PassManager;
 
     IRListView ViewIR() { return IRListView(&DualListData, false); }
     IRListView *CreateIRCopy() { return new IRListView(&DualListData, true); }
+    // Only valid until Arena is reset
+    IRListView *CreateIRCopy(FEXCore::Utils::BumpArena &Arena) { return Arena.New<IRListView>(&DualListData, Arena); }
     void ResetWorkingList();
 
   /**
@@ -3,6 +3,7 @@
 #include "FEXCore/IR/IR.h"
 #include <FEXCore/Core/Context.h>
 #include <FEXCore/Utils/Allocator.h>
+#include <FEXCore/Utils/BumpArena.h>
 #include <FEXCore/Utils/LogManager.h>
 #include <FEXCore/Utils/ThreadPoolAllocator.h>
 #include <FEXCore/fextl/vector.h>
@@ -148,6 +149,36 @@ public:
     }
   }
 
+  /**
+   * @brief Copies the IR in to Arena
+   *
+   * The view is marked shared since the arena owns the data, it is only valid until the arena is reset
+   */
+  IRListView(DualIntrusiveAllocator *Data, FEXCore::Utils::BumpArena &Arena) {
+    SetShared(true);
+    DataSize = Data->DataSize();
+    ListSize = Data->ListSize();
+
+    IRDataInternal = Arena.Allocate(DataSize + ListSize, alignof(OrderedNode));
+    ListDataInternal = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(IRDataInternal) + DataSize);
+    memcpy(IRDataInternal, reinterpret_cast<void*>(Data->DataBegin()), DataSize);
+    memcpy(ListDataInternal, reinterpret_cast<void*>(Data->ListBegin()), ListSize);
+  }
+
+  /**
+   * @brief Copies another view's IR in to Arena, with the same lifetime as the constructor above
+   */
+  IRListView(IRListView const *Old, FEXCore::Utils::BumpArena &Arena) {
+    SetShared(true);
+    DataSize = Old->DataSize;
+    ListSize = Old->ListSize;
+
+    IRDataInternal = Arena.Allocate(DataSize + ListSize, alignof(OrderedNode));
+    ListDataInternal = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(IRDataInternal) + DataSize);
+    memcpy(IRDataInternal, Old->IRDataInternal, DataSize);
+    memcpy(ListDataInternal, Old->ListDataInternal, ListSize);
+  }
+
   IRListView(IRListView *Old, bool _IsCopy) {
     SetCopy(_IsCopy);
     DataSize = Old->DataSize;
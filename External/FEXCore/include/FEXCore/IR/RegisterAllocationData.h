@@ -2,6 +2,7 @@
 #include "IR.h"
 #include <FEXCore/Core/Context.h>
 #include <FEXCore/Utils/Allocator.h>
+#include <FEXCore/Utils/BumpArena.h>
 #include <cstring>
 
 namespace FEXCore::IR {
@@ -58,6 +59,11 @@ class FEX_PACKED RegisterAllocationData {
 
     UniquePtr CreateCopy() const;
 
+    /**
+     * @brief Copies in to Arena, the copy is marked shared so it is never freed and lives until the arena is reset
+     */
+    UniquePtr CreateCopy(FEXCore::Utils::BumpArena &Arena) const;
+
     void Serialize(FEXCore::Context::AOTIRWriter& stream) const {
       stream.Write((const char*)&SpillSlotCount, sizeof(SpillSlotCount));
       stream.Write((const char*)&MapCount, sizeof(MapCount));
@@ -91,7 +97,17 @@ inline auto RegisterAllocationData::CreateCopy() const -> UniquePtr {
   memcpy((void*)&copy->Map[0], (void*)&Map[0], MapCount * sizeof(Map[0]));
   copy->SpillSlotCount = SpillSlotCount;
   copy->MapCount = MapCount;
-  copy->IsShared = IsShared;
+  // The copy is always owned, even when copying from a shared mapping
+  copy->IsShared = false;
+  return UniquePtr { copy };
+}
+
+inline auto RegisterAllocationData::CreateCopy(FEXCore::Utils::BumpArena &Arena) const -> UniquePtr {
+  auto copy = (RegisterAllocationData*)Arena.Allocate(Size(MapCount), alignof(RegisterAllocationData));
+  memcpy((void*)&copy->Map[0], (void*)&Map[0], MapCount * sizeof(Map[0]));
+  copy->SpillSlotCount = SpillSlotCount;
+  copy->MapCount = MapCount;
+  copy->IsShared = true;
   return UniquePtr { copy };
 }
 
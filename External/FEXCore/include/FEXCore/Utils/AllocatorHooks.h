@@ -53,6 +53,9 @@ namespace FEXCore::Allocator {
     // Protections are ignored but still required to be valid.
     ::VirtualAlloc(Ptr, Size, MEM_RESET, PAGE_NOACCESS);
   }
+  inline void VirtualHugePages(void *Ptr, size_t Size) {
+    // Large pages need to be requested at allocation time with a privilege, nothing to do here.
+  }
 
 #else
   using MMAP_Hook = void*(*)(void*, size_t, int, int, int, off_t);
@@ -75,6 +78,9 @@ namespace FEXCore::Allocator {
   inline void VirtualDontNeed(void *Ptr, size_t Size) {
     ::madvise(reinterpret_cast<void*>(Ptr), Size, MADV_DONTNEED);
   }
+  inline void VirtualHugePages(void *Ptr, size_t Size) {
+    ::madvise(Ptr, Size, MADV_HUGEPAGE);
+  }
 #endif
 
   // Memory allocation routines aliased to jemalloc functions.
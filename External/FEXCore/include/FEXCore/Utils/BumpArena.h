@@ -0,0 +1,139 @@
+#pragma once
+
+#include <FEXCore/Utils/AllocatorHooks.h>
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/Utils/MathUtils.h>
+#include <FEXCore/fextl/vector.h>
+#include <FEXHeaderUtils/TypeDefines.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace FEXCore::Utils {
+  /**
+   * @brief A bump allocator for data that only lives until the next Reset
+   *
+   * Allocations are never freed individually, Reset releases all of them at once.
+   * Destructors of objects created in the arena are never run.
+   *
+   * If a round of allocations doesn't fit in the current chunk then overflow chunks are allocated for the remainder.
+   * The next Reset replaces every chunk with a single one large enough for the whole round,
+   * so once warmed up the arena never allocates.
+   */
+  class BumpArena final {
+    public:
+      BumpArena() = default;
+      BumpArena(const BumpArena&) = delete;
+      BumpArena& operator=(const BumpArena&) = delete;
+
+      ~BumpArena() {
+        FreeChunks();
+      }
+
+      void *Allocate(size_t Size, size_t Alignment = alignof(std::max_align_t)) {
+        const uintptr_t Begin = AlignUp(Current, Alignment);
+        if (Begin + Size > End || Begin < Current) {
+          return AllocateSlow(Size, Alignment);
+        }
+
+        Current = Begin + Size;
+        return reinterpret_cast<void*>(Begin);
+      }
+
+      template<typename T, typename... Args>
+      T *New(Args&&... args) {
+        // Global placement new, FEXAllocOperators hides it
+        return ::new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+      }
+
+      /**
+       * @brief Releases every allocation
+       *
+       * Only the first Reset after an overflow touches the OS, otherwise this is a pointer reset.
+       */
+      void Reset() {
+        if (!Overflow.empty()) {
+          // Grow the main chunk to hold everything the last round needed
+          size_t NewSize = Main.Size;
+          for (const auto &Chunk : Overflow) {
+            NewSize += Chunk.Size;
+          }
+          FreeChunks();
+          AllocateMainChunk(NewSize);
+        }
+
+        Current = reinterpret_cast<uintptr_t>(Main.Ptr);
+      }
+
+      /**
+       * @brief Resets the arena when leaving the scope
+       */
+      class ScopedReset final {
+        public:
+          explicit ScopedReset(BumpArena &Arena) : Arena {Arena} {}
+          ~ScopedReset() { Arena.Reset(); }
+
+        private:
+          BumpArena &Arena;
+      };
+
+    private:
+      static constexpr size_t DEFAULT_CHUNK_SIZE = 1024 * 1024;
+
+      struct Chunk {
+        void *Ptr;
+        size_t Size;
+      };
+
+      // Only replaced by Reset, overflow chunks are allocated once the main chunk is full
+      Chunk Main {};
+      fextl::vector<Chunk> Overflow;
+      uintptr_t Current {};
+      uintptr_t End {};
+
+      static void *AllocateChunk(size_t Size) {
+        auto Ptr = FEXCore::Allocator::VirtualAlloc(Size);
+        LOGMAN_THROW_A_FMT(Ptr != nullptr && Ptr != reinterpret_cast<void*>(~0ULL), "Couldn't allocate BumpArena chunk");
+        return Ptr;
+      }
+
+      void AllocateMainChunk(size_t Size) {
+        Size = AlignUp(Size, FHU::FEX_PAGE_SIZE);
+        Main = {AllocateChunk(Size), Size};
+        Current = reinterpret_cast<uintptr_t>(Main.Ptr);
+        End = Current + Size;
+      }
+
+      void *AllocateSlow(size_t Size, size_t Alignment) {
+        if (!Main.Ptr) {
+          // First use, nothing to overflow from
+          AllocateMainChunk(std::max(DEFAULT_CHUNK_SIZE, Size + Alignment));
+        }
+        else {
+          const size_t ChunkSize = AlignUp(std::max(DEFAULT_CHUNK_SIZE, Size + Alignment), FHU::FEX_PAGE_SIZE);
+          auto Ptr = AllocateChunk(ChunkSize);
+          Overflow.emplace_back(Chunk {Ptr, ChunkSize});
+          Current = reinterpret_cast<uintptr_t>(Ptr);
+          End = Current + ChunkSize;
+        }
+
+        return Allocate(Size, Alignment);
+      }
+
+      void FreeChunks() {
+        for (const auto &Chunk : Overflow) {
+          FEXCore::Allocator::VirtualFree(Chunk.Ptr, Chunk.Size);
+        }
+        Overflow.clear();
+
+        if (Main.Ptr) {
+          FEXCore::Allocator::VirtualFree(Main.Ptr, Main.Size);
+          Main = {};
+        }
+        Current = End = 0;
+      }
+  };
+}
@@ -86,6 +86,38 @@ using MsgHandler = void(*)(DebugLevels Level, char const *Message);
 FEX_DEFAULT_VISIBILITY void InstallHandler(MsgHandler Handler);
 FEX_DEFAULT_VISIBILITY void UnInstallHandlers();
 
+/**
+ * @brief Moves handler dispatch of log messages off the logging threads
+ *
+ * Messages are formatted on the calling thread and queued in a buffer owned by that thread.
+ * A background thread drains the buffers and calls the installed handlers.
+ * ERROR, ASSERT and throw messages flush the queue and are handled synchronously, so they keep their order and make it out before a trap.
+ *
+ * Thread creation must be set up before this is called.
+ *
+ * @param RateLimit - Maximum number of DEBUG and INFO messages per second from a single format string, 0 to disable
+ */
+FEX_DEFAULT_VISIBILITY void EnableAsync(uint32_t RateLimit);
+
+/**
+ * @brief Flushes the queued messages and stops the background thread
+ *
+ * Must be called before the handlers are uninstalled.
+ */
+FEX_DEFAULT_VISIBILITY void DisableAsync();
+
+/**
+ * @brief Hands every queued message to the handlers before returning
+ */
+FEX_DEFAULT_VISIBILITY void FlushAsync();
+
+/**
+ * @brief Restarts the background thread in a forked child
+ *
+ * Buffers of threads that didn't survive the fork are dropped.
+ */
+FEX_DEFAULT_VISIBILITY void AsyncAfterFork();
+
 // Fmt-capable interface.
 
 FEX_DEFAULT_VISIBILITY void MFmtImpl(DebugLevels level, const char* fmt, const fmt::format_args& args);
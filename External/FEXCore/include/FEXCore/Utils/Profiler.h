@@ -24,13 +24,17 @@ static inline uint64_t GetTime() {
 // A class that follows scoping rules to generate a profile duration block
 class ProfilerBlock final {
   public:
-    ProfilerBlock(std::string_view const Format);
+    // Arg is attached to the event when not NO_ARG, eg. the guest RIP of a compile
+    constexpr static uint64_t NO_ARG = ~0ULL;
+
+    ProfilerBlock(std::string_view const Format, uint64_t Arg = NO_ARG);
 
     ~ProfilerBlock();
 
   private:
     uint64_t DurationBegin;
     std::string_view const Format;
+    uint64_t Arg;
 };
 
 #define UniqueScopeName2(name, line) name ## line
@@ -43,6 +47,10 @@ class ProfilerBlock final {
 #define FEXCORE_PROFILE_SCOPED(name) \
   FEXCore::Profiler::ProfilerBlock UniqueScopeName(ScopedBlock_, __LINE__) (name)
 
+// Declare a scoped profile block variable with a value attached to it.
+#define FEXCORE_PROFILE_SCOPED_ARG(name, arg) \
+  FEXCore::Profiler::ProfilerBlock UniqueScopeName(ScopedBlock_, __LINE__) (name, arg)
+
 #else
 [[maybe_unused]] static void Init() {}
 [[maybe_unused]] static void Shutdown() {}
@@ -51,5 +59,6 @@ class ProfilerBlock final {
 
 #define FEXCORE_PROFILE_INSTANT(...) do {} while(0)
 #define FEXCORE_PROFILE_SCOPED(...) do {} while(0)
+#define FEXCORE_PROFILE_SCOPED_ARG(...) do {} while(0)
 #endif
 }
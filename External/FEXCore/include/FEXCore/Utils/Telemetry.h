@@ -3,7 +3,10 @@
 #include <FEXCore/Utils/CompilerDefs.h>
 #include <FEXCore/fextl/string.h>
 
+#include <algorithm>
 #include <atomic>
+#include <bit>
+#include <stddef.h>
 #include <stdint.h>
 #include <type_traits>
 #include <filesystem>
@@ -43,9 +46,69 @@ namespace FEXCore::Telemetry {
 
   FEX_DEFAULT_VISIBILITY Value &GetTelemetryValue(TelemetryType Type);
 
+  // Performance counters
+  // Unlike the values above these are counted per thread, so they are cheap enough to sit on hot paths
+  enum CounterType {
+    COUNTER_BLOCKS_COMPILED,
+    COUNTER_CODE_CACHE_FLUSHES,
+    COUNTER_SMC_INVALIDATIONS,
+    COUNTER_BLOCKS_REINSTATED,
+    COUNTER_LOOKUP_L1_HITS,
+    COUNTER_LOOKUP_L2_HITS,
+    COUNTER_LOOKUP_L3_HITS,
+    COUNTER_LOOKUP_MISSES,
+    COUNTER_DISPATCHER_EXITS,
+    COUNTER_SIGNALS_DELIVERED,
+    COUNTER_HUGEPAGE_MAPPINGS,
+    COUNTER_LAST,
+  };
+
+  constexpr static size_t COMPILE_TIME_BUCKETS = 16;
+  constexpr static size_t MAX_SYSCALL_COUNTERS = 512;
+  constexpr static size_t MAX_FALLBACK_COUNTERS = 64;
+
+  /**
+   * @brief Performance counters of a single thread
+   *
+   * Only ever written by the owning thread, including from its JIT code, so no atomics are needed.
+   * Every thread's counters are summed in to the telemetry file at shutdown.
+   */
+  struct ThreadCounters {
+    uint64_t Counters[COUNTER_LAST];
+    // Bucket N counts compiles that took less than 2^N microseconds, the last bucket counts everything slower
+    uint64_t CompileTime[COMPILE_TIME_BUCKETS];
+    // Indexed by guest syscall number
+    uint64_t Syscalls[MAX_SYSCALL_COUNTERS];
+    // Indexed by FallbackInfo::HandlerIndex
+    uint64_t Fallbacks[MAX_FALLBACK_COUNTERS];
+  };
+
+  // Null on threads that never registered their counters
+  extern FEX_DEFAULT_VISIBILITY thread_local ThreadCounters *TLSThreadCounters;
+
+  // Allocates the calling thread's counters, counts are kept in the telemetry file after the thread unregisters
+  FEX_DEFAULT_VISIBILITY ThreadCounters *RegisterThreadCounters();
+  FEX_DEFAULT_VISIBILITY void UnregisterThreadCounters();
+
+  static inline void RecordCompileTime(uint64_t Nanoseconds) {
+    if (auto Counters = TLSThreadCounters) {
+      const size_t Bucket = std::min<size_t>(std::bit_width(Nanoseconds / 1000), COMPILE_TIME_BUCKETS - 1);
+      ++Counters->CompileTime[Bucket];
+    }
+  }
+
   FEX_DEFAULT_VISIBILITY void Initialize();
   FEX_DEFAULT_VISIBILITY void Shutdown(fextl::string const &ApplicationName);
 
+  /**
+   * @brief Sums the counters of every thread so far
+   *
+   * @param Total - Receives the sum
+   *
+   * @return Nanoseconds since Initialize
+   */
+  FEX_DEFAULT_VISIBILITY uint64_t GetCounterTotals(ThreadCounters *Total);
+
 // Telemetry object declaration
 // This returns the internal structure to the telemetry data structures
 // One must be careful with placing these in the hot path of code execution
@@ -58,12 +121,22 @@ namespace FEXCore::Telemetry {
 #define FEXCORE_TELEMETRY_OR(Name, Value) Name |= Value
 #define FEXCORE_TELEMETRY_INC(Name) Name++
 
+// Per-thread counter operations
+// A thread local load and an add, threads without registered counters don't count
+#define FEXCORE_TELEMETRY_COUNTER_INC(Type) do { if (auto Counters = FEXCore::Telemetry::TLSThreadCounters) { ++Counters->Counters[FEXCore::Telemetry::Type]; } } while(0)
+#define FEXCORE_TELEMETRY_SYSCALL_INC(Number) do { if (auto Counters = FEXCore::Telemetry::TLSThreadCounters; Counters && (Number) < FEXCore::Telemetry::MAX_SYSCALL_COUNTERS) { ++Counters->Syscalls[(Number)]; } } while(0)
+#define FEXCORE_TELEMETRY_COMPILE_TIME(Nanoseconds) FEXCore::Telemetry::RecordCompileTime(Nanoseconds)
+
 // Returns a pointer to std::atomic<uint64_t>. Can be useful if you are attempting to JIT telemetry accesses for debug purposes
 // Not recommended to do telemetry inside JIT code in production code
 #define FEXCORE_TELEMETRY_Addr(Name) Name->GetAddr()
 #else
   static inline void Initialize() {}
   static inline void Shutdown(fextl::string const &ApplicationName) {}
+  struct ThreadCounters;
+  static inline uint64_t GetCounterTotals(ThreadCounters *Total) { return 0; }
+  static inline void *RegisterThreadCounters() { return nullptr; }
+  static inline void UnregisterThreadCounters() {}
 
 #define FEXCORE_TELEMETRY_STATIC_INIT(Name, Type)
 #define FEXCORE_TELEMETRY_INIT(Name, Type)
@@ -71,6 +144,9 @@ namespace FEXCore::Telemetry {
 #define FEXCORE_TELEMETRY_SET(Name, Value) do {} while(0)
 #define FEXCORE_TELEMETRY_OR(Name, Value) do {} while(0)
 #define FEXCORE_TELEMETRY_INC(Name) do {} while(0)
+#define FEXCORE_TELEMETRY_COUNTER_INC(Type) do {} while(0)
+#define FEXCORE_TELEMETRY_SYSCALL_INC(Number) do {} while(0)
+#define FEXCORE_TELEMETRY_COMPILE_TIME(Nanoseconds) do {} while(0)
 #define FEXCORE_TELEMETRY_Addr(Name) reinterpret_cast<std::atomic<uint64_t>*>(nullptr)
 #endif
 }
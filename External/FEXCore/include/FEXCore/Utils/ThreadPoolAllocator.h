@@ -3,11 +3,10 @@
 #include <atomic>
 #include <FEXCore/Utils/Allocator.h>
 #include <FEXCore/Utils/LogManager.h>
-#include <FEXCore/fextl/list.h>
 
 #include <chrono>
 #include <cstddef>
-#include <mutex>
+#include <type_traits>
 
 namespace FEXCore::Utils {
   /**
@@ -22,7 +21,7 @@ namespace FEXCore::Utils {
    *     - `Disown` the buffer when it is expected to be used again soon.
    *       - This is relatively cheap.
    *     - `Unclaim` when the buffer won't be used again for an extended period.
-   *       - This is expensive and requires a mutex shared between threads
+   *       - This is more expensive since it needs to synchronize with threads that are reclaiming buffers
    *     - `FixedSizePooledAllocation` helper class provided to help with this.
    *
    * Once the client has disowned a buffer then the allocator is free to reclaim the buffer when another thread is trying to `Claim` a new buffer.
@@ -30,6 +29,10 @@ namespace FEXCore::Utils {
    * reclaimed by the Allocator.
    *
    * During buffer reclaiming is also when unclaimed buffers get freed. This means active threads are able to clean up idle thread's unused memory.
+   *
+   * There is no allocator wide lock.
+   * Every buffer lives in a push-only intrusive list and ownership of a buffer moves between threads with a CAS on its `BufferState`.
+   * A thread only has exclusive access to a buffer's bookkeeping while it holds the buffer in one of the transient states.
    */
   class IntrusivePooledAllocator {
     public:
@@ -39,14 +42,6 @@ namespace FEXCore::Utils {
         size_t Size;
       };
 
-      struct MemoryBuffer;
-      /**
-       * @brief Container for tracking the buffers
-       *
-       * We're using fextl::list explicitly because its iterators aren't invalidated when the list is adjusted.
-       * if we had list types that we can atomically erase and append elements then unclaiming could be made cheaper.
-       */
-      using ContainerType = fextl::list<MemoryBuffer*>;
       /**
        * @brief steady_clock to ensure long running applications don't hit any timeskip problems.
        */
@@ -62,6 +57,21 @@ namespace FEXCore::Utils {
 
       using BufferOwnedFlag = std::atomic<ClientFlags>;
 
+      /**
+       * @brief Allocator side state of a buffer
+       *
+       * `BUSY` is the transient state that gives a single thread exclusive access to the buffer's bookkeeping.
+       */
+      enum class BufferState : uint32_t {
+        // No backing memory, node can be reused for a new allocation
+        EMPTY,
+        // Owned by the allocator, available to claim
+        UNCLAIMED,
+        // Owned by a client through `CurrentClientOwnedFlag`
+        CLAIMED,
+        BUSY,
+      };
+
       struct MemoryBuffer : public FEXCore::Allocator::FEXAllocOperators {
         MemoryBuffer(void* Ptr, size_t Size, std::chrono::time_point<ClockType> LastUsed)
           : Ptr {Ptr}
@@ -69,12 +79,18 @@ namespace FEXCore::Utils {
           , LastUsed {LastUsed} {}
 
         void* Ptr;
-        size_t Size;
+        // Atomic since other threads check the size before trying to claim
+        std::atomic<size_t> Size;
         std::atomic<std::chrono::time_point<ClockType>> LastUsed;
+        std::atomic<BufferState> State {BufferState::BUSY};
+        // Only accessed by the thread holding the buffer in BUSY, or the owning client
         BufferOwnedFlag *CurrentClientOwnedFlag{};
+        // Set once before the buffer is published and never changed
+        MemoryBuffer *Next{};
       };
       // Ensure that the atomic objects of MemoryBuffer are lock free
       static_assert(decltype(MemoryBuffer::LastUsed){}.is_always_lock_free, "Oops, needs to be lock free");
+      static_assert(decltype(MemoryBuffer::State){}.is_always_lock_free, "Oops, needs to be lock free");
       static_assert(std::remove_pointer<decltype(MemoryBuffer::CurrentClientOwnedFlag)>::type{}.is_always_lock_free, "Oops, needs to be lock free");
 
       /**
@@ -107,43 +123,59 @@ namespace FEXCore::Utils {
        *
        * Once a buffer is claimed, the pool allocator can not reclaim this buffer until it is "Disowned"
        *
-       * @return iterator to the internal tracking container
+       * @return the internal tracking buffer
        */
-      ContainerType::iterator ClaimBuffer(size_t Size, BufferOwnedFlag *CurrentClientFlag) {
-        std::unique_lock lk {AllocationMutex};
+      MemoryBuffer *ClaimBuffer(size_t Size, BufferOwnedFlag *CurrentClientFlag) {
         auto Buffer = ClaimBufferImpl(Size);
-        (*Buffer)->CurrentClientOwnedFlag = CurrentClientFlag;
+        Buffer->CurrentClientOwnedFlag = CurrentClientFlag;
         CurrentClientFlag->store(ClientFlags::FLAG_OWNED);
+        Buffer->State.store(BufferState::CLAIMED);
         return Buffer;
       }
 
       /**
        * @brief Immediately release the buffer back to the allocator
        *
-       * @param Buffer - The iterator that was previously given with ClaimBuffer
+       * @param Buffer - The buffer that was previously given with ClaimBuffer
+       * @param CurrentClientFlag - The client tracked flag
        *
        * Once this is called on a buffer then the pool allocator has full ownership of the buffer
        */
-      void UnclaimBuffer(ContainerType::iterator Buffer) {
-        std::unique_lock lk {AllocationMutex};
-        (*Buffer)->CurrentClientOwnedFlag->store(ClientFlags::FLAG_FREE);
-        UnclaimBufferImpl(Buffer);
+      void UnclaimBuffer(MemoryBuffer *Buffer, BufferOwnedFlag *CurrentClientFlag) {
+        while (!IsClientBufferFree(*CurrentClientFlag)) {
+          // Another thread might be checking this buffer for reclaiming, wait for it to finish
+          BufferState Expected = BufferState::CLAIMED;
+          if (!Buffer->State.compare_exchange_weak(Expected, BufferState::BUSY)) {
+            continue;
+          }
+
+          if (Buffer->CurrentClientOwnedFlag != CurrentClientFlag) {
+            // The allocator reclaimed the buffer and it was handed to another client before we got here
+            Buffer->State.store(BufferState::CLAIMED);
+            break;
+          }
+
+          CurrentClientFlag->store(ClientFlags::FLAG_FREE);
+          Buffer->CurrentClientOwnedFlag = nullptr;
+          Buffer->State.store(BufferState::UNCLAIMED);
+          break;
+        }
       }
 
       /**
        * @brief Set internal flags of buffer claiming that the buffer is relinquished ownership
        *
-       * @param Buffer - The iterator that was previously given with ClaimBuffer
+       * @param Buffer - The buffer that was previously given with ClaimBuffer
        *
        * Once the buffer is disowned, the allocator can take back ownership of the buffer at any time
        *
        * Use ReownOrClaimBuffer if you want to attempt reusing a buffer being held on to.
        */
-      void DisownBuffer(ContainerType::iterator Buffer) {
+      void DisownBuffer(MemoryBuffer *Buffer) {
         // Client still owns the buffer but isn't using it
         // Allows us to claim it back if necessary
-        (*Buffer)->LastUsed.store(ClockType::now(), std::memory_order_relaxed);
-        (*Buffer)->CurrentClientOwnedFlag->store(ClientFlags::FLAG_DISOWNED);
+        Buffer->LastUsed.store(ClockType::now(), std::memory_order_relaxed);
+        Buffer->CurrentClientOwnedFlag->store(ClientFlags::FLAG_DISOWNED);
       }
 
       /**
@@ -158,12 +190,12 @@ namespace FEXCore::Utils {
        *
        * @return Either the original buffer passed in if we managed to reclaim, or a new buffer if we couldn't
        */
-      ContainerType::iterator ReownOrClaimBuffer(ContainerType::iterator Buffer, size_t Size, BufferOwnedFlag *CurrentClientFlag) {
+      MemoryBuffer *ReownOrClaimBuffer(MemoryBuffer *Buffer, size_t Size, BufferOwnedFlag *CurrentClientFlag) {
         ClientFlags Expected = ClientFlags::FLAG_DISOWNED;
         if (CurrentClientFlag->compare_exchange_strong(Expected, ClientFlags::FLAG_OWNED)) {
           // If we managed to change the flag from DISOWNED to OWNED then we have successfully reclaimed
           // Finish setting up state
-          (*Buffer)->LastUsed.store(ClockType::now(), std::memory_order_relaxed);
+          Buffer->LastUsed.store(ClockType::now(), std::memory_order_relaxed);
           return Buffer;
         }
 
@@ -184,131 +216,150 @@ namespace FEXCore::Utils {
     protected:
       IntrusivePooledAllocator() = default;
 
-      ContainerType::iterator ClaimBufferImpl(size_t Size) {
-        auto BuffersEnd = UnclaimedBuffers.end();
-        ContainerType::iterator BestFit = BuffersEnd;
-        ContainerType::iterator UnsizedFit = BuffersEnd;
+      /**
+       * @brief Moves a buffer from `From` to BUSY
+       *
+       * @return If this thread now has exclusive access to the buffer
+       */
+      static bool TryAcquire(MemoryBuffer *Buffer, BufferState From) {
+        BufferState Expected = From;
+        return Buffer->State.load(std::memory_order_relaxed) == From &&
+               Buffer->State.compare_exchange_strong(Expected, BufferState::BUSY);
+      }
 
+      /**
+       * @brief Finds or allocates a buffer of at least `Size`
+       *
+       * @return The buffer, held in BUSY by the calling thread
+       */
+      MemoryBuffer *ClaimBufferImpl(size_t Size) {
+        auto Head = Buffers.load();
         auto Now = ClockType::now();
-        // Move any expired ClaimedBuffers to UnclaimedBuffers
-        {
-          // Spin the non-owned buffers and see if we can take ones past the period
-          for (auto it = ClaimedBuffers.begin(); it != ClaimedBuffers.end();) {
-            // 1) Can't take anything that the client has still claimed
-            // 2) Needs to still be last used beyond our time threshold
-            // 3) Only take the oldest buffer
-            if ((*it)->CurrentClientOwnedFlag->load() == ClientFlags::FLAG_DISOWNED) {
-              auto UsedTime = (*it)->LastUsed.load(std::memory_order_relaxed);
-              if ((Now - UsedTime) >= DURATION) {
-                ClientFlags Expected = ClientFlags::FLAG_DISOWNED;
-                if ((*it)->CurrentClientOwnedFlag->compare_exchange_strong(Expected, ClientFlags::FLAG_FREE)) {
-                  // We managed to take away ownership
-                  // Put it back in the regular pool and come back to it
-                  (*it)->CurrentClientOwnedFlag = nullptr;
-                  UnclaimedBuffers.emplace_back(*it);
-                  it = ClaimedBuffers.erase(it);
-                  continue;
-                }
-              }
+
+        // Move any expired claimed buffers back to the allocator
+        for (auto Buffer = Head; Buffer; Buffer = Buffer->Next) {
+          // 1) Can't take anything that the client has still claimed
+          // 2) Needs to still be last used beyond our time threshold
+          if (!TryAcquire(Buffer, BufferState::CLAIMED)) {
+            continue;
+          }
+
+          auto ClientFlag = Buffer->CurrentClientOwnedFlag;
+          bool Reclaimed = false;
+          if (ClientFlag->load() == ClientFlags::FLAG_DISOWNED) {
+            auto UsedTime = Buffer->LastUsed.load(std::memory_order_relaxed);
+            if ((Now - UsedTime) >= DURATION) {
+              ClientFlags Expected = ClientFlags::FLAG_DISOWNED;
+              // We managed to take away ownership if this succeeds
+              Reclaimed = ClientFlag->compare_exchange_strong(Expected, ClientFlags::FLAG_FREE);
             }
+          }
 
-            ++it;
+          if (Reclaimed) {
+            Buffer->CurrentClientOwnedFlag = nullptr;
           }
+          Buffer->State.store(Reclaimed ? BufferState::UNCLAIMED : BufferState::CLAIMED);
         }
 
-        // Find an unclaimed buffer that is >= Size and Free up to one unclaimed buffer that has expired
+        // Find an unclaimed buffer that is >= Size
+        MemoryBuffer *BestFit {};
         {
-          // Walk all the allocations and find a buffer that fits
-          for (auto it = UnclaimedBuffers.begin(); it != BuffersEnd; ++it) {
-            if ((*it)->Size == Size) {
-              BestFit = it;
+          MemoryBuffer *UnsizedFit {};
+          for (auto Buffer = Head; Buffer; Buffer = Buffer->Next) {
+            if (Buffer->State.load(std::memory_order_relaxed) != BufferState::UNCLAIMED) {
+              continue;
+            }
+
+            const size_t BufferSize = Buffer->Size.load(std::memory_order_relaxed);
+            if (BufferSize == Size) {
+              BestFit = Buffer;
               break;
             }
 
-            if ((*it)->Size > Size) {
-              UnsizedFit = it;
+            if (BufferSize > Size) {
+              UnsizedFit = Buffer;
             }
           }
 
           // If we didn't have an exact fit then use an unsized fit
-          if (BestFit == BuffersEnd) {
+          if (!BestFit) {
             BestFit = UnsizedFit;
           }
 
-          // Free up to one unclaimed buffer that has expired
-          {
-            std::chrono::time_point<ClockType> LRUTime{};
-            ContainerType::iterator LastUsed = BuffersEnd;
-
-            // Walk all the allocations and find a buffer to erase
-            for (auto it = UnclaimedBuffers.begin(); it != UnclaimedBuffers.end(); ++it) {
-              // Ensure that the LRU value is past our duration threshold and isn't the one we are claiming
-              // Also only select a single memory region
-              if (it != BestFit) {
-                auto UsedTime = (*it)->LastUsed.load(std::memory_order_relaxed);
-                if ((Now - UsedTime) >= DURATION &&
-                    UsedTime > LRUTime) {
-                  LastUsed = it;
-                  LRUTime = UsedTime;
-                }
-              }
-            }
+          // If another thread got there first then fall back to allocating
+          if (BestFit && !TryAcquire(BestFit, BufferState::UNCLAIMED)) {
+            BestFit = nullptr;
+          }
+        }
 
-            // If we found a buffer then free it
-            if (LastUsed != BuffersEnd) {
-              Free((*LastUsed)->Ptr, (*LastUsed)->Size);
-              delete *LastUsed;
-              UnclaimedBuffers.erase(LastUsed);
+        // Free up to one unclaimed buffer that has expired
+        {
+          std::chrono::time_point<ClockType> LRUTime{};
+          MemoryBuffer *LastUsed {};
+
+          // Ensure that the LRU value is past our duration threshold
+          // Also only select a single memory region
+          for (auto Buffer = Head; Buffer; Buffer = Buffer->Next) {
+            if (Buffer->State.load(std::memory_order_relaxed) == BufferState::UNCLAIMED) {
+              auto UsedTime = Buffer->LastUsed.load(std::memory_order_relaxed);
+              if ((Now - UsedTime) >= DURATION &&
+                  UsedTime > LRUTime) {
+                LastUsed = Buffer;
+                LRUTime = UsedTime;
+              }
             }
           }
 
-          if (BestFit != UnclaimedBuffers.end()) {
-            MemoryBuffer *Buffer = *BestFit;
-            UnclaimedBuffers.erase(BestFit);
-            return ClaimedBuffers.emplace(ClaimedBuffers.end(), Buffer);
+          // If we found a buffer then free it, the tracking node stays in the list for reuse
+          if (LastUsed && TryAcquire(LastUsed, BufferState::UNCLAIMED)) {
+            Free(LastUsed->Ptr, LastUsed->Size.load(std::memory_order_relaxed));
+            LastUsed->Ptr = nullptr;
+            LastUsed->Size.store(0, std::memory_order_relaxed);
+            LastUsed->State.store(BufferState::EMPTY);
           }
         }
 
+        if (BestFit) {
+          return BestFit;
+        }
+
         // Need to allocate a new buffer, couldn't fit
         auto Data = Alloc(Size);
-        return ClaimedBuffers.emplace(ClaimedBuffers.end(), new MemoryBuffer{Data, Size, ClockType::now()});
-      }
 
-      void UnclaimBufferImpl(ContainerType::iterator Buffer) {
-        (*Buffer)->CurrentClientOwnedFlag = nullptr;
-        UnclaimedBuffers.emplace_back(*Buffer);
-        ClaimedBuffers.erase(Buffer);
+        // Reuse a tracking node of a previously freed buffer if there is one
+        for (auto Buffer = Head; Buffer; Buffer = Buffer->Next) {
+          if (TryAcquire(Buffer, BufferState::EMPTY)) {
+            Buffer->Ptr = Data;
+            Buffer->Size.store(Size, std::memory_order_relaxed);
+            Buffer->LastUsed.store(Now, std::memory_order_relaxed);
+            return Buffer;
+          }
+        }
+
+        auto Buffer = new MemoryBuffer{Data, Size, Now};
+        Buffer->Next = Buffers.load();
+        while (!Buffers.compare_exchange_weak(Buffer->Next, Buffer));
+        return Buffer;
       }
 
       void FreeAllBuffers() {
-        for (auto it : UnclaimedBuffers) {
-          Free(it->Ptr, it->Size);
-          delete it;
-        }
-
-        for (auto it : ClaimedBuffers) {
-          Free(it->Ptr, it->Size);
-          delete it;
+        for (auto Buffer = Buffers.exchange(nullptr); Buffer;) {
+          auto Next = Buffer->Next;
+          if (Buffer->Ptr) {
+            Free(Buffer->Ptr, Buffer->Size.load());
+          }
+          delete Buffer;
+          Buffer = Next;
         }
-
-        UnclaimedBuffers.clear();
-        ClaimedBuffers.clear();
       }
 
       /**
-       * @brief List of buffers that this pool allocator itself owns
-       */
-      ContainerType UnclaimedBuffers;
-
-      /**
-       * @brief List of buffers that are client claimed
-       */
-      ContainerType ClaimedBuffers;
-
-      /**
-       * @brief Mutex to ensure thread safety while shuffling buffers around and allocating
+       * @brief Intrusive list of every buffer tracking node, both allocator and client owned
+       *
+       * Nodes are only ever pushed to the front, which keeps traversal safe without a lock.
+       * Nodes whose memory is freed are kept as `EMPTY` and reused, only `FreeAllBuffers` deletes them.
        */
-      std::mutex AllocationMutex;
+      std::atomic<MemoryBuffer*> Buffers{};
 
     private:
       /**
@@ -398,13 +449,12 @@ namespace FEXCore::Utils {
    *      - atomic<uint32_t> set to change object to `OWNED` state
    *    - When object isn't owned, then allocate a new buffer from the pool
    *
-   *  - Unclaiming is fairly costly
-   *    - Requires owning a mutex, shared between all threads using the `Allocator`
-   *    - Updating two fextl::list containers to give the ownership back to the `Allocator`
+   *  - Unclaiming is fairly cheap
+   *    - atomic<uint32_t> CAS to take the buffer's state, waiting if another thread is checking it for reclaiming
+   *    - Couple of atomic stores to give the ownership back to the `Allocator`
    *
    *  - Claiming is very costly
-   *    - Requires owning a mutex, shared between all threads using the `Allocator`
-   *    - Scans two fextl::list containers to find the best fit buffer
+   *    - Scans the list of all buffers to reclaim expired buffers and find the best fit buffer
    *    - Or allocates another buffer when that fails
    *    - Frees stale buffers opportunistically
    */
@@ -437,9 +487,9 @@ namespace FEXCore::Utils {
 
         // Putting a memset here is very handy for using thread sanitizer to find buffer usage races
         // Leaving this here for future excavation that will definitely occur here
-        // memset((*Info)->Ptr, 0, Size);
+        // memset(Info->Ptr, 0, Size);
 
-        return reinterpret_cast<Type>((*Info)->Ptr);
+        return reinterpret_cast<Type>(Info->Ptr);
       }
 
       /**
@@ -483,7 +533,7 @@ namespace FEXCore::Utils {
        */
       void UnclaimBuffer() {
         if (!FEXCore::Utils::IntrusivePooledAllocator::IsClientBufferFree(ClientOwnedFlag)) {
-          ThreadAllocator.UnclaimBuffer(Info);
+          ThreadAllocator.UnclaimBuffer(Info, &ClientOwnedFlag);
         }
       }
 
@@ -495,7 +545,7 @@ namespace FEXCore::Utils {
       size_t Size;
 
       // Buffer ownership tracking
-      FEXCore::Utils::IntrusivePooledAllocator::ContainerType::iterator Info{};
+      FEXCore::Utils::IntrusivePooledAllocator::MemoryBuffer *Info{};
       FEXCore::Utils::IntrusivePooledAllocator::BufferOwnedFlag ClientOwnedFlag { FEXCore::Utils::IntrusivePooledAllocator::ClientFlags::FLAG_FREE };
 
       // Threshold counting
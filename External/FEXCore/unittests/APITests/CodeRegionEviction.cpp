@@ -0,0 +1,81 @@
+#include "Interface/Core/CodeRegionEviction.h"
+
+#include <catch2/catch.hpp>
+
+namespace {
+  constexpr size_t REGIONS = 8;
+  using Eviction = FEXCore::CodeRegionEviction<REGIONS>;
+  using Heat = std::array<uint64_t, REGIONS>;
+
+  // Fills the regions in order, as a freshly cleared code buffer does
+  Eviction FillAll() {
+    Eviction Regions;
+    Regions.Reset();
+    for (size_t i = 1; i < REGIONS; ++i) {
+      CHECK(Regions.Pick(Heat{}) == i);
+      Regions.Filled(i);
+    }
+    return Regions;
+  }
+}
+
+TEST_CASE("CodeRegionEviction - Fills unused regions first") {
+  Eviction Regions;
+  Regions.Reset();
+  Regions.Filled(1);
+  Regions.Filled(2);
+  Regions.Filled(3);
+
+  // Regions 0 and 1 could be evicted, but the unused regions come first even though none of the blocks ran
+  CHECK(Regions.Pick(Heat{}) == 4);
+}
+
+TEST_CASE("CodeRegionEviction - Oldest without counters") {
+  auto Regions = FillAll();
+
+  for (size_t i = 0; i < REGIONS * 2; ++i) {
+    const size_t Expected = i % REGIONS;
+    CHECK(Regions.Pick(Heat{}) == Expected);
+    Regions.Filled(Expected);
+  }
+}
+
+TEST_CASE("CodeRegionEviction - Coldest region") {
+  auto Regions = FillAll();
+
+  Heat Counts{100, 50, 100, 3, 100, 100, 0, 0};
+  // The last two regions are the newest, even without executions they aren't picked
+  CHECK(Regions.Pick(Counts) == 3);
+  Regions.Filled(3);
+
+  // Region 3 is now the newest, region 7 is still protected as the one filled before it
+  Counts[3] = 0;
+  CHECK(Regions.Pick(Counts) == 6);
+  Regions.Filled(6);
+
+  // Hot code isn't evicted while there are colder regions
+  Counts[6] = 0;
+  Counts[7] = 1;
+  CHECK(Regions.Pick(Counts) == 7);
+  Regions.Filled(7);
+  CHECK(Regions.Pick(Counts) == 3);
+}
+
+TEST_CASE("CodeRegionEviction - Ties go to the oldest region") {
+  auto Regions = FillAll();
+
+  Heat Counts{5, 1, 5, 1, 5, 1, 5, 5};
+  CHECK(Regions.Pick(Counts) == 1);
+  Regions.Filled(1);
+  CHECK(Regions.Pick(Counts) == 3);
+  Regions.Filled(3);
+  CHECK(Regions.Pick(Counts) == 5);
+}
+
+TEST_CASE("CodeRegionEviction - Reset") {
+  auto Regions = FillAll();
+  Regions.Filled(0);
+
+  Regions.Reset();
+  CHECK(Regions.Pick(Heat{}) == 1);
+}
@@ -0,0 +1,162 @@
+#include "Utils/Allocator/FlexBitSet.h"
+
+#include <catch2/catch.hpp>
+
+#include <random>
+#include <vector>
+
+namespace {
+  using BitSet = FEXCore::FlexBitSet<uint64_t>;
+  using ScanResult = BitSet::BitsetScanResults;
+
+  constexpr size_t ELEMENTS = 64 * 12;
+
+  struct TestSet {
+    std::vector<uint64_t> Storage = std::vector<uint64_t>(ELEMENTS / BitSet::MinimumSizeBits);
+    BitSet &Set = *reinterpret_cast<BitSet*>(Storage.data());
+  };
+
+  // Fills the set with runs of set and unset elements, DensityPercent of the runs are set.
+  // Short runs leave holes inside of a word, long runs cross word boundaries.
+  void FillRuns(BitSet &Set, std::mt19937_64 &Rng, unsigned DensityPercent, size_t MaxRun) {
+    size_t Element = 0;
+    while (Element < ELEMENTS) {
+      const bool Value = Rng() % 100 < DensityPercent;
+      const size_t Run = std::min<size_t>(1 + Rng() % MaxRun, ELEMENTS - Element);
+      for (size_t i = 0; i < Run; ++i, ++Element) {
+        if (Value) {
+          Set.Set(Element);
+        }
+        else {
+          Set.Clear(Element);
+        }
+      }
+    }
+  }
+
+  // The per-element scans the word based ones replaced
+  template<bool WantUnset>
+  ScanResult ReferenceBackwardScan(const BitSet &Set, size_t BeginningElement, size_t ElementCount, size_t MinimumElement) {
+    bool FoundHole {};
+    for (size_t CurrentPage = BeginningElement; CurrentPage >= (MinimumElement + ElementCount);) {
+      size_t Remaining = ElementCount;
+      while (Remaining) {
+        if (Set.Get(CurrentPage - Remaining) == WantUnset) {
+          break;
+        }
+        --Remaining;
+      }
+
+      if (!Remaining) {
+        return ScanResult {CurrentPage - ElementCount, FoundHole};
+      }
+
+      FoundHole |= Remaining != ElementCount;
+      CurrentPage -= Remaining;
+    }
+    return ScanResult {~0ULL, FoundHole};
+  }
+
+  template<bool WantUnset>
+  ScanResult ReferenceForwardScan(const BitSet &Set, size_t BeginningElement, size_t ElementCount, size_t ElementsInSet) {
+    bool FoundHole {};
+    for (size_t CurrentElement = BeginningElement; CurrentElement < (ElementsInSet - ElementCount);) {
+      size_t Remaining = ElementCount;
+      while (Remaining) {
+        if (Set.Get(CurrentElement + Remaining - 1) == WantUnset) {
+          break;
+        }
+        --Remaining;
+      }
+
+      if (!Remaining) {
+        return ScanResult {CurrentElement, FoundHole};
+      }
+
+      FoundHole |= Remaining != ElementCount;
+      CurrentElement += Remaining;
+    }
+    return ScanResult {~0ULL, FoundHole};
+  }
+
+  template<bool WantUnset>
+  void CheckScans(BitSet &Set) {
+    for (size_t Count : {1, 2, 7, 63, 64, 65, 100, 128, 200}) {
+      for (size_t Begin = Count; Begin <= ELEMENTS; Begin += 37) {
+        const auto Expected = ReferenceBackwardScan<WantUnset>(Set, Begin, Count, 0);
+        const auto Result = Set.BackwardScanForRange<WantUnset>(Begin, Count, 0);
+        CAPTURE(Count, Begin);
+        CHECK(Result.FoundElement == Expected.FoundElement);
+        CHECK(Result.FoundHole == Expected.FoundHole);
+      }
+
+      for (size_t Begin = 0; Begin + Count < ELEMENTS; Begin += 37) {
+        const auto Expected = ReferenceForwardScan<WantUnset>(Set, Begin, Count, ELEMENTS);
+        const auto Result = Set.ForwardScanForRange<WantUnset>(Begin, Count, ELEMENTS);
+        CAPTURE(Count, Begin);
+        CHECK(Result.FoundElement == Expected.FoundElement);
+        CHECK(Result.FoundHole == Expected.FoundHole);
+      }
+    }
+  }
+}
+
+TEST_CASE("FlexBitSet - Scans match the per element scan") {
+  std::mt19937_64 Rng(0x46455842);
+  const auto Density = GENERATE(0u, 10u, 50u, 90u, 100u);
+  const auto MaxRun = GENERATE(size_t{3}, size_t{40}, size_t{300});
+
+  TestSet Test;
+  FillRuns(Test.Set, Rng, Density, MaxRun);
+
+  CAPTURE(Density, MaxRun);
+  CheckScans<true>(Test.Set);
+  CheckScans<false>(Test.Set);
+}
+
+TEST_CASE("FlexBitSet - Scan stops at MinimumElement and the end of the set") {
+  TestSet Test;
+  Test.Set.MemClear(ELEMENTS);
+
+  // Only the range right above MinimumElement is free
+  Test.Set.SetRange(0, ELEMENTS);
+  Test.Set.TestAndClearRange(130, 20);
+  CHECK(Test.Set.BackwardScanForRange<true>(ELEMENTS, 20, 130).FoundElement == 130);
+  CHECK(Test.Set.BackwardScanForRange<true>(ELEMENTS, 20, 131).FoundElement == ~0ULL);
+  CHECK(Test.Set.BackwardScanForRange<true>(ELEMENTS, 21, 0).FoundElement == ~0ULL);
+
+  // A free range ending at the last element isn't found, the forward scan keeps the last element in reserve
+  Test.Set.SetRange(0, ELEMENTS);
+  Test.Set.TestAndClearRange(ELEMENTS - 10, 10);
+  CHECK(Test.Set.ForwardScanForRange<true>(0, 10, ELEMENTS).FoundElement == ~0ULL);
+  CHECK(Test.Set.ForwardScanForRange<true>(0, 9, ELEMENTS).FoundElement == ELEMENTS - 10);
+}
+
+TEST_CASE("FlexBitSet - Range updates") {
+  std::mt19937_64 Rng(0x52414E47);
+  TestSet Test;
+  std::vector<bool> Expected(ELEMENTS);
+
+  Test.Set.MemClear(ELEMENTS);
+  for (size_t i = 0; i < 2000; ++i) {
+    const size_t Begin = Rng() % ELEMENTS;
+    const size_t Count = Rng() % (ELEMENTS - Begin + 1);
+    CAPTURE(i, Begin, Count);
+
+    if (Rng() & 1) {
+      Test.Set.SetRange(Begin, Count);
+      std::fill(Expected.begin() + Begin, Expected.begin() + Begin + Count, true);
+    }
+    else {
+      const size_t WasSet = std::count(Expected.begin() + Begin, Expected.begin() + Begin + Count, true);
+      CHECK(Test.Set.TestAndClearRange(Begin, Count) == WasSet);
+      std::fill(Expected.begin() + Begin, Expected.begin() + Begin + Count, false);
+    }
+
+    for (size_t Element = 0; Element < ELEMENTS; ++Element) {
+      if (Test.Set.Get(Element) != Expected[Element]) {
+        FAIL("Element " << Element << " differs");
+      }
+    }
+  }
+}
@@ -1,6 +1,10 @@
 #pragma once
 #include <cstddef>
 
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
 namespace FHU {
   // FEX assumes an operating page size of 4096
   // To work around build systems that build on a 16k/64k page size, define our page size here
@@ -8,4 +12,15 @@ namespace FHU {
   constexpr size_t FEX_PAGE_SIZE = 4096;
   constexpr size_t FEX_PAGE_SHIFT = 12;
   constexpr size_t FEX_PAGE_MASK = ~(FEX_PAGE_SIZE - 1);
+
+  // The granule mprotect works in, a multiple of FEX_PAGE_SIZE.
+  // 16k or 64k on some arm64 kernels, state tracked per protected page needs to use this instead.
+  inline size_t GetHostPageSize() {
+#ifdef _WIN32
+    return FEX_PAGE_SIZE;
+#else
+    static const size_t HostPageSize = sysconf(_SC_PAGESIZE);
+    return HostPageSize;
+#endif
+  }
 }
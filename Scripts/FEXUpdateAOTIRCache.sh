@@ -1,8 +1,21 @@
 #!/bin/bash
 FEX=${1:-FEXLoader}
 echo Using $FEX
-for fileid in ~/.fex-emu/aotir/*.path; do
+
+# fileids are <name>-<path hash>-<content hash>-<flags>, a file that changed gets a new content hash.
+# Walk newest first so only the current version of each file is kept and regenerated.
+declare -A current
+for fileid in `ls -t ~/.fex-emu/aotir/*.path`; do
 	filename=`cat "$fileid"`
+	stem=`basename "$fileid" .path`
+	key="${stem%-*-*}-${stem##*-}"
+
+	if [ ! -f "$filename" ] || [ -n "${current[$key]}" ]; then
+		echo "Removing stale `basename $fileid`"
+		rm -f "$fileid" "${fileid%.path}.aotir"
+		continue
+	fi
+	current[$key]=1
 	args=""
 	if [ "${fileid: -6 : 1}" == "P" ]; then
 		args="$args --no-abinopf"
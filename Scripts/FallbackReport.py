@@ -0,0 +1,43 @@
+#!/usr/bin/python3
+# Merges the per-process files written by ProfileFallbacksFile in to a single report
+# Usage: FallbackReport.py <profile file prefix> [output file]
+import glob
+import sys
+from collections import defaultdict
+
+def main():
+    if len(sys.argv) < 2:
+        print("Usage: {} <profile file prefix> [output file]".format(sys.argv[0]))
+        sys.exit(1)
+
+    Files = glob.glob(sys.argv[1] + ".*")
+
+    # (instruction, op) -> [count, set of locations]
+    Instructions = defaultdict(lambda: [0, set()])
+    Total = 0
+    for File in Files:
+        with open(File) as f:
+            for Line in f:
+                Fields = Line.rstrip("\n").split("\t")
+                if len(Fields) != 5:
+                    continue
+                Count = int(Fields[0])
+                Entry = Instructions[(Fields[1], Fields[2])]
+                Entry[0] += Count
+                Entry[1].add(Fields[4] if Fields[4] != "<anonymous>" else Fields[3])
+                Total += Count
+
+    Lines = ["Fallback report: {} executions from {} processes".format(Total, len(Files)),
+             "{:>16} {:>7} {:>6}  {}".format("Executions", "Share", "Sites", "Instruction -> IR op")]
+    for (Instruction, Op), (Count, Sites) in sorted(Instructions.items(), key=lambda Item: Item[1][0], reverse=True):
+        Share = Count * 100.0 / Total if Total else 0.0
+        Lines.append("{:>16} {:>6.2f}% {:>6}  {} -> {}".format(Count, Share, len(Sites), Instruction, Op))
+
+    Report = "\n".join(Lines) + "\n"
+    if len(sys.argv) > 2:
+        with open(sys.argv[2], "w") as f:
+            f.write(Report)
+    print(Report, end="")
+
+if __name__ == "__main__":
+    sys.exit(main())
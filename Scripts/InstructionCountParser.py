@@ -16,10 +16,14 @@ class TestData:
     name: str
     optimal: int
     expectedinstructioncount: int
+    expectedlatency: float
+    expectedthroughput: float
     code: bytes
-    def __init__(self, Name, Optimal, ExpectedInstructionCount, Code):
+    def __init__(self, Name, Optimal, ExpectedInstructionCount, ExpectedLatency, ExpectedThroughput, Code):
         self.name = Name
         self.expectedinstructioncount = ExpectedInstructionCount
+        self.expectedlatency = ExpectedLatency
+        self.expectedthroughput = ExpectedThroughput
         self.optimal = Optimal
         self.code = Code
 
@@ -35,6 +39,14 @@ class TestData:
     def ExpectedInstructionCount(self):
         return self.expectedinstructioncount
 
+    @property
+    def ExpectedLatency(self):
+        return self.expectedlatency
+
+    @property
+    def ExpectedThroughput(self):
+        return self.expectedthroughput
+
     @property
     def Code(self):
         return self.code
@@ -45,12 +57,23 @@ class HostFeatures(Flag) :
     FEATURE_SVE128 = (1 << 0)
     FEATURE_SVE256 = (1 << 1)
     FEATURE_CLZERO = (1 << 2)
+    FEATURE_AFP    = (1 << 3)
+    FEATURE_AVX    = (1 << 4)
 
 
 HostFeaturesLookup = {
     "SVE128"  : HostFeatures.FEATURE_SVE128,
     "SVE256"  : HostFeatures.FEATURE_SVE256,
     "CLZERO"  : HostFeatures.FEATURE_CLZERO,
+    "AFP"     : HostFeatures.FEATURE_AFP,
+    "AVX"     : HostFeatures.FEATURE_AVX,
+}
+
+# Must match CodeSize::CostModel::Model
+CostModelLookup = {
+    "NEOVERSE-N1" : 0,
+    "NEOVERSE-V1" : 1,
+    "CORTEX-A78"  : 2,
 }
 
 def GetHostFeatures(data):
@@ -70,6 +93,8 @@ def parse_json_data(json_data, output_binary_path):
     Bitness = 64
     EnabledHostFeatures = HostFeatures.FEATURE_ANY
     DisabledHostFeatures = HostFeatures.FEATURE_ANY
+    CostModel = CostModelLookup["NEOVERSE-N1"]
+    Sequences = {}
 
     if "Features" in json_data:
         items = json_data["Features"]
@@ -82,19 +107,53 @@ def parse_json_data(json_data, output_binary_path):
         if ("DisabledHostFeatures" in items):
             DisabledHostFeatures = GetHostFeatures(items["DisabledHostFeatures"])
 
+        if ("CostModel" in items):
+            if not (items["CostModel"].upper() in CostModelLookup):
+                sys.exit("Invalid cost model")
+            CostModel = CostModelLookup[items["CostModel"].upper()]
+
+    for key, items in json_data["Instructions"].items():
+        if ("Skip" in items):
+                if items["Skip"].upper() == "YES":
+                    continue
+
+        # Multi-instruction tests list their instructions, otherwise the key is the instruction
+        Insts = [key]
+        if ("x86Insts" in items):
+            Insts = items["x86Insts"]
+            if not (type(Insts) is list) or len(Insts) == 0:
+                sys.exit("x86Insts must be a non-empty list of instructions")
+
+        Sequences[key] = Insts
+
+    # The whole sequence has to end up in one block, so the block size is the longest sequence.
+    # Labels don't count as instructions.
+    MaxInst = max([len([Inst for Inst in Insts if not Inst.strip().endswith(":")]) for Insts in Sequences.values()], default = 1)
+
     for key, items in json_data["Instructions"].items():
+        if not (key in Sequences):
+            continue
+
         ExpectedInstructionCount = 0
+        # Negative means the estimate hasn't been recorded yet
+        ExpectedLatency = -1.0
+        ExpectedThroughput = -1.0
         Optimal = 0
         if ("ExpectedInstructionCount" in items):
             ExpectedInstructionCount = int(items["ExpectedInstructionCount"])
 
+        if ("ExpectedLatency" in items):
+            ExpectedLatency = float(items["ExpectedLatency"])
+
+        if ("ExpectedThroughput" in items):
+            ExpectedThroughput = float(items["ExpectedThroughput"])
+
         if ("Optimal" in items):
                 if items["Optimal"].upper() == "YES":
                     Optimal = 1
 
-        if ("Skip" in items):
-                if items["Skip"].upper() == "YES":
-                    continue
+        Insts = Sequences[key]
+        NumInsts = len([Inst for Inst in Insts if not Inst.strip().endswith(":")])
 
         TestName = base64.b64encode(key.encode("ascii")).decode("ascii")
         tmp_asm = "/tmp/{}.asm".format(TestName)
@@ -103,7 +162,13 @@ def parse_json_data(json_data, output_binary_path):
 
         with open(tmp_asm, "w") as tmp_asm_file:
             tmp_asm_file.write("BITS 64;\n")
-            tmp_asm_file.write("{}\n".format(key))
+            for Inst in Insts:
+                tmp_asm_file.write("{}\n".format(Inst))
+
+            # Shorter sequences are padded out with nops, which don't generate any host code.
+            # Otherwise the block would continue in to the next test.
+            for i in range(NumInsts, MaxInst):
+                tmp_asm_file.write("nop\n")
 
         Process = subprocess.Popen(["nasm", tmp_asm, "-o", tmp_asm_out])
         Process.wait()
@@ -125,7 +190,7 @@ def parse_json_data(json_data, output_binary_path):
         with open(tmp_asm_out, "rb") as tmp_asm_out_file:
             binary_hex = tmp_asm_out_file.read()
 
-        TestDataMap[TestName] = TestData(key, Optimal, ExpectedInstructionCount, binary_hex)
+        TestDataMap[TestName] = TestData(key, Optimal, ExpectedInstructionCount, ExpectedLatency, ExpectedThroughput, binary_hex)
 
         os.remove(tmp_asm)
         os.remove(tmp_asm_out)
@@ -137,12 +202,16 @@ def parse_json_data(json_data, output_binary_path):
         #   uint64_t NumTests;
         #   uint64_t EnabledHostFeatures;
         #   uint64_t DisabledHostFeatures;
+        #   uint64_t CostModel;
+        #   uint64_t MaxInst;
         #   TestInfo Tests[NumTests];
         # };
         # struct TestInfo {
         #   char InstName[128];
         #   uint64_t Optimal;
         #   int64_t ExpectedInstructionCount;
+        #   double ExpectedLatency;
+        #   double ExpectedThroughput;
         #   uint64_t CodeSize;
         #   uint32_t Cookie;
         #   uint8_t Code[CodeSize];
@@ -154,12 +223,16 @@ def parse_json_data(json_data, output_binary_path):
     MemData += struct.pack('Q', len(TestDataMap))
     MemData += struct.pack('Q', EnabledHostFeatures.value)
     MemData += struct.pack('Q', DisabledHostFeatures.value)
+    MemData += struct.pack('Q', CostModel)
+    MemData += struct.pack('Q', MaxInst)
 
     # Add each test
     for key, item in TestDataMap.items():
         MemData += struct.pack('128s', item.Name.encode("ascii"))
         MemData += struct.pack('Q', item.Optimal)
         MemData += struct.pack('q', item.ExpectedInstructionCount)
+        MemData += struct.pack('d', item.ExpectedLatency)
+        MemData += struct.pack('d', item.ExpectedThroughput)
         MemData += struct.pack('Q', len(item.Code))
         MemData += struct.pack('I', 0x41424344)
         MemData += item.Code
@@ -13,7 +13,13 @@ def update_performance_numbers(performance_json_path, performance_json, new_json
         if not key in performance_json["Instructions"]:
             logging.error("{} didn't exist in performance json file?".format(key))
             return 1
-        performance_json["Instructions"][key]["ExpectedInstructionCount"] = items
+
+        # Older outputs only carry the instruction count, newer ones also carry the cost model estimates
+        if isinstance(items, dict):
+            for field, value in items.items():
+                performance_json["Instructions"][key][field] = value
+        else:
+            performance_json["Instructions"][key]["ExpectedInstructionCount"] = items
 
     # Output to the original file.
     with open(performance_json_path, "w") as json_file:
@@ -0,0 +1,63 @@
+#!/usr/bin/python3
+import glob
+import os
+import sys
+import subprocess
+import tempfile
+
+# Args: <FexExecutable> <FexArgs>...
+# FexArgs should also include the test executable.
+#
+# Captures an AOTIR cache of the test with and without host code, then runs the test again loading the cache.
+# The test has to pass in every run, and the cache with host code has to be bigger than the one without.
+
+if (len(sys.argv) < 3):
+    sys.exit(1)
+
+RunnerArgs = [sys.argv[1]]
+
+ROOTFS_ENV = os.getenv("ROOTFS")
+if ROOTFS_ENV != None:
+    RunnerArgs.append("-R")
+    RunnerArgs.append(ROOTFS_ENV)
+
+RunnerArgs.extend(sys.argv[2:])
+
+def Run(Name, AOTDir, Options):
+    Env = dict(os.environ)
+    Env["FEX_AOTIRDIRECTORY"] = AOTDir
+    for Option, Value in Options.items():
+        Env["FEX_" + Option] = Value
+
+    print(Name, Options, RunnerArgs)
+    Process = subprocess.run(RunnerArgs, env=Env)
+    if Process.returncode != 0:
+        print(Name, "failed with", Process.returncode)
+        sys.exit(1)
+
+def CacheSize(AOTDir):
+    Files = glob.glob(os.path.join(AOTDir, "*.aotir"))
+    if len(Files) == 0:
+        print("No AOTIR cache was stored in", AOTDir)
+        sys.exit(1)
+
+    return sum(os.path.getsize(File) for File in Files)
+
+with tempfile.TemporaryDirectory() as IRDir, tempfile.TemporaryDirectory() as HostCodeDir:
+    Run("Capture IR", IRDir, {"AOTIRCAPTURE": "1", "AOTIRHOSTCODE": "0"})
+    Run("Capture host code", HostCodeDir, {"AOTIRCAPTURE": "1", "AOTIRHOSTCODE": "1"})
+
+    IRSize = CacheSize(IRDir)
+    HostCodeSize = CacheSize(HostCodeDir)
+    if HostCodeSize <= IRSize:
+        print("Cache with host code isn't bigger,", HostCodeSize, "<=", IRSize)
+        sys.exit(1)
+
+    # Relocates the host code
+    Run("Load host code", HostCodeDir, {"AOTIRLOAD": "1", "AOTIRHOSTCODE": "1"})
+
+    # Entries with host code still have usable IR
+    Run("Load IR", HostCodeDir, {"AOTIRLOAD": "1", "AOTIRHOSTCODE": "0"})
+
+print("test passed")
+sys.exit(0)
@@ -0,0 +1,108 @@
+#!/usr/bin/python3
+# Runs the guest benchmarks through FEXLoader and collects their results in to one JSON file
+#
+# Every benchmark binary prints one JSON object per line:
+#   {"benchmark": <name>, "iterations": <count>, "ns_per_iteration": <time>}
+#
+# With a baseline, from a previous run's output, any benchmark that got slower than the threshold fails the run.
+#
+# Given the thunk library directories, the thunks benchmark runs a second time through the guest thunk library.
+# Those results get a "_thunked" suffix, next to the same calls emulated.
+import argparse
+import json
+import os
+import subprocess
+import sys
+
+def RunBenchmark(Command, Env=None):
+    Results = []
+    try:
+        Process = subprocess.run(Command, capture_output=True, text=True, timeout=600, env=Env)
+    except subprocess.TimeoutExpired:
+        print("Timed out: {}".format(" ".join(Command)))
+        return Results
+
+    if Process.returncode != 0:
+        print("Failed with {}: {}".format(Process.returncode, " ".join(Command)))
+        print(Process.stderr)
+
+    for Line in Process.stdout.splitlines():
+        Line = Line.strip()
+        if not Line.startswith("{"):
+            continue
+        try:
+            Results.append(json.loads(Line))
+        except ValueError:
+            pass
+    return Results
+
+def CompareToBaseline(Results, BaselineFile, Threshold):
+    with open(BaselineFile) as f:
+        Baseline = {Result["benchmark"]: Result for Result in json.load(f)["results"]}
+
+    Regressions = 0
+    for Result in Results:
+        Old = Baseline.get(Result["benchmark"])
+        if Old is None or Old["ns_per_iteration"] <= 0:
+            continue
+        Change = (Result["ns_per_iteration"] / Old["ns_per_iteration"] - 1.0) * 100.0
+        Result["baseline_ns_per_iteration"] = Old["ns_per_iteration"]
+        Result["change_percent"] = round(Change, 2)
+        if Change > Threshold:
+            print("Regression: {} {:.3f}ns -> {:.3f}ns (+{:.1f}%)".format(
+                Result["benchmark"], Old["ns_per_iteration"], Result["ns_per_iteration"], Change))
+            Regressions += 1
+    return Regressions
+
+def main():
+    Parser = argparse.ArgumentParser(description="Runs the guest benchmarks through FEXLoader")
+    Parser.add_argument("--output", help="File to write the JSON results to")
+    Parser.add_argument("--baseline", default=os.getenv("FEX_BENCHMARK_BASELINE"),
+                        help="Results of a previous run to compare against, defaults to $FEX_BENCHMARK_BASELINE")
+    Parser.add_argument("--threshold", type=float, default=10.0,
+                        help="Percentage a benchmark may get slower than the baseline before it counts as a regression")
+    Parser.add_argument("--native", action="store_true", help="Run the benchmarks directly instead of through FEXLoader")
+    Parser.add_argument("--filter", default="", help="Only run benchmark binaries whose name contains this string")
+    Parser.add_argument("--thunks", nargs=2, metavar=("HOSTTHUNKS", "GUESTTHUNKS"),
+                        help="Host and guest thunk library directories, also runs the thunks benchmark with thunks enabled")
+    Parser.add_argument("fexloader", help="Path to FEXLoader")
+    Parser.add_argument("benchmarks", help="Directory containing the benchmark binaries")
+    Args = Parser.parse_args()
+
+    Binaries = sorted(
+        os.path.join(Args.benchmarks, Name) for Name in os.listdir(Args.benchmarks)
+        if Args.filter in Name and
+           ".so" not in Name and
+           os.path.isfile(os.path.join(Args.benchmarks, Name)) and
+           os.access(os.path.join(Args.benchmarks, Name), os.X_OK))
+
+    Runs = []
+    for Binary in Binaries:
+        Runs.append(([Binary] if Args.native else [Args.fexloader, "--", Binary], None, ""))
+        if Args.thunks and not Args.native and os.path.basename(Binary) == "thunks":
+            HostThunks, GuestThunks = Args.thunks
+            Env = dict(os.environ)
+            Env["FEX_THUNK_BENCH_LIB"] = os.path.join(GuestThunks, "libfex_thunk_bench-guest.so")
+            Runs.append(([Args.fexloader, "-t", HostThunks, "-j", GuestThunks, "--", Binary], Env, "_thunked"))
+
+    Results = []
+    for Command, Env, Suffix in Runs:
+        for Result in RunBenchmark(Command, Env):
+            Result["benchmark"] += Suffix
+            Result["binary"] = os.path.basename(Command[-1])
+            Results.append(Result)
+            print("{:<32} {:>16.3f} ns/iteration".format(Result["benchmark"], Result["ns_per_iteration"]))
+
+    Regressions = 0
+    if Args.baseline:
+        Regressions = CompareToBaseline(Results, Args.baseline, Args.threshold)
+
+    if Args.output:
+        os.makedirs(os.path.dirname(os.path.abspath(Args.output)), exist_ok=True)
+        with open(Args.output, "w") as f:
+            json.dump({"native": Args.native, "results": Results}, f, indent=2)
+
+    return 1 if Regressions else 0
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -74,6 +74,7 @@ class HostFeatures(Flag) :
     FEATURE_BMI2   = (1 << 7)
     FEATURE_CLWB   = (1 << 8)
     FEATURE_LINUX  = (1 << 9)
+    FEATURE_AFP    = (1 << 10)
 
 RegStringLookup = {
     "NONE":  Regs.REG_NONE,
@@ -147,6 +148,7 @@ HostFeaturesLookup = {
     "BMI2"   : HostFeatures.FEATURE_BMI2,
     "CLWB"   : HostFeatures.FEATURE_CLWB,
     "LINUX"  : HostFeatures.FEATURE_LINUX,
+    "AFP"    : HostFeatures.FEATURE_AFP,
 }
 
 def parse_hexstring(s):
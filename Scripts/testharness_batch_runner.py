@@ -0,0 +1,193 @@
+#!/usr/bin/python3
+import argparse
+import concurrent.futures
+import csv
+import os
+import re
+import subprocess
+import sys
+from collections import defaultdict
+
+# Runs a TestHarnessRunner suite (ASM or 32Bit_ASM) with many tests per process.
+# TestHarnessRunner creates a fresh context for every <test> <config> pair it's given, so a batch only pays
+# for process startup and the static table setup once. Batches of each config run in parallel and the suite
+# can be sharded across machines.
+#
+# Known failures and disabled tests use the same files and rules as testharness_runner.py.
+#
+# Example, all of the jit configs the CMake tests use, on every core:
+#   testharness_batch_runner.py --runner Build/Bin/TestHarnessRunner \
+#     --source unittests/ASM --build Build/unittests/ASM --timing-csv timings.csv
+
+DEFAULT_MATRIX = [
+    ("jit_1",     "jit", "--no-silent -g -c irjit -n 1   --no-multiblock"),
+    ("jit_500",   "jit", "--no-silent -g -c irjit -n 500 --no-multiblock"),
+    ("jit_500_m", "jit", "--no-silent -g -c irjit -n 500 --multiblock"),
+]
+
+RESULT_LINE = re.compile(r"^TestResult: (\S+) (\S+) (\d+)$")
+
+def LoadTestsFile(File):
+    Tests = set()
+    if not os.path.exists(File):
+        return Tests
+
+    with open(File) as dtf:
+        for line in dtf:
+            test = line.split("#")[0].strip()
+            if len(test) > 0:
+                Tests.add(test)
+    return Tests
+
+class Test:
+    def __init__(self, Build, Binary):
+        self.Binary = Binary
+        self.Config = Binary[:-len(".bin")] + ".config.bin"
+        # Matches the CMake test naming, Test_<path relative to the suite>
+        self.Name = "Test_" + os.path.relpath(Binary, Build)[:-len(".bin")]
+        # Top level directory, roughly the instruction group
+        Parts = os.path.relpath(Binary, Build).split(os.sep)
+        self.Group = Parts[0] if len(Parts) > 1 else "."
+
+    def ExtraArgs(self):
+        if "SelfModifyingCode" in self.Name:
+            return ["--smcchecks=full"]
+        return []
+
+def FindTests(Build, Filter):
+    Tests = []
+    for Root, _, Files in os.walk(Build):
+        for File in Files:
+            if File.endswith(".asm.bin"):
+                NewTest = Test(Build, os.path.join(Root, File))
+                if os.path.exists(NewTest.Config) and (Filter is None or Filter.search(NewTest.Name)):
+                    Tests.append(NewTest)
+    return sorted(Tests, key=lambda t: t.Name)
+
+def RunBatch(Runner, Args, Tests, Timeout):
+    Command = [Runner] + Args
+    for Entry in Tests:
+        Command += [Entry.Binary, Entry.Config]
+
+    Results = {}
+    try:
+        Process = subprocess.run(Command, capture_output=True, text=True, errors="replace", timeout=Timeout * len(Tests))
+        Output = Process.stdout
+    except subprocess.TimeoutExpired as e:
+        Output = e.stdout.decode(errors="replace") if isinstance(e.stdout, bytes) else (e.stdout or "")
+
+    for Line in Output.splitlines():
+        Match = RESULT_LINE.match(Line.strip())
+        if Match:
+            Results[Match.group(1)] = (Match.group(2), int(Match.group(3)))
+    return Results
+
+def RunTests(Runner, Args, Tests, Timeout):
+    Results = RunBatch(Runner, Args, Tests, Timeout)
+
+    # A crash or hang takes the rest of the batch with it, give each of those tests its own process
+    Missing = [t for t in Tests if t.Binary not in Results]
+    if len(Tests) > 1:
+        for Entry in Missing:
+            Results.update(RunBatch(Runner, Args, [Entry], Timeout))
+
+    return {t.Binary: Results.get(t.Binary, ("Crashed", 0)) for t in Tests}
+
+def main():
+    Parser = argparse.ArgumentParser(description="Runs TestHarnessRunner tests in batches, in parallel and with per-test timings")
+    Parser.add_argument("--runner", required=True, help="Path to TestHarnessRunner")
+    Parser.add_argument("--source", required=True, help="Suite source directory with the Known_Failures and Disabled_Tests files")
+    Parser.add_argument("--build", required=True, help="Suite build directory with the .asm.bin and .asm.config.bin files")
+    Parser.add_argument("--matrix", nargs=3, action="append", metavar=("NAME", "TYPE", "ARGS"),
+                        help="Config to run every test with, TYPE picks the _TYPE known failure files. Defaults to the CMake jit configs")
+    Parser.add_argument("--cpu-class", default=None, help="Host class for Disabled_Tests_<class>, defaults to ClassifyCPU.py")
+    Parser.add_argument("-j", "--jobs", type=int, default=os.cpu_count(), help="Number of TestHarnessRunner processes at once")
+    Parser.add_argument("--batch-size", type=int, default=64, help="Tests per TestHarnessRunner process")
+    Parser.add_argument("--shard", default="0/1", help="K/N, runs every Nth test and config pair starting at K")
+    Parser.add_argument("--filter", default=None, help="Regex on test names")
+    Parser.add_argument("--timeout", type=int, default=300, help="Seconds per test")
+    Parser.add_argument("--timing-csv", default=None, help="Writes test, config, result and microseconds for every test")
+    Parser.add_argument("--slowest", type=int, default=10, help="Number of slowest tests to list")
+    Options = Parser.parse_args()
+
+    Matrix = Options.matrix if Options.matrix else DEFAULT_MATRIX
+    ShardIndex, ShardCount = (int(x) for x in Options.shard.split("/"))
+
+    CPUClass = Options.cpu_class
+    if CPUClass is None:
+        ClassifyScript = os.path.join(os.path.dirname(os.path.abspath(__file__)), "ClassifyCPU.py")
+        CPUClass = subprocess.run([sys.executable, ClassifyScript], capture_output=True, text=True).stdout.strip()
+
+    Tests = FindTests(Options.build, re.compile(Options.filter) if Options.filter else None)
+
+    # Sharding is over test and config pairs so every shard gets a similar mix
+    Work = defaultdict(list)
+    Disabled = 0
+    Index = 0
+    for Name, Type, Args in Matrix:
+        DisabledTests = LoadTestsFile(os.path.join(Options.source, "Disabled_Tests")) | \
+                        LoadTestsFile(os.path.join(Options.source, "Disabled_Tests_" + Type)) | \
+                        LoadTestsFile(os.path.join(Options.source, "Disabled_Tests_" + CPUClass))
+        for Entry in Tests:
+            Index += 1
+            if (Index - 1) % ShardCount != ShardIndex:
+                continue
+            if Entry.Name in DisabledTests:
+                Disabled += 1
+                continue
+            Work[(Name, Type, Args, tuple(Entry.ExtraArgs()))].append(Entry)
+
+    Batches = []
+    for Key, Entries in Work.items():
+        for i in range(0, len(Entries), Options.batch_size):
+            Batches.append((Key, Entries[i:i + Options.batch_size]))
+
+    Records = []
+    with concurrent.futures.ThreadPoolExecutor(max_workers=Options.jobs) as Executor:
+        Futures = {}
+        for Key, Entries in Batches:
+            Name, Type, Args, ExtraArgs = Key
+            RunnerArgs = Args.split() + list(ExtraArgs)
+            Futures[Executor.submit(RunTests, Options.runner, RunnerArgs, Entries, Options.timeout)] = (Key, Entries)
+
+        for Future in concurrent.futures.as_completed(Futures):
+            (Name, Type, _, _), Entries = Futures[Future]
+            KnownFailures = LoadTestsFile(os.path.join(Options.source, "Known_Failures")) | \
+                            LoadTestsFile(os.path.join(Options.source, "Known_Failures_" + Type))
+            for Entry in Entries:
+                Status, Microseconds = Future.result()[Entry.Binary]
+                Failed = Status in ("Failed", "Crashed")
+                Expected = Failed == (Entry.Name in KnownFailures)
+                Records.append((Entry, Name, Status, Microseconds, Expected))
+                print("{} {}/{} {} {:.3f}ms".format("ok  " if Expected else "FAIL", Name, Entry.Name, Status, Microseconds / 1000.0), flush=True)
+
+    Records.sort(key=lambda r: (r[0].Name, r[1]))
+
+    if Options.timing_csv:
+        with open(Options.timing_csv, "w", newline="") as CSVFile:
+            Writer = csv.writer(CSVFile)
+            Writer.writerow(["test", "config", "result", "microseconds"])
+            for Entry, Name, Status, Microseconds, _ in Records:
+                Writer.writerow([Entry.Name, Name, Status, Microseconds])
+
+    print("\nTime per group and config:")
+    GroupTimes = defaultdict(int)
+    for Entry, Name, _, Microseconds, _ in Records:
+        GroupTimes[(Entry.Group, Name)] += Microseconds
+    for (Group, Name), Microseconds in sorted(GroupTimes.items(), key=lambda g: -g[1]):
+        print("  {:<32} {:<12} {:10.3f}ms".format(Group, Name, Microseconds / 1000.0))
+
+    if Options.slowest > 0:
+        print("\nSlowest tests:")
+        for Entry, Name, _, Microseconds, _ in sorted(Records, key=lambda r: -r[3])[:Options.slowest]:
+            print("  {}/{} {:.3f}ms".format(Name, Entry.Name, Microseconds / 1000.0))
+
+    Unexpected = [r for r in Records if not r[4]]
+    print("\n{} run, {} unexpected results, {} disabled".format(len(Records), len(Unexpected), Disabled))
+    for Entry, Name, Status, _, _ in Unexpected:
+        print("  {}/{} {}".format(Name, Entry.Name, Status))
+
+    sys.exit(1 if Unexpected else 0)
+
+if __name__ == "__main__":
+    main()
@@ -1,7 +1,12 @@
 #include "Common/ArgumentLoader.h"
 #include "Common/Config.h"
+#ifndef _WIN32
+#include "Common/ConfigCache.h"
+#endif
 
 #include <FEXCore/Config/Config.h>
+#include <FEXCore/Core/CoreState.h>
+#include <FEXCore/Utils/Telemetry.h>
 #include <FEXCore/fextl/fmt.h>
 #include <FEXCore/fextl/map.h>
 #include <FEXCore/fextl/string.h>
@@ -13,6 +18,7 @@
 #ifndef _WIN32
 #include <linux/limits.h>
 #include <pwd.h>
+#include <unistd.h>
 #endif
 #include <list>
 #include <utility>
@@ -39,6 +45,20 @@ namespace JSON {
   }
 
   static void LoadJSonConfig(const fextl::string &Config, std::function<void(const char *Name, const char *ConfigSring)> Func) {
+#ifndef _WIN32
+    struct stat Stat;
+    if (stat(Config.c_str(), &Stat) != 0) {
+      return;
+    }
+
+    // Every process start reads the same handful of configs, skip the parse if nothing changed since the last one
+    if (Cache::Load(Config, Stat, Func)) {
+      return;
+    }
+
+    Cache::OptionList Options;
+#endif
+
     fextl::vector<char> Data;
     if (!FEXCore::FileLoading::LoadFile(Data, Config)) {
       return;
@@ -61,6 +81,9 @@ namespace JSON {
 
     if (!ConfigList) {
       // This is a non-error if the configuration file exists but no Config section
+#ifndef _WIN32
+      Cache::Store(Config, Stat, Options);
+#endif
       return;
     }
 
@@ -81,7 +104,14 @@ namespace JSON {
       }
 
       Func(ConfigName, ConfigString);
+#ifndef _WIN32
+      Options.emplace_back(ConfigName, ConfigString);
+#endif
     }
+
+#ifndef _WIN32
+    Cache::Store(Config, Stat, Options);
+#endif
   }
 }
 
@@ -193,7 +223,9 @@ namespace JSON {
     : OptionMapper(Type) {
     const bool Global = Type == FEXCore::Config::LayerType::LAYER_GLOBAL_STEAM_APP ||
                         Type == FEXCore::Config::LayerType::LAYER_GLOBAL_APP;
-    Config = FEXCore::Config::GetApplicationConfig(Filename, Global);
+    Config = Type == FEXCore::Config::LayerType::LAYER_LEARNED_APP ?
+      GetLearnedAppConfig(Filename) :
+      FEXCore::Config::GetApplicationConfig(Filename, Global);
 
     // Immediately load so we can reload the meta layer
     Load();
@@ -279,6 +311,76 @@ namespace JSON {
     return fextl::make_unique<EnvLoader>(_envp);
   }
 
+  fextl::string GetLearnedAppConfig(std::string_view ProgramName) {
+    return FEXCore::Config::GetApplicationConfig(fextl::fmt::format("{}.learned", ProgramName), false);
+  }
+
+#ifndef _WIN32
+  // Runs shorter than this are mostly startup and don't replace an earlier profile
+  constexpr double LEARN_MIN_SECONDS = 10.0;
+  // SMC invalidations per second where keeping invalidated blocks aside starts to pay off
+  constexpr double LEARN_SMC_REVALIDATE_RATE = 1.0;
+  // SMC invalidations per second where page faults cost more than validating the written pages before every run
+  constexpr double LEARN_SMC_HYBRID_RATE = 50.0;
+  // x87 fallback calls per second where reduced precision blocks are a measurable win
+  constexpr double LEARN_X87_FALLBACK_RATE = 100000.0;
+
+  void SaveLearnedAppConfig(const fextl::string &ProgramName) {
+    FEX_CONFIG_OPT(LearnAppConfig, LEARNAPPCONFIG);
+    if (!LearnAppConfig || ProgramName.empty()) {
+      return;
+    }
+
+    auto Total = fextl::make_unique<FEXCore::Telemetry::ThreadCounters>();
+    const double Seconds = static_cast<double>(FEXCore::Telemetry::GetCounterTotals(Total.get())) / 1'000'000'000.0;
+    if (Seconds < LEARN_MIN_SECONDS) {
+      return;
+    }
+
+    FEX_CONFIG_OPT(SMCChecks, SMCCHECKS);
+    FEX_CONFIG_OPT(SMCRevalidateBlocks, SMCREVALIDATEBLOCKS);
+    FEX_CONFIG_OPT(X87ReducedPrecision, X87REDUCEDPRECISION);
+    FEX_CONFIG_OPT(X87AdaptivePrecision, X87ADAPTIVEPRECISION);
+
+    // Settings that are already on, possibly from an earlier profile, lower the rates they were recommended for.
+    // They are kept for as long as the application still does the work they help with.
+    EmptyMapper Learned;
+
+    const uint64_t SMCInvalidations = Total->Counters[FEXCore::Telemetry::COUNTER_SMC_INVALIDATIONS];
+    const double SMCRate = SMCInvalidations / Seconds;
+    const bool PageTracking = SMCChecks == FEXCore::Config::CONFIG_SMC_MTRACK ||
+                              SMCChecks == FEXCore::Config::CONFIG_SMC_HYBRID;
+    if (PageTracking && SMCInvalidations) {
+      if (SMCRate >= LEARN_SMC_REVALIDATE_RATE || SMCRevalidateBlocks) {
+        Learned.Set(FEXCore::Config::CONFIG_SMCREVALIDATEBLOCKS, "1");
+      }
+
+      if (SMCRate >= LEARN_SMC_HYBRID_RATE || SMCChecks == FEXCore::Config::CONFIG_SMC_HYBRID) {
+        Learned.Set(FEXCore::Config::CONFIG_SMCCHECKS, fextl::fmt::format("{}", FEXCore::ToUnderlying(FEXCore::Config::CONFIG_SMC_HYBRID)));
+      }
+    }
+
+    uint64_t X87Fallbacks{};
+    for (size_t i = 0; i < FEXCore::Core::OPINDEX_VPCMPESTRX; ++i) {
+      X87Fallbacks += Total->Fallbacks[i];
+    }
+
+    if (!X87ReducedPrecision && X87Fallbacks &&
+        (X87Fallbacks / Seconds >= LEARN_X87_FALLBACK_RATE || X87AdaptivePrecision)) {
+      Learned.Set(FEXCore::Config::CONFIG_X87ADAPTIVEPRECISION, "1");
+    }
+
+    const auto Filename = GetLearnedAppConfig(ProgramName);
+    if (Learned.GetOptionMap().empty()) {
+      // Nothing to recommend anymore, don't leave stale settings behind
+      unlink(Filename.c_str());
+      return;
+    }
+
+    SaveLayerToJSON(Filename, &Learned);
+  }
+#endif
+
   fextl::string RecoverGuestProgramFilename(fextl::string Program, bool ExecFDInterp, const std::string_view ProgramFDFromEnv) {
     // If executed with a FEX FD then the Program argument might be empty.
     // In this case we need to scan the FD node to recover the application binary that exists on disk.
@@ -419,6 +521,7 @@ namespace JSON {
         }
       }
 
+      FEXCore::Config::AddLayer(CreateAppLayer(ProgramName, FEXCore::Config::LayerType::LAYER_LEARNED_APP));
       FEXCore::Config::AddLayer(CreateAppLayer(ProgramName, FEXCore::Config::LayerType::LAYER_GLOBAL_APP));
       FEXCore::Config::AddLayer(CreateAppLayer(ProgramName, FEXCore::Config::LayerType::LAYER_LOCAL_APP));
 
@@ -2,6 +2,8 @@
 #include <FEXCore/Config/Config.h>
 #include <FEXCore/fextl/string.h>
 
+#include <string_view>
+
 /**
  * @brief This is a singleton for storing global configuration state
  */
@@ -91,4 +93,23 @@ namespace FEX::Config {
    * @return unique_ptr for that layer
    */
   fextl::unique_ptr<FEXCore::Config::Layer> CreateEnvironmentLayer(char *const _envp[]);
+
+  /**
+   * @brief Path of the profile that LearnAppConfig writes for an application
+   *
+   * @param ProgramName Application filename component
+   */
+  fextl::string GetLearnedAppConfig(std::string_view ProgramName);
+
+#ifndef _WIN32
+  /**
+   * @brief Writes the application's learned profile from this run's telemetry counters if LearnAppConfig is enabled
+   *
+   * Needs to run before the config layers are shut down.
+   * Removes the profile if nothing is recommended anymore.
+   *
+   * @param ProgramName Application filename component
+   */
+  void SaveLearnedAppConfig(const fextl::string &ProgramName);
+#endif
 }
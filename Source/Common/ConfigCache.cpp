@@ -0,0 +1,149 @@
+#include "Common/Config.h"
+#include "Common/ConfigCache.h"
+
+#include <FEXCore/fextl/fmt.h>
+#include <FEXCore/Utils/File.h>
+#include <FEXHeaderUtils/Filesystem.h>
+
+#include <cstring>
+#include <fcntl.h>
+#include <string_view>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace FEX::Config::Cache {
+  constexpr char Magic[8] = {'F', 'E', 'X', 'C', 'F', 'G', 'C', '1'};
+  constexpr uint32_t Version = 1;
+
+  /**
+   * A Header, followed by the null terminated path of the JSON file, followed by Count entries.
+   * Each entry is a null terminated option name directly followed by its null terminated value.
+   */
+  struct Header {
+    char Magic[8];
+    uint32_t Version;
+    uint32_t Count;
+    uint64_t Dev;
+    uint64_t Inode;
+    uint64_t Size;
+    int64_t MTimeSec;
+    int64_t MTimeNSec;
+    uint64_t PathLength;
+  };
+
+  static fextl::string GetCachePath(const fextl::string &Config) {
+    const auto Hash = std::hash<std::string_view>{}(Config);
+    return fextl::fmt::format("{}ConfigCache/{:016x}.bin", FEX::Config::GetDataDirectory(), Hash);
+  }
+
+  static bool Matches(const Header &Header, const fextl::string &Config, const struct stat &Stat) {
+    return memcmp(Header.Magic, Magic, sizeof(Magic)) == 0 &&
+           Header.Version == Version &&
+           Header.Dev == Stat.st_dev &&
+           Header.Inode == Stat.st_ino &&
+           Header.Size == static_cast<uint64_t>(Stat.st_size) &&
+           Header.MTimeSec == Stat.st_mtim.tv_sec &&
+           Header.MTimeNSec == Stat.st_mtim.tv_nsec &&
+           Header.PathLength == Config.size();
+  }
+
+  bool Load(const fextl::string &Config, const struct stat &Stat, const std::function<void(const char *Name, const char *ConfigString)> &Func) {
+    int FD = open(GetCachePath(Config).c_str(), O_RDONLY | O_CLOEXEC);
+    if (FD == -1) {
+      return false;
+    }
+
+    struct stat CacheStat;
+    if (fstat(FD, &CacheStat) != 0 || CacheStat.st_size < static_cast<off_t>(sizeof(Header))) {
+      close(FD);
+      return false;
+    }
+
+    const size_t CacheSize = CacheStat.st_size;
+    void *Ptr = mmap(nullptr, CacheSize, PROT_READ, MAP_PRIVATE, FD, 0);
+    close(FD);
+    if (Ptr == MAP_FAILED) {
+      return false;
+    }
+
+    const auto Data = reinterpret_cast<const char*>(Ptr);
+    const auto End = Data + CacheSize;
+    const auto Hdr = reinterpret_cast<const Header*>(Data);
+    const char *Cur = Data + sizeof(Header);
+
+    // Guards against a hash collision between two config paths
+    bool Valid = Matches(*Hdr, Config, Stat) &&
+                 static_cast<size_t>(End - Cur) > Hdr->PathLength &&
+                 memcmp(Cur, Config.c_str(), Hdr->PathLength + 1) == 0;
+
+    // Validate every string is terminated inside the file before applying anything
+    fextl::vector<const char*> Strings;
+    if (Valid) {
+      Cur += Hdr->PathLength + 1;
+      Strings.reserve(Hdr->Count * 2);
+      for (size_t i = 0; i < Hdr->Count * 2; ++i) {
+        const auto Terminator = static_cast<const char*>(memchr(Cur, 0, End - Cur));
+        if (!Terminator) {
+          Valid = false;
+          break;
+        }
+        Strings.emplace_back(Cur);
+        Cur = Terminator + 1;
+      }
+    }
+
+    if (Valid) {
+      for (size_t i = 0; i < Strings.size(); i += 2) {
+        Func(Strings[i], Strings[i + 1]);
+      }
+    }
+
+    munmap(Ptr, CacheSize);
+    return Valid;
+  }
+
+  void Store(const fextl::string &Config, const struct stat &Stat, const OptionList &Options) {
+    const auto CachePath = GetCachePath(Config);
+    const auto CacheDir = FHU::Filesystem::ParentPath(CachePath);
+    if (!FHU::Filesystem::Exists(CacheDir) &&
+        !FHU::Filesystem::CreateDirectories(CacheDir)) {
+      return;
+    }
+
+    Header Hdr {
+      .Version = Version,
+      .Count = static_cast<uint32_t>(Options.size()),
+      .Dev = Stat.st_dev,
+      .Inode = Stat.st_ino,
+      .Size = static_cast<uint64_t>(Stat.st_size),
+      .MTimeSec = Stat.st_mtim.tv_sec,
+      .MTimeNSec = Stat.st_mtim.tv_nsec,
+      .PathLength = Config.size(),
+    };
+    memcpy(Hdr.Magic, Magic, sizeof(Magic));
+
+    fextl::vector<char> Buffer(reinterpret_cast<const char*>(&Hdr), reinterpret_cast<const char*>(&Hdr + 1));
+    Buffer.insert(Buffer.end(), Config.c_str(), Config.c_str() + Config.size() + 1);
+    for (auto &[Name, Value] : Options) {
+      Buffer.insert(Buffer.end(), Name.c_str(), Name.c_str() + Name.size() + 1);
+      Buffer.insert(Buffer.end(), Value.c_str(), Value.c_str() + Value.size() + 1);
+    }
+
+    const auto TmpPath = fextl::fmt::format("{}.{}", CachePath, ::getpid());
+    {
+      auto File = FEXCore::File::File(TmpPath.c_str(),
+        FEXCore::File::FileModes::WRITE |
+        FEXCore::File::FileModes::CREATE |
+        FEXCore::File::FileModes::TRUNCATE);
+
+      if (!File.IsValid() || File.Write(Buffer.data(), Buffer.size()) != static_cast<ssize_t>(Buffer.size())) {
+        unlink(TmpPath.c_str());
+        return;
+      }
+    }
+
+    if (FHU::Filesystem::RenameFile(TmpPath, CachePath)) {
+      unlink(TmpPath.c_str());
+    }
+  }
+}
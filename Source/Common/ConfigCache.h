@@ -0,0 +1,37 @@
+#pragma once
+#include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <functional>
+#include <utility>
+#include <sys/stat.h>
+
+namespace FEX::Config::Cache {
+  using OptionList = fextl::vector<std::pair<fextl::string, fextl::string>>;
+
+  /**
+   * @brief Applies the binary snapshot of a JSON config file if it is still current
+   *
+   * Snapshots live in the data directory and are keyed by the JSON file's path.
+   * A snapshot is only used if the device, inode, size and mtime it recorded match the file on disk.
+   * The snapshot is mapped and its strings are handed to Func in place without being copied.
+   *
+   * @param Config JSON config file the snapshot was taken of
+   * @param Stat stat of Config
+   * @param Func Called for every option stored in the snapshot
+   *
+   * @return true if the snapshot was current and applied
+   */
+  bool Load(const fextl::string &Config, const struct stat &Stat, const std::function<void(const char *Name, const char *ConfigString)> &Func);
+
+  /**
+   * @brief Writes a binary snapshot of a freshly parsed JSON config file
+   *
+   * The snapshot is written to a temporary file and renamed in place so concurrent processes never see a partial one.
+   *
+   * @param Config JSON config file that was parsed
+   * @param Stat stat of Config taken before it was parsed
+   * @param Options Every option in the file in file order
+   */
+  void Store(const fextl::string &Config, const struct stat &Stat, const OptionList &Options);
+}
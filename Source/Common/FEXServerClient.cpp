@@ -12,6 +12,8 @@
 #include <fcntl.h>
 #include <linux/limits.h>
 #include <unistd.h>
+#include <algorithm>
+#include <sys/mman.h>
 #include <sys/poll.h>
 #include <sys/prctl.h>
 #include <sys/signal.h>
@@ -20,10 +22,68 @@
 #include <sys/types.h>
 #include <sys/un.h>
 #include <sys/uio.h>
+#include <mutex>
 #include <thread>
 
 namespace FEXServerClient {
-  int RequestPIDFDPacket(int ServerSocket, PacketType Type) {
+  bool ReceiveFDsPacket(int ServerSocket, int *FDs, size_t NumFDs) {
+    // Wait for success response with SCM_RIGHTS
+
+    FEXServerResultPacket Res{};
+    struct iovec iov {
+      .iov_base = &Res,
+      .iov_len = sizeof(Res),
+    };
+
+    struct msghdr msg {
+      .msg_name = nullptr,
+      .msg_namelen = 0,
+      .msg_iov = &iov,
+      .msg_iovlen = 1,
+    };
+
+    // Setup the ancillary buffer. This is where we will be getting pipe FDs
+    // We only need 4 bytes per FD
+    constexpr size_t MAX_FDS = 2;
+    constexpr size_t CMSG_SIZE = CMSG_SPACE(sizeof(int) * MAX_FDS);
+    union AncillaryBuffer {
+      struct cmsghdr Header;
+      uint8_t Buffer[CMSG_SIZE];
+    };
+    AncillaryBuffer AncBuf{};
+
+    // Now link to our ancilllary buffer
+    msg.msg_control = AncBuf.Buffer;
+    msg.msg_controllen = CMSG_SIZE;
+
+    ssize_t DataResult = recvmsg(ServerSocket, &msg, 0);
+    if (DataResult > 0) {
+      // Now that we have the data, we can extract the FD from the ancillary buffer
+      struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+
+      // Do some error checking
+      if (cmsg == nullptr ||
+          NumFDs > MAX_FDS ||
+          cmsg->cmsg_len != CMSG_LEN(sizeof(int) * NumFDs) ||
+          cmsg->cmsg_level != SOL_SOCKET ||
+          cmsg->cmsg_type != SCM_RIGHTS) {
+        // Couldn't get a socket
+      }
+      else {
+        // Check for Success.
+        // If type error was returned then the FEXServer doesn't have a log to pipe in to
+        if (Res.Header.Type == PacketType::TYPE_SUCCESS) {
+          // Now that we know the cmsg is sane, read the FDs
+          memcpy(FDs, CMSG_DATA(cmsg), sizeof(int) * NumFDs);
+          return true;
+        }
+      }
+    }
+
+    return false;
+  }
+
+  bool RequestFDsPacket(int ServerSocket, PacketType Type, int *FDs, size_t NumFDs) {
     FEXServerRequestPacket Req {
       .Header {
         .Type = Type,
@@ -32,63 +92,26 @@ namespace FEXServerClient {
 
     int Result = write(ServerSocket, &Req, sizeof(Req.BasicRequest));
     if (Result != -1) {
-      // Wait for success response with SCM_RIGHTS
-
-      FEXServerResultPacket Res{};
-      struct iovec iov {
-        .iov_base = &Res,
-        .iov_len = sizeof(Res),
-      };
-
-      struct msghdr msg {
-        .msg_name = nullptr,
-        .msg_namelen = 0,
-        .msg_iov = &iov,
-        .msg_iovlen = 1,
-      };
-
-      // Setup the ancillary buffer. This is where we will be getting pipe FDs
-      // We only need 4 bytes for the FD
-      constexpr size_t CMSG_SIZE = CMSG_SPACE(sizeof(int));
-      union AncillaryBuffer {
-        struct cmsghdr Header;
-        uint8_t Buffer[CMSG_SIZE];
-      };
-      AncillaryBuffer AncBuf{};
-
-      // Now link to our ancilllary buffer
-      msg.msg_control = AncBuf.Buffer;
-      msg.msg_controllen = CMSG_SIZE;
-
-      ssize_t DataResult = recvmsg(ServerSocket, &msg, 0);
-      if (DataResult > 0) {
-        // Now that we have the data, we can extract the FD from the ancillary buffer
-        struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
-
-        // Do some error checking
-        if (cmsg == nullptr ||
-            cmsg->cmsg_len != CMSG_LEN(sizeof(int)) ||
-            cmsg->cmsg_level != SOL_SOCKET ||
-            cmsg->cmsg_type != SCM_RIGHTS) {
-          // Couldn't get a socket
-        }
-        else {
-          // Check for Success.
-          // If type error was returned then the FEXServer doesn't have a log to pipe in to
-          if (Res.Header.Type == PacketType::TYPE_SUCCESS) {
-            // Now that we know the cmsg is sane, read the FD
-            int NewFD{};
-            memcpy(&NewFD, CMSG_DATA(cmsg), sizeof(NewFD));
-            return NewFD;
-          }
-        }
-      }
+      return ReceiveFDsPacket(ServerSocket, FDs, NumFDs);
+    }
+
+    return false;
+  }
+
+  int RequestPIDFDPacket(int ServerSocket, PacketType Type) {
+    int NewFD{};
+    if (RequestFDsPacket(ServerSocket, Type, &NewFD, 1)) {
+      return NewFD;
     }
 
     return -1;
   }
 
   static int ServerFD {-1};
+  static uint32_t ServerProtocolVersion{};
+  static fextl::string ServerRootFSPath{};
+  // Serializes the requests made while the guest runs, they come from any thread and share the one socket
+  static std::mutex RuntimeRequestMutex{};
 
   fextl::string GetServerLockFolder() {
     return FEXCore::Config::GetDataDirectory() + "Server/";
@@ -149,11 +172,16 @@ namespace FEXServerClient {
     return ServerFD;
   }
 
+  uint32_t GetServerProtocolVersion() {
+    return ServerProtocolVersion;
+  }
+
   int ConnectToServer(ConnectionOption ConnectionOption) {
     auto ServerSocketName = GetServerSocketName();
 
     // Create the initial unix socket
-    int SocketFD = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    // SEQPACKET, each request and result is its own message
+    int SocketFD = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
     if (SocketFD == -1) {
       LogMan::Msg::EFmt("Couldn't open AF_UNIX socket {} {}", errno, strerror(errno));
       return -1;
@@ -170,7 +198,19 @@ namespace FEXServerClient {
     // Include final null character.
     size_t SizeOfAddr = sizeof(addr.sun_family) + SizeOfSocketString;
 
-    if (connect(SocketFD, reinterpret_cast<struct sockaddr*>(&addr), SizeOfAddr) == -1) {
+    int Result = connect(SocketFD, reinterpret_cast<struct sockaddr*>(&addr), SizeOfAddr);
+    if (Result == -1 && errno == EPROTOTYPE) {
+      // FEXServer from before the switch to SEQPACKET is still running, talk to it over a stream socket
+      close(SocketFD);
+      SocketFD = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+      if (SocketFD == -1) {
+        LogMan::Msg::EFmt("Couldn't open AF_UNIX socket {} {}", errno, strerror(errno));
+        return -1;
+      }
+      Result = connect(SocketFD, reinterpret_cast<struct sockaddr*>(&addr), SizeOfAddr);
+    }
+
+    if (Result == -1) {
       if (ConnectionOption == ConnectionOption::Default || errno != ECONNREFUSED) {
         LogMan::Msg::EFmt("Couldn't connect to FEXServer socket {} {} {}", ServerSocketName, errno, strerror(errno));
       }
@@ -187,10 +227,14 @@ namespace FEXServerClient {
       return false;
     }
 
+    // Asked before anything else so an old FEXServer never sees a request it would drop without a reply
+    ServerProtocolVersion = FEXServerClient::RequestProtocolVersion(ServerFD, 1000);
+
     // If we were started in a container then we want to use the rootfs that they provided.
     // In the pressure-vessel case this is a combination of our rootfs and the steam soldier runtime.
     if (FEXCore::Config::FindContainer() != "pressure-vessel") {
       fextl::string RootFSPath = FEXServerClient::RequestRootFSPath(ServerFD);
+      ServerRootFSPath = RootFSPath;
 
       //// If everything has passed then we can now update the rootfs path
       FEXCore::Config::EraseSet(FEXCore::Config::CONFIG_ROOTFS, RootFSPath);
@@ -300,10 +344,68 @@ namespace FEXServerClient {
     write(ServerSocket, &Req, sizeof(Req.BasicRequest));
   }
 
+  uint32_t RequestProtocolVersion(int ServerSocket, int TimeoutMS) {
+    FEXServerRequestPacket Req {
+      .Header {
+        .Type = PacketType::TYPE_GET_PROTOCOL_VERSION,
+      },
+    };
+
+    if (write(ServerSocket, &Req, sizeof(Req.BasicRequest)) == -1) {
+      return 0;
+    }
+
+    pollfd PollFD {
+      .fd = ServerSocket,
+      .events = POLLIN,
+      .revents = 0,
+    };
+
+    int Result{};
+    while ((Result = poll(&PollFD, 1, TimeoutMS)) == -1 && errno == EINTR);
+    if (Result != 1 || !(PollFD.revents & POLLIN)) {
+      // Old FEXServer, it logged the request as invalid and moved on
+      return 0;
+    }
+
+    FEXServerResultPacket Res{};
+    ssize_t DataResult = recv(ServerSocket, &Res, sizeof(Res), 0);
+    if (DataResult >= static_cast<ssize_t>(sizeof(Res.ProtocolVersion)) &&
+        Res.Header.Type == PacketType::TYPE_GET_PROTOCOL_VERSION) {
+      return Res.ProtocolVersion.Version;
+    }
+
+    return 0;
+  }
+
   int RequestLogFD(int ServerSocket) {
     return RequestPIDFDPacket(ServerSocket, PacketType::TYPE_GET_LOG_FD);
   }
 
+  Logging::RingHeader *RequestLogRing(int ServerSocket, int *LogFD) {
+    if (ServerProtocolVersion < 1) {
+      return nullptr;
+    }
+
+    // 0 = Pipe write side
+    // 1 = Ring memfd
+    int FDs[2]{};
+    if (!RequestFDsPacket(ServerSocket, PacketType::TYPE_GET_LOG_RING_FDS, FDs, 2)) {
+      return nullptr;
+    }
+
+    void *Ptr = mmap(nullptr, Logging::RING_TOTAL_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, FDs[1], 0);
+    close(FDs[1]);
+
+    if (Ptr == MAP_FAILED) {
+      close(FDs[0]);
+      return nullptr;
+    }
+
+    *LogFD = FDs[0];
+    return reinterpret_cast<Logging::RingHeader*>(Ptr);
+  }
+
   fextl::string RequestRootFSPath(int ServerSocket) {
     FEXServerRequestPacket Req {
       .Header {
@@ -333,6 +435,100 @@ namespace FEXServerClient {
     return RequestPIDFDPacket(ServerSocket, PacketType::TYPE_GET_PID_FD);
   }
 
+  int RequestRootFSEntriesFD(int ServerSocket) {
+    if (ServerProtocolVersion < 1) {
+      return -1;
+    }
+
+    return RequestPIDFDPacket(ServerSocket, PacketType::TYPE_GET_ROOTFS_ENTRIES_FD);
+  }
+
+  fextl::string const &GetServerRootFSPath() {
+    return ServerRootFSPath;
+  }
+
+  int RequestRootFSCacheFD(int ServerSocket) {
+    if (ServerProtocolVersion < 1) {
+      return -1;
+    }
+
+    return RequestPIDFDPacket(ServerSocket, PacketType::TYPE_GET_ROOTFS_CACHE_FD);
+  }
+
+  bool RequestCacheRootFSFile(int ServerSocket, const char *Path) {
+    if (ServerProtocolVersion < 1) {
+      return false;
+    }
+
+    FEXServerRequestPacket Req {
+      .CacheFile {
+        .Header {
+          .Type = PacketType::TYPE_CACHE_ROOTFS_FILE,
+        },
+        .Length = strlen(Path) + 1,
+      },
+    };
+
+    const iovec vec[2] = {
+      {
+        .iov_base = &Req,
+        .iov_len = sizeof(Req.CacheFile),
+      },
+      {
+        .iov_base = const_cast<char*>(Path),
+        .iov_len = Req.CacheFile.Length,
+      },
+    };
+
+    std::unique_lock lk {RuntimeRequestMutex};
+    if (writev(ServerSocket, vec, 2) == -1) {
+      return false;
+    }
+
+    // The copy is done by the time the result comes back
+    FEXServerResultPacket Res{};
+    ssize_t DataResult = recv(ServerSocket, &Res, sizeof(Res), 0);
+    return DataResult >= static_cast<ssize_t>(sizeof(Res.Header)) && Res.Header.Type == PacketType::TYPE_SUCCESS;
+  }
+
+  int RequestCodeObjectFD(int ServerSocket, const char *Name) {
+    if (ServerProtocolVersion < 1) {
+      return -1;
+    }
+
+    FEXServerRequestPacket Req {
+      .CodeObject {
+        .Header {
+          .Type = PacketType::TYPE_GET_CODE_OBJECT_FD,
+        },
+        .Length = strlen(Name) + 1,
+      },
+    };
+
+    const iovec vec[2] = {
+      {
+        .iov_base = &Req,
+        .iov_len = sizeof(Req.CodeObject),
+      },
+      {
+        .iov_base = const_cast<char*>(Name),
+        .iov_len = Req.CodeObject.Length,
+      },
+    };
+
+    std::unique_lock lk {RuntimeRequestMutex};
+    if (writev(ServerSocket, vec, 2) == -1) {
+      return -1;
+    }
+
+    int FD{};
+    if (ReceiveFDsPacket(ServerSocket, &FD, 1)) {
+      return FD;
+    }
+
+    return -1;
+  }
+
   /**  @} */
 
   /**
@@ -361,6 +557,56 @@ namespace FEXServerClient {
     writev(FD, vec, 2);
   }
 
+  namespace Logging {
+    static void CopyToRing(RingHeader *Ring, uint64_t Offset, const void *Src, size_t Size) {
+      const size_t Begin = Offset & (RING_DATA_SIZE - 1);
+      const size_t FirstPart = std::min(Size, RING_DATA_SIZE - Begin);
+      memcpy(GetRingData(Ring) + Begin, Src, FirstPart);
+      memcpy(GetRingData(Ring), reinterpret_cast<const uint8_t*>(Src) + FirstPart, Size - FirstPart);
+    }
+
+    static bool WriteToRing(int FD, RingHeader *Ring, LogMan::DebugLevels Level, char const *Message) {
+      // Never wait for the lock, it might be held by the code this signal interrupted
+      uint32_t Expected{};
+      if (!Ring->WriterLock.compare_exchange_strong(Expected, 1, std::memory_order_acquire)) {
+        return false;
+      }
+
+      size_t MsgLen = strlen(Message) + 1;
+
+      Logging::PacketMsg Msg;
+      Msg.Header = Logging::FillHeader(Logging::PacketTypes::TYPE_MSG);
+      Msg.MessageLength = MsgLen;
+      Msg.Level = Level;
+
+      const uint64_t Head = Ring->Head.load(std::memory_order_relaxed);
+      const uint64_t PacketSize = sizeof(Msg) + MsgLen;
+      const bool Fits = (Head + PacketSize - Ring->Tail.load(std::memory_order_acquire)) <= RING_DATA_SIZE;
+      if (Fits) {
+        CopyToRing(Ring, Head, &Msg, sizeof(Msg));
+        CopyToRing(Ring, Head + sizeof(Msg), Message, MsgLen);
+        Ring->Head.store(Head + PacketSize);
+
+        // If everything before this message was consumed then FEXServer may be sleeping on the pipe
+        if (Ring->Tail.load() == Head) {
+          auto Wake = Logging::FillHeader(Logging::PacketTypes::TYPE_WAKE);
+          write(FD, &Wake, sizeof(Wake));
+        }
+      }
+
+      Ring->WriterLock.store(0, std::memory_order_release);
+      return Fits;
+    }
+  }
+
+  void MsgHandler(int FD, Logging::RingHeader *Ring, LogMan::DebugLevels Level, char const *Message) {
+    if (Ring && Logging::WriteToRing(FD, Ring, Level, Message)) {
+      return;
+    }
+
+    MsgHandler(FD, Level, Message);
+  }
+
   void AssertHandler(int FD, char const *Message) {
     MsgHandler(FD, LogMan::DebugLevels::ASSERT, Message);
   }
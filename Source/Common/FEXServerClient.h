@@ -4,6 +4,8 @@
 #include <FEXCore/fextl/string.h>
 #include <FEXHeaderUtils/Syscalls.h>
 
+#include <atomic>
+
 namespace FEXServerClient {
   enum class PacketType {
     // Request and Result
@@ -15,8 +17,28 @@ namespace FEXServerClient {
     // Result only
     TYPE_SUCCESS,
     TYPE_ERROR,
+
+    // Request and Result
+    // After the result types so an already running FEXServer keeps agreeing on their values
+    TYPE_GET_ROOTFS_ENTRIES_FD,
+    TYPE_GET_LOG_RING_FDS,
+    TYPE_GET_ROOTFS_CACHE_FD,
+    TYPE_CACHE_ROOTFS_FILE,
+    TYPE_GET_CODE_OBJECT_FD,
+    TYPE_GET_PROTOCOL_VERSION,
   };
 
+  /**
+   * @brief Version of the requests the FEXServer understands
+   *
+   * A FEXServer from before TYPE_GET_PROTOCOL_VERSION drops every request it doesn't know without replying,
+   * so anything past TYPE_ERROR may only be sent once the server has answered with a new enough version.
+   *
+   * 0 - Only the requests before TYPE_SUCCESS
+   * 1 - Everything up to TYPE_GET_PROTOCOL_VERSION
+   */
+  constexpr uint32_t PROTOCOL_VERSION = 1;
+
   union FEXServerRequestPacket {
     struct Header {
       PacketType Type;
@@ -25,6 +47,20 @@ namespace FEXServerClient {
     struct {
       struct Header Header;
     } BasicRequest;
+
+    struct {
+      struct Header Header;
+      // Includes the NUL terminator
+      size_t Length;
+      char Path[0];
+    } CacheFile;
+
+    struct {
+      struct Header Header;
+      // Includes the NUL terminator
+      size_t Length;
+      char Name[0];
+    } CodeObject;
   };
 
   union FEXServerResultPacket {
@@ -42,6 +78,11 @@ namespace FEXServerClient {
       size_t Length;
       char Mount[0];
     } MountPath;
+
+    struct {
+      struct Header Header;
+      uint32_t Version;
+    } ProtocolVersion;
   };
 
   constexpr size_t MAXIMUM_REQUEST_PACKET_SIZE = sizeof(FEXServerRequestPacket);
@@ -73,6 +114,13 @@ namespace FEXServerClient {
    */
   int ConnectToServer(ConnectionOption ConnectionOption = ConnectionOption::Default);
 
+  /**
+   * @brief Protocol version of the FEXServer that SetupClient connected to
+   *
+   * @return 0 when there is no server or it is too old to answer TYPE_GET_PROTOCOL_VERSION
+   */
+  uint32_t GetServerProtocolVersion();
+
   /**
    * @name Packet request functions
    * @{ */
@@ -83,6 +131,18 @@ namespace FEXServerClient {
    */
   void RequestServerKill(int ServerSocket);
 
+  /**
+   * @brief Request the protocol version of a FEXServer
+   *
+   * An old FEXServer never answers, so the reply is only waited on for TimeoutMS.
+   *
+   * @param ServerSocket - Socket to the server
+   * @param TimeoutMS - How long to wait for the reply
+   *
+   * @return The server's PROTOCOL_VERSION, or 0 if it didn't answer in time
+   */
+  uint32_t RequestProtocolVersion(int ServerSocket, int TimeoutMS);
+
   /**
    * @brief Request a FEXServer to give us a log FD to write in to
    *
@@ -92,6 +152,20 @@ namespace FEXServerClient {
    */
   int RequestLogFD(int ServerSocket);
 
+  namespace Logging {
+    struct RingHeader;
+  }
+
+  /**
+   * @brief Request a FEXServer to give us a shared memory log ring
+   *
+   * @param ServerSocket - Socket to the server
+   * @param LogFD - Pipe for wakeups, and for messages that don't fit in the ring
+   *
+   * @return The mapped ring, or nullptr with LogFD left untouched. Always nullptr for a FEXServer that is too old to have rings
+   */
+  Logging::RingHeader *RequestLogRing(int ServerSocket, int *LogFD);
+
   fextl::string RequestRootFSPath(int ServerSocket);
 
   /**
@@ -103,6 +177,54 @@ namespace FEXServerClient {
    */
   int RequestPIDFD(int ServerSocket);
 
+  /**
+   * @brief Request the top level entries of the FEXServer's RootFS mount
+   *
+   * @param ServerSocket - Socket to the server
+   *
+   * @return FD of a sealed memfd containing NUL terminated entry names, or -1
+   */
+  int RequestRootFSEntriesFD(int ServerSocket);
+
+  /**
+   * @brief RootFS path that the FEXServer handed out in SetupClient
+   *
+   * Empty if FEXServer doesn't have a RootFS mounted or a container RootFS is used
+   */
+  fextl::string const &GetServerRootFSPath();
+
+  /**
+   * @brief Request the RootFS file cache folder of the FEXServer
+   *
+   * @param ServerSocket - Socket to the server
+   *
+   * @return O_PATH FD of the folder, or -1 if the file cache isn't enabled in the FEXServer
+   */
+  int RequestRootFSCacheFD(int ServerSocket);
+
+  /**
+   * @brief Request the FEXServer to copy a RootFS file in to its file cache
+   *
+   * @param ServerSocket - Socket to the server
+   * @param Path - Path relative to the RootFS, with symlinks resolved
+   *
+   * @return True once the file exists in the cache folder
+   */
+  bool RequestCacheRootFSFile(int ServerSocket, const char *Path);
+
+  /**
+   * @brief Request the FEXServer's shared object cache file with the given name
+   *
+   * Every process asking for the same name gets the same memfd, created empty by the first request.
+   * The FD shares its file offset and flock state with every other process, reopen it through /proc/self/fd before using either.
+   *
+   * @param ServerSocket - Socket to the server
+   * @param Name - Object cache file name, without any directory
+   *
+   * @return FD of the memfd, or -1
+   */
+  int RequestCodeObjectFD(int ServerSocket, const char *Name);
+
   /**  @} */
 
   /**
@@ -111,6 +233,8 @@ namespace FEXServerClient {
   namespace Logging {
     enum class PacketTypes : uint32_t {
       TYPE_MSG,
+      // Header only, new data is in the process' log ring
+      TYPE_WAKE,
     };
 
     struct PacketHeader {
@@ -131,6 +255,38 @@ namespace FEXServerClient {
 
     static_assert(sizeof(PacketHeader) == 24, "Wrong size");
 
+    /**
+     * @brief Size of the packet at the start of Data
+     *
+     * The data comes from a process' pipe or ring, nothing in it can be trusted.
+     *
+     * @return The packet size, or 0 if the packet is unknown, runs past Size, or its message isn't NUL terminated
+     */
+    [[maybe_unused]]
+    static size_t GetPacketSize(const uint8_t *Data, size_t Size) {
+      if (Size < sizeof(PacketHeader)) {
+        return 0;
+      }
+
+      const PacketHeader *Header = reinterpret_cast<const PacketHeader*>(Data);
+      if (Header->PacketType == PacketTypes::TYPE_WAKE) {
+        return sizeof(PacketHeader);
+      }
+
+      if (Header->PacketType != PacketTypes::TYPE_MSG || Size < sizeof(PacketMsg)) {
+        return 0;
+      }
+
+      const PacketMsg *Msg = reinterpret_cast<const PacketMsg*>(Data);
+      const size_t Remaining = Size - sizeof(PacketMsg);
+      if (Msg->MessageLength == 0 || Msg->MessageLength > Remaining ||
+          Data[sizeof(PacketMsg) + Msg->MessageLength - 1] != '\0') {
+        return 0;
+      }
+
+      return sizeof(PacketMsg) + Msg->MessageLength;
+    }
+
     [[maybe_unused]]
     static PacketHeader FillHeader(Logging::PacketTypes Type) {
       struct timespec Time{};
@@ -147,9 +303,43 @@ namespace FEXServerClient {
 
       return Msg;
     }
+
+    /**
+     * @brief Shared memory ring of log packets, one per process
+     *
+     * The process writes PacketMsg packets in to the ring and FEXServer drains them in batches,
+     * which saves a write syscall per message.
+     * Head and Tail only ever grow, the data offset is their value modulo RING_DATA_SIZE.
+     * Only one writer is allowed at a time. Threads that can't claim WriterLock, or find the ring full,
+     * send their message over the pipe instead.
+     * A TYPE_WAKE header goes down the pipe whenever FEXServer might have gone to sleep on an empty ring.
+     */
+    struct RingHeader {
+      // Bytes written, only advanced by the process
+      std::atomic<uint64_t> Head;
+      // Bytes consumed, only advanced by FEXServer
+      std::atomic<uint64_t> Tail;
+      std::atomic<uint32_t> WriterLock;
+      uint32_t Pad;
+    };
+
+    constexpr size_t RING_HEADER_SIZE = 4096;
+    constexpr size_t RING_DATA_SIZE = 1024 * 1024;
+    constexpr size_t RING_TOTAL_SIZE = RING_HEADER_SIZE + RING_DATA_SIZE;
+    static_assert((RING_DATA_SIZE & (RING_DATA_SIZE - 1)) == 0, "Ring size needs to be a power of 2");
+    static_assert(sizeof(RingHeader) <= RING_HEADER_SIZE, "Ring header too large");
+
+    [[maybe_unused]]
+    static uint8_t *GetRingData(RingHeader *Ring) {
+      return reinterpret_cast<uint8_t*>(Ring) + RING_HEADER_SIZE;
+    }
   }
 
   void MsgHandler(int FD, LogMan::DebugLevels Level, char const *Message);
+  /**
+   * @brief Writes the message in to the log ring, falling back to the pipe when that isn't possible
+   */
+  void MsgHandler(int FD, Logging::RingHeader *Ring, LogMan::DebugLevels Level, char const *Message);
   void AssertHandler(int FD, char const *Message);
   /**  @} */
 }
@@ -1,3 +1,5 @@
+#include "Common/FileFormatCheck.h"
+
 #include <FEXCore/fextl/string.h>
 
 #include <fcntl.h>
@@ -75,4 +77,9 @@ namespace FEX::FormatCheck {
 
     return Header.Magic == COOKIE_MAGIC_V1;
   }
+
+  bool IsSharedLibraryName(std::string_view Filename) {
+    // Not a substring match, that would pick up names like foo.sock or foo.sorted
+    return Filename.ends_with(".so") || Filename.find(".so.") != Filename.npos;
+  }
 }
@@ -2,7 +2,14 @@
 
 #include <FEXCore/fextl/string.h>
 
+#include <string_view>
+
 namespace FEX::FormatCheck {
   bool IsSquashFS(fextl::string const &Filename);
   bool IsEroFS(fextl::string const &Filename);
+
+  /**
+   * @brief Checks if the file name is one of a shared library, libfoo.so or a versioned libfoo.so.1
+   */
+  bool IsSharedLibraryName(std::string_view Filename);
 }
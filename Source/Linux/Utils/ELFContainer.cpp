@@ -6,7 +6,6 @@ $end_info$
 */
 
 #include "Linux/Utils/ELFContainer.h"
-#include <FEXCore/Utils/FileLoading.h>
 #include <FEXCore/Utils/LogManager.h>
 #include <FEXCore/Utils/MathUtils.h>
 #include <FEXCore/fextl/vector.h>
@@ -14,12 +13,14 @@ $end_info$
 #include <FEXHeaderUtils/SymlinkChecks.h>
 
 #include <algorithm>
+#include <cstdlib>
 #include <cstring>
 #include <elf.h>
 #include <fcntl.h>
 #include <memory>
 #include <linux/limits.h>
 #include <system_error>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -105,7 +106,8 @@ ELFContainer::ELFContainer(fextl::string const &Filename, fextl::string const &R
     // If we we are dynamic application then we have an interpreter program header
     // We need to load that ELF instead if it exists
     // We are no longer dynamic since we are executing the interpreter
-    const char *RawString{};
+    // Copied out since loading the interpreter replaces the mapping it lives in
+    fextl::string RawString;
     if (Mode == MODE_32BIT) {
       RawString = &RawFile.at(InterpreterHeader._32->p_offset);
     }
@@ -159,18 +161,61 @@ ELFContainer::ELFContainer(fextl::string const &Filename, fextl::string const &R
 
 ELFContainer::~ELFContainer() {
   NecessaryLibs.clear();
-  SymbolMapByAddress.clear();
+  SymbolsByAddress.clear();
   SymbolMap.clear();
   Symbols.clear();
   ProgramHeaders.clear();
   SectionHeaders.clear();
-  RawFile.clear();
+  RawFile.Unmap();
+}
+
+bool ELFContainer::MappedFile::Map(fextl::string const &Filename) {
+  int FD = open(Filename.c_str(), O_RDONLY | O_CLOEXEC);
+  if (FD == -1) {
+    return false;
+  }
+
+  struct stat Stat;
+  if (fstat(FD, &Stat) != 0 || Stat.st_size == 0) {
+    close(FD);
+    return false;
+  }
+
+  void *Ptr = mmap(nullptr, Stat.st_size, PROT_READ, MAP_PRIVATE, FD, 0);
+  close(FD);
+  if (Ptr == MAP_FAILED) {
+    return false;
+  }
+
+  Unmap();
+  Data = reinterpret_cast<char*>(Ptr);
+  Size = Stat.st_size;
+  return true;
+}
+
+void ELFContainer::MappedFile::Unmap() {
+  if (Data) {
+    munmap(Data, Size);
+    Data = nullptr;
+    Size = 0;
+  }
+}
+
+char &ELFContainer::MappedFile::at(size_t Offset) const {
+  if (Offset >= Size) {
+    // Matches the vector::at this replaced, a truncated or corrupt file must not read past the mapping
+    LogMan::Msg::EFmt("ELF offset 0x{:x} outside of the 0x{:x} byte file", Offset, Size);
+    std::abort();
+  }
+  return Data[Offset];
 }
 
 bool ELFContainer::LoadELF(fextl::string const &Filename) {
-  if (!FEXCore::FileLoading::LoadFile(RawFile, Filename)) {
+  MappedFile NewFile;
+  if (!NewFile.Map(Filename)) {
     return false;
   }
+  RawFile = std::move(NewFile);
 
   InterpreterHeader._64 = nullptr;
 
@@ -308,29 +353,76 @@ void ELFContainer::WriteLoadableSections(MemoryWriter Writer, uint64_t Offset) {
   }
 }
 
+void ELFContainer::BuildSymbolMap() {
+  SymbolMapBuilt = true;
+  SymbolMap.reserve(Symbols.size());
+  for (auto &Sym : Symbols) {
+    if (Sym.FileOffset) {
+      // Later definitions win, the dynamic symbol table comes after the static one
+      SymbolMap.insert_or_assign(Sym.Name, &Sym);
+    }
+  }
+}
+
+void ELFContainer::BuildSymbolsByAddress() {
+  SymbolsByAddressBuilt = true;
+  SymbolsByAddress.reserve(Symbols.size());
+  for (auto &Sym : Symbols) {
+    if (Sym.FileOffset) {
+      SymbolsByAddress.emplace_back(&Sym);
+    }
+  }
+
+  std::stable_sort(SymbolsByAddress.begin(), SymbolsByAddress.end(), [](ELFSymbol const *lhs, ELFSymbol const *rhs) {
+    return lhs->Address < rhs->Address;
+  });
+
+  // Keep the last definition of each address, stable sort keeps those in table order
+  auto Last = std::unique(SymbolsByAddress.rbegin(), SymbolsByAddress.rend(), [](ELFSymbol const *lhs, ELFSymbol const *rhs) {
+    return lhs->Address == rhs->Address;
+  });
+  SymbolsByAddress.erase(SymbolsByAddress.begin(), Last.base());
+}
+
 ELFSymbol const *ELFContainer::GetSymbol(char const *Name) {
+  if (!SymbolMapBuilt) {
+    BuildSymbolMap();
+  }
+
   auto Sym = SymbolMap.find(Name);
   if (Sym == SymbolMap.end())
     return nullptr;
   return Sym->second;
 }
 ELFSymbol const *ELFContainer::GetSymbol(uint64_t Address) {
-  auto Sym = SymbolMapByAddress.find(Address);
-  if (Sym == SymbolMapByAddress.end())
+  if (!SymbolsByAddressBuilt) {
+    BuildSymbolsByAddress();
+  }
+
+  auto Sym = std::lower_bound(SymbolsByAddress.begin(), SymbolsByAddress.end(), Address, [](ELFSymbol const *lhs, uint64_t Address) {
+    return lhs->Address < Address;
+  });
+  if (Sym == SymbolsByAddress.end() || (*Sym)->Address != Address)
     return nullptr;
-  return Sym->second;
+  return *Sym;
 }
 ELFSymbol const *ELFContainer::GetSymbolInRange(RangeType Address) {
-  auto Sym = SymbolMapByAddress.upper_bound(Address.first);
-  if (Sym != SymbolMapByAddress.begin())
+  if (!SymbolsByAddressBuilt) {
+    BuildSymbolsByAddress();
+  }
+
+  auto Sym = std::upper_bound(SymbolsByAddress.begin(), SymbolsByAddress.end(), Address.first, [](uint64_t Address, ELFSymbol const *rhs) {
+    return Address < rhs->Address;
+  });
+  if (Sym != SymbolsByAddress.begin())
     --Sym;
-  if (Sym == SymbolMapByAddress.end())
+  if (Sym == SymbolsByAddress.end())
     return nullptr;
 
-  if ((Sym->second->Address + Sym->second->Size) < Address.first)
+  if (((*Sym)->Address + (*Sym)->Size) < Address.first)
     return nullptr;
 
-  return Sym->second;
+  return *Sym;
 }
 
 void ELFContainer::CalculateMemoryLayouts() {
@@ -455,9 +547,6 @@ void ELFContainer::CalculateSymbols() {
           DefinedSymbol->Bind = ELF32_ST_BIND(Symbol->st_info);
           DefinedSymbol->Name = Name;
           DefinedSymbol->SectionIndex = Symbol->st_shndx;
-
-          SymbolMap[DefinedSymbol->Name] = DefinedSymbol;
-          SymbolMapByAddress[DefinedSymbol->Address] = DefinedSymbol;
         }
       }
     }
@@ -478,9 +567,6 @@ void ELFContainer::CalculateSymbols() {
           DefinedSymbol->Bind = ELF32_ST_BIND(Symbol->st_info);
           DefinedSymbol->Name = Name;
           DefinedSymbol->SectionIndex = Symbol->st_shndx;
-
-          SymbolMap[DefinedSymbol->Name] = DefinedSymbol;
-          SymbolMapByAddress[DefinedSymbol->Address] = DefinedSymbol;
         }
       }
     }
@@ -588,9 +674,6 @@ void ELFContainer::CalculateSymbols() {
           DefinedSymbol->Bind = ELF64_ST_BIND(Symbol->st_info);
           DefinedSymbol->Name = Name;
           DefinedSymbol->SectionIndex = Symbol->st_shndx;
-
-          SymbolMap[DefinedSymbol->Name] = DefinedSymbol;
-          SymbolMapByAddress[DefinedSymbol->Address] = DefinedSymbol;
         }
       }
     }
@@ -611,9 +694,6 @@ void ELFContainer::CalculateSymbols() {
           DefinedSymbol->Bind = ELF64_ST_BIND(Symbol->st_info);
           DefinedSymbol->Name = Name;
           DefinedSymbol->SectionIndex = Symbol->st_shndx;
-
-          SymbolMap[DefinedSymbol->Name] = DefinedSymbol;
-          SymbolMapByAddress[DefinedSymbol->Address] = DefinedSymbol;
         }
       }
     }
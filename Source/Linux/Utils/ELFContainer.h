@@ -9,6 +9,7 @@
 #include <elf.h>
 #include <functional>
 #include <stddef.h>
+#include <string_view>
 #include <tuple>
 #include <utility>
 
@@ -140,7 +141,36 @@ private:
   void PrintInitArray() const;
   void PrintDynamicTable() const;
 
-  fextl::vector<char> RawFile;
+  /**
+   * @brief Read-only mapping of the whole ELF file
+   *
+   * Only the pages holding headers and tables that actually get parsed are faulted in,
+   * where reading the file in to a buffer touched all of it.
+   */
+  class MappedFile final {
+  public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile &&rhs) {
+      std::swap(Data, rhs.Data);
+      std::swap(Size, rhs.Size);
+      return *this;
+    }
+    ~MappedFile() { Unmap(); }
+
+    bool Map(fextl::string const &Filename);
+    void Unmap();
+
+    size_t size() const { return Size; }
+    char &at(size_t Offset) const;
+
+  private:
+    char *Data{};
+    size_t Size{};
+  };
+
+  MappedFile RawFile;
   union {
     Elf32_Ehdr _32;
     Elf64_Ehdr _64;
@@ -161,8 +191,17 @@ private:
   fextl::vector<ProgramHeader> ProgramHeaders;
   fextl::vector<ELFSymbol> Symbols;
   fextl::vector<uintptr_t> UnwindEntries;
-  fextl::unordered_map<fextl::string, ELFSymbol *> SymbolMap;
-  fextl::map<uint64_t, ELFSymbol *> SymbolMapByAddress;
+
+  // Lookup tables over Symbols, each built on its first query.
+  // Most users only walk Symbols once, so large binaries don't pay for tables nobody reads.
+  fextl::unordered_map<std::string_view, ELFSymbol *> SymbolMap;
+  // Defined symbols sorted by address, one per address
+  fextl::vector<ELFSymbol *> SymbolsByAddress;
+  bool SymbolMapBuilt{};
+  bool SymbolsByAddressBuilt{};
+
+  void BuildSymbolMap();
+  void BuildSymbolsByAddress();
 
   fextl::vector<char const*> NecessaryLibs;
 
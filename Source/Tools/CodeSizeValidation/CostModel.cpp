@@ -0,0 +1,602 @@
+#include "CostModel.h"
+
+#include <FEXCore/fextl/fmt.h>
+#include <FEXCore/fextl/map.h>
+#include <FEXCore/fextl/unordered_map.h>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+
+namespace CodeSize::CostModel {
+  enum class InstClass {
+    ALU,
+    ALU_SHIFTED,
+    MUL,
+    MULH,
+    DIV32,
+    DIV64,
+    CRC,
+    BRANCH,
+    LOAD,
+    LOAD_PAIR,
+    LOAD_VEC,
+    STORE,
+    STORE_VEC,
+    ATOMIC,
+    BARRIER,
+    VEC_ALU,
+    VEC_SHIFT,
+    VEC_MUL,
+    VEC_REDUCE,
+    VEC_PERMUTE,
+    VEC_FROM_GPR,
+    VEC_TO_GPR,
+    FP_ADD,
+    FP_MUL,
+    FP_FMA,
+    FP_DIV32,
+    FP_DIV64,
+    FP_SQRT32,
+    FP_SQRT64,
+    FP_CVT,
+    FP_CMP,
+    CRYPTO,
+    SVE_GATHER,
+    MAX,
+  };
+
+  enum class Pipe {
+    INT,
+    MUL,
+    BRANCH,
+    LOADSTORE,
+    VEC,
+    // Divide and square root only run on one vector pipe and aren't fully pipelined
+    VEC_DIV,
+    MAX,
+  };
+
+  struct ClassCost {
+    uint8_t Latency;
+    Pipe Unit;
+    // Cycles the pipe is busy for, only more than one for unpipelined operations
+    uint8_t Occupancy;
+  };
+
+  struct ModelInfo {
+    std::string_view Name;
+    // Instructions per cycle the front end delivers in a loop
+    uint32_t Width;
+    std::array<uint32_t, static_cast<size_t>(Pipe::MAX)> PipeCount;
+    std::array<ClassCost, static_cast<size_t>(InstClass::MAX)> Costs;
+  };
+
+  // Indexed by InstClass
+  // Divides and square roots use the latency of typical operands rather than the worst case
+#define COSTS(ALU_SHIFTED_LAT, MULH_LAT, LOAD_VEC_LAT, VEC_DIV_PIPE_OCC32, VEC_DIV_PIPE_OCC64, SQRT32_LAT, SQRT64_LAT) {{ \
+    {1, Pipe::INT, 1},                 /* ALU */ \
+    {ALU_SHIFTED_LAT, Pipe::INT, 1},   /* ALU_SHIFTED */ \
+    {2, Pipe::MUL, 1},                 /* MUL */ \
+    {MULH_LAT, Pipe::MUL, 1},          /* MULH */ \
+    {12, Pipe::MUL, 12},               /* DIV32 */ \
+    {20, Pipe::MUL, 20},               /* DIV64 */ \
+    {2, Pipe::MUL, 1},                 /* CRC */ \
+    {1, Pipe::BRANCH, 1},              /* BRANCH */ \
+    {4, Pipe::LOADSTORE, 1},           /* LOAD */ \
+    {4, Pipe::LOADSTORE, 1},           /* LOAD_PAIR */ \
+    {LOAD_VEC_LAT, Pipe::LOADSTORE, 1},/* LOAD_VEC */ \
+    {1, Pipe::LOADSTORE, 1},           /* STORE */ \
+    {1, Pipe::LOADSTORE, 1},           /* STORE_VEC */ \
+    {8, Pipe::LOADSTORE, 1},           /* ATOMIC */ \
+    {10, Pipe::LOADSTORE, 10},         /* BARRIER */ \
+    {2, Pipe::VEC, 1},                 /* VEC_ALU */ \
+    {2, Pipe::VEC, 1},                 /* VEC_SHIFT */ \
+    {4, Pipe::VEC, 1},                 /* VEC_MUL */ \
+    {4, Pipe::VEC, 1},                 /* VEC_REDUCE */ \
+    {2, Pipe::VEC, 1},                 /* VEC_PERMUTE */ \
+    {3, Pipe::VEC, 1},                 /* VEC_FROM_GPR */ \
+    {2, Pipe::VEC, 1},                 /* VEC_TO_GPR */ \
+    {2, Pipe::VEC, 1},                 /* FP_ADD */ \
+    {3, Pipe::VEC, 1},                 /* FP_MUL */ \
+    {4, Pipe::VEC, 1},                 /* FP_FMA */ \
+    {10, Pipe::VEC_DIV, VEC_DIV_PIPE_OCC32}, /* FP_DIV32 */ \
+    {15, Pipe::VEC_DIV, VEC_DIV_PIPE_OCC64}, /* FP_DIV64 */ \
+    {SQRT32_LAT, Pipe::VEC_DIV, VEC_DIV_PIPE_OCC32}, /* FP_SQRT32 */ \
+    {SQRT64_LAT, Pipe::VEC_DIV, VEC_DIV_PIPE_OCC64}, /* FP_SQRT64 */ \
+    {3, Pipe::VEC, 1},                 /* FP_CVT */ \
+    {2, Pipe::VEC, 1},                 /* FP_CMP */ \
+    {2, Pipe::VEC, 1},                 /* CRYPTO */ \
+    {9, Pipe::LOADSTORE, 4},           /* SVE_GATHER */ \
+  }}
+
+  constexpr std::array<ModelInfo, static_cast<size_t>(Model::MAX)> Models = {{
+    {
+      .Name = "Neoverse-N1",
+      .Width = 4,
+      //           INT MUL BRANCH LS VEC VEC_DIV
+      .PipeCount = {3,  1,  1,     2, 2,  1},
+      .Costs = COSTS(2, 4, 5, 7, 13, 10, 17),
+    },
+    {
+      .Name = "Neoverse-V1",
+      .Width = 8,
+      .PipeCount = {4,  2,  2,     3, 4,  1},
+      .Costs = COSTS(1, 3, 6, 5, 10, 9, 16),
+    },
+    {
+      .Name = "Cortex-A78",
+      .Width = 6,
+      .PipeCount = {4,  1,  2,     2, 2,  1},
+      .Costs = COSTS(2, 4, 5, 7, 13, 9, 16),
+    },
+  }};
+#undef COSTS
+
+  std::string_view GetName(Model Model) {
+    return Models[static_cast<size_t>(Model)].Name;
+  }
+
+  std::optional<Model> GetModel(std::string_view Name) {
+    for (size_t i = 0; i < Models.size(); ++i) {
+      if (std::equal(Name.begin(), Name.end(), Models[i].Name.begin(), Models[i].Name.end(),
+                     [](char a, char b) { return std::tolower(a) == std::tolower(b); })) {
+        return static_cast<Model>(i);
+      }
+    }
+    return std::nullopt;
+  }
+
+namespace {
+  // Mnemonics whose class doesn't depend on the operands, others are decided by register types
+  const fextl::unordered_map<std::string_view, InstClass> MnemonicClasses = {
+    {"mul", InstClass::MUL}, {"madd", InstClass::MUL}, {"msub", InstClass::MUL}, {"mneg", InstClass::MUL},
+    {"smull", InstClass::MUL}, {"umull", InstClass::MUL}, {"smaddl", InstClass::MUL}, {"umaddl", InstClass::MUL},
+    {"smsubl", InstClass::MUL}, {"umsubl", InstClass::MUL}, {"smnegl", InstClass::MUL}, {"umnegl", InstClass::MUL},
+    {"smulh", InstClass::MULH}, {"umulh", InstClass::MULH},
+
+    {"b", InstClass::BRANCH}, {"bl", InstClass::BRANCH}, {"br", InstClass::BRANCH}, {"blr", InstClass::BRANCH},
+    {"ret", InstClass::BRANCH}, {"cbz", InstClass::BRANCH}, {"cbnz", InstClass::BRANCH},
+    {"tbz", InstClass::BRANCH}, {"tbnz", InstClass::BRANCH},
+
+    {"ldp", InstClass::LOAD_PAIR}, {"ldpsw", InstClass::LOAD_PAIR}, {"ldnp", InstClass::LOAD_PAIR},
+    {"ldxp", InstClass::LOAD_PAIR}, {"ldaxp", InstClass::LOAD_PAIR},
+
+    {"dmb", InstClass::BARRIER}, {"dsb", InstClass::BARRIER}, {"isb", InstClass::BARRIER},
+
+    {"mla", InstClass::VEC_MUL}, {"mls", InstClass::VEC_MUL}, {"sqdmulh", InstClass::VEC_MUL},
+    {"sqrdmulh", InstClass::VEC_MUL}, {"umull2", InstClass::VEC_MUL}, {"smull2", InstClass::VEC_MUL},
+    {"umlal", InstClass::VEC_MUL}, {"umlal2", InstClass::VEC_MUL}, {"smlal", InstClass::VEC_MUL},
+    {"smlal2", InstClass::VEC_MUL}, {"pmul", InstClass::VEC_MUL}, {"sdot", InstClass::VEC_MUL},
+    {"udot", InstClass::VEC_MUL},
+
+    {"addv", InstClass::VEC_REDUCE}, {"uaddv", InstClass::VEC_REDUCE}, {"saddv", InstClass::VEC_REDUCE},
+    {"uaddlv", InstClass::VEC_REDUCE}, {"saddlv", InstClass::VEC_REDUCE}, {"umaxv", InstClass::VEC_REDUCE},
+    {"uminv", InstClass::VEC_REDUCE}, {"smaxv", InstClass::VEC_REDUCE}, {"sminv", InstClass::VEC_REDUCE},
+    {"fmaxv", InstClass::VEC_REDUCE}, {"fminv", InstClass::VEC_REDUCE}, {"fmaxnmv", InstClass::VEC_REDUCE},
+    {"fminnmv", InstClass::VEC_REDUCE}, {"orv", InstClass::VEC_REDUCE}, {"eorv", InstClass::VEC_REDUCE},
+    {"andv", InstClass::VEC_REDUCE},
+
+    {"tbl", InstClass::VEC_PERMUTE}, {"tbx", InstClass::VEC_PERMUTE}, {"zip1", InstClass::VEC_PERMUTE},
+    {"zip2", InstClass::VEC_PERMUTE}, {"uzp1", InstClass::VEC_PERMUTE}, {"uzp2", InstClass::VEC_PERMUTE},
+    {"trn1", InstClass::VEC_PERMUTE}, {"trn2", InstClass::VEC_PERMUTE}, {"ext", InstClass::VEC_PERMUTE},
+    {"rev64", InstClass::VEC_PERMUTE}, {"splice", InstClass::VEC_PERMUTE}, {"compact", InstClass::VEC_PERMUTE},
+    {"sunpklo", InstClass::VEC_PERMUTE}, {"sunpkhi", InstClass::VEC_PERMUTE}, {"uunpklo", InstClass::VEC_PERMUTE},
+    {"uunpkhi", InstClass::VEC_PERMUTE},
+
+    {"shl", InstClass::VEC_SHIFT}, {"ushr", InstClass::VEC_SHIFT}, {"sshr", InstClass::VEC_SHIFT},
+    {"ushl", InstClass::VEC_SHIFT}, {"sshl", InstClass::VEC_SHIFT}, {"urshr", InstClass::VEC_SHIFT},
+    {"srshr", InstClass::VEC_SHIFT}, {"ushll", InstClass::VEC_SHIFT}, {"ushll2", InstClass::VEC_SHIFT},
+    {"sshll", InstClass::VEC_SHIFT}, {"sshll2", InstClass::VEC_SHIFT}, {"shrn", InstClass::VEC_SHIFT},
+    {"shrn2", InstClass::VEC_SHIFT}, {"rshrn", InstClass::VEC_SHIFT}, {"rshrn2", InstClass::VEC_SHIFT},
+    {"sqshrn", InstClass::VEC_SHIFT}, {"sqshrn2", InstClass::VEC_SHIFT}, {"uqshrn", InstClass::VEC_SHIFT},
+    {"uqshrn2", InstClass::VEC_SHIFT}, {"sqshrun", InstClass::VEC_SHIFT}, {"sqshrun2", InstClass::VEC_SHIFT},
+    {"sqxtn", InstClass::VEC_SHIFT}, {"sqxtn2", InstClass::VEC_SHIFT}, {"uqxtn", InstClass::VEC_SHIFT},
+    {"uqxtn2", InstClass::VEC_SHIFT}, {"sqxtun", InstClass::VEC_SHIFT}, {"sqxtun2", InstClass::VEC_SHIFT},
+    {"xtn", InstClass::VEC_SHIFT}, {"xtn2", InstClass::VEC_SHIFT}, {"sli", InstClass::VEC_SHIFT},
+    {"sri", InstClass::VEC_SHIFT}, {"usra", InstClass::VEC_SHIFT}, {"ssra", InstClass::VEC_SHIFT},
+    {"sqshl", InstClass::VEC_SHIFT}, {"uqshl", InstClass::VEC_SHIFT}, {"shll", InstClass::VEC_SHIFT},
+    {"shll2", InstClass::VEC_SHIFT},
+
+    {"umov", InstClass::VEC_TO_GPR}, {"smov", InstClass::VEC_TO_GPR},
+
+    {"fadd", InstClass::FP_ADD}, {"fsub", InstClass::FP_ADD}, {"fabd", InstClass::FP_ADD},
+    {"fabs", InstClass::FP_ADD}, {"fneg", InstClass::FP_ADD}, {"fmax", InstClass::FP_ADD},
+    {"fmin", InstClass::FP_ADD}, {"fmaxnm", InstClass::FP_ADD}, {"fminnm", InstClass::FP_ADD},
+    {"faddp", InstClass::FP_ADD}, {"fmaxp", InstClass::FP_ADD}, {"fminp", InstClass::FP_ADD},
+    {"fmaxnmp", InstClass::FP_ADD}, {"fminnmp", InstClass::FP_ADD},
+
+    {"fmul", InstClass::FP_MUL}, {"fmulx", InstClass::FP_MUL}, {"fnmul", InstClass::FP_MUL},
+    {"frecpe", InstClass::FP_MUL}, {"frsqrte", InstClass::FP_MUL}, {"frecps", InstClass::FP_FMA},
+    {"frsqrts", InstClass::FP_FMA}, {"frecpx", InstClass::FP_MUL},
+
+    {"fmla", InstClass::FP_FMA}, {"fmls", InstClass::FP_FMA}, {"fmadd", InstClass::FP_FMA},
+    {"fmsub", InstClass::FP_FMA}, {"fnmadd", InstClass::FP_FMA}, {"fnmsub", InstClass::FP_FMA},
+
+    {"fcvt", InstClass::FP_CVT}, {"fcvtn", InstClass::FP_CVT}, {"fcvtn2", InstClass::FP_CVT},
+    {"fcvtl", InstClass::FP_CVT}, {"fcvtl2", InstClass::FP_CVT}, {"fcvtxn", InstClass::FP_CVT},
+    {"fcvtxn2", InstClass::FP_CVT}, {"scvtf", InstClass::FP_CVT}, {"ucvtf", InstClass::FP_CVT},
+    {"fcvtzs", InstClass::FP_CVT}, {"fcvtzu", InstClass::FP_CVT}, {"fcvtas", InstClass::FP_CVT},
+    {"fcvtau", InstClass::FP_CVT}, {"fcvtms", InstClass::FP_CVT}, {"fcvtmu", InstClass::FP_CVT},
+    {"fcvtns", InstClass::FP_CVT}, {"fcvtnu", InstClass::FP_CVT}, {"fcvtps", InstClass::FP_CVT},
+    {"fcvtpu", InstClass::FP_CVT}, {"frinta", InstClass::FP_CVT}, {"frinti", InstClass::FP_CVT},
+    {"frintm", InstClass::FP_CVT}, {"frintn", InstClass::FP_CVT}, {"frintp", InstClass::FP_CVT},
+    {"frintx", InstClass::FP_CVT}, {"frintz", InstClass::FP_CVT},
+
+    {"fcmp", InstClass::FP_CMP}, {"fcmpe", InstClass::FP_CMP}, {"fccmp", InstClass::FP_CMP},
+    {"fccmpe", InstClass::FP_CMP}, {"fcsel", InstClass::FP_CMP}, {"fcmeq", InstClass::FP_CMP},
+    {"fcmge", InstClass::FP_CMP}, {"fcmgt", InstClass::FP_CMP}, {"fcmle", InstClass::FP_CMP},
+    {"fcmlt", InstClass::FP_CMP}, {"facge", InstClass::FP_CMP}, {"facgt", InstClass::FP_CMP},
+
+    {"aese", InstClass::CRYPTO}, {"aesd", InstClass::CRYPTO}, {"aesmc", InstClass::CRYPTO},
+    {"aesimc", InstClass::CRYPTO}, {"pmull", InstClass::CRYPTO}, {"pmull2", InstClass::CRYPTO},
+    {"eor3", InstClass::CRYPTO}, {"bcax", InstClass::CRYPTO}, {"rax1", InstClass::CRYPTO},
+    {"xar", InstClass::CRYPTO},
+  };
+
+  // Only write NZCV
+  const fextl::unordered_map<std::string_view, bool> FlagOnlyWriters = {
+    {"cmp", true}, {"cmn", true}, {"tst", true}, {"ccmp", true}, {"ccmn", true}, {"fcmp", true},
+    {"fcmpe", true}, {"fccmp", true}, {"fccmpe", true}, {"ptest", true}, {"cfinv", true}, {"rmif", true},
+    {"setf8", true}, {"setf16", true},
+  };
+
+  // Write NZCV as well as their destination
+  const fextl::unordered_map<std::string_view, bool> FlagWriters = {
+    {"adds", true}, {"subs", true}, {"ands", true}, {"bics", true}, {"adcs", true}, {"sbcs", true},
+    {"negs", true}, {"ngcs", true},
+  };
+
+  const fextl::unordered_map<std::string_view, bool> FlagReaders = {
+    {"csel", true}, {"csinc", true}, {"csinv", true}, {"csneg", true}, {"cset", true}, {"csetm", true},
+    {"cinc", true}, {"cinv", true}, {"cneg", true}, {"ccmp", true}, {"ccmn", true}, {"adc", true},
+    {"adcs", true}, {"sbc", true}, {"sbcs", true}, {"ngc", true}, {"ngcs", true}, {"fcsel", true},
+    {"fccmp", true}, {"fccmpe", true}, {"cfinv", true},
+  };
+
+  // Merge in to their destination, so it is also a source
+  const fextl::unordered_map<std::string_view, bool> DestinationReaders = {
+    {"movk", true}, {"bfi", true}, {"bfxil", true}, {"bfc", true}, {"fmla", true}, {"fmls", true},
+    {"mla", true}, {"mls", true}, {"bsl", true}, {"bif", true}, {"bit", true}, {"tbx", true},
+    {"sli", true}, {"sri", true}, {"usra", true}, {"ssra", true}, {"shrn2", true}, {"rshrn2", true},
+    {"xtn2", true}, {"sqxtn2", true}, {"uqxtn2", true}, {"sqxtun2", true}, {"sqshrn2", true},
+    {"uqshrn2", true}, {"fcvtn2", true}, {"fcvtxn2", true}, {"umlal", true}, {"umlal2", true},
+    {"smlal", true}, {"smlal2", true}, {"sdot", true}, {"udot", true}, {"sel", true},
+  };
+
+  bool StartsWith(std::string_view String, std::string_view Prefix) {
+    return String.substr(0, Prefix.size()) == Prefix;
+  }
+
+  enum class RegType {
+    NONE,
+    GPR,
+    VECTOR,
+    PREDICATE,
+  };
+
+  struct Operand {
+    fextl::string Text;
+    fextl::vector<fextl::string> Registers;
+    RegType Type;
+    bool Memory;
+    bool ElementIndexed;
+  };
+
+  // Turns a register name in to a key that is the same for every view of the register, w1 and x1 or s1 and v1
+  std::optional<std::pair<fextl::string, RegType>> ParseRegister(std::string_view Token) {
+    if (Token == "sp" || Token == "wsp") {
+      return std::make_pair("sp", RegType::GPR);
+    }
+
+    if (Token.size() < 2 || !std::isdigit(Token[1])) {
+      return std::nullopt;
+    }
+
+    for (size_t i = 1; i < Token.size(); ++i) {
+      if (!std::isdigit(Token[i])) {
+        return std::nullopt;
+      }
+    }
+
+    const auto Number = Token.substr(1);
+    switch (Token[0]) {
+      case 'x':
+      case 'w':
+        return std::make_pair(fextl::fmt::format("r{}", Number), RegType::GPR);
+      case 'v':
+      case 'q':
+      case 'd':
+      case 's':
+      case 'h':
+      case 'b':
+      case 'z':
+        return std::make_pair(fextl::fmt::format("v{}", Number), RegType::VECTOR);
+      case 'p':
+        return std::make_pair(fextl::fmt::format("p{}", Number), RegType::PREDICATE);
+      default:
+        return std::nullopt;
+    }
+  }
+
+  Operand ParseOperand(std::string_view Text) {
+    Operand Result {
+      .Text = fextl::string(Text),
+      .Type = RegType::NONE,
+      .Memory = !Text.empty() && Text.front() == '[',
+      .ElementIndexed = false,
+    };
+
+    size_t Begin = 0;
+    for (size_t i = 0; i <= Text.size(); ++i) {
+      const bool Separator = i == Text.size() || !std::isalnum(static_cast<unsigned char>(Text[i]));
+      if (!Separator) {
+        continue;
+      }
+
+      if (i > Begin) {
+        if (auto Reg = ParseRegister(Text.substr(Begin, i - Begin))) {
+          Result.Registers.emplace_back(std::move(Reg->first));
+          if (Result.Type == RegType::NONE) {
+            Result.Type = Reg->second;
+          }
+        }
+      }
+
+      if (i < Text.size() && Text[i] == '[' && !Result.Memory) {
+        Result.ElementIndexed = true;
+      }
+      Begin = i + 1;
+    }
+
+    return Result;
+  }
+
+  // Splits operands on commas outside of memory operands and register lists
+  fextl::vector<Operand> ParseOperands(std::string_view Text) {
+    fextl::vector<Operand> Result;
+    int Depth = 0;
+    size_t Begin = 0;
+    for (size_t i = 0; i <= Text.size(); ++i) {
+      if (i < Text.size()) {
+        if (Text[i] == '[' || Text[i] == '{') {
+          ++Depth;
+        }
+        else if (Text[i] == ']' || Text[i] == '}') {
+          --Depth;
+        }
+        if (Text[i] != ',' || Depth != 0) {
+          continue;
+        }
+      }
+
+      auto Part = Text.substr(Begin, i - Begin);
+      while (!Part.empty() && Part.front() == ' ') {
+        Part.remove_prefix(1);
+      }
+      while (!Part.empty() && Part.back() == ' ') {
+        Part.remove_suffix(1);
+      }
+      if (!Part.empty()) {
+        Result.emplace_back(ParseOperand(Part));
+      }
+      Begin = i + 1;
+    }
+    return Result;
+  }
+
+  bool IsAtomic(std::string_view Mnemonic) {
+    constexpr std::array<std::string_view, 10> Prefixes = {
+      "cas", "ldadd", "ldclr", "ldeor", "ldset", "ldsmax", "ldsmin", "ldumax", "ldumin", "swp",
+    };
+    return std::any_of(Prefixes.begin(), Prefixes.end(), [Mnemonic](std::string_view Prefix) {
+      return StartsWith(Mnemonic, Prefix);
+    });
+  }
+
+  bool IsExclusiveStore(std::string_view Mnemonic) {
+    return Mnemonic == "stxr" || Mnemonic == "stlxr" || Mnemonic == "stxrb" || Mnemonic == "stlxrb" ||
+           Mnemonic == "stxrh" || Mnemonic == "stlxrh" || Mnemonic == "stxp" || Mnemonic == "stlxp";
+  }
+
+  bool Is64BitElement(Operand const &Op) {
+    return Op.Text.front() == 'd' || Op.Text.find(".2d") != fextl::string::npos ||
+           Op.Text.find(".d") != fextl::string::npos;
+  }
+
+  struct Instruction {
+    InstClass Class;
+    fextl::vector<fextl::string> Sources;
+    fextl::vector<fextl::string> Destinations;
+  };
+
+  std::optional<Instruction> DecodeInstruction(std::string_view Line) {
+    // Drop the trailing address annotation of PC relative instructions
+    if (auto Annotation = Line.find(" ("); Annotation != Line.npos) {
+      Line = Line.substr(0, Annotation);
+    }
+
+    while (!Line.empty() && std::isspace(static_cast<unsigned char>(Line.front()))) {
+      Line.remove_prefix(1);
+    }
+
+    const auto MnemonicEnd = Line.find(' ');
+    const auto Mnemonic = Line.substr(0, MnemonicEnd);
+    if (Mnemonic.empty() || Mnemonic == "nop" || Mnemonic == "unallocated" || Mnemonic == "udf") {
+      return std::nullopt;
+    }
+
+    const auto Operands = ParseOperands(MnemonicEnd == Line.npos ? std::string_view{} : Line.substr(MnemonicEnd + 1));
+
+    bool AnyVector{};
+    bool AnyGPRSource{};
+    for (size_t i = 0; i < Operands.size(); ++i) {
+      const auto &Op = Operands[i];
+      if (Op.Memory) {
+        // Gather indices are vectors, but the access is still a memory one
+        continue;
+      }
+      AnyVector |= Op.Type == RegType::VECTOR || Op.Type == RegType::PREDICATE;
+      AnyGPRSource |= i != 0 && Op.Type == RegType::GPR;
+    }
+    const bool VectorDest = !Operands.empty() && Operands[0].Type == RegType::VECTOR;
+    const bool GPRDest = !Operands.empty() && Operands[0].Type == RegType::GPR;
+
+    Instruction Result {};
+    const bool MemoryAccess = std::any_of(Operands.begin(), Operands.end(), [](Operand const &Op) { return Op.Memory; });
+    const bool Store = MemoryAccess && StartsWith(Mnemonic, "st");
+    const bool Load = MemoryAccess && StartsWith(Mnemonic, "ld");
+
+    if (auto it = MnemonicClasses.find(Mnemonic); it != MnemonicClasses.end()) {
+      Result.Class = it->second;
+
+      // Scalar forms of the vector multiplies and vector forms of the scalar ones
+      if (Result.Class == InstClass::MUL && AnyVector) {
+        Result.Class = InstClass::VEC_MUL;
+      }
+    }
+    else if (StartsWith(Mnemonic, "b.")) {
+      Result.Class = InstClass::BRANCH;
+    }
+    else if (StartsWith(Mnemonic, "crc32")) {
+      Result.Class = InstClass::CRC;
+    }
+    else if (Mnemonic == "udiv" || Mnemonic == "sdiv") {
+      Result.Class = !Operands.empty() && Operands[0].Text.front() == 'x' ? InstClass::DIV64 : InstClass::DIV32;
+    }
+    else if (Mnemonic == "fdiv") {
+      Result.Class = !Operands.empty() && Is64BitElement(Operands[0]) ? InstClass::FP_DIV64 : InstClass::FP_DIV32;
+    }
+    else if (Mnemonic == "fsqrt") {
+      Result.Class = !Operands.empty() && Is64BitElement(Operands[0]) ? InstClass::FP_SQRT64 : InstClass::FP_SQRT32;
+    }
+    else if (MemoryAccess && IsAtomic(Mnemonic)) {
+      Result.Class = InstClass::ATOMIC;
+    }
+    else if (Load) {
+      const bool IndexedByVector = std::any_of(Operands.begin(), Operands.end(), [](Operand const &Op) {
+        return Op.Memory && Op.Text.find('z') != fextl::string::npos;
+      });
+      Result.Class = IndexedByVector ? InstClass::SVE_GATHER :
+                     VectorDest ? InstClass::LOAD_VEC : InstClass::LOAD;
+    }
+    else if (Store) {
+      Result.Class = AnyVector ? InstClass::STORE_VEC : InstClass::STORE;
+    }
+    else if (AnyVector) {
+      if (GPRDest) {
+        Result.Class = InstClass::VEC_TO_GPR;
+      }
+      else if (VectorDest && AnyGPRSource) {
+        Result.Class = InstClass::VEC_FROM_GPR;
+      }
+      else if (VectorDest && Operands[0].ElementIndexed && Operands.size() > 1 && Operands[1].ElementIndexed) {
+        // ins/mov between elements
+        Result.Class = InstClass::VEC_PERMUTE;
+      }
+      else {
+        Result.Class = InstClass::VEC_ALU;
+      }
+    }
+    else {
+      // Register forms with a shifted or extended last operand take the longer path on some cores
+      const bool Shifted = Operands.size() >= 3 && Operands.back().Type == RegType::NONE &&
+                           Operands[Operands.size() - 2].Type == RegType::GPR &&
+                           (StartsWith(Operands.back().Text, "lsl") || StartsWith(Operands.back().Text, "lsr") ||
+                            StartsWith(Operands.back().Text, "asr") || StartsWith(Operands.back().Text, "ror") ||
+                            StartsWith(Operands.back().Text, "sxt") || StartsWith(Operands.back().Text, "uxt"));
+      Result.Class = Shifted ? InstClass::ALU_SHIFTED : InstClass::ALU;
+    }
+
+    // Work out which operands are written
+    size_t NumDestinations = 1;
+    if (Result.Class == InstClass::BRANCH || Result.Class == InstClass::BARRIER ||
+        FlagOnlyWriters.contains(Mnemonic) ||
+        (Store && !IsExclusiveStore(Mnemonic))) {
+      NumDestinations = 0;
+    }
+    else if (Result.Class == InstClass::LOAD_PAIR) {
+      NumDestinations = 2;
+    }
+    else if (Mnemonic == "msr") {
+      NumDestinations = 0;
+      Result.Destinations.emplace_back("nzcv");
+    }
+
+    size_t FirstDestination = 0;
+    if (Result.Class == InstClass::ATOMIC && !StartsWith(Mnemonic, "cas")) {
+      // ldadd/swp Rs, Rt, [Xn], the result goes to Rt
+      FirstDestination = 1;
+    }
+
+    for (size_t i = 0; i < Operands.size(); ++i) {
+      const auto &Op = Operands[i];
+      const bool Destination = !Op.Memory && i >= FirstDestination && i < FirstDestination + NumDestinations;
+      const bool AlsoSource = Destination &&
+        (DestinationReaders.contains(Mnemonic) || Op.ElementIndexed || Result.Class == InstClass::ATOMIC);
+
+      for (const auto &Reg : Op.Registers) {
+        if (Destination) {
+          Result.Destinations.emplace_back(Reg);
+        }
+        if (!Destination || AlsoSource) {
+          Result.Sources.emplace_back(Reg);
+        }
+      }
+    }
+
+    if (FlagOnlyWriters.contains(Mnemonic) || FlagWriters.contains(Mnemonic)) {
+      Result.Destinations.emplace_back("nzcv");
+    }
+    if (FlagReaders.contains(Mnemonic) || (StartsWith(Mnemonic, "b.") && Mnemonic != "b.al") ||
+        (Mnemonic == "mrs" && Line.find("nzcv") != Line.npos)) {
+      Result.Sources.emplace_back("nzcv");
+    }
+
+    return Result;
+  }
+}
+
+  Estimate EstimateCode(Model Model, fextl::vector<fextl::string> const &Lines) {
+    const auto &Info = Models[static_cast<size_t>(Model)];
+
+    fextl::map<fextl::string, double> Ready;
+    std::array<double, static_cast<size_t>(Pipe::MAX)> PipeBusy{};
+    double Latency{};
+    size_t NumInstructions{};
+
+    for (const auto &Line : Lines) {
+      auto Inst = DecodeInstruction(Line);
+      if (!Inst) {
+        continue;
+      }
+
+      ++NumInstructions;
+      const auto &Cost = Info.Costs[static_cast<size_t>(Inst->Class)];
+      PipeBusy[static_cast<size_t>(Cost.Unit)] += Cost.Occupancy;
+
+      double Start{};
+      for (const auto &Source : Inst->Sources) {
+        if (auto it = Ready.find(Source); it != Ready.end()) {
+          Start = std::max(Start, it->second);
+        }
+      }
+
+      const double End = Start + Cost.Latency;
+      for (const auto &Destination : Inst->Destinations) {
+        Ready[Destination] = End;
+      }
+      Latency = std::max(Latency, End);
+    }
+
+    double Throughput = static_cast<double>(NumInstructions) / Info.Width;
+    for (size_t i = 0; i < PipeBusy.size(); ++i) {
+      Throughput = std::max(Throughput, PipeBusy[i] / Info.PipeCount[i]);
+    }
+
+    return Estimate {
+      .Latency = Latency,
+      .Throughput = Throughput,
+    };
+  }
+}
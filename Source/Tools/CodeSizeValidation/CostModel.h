@@ -0,0 +1,36 @@
+#pragma once
+#include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace CodeSize::CostModel {
+  enum class Model : uint64_t {
+    NEOVERSE_N1,
+    NEOVERSE_V1,
+    CORTEX_A78,
+    MAX,
+  };
+
+  struct Estimate {
+    // Cycles from the first instruction issuing until every result is ready, following register and flag dependencies
+    double Latency;
+    // Cycles per iteration if the sequence ran back to back, limited by the busiest pipe or the front end
+    double Throughput;
+  };
+
+  std::string_view GetName(Model Model);
+  std::optional<Model> GetModel(std::string_view Name);
+
+  /**
+   * @brief Statically estimates the cost of disassembled AArch64 code
+   *
+   * Instructions are grouped in to classes with per microarchitecture latencies and pipes, approximated from the
+   * public Software Optimization Guides. Memory is always assumed to hit L1 and no branches are taken.
+   *
+   * @param Lines - One instruction per line, as printed by the vixl disassembler
+   */
+  Estimate EstimateCode(Model Model, fextl::vector<fextl::string> const &Lines);
+}
@@ -1,3 +1,4 @@
+#include "CostModel.h"
 #include "DummyHandlers.h"
 #include "FEXCore/Core/Context.h"
 #include "FEXCore/Debug/InternalThreadState.h"
@@ -7,6 +8,8 @@
 #include <FEXCore/Utils/FileLoading.h>
 #include <FEXCore/Utils/LogManager.h>
 
+#include <cmath>
+
 namespace CodeSize {
   class CodeSizeValidation final {
     public:
@@ -31,7 +34,7 @@ namespace CodeSize {
         return SetupInfoDisabled;
       }
 
-      void CalculateBaseStats(FEXCore::Context::Context *CTX, FEXCore::Core::InternalThreadState *Thread);
+      void CalculateBaseStats(FEXCore::Context::Context *CTX, FEXCore::Core::InternalThreadState *Thread, uint64_t MaxInst);
     private:
       void ClearStats() {
         RIPToStats.clear();
@@ -154,30 +157,30 @@ namespace CodeSize {
     SetBaseStats(Nop->first);
   }
 
-  void CodeSizeValidation::CalculateBaseStats(FEXCore::Context::Context *CTX, FEXCore::Core::InternalThreadState *Thread) {
+  void CodeSizeValidation::CalculateBaseStats(FEXCore::Context::Context *CTX, FEXCore::Core::InternalThreadState *Thread, uint64_t MaxInst) {
     SetupInfoDisabled = true;
 
     // Known hardcoded instructions that will generate blocks of particular sizes.
     // NOP will never generate any instructions.
-    constexpr static uint8_t NOP[] = {
-      0x90,
-    };
+    // Blocks are MaxInst instructions long, so both are padded out with NOPs the same way the tests are.
+    fextl::vector<uint8_t> NOP(MaxInst, 0x90);
 
     // MFENCE will always generate a block with one instruction.
-    constexpr static uint8_t MFENCE[] = {
+    fextl::vector<uint8_t> MFENCE {
       0x0f, 0xae, 0xf0,
     };
+    MFENCE.resize(MFENCE.size() + MaxInst - 1, 0x90);
 
     // Compile the NOP.
-    CTX->CompileRIP(Thread, (uint64_t)NOP);
+    CTX->CompileRIP(Thread, (uint64_t)NOP.data());
     // Gather the stats for the NOP.
-    auto NOPStats = GetDataForRIP((uint64_t)NOP);
+    auto NOPStats = GetDataForRIP((uint64_t)NOP.data());
 
     // Compile MFence
-    CTX->CompileRIP(Thread, (uint64_t)MFENCE);
+    CTX->CompileRIP(Thread, (uint64_t)MFENCE.data());
 
     // Get MFence stats.
-    auto MFENCEStats = GetDataForRIP((uint64_t)MFENCE);
+    auto MFENCEStats = GetDataForRIP((uint64_t)MFENCE.data());
 
     // Now scan the difference in disasembly between NOP and MFENCE to remove the header and tail.
     // Just searching for first instruction change.
@@ -187,8 +190,8 @@ namespace CodeSize {
     ClearStats();
 
     // Invalidate the code ranges to be safe.
-    CTX->InvalidateGuestCodeRange(Thread, (uint64_t)NOP, sizeof(NOP));
-    CTX->InvalidateGuestCodeRange(Thread, (uint64_t)MFENCE, sizeof(MFENCE));
+    CTX->InvalidateGuestCodeRange(Thread, (uint64_t)NOP.data(), NOP.size());
+    CTX->InvalidateGuestCodeRange(Thread, (uint64_t)MFENCE.data(), MFENCE.size());
     SetupInfoDisabled = false;
   }
 
@@ -239,6 +242,9 @@ struct TestInfo {
   char TestInst[128];
   uint64_t Optimal;
   int64_t ExpectedInstructionCount;
+  // Negative if the test doesn't have an estimate recorded yet
+  double ExpectedLatency;
+  double ExpectedThroughput;
   uint64_t CodeSize;
   uint32_t Cookie;
   uint8_t Code[];
@@ -249,12 +255,25 @@ struct TestHeader {
   uint64_t NumTests{};
   uint64_t EnabledHostFeatures;
   uint64_t DisabledHostFeatures;
+  // CodeSize::CostModel::Model that the expected latency and throughput are checked against
+  uint64_t CostModel;
+  // Instructions in the longest test, shorter tests are padded with NOPs
+  uint64_t MaxInst;
   TestInfo Tests[];
 };
 
 static fextl::vector<char> TestData;
 static TestHeader const *TestHeaderData{};
 
+// Estimates are stored with two decimals, so anything smaller is noise
+static double RoundEstimate(double Value) {
+  return std::round(Value * 100.0) / 100.0;
+}
+
+static bool EstimateMatches(double Expected, double Actual) {
+  return Expected >= 0.0 && std::abs(Expected - RoundEstimate(Actual)) < 0.005;
+}
+
 static bool TestInstructions(FEXCore::Context::Context *CTX, FEXCore::Core::InternalThreadState *Thread, const char *UpdatedInstructionCountsPath) {
   LogMan::Msg::IFmt("Compiling code");
 
@@ -271,6 +290,8 @@ static bool TestInstructions(FEXCore::Context::Context *CTX, FEXCore::Core::Inte
 
   bool TestsPassed {true};
   bool InstructionCountChanged {};
+  const auto CostModel = static_cast<CodeSize::CostModel::Model>(TestHeaderData->CostModel);
+  fextl::unordered_map<uint64_t, CodeSize::CostModel::Estimate> Estimates;
 
   // Get all the data for the instructions compiled.
   CurrentTest = &TestHeaderData->Tests[0];
@@ -281,6 +302,16 @@ static bool TestInstructions(FEXCore::Context::Context *CTX, FEXCore::Core::Inte
 
     LogMan::Msg::IFmt("Testing instruction '{}': {} host instructions", CurrentTest->TestInst, INSTStats->first.HostCodeInstructions);
 
+    for (uint64_t Model = 0; Model < static_cast<uint64_t>(CodeSize::CostModel::Model::MAX); ++Model) {
+      const auto ModelEstimate = CodeSize::CostModel::EstimateCode(static_cast<CodeSize::CostModel::Model>(Model), INSTStats->second);
+      LogMan::Msg::IFmt("\t{}: {:.2f} cycles latency, {:.2f} cycles throughput",
+        CodeSize::CostModel::GetName(static_cast<CodeSize::CostModel::Model>(Model)), ModelEstimate.Latency, ModelEstimate.Throughput);
+    }
+
+    const auto &Estimate = Estimates[CodeRIP] = CodeSize::CostModel::EstimateCode(CostModel, INSTStats->second);
+    const bool EstimateChanged = !EstimateMatches(CurrentTest->ExpectedLatency, Estimate.Latency) ||
+      !EstimateMatches(CurrentTest->ExpectedThroughput, Estimate.Throughput);
+
     // Show the code if we know the implementation isn't optimal or if the count of instructions changed to something we didn't expect.
     bool ShouldShowCode = CurrentTest->Optimal == 0 ||
       INSTStats->first.HostCodeInstructions != CurrentTest->ExpectedInstructionCount;
@@ -302,6 +333,25 @@ static bool TestInstructions(FEXCore::Context::Context *CTX, FEXCore::Core::Inte
       }
     }
 
+    if (EstimateChanged) {
+      InstructionCountChanged = true;
+
+      // Tests without a recorded estimate only get one written out.
+      const bool Regressed =
+        (CurrentTest->ExpectedLatency >= 0.0 && RoundEstimate(Estimate.Latency) > CurrentTest->ExpectedLatency + 0.005) ||
+        (CurrentTest->ExpectedThroughput >= 0.0 && RoundEstimate(Estimate.Throughput) > CurrentTest->ExpectedThroughput + 0.005);
+
+      if (Regressed) {
+        LogMan::Msg::EFmt("Fail: '{}': {} estimate went from {:.2f} to {:.2f} cycles latency and {:.2f} to {:.2f} cycles throughput",
+          CurrentTest->TestInst, CodeSize::CostModel::GetName(CostModel),
+          CurrentTest->ExpectedLatency, Estimate.Latency, CurrentTest->ExpectedThroughput, Estimate.Throughput);
+
+        if (CurrentTest->Optimal) {
+          TestsPassed = false;
+        }
+      }
+    }
+
     // Go to the next test.
     CurrentTest = reinterpret_cast<TestInfo const*>(&CurrentTest->Code[CurrentTest->CodeSize]);
   }
@@ -331,8 +381,13 @@ static bool TestInstructions(FEXCore::Context::Context *CTX, FEXCore::Core::Inte
       // Get the instruction stats.
       auto INSTStats = CodeSize::Validation.GetDataForRIP(CodeRIP);
 
-      if (INSTStats->first.HostCodeInstructions != CurrentTest->ExpectedInstructionCount) {
-        FD.Write(fextl::fmt::format("\t\"{}\": {},\n", CurrentTest->TestInst, INSTStats->first.HostCodeInstructions));
+      const auto &Estimate = Estimates[CodeRIP];
+
+      if (INSTStats->first.HostCodeInstructions != CurrentTest->ExpectedInstructionCount ||
+          !EstimateMatches(CurrentTest->ExpectedLatency, Estimate.Latency) ||
+          !EstimateMatches(CurrentTest->ExpectedThroughput, Estimate.Throughput)) {
+        FD.Write(fextl::fmt::format("\t\"{}\": {{\"ExpectedInstructionCount\": {}, \"ExpectedLatency\": {:.2f}, \"ExpectedThroughput\": {:.2f}}},\n",
+          CurrentTest->TestInst, INSTStats->first.HostCodeInstructions, RoundEstimate(Estimate.Latency), RoundEstimate(Estimate.Throughput)));
       }
 
       // Go to the next test.
@@ -375,8 +430,8 @@ int main(int argc, char **argv, char **const envp) {
   }
 
   // Setup configurations that this tool needs
-  // Maximum one instruction.
-  FEXCore::Config::EraseSet(FEXCore::Config::CONFIG_MAXINST, "1");
+  // Each test is compiled as exactly one block.
+  FEXCore::Config::EraseSet(FEXCore::Config::CONFIG_MAXINST, fextl::fmt::format("{}", TestHeaderData->MaxInst));
   // IRJIT. Only works on JITs.
   FEXCore::Config::EraseSet(FEXCore::Config::CONFIG_CORE, fextl::fmt::format("{}", static_cast<uint64_t>(FEXCore::Config::CONFIG_IRJIT)));
   // Enable block disassembly.
@@ -389,6 +444,8 @@ int main(int argc, char **argv, char **const envp) {
     FEATURE_SVE128 = (1U << 0),
     FEATURE_SVE256 = (1U << 1),
     FEATURE_CLZERO = (1U << 2),
+    FEATURE_AFP    = (1U << 3),
+    FEATURE_AVX    = (1U << 4),
   };
 
   uint64_t SVEWidth = 0;
@@ -404,6 +461,13 @@ int main(int argc, char **argv, char **const envp) {
   if (TestHeaderData->EnabledHostFeatures & FEATURE_CLZERO) {
     HostFeatureControl |= static_cast<uint64_t>(FEXCore::Config::HostFeatures::ENABLECLZERO);
   }
+  if (TestHeaderData->EnabledHostFeatures & FEATURE_AFP) {
+    HostFeatureControl |= static_cast<uint64_t>(FEXCore::Config::HostFeatures::ENABLEAFP);
+  }
+  if (TestHeaderData->EnabledHostFeatures & FEATURE_AVX) {
+    // AVX without SVE256 splits 256-bit ops in to 128-bit halves
+    HostFeatureControl |= static_cast<uint64_t>(FEXCore::Config::HostFeatures::ENABLEAVX);
+  }
 
   if (TestHeaderData->DisabledHostFeatures & FEATURE_SVE128) {
     HostFeatureControl |= static_cast<uint64_t>(FEXCore::Config::HostFeatures::DISABLESVE);
@@ -414,6 +478,12 @@ int main(int argc, char **argv, char **const envp) {
   if (TestHeaderData->DisabledHostFeatures & FEATURE_CLZERO) {
     HostFeatureControl |= static_cast<uint64_t>(FEXCore::Config::HostFeatures::DISABLECLZERO);
   }
+  if (TestHeaderData->DisabledHostFeatures & FEATURE_AFP) {
+    HostFeatureControl |= static_cast<uint64_t>(FEXCore::Config::HostFeatures::DISABLEAFP);
+  }
+  if (TestHeaderData->DisabledHostFeatures & FEATURE_AVX) {
+    HostFeatureControl |= static_cast<uint64_t>(FEXCore::Config::HostFeatures::DISABLEAVX);
+  }
   FEXCore::Config::EraseSet(FEXCore::Config::CONFIG_HOSTFEATURES, fextl::fmt::format("{}", HostFeatureControl));
   FEXCore::Config::EraseSet(FEXCore::Config::CONFIG_FORCESVEWIDTH, fextl::fmt::format("{}", SVEWidth));
 
@@ -432,7 +502,7 @@ int main(int argc, char **argv, char **const envp) {
   auto ParentThread = CTX->InitCore(0, 0);
 
   // Calculate the base stats for instruction testing.
-  CodeSize::Validation.CalculateBaseStats(CTX.get(), ParentThread);
+  CodeSize::Validation.CalculateBaseStats(CTX.get(), ParentThread, TestHeaderData->MaxInst);
 
   // Test all the instructions.
   return TestInstructions(CTX.get(), ParentThread, argc >= 2 ? argv[2] : nullptr) ? 0 : 1;
@@ -0,0 +1,322 @@
+/*
+$info$
+tags: Bin|CompileBench
+desc: Replays a recorded block corpus through the JIT to measure compile throughput
+$end_info$
+*/
+
+#include "DummyHandlers.h"
+#include <FEXCore/Config/Config.h>
+#include <FEXCore/Core/Context.h>
+#include <FEXCore/Debug/BlockCorpus.h>
+#include <FEXCore/Debug/InternalThreadState.h>
+#include <FEXCore/Utils/Allocator.h>
+#include <FEXCore/Utils/CPUInfo.h>
+#include <FEXCore/Utils/FileLoading.h>
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/fextl/fmt.h>
+#include <FEXCore/fextl/set.h>
+#include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/vector.h>
+#include <FEXHeaderUtils/Syscalls.h>
+#include <FEXHeaderUtils/TypeDefines.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <sys/mman.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+  struct Block {
+    uint64_t GuestRIP;
+    uint64_t CodeStart;
+    uint32_t CodeLength;
+    // Offset of the recorded code in to the corpus
+    size_t CodeOffset;
+  };
+
+  struct Corpus {
+    bool Is64BitMode;
+    fextl::vector<Block> Blocks;
+  };
+
+  void MsgHandler(LogMan::DebugLevels Level, char const *Message) {
+    const char *CharLevel{nullptr};
+
+    switch (Level) {
+    case LogMan::NONE:
+      CharLevel = "NONE";
+      break;
+    case LogMan::ASSERT:
+      CharLevel = "ASSERT";
+      break;
+    case LogMan::ERROR:
+      CharLevel = "ERROR";
+      break;
+    case LogMan::DEBUG:
+      CharLevel = "DEBUG";
+      break;
+    case LogMan::INFO:
+      CharLevel = "Info";
+      break;
+    default:
+      CharLevel = "???";
+      break;
+    }
+    fextl::fmt::print("[{}] {}\n", CharLevel, Message);
+  }
+
+  void AssertHandler(char const *Message) {
+    fextl::fmt::print("[ASSERT] {}\n", Message);
+
+    // make sure buffers are flushed
+    fflush(nullptr);
+  }
+
+  bool ParseCorpus(const fextl::vector<char> &Data, Corpus *Result) {
+    FEXCore::BlockCorpus::FileHeader Header;
+    if (Data.size() < sizeof(Header)) {
+      return false;
+    }
+
+    memcpy(&Header, Data.data(), sizeof(Header));
+    if (memcmp(Header.Magic, FEXCore::BlockCorpus::Magic, sizeof(Header.Magic)) != 0 ||
+        Header.Version != FEXCore::BlockCorpus::Version) {
+      return false;
+    }
+
+    Result->Is64BitMode = Header.Is64BitMode != 0;
+
+    size_t Offset = sizeof(Header);
+    while (Offset + sizeof(FEXCore::BlockCorpus::BlockHeader) <= Data.size()) {
+      FEXCore::BlockCorpus::BlockHeader BlockHeader;
+      memcpy(&BlockHeader, &Data[Offset], sizeof(BlockHeader));
+      Offset += sizeof(BlockHeader);
+
+      if (Offset + BlockHeader.CodeLength > Data.size()) {
+        // Truncated by a process that didn't exit cleanly
+        break;
+      }
+
+      Result->Blocks.emplace_back(Block {
+        .GuestRIP = BlockHeader.GuestRIP,
+        .CodeStart = BlockHeader.CodeStart,
+        .CodeLength = BlockHeader.CodeLength,
+        .CodeOffset = Offset,
+      });
+      Offset += BlockHeader.CodeLength;
+    }
+
+    return true;
+  }
+
+  /**
+   * @brief Places the recorded guest code back at its original addresses
+   *
+   * Blocks are applied in recording order, so code that was rewritten ends up with its newest bytes.
+   * Blocks that can't be mapped, or whose code was later overwritten by another block, are dropped.
+   *
+   * @return The blocks that can be compiled
+   */
+  fextl::vector<Block> MapCorpus(const fextl::vector<char> &Data, const fextl::vector<Block> &Blocks, fextl::set<uint64_t> *MappedPages) {
+    fextl::set<uint64_t> FailedPages;
+    fextl::vector<Block> Mappable;
+
+    for (const auto &Block : Blocks) {
+      const uint64_t FirstPage = Block.CodeStart & FHU::FEX_PAGE_MASK;
+      const uint64_t LastPage = (Block.CodeStart + Block.CodeLength - 1) & FHU::FEX_PAGE_MASK;
+
+      bool Mapped = true;
+      for (uint64_t Page = FirstPage; Page <= LastPage; Page += FHU::FEX_PAGE_SIZE) {
+        if (MappedPages->contains(Page)) {
+          continue;
+        }
+
+        if (!FailedPages.contains(Page)) {
+          auto Result = mmap(reinterpret_cast<void*>(Page), FHU::FEX_PAGE_SIZE, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+          if (Result == reinterpret_cast<void*>(Page)) {
+            MappedPages->emplace(Page);
+            continue;
+          }
+
+          if (Result != MAP_FAILED) {
+            // Kernels without MAP_FIXED_NOREPLACE treat the address as a hint
+            munmap(Result, FHU::FEX_PAGE_SIZE);
+          }
+          FailedPages.emplace(Page);
+        }
+        Mapped = false;
+      }
+
+      if (!Mapped) {
+        continue;
+      }
+
+      memcpy(reinterpret_cast<void*>(Block.CodeStart), &Data[Block.CodeOffset], Block.CodeLength);
+      Mappable.emplace_back(Block);
+    }
+
+    fextl::vector<Block> Result;
+    for (const auto &Block : Mappable) {
+      if (memcmp(reinterpret_cast<void*>(Block.CodeStart), &Data[Block.CodeOffset], Block.CodeLength) == 0) {
+        Result.emplace_back(Block);
+      }
+    }
+
+    return Result;
+  }
+
+  void InvalidateCorpus(FEXCore::Context::Context *CTX, const fextl::set<uint64_t> &MappedPages) {
+    // Invalidate runs of contiguous pages at once
+    uint64_t RunStart {}, RunEnd {};
+    for (auto Page : MappedPages) {
+      if (Page != RunEnd) {
+        if (RunEnd != RunStart) {
+          CTX->InvalidateGuestCodeRange(nullptr, RunStart, RunEnd - RunStart);
+        }
+        RunStart = Page;
+      }
+      RunEnd = Page + FHU::FEX_PAGE_SIZE;
+    }
+
+    if (RunEnd != RunStart) {
+      CTX->InvalidateGuestCodeRange(nullptr, RunStart, RunEnd - RunStart);
+    }
+  }
+
+  void PrintUsage(const char *Name) {
+    LogMan::Msg::EFmt("Usage: {} [-t <threads>] [-n <passes>] <corpus>", Name);
+    LogMan::Msg::EFmt("  -t <threads>: Compile threads, defaults to every CPU");
+    LogMan::Msg::EFmt("  -n <passes>: Times the whole corpus is compiled, defaults to 1");
+  }
+}
+
+int main(int argc, char **argv, char **const envp) {
+  FEXCore::Allocator::GLIBCScopedFault GLIBFaultScope;
+  LogMan::Throw::InstallHandler(AssertHandler);
+  LogMan::Msg::InstallHandler(MsgHandler);
+  FEXCore::Config::Initialize();
+  FEXCore::Config::Load();
+  FEXCore::Config::ReloadMetaLayer();
+
+  size_t NumThreads = FEXCore::CPUInfo::CalculateNumberOfCPUs();
+  size_t NumPasses = 1;
+  const char *CorpusPath {};
+
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+      NumThreads = std::max<size_t>(1, strtoul(argv[++i], nullptr, 0));
+    }
+    else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+      NumPasses = std::max<size_t>(1, strtoul(argv[++i], nullptr, 0));
+    }
+    else if (!CorpusPath) {
+      CorpusPath = argv[i];
+    }
+    else {
+      PrintUsage(argv[0]);
+      return 1;
+    }
+  }
+
+  if (!CorpusPath) {
+    PrintUsage(argv[0]);
+    return 1;
+  }
+
+  fextl::vector<char> CorpusData;
+  Corpus Corpus {};
+  if (!FEXCore::FileLoading::LoadFile(CorpusData, CorpusPath) || !ParseCorpus(CorpusData, &Corpus)) {
+    LogMan::Msg::EFmt("Couldn't load block corpus from {}", CorpusPath);
+    return 1;
+  }
+
+  fextl::set<uint64_t> MappedPages;
+  auto Blocks = MapCorpus(CorpusData, Corpus.Blocks, &MappedPages);
+  LogMan::Msg::IFmt("Loaded {} of {} recorded blocks, {} dropped as unmappable or stale",
+                    Blocks.size(), Corpus.Blocks.size(), Corpus.Blocks.size() - Blocks.size());
+  if (Blocks.empty()) {
+    return 1;
+  }
+
+  uint64_t GuestBytes {};
+  for (const auto &Block : Blocks) {
+    GuestBytes += Block.CodeLength;
+  }
+
+  // Setup configurations that this tool needs
+  // Decode in the mode the corpus was recorded in.
+  FEXCore::Config::EraseSet(FEXCore::Config::CONFIG_IS64BIT_MODE, Corpus.Is64BitMode ? "1" : "0");
+  // IRJIT. Only works on JITs.
+  FEXCore::Config::EraseSet(FEXCore::Config::CONFIG_CORE, fextl::fmt::format("{}", static_cast<uint64_t>(FEXCore::Config::CONFIG_IRJIT)));
+  // Per stage and per pass timings.
+  FEXCore::Config::EraseSet(FEXCore::Config::CONFIG_PROFILECOMPILATION, "1");
+  // Don't record the replay itself.
+  FEXCore::Config::Erase(FEXCore::Config::CONFIG_RECORDBLOCKCORPUS);
+  // Cached code objects would skip the compile being measured.
+  FEXCore::Config::EraseSet(FEXCore::Config::CONFIG_CACHEOBJECTCODECOMPILATION, fextl::fmt::format("{}", static_cast<uint64_t>(FEXCore::Config::ConfigObjectCodeHandler::CONFIG_NONE)));
+
+  FEXCore::Context::InitializeStaticTables(Corpus.Is64BitMode ? FEXCore::Context::MODE_64BIT : FEXCore::Context::MODE_32BIT);
+
+  auto CTX = FEXCore::Context::Context::CreateNewContext();
+  CTX->InitializeContext();
+  auto SignalDelegation = FEX::DummyHandlers::CreateSignalDelegator();
+  auto SyscallHandler = FEX::DummyHandlers::CreateSyscallHandler();
+
+  CTX->SetSignalDelegator(SignalDelegation.get());
+  CTX->SetSyscallHandler(SyscallHandler.get());
+  CTX->InitCore(0, 0);
+
+  // Compile threads are plain std::threads
+  FEXCore::Allocator::YesIKnowImNotSupposedToUseTheGlibcAllocator glibc;
+
+  uint64_t TotalNanoseconds {};
+  for (size_t Pass = 0; Pass < NumPasses; ++Pass) {
+    if (Pass != 0) {
+      InvalidateCorpus(CTX.get(), MappedPages);
+    }
+
+    std::atomic<size_t> NextBlock {};
+    fextl::vector<std::thread> Workers;
+
+    const auto Begin = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < NumThreads; ++i) {
+      Workers.emplace_back([&]() {
+        // Each compilation thread uses its own backing FEX thread
+        FEXCore::Core::CPUState State {};
+        auto Thread = CTX->CreateThread(&State, FHU::Syscalls::gettid());
+
+        for (size_t Index = NextBlock++; Index < Blocks.size(); Index = NextBlock++) {
+          CTX->CompileRIP(Thread, Blocks[Index].GuestRIP);
+        }
+
+        CTX->DestroyThread(Thread);
+
+        // This thread is now getting abandoned. Disable glibc allocator checking so glibc can safely cleanup its internal allocations.
+        FEXCore::Allocator::YesIKnowImNotSupposedToUseTheGlibcAllocator::HardDisable();
+      });
+    }
+
+    for (auto &Worker : Workers) {
+      Worker.join();
+    }
+    const uint64_t Nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Begin).count();
+    TotalNanoseconds += Nanoseconds;
+
+    LogMan::Msg::IFmt("Pass {}: {} blocks in {:.3f}ms, {:.0f} blocks/s, {:.2f} guest MiB/s", Pass, Blocks.size(), Nanoseconds / 1e6,
+                      Blocks.size() * 1e9 / Nanoseconds, GuestBytes * 1e9 / Nanoseconds / (1024.0 * 1024.0));
+  }
+
+  LogMan::Msg::IFmt("Total: {} blocks over {} passes on {} threads, {:.0f} blocks/s, {:.2f} guest MiB/s",
+                    Blocks.size() * NumPasses, NumPasses, NumThreads,
+                    Blocks.size() * NumPasses * 1e9 / TotalNanoseconds,
+                    GuestBytes * NumPasses * 1e9 / TotalNanoseconds / (1024.0 * 1024.0));
+
+  CTX->DumpProfiles();
+
+  return 0;
+}
@@ -594,6 +594,8 @@ namespace {
           SMCChecks = FEXCore::Config::CONFIG_SMC_FULL;
         } else if (**Value == "3") {
           SMCChecks = FEXCore::Config::CONFIG_SMC_MMAN;
+        } else if (**Value == "4") {
+          SMCChecks = FEXCore::Config::CONFIG_SMC_HYBRID;
         }
       }
 
@@ -602,6 +604,7 @@ namespace {
       SMCChanged |= ImGui::RadioButton("MTrack (Default)", &SMCChecks, FEXCore::Config::CONFIG_SMC_MTRACK); ImGui::SameLine();
       SMCChanged |= ImGui::RadioButton("Full", &SMCChecks, FEXCore::Config::CONFIG_SMC_FULL);
       SMCChanged |= ImGui::RadioButton("MMan (Deprecated)", &SMCChecks, FEXCore::Config::CONFIG_SMC_MMAN); ImGui::SameLine();
+      SMCChanged |= ImGui::RadioButton("Hybrid", &SMCChecks, FEXCore::Config::CONFIG_SMC_HYBRID);
 
       if (SMCChanged) {
         LoadedConfig->EraseSet(FEXCore::Config::ConfigOption::CONFIG_SMCCHECKS, std::to_string(SMCChecks));
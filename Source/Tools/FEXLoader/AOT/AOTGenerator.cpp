@@ -1,6 +1,7 @@
 #include "ELFCodeLoader.h"
 #include "Linux/Utils/ELFContainer.h"
 
+#include <FEXCore/Config/Config.h>
 #include <FEXCore/Core/Context.h>
 #include <FEXCore/Utils/CPUInfo.h>
 #include <FEXCore/Utils/LogManager.h>
@@ -9,13 +10,47 @@
 #include <FEXCore/fextl/vector.h>
 #include <FEXHeaderUtils/Syscalls.h>
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <cstddef>
+#include <cstring>
 #include <sys/resource.h>
 #include <sys/sysinfo.h>
 #include <thread>
 
 namespace FEX::AOT {
+static void ReportProgress(const ELFCodeLoader::LoadedSection &Section, fextl::vector<FEXCore::Context::AOTGenStats> const &Stats,
+                           std::chrono::steady_clock::time_point Start, size_t Queued) {
+  uint64_t Blocks{}, GuestBytes{}, IRBytes{};
+  for (auto &ThreadStats : Stats) {
+    Blocks += ThreadStats.Blocks.load(std::memory_order_relaxed);
+    GuestBytes += ThreadStats.GuestBytes.load(std::memory_order_relaxed);
+    IRBytes += ThreadStats.IRBytes.load(std::memory_order_relaxed);
+  }
+
+  const double Seconds = std::max(std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count(), 0.001);
+  LogMan::Msg::IFmt("AOTIR: {}: {} blocks ({:.0f} blocks/s), {} KiB guest, {} KiB IR ({:.2f} MiB IR/s), {} queued, {:.1f}s",
+    Section.Filename, Blocks, Blocks / Seconds, GuestBytes / 1024, IRBytes / 1024, IRBytes / Seconds / (1024.0 * 1024.0), Queued, Seconds);
+}
+
+// True if any byte of Word could start a pattern the section scan looks for.
+// Bytes of (Word ^ Pattern) are zero where they match, the usual SWAR zero byte test finds them.
+static bool HasScanLeadByte(uint64_t Word) {
+  constexpr uint64_t Ones = 0x0101'0101'0101'0101ULL;
+  constexpr uint64_t Highs = 0x8080'8080'8080'8080ULL;
+  auto HasByte = [](uint64_t Value, uint8_t Byte) {
+    const uint64_t Matched = Value ^ (Ones * Byte);
+    return ((Matched - Ones) & ~Matched & Highs) != 0;
+  };
+
+  // CALL <disp32> or the start of endbr64
+  return HasByte(Word, 0xE8) || HasByte(Word, 0xF3);
+}
+
 void AOTGenSection(FEXCore::Context::Context *CTX, ELFCodeLoader::LoadedSection &Section) {
+  FEX_CONFIG_OPT(AOTIRGenerateThreads, AOTIRGENERATETHREADS);
+
   // Make sure this section is executable and big enough
   if (!Section.Executable || Section.Size < 16)
     return;
@@ -51,8 +86,7 @@ void AOTGenSection(FEXCore::Context::Context *CTX, ELFCodeLoader::LoadedSection
 
   LogMan::Msg::IFmt("Symbol + Unwind seed: {}", InitialBranchTargets.size());
 
-  // Scan the executable section and try to find function entries
-  for (size_t Offset = 0; Offset < (Section.Size - 16); Offset++) {
+  auto ScanOffset = [&](size_t Offset) {
     uint8_t *pCode = (uint8_t *)(Section.Base + Offset);
 
     // Possible CALL <disp32>
@@ -63,10 +97,10 @@ void AOTGenSection(FEXCore::Context::Context *CTX, ELFCodeLoader::LoadedSection
       auto DestinationPtr = (uint8_t*)Destination;
 
       if (! (Destination >= Section.Base && Destination <= (Section.Base + Section.Size)) )
-        continue; // outside of current section, unlikely to be real code
+        return; // outside of current section, unlikely to be real code
 
       if (DestinationPtr[0] == 0 && DestinationPtr[1] == 0)
-        continue; // add al, [rax], unlikely to be real code
+        return; // add al, [rax], unlikely to be real code
 
       InitialBranchTargets.insert(Destination);
     }
@@ -75,6 +109,24 @@ void AOTGenSection(FEXCore::Context::Context *CTX, ELFCodeLoader::LoadedSection
     if (pCode[0] == 0xf3 && pCode[1] == 0x0f && pCode[2] == 0x1e && pCode[3] == 0xfa) {
       InitialBranchTargets.insert((uintptr_t)pCode);
     }
+  };
+
+  // Scan the executable section and try to find function entries
+  // Most words of a section contain neither lead byte, those get skipped eight bytes at a time
+  const size_t ScanSize = Section.Size - 16;
+  for (size_t Offset = 0; Offset < ScanSize; Offset += sizeof(uint64_t)) {
+    const size_t WordSize = std::min(sizeof(uint64_t), ScanSize - Offset);
+    if (WordSize == sizeof(uint64_t)) {
+      uint64_t Word;
+      memcpy(&Word, (void*)(Section.Base + Offset), sizeof(Word));
+      if (!HasScanLeadByte(Word)) {
+        continue;
+      }
+    }
+
+    for (size_t i = 0; i < WordSize; ++i) {
+      ScanOffset(Offset + i);
+    }
   }
 
   uint64_t SectionMaxAddress = Section.Base + Section.Size;
@@ -95,12 +147,20 @@ void AOTGenSection(FEXCore::Context::Context *CTX, ELFCodeLoader::LoadedSection
 
 
   std::mutex QueueMutex;
+  std::condition_variable WorkersDone;
   fextl::vector<std::thread> ThreadPool;
 
+  const size_t NumThreads = AOTIRGenerateThreads() ? AOTIRGenerateThreads() : FEXCore::CPUInfo::CalculateNumberOfCPUs();
+  size_t ActiveThreads = NumThreads;
+
+  // Each worker only ever touches its own counters, the reporter sums them
+  fextl::vector<FEXCore::Context::AOTGenStats> Stats(NumThreads);
+  const auto Start = std::chrono::steady_clock::now();
+
   // This code is tricky to refactor so it doesn't allocate memory through glibc.
   FEXCore::Allocator::YesIKnowImNotSupposedToUseTheGlibcAllocator glibc;
-  for (int i = 0; i < FEXCore::CPUInfo::CalculateNumberOfCPUs(); i++) {
-    std::thread thd([&BranchTargets, CTX, &counter, &Compiled, &Section, &QueueMutex, SectionMaxAddress]() {
+  for (size_t i = 0; i < NumThreads; i++) {
+    std::thread thd([&BranchTargets, CTX, &counter, &Compiled, &Section, &QueueMutex, &WorkersDone, &ActiveThreads, ThreadStats = &Stats[i], SectionMaxAddress]() {
       // Set the priority of the thread so it doesn't overwhelm the system when running in the background
       setpriority(PRIO_PROCESS, FHU::Syscalls::gettid(), 19);
 
@@ -108,7 +168,7 @@ void AOTGenSection(FEXCore::Context::Context *CTX, ELFCodeLoader::LoadedSection
       FEXCore::Core::CPUState state;
       auto Thread = CTX->CreateThread(&state, FHU::Syscalls::gettid());
       fextl::set<uint64_t> ExternalBranchesLocal;
-      CTX->ConfigureAOTGen(Thread, &ExternalBranchesLocal, SectionMaxAddress);
+      CTX->ConfigureAOTGen(Thread, &ExternalBranchesLocal, SectionMaxAddress, ThreadStats);
 
       for (;;) {
         uint64_t BranchTarget;
@@ -147,6 +207,13 @@ void AOTGenSection(FEXCore::Context::Context *CTX, ELFCodeLoader::LoadedSection
 
       // All entryproints processed, cleanup this thread
       CTX->DestroyThread(Thread);
+
+      {
+        std::lock_guard lk(QueueMutex);
+        --ActiveThreads;
+      }
+      WorkersDone.notify_one();
+
       // This thread is now getting abandoned. Disable glibc allocator checking so glibc can safely cleanup its internal allocations.
       FEXCore::Allocator::YesIKnowImNotSupposedToUseTheGlibcAllocator::HardDisable();
     });
@@ -155,6 +222,18 @@ void AOTGenSection(FEXCore::Context::Context *CTX, ELFCodeLoader::LoadedSection
     ThreadPool.push_back(std::move(thd));
   }
 
+  // Report progress until every worker has drained the queue
+  for (;;) {
+    std::unique_lock lk(QueueMutex);
+    if (WorkersDone.wait_for(lk, std::chrono::seconds(5), [&ActiveThreads] { return ActiveThreads == 0; })) {
+      break;
+    }
+    const size_t Queued = BranchTargets.size();
+    lk.unlock();
+
+    ReportProgress(Section, Stats, Start, Queued);
+  }
+
   // Make sure all threads are finished
   for (auto & Thread: ThreadPool) {
     Thread.join();
@@ -162,6 +241,7 @@ void AOTGenSection(FEXCore::Context::Context *CTX, ELFCodeLoader::LoadedSection
 
   ThreadPool.clear();
 
+  ReportProgress(Section, Stats, Start, 0);
   LogMan::Msg::IFmt("\nAll Done: {}", counter.load());
 }
 }
@@ -44,6 +44,8 @@ struct X86ContextBackup {
   // Guest state
   int Signal;
   uint32_t Flags;
+  // Emulated guest signal mask from before the signal
+  uint64_t GuestSigMask;
   uint64_t OriginalRIP;
   uint64_t FPStateLocation;
   uint64_t UContextLocation;
@@ -71,6 +73,8 @@ struct ArmContextBackup {
   // Guest state
   int Signal;
   uint32_t Flags;
+  // Emulated guest signal mask from before the signal
+  uint64_t GuestSigMask;
   uint64_t OriginalRIP;
   uint64_t FPStateLocation;
   uint64_t UContextLocation;
@@ -272,6 +276,36 @@ static inline void RestoreContext(void* ucontext, T *Backup) {
   }
 }
 
+// FPCR.RMode orders the directed rounding modes the other way around from MXCSR.RC, the mapping is its own inverse
+constexpr uint32_t SwapRoundingMode[4] = {0b00, 0b10, 0b01, 0b11};
+
+/**
+ * @brief Reconstructs the guest MXCSR from the host FPCR the JIT was running with
+ *
+ * Only rounding control, FTZ and DAZ are emulated, exceptions are always masked.
+ */
+static inline uint32_t GetGuestMXCSR(ContextBackup *Backup) {
+  uint32_t MXCSR = 0x1F80;
+  MXCSR |= SwapRoundingMode[(Backup->FPCR >> 22) & 0b11] << 13;
+  MXCSR |= ((Backup->FPCR >> 24) & 1) << 15;
+  // FPCR.FIZ, RES0 without FEAT_AFP
+  MXCSR |= (Backup->FPCR & 1) << 6;
+  return MXCSR;
+}
+
+static inline void SetGuestMXCSR(void* ucontext, uint32_t MXCSR, bool SupportsFlushInputsToZero) {
+  HostFPRState *HostState = reinterpret_cast<HostFPRState*>(&GetMContext(ucontext)->__reserved[0]);
+  LOGMAN_THROW_AA_FMT(HostState->Head.Magic == FPR_MAGIC, "Wrong FPR Magic: 0x{:08x}", HostState->Head.Magic);
+
+  uint32_t FPCR = HostState->FPCR & ~((0b111U << 22) | 1);
+  FPCR |= SwapRoundingMode[(MXCSR >> 13) & 0b11] << 22;
+  FPCR |= ((MXCSR >> 15) & 1) << 24;
+  if (SupportsFlushInputsToZero) {
+    FPCR |= (MXCSR >> 6) & 1;
+  }
+  HostState->FPCR = FPCR;
+}
+
 #endif
 
 #ifdef _M_X86_64
@@ -366,6 +400,17 @@ static inline void RestoreContext(void* ucontext, T *Backup) {
   }
 }
 
+static inline uint32_t GetGuestMXCSR(ContextBackup *Backup) {
+  return Backup->FPRState.mxcsr;
+}
+
+static inline void SetGuestMXCSR(void* ucontext, uint32_t MXCSR, bool) {
+  // Only rounding control, FTZ and DAZ are emulated
+  constexpr uint32_t Mask = (0b111U << 13) | (1U << 6);
+  auto fpstate = GetMContext(ucontext)->fpregs;
+  fpstate->mxcsr = (fpstate->mxcsr & ~Mask) | (MXCSR & Mask);
+}
+
 #endif
 #else
 
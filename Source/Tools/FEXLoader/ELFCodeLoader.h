@@ -137,6 +137,10 @@ class ELFCodeLoader final : public FEXCore::CodeLoader {
 
       int MapProt = MapFlags(Header);
       int MapType = MAP_PRIVATE | MAP_DENYWRITE | MAP_FIXED;
+      if (PrefaultELFText() && (Header.p_flags & PF_X)) {
+        // Read the whole text segment in now rather than faulting page by page as the code gets translated
+        MapType |= MAP_POPULATE;
+      }
 
       if (!MapFile(Elf, LoadBase, Header, MapProt, MapType, Handler)) {
         return {};
@@ -928,5 +932,6 @@ class ELFCodeLoader final : public FEXCore::CodeLoader {
 
   FEX_CONFIG_OPT(AdditionalArguments, ADDITIONALARGUMENTS);
   FEX_CONFIG_OPT(InjectLibSegFault, INJECTLIBSEGFAULT);
+  FEX_CONFIG_OPT(PrefaultELFText, PREFAULTELFTEXT);
 
 };
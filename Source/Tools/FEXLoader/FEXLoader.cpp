@@ -46,7 +46,6 @@ $end_info$
 #include <queue>
 #include <set>
 #include <sys/auxv.h>
-#include <sys/prctl.h>
 #include <sys/resource.h>
 #include <sys/select.h>
 #include <system_error>
@@ -86,8 +85,9 @@ void AssertHandler(char const *Message) {
 
 namespace FEXServerLogging {
   int FEXServerFD{};
+  FEXServerClient::Logging::RingHeader *LogRing{};
   void MsgHandler(LogMan::DebugLevels Level, char const *Message) {
-    FEXServerClient::MsgHandler(FEXServerFD, Level, Message);
+    FEXServerClient::MsgHandler(FEXServerFD, LogRing, Level, Message);
   }
 
   void AssertHandler(char const *Message) {
@@ -206,47 +206,6 @@ bool IsInterpreterInstalled() {
           access("/proc/sys/fs/binfmt_misc/FEX-x86_64", F_OK) == 0);
 }
 
-namespace FEX::TSO {
-  void SetupTSOEmulation(FEXCore::Context::Context *CTX) {
-    // We need to check if these are defined or not. This is a very fresh feature.
-#ifndef PR_GET_MEM_MODEL
-#define PR_GET_MEM_MODEL 0x6d4d444c
-#endif
-#ifndef PR_SET_MEM_MODEL
-#define PR_SET_MEM_MODEL 0x4d4d444c
-#endif
-#ifndef PR_SET_MEM_MODEL_DEFAULT
-#define PR_SET_MEM_MODEL_DEFAULT 0
-#endif
-#ifndef PR_SET_MEM_MODEL_TSO
-#define PR_SET_MEM_MODEL_TSO 1
-#endif
-    // Check to see if this is supported.
-    auto Result = prctl(PR_GET_MEM_MODEL, 0, 0, 0, 0);
-    if (Result == -1) {
-      // Unsupported, early exit.
-      return;
-    }
-
-    FEX_CONFIG_OPT(TSOEnabled, TSOENABLED);
-
-    if (!TSOEnabled()) {
-      // TSO emulation isn't even enabled, early exit.
-      return;
-    }
-
-    if (Result == PR_SET_MEM_MODEL_DEFAULT) {
-      // Try to set the TSO mode if we are currently default.
-      Result = prctl(PR_SET_MEM_MODEL, PR_SET_MEM_MODEL_TSO, 0, 0, 0);
-      if (Result == 0) {
-        // TSO mode successfully enabled. Tell the context to disable TSO emulation through atomics.
-        // This flag gets inherited on thread creation, so FEX only needs to set it at the start.
-        CTX->SetHardwareTSOSupport(true);
-      }
-    }
-  }
-}
-
 int main(int argc, char **argv, char **const envp) {
   auto SBRKPointer = FEXCore::Allocator::DisableSBRKAllocations();
   FEXCore::Allocator::GLIBCScopedFault GLIBFaultScope;
@@ -289,6 +248,16 @@ int main(int argc, char **argv, char **const envp) {
     }
   }
 
+  // The RootFS image path is replaced with its mount point by SetupClient, caches shipped next to the image are found through it
+  fextl::string RootFSImage{};
+  if (FEXCore::Config::Exists(FEXCore::Config::CONFIG_ROOTFS)) {
+    FEX_CONFIG_OPT(RootFSImagePath, ROOTFS);
+    RootFSImage = RootFSImagePath();
+    while (RootFSImage.size() > 1 && RootFSImage.back() == '/') {
+      RootFSImage.pop_back();
+    }
+  }
+
   // Ensure FEXServer is setup before config options try to pull CONFIG_ROOTFS
   if (!FEXServerClient::SetupClient(argv[0])) {
     LogMan::Msg::EFmt("FEXServerClient: Failure to setup client");
@@ -299,6 +268,7 @@ int main(int argc, char **argv, char **const envp) {
   FEX_CONFIG_OPT(AOTIRCapture, AOTIRCAPTURE);
   FEX_CONFIG_OPT(AOTIRGenerate, AOTIRGENERATE);
   FEX_CONFIG_OPT(AOTIRLoad, AOTIRLOAD);
+  FEX_CONFIG_OPT(AOTIRDirectory, AOTIRDIRECTORY);
   FEX_CONFIG_OPT(OutputLog, OUTPUTLOG);
   FEX_CONFIG_OPT(LDPath, ROOTFS);
   FEX_CONFIG_OPT(Environment, ENV);
@@ -328,7 +298,10 @@ int main(int argc, char **argv, char **const envp) {
       LogMan::Throw::UnInstallHandlers();
       LogMan::Msg::UnInstallHandlers();
 
-      FEXServerLogging::FEXServerFD = FEXServerClient::RequestLogFD(FEXServerClient::GetServerFD());
+      FEXServerLogging::LogRing = FEXServerClient::RequestLogRing(FEXServerClient::GetServerFD(), &FEXServerLogging::FEXServerFD);
+      if (!FEXServerLogging::LogRing) {
+        FEXServerLogging::FEXServerFD = FEXServerClient::RequestLogFD(FEXServerClient::GetServerFD());
+      }
       if (FEXServerLogging::FEXServerFD != -1) {
         LogMan::Throw::InstallHandler(FEXServerLogging::AssertHandler);
         LogMan::Msg::InstallHandler(FEXServerLogging::MsgHandler);
@@ -406,6 +379,14 @@ int main(int argc, char **argv, char **const envp) {
   // Setup Thread handlers, so FEXCore can create threads.
   FEX::LinuxEmulation::Threads::SetupThreadHandlers();
 
+  if (!::SilentLog) {
+    FEX_CONFIG_OPT(AsyncLog, ASYNCLOG);
+    FEX_CONFIG_OPT(LogRateLimit, LOGRATELIMIT);
+    if (AsyncLog()) {
+      LogMan::Msg::EnableAsync(LogRateLimit());
+    }
+  }
+
   FEXCore::Config::EraseSet(FEXCore::Config::CONFIG_IS64BIT_MODE, Loader.Is64BitMode() ? "1" : "0");
 
   fextl::unique_ptr<FEX::HLE::MemAllocator> Allocator;
@@ -440,8 +421,75 @@ int main(int argc, char **argv, char **const envp) {
   auto CTX = FEXCore::Context::Context::CreateNewContext();
   CTX->InitializeContext();
 
-  // Setup TSO hardware emulation immediately after initializing the context.
-  FEX::TSO::SetupTSOEmulation(CTX.get());
+  {
+    FEX_CONFIG_OPT(CacheObjectCodeCompilation, CACHEOBJECTCODECOMPILATION);
+    FEX_CONFIG_OPT(CacheObjectCodeInServer, CACHEOBJECTCODEINSERVER);
+    if (CacheObjectCodeInServer() && CacheObjectCodeCompilation() != FEXCore::Config::ConfigObjectCodeHandler::CONFIG_NONE) {
+      CTX->SetCodeObjectFileOpener([ServerPID = ::getpid()](const fextl::string &Name) -> int {
+        // A forked child would share the server socket with its parent, it uses the data directory instead
+        if (::getpid() != ServerPID) {
+          return -1;
+        }
+
+        int SharedFD = FEXServerClient::RequestCodeObjectFD(FEXServerClient::GetServerFD(), Name.c_str());
+        if (SharedFD == -1) {
+          return -1;
+        }
+
+        // Every process received the same open file description, reopen it so appends and flock work between processes
+        const auto Path = fextl::fmt::format("/proc/self/fd/{}", SharedFD);
+        int FD = open(Path.c_str(), O_RDWR | O_APPEND | O_CLOEXEC);
+        close(SharedFD);
+        return FD;
+      });
+    }
+  }
+
+  const bool AOTEnabled = AOTIRLoad() || AOTIRCapture() || AOTIRGenerate();
+  const fextl::string AOTDir = AOTIRDirectory().empty() ? fextl::fmt::format("{}/aotir", FEXCore::Config::GetDataDirectory()) : AOTIRDirectory();
+  // FEXRootFSFetcher pre-generates caches for the rootfs core libraries in to a folder next to the image
+  const fextl::string RootFSAOTDir = RootFSImage.empty() ? fextl::string{} : RootFSImage + ".aotir";
+  if (AOTEnabled) {
+    LogMan::Msg::IFmt("Warning: AOTIR is experimental, and might lead to crashes. "
+                      "Capture doesn't work with programs that fork.");
+
+    CTX->SetAOTIRLoader([AOTDir, RootFSAOTDir](const fextl::string &fileid) -> int {
+      const auto filepath = fextl::fmt::format("{}/{}.aotir", AOTDir, fileid);
+      int fd = open(filepath.c_str(), O_RDONLY);
+      if (fd == -1 && !RootFSAOTDir.empty()) {
+        // Fall back to the cache generated for the rootfs when it was installed
+        const auto RootFSFilepath = fextl::fmt::format("{}/{}.aotir", RootFSAOTDir, fileid);
+        fd = open(RootFSFilepath.c_str(), O_RDONLY);
+      }
+      return fd;
+    });
+
+    CTX->SetAOTIRWriter([AOTDir](const fextl::string& fileid) -> fextl::unique_ptr<AOTIR::AOTIRWriterFD> {
+      const auto filepath = fextl::fmt::format("{}/{}.aotir.tmp", AOTDir, fileid);
+      auto AOTWrite = fextl::make_unique<AOTIR::AOTIRWriterFD>(filepath);
+      if (*AOTWrite) {
+        LogMan::Msg::IFmt("AOTIR: Storing {}", fileid);
+      } else {
+        LogMan::Msg::IFmt("AOTIR: Failed to store {}", fileid);
+      }
+      return AOTWrite;
+    });
+
+    CTX->SetAOTIRRenamer([AOTDir](const fextl::string& fileid) -> void {
+      const auto TmpFilepath = fextl::fmt::format("{}/{}.aotir.tmp", AOTDir, fileid);
+      const auto NewFilepath = fextl::fmt::format("{}/{}.aotir", AOTDir, fileid);
+
+      // Rename the temporary file to atomically update the file
+      if (!FHU::Filesystem::RenameFile(TmpFilepath, NewFilepath)) {
+        LogMan::Msg::IFmt("Couldn't rename aotir");
+      }
+    });
+
+    // Set up before the ELFs are mapped so the bundle is used for their modules too
+    if (AOTIRLoad()) {
+      CTX->LoadAOTIRBundle(Program.ProgramPath);
+    }
+  }
 
   auto SignalDelegation = FEX::HLE::CreateSignalDelegator(CTX.get(), Program.ProgramName);
 
@@ -487,38 +535,6 @@ int main(int argc, char **argv, char **const envp) {
     });
   }
 
-  const bool AOTEnabled = AOTIRLoad() || AOTIRCapture() || AOTIRGenerate();
-  if (AOTEnabled) {
-    LogMan::Msg::IFmt("Warning: AOTIR is experimental, and might lead to crashes. "
-                      "Capture doesn't work with programs that fork.");
-
-    CTX->SetAOTIRLoader([](const fextl::string &fileid) -> int {
-      const auto filepath = fextl::fmt::format("{}/aotir/{}.aotir", FEXCore::Config::GetDataDirectory(), fileid);
-      return open(filepath.c_str(), O_RDONLY);
-    });
-
-    CTX->SetAOTIRWriter([](const fextl::string& fileid) -> fextl::unique_ptr<AOTIR::AOTIRWriterFD> {
-      const auto filepath = fextl::fmt::format("{}/aotir/{}.aotir.tmp", FEXCore::Config::GetDataDirectory(), fileid);
-      auto AOTWrite = fextl::make_unique<AOTIR::AOTIRWriterFD>(filepath);
-      if (*AOTWrite) {
-        LogMan::Msg::IFmt("AOTIR: Storing {}", fileid);
-      } else {
-        LogMan::Msg::IFmt("AOTIR: Failed to store {}", fileid);
-      }
-      return AOTWrite;
-    });
-
-    CTX->SetAOTIRRenamer([](const fextl::string& fileid) -> void {
-      const auto TmpFilepath = fextl::fmt::format("{}/aotir/{}.aotir.tmp", FEXCore::Config::GetDataDirectory(), fileid);
-      const auto NewFilepath = fextl::fmt::format("{}/aotir/{}.aotir", FEXCore::Config::GetDataDirectory(), fileid);
-
-      // Rename the temporary file to atomically update the file
-      if (!FHU::Filesystem::RenameFile(TmpFilepath, NewFilepath)) {
-        LogMan::Msg::IFmt("Couldn't rename aotir");
-      }
-    });
-  }
-
   if (AOTIRGenerate()) {
     for(auto &Section: Loader.Sections) {
       FEX::AOT::AOTGenSection(CTX.get(), Section);
@@ -528,9 +544,9 @@ int main(int argc, char **argv, char **const envp) {
   }
 
   if (AOTEnabled) {
-    if (FHU::Filesystem::CreateDirectories(fextl::fmt::format("{}/aotir", FEXCore::Config::GetDataDirectory()))) {
-      CTX->WriteFilesWithCode([](const fextl::string& fileid, const fextl::string& filename) {
-        const auto filepath = fextl::fmt::format("{}/aotir/{}.path", FEXCore::Config::GetDataDirectory(), fileid);
+    if (FHU::Filesystem::CreateDirectories(AOTDir)) {
+      CTX->WriteFilesWithCode([&AOTDir](const fextl::string& fileid, const fextl::string& filename) {
+        const auto filepath = fextl::fmt::format("{}/{}.path", AOTDir, fileid);
         int fd = open(filepath.c_str(), O_CREAT | O_EXCL | O_WRONLY, 0644);
         if (fd != -1) {
           write(fd, filename.c_str(), filename.size());
@@ -543,6 +559,10 @@ int main(int argc, char **argv, char **const envp) {
       CTX->FinalizeAOTIRCache();
       LogMan::Msg::IFmt("AOTIR Cache Stored");
     }
+
+    if (AOTIRCapture()) {
+      CTX->WriteAOTIRBundle(Program.ProgramPath);
+    }
   }
 
   auto ProgramStatus = CTX->GetProgramStatus();
@@ -554,8 +574,10 @@ int main(int argc, char **argv, char **const envp) {
 
   Loader.FreeSections();
 
+  FEX::Config::SaveLearnedAppConfig(Program.ProgramName);
   FEXCore::Config::Shutdown();
 
+  LogMan::Msg::DisableAsync();
   LogMan::Throw::UnInstallHandlers();
   LogMan::Msg::UnInstallHandlers();
 
@@ -371,6 +371,8 @@ namespace FEX::HarnessHelper {
       FEATURE_BMI2   = (1 << 7),
       FEATURE_CLWB   = (1 << 8),
       FEATURE_LINUX  = (1 << 9),
+      // Host can flush denormal inputs, needed for MXCSR.DAZ
+      FEATURE_AFP    = (1 << 10),
 
     };
 
@@ -384,6 +386,7 @@ namespace FEX::HarnessHelper {
     bool RequiresBMI2()   const { return BaseConfig.OptionHostFeatures & HostFeatures::FEATURE_BMI2; }
     bool RequiresCLWB()   const { return BaseConfig.OptionHostFeatures & HostFeatures::FEATURE_CLWB; }
     bool RequiresLinux()  const { return BaseConfig.OptionHostFeatures & HostFeatures::FEATURE_LINUX; }
+    bool RequiresAFP()    const { return BaseConfig.OptionHostFeatures & HostFeatures::FEATURE_AFP; }
 
   private:
     FEX_CONFIG_OPT(ConfigDumpGPRs, DUMPGPRS);
@@ -437,17 +440,27 @@ namespace FEX::HarnessHelper {
       Config.Init(ConfigFilename);
     }
 
+    // Tests run back to back in one process, so everything mapped for this one has to go
+    ~HarnessCodeLoader() {
+      for (auto [Ptr, Size] : MappedRegions) {
+        FEXCore::Allocator::VirtualFree(Ptr, Size);
+      }
+    }
+
     uint64_t StackSize() const override {
       return STACK_SIZE;
     }
 
     uint64_t GetStackPointer() override {
       if (Config.Is64BitMode()) {
-        return reinterpret_cast<uint64_t>(FEXCore::Allocator::VirtualAlloc(STACK_SIZE)) + STACK_SIZE;
+        auto Result = FEXCore::Allocator::VirtualAlloc(STACK_SIZE);
+        MappedRegions.emplace_back(Result, STACK_SIZE);
+        return reinterpret_cast<uint64_t>(Result) + STACK_SIZE;
       }
       else {
         uint64_t Result = reinterpret_cast<uint64_t>(FEXCore::Allocator::VirtualAlloc(reinterpret_cast<void*>(STACK_OFFSET), STACK_SIZE));
         LOGMAN_THROW_AA_FMT(Result != ~0ULL, "Stack Pointer mmap failed");
+        MappedRegions.emplace_back(reinterpret_cast<void*>(Result), STACK_SIZE);
         return Result + STACK_SIZE;
       }
     }
@@ -458,9 +471,10 @@ namespace FEX::HarnessHelper {
 
     bool MapMemory() {
       bool LimitedSize = true;
-      auto DoMMap = [](uint64_t Address, size_t Size) -> void* {
+      auto DoMMap = [this](uint64_t Address, size_t Size) -> void* {
         void *Result = FEXCore::Allocator::VirtualAlloc(reinterpret_cast<void*>(Address), Size, true);
         LOGMAN_THROW_AA_FMT(Result == reinterpret_cast<void*>(Address), "Map Memory mmap failed");
+        MappedRegions.emplace_back(Result, Size);
         return Result;
       };
 
@@ -492,8 +506,10 @@ namespace FEX::HarnessHelper {
       auto ASMPtr = FEXCore::Allocator::VirtualAlloc(reinterpret_cast<void*>(Code_start_page), Length, true);
 #else
       // Special magic DOS area that starts at 0x1'0000
-      auto ASMPtr = FEXCore::Allocator::VirtualAlloc(reinterpret_cast<void*>(1), 0x110000 - 1, true);
+      size_t Length = 0x110000 - 1;
+      auto ASMPtr = FEXCore::Allocator::VirtualAlloc(reinterpret_cast<void*>(1), Length, true);
 #endif
+      MappedRegions.emplace_back(ASMPtr, Length);
       LOGMAN_THROW_A_FMT((uint64_t)ASMPtr == Code_start_page, "Couldn't allocate code at expected page: 0x{:x} != 0x{:x}", (uint64_t)ASMPtr, Code_start_page);
       memcpy(ASMPtr, RawASMFile.data(), RawASMFile.size());
       RIP = Code_start_page;
@@ -533,6 +549,7 @@ namespace FEX::HarnessHelper {
     bool RequiresBMI2()   const { return Config.RequiresBMI2(); }
     bool RequiresCLWB()   const { return Config.RequiresCLWB(); }
     bool RequiresLinux()  const { return Config.RequiresLinux(); }
+    bool RequiresAFP()    const { return Config.RequiresAFP(); }
 
   private:
     constexpr static uint64_t STACK_SIZE = FHU::FEX_PAGE_SIZE;
@@ -542,6 +559,8 @@ namespace FEX::HarnessHelper {
     uint64_t RIP {};
 
     fextl::vector<char> RawASMFile;
+    fextl::vector<std::pair<void*, size_t>> MappedRegions;
+    // Ends in a flexible array member, has to stay last
     ConfigLoader Config;
   };
 
@@ -1,7 +1,7 @@
 /*
 $info$
 tags: Bin|IRLoader
-desc: Used to run IR Tests
+desc: Used to run IR Tests, and to benchmark the IR passes on directories of dumped IR
 $end_info$
 */
 
@@ -22,12 +22,16 @@ $end_info$
 #include <FEXCore/fextl/fmt.h>
 #include <FEXCore/fextl/sstream.h>
 
+#include <algorithm>
+#include <chrono>
 #include <csetjmp>
+#include <filesystem>
 #include <functional>
 #include <memory>
 #include <stdint.h>
 #include <stdio.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 #include <vector>
 
 #include "HarnessHelpers.h"
@@ -133,6 +137,80 @@ class DummySyscallHandler: public FEXCore::HLE::SyscallHandler, public FEXCore::
   }
 };
 
+/**
+ * @brief Compiles every .ir file in a directory Iterations times without running them
+ *
+ * Meant for measuring IR passes on IR dumped from real workloads with PassManagerDumpIR.
+ * Each compile gets its own entrypoint so nothing is served from the code cache, the per pass
+ * timings and IR op deltas from ProfileCompilation are logged at the end.
+ */
+static int RunBenchmark(FEXCore::Context::Context *CTX, fextl::string const &Directory, uint64_t Iterations) {
+  // Entrypoints are only keys for the custom IR handlers, nothing is mapped there
+  constexpr uint64_t BENCHMARK_BASE_RIP = 0x40000;
+
+  FEXCore::Utils::PooledAllocatorMalloc Allocator;
+  fextl::vector<fextl::unique_ptr<IREmitter>> ParsedFiles;
+
+  fextl::vector<fextl::string> Filenames;
+  {
+    // std::filesystem allocates through glibc
+    FEXCore::Allocator::YesIKnowImNotSupposedToUseTheGlibcAllocator glibc;
+    std::error_code ec{};
+    for (auto &Entry : std::filesystem::directory_iterator(Directory, ec)) {
+      if (Entry.path().extension() == ".ir") {
+        Filenames.emplace_back(Entry.path().string());
+      }
+    }
+  }
+  // Same order on every run
+  std::sort(Filenames.begin(), Filenames.end());
+
+  for (auto &Filename : Filenames) {
+    fextl::string IRFile;
+    if (!FEXCore::FileLoading::LoadFile(IRFile, Filename)) {
+      LogMan::Msg::EFmt("Couldn't open IR file '{}'", Filename);
+      continue;
+    }
+
+    fextl::stringstream IRStream(IRFile);
+    auto ParsedCode = FEXCore::IR::Parse(Allocator, IRStream);
+    if (!ParsedCode) {
+      LogMan::Msg::EFmt("Couldn't parse IR file '{}'", Filename);
+      continue;
+    }
+    ParsedFiles.emplace_back(std::move(ParsedCode));
+  }
+
+  if (ParsedFiles.empty()) {
+    LogMan::Msg::EFmt("No IR files in '{}'", Directory);
+    return -1;
+  }
+
+  uint64_t RIP = BENCHMARK_BASE_RIP;
+  for (uint64_t Iteration = 0; Iteration < Iterations; ++Iteration) {
+    for (auto &ParsedCode : ParsedFiles) {
+      CTX->AddCustomIREntrypoint(RIP++, [ParsedCodePtr = ParsedCode.get()](uintptr_t Entrypoint, FEXCore::IR::IREmitter *emit) {
+        emit->CopyData(*ParsedCodePtr);
+      });
+    }
+  }
+
+  auto Thread = CTX->InitCore(BENCHMARK_BASE_RIP, 0);
+
+  const auto Begin = std::chrono::steady_clock::now();
+  for (uint64_t Entry = BENCHMARK_BASE_RIP; Entry < RIP; ++Entry) {
+    CTX->CompileRIP(Thread, Entry);
+  }
+  const uint64_t Nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Begin).count();
+
+  const uint64_t Compiles = RIP - BENCHMARK_BASE_RIP;
+  LogMan::Msg::IFmt("Compiled {} IR files {} times in {:.3f}ms, {:.3f}us per compile", ParsedFiles.size(), Iterations,
+                    Nanoseconds / 1e6, Nanoseconds / 1e3 / Compiles);
+
+  CTX->DumpProfiles();
+  return 0;
+}
+
 int main(int argc, char **argv, char **const envp)
 {
   FEXCore::Allocator::GLIBCScopedFault GLIBFaultScope;
@@ -151,7 +229,17 @@ int main(int argc, char **argv, char **const envp)
   auto Args = FEX::ArgLoader::Get();
   auto ParsedArgs = FEX::ArgLoader::GetParsedArgs();
 
-  LOGMAN_THROW_A_FMT(Args.size() > 1, "Not enough arguments");
+  // Benchmark mode: IRLoader <directory of .ir files> [iterations]
+  struct stat Stat{};
+  const bool Benchmark = !Args.empty() && stat(Args[0].c_str(), &Stat) == 0 && S_ISDIR(Stat.st_mode);
+  LOGMAN_THROW_A_FMT(Benchmark || Args.size() > 1, "Not enough arguments");
+
+  if (Benchmark) {
+    // Per stage and per pass timings.
+    FEXCore::Config::EraseSet(FEXCore::Config::CONFIG_PROFILECOMPILATION, "1");
+    // Cached code objects would skip the compile being measured.
+    FEXCore::Config::EraseSet(FEXCore::Config::CONFIG_CACHEOBJECTCODECOMPILATION, fextl::fmt::format("{}", static_cast<uint64_t>(FEXCore::Config::ConfigObjectCodeHandler::CONFIG_NONE)));
+  }
 
   FEXCore::Context::InitializeStaticTables();
   auto CTX = FEXCore::Context::Context::CreateNewContext();
@@ -162,6 +250,11 @@ int main(int argc, char **argv, char **const envp)
   CTX->SetSignalDelegator(SignalDelegation.get());
   CTX->SetSyscallHandler(new DummySyscallHandler());
 
+  if (Benchmark) {
+    const uint64_t Iterations = Args.size() > 1 ? std::max<uint64_t>(1, strtoull(Args[1].c_str(), nullptr, 0)) : 1;
+    return RunBenchmark(CTX.get(), Args[0], Iterations);
+  }
+
   IRCodeLoader Loader(Args[0], Args[1]);
 
   // Skip tests that require AVX on hosts that don't support it.
@@ -0,0 +1,80 @@
+/*
+$info$
+tags: LinuxSyscalls|common
+$end_info$
+*/
+
+#pragma once
+
+#include <FEXCore/fextl/vector.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/epoll.h>
+
+namespace FEX::HLE {
+  /**
+   * @brief Host epoll_event array for one epoll_wait style syscall, copied out to the guest's packed array
+   *
+   * The x86 epoll_event is packed to 12 bytes while the host one is 16, so the kernel can't write in to the guest array.
+   * The host array comes from a per-thread scratch buffer instead of an allocation per call. Only large requests
+   * allocate, so a single huge epoll_wait doesn't pin its buffer for the life of the thread.
+   * When the host layout matches the guest layout the guest array is used directly.
+   */
+  template<typename GuestEvent>
+  class HostEPollEvents final {
+    public:
+      static_assert(sizeof(GuestEvent) == 12, "Guest epoll_event is expected to be packed");
+
+      HostEPollEvents(GuestEvent *Guest, int MaxEvents)
+        : Guest {Guest} {
+        if constexpr (sizeof(struct epoll_event) == sizeof(GuestEvent)) {
+          Events = reinterpret_cast<struct epoll_event*>(Guest);
+          return;
+        }
+
+        const size_t Count = std::max(0, MaxEvents);
+        if (Count <= MAX_SCRATCH_EVENTS) {
+          static thread_local fextl::vector<struct epoll_event> Scratch{};
+          if (Scratch.size() < Count) {
+            Scratch.resize(Count);
+          }
+          Events = Scratch.data();
+        }
+        else {
+          Large.resize(Count);
+          Events = Large.data();
+        }
+      }
+
+      struct epoll_event *data() const { return Events; }
+
+      // Repacks the first Count events in to the guest array
+      void CopyOut(size_t Count) const {
+        if constexpr (sizeof(struct epoll_event) == sizeof(GuestEvent)) {
+          return;
+        }
+
+        // Both layouts are the 32-bit events followed by the 64-bit data, only the padding differs.
+        // Plain fixed size copies so the compiler emits straight loads and stores for the loop.
+        auto Dst = reinterpret_cast<uint8_t*>(Guest);
+        auto Src = reinterpret_cast<const uint8_t*>(Events);
+        for (size_t i = 0; i < Count; ++i) {
+          memcpy(Dst, Src + offsetof(struct epoll_event, events), sizeof(uint32_t));
+          memcpy(Dst + sizeof(uint32_t), Src + offsetof(struct epoll_event, data), sizeof(uint64_t));
+          Dst += sizeof(GuestEvent);
+          Src += sizeof(struct epoll_event);
+        }
+      }
+
+    private:
+      // 64KB of host events per thread
+      constexpr static size_t MAX_SCRATCH_EVENTS = 4096;
+
+      GuestEvent *Guest;
+      struct epoll_event *Events{};
+      fextl::vector<struct epoll_event> Large{};
+  };
+}
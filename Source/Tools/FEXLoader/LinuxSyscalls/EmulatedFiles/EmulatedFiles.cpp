@@ -26,6 +26,8 @@ $end_info$
 #include <filesystem>
 #include <ostream>
 #include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <system_error>
 #include <unistd.h>
 #include <utility>
@@ -50,6 +52,49 @@ namespace FEX::EmulatedFile {
     return fd;
   }
 
+  /**
+   * @brief Creates a sealed memfd holding the contents, -1 on failure
+   *
+   * The memfd is CLOEXEC so it never leaks in to an exec'd process.
+   */
+  static int GenSealedFD(const char *Name, const fextl::string &Contents) {
+    int FD = memfd_create(Name, MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (FD == -1) {
+      return -1;
+    }
+
+    if (write(FD, Contents.data(), Contents.size()) != static_cast<ssize_t>(Contents.size()) ||
+        fcntl(FD, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) != 0) {
+      close(FD);
+      return -1;
+    }
+
+    return FD;
+  }
+
+  /**
+   * @brief Opens a new read-only description of a sealed memfd
+   *
+   * A dup would share the file offset between every guest open, reopening through procfs gives each open its own.
+   * The guest may have closed our FD and had the number reused, so the result is checked against the file it was.
+   */
+  static int ReopenSealedFD(int SealedFD, dev_t Device, ino_t Inode, int32_t flags) {
+    char Path[32];
+    snprintf(Path, sizeof(Path), "/proc/self/fd/%d", SealedFD);
+    int FD = open(Path, O_RDONLY | (flags & O_CLOEXEC));
+    if (FD == -1) {
+      return -1;
+    }
+
+    struct stat Stat;
+    if (fstat(FD, &Stat) != 0 || Stat.st_dev != Device || Stat.st_ino != Inode) {
+      close(FD);
+      return -1;
+    }
+
+    return FD;
+  }
+
   fextl::string GenerateCPUInfo(FEXCore::Context::Context *ctx, uint32_t CPUCores) {
     fextl::ostringstream cpu_stream{};
     auto res_0  = ctx->RunCPUIDFunction(0, 0);
@@ -622,79 +667,78 @@ namespace FEX::EmulatedFile {
   EmulatedFDManager::EmulatedFDManager(FEXCore::Context::Context *ctx)
     : CTX {ctx} {
     FDReadCreators["/proc/cpuinfo"] = [&](FEXCore::Context::Context *ctx, int32_t fd, const char *pathname, int32_t flags, mode_t mode) -> int32_t {
-      // Only allow a single thread to initialize the cpu_info.
-      // Jit in-case multiple threads try to initialize at once.
-      // Check if deferred cpuinfo initialization has occured.
-      std::call_once(cpu_info_initialized, [&]() { cpu_info = GenerateCPUInfo(ctx, ThreadsConfig()); });
-
-      int FD = GenTmpFD();
-      write(FD, (void*)&cpu_info.at(0), cpu_info.size());
-      lseek(FD, 0, SEEK_SET);
-      return FD;
+      // Deferred so the CPUID configuration is final by the first open
+      return OpenCachedFile(CPUInfo, "FEXCPUInfo", flags, [&]() { return GenerateCPUInfo(ctx, ThreadsConfig()); });
     };
 
     FDReadCreators["/proc/sys/kernel/osrelease"] = [&](FEXCore::Context::Context *ctx, int32_t fd, const char *pathname, int32_t flags, mode_t mode) -> int32_t {
-      int FD = GenTmpFD();
-      uint32_t GuestVersion = FEX::HLE::_SyscallHandler->GetGuestKernelVersion();
-      char Tmp[64]{};
-      snprintf(Tmp, sizeof(Tmp), "%d.%d.%d\n",
-        FEX::HLE::SyscallHandler::KernelMajor(GuestVersion),
-        FEX::HLE::SyscallHandler::KernelMinor(GuestVersion),
-        FEX::HLE::SyscallHandler::KernelPatch(GuestVersion));
-      // + 1 to ensure null at the end
-      write(FD, Tmp, strlen(Tmp) + 1);
-      lseek(FD, 0, SEEK_SET);
-      return FD;
+      return OpenCachedFile(OSRelease, "FEXOSRelease", flags, []() {
+        uint32_t GuestVersion = FEX::HLE::_SyscallHandler->GetGuestKernelVersion();
+        char Tmp[64]{};
+        snprintf(Tmp, sizeof(Tmp), "%d.%d.%d\n",
+          FEX::HLE::SyscallHandler::KernelMajor(GuestVersion),
+          FEX::HLE::SyscallHandler::KernelMinor(GuestVersion),
+          FEX::HLE::SyscallHandler::KernelPatch(GuestVersion));
+        // + 1 to ensure null at the end
+        return fextl::string(Tmp, strlen(Tmp) + 1);
+      });
     };
 
     FDReadCreators["/proc/version"] = [&](FEXCore::Context::Context *ctx, int32_t fd, const char *pathname, int32_t flags, mode_t mode) -> int32_t {
-      int FD = GenTmpFD();
-      // UTS version NEEDS to be in a format that can pass to `date -d`
-      // Format of this is Linux version <Release> (<Compile By>@<Compile Host>) (<Linux Compiler>) #<version> {SMP, PREEMPT, PREEMPT_RT} <UTS version>\n"
-      const char kernel_version[] = "Linux version %d.%d.%d (FEX@FEX) (clang) #" GIT_DESCRIBE_STRING " SMP " __DATE__ " " __TIME__ "\n";
-      uint32_t GuestVersion = FEX::HLE::_SyscallHandler->GetGuestKernelVersion();
-      char Tmp[sizeof(kernel_version) + 64]{};
-      snprintf(Tmp, sizeof(Tmp), kernel_version,
-        FEX::HLE::SyscallHandler::KernelMajor(GuestVersion),
-        FEX::HLE::SyscallHandler::KernelMinor(GuestVersion),
-        FEX::HLE::SyscallHandler::KernelPatch(GuestVersion));
-      // + 1 to ensure null at the end
-      write(FD, Tmp, strlen(Tmp) + 1);
-      lseek(FD, 0, SEEK_SET);
-      return FD;
+      return OpenCachedFile(Version, "FEXVersion", flags, []() {
+        // UTS version NEEDS to be in a format that can pass to `date -d`
+        // Format of this is Linux version <Release> (<Compile By>@<Compile Host>) (<Linux Compiler>) #<version> {SMP, PREEMPT, PREEMPT_RT} <UTS version>\n"
+        const char kernel_version[] = "Linux version %d.%d.%d (FEX@FEX) (clang) #" GIT_DESCRIBE_STRING " SMP " __DATE__ " " __TIME__ "\n";
+        uint32_t GuestVersion = FEX::HLE::_SyscallHandler->GetGuestKernelVersion();
+        char Tmp[sizeof(kernel_version) + 64]{};
+        snprintf(Tmp, sizeof(Tmp), kernel_version,
+          FEX::HLE::SyscallHandler::KernelMajor(GuestVersion),
+          FEX::HLE::SyscallHandler::KernelMinor(GuestVersion),
+          FEX::HLE::SyscallHandler::KernelPatch(GuestVersion));
+        // + 1 to ensure null at the end
+        return fextl::string(Tmp, strlen(Tmp) + 1);
+      });
     };
 
     auto NumCPUCores = [&](FEXCore::Context::Context *ctx, int32_t fd, const char *pathname, int32_t flags, mode_t mode) -> int32_t {
-      int FD = GenTmpFD();
-      write(FD, (void*)&cpus_online.at(0), cpus_online.size());
-      lseek(FD, 0, SEEK_SET);
-      return FD;
+      return OpenCachedFile(CPUsOnline, "FEXCPUsOnline", flags, [&]() { return cpus_online; });
     };
 
     FDReadCreators["/sys/devices/system/cpu/online"] = NumCPUCores;
     FDReadCreators["/sys/devices/system/cpu/present"] = NumCPUCores;
 
+    auto auxv_handler = [&](FEXCore::Context::Context *ctx, int32_t fd, const char *pathname, int32_t flags, mode_t mode) -> int32_t {
+      uint64_t auxvBase=0, auxvSize=0;
+      FEX::HLE::_SyscallHandler->GetCodeLoader()->GetAuxv(auxvBase, auxvSize);
+      if (!auxvBase) {
+        LogMan::Msg::DFmt("Failed to get Auxv stack address");
+        return -1;
+      }
+
+      return OpenCachedFile(Auxv, "FEXAuxv", flags, [auxvBase, auxvSize]() {
+        return fextl::string(reinterpret_cast<const char*>(auxvBase), auxvSize);
+      });
+    };
+
     fextl::string procAuxv = fextl::fmt::format("/proc/{}/auxv", getpid());
 
-    FDReadCreators[procAuxv] = &EmulatedFDManager::ProcAuxv;
-    FDReadCreators["/proc/self/auxv"] = &EmulatedFDManager::ProcAuxv;
+    FDReadCreators[procAuxv] = auxv_handler;
+    FDReadCreators["/proc/self/auxv"] = auxv_handler;
 
     auto cmdline_handler = [&](FEXCore::Context::Context *ctx, int32_t fd, const char *pathname, int32_t flags, mode_t mode) -> int32_t {
-      int FD = GenTmpFD();
-      auto CodeLoader = FEX::HLE::_SyscallHandler->GetCodeLoader();
-      auto Args = CodeLoader->GetApplicationArguments();
-      char NullChar{};
-      // cmdline is an array of null terminated arguments
-      for (size_t i = 0; i < Args->size(); ++i) {
-        auto &Arg = Args->at(i);
-        write(FD, Arg.c_str(), Arg.size());
-        // Finish off with a null terminator
-        write(FD, &NullChar, sizeof(uint8_t));
-      }
-
-      // One additional null terminator to finish the list
-      lseek(FD, 0, SEEK_SET);
-      return FD;
+      return OpenCachedFile(CmdLine, "FEXCmdLine", flags, []() {
+        auto CodeLoader = FEX::HLE::_SyscallHandler->GetCodeLoader();
+        auto Args = CodeLoader->GetApplicationArguments();
+        fextl::string CmdLine{};
+        // cmdline is an array of null terminated arguments
+        for (size_t i = 0; i < Args->size(); ++i) {
+          auto &Arg = Args->at(i);
+          CmdLine.append(Arg);
+          // Finish off with a null terminator
+          CmdLine.push_back('\0');
+        }
+        return CmdLine;
+      });
     };
 
     FDReadCreators["/proc/self/cmdline"] = cmdline_handler;
@@ -711,6 +755,11 @@ namespace FEX::EmulatedFile {
   }
 
   EmulatedFDManager::~EmulatedFDManager() {
+    for (auto File : {&CPUInfo, &OSRelease, &Version, &CPUsOnline, &Auxv, &CmdLine}) {
+      if (File->FD != -1) {
+        close(File->FD);
+      }
+    }
   }
 
   int32_t EmulatedFDManager::OpenAt(int dirfs, const char *pathname, int flags, uint32_t mode) {
@@ -778,19 +827,44 @@ namespace FEX::EmulatedFile {
     return Creator->second(CTX, dirfs, Path, flags, mode);
   }
 
-  int32_t EmulatedFDManager::ProcAuxv(FEXCore::Context::Context* ctx, int32_t fd, const char* pathname, int32_t flags, mode_t mode)
-  {
-    uint64_t auxvBase=0, auxvSize=0;
-    FEX::HLE::_SyscallHandler->GetCodeLoader()->GetAuxv(auxvBase, auxvSize);
-    if (!auxvBase) {
-      LogMan::Msg::DFmt("Failed to get Auxv stack address");
-      return -1;
+  int32_t EmulatedFDManager::OpenCachedFile(CachedFile &File, const char *Name, int32_t flags, const std::function<fextl::string()> &Render) {
+    std::scoped_lock lk(File.Mutex);
+    if (!File.Rendered) {
+      File.Contents = Render();
+      File.Rendered = true;
     }
 
+    if (File.FD != -1) {
+      int FD = ReopenSealedFD(File.FD, File.Device, File.Inode, flags);
+      if (FD != -1) {
+        return FD;
+      }
+
+      // The guest closed the FD out from under us, the number isn't ours to close anymore
+      File.FD = -1;
+    }
+
+    File.FD = GenSealedFD(Name, File.Contents);
+    if (File.FD != -1) {
+      struct stat Stat;
+      if (fstat(File.FD, &Stat) == 0) {
+        File.Device = Stat.st_dev;
+        File.Inode = Stat.st_ino;
+
+        int FD = ReopenSealedFD(File.FD, File.Device, File.Inode, flags);
+        if (FD != -1) {
+          return FD;
+        }
+      }
+
+      close(File.FD);
+      File.FD = -1;
+    }
+
+    // No memfd sealing or procfs, fall back to a fresh temporary file
     int FD = GenTmpFD();
-    write(FD, (void*)auxvBase, auxvSize);
+    write(FD, File.Contents.data(), File.Contents.size());
     lseek(FD, 0, SEEK_SET);
     return FD;
   }
 }
-
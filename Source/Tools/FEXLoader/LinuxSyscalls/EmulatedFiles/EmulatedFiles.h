@@ -11,6 +11,7 @@ $end_info$
 
 #include <cstdint>
 #include <functional>
+#include <mutex>
 #include <sys/types.h>
 
 namespace FEXCore::Context {
@@ -27,12 +28,32 @@ namespace FEX::EmulatedFile {
     private:
       FEXCore::Context::Context *CTX;
       fextl::string cpus_online{};
-      std::once_flag cpu_info_initialized{};
-      fextl::string cpu_info{};
       using FDReadStringFunc = std::function<int32_t(FEXCore::Context::Context *ctx, int32_t fd, const char *pathname, int32_t flags, mode_t mode)>;
       fextl::unordered_map<fextl::string, FDReadStringFunc> FDReadCreators;
 
-      static int32_t ProcAuxv(FEXCore::Context::Context* ctx, int32_t fd, const char* pathname, int32_t flags, mode_t mode);
+      /**
+       * @brief Contents of an emulated file that doesn't change for the life of the process
+       *
+       * Rendered on the first open and kept in a sealed memfd that every later open reopens read-only.
+       */
+      struct CachedFile {
+        std::mutex Mutex{};
+        bool Rendered{};
+        fextl::string Contents{};
+        // Sealed memfd holding Contents, -1 if it couldn't be created
+        int FD{-1};
+        dev_t Device{};
+        ino_t Inode{};
+      };
+
+      CachedFile CPUInfo{};
+      CachedFile OSRelease{};
+      CachedFile Version{};
+      CachedFile CPUsOnline{};
+      CachedFile Auxv{};
+      CachedFile CmdLine{};
+
+      static int32_t OpenCachedFile(CachedFile &File, const char *Name, int32_t flags, const std::function<fextl::string()> &Render);
       FEX_CONFIG_OPT(ThreadsConfig, THREADS);
   };
 }
@@ -7,6 +7,8 @@ $end_info$
 
 #include "Common/Config.h"
 #include "Common/FDUtils.h"
+#include "Common/FEXServerClient.h"
+#include "Common/FileFormatCheck.h"
 
 #include "FEXCore/Config/Config.h"
 #include "LinuxSyscalls/FileManagement.h"
@@ -24,10 +26,12 @@ $end_info$
 #include <FEXHeaderUtils/Syscalls.h>
 
 #include <algorithm>
+#include <dirent.h>
 #include <errno.h>
 #include <cstring>
 #include <fcntl.h>
 #include <filesystem>
+#include <linux/magic.h>
 #include <optional>
 #include <stdio.h>
 #include <sys/stat.h>
@@ -60,6 +64,26 @@ namespace JSON {
 }
 
 namespace FEX::HLE {
+bool FileManager::RootFSMayContain(const char *pathname) const {
+  if (RootFSTopLevelEntries.empty()) {
+    return true;
+  }
+
+  // Only the first real path component is checked.
+  // Skip any leading '/', '.' and '..' components, at the root '..' is the root itself.
+  std::string_view Path {pathname};
+  while (!Path.empty()) {
+    const auto Component = Path.substr(0, Path.find('/'));
+    if (!Component.empty() && Component != "." && Component != "..") {
+      return RootFSTopLevelEntries.contains(Component);
+    }
+    Path.remove_prefix(std::min(Path.size(), Component.size() + 1));
+  }
+
+  // The path is the root itself
+  return true;
+}
+
 bool FileManager::RootFSPathExists(const char* Filepath) {
   LOGMAN_THROW_A_FMT(Filepath && Filepath[0] == '/', "Filepath needs to be absolute");
   return FHU::Filesystem::ExistsAt(RootFSFD, Filepath + 1);
@@ -205,6 +229,72 @@ void FileManager::LoadThunkDatabase(fextl::unordered_map<fextl::string, ThunkDBO
   }
 }
 
+bool FileManager::LoadServerRootFSEntries() {
+  // Only the FEXServer's own squashfs mount is known to match its listing
+  const auto &ServerRootFS = FEXServerClient::GetServerRootFSPath();
+  if (ServerRootFS.empty() || ServerRootFS != LDPath() || FEXServerClient::GetServerFD() == -1) {
+    return false;
+  }
+
+  int FD = FEXServerClient::RequestRootFSEntriesFD(FEXServerClient::GetServerFD());
+  if (FD == -1) {
+    return false;
+  }
+
+  struct stat Stat{};
+  fextl::string Entries;
+  bool Result = fstat(FD, &Stat) == 0;
+  if (Result) {
+    Entries.resize(Stat.st_size);
+    Result = pread(FD, Entries.data(), Entries.size(), 0) == Stat.st_size;
+  }
+  close(FD);
+
+  if (!Result) {
+    return false;
+  }
+
+  for (size_t Offset = 0; Offset < Entries.size();) {
+    const auto End = Entries.find('\0', Offset);
+    if (End == fextl::string::npos) {
+      break;
+    }
+    RootFSTopLevelEntries.emplace(Entries.substr(Offset, End - Offset));
+    Offset = End + 1;
+  }
+
+  return true;
+}
+
+int FileManager::OpenCachedRootFSFile(const char *SubPath, int flags, uint32_t mode) {
+  // Only plain read-only opens of shared libraries
+  constexpr int ModifyingFlags = O_CREAT | O_TRUNC | O_PATH | O_DIRECTORY | O_TMPFILE;
+  if (RootFSCacheFD == -1 || (flags & O_ACCMODE) != O_RDONLY || (flags & ModifyingFlags) ||
+      !FEX::FormatCheck::IsSharedLibraryName(FHU::Filesystem::GetFilename(SubPath))) {
+    return -1;
+  }
+
+  int fd = ::openat(RootFSCacheFD, SubPath, flags, mode);
+  if (fd != -1 || errno != ENOENT || ::getpid() != RootFSCachePID) {
+    return fd;
+  }
+
+  {
+    // First open of this library by any process, have the FEXServer copy it out of the image
+    std::unique_lock lk {RootFSCacheMutex};
+    if (UncachableRootFSFiles.contains(SubPath)) {
+      return -1;
+    }
+
+    if (!FEXServerClient::RequestCacheRootFSFile(FEXServerClient::GetServerFD(), SubPath)) {
+      UncachableRootFSFiles.emplace(SubPath);
+      return -1;
+    }
+  }
+
+  return ::openat(RootFSCacheFD, SubPath, flags, mode);
+}
+
 FileManager::FileManager(FEXCore::Context::Context *ctx)
   : EmuFD {ctx} {
   auto ThunkConfigFile = ThunkConfig();
@@ -250,6 +340,38 @@ FileManager::FileManager(FEXCore::Context::Context *ctx)
     }
   }
 
+  if (RootFSFD != AT_FDCWD) {
+    // A read-only mount flag isn't enough, a read-only bind mount of a writable directory still changes underneath.
+    // Only an image, either mounted by FEXServer or through the kernel's squashfs or erofs, is known to never change.
+    struct statfs FS{};
+    const auto &ServerRootFS = FEXServerClient::GetServerRootFSPath();
+    RootFSImmutable = (!ServerRootFS.empty() && ServerRootFS == LDPath()) ||
+      (fstatfs(RootFSFD, &FS) == 0 && (FS.f_type == SQUASHFS_MAGIC || FS.f_type == EROFS_SUPER_MAGIC_V1));
+  }
+
+  if ((RootFSLookupCache() || RootFSImmutable) && RootFSFD != AT_FDCWD && !LoadServerRootFSEntries()) {
+    // RootFSFD is O_PATH so it can't be iterated, open the directory again for reading
+    int DirFD = openat(RootFSFD, ".", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    DIR *Dir = DirFD != -1 ? fdopendir(DirFD) : nullptr;
+    if (Dir) {
+      while (auto Entry = readdir(Dir)) {
+        if (strcmp(Entry->d_name, ".") != 0 && strcmp(Entry->d_name, "..") != 0) {
+          RootFSTopLevelEntries.emplace(Entry->d_name);
+        }
+      }
+      closedir(Dir);
+    }
+    else if (DirFD != -1) {
+      close(DirFD);
+    }
+  }
+
+  if (RootFSFileCache() && RootFSImmutable && FEXServerClient::GetServerFD() != -1 &&
+      FEXServerClient::GetServerRootFSPath() == LDPath()) {
+    RootFSCacheFD = FEXServerClient::RequestRootFSCacheFD(FEXServerClient::GetServerFD());
+    RootFSCachePID = ::getpid();
+  }
+
   fextl::unordered_map<fextl::string, ThunkDBObject> ThunkDB;
   LoadThunkDatabase(ThunkDB, true);
   LoadThunkDatabase(ThunkDB, false);
@@ -349,6 +471,9 @@ FileManager::FileManager(FEXCore::Context::Context *ctx)
 
 FileManager::~FileManager() {
   close(RootFSFD);
+  if (RootFSCacheFD != -1) {
+    close(RootFSCacheFD);
+  }
 }
 
 fextl::string FileManager::GetEmulatedPath(const char *pathname, bool FollowSymlink) {
@@ -364,7 +489,8 @@ fextl::string FileManager::GetEmulatedPath(const char *pathname, bool FollowSyml
   }
 
   auto RootFSPath = LDPath();
-  if (RootFSPath.empty()) { // If RootFS doesn't exist
+  if (RootFSPath.empty() || // If RootFS doesn't exist
+      !RootFSMayContain(pathname)) {
     return {};
   }
 
@@ -400,8 +526,8 @@ std::pair<int, const char*> FileManager::GetEmulatedFDPath(int dirfd, const char
     return std::make_pair(AT_FDCWD, thunkOverlay->second.c_str());
   }
 
-  if (RootFSFD == AT_FDCWD) {
-    // If RootFS doesn't exist
+  if (RootFSFD == AT_FDCWD || // If RootFS doesn't exist
+      !RootFSMayContain(pathname)) {
     return NoEntry;
   }
 
@@ -417,6 +543,33 @@ std::pair<int, const char*> FileManager::GetEmulatedFDPath(int dirfd, const char
     TmpFilename[1],
   };
 
+  if (FollowSymlink && RootFSImmutable) {
+    std::shared_lock lk {ResolvedPathsMutex};
+    auto it = ResolvedPaths.find(std::string_view(pathname));
+    if (it != ResolvedPaths.end()) {
+      if (!it->second.Exists) {
+        return NoEntry;
+      }
+
+      memcpy(TmpPaths[0], it->second.SubPath.c_str(), it->second.SubPath.size() + 1);
+      return std::make_pair(RootFSFD, TmpPaths[0]);
+    }
+  }
+
+  // Errors other than ENOENT, like EACCES, depend on the caller and don't get cached
+  bool CanCache = FollowSymlink && RootFSImmutable;
+  auto CacheResolvedPath = [&](bool Exists, const char *ResolvedSubPath) {
+    if (!CanCache) {
+      return;
+    }
+
+    std::unique_lock lk {ResolvedPathsMutex};
+    if (ResolvedPaths.size() >= MaxResolvedPaths) {
+      ResolvedPaths.clear();
+    }
+    ResolvedPaths.insert_or_assign(fextl::string(pathname), ResolvedRootFSPath{Exists, Exists ? fextl::string(ResolvedSubPath) : fextl::string{}});
+  };
+
   if (FollowSymlink) {
     // Check if the combination of RootFS FD and subpath with the front '/' stripped off is a symlink.
     bool HadAtLeastOne{};
@@ -426,8 +579,12 @@ std::pair<int, const char*> FileManager::GetEmulatedFDPath(int dirfd, const char
       // If the initial filepath doesn't exist then early exit.
       // If it did exist at some state then trace it all all the way to the final link.
       int Result = fstatat(RootFSFD, &SubPath[1], &Buffer, AT_SYMLINK_NOFOLLOW);
+      if (Result != 0 && errno != ENOENT) {
+        CanCache = false;
+      }
       if (Result != 0 && errno == ENOENT && !HadAtLeastOne) {
         // Initial file didn't exist at all
+        CacheResolvedPath(false, nullptr);
         return NoEntry;
       }
 
@@ -465,6 +622,8 @@ std::pair<int, const char*> FileManager::GetEmulatedFDPath(int dirfd, const char
     }
   }
 
+  CacheResolvedPath(true, &SubPath[1]);
+
   // Return the pair of rootfs FD plus relative subpath by stripping off the front '/'
   return std::make_pair(RootFSFD, &SubPath[1]);
 }
@@ -515,7 +674,10 @@ uint64_t FileManager::Open(const char *pathname, int flags, uint32_t mode) {
     if (fd == -1) {
       FDPathTmpData TmpFilename;
       auto Path = GetEmulatedFDPath(AT_FDCWD, SelfPath, true, TmpFilename);
-      if (Path.first != -1) {
+      if (Path.first == RootFSFD) {
+        fd = OpenCachedRootFSFile(Path.second, flags, mode);
+      }
+      if (fd == -1 && Path.first != -1) {
         fd = ::openat(Path.first, Path.second, flags, mode);
       }
     }
@@ -736,7 +898,10 @@ uint64_t FileManager::Openat([[maybe_unused]] int dirfs, const char *pathname, i
     if (fd == -1) {
       FDPathTmpData TmpFilename;
       auto Path = GetEmulatedFDPath(dirfs, SelfPath, true, TmpFilename);
-      if (Path.first != -1) {
+      if (Path.first == RootFSFD) {
+        fd = OpenCachedRootFSFile(Path.second, flags, mode);
+      }
+      if (fd == -1 && Path.first != -1) {
         fd = ::syscall(SYSCALL_DEF(openat), Path.first, Path.second, flags, mode);
       }
     }
@@ -760,7 +925,10 @@ uint64_t FileManager::Openat2(int dirfs, const char *pathname, FEX::HLE::open_ho
     if (fd == -1) {
       FDPathTmpData TmpFilename;
       auto Path = GetEmulatedFDPath(dirfs, SelfPath, true, TmpFilename);
-      if (Path.first != -1) {
+      if (Path.first == RootFSFD && how->resolve == 0) {
+        fd = OpenCachedRootFSFile(Path.second, how->flags, how->mode);
+      }
+      if (fd == -1 && Path.first != -1) {
         fd = ::syscall(SYSCALL_DEF(openat2), Path.first, Path.second, how, usize);
       }
     }
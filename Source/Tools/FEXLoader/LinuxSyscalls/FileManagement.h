@@ -7,6 +7,7 @@ $end_info$
 #pragma once
 #include <FEXCore/Config/Config.h>
 #include <FEXCore/fextl/map.h>
+#include <FEXCore/fextl/set.h>
 #include <FEXCore/fextl/string.h>
 #include <FEXCore/fextl/unordered_set.h>
 
@@ -16,6 +17,7 @@ $end_info$
 #include <mutex>
 #include <linux/limits.h>
 #include <optional>
+#include <shared_mutex>
 #include <stddef.h>
 #include <sys/stat.h>
 #include <unistd.h>
@@ -87,6 +89,9 @@ public:
 
 private:
   bool RootFSPathExists(const char* Filepath);
+  bool RootFSMayContain(const char *pathname) const;
+  bool LoadServerRootFSEntries();
+  int OpenCachedRootFSFile(const char *SubPath, int flags, uint32_t mode);
 
   struct ThunkDBObject {
     fextl::string LibraryName;
@@ -106,7 +111,33 @@ private:
   FEX_CONFIG_OPT(ThunkConfig, THUNKCONFIG);
   FEX_CONFIG_OPT(AppConfigName, APP_CONFIG_NAME);
   FEX_CONFIG_OPT(Is64BitMode, IS64BIT_MODE);
+  FEX_CONFIG_OPT(RootFSLookupCache, ROOTFSLOOKUPCACHE);
+  FEX_CONFIG_OPT(RootFSFileCache, ROOTFSFILECACHE);
   uint32_t CurrentPID{};
   int RootFSFD{AT_FDCWD};
+
+  // A RootFS image, like a FEXServer squashfs mount, can't change under us.
+  // Lookups against it get cached without any invalidation.
+  bool RootFSImmutable{};
+
+  // Top level entries of the RootFS, only filled when RootFSLookupCache is enabled or the RootFS is an image
+  fextl::set<fextl::string, std::less<>> RootFSTopLevelEntries;
+
+  // Guest path to RootFS relative path with symlinks followed, or ENOENT.
+  // Only used with a RootFS image.
+  struct ResolvedRootFSPath {
+    bool Exists;
+    fextl::string SubPath;
+  };
+  static constexpr size_t MaxResolvedPaths = 16384;
+  std::shared_mutex ResolvedPathsMutex;
+  fextl::map<fextl::string, ResolvedRootFSPath, std::less<>> ResolvedPaths;
+
+  // FEXServer's copies of RootFS shared libraries, only with the FEXServer's own RootFS mount
+  int RootFSCacheFD{-1};
+  // Requests share the FEXServer socket, a forked child must not read the parent's replies
+  pid_t RootFSCachePID{};
+  std::mutex RootFSCacheMutex;
+  fextl::set<fextl::string, std::less<>> UncachableRootFSFiles;
 };
 }
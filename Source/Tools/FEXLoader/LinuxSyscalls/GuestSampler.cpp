@@ -0,0 +1,380 @@
+/*
+$info$
+tags: LinuxSyscalls|common
+desc: Sampling profiler for guest code
+$end_info$
+*/
+
+#include "LinuxSyscalls/GuestSampler.h"
+#include "ArchHelpers/MContext.h"
+#include "Linux/Utils/ELFContainer.h"
+
+#include <FEXCore/Core/Context.h>
+#include <FEXCore/Core/CoreState.h>
+#include <FEXCore/Debug/InternalThreadState.h>
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/fextl/fmt.h>
+#include <FEXCore/fextl/map.h>
+#include <FEXCore/fextl/memory.h>
+#include <FEXCore/fextl/unordered_map.h>
+#include <FEXHeaderUtils/Syscalls.h>
+
+#include <algorithm>
+#include <charconv>
+#include <fcntl.h>
+#include <signal.h>
+#include <string.h>
+#include <string_view>
+#include <sys/mman.h>
+#include <syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace FEX::HLE {
+  struct GuestSampler::SampleTable {
+    // Power of two so a sample hashes with a multiply and shift
+    constexpr static size_t NUM_ENTRIES_LOG2 = 13;
+    constexpr static size_t NUM_ENTRIES = 1ULL << NUM_ENTRIES_LOG2;
+    constexpr static size_t MAX_PROBES = 16;
+    // Samples taken outside of JIT code are attributed to the guest RIP with this bit set
+    constexpr static uint64_t FEX_SAMPLE_BIT = 1ULL << 63;
+
+    struct Entry {
+      uint64_t RIP;
+      uint64_t Count;
+    };
+
+    Entry Entries[NUM_ENTRIES];
+    uint64_t Dropped;
+    int TimerID;
+    bool HasTimer;
+
+    void Add(uint64_t Key) {
+      const size_t Index = (Key * 0x9E37'79B9'7F4A'7C15ULL) >> (64 - NUM_ENTRIES_LOG2);
+      for (size_t i = 0; i < MAX_PROBES; ++i) {
+        auto &Entry = Entries[(Index + i) & (NUM_ENTRIES - 1)];
+        if (Entry.RIP == Key) {
+          ++Entry.Count;
+          return;
+        }
+        if (Entry.RIP == 0) {
+          Entry.RIP = Key;
+          Entry.Count = 1;
+          return;
+        }
+      }
+      ++Dropped;
+    }
+  };
+
+  static thread_local GuestSampler::SampleTable *ThreadTable{};
+
+  GuestSampler::GuestSampler(FEXCore::Context::Context *CTX, fextl::string OutputPath, uint32_t SampleRate)
+    : CTX {CTX}
+    , OutputPath {std::move(OutputPath)}
+    , SampleRate {std::clamp(SampleRate, 1U, 10000U)} {
+  }
+
+  GuestSampler::~GuestSampler() {
+    {
+      // Other threads may still be running at shutdown, stop them from sampling in to tables that are about to go away
+      std::scoped_lock lk(TablesMutex);
+      for (auto Table : Tables) {
+        StopTimer(Table);
+      }
+    }
+
+    WriteProfile();
+
+    for (auto Table : Tables) {
+      FEXCore::Allocator::munmap(Table, sizeof(SampleTable));
+    }
+  }
+
+  void GuestSampler::StartTimer(SampleTable *Table) {
+    // Sample on thread CPU time, idle threads cost nothing and blocked syscalls are never interrupted by a sample
+    sigevent Event{};
+    Event.sigev_notify = SIGEV_THREAD_ID;
+    Event.sigev_signo = SIGNAL_FOR_SAMPLE;
+    Event.sigev_value.sival_ptr = Table;
+    Event._sigev_un._tid = FHU::Syscalls::gettid();
+
+    if (::syscall(SYS_timer_create, CLOCK_THREAD_CPUTIME_ID, &Event, &Table->TimerID) != 0) {
+      LogMan::Msg::EFmt("GuestSampler: Couldn't create the sample timer: {}", strerror(errno));
+      return;
+    }
+    Table->HasTimer = true;
+
+    const long Period = 1'000'000'000L / SampleRate;
+    const itimerspec Spec {
+      .it_interval = {.tv_sec = Period / 1'000'000'000L, .tv_nsec = Period % 1'000'000'000L},
+      .it_value = {.tv_sec = Period / 1'000'000'000L, .tv_nsec = Period % 1'000'000'000L},
+    };
+    ::syscall(SYS_timer_settime, Table->TimerID, 0, &Spec, nullptr);
+  }
+
+  void GuestSampler::StopTimer(SampleTable *Table) {
+    // Deleting the timer also drops a sample that is still pending
+    if (Table->HasTimer) {
+      ::syscall(SYS_timer_delete, Table->TimerID);
+      Table->HasTimer = false;
+    }
+  }
+
+  void GuestSampler::RegisterThread() {
+    auto Table = reinterpret_cast<SampleTable*>(FEXCore::Allocator::mmap(nullptr, sizeof(SampleTable), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if (Table == MAP_FAILED) {
+      return;
+    }
+
+    std::scoped_lock lk(TablesMutex);
+    Tables.emplace_back(Table);
+    ThreadTable = Table;
+    StartTimer(Table);
+  }
+
+  void GuestSampler::UnregisterThread() {
+    auto Table = ThreadTable;
+    if (!Table) {
+      return;
+    }
+
+    std::scoped_lock lk(TablesMutex);
+    StopTimer(Table);
+    ThreadTable = nullptr;
+  }
+
+  bool GuestSampler::HandleSample(FEXCore::Core::InternalThreadState *Thread, void *Info, void *UContext) {
+    const auto SigInfo = reinterpret_cast<const siginfo_t*>(Info);
+    auto Table = ThreadTable;
+
+    // Anything other than our own timer is a real guest signal
+    if (!Table || SigInfo->si_code != SI_TIMER || SigInfo->si_value.sival_ptr != Table) {
+      return false;
+    }
+
+    const uint64_t PC = ArchHelpers::Context::GetPc(UContext);
+    if (Thread->CPUBackend->IsAddressInCodeBuffer(PC)) {
+      Table->Add(CTX->RestoreRIPFromHostPC(Thread, PC));
+    }
+    else {
+      // Compiling, handling a syscall or otherwise inside of FEX on behalf of the guest
+      Table->Add(Thread->CurrentFrame->State.rip | SampleTable::FEX_SAMPLE_BIT);
+    }
+
+    return true;
+  }
+
+  void GuestSampler::LockBeforeFork() {
+    TablesMutex.lock();
+  }
+
+  void GuestSampler::UnlockAfterFork(bool Child) {
+    if (Child) {
+      // Only the forking thread exists in the child and none of the parent's samples belong to it
+      for (auto Table : Tables) {
+        if (Table != ThreadTable) {
+          FEXCore::Allocator::munmap(Table, sizeof(SampleTable));
+        }
+      }
+      Tables.clear();
+
+      if (auto Table = ThreadTable) {
+        memset(Table, 0, sizeof(SampleTable));
+        Tables.emplace_back(Table);
+        StartTimer(Table);
+      }
+    }
+
+    TablesMutex.unlock();
+  }
+
+  namespace {
+    struct MappedFile {
+      uint64_t Begin;
+      uint64_t End;
+      uint64_t Offset;
+      std::string_view Path;
+    };
+
+    fextl::string ReadMaps() {
+      // procfs reports a zero file size, read until EOF
+      fextl::string Maps;
+      int FD = open("/proc/self/maps", O_RDONLY | O_CLOEXEC);
+      if (FD == -1) {
+        return Maps;
+      }
+
+      char Buffer[4096];
+      ssize_t Read;
+      while ((Read = read(FD, Buffer, sizeof(Buffer))) > 0) {
+        Maps.append(Buffer, Read);
+      }
+      close(FD);
+      return Maps;
+    }
+
+    fextl::vector<MappedFile> ParseMaps(std::string_view Maps) {
+      fextl::vector<MappedFile> Files;
+
+      while (!Maps.empty()) {
+        const auto LineEnd = Maps.find('\n');
+        auto Line = Maps.substr(0, LineEnd);
+        Maps = LineEnd == std::string_view::npos ? std::string_view{} : Maps.substr(LineEnd + 1);
+
+        // `begin-end perms offset dev inode path`
+        MappedFile File{};
+        const auto End = Line.data() + Line.size();
+        auto Result = std::from_chars(Line.data(), End, File.Begin, 16);
+        if (Result.ec != std::errc{} || Result.ptr == End) continue;
+        Result = std::from_chars(Result.ptr + 1, End, File.End, 16);
+        if (Result.ec != std::errc{}) continue;
+
+        // Skip the permissions
+        auto OffsetStart = Line.find(' ', Result.ptr - Line.data() + 1);
+        if (OffsetStart == std::string_view::npos) continue;
+        Result = std::from_chars(Line.data() + OffsetStart + 1, End, File.Offset, 16);
+        if (Result.ec != std::errc{}) continue;
+
+        auto PathStart = Line.find('/');
+        if (PathStart == std::string_view::npos) continue;
+        File.Path = Line.substr(PathStart);
+
+        Files.emplace_back(File);
+      }
+
+      return Files;
+    }
+
+    /**
+     * @brief Resolves guest addresses to ELF symbols of the files mapped at that address
+     *
+     * Each file is only parsed the first time a sample lands in it.
+     */
+    class SymbolResolver final {
+    public:
+      SymbolResolver(const fextl::vector<MappedFile> &Files)
+        : Files {Files} {
+        // The first mapping of a file is its load base
+        for (const auto &File : Files) {
+          if (File.Offset == 0) {
+            LoadBases.try_emplace(File.Path, File.Begin);
+          }
+        }
+      }
+
+      fextl::string GetFrame(uint64_t RIP) {
+        auto It = std::upper_bound(Files.begin(), Files.end(), RIP, [](uint64_t RIP, const MappedFile &File) {
+          return RIP < File.Begin;
+        });
+
+        if (It == Files.begin() || RIP >= std::prev(It)->End) {
+          return fextl::fmt::format("JIT_0x{:x}", RIP);
+        }
+
+        --It;
+        const auto Path = It->Path;
+        const auto Name = Path.substr(Path.find_last_of('/') + 1);
+
+        auto Container = GetContainer(Path);
+        auto Base = LoadBases.find(Path);
+        if (Container && Base != LoadBases.end()) {
+          // Non-PIE executables are linked at their first segment, everything else is linked at zero
+          const uint64_t LinkBase = std::get<0>(Container->GetLayout()) & ~0xFFFULL;
+          const uint64_t Address = RIP - Base->second + LinkBase;
+          auto Symbol = Container->GetSymbolInRange({Address, 1});
+          if (Symbol && Symbol->Address <= Address) {
+            return fextl::fmt::format("{};{}", Name, Symbol->Name);
+          }
+        }
+
+        return fextl::fmt::format("{};+0x{:x}", Name, RIP - It->Begin + It->Offset);
+      }
+
+    private:
+      const fextl::vector<MappedFile> &Files;
+      fextl::unordered_map<std::string_view, uint64_t> LoadBases;
+      fextl::unordered_map<std::string_view, fextl::unique_ptr<ELFLoader::ELFContainer>> Containers;
+
+      ELFLoader::ELFContainer *GetContainer(std::string_view Path) {
+        auto [It, Inserted] = Containers.try_emplace(Path);
+        if (Inserted) {
+          const fextl::string Filename {Path};
+          const auto Type = ELFLoader::ELFContainer::GetELFType(Filename);
+          if (Type == ELFLoader::ELFContainer::ELFType::TYPE_X86_64 ||
+              Type == ELFLoader::ELFContainer::ELFType::TYPE_X86_32) {
+            auto Container = fextl::make_unique<ELFLoader::ELFContainer>(Filename, fextl::string{}, true);
+            if (Container->WasLoaded()) {
+              It->second = std::move(Container);
+            }
+          }
+        }
+
+        return It->second.get();
+      }
+    };
+  }
+
+  void GuestSampler::WriteProfile() {
+    std::scoped_lock lk(TablesMutex);
+
+    // Merge every thread's samples
+    fextl::map<uint64_t, uint64_t> Samples;
+    uint64_t Dropped{};
+    for (auto Table : Tables) {
+      for (auto &Entry : Table->Entries) {
+        if (Entry.RIP) {
+          Samples[Entry.RIP] += Entry.Count;
+        }
+      }
+      Dropped += Table->Dropped;
+    }
+
+    if (Samples.empty()) {
+      return;
+    }
+
+    const auto MapsFile = ReadMaps();
+    const auto Files = ParseMaps(MapsFile);
+    SymbolResolver Resolver {Files};
+
+    // Folded stacks, the guest location followed by a FEX frame if the time wasn't spent in JIT code
+    fextl::map<fextl::string, uint64_t> Stacks;
+    for (auto [Key, Count] : Samples) {
+      auto Stack = Resolver.GetFrame(Key & ~SampleTable::FEX_SAMPLE_BIT);
+      if (Key & SampleTable::FEX_SAMPLE_BIT) {
+        Stack += ";[FEX]";
+      }
+      Stacks[Stack] += Count;
+    }
+
+    fextl::vector<std::pair<std::string_view, uint64_t>> Folded(Stacks.begin(), Stacks.end());
+    std::sort(Folded.begin(), Folded.end(), [](const auto &LHS, const auto &RHS) {
+      return LHS.second > RHS.second;
+    });
+
+    fextl::string Output;
+    for (const auto &[Stack, Count] : Folded) {
+      Output += fextl::fmt::format("{} {}\n", Stack, Count);
+    }
+
+    const auto Path = fextl::fmt::format("{}.{}", OutputPath, ::getpid());
+    int FD = open(Path.c_str(), O_CREAT | O_TRUNC | O_WRONLY | O_CLOEXEC, 0644);
+    if (FD == -1) {
+      LogMan::Msg::EFmt("GuestSampler: Couldn't open {}", Path);
+      return;
+    }
+
+    size_t Offset = 0;
+    while (Offset < Output.size()) {
+      auto Result = write(FD, Output.data() + Offset, Output.size() - Offset);
+      if (Result <= 0) {
+        break;
+      }
+      Offset += Result;
+    }
+    close(FD);
+
+    LogMan::Msg::IFmt("GuestSampler: Wrote {} stacks to {}, {} samples dropped", Folded.size(), Path, Dropped);
+  }
+}
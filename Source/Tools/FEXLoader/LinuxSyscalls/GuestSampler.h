@@ -0,0 +1,71 @@
+/*
+$info$
+tags: LinuxSyscalls|common
+$end_info$
+*/
+
+#pragma once
+
+#include <FEXCore/Utils/Allocator.h>
+#include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <mutex>
+#include <stdint.h>
+
+namespace FEXCore {
+namespace Context {
+  class Context;
+}
+namespace Core {
+  struct InternalThreadState;
+}
+}
+
+namespace FEX::HLE {
+  /**
+   * @brief Low overhead sampling profiler for guest code
+   *
+   * Every registered thread gets a timer on its own CPU time which delivers SIGNAL_FOR_SAMPLE.
+   * The signal handler maps the interrupted host PC back to a guest RIP and counts it in a fixed size
+   * per-thread table, nothing in signal context allocates or takes a lock.
+   *
+   * At shutdown the counts are resolved to guest ELF symbols, or file offsets when a symbol isn't available,
+   * and written out as folded stacks ready for flamegraph.pl.
+   */
+  class GuestSampler final : public FEXCore::Allocator::FEXAllocOperators {
+  public:
+    // One below SIGNAL_FOR_PAUSE, only reserved from the guest while sampling is enabled
+    constexpr static int SIGNAL_FOR_SAMPLE {62};
+
+    struct SampleTable;
+
+    GuestSampler(FEXCore::Context::Context *CTX, fextl::string OutputPath, uint32_t SampleRate);
+    ~GuestSampler();
+
+    // Starts and stops sampling the calling thread
+    void RegisterThread();
+    void UnregisterThread();
+
+    // Returns true if the signal was a sample of this thread
+    bool HandleSample(FEXCore::Core::InternalThreadState *Thread, void *Info, void *UContext);
+
+    // Timers aren't inherited over fork, the child only keeps sampling the forking thread
+    void LockBeforeFork();
+    void UnlockAfterFork(bool Child);
+
+    void WriteProfile();
+
+  private:
+    FEXCore::Context::Context *CTX;
+    fextl::string OutputPath;
+    uint32_t SampleRate;
+
+    // Tables of exited threads are kept so that their samples make it in to the profile
+    std::mutex TablesMutex;
+    fextl::vector<SampleTable*> Tables;
+
+    void StartTimer(SampleTable *Table);
+    void StopTimer(SampleTable *Table);
+  };
+}
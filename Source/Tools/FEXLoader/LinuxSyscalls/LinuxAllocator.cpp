@@ -1,4 +1,5 @@
 #include "LinuxSyscalls/LinuxAllocator.h"
+#include "LinuxSyscalls/PageBitmap.h"
 #include "LinuxSyscalls/Syscalls.h"
 
 #include <FEXCore/Utils/MathUtils.h>
@@ -7,7 +8,6 @@
 #include <FEXCore/fextl/map.h>
 #include <FEXCore/fextl/memory.h>
 
-#include <bitset>
 #include <linux/mman.h>
 #include <unistd.h>
 #include <sys/user.h>
@@ -28,11 +28,9 @@ private:
 public:
   MemAllocator32Bit() {
     // First 16 pages are taken by the Linux kernel
-    for (size_t i = 0; i < 16; ++i) {
-      MappedPages.set(i);
-    }
+    MappedPages.Set(0, 16);
     // Take the top page as well
-    MappedPages.set(TOP_KEY);
+    MappedPages.Set(TOP_KEY, 1);
     if (SearchDown) {
       LastScanLocation = TOP_KEY;
       LastKeyLocation = TOP_KEY;
@@ -57,24 +55,20 @@ public:
   // PagesLength is the number of pages
   void SetUsedPages(uint64_t PageAddr, size_t PagesLength) {
     // Set the range as mapped
-    for (size_t i = 0; i < PagesLength; ++i) {
-      MappedPages.set(PageAddr + i);
-    }
+    MappedPages.Set(PageAddr, PagesLength);
   }
 
   // PageAddr is a page already shifted to page index
   // PagesLength is the number of pages
   void SetFreePages(uint64_t PageAddr, size_t PagesLength) {
     // Set the range as unused
-    for (size_t i = 0; i < PagesLength; ++i) {
-      MappedPages.reset(PageAddr + i);
-    }
+    MappedPages.Reset(PageAddr, PagesLength);
   }
 
 private:
   // Set that contains 4k mapped pages
   // This is the full 32bit memory range
-  std::bitset<0x10'0000> MappedPages;
+  PageBitmap MappedPages;
   fextl::map<uint32_t, int> PageToShm{};
   uint64_t LastScanLocation{};
   uint64_t LastKeyLocation{};
@@ -87,50 +81,18 @@ private:
 };
 
 uint64_t MemAllocator32Bit::FindPageRange(uint64_t Start, size_t Pages) const {
-  // Linear range scan
-  while (Start != TOP_KEY) {
-    bool Free = true;
-    if ((Start + Pages) > TOP_KEY) {
-      return 0;
-    }
-    uint64_t Offset = 0;
-    for (; Offset < Pages; ++Offset) {
-      if (MappedPages.test(Start + Offset)) {
-        Free = false;
-        break;
-      }
-    }
-
-    if (Free) {
-      return Start;
-    }
-    Start += Offset + 1;
+  if (Start >= TOP_KEY) {
+    return 0;
   }
-
-  return 0;
+  return MappedPages.FindFreeRange(Start, TOP_KEY, Pages);
 }
 
 uint64_t MemAllocator32Bit::FindPageRange_TopDown(uint64_t Start, size_t Pages) const {
-  // Linear range scan
-  while (Start >= BASE_KEY &&
-         Start <= TOP_KEY) {
-    bool Free = true;
-
-    uint64_t Offset = 0;
-    for (; Offset < Pages; ++Offset) {
-      if (MappedPages.test(Start - Offset)) {
-        Free = false;
-        break;
-      }
-    }
-
-    if (Free) {
-      return Start - Offset;
-    }
-    Start -= Offset + 1;
+  if (Start < BASE_KEY ||
+      Start > TOP_KEY) {
+    return 0;
   }
-
-  return 0;
+  return MappedPages.FindFreeRangeTopDown(Start, BASE_KEY, Pages);
 }
 
 void *MemAllocator32Bit::Mmap(void *addr, size_t length, int prot, int flags, int fd, off_t offset) {
@@ -228,12 +190,12 @@ restart:
             return (void*)(uintptr_t)-errno;
           }
           else {
-            // Try again
+            // Something we don't track is in the way, try again just past the range that failed
             if (SearchDown) {
-              --BottomPage;
+              BottomPage = LowerPage - 1;
             }
             else {
-              ++BottomPage;
+              BottomPage = LowerPage + 1;
             }
             goto restart;
           }
@@ -312,20 +274,14 @@ int MemAllocator32Bit::Munmap(void *addr, size_t length) {
     return 0;
   }
 
-  while (PageAddr != PageEnd) {
-    // Always pass to munmap, it may be something allocated we aren't tracking
-    int Result = ::munmap(reinterpret_cast<void*>(PageAddr << FHU::FEX_PAGE_SHIFT), FHU::FEX_PAGE_SIZE);
-    if (Result != 0) {
-      return -errno;
-    }
-
-    if (MappedPages.test(PageAddr)) {
-      MappedPages.reset(PageAddr);
-    }
-
-    ++PageAddr;
+  // Always pass to munmap, it may be something allocated we aren't tracking
+  int Result = ::munmap(reinterpret_cast<void*>(PageAddr << FHU::FEX_PAGE_SHIFT), PagesLength << FHU::FEX_PAGE_SHIFT);
+  if (Result != 0) {
+    return -errno;
   }
 
+  SetFreePages(PageAddr, PageEnd - PageAddr);
+
   return 0;
 }
 
@@ -373,14 +329,7 @@ void *MemAllocator32Bit::Mremap(void *old_address, size_t old_size, size_t new_s
       }
       else {
         // Scan the region forward from our first region's endd to see if it can be extended
-        bool CanExtend{true};
-
-        for (size_t i = OldPagesLength; i < NewPagesLength; ++i) {
-          if (MappedPages[OldPageAddr + i]) {
-            CanExtend = false;
-            break;
-          }
-        }
+        bool CanExtend = MappedPages.IsRangeFree(OldPageAddr + OldPagesLength, NewPagesLength - OldPagesLength);
 
         if (CanExtend) {
           void *MappedPtr = ::mremap(old_address, old_size, new_size, flags & ~MREMAP_MAYMOVE);
@@ -523,8 +472,13 @@ restart:
             return -errno;
           }
           else {
-            // Try again
-            BottomPage += PagesLength;
+            // Try again just past the range that failed
+            if (SearchDown) {
+              BottomPage = LowerPage - 1;
+            }
+            else {
+              BottomPage = UpperPage;
+            }
             goto restart;
           }
         }
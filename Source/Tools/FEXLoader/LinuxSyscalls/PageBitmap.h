@@ -0,0 +1,181 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace FEX::HLE {
+// Bitmap of the mapped pages in the 32-bit address space.
+// A second level tracks which 64 page words are fully mapped so searches skip over dense regions
+// a word or 4096 pages at a time instead of testing every page.
+class PageBitmap final {
+public:
+  static constexpr uint64_t NumPages = 0x10'0000;
+
+  void Set(uint64_t Page, size_t Count) {
+    Apply(Page, Count, true);
+  }
+
+  void Reset(uint64_t Page, size_t Count) {
+    Apply(Page, Count, false);
+  }
+
+  bool IsRangeFree(uint64_t Page, size_t Count) const {
+    if (Page + Count > NumPages) {
+      return false;
+    }
+    return FindNextUsed(Page, Page + Count) == Page + Count;
+  }
+
+  // Returns the lowest page of the first free run of Count pages in [Start, End), or zero if there is none
+  uint64_t FindFreeRange(uint64_t Start, uint64_t End, size_t Count) const {
+    uint64_t Page = Start;
+    while (true) {
+      Page = FindNextFree(Page, End);
+      if (Page + Count > End) {
+        return 0;
+      }
+
+      const uint64_t Used = FindNextUsed(Page, Page + Count);
+      if (Used == Page + Count) {
+        return Page;
+      }
+      Page = Used;
+    }
+  }
+
+  // Returns the lowest page of the highest free run of Count pages in [Bottom, Top], or zero if there is none
+  uint64_t FindFreeRangeTopDown(uint64_t Top, uint64_t Bottom, size_t Count) const {
+    int64_t Page = Top;
+    while (true) {
+      Page = FindPrevFree(Page, Bottom);
+      const int64_t Lowest = Page - static_cast<int64_t>(Count) + 1;
+      if (Lowest < static_cast<int64_t>(Bottom)) {
+        return 0;
+      }
+
+      const int64_t Used = FindPrevUsed(Page, Lowest);
+      if (Used < Lowest) {
+        return Lowest;
+      }
+      Page = Used;
+    }
+  }
+
+private:
+  static constexpr size_t NumWords = NumPages / 64;
+  uint64_t Words[NumWords]{};
+  uint64_t FullWords[NumWords / 64]{};
+
+  // Mask of the bits up to and including Bit
+  static uint64_t MaskUpTo(uint64_t Bit) {
+    return (2ULL << Bit) - 1;
+  }
+
+  void Apply(uint64_t Page, size_t Count, bool Value) {
+    if (Page >= NumPages) {
+      return;
+    }
+    Count = std::min<uint64_t>(Count, NumPages - Page);
+
+    while (Count) {
+      const size_t Word = Page / 64;
+      const size_t Bit = Page % 64;
+      const size_t Bits = std::min<size_t>(64 - Bit, Count);
+      const uint64_t Mask = (Bits == 64 ? ~0ULL : ((1ULL << Bits) - 1)) << Bit;
+
+      if (Value) {
+        Words[Word] |= Mask;
+      }
+      else {
+        Words[Word] &= ~Mask;
+      }
+
+      if (Words[Word] == ~0ULL) {
+        FullWords[Word / 64] |= 1ULL << (Word % 64);
+      }
+      else {
+        FullWords[Word / 64] &= ~(1ULL << (Word % 64));
+      }
+
+      Page += Bits;
+      Count -= Bits;
+    }
+  }
+
+  // First free page in [Page, End), or End
+  uint64_t FindNextFree(uint64_t Page, uint64_t End) const {
+    while (Page < End) {
+      size_t Word = Page / 64;
+      const uint64_t Free = ~Words[Word] & (~0ULL << (Page % 64));
+      if (Free) {
+        return std::min<uint64_t>(Word * 64 + std::countr_zero(Free), End);
+      }
+
+      // Skip over full words
+      ++Word;
+      while (Word < NumWords) {
+        const uint64_t NotFull = ~FullWords[Word / 64] & (~0ULL << (Word % 64));
+        if (NotFull) {
+          Word = (Word & ~63ULL) + std::countr_zero(NotFull);
+          break;
+        }
+        Word = (Word & ~63ULL) + 64;
+      }
+      Page = Word * 64;
+    }
+    return End;
+  }
+
+  // First used page in [Page, End), or End
+  uint64_t FindNextUsed(uint64_t Page, uint64_t End) const {
+    while (Page < End) {
+      const size_t Word = Page / 64;
+      const uint64_t Used = Words[Word] & (~0ULL << (Page % 64));
+      if (Used) {
+        return std::min<uint64_t>(Word * 64 + std::countr_zero(Used), End);
+      }
+      Page = (Word + 1) * 64;
+    }
+    return End;
+  }
+
+  // Last free page in [Bottom, Page], or Bottom - 1
+  int64_t FindPrevFree(int64_t Page, int64_t Bottom) const {
+    while (Page >= Bottom) {
+      int64_t Word = Page / 64;
+      const uint64_t Free = ~Words[Word] & MaskUpTo(Page % 64);
+      if (Free) {
+        return std::max<int64_t>(Word * 64 + 63 - std::countl_zero(Free), Bottom - 1);
+      }
+
+      // Skip over full words
+      --Word;
+      while (Word >= 0) {
+        const uint64_t NotFull = ~FullWords[Word / 64] & MaskUpTo(Word % 64);
+        if (NotFull) {
+          Word = (Word & ~63LL) + 63 - std::countl_zero(NotFull);
+          break;
+        }
+        Word = (Word & ~63LL) - 1;
+      }
+      Page = Word * 64 + 63;
+    }
+    return Bottom - 1;
+  }
+
+  // Last used page in [Bottom, Page], or Bottom - 1
+  int64_t FindPrevUsed(int64_t Page, int64_t Bottom) const {
+    while (Page >= Bottom) {
+      const int64_t Word = Page / 64;
+      const uint64_t Used = Words[Word] & MaskUpTo(Page % 64);
+      if (Used) {
+        return std::max<int64_t>(Word * 64 + 63 - std::countl_zero(Used), Bottom - 1);
+      }
+      Page = Word * 64 - 1;
+    }
+    return Bottom - 1;
+  }
+};
+} // namespace FEX::HLE
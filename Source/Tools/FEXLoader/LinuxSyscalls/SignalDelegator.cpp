@@ -16,6 +16,7 @@ $end_info$
 #include <FEXCore/Utils/Allocator.h>
 #include <FEXCore/Utils/LogManager.h>
 #include <FEXCore/Utils/MathUtils.h>
+#include <FEXCore/Utils/Telemetry.h>
 #include <FEXCore/Utils/ArchHelpers/Arm64.h>
 #include <FEXHeaderUtils/Syscalls.h>
 
@@ -63,11 +64,19 @@ namespace FEX::HLE {
       .ss_size = 0,
     };
     // This is the thread's current signal mask
+    // Only emulated, the host mask is left alone unless a masked signal arrives
     GuestSAMask CurrentSignalMask{};
     // The mask prior to a suspend
     GuestSAMask PreviousSuspendMask{};
 
+    // Signals that arrived while the guest had them masked and the siginfo they arrived with
     uint64_t PendingSignals{};
+    siginfo_t PendingSignalInfo[SignalDelegator::MAX_SIGNALS]{};
+
+    // Signals the host kernel is blocking for this thread, or will block before the thread's next syscall.
+    // The second part is CpuStateFrame::PendingHostSignalMask.
+    // Can overstate the real mask but never understate it.
+    uint64_t HostSignalMask{};
   };
 
   thread_local ThreadState ThreadData{};
@@ -76,6 +85,34 @@ namespace FEX::HLE {
     GlobalDelegator->HandleSignal(Signal, Info, UContext);
   }
 
+  // Only tgkill and timers can target a thread, anything else was sent to the whole process.
+  // A timer can't be told apart from one created with SIGEV_THREAD_ID, so it stays on this thread.
+  static bool IsThreadDirectedSignal(const siginfo_t *Info) {
+    return Info->si_code == SI_TKILL || Info->si_code == SI_TIMER;
+  }
+
+  // Hands a process directed signal back to the kernel with its original siginfo, any thread that doesn't block it can take it
+  static void QueueProcessSignal(FEXCore::Core::InternalThreadState *Thread, int Signal, siginfo_t *Info) {
+    if (::syscall(SYS_rt_sigqueueinfo, Thread->ThreadManager.GetPID(), Signal, Info) == -1) {
+      // Only the thread group leader may queue siginfo claiming to come from kill() or the kernel.
+      // Other threads have to fall back to kill(), which loses the original sender.
+      ::kill(Thread->ThreadManager.GetPID(), Signal);
+    }
+  }
+
+  // Hands held thread directed signals back to the kernel with their original siginfo
+  static void RequeuePendingSignals(FEXCore::Core::InternalThreadState *Thread, uint64_t Signals) {
+    Signals &= ThreadData.PendingSignals;
+    ThreadData.PendingSignals &= ~Signals;
+
+    for (int i = 0; Signals != 0; ++i) {
+      if (Signals & (1ULL << i)) {
+        Signals &= ~(1ULL << i);
+        ::syscall(SYS_rt_tgsigqueueinfo, Thread->ThreadManager.GetPID(), Thread->ThreadManager.GetTID(), i + 1, &ThreadData.PendingSignalInfo[i]);
+      }
+    }
+  }
+
   uint64_t SigIsMember(GuestSAMask *Set, int Signal) {
     // Signal 0 isn't real, so everything is offset by one inside the set
     Signal -= 1;
@@ -226,6 +263,114 @@ namespace FEX::HLE {
     }
   }
 
+  // The YMM upper halves only get written to the frame when they aren't all zero.
+  // Like XSAVE's init optimization, the YMM bit in the xstate header says if the area is valid.
+  // Signals that arrive while only SSE code is running skip copying the upper halves.
+  template <typename T>
+  static void StoreYMMUpperState(T* xstate, const FEXCore::Core::CPUState &State) {
+    uint64_t Live{};
+    for (const auto &Reg : State.xmm.avx.data) {
+      Live |= Reg[2] | Reg[3];
+    }
+
+    if (!Live) {
+      return;
+    }
+
+    xstate->xstate_hdr.xfeatures |= FEXCore::x86_64::fpx_sw_bytes::FEATURE_YMM;
+    for (size_t i = 0; i < std::size(State.xmm.avx.data); i++) {
+      memcpy(&xstate->ymmh.ymmh_space[i], &State.xmm.avx.data[i][2], sizeof(__uint128_t));
+    }
+  }
+
+  template <typename T>
+  static void LoadYMMUpperState(FEXCore::Core::CPUState &State, const T* xstate) {
+    if (!(xstate->xstate_hdr.xfeatures & FEXCore::x86_64::fpx_sw_bytes::FEATURE_YMM)) {
+      // YMM was in its init state, the ymmh area isn't valid
+      for (auto &Reg : State.xmm.avx.data) {
+        Reg[2] = Reg[3] = 0;
+      }
+      return;
+    }
+
+    for (size_t i = 0; i < std::size(State.xmm.avx.data); i++) {
+      memcpy(&State.xmm.avx.data[i][2], &xstate->ymmh.ymmh_space[i], sizeof(__uint128_t));
+    }
+  }
+
+  // The FP and SSE components get the same treatment as YMM in the xstate header, their bits are only set when they
+  // aren't in their init state. The legacy area is always written like the kernel's XSAVE does, so readers that
+  // ignore the header still see the right values, but sigreturn only loads the components marked live.
+  static bool IsX87InitState(const FEXCore::Core::CPUState &State) {
+    if (State.FCW != 0x37F || State.FTW != 0xFFFF ||
+        State.flags[FEXCore::X86State::X87FLAG_C0_LOC] ||
+        State.flags[FEXCore::X86State::X87FLAG_C1_LOC] ||
+        State.flags[FEXCore::X86State::X87FLAG_C2_LOC] ||
+        State.flags[FEXCore::X86State::X87FLAG_C3_LOC] ||
+        State.flags[FEXCore::X86State::X87FLAG_TOP_LOC]) {
+      return false;
+    }
+
+    uint64_t Live{};
+    for (const auto &Reg : State.mm) {
+      Live |= Reg[0] | Reg[1];
+    }
+    return !Live;
+  }
+
+  static void SetX87InitState(FEXCore::Core::CPUState &State) {
+    memset(State.mm, 0, sizeof(State.mm));
+    State.FCW = 0x37F;
+    State.FTW = 0xFFFF;
+    State.flags[FEXCore::X86State::X87FLAG_C0_LOC] = 0;
+    State.flags[FEXCore::X86State::X87FLAG_C1_LOC] = 0;
+    State.flags[FEXCore::X86State::X87FLAG_C2_LOC] = 0;
+    State.flags[FEXCore::X86State::X87FLAG_C3_LOC] = 0;
+    State.flags[FEXCore::X86State::X87FLAG_TOP_LOC] = 0;
+  }
+
+  // Only valid with AVX enabled, where the xmm registers live in the lower halves of the avx state
+  static uint32_t GetLegacyXFeatures(const FEXCore::Core::CPUState &State, uint32_t MXCSR) {
+    uint32_t XFeatures{};
+    if (!IsX87InitState(State)) {
+      XFeatures |= FEXCore::x86_64::fpx_sw_bytes::FEATURE_FP;
+    }
+
+    uint64_t Live = MXCSR ^ 0x1F80;
+    for (const auto &Reg : State.xmm.avx.data) {
+      Live |= Reg[0] | Reg[1];
+    }
+
+    if (Live) {
+      XFeatures |= FEXCore::x86_64::fpx_sw_bytes::FEATURE_SSE;
+    }
+    return XFeatures;
+  }
+
+  // Without AVX there is no xstate header and everything is always loaded
+  template <typename T>
+  static uint32_t GetXStateFeatures(const T* xstate, bool is_avx_enabled) {
+    if (!is_avx_enabled) {
+      return FEXCore::x86_64::fpx_sw_bytes::FEATURE_FP | FEXCore::x86_64::fpx_sw_bytes::FEATURE_SSE;
+    }
+    return xstate->xstate_hdr.xfeatures;
+  }
+
+  template <typename T>
+  static void LoadSSEState(FEXCore::Core::CPUState &State, const T* xstate, uint32_t XFeatures) {
+    if (!(XFeatures & FEXCore::x86_64::fpx_sw_bytes::FEATURE_SSE)) {
+      // Like XRSTOR, a component that isn't marked gets its init state. MXCSR is loaded regardless.
+      for (auto &Reg : State.xmm.avx.data) {
+        Reg[0] = Reg[1] = 0;
+      }
+      return;
+    }
+
+    for (size_t i = 0; i < FEXCore::Core::CPUState::NUM_XMMS; i++) {
+      memcpy(&State.xmm.avx.data[i][0], &xstate->fpstate._xmm[i], sizeof(__uint128_t));
+    }
+  }
+
   ArchHelpers::Context::ContextBackup* SignalDelegator::StoreThreadState(FEXCore::Core::InternalThreadState *Thread, int Signal, void *ucontext) {
     // We can end up getting a signal at any point in our host state
     // Jump to a handler that saves all state so we can safely return
@@ -247,6 +392,7 @@ namespace FEX::HLE {
 
     // Retain the action pointer so we can see it when we return
     Context->Signal = Signal;
+    Context->GuestSigMask = ThreadData.CurrentSignalMask.Val;
 
     // Save guest state
     // We can't guarantee if registers are in context or host GPRs
@@ -352,6 +498,19 @@ namespace FEX::HLE {
     // Restore host state
     ArchHelpers::Context::RestoreContext(ucontext, Context);
 
+    // Restore the guest signal mask, this can unmask signals that were held while the guest handler ran.
+    // They are blocked until we return from this host signal handler and then delivered to the restored context.
+    ThreadData.CurrentSignalMask.Val = Context->GuestSigMask;
+    uint64_t HostMask = Context->sa_mask;
+    const uint64_t Unmasked = ThreadData.PendingSignals & ~ThreadData.CurrentSignalMask.Val;
+    if (Unmasked) {
+      ::syscall(SYS_rt_sigprocmask, SIG_BLOCK, &Unmasked, nullptr, 8);
+      RequeuePendingSignals(Thread, Unmasked);
+      HostMask &= ~Unmasked;
+      memcpy(&ArchHelpers::Context::GetUContext(ucontext)->uc_sigmask, &HostMask, sizeof(uint64_t));
+    }
+    SetHostSignalMask(Thread, HostMask);
+
     // Reset the guest state
     memcpy(&Thread->CurrentFrame->State, &Context->GuestState, sizeof(FEXCore::Core::CPUState));
 
@@ -400,12 +559,7 @@ namespace FEX::HLE {
       Frame->State.rip = guest_uctx->uc_mcontext.gregs[FEXCore::x86_64::FEX_REG_RIP];
       // XXX: Full context setting
       uint32_t eflags = guest_uctx->uc_mcontext.gregs[FEXCore::x86_64::FEX_REG_EFL];
-      for (size_t i = 0; i < FEXCore::Core::CPUState::NUM_EFLAG_BITS; ++i) {
-        Frame->State.flags[i] = (eflags & (1U << i)) ? 1 : 0;
-      }
-
-      Frame->State.flags[1] = 1;
-      Frame->State.flags[9] = 1;
+      CTX->SetFlagsFromCompactedEFLAGS(&Frame->State, eflags);
 
 #define COPY_REG(x) \
           Frame->State.gregs[FEXCore::X86State::REG_##x] = guest_uctx->uc_mcontext.gregs[FEXCore::x86_64::FEX_REG_##x];
@@ -429,30 +583,35 @@ namespace FEX::HLE {
       auto *xstate = reinterpret_cast<FEXCore::x86_64::xstate*>(guest_uctx->uc_mcontext.fpregs);
       auto *fpstate = &xstate->fpstate;
 
-      // Copy float registers
-      memcpy(Frame->State.mm, fpstate->_st, sizeof(Frame->State.mm));
+      const uint32_t XFeatures = GetXStateFeatures(xstate, IsAVXEnabled);
+
+      if (XFeatures & FEXCore::x86_64::fpx_sw_bytes::FEATURE_FP) {
+        // Copy float registers
+        memcpy(Frame->State.mm, fpstate->_st, sizeof(Frame->State.mm));
+
+        // FCW store default
+        Frame->State.FCW = fpstate->fcw;
+        Frame->State.FTW = fpstate->ftw;
+
+        // Deconstruct FSW
+        Frame->State.flags[FEXCore::X86State::X87FLAG_C0_LOC] = (fpstate->fsw >> 8) & 1;
+        Frame->State.flags[FEXCore::X86State::X87FLAG_C1_LOC] = (fpstate->fsw >> 9) & 1;
+        Frame->State.flags[FEXCore::X86State::X87FLAG_C2_LOC] = (fpstate->fsw >> 10) & 1;
+        Frame->State.flags[FEXCore::X86State::X87FLAG_C3_LOC] = (fpstate->fsw >> 14) & 1;
+        Frame->State.flags[FEXCore::X86State::X87FLAG_TOP_LOC] = (fpstate->fsw >> 11) & 0b111;
+      }
+      else {
+        SetX87InitState(Frame->State);
+      }
 
       if (IsAVXEnabled) {
-        for (size_t i = 0; i < FEXCore::Core::CPUState::NUM_XMMS; i++) {
-          memcpy(&Frame->State.xmm.avx.data[i][0], &fpstate->_xmm[i], sizeof(__uint128_t));
-        }
-        for (size_t i = 0; i < FEXCore::Core::CPUState::NUM_XMMS; i++) {
-          memcpy(&Frame->State.xmm.avx.data[i][2], &xstate->ymmh.ymmh_space[i], sizeof(__uint128_t));
-        }
+        LoadSSEState(Frame->State, xstate, XFeatures);
+        LoadYMMUpperState(Frame->State, xstate);
       } else {
         memcpy(Frame->State.xmm.sse.data, fpstate->_xmm, sizeof(Frame->State.xmm.sse.data));
       }
 
-      // FCW store default
-      Frame->State.FCW = fpstate->fcw;
-      Frame->State.FTW = fpstate->ftw;
-
-      // Deconstruct FSW
-      Frame->State.flags[FEXCore::X86State::X87FLAG_C0_LOC] = (fpstate->fsw >> 8) & 1;
-      Frame->State.flags[FEXCore::X86State::X87FLAG_C1_LOC] = (fpstate->fsw >> 9) & 1;
-      Frame->State.flags[FEXCore::X86State::X87FLAG_C2_LOC] = (fpstate->fsw >> 10) & 1;
-      Frame->State.flags[FEXCore::X86State::X87FLAG_C3_LOC] = (fpstate->fsw >> 14) & 1;
-      Frame->State.flags[FEXCore::X86State::X87FLAG_TOP_LOC] = (fpstate->fsw >> 11) & 0b111;
+      ArchHelpers::Context::SetGuestMXCSR(ucontext, fpstate->mxcsr, Config.SupportsFlushInputsToZero);
     }
   }
 
@@ -475,12 +634,7 @@ namespace FEX::HLE {
       // XXX: Full context setting
       // First 32-bytes of flags is EFLAGS broken out
       uint32_t eflags = guest_uctx->sc.flags;
-      for (size_t i = 0; i < FEXCore::Core::CPUState::NUM_EFLAG_BITS; ++i) {
-        Frame->State.flags[i] = (eflags & (1U << i)) ? 1 : 0;
-      }
-
-      Frame->State.flags[1] = 1;
-      Frame->State.flags[9] = 1;
+      CTX->SetFlagsFromCompactedEFLAGS(&Frame->State, eflags);
 
       Frame->State.rip = guest_uctx->sc.ip;
       Frame->State.cs_idx = guest_uctx->sc.cs;
@@ -511,34 +665,38 @@ namespace FEX::HLE {
       auto *xstate = reinterpret_cast<FEXCore::x86::xstate*>(guest_uctx->sc.fpstate);
       auto *fpstate = &xstate->fpstate;
 
-      // Copy float registers
-      for (size_t i = 0; i < FEXCore::Core::CPUState::NUM_MMS; ++i) {
-        // 32-bit st register size is only 10 bytes. Not padded to 16byte like x86-64
-        memcpy(&Frame->State.mm[i], &fpstate->_st[i], 10);
+      const uint32_t XFeatures = GetXStateFeatures(xstate, IsAVXEnabled);
+
+      if (XFeatures & FEXCore::x86_64::fpx_sw_bytes::FEATURE_FP) {
+        // Copy float registers
+        for (size_t i = 0; i < FEXCore::Core::CPUState::NUM_MMS; ++i) {
+          // 32-bit st register size is only 10 bytes. Not padded to 16byte like x86-64
+          memcpy(&Frame->State.mm[i], &fpstate->_st[i], 10);
+        }
+
+        // FCW store default
+        Frame->State.FCW = fpstate->fcw;
+        Frame->State.FTW = fpstate->ftw;
+
+        // Deconstruct FSW
+        Frame->State.flags[FEXCore::X86State::X87FLAG_C0_LOC] = (fpstate->fsw >> 8) & 1;
+        Frame->State.flags[FEXCore::X86State::X87FLAG_C1_LOC] = (fpstate->fsw >> 9) & 1;
+        Frame->State.flags[FEXCore::X86State::X87FLAG_C2_LOC] = (fpstate->fsw >> 10) & 1;
+        Frame->State.flags[FEXCore::X86State::X87FLAG_C3_LOC] = (fpstate->fsw >> 14) & 1;
+        Frame->State.flags[FEXCore::X86State::X87FLAG_TOP_LOC] = (fpstate->fsw >> 11) & 0b111;
+      }
+      else {
+        SetX87InitState(Frame->State);
       }
 
-      // Extended XMM state
       if (IsAVXEnabled) {
-        for (size_t i = 0; i < FEXCore::Core::CPUState::NUM_XMMS; i++) {
-          memcpy(&Frame->State.xmm.avx.data[i][0], &fpstate->_xmm[i], sizeof(__uint128_t));
-        }
-        for (size_t i = 0; i < FEXCore::Core::CPUState::NUM_XMMS; i++) {
-          memcpy(&Frame->State.xmm.avx.data[i][2], &xstate->ymmh.ymmh_space[i], sizeof(__uint128_t));
-        }
+        LoadSSEState(Frame->State, xstate, XFeatures);
+        LoadYMMUpperState(Frame->State, xstate);
       } else {
         memcpy(Frame->State.xmm.sse.data, fpstate->_xmm, sizeof(Frame->State.xmm.sse.data));
       }
 
-      // FCW store default
-      Frame->State.FCW = fpstate->fcw;
-      Frame->State.FTW = fpstate->ftw;
-
-      // Deconstruct FSW
-      Frame->State.flags[FEXCore::X86State::X87FLAG_C0_LOC] = (fpstate->fsw >> 8) & 1;
-      Frame->State.flags[FEXCore::X86State::X87FLAG_C1_LOC] = (fpstate->fsw >> 9) & 1;
-      Frame->State.flags[FEXCore::X86State::X87FLAG_C2_LOC] = (fpstate->fsw >> 10) & 1;
-      Frame->State.flags[FEXCore::X86State::X87FLAG_C3_LOC] = (fpstate->fsw >> 14) & 1;
-      Frame->State.flags[FEXCore::X86State::X87FLAG_TOP_LOC] = (fpstate->fsw >> 11) & 0b111;
+      ArchHelpers::Context::SetGuestMXCSR(ucontext, fpstate->mxcsr, Config.SupportsFlushInputsToZero);
     }
   }
 
@@ -562,12 +720,7 @@ namespace FEX::HLE {
       // XXX: Full context setting
       // First 32-bytes of flags is EFLAGS broken out
       uint32_t eflags = guest_uctx->uc.uc_mcontext.gregs[FEXCore::x86::FEX_REG_EFL];
-      for (size_t i = 0; i < FEXCore::Core::CPUState::NUM_EFLAG_BITS; ++i) {
-        Frame->State.flags[i] = (eflags & (1U << i)) ? 1 : 0;
-      }
-
-      Frame->State.flags[1] = 1;
-      Frame->State.flags[9] = 1;
+      CTX->SetFlagsFromCompactedEFLAGS(&Frame->State, eflags);
 
       Frame->State.rip = guest_uctx->uc.uc_mcontext.gregs[FEXCore::x86::FEX_REG_EIP];
       Frame->State.cs_idx = guest_uctx->uc.uc_mcontext.gregs[FEXCore::x86::FEX_REG_CS];
@@ -598,34 +751,38 @@ namespace FEX::HLE {
       auto *xstate = reinterpret_cast<FEXCore::x86::xstate*>(guest_uctx->uc.uc_mcontext.fpregs);
       auto *fpstate = &xstate->fpstate;
 
-      // Copy float registers
-      for (size_t i = 0; i < FEXCore::Core::CPUState::NUM_MMS; ++i) {
-        // 32-bit st register size is only 10 bytes. Not padded to 16byte like x86-64
-        memcpy(&Frame->State.mm[i], &fpstate->_st[i], 10);
+      const uint32_t XFeatures = GetXStateFeatures(xstate, IsAVXEnabled);
+
+      if (XFeatures & FEXCore::x86_64::fpx_sw_bytes::FEATURE_FP) {
+        // Copy float registers
+        for (size_t i = 0; i < FEXCore::Core::CPUState::NUM_MMS; ++i) {
+          // 32-bit st register size is only 10 bytes. Not padded to 16byte like x86-64
+          memcpy(&Frame->State.mm[i], &fpstate->_st[i], 10);
+        }
+
+        // FCW store default
+        Frame->State.FCW = fpstate->fcw;
+        Frame->State.FTW = fpstate->ftw;
+
+        // Deconstruct FSW
+        Frame->State.flags[FEXCore::X86State::X87FLAG_C0_LOC] = (fpstate->fsw >> 8) & 1;
+        Frame->State.flags[FEXCore::X86State::X87FLAG_C1_LOC] = (fpstate->fsw >> 9) & 1;
+        Frame->State.flags[FEXCore::X86State::X87FLAG_C2_LOC] = (fpstate->fsw >> 10) & 1;
+        Frame->State.flags[FEXCore::X86State::X87FLAG_C3_LOC] = (fpstate->fsw >> 14) & 1;
+        Frame->State.flags[FEXCore::X86State::X87FLAG_TOP_LOC] = (fpstate->fsw >> 11) & 0b111;
+      }
+      else {
+        SetX87InitState(Frame->State);
       }
 
-      // Extended XMM state
       if (IsAVXEnabled) {
-        for (size_t i = 0; i < FEXCore::Core::CPUState::NUM_XMMS; i++) {
-          memcpy(&Frame->State.xmm.avx.data[i][0], &fpstate->_xmm[i], sizeof(__uint128_t));
-        }
-        for (size_t i = 0; i < FEXCore::Core::CPUState::NUM_XMMS; i++) {
-          memcpy(&Frame->State.xmm.avx.data[i][2], &xstate->ymmh.ymmh_space[i], sizeof(__uint128_t));
-        }
+        LoadSSEState(Frame->State, xstate, XFeatures);
+        LoadYMMUpperState(Frame->State, xstate);
       } else {
         memcpy(Frame->State.xmm.sse.data, fpstate->_xmm, sizeof(Frame->State.xmm.sse.data));
       }
 
-      // FCW store default
-      Frame->State.FCW = fpstate->fcw;
-      Frame->State.FTW = fpstate->ftw;
-
-      // Deconstruct FSW
-      Frame->State.flags[FEXCore::X86State::X87FLAG_C0_LOC] = (fpstate->fsw >> 8) & 1;
-      Frame->State.flags[FEXCore::X86State::X87FLAG_C1_LOC] = (fpstate->fsw >> 9) & 1;
-      Frame->State.flags[FEXCore::X86State::X87FLAG_C2_LOC] = (fpstate->fsw >> 10) & 1;
-      Frame->State.flags[FEXCore::X86State::X87FLAG_C3_LOC] = (fpstate->fsw >> 14) & 1;
-      Frame->State.flags[FEXCore::X86State::X87FLAG_TOP_LOC] = (fpstate->fsw >> 11) & 0b111;
+      ArchHelpers::Context::SetGuestMXCSR(ucontext, fpstate->mxcsr, Config.SupportsFlushInputsToZero);
     }
   }
 
@@ -745,9 +902,7 @@ namespace FEX::HLE {
       for (size_t i = 0; i < FEXCore::Core::CPUState::NUM_XMMS; i++) {
         memcpy(&fpstate->_xmm[i], &Frame->State.xmm.avx.data[i][0], sizeof(__uint128_t));
       }
-      for (size_t i = 0; i < FEXCore::Core::CPUState::NUM_XMMS; i++) {
-        memcpy(&xstate->ymmh.ymmh_space[i], &Frame->State.xmm.avx.data[i][2], sizeof(__uint128_t));
-      }
+      StoreYMMUpperState(xstate, Frame->State);
     } else {
       memcpy(fpstate->_xmm, Frame->State.xmm.sse.data, sizeof(Frame->State.xmm.sse.data));
     }
@@ -755,6 +910,7 @@ namespace FEX::HLE {
     // FCW store default
     fpstate->fcw = Frame->State.FCW;
     fpstate->ftw = Frame->State.FTW;
+    fpstate->mxcsr = ArchHelpers::Context::GetGuestMXCSR(ContextBackup);
 
     // Reconstruct FSW
     fpstate->fsw =
@@ -764,6 +920,10 @@ namespace FEX::HLE {
       (Frame->State.flags[FEXCore::X86State::X87FLAG_C2_LOC] << 10) |
       (Frame->State.flags[FEXCore::X86State::X87FLAG_C3_LOC] << 14);
 
+    if (IsAVXEnabled) {
+      xstate->xstate_hdr.xfeatures |= GetLegacyXFeatures(Frame->State, fpstate->mxcsr);
+    }
+
     // Copy over signal stack information
     guest_uctx->uc_stack.ss_flags = GuestStack->ss_flags;
     guest_uctx->uc_stack.ss_sp = GuestStack->ss_sp;
@@ -879,9 +1039,7 @@ namespace FEX::HLE {
       for (size_t i = 0; i < std::size(Frame->State.xmm.avx.data); i++) {
         memcpy(&fpstate->_xmm[i], &Frame->State.xmm.avx.data[i][0], sizeof(__uint128_t));
       }
-      for (size_t i = 0; i < std::size(Frame->State.xmm.avx.data); i++) {
-        memcpy(&xstate->ymmh.ymmh_space[i], &Frame->State.xmm.avx.data[i][2], sizeof(__uint128_t));
-      }
+      StoreYMMUpperState(xstate, Frame->State);
     } else {
       memcpy(fpstate->_xmm, Frame->State.xmm.sse.data, sizeof(Frame->State.xmm.sse.data));
     }
@@ -889,6 +1047,7 @@ namespace FEX::HLE {
     // FCW store default
     fpstate->fcw = Frame->State.FCW;
     fpstate->ftw = Frame->State.FTW;
+    fpstate->mxcsr = ArchHelpers::Context::GetGuestMXCSR(ContextBackup);
     // Reconstruct FSW
     fpstate->fsw =
       (Frame->State.flags[FEXCore::X86State::X87FLAG_TOP_LOC] << 11) |
@@ -897,6 +1056,10 @@ namespace FEX::HLE {
       (Frame->State.flags[FEXCore::X86State::X87FLAG_C2_LOC] << 10) |
       (Frame->State.flags[FEXCore::X86State::X87FLAG_C3_LOC] << 14);
 
+    if (IsAVXEnabled) {
+      xstate->xstate_hdr.xfeatures |= GetLegacyXFeatures(Frame->State, fpstate->mxcsr);
+    }
+
     // Curiously non-rt signals don't support altstack. So that state doesn't exist here.
 
     // Copy over the signal information.
@@ -1026,9 +1189,7 @@ namespace FEX::HLE {
       for (size_t i = 0; i < std::size(Frame->State.xmm.avx.data); i++) {
         memcpy(&fpstate->_xmm[i], &Frame->State.xmm.avx.data[i][0], sizeof(__uint128_t));
       }
-      for (size_t i = 0; i < std::size(Frame->State.xmm.avx.data); i++) {
-        memcpy(&xstate->ymmh.ymmh_space[i], &Frame->State.xmm.avx.data[i][2], sizeof(__uint128_t));
-      }
+      StoreYMMUpperState(xstate, Frame->State);
     } else {
       memcpy(fpstate->_xmm, Frame->State.xmm.sse.data, sizeof(Frame->State.xmm.sse.data));
     }
@@ -1036,6 +1197,7 @@ namespace FEX::HLE {
     // FCW store default
     fpstate->fcw = Frame->State.FCW;
     fpstate->ftw = Frame->State.FTW;
+    fpstate->mxcsr = ArchHelpers::Context::GetGuestMXCSR(ContextBackup);
     // Reconstruct FSW
     fpstate->fsw =
       (Frame->State.flags[FEXCore::X86State::X87FLAG_TOP_LOC] << 11) |
@@ -1044,6 +1206,10 @@ namespace FEX::HLE {
       (Frame->State.flags[FEXCore::X86State::X87FLAG_C2_LOC] << 10) |
       (Frame->State.flags[FEXCore::X86State::X87FLAG_C3_LOC] << 14);
 
+    if (IsAVXEnabled) {
+      xstate->xstate_hdr.xfeatures |= GetLegacyXFeatures(Frame->State, fpstate->mxcsr);
+    }
+
     // Copy over signal stack information
     guest_uctx->uc.uc_stack.ss_flags = GuestStack->ss_flags;
     guest_uctx->uc.uc_stack.ss_sp = static_cast<uint32_t>(reinterpret_cast<uint64_t>(GuestStack->ss_sp));
@@ -1150,6 +1316,8 @@ namespace FEX::HLE {
 
     auto Frame = Thread->CurrentFrame;
 
+    FEXCORE_TELEMETRY_COUNTER_INC(COUNTER_SIGNALS_DELIVERED);
+
     // Ref count our faults
     // We use this to track if it is safe to clear cache
     ++Thread->CurrentFrame->SignalHandlerRefCounter;
@@ -1225,10 +1393,7 @@ namespace FEX::HLE {
     // Backup where we think the RIP currently is
     ContextBackup->OriginalRIP = CTX->RestoreRIPFromHostPC(Thread, ArchHelpers::Context::GetPc(ucontext));
     // Calculate eflags upfront.
-    uint32_t eflags = 0;
-    for (size_t i = 0; i < FEXCore::Core::CPUState::NUM_EFLAG_BITS; ++i) {
-      eflags |= Frame->State.flags[i] << i;
-    }
+    uint32_t eflags = CTX->ReconstructCompactedEFLAGS(&Frame->State);
 
     if (Is64BitMode) {
       NewGuestSP = SetupFrame_x64(Thread, ContextBackup, Frame, Signal, HostSigInfo, ucontext, GuestAction, GuestStack, NewGuestSP, eflags);
@@ -1480,12 +1645,42 @@ namespace FEX::HLE {
         }
       }
     }
+    if (IsAsyncSignal(&SigInfo, Signal) && SigIsMember(&ThreadData.CurrentSignalMask, Signal)) {
+      // The guest has this signal masked but the host doesn't.
+      // Synchronous signals are always delivered, the kernel would do the same for a fault.
+
+      // Have the host block the guest mask from here on so that further masked signals wait in the kernel
+      // rather than coming through here. The next GuestSigProcMask that unmasks them lifts this.
+      uint64_t HostMask{};
+      memcpy(&HostMask, &_context->uc_sigmask, sizeof(uint64_t));
+      HostMask |= GetHostSignalMask(ThreadData.CurrentSignalMask.Val);
+      memcpy(&_context->uc_sigmask, &HostMask, sizeof(uint64_t));
+      SetHostSignalMask(Thread, HostMask);
+
+      if (!IsThreadDirectedSignal(&SigInfo)) {
+        // Another thread that doesn't mask it should take it. The signal is blocked while its own handler runs,
+        // and by the new mask afterwards, so the kernel won't hand it straight back to this thread.
+        QueueProcessSignal(Thread, Signal, &SigInfo);
+        return;
+      }
+
+      // Only this thread can take it, hold on to it until the guest unmasks it
+      const uint64_t SignalBit = 1ULL << (Signal - 1);
+      if (!(ThreadData.PendingSignals & SignalBit)) {
+        ThreadData.PendingSignals |= SignalBit;
+        ThreadData.PendingSignalInfo[Signal - 1] = SigInfo;
+      }
+      else if (Signal >= __SIGRTMIN) {
+        // Realtime signals queue rather than merge. The signal is blocked while its own handler runs,
+        // so this one stays queued in the kernel.
+        ::syscall(SYS_rt_tgsigqueueinfo, Thread->ThreadManager.GetPID(), Thread->ThreadManager.GetTID(), Signal, &SigInfo);
+      }
+      return;
+    }
+
     // Let the host take first stab at handling the signal
     SignalHandler &Handler = HostHandlers[Signal];
 
-    // Remove the pending signal
-    ThreadData.PendingSignals &= ~(1ULL << (Signal - 1));
-
     // We have an emulation thread pointer, we can now modify its state
     if (Handler.GuestAction.sigaction_handler.handler == SIG_DFL) {
       if (Handler.DefaultBehaviour == DEFAULT_TERM ||
@@ -1508,17 +1703,14 @@ namespace FEX::HLE {
           NewMask |= (1ULL << (Signal - 1));
         }
 
-        // Walk our required signals and stop masking them if requested
-        for (size_t i = 0; i < MAX_SIGNALS; ++i) {
-          if (HostHandlers[i + 1].Required.load(std::memory_order_relaxed)) {
-            // Never mask our required signals
-            NewMask &= ~(1ULL << i);
-          }
-        }
+        // The guest handler runs with its mask added to the current one, the previous mask is restored on sigreturn
+        ThreadData.CurrentSignalMask.Val |= NewMask & ~((1ULL << (SIGKILL - 1)) | (1ULL << (SIGSTOP - 1)));
 
         // Update our host signal mask so we don't hit race conditions with signals
         // This allows us to maintain the expected signal mask through the guest signal handling and then all the way back again
+        NewMask = GetHostSignalMask(NewMask);
         memcpy(&_context->uc_sigmask, &NewMask, sizeof(uint64_t));
+        SetHostSignalMask(Thread, NewMask);
 
         // We handled this signal, continue running
         return;
@@ -1772,6 +1964,17 @@ namespace FEX::HLE {
     // Register pause signal handler.
     RegisterHostSignalHandler(SignalDelegator::SIGNAL_FOR_PAUSE, PauseHandler, true);
 
+    if (ProfileSampleRate()) {
+      Sampler = fextl::make_unique<GuestSampler>(CTX, ProfileSampleFile(), ProfileSampleRate());
+
+      const auto SampleHandler = [](FEXCore::Core::InternalThreadState *Thread, int Signal, void *info, void *ucontext) -> bool {
+        return GlobalDelegator->Sampler->HandleSample(Thread, info, ucontext);
+      };
+
+      // Register sample signal handler, signals that aren't from our timers fall through to the guest.
+      RegisterHostSignalHandler(GuestSampler::SIGNAL_FOR_SAMPLE, SampleHandler, true);
+    }
+
     // Guest signal handlers.
     for (uint32_t Signal = 0; Signal <= SignalDelegator::MAX_SIGNALS; ++Signal) {
       RegisterHostSignalHandlerForGuest(Signal, GuestSignalHandler);
@@ -1779,6 +1982,9 @@ namespace FEX::HLE {
   }
 
   SignalDelegator::~SignalDelegator() {
+    // Stop sampling before the host handlers go away, an unhandled sample signal would terminate the process.
+    Sampler.reset();
+
     for (int i = 0; i < MAX_SIGNALS; ++i) {
       if (i == 0 ||
           i == SIGKILL ||
@@ -1816,16 +2022,26 @@ namespace FEX::HLE {
     }
 
     // Get the current host signal mask
+    // This was inherited from the parent, which synchronized it with its guest mask
     ::syscall(SYS_rt_sigprocmask, 0, nullptr, &ThreadData.CurrentSignalMask.Val, 8);
+    ThreadData.HostSignalMask = ThreadData.CurrentSignalMask.Val;
 
     if (Thread != (FEXCore::Core::InternalThreadState*)UINTPTR_MAX) {
       // Reserve a small amount of deferred signal frames. Usually the stack won't be utilized beyond
       // 1 or 2 signals but add a few more just in case.
       Thread->DeferredSignalFrames.reserve(8);
+
+      if (Sampler) {
+        Sampler->RegisterThread();
+      }
     }
   }
 
   void SignalDelegator::UninstallTLSState(FEXCore::Core::InternalThreadState *Thread) {
+    if (Sampler) {
+      Sampler->UnregisterThread();
+    }
+
     FEXCore::Allocator::munmap(ThreadData.AltStackPtr, SIGSTKSZ * 16);
 
     ThreadData.AltStackPtr = nullptr;
@@ -1898,6 +2114,18 @@ namespace FEX::HLE {
     return 0;
   }
 
+  void SignalDelegator::LockBeforeFork() {
+    if (Sampler) {
+      Sampler->LockBeforeFork();
+    }
+  }
+
+  void SignalDelegator::UnlockAfterFork(bool Child) {
+    if (Sampler) {
+      Sampler->UnlockAfterFork(Child);
+    }
+  }
+
   void SignalDelegator::CheckXIDHandler() {
     std::lock_guard lk(GuestDelegatorMutex);
     std::lock_guard lk2(HostDelegatorMutex);
@@ -1984,15 +2212,46 @@ namespace FEX::HLE {
 
   static void CheckForPendingSignals(FEXCore::Core::InternalThreadState *Thread) {
     // Do we have any pending signals that became unmasked?
-    uint64_t PendingSignals = ~ThreadData.CurrentSignalMask.Val & ThreadData.PendingSignals;
-    if (PendingSignals != 0) {
-      for (int i = 0; i < 64; ++i) {
-        if (PendingSignals & (1ULL << i)) {
-          FHU::Syscalls::tgkill(Thread->ThreadManager.PID, Thread->ThreadManager.TID, i + 1);
-          // We might not even return here which is spooky
-        }
+    // These get delivered on the way out of the requeue syscall, so we might not even return here which is spooky
+    RequeuePendingSignals(Thread, ~ThreadData.CurrentSignalMask.Val);
+  }
+
+  uint64_t SignalDelegator::GetHostSignalMask(uint64_t GuestMask) const {
+    for (size_t i = 0; i < MAX_SIGNALS; ++i) {
+      if (HostHandlers[i + 1].Required.load(std::memory_order_relaxed)) {
+        // If it is a required host signal then we can't mask it
+        GuestMask &= ~(1ULL << i);
       }
     }
+
+    return GuestMask;
+  }
+
+  void SignalDelegator::BlockHostSignals(uint64_t GuestMask) {
+    auto &Pending = GetTLSThread()->CurrentFrame->PendingHostSignalMask;
+    const uint64_t Signals = GetHostSignalMask(GuestMask) & (~ThreadData.HostSignalMask | Pending);
+    if (Signals) {
+      ThreadData.HostSignalMask |= Signals;
+      Pending &= ~Signals;
+      ::syscall(SYS_rt_sigprocmask, SIG_BLOCK, &Signals, nullptr, 8);
+    }
+
+    // Now that they are blocked anything we were holding stays queued in the kernel
+    RequeuePendingSignals(GetTLSThread(), GuestMask);
+  }
+
+  void SignalDelegator::SetHostSignalMask(FEXCore::Core::InternalThreadState *Thread, uint64_t HostMask) {
+    const uint64_t Pending = GetHostSignalMask(ThreadData.CurrentSignalMask.Val) & ~HostMask;
+    Thread->CurrentFrame->PendingHostSignalMask = Pending;
+    ThreadData.HostSignalMask = HostMask | Pending;
+  }
+
+  void SignalDelegator::SyncHostSignalMask() {
+    ThreadData.HostSignalMask = GetHostSignalMask(ThreadData.CurrentSignalMask.Val);
+    GetTLSThread()->CurrentFrame->PendingHostSignalMask = 0;
+    ::syscall(SYS_rt_sigprocmask, SIG_SETMASK, &ThreadData.HostSignalMask, nullptr, 8);
+
+    RequeuePendingSignals(GetTLSThread(), ThreadData.CurrentSignalMask.Val);
   }
 
   uint64_t SignalDelegator::GuestSigProcMask(int how, const uint64_t *set, uint64_t *oldset) {
@@ -2020,17 +2279,24 @@ namespace FEX::HLE {
         return -EINVAL;
       }
 
-      uint64_t HostMask = ThreadData.CurrentSignalMask.Val;
-      // Now actually set the host mask
-      // This will hide from the guest that we are not actually setting all of the masks it wants
-      for (size_t i = 0; i < MAX_SIGNALS; ++i) {
-        if (HostHandlers[i + 1].Required.load(std::memory_order_relaxed)) {
-          // If it is a required host signal then we can't mask it
-          HostMask &= ~(1ULL << i);
+      // The mask is only emulated, the host mask only needs touching now if it still blocks signals the guest just unmasked.
+      auto &Pending = GetTLSThread()->CurrentFrame->PendingHostSignalMask;
+      const uint64_t Unblocked = ThreadData.HostSignalMask & ~ThreadData.CurrentSignalMask.Val;
+      if (Unblocked) {
+        ThreadData.HostSignalMask &= ~Unblocked;
+        // Pending signals were never blocked by the kernel
+        const uint64_t HostUnblocked = Unblocked & ~Pending;
+        Pending &= ~Unblocked;
+        if (HostUnblocked) {
+          ::syscall(SYS_rt_sigprocmask, SIG_UNBLOCK, &HostUnblocked, nullptr, 8);
         }
       }
 
-      ::syscall(SYS_rt_sigprocmask, SIG_SETMASK, &HostMask, nullptr, 8);
+      // Newly masked signals get blocked on the host before the next syscall so they can't interrupt it with EINTR.
+      // Until then HandleGuestSignal holds on to any that arrive.
+      const uint64_t Blocked = GetHostSignalMask(ThreadData.CurrentSignalMask.Val) & ~ThreadData.HostSignalMask;
+      ThreadData.HostSignalMask |= Blocked;
+      Pending |= Blocked;
     }
 
     if (!!oldset) {
@@ -2075,12 +2341,18 @@ namespace FEX::HLE {
     ThreadData.PreviousSuspendMask = ThreadData.CurrentSignalMask;
     // Set the new mask
     ThreadData.CurrentSignalMask.Val = *set & IgnoredSignalsMask;
+
+    // Held signals the suspend mask unmasks go back to the kernel while the host still blocks them.
+    // sigsuspend below unblocks them atomically so the guest handler runs before it returns.
+    BlockHostSignals(ThreadData.PendingSignals & ~ThreadData.CurrentSignalMask.Val);
+
     sigset_t HostSet{};
 
     sigemptyset(&HostSet);
 
+    const uint64_t HostMask = GetHostSignalMask(ThreadData.CurrentSignalMask.Val);
     for (int32_t i = 0; i < MAX_SIGNALS; ++i) {
-      if (*set & (1ULL << i)) {
+      if (HostMask & (1ULL << i)) {
         sigaddset(&HostSet, i + 1);
       }
     }
@@ -2111,6 +2383,9 @@ namespace FEX::HLE {
       return -EINVAL;
     }
 
+    // Waited on signals the guest has masked must stay in the kernel to be dequeued here, rather than being held by us
+    BlockHostSignals(*set & ThreadData.CurrentSignalMask.Val);
+
     uint64_t Result = ::syscall(SYS_rt_sigtimedwait, set, info, timeout);
 
     return Result == -1 ? -errno : Result;
@@ -2140,6 +2415,11 @@ namespace FEX::HLE {
     // Thread is necessary to prevent deadlocks for a thread that has signaled on the same thread listening to the FD and blocking is enabled
     uint64_t Result = signalfd(fd, &HostSet, flags);
 
+    if (Result != -1) {
+      // Masked signals have to stay queued in the kernel to be readable from the signalfd
+      BlockHostSignals(*set & ThreadData.CurrentSignalMask.Val);
+    }
+
     return Result == -1 ? -errno : Result;
   }
 
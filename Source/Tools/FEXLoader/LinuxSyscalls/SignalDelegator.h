@@ -7,6 +7,7 @@ $end_info$
 
 #pragma once
 
+#include "LinuxSyscalls/GuestSampler.h"
 #include "LinuxSyscalls/Types.h"
 #include "ArchHelpers/MContext.h"
 #include "VDSO_Emulation.h"
@@ -70,6 +71,14 @@ namespace FEX::HLE {
       uint64_t GuestSigSuspend(uint64_t *set, size_t sigsetsize);
       uint64_t GuestSigTimedWait(uint64_t *set, siginfo_t *info, const struct timespec *timeout, size_t sigsetsize);
       uint64_t GuestSignalFD(int fd, const uint64_t *set, size_t sigsetsize , int flags);
+
+      /**
+       * @brief Makes the host signal mask match the guest's emulated one
+       *
+       * The guest mask is normally only tracked in userspace. New threads and execve inherit the host mask so this
+       * must be called before either. Any signals held for the guest get handed back to the kernel.
+       */
+      void SyncHostSignalMask();
     /**  @} */
 
       void CheckXIDHandler() override;
@@ -103,6 +112,9 @@ namespace FEX::HLE {
 
     void SignalThread(FEXCore::Core::InternalThreadState *Thread, FEXCore::Core::SignalEvent Event) override;
 
+    void LockBeforeFork();
+    void UnlockAfterFork(bool Child);
+
     FEX_CONFIG_OPT(ParanoidTSO, PARANOIDTSO);
   protected:
     // Called from the thunk handler to handle the signal
@@ -121,7 +133,12 @@ namespace FEX::HLE {
   private:
     FEX_CONFIG_OPT(Is64BitMode, IS64BIT_MODE);
     FEX_CONFIG_OPT(Core, CORE);
+    FEX_CONFIG_OPT(ProfileSampleRate, PROFILESAMPLERATE);
+    FEX_CONFIG_OPT(ProfileSampleFile, PROFILESAMPLEFILE);
     fextl::string const ApplicationName;
+
+    // Only allocated when ProfileSampleRate is enabled
+    fextl::unique_ptr<GuestSampler> Sampler;
     FEXCORE_TELEMETRY_INIT(CrashMask, TYPE_CRASH_MASK);
 
     enum DefaultBehaviour {
@@ -158,6 +175,13 @@ namespace FEX::HLE {
     bool InstallHostThunk(int Signal);
     bool UpdateHostThunk(int Signal);
 
+    // Removes the signals FEX needs for itself from a guest signal mask
+    uint64_t GetHostSignalMask(uint64_t GuestMask) const;
+    // Blocks guest masked signals on the host so they stay queued in the kernel
+    void BlockHostSignals(uint64_t GuestMask);
+    // The kernel blocks HostMask from here on, the rest of the guest mask is blocked before the next syscall
+    void SetHostSignalMask(FEXCore::Core::InternalThreadState *Thread, uint64_t HostMask);
+
     FEXCore::Context::VDSOSigReturn VDSOPointers{};
 
     bool IsAddressInDispatcher(uint64_t Address) const {
@@ -30,6 +30,8 @@ $end_info$
 #include <FEXCore/Utils/CompilerDefs.h>
 #include <FEXCore/Utils/LogManager.h>
 #include <FEXCore/Utils/MathUtils.h>
+#include <FEXCore/Utils/Profiler.h>
+#include <FEXCore/Utils/Telemetry.h>
 #include <FEXCore/Utils/FileLoading.h>
 #include <FEXCore/fextl/fmt.h>
 #include <FEXCore/fextl/sstream.h>
@@ -57,6 +59,8 @@ $end_info$
 #include <sys/utsname.h>
 #include <unistd.h>
 
+#include <git_version.h>
+
 namespace FEX::HLE {
 class SignalDelegator;
 SyscallHandler *_SyscallHandler{};
@@ -271,6 +275,12 @@ uint64_t ExecveHandler(const char *pathname, char* const* argv, char* const* env
   // Kernel does its own checks for file format support for this
   // We can only call execve directly if we both have an interpreter installed AND were ran with the interpreter
   // If the user ran FEX through FEXLoader then we must go down the emulated path
+  // Queued log messages don't survive the execve
+  LogMan::Msg::FlushAsync();
+
+  // The new process picks up the host signal mask and pending signals, not our emulated ones
+  FEX::HLE::_SyscallHandler->GetSignalDelegator()->SyncHostSignalMask();
+
   uint64_t Result{};
   if (FEX::HLE::_SyscallHandler->IsInterpreterInstalled() &&
       FEX::HLE::_SyscallHandler->IsInterpreter() &&
@@ -571,10 +581,15 @@ uint64_t CloneHandler(FEXCore::Core::CpuStateFrame *Frame, FEX::HLE::clone3_args
     return false;
   };
 
-  if (flags & CLONE_VM) {
+  // With CLONE_VFORK the caller is suspended until the child execs or exits, so nothing runs concurrently
+  // on the shared memory. posix_spawn and system() use this, they shouldn't migrate the whole process to TSO.
+  if ((flags & CLONE_VM) && !(flags & CLONE_VFORK)) {
     Frame->Thread->CTX->MarkMemoryShared();
   }
 
+  // Children inherit the host signal mask, which only follows the emulated guest mask lazily
+  FEX::HLE::_SyscallHandler->GetSignalDelegator()->SyncHostSignalMask();
+
   // If there are flags that can't be handled regularly then we need to hand off to the true clone handler
   if (HasUnhandledFlags(args)) {
     if (!AnyFlagsSet(flags, CLONE_THREAD)) {
@@ -744,10 +759,61 @@ SyscallHandler::SyscallHandler(FEXCore::Context::Context *_CTX, FEX::HLE::Signal
   HostKernelVersion = CalculateHostKernelVersion();
   GuestKernelVersion = CalculateGuestKernelVersion();
   Alloc32Handler = FEX::HLE::Create32BitAllocator();
+  HostAllocHandler = FEX::HLE::CreatePassthroughAllocator();
 
   SignalDelegation->RegisterHostSignalHandler(SIGSEGV, HandleSegfault, true);
 }
 
+bool SyscallHandler::WantsHugePages(size_t Length, int Flags) const {
+  // Shared mappings depend on the host's shmem THP setting instead, and huge thread stacks would only waste memory
+  return HugePageThreshold() != 0 &&
+    Length >= (static_cast<uint64_t>(HugePageThreshold()) << 20) &&
+    (Flags & MAP_ANONYMOUS) &&
+    (Flags & MAP_PRIVATE) &&
+    !(Flags & (MAP_STACK | MAP_GROWSDOWN));
+}
+
+void *SyscallHandler::MmapHugePages(FEX::HLE::MemAllocator *Alloc, void *addr, size_t length, int prot, int flags, int fd, off_t offset) {
+  constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+  // Define MAP_FIXED_NOREPLACE ourselves to ensure we always parse this flag
+  constexpr int FEX_MAP_FIXED_NOREPLACE = 0x100000;
+
+  length = FEXCore::AlignUp(length, FHU::FEX_PAGE_SIZE);
+  uint64_t Result = -ENOMEM;
+
+  if (!addr && !(flags & (MAP_FIXED | FEX_MAP_FIXED_NOREPLACE))) {
+    // THP can only back 2MB aligned ranges, over-allocate and trim down to an aligned range.
+    // Trimming goes through the allocator so the 32-bit allocator's tracking stays in sync.
+    const size_t PaddedLength = length + HUGE_PAGE_SIZE - FHU::FEX_PAGE_SIZE;
+    const uint64_t Begin = reinterpret_cast<uint64_t>(Alloc->Mmap(nullptr, PaddedLength, prot, flags, fd, offset));
+    if (!FEX::HLE::HasSyscallError(Begin)) {
+      const uint64_t End = Begin + PaddedLength;
+      const uint64_t AlignedBegin = FEXCore::AlignUp(Begin, HUGE_PAGE_SIZE);
+      const uint64_t AlignedEnd = AlignedBegin + length;
+
+      if (AlignedBegin != Begin) {
+        Alloc->Munmap(reinterpret_cast<void*>(Begin), AlignedBegin - Begin);
+      }
+      if (AlignedEnd != End) {
+        Alloc->Munmap(reinterpret_cast<void*>(AlignedEnd), End - AlignedEnd);
+      }
+      Result = AlignedBegin;
+    }
+  }
+
+  if (FEX::HLE::HasSyscallError(Result)) {
+    // Guest picked the address, or a tight address space had no room for the padding
+    Result = reinterpret_cast<uint64_t>(Alloc->Mmap(addr, length, prot, flags, fd, offset));
+    if (FEX::HLE::HasSyscallError(Result)) {
+      return reinterpret_cast<void*>(Result);
+    }
+  }
+
+  ::madvise(reinterpret_cast<void*>(Result), length, MADV_HUGEPAGE);
+  FEXCORE_TELEMETRY_COUNTER_INC(COUNTER_HUGEPAGE_MAPPINGS);
+  return reinterpret_cast<void*>(Result);
+}
+
 SyscallHandler::~SyscallHandler() {
   FEXCore::Allocator::munmap(reinterpret_cast<void*>(DataSpace), DataSpaceMaxSize);
 }
@@ -771,6 +837,33 @@ uint32_t SyscallHandler::CalculateHostKernelVersion() {
   return (Major << 24) | (Minor << 16) | Patch;
 }
 
+const struct utsname &SyscallHandler::GetGuestUname() {
+  std::call_once(GuestUnameOnce, [this] {
+    struct utsname Local{};
+    if (::uname(&Local) == 0) {
+      memcpy(GuestUname.nodename, Local.nodename, sizeof(Local.nodename));
+      memcpy(GuestUname.domainname, Local.domainname, sizeof(Local.domainname));
+    }
+    else {
+      strcpy(GuestUname.nodename, "FEXCore");
+      LogMan::Msg::EFmt("Couldn't determine host nodename. Defaulting to '{}'", GuestUname.nodename);
+    }
+    strcpy(GuestUname.sysname, "Linux");
+    snprintf(GuestUname.release, sizeof(GuestUname.release), "%d.%d.%d",
+      KernelMajor(GuestKernelVersion),
+      KernelMinor(GuestKernelVersion),
+      KernelPatch(GuestKernelVersion));
+
+    const char version[] = "#" GIT_DESCRIBE_STRING " SMP " __DATE__ " " __TIME__;
+    strcpy(GuestUname.version, version);
+    static_assert(sizeof(version) <= sizeof(GuestUname.version), "uname version define became too large!");
+    // Tell the guest that we are a 64bit kernel
+    strcpy(GuestUname.machine, "x86_64");
+  });
+
+  return GuestUname;
+}
+
 uint32_t SyscallHandler::CalculateGuestKernelVersion() {
   // We currently only emulate a kernel between the ranges of Kernel 5.0.0 and 6.2.0
   return std::max(KernelVersion(5, 0), std::min(KernelVersion(6, 2), GetHostKernelVersion()));
@@ -781,7 +874,18 @@ uint64_t SyscallHandler::HandleSyscall(FEXCore::Core::CpuStateFrame *Frame, FEXC
     return -ENOSYS;
   }
 
+  FEXCORE_TELEMETRY_SYSCALL_INC(Args->Argument[0]);
+  FEXCORE_PROFILE_SCOPED_ARG("Syscall", Args->Argument[0]);
+
   auto &Def = Definitions[Args->Argument[0]];
+
+  if (Frame->PendingHostSignalMask &&
+      (Def.Flags & FEXCore::IR::SyscallFlags::SIGNALMASK) != FEXCore::IR::SyscallFlags::SIGNALMASK) {
+    // Have the host catch up with signals the guest masked before the syscall can block
+    const uint64_t Mask = std::exchange(Frame->PendingHostSignalMask, 0);
+    ::syscall(SYS_rt_sigprocmask, SIG_BLOCK, &Mask, nullptr, 8);
+  }
+
   uint64_t Result{};
   switch (Def.NumArgs) {
   case 0: Result = std::invoke(Def.Ptr0, Frame); break;
@@ -831,9 +935,12 @@ uint64_t UnimplementedSyscallSafe(FEXCore::Core::CpuStateFrame *Frame, uint64_t
 
 void SyscallHandler::LockBeforeFork() {
   VMATracking.Mutex.lock();
+  SignalDelegation->LockBeforeFork();
 }
 
 void SyscallHandler::UnlockAfterFork(bool Child) {
+  SignalDelegation->UnlockAfterFork(Child);
+
   if (Child) {
     VMATracking.Mutex.StealAndDropActiveLocks();
   }
@@ -19,15 +19,20 @@ $end_info$
 #include <FEXCore/fextl/fmt.h>
 #include <FEXCore/fextl/map.h>
 #include <FEXCore/fextl/memory.h>
+#include <FEXCore/fextl/set.h>
 #include <FEXCore/fextl/string.h>
 #include <FEXCore/fextl/vector.h>
+#include <FEXHeaderUtils/TypeDefines.h>
 
+#include <array>
+#include <atomic>
 #include <mutex>
 #include <shared_mutex>
 
 #include <errno.h>
 #include <fcntl.h>
 #include <stdint.h>
+#include <sys/utsname.h>
 #include <type_traits>
 #include <list>
 #ifdef _M_X86_64
@@ -177,6 +182,7 @@ public:
   FEX_CONFIG_OPT(ThreadsConfig, THREADS);
   FEX_CONFIG_OPT(Is64BitMode, IS64BIT_MODE);
   FEX_CONFIG_OPT(SMCChecks, SMCCHECKS);
+  FEX_CONFIG_OPT(HugePageThreshold, HUGEPAGETHRESHOLD);
 
   uint32_t GetHostKernelVersion() const { return HostKernelVersion; }
   uint32_t GetGuestKernelVersion() const { return GuestKernelVersion; }
@@ -192,6 +198,10 @@ public:
     return (Major << 24) | (Minor << 16) | Patch;
   }
 
+  // What uname returns to the guest, built on first use.
+  // Guests can't change the host or domain name, so this is the result of every uname flavour for the life of the process.
+  const struct utsname &GetGuestUname();
+
   static uint32_t KernelMajor(uint32_t Version) { return Version >> 24; }
   static uint32_t KernelMinor(uint32_t Version) { return (Version >> 16) & 0xFF; }
   static uint32_t KernelPatch(uint32_t Version) { return Version & 0xFFFF; }
@@ -204,6 +214,14 @@ public:
   // does a guest munmap as if done via a guest syscall
   virtual int GuestMunmap(FEXCore::Core::InternalThreadState *Thread, void *addr, uint64_t length) = 0;
 
+  ///// Transparent huge pages /////
+  // Whether a guest mmap falls under the HugePageThreshold policy
+  bool WantsHugePages(size_t Length, int Flags) const;
+  // Maps through the allocator, 2MB aligned unless the guest asked for an address, and madvises the result for huge pages.
+  // Returns -errno on failure like the allocator does.
+  void *MmapHugePages(FEX::HLE::MemAllocator *Alloc, void *addr, size_t length, int prot, int flags, int fd, off_t offset);
+  FEX::HLE::MemAllocator *GetHostAllocator() { return HostAllocHandler.get(); }
+
   ///// Memory Manager tracking /////
   void TrackMmap(FEXCore::Core::InternalThreadState *Thread, uintptr_t Base, uintptr_t Size, int Prot, int Flags, int fd, off_t Offset);
   void TrackMunmap(FEXCore::Core::InternalThreadState *Thread, uintptr_t Base, uintptr_t Size);
@@ -216,6 +234,8 @@ public:
   ///// VMA (Virtual Memory Area) tracking /////
   static bool HandleSegfault(FEXCore::Core::InternalThreadState *Thread, int Signal, void *info, void *ucontext);
   void MarkGuestExecutableRange(FEXCore::Core::InternalThreadState *Thread, uint64_t Start, uint64_t Length) override;
+  bool NeedsInlineSMCChecks(uint64_t Start, uint64_t Length) const override;
+  bool IsReadOnlyFileMapping(uint64_t Start, uint64_t Length) override;
   // AOTIRCacheEntryLookupResult also includes a shared lock guard, so the pointed AOTIRCacheEntry return can be safely used
   FEXCore::HLE::AOTIRCacheEntryLookupResult LookupAOTIRCacheEntry(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestAddr) final override;
 
@@ -249,6 +269,9 @@ private:
 
   std::mutex FutexMutex;
   std::mutex SyscallMutex;
+
+  std::once_flag GuestUnameOnce;
+  struct utsname GuestUname{};
   FEXCore::CodeLoader *LocalLoader{};
 
   #ifdef DEBUG_STRACE
@@ -256,6 +279,8 @@ private:
   #endif
 
   fextl::unique_ptr<FEX::HLE::MemAllocator> Alloc32Handler{};
+  // Plain host mmap, for huge page mappings outside of the 32-bit allocator
+  fextl::unique_ptr<FEX::HLE::MemAllocator> HostAllocHandler{};
 
   fextl::unique_ptr<FEXCore::HLE::SourcecodeMap> GenerateMap(const std::string_view& GuestBinaryFile, const std::string_view& GuestBinaryFileId) override;
 
@@ -335,6 +360,10 @@ private:
 
     using VMACIterator = decltype(VMAs)::const_iterator;
 
+    // Bumped by every change to VMAs, invalidates the per thread LookupVMAUnsafe cache.
+    // Only written with Mutex unique_locked.
+    uint64_t Generation{};
+
     MappedResource::ContainerType MappedResources;
 
     // Mutex must be at least shared_locked before calling
@@ -359,6 +388,40 @@ private:
     void ListPrepend(MappedResource *Resource, VMAEntry *NewVMA);
     static void ListCheckVMALinks(VMAEntry *VMA);
   } VMATracking;
+
+  ///// SMC write fault tracking /////
+  // Pages that take this many SMC write faults are no longer write protected, their blocks validate the code inline instead.
+  // Hybrid mode promotes a page on its first fault.
+  constexpr static uint32_t SMC_FAULT_PROMOTE_THRESHOLD = 16;
+  constexpr static uint32_t SMC_HYBRID_FAULT_PROMOTE_THRESHOLD = 1;
+  constexpr static size_t SMC_FAULT_COUNTERS = 4096;
+  // Indexed by a hash of the host page, collisions only make a page get promoted early.
+  // Fixed size and lock free so the SIGSEGV handler can update it.
+  std::array<std::atomic<uint32_t>, SMC_FAULT_COUNTERS> SMCPageFaults{};
+
+  static size_t SMCPageFaultIndex(uint64_t Address) {
+    return (Address / FHU::GetHostPageSize()) % SMC_FAULT_COUNTERS;
+  }
+  std::atomic<uint32_t> &GetSMCPageFaults(uint64_t Address) {
+    return SMCPageFaults[SMCPageFaultIndex(Address)];
+  }
+  bool IsSMCPromotedPage(uint64_t Address) const {
+    const auto Threshold = SMCChecks == FEXCore::Config::CONFIG_SMC_HYBRID ? SMC_HYBRID_FAULT_PROMOTE_THRESHOLD : SMC_FAULT_PROMOTE_THRESHOLD;
+    return SMCPageFaults[SMCPageFaultIndex(Address)].load(std::memory_order_relaxed) >= Threshold;
+  }
+  bool UsesSMCPageTracking() const {
+    return SMCChecks == FEXCore::Config::CONFIG_SMC_MTRACK || SMCChecks == FEXCore::Config::CONFIG_SMC_HYBRID;
+  }
+
+  // Pages of shared mappings that code was compiled from. A write through one mirror only invalidates the mirrors listed here.
+  // Pages are forgotten when a write fault invalidates them or they are unmapped, until then they may no longer have code.
+  std::mutex SharedCodePagesMutex;
+  fextl::set<uint64_t> SharedCodePages;
+
+  void AddSharedCodePages(uint64_t Start, uint64_t Length);
+  void RemoveSharedCodePages(uint64_t Start, uint64_t Length);
+  // Returns true if Page was tracked
+  bool TakeSharedCodePage(uint64_t Page);
 };
 
 uint64_t HandleSyscall(SyscallHandler *Handler, FEXCore::Core::CpuStateFrame *Frame, FEXCore::HLE::SyscallArguments *Args);
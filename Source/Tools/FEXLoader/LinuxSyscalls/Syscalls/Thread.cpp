@@ -17,6 +17,7 @@ $end_info$
 #include <FEXCore/Core/X86Enums.h>
 #include <FEXCore/Debug/InternalThreadState.h>
 #include <FEXCore/IR/IR.h>
+#include <FEXCore/Utils/LogManager.h>
 
 #include <FEXHeaderUtils/Syscalls.h>
 
@@ -235,6 +236,8 @@ namespace FEX::HLE {
       // Clear all the other threads that are being tracked
       Thread->CTX->UnlockAfterFork(Frame->Thread, IsChild);
 
+      LogMan::Msg::AsyncAfterFork();
+
       ::syscall(SYS_rt_sigprocmask, SIG_SETMASK, &Mask, nullptr, sizeof(Mask));
 
       // Child
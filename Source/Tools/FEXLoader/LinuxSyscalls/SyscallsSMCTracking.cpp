@@ -8,6 +8,7 @@ $end_info$
 
 #include "Common/FDUtils.h"
 
+#include <algorithm>
 #include <filesystem>
 #include <sys/shm.h>
 #include <sys/mman.h>
@@ -20,6 +21,7 @@ $end_info$
 #include <FEXCore/Utils/LogManager.h>
 #include <FEXCore/Utils/MathUtils.h>
 #include <FEXCore/Utils/DeferredSignalMutex.h>
+#include <FEXCore/Utils/Telemetry.h>
 
 namespace FEX::HLE {
 
@@ -66,7 +68,14 @@ bool SyscallHandler::HandleSegfault(FEXCore::Core::InternalThreadState *Thread,
       return false;
     }
 
-    auto FaultBase = FEXCore::AlignDown(FaultAddress, FHU::FEX_PAGE_SIZE);
+    // Protection is per host page, which can hold several guest pages
+    const auto HostPageSize = FHU::GetHostPageSize();
+    auto FaultBase = FEXCore::AlignDown(FaultAddress, HostPageSize);
+
+    FEXCORE_TELEMETRY_COUNTER_INC(COUNTER_SMC_INVALIDATIONS);
+
+    // Pages that keep faulting mix code with data that is written to, promote them to inline checks after enough faults
+    _SyscallHandler->GetSMCPageFaults(FaultBase).fetch_add(1, std::memory_order_relaxed);
 
     if (Entry->second.Flags.Shared) {
       LOGMAN_THROW_A_FMT(Entry->second.Resource, "VMA tracking error");
@@ -76,23 +85,42 @@ bool SyscallHandler::HandleSegfault(FEXCore::Core::InternalThreadState *Thread,
       auto VMA = Entry->second.Resource->FirstVMA;
       LOGMAN_THROW_AA_FMT(VMA, "VMA tracking error");
 
-      // Flush all mirrors, remap the page writable as needed
+      // Dual mapped JIT code usually only has code on one of its mirrors, only those are invalidated.
+      // Every writable mirror was protected for that code and is remapped writable.
+      fextl::vector<FEXCore::Context::CodeRange> CodeMirrors;
+      fextl::vector<uint64_t> WritableMirrors;
       do {
         if (VMA->Offset <= Offset && (VMA->Offset + VMA->Length) > Offset) {
           auto FaultBaseMirrored = Offset - VMA->Offset + VMA->Base;
 
+          if (_SyscallHandler->TakeSharedCodePage(FaultBaseMirrored)) {
+            CodeMirrors.push_back({FaultBaseMirrored, HostPageSize});
+          }
+
           if (VMA->Prot.Writable) {
-            CTX->InvalidateGuestCodeRange(Thread, FaultBaseMirrored, FHU::FEX_PAGE_SIZE, [](uintptr_t Start, uintptr_t Length) {
-              auto rv = mprotect((void *)Start, Length, PROT_READ | PROT_WRITE);
-              LogMan::Throw::AAFmt(rv == 0, "mprotect({}, {}) failed", Start, Length);
-            });
-          } else {
-            CTX->InvalidateGuestCodeRange(Thread, FaultBaseMirrored, FHU::FEX_PAGE_SIZE);
+            WritableMirrors.push_back(FaultBaseMirrored);
           }
         }
       } while ((VMA = VMA->ResourceNextVMA));
+
+      CTX->SuspendGuestCodeRanges(Thread, CodeMirrors, [&WritableMirrors, HostPageSize]() {
+        // Mirrors placed back to back are unprotected together
+        std::sort(WritableMirrors.begin(), WritableMirrors.end());
+        for (size_t i = 0; i < WritableMirrors.size();) {
+          const auto Start = WritableMirrors[i];
+          auto End = Start + HostPageSize;
+          for (++i; i < WritableMirrors.size() && WritableMirrors[i] == End; ++i) {
+            End += HostPageSize;
+          }
+
+          auto rv = mprotect((void *)Start, End - Start, PROT_READ | PROT_WRITE);
+          LogMan::Throw::AAFmt(rv == 0, "mprotect({}, {}) failed", Start, End - Start);
+        }
+      });
     } else {
-      CTX->InvalidateGuestCodeRange(Thread, FaultBase, FHU::FEX_PAGE_SIZE, [](uintptr_t Start, uintptr_t Length) {
+      // The write hasn't happened yet and might not change any code, blocks are checked before they run again.
+      // This also covers the guest pages sharing the host page that aren't written, their blocks are reinstated unchanged.
+      CTX->SuspendGuestCodeRange(Thread, FaultBase, HostPageSize, [](uintptr_t Start, uintptr_t Length) {
         auto rv = mprotect((void *)Start, Length, PROT_READ | PROT_WRITE);
         LogMan::Throw::AAFmt(rv == 0, "mprotect({}, {}) failed", Start, Length);
       });
@@ -103,67 +131,135 @@ bool SyscallHandler::HandleSegfault(FEXCore::Core::InternalThreadState *Thread,
 }
 
 void SyscallHandler::MarkGuestExecutableRange(FEXCore::Core::InternalThreadState *Thread, uint64_t Start, uint64_t Length) {
-  const auto Base = Start & FHU::FEX_PAGE_MASK;
-  const auto Top = FEXCore::AlignUp(Start + Length, FHU::FEX_PAGE_SIZE);
-
   {
-    if (SMCChecks != FEXCore::Config::CONFIG_SMC_MTRACK) {
+    if (!UsesSMCPageTracking()) {
       return;
     }
 
     FEXCore::ScopedDeferredSignalWithForkableSharedLock lk(VMATracking.Mutex, Thread);
 
-    // Find the first mapping at or after the range ends, or ::end().
-    // Top points to the address after the end of the range
-    auto Mapping = VMATracking.VMAs.lower_bound(Top);
+    auto ProtectRange = [this](uintptr_t Base, uintptr_t Top) {
+      // Find the first mapping at or after the range ends, or ::end().
+      // Top points to the address after the end of the range
+      auto Mapping = VMATracking.VMAs.lower_bound(Top);
+
+      while (Mapping != VMATracking.VMAs.begin()) {
+        Mapping--;
 
-    while (Mapping != VMATracking.VMAs.begin()) {
-      Mapping--;
+        const auto MapBase = Mapping->first;
+        const auto MapTop = MapBase + Mapping->second.Length;
 
-      const auto MapBase = Mapping->first;
-      const auto MapTop = MapBase + Mapping->second.Length;
+        if (MapTop <= Base) {
+          // Mapping ends before the Range start, exit
+          break;
+        } else {
+          const auto ProtectBase = std::max(MapBase, Base);
+          const auto ProtectSize = std::min(MapTop, Top) - ProtectBase;
 
-      if (MapTop <= Base) {
-        // Mapping ends before the Range start, exit
-        break;
-      } else {
-        const auto ProtectBase = std::max(MapBase, Base);
-        const auto ProtectSize = std::min(MapTop, Top) - ProtectBase;
+          if (Mapping->second.Flags.Shared) {
+            LOGMAN_THROW_A_FMT(Mapping->second.Resource, "VMA tracking error");
 
-        if (Mapping->second.Flags.Shared) {
-          LOGMAN_THROW_A_FMT(Mapping->second.Resource, "VMA tracking error");
+            AddSharedCodePages(ProtectBase, ProtectSize);
 
-          const auto OffsetBase = ProtectBase - Mapping->first + Mapping->second.Offset;
-          const auto OffsetTop = OffsetBase + ProtectSize;
+            const auto OffsetBase = ProtectBase - Mapping->first + Mapping->second.Offset;
+            const auto OffsetTop = OffsetBase + ProtectSize;
 
-          auto VMA = Mapping->second.Resource->FirstVMA;
-          LOGMAN_THROW_AA_FMT(VMA, "VMA tracking error");
+            auto VMA = Mapping->second.Resource->FirstVMA;
+            LOGMAN_THROW_AA_FMT(VMA, "VMA tracking error");
 
-          do {
-            auto VMAOffsetBase = VMA->Offset;
-            auto VMAOffsetTop = VMA->Offset + VMA->Length;
-            auto VMABase = VMA->Base;
+            do {
+              auto VMAOffsetBase = VMA->Offset;
+              auto VMAOffsetTop = VMA->Offset + VMA->Length;
+              auto VMABase = VMA->Base;
 
-            if (VMA->Prot.Writable && VMAOffsetBase < OffsetTop && VMAOffsetTop > OffsetBase) {
+              if (VMA->Prot.Writable && VMAOffsetBase < OffsetTop && VMAOffsetTop > OffsetBase) {
 
-              const auto MirroredBase = std::max(VMAOffsetBase, OffsetBase);
-              const auto MirroredSize = std::min(OffsetTop, VMAOffsetTop) - MirroredBase;
+                const auto MirroredBase = std::max(VMAOffsetBase, OffsetBase);
+                const auto MirroredSize = std::min(OffsetTop, VMAOffsetTop) - MirroredBase;
 
-              auto rv = mprotect((void *)(MirroredBase - VMAOffsetBase + VMABase), MirroredSize, PROT_READ);
-              LogMan::Throw::AAFmt(rv == 0, "mprotect({}, {}) failed", MirroredBase, MirroredSize);
-            }
-          } while ((VMA = VMA->ResourceNextVMA));
+                auto rv = mprotect((void *)(MirroredBase - VMAOffsetBase + VMABase), MirroredSize, PROT_READ);
+                LogMan::Throw::AAFmt(rv == 0, "mprotect({}, {}) failed", MirroredBase, MirroredSize);
+              }
+            } while ((VMA = VMA->ResourceNextVMA));
 
-        } else if (Mapping->second.Prot.Writable) {
-          int rv = mprotect((void *)ProtectBase, ProtectSize, PROT_READ);
+          } else if (Mapping->second.Prot.Writable) {
+            int rv = mprotect((void *)ProtectBase, ProtectSize, PROT_READ);
 
-          LogMan::Throw::AAFmt(rv == 0, "mprotect({}, {}) failed", ProtectBase, ProtectSize);
+            LogMan::Throw::AAFmt(rv == 0, "mprotect({}, {}) failed", ProtectBase, ProtectSize);
+          }
         }
       }
+    };
+
+    // Promoted pages stay writable, blocks on them check for modification inline instead
+    const auto HostPageSize = FHU::GetHostPageSize();
+    const auto End = FEXCore::AlignUp(Start + Length, HostPageSize);
+    for (auto Base = FEXCore::AlignDown(Start, HostPageSize); Base < End;) {
+      if (IsSMCPromotedPage(Base)) {
+        Base += HostPageSize;
+        continue;
+      }
+
+      auto Top = Base + HostPageSize;
+      while (Top < End && !IsSMCPromotedPage(Top)) {
+        Top += HostPageSize;
+      }
+
+      ProtectRange(Base, Top);
+      Base = Top;
     }
   }
 }
 
+void SyscallHandler::AddSharedCodePages(uint64_t Start, uint64_t Length) {
+  const auto HostPageSize = FHU::GetHostPageSize();
+  std::lock_guard lk(SharedCodePagesMutex);
+  for (auto Page = FEXCore::AlignDown(Start, HostPageSize); Page < Start + Length; Page += HostPageSize) {
+    SharedCodePages.insert(Page);
+  }
+}
+
+void SyscallHandler::RemoveSharedCodePages(uint64_t Start, uint64_t Length) {
+  // Pages are keyed on the host page base, which can be below a guest page aligned Start
+  const auto HostPageSize = FHU::GetHostPageSize();
+  std::lock_guard lk(SharedCodePagesMutex);
+  SharedCodePages.erase(SharedCodePages.lower_bound(FEXCore::AlignDown(Start, HostPageSize)), SharedCodePages.lower_bound(Start + Length));
+}
+
+bool SyscallHandler::TakeSharedCodePage(uint64_t Page) {
+  std::lock_guard lk(SharedCodePagesMutex);
+  return SharedCodePages.erase(Page) != 0;
+}
+
+bool SyscallHandler::NeedsInlineSMCChecks(uint64_t Start, uint64_t Length) const {
+  if (!UsesSMCPageTracking()) {
+    return false;
+  }
+
+  const auto HostPageSize = FHU::GetHostPageSize();
+  const auto End = FEXCore::AlignUp(Start + Length, HostPageSize);
+  for (auto Page = FEXCore::AlignDown(Start, HostPageSize); Page < End; Page += HostPageSize) {
+    if (IsSMCPromotedPage(Page)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool SyscallHandler::IsReadOnlyFileMapping(uint64_t Start, uint64_t Length) {
+  // Called while compiling, which doesn't have a thread to defer signals on
+  FHU::ScopedSignalMaskWithForkableSharedLock lk(VMATracking.Mutex);
+
+  auto Entry = VMATracking.LookupVMAUnsafe(Start);
+  if (Entry == VMATracking.VMAs.end()) {
+    return false;
+  }
+
+  const auto &VMA = Entry->second;
+  return VMA.Resource && !VMA.Flags.Shared && VMA.Prot.Readable && !VMA.Prot.Writable &&
+         Start + Length <= Entry->first + VMA.Length;
+}
+
 // Used for AOT
 FEXCore::HLE::AOTIRCacheEntryLookupResult SyscallHandler::LookupAOTIRCacheEntry(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestAddr) {
   FEXCore::ScopedDeferredSignalWithForkableSharedLock lk(VMATracking.Mutex, Thread);
@@ -190,6 +286,9 @@ void SyscallHandler::TrackMmap(FEXCore::Core::InternalThreadState *Thread, uintp
     CTX->MarkMemoryShared();
   }
 
+  // Executable file mappings are handed to the code object cache once VMA tracking is updated
+  fextl::string NamedRegionFilename;
+
   {
     // NOTE: Frontend calls this with a nullptr Thread during initialization, but
     //       providing this code with a valid Thread object earlier would allow
@@ -217,6 +316,10 @@ void SyscallHandler::TrackMmap(FEXCore::Core::InternalThreadState *Thread, uintp
           Resource->AOTIRCacheEntry = CTX->LoadAOTIRCacheEntry(fextl::string(Tmp, PathLength));
           Resource->Iterator = Iter;
         }
+
+        if (Prot & PROT_EXEC) {
+          NamedRegionFilename = fextl::string(Tmp, PathLength);
+        }
       }
     } else if (Flags & MAP_SHARED) {
       MRID mrid{SpecialDev::Anon, AnonSharedId++};
@@ -235,6 +338,13 @@ void SyscallHandler::TrackMmap(FEXCore::Core::InternalThreadState *Thread, uintp
   if (SMCChecks != FEXCore::Config::CONFIG_SMC_NONE) {
     // VMATracking.Mutex can't be held while executing this, otherwise it hangs if the JIT is in the process of looking up code in the AOT JIT.
     CTX->InvalidateGuestCodeRange(Thread, (uintptr_t)Base, Size);
+    RemoveSharedCodePages(Base, Size);
+  }
+
+  // A new mapping replaces anything that was there before
+  CTX->RemoveNamedRegion(Base, Size);
+  if (!NamedRegionFilename.empty()) {
+    CTX->AddNamedRegion(Base, Size, Offset, NamedRegionFilename);
   }
 }
 
@@ -252,7 +362,10 @@ void SyscallHandler::TrackMunmap(FEXCore::Core::InternalThreadState *Thread, uin
 
   if (SMCChecks != FEXCore::Config::CONFIG_SMC_NONE) {
     CTX->InvalidateGuestCodeRange(Thread, (uintptr_t)Base, Size);
+    RemoveSharedCodePages(Base, Size);
   }
+
+  CTX->RemoveNamedRegion(Base, Size);
 }
 
 void SyscallHandler::TrackMprotect(FEXCore::Core::InternalThreadState *Thread, uintptr_t Base, uintptr_t Size, int Prot) {
@@ -265,7 +378,12 @@ void SyscallHandler::TrackMprotect(FEXCore::Core::InternalThreadState *Thread, u
   }
 
   if (SMCChecks != FEXCore::Config::CONFIG_SMC_NONE) {
-    CTX->InvalidateGuestCodeRange(Thread, Base, Size);
+    if (Prot & PROT_READ) {
+      // W^X toggles of guest JIT code, blocks are checked before they run again
+      CTX->SuspendGuestCodeRange(Thread, Base, Size);
+    } else {
+      CTX->InvalidateGuestCodeRange(Thread, Base, Size);
+    }
   }
 }
 
@@ -319,6 +437,11 @@ void SyscallHandler::TrackMremap(FEXCore::Core::InternalThreadState *Thread, uin
       }
     }
   }
+
+  if (OldAddress != NewAddress && OldSize != 0) {
+    // Code that moved can reuse the IR it had at the old address
+    CTX->MigrateGuestCodeRange(OldAddress, NewAddress, std::min(OldSize, NewSize));
+  }
 }
 
 void SyscallHandler::TrackShmat(FEXCore::Core::InternalThreadState *Thread, int shmid, uintptr_t Base, int shmflg) {
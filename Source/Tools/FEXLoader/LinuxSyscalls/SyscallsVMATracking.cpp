@@ -127,12 +127,27 @@ void SyscallHandler::VMATracking::ListPrepend(MappedResource *Resource, VMAEntry
 
 // Lookup a VMA by address
 SyscallHandler::VMATracking::VMACIterator SyscallHandler::VMATracking::LookupVMAUnsafe(uint64_t GuestAddr) const {
+  // Consecutive lookups from a thread usually land in the same mapping, such as repeated SMC faults on one page.
+  // A hit is only trusted while nothing in VMAs has changed since it was cached.
+  struct LastHitCache {
+    const VMATracking *Owner;
+    uint64_t Generation;
+    VMACIterator Entry;
+  };
+  static thread_local LastHitCache LastHit{};
+
+  if (LastHit.Owner == this && LastHit.Generation == Generation &&
+      LastHit.Entry->first <= GuestAddr && (LastHit.Entry->first + LastHit.Entry->second.Length) > GuestAddr) {
+    return LastHit.Entry;
+  }
+
   auto Entry = VMAs.upper_bound(GuestAddr);
 
   if (Entry != VMAs.begin()) {
     --Entry;
 
     if (Entry->first <= GuestAddr && (Entry->first + Entry->second.Length) > GuestAddr) {
+      LastHit = {this, Generation, Entry};
       return Entry;
     }
   }
@@ -144,6 +159,7 @@ SyscallHandler::VMATracking::VMACIterator SyscallHandler::VMATracking::LookupVMA
 void SyscallHandler::VMATracking::SetUnsafe(FEXCore::Context::Context *CTX, MappedResource *MappedResource, uintptr_t Base,
                                             uintptr_t Offset, uintptr_t Length, VMAFlags Flags, VMAProt Prot) {
   ClearUnsafe(CTX, Base, Length, MappedResource);
+  ++Generation;
 
   auto [Iter, Inserted] = VMAs.emplace(
       Base, VMAEntry{MappedResource, nullptr, MappedResource ? MappedResource->FirstVMA : nullptr, Base, Offset, Length, Flags, Prot});
@@ -161,6 +177,7 @@ void SyscallHandler::VMATracking::SetUnsafe(FEXCore::Context::Context *CTX, Mapp
 void SyscallHandler::VMATracking::ClearUnsafe(FEXCore::Context::Context *CTX, uintptr_t Base, uintptr_t Length,
                                               MappedResource *PreservedMappedResource) {
   const auto Top = Base + Length;
+  ++Generation;
 
   // find the first Mapping at or after the Range ends, or ::end()
   // Top is the address after the end
@@ -245,6 +262,7 @@ void SyscallHandler::VMATracking::ClearUnsafe(FEXCore::Context::Context *CTX, ui
 // Change flags of mappings in a range and split the mappings if needed
 void SyscallHandler::VMATracking::ChangeUnsafe(uintptr_t Base, uintptr_t Length, VMAProt NewProt) {
   const auto Top = Base + Length;
+  ++Generation;
 
   // find the first Mapping at or after the Range ends, or ::end()
   // Top is the address after the end
@@ -324,6 +342,7 @@ void SyscallHandler::VMATracking::ChangeUnsafe(uintptr_t Base, uintptr_t Length,
 
 // This matches the peculiarities algorithm used in linux ksys_shmdt (linux kernel 5.16, ipc/shm.c)
 uintptr_t SyscallHandler::VMATracking::ClearShmUnsafe(FEXCore::Context::Context *CTX, uintptr_t Base) {
+  ++Generation;
 
   // Find first VMA at or after Base
   // Iterate until first SHM VMA, with matching offset, get length
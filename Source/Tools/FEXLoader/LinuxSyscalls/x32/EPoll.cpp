@@ -5,14 +5,13 @@ tags: LinuxSyscalls|syscalls-x86-32
 $end_info$
 */
 
+#include "LinuxSyscalls/EPollEvents.h"
 #include "LinuxSyscalls/Syscalls.h"
 #include "LinuxSyscalls/Types.h"
 #include "LinuxSyscalls/x32/Syscalls.h"
 #include "LinuxSyscalls/x32/Types.h"
 #include "LinuxSyscalls/x64/Syscalls.h"
 
-#include <FEXCore/fextl/vector.h>
-
 #include <algorithm>
 #include <cstdint>
 #include <sys/epoll.h>
@@ -30,13 +29,11 @@ namespace FEXCore::Core {
 namespace FEX::HLE::x32 {
   void RegisterEpoll(FEX::HLE::SyscallHandler *Handler) {
     REGISTER_SYSCALL_IMPL_X32(epoll_wait, [](FEXCore::Core::CpuStateFrame *Frame, int epfd, compat_ptr<FEX::HLE::x32::epoll_event32> events, int maxevents, int timeout) -> uint64_t {
-      fextl::vector<struct epoll_event> Events(std::max(0, maxevents));
+      FEX::HLE::HostEPollEvents<FEX::HLE::x32::epoll_event32> Events(events, maxevents);
       uint64_t Result = ::syscall(SYSCALL_DEF(epoll_pwait), epfd, Events.data(), maxevents, timeout, nullptr, 8);
 
       if (Result != -1) {
-        for (size_t i = 0; i < Result; ++i) {
-          events[i] = Events[i];
-        }
+        Events.CopyOut(Result);
       }
       SYSCALL_ERRNO();
     });
@@ -48,7 +45,7 @@ namespace FEX::HLE::x32 {
     });
 
     REGISTER_SYSCALL_IMPL_X32(epoll_pwait, [](FEXCore::Core::CpuStateFrame *Frame, int epfd, compat_ptr<FEX::HLE::x32::epoll_event32> events, int maxevent, int timeout, const uint64_t* sigmask, size_t sigsetsize) -> uint64_t {
-      fextl::vector<struct epoll_event> Events(std::max(0, maxevent));
+      FEX::HLE::HostEPollEvents<FEX::HLE::x32::epoll_event32> Events(events, maxevent);
 
       uint64_t Result = ::syscall(SYSCALL_DEF(epoll_pwait),
         epfd,
@@ -59,9 +56,7 @@ namespace FEX::HLE::x32 {
         sigsetsize);
 
       if (Result != -1) {
-        for (size_t i = 0; i < Result; ++i) {
-          events[i] = Events[i];
-        }
+        Events.CopyOut(Result);
       }
 
       SYSCALL_ERRNO();
@@ -69,7 +64,7 @@ namespace FEX::HLE::x32 {
 
     if (Handler->IsHostKernelVersionAtLeast(5, 11, 0)) {
       REGISTER_SYSCALL_IMPL_X32(epoll_pwait2, [](FEXCore::Core::CpuStateFrame *Frame, int epfd, compat_ptr<FEX::HLE::x32::epoll_event32> events, int maxevent, compat_ptr<timespec32> timeout, const uint64_t* sigmask, size_t sigsetsize) -> uint64_t {
-        fextl::vector<struct epoll_event> Events(std::max(0, maxevent));
+        FEX::HLE::HostEPollEvents<FEX::HLE::x32::epoll_event32> Events(events, maxevent);
 
         struct timespec tp64{};
         struct timespec *timed_ptr{};
@@ -87,9 +82,7 @@ namespace FEX::HLE::x32 {
           sigsetsize);
 
         if (Result != -1) {
-          for (size_t i = 0; i < Result; ++i) {
-            events[i] = Events[i];
-          }
+          Events.CopyOut(Result);
         }
 
         SYSCALL_ERRNO();
@@ -0,0 +1,151 @@
+/*
+$info$
+tags: LinuxSyscalls|syscalls-x86-32
+$end_info$
+*/
+
+#pragma once
+
+#include "LinuxSyscalls/x32/Types.h"
+
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/uio.h>
+
+namespace FEX::HLE::x32 {
+/**
+ * @brief Bump allocator for the host copies of guest structures that one syscall needs
+ *
+ * Memory comes from a per-thread scratch buffer that keeps the size of the largest request below MAX_SCRATCH_SIZE,
+ * so repeated sendmmsg/recvmmsg/readv calls don't allocate. Larger requests, or a second arena alive on the same
+ * thread, get their own heap buffer. Callers size the arena up front with AllocationSize.
+ */
+class ScratchArena final {
+public:
+  explicit ScratchArena(size_t Size)
+    : Remaining {Size} {
+    if (Size == 0) {
+      return;
+    }
+
+    auto &Scratch = GetScratch();
+    if (Size <= MAX_SCRATCH_SIZE && !Scratch.InUse) {
+      if (Scratch.Buffer.size() < Size) {
+        Scratch.Buffer.resize(Size);
+      }
+      Scratch.InUse = true;
+      OwnsScratch = true;
+      Base = Scratch.Buffer.data();
+    }
+    else {
+      Large.resize(Size);
+      Base = Large.data();
+    }
+  }
+
+  ~ScratchArena() {
+    if (OwnsScratch) {
+      GetScratch().InUse = false;
+    }
+  }
+
+  ScratchArena(const ScratchArena&) = delete;
+  ScratchArena& operator=(const ScratchArena&) = delete;
+
+  // Only for trivial types, the memory isn't initialized
+  template<typename T>
+  T *Allocate(size_t Count) {
+    const size_t Bytes = AllocationSize<T>(Count);
+    LOGMAN_THROW_A_FMT(Bytes <= Remaining, "Scratch arena sized too small");
+    auto Result = reinterpret_cast<T*>(Base);
+    Base += Bytes;
+    Remaining -= Bytes;
+    return Result;
+  }
+
+  // Rounded up so every allocation stays 16 byte aligned
+  template<typename T>
+  constexpr static size_t AllocationSize(size_t Count) {
+    return (sizeof(T) * Count + 15) & ~size_t{15};
+  }
+
+private:
+  constexpr static size_t MAX_SCRATCH_SIZE = 256 * 1024;
+
+  struct ScratchState {
+    fextl::vector<uint8_t> Buffer;
+    bool InUse;
+  };
+
+  static ScratchState &GetScratch() {
+    static thread_local ScratchState Scratch{};
+    return Scratch;
+  }
+
+  uint8_t *Base{};
+  size_t Remaining;
+  bool OwnsScratch{};
+  fextl::vector<uint8_t> Large{};
+};
+
+/**
+ * @brief Widens guest iovec32s in to host iovecs
+ *
+ * Handles two iovecs per iteration as one 16-byte load of 32-bit lanes and two 16-byte stores of 64-bit lanes,
+ * which compilers turn in to a pair of zero extending unpacks (ushll/ushll2 on AArch64) even at -O2.
+ */
+inline void WidenIOVecs(iovec *__restrict Host, const iovec32 *__restrict Guest, size_t Count) {
+  size_t i = 0;
+  for (; i + 2 <= Count; i += 2) {
+    uint32_t In[4];
+    uint64_t Out[4];
+    memcpy(In, &Guest[i], sizeof(In));
+    for (size_t j = 0; j < 4; ++j) {
+      Out[j] = In[j];
+    }
+    memcpy(&Host[i], Out, sizeof(Out));
+  }
+
+  for (; i < Count; ++i) {
+    Host[i] = Guest[i];
+  }
+}
+
+/**
+ * @brief Host copy of a guest iovec32 array
+ *
+ * Arrays up to the kernel's UIO_FASTIOV size live inline so the common
+ * readv/writev/sendmsg calls don't need a heap allocation to widen the guest iovecs.
+ * Larger arrays come from the thread's ScratchArena.
+ */
+class HostIOVec final {
+public:
+  HostIOVec(const iovec32 *Guest, size_t Count)
+    : Count {std::min(Count, MAX_IOV_COUNT)}
+    , Arena {this->Count > FastIOVCount ? ScratchArena::AllocationSize<iovec>(this->Count) : 0} {
+    Data = this->Count > FastIOVCount ? Arena.Allocate<iovec>(this->Count) : Inline.data();
+    WidenIOVecs(Data, Guest, this->Count);
+  }
+
+  HostIOVec(const HostIOVec&) = delete;
+  HostIOVec& operator=(const HostIOVec&) = delete;
+
+  iovec *data() const { return Data; }
+
+private:
+  constexpr static size_t FastIOVCount = 8;
+  // UIO_MAXIOV, the kernel rejects larger counts before it looks at the array
+  constexpr static size_t MAX_IOV_COUNT = 1024;
+
+  size_t Count;
+  std::array<iovec, FastIOVCount> Inline;
+  ScratchArena Arena;
+  iovec *Data;
+};
+}
@@ -17,8 +17,6 @@ $end_info$
 #include <sys/sysinfo.h>
 #include <sys/utsname.h>
 
-#include <git_version.h>
-
 namespace FEXCore::Core {
   struct CpuStateFrame;
 }
@@ -46,53 +44,27 @@ namespace FEX::HLE::x32 {
   static_assert(sizeof(sysinfo32) == 64, "Needs to be 64bytes");
 
   void RegisterInfo(FEX::HLE::SyscallHandler *Handler) {
-    REGISTER_SYSCALL_IMPL_X32(oldolduname, [](FEXCore::Core::CpuStateFrame *Frame, struct oldold_utsname *buf) -> uint64_t {
-      struct utsname Local{};
+    REGISTER_SYSCALL_IMPL_X32_FLAGS(oldolduname, FEXCore::IR::SyscallFlags::CACHEABLE, [](FEXCore::Core::CpuStateFrame *Frame, struct oldold_utsname *buf) -> uint64_t {
+      const auto &Uname = FEX::HLE::_SyscallHandler->GetGuestUname();
 
       memset(buf, 0, sizeof(*buf));
-      if (::uname(&Local) == 0) {
-        memcpy(buf->nodename, Local.nodename, __OLD_UTS_LEN);
-      }
-      else {
-        strncpy(buf->nodename, "FEXCore", __OLD_UTS_LEN);
-        LogMan::Msg::EFmt("Couldn't determine host nodename. Defaulting to '{}'", buf->nodename);
-      }
-      strncpy(buf->sysname, "Linux", __OLD_UTS_LEN);
-      uint32_t GuestVersion = FEX::HLE::_SyscallHandler->GetGuestKernelVersion();
-      snprintf(buf->release, __OLD_UTS_LEN, "%d.%d.%d",
-        FEX::HLE::SyscallHandler::KernelMajor(GuestVersion),
-        FEX::HLE::SyscallHandler::KernelMinor(GuestVersion),
-        FEX::HLE::SyscallHandler::KernelPatch(GuestVersion));
-
-      const char version[] = "#" GIT_DESCRIBE_STRING " SMP " __DATE__ " " __TIME__;
-      strncpy(buf->version, version, __OLD_UTS_LEN);
-      // Tell the guest that we are a 64bit kernel
-      strncpy(buf->machine, "x86_64", __OLD_UTS_LEN);
+      strncpy(buf->sysname, Uname.sysname, __OLD_UTS_LEN);
+      strncpy(buf->nodename, Uname.nodename, __OLD_UTS_LEN);
+      strncpy(buf->release, Uname.release, __OLD_UTS_LEN);
+      strncpy(buf->version, Uname.version, __OLD_UTS_LEN);
+      strncpy(buf->machine, Uname.machine, __OLD_UTS_LEN);
       return 0;
     });
 
-    REGISTER_SYSCALL_IMPL_X32(olduname, [](FEXCore::Core::CpuStateFrame *Frame, struct old_utsname *buf) -> uint64_t {
-      struct utsname Local{};
+    REGISTER_SYSCALL_IMPL_X32_FLAGS(olduname, FEXCore::IR::SyscallFlags::CACHEABLE, [](FEXCore::Core::CpuStateFrame *Frame, struct old_utsname *buf) -> uint64_t {
+      const auto &Uname = FEX::HLE::_SyscallHandler->GetGuestUname();
 
       memset(buf, 0, sizeof(*buf));
-      if (::uname(&Local) == 0) {
-        memcpy(buf->nodename, Local.nodename, __NEW_UTS_LEN);
-      }
-      else {
-        strncpy(buf->nodename, "FEXCore", __NEW_UTS_LEN);
-        LogMan::Msg::EFmt("Couldn't determine host nodename. Defaulting to '{}'", buf->nodename);
-      }
-      strncpy(buf->sysname, "Linux", __NEW_UTS_LEN);
-      uint32_t GuestVersion = FEX::HLE::_SyscallHandler->GetGuestKernelVersion();
-      snprintf(buf->release, __NEW_UTS_LEN, "%d.%d.%d",
-        FEX::HLE::SyscallHandler::KernelMajor(GuestVersion),
-        FEX::HLE::SyscallHandler::KernelMinor(GuestVersion),
-        FEX::HLE::SyscallHandler::KernelPatch(GuestVersion));
-
-      const char version[] = "#" GIT_DESCRIBE_STRING " SMP " __DATE__ " " __TIME__;
-      strncpy(buf->version, version, __NEW_UTS_LEN);
-      // Tell the guest that we are a 64bit kernel
-      strncpy(buf->machine, "x86_64", __NEW_UTS_LEN);
+      strncpy(buf->sysname, Uname.sysname, __NEW_UTS_LEN);
+      strncpy(buf->nodename, Uname.nodename, __NEW_UTS_LEN);
+      strncpy(buf->release, Uname.release, __NEW_UTS_LEN);
+      strncpy(buf->version, Uname.version, __NEW_UTS_LEN);
+      strncpy(buf->machine, Uname.machine, __NEW_UTS_LEN);
       return 0;
     });
 
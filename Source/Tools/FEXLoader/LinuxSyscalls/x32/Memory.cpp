@@ -23,7 +23,13 @@ namespace FEX::HLE::x32 {
   void *x32SyscallHandler::GuestMmap(FEXCore::Core::InternalThreadState *Thread, void *addr, size_t length, int prot, int flags, int fd, off_t offset) {
     LOGMAN_THROW_AA_FMT((length >> 32) == 0, "values must fit to 32 bits");
 
-    auto Result = (uint64_t)GetAllocator()->Mmap((void*)addr, length, prot, flags, fd, offset);
+    uint64_t Result{};
+    if (WantsHugePages(length, flags)) {
+      Result = (uint64_t)MmapHugePages(GetAllocator(), addr, length, prot, flags, fd, offset);
+    }
+    else {
+      Result = (uint64_t)GetAllocator()->Mmap((void*)addr, length, prot, flags, fd, offset);
+    }
 
     LOGMAN_THROW_AA_FMT((Result >> 32) == 0|| (Result >> 32) == 0xFFFFFFFF, "values must fit to 32 bits");
 
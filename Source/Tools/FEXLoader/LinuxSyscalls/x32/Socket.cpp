@@ -5,6 +5,7 @@ $end_info$
 */
 
 #include "LinuxSyscalls/Syscalls.h"
+#include "LinuxSyscalls/x32/IOVec.h"
 #include "LinuxSyscalls/x32/Syscalls.h"
 #include "LinuxSyscalls/x32/Types.h"
 #include "LinuxSyscalls/x64/Syscalls.h"
@@ -13,6 +14,7 @@ $end_info$
 #include <FEXCore/fextl/vector.h>
 
 #include <alloca.h>
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 #include <memory>
@@ -123,10 +125,7 @@ namespace FEX::HLE::x32 {
 
   static uint64_t SendMsg(int sockfd, const struct msghdr32 *msg, int flags) {
     struct msghdr HostHeader{};
-    fextl::vector<iovec> Host_iovec(msg->msg_iovlen);
-    for (size_t i = 0; i < msg->msg_iovlen; ++i) {
-      Host_iovec[i] = msg->msg_iov[i];
-    }
+    HostIOVec Host_iovec(msg->msg_iov, msg->msg_iovlen);
 
     HostHeader.msg_name = msg->msg_name;
     HostHeader.msg_namelen = msg->msg_namelen;
@@ -179,10 +178,7 @@ namespace FEX::HLE::x32 {
 
   static uint64_t RecvMsg(int sockfd, struct msghdr32 *msg, int flags) {
     struct msghdr HostHeader{};
-    fextl::vector<iovec> Host_iovec(msg->msg_iovlen);
-    for (size_t i = 0; i < msg->msg_iovlen; ++i) {
-      Host_iovec[i] = msg->msg_iov[i];
-    }
+    HostIOVec Host_iovec(msg->msg_iov, msg->msg_iovlen);
 
     HostHeader.msg_name = msg->msg_name;
     HostHeader.msg_namelen = msg->msg_namelen;
@@ -197,10 +193,7 @@ namespace FEX::HLE::x32 {
 
     uint64_t Result = ::recvmsg(sockfd, &HostHeader, flags);
     if (Result != -1) {
-      for (size_t i = 0; i < msg->msg_iovlen; ++i) {
-        msg->msg_iov[i] = Host_iovec[i];
-      }
-
+      // The kernel doesn't write back to the iovecs, the guest's copy is still current
       msg->msg_namelen = HostHeader.msg_namelen;
       msg->msg_controllen = HostHeader.msg_controllen;
       msg->msg_flags = HostHeader.msg_flags;
@@ -238,31 +231,33 @@ namespace FEX::HLE::x32 {
     SYSCALL_ERRNO();
   }
 
-  void ConvertHeaderToHost(fextl::vector<iovec> &iovec, struct msghdr *Host, const struct msghdr32 *Guest) {
-    size_t CurrentIOVecSize = iovec.size();
-    iovec.resize(CurrentIOVecSize + Guest->msg_iovlen);
-    for (size_t i = 0; i < Guest->msg_iovlen; ++i) {
-      iovec[CurrentIOVecSize + i] = Guest->msg_iov[i];
-    }
+  // The kernel caps sendmmsg/recvmmsg batches at UIO_MAXIOV messages
+  constexpr static uint32_t MAX_MMSG_COUNT = 1024;
+
+  // Arena space ConvertHeaderToHost needs for one header
+  static size_t HostHeaderArenaSize(const struct msghdr32 *Guest) {
+    return ScratchArena::AllocationSize<iovec>(Guest->msg_iovlen) +
+      ScratchArena::AllocationSize<uint8_t>(Guest->msg_controllen * 2);
+  }
+
+  void ConvertHeaderToHost(ScratchArena &Arena, struct msghdr *Host, const struct msghdr32 *Guest) {
+    iovec *HostIOV = Arena.Allocate<iovec>(Guest->msg_iovlen);
+    WidenIOVecs(HostIOV, Guest->msg_iov, Guest->msg_iovlen);
 
     Host->msg_name = Guest->msg_name;
     Host->msg_namelen = Guest->msg_namelen;
 
-    Host->msg_iov = &iovec[CurrentIOVecSize];
+    Host->msg_iov = HostIOV;
     Host->msg_iovlen = Guest->msg_iovlen;
 
-    // XXX: This could result in a stack overflow
-    Host->msg_control = alloca(Guest->msg_controllen*2);
+    Host->msg_control = Arena.Allocate<uint8_t>(Guest->msg_controllen * 2);
     Host->msg_controllen = Guest->msg_controllen*2;
 
     Host->msg_flags = Guest->msg_flags;
   }
 
   void ConvertHeaderToGuest(struct msghdr32 *Guest, struct msghdr *Host) {
-    for (size_t i = 0; i < Guest->msg_iovlen; ++i) {
-      Guest->msg_iov[i] = Host->msg_iov[i];
-    }
-
+    // The kernel doesn't write back to the iovecs, the guest's copy is still current
     Guest->msg_namelen = Host->msg_namelen;
     Guest->msg_controllen = Host->msg_controllen;
     Guest->msg_flags = Host->msg_flags;
@@ -299,13 +294,22 @@ namespace FEX::HLE::x32 {
   }
 
   static uint64_t RecvMMsg(int sockfd, compat_ptr<mmsghdr_32> msgvec, uint32_t vlen, int flags, struct timespec *timeout_ts) {
-    fextl::vector<iovec> Host_iovec;
-    fextl::vector<struct mmsghdr> HostMHeader(vlen);
+    vlen = std::min(vlen, MAX_MMSG_COUNT);
+
+    // Everything is sized up front so the whole batch comes out of one arena
+    size_t ArenaSize = ScratchArena::AllocationSize<struct mmsghdr>(vlen);
+    for (size_t i = 0; i < vlen; ++i) {
+      ArenaSize += HostHeaderArenaSize(&msgvec[i].msg_hdr);
+    }
+
+    ScratchArena Arena(ArenaSize);
+    struct mmsghdr *HostMHeader = Arena.Allocate<struct mmsghdr>(vlen);
     for (size_t i = 0; i < vlen; ++i) {
-      ConvertHeaderToHost(Host_iovec, &HostMHeader[i].msg_hdr, &msgvec[i].msg_hdr);
+      HostMHeader[i] = {};
+      ConvertHeaderToHost(Arena, &HostMHeader[i].msg_hdr, &msgvec[i].msg_hdr);
       HostMHeader[i].msg_len = msgvec[i].msg_len;
     }
-    uint64_t Result = ::recvmmsg(sockfd, HostMHeader.data(), vlen, flags, timeout_ts);
+    uint64_t Result = ::recvmmsg(sockfd, HostMHeader, vlen, flags, timeout_ts);
     if (Result != -1) {
       for (size_t i = 0; i < Result; ++i) {
         ConvertHeaderToGuest(&msgvec[i].msg_hdr, &HostMHeader[i].msg_hdr);
@@ -316,39 +320,30 @@ namespace FEX::HLE::x32 {
   }
 
   static uint64_t SendMMsg(int sockfd, compat_ptr<mmsghdr_32> msgvec, uint32_t vlen, int flags) {
-    fextl::vector<iovec> Host_iovec;
-    fextl::vector<struct mmsghdr> HostMmsg(vlen);
+    vlen = std::min(vlen, MAX_MMSG_COUNT);
 
-    // Walk the iovec and convert them
-    // Calculate controllen at the same time
-    size_t Controllen_size{};
+    // Everything is sized up front so the whole batch comes out of one arena
+    size_t ArenaSize = ScratchArena::AllocationSize<struct mmsghdr>(vlen);
     for (size_t i = 0; i < vlen; ++i) {
-      msghdr32 &guest = msgvec[i].msg_hdr;
-
-      Controllen_size += guest.msg_controllen * 2;
-      for (size_t j = 0; j < guest.msg_iovlen; ++j) {
-        iovec guest_iov = guest.msg_iov[j];
-        Host_iovec.emplace_back(guest_iov);
-      }
+      ArenaSize += HostHeaderArenaSize(&msgvec[i].msg_hdr);
     }
 
-    fextl::vector<uint8_t> Controllen(Controllen_size);
+    ScratchArena Arena(ArenaSize);
+    struct mmsghdr *HostMmsg = Arena.Allocate<struct mmsghdr>(vlen);
 
-    size_t current_iov{};
-    size_t current_controllen_offset{};
     for (size_t i = 0; i < vlen; ++i) {
       msghdr32 &guest = msgvec[i].msg_hdr;
+      HostMmsg[i] = {};
       struct msghdr &msg = HostMmsg[i].msg_hdr;
       msg.msg_name = guest.msg_name;
       msg.msg_namelen = guest.msg_namelen;
 
-      msg.msg_iov = &Host_iovec.at(current_iov);
+      msg.msg_iov = Arena.Allocate<iovec>(guest.msg_iovlen);
       msg.msg_iovlen = guest.msg_iovlen;
-      current_iov += msg.msg_iovlen;
+      WidenIOVecs(msg.msg_iov, guest.msg_iov, guest.msg_iovlen);
 
       if (guest.msg_controllen) {
-        msg.msg_control = &Controllen.at(current_controllen_offset);
-        current_controllen_offset += guest.msg_controllen * 2;
+        msg.msg_control = Arena.Allocate<uint8_t>(guest.msg_controllen * 2);
       }
       msg.msg_controllen = guest.msg_controllen;
 
@@ -392,7 +387,7 @@ namespace FEX::HLE::x32 {
       HostMmsg[i].msg_len = msgvec[i].msg_len;
     }
 
-    uint64_t Result = ::sendmmsg(sockfd, HostMmsg.data(), vlen, flags);
+    uint64_t Result = ::sendmmsg(sockfd, HostMmsg, vlen, flags);
 
     if (Result != -1) {
       // Update guest msglen
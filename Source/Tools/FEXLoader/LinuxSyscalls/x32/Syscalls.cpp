@@ -8,6 +8,7 @@ $end_info$
 #include "LinuxSyscalls/x32/IoctlEmulation.h"
 #include "LinuxSyscalls/x32/Syscalls.h"
 #include "LinuxSyscalls/x32/SyscallsEnum.h"
+#include "LinuxSyscalls/x64/Syscalls.h"
 
 #include <FEXCore/HLE/SyscallHandler.h>
 #include <FEXCore/Utils/LogManager.h>
@@ -17,6 +18,7 @@ $end_info$
 #include <cerrno>
 #include <cstdint>
 #include <limits>
+#include <linux/futex.h>
 #include <mutex>
 #include <sys/mman.h>
 #include <sys/shm.h>
@@ -111,6 +113,32 @@ namespace FEX::HLE::x32 {
 #endif
   }
 
+  int32_t x32SyscallHandler::GetPassthroughHostSyscall(uint64_t Syscall, const FEXCore::HLE::SyscallArguments &Args, uint32_t ConstantMask) const {
+    if (Syscall == SYSCALL_x86_futex) {
+      // futex only needs its timespec32 converted for the waiting commands with a timeout.
+      // Every other command, like the FUTEX_WAKE and untimed FUTEX_WAIT that guest mutexes and condvars use,
+      // can go straight to the host futex.
+      constexpr uint32_t FutexOpArg = 1;
+      constexpr uint32_t TimeoutArg = 3;
+
+      if (ConstantMask & (1U << TimeoutArg) && Args.Argument[TimeoutArg] == 0) {
+        return SYSCALL_DEF(futex);
+      }
+
+      if (ConstantMask & (1U << FutexOpArg)) {
+        const int cmd = Args.Argument[FutexOpArg] & FUTEX_CMD_MASK;
+        if (cmd != FUTEX_WAIT &&
+            cmd != FUTEX_LOCK_PI &&
+            cmd != FUTEX_WAIT_BITSET &&
+            cmd != FUTEX_WAIT_REQUEUE_PI) {
+          return SYSCALL_DEF(futex);
+        }
+      }
+    }
+
+    return -1;
+  }
+
   fextl::unique_ptr<FEX::HLE::SyscallHandler> CreateHandler(FEXCore::Context::Context *ctx, FEX::HLE::SignalDelegator *_SignalDelegation, fextl::unique_ptr<MemAllocator> Allocator) {
     return fextl::make_unique<x32SyscallHandler>(ctx, _SignalDelegation, std::move(Allocator));
   }
@@ -40,6 +40,8 @@ public:
   void *GuestMmap(FEXCore::Core::InternalThreadState *Thread, void *addr, size_t length, int prot, int flags, int fd, off_t offset) override;
   int GuestMunmap(FEXCore::Core::InternalThreadState *Thread, void *addr, uint64_t length) override;
 
+  int32_t GetPassthroughHostSyscall(uint64_t Syscall, const FEXCore::HLE::SyscallArguments &Args, uint32_t ConstantMask) const override;
+
   void RegisterSyscall_32(int SyscallNumber,
     int32_t HostSyscallNumber,
     FEXCore::IR::SyscallFlags Flags,
@@ -99,6 +99,8 @@ namespace FEX::HLE::x32 {
   }
 
   void RegisterThread(FEX::HLE::SyscallHandler *Handler) {
+    using namespace FEXCore::IR;
+
     REGISTER_SYSCALL_IMPL_X32(sigreturn, [](FEXCore::Core::CpuStateFrame *Frame) -> uint64_t {
       FEX::HLE::_SyscallHandler->GetSignalDelegator()->HandleSignalHandlerReturn(false);
       FEX_UNREACHABLE;
@@ -188,7 +190,9 @@ namespace FEX::HLE::x32 {
       return 0;
     });
 
-    REGISTER_SYSCALL_IMPL_X32(futex, [](FEXCore::Core::CpuStateFrame *Frame, int *uaddr, int futex_op, int val, const timespec32 *timeout, int *uaddr2, uint32_t val3) -> uint64_t {
+    // x32SyscallHandler::GetPassthroughHostSyscall inlines the commands that don't need the timeout converted
+    REGISTER_SYSCALL_IMPL_X32_FLAGS(futex, SyscallFlags::OPTIMIZETHROUGH | SyscallFlags::NOSYNCSTATEONENTRY,
+      [](FEXCore::Core::CpuStateFrame *Frame, int *uaddr, int futex_op, int val, const timespec32 *timeout, int *uaddr2, uint32_t val3) -> uint64_t {
       void* timeout_ptr = (void*)timeout;
       struct timespec tp64{};
       int cmd = futex_op & FUTEX_CMD_MASK;
@@ -9,6 +9,7 @@ $end_info$
 #include "LinuxSyscalls/x32/Types.h"
 
 #include "LinuxSyscalls/x64/Syscalls.h"
+#include "VDSO_Emulation.h"
 
 #include <stdint.h>
 #include <syscall.h>
@@ -31,15 +32,15 @@ namespace FEX::HLE::x32 {
   void RegisterTime(FEX::HLE::SyscallHandler *Handler) {
 
     REGISTER_SYSCALL_IMPL_X32(time, [](FEXCore::Core::CpuStateFrame *Frame, FEX::HLE::x32::old_time32_t *tloc) -> uint64_t {
-      time_t Host{};
-      uint64_t Result = ::time(&Host);
+      // The time is also the result, so the vDSO never needs a pointer
+      const time_t Result = FEX::VDSO::HostVDSO::Time(nullptr);
 
-      if (tloc) {
+      if (tloc && Result >= 0) {
         // On 32-bit this truncates
-        *tloc = (FEX::HLE::x32::old_time32_t)Host;
+        *tloc = (FEX::HLE::x32::old_time32_t)Result;
       }
 
-      SYSCALL_ERRNO();
+      return Result;
     });
 
     REGISTER_SYSCALL_IMPL_X32(times, [](FEXCore::Core::CpuStateFrame *Frame, struct FEX::HLE::x32::compat_tms *buf) -> uint64_t {
@@ -69,12 +70,25 @@ namespace FEX::HLE::x32 {
         tv_ptr = &tv64;
       }
 
-      uint64_t Result = ::gettimeofday(tv_ptr, tz);
+      uint64_t Result{};
+      if (tz) {
+        // tz is guest memory, only the syscall returns EFAULT for it
+        Result = ::syscall(SYSCALL_DEF(gettimeofday), tv_ptr, tz);
+        if (Result == -1) {
+          return -errno;
+        }
+      }
+      else {
+        Result = FEX::VDSO::HostVDSO::GetTimeOfDay(tv_ptr, nullptr);
+        if (Result != 0) {
+          return Result;
+        }
+      }
 
       if (tv) {
         *tv = tv64;
       }
-      SYSCALL_ERRNO();
+      return Result;
     });
 
     REGISTER_SYSCALL_IMPL_X32(settimeofday, [](FEXCore::Core::CpuStateFrame *Frame, const timeval32 *tv, const struct timezone *tz) -> uint64_t {
@@ -114,20 +128,20 @@ namespace FEX::HLE::x32 {
 
     REGISTER_SYSCALL_IMPL_X32(clock_gettime, [](FEXCore::Core::CpuStateFrame *Frame, clockid_t clk_id, timespec32 *tp) -> uint64_t {
       struct timespec tp64{};
-      uint64_t Result = ::clock_gettime(clk_id, &tp64);
-      if (tp) {
+      const int Result = FEX::VDSO::HostVDSO::ClockGetTime(clk_id, &tp64);
+      if (tp && Result == 0) {
         *tp = tp64;
       }
-      SYSCALL_ERRNO();
+      return Result;
     });
 
     REGISTER_SYSCALL_IMPL_X32(clock_getres, [](FEXCore::Core::CpuStateFrame *Frame, clockid_t clk_id, timespec32 *tp) -> uint64_t {
       struct timespec tp64{};
-      uint64_t Result = ::clock_getres(clk_id, &tp64);
-      if (tp) {
+      const int Result = FEX::VDSO::HostVDSO::ClockGetRes(clk_id, &tp64);
+      if (tp && Result == 0) {
         *tp = tp64;
       }
-      SYSCALL_ERRNO();
+      return Result;
     });
 
     REGISTER_SYSCALL_IMPL_X32(clock_nanosleep, [](FEXCore::Core::CpuStateFrame *Frame, clockid_t clockid, int flags, const timespec32 *request, timespec32 *remain) -> uint64_t {
@@ -196,8 +210,7 @@ namespace FEX::HLE::x32 {
     });
 
     REGISTER_SYSCALL_IMPL_X32_PASS_MANUAL(clock_gettime64, clock_gettime, [](FEXCore::Core::CpuStateFrame *Frame, clockid_t clk_id, timespec *tp) -> uint64_t {
-      uint64_t Result = ::clock_gettime(clk_id, tp);
-      SYSCALL_ERRNO();
+      return FEX::VDSO::HostVDSO::ClockGetTime(clk_id, tp);
     });
 
     REGISTER_SYSCALL_IMPL_X32_PASS_MANUAL(clock_adjtime64, clock_adjtime, [](FEXCore::Core::CpuStateFrame *Frame, clockid_t clk_id, struct timex *buf) -> uint64_t {
@@ -211,8 +224,7 @@ namespace FEX::HLE::x32 {
     });
 
     REGISTER_SYSCALL_IMPL_X32_PASS_MANUAL(clock_getres_time64, clock_getres, [](FEXCore::Core::CpuStateFrame *Frame, clockid_t clk_id, timespec *tp) -> uint64_t {
-      uint64_t Result = ::clock_getres(clk_id, tp);
-      SYSCALL_ERRNO();
+      return FEX::VDSO::HostVDSO::ClockGetRes(clk_id, tp);
     });
 
     REGISTER_SYSCALL_IMPL_X32_PASS_MANUAL(clock_nanosleep_time64, clock_nanosleep, [](FEXCore::Core::CpuStateFrame *Frame, clockid_t clockid, int flags, const struct timespec *request, struct timespec *remain) -> uint64_t {
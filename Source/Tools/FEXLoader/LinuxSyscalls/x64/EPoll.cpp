@@ -5,13 +5,12 @@ tags: LinuxSyscalls|syscalls-x86-64
 $end_info$
 */
 
+#include "LinuxSyscalls/EPollEvents.h"
 #include "LinuxSyscalls/Syscalls.h"
 #include "LinuxSyscalls/Types.h"
 #include "LinuxSyscalls/x64/Syscalls.h"
 #include "LinuxSyscalls/x64/Types.h"
 
-#include <FEXCore/fextl/vector.h>
-
 #include <algorithm>
 #include <cstdint>
 #include <stddef.h>
@@ -27,13 +26,11 @@ namespace FEXCore::Core {
 namespace FEX::HLE::x64 {
   void RegisterEpoll(FEX::HLE::SyscallHandler *Handler) {
     REGISTER_SYSCALL_IMPL_X64(epoll_wait, [](FEXCore::Core::CpuStateFrame *Frame, int epfd, FEX::HLE::epoll_event_x86 *events, int maxevents, int timeout) -> uint64_t {
-      fextl::vector<struct epoll_event> Events(std::max(0, maxevents));
+      FEX::HLE::HostEPollEvents<FEX::HLE::epoll_event_x86> Events(events, maxevents);
       uint64_t Result = ::syscall(SYSCALL_DEF(epoll_pwait), epfd, Events.data(), maxevents, timeout, nullptr, 8);
 
       if (Result != -1) {
-        for (size_t i = 0; i < Result; ++i) {
-          events[i] = Events[i];
-        }
+        Events.CopyOut(Result);
       }
       SYSCALL_ERRNO();
     });
@@ -53,7 +50,7 @@ namespace FEX::HLE::x64 {
     });
 
     REGISTER_SYSCALL_IMPL_X64(epoll_pwait, [](FEXCore::Core::CpuStateFrame *Frame, int epfd, FEX::HLE::epoll_event_x86 *events, int maxevent, int timeout, const uint64_t* sigmask, size_t sigsetsize) -> uint64_t {
-      fextl::vector<struct epoll_event> Events(std::max(0, maxevent));
+      FEX::HLE::HostEPollEvents<FEX::HLE::epoll_event_x86> Events(events, maxevent);
 
       uint64_t Result = ::syscall(SYSCALL_DEF(epoll_pwait),
         epfd,
@@ -64,9 +61,7 @@ namespace FEX::HLE::x64 {
         sigsetsize);
 
       if (Result != -1) {
-        for (size_t i = 0; i < Result; ++i) {
-          events[i] = Events[i];
-        }
+        Events.CopyOut(Result);
       }
 
       SYSCALL_ERRNO();
@@ -74,7 +69,7 @@ namespace FEX::HLE::x64 {
 
     if (Handler->IsHostKernelVersionAtLeast(5, 11, 0)) {
       REGISTER_SYSCALL_IMPL_X64(epoll_pwait2, [](FEXCore::Core::CpuStateFrame *Frame, int epfd, FEX::HLE::epoll_event_x86 *events, int maxevent, timespec *timeout, const uint64_t* sigmask, size_t sigsetsize) -> uint64_t {
-        fextl::vector<struct epoll_event> Events(std::max(0, maxevent));
+        FEX::HLE::HostEPollEvents<FEX::HLE::epoll_event_x86> Events(events, maxevent);
 
         uint64_t Result = ::syscall(SYSCALL_DEF(epoll_pwait2),
           epfd,
@@ -85,9 +80,7 @@ namespace FEX::HLE::x64 {
           sigsetsize);
 
         if (Result != -1) {
-          for (size_t i = 0; i < Result; ++i) {
-            events[i] = Events[i];
-          }
+          Events.CopyOut(Result);
         }
 
         SYSCALL_ERRNO();
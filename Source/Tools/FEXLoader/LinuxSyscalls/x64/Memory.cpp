@@ -26,7 +26,14 @@ namespace FEX::HLE::x64 {
     uint64_t Result{};
 
     bool Map32Bit = flags & FEX::HLE::X86_64_MAP_32BIT;
-    if (Map32Bit) {
+    if (WantsHugePages(length, flags)) {
+      auto Alloc = Map32Bit ? Get32BitAllocator() : GetHostAllocator();
+      Result = (uint64_t)MmapHugePages(Alloc, addr, length, prot, flags, fd, offset);
+      if (FEX::HLE::HasSyscallError(Result)) {
+        errno = -Result;
+        Result = -1;
+      }
+    } else if (Map32Bit) {
       Result = (uint64_t)Get32BitAllocator()->Mmap(addr, length, prot,flags, fd, offset);
       if (FEX::HLE::HasSyscallError(Result)) {
         errno = -Result;
@@ -34,9 +34,11 @@ $end_info$
 #include <FEXCore/fextl/string.h>
 #include <FEXCore/fextl/vector.h>
 
+#include <chrono>
 #include <csetjmp>
 #include <cstdint>
 #include <errno.h>
+#include <optional>
 #include <signal.h>
 #include <stdio.h>
 #include <sys/types.h>
@@ -107,7 +109,12 @@ private:
 }
 
 namespace LongJumpHandler {
+#ifndef _WIN32
+  // The jump leaves a signal handler, the signal mask has to be restored for the next test in the process to fault
+  static sigjmp_buf LongJump{};
+#else
   static jmp_buf LongJump{};
+#endif
   static bool DidFault{};
 
 #ifndef _WIN32
@@ -119,7 +126,7 @@ namespace LongJumpHandler {
         return false;
       }
 
-      longjmp(LongJumpHandler::LongJump, 1);
+      siglongjmp(LongJumpHandler::LongJump, 1);
       return false;
     }, true);
   }
@@ -182,28 +189,29 @@ namespace LongJumpHandler {
 #endif
 }
 
-int main(int argc, char **argv, char **const envp) {
-#ifndef _WIN32
-  auto SBRKPointer = FEXCore::Allocator::DisableSBRKAllocations();
-#endif
-  FEXCore::Allocator::GLIBCScopedFault GLIBFaultScope;
-  LogMan::Throw::InstallHandler(AssertHandler);
-  LogMan::Msg::InstallHandler(MsgHandler);
-  FEXCore::Config::Initialize();
-  FEXCore::Config::AddLayer(fextl::make_unique<FEX::ArgLoader::ArgLoader>(argc, argv));
-  FEXCore::Config::AddLayer(FEX::Config::CreateEnvironmentLayer(envp));
-  FEXCore::Config::Load();
-
-  auto Args = FEX::ArgLoader::Get();
+namespace {
+enum class TestResult {
+  Passed,
+  Failed,
+  Unsupported,
+};
 
-  if (Args.size() < 2) {
-    LogMan::Msg::EFmt("Not enough arguments");
-    return -1;
+constexpr const char *TestResultName(TestResult Result) {
+  switch (Result) {
+    case TestResult::Passed: return "Passed";
+    case TestResult::Failed: return "Failed";
+    case TestResult::Unsupported: return "Unsupported";
   }
+  return "Unknown";
+}
 
-  FEX::HarnessHelper::HarnessCodeLoader Loader{Args[0], Args[1]};
+// Tests share the process, the static tables and the base config layers.
+// Everything else, from the context down to the guest memory, is created fresh for each test.
+TestResult RunTest(fextl::string const &TestFile, fextl::string const &ConfigFile, std::optional<FEXCore::Context::OperatingMode> *TablesMode) {
+  FEX::HarnessHelper::HarnessCodeLoader Loader{TestFile, ConfigFile};
 
-  // Adds in environment options from the test harness config
+  // Adds in environment options from the test harness config, replacing the previous test's
+  FEXCore::Config::RemoveLayer(FEXCore::Config::LayerType::LAYER_LOCAL_APP);
   FEXCore::Config::AddLayer(fextl::make_unique<TestEnvLoader>(Loader.GetEnvironmentOptions()));
   FEXCore::Config::ReloadMetaLayer();
 
@@ -217,8 +225,10 @@ int main(int argc, char **argv, char **const envp) {
   if (!Loader.Is64BitMode()) {
     // Setup our userspace allocator
     uint32_t KernelVersion = FEX::HLE::SyscallHandler::CalculateHostKernelVersion();
-    if (KernelVersion >= FEX::HLE::SyscallHandler::KernelVersion(4, 17)) {
+    static bool HooksInstalled = false;
+    if (KernelVersion >= FEX::HLE::SyscallHandler::KernelVersion(4, 17) && !HooksInstalled) {
       FEXCore::Allocator::SetupHooks();
+      HooksInstalled = true;
     }
 
     if (KernelVersion < FEX::HLE::SyscallHandler::KernelVersion(4, 17)) {
@@ -233,7 +243,12 @@ int main(int argc, char **argv, char **const envp) {
   bool SupportsAVX = false;
   FEXCore::Core::CPUState State;
 
-  FEXCore::Context::InitializeStaticTables(Loader.Is64BitMode() ? FEXCore::Context::MODE_64BIT : FEXCore::Context::MODE_32BIT);
+  // Only the mode dependent tables need switching over between tests
+  const auto Mode = Loader.Is64BitMode() ? FEXCore::Context::MODE_64BIT : FEXCore::Context::MODE_32BIT;
+  if (*TablesMode != Mode) {
+    FEXCore::Context::InitializeStaticTables(Mode);
+    *TablesMode = Mode;
+  }
 
   auto CTX = FEXCore::Context::Context::CreateNewContext();
 
@@ -262,16 +277,19 @@ int main(int argc, char **argv, char **const envp) {
     (!HostFeatures.SupportsCLZERO && Loader.RequiresCLZERO()) ||
     (!HostFeatures.SupportsBMI1 && Loader.RequiresBMI1()) ||
     (!HostFeatures.SupportsBMI2 && Loader.RequiresBMI2()) ||
-    (!HostFeatures.SupportsCLWB && Loader.RequiresCLWB());
+    (!HostFeatures.SupportsCLWB && Loader.RequiresCLWB()) ||
+    (!HostFeatures.SupportsFlushInputsToZero && Loader.RequiresAFP());
 
 #ifdef _WIN32
     TestUnsupported |= Loader.RequiresLinux();
 #endif
 
   if (TestUnsupported) {
-    return 0;
+    return TestResult::Unsupported;
   }
 
+  LongJumpHandler::DidFault = false;
+
   if (Core != FEXCore::Config::CONFIG_CUSTOM) {
 #ifndef _WIN32
     auto SyscallHandler = Loader.Is64BitMode() ? FEX::HLE::x64::CreateHandler(CTX.get(), SignalDelegation.get())
@@ -286,8 +304,8 @@ int main(int argc, char **argv, char **const envp) {
     // Run through FEX
     if (!Loader.MapMemory()) {
       // failed to map
-      LogMan::Msg::EFmt("Failed to map %d-bit elf file.", Loader.Is64BitMode() ? 64 : 32);
-      return -ENOEXEC;
+      LogMan::Msg::EFmt("Failed to map {}-bit elf file.", Loader.Is64BitMode() ? 64 : 32);
+      return TestResult::Failed;
     }
 
     CTX->SetSignalDelegator(SignalDelegation.get());
@@ -296,10 +314,14 @@ int main(int argc, char **argv, char **const envp) {
     bool Result1 = CTX->InitCore(Loader.DefaultRIP(), Loader.GetStackPointer());
 
     if (!Result1) {
-      return 1;
+      return TestResult::Failed;
     }
 
+#ifndef _WIN32
+    int LongJumpVal = sigsetjmp(LongJumpHandler::LongJump, 1);
+#else
     int LongJumpVal = setjmp(LongJumpHandler::LongJump);
+#endif
     if (!LongJumpVal) {
       CTX->RunUntilExit();
     }
@@ -316,8 +338,8 @@ int main(int argc, char **argv, char **const envp) {
     SignalDelegation->RegisterTLSState((FEXCore::Core::InternalThreadState*)UINTPTR_MAX);
     if (!Loader.MapMemory()) {
       // failed to map
-      LogMan::Msg::EFmt("Failed to map %d-bit elf file.", Loader.Is64BitMode() ? 64 : 32);
-      return -ENOEXEC;
+      LogMan::Msg::EFmt("Failed to map {}-bit elf file.", Loader.Is64BitMode() ? 64 : 32);
+      return TestResult::Failed;
     }
 
     RunAsHost(SignalDelegation, Loader.DefaultRIP(), Loader.GetStackPointer(), &State);
@@ -329,8 +351,54 @@ int main(int argc, char **argv, char **const envp) {
   LogMan::Msg::IFmt("Faulted? {}", LongJumpHandler::DidFault ? "Yes" : "No");
   LogMan::Msg::IFmt("Passed? {}", Passed ? "Yes" : "No");
 
+  return Passed ? TestResult::Passed : TestResult::Failed;
+}
+}
 
-  SignalDelegation.reset();
+int main(int argc, char **argv, char **const envp) {
+#ifndef _WIN32
+  auto SBRKPointer = FEXCore::Allocator::DisableSBRKAllocations();
+#endif
+  FEXCore::Allocator::GLIBCScopedFault GLIBFaultScope;
+  LogMan::Throw::InstallHandler(AssertHandler);
+  LogMan::Msg::InstallHandler(MsgHandler);
+  FEXCore::Config::Initialize();
+  FEXCore::Config::AddLayer(fextl::make_unique<FEX::ArgLoader::ArgLoader>(argc, argv));
+  FEXCore::Config::AddLayer(FEX::Config::CreateEnvironmentLayer(envp));
+  FEXCore::Config::Load();
+
+  auto Args = FEX::ArgLoader::Get();
+
+  // Takes any number of <test> <config> pairs, which all run in this process one after another
+  if (Args.size() < 2 || (Args.size() % 2) != 0) {
+    LogMan::Msg::EFmt("Expected pairs of test and config files");
+    return -1;
+  }
+
+#ifdef _WIN32
+  // Guest memory can't be released and mapped again at the same address, each test needs its own process
+  if (Args.size() > 2) {
+    LogMan::Msg::EFmt("Only a single test per process is supported");
+    return -1;
+  }
+#endif
+
+  std::optional<FEXCore::Context::OperatingMode> TablesMode{};
+  size_t Failures{};
+
+  for (size_t i = 0; i < Args.size(); i += 2) {
+    const auto Start = std::chrono::steady_clock::now();
+    const auto Result = RunTest(Args[i], Args[i + 1], &TablesMode);
+    const auto Duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - Start);
+
+    if (Result == TestResult::Failed) {
+      ++Failures;
+    }
+
+    // Printed even when silent, testharness_batch_runner.py collects results and timings from these lines
+    fextl::fmt::print("TestResult: {} {} {}\n", Args[i], TestResultName(Result), Duration.count());
+    fflush(stdout);
+  }
 
   FEXCore::Config::Shutdown();
 
@@ -343,6 +411,5 @@ int main(int argc, char **argv, char **const envp) {
   FEXCore::Allocator::ReenableSBRKAllocations(SBRKPointer);
 #endif
 
-  return Passed ? 0 : -1;
+  return Failures ? -1 : 0;
 }
-
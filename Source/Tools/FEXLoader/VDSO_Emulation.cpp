@@ -14,6 +14,7 @@
 #include <fcntl.h>
 #include <filesystem>
 #include <sys/mman.h>
+#include <sys/syscall.h>
 #include <sys/time.h>
 #include <unistd.h>
 
@@ -31,6 +32,20 @@ namespace FEX::VDSO {
     ClockGetTimeType ClockGetTimePtr;
     ClockGetResType ClockGetResPtr;
     GetCPUType GetCPUPtr;
+
+    // The AArch64 vDSO has no time entry point, build it from clock_gettime like glibc does
+    static time_t TimeFromClockGetTime(time_t *t) noexcept {
+      struct timespec ts{};
+      int Result = ClockGetTimePtr(CLOCK_REALTIME_COARSE, &ts);
+      if (Result != 0) {
+        return Result;
+      }
+
+      if (t) {
+        *t = ts.tv_sec;
+      }
+      return ts.tv_sec;
+    }
   }
 
   using HandlerPtr = void(*)(void*);
@@ -373,36 +388,51 @@ namespace FEX::VDSO {
       return;
     }
 
-    auto SymbolPtr = dlsym(vdso, "__vdso_time");
+    // x86-64 names its vDSO symbols __vdso_*, AArch64 uses __kernel_*
+    auto LookupSymbol = [vdso](const char *Name) -> void* {
+      auto SymbolPtr = dlsym(vdso, fextl::fmt::format("__vdso_{}", Name).c_str());
+      if (!SymbolPtr) {
+        SymbolPtr = dlsym(vdso, fextl::fmt::format("__kernel_{}", Name).c_str());
+      }
+      return SymbolPtr;
+    };
+
+    auto SymbolPtr = LookupSymbol("time");
     if (SymbolPtr) {
       VDSOHandlers::TimePtr = reinterpret_cast<VDSOHandlers::TimeType>(SymbolPtr);
       x64::Handler_time = x64::VDSO::time;
       x32::Handler_time = x32::VDSO::time;
     }
 
-    SymbolPtr = dlsym(vdso, "__vdso_gettimeofday");
+    SymbolPtr = LookupSymbol("gettimeofday");
     if (SymbolPtr) {
       VDSOHandlers::GetTimeOfDayPtr = reinterpret_cast<VDSOHandlers::GetTimeOfDayType>(SymbolPtr);
       x64::Handler_gettimeofday = x64::VDSO::gettimeofday;
       x32::Handler_gettimeofday = x32::VDSO::gettimeofday;
     }
 
-    SymbolPtr = dlsym(vdso, "__vdso_clock_gettime");
+    SymbolPtr = LookupSymbol("clock_gettime");
     if (SymbolPtr) {
       VDSOHandlers::ClockGetTimePtr = reinterpret_cast<VDSOHandlers::ClockGetTimeType>(SymbolPtr);
       x64::Handler_clock_gettime = x64::VDSO::clock_gettime;
       x32::Handler_clock_gettime = x32::VDSO::clock_gettime;
       x32::Handler_clock_gettime64 = x32::VDSO::clock_gettime64;
+
+      if (!VDSOHandlers::TimePtr) {
+        VDSOHandlers::TimePtr = VDSOHandlers::TimeFromClockGetTime;
+        x64::Handler_time = x64::VDSO::time;
+        x32::Handler_time = x32::VDSO::time;
+      }
     }
 
-    SymbolPtr = dlsym(vdso, "__vdso_clock_getres");
+    SymbolPtr = LookupSymbol("clock_getres");
     if (SymbolPtr) {
       VDSOHandlers::ClockGetResPtr = reinterpret_cast<VDSOHandlers::ClockGetResType>(SymbolPtr);
       x64::Handler_clock_getres = x64::VDSO::clock_getres;
       x32::Handler_clock_getres = x32::VDSO::clock_getres;
     }
 
-    SymbolPtr = dlsym(vdso, "__vdso_getcpu");
+    SymbolPtr = LookupSymbol("getcpu");
     if (SymbolPtr) {
       VDSOHandlers::GetCPUPtr = reinterpret_cast<VDSOHandlers::GetCPUType>(SymbolPtr);
       x64::Handler_getcpu = x64::VDSO::getcpu;
@@ -507,6 +537,11 @@ namespace FEX::VDSO {
     FEX_CONFIG_OPT(ThunkGuestLibs, THUNKGUESTLIBS);
     FEX_CONFIG_OPT(ThunkGuestLibs32, THUNKGUESTLIBS32);
 
+    // Find our host VDSO function implementations.
+    // Done first so the thunk definitions below pick up the VDSO handlers, and so the time syscalls can use them
+    // even without the guest VDSO thunk library.
+    LoadHostVDSO();
+
     fextl::string ThunkGuestPath{};
     if (Is64Bit) {
       ThunkGuestPath = fextl::fmt::format("{}/libVDSO-guest.so", ThunkGuestLibs());
@@ -545,10 +580,6 @@ namespace FEX::VDSO {
 
         // Map the VDSO file to memory
         VDSOBase = Handler->GuestMmap(nullptr, nullptr, VDSOSize, PROT_READ, MAP_PRIVATE, VDSOFD, 0);
-
-        // Since we found our VDSO thunk library, find our host VDSO function implementations.
-        LoadHostVDSO();
-
       }
       close(VDSOFD);
       LoadGuestVDSOSymbols(Is64Bit, reinterpret_cast<char*>(VDSOBase));
@@ -557,6 +588,50 @@ namespace FEX::VDSO {
     return VDSOBase;
   }
 
+  namespace HostVDSO {
+    static int SyscallRet(long Result) {
+      if (Result == -1) {
+        return -errno;
+      }
+      return Result;
+    }
+
+    time_t Time(time_t *tloc) {
+      if (VDSOHandlers::TimePtr && !tloc) {
+        return VDSOHandlers::TimePtr(nullptr);
+      }
+
+#ifdef SYS_time
+      // The syscall returns EFAULT for a bad guest pointer
+      return SyscallRet(::syscall(SYS_time, tloc));
+#else
+      // AArch64 has no time syscall
+      return SyscallRet(::time(tloc));
+#endif
+    }
+
+    int GetTimeOfDay(struct timeval *tv, struct timezone *tz) {
+      if (VDSOHandlers::GetTimeOfDayPtr) {
+        return VDSOHandlers::GetTimeOfDayPtr(tv, tz);
+      }
+      return SyscallRet(::syscall(SYS_gettimeofday, tv, tz));
+    }
+
+    int ClockGetTime(clockid_t clk_id, struct timespec *tp) {
+      if (VDSOHandlers::ClockGetTimePtr) {
+        return VDSOHandlers::ClockGetTimePtr(clk_id, tp);
+      }
+      return SyscallRet(::syscall(SYS_clock_gettime, clk_id, tp));
+    }
+
+    int ClockGetRes(clockid_t clk_id, struct timespec *tp) {
+      if (VDSOHandlers::ClockGetResPtr) {
+        return VDSOHandlers::ClockGetResPtr(clk_id, tp);
+      }
+      return SyscallRet(::syscall(SYS_clock_getres, clk_id, tp));
+    }
+  }
+
   uint64_t GetVSyscallEntry(const void* VDSOBase) {
     if (!VDSOBase) {
       return 0;
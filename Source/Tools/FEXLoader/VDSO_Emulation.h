@@ -4,6 +4,9 @@
 
 #include "LinuxSyscalls/Syscalls.h"
 
+#include <sys/time.h>
+#include <time.h>
+
 namespace FEXCore::Context {
 struct VDSOSigReturn;
 }
@@ -16,4 +19,22 @@ namespace FEX::VDSO {
 
   fextl::vector<FEXCore::IR::ThunkDefinition> const& GetVDSOThunkDefinitions();
   FEXCore::Context::VDSOSigReturn const& GetVDSOSymbols();
+
+  /**
+   * @name Host vDSO time queries for the syscall handlers
+   *
+   * Guests that use the syscall instruction instead of their vDSO (static binaries, Go) get the host's vDSO
+   * through these, without a kernel transition. Without a host vDSO they fall back to the real syscall.
+   * All of them follow syscall conventions and return -errno on failure.
+   *
+   * The vDSO writes its results with plain stores, so unlike the syscall it faults on a bad pointer instead of returning EFAULT.
+   * `Time` only uses the vDSO without `tloc`. `GetTimeOfDay` takes host pointers only, guest pointers go through the syscall.
+   * @{ */
+  namespace HostVDSO {
+    time_t Time(time_t *tloc);
+    int GetTimeOfDay(struct timeval *tv, struct timezone *tz);
+    int ClockGetTime(clockid_t clk_id, struct timespec *tp);
+    int ClockGetRes(clockid_t clk_id, struct timespec *tp);
+  }
+  /**  @} */
 }
@@ -7,15 +7,22 @@
 #include "Common/ArgumentLoader.h"
 #include "Common/Config.h"
 
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <csignal>
+#include <fcntl.h>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <unistd.h>
+#include <mutex>
 #include <optional>
 #include <sstream>
 #include <sys/mman.h>
 #include <sys/syscall.h>
 #include <sys/wait.h>
+#include <thread>
 #include <unistd.h>
 
 #include <tiny-json.h>
@@ -37,11 +44,21 @@ namespace ArgOptions {
 
   ListQueryOption DistroListOption {ListQueryOption::OPTION_ASK};
 
+  enum class AOTOption {
+    OPTION_ASK,
+    OPTION_GENERATE,
+    OPTION_SKIP,
+  };
+
+  AOTOption GenerateAOTOption {AOTOption::OPTION_ASK};
+
   fextl::vector<fextl::string> RemainingArgs;
 
   std::string DistroName{};
   std::string DistroVersion{};
 
+  uint32_t DownloadJobs {8};
+
   void ParseArguments(int argc, char **argv) {
     optparse::OptionParser Parser = optparse::OptionParser()
       .description("Tool for fetching RootFS from FEXServers")
@@ -69,6 +86,21 @@ namespace ArgOptions {
       .action("store_true")
       .help("When presented the distro-list option, automatically select the first distro if there isn't an exact match.");
 
+    Parser.add_option("--aot")
+      .action("store_true")
+      .help("Pre-translate the RootFS core libraries for faster application startup");
+
+    Parser.add_option("--no-aot")
+      .action("store_true")
+      .help("Don't pre-translate the RootFS core libraries");
+
+    Parser.add_option("-j", "--jobs")
+      .action("store")
+      .type("int")
+      .set_default(DownloadJobs)
+      .metavar("n")
+      .help("Number of parallel connections used to download the RootFS");
+
     optparse::Values Options = Parser.parse_args(argc, argv);
 
     if (Options.is_set_by_user("assume_yes")) {
@@ -87,6 +119,14 @@ namespace ArgOptions {
       DistroListOption = ListQueryOption::OPTION_FIRST;
     }
 
+    if (Options.is_set_by_user("aot")) {
+      GenerateAOTOption = AOTOption::OPTION_GENERATE;
+    }
+
+    if (Options.is_set_by_user("no_aot")) {
+      GenerateAOTOption = AOTOption::OPTION_SKIP;
+    }
+
     if (Options.is_set_by_user("distro_name")) {
       DistroName = Options["distro_name"];
     }
@@ -95,6 +135,8 @@ namespace ArgOptions {
       DistroVersion = Options["distro_version"];
     }
 
+    DownloadJobs = std::max(1, static_cast<int>(Options.get("jobs")));
+
     RemainingArgs = Parser.args();
   }
 }
@@ -202,6 +244,68 @@ namespace Exec {
 
     return {};
   }
+
+  // Hands the child's stdout to Consumer as it arrives. The child is killed if Consumer returns false, which fails the call.
+  int32_t ExecAndWaitForResponseStream(const char *path, char* const* args, const std::function<bool(const char *Data, size_t Size)> &Consumer) {
+    int fd[2];
+    // Downloads spawn children from multiple threads, other children inheriting the write side would keep the pipe open
+    if (pipe2(fd, O_CLOEXEC) == -1) {
+      return -1;
+    }
+
+    pid_t pid = fork();
+
+    if (pid == 0) {
+      // Redirect stdout to pipe
+      dup2(fd[1], STDOUT_FILENO);
+
+      // Close stderr
+      close(STDERR_FILENO);
+
+      execvp(path, args);
+      _exit(-1);
+    }
+
+    close(fd[1]); // Close write side
+
+    if (pid == -1) {
+      close(fd[0]);
+      return -1;
+    }
+
+    char Buffer[64 * 1024];
+    bool Consumed = true;
+    ssize_t Size{};
+    while ((Size = read(fd[0], Buffer, sizeof(Buffer))) != 0) {
+      if (Size == -1) {
+        if (errno == EINTR) {
+          continue;
+        }
+        Consumed = false;
+        break;
+      }
+
+      if (!Consumer(Buffer, Size)) {
+        // No point in letting the child finish
+        kill(pid, SIGKILL);
+        Consumed = false;
+        break;
+      }
+    }
+    close(fd[0]);
+
+    int32_t Status{};
+    waitpid(pid, &Status, 0);
+    if (!Consumed) {
+      return -1;
+    }
+
+    if (WIFEXITED(Status)) {
+      return (int8_t)WEXITSTATUS(Status);
+    }
+
+    return -1;
+  }
 }
 
 namespace WorkingAppsTester {
@@ -528,6 +632,243 @@ namespace WebFileFetcher {
     return Exec::ExecAndWaitForResponse(ExecveArgs[0], const_cast<char* const*>(ExecveArgs.data())) == 0;
   }
 
+  // Matches the hashing block size so each finished chunk can be hashed in one go
+  constexpr static uint64_t DOWNLOAD_CHUNK_SIZE = 32 * 1024 * 1024;
+  constexpr static uint32_t DOWNLOAD_CHUNK_ATTEMPTS = 3;
+
+  // Returns the size of the file if the server supports range requests for it
+  std::optional<uint64_t> GetRangedDownloadSize(const fextl::string &URL) {
+    const std::vector<const char*> ExecveArgs = {
+      "curl",
+      "-sfIL",
+      URL.c_str(),
+      nullptr,
+    };
+
+    std::string Headers = Exec::ExecAndWaitForResponseText(ExecveArgs[0], const_cast<char* const*>(ExecveArgs.data()));
+    std::transform(Headers.begin(), Headers.end(), Headers.begin(), [](char c) { return std::tolower(c); });
+
+    std::optional<uint64_t> Size{};
+    bool AcceptsRanges{};
+
+    std::istringstream HeaderStream(Headers);
+    std::string Line;
+    while (std::getline(HeaderStream, Line)) {
+      if (Line.starts_with("http/")) {
+        // Each redirect starts a new set of headers, only the final response matters
+        Size.reset();
+        AcceptsRanges = false;
+      }
+      else if (Line.starts_with("content-length:")) {
+        Size = std::strtoull(Line.c_str() + strlen("content-length:"), nullptr, 10);
+      }
+      else if (Line.starts_with("accept-ranges:") && Line.find("bytes") != Line.npos) {
+        AcceptsRanges = true;
+      }
+    }
+
+    if (!AcceptsRanges) {
+      return std::nullopt;
+    }
+    return Size;
+  }
+
+  bool DownloadRangeToFile(const fextl::string &URL, int fd, uint64_t Offset, uint64_t Size) {
+    const std::string Range = fmt::format("{}-{}", Offset, Offset + Size - 1);
+    const std::vector<const char*> ExecveArgs = {
+      "curl",
+      "-sfL",
+      "-r",
+      Range.c_str(),
+      URL.c_str(),
+      nullptr,
+    };
+
+    uint64_t Written{};
+    auto WriteData = [fd, Offset, Size, &Written](const char *Data, size_t DataSize) -> bool {
+      if (Written + DataSize > Size) {
+        // Server ignored the range and is sending the whole file
+        return false;
+      }
+
+      while (DataSize) {
+        ssize_t Result = pwrite(fd, Data, DataSize, Offset + Written);
+        if (Result <= 0) {
+          return false;
+        }
+        Data += Result;
+        DataSize -= Result;
+        Written += Result;
+      }
+      return true;
+    };
+
+    return Exec::ExecAndWaitForResponseStream(ExecveArgs[0], const_cast<char* const*>(ExecveArgs.data()), WriteData) == 0 &&
+      Written == Size;
+  }
+
+  /**
+   * @brief Downloads URL in to Path over several ranged requests in parallel, hashing the file while it arrives
+   *
+   * Chunks that finished are recorded in a `.parts` file next to the download, so running again after a failure only
+   * fetches what is missing. Servers without range support go through FallbackDownload and get hashed afterwards.
+   *
+   * @param Progress - Called about once a second with the bytes downloaded so far
+   * @param FallbackDownload - Single connection download for servers that don't support ranges
+   *
+   * @return If the download succeeded and the hash of the downloaded file
+   */
+  std::pair<bool, uint64_t> ParallelDownloadToPath(const fextl::string &URL, const fextl::string &Path,
+                                                   const std::function<void(uint64_t Downloaded, uint64_t Total)> &Progress,
+                                                   const std::function<bool(const fextl::string &URL, const fextl::string &Path)> &FallbackDownload) {
+    auto filename = URL.substr(URL.find_last_of('/') + 1);
+    auto PathName = Path + filename;
+    auto PartsName = PathName + ".parts";
+
+    auto Size = GetRangedDownloadSize(URL);
+    if (!Size.has_value() || *Size == 0) {
+      if (!FallbackDownload(URL, Path)) {
+        return {false, 0};
+      }
+      return XXFileHash::HashFile(PathName);
+    }
+
+    const uint64_t NumChunks = (*Size + DOWNLOAD_CHUNK_SIZE - 1) / DOWNLOAD_CHUNK_SIZE;
+
+    // Layout of the parts file: the total size, then one byte per chunk that is set once the chunk is on disk
+    std::vector<uint8_t> ChunkDone(NumChunks);
+    std::error_code ec;
+    bool Resuming = std::filesystem::exists(PathName, ec) && std::filesystem::file_size(PathName, ec) == *Size;
+
+    int PartsFD = open(PartsName.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (PartsFD == -1) {
+      return {false, 0};
+    }
+
+    uint64_t PartsSize{};
+    Resuming = Resuming &&
+      pread(PartsFD, &PartsSize, sizeof(PartsSize), 0) == sizeof(PartsSize) && PartsSize == *Size &&
+      pread(PartsFD, ChunkDone.data(), NumChunks, sizeof(PartsSize)) == static_cast<ssize_t>(NumChunks);
+
+    if (!Resuming) {
+      std::fill(ChunkDone.begin(), ChunkDone.end(), 0);
+      if (ftruncate(PartsFD, 0) == -1 ||
+          pwrite(PartsFD, &*Size, sizeof(*Size), 0) != sizeof(*Size) ||
+          pwrite(PartsFD, ChunkDone.data(), NumChunks, sizeof(*Size)) != static_cast<ssize_t>(NumChunks)) {
+        close(PartsFD);
+        return {false, 0};
+      }
+    }
+
+    int fd = open(PathName.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd == -1) {
+      close(PartsFD);
+      return {false, 0};
+    }
+
+    // Reserve the whole image up front so the chunks don't fragment the file
+    if (!Resuming && (ftruncate(fd, 0) == -1 || posix_fallocate(fd, 0, *Size) != 0)) {
+      if (ftruncate(fd, *Size) == -1) {
+        close(fd);
+        close(PartsFD);
+        return {false, 0};
+      }
+    }
+
+    std::vector<uint64_t> PendingChunks;
+    uint64_t Downloaded{};
+    for (uint64_t i = 0; i < NumChunks; ++i) {
+      if (ChunkDone[i]) {
+        Downloaded += std::min(DOWNLOAD_CHUNK_SIZE, *Size - i * DOWNLOAD_CHUNK_SIZE);
+      }
+      else {
+        PendingChunks.emplace_back(i);
+      }
+    }
+
+    std::mutex ChunkMutex;
+    std::condition_variable ChunkCV;
+    size_t NextPending{};
+    bool Failed{};
+
+    auto Worker = [&]() {
+      while (true) {
+        uint64_t Chunk{};
+        {
+          std::unique_lock lk(ChunkMutex);
+          if (Failed || NextPending == PendingChunks.size()) {
+            return;
+          }
+          Chunk = PendingChunks[NextPending++];
+        }
+
+        const uint64_t Offset = Chunk * DOWNLOAD_CHUNK_SIZE;
+        const uint64_t ChunkSize = std::min(DOWNLOAD_CHUNK_SIZE, *Size - Offset);
+
+        bool Success{};
+        for (uint32_t Attempt = 0; Attempt < DOWNLOAD_CHUNK_ATTEMPTS && !Success; ++Attempt) {
+          Success = DownloadRangeToFile(URL, fd, Offset, ChunkSize);
+        }
+
+        std::unique_lock lk(ChunkMutex);
+        if (Success) {
+          ChunkDone[Chunk] = 1;
+          Downloaded += ChunkSize;
+          // Losing this write only means the chunk gets downloaded again
+          pwrite(PartsFD, &ChunkDone[Chunk], 1, sizeof(*Size) + Chunk);
+        }
+        else {
+          Failed = true;
+        }
+        ChunkCV.notify_all();
+      }
+    };
+
+    std::vector<std::thread> Workers;
+    const size_t NumWorkers = std::min<size_t>(ArgOptions::DownloadJobs, PendingChunks.size());
+    for (size_t i = 0; i < NumWorkers; ++i) {
+      Workers.emplace_back(Worker);
+    }
+
+    auto WaitForData = [&](uint64_t Offset) -> uint64_t {
+      const uint64_t Chunk = Offset / DOWNLOAD_CHUNK_SIZE;
+      std::unique_lock lk(ChunkMutex);
+      while (!ChunkDone[Chunk] && !Failed) {
+        if (ChunkCV.wait_for(lk, std::chrono::seconds(1)) == std::cv_status::timeout) {
+          Progress(Downloaded, *Size);
+        }
+      }
+
+      if (Failed) {
+        return 0;
+      }
+
+      return std::min((Chunk + 1) * DOWNLOAD_CHUNK_SIZE, *Size) - Offset;
+    };
+
+    auto Result = XXFileHash::HashFileAsWritten(fd, *Size, WaitForData);
+
+    {
+      // Hashing can fail on its own, stop handing out chunks in that case
+      std::unique_lock lk(ChunkMutex);
+      Failed |= !Result.first;
+    }
+
+    for (auto &Thread : Workers) {
+      Thread.join();
+    }
+
+    close(fd);
+    close(PartsFD);
+
+    if (!Failed) {
+      Progress(*Size, *Size);
+      unlink(PartsName.c_str());
+    }
+
+    return Result;
+  }
+
   struct JsonAllocator {
     jsonPool_t PoolObject;
     std::unique_ptr<std::list<json_t>> json_objects;
@@ -796,7 +1137,7 @@ namespace Zenity {
     return true;
   }
 
-  bool ValidateDownloadSelection(const WebFileFetcher::FileTargets &Target) {
+  std::optional<uint64_t> ValidateDownloadSelection(const WebFileFetcher::FileTargets &Target) {
     fextl::string Text = fextl::fmt::format("Selected Rootfs: {}\n", Target.DistroName);
     Text += fmt::format("\tURL: {}\n", Target.URL);
     Text += fmt::format("Are you sure that you want to download this image");
@@ -810,17 +1151,36 @@ namespace Zenity {
           // Well I guess we failed
           Text = fmt::format("Couldn't create {} path for storing RootFS", RootFS);
           ExecWithInfo(Text);
-          return false;
+          return std::nullopt;
         }
       }
 
-      if (!WebFileFetcher::DownloadToPathWithZenityProgress(Target.URL, RootFS)) {
-        return false;
+      // Only opened once the ranged download starts, the fallback download brings its own progress dialog
+      FILE *ZenityProgress{};
+      auto Progress = [&ZenityProgress](uint64_t Downloaded, uint64_t Total) {
+        if (!ZenityProgress) {
+          ZenityProgress = popen("zenity --time-remaining --progress --no-cancel --auto-close --title 'Downloading'", "w");
+        }
+
+        if (ZenityProgress) {
+          fmt::print(ZenityProgress, "{}\n", Downloaded * 100 / Total);
+          fflush(ZenityProgress);
+        }
+      };
+
+      auto Res = WebFileFetcher::ParallelDownloadToPath(Target.URL, RootFS, Progress, WebFileFetcher::DownloadToPathWithZenityProgress);
+
+      if (ZenityProgress) {
+        pclose(ZenityProgress);
       }
 
-      return true;
+      if (!Res.first) {
+        return std::nullopt;
+      }
+
+      return Res.second;
     }
-    return false;
+    return std::nullopt;
   }
 }
 
@@ -968,7 +1328,7 @@ namespace TTY {
     return true;
   }
 
-  bool ValidateDownloadSelection(const WebFileFetcher::FileTargets &Target) {
+  std::optional<uint64_t> ValidateDownloadSelection(const WebFileFetcher::FileTargets &Target) {
     fmt::print("Selected Rootfs: {}\n", Target.DistroName);
     fmt::print("\tURL: {}\n", Target.URL);
 
@@ -980,31 +1340,45 @@ namespace TTY {
         if (!std::filesystem::create_directories(RootFS, ec)) {
           // Well I guess we failed
           fmt::print("Couldn't create {} path for storing RootFS\n", RootFS);
-          return false;
+          return std::nullopt;
         }
       }
-      auto DoDownload = [&Target, &RootFS]() -> bool {
-        if (!WebFileFetcher::DownloadToPath(Target.URL, RootFS)) {
+
+      auto Now = std::chrono::steady_clock::now();
+      uint64_t LastDownloaded{};
+      auto Progress = [&Now, &LastDownloaded](uint64_t Downloaded, uint64_t Total) {
+        auto Cur = std::chrono::steady_clock::now();
+        double Seconds = std::chrono::duration<double>(Cur - Now).count();
+        fmt::print("{:.2f}% downloaded ({:.1f} MiB/s)\n", (double)Downloaded / Total * 100.0,
+          (double)(Downloaded - LastDownloaded) / (1024.0 * 1024.0) / Seconds);
+        Now = Cur;
+        LastDownloaded = Downloaded;
+      };
+
+      auto DoDownload = [&Target, &RootFS, &Progress]() -> std::pair<bool, uint64_t> {
+        // Failed downloads pick up from the chunks that already finished
+        auto Res = WebFileFetcher::ParallelDownloadToPath(Target.URL, RootFS, Progress, WebFileFetcher::DownloadToPath);
+        if (!Res.first) {
           fmt::print("Couldn't download RootFS\n");
-          return false;
         }
 
-        return true;
+        return Res;
       };
 
-      while (DoDownload() == false) {
+      std::pair<bool, uint64_t> Res{};
+      while ((Res = DoDownload()).first == false) {
         if (AskForConfirmation("Curl RootFS download failed. Do you want to retry?")) {
           // Loop to retry
         }
         else {
-          return false;
+          return std::nullopt;
         }
       }
 
       // Got here then we passed
-      return true;
+      return Res.second;
     }
-    return false;
+    return std::nullopt;
   }
 }
 
@@ -1016,7 +1390,8 @@ namespace {
   std::function<int32_t(const fextl::string &Text, const std::vector<fextl::string> &List)> _AskForConfirmationList;
   std::function<int32_t(DistroQuery::DistroInfo &Info, std::vector<WebFileFetcher::FileTargets> &Targets)> _AskForDistroSelection;
   std::function<bool(const WebFileFetcher::FileTargets &Target)> _ValidateCheckExists;
-  std::function<bool(const WebFileFetcher::FileTargets &Target)> _ValidateDownloadSelection;
+  // Returns the hash of the downloaded RootFS
+  std::function<std::optional<uint64_t>(const WebFileFetcher::FileTargets &Target)> _ValidateDownloadSelection;
 
   void CheckTTY() {
     IsTTY = isatty(STDOUT_FILENO);
@@ -1068,7 +1443,7 @@ namespace {
     return _ValidateCheckExists(Target);
   }
 
-  bool ValidateDownloadSelection(const WebFileFetcher::FileTargets &Target) {
+  std::optional<uint64_t> ValidateDownloadSelection(const WebFileFetcher::FileTargets &Target) {
     return _ValidateDownloadSelection(Target);
   }
 }
@@ -1081,6 +1456,14 @@ namespace ConfigSetter {
     LoadedConfig->EraseSet(FEXCore::Config::ConfigOption::CONFIG_ROOTFS, RootFS);
     FEX::Config::SaveLayerToJSON(Filename, LoadedConfig.get());
   }
+
+  void EnableAOTIRLoad() {
+    fextl::string Filename = FEXCore::Config::GetConfigFileLocation();
+    auto LoadedConfig = FEX::Config::CreateMainLayer(&Filename);
+    LoadedConfig->Load();
+    LoadedConfig->EraseSet(FEXCore::Config::ConfigOption::CONFIG_AOTIRLOAD, "1");
+    FEX::Config::SaveLayerToJSON(Filename, LoadedConfig.get());
+  }
 }
 
 namespace UnSquash {
@@ -1115,6 +1498,72 @@ namespace UnSquash {
   }
 }
 
+namespace AOTGen {
+  // Every guest process runs through these before reaching main
+  constexpr std::array CoreLibraries = {
+    "ld-linux-x86-64.so.2",
+    "ld-linux.so.2",
+    "libc.so.6",
+    "libm.so.6",
+    "libpthread.so.0",
+    "libstdc++.so.6",
+  };
+
+  // Library folders of the distros that FEX provides images for, a library that doesn't exist in one is skipped
+  constexpr std::array LibraryFolders = {
+    "/lib/x86_64-linux-gnu/",
+    "/lib/i386-linux-gnu/",
+    "/usr/lib64/",
+    "/usr/lib32/",
+    "/usr/lib/",
+  };
+
+  /**
+   * @brief Generates AOT IR caches for the core libraries of a RootFS
+   *
+   * Runs FEXInterpreter with AOTIRGenerate on each library, which loads it from the RootFS without executing it.
+   * The caches are stored in a folder next to the RootFS that FEXLoader checks after the user's own AOT IR caches.
+   *
+   * @param RootFS - Path to the RootFS image or folder
+   *
+   * @return Number of libraries that had a cache generated
+   */
+  uint32_t GenerateRootFSAOTIR(const fextl::string &RootFS) {
+    const auto AOTDir = RootFS + ".aotir";
+    std::error_code ec;
+    std::filesystem::create_directories(AOTDir, ec);
+    if (ec) {
+      return 0;
+    }
+
+    const auto RootFSEnv = "FEX_ROOTFS=" + RootFS;
+    const auto AOTDirEnv = "FEX_AOTIRDIRECTORY=" + AOTDir;
+
+    uint32_t Generated{};
+    for (auto Folder : LibraryFolders) {
+      for (auto Library : CoreLibraries) {
+        const fextl::string LibraryPath = fextl::fmt::format("{}{}", Folder, Library);
+        const std::vector<const char*> ExecveArgs = {
+          "env",
+          RootFSEnv.c_str(),
+          AOTDirEnv.c_str(),
+          "FEX_AOTIRGENERATE=1",
+          "FEX_SILENTLOG=1",
+          "FEXInterpreter",
+          LibraryPath.c_str(),
+          nullptr,
+        };
+
+        if (Exec::ExecAndWaitForResponseRedirect(ExecveArgs[0], const_cast<char* const*>(ExecveArgs.data()), -1, -1) == 0) {
+          ++Generated;
+        }
+      }
+    }
+
+    return Generated;
+  }
+}
+
 int main(int argc, char **argv, char **const envp) {
   CheckTTY();
   FEX::Config::LoadConfig(
@@ -1193,15 +1642,14 @@ int main(int argc, char **argv, char **const envp) {
       else {
         auto ValidateDownload = [&Target, &PathName]() -> std::pair<int32_t, bool> {
           std::error_code ec;
-          if (ValidateDownloadSelection(Target)) {
+          if (auto DownloadedHash = ValidateDownloadSelection(Target)) {
             uint64_t ExpectedHash = std::stoul(Target.Hash, nullptr, 16);
 
             if (std::filesystem::exists(PathName, ec)) {
-              auto Res = XXFileHash::HashFile(PathName);
-              if (Res.first == false ||
-                  Res.second != ExpectedHash) {
+              // Hashed while downloading, no need for another pass over the image
+              if (*DownloadedHash != ExpectedHash) {
                 fextl::string Text = fextl::fmt::format("Couldn't hash the rootfs or hash didn't match\n");
-                Text += fmt::format("Hash {:x} != Expected Hash {:x}\n", Res.second, ExpectedHash);
+                Text += fmt::format("Hash {:x} != Expected Hash {:x}\n", *DownloadedHash, ExpectedHash);
                 ExecWithInfo(Text);
                 return std::make_pair(-1, true);
               }
@@ -1302,6 +1750,25 @@ int main(int argc, char **argv, char **const envp) {
         fextl::string Text = fextl::fmt::format("{} set as default RootFS\n", filename);
         ExecWithInfo(Text);
       }
+
+      bool GenerateAOT = ArgOptions::GenerateAOTOption == ArgOptions::AOTOption::OPTION_GENERATE;
+      if (ArgOptions::GenerateAOTOption == ArgOptions::AOTOption::OPTION_ASK) {
+        GenerateAOT = AskForConfirmation("Do you wish to pre-translate the RootFS core libraries for faster application startup?\n"
+                                         "This enables loading AOT IR caches.");
+      }
+
+      if (GenerateAOT) {
+        fmt::print("Pre-translating RootFS core libraries...\n");
+        const auto Generated = AOTGen::GenerateRootFSAOTIR(RootFS + filename);
+        if (Generated) {
+          ConfigSetter::EnableAOTIRLoad();
+          fextl::string Text = fextl::fmt::format("Pre-translated {} libraries\n", Generated);
+          ExecWithInfo(Text);
+        }
+        else {
+          ExecWithInfo("Couldn't pre-translate any RootFS libraries");
+        }
+      }
     }
   }
 
@@ -1,5 +1,6 @@
 #include "XXFileHash.h"
 
+#include <algorithm>
 #include <chrono>
 #include <fcntl.h>
 #include <fmt/format.h>
@@ -70,4 +71,50 @@ namespace XXFileHash {
     close(fd);
     return {true, Hash};
   }
+
+  std::pair<bool, uint64_t> HashFileAsWritten(int fd, uint64_t Size, const std::function<uint64_t(uint64_t Offset)> &WaitForData) {
+    XXH3_state_t* const State = XXH3_createState();
+    XXH64_hash_t const Seed = 0;
+
+    if (!State) {
+      return {false, 0};
+    }
+
+    auto HadError = [State]() -> std::pair<bool, uint64_t> {
+      XXH3_freeState(State);
+      return {false, 0};
+    };
+
+    if (XXH3_64bits_reset_withSeed(State, Seed) == XXH_ERROR) {
+      return HadError();
+    }
+
+    std::vector<char> Data(BLOCK_SIZE);
+    uint64_t CurrentOffset = 0;
+
+    while (CurrentOffset < Size) {
+      uint64_t Available = WaitForData(CurrentOffset);
+      if (Available == 0) {
+        return HadError();
+      }
+
+      // Was just written, so this should come straight out of the page cache
+      const uint64_t End = CurrentOffset + Available;
+      while (CurrentOffset < End) {
+        ssize_t Result = pread(fd, Data.data(), std::min<uint64_t>(BLOCK_SIZE, End - CurrentOffset), CurrentOffset);
+        if (Result <= 0) {
+          return HadError();
+        }
+
+        if (XXH3_64bits_update(State, Data.data(), Result) == XXH_ERROR) {
+          return HadError();
+        }
+        CurrentOffset += Result;
+      }
+    }
+
+    XXH64_hash_t const Hash = XXH3_64bits_digest(State);
+    XXH3_freeState(State);
+    return {true, Hash};
+  }
 }
@@ -1,7 +1,19 @@
 #pragma once
 #include <FEXCore/fextl/string.h>
 
+#include <cstdint>
+#include <functional>
+#include <utility>
+
 namespace XXFileHash {
   std::pair<bool, uint64_t> HashFile(const fextl::string &Filepath);
-}
 
+  /**
+   * @brief Hashes a file that is still being written, in order, as soon as each part of it lands
+   *
+   * @param fd - File to hash, read with pread so the file offset is left alone
+   * @param Size - Final size of the file
+   * @param WaitForData - Blocks until the data at Offset is written. Returns how many bytes from Offset can be read, or 0 if writing failed
+   */
+  std::pair<bool, uint64_t> HashFileAsWritten(int fd, uint64_t Size, const std::function<uint64_t(uint64_t Offset)> &WaitForData);
+}
@@ -1,9 +1,14 @@
 #include "Common/FEXServerClient.h"
+#include "Logger.h"
 
+#include <algorithm>
 #include <atomic>
+#include <cstring>
 #include <mutex>
 #include <poll.h>
+#include <sys/mman.h>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 namespace Logging {
@@ -18,6 +23,66 @@ namespace Logger {
   std::atomic<bool> ShouldShutdown {false};
   std::atomic<int32_t> LoggerThreadTID{};
 
+  // Log rings keyed by their wakeup pipe, only touched by the log thread
+  std::unordered_map<int, FEXServerClient::Logging::RingHeader*> Rings{};
+  std::vector<std::pair<int, FEXServerClient::Logging::RingHeader*>> IncomingRings{};
+
+  void HandlePackets(int Socket, const uint8_t *Data, size_t Size) {
+    size_t CurrentOffset{};
+    while (CurrentOffset < Size) {
+      const size_t PacketSize = FEXServerClient::Logging::GetPacketSize(&Data[CurrentOffset], Size - CurrentOffset);
+      if (PacketSize == 0) {
+        // Truncated or corrupt, drop the rest of the data
+        break;
+      }
+
+      const FEXServerClient::Logging::PacketHeader *Header = reinterpret_cast<const FEXServerClient::Logging::PacketHeader*>(&Data[CurrentOffset]);
+      if (Header->PacketType == FEXServerClient::Logging::PacketTypes::TYPE_MSG) {
+        const FEXServerClient::Logging::PacketMsg *Msg = reinterpret_cast<const FEXServerClient::Logging::PacketMsg*>(&Data[CurrentOffset]);
+        const char *MsgText = reinterpret_cast<const char*>(&Data[CurrentOffset + sizeof(FEXServerClient::Logging::PacketMsg)]);
+        Logging::ClientMsgHandler(Socket, Msg->Header.Timestamp, Msg->Header.PID, Msg->Header.TID, Msg->Level, MsgText);
+      }
+      // TYPE_WAKE has nothing to handle, rings get drained after every poll anyway
+
+      CurrentOffset += PacketSize;
+    }
+  }
+
+  void DrainRing(int Socket, FEXServerClient::Logging::RingHeader *Ring) {
+    using namespace FEXServerClient::Logging;
+    std::vector<uint8_t> Data;
+    uint64_t Tail = Ring->Tail.load(std::memory_order_relaxed);
+
+    // Keep going until the ring is seen empty after publishing Tail, see WriteToRing for the other side
+    while (true) {
+      const uint64_t Head = Ring->Head.load();
+      const uint64_t Size = Head - Tail;
+      if (Size == 0) {
+        break;
+      }
+
+      if (Size <= RING_DATA_SIZE) {
+        // Copy out in one batch, the writer can reuse the space once Tail moves
+        const size_t Begin = Tail & (RING_DATA_SIZE - 1);
+        const size_t FirstPart = std::min<size_t>(Size, RING_DATA_SIZE - Begin);
+        Data.resize(Size);
+        memcpy(Data.data(), GetRingData(Ring) + Begin, FirstPart);
+        memcpy(Data.data() + FirstPart, GetRingData(Ring), Size - FirstPart);
+        HandlePackets(Socket, Data.data(), Data.size());
+      }
+      // Otherwise the process scribbled over the header, skip what it claims to have written
+
+      Tail = Head;
+      Ring->Tail.store(Tail);
+    }
+  }
+
+  void DrainAllRings() {
+    for (auto &[Socket, Ring] : Rings) {
+      DrainRing(Socket, Ring);
+    }
+  }
+
   void HandleLogData(int Socket) {
     std::vector<uint8_t> Data(1500);
     size_t CurrentRead{};
@@ -44,20 +109,7 @@ namespace Logger {
       }
     }
 
-    size_t CurrentOffset{};
-    while (CurrentOffset < CurrentRead) {
-      FEXServerClient::Logging::PacketHeader *Header = reinterpret_cast<FEXServerClient::Logging::PacketHeader*>(&Data[CurrentOffset]);
-      if (Header->PacketType == FEXServerClient::Logging::PacketTypes::TYPE_MSG) {
-        FEXServerClient::Logging::PacketMsg *Msg = reinterpret_cast<FEXServerClient::Logging::PacketMsg*>(&Data[CurrentOffset]);
-        const char *MsgText = reinterpret_cast<const char*>(&Data[CurrentOffset + sizeof(FEXServerClient::Logging::PacketMsg)]);
-        Logging::ClientMsgHandler(Socket, Msg->Header.Timestamp, Msg->Header.PID, Msg->Header.TID, Msg->Level, MsgText);
-
-        CurrentOffset += sizeof(FEXServerClient::Logging::PacketMsg) + Msg->MessageLength;
-      }
-      else {
-        CurrentOffset = CurrentRead;
-      }
-    }
+    HandlePackets(Socket, Data.data(), CurrentRead);
   }
 
   void LogThreadFunc() {
@@ -71,6 +123,8 @@ namespace Logger {
         std::unique_lock lk {IncomingPollFDsLock};
         PollFDs.insert(PollFDs.end(), std::make_move_iterator(IncomingPollFDs.begin()), std::make_move_iterator(IncomingPollFDs.end()));
         IncomingPollFDs.clear();
+        Rings.insert(IncomingRings.begin(), IncomingRings.end());
+        IncomingRings.clear();
       }
       if (PollFDs.size() == 0) {
         pselect(0, nullptr, nullptr, nullptr, &ts, nullptr);
@@ -89,6 +143,13 @@ namespace Logger {
               else if (it->revents & (POLLHUP | POLLERR | POLLNVAL | POLLRDHUP)) {
                 // Error or hangup, close the socket and erase it from our list
                 Erase = true;
+
+                if (auto Ring = Rings.find(it->fd); Ring != Rings.end()) {
+                  // The process is gone, pick up whatever it left behind
+                  DrainRing(Ring->first, Ring->second);
+                  munmap(Ring->second, FEXServerClient::Logging::RING_TOTAL_SIZE);
+                  Rings.erase(Ring);
+                }
                 close(it->fd);
               }
 
@@ -109,6 +170,8 @@ namespace Logger {
             }
           }
         }
+
+        DrainAllRings();
       }
     }
   }
@@ -131,6 +194,15 @@ namespace Logger {
     FHU::Syscalls::tgkill(::getpid(), LoggerThreadTID, SIGUSR1);
   }
 
+  void AppendLogRing(int FD, FEXServerClient::Logging::RingHeader *Ring) {
+    {
+      std::unique_lock lk {IncomingPollFDsLock};
+      IncomingRings.emplace_back(FD, Ring);
+    }
+
+    AppendLogFD(FD);
+  }
+
   bool LogThreadRunning() {
     return LogThread.joinable();
   }
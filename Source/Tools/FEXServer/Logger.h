@@ -1,7 +1,13 @@
 #pragma once
 
+namespace FEXServerClient::Logging {
+  struct RingHeader;
+}
+
 namespace Logger {
   void AppendLogFD(int FD);
+  // FD is the wakeup pipe of the ring, the ring is unmapped once that hangs up
+  void AppendLogRing(int FD, FEXServerClient::Logging::RingHeader *Ring);
   void StartLogThread();
   bool LogThreadRunning();
   void Shutdown();
@@ -5,13 +5,20 @@
 #include "Common/FEXServerClient.h"
 
 #include <atomic>
+#include <cstring>
+#include <dirent.h>
 #include <fcntl.h>
 #include <filesystem>
-#include <poll.h>
+#include <limits.h>
 #include <string>
+#include <sys/epoll.h>
+#include <sys/mman.h>
 #include <sys/resource.h>
 #include <sys/socket.h>
 #include <sys/un.h>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 namespace ProcessPipe {
@@ -21,7 +28,15 @@ namespace ProcessPipe {
   std::atomic<bool> ShouldShutdown {false};
   time_t RequestTimeout {10};
   bool Foreground {false};
-  std::vector<struct pollfd> PollFDs{};
+  int EpollFD{-1};
+  size_t NumClients{};
+  // RootFS file copies still running on worker threads
+  std::atomic<size_t> NumCacheCopies{};
+
+  // Every request is a single SOCK_SEQPACKET message so there is never a partial request to keep per client.
+  // The loop is single threaded, one buffer covers all of them.
+  constexpr size_t MAX_REQUEST_SIZE = sizeof(FEXServerClient::FEXServerRequestPacket) + PATH_MAX;
+  alignas(FEXServerClient::FEXServerRequestPacket) uint8_t RequestData[MAX_REQUEST_SIZE];
 
   // FD count watching
   constexpr size_t static MAX_FD_DISTANCE = 32;
@@ -182,7 +197,8 @@ namespace ProcessPipe {
     auto ServerSocketName = FEXServerClient::GetServerSocketName();
 
     // Create the initial unix socket
-    ServerSocketFD = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    // SEQPACKET keeps request boundaries so clients can pipeline requests without framing
+    ServerSocketFD = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
     if (ServerSocketFD == -1) {
       LogMan::Msg::EFmt("Couldn't create AF_UNIX socket: {} {}\n", errno, strerror(errno));
       return false;
@@ -205,20 +221,35 @@ namespace ProcessPipe {
       return false;
     }
 
-    listen(ServerSocketFD, 16);
-    PollFDs.emplace_back(pollfd {
-      .fd = ServerSocketFD,
-      .events = POLLIN,
-      .revents = 0,
-    });
+    // Builds can start hundreds of FEX processes at once, don't make them retry connecting
+    listen(ServerSocketFD, SOMAXCONN);
+
+    EpollFD = epoll_create1(EPOLL_CLOEXEC);
+    if (EpollFD == -1) {
+      LogMan::Msg::EFmt("Couldn't create epoll FD: {} {}\n", errno, strerror(errno));
+      close(ServerSocketFD);
+      ServerSocketFD = -1;
+      return false;
+    }
+
+    struct epoll_event Event {
+      .events = EPOLLIN,
+      .data {
+        .fd = ServerSocketFD,
+      },
+    };
+    epoll_ctl(EpollFD, EPOLL_CTL_ADD, ServerSocketFD, &Event);
+
+    // Get the current number of FDs of the process, this is tracked as clients come and go from here on.
+    GetMaxFDs();
 
     return true;
   }
 
-  void SendEmptyErrorPacket(int Socket) {
+  void SendEmptyResultPacket(int Socket, FEXServerClient::PacketType Type) {
     FEXServerClient::FEXServerResultPacket Res {
       .Header {
-        .Type = FEXServerClient::PacketType::TYPE_ERROR,
+        .Type = Type,
       },
     };
 
@@ -237,7 +268,90 @@ namespace ProcessPipe {
     sendmsg(Socket, &msg, 0);
   }
 
-  void SendFDSuccessPacket(int Socket, int FD) {
+  void SendEmptyErrorPacket(int Socket) {
+    SendEmptyResultPacket(Socket, FEXServerClient::PacketType::TYPE_ERROR);
+  }
+
+  int RootFSEntriesFD {-1};
+
+  /**
+   * @brief Top level entries of the mounted RootFS, NUL terminated in a sealed memfd
+   *
+   * The squashfs image can't change while it is mounted, so this gets built once.
+   * Every FEXInterpreter instance can then skip listing the RootFS through FUSE on startup.
+   */
+  int GetRootFSEntriesFD() {
+    if (RootFSEntriesFD != -1) {
+      return RootFSEntriesFD;
+    }
+
+    auto MountFolder = SquashFS::GetMountFolder();
+    if (MountFolder.empty()) {
+      return -1;
+    }
+
+    DIR *Dir = opendir(MountFolder.c_str());
+    if (!Dir) {
+      return -1;
+    }
+
+    std::string Entries;
+    while (auto Entry = readdir(Dir)) {
+      if (strcmp(Entry->d_name, ".") != 0 && strcmp(Entry->d_name, "..") != 0) {
+        Entries.append(Entry->d_name);
+        Entries.push_back('\0');
+      }
+    }
+    closedir(Dir);
+
+    int FD = memfd_create("FEXRootFSEntries", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (FD == -1) {
+      return -1;
+    }
+
+    if (write(FD, Entries.data(), Entries.size()) != static_cast<ssize_t>(Entries.size()) ||
+        fcntl(FD, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) != 0) {
+      close(FD);
+      return -1;
+    }
+
+    RootFSEntriesFD = FD;
+    return RootFSEntriesFD;
+  }
+
+  // Object cache files shared between every client, keyed by the object file name
+  constexpr size_t MAX_CODE_OBJECT_FILES = 4096;
+  std::unordered_map<std::string, int> CodeObjectFDs{};
+
+  int GetCodeObjectFD(std::string_view Name) {
+    auto it = CodeObjectFDs.find(std::string(Name));
+    if (it != CodeObjectFDs.end()) {
+      return it->second;
+    }
+
+    if (Name.empty() || Name.find('/') != Name.npos || CodeObjectFDs.size() >= MAX_CODE_OBJECT_FILES) {
+      return -1;
+    }
+
+    int FD = memfd_create("FEXCodeObjects", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (FD == -1) {
+      return -1;
+    }
+
+    // Clients map the file while others append to it, it must never shrink under them
+    if (fcntl(FD, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_SEAL) != 0) {
+      close(FD);
+      return -1;
+    }
+
+    ++NumFilesOpened;
+    CheckRaiseFDLimit();
+
+    CodeObjectFDs.emplace(Name, FD);
+    return FD;
+  }
+
+  void SendFDsSuccessPacket(int Socket, const int *FDs, size_t NumFDs) {
     FEXServerClient::FEXServerResultPacket Res {
       .Header {
         .Type = FEXServerClient::PacketType::TYPE_SUCCESS,
@@ -257,8 +371,9 @@ namespace ProcessPipe {
     };
 
     // Setup the ancillary buffer. This is where we will be getting pipe FDs
-    // We only need 4 bytes for the FD
-    constexpr size_t CMSG_SIZE = CMSG_SPACE(sizeof(int));
+    // We only need 4 bytes per FD
+    constexpr size_t MAX_FDS = 2;
+    constexpr size_t CMSG_SIZE = CMSG_SPACE(sizeof(int) * MAX_FDS);
     union AncillaryBuffer {
       struct cmsghdr Header;
       uint8_t Buffer[CMSG_SIZE];
@@ -267,62 +382,25 @@ namespace ProcessPipe {
 
     // Now link to our ancilllary buffer
     msg.msg_control = AncBuf.Buffer;
-    msg.msg_controllen = CMSG_SIZE;
+    msg.msg_controllen = CMSG_SPACE(sizeof(int) * NumFDs);
 
-    // Now we need to setup the ancillary buffer data. We are only sending an FD
+    // Now we need to setup the ancillary buffer data. We are only sending FDs
     struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
-    cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int) * NumFDs);
     cmsg->cmsg_level = SOL_SOCKET;
     cmsg->cmsg_type = SCM_RIGHTS;
 
     // We are giving the daemon the write side of the pipe
-    memcpy(CMSG_DATA(cmsg), &FD, sizeof(int));
+    memcpy(CMSG_DATA(cmsg), FDs, sizeof(int) * NumFDs);
 
     sendmsg(Socket, &msg, 0);
   }
 
-  void HandleSocketData(int Socket) {
-    std::vector<uint8_t> Data(1500);
-    size_t CurrentRead{};
-
-    // Get the current number of FDs of the process before we start handling sockets.
-    GetMaxFDs();
-
-    while (true) {
-      struct iovec iov {
-        .iov_base = &Data.at(CurrentRead),
-        .iov_len = Data.size() - CurrentRead,
-      };
-
-      struct msghdr msg {
-        .msg_name = nullptr,
-        .msg_namelen = 0,
-        .msg_iov = &iov,
-        .msg_iovlen = 1,
-      };
-
-      ssize_t Read = recvmsg(Socket, &msg, 0);
-      if (Read <= msg.msg_iov->iov_len) {
-        CurrentRead += Read;
-        if (CurrentRead == Data.size()) {
-          Data.resize(Data.size() << 1);
-        }
-        else {
-          // No more to read
-          break;
-        }
-      }
-      else {
-        if (errno == EWOULDBLOCK) {
-          // no error
-        }
-        else {
-          perror("read");
-        }
-        break;
-      }
-    }
+  void SendFDSuccessPacket(int Socket, int FD) {
+    SendFDsSuccessPacket(Socket, &FD, 1);
+  }
 
+  void HandleRequest(int Socket, uint8_t *Data, size_t CurrentRead) {
     size_t CurrentOffset{};
     while (CurrentOffset < CurrentRead) {
       FEXServerClient::FEXServerRequestPacket *Req = reinterpret_cast<FEXServerClient::FEXServerRequestPacket *>(&Data[CurrentOffset]);
@@ -356,6 +434,44 @@ namespace ProcessPipe {
           CurrentOffset += sizeof(FEXServerClient::FEXServerRequestPacket::Header);
           break;
         }
+        case FEXServerClient::PacketType::TYPE_GET_LOG_RING_FDS: {
+          using namespace FEXServerClient::Logging;
+          int RingFD = Logger::LogThreadRunning() ? memfd_create("FEXLogRing", MFD_CLOEXEC) : -1;
+          void *Ring = MAP_FAILED;
+          if (RingFD != -1 && ftruncate(RingFD, RING_TOTAL_SIZE) == 0) {
+            Ring = mmap(nullptr, RING_TOTAL_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, RingFD, 0);
+          }
+
+          if (Ring != MAP_FAILED) {
+            int fds[2]{};
+            pipe2(fds, 0);
+            // 0 = Read
+            // 1 = Write
+            Logger::AppendLogRing(fds[0], reinterpret_cast<RingHeader*>(Ring));
+
+            const int SendFDs[2] = {fds[1], RingFD};
+            SendFDsSuccessPacket(Socket, SendFDs, 2);
+
+            // Close the write side now, doesn't matter to us
+            close(fds[1]);
+
+            // Check if we need to increase the FD limit.
+            ++NumFilesOpened;
+            CheckRaiseFDLimit();
+          }
+          else {
+            // Log thread isn't running or the ring couldn't be created. FEXInterpreter falls back to TYPE_GET_LOG_FD.
+            SendEmptyErrorPacket(Socket);
+          }
+
+          if (RingFD != -1) {
+            // The mapping keeps the ring alive
+            close(RingFD);
+          }
+
+          CurrentOffset += sizeof(FEXServerClient::FEXServerRequestPacket::Header);
+          break;
+        }
         case FEXServerClient::PacketType::TYPE_GET_ROOTFS_PATH: {
           fextl::string MountFolder = SquashFS::GetMountFolder();
 
@@ -427,6 +543,102 @@ namespace ProcessPipe {
           CurrentOffset += sizeof(FEXServerClient::FEXServerRequestPacket::Header);
           break;
         }
+        case FEXServerClient::PacketType::TYPE_GET_ROOTFS_ENTRIES_FD: {
+          int FD = GetRootFSEntriesFD();
+          if (FD != -1) {
+            // Kept open, every client gets the same sealed memfd
+            SendFDSuccessPacket(Socket, FD);
+          }
+          else {
+            SendEmptyErrorPacket(Socket);
+          }
+
+          CurrentOffset += sizeof(FEXServerClient::FEXServerRequestPacket::Header);
+          break;
+        }
+        case FEXServerClient::PacketType::TYPE_GET_ROOTFS_CACHE_FD: {
+          int FD = SquashFS::GetFileCacheFD();
+          if (FD != -1) {
+            SendFDSuccessPacket(Socket, FD);
+          }
+          else {
+            SendEmptyErrorPacket(Socket);
+          }
+
+          CurrentOffset += sizeof(FEXServerClient::FEXServerRequestPacket::Header);
+          break;
+        }
+        case FEXServerClient::PacketType::TYPE_CACHE_ROOTFS_FILE: {
+          const size_t Remaining = CurrentRead - CurrentOffset;
+          if (Remaining < sizeof(Req->CacheFile) ||
+              Req->CacheFile.Length == 0 ||
+              Req->CacheFile.Length > Remaining - sizeof(Req->CacheFile)) {
+            // Truncated packet, drop the rest of the data
+            SendEmptyErrorPacket(Socket);
+            CurrentOffset = CurrentRead;
+            break;
+          }
+
+          // Copying a file out of the image can take seconds, don't hold up every other client on it.
+          // The worker answers through its own reference to the socket in case the client goes away in the meantime.
+          // The client waits for this answer before sending anything else, so results stay in order.
+          int ReplySocket = fcntl(Socket, F_DUPFD_CLOEXEC, 0);
+          if (ReplySocket == -1) {
+            SendEmptyErrorPacket(Socket);
+          }
+          else {
+            ++NumCacheCopies;
+            std::thread([ReplySocket, Path = std::string(Req->CacheFile.Path, strnlen(Req->CacheFile.Path, Req->CacheFile.Length))] {
+              SendEmptyResultPacket(ReplySocket, SquashFS::CacheFile(Path) ?
+                FEXServerClient::PacketType::TYPE_SUCCESS :
+                FEXServerClient::PacketType::TYPE_ERROR);
+              close(ReplySocket);
+              --NumCacheCopies;
+            }).detach();
+          }
+
+          CurrentOffset += sizeof(Req->CacheFile) + Req->CacheFile.Length;
+          break;
+        }
+        case FEXServerClient::PacketType::TYPE_GET_CODE_OBJECT_FD: {
+          const size_t Remaining = CurrentRead - CurrentOffset;
+          if (Remaining < sizeof(Req->CodeObject) ||
+              Req->CodeObject.Length == 0 ||
+              Req->CodeObject.Length > Remaining - sizeof(Req->CodeObject)) {
+            // Truncated packet, drop the rest of the data
+            SendEmptyErrorPacket(Socket);
+            CurrentOffset = CurrentRead;
+            break;
+          }
+
+          const std::string_view Name(Req->CodeObject.Name, strnlen(Req->CodeObject.Name, Req->CodeObject.Length));
+          int FD = GetCodeObjectFD(Name);
+          if (FD != -1) {
+            // Kept open for the next client that maps the same region
+            SendFDSuccessPacket(Socket, FD);
+          }
+          else {
+            SendEmptyErrorPacket(Socket);
+          }
+
+          CurrentOffset += sizeof(Req->CodeObject) + Req->CodeObject.Length;
+          break;
+        }
+        case FEXServerClient::PacketType::TYPE_GET_PROTOCOL_VERSION: {
+          FEXServerClient::FEXServerResultPacket Res {
+            .ProtocolVersion {
+              .Header {
+                .Type = FEXServerClient::PacketType::TYPE_GET_PROTOCOL_VERSION,
+              },
+              .Version = FEXServerClient::PROTOCOL_VERSION,
+            },
+          };
+
+          send(Socket, &Res, sizeof(Res), 0);
+
+          CurrentOffset += sizeof(FEXServerClient::FEXServerRequestPacket::Header);
+          break;
+        }
           // Invalid
         case FEXServerClient::PacketType::TYPE_ERROR:
         default:
@@ -438,6 +650,92 @@ namespace ProcessPipe {
     }
   }
 
+  /**
+   * @brief Answers every request a client has queued
+   *
+   * Clients may send several requests before reading any results, they get answered in order.
+   *
+   * @return false if the client hung up or the socket errored
+   */
+  bool HandleSocketData(int Socket) {
+    while (true) {
+      struct iovec iov {
+        .iov_base = RequestData,
+        .iov_len = sizeof(RequestData),
+      };
+
+      struct msghdr msg {
+        .msg_name = nullptr,
+        .msg_namelen = 0,
+        .msg_iov = &iov,
+        .msg_iovlen = 1,
+      };
+
+      ssize_t Read = recvmsg(Socket, &msg, MSG_DONTWAIT);
+      if (Read == 0) {
+        // Orderly shutdown of the client
+        return false;
+      }
+      else if (Read < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+          // Drained all the queued requests
+          return true;
+        }
+        else if (errno == EINTR) {
+          continue;
+        }
+
+        perror("recvmsg");
+        return false;
+      }
+
+      if (msg.msg_flags & MSG_TRUNC) {
+        LogMan::Msg::EFmt("[FEXServer] Request larger than 0x{:x} bytes", sizeof(RequestData));
+        SendEmptyErrorPacket(Socket);
+        continue;
+      }
+
+      HandleRequest(Socket, RequestData, Read);
+    }
+  }
+
+  void AcceptConnections() {
+    // Connections come in bursts when a lot of processes start, accept everything that is queued in one go
+    while (true) {
+      int NewFD = accept4(ServerSocketFD, nullptr, nullptr, SOCK_CLOEXEC);
+      if (NewFD == -1) {
+        if (errno == EINTR) {
+          continue;
+        }
+
+        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+          LogMan::Msg::EFmt("[FEXServer] accept failed: {} {}", errno, strerror(errno));
+        }
+        break;
+      }
+
+      struct epoll_event Event {
+        .events = EPOLLIN | EPOLLRDHUP,
+        .data {
+          .fd = NewFD,
+        },
+      };
+      epoll_ctl(EpollFD, EPOLL_CTL_ADD, NewFD, &Event);
+      ++NumClients;
+
+      // Check if we need to increase the FD limit.
+      ++NumFilesOpened;
+      CheckRaiseFDLimit();
+    }
+  }
+
+  void CloseClient(int Socket) {
+    // Closing removes it from the epoll set
+    close(Socket);
+    --NumClients;
+    --NumFilesOpened;
+  }
+
   void CloseConnections() {
     // Close the server pipe so new processes will know to spin up a new FEXServer.
     // This one is closing
@@ -445,77 +743,46 @@ namespace ProcessPipe {
 
     // Close the server socket so no more connections can be started
     close(ServerSocketFD);
+    close(EpollFD);
   }
 
   void WaitForRequests() {
     auto LastDataTime = std::chrono::system_clock::now();
 
-    while (!ShouldShutdown) {
-      struct timespec ts{};
-      ts.tv_sec = RequestTimeout;
+    constexpr size_t MAX_EVENTS = 64;
+    struct epoll_event Events[MAX_EVENTS];
 
-      int Result = ppoll(&PollFDs.at(0), PollFDs.size(), &ts, nullptr);
-      std::vector<struct pollfd> NewPollFDs{};
+    while (!ShouldShutdown) {
+      int Result = epoll_wait(EpollFD, Events, MAX_EVENTS, RequestTimeout * 1000);
 
       if (Result > 0) {
-        // Walk the FDs and see if we got any results
-        for (auto it = PollFDs.begin(); it != PollFDs.end(); ) {
-          auto &Event = *it;
-          bool Erase{};
-
-          if (Event.revents != 0) {
-            if (Event.fd == ServerSocketFD) {
-              if (Event.revents & POLLIN) {
-                // If it is the listen socket then we have a new connection
-                struct sockaddr_storage Addr{};
-                socklen_t AddrSize{};
-                int NewFD = accept(ServerSocketFD, reinterpret_cast<struct sockaddr*>(&Addr), &AddrSize);
-
-                // Add the new client to the temporary array
-                NewPollFDs.emplace_back(pollfd {
-                  .fd = NewFD,
-                  .events = POLLIN | POLLPRI | POLLRDHUP,
-                  .revents = 0,
-                });
-              }
-              else if (Event.revents & (POLLHUP | POLLERR | POLLNVAL)) {
-                // Listen socket error or shutting down
-                break;
-              }
-            }
-            else {
-              if (Event.revents & POLLIN) {
-                // Data from the socket
-                HandleSocketData(Event.fd);
-              }
-
-              if (Event.revents & (POLLHUP | POLLERR | POLLNVAL | POLLRDHUP)) {
-                // Error or hangup, close the socket and erase it from our list
-                Erase = true;
-                close(Event.fd);
-              }
-            }
+        for (int i = 0; i < Result; ++i) {
+          auto &Event = Events[i];
 
-            Event.revents = 0;
-            --Result;
+          if (Event.data.fd == ServerSocketFD) {
+            if (Event.events & EPOLLIN) {
+              // If it is the listen socket then we have new connections
+              AcceptConnections();
+            }
+            continue;
           }
 
-          if (Erase) {
-            it = PollFDs.erase(it);
+          bool Close{};
+          if (Event.events & EPOLLIN) {
+            // Data from the socket
+            Close = !HandleSocketData(Event.data.fd);
           }
-          else {
-            ++it;
+
+          if (Event.events & (EPOLLHUP | EPOLLERR | EPOLLRDHUP)) {
+            // Error or hangup, close the socket
+            Close = true;
           }
 
-          if (Result == 0) {
-            // Early break if we've consumed all the results
-            break;
+          if (Close) {
+            CloseClient(Event.data.fd);
           }
         }
 
-        // Insert the new FDs to poll
-        PollFDs.insert(PollFDs.begin(), NewPollFDs.begin(), NewPollFDs.end());
-
         LastDataTime = std::chrono::system_clock::now();
       }
       else {
@@ -523,7 +790,8 @@ namespace ProcessPipe {
         auto Diff = Now - LastDataTime;
         if (Diff >= std::chrono::seconds(RequestTimeout) &&
             !Foreground &&
-            PollFDs.size() == 1) {
+            NumClients == 0 &&
+            NumCacheCopies == 0) {
           // If we aren't running in the foreground and we have no connections after a timeout
           // Then we can just go ahead and leave
           ShouldShutdown = true;
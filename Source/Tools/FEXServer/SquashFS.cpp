@@ -3,11 +3,19 @@
 
 #include <FEXCore/Config/Config.h>
 #include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/fextl/fmt.h>
 #include <FEXCore/fextl/string.h>
+#include <FEXHeaderUtils/Filesystem.h>
+#include <FEXHeaderUtils/Syscalls.h>
 
+#include <algorithm>
 #include <fcntl.h>
 #include <filesystem>
+#include <linux/limits.h>
+#include <sys/mount.h>
 #include <sys/poll.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
 #include <sys/wait.h>
 #include <thread>
 
@@ -16,8 +24,18 @@ namespace SquashFS {
   constexpr int USER_PERMS = S_IRWXU | S_IRWXG | S_IRWXO;
   int ServerRootFSLockFD {-1};
   int FuseMountPID{};
+  bool KernelMounted{};
   fextl::string MountFolder{};
 
+  // Lock file of a mount shared between FEXServers, every user holds a read lock on it
+  int SharedMountLockFD {-1};
+  fextl::string SharedMountKey{};
+
+  fextl::string FileCacheFolder{};
+  int FileCacheFD {-1};
+  // Larger files than this are left on the FUSE mount
+  constexpr off_t MAX_CACHED_FILE_SIZE = 256 * 1024 * 1024;
+
   void ShutdownImagePID() {
     if (FuseMountPID) {
       FHU::Syscalls::tgkill(FuseMountPID, FuseMountPID, SIGINT);
@@ -123,6 +141,17 @@ namespace SquashFS {
       return false;
     }
 
+    // Linux 6.12+ can mount an EroFS image file directly, without a loop device or FUSE.
+    // This needs CAP_SYS_ADMIN so usually fails, in which case erofsfuse is used.
+    if (EroFS && mount(SquashFS.c_str(), MountFolderStr, "erofs", MS_RDONLY | MS_NOSUID | MS_NODEV, nullptr) == 0) {
+      KernelMounted = true;
+
+      // Write to the lock file where we are mounted
+      write(ServerRootFSLockFD, MountFolder.c_str(), MountFolder.size());
+      fdatasync(ServerRootFSLockFD);
+      return true;
+    }
+
     // Create local FDs so our internal forks can communicate
     int fds[2];
     pipe2(fds, 0);
@@ -189,12 +218,145 @@ namespace SquashFS {
     return true;
   }
 
+  bool IsMountPoint(const fextl::string &Path) {
+    struct stat Mount{};
+    struct stat Parent{};
+    // A dead FUSE mount fails with ENOTCONN here
+    return stat(Path.c_str(), &Mount) == 0 &&
+           stat(FHU::Filesystem::ParentPath(Path).c_str(), &Parent) == 0 &&
+           Mount.st_dev != Parent.st_dev;
+  }
+
+  bool SetSharedMountLock(short Type, bool Wait) {
+    flock lk {
+      .l_type = Type,
+      .l_whence = SEEK_SET,
+      .l_start = 0,
+      .l_len = 0,
+    };
+
+    int Ret;
+    while ((Ret = fcntl(SharedMountLockFD, Wait ? F_SETLKW : F_SETLK, &lk)) == -1 && errno == EINTR);
+    return Ret == 0;
+  }
+
+  /**
+   * @brief Takes the shared mount lock of an image, reusing its mount when another FEXServer already has it mounted
+   *
+   * The lock file contains 'K' or 'F' for a kernel or FUSE mount followed by the mount folder.
+   * Every FEXServer using the mount holds a read lock, so the reference count is the number of readers.
+   *
+   * @return True if an existing mount was picked up, false if this FEXServer needs to mount the image.
+   * The write lock is held in that case until PublishSharedMount.
+   */
+  bool AcquireSharedMount(const fextl::string &Image) {
+    struct stat Stat{};
+    if (stat(Image.c_str(), &Stat) != 0) {
+      return false;
+    }
+
+    // Identified by inode and modification time, hashing a multi-gigabyte image would defeat the point
+    SharedMountKey = fextl::fmt::format("{:x}-{:x}-{:x}-{:x}", Stat.st_dev, Stat.st_ino, Stat.st_size, Stat.st_mtim.tv_sec);
+    const auto LockFile = fextl::fmt::format("{}/.FEXImage-{}.lock", FEXServerClient::GetServerMountFolder(), SharedMountKey);
+
+    SharedMountLockFD = open(LockFile.c_str(), O_CREAT | O_RDWR | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (SharedMountLockFD == -1) {
+      return false;
+    }
+
+    // Serializes setup between FEXServers starting at the same time
+    if (!SetSharedMountLock(F_WRLCK, true)) {
+      close(SharedMountLockFD);
+      SharedMountLockFD = -1;
+      return false;
+    }
+
+    char Buffer[PATH_MAX + 1]{};
+    ssize_t Read = pread(SharedMountLockFD, Buffer, PATH_MAX, 0);
+    if (Read > 1 && (Buffer[0] == 'K' || Buffer[0] == 'F')) {
+      fextl::string ExistingMount(&Buffer[1], Read - 1);
+      if (IsMountPoint(ExistingMount)) {
+        MountFolder = std::move(ExistingMount);
+        KernelMounted = Buffer[0] == 'K';
+
+        // Write to the lock file where we are mounted
+        write(ServerRootFSLockFD, MountFolder.c_str(), MountFolder.size());
+        fdatasync(ServerRootFSLockFD);
+
+        SetSharedMountLock(F_RDLCK, false);
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  void PublishSharedMount() {
+    if (SharedMountLockFD == -1) {
+      return;
+    }
+
+    const auto Contents = fextl::fmt::format("{}{}", KernelMounted ? 'K' : 'F', MountFolder);
+    ftruncate(SharedMountLockFD, 0);
+    pwrite(SharedMountLockFD, Contents.c_str(), Contents.size(), 0);
+    fdatasync(SharedMountLockFD);
+    SetSharedMountLock(F_RDLCK, false);
+  }
+
+  /**
+   * @return True if this was the last FEXServer using the mount, which now needs unmounting
+   */
+  bool ReleaseSharedMount() {
+    if (SetSharedMountLock(F_WRLCK, false)) {
+      // Keep the write lock until the mount is gone so nobody picks it up in the mean time
+      return true;
+    }
+
+    close(SharedMountLockFD);
+    SharedMountLockFD = -1;
+    return false;
+  }
+
+  void CloseSharedMount() {
+    if (SharedMountLockFD == -1) {
+      return;
+    }
+
+    // Not unlinked, a FEXServer might be waiting on the lock of this inode
+    ftruncate(SharedMountLockFD, 0);
+    close(SharedMountLockFD);
+    SharedMountLockFD = -1;
+  }
+
   void UnmountRootFS() {
     FEX_CONFIG_OPT(LDPath, ROOTFS);
     if (!FEX::FormatCheck::IsSquashFS(LDPath()) && !FEX::FormatCheck::IsEroFS(LDPath())) {
       return;
     }
 
+    if (FileCacheFD != -1) {
+      close(FileCacheFD);
+      FileCacheFD = -1;
+    }
+
+    if (SharedMountLockFD != -1 && !ReleaseSharedMount()) {
+      // Another FEXServer is still using the mount, it gets unmounted by the last one out
+      auto RootFSLockFile = FEXServerClient::GetServerRootFSLockFile();
+      unlink(RootFSLockFile.c_str());
+      return;
+    }
+
+    if (KernelMounted) {
+      // Lazy unmount, clients might still have files open
+      umount2(MountFolder.c_str(), MNT_DETACH);
+      rmdir(MountFolder.c_str());
+
+      auto RootFSLockFile = FEXServerClient::GetServerRootFSLockFile();
+      unlink(RootFSLockFile.c_str());
+      CloseSharedMount();
+      return;
+    }
+
     SquashFS::ShutdownImagePID();
 
     // Handle final mount removal
@@ -225,9 +387,34 @@ namespace SquashFS {
       // Remove the rootfs lock file
       auto RootFSLockFile = FEXServerClient::GetServerRootFSLockFile();
       unlink(RootFSLockFile.c_str());
+      CloseSharedMount();
     }
   }
 
+  void InitializeFileCache(const fextl::string &Image) {
+    struct stat Stat{};
+    if (stat(Image.c_str(), &Stat) != 0) {
+      return;
+    }
+
+    if (SharedMountLockFD != -1) {
+      // Shared by every FEXServer of the image along with the mount
+      FileCacheFolder = fextl::fmt::format("{}/.FEXImage-{}.cache", FEXServerClient::GetServerMountFolder(), SharedMountKey);
+    }
+    else {
+      // Keyed on the image size and modification time so a replaced image doesn't get stale files
+      FileCacheFolder = fextl::fmt::format("{}RootFSCache/{}-{:x}-{:x}", FEXCore::Config::GetDataDirectory(),
+        FHU::Filesystem::GetFilename(Image), Stat.st_size, Stat.st_mtim.tv_sec);
+    }
+
+    if (!FHU::Filesystem::CreateDirectories(FileCacheFolder)) {
+      LogMan::Msg::EFmt("[FEXServer] Couldn't create RootFS file cache folder: {}", FileCacheFolder);
+      return;
+    }
+
+    FileCacheFD = open(FileCacheFolder.c_str(), O_PATH | O_DIRECTORY | O_CLOEXEC);
+  }
+
   bool InitializeSquashFS() {
     FEX_CONFIG_OPT(LDPath, ROOTFS);
 
@@ -254,10 +441,19 @@ namespace SquashFS {
       return false;
     }
 
+    FEX_CONFIG_OPT(ServerSharedMounts, SERVERSHAREDMOUNTS);
+    const bool ReusedMount = ServerSharedMounts() && AcquireSharedMount(LDPath());
+
     // Setup rootfs here
-    if (!MountRootFSImagePath(LDPath(), IsEroFS)) {
-      LogMan::Msg::EFmt("[FEXServer] Couldn't mount squashfs path");
-      return false;
+    if (!ReusedMount) {
+      if (!MountRootFSImagePath(LDPath(), IsEroFS)) {
+        LogMan::Msg::EFmt("[FEXServer] Couldn't mount squashfs path");
+        // Drops the setup lock for the next FEXServer to try
+        CloseSharedMount();
+        return false;
+      }
+
+      PublishSharedMount();
     }
 
     if (!DowngradeRootFSPipeToReadLock()) {
@@ -265,10 +461,83 @@ namespace SquashFS {
       return false;
     }
 
+    FEX_CONFIG_OPT(RootFSFileCache, ROOTFSFILECACHE);
+    if (RootFSFileCache()) {
+      InitializeFileCache(LDPath());
+    }
+
     return true;
   }
 
   fextl::string GetMountFolder() {
     return MountFolder;
   }
+
+  int GetFileCacheFD() {
+    return FileCacheFD;
+  }
+
+  bool CacheFile(std::string_view Path) {
+    if (FileCacheFD == -1 || Path.empty() || Path.front() == '/') {
+      return false;
+    }
+
+    // Clients only send resolved paths, refuse anything that could step outside of the mount
+    for (size_t Offset = 0; Offset <= Path.size();) {
+      const auto End = std::min(Path.find('/', Offset), Path.size());
+      const auto Component = Path.substr(Offset, End - Offset);
+      if (Component.empty() || Component == "." || Component == "..") {
+        return false;
+      }
+      Offset = End + 1;
+    }
+
+    const fextl::string Relative(Path);
+    if (FHU::Filesystem::ExistsAt(FileCacheFD, Relative)) {
+      // Another process got here first
+      return true;
+    }
+
+    int SourceFD = open(fextl::fmt::format("{}/{}", MountFolder, Relative).c_str(), O_RDONLY | O_NOFOLLOW | O_CLOEXEC);
+    if (SourceFD == -1) {
+      return false;
+    }
+
+    struct stat Stat{};
+    if (fstat(SourceFD, &Stat) != 0 || !S_ISREG(Stat.st_mode) || Stat.st_size > MAX_CACHED_FILE_SIZE) {
+      close(SourceFD);
+      return false;
+    }
+
+    const auto Destination = fextl::fmt::format("{}/{}", FileCacheFolder, Relative);
+    // Copies run on their own threads, two clients can be copying the same file at once
+    const auto TmpDestination = fextl::fmt::format("{}.{}.tmp", Destination, FHU::Syscalls::gettid());
+    bool Result = FHU::Filesystem::CreateDirectories(FHU::Filesystem::ParentPath(Destination));
+
+    int DestinationFD = Result ? open(TmpDestination.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, (Stat.st_mode & 0777) | S_IRUSR | S_IWUSR) : -1;
+    if (DestinationFD != -1) {
+      // Decompresses through FUSE once, every open after this is a plain file
+      off_t Offset{};
+      while (Offset < Stat.st_size) {
+        ssize_t Copied = sendfile(DestinationFD, SourceFD, &Offset, Stat.st_size - Offset);
+        if (Copied <= 0) {
+          break;
+        }
+      }
+      Result = Offset == Stat.st_size;
+      close(DestinationFD);
+
+      // Rename in to place so clients never see a partial file
+      Result = Result && rename(TmpDestination.c_str(), Destination.c_str()) == 0;
+      if (!Result) {
+        unlink(TmpDestination.c_str());
+      }
+    }
+    else {
+      Result = false;
+    }
+
+    close(SourceFD);
+    return Result;
+  }
 }
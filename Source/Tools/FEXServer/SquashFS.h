@@ -1,8 +1,26 @@
 #pragma once
 #include <FEXCore/fextl/string.h>
 
+#include <string_view>
+
 namespace SquashFS {
   bool InitializeSquashFS();
   void UnmountRootFS();
   fextl::string GetMountFolder();
+
+  /**
+   * @brief O_PATH FD of the RootFS file cache folder, or -1 when RootFSFileCache is disabled
+   */
+  int GetFileCacheFD();
+
+  /**
+   * @brief Copies a file out of the RootFS mount in to the file cache folder
+   *
+   * Safe to call from multiple threads at once.
+   *
+   * @param Path - Path relative to the RootFS with symlinks resolved
+   *
+   * @return True if the file is in the cache folder afterwards
+   */
+  bool CacheFile(std::string_view Path);
 }
@@ -3,7 +3,7 @@
 #include <utility>
 #include <algorithm>
 
-#include <FEXCore/fextl/vector.h>
+#include <FEXCore/fextl/map.h>
 
 template<typename SizeType>
 class IntervalList {
@@ -20,7 +20,22 @@ public:
   };
 
 private:
-  fextl::vector<Interval> Intervals; ///< list of intervals sorted by their end offset
+  // Map of non-overlapping intervals from their offset to their end offset.
+  // A balanced tree keeps inserts and removals logarithmic with thousands of intervals
+  fextl::map<SizeType, SizeType> Intervals;
+  using IteratorType = typename decltype(Intervals)::iterator;
+
+  // Lowest offset interval that (maybe) overlaps with the given offset
+  IteratorType LowestOverlapping(SizeType Offset) {
+    auto It = Intervals.upper_bound(Offset);
+    if (It != Intervals.begin()) {
+      auto PrevIt = std::prev(It);
+      if (PrevIt->second > Offset) {
+        return PrevIt;
+      }
+    }
+    return It;
+  }
 
 public:
   struct QueryResult {
@@ -38,30 +53,26 @@ public:
       return;
     }
 
-    auto [FirstIt, EndIt] = std::equal_range(Intervals.begin(), Intervals.end(), Entry, [](const auto &LHS, const auto &RHS) {
-      return LHS.End <= RHS.Offset;
-    });
+    auto FirstIt = LowestOverlapping(Entry.Offset);
+    auto EndIt = FirstIt;
+    while (EndIt != Intervals.end() && EndIt->first < Entry.End) {
+      ++EndIt;
+    }
 
     if (FirstIt == EndIt) {
       // No overlaps
-      Intervals.insert(FirstIt, Entry);
+      Intervals.emplace_hint(EndIt, Entry.Offset, Entry.End);
       return;
     }
 
-    auto LastIt = std::prev(EndIt);
     // FirstIt/LastIt are the lowest/highest offset intervals respectively that overlap with the new interval
+    const auto LastIt = std::prev(EndIt);
+    const SizeType Offset = std::min(Entry.Offset, FirstIt->first);
+    const SizeType End = std::max(LastIt->second, Entry.End);
 
-    const SizeType Offset = std::min(Entry.Offset, FirstIt->Offset);
-    const SizeType End = std::max(LastIt->End, Entry.End);
-
-    // Erase all overlapping entries but the first
-    const auto EraseStartIt = std::next(FirstIt);
-    const auto EraseEndIt = std::next(LastIt);
-    LastIt = Intervals.erase(EraseStartIt, EraseEndIt);
-    FirstIt = std::prev(LastIt);
-
-    FirstIt->Offset = Offset;
-    FirstIt->End = End;
+    // Replace all overlapping entries with the merged interval
+    EndIt = Intervals.erase(FirstIt, EndIt);
+    Intervals.emplace_hint(EndIt, Offset, End);
   }
 
   void Remove(Interval Entry) {
@@ -69,76 +80,54 @@ public:
       return;
     }
 
-    auto [FirstIt, EndIt] = std::equal_range(Intervals.begin(), Intervals.end(), Entry, [](const auto &LHS, const auto &RHS) {
-      return LHS.End <= RHS.Offset;
-    });
-
-    if (FirstIt == EndIt) {
+    auto It = LowestOverlapping(Entry.Offset);
+    if (It == Intervals.end() || It->first >= Entry.End) {
       // No intersecting intervals present, nothing more to do
       return;
     }
 
-    if (FirstIt->Offset < Entry.Offset && FirstIt->End > Entry.End) {
-      // The interval to be removed is fully enclosed by an existing interval
-      
-      // Break the single interval into two smaller intervals on either side on the interval being removed
-      const auto FirstPredecessorIt = Intervals.insert(FirstIt, *FirstIt);
-      FirstIt = std::next(FirstPredecessorIt);
-      FirstPredecessorIt->End = Entry.Offset;
-      FirstIt->Offset = Entry.End;
-      return;
-    }
-
-    auto LastIt = std::prev(EndIt);
-    // FirstIt/LastIt are the lowest/highest offset intervals respectively that overlap with the new interval
-
-    if (FirstIt->Offset < Entry.Offset) {
+    if (It->first < Entry.Offset) {
       // The first overlap straddles the start of the interval to be removed
-      FirstIt->End = Entry.Offset;
-      if (FirstIt == LastIt) {
-        // No more overlaps left, nothing more to do
+      const SizeType End = It->second;
+      It->second = Entry.Offset;
+
+      if (End > Entry.End) {
+        // The interval to be removed is fully enclosed by an existing interval,
+        // keep the part on the other side of it too
+        Intervals.emplace_hint(std::next(It), Entry.End, End);
         return;
-      } else {
-        FirstIt++;
       }
+      ++It;
     }
 
-    if (LastIt->End > Entry.End) {
-      // The last overlap straddles the end of the interval to be removed
-      LastIt->Offset = Entry.End;
-      if (LastIt == FirstIt) {
-        // No more overlaps left, nothing more to do
-        return;
-      } else {
-        LastIt--;
-      }
+    // Erase the overlaps that are fully removed
+    while (It != Intervals.end() && It->second <= Entry.End) {
+      It = Intervals.erase(It);
     }
 
-    // Now none of the overlaps straddle the edges of the interval to be removed they can all be erased
-    const auto EraseStartIt = FirstIt;
-    const auto EraseEndIt = std::next(LastIt);
-    Intervals.erase(EraseStartIt, EraseEndIt);
+    if (It != Intervals.end() && It->first < Entry.End) {
+      // The last overlap straddles the end of the interval to be removed
+      const SizeType End = It->second;
+      It = Intervals.erase(It);
+      Intervals.emplace_hint(It, Entry.End, End);
+    }
   }
 
   QueryResult Query(SizeType Offset) {
-    const auto It = std::upper_bound(Intervals.begin(), Intervals.end(), Offset, [](const auto &LHS, const auto &RHS) {
-      return LHS < RHS.End;
-    }); // Lowest offset interval that (maybe) overlaps with the query offset
+    const auto It = LowestOverlapping(Offset);
 
     if (It == Intervals.end()) { // No overlaps past offset
       return {false, {}};
-    } else if (It->Offset > Offset) { // No overlap, return the distance to the next possible overlap
-      return {false, It->Offset - Offset};
+    } else if (It->first > Offset) { // No overlap, return the distance to the next possible overlap
+      return {false, It->first - Offset};
     } else { // Overlap, return the distance to the end of the overlap
-      return {true, It->End - Offset};
+      return {true, It->second - Offset};
     }
   }
 
   bool Intersect(Interval Entry) {
-    const auto It = std::upper_bound(Intervals.begin(), Intervals.end(), Entry, [](const auto &LHS, const auto &RHS) {
-      return LHS.Offset < RHS.End;
-    }); // Lowest offset interval that (maybe) overlaps with the query offset
+    const auto It = LowestOverlapping(Entry.Offset);
 
-    return It != Intervals.end() && It->Offset < Entry.End;
+    return It != Intervals.end() && It->first < Entry.End;
   }
 };
@@ -8,6 +8,8 @@ $end_info$
 // Thanks to André Zwing, whose ideas from https://github.com/AndreRH/hangover this code is based upon
 
 #include <FEXCore/fextl/fmt.h>
+#include <FEXCore/fextl/map.h>
+#include <FEXCore/fextl/string.h>
 #include <FEXCore/Core/X86Enums.h>
 #include <FEXCore/Core/SignalDelegator.h>
 #include <FEXCore/Core/Context.h>
@@ -29,6 +31,8 @@ $end_info$
 #include "WineHelpers.h"
 #include "IntervalList.h"
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <type_traits>
 #include <atomic>
@@ -92,7 +96,13 @@ namespace {
 
   SYSTEM_CPU_INFORMATION CpuInfo{};
 
-  std::mutex ThreadSuspendLock;
+  // Suspending the same thread from two others at once would race on its PAUSED bit, but suspends of unrelated
+  // threads don't need to serialize. Hashing by TID keeps those from queueing behind each other
+  std::array<std::mutex, 16> ThreadSuspendLocks;
+
+  std::mutex &GetThreadSuspendLock(uint64_t ThreadTID) {
+    return ThreadSuspendLocks[ThreadTID % ThreadSuspendLocks.size()];
+  }
 
   std::pair<NTSTATUS, TLS> GetThreadTLS(HANDLE Thread) {
     THREAD_BASIC_INFORMATION Info;
@@ -130,9 +140,7 @@ namespace Context {
 
     State.rip = Context->Eip;
 
-    for (size_t i = 0; i < FEXCore::Core::CPUState::NUM_EFLAG_BITS; ++i) {
-      State.flags[i] = (Context->EFlags >> i) & 1;
-    }
+    CTX->SetFlagsFromCompactedEFLAGS(&State, Context->EFlags);
 
     State.es_idx = Context->SegEs & 0xffff;
     State.cs_idx = Context->SegCs & 0xffff;
@@ -178,10 +186,7 @@ namespace Context {
 
     Context->Eip = State.rip;
 
-    Context->EFlags = 0;
-    for (size_t i = 0; i < FEXCore::Core::CPUState::NUM_EFLAG_BITS; ++i) {
-      Context->EFlags |= State.flags[i] << i;
-    }
+    Context->EFlags = CTX->ReconstructCompactedEFLAGS(&State);
 
     Context->SegEs = State.es_idx;
     Context->SegCs = State.cs_idx;
@@ -209,14 +214,15 @@ namespace Context {
     WineHelpers::fpux_to_fpu(&Context->FloatSave, XSave);
   }
 
-  NTSTATUS FlushThreadStateContext(HANDLE Thread) {
+  // Flushes the JIT state to the thread's CPU area, only the register groups in `Flags` are written
+  NTSTATUS FlushThreadStateContext(HANDLE Thread, ULONG Flags = WOW64_CONTEXT_FULL | WOW64_CONTEXT_EXTENDED_REGISTERS) {
     const auto [Err, TLS] = GetThreadTLS(Thread);
     if (Err) {
       return Err;
     }
 
     WOW64_CONTEXT TmpWowContext{
-      .ContextFlags = WOW64_CONTEXT_FULL | WOW64_CONTEXT_EXTENDED_REGISTERS
+      .ContextFlags = Flags
     };
 
     Context::StoreWowContextFromState(TLS.ThreadState()->CurrentFrame->State, &TmpWowContext);
@@ -321,14 +327,40 @@ namespace Context {
 
 namespace Invalidation {
   static IntervalList<uint64_t> RWXIntervals;
+  // Pages that have had guest code translated from them since they were last invalidated
+  static IntervalList<uint64_t> TranslatedIntervals;
   static std::mutex RWXIntervalsLock;
 
+  void AddTranslatedInterval(uint64_t Address, uint64_t Size) {
+    const auto AlignedBase = Address & FHU::FEX_PAGE_MASK;
+    const auto AlignedSize = (Address - AlignedBase + Size + FHU::FEX_PAGE_SIZE - 1) & FHU::FEX_PAGE_MASK;
+
+    std::scoped_lock Lock(RWXIntervalsLock);
+    TranslatedIntervals.Insert({AlignedBase, AlignedBase + AlignedSize});
+  }
+
+  // Invalidates the given range, skipping the invalidation entirely if no code was ever translated from it
+  void InvalidateTranslatedRange(uint64_t Base, uint64_t Size) {
+    {
+      std::scoped_lock Lock(RWXIntervalsLock);
+      if (!TranslatedIntervals.Intersect({Base, Base + Size})) {
+        return;
+      }
+
+      // Removed before invalidating so that code translated concurrently stays tracked
+      TranslatedIntervals.Remove({Base, Base + Size});
+    }
+
+    // RWXIntervalsLock cannot be held during invalidation
+    CTX->InvalidateGuestCodeRange(GetTLS().ThreadState(), Base, Size);
+  }
+
   void HandleMemoryProtectionNotification(uint64_t Address, uint64_t Size, ULONG Prot) {
     const auto AlignedBase = Address & FHU::FEX_PAGE_MASK;
     const auto AlignedSize = (Address - AlignedBase + Size + FHU::FEX_PAGE_SIZE - 1) & FHU::FEX_PAGE_MASK;
 
     if (Prot & (PAGE_EXECUTE | PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE)) {
-      CTX->InvalidateGuestCodeRange(GetTLS().ThreadState(), AlignedBase, AlignedSize);
+      InvalidateTranslatedRange(AlignedBase, AlignedSize);
     }
 
     if (Prot & PAGE_EXECUTE_READWRITE) {
@@ -349,7 +381,7 @@ namespace Invalidation {
     const auto SectionBase = reinterpret_cast<uint64_t>(Info.AllocationBase);
     const auto SectionSize = reinterpret_cast<uint64_t>(Info.BaseAddress) + Info.RegionSize
                              - reinterpret_cast<uint64_t>(Info.AllocationBase);
-    CTX->InvalidateGuestCodeRange(GetTLS().ThreadState(), SectionBase, SectionSize);
+    InvalidateTranslatedRange(SectionBase, SectionSize);
 
     if (Free) {
       std::scoped_lock Lock(RWXIntervalsLock);
@@ -360,7 +392,7 @@ namespace Invalidation {
   void InvalidateAlignedInterval(uint64_t Address, uint64_t Size, bool Free) {
     const auto AlignedBase = Address & FHU::FEX_PAGE_MASK;
     const auto AlignedSize = (Address - AlignedBase + Size + FHU::FEX_PAGE_SIZE - 1) & FHU::FEX_PAGE_MASK;
-    CTX->InvalidateGuestCodeRange(GetTLS().ThreadState(), AlignedBase, AlignedSize);
+    InvalidateTranslatedRange(AlignedBase, AlignedSize);
 
     if (Free) {
       std::scoped_lock Lock(RWXIntervalsLock);
@@ -412,6 +444,107 @@ namespace Invalidation {
   }
 }
 
+namespace Images {
+  struct ImageMapping {
+    uint64_t End;
+    FEXCore::IR::AOTIRCacheEntry *Entry;
+  };
+
+  // PE images that code has been translated from, keyed by their base address
+  static fextl::map<uint64_t, ImageMapping> Mappings;
+  static std::mutex MappingsLock;
+
+  // Identifies a mapped PE image by its path, link timestamp and checksum.
+  // A rebuilt module at the same path gets a different name so stale cache entries are never used
+  fextl::string GetImageName(uint64_t Base, uint64_t *Size) {
+    const auto *DosHeader = reinterpret_cast<const IMAGE_DOS_HEADER *>(Base);
+    if (DosHeader->e_magic != IMAGE_DOS_SIGNATURE) {
+      return {};
+    }
+
+    const auto *NtHeaders = reinterpret_cast<const IMAGE_NT_HEADERS32 *>(Base + DosHeader->e_lfanew);
+    if (NtHeaders->Signature != IMAGE_NT_SIGNATURE) {
+      return {};
+    }
+
+    struct {
+      MEMORY_SECTION_NAME Name;
+      WCHAR Buffer[MAX_PATH + 1];
+    } SectionName;
+
+    if (NtQueryVirtualMemory(NtCurrentProcess(), reinterpret_cast<void *>(Base), MemoryMappedFilenameInformation,
+                             &SectionName, sizeof(SectionName), nullptr)) {
+      return {};
+    }
+
+    char Path[MAX_PATH * 3];
+    ULONG PathLength{};
+    if (RtlUnicodeToUTF8N(Path, sizeof(Path), &PathLength, SectionName.Name.SectionFileName.Buffer,
+                          SectionName.Name.SectionFileName.Length)) {
+      return {};
+    }
+
+    // NT paths use backslashes, the cache only understands forward slashes when splitting off the filename
+    fextl::string Name(Path, PathLength);
+    std::replace(Name.begin(), Name.end(), '\\', '/');
+
+    *Size = NtHeaders->OptionalHeader.SizeOfImage;
+    return fextl::fmt::format("{}-{:08x}-{:08x}", Name, NtHeaders->FileHeader.TimeDateStamp,
+                              NtHeaders->OptionalHeader.CheckSum);
+  }
+
+  FEXCore::HLE::AOTIRCacheEntryLookupResult Lookup(uint64_t Address) {
+    std::scoped_lock Lock(MappingsLock);
+
+    auto It = Mappings.upper_bound(Address);
+    if (It != Mappings.begin()) {
+      auto PrevIt = std::prev(It);
+      if (Address < PrevIt->second.End) {
+        return {PrevIt->second.Entry, PrevIt->first};
+      }
+    }
+
+    MEMORY_BASIC_INFORMATION Info;
+    if (NtQueryVirtualMemory(NtCurrentProcess(), reinterpret_cast<void *>(Address), MemoryBasicInformation, &Info, sizeof(Info), nullptr) ||
+        Info.Type != MEM_IMAGE) {
+      return {nullptr, 0};
+    }
+
+    const auto Base = reinterpret_cast<uint64_t>(Info.AllocationBase);
+    uint64_t Size{};
+    const auto Name = GetImageName(Base, &Size);
+    if (Name.empty()) {
+      return {nullptr, 0};
+    }
+
+    LogMan::Msg::DFmt("Add image region: {:X} - {:X} {}", Base, Base + Size, Name);
+    auto Entry = CTX->LoadAOTIRCacheEntry(Name);
+    CTX->AddNamedRegion(Base, Size, 0, Name);
+    Mappings.emplace(Base, ImageMapping{Base + Size, Entry});
+    return {Entry, Base};
+  }
+
+  void HandleUnmap(uint64_t Address) {
+    std::scoped_lock Lock(MappingsLock);
+
+    auto It = Mappings.upper_bound(Address);
+    if (It == Mappings.begin()) {
+      return;
+    }
+
+    --It;
+    if (Address >= It->second.End) {
+      return;
+    }
+
+    if (It->second.Entry) {
+      CTX->UnloadAOTIRCacheEntry(It->second.Entry);
+    }
+    CTX->RemoveNamedRegion(It->first, It->second.End - It->first);
+    Mappings.erase(It);
+  }
+}
+
 namespace Logging {
   void MsgHandler(LogMan::DebugLevels Level, char const *Message) {
     const auto Output = fextl::fmt::format("[{}][{:X}] {}\n", LogMan::DebugLevelStr(Level), GetCurrentThreadId(), Message);
@@ -478,12 +611,27 @@ public:
   }
 
   FEXCore::HLE::AOTIRCacheEntryLookupResult LookupAOTIRCacheEntry(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestAddr) override {
-    return {0, 0};
+    // Identifying the image costs a syscall for code outside of known images, only do it when something consumes the result
+    if (!AOTIRLoad() && !AOTIRCapture() && !AOTIRGenerate() && !LibraryJITNaming() && !GDBSymbols() &&
+        CacheObjectCodeCompilation() == FEXCore::Config::ConfigObjectCodeHandler::CONFIG_NONE) {
+      return {nullptr, 0};
+    }
+
+    return Images::Lookup(GuestAddr);
   }
 
   void MarkGuestExecutableRange(FEXCore::Core::InternalThreadState *Thread, uint64_t Start, uint64_t Length) override {
+    Invalidation::AddTranslatedInterval(Start, Length);
     Invalidation::ReprotectRWXIntervals(Start, Length);
   }
+
+private:
+  FEX_CONFIG_OPT(AOTIRLoad, AOTIRLOAD);
+  FEX_CONFIG_OPT(AOTIRCapture, AOTIRCAPTURE);
+  FEX_CONFIG_OPT(AOTIRGenerate, AOTIRGENERATE);
+  FEX_CONFIG_OPT(LibraryJITNaming, LIBRARYJITNAMING);
+  FEX_CONFIG_OPT(GDBSymbols, GDBSYMBOLS);
+  FEX_CONFIG_OPT(CacheObjectCodeCompilation, CACHEOBJECTCODECOMPILATION);
 };
 
 void BTCpuProcessInit() {
@@ -553,8 +701,13 @@ NTSTATUS BTCpuGetContext(HANDLE Thread, HANDLE Process, void *Unknown, WOW64_CON
   }
 
   if (!(TLS.ControlWord().load(std::memory_order::relaxed) & ControlBits::WOW_CPU_AREA_DIRTY)) {
-    if (Err = Context::FlushThreadStateContext(Thread); Err) {
-      return Err;
+    // Only the requested registers are read back, don't bother flushing the rest
+    const ULONG FlushFlags = WOW64_CONTEXT_i386 |
+                             (Context->ContextFlags & (WOW64_CONTEXT_FULL | WOW64_CONTEXT_EXTENDED_REGISTERS));
+    if (FlushFlags & ~WOW64_CONTEXT_i386) {
+      if (Err = Context::FlushThreadStateContext(Thread, FlushFlags); Err) {
+        return Err;
+      }
     }
   }
 
@@ -572,8 +725,13 @@ NTSTATUS BTCpuSetContext(HANDLE Thread, HANDLE Process, void *Unknown, WOW64_CON
   WOW64_CONTEXT TmpContext = *Context;
 
   if (!(TLS.ControlWord().load(std::memory_order::relaxed) & ControlBits::WOW_CPU_AREA_DIRTY)) {
-    if (Err = Context::FlushThreadStateContext(Thread); Err) {
-      return Err;
+    // Register groups in the input context are entirely overwritten by the merge, only flush the others
+    const ULONG FlushFlags = WOW64_CONTEXT_i386 |
+                             ((WOW64_CONTEXT_FULL | WOW64_CONTEXT_EXTENDED_REGISTERS) & ~TmpContext.ContextFlags);
+    if (FlushFlags & ~WOW64_CONTEXT_i386) {
+      if (Err = Context::FlushThreadStateContext(Thread, FlushFlags); Err) {
+        return Err;
+      }
     }
   }
 
@@ -635,7 +793,7 @@ NTSTATUS BTCpuSuspendLocalThread(HANDLE Thread, ULONG *Count) {
     return Err;
   }
 
-  std::scoped_lock Lock(ThreadSuspendLock);
+  std::scoped_lock Lock(GetThreadSuspendLock(ThreadTID));
   // If CONTROL_IN_JIT is unset at this point, then it can never be set (and thus the JIT cannot be reentered) as
   // CONTROL_PAUSED has been set, as such, while this may redundantly request interrupts in rare cases it will never
   // miss them
@@ -745,6 +903,7 @@ void BTCpuNotifyMemoryFree(void *Address, SIZE_T Size, ULONG FreeType) {
 }
 
 void BTCpuNotifyUnmapViewOfSection(void *Address, ULONG Flags) {
+  Images::HandleUnmap(reinterpret_cast<uint64_t>(Address));
   Invalidation::InvalidateContainingSection(reinterpret_cast<uint64_t>(Address), true);
 }
 
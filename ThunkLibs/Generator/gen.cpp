@@ -1,7 +1,9 @@
 #include "clang/AST/RecursiveASTVisitor.h"
 #include "clang/Frontend/CompilerInstance.h"
 
+#include <algorithm>
 #include <fstream>
+#include <functional>
 #include <numeric>
 #include <iostream>
 #include <string_view>
@@ -48,6 +50,14 @@ struct ThunkedFunction : FunctionParams {
     // This is implied e.g. for thunks generated for variadic functions
     bool custom_host_impl = false;
 
+    // If set, guest calls are queued in a per-thread buffer and sent to the host
+    // in one transition before the next non-batched call to this library.
+    // The value is the index in to the host's table of batchable functions.
+    std::optional<unsigned> batch_index;
+
+    // If true, the returned pointer was allocated on the host heap and the guest frees it
+    bool returns_host_allocation = false;
+
     std::string GetOriginalFunctionName() const {
         const std::string suffix = "_internal";
         assert(function_name.length() > suffix.size());
@@ -187,6 +197,10 @@ struct Annotations {
 
     bool returns_guest_pointer = false;
 
+    bool batchable = false;
+
+    bool returns_host_allocation = false;
+
     std::optional<clang::QualType> uniform_va_type;
 
     CallbackStrategy callback_strategy = CallbackStrategy::Default;
@@ -208,6 +222,10 @@ static Annotations GetAnnotations(clang::ASTContext& context, clang::CXXRecordDe
             ret.callback_strategy = CallbackStrategy::Guest;
         } else if (annotation == "fexgen::custom_guest_entrypoint") {
             ret.custom_guest_entrypoint = true;
+        } else if (annotation == "fexgen::batchable") {
+            ret.batchable = true;
+        } else if (annotation == "fexgen::returns_host_allocation") {
+            ret.returns_host_allocation = true;
         } else {
             throw report_error(base.getSourceRange().getBegin(), "Unknown annotation");
         }
@@ -254,9 +272,71 @@ public:
     }
 };
 
+static TypeLayout ComputeTypeLayout(clang::ASTContext& context, const clang::RecordDecl* decl) {
+    const auto& layout = context.getASTRecordLayout(decl);
+    TypeLayout ret { static_cast<uint64_t>(context.toBits(layout.getSize())),
+                     static_cast<uint64_t>(context.toBits(layout.getAlignment())),
+                     {} };
+    for (const clang::FieldDecl* field : decl->fields()) {
+        ret.fields.push_back({ field->getNameAsString(),
+                               layout.getFieldOffset(field->getFieldIndex()),
+                               field->isBitField() ? field->getBitWidthValue(context) : context.getTypeSize(field->getType()) });
+    }
+    return ret;
+}
+
+static std::string GetLayoutKey(clang::ASTContext& context, const clang::RecordDecl* decl) {
+    return context.getRecordType(decl).getCanonicalType().getAsString();
+}
+
+class AnalyzeDataLayoutAction : public clang::ASTFrontendAction {
+public:
+    AnalyzeDataLayoutAction(TypeLayouts& layouts_) : layouts(layouts_) {
+    }
+
+    std::unique_ptr<clang::ASTConsumer> CreateASTConsumer(clang::CompilerInstance&, clang::StringRef /*file*/) override;
+
+private:
+    TypeLayouts& layouts;
+};
+
+class LayoutCollector : public clang::RecursiveASTVisitor<LayoutCollector> {
+public:
+    LayoutCollector(clang::ASTContext& context_, TypeLayouts& layouts_) : context(context_), layouts(layouts_) {
+    }
+
+    bool VisitRecordDecl(clang::RecordDecl* decl) {
+        if (decl->isCompleteDefinition() && !decl->isInvalidDecl() && !decl->isDependentType()) {
+            layouts.emplace(GetLayoutKey(context, decl), ComputeTypeLayout(context, decl));
+        }
+        return true;
+    }
+
+private:
+    clang::ASTContext& context;
+    TypeLayouts& layouts;
+};
+
+class LayoutConsumer : public clang::ASTConsumer {
+public:
+    LayoutConsumer(TypeLayouts& layouts_) : layouts(layouts_) {
+    }
+
+    void HandleTranslationUnit(clang::ASTContext& context) override {
+        LayoutCollector { context, layouts }.TraverseDecl(context.getTranslationUnitDecl());
+    }
+
+private:
+    TypeLayouts& layouts;
+};
+
+std::unique_ptr<clang::ASTConsumer> AnalyzeDataLayoutAction::CreateASTConsumer(clang::CompilerInstance&, clang::StringRef) {
+    return std::make_unique<LayoutConsumer>(layouts);
+}
+
 class GenerateThunkLibsAction : public clang::ASTFrontendAction {
 public:
-    GenerateThunkLibsAction(const std::string& libname, const OutputFilenames&);
+    GenerateThunkLibsAction(const std::string& libname, const OutputFilenames&, const TypeLayouts* guest_layouts);
 
     void ExecuteAction() override;
 
@@ -266,22 +346,27 @@ private:
     // Build the internal API representation by processing fex_gen_config and other annotated entities
     void ParseInterface(clang::ASTContext&);
 
+    // Warn about struct types passed between guest and host whose layout differs between the two
+    void CheckDataLayout(clang::ASTContext&);
+
     // Generate helper code for thunk libraries and write them to the output file
     void EmitOutput();
 
     const std::string& libfilename;
     std::string libname; // sanitized filename, usable as part of emitted function names
     const OutputFilenames& output_filenames;
+    const TypeLayouts* guest_layouts;
 
     std::vector<ThunkedFunction> thunks;
     std::vector<ThunkedAPIFunction> thunked_api;
     std::unordered_set<const clang::Type*> funcptr_types;
     std::optional<unsigned> lib_version;
     std::vector<NamespaceInfo> namespaces;
+    unsigned num_batchable = 0;
 };
 
-GenerateThunkLibsAction::GenerateThunkLibsAction(const std::string& libname_, const OutputFilenames& output_filenames_)
-    : libfilename(libname_), libname(libname_), output_filenames(output_filenames_) {
+GenerateThunkLibsAction::GenerateThunkLibsAction(const std::string& libname_, const OutputFilenames& output_filenames_, const TypeLayouts* guest_layouts_)
+    : libfilename(libname_), libname(libname_), output_filenames(output_filenames_), guest_layouts(guest_layouts_) {
     for (auto& c : libname) {
         if (c == '-') {
             c = '_';
@@ -333,6 +418,7 @@ void GenerateThunkLibsAction::ExecuteAction() {
 
     try {
         ParseInterface(context);
+        CheckDataLayout(context);
         EmitOutput();
     } catch (ClangDiagnosticAsException& exception) {
         exception.Report(context.getDiagnostics());
@@ -408,6 +494,13 @@ void GenerateThunkLibsAction::ParseInterface(clang::ASTContext& context) {
 
                 data.custom_host_impl = annotations.custom_host_impl;
 
+                if (annotations.returns_host_allocation) {
+                    if (!return_type->isPointerType() || return_type->isFunctionPointerType()) {
+                        throw report_error(decl->getBeginLoc(), "returns_host_allocation requires a data pointer return type");
+                    }
+                    data.returns_host_allocation = true;
+                }
+
                 for (std::size_t param_idx = 0; param_idx < emitted_function->param_size(); ++param_idx) {
                     auto* param = emitted_function->getParamDecl(param_idx);
                     data.param_types.push_back(param->getType());
@@ -470,6 +563,21 @@ void GenerateThunkLibsAction::ParseInterface(clang::ASTContext& context) {
                     data.custom_host_impl = true;
                 }
 
+                if (annotations.batchable) {
+                    // Deferred calls must not depend on guest memory staying unchanged or on their result
+                    if (!return_type->isVoidType() || data.is_variadic) {
+                        throw report_error(decl->getBeginLoc(), "batchable functions must return void and can't be variadic");
+                    }
+                    for (auto& type : data.param_types) {
+                        // Pointers to incomplete structs are opaque handles (e.g. Vulkan objects) that are never dereferenced through guest memory
+                        const bool is_opaque_handle = type->isPointerType() && type->getPointeeType()->isRecordType() && type->getPointeeType()->isIncompleteType();
+                        if (!type->isArithmeticType() && !type->isEnumeralType() && !is_opaque_handle) {
+                            throw report_error(decl->getBeginLoc(), "batchable functions may only take scalar or opaque handle parameters");
+                        }
+                    }
+                    data.batch_index = num_batchable++;
+                }
+
                 // For indirect calls, register the function signature as a function pointer type
                 if (namespace_info.indirect_guest_calls) {
                     funcptr_types.insert(context.getCanonicalType(emitted_function->getFunctionType()));
@@ -481,6 +589,69 @@ void GenerateThunkLibsAction::ParseInterface(clang::ASTContext& context) {
     }
 }
 
+/**
+ * Arguments are passed through as-is, so pointed-to structs must have the same layout on the guest and host.
+ *
+ * Types that match are fine to pass through directly. Mismatching ones are reported here at generation time,
+ * they need a custom_host_impl that converts them field by field.
+ */
+void GenerateThunkLibsAction::CheckDataLayout(clang::ASTContext& context) {
+    if (!guest_layouts) {
+        return;
+    }
+
+    auto warning_id = context.getDiagnostics().getCustomDiagID(clang::DiagnosticsEngine::Warning,
+                                                              "%0 has a different data layout on the guest (%1)");
+    std::unordered_set<const clang::RecordDecl*> checked;
+
+    // Checks the given type, structs embedded by value and the types they point to
+    std::function<void(clang::QualType, clang::SourceLocation)> check_type = [&](clang::QualType type, clang::SourceLocation loc) {
+        type = type.getCanonicalType();
+        while (type->isPointerType() || type->isArrayType()) {
+            type = type->isPointerType() ? type->getPointeeType() : clang::QualType { type->getArrayElementTypeNoTypeQual(), 0 };
+            type = type.getCanonicalType();
+        }
+
+        auto decl = type->getAsRecordDecl();
+        if (!decl || !decl->isCompleteDefinition() || !checked.insert(decl).second) {
+            return;
+        }
+
+        auto guest_layout = guest_layouts->find(GetLayoutKey(context, decl));
+        if (guest_layout == guest_layouts->end()) {
+            return;
+        }
+
+        auto host_layout = ComputeTypeLayout(context, decl);
+        if (host_layout != guest_layout->second) {
+            std::string reason;
+            if (host_layout.size_bits != guest_layout->second.size_bits) {
+                reason = fmt::format("size {} vs {} bytes on the host", guest_layout->second.size_bits / 8, host_layout.size_bits / 8);
+            } else if (host_layout.align_bits != guest_layout->second.align_bits) {
+                reason = fmt::format("alignment {} vs {} bytes on the host", guest_layout->second.align_bits / 8, host_layout.align_bits / 8);
+            } else {
+                auto mismatch = std::mismatch(host_layout.fields.begin(), host_layout.fields.end(),
+                                              guest_layout->second.fields.begin(), guest_layout->second.fields.end(),
+                                              [](auto& a, auto& b) { return a.name == b.name && a.offset_bits == b.offset_bits && a.size_bits == b.size_bits; });
+                reason = mismatch.first != host_layout.fields.end() ? "field " + mismatch.first->name : "fields";
+            }
+            context.getDiagnostics().Report(loc, warning_id) << type.getAsString() << reason;
+        }
+
+        for (const clang::FieldDecl* field : decl->fields()) {
+            check_type(field->getType(), loc);
+        }
+    };
+
+    for (auto& thunk : thunks) {
+        auto loc = thunk.decl->getBeginLoc();
+        check_type(thunk.return_type, loc);
+        for (auto& param_type : thunk.param_types) {
+            check_type(param_type, loc);
+        }
+    }
+}
+
 void GenerateThunkLibsAction::EmitOutput() {
     static auto format_decl = [](clang::QualType type, const std::string_view& name) {
         clang::QualType innermostPointee = type;
@@ -563,6 +734,10 @@ void GenerateThunkLibsAction::EmitOutput() {
             fmt::print( file, "MAKE_THUNK({}, {}, \"{:#02x}\")\n",
                         libname, function_name, fmt::join(sha256, ", "));
         }
+        if (num_batchable) {
+            fmt::print( file, "MAKE_THUNK({}, fexfn_batch_flush, \"{:#02x}\")\n",
+                        libname, fmt::join(get_sha256("fexfn_batch_flush"), ", "));
+        }
         file << "}\n";
 
         // Guest->Host transition points for invoking runtime host-function pointers based on their signature
@@ -615,8 +790,20 @@ void GenerateThunkLibsAction::EmitOutput() {
                     fmt::print(file, "AllocateHostTrampolineForGuestFunction(a_{});\n", idx);
                 }
             }
-            file << "  fexthunks_" << libname << "_" << function_name << "(&args);\n";
-            if (!is_void) {
+            if (data.batch_index) {
+                fmt::print(file, "  if (!QueueBatchedCall(fexthunks_{}_fexfn_batch_flush, {}, &args, sizeof(args))) {{\n", libname, *data.batch_index);
+                file << "    fexthunks_" << libname << "_" << function_name << "(&args);\n";
+                file << "  }\n";
+            } else {
+                if (num_batchable) {
+                    // Earlier deferred calls must reach the host first
+                    file << "  FlushBatchedCalls();\n";
+                }
+                file << "  fexthunks_" << libname << "_" << function_name << "(&args);\n";
+            }
+            if (data.returns_host_allocation) {
+                file << "  return AdoptHostAllocation(args.rv);\n";
+            } else if (!is_void) {
                 file << "  return args.rv;\n";
             }
             file << "}\n";
@@ -651,6 +838,16 @@ void GenerateThunkLibsAction::EmitOutput() {
                 }
             }
             file << "\n";
+
+            // Subset of the above that queues calls instead of transitioning to the host
+            file << "#define FOREACH_" << ns.name << (ns.name.empty() ? "" : "_") << "BATCHABLE_SYMBOL(EXPAND) \\\n";
+            for (auto& symbol : thunked_api) {
+                auto thunk = std::find_if(thunks.begin(), thunks.end(), [&](const ThunkedFunction& thunk) { return thunk.function_name == symbol.function_name; });
+                if (symbol.symtable_namespace.value_or(0) == namespace_idx && thunk != thunks.end() && thunk->batch_index) {
+                    file << "  EXPAND(" << symbol.function_name << ", \"TODO\") \\\n";
+                }
+            }
+            file << "\n";
         }
     }
 
@@ -751,6 +948,25 @@ void GenerateThunkLibsAction::EmitOutput() {
             file << ");\n";
             file << "}\n";
         }
+
+        if (num_batchable) {
+            // Unpacking functions of batchable thunks, indexed by ThunkedFunction::batch_index
+            file << "static void (*const fexfn_batch_unpackers_" << libname << "[])(void*) = {\n";
+            for (auto& thunk : thunks) {
+                if (thunk.batch_index) {
+                    file << "  (void(*)(void*))&fexfn_unpack_" << libname << "_" << thunk.function_name << ",\n";
+                }
+            }
+            file << "};\n";
+
+            file << "struct fexfn_packed_args_" << libname << "_fexfn_batch_flush {\n";
+            file << "  uint8_t* a_0;\n";
+            file << "  uint32_t a_1;\n";
+            file << "};\n";
+            file << "static void fexfn_unpack_" << libname << "_fexfn_batch_flush(fexfn_packed_args_" << libname << "_fexfn_batch_flush* args) {\n";
+            file << "  UnpackBatchedCalls(args->a_0, args->a_1, fexfn_batch_unpackers_" << libname << ");\n";
+            file << "}\n";
+        }
         file << "}\n";
 
         // Endpoints for Guest->Host invocation of API functions
@@ -761,6 +977,10 @@ void GenerateThunkLibsAction::EmitOutput() {
             fmt::print( file, "  {{(uint8_t*)\"\\x{:02x}\", (void(*)(void *))&fexfn_unpack_{}_{}}}, // {}:{}\n",
                         fmt::join(sha256, "\\x"), libname, function_name, libname, function_name);
         }
+        if (num_batchable) {
+            fmt::print( file, "  {{(uint8_t*)\"\\x{:02x}\", (void(*)(void *))&fexfn_unpack_{}_fexfn_batch_flush}}, // {}:fexfn_batch_flush\n",
+                        fmt::join(get_sha256("fexfn_batch_flush"), "\\x"), libname, libname);
+        }
 
         // Endpoints for Guest->Host invocation of runtime host-function pointers
         for (auto& type : funcptr_types) {
@@ -802,5 +1022,9 @@ std::unique_ptr<clang::ASTConsumer> GenerateThunkLibsAction::CreateASTConsumer(c
 }
 
 std::unique_ptr<clang::FrontendAction> GenerateThunkLibsActionFactory::create() {
-    return std::make_unique<GenerateThunkLibsAction>(libname, output_filenames);
+    return std::make_unique<GenerateThunkLibsAction>(libname, output_filenames, guest_layouts);
+}
+
+std::unique_ptr<clang::FrontendAction> AnalyzeDataLayoutActionFactory::create() {
+    return std::make_unique<AnalyzeDataLayoutAction>(layouts);
 }
@@ -1,17 +1,56 @@
 #include <clang/Tooling/Tooling.h>
 
+#include <cstdint>
 #include <optional>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 struct OutputFilenames {
     std::string host;
     std::string guest;
 };
 
+/**
+ * Memory layout of a struct type as seen by one target ABI
+ */
+struct TypeLayout {
+    struct Field {
+        std::string name;
+        uint64_t offset_bits;
+        uint64_t size_bits;
+    };
+
+    uint64_t size_bits;
+    uint64_t align_bits;
+    std::vector<Field> fields;
+
+    bool operator==(const TypeLayout&) const = default;
+};
+
+// Struct layouts keyed by canonical type name
+using TypeLayouts = std::unordered_map<std::string, TypeLayout>;
+
+/**
+ * Records the layout of every struct type in the interface as seen by the target it's compiled for.
+ *
+ * Run with the guest target before generating host code so the generator can check the types passed between the two.
+ */
+class AnalyzeDataLayoutActionFactory : public clang::tooling::FrontendActionFactory {
+public:
+    AnalyzeDataLayoutActionFactory(TypeLayouts& layouts_) : layouts(layouts_) {
+    }
+
+    std::unique_ptr<clang::FrontendAction> create() override;
+
+private:
+    TypeLayouts& layouts;
+};
+
 class GenerateThunkLibsActionFactory : public clang::tooling::FrontendActionFactory {
 public:
-    GenerateThunkLibsActionFactory(std::string_view libname_, OutputFilenames output_filenames_)
-        : libname(std::move(libname_)), output_filenames(std::move(output_filenames_)) {
+    GenerateThunkLibsActionFactory(std::string_view libname_, OutputFilenames output_filenames_, const TypeLayouts* guest_layouts_ = nullptr)
+        : libname(std::move(libname_)), output_filenames(std::move(output_filenames_)), guest_layouts(guest_layouts_) {
     }
 
     std::unique_ptr<clang::FrontendAction> create() override;
@@ -19,4 +58,5 @@ public:
 private:
     std::string libname;
     OutputFilenames output_filenames;
+    const TypeLayouts* guest_layouts;
 };
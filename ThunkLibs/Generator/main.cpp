@@ -1,9 +1,12 @@
+#include "clang/Basic/Diagnostic.h"
 #include "clang/Tooling/Tooling.h"
+#include "clang/Tooling/ArgumentsAdjusters.h"
 #include "clang/Tooling/CompilationDatabase.h"
 
 #include "llvm/Support/Signals.h"
 
 #include <iostream>
+#include <optional>
 #include <string>
 
 #include "interface.h"
@@ -53,14 +56,35 @@ int main(int argc, char* argv[]) {
         return EXIT_FAILURE;
     }
 
+    auto set_resource_directory = [](const clang::tooling::CommandLineArguments &Args, clang::StringRef) {
+        clang::tooling::CommandLineArguments AdjustedArgs = Args;
+        AdjustedArgs.push_back(std::string { "-resource-dir=" } + CLANG_RESOURCE_DIR);
+        return AdjustedArgs;
+    };
+
+    // Host code generation checks the interface's types against their layout on the x86-64 guest
+    std::optional<TypeLayouts> guest_layouts;
+    if (!output_filenames.host.empty()) {
+        ClangTool GuestTool(*compile_db, { filename });
+        if (CLANG_RESOURCE_DIR[0] != 0) {
+            GuestTool.appendArgumentsAdjuster(set_resource_directory);
+        }
+        GuestTool.appendArgumentsAdjuster(getInsertArgumentAdjuster("--target=x86_64-linux-gnu", ArgumentInsertPosition::END));
+        // Failures are expected without x86-64 system headers, don't report them
+        clang::IgnoringDiagConsumer ignore_diagnostics;
+        GuestTool.setDiagnosticConsumer(&ignore_diagnostics);
+
+        guest_layouts.emplace();
+        if (GuestTool.run(std::make_unique<AnalyzeDataLayoutActionFactory>(*guest_layouts).get()) != 0) {
+            // Guest headers may not be available for the analysis, generate without the check
+            guest_layouts.reset();
+        }
+    }
+
     ClangTool Tool(*compile_db, { filename });
     if (CLANG_RESOURCE_DIR[0] != 0) {
-        auto set_resource_directory = [](const clang::tooling::CommandLineArguments &Args, clang::StringRef) {
-            clang::tooling::CommandLineArguments AdjustedArgs = Args;
-            AdjustedArgs.push_back(std::string { "-resource-dir=" } + CLANG_RESOURCE_DIR);
-            return AdjustedArgs;
-        };
         Tool.appendArgumentsAdjuster(set_resource_directory);
     }
-    return Tool.run(std::make_unique<GenerateThunkLibsActionFactory>(std::move(libname), std::move(output_filenames)).get());
+    return Tool.run(std::make_unique<GenerateThunkLibsActionFactory>(std::move(libname), std::move(output_filenames),
+                                                                     guest_layouts ? &*guest_layouts : nullptr).get());
 }
@@ -2,6 +2,10 @@ namespace fexgen {
 struct returns_guest_pointer {};
 struct custom_host_impl {};
 struct custom_guest_entrypoint {};
+// Void function with only scalar or opaque handle parameters that may be deferred until the next non-batched call
+struct batchable {};
+// Returned pointer is allocated on the host heap and released by the guest with free()
+struct returns_host_allocation {};
 
 struct generate_guest_symtable {};
 struct indirect_guest_calls {};
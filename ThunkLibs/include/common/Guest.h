@@ -1,5 +1,8 @@
 #pragma once
+#include <pthread.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 #include <type_traits>
 
 #include "PackedArguments.h"
@@ -59,8 +62,11 @@ struct LoadlibArgs {
 MAKE_THUNK(fex, loadlib, "0x27, 0x7e, 0xb7, 0x69, 0x5b, 0xe9, 0xab, 0x12, 0x6e, 0xf7, 0x85, 0x9d, 0x4b, 0xc9, 0xa2, 0x44, 0x46, 0xcf, 0xbd, 0xb5, 0x87, 0x43, 0xef, 0x28, 0xa2, 0x65, 0xba, 0xfc, 0x89, 0x0f, 0x77, 0x80")
 MAKE_THUNK(fex, is_lib_loaded, "0xee, 0x57, 0xba, 0x0c, 0x5f, 0x6e, 0xef, 0x2a, 0x8c, 0xb5, 0x19, 0x81, 0xc9, 0x23, 0xe6, 0x51, 0xae, 0x65, 0x02, 0x8f, 0x2b, 0x5d, 0x59, 0x90, 0x6a, 0x7e, 0xe2, 0xe7, 0x1c, 0x33, 0x8a, 0xff")
 MAKE_THUNK(fex, is_host_heap_allocation, "0xf5, 0x77, 0x68, 0x43, 0xbb, 0x6b, 0x28, 0x18, 0x40, 0xb0, 0xdb, 0x8a, 0x66, 0xfb, 0x0e, 0x2d, 0x98, 0xc2, 0xad, 0xe2, 0x5a, 0x18, 0x5a, 0x37, 0x2e, 0x13, 0xc9, 0xe7, 0xb9, 0x8c, 0xa9, 0x3e")
+MAKE_THUNK(fex, free_host_allocation, "0x98, 0x4c, 0xa6, 0xe5, 0x6f, 0x61, 0x31, 0xbc, 0x18, 0x96, 0xf0, 0xea, 0xed, 0x12, 0xf1, 0x7a, 0x19, 0x6d, 0xa3, 0x46, 0xce, 0xf3, 0x2f, 0xd7, 0xe6, 0xa5, 0xb9, 0x70, 0xb4, 0xd1, 0xb6, 0xe5")
+MAKE_THUNK(fex, host_allocation_size, "0x53, 0x0a, 0x53, 0x1b, 0x96, 0xc2, 0x77, 0x97, 0x3e, 0x76, 0xe3, 0xd8, 0x98, 0x8a, 0x37, 0x48, 0x10, 0xf9, 0x2f, 0x40, 0x71, 0xa7, 0x56, 0xb1, 0x0d, 0x1a, 0x88, 0x98, 0xd9, 0x72, 0xd5, 0x82")
 MAKE_THUNK(fex, link_address_to_function, "0xe6, 0xa8, 0xec, 0x1c, 0x7b, 0x74, 0x35, 0x27, 0xe9, 0x4f, 0x5b, 0x6e, 0x2d, 0xc9, 0xa0, 0x27, 0xd6, 0x1f, 0x2b, 0x87, 0x8f, 0x2d, 0x35, 0x50, 0xea, 0x16, 0xb8, 0xc4, 0x5e, 0x42, 0xfd, 0x77")
 MAKE_THUNK(fex, allocate_host_trampoline_for_guest_function, "0x9b, 0xb2, 0xf4, 0xb4, 0x83, 0x7d, 0x28, 0x93, 0x40, 0xcb, 0xf4, 0x7a, 0x0b, 0x47, 0x85, 0x87, 0xf9, 0xbc, 0xb5, 0x27, 0xca, 0xa6, 0x93, 0xa5, 0xc0, 0x73, 0x27, 0x24, 0xae, 0xc8, 0xb8, 0x5a")
+MAKE_THUNK(fex, callback_worker, "0xa3, 0x3c, 0xb9, 0x48, 0x89, 0x7e, 0x94, 0x23, 0x5a, 0x60, 0xe5, 0x51, 0xe9, 0x4c, 0xb9, 0xf0, 0xf0, 0x6c, 0x86, 0xae, 0xda, 0x8d, 0x62, 0xc1, 0x35, 0x85, 0xfd, 0x37, 0xa0, 0x72, 0x61, 0x5c")
 
 #define LOAD_LIB_BASE(name, init_fn) \
   __attribute__((constructor)) static void loadlib() \
@@ -82,6 +88,31 @@ inline void LinkAddressToFunction(uintptr_t addr, uintptr_t target) {
     fexthunks_fex_link_address_to_function(&args);
 }
 
+// Parks Count guest threads in FEX to run guest callbacks that host libraries make from their own threads.
+// Those threads don't have any guest state, without workers such a callback is fatal.
+// Only the first call in each library creates threads.
+inline void StartCallbackWorkers(unsigned Count) {
+  static bool Started = false;
+  if (Started) {
+    return;
+  }
+  Started = true;
+
+  pthread_attr_t Attr;
+  pthread_attr_init(&Attr);
+  pthread_attr_setdetachstate(&Attr, PTHREAD_CREATE_DETACHED);
+  for (unsigned i = 0; i < Count; ++i) {
+    pthread_t Worker;
+    if (pthread_create(&Worker, &Attr, [](void*) -> void* {
+          fexthunks_fex_callback_worker(nullptr);
+          return nullptr;
+        }, nullptr) == 0) {
+      pthread_setname_np(Worker, "FEX:callbacks");
+    }
+  }
+  pthread_attr_destroy(&Attr);
+}
+
 inline bool IsLibLoaded(const char *libname) {
   struct {
     const char *Name;
@@ -93,6 +124,76 @@ inline bool IsLibLoaded(const char *libname) {
   return argsrv.rv;
 }
 
+// Same calling convention as every other thunk
+using BatchFlushThunk = decltype(&fexthunks_fex_loadlib);
+
+// Per-thread buffer of calls to fexgen::batchable functions.
+// The calls are sent to the host in one transition before the next non-batched call of the library.
+struct BatchBuffer {
+  static constexpr uint32_t Capacity = 16384;
+
+  uint8_t *Data;
+  uint32_t Size;
+  // Set while the host runs the batch, calls from guest callbacks then go straight through
+  bool Flushing;
+  BatchFlushThunk FlushThunk;
+
+  ~BatchBuffer();
+};
+
+[[gnu::visibility("hidden")]] inline thread_local BatchBuffer fexthunks_batch {};
+
+inline void FlushBatchedCalls() {
+  auto &Batch = fexthunks_batch;
+  if (Batch.Size == 0 || Batch.Flushing) {
+    return;
+  }
+
+  struct {
+    uint8_t *Data;
+    uint32_t Size;
+  } args = { Batch.Data, Batch.Size };
+
+  Batch.Flushing = true;
+  Batch.FlushThunk(&args);
+  Batch.Flushing = false;
+  Batch.Size = 0;
+}
+
+inline BatchBuffer::~BatchBuffer() {
+  // Calls queued right before the thread exits still need to happen
+  FlushBatchedCalls();
+  free(Data);
+}
+
+// Returns false if the call must be made directly instead
+inline bool QueueBatchedCall(BatchFlushThunk FlushThunk, uint32_t Index, const void *Args, uint32_t ArgsSize) {
+  auto &Batch = fexthunks_batch;
+  if (Batch.Flushing) {
+    return false;
+  }
+
+  if (!Batch.Data) {
+    Batch.Data = static_cast<uint8_t*>(aligned_alloc(16, BatchBuffer::Capacity));
+    if (!Batch.Data) {
+      return false;
+    }
+  }
+
+  const uint32_t EntrySize = (sizeof(BatchedCallHeader) + ArgsSize + 15) & ~15U;
+  if (Batch.Size + EntrySize > BatchBuffer::Capacity) {
+    FlushBatchedCalls();
+  }
+
+  Batch.FlushThunk = FlushThunk;
+  auto Header = reinterpret_cast<BatchedCallHeader*>(&Batch.Data[Batch.Size]);
+  Header->Index = Index;
+  Header->Size = EntrySize;
+  memcpy(Header + 1, Args, ArgsSize);
+  Batch.Size += EntrySize;
+  return true;
+}
+
 // Helper template that packs the given arguments and invokes a thunk at the
 // address stored in the `r11` guest register. The signature of the thunk must
 // be specified at compile-time via the Thunk template parameter.
@@ -139,6 +240,8 @@ inline Result CallHostFunction(Args... args) {
     // Return value not explicitly initialized since an initializer would fail to compile for the void case
   };
 
+  // Host function pointers must observe earlier batched calls of this library
+  FlushBatchedCalls();
   Thunk(reinterpret_cast<void*>(&packed_args));
 
   if constexpr (!std::is_void_v<Result>) {
@@ -210,3 +313,49 @@ inline bool IsHostHeapAllocation(void* ptr) {
     fexthunks_fex_is_host_heap_allocation(&args);
     return args.rv;
 }
+
+inline void FreeHostAllocation(void* ptr) {
+    struct {
+        void* ptr;
+    } args = { ptr };
+
+    fexthunks_fex_free_host_allocation(&args);
+}
+
+inline size_t HostAllocationSize(void* ptr) {
+    struct {
+        void* ptr;
+        size_t rv;
+    } args = { ptr, {} };
+
+    fexthunks_fex_host_allocation_size(&args);
+    return args.rv;
+}
+
+// True if the guest malloc is backed by the host heap (e.g. through libfex_malloc),
+// in which case host allocations can be handed to the guest as-is
+inline bool GuestHeapIsHostHeap() {
+    static const bool Shared = [] {
+        void* Probe = malloc(1);
+        bool Result = IsHostHeapAllocation(Probe);
+        free(Probe);
+        return Result;
+    }();
+    return Shared;
+}
+
+// Transfers ownership of a host heap allocation to the guest, which releases it with its own free.
+// Only copies if the guest and host heaps are separate.
+template<typename T>
+inline T* AdoptHostAllocation(T* ptr) {
+    if (!ptr || GuestHeapIsHostHeap()) {
+        return ptr;
+    }
+
+    // The original size is unknown so this is a bit wasteful, but always covers it
+    const size_t Usable = HostAllocationSize(ptr);
+    void* NewPtr = malloc(Usable);
+    memcpy(NewPtr, ptr, Usable);
+    FreeHostAllocation((void*)ptr);
+    return static_cast<T*>(NewPtr);
+}
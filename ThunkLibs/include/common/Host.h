@@ -46,6 +46,15 @@ fexfn_type_erased_unpack(void* argsv) {
 
 struct ExportEntry { uint8_t* sha256; void(*fn)(void *); };
 
+// Runs a batch of deferred guest calls in the order they were made
+inline void UnpackBatchedCalls(uint8_t *Data, uint32_t Size, void (*const *Unpackers)(void*)) {
+  for (uint32_t Offset = 0; Offset < Size;) {
+    auto Header = reinterpret_cast<BatchedCallHeader*>(&Data[Offset]);
+    Unpackers[Header->Index](Header + 1);
+    Offset += Header->Size;
+  }
+}
+
 typedef void fex_call_callback_t(uintptr_t callback, void *arg0, void* arg1);
 
 /**
@@ -3,6 +3,16 @@
 #include <cstdint>
 #include <type_traits>
 
+// Entry of a guest-side batch of deferred thunk calls, followed by the packed arguments of the call
+struct BatchedCallHeader {
+  // Index in to the host library's batchable function table
+  uint32_t Index;
+  // Size of this entry including the header, keeps the next entry 16 byte aligned
+  uint32_t Size;
+  uint64_t Pad;
+};
+static_assert(sizeof(BatchedCallHeader) == 16);
+
 template<typename Result, typename... Args>
 struct PackedArguments;
 
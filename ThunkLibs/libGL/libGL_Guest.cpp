@@ -19,6 +19,8 @@ $end_info$
 #include <stdio.h>
 #include <cstdlib>
 #include <functional>
+#include <mutex>
+#include <string>
 #include <string_view>
 #include <unordered_map>
 
@@ -35,20 +37,38 @@ const std::unordered_map<std::string_view, uintptr_t /* guest function address *
 #define PAIR(name, unused) Ret[#name] = reinterpret_cast<uintptr_t>(GetCallerForHostFunction(name));
         std::unordered_map<std::string_view, uintptr_t> Ret;
         FOREACH_internal_SYMBOL(PAIR);
-        return Ret;
 #undef PAIR
+
+        // Batchable functions queue through their packing function instead, so the
+        // pointers applications get from glXGetProcAddress are batched as well
+#define PAIR(name, unused) Ret[#name] = reinterpret_cast<uintptr_t>(fexfn_pack_##name);
+        FOREACH_internal_BATCHABLE_SYMBOL(PAIR);
+#undef PAIR
+        return Ret;
     });
 
+// Results of earlier glXGetProcAddress calls.
+// Loaders resolve every entry point again for each context they create, the host
+// pointers don't change between contexts so they are only looked up and linked once.
+static std::mutex ResolvedProcsMutex;
+static std::unordered_map<std::string, voidFunc*> ResolvedProcs;
+
 extern "C" {
   voidFunc *glXGetProcAddress(const GLubyte *procname) {
+    std::string_view procname_s { reinterpret_cast<const char*>(procname) };
+
+    std::lock_guard lk(ResolvedProcsMutex);
+    if (auto it = ResolvedProcs.find(std::string { procname_s }); it != ResolvedProcs.end()) {
+      return it->second;
+    }
+
     auto Ret = fexfn_pack_glXGetProcAddress(procname);
     if (!Ret) {
       return nullptr;
     }
 
-    auto TargetFuncIt = HostPtrInvokers.find(reinterpret_cast<const char*>(procname));
+    auto TargetFuncIt = HostPtrInvokers.find(procname_s);
     if (TargetFuncIt == HostPtrInvokers.end()) {
-      std::string_view procname_s { reinterpret_cast<const char*>(procname) };
       // If glXGetProcAddress is querying itself, then we can just return itself.
       // Some games do this for unknown reasons.
       if (procname_s == "glXGetProcAddress" ||
@@ -66,6 +86,7 @@ extern "C" {
     }
 
     LinkAddressToFunction((uintptr_t)Ret, TargetFuncIt->second);
+    ResolvedProcs.emplace(procname_s, Ret);
     return Ret;
   }
 
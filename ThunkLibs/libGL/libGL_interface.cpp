@@ -360,7 +360,7 @@ template<> struct fex_gen_config<glBeginConditionalRender> {};
 template<> struct fex_gen_config<glBeginConditionalRenderNV> {};
 template<> struct fex_gen_config<glBeginConditionalRenderNVX> {};
 template<> struct fex_gen_config<glBeginFragmentShaderATI> {};
-template<> struct fex_gen_config<glBegin> {};
+template<> struct fex_gen_config<glBegin> : fexgen::batchable {};
 template<> struct fex_gen_config<glBeginOcclusionQueryNV> {};
 template<> struct fex_gen_config<glBeginPerfMonitorAMD> {};
 template<> struct fex_gen_config<glBeginPerfQueryINTEL> {};
@@ -518,7 +518,7 @@ template<> struct fex_gen_config<glColor3b> {};
 template<> struct fex_gen_config<glColor3bv> {};
 template<> struct fex_gen_config<glColor3d> {};
 template<> struct fex_gen_config<glColor3dv> {};
-template<> struct fex_gen_config<glColor3f> {};
+template<> struct fex_gen_config<glColor3f> : fexgen::batchable {};
 template<> struct fex_gen_config<glColor3fv> {};
 template<> struct fex_gen_config<glColor3fVertex3fSUN> {};
 template<> struct fex_gen_config<glColor3fVertex3fvSUN> {};
@@ -528,7 +528,7 @@ template<> struct fex_gen_config<glColor3i> {};
 template<> struct fex_gen_config<glColor3iv> {};
 template<> struct fex_gen_config<glColor3s> {};
 template<> struct fex_gen_config<glColor3sv> {};
-template<> struct fex_gen_config<glColor3ub> {};
+template<> struct fex_gen_config<glColor3ub> : fexgen::batchable {};
 template<> struct fex_gen_config<glColor3ubv> {};
 template<> struct fex_gen_config<glColor3ui> {};
 template<> struct fex_gen_config<glColor3uiv> {};
@@ -540,7 +540,7 @@ template<> struct fex_gen_config<glColor4b> {};
 template<> struct fex_gen_config<glColor4bv> {};
 template<> struct fex_gen_config<glColor4d> {};
 template<> struct fex_gen_config<glColor4dv> {};
-template<> struct fex_gen_config<glColor4f> {};
+template<> struct fex_gen_config<glColor4f> : fexgen::batchable {};
 template<> struct fex_gen_config<glColor4fNormal3fVertex3fSUN> {};
 template<> struct fex_gen_config<glColor4fNormal3fVertex3fvSUN> {};
 template<> struct fex_gen_config<glColor4fv> {};
@@ -550,7 +550,7 @@ template<> struct fex_gen_config<glColor4i> {};
 template<> struct fex_gen_config<glColor4iv> {};
 template<> struct fex_gen_config<glColor4s> {};
 template<> struct fex_gen_config<glColor4sv> {};
-template<> struct fex_gen_config<glColor4ub> {};
+template<> struct fex_gen_config<glColor4ub> : fexgen::batchable {};
 template<> struct fex_gen_config<glColor4ubv> {};
 template<> struct fex_gen_config<glColor4ubVertex2fSUN> {};
 template<> struct fex_gen_config<glColor4ubVertex2fvSUN> {};
@@ -848,7 +848,7 @@ template<> struct fex_gen_config<glEnableVertexArrayEXT> {};
 template<> struct fex_gen_config<glEnableVertexAttribAPPLE> {};
 template<> struct fex_gen_config<glEnableVertexAttribArrayARB> {};
 template<> struct fex_gen_config<glEnableVertexAttribArray> {};
-template<> struct fex_gen_config<glEnd> {};
+template<> struct fex_gen_config<glEnd> : fexgen::batchable {};
 template<> struct fex_gen_config<glEndConditionalRender> {};
 template<> struct fex_gen_config<glEndConditionalRenderNV> {};
 template<> struct fex_gen_config<glEndConditionalRenderNVX> {};
@@ -1783,7 +1783,7 @@ template<> struct fex_gen_config<glNormal3b> {};
 template<> struct fex_gen_config<glNormal3bv> {};
 template<> struct fex_gen_config<glNormal3d> {};
 template<> struct fex_gen_config<glNormal3dv> {};
-template<> struct fex_gen_config<glNormal3f> {};
+template<> struct fex_gen_config<glNormal3f> : fexgen::batchable {};
 template<> struct fex_gen_config<glNormal3fv> {};
 template<> struct fex_gen_config<glNormal3fVertex3fSUN> {};
 template<> struct fex_gen_config<glNormal3fVertex3fvSUN> {};
@@ -2332,7 +2332,7 @@ template<> struct fex_gen_config<glTexCoord2fColor4fNormal3fVertex3fSUN> {};
 template<> struct fex_gen_config<glTexCoord2fColor4fNormal3fVertex3fvSUN> {};
 template<> struct fex_gen_config<glTexCoord2fColor4ubVertex3fSUN> {};
 template<> struct fex_gen_config<glTexCoord2fColor4ubVertex3fvSUN> {};
-template<> struct fex_gen_config<glTexCoord2f> {};
+template<> struct fex_gen_config<glTexCoord2f> : fexgen::batchable {};
 template<> struct fex_gen_config<glTexCoord2fNormal3fVertex3fSUN> {};
 template<> struct fex_gen_config<glTexCoord2fNormal3fVertex3fvSUN> {};
 template<> struct fex_gen_config<glTexCoord2fv> {};
@@ -2508,7 +2508,7 @@ template<> struct fex_gen_config<glTranslatexOES> {};
 template<> struct fex_gen_config<glUniform1d> {};
 template<> struct fex_gen_config<glUniform1dv> {};
 template<> struct fex_gen_config<glUniform1fARB> {};
-template<> struct fex_gen_config<glUniform1f> {};
+template<> struct fex_gen_config<glUniform1f> : fexgen::batchable {};
 template<> struct fex_gen_config<glUniform1fvARB> {};
 template<> struct fex_gen_config<glUniform1fv> {};
 template<> struct fex_gen_config<glUniform1i64ARB> {};
@@ -2516,7 +2516,7 @@ template<> struct fex_gen_config<glUniform1i64NV> {};
 template<> struct fex_gen_config<glUniform1i64vARB> {};
 template<> struct fex_gen_config<glUniform1i64vNV> {};
 template<> struct fex_gen_config<glUniform1iARB> {};
-template<> struct fex_gen_config<glUniform1i> {};
+template<> struct fex_gen_config<glUniform1i> : fexgen::batchable {};
 template<> struct fex_gen_config<glUniform1ivARB> {};
 template<> struct fex_gen_config<glUniform1iv> {};
 template<> struct fex_gen_config<glUniform1ui64ARB> {};
@@ -2530,7 +2530,7 @@ template<> struct fex_gen_config<glUniform1uiv> {};
 template<> struct fex_gen_config<glUniform2d> {};
 template<> struct fex_gen_config<glUniform2dv> {};
 template<> struct fex_gen_config<glUniform2fARB> {};
-template<> struct fex_gen_config<glUniform2f> {};
+template<> struct fex_gen_config<glUniform2f> : fexgen::batchable {};
 template<> struct fex_gen_config<glUniform2fvARB> {};
 template<> struct fex_gen_config<glUniform2fv> {};
 template<> struct fex_gen_config<glUniform2i64ARB> {};
@@ -2538,7 +2538,7 @@ template<> struct fex_gen_config<glUniform2i64NV> {};
 template<> struct fex_gen_config<glUniform2i64vARB> {};
 template<> struct fex_gen_config<glUniform2i64vNV> {};
 template<> struct fex_gen_config<glUniform2iARB> {};
-template<> struct fex_gen_config<glUniform2i> {};
+template<> struct fex_gen_config<glUniform2i> : fexgen::batchable {};
 template<> struct fex_gen_config<glUniform2ivARB> {};
 template<> struct fex_gen_config<glUniform2iv> {};
 template<> struct fex_gen_config<glUniform2ui64ARB> {};
@@ -2552,7 +2552,7 @@ template<> struct fex_gen_config<glUniform2uiv> {};
 template<> struct fex_gen_config<glUniform3d> {};
 template<> struct fex_gen_config<glUniform3dv> {};
 template<> struct fex_gen_config<glUniform3fARB> {};
-template<> struct fex_gen_config<glUniform3f> {};
+template<> struct fex_gen_config<glUniform3f> : fexgen::batchable {};
 template<> struct fex_gen_config<glUniform3fvARB> {};
 template<> struct fex_gen_config<glUniform3fv> {};
 template<> struct fex_gen_config<glUniform3i64ARB> {};
@@ -2560,7 +2560,7 @@ template<> struct fex_gen_config<glUniform3i64NV> {};
 template<> struct fex_gen_config<glUniform3i64vARB> {};
 template<> struct fex_gen_config<glUniform3i64vNV> {};
 template<> struct fex_gen_config<glUniform3iARB> {};
-template<> struct fex_gen_config<glUniform3i> {};
+template<> struct fex_gen_config<glUniform3i> : fexgen::batchable {};
 template<> struct fex_gen_config<glUniform3ivARB> {};
 template<> struct fex_gen_config<glUniform3iv> {};
 template<> struct fex_gen_config<glUniform3ui64ARB> {};
@@ -2574,7 +2574,7 @@ template<> struct fex_gen_config<glUniform3uiv> {};
 template<> struct fex_gen_config<glUniform4d> {};
 template<> struct fex_gen_config<glUniform4dv> {};
 template<> struct fex_gen_config<glUniform4fARB> {};
-template<> struct fex_gen_config<glUniform4f> {};
+template<> struct fex_gen_config<glUniform4f> : fexgen::batchable {};
 template<> struct fex_gen_config<glUniform4fvARB> {};
 template<> struct fex_gen_config<glUniform4fv> {};
 template<> struct fex_gen_config<glUniform4i64ARB> {};
@@ -2582,7 +2582,7 @@ template<> struct fex_gen_config<glUniform4i64NV> {};
 template<> struct fex_gen_config<glUniform4i64vARB> {};
 template<> struct fex_gen_config<glUniform4i64vNV> {};
 template<> struct fex_gen_config<glUniform4iARB> {};
-template<> struct fex_gen_config<glUniform4i> {};
+template<> struct fex_gen_config<glUniform4i> : fexgen::batchable {};
 template<> struct fex_gen_config<glUniform4ivARB> {};
 template<> struct fex_gen_config<glUniform4iv> {};
 template<> struct fex_gen_config<glUniform4ui64ARB> {};
@@ -2656,11 +2656,11 @@ template<> struct fex_gen_config<glVertex2bOES> {};
 template<> struct fex_gen_config<glVertex2bvOES> {};
 template<> struct fex_gen_config<glVertex2d> {};
 template<> struct fex_gen_config<glVertex2dv> {};
-template<> struct fex_gen_config<glVertex2f> {};
+template<> struct fex_gen_config<glVertex2f> : fexgen::batchable {};
 template<> struct fex_gen_config<glVertex2fv> {};
 template<> struct fex_gen_config<glVertex2hNV> {};
 template<> struct fex_gen_config<glVertex2hvNV> {};
-template<> struct fex_gen_config<glVertex2i> {};
+template<> struct fex_gen_config<glVertex2i> : fexgen::batchable {};
 template<> struct fex_gen_config<glVertex2iv> {};
 template<> struct fex_gen_config<glVertex2s> {};
 template<> struct fex_gen_config<glVertex2sv> {};
@@ -2670,11 +2670,11 @@ template<> struct fex_gen_config<glVertex3bOES> {};
 template<> struct fex_gen_config<glVertex3bvOES> {};
 template<> struct fex_gen_config<glVertex3d> {};
 template<> struct fex_gen_config<glVertex3dv> {};
-template<> struct fex_gen_config<glVertex3f> {};
+template<> struct fex_gen_config<glVertex3f> : fexgen::batchable {};
 template<> struct fex_gen_config<glVertex3fv> {};
 template<> struct fex_gen_config<glVertex3hNV> {};
 template<> struct fex_gen_config<glVertex3hvNV> {};
-template<> struct fex_gen_config<glVertex3i> {};
+template<> struct fex_gen_config<glVertex3i> : fexgen::batchable {};
 template<> struct fex_gen_config<glVertex3iv> {};
 template<> struct fex_gen_config<glVertex3s> {};
 template<> struct fex_gen_config<glVertex3sv> {};
@@ -2684,11 +2684,11 @@ template<> struct fex_gen_config<glVertex4bOES> {};
 template<> struct fex_gen_config<glVertex4bvOES> {};
 template<> struct fex_gen_config<glVertex4d> {};
 template<> struct fex_gen_config<glVertex4dv> {};
-template<> struct fex_gen_config<glVertex4f> {};
+template<> struct fex_gen_config<glVertex4f> : fexgen::batchable {};
 template<> struct fex_gen_config<glVertex4fv> {};
 template<> struct fex_gen_config<glVertex4hNV> {};
 template<> struct fex_gen_config<glVertex4hvNV> {};
-template<> struct fex_gen_config<glVertex4i> {};
+template<> struct fex_gen_config<glVertex4i> : fexgen::batchable {};
 template<> struct fex_gen_config<glVertex4iv> {};
 template<> struct fex_gen_config<glVertex4s> {};
 template<> struct fex_gen_config<glVertex4sv> {};
@@ -2731,7 +2731,7 @@ template<> struct fex_gen_config<glVertexAttrib1dvARB> {};
 template<> struct fex_gen_config<glVertexAttrib1dv> {};
 template<> struct fex_gen_config<glVertexAttrib1dvNV> {};
 template<> struct fex_gen_config<glVertexAttrib1fARB> {};
-template<> struct fex_gen_config<glVertexAttrib1f> {};
+template<> struct fex_gen_config<glVertexAttrib1f> : fexgen::batchable {};
 template<> struct fex_gen_config<glVertexAttrib1fNV> {};
 template<> struct fex_gen_config<glVertexAttrib1fvARB> {};
 template<> struct fex_gen_config<glVertexAttrib1fv> {};
@@ -2751,7 +2751,7 @@ template<> struct fex_gen_config<glVertexAttrib2dvARB> {};
 template<> struct fex_gen_config<glVertexAttrib2dv> {};
 template<> struct fex_gen_config<glVertexAttrib2dvNV> {};
 template<> struct fex_gen_config<glVertexAttrib2fARB> {};
-template<> struct fex_gen_config<glVertexAttrib2f> {};
+template<> struct fex_gen_config<glVertexAttrib2f> : fexgen::batchable {};
 template<> struct fex_gen_config<glVertexAttrib2fNV> {};
 template<> struct fex_gen_config<glVertexAttrib2fvARB> {};
 template<> struct fex_gen_config<glVertexAttrib2fv> {};
@@ -2771,7 +2771,7 @@ template<> struct fex_gen_config<glVertexAttrib3dvARB> {};
 template<> struct fex_gen_config<glVertexAttrib3dv> {};
 template<> struct fex_gen_config<glVertexAttrib3dvNV> {};
 template<> struct fex_gen_config<glVertexAttrib3fARB> {};
-template<> struct fex_gen_config<glVertexAttrib3f> {};
+template<> struct fex_gen_config<glVertexAttrib3f> : fexgen::batchable {};
 template<> struct fex_gen_config<glVertexAttrib3fNV> {};
 template<> struct fex_gen_config<glVertexAttrib3fvARB> {};
 template<> struct fex_gen_config<glVertexAttrib3fv> {};
@@ -2793,7 +2793,7 @@ template<> struct fex_gen_config<glVertexAttrib4dvARB> {};
 template<> struct fex_gen_config<glVertexAttrib4dv> {};
 template<> struct fex_gen_config<glVertexAttrib4dvNV> {};
 template<> struct fex_gen_config<glVertexAttrib4fARB> {};
-template<> struct fex_gen_config<glVertexAttrib4f> {};
+template<> struct fex_gen_config<glVertexAttrib4f> : fexgen::batchable {};
 template<> struct fex_gen_config<glVertexAttrib4fNV> {};
 template<> struct fex_gen_config<glVertexAttrib4fvARB> {};
 template<> struct fex_gen_config<glVertexAttrib4fv> {};
@@ -0,0 +1,42 @@
+#pragma once
+#include <common/CrossArchEvent.h>
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Ring of interleaved playback frames shared between the guest and a host feeder thread.
+ *
+ * The guest appends frames and moves Write forward, the host thread hands them to ALSA and moves Read forward.
+ * Both positions count frames and only ever grow, the offset in Data is the position modulo Capacity.
+ * Avail and Delay are the PCM's state as of the host thread's last write, so the guest can answer
+ * snd_pcm_avail/snd_pcm_delay without a guest<->host transition.
+ */
+struct PCMRing {
+  // Host allocated frame storage
+  uint8_t *Data;
+  uint64_t Capacity;
+  uint64_t FrameBytes;
+
+  std::atomic<uint64_t> Write;
+  std::atomic<uint64_t> Read;
+
+  std::atomic<int64_t> Avail;
+  std::atomic<int64_t> Delay;
+
+  // Negative error code from the last host write, sticks until the ring is detached
+  std::atomic<int64_t> Error;
+
+  // Host thread stops once it's drained the ring, or immediately with Discard
+  std::atomic<uint32_t> Stop;
+  std::atomic<uint32_t> Discard;
+
+  // Guest -> host, more frames were written
+  CrossArchEvent DataReady;
+  // Host -> guest, frames were consumed or an error occured
+  CrossArchEvent SpaceReady;
+
+  uint64_t Fill() const {
+    return Write.load(std::memory_order_relaxed) - Read.load(std::memory_order_acquire);
+  }
+};
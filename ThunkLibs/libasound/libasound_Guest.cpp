@@ -9,13 +9,312 @@ extern "C" {
 }
 
 #include <stdio.h>
+#include <algorithm>
+#include <cstdlib>
 #include <cstring>
 #include <map>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include "common/Guest.h"
 #include <stdarg.h>
 
+#include "PCMRing.h"
+
 #include "thunkgen_guest_libasound.inl"
 
-LOAD_LIB(libasound)
+// Playback through a host fed ring, opted in to with FEX_ASOUND_PCM_RING=1.
+// snd_pcm_writei only copies in to the ring and avail/delay are answered from the ring's state, so games polling
+// audio don't pay a guest<->host transition per call and the host keeps feeding ALSA while the JIT is busy.
+// Any other PCM control first detaches the ring, handing the queued frames to ALSA or discarding them,
+// so it sees the same PCM state it would without the ring. The next write attaches a new one.
+static const bool PCMRingEnabled = [] {
+  auto Env = getenv("FEX_ASOUND_PCM_RING");
+  return Env && atoi(Env) != 0;
+}();
+
+struct PCMGuestState {
+  PCMRing *Ring{};
+  bool NonBlock{};
+  // The host couldn't create a ring with the current hw params
+  bool RingUnsupported{};
+};
+
+static std::mutex PCMStatesMutex;
+static std::unordered_map<snd_pcm_t*, PCMGuestState> PCMStates;
+
+static PCMRing *GetRing(snd_pcm_t *pcm) {
+  if (!PCMRingEnabled) {
+    return nullptr;
+  }
+
+  std::lock_guard lk(PCMStatesMutex);
+  auto it = PCMStates.find(pcm);
+  return it != PCMStates.end() ? it->second.Ring : nullptr;
+}
+
+static PCMRing *GetOrAttachRing(snd_pcm_t *pcm, bool *NonBlock) {
+  if (!PCMRingEnabled) {
+    return nullptr;
+  }
+
+  std::lock_guard lk(PCMStatesMutex);
+  auto &State = PCMStates[pcm];
+  if (!State.Ring && !State.RingUnsupported) {
+    State.Ring = FEX_PCMRingAttach(pcm);
+    State.RingUnsupported = !State.Ring;
+  }
+  *NonBlock = State.NonBlock;
+  return State.Ring;
+}
+
+static void DetachRing(snd_pcm_t *pcm, bool Discard, bool ResetSupport = false) {
+  if (!PCMRingEnabled) {
+    return;
+  }
+
+  PCMRing *Ring{};
+  {
+    std::lock_guard lk(PCMStatesMutex);
+    auto it = PCMStates.find(pcm);
+    if (it == PCMStates.end()) {
+      return;
+    }
+    Ring = it->second.Ring;
+    it->second.Ring = nullptr;
+    if (ResetSupport) {
+      it->second.RingUnsupported = false;
+    }
+  }
+
+  if (Ring) {
+    Ring->Discard = Discard;
+    FEX_PCMRingDetach(pcm, Ring);
+  }
+}
+
+static snd_pcm_sframes_t RingAvail(PCMRing *Ring) {
+  return std::max<int64_t>(0, Ring->Avail.load(std::memory_order_relaxed) - Ring->Fill());
+}
+
+extern "C" {
+  int snd_pcm_open(snd_pcm_t **pcm, const char *name, snd_pcm_stream_t stream, int mode) {
+    auto Result = fexfn_pack_snd_pcm_open(pcm, name, stream, mode);
+    if (Result == 0 && PCMRingEnabled) {
+      std::lock_guard lk(PCMStatesMutex);
+      PCMStates[*pcm] = { .NonBlock = (mode & SND_PCM_NONBLOCK) != 0 };
+    }
+    return Result;
+  }
+
+  int snd_pcm_close(snd_pcm_t *pcm) {
+    DetachRing(pcm, false);
+    if (PCMRingEnabled) {
+      std::lock_guard lk(PCMStatesMutex);
+      PCMStates.erase(pcm);
+    }
+    return fexfn_pack_snd_pcm_close(pcm);
+  }
+
+  int snd_pcm_nonblock(snd_pcm_t *pcm, int nonblock) {
+    DetachRing(pcm, false);
+    auto Result = fexfn_pack_snd_pcm_nonblock(pcm, nonblock);
+    if (Result == 0 && PCMRingEnabled) {
+      std::lock_guard lk(PCMStatesMutex);
+      PCMStates[pcm].NonBlock = nonblock != 0;
+    }
+    return Result;
+  }
+
+  int snd_pcm_hw_params(snd_pcm_t *pcm, snd_pcm_hw_params_t *params) {
+    DetachRing(pcm, false, true);
+    return fexfn_pack_snd_pcm_hw_params(pcm, params);
+  }
+
+  int snd_pcm_hw_free(snd_pcm_t *pcm) {
+    DetachRing(pcm, false, true);
+    return fexfn_pack_snd_pcm_hw_free(pcm);
+  }
+
+  int snd_pcm_sw_params(snd_pcm_t *pcm, snd_pcm_sw_params_t *params) {
+    DetachRing(pcm, false);
+    return fexfn_pack_snd_pcm_sw_params(pcm, params);
+  }
+
+  int snd_pcm_set_params(snd_pcm_t *pcm, snd_pcm_format_t format, snd_pcm_access_t access, unsigned int channels, unsigned int rate, int soft_resample, unsigned int latency) {
+    DetachRing(pcm, false, true);
+    return fexfn_pack_snd_pcm_set_params(pcm, format, access, channels, rate, soft_resample, latency);
+  }
+
+  int snd_pcm_prepare(snd_pcm_t *pcm) {
+    DetachRing(pcm, true);
+    return fexfn_pack_snd_pcm_prepare(pcm);
+  }
+
+  int snd_pcm_reset(snd_pcm_t *pcm) {
+    DetachRing(pcm, true);
+    return fexfn_pack_snd_pcm_reset(pcm);
+  }
+
+  int snd_pcm_start(snd_pcm_t *pcm) {
+    DetachRing(pcm, false);
+    return fexfn_pack_snd_pcm_start(pcm);
+  }
+
+  int snd_pcm_drop(snd_pcm_t *pcm) {
+    DetachRing(pcm, true);
+    return fexfn_pack_snd_pcm_drop(pcm);
+  }
+
+  int snd_pcm_drain(snd_pcm_t *pcm) {
+    DetachRing(pcm, false);
+    return fexfn_pack_snd_pcm_drain(pcm);
+  }
+
+  int snd_pcm_pause(snd_pcm_t *pcm, int enable) {
+    DetachRing(pcm, false);
+    return fexfn_pack_snd_pcm_pause(pcm, enable);
+  }
+
+  int snd_pcm_resume(snd_pcm_t *pcm) {
+    DetachRing(pcm, false);
+    return fexfn_pack_snd_pcm_resume(pcm);
+  }
+
+  int snd_pcm_recover(snd_pcm_t *pcm, int err, int silent) {
+    DetachRing(pcm, true);
+    return fexfn_pack_snd_pcm_recover(pcm, err, silent);
+  }
+
+  snd_pcm_sframes_t snd_pcm_rewindable(snd_pcm_t *pcm) {
+    DetachRing(pcm, false);
+    return fexfn_pack_snd_pcm_rewindable(pcm);
+  }
+
+  snd_pcm_sframes_t snd_pcm_rewind(snd_pcm_t *pcm, snd_pcm_uframes_t frames) {
+    DetachRing(pcm, false);
+    return fexfn_pack_snd_pcm_rewind(pcm, frames);
+  }
+
+  snd_pcm_sframes_t snd_pcm_forwardable(snd_pcm_t *pcm) {
+    DetachRing(pcm, false);
+    return fexfn_pack_snd_pcm_forwardable(pcm);
+  }
+
+  snd_pcm_sframes_t snd_pcm_forward(snd_pcm_t *pcm, snd_pcm_uframes_t frames) {
+    DetachRing(pcm, false);
+    return fexfn_pack_snd_pcm_forward(pcm, frames);
+  }
+
+  snd_pcm_sframes_t snd_pcm_avail(snd_pcm_t *pcm) {
+    if (auto Ring = GetRing(pcm)) {
+      if (auto Error = Ring->Error.load(std::memory_order_relaxed)) {
+        return Error;
+      }
+      return RingAvail(Ring);
+    }
+    return fexfn_pack_snd_pcm_avail(pcm);
+  }
+
+  snd_pcm_sframes_t snd_pcm_avail_update(snd_pcm_t *pcm) {
+    if (auto Ring = GetRing(pcm)) {
+      if (auto Error = Ring->Error.load(std::memory_order_relaxed)) {
+        return Error;
+      }
+      return RingAvail(Ring);
+    }
+    return fexfn_pack_snd_pcm_avail_update(pcm);
+  }
+
+  int snd_pcm_delay(snd_pcm_t *pcm, snd_pcm_sframes_t *delayp) {
+    if (auto Ring = GetRing(pcm)) {
+      if (auto Error = Ring->Error.load(std::memory_order_relaxed)) {
+        return Error;
+      }
+      // Frames still in the ring are ahead of everything ALSA has queued
+      *delayp = Ring->Delay.load(std::memory_order_relaxed) + Ring->Fill();
+      return 0;
+    }
+    return fexfn_pack_snd_pcm_delay(pcm, delayp);
+  }
+
+  int snd_pcm_avail_delay(snd_pcm_t *pcm, snd_pcm_sframes_t *availp, snd_pcm_sframes_t *delayp) {
+    if (auto Ring = GetRing(pcm)) {
+      if (auto Error = Ring->Error.load(std::memory_order_relaxed)) {
+        return Error;
+      }
+      *availp = RingAvail(Ring);
+      *delayp = Ring->Delay.load(std::memory_order_relaxed) + Ring->Fill();
+      return 0;
+    }
+    return fexfn_pack_snd_pcm_avail_delay(pcm, availp, delayp);
+  }
+
+  int snd_pcm_wait(snd_pcm_t *pcm, int timeout) {
+    if (auto Ring = GetRing(pcm)) {
+      while (true) {
+        if (auto Error = Ring->Error.load(std::memory_order_relaxed)) {
+          return Error;
+        }
+        if (Ring->Fill() < Ring->Capacity) {
+          return 1;
+        }
+        if (timeout == 0) {
+          return 0;
+        }
+        // The host thread frees space at least once per period while the PCM is running
+        WaitForWorkFunc(&Ring->SpaceReady);
+      }
+    }
+    return fexfn_pack_snd_pcm_wait(pcm, timeout);
+  }
+
+  snd_pcm_sframes_t snd_pcm_writei(snd_pcm_t *pcm, const void *buffer, snd_pcm_uframes_t size) {
+    bool NonBlock{};
+    auto Ring = GetOrAttachRing(pcm, &NonBlock);
+    if (!Ring) {
+      return fexfn_pack_snd_pcm_writei(pcm, buffer, size);
+    }
+
+    auto Src = reinterpret_cast<const uint8_t*>(buffer);
+    snd_pcm_uframes_t Written{};
+    while (Written < size) {
+      if (auto Error = Ring->Error.load(std::memory_order_relaxed)) {
+        return Written ? Written : Error;
+      }
+
+      const uint64_t Write = Ring->Write.load(std::memory_order_relaxed);
+      const uint64_t Free = Ring->Capacity - Ring->Fill();
+      if (Free == 0) {
+        if (NonBlock) {
+          break;
+        }
+        WaitForWorkFunc(&Ring->SpaceReady);
+        continue;
+      }
+
+      // Copy in up to two pieces around the end of the ring
+      uint64_t Frames = std::min<uint64_t>(size - Written, Free);
+      const uint64_t Offset = Write % Ring->Capacity;
+      const uint64_t FirstFrames = std::min(Frames, Ring->Capacity - Offset);
+      memcpy(Ring->Data + Offset * Ring->FrameBytes, Src, FirstFrames * Ring->FrameBytes);
+      memcpy(Ring->Data, Src + FirstFrames * Ring->FrameBytes, (Frames - FirstFrames) * Ring->FrameBytes);
+
+      Ring->Write.store(Write + Frames, std::memory_order_release);
+      NotifyWorkFunc(&Ring->DataReady);
+
+      Src += Frames * Ring->FrameBytes;
+      Written += Frames;
+    }
+
+    return (Written || size == 0) ? Written : -EAGAIN;
+  }
+}
+
+static void OnInit() {
+  // Sound server plugins (pulse, pipewire, jack) call back from their own host threads
+  StartCallbackWorkers(2);
+}
+
+LOAD_LIB_INIT(libasound, OnInit)
@@ -11,6 +11,125 @@ $end_info$
 #include "common/Host.h"
 #include <dlfcn.h>
 
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "PCMRing.h"
+
 #include "thunkgen_host_libasound.inl"
 
+static PCMRing *fexfn_impl_libasound_FEX_PCMRingAttach(snd_pcm_t*);
+static void fexfn_impl_libasound_FEX_PCMRingDetach(snd_pcm_t*, PCMRing*);
+
+struct PCMRingFeeder {
+  PCMRing Ring{};
+  snd_pcm_t *PCM;
+  std::unique_ptr<uint8_t[]> Storage;
+  std::thread Thread;
+};
+
+static std::mutex FeedersMutex;
+static std::unordered_map<PCMRing*, std::unique_ptr<PCMRingFeeder>> Feeders;
+
+static void UpdatePCMState(PCMRingFeeder *Feeder) {
+  snd_pcm_sframes_t Avail{}, Delay{};
+  if (fexldr_ptr_libasound_snd_pcm_avail_delay(Feeder->PCM, &Avail, &Delay) == 0) {
+    Feeder->Ring.Avail.store(Avail, std::memory_order_relaxed);
+    Feeder->Ring.Delay.store(Delay, std::memory_order_relaxed);
+  }
+}
+
+// Hands the guest's frames to ALSA, only ever touches host state so it never needs to call in to the guest
+static void FeederThreadFunc(PCMRingFeeder *Feeder) {
+  pthread_setname_np(pthread_self(), "asound:ring");
+
+  auto &Ring = Feeder->Ring;
+  while (true) {
+    const uint64_t Write = Ring.Write.load(std::memory_order_acquire);
+    const uint64_t Read = Ring.Read.load(std::memory_order_relaxed);
+
+    if (Ring.Stop.load() && (Ring.Discard.load() || Write == Read || Ring.Error.load(std::memory_order_relaxed))) {
+      break;
+    }
+
+    if (Write == Read || Ring.Error.load(std::memory_order_relaxed)) {
+      WaitForWorkFunc(&Ring.DataReady);
+      continue;
+    }
+
+    const uint64_t Offset = Read % Ring.Capacity;
+    const uint64_t Frames = std::min(Write - Read, Ring.Capacity - Offset);
+    auto Result = fexldr_ptr_libasound_snd_pcm_writei(Feeder->PCM, Ring.Data + Offset * Ring.FrameBytes, Frames);
+
+    if (Result == -EAGAIN) {
+      // Non-blocking PCM with a full buffer
+      fexldr_ptr_libasound_snd_pcm_wait(Feeder->PCM, 10);
+      continue;
+    }
+
+    if (Result < 0) {
+      // Underrun or suspend, the guest sees it on its next call and recovers through the usual prepare path
+      Ring.Error.store(Result, std::memory_order_relaxed);
+      Ring.Read.store(Write, std::memory_order_release);
+    }
+    else {
+      Ring.Read.store(Read + Result, std::memory_order_release);
+      UpdatePCMState(Feeder);
+    }
+
+    NotifyWorkFunc(&Ring.SpaceReady);
+  }
+}
+
+static PCMRing *fexfn_impl_libasound_FEX_PCMRingAttach(snd_pcm_t *a_0) {
+  if (fexldr_ptr_libasound_snd_pcm_stream(a_0) != SND_PCM_STREAM_PLAYBACK) {
+    return nullptr;
+  }
+
+  snd_pcm_uframes_t BufferSize{}, PeriodSize{};
+  if (fexldr_ptr_libasound_snd_pcm_get_params(a_0, &BufferSize, &PeriodSize) != 0 || BufferSize == 0) {
+    return nullptr;
+  }
+
+  const auto FrameBytes = fexldr_ptr_libasound_snd_pcm_frames_to_bytes(a_0, 1);
+  if (FrameBytes <= 0) {
+    return nullptr;
+  }
+
+  auto Feeder = std::make_unique<PCMRingFeeder>();
+  Feeder->PCM = a_0;
+  Feeder->Storage = std::make_unique<uint8_t[]>(BufferSize * FrameBytes);
+  Feeder->Ring.Data = Feeder->Storage.get();
+  Feeder->Ring.Capacity = BufferSize;
+  Feeder->Ring.FrameBytes = FrameBytes;
+  UpdatePCMState(Feeder.get());
+  Feeder->Thread = std::thread(FeederThreadFunc, Feeder.get());
+
+  auto Ring = &Feeder->Ring;
+  std::lock_guard lk(FeedersMutex);
+  Feeders.emplace(Ring, std::move(Feeder));
+  return Ring;
+}
+
+static void fexfn_impl_libasound_FEX_PCMRingDetach(snd_pcm_t *a_0, PCMRing *a_1) {
+  std::unique_ptr<PCMRingFeeder> Feeder;
+  {
+    std::lock_guard lk(FeedersMutex);
+    auto it = Feeders.find(a_1);
+    if (it == Feeders.end()) {
+      return;
+    }
+    Feeder = std::move(it->second);
+    Feeders.erase(it);
+  }
+
+  // Waits for the remaining frames to reach ALSA unless the guest set Discard
+  Feeder->Ring.Stop = 1;
+  NotifyWorkFunc(&Feeder->Ring.DataReady);
+  Feeder->Thread.join();
+}
+
 EXPORTS(libasound)
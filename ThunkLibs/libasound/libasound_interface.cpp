@@ -3,11 +3,19 @@
 #include <alsa/asoundlib.h>
 #include <alsa/version.h>
 
+#include "PCMRing.h"
+
 template<auto>
 struct fex_gen_config {
     unsigned version = 2;
 };
 
+PCMRing *FEX_PCMRingAttach(snd_pcm_t*);
+void FEX_PCMRingDetach(snd_pcm_t*, PCMRing*);
+
+template<> struct fex_gen_config<FEX_PCMRingAttach> : fexgen::custom_host_impl {};
+template<> struct fex_gen_config<FEX_PCMRingDetach> : fexgen::custom_host_impl {};
+
 template<> struct fex_gen_config<snd_asoundlib_version> {};
 #if SND_LIB_VERSION < ((1 << 16) | (2 << 8) | (6))
 // Exists on 1.2.6
@@ -109,49 +117,49 @@ template<> struct fex_gen_config<snd_config_get_ctl_iface_ascii> {};
 template<> struct fex_gen_config<snd_config_get_ctl_iface> {};
 template<> struct fex_gen_config<snd_names_list> {};
 template<> struct fex_gen_config<snd_names_list_free> {};
-template<> struct fex_gen_config<snd_pcm_open> {};
+template<> struct fex_gen_config<snd_pcm_open> : fexgen::custom_guest_entrypoint {};
 template<> struct fex_gen_config<snd_pcm_open_lconf> {};
 template<> struct fex_gen_config<snd_pcm_open_fallback> {};
-template<> struct fex_gen_config<snd_pcm_close> {};
+template<> struct fex_gen_config<snd_pcm_close> : fexgen::custom_guest_entrypoint {};
 template<> struct fex_gen_config<snd_pcm_name> {};
 template<> struct fex_gen_config<snd_pcm_type> {};
 template<> struct fex_gen_config<snd_pcm_stream> {};
 template<> struct fex_gen_config<snd_pcm_poll_descriptors_count> {};
 template<> struct fex_gen_config<snd_pcm_poll_descriptors> {};
 template<> struct fex_gen_config<snd_pcm_poll_descriptors_revents> {};
-template<> struct fex_gen_config<snd_pcm_nonblock> {};
+template<> struct fex_gen_config<snd_pcm_nonblock> : fexgen::custom_guest_entrypoint {};
 //template<> struct fex_gen_config<snd_async_add_pcm_handler> {};
 template<> struct fex_gen_config<snd_async_handler_get_pcm> {};
 template<> struct fex_gen_config<snd_pcm_info> {};
 template<> struct fex_gen_config<snd_pcm_hw_params_current> {};
-template<> struct fex_gen_config<snd_pcm_hw_params> {};
-template<> struct fex_gen_config<snd_pcm_hw_free> {};
+template<> struct fex_gen_config<snd_pcm_hw_params> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<snd_pcm_hw_free> : fexgen::custom_guest_entrypoint {};
 template<> struct fex_gen_config<snd_pcm_sw_params_current> {};
-template<> struct fex_gen_config<snd_pcm_sw_params> {};
-template<> struct fex_gen_config<snd_pcm_prepare> {};
-template<> struct fex_gen_config<snd_pcm_reset> {};
+template<> struct fex_gen_config<snd_pcm_sw_params> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<snd_pcm_prepare> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<snd_pcm_reset> : fexgen::custom_guest_entrypoint {};
 template<> struct fex_gen_config<snd_pcm_status> {};
-template<> struct fex_gen_config<snd_pcm_start> {};
-template<> struct fex_gen_config<snd_pcm_drop> {};
-template<> struct fex_gen_config<snd_pcm_drain> {};
-template<> struct fex_gen_config<snd_pcm_pause> {};
+template<> struct fex_gen_config<snd_pcm_start> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<snd_pcm_drop> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<snd_pcm_drain> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<snd_pcm_pause> : fexgen::custom_guest_entrypoint {};
 template<> struct fex_gen_config<snd_pcm_state> {};
 template<> struct fex_gen_config<snd_pcm_hwsync> {};
-template<> struct fex_gen_config<snd_pcm_delay> {};
-template<> struct fex_gen_config<snd_pcm_resume> {};
+template<> struct fex_gen_config<snd_pcm_delay> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<snd_pcm_resume> : fexgen::custom_guest_entrypoint {};
 template<> struct fex_gen_config<snd_pcm_htimestamp> {};
-template<> struct fex_gen_config<snd_pcm_avail> {};
-template<> struct fex_gen_config<snd_pcm_avail_update> {};
-template<> struct fex_gen_config<snd_pcm_avail_delay> {};
-template<> struct fex_gen_config<snd_pcm_rewindable> {};
-template<> struct fex_gen_config<snd_pcm_rewind> {};
-template<> struct fex_gen_config<snd_pcm_forwardable> {};
-template<> struct fex_gen_config<snd_pcm_forward> {};
-template<> struct fex_gen_config<snd_pcm_writei> {};
+template<> struct fex_gen_config<snd_pcm_avail> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<snd_pcm_avail_update> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<snd_pcm_avail_delay> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<snd_pcm_rewindable> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<snd_pcm_rewind> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<snd_pcm_forwardable> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<snd_pcm_forward> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<snd_pcm_writei> : fexgen::custom_guest_entrypoint {};
 template<> struct fex_gen_config<snd_pcm_readi> {};
 template<> struct fex_gen_config<snd_pcm_writen> {};
 template<> struct fex_gen_config<snd_pcm_readn> {};
-template<> struct fex_gen_config<snd_pcm_wait> {};
+template<> struct fex_gen_config<snd_pcm_wait> : fexgen::custom_guest_entrypoint {};
 template<> struct fex_gen_config<snd_pcm_link> {};
 template<> struct fex_gen_config<snd_pcm_unlink> {};
 template<> struct fex_gen_config<snd_pcm_query_chmaps> {};
@@ -165,8 +173,8 @@ template<> struct fex_gen_config<snd_pcm_chmap_long_name> {};
 template<> struct fex_gen_config<snd_pcm_chmap_print> {};
 template<> struct fex_gen_config<snd_pcm_chmap_from_string> {};
 template<> struct fex_gen_config<snd_pcm_chmap_parse_string> {};
-template<> struct fex_gen_config<snd_pcm_recover> {};
-template<> struct fex_gen_config<snd_pcm_set_params> {};
+template<> struct fex_gen_config<snd_pcm_recover> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<snd_pcm_set_params> : fexgen::custom_guest_entrypoint {};
 template<> struct fex_gen_config<snd_pcm_get_params> {};
 template<> struct fex_gen_config<snd_pcm_info_sizeof> {};
 template<> struct fex_gen_config<snd_pcm_info_malloc> {};
@@ -0,0 +1,13 @@
+/*
+$info$
+tags: thunklibs|fex_thunk_bench
+$end_info$
+*/
+
+#include "fex_thunk_bench.h"
+
+#include "common/Guest.h"
+
+#include "thunkgen_guest_libfex_thunk_bench.inl"
+
+LOAD_LIB(libfex_thunk_bench)
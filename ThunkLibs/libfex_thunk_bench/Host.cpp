@@ -0,0 +1,14 @@
+/*
+$info$
+tags: thunklibs|fex_thunk_bench
+$end_info$
+*/
+
+#include "fex_thunk_bench.h"
+
+#include "common/Host.h"
+#include <dlfcn.h>
+
+#include "thunkgen_host_libfex_thunk_bench.inl"
+
+EXPORTS(libfex_thunk_bench)
@@ -0,0 +1,54 @@
+/*
+$info$
+tags: thunklibs|fex_thunk_bench
+desc: Native implementation of the thunk benchmark library, built for the host and for the guest
+$end_info$
+*/
+
+#include "fex_thunk_bench.h"
+
+template<typename T>
+static uint64_t Sum(const T *args) {
+  uint64_t Result{};
+  for (auto Value : args->values) {
+    Result += Value;
+  }
+  return Result;
+}
+
+static uint64_t BatchedValue{};
+
+extern "C" {
+  __attribute__((visibility("default"))) void fex_thunk_bench_empty() {
+  }
+
+  __attribute__((visibility("default"))) uint64_t fex_thunk_bench_scalars(uint64_t a, uint64_t b, uint64_t c, uint64_t d) {
+    return a + b + c + d;
+  }
+
+  __attribute__((visibility("default"))) uint64_t fex_thunk_bench_sum16(const fex_thunk_bench_args16 *args) {
+    return Sum(args);
+  }
+
+  __attribute__((visibility("default"))) uint64_t fex_thunk_bench_sum64(const fex_thunk_bench_args64 *args) {
+    return Sum(args);
+  }
+
+  __attribute__((visibility("default"))) uint64_t fex_thunk_bench_sum256(const fex_thunk_bench_args256 *args) {
+    return Sum(args);
+  }
+
+  __attribute__((visibility("default"))) void fex_thunk_bench_invoke(fex_thunk_bench_callback callback, void *data, uint32_t count) {
+    for (uint32_t i = 0; i < count; ++i) {
+      callback(data);
+    }
+  }
+
+  __attribute__((visibility("default"))) void fex_thunk_bench_batched(uint64_t value) {
+    BatchedValue += value;
+  }
+
+  __attribute__((visibility("default"))) uint64_t fex_thunk_bench_batched_result() {
+    return BatchedValue;
+  }
+}
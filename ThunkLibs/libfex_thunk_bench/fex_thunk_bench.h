@@ -0,0 +1,33 @@
+#pragma once
+#include <stdint.h>
+
+// Functions that do as little work as possible, so calling them through a thunk measures the guest <-> host transitions.
+// Pointed to arguments are only summed, they have the same layout on every architecture so no repacking is needed.
+extern "C" {
+  struct fex_thunk_bench_args16 {
+    uint64_t values[2];
+  };
+
+  struct fex_thunk_bench_args64 {
+    uint64_t values[8];
+  };
+
+  struct fex_thunk_bench_args256 {
+    uint64_t values[32];
+  };
+
+  typedef void (*fex_thunk_bench_callback)(void *data);
+
+  void fex_thunk_bench_empty();
+  uint64_t fex_thunk_bench_scalars(uint64_t a, uint64_t b, uint64_t c, uint64_t d);
+  uint64_t fex_thunk_bench_sum16(const fex_thunk_bench_args16 *args);
+  uint64_t fex_thunk_bench_sum64(const fex_thunk_bench_args64 *args);
+  uint64_t fex_thunk_bench_sum256(const fex_thunk_bench_args256 *args);
+
+  // Calls Callback Count times, one thunk call for many host -> guest transitions
+  void fex_thunk_bench_invoke(fex_thunk_bench_callback callback, void *data, uint32_t count);
+
+  // Accumulates in to a host side value, fex_thunk_bench_batched_result returns it
+  void fex_thunk_bench_batched(uint64_t value);
+  uint64_t fex_thunk_bench_batched_result();
+}
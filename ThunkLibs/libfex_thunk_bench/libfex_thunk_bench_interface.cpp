@@ -0,0 +1,17 @@
+#include <common/GeneratorInterface.h>
+
+#include "fex_thunk_bench.h"
+
+template<auto>
+struct fex_gen_config {
+    unsigned version = 1;
+};
+
+template<> struct fex_gen_config<fex_thunk_bench_empty> {};
+template<> struct fex_gen_config<fex_thunk_bench_scalars> {};
+template<> struct fex_gen_config<fex_thunk_bench_sum16> {};
+template<> struct fex_gen_config<fex_thunk_bench_sum64> {};
+template<> struct fex_gen_config<fex_thunk_bench_sum256> {};
+template<> struct fex_gen_config<fex_thunk_bench_invoke> {};
+template<> struct fex_gen_config<fex_thunk_bench_batched> : fexgen::batchable {};
+template<> struct fex_gen_config<fex_thunk_bench_batched_result> {};
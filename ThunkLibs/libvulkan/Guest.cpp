@@ -29,8 +29,15 @@ const std::unordered_map<std::string_view, uintptr_t /* guest function address *
 #define PAIR(name, unused) Ret[#name] = reinterpret_cast<uintptr_t>(GetCallerForHostFunction(name));
         std::unordered_map<std::string_view, uintptr_t> Ret;
         FOREACH_internal_SYMBOL(PAIR);
-        return Ret;
 #undef PAIR
+
+        // Command recording functions that only take handles and scalars are queued through
+        // their packing function and reach the host together at the next non-recording call,
+        // e.g. vkEndCommandBuffer or vkQueueSubmit
+#define PAIR(name, unused) Ret[#name] = reinterpret_cast<uintptr_t>(fexfn_pack_##name);
+        FOREACH_internal_BATCHABLE_SYMBOL(PAIR);
+#undef PAIR
+        return Ret;
     });
 
 // This variable controls the behavior of vkGetDevice/InstanceProcAddr for functions we don't know the signature of:
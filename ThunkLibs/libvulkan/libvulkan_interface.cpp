@@ -44,6 +44,8 @@ template<> struct fex_gen_config<vkQueueWaitIdle> {};
 template<> struct fex_gen_config<vkDeviceWaitIdle> {};
 template<> struct fex_gen_config<vkAllocateMemory> : fexgen::custom_host_impl {};
 template<> struct fex_gen_config<vkFreeMemory> : fexgen::custom_host_impl {};
+// Mapped pointers are passed through as-is, which is only valid for 64-bit guests.
+// 32-bit guests would need the mapping placed in their low 4GB, but there is no 32-bit libvulkan guest thunk to use it.
 template<> struct fex_gen_config<vkMapMemory> {};
 template<> struct fex_gen_config<vkUnmapMemory> {};
 template<> struct fex_gen_config<vkFlushMappedMemoryRanges> {};
@@ -114,56 +116,56 @@ template<> struct fex_gen_config<vkFreeCommandBuffers> {};
 template<> struct fex_gen_config<vkBeginCommandBuffer> {};
 template<> struct fex_gen_config<vkEndCommandBuffer> {};
 template<> struct fex_gen_config<vkResetCommandBuffer> {};
-template<> struct fex_gen_config<vkCmdBindPipeline> {};
+template<> struct fex_gen_config<vkCmdBindPipeline> : fexgen::batchable {};
 template<> struct fex_gen_config<vkCmdSetViewport> {};
 template<> struct fex_gen_config<vkCmdSetScissor> {};
-template<> struct fex_gen_config<vkCmdSetLineWidth> {};
-template<> struct fex_gen_config<vkCmdSetDepthBias> {};
+template<> struct fex_gen_config<vkCmdSetLineWidth> : fexgen::batchable {};
+template<> struct fex_gen_config<vkCmdSetDepthBias> : fexgen::batchable {};
 template<> struct fex_gen_config<vkCmdSetBlendConstants> {};
-template<> struct fex_gen_config<vkCmdSetDepthBounds> {};
-template<> struct fex_gen_config<vkCmdSetStencilCompareMask> {};
-template<> struct fex_gen_config<vkCmdSetStencilWriteMask> {};
-template<> struct fex_gen_config<vkCmdSetStencilReference> {};
+template<> struct fex_gen_config<vkCmdSetDepthBounds> : fexgen::batchable {};
+template<> struct fex_gen_config<vkCmdSetStencilCompareMask> : fexgen::batchable {};
+template<> struct fex_gen_config<vkCmdSetStencilWriteMask> : fexgen::batchable {};
+template<> struct fex_gen_config<vkCmdSetStencilReference> : fexgen::batchable {};
 template<> struct fex_gen_config<vkCmdBindDescriptorSets> {};
-template<> struct fex_gen_config<vkCmdBindIndexBuffer> {};
+template<> struct fex_gen_config<vkCmdBindIndexBuffer> : fexgen::batchable {};
 template<> struct fex_gen_config<vkCmdBindVertexBuffers> {};
-template<> struct fex_gen_config<vkCmdDraw> {};
-template<> struct fex_gen_config<vkCmdDrawIndexed> {};
-template<> struct fex_gen_config<vkCmdDrawIndirect> {};
-template<> struct fex_gen_config<vkCmdDrawIndexedIndirect> {};
-template<> struct fex_gen_config<vkCmdDispatch> {};
-template<> struct fex_gen_config<vkCmdDispatchIndirect> {};
+template<> struct fex_gen_config<vkCmdDraw> : fexgen::batchable {};
+template<> struct fex_gen_config<vkCmdDrawIndexed> : fexgen::batchable {};
+template<> struct fex_gen_config<vkCmdDrawIndirect> : fexgen::batchable {};
+template<> struct fex_gen_config<vkCmdDrawIndexedIndirect> : fexgen::batchable {};
+template<> struct fex_gen_config<vkCmdDispatch> : fexgen::batchable {};
+template<> struct fex_gen_config<vkCmdDispatchIndirect> : fexgen::batchable {};
 template<> struct fex_gen_config<vkCmdCopyBuffer> {};
 template<> struct fex_gen_config<vkCmdCopyImage> {};
 template<> struct fex_gen_config<vkCmdBlitImage> {};
 template<> struct fex_gen_config<vkCmdCopyBufferToImage> {};
 template<> struct fex_gen_config<vkCmdCopyImageToBuffer> {};
 template<> struct fex_gen_config<vkCmdUpdateBuffer> {};
-template<> struct fex_gen_config<vkCmdFillBuffer> {};
+template<> struct fex_gen_config<vkCmdFillBuffer> : fexgen::batchable {};
 template<> struct fex_gen_config<vkCmdClearColorImage> {};
 template<> struct fex_gen_config<vkCmdClearDepthStencilImage> {};
 template<> struct fex_gen_config<vkCmdClearAttachments> {};
 template<> struct fex_gen_config<vkCmdResolveImage> {};
-template<> struct fex_gen_config<vkCmdSetEvent> {};
-template<> struct fex_gen_config<vkCmdResetEvent> {};
+template<> struct fex_gen_config<vkCmdSetEvent> : fexgen::batchable {};
+template<> struct fex_gen_config<vkCmdResetEvent> : fexgen::batchable {};
 template<> struct fex_gen_config<vkCmdWaitEvents> {};
 template<> struct fex_gen_config<vkCmdPipelineBarrier> {};
-template<> struct fex_gen_config<vkCmdBeginQuery> {};
-template<> struct fex_gen_config<vkCmdEndQuery> {};
-template<> struct fex_gen_config<vkCmdResetQueryPool> {};
-template<> struct fex_gen_config<vkCmdWriteTimestamp> {};
-template<> struct fex_gen_config<vkCmdCopyQueryPoolResults> {};
+template<> struct fex_gen_config<vkCmdBeginQuery> : fexgen::batchable {};
+template<> struct fex_gen_config<vkCmdEndQuery> : fexgen::batchable {};
+template<> struct fex_gen_config<vkCmdResetQueryPool> : fexgen::batchable {};
+template<> struct fex_gen_config<vkCmdWriteTimestamp> : fexgen::batchable {};
+template<> struct fex_gen_config<vkCmdCopyQueryPoolResults> : fexgen::batchable {};
 template<> struct fex_gen_config<vkCmdPushConstants> {};
 template<> struct fex_gen_config<vkCmdBeginRenderPass> {};
-template<> struct fex_gen_config<vkCmdNextSubpass> {};
-template<> struct fex_gen_config<vkCmdEndRenderPass> {};
+template<> struct fex_gen_config<vkCmdNextSubpass> : fexgen::batchable {};
+template<> struct fex_gen_config<vkCmdEndRenderPass> : fexgen::batchable {};
 template<> struct fex_gen_config<vkCmdExecuteCommands> {};
 template<> struct fex_gen_config<vkEnumerateInstanceVersion> {};
 template<> struct fex_gen_config<vkBindBufferMemory2> {};
 template<> struct fex_gen_config<vkBindImageMemory2> {};
 template<> struct fex_gen_config<vkGetDeviceGroupPeerMemoryFeatures> {};
-template<> struct fex_gen_config<vkCmdSetDeviceMask> {};
-template<> struct fex_gen_config<vkCmdDispatchBase> {};
+template<> struct fex_gen_config<vkCmdSetDeviceMask> : fexgen::batchable {};
+template<> struct fex_gen_config<vkCmdDispatchBase> : fexgen::batchable {};
 template<> struct fex_gen_config<vkEnumeratePhysicalDeviceGroups> {};
 template<> struct fex_gen_config<vkGetImageMemoryRequirements2> {};
 template<> struct fex_gen_config<vkGetBufferMemoryRequirements2> {};
@@ -186,8 +188,8 @@ template<> struct fex_gen_config<vkGetPhysicalDeviceExternalBufferProperties> {}
 template<> struct fex_gen_config<vkGetPhysicalDeviceExternalFenceProperties> {};
 template<> struct fex_gen_config<vkGetPhysicalDeviceExternalSemaphoreProperties> {};
 template<> struct fex_gen_config<vkGetDescriptorSetLayoutSupport> {};
-template<> struct fex_gen_config<vkCmdDrawIndirectCount> {};
-template<> struct fex_gen_config<vkCmdDrawIndexedIndirectCount> {};
+template<> struct fex_gen_config<vkCmdDrawIndirectCount> : fexgen::batchable {};
+template<> struct fex_gen_config<vkCmdDrawIndexedIndirectCount> : fexgen::batchable {};
 template<> struct fex_gen_config<vkCreateRenderPass2> {};
 template<> struct fex_gen_config<vkCmdBeginRenderPass2> {};
 template<> struct fex_gen_config<vkCmdNextSubpass2> {};
@@ -205,10 +207,10 @@ template<> struct fex_gen_config<vkDestroyPrivateDataSlot> {};
 template<> struct fex_gen_config<vkSetPrivateData> {};
 template<> struct fex_gen_config<vkGetPrivateData> {};
 template<> struct fex_gen_config<vkCmdSetEvent2> {};
-template<> struct fex_gen_config<vkCmdResetEvent2> {};
+template<> struct fex_gen_config<vkCmdResetEvent2> : fexgen::batchable {};
 template<> struct fex_gen_config<vkCmdWaitEvents2> {};
 template<> struct fex_gen_config<vkCmdPipelineBarrier2> {};
-template<> struct fex_gen_config<vkCmdWriteTimestamp2> {};
+template<> struct fex_gen_config<vkCmdWriteTimestamp2> : fexgen::batchable {};
 template<> struct fex_gen_config<vkQueueSubmit2> {};
 template<> struct fex_gen_config<vkCmdCopyBuffer2> {};
 template<> struct fex_gen_config<vkCmdCopyImage2> {};
@@ -217,22 +219,22 @@ template<> struct fex_gen_config<vkCmdCopyImageToBuffer2> {};
 template<> struct fex_gen_config<vkCmdBlitImage2> {};
 template<> struct fex_gen_config<vkCmdResolveImage2> {};
 template<> struct fex_gen_config<vkCmdBeginRendering> {};
-template<> struct fex_gen_config<vkCmdEndRendering> {};
-template<> struct fex_gen_config<vkCmdSetCullMode> {};
-template<> struct fex_gen_config<vkCmdSetFrontFace> {};
-template<> struct fex_gen_config<vkCmdSetPrimitiveTopology> {};
+template<> struct fex_gen_config<vkCmdEndRendering> : fexgen::batchable {};
+template<> struct fex_gen_config<vkCmdSetCullMode> : fexgen::batchable {};
+template<> struct fex_gen_config<vkCmdSetFrontFace> : fexgen::batchable {};
+template<> struct fex_gen_config<vkCmdSetPrimitiveTopology> : fexgen::batchable {};
 template<> struct fex_gen_config<vkCmdSetViewportWithCount> {};
 template<> struct fex_gen_config<vkCmdSetScissorWithCount> {};
 template<> struct fex_gen_config<vkCmdBindVertexBuffers2> {};
-template<> struct fex_gen_config<vkCmdSetDepthTestEnable> {};
-template<> struct fex_gen_config<vkCmdSetDepthWriteEnable> {};
-template<> struct fex_gen_config<vkCmdSetDepthCompareOp> {};
-template<> struct fex_gen_config<vkCmdSetDepthBoundsTestEnable> {};
-template<> struct fex_gen_config<vkCmdSetStencilTestEnable> {};
-template<> struct fex_gen_config<vkCmdSetStencilOp> {};
-template<> struct fex_gen_config<vkCmdSetRasterizerDiscardEnable> {};
-template<> struct fex_gen_config<vkCmdSetDepthBiasEnable> {};
-template<> struct fex_gen_config<vkCmdSetPrimitiveRestartEnable> {};
+template<> struct fex_gen_config<vkCmdSetDepthTestEnable> : fexgen::batchable {};
+template<> struct fex_gen_config<vkCmdSetDepthWriteEnable> : fexgen::batchable {};
+template<> struct fex_gen_config<vkCmdSetDepthCompareOp> : fexgen::batchable {};
+template<> struct fex_gen_config<vkCmdSetDepthBoundsTestEnable> : fexgen::batchable {};
+template<> struct fex_gen_config<vkCmdSetStencilTestEnable> : fexgen::batchable {};
+template<> struct fex_gen_config<vkCmdSetStencilOp> : fexgen::batchable {};
+template<> struct fex_gen_config<vkCmdSetRasterizerDiscardEnable> : fexgen::batchable {};
+template<> struct fex_gen_config<vkCmdSetDepthBiasEnable> : fexgen::batchable {};
+template<> struct fex_gen_config<vkCmdSetPrimitiveRestartEnable> : fexgen::batchable {};
 template<> struct fex_gen_config<vkGetDeviceBufferMemoryRequirements> {};
 template<> struct fex_gen_config<vkGetDeviceImageMemoryRequirements> {};
 template<> struct fex_gen_config<vkGetDeviceImageSparseMemoryRequirements> {};
@@ -30,6 +30,7 @@ extern "C" const wl_interface wl_callback_interface {};
 #include <charconv>
 #include <cstdio>
 #include <cstdarg>
+#include <cstdlib>
 #include <cstring>
 #include <string>
 #include <unordered_map>
@@ -213,6 +214,27 @@ static void wl_argument_from_va_list(const char *signature, wl_argument *args,
   }
 }
 
+// Queue requests through fex_wl_proxy_marshal_batched, opted in to with FEX_WAYLAND_BATCH_REQUESTS=1.
+// Queued requests are only sent by the next non-batched call on the same thread, so this is unsafe for
+// applications that marshal requests on one thread and only flush the display from another.
+static const bool BatchRequests = [] {
+  auto Env = getenv("FEX_WAYLAND_BATCH_REQUESTS");
+  return Env && atoi(Env) != 0;
+}();
+
+constexpr int MAX_BATCHED_ARGS = 6;
+
+// Strings, arrays and fds are read when the request is marshalled, so they can't be deferred
+static bool CanBatchRequest(const char *signature) {
+  int count = 0;
+  for (char arg_type; signature = get_next_argument_type(signature, arg_type), arg_type;) {
+    if ((arg_type != 'i' && arg_type != 'u' && arg_type != 'f' && arg_type != 'o') || ++count > MAX_BATCHED_ARGS) {
+      return false;
+    }
+  }
+  return true;
+}
+
 extern "C" wl_proxy *wl_proxy_marshal_flags(wl_proxy *proxy, uint32_t opcode,
            const wl_interface *interface,
            uint32_t version,
@@ -232,6 +254,15 @@ extern "C" wl_proxy *wl_proxy_marshal_flags(wl_proxy *proxy, uint32_t opcode,
 
   // wl_proxy_marshal_array_flags is only available starting from Wayland 1.19.91
 #if WAYLAND_VERSION_MAJOR * 10000 + WAYLAND_VERSION_MINOR * 100 + WAYLAND_VERSION_MICRO >= 11991
+  // Requests creating or destroying a proxy change client state and are always sent right away
+  if (BatchRequests && !interface && !(flags & WL_MARSHAL_FLAG_DESTROY) && CanBatchRequest(((wl_proxy_private*)proxy)->interface->methods[opcode].signature)) {
+    uint64_t raw_args[MAX_BATCHED_ARGS] {};
+    memcpy(raw_args, args, sizeof(raw_args));
+    fex_wl_proxy_marshal_batched(proxy, opcode, version, flags,
+                                 raw_args[0], raw_args[1], raw_args[2], raw_args[3], raw_args[4], raw_args[5]);
+    return nullptr;
+  }
+
   return wl_proxy_marshal_array_flags(proxy, opcode, interface, version, flags, args);
 #else
   fprintf(stderr, "Host Wayland version is too old to support FEX thunking\n");
@@ -146,4 +146,15 @@ wl_interface* fexfn_impl_libwayland_client_fex_wl_exchange_interface_pointer(wl_
   return host_interface;
 }
 
+#if WAYLAND_VERSION_MAJOR * 10000 + WAYLAND_VERSION_MINOR * 100 + WAYLAND_VERSION_MICRO >= 11991
+void fexfn_impl_libwayland_client_fex_wl_proxy_marshal_batched(wl_proxy *proxy, uint32_t opcode, uint32_t version, uint32_t flags,
+                                                                uint64_t a_0, uint64_t a_1, uint64_t a_2, uint64_t a_3, uint64_t a_4, uint64_t a_5) {
+  static_assert(sizeof(wl_argument) == sizeof(uint64_t));
+  const uint64_t raw_args[] = { a_0, a_1, a_2, a_3, a_4, a_5 };
+  wl_argument args[std::size(raw_args)];
+  memcpy(args, raw_args, sizeof(args));
+  fexldr_ptr_libwayland_client_wl_proxy_marshal_array_flags(proxy, opcode, nullptr, version, flags, args);
+}
+#endif
+
 EXPORTS(libwayland_client)
@@ -33,6 +33,12 @@ template<> struct fex_gen_config<wl_event_queue_destroy> {};
 // wl_proxy_marshal_array_flags is only available starting from Wayland 1.19.91
 #if WAYLAND_VERSION_MAJOR * 10000 + WAYLAND_VERSION_MINOR * 100 + WAYLAND_VERSION_MICRO >= 11991
 template<> struct fex_gen_config<wl_proxy_marshal_array_flags> {};
+
+// Request that creates no object and only has integer or object arguments, passed as the raw wl_argument bits.
+// These are fire-and-forget, so they're queued until the next non-batched call (e.g. wl_display_flush or dispatch).
+void fex_wl_proxy_marshal_batched(wl_proxy*, uint32_t opcode, uint32_t version, uint32_t flags,
+                                  uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t);
+template<> struct fex_gen_config<fex_wl_proxy_marshal_batched> : fexgen::custom_host_impl, fexgen::batchable {};
 #endif
 
 // Guest notifies host about its interface. Host returns its corresponding interface pointer
@@ -189,105 +189,6 @@ extern "C" {
     return ret;
   }
 
-  xcb_generic_event_t * xcb_wait_for_event(xcb_connection_t * a_0){
-    auto ret = fexfn_pack_xcb_wait_for_event(a_0);
-
-    if (ret) {
-      // Usable size
-      size_t Usable = FEX_malloc_usable_size(ret);
-
-      // This will be a bit wasteful but this is an unsized pointer
-      void *NewPtr = malloc(Usable);
-      memcpy(NewPtr, ret, Usable);
-
-      FEX_malloc_free_on_host(ret);
-      ret = (decltype(ret))NewPtr;
-    }
-
-    return ret;
-  }
-
-  xcb_generic_event_t * xcb_poll_for_event(xcb_connection_t * a_0){
-    auto ret = fexfn_pack_xcb_poll_for_event(a_0);
-    if (ret) {
-      // Usable size
-      size_t Usable = FEX_malloc_usable_size(ret);
-
-      // This will be a bit wasteful but this is an unsized pointer
-      void *NewPtr = malloc(Usable);
-      memcpy(NewPtr, ret, Usable);
-
-      FEX_malloc_free_on_host(ret);
-      ret = (decltype(ret))NewPtr;
-    }
-
-    return ret;
-  }
-
-  xcb_generic_event_t * xcb_poll_for_queued_event(xcb_connection_t * a_0){
-    auto ret = fexfn_pack_xcb_poll_for_queued_event(a_0);
-    if (ret) {
-      // Usable size
-      size_t Usable = FEX_malloc_usable_size(ret);
-
-      // This will be a bit wasteful but this is an unsized pointer
-      void *NewPtr = malloc(Usable);
-      memcpy(NewPtr, ret, Usable);
-
-      FEX_malloc_free_on_host(ret);
-      ret = (decltype(ret))NewPtr;
-    }
-
-    return ret;
-  }
-
-  xcb_generic_event_t * xcb_poll_for_special_event(xcb_connection_t * a_0,xcb_special_event_t * a_1){
-    auto ret = fexfn_pack_xcb_poll_for_special_event(a_0, a_1);
-    if (ret) {
-      // Usable size
-      size_t Usable = FEX_malloc_usable_size(ret);
-
-      // This will be a bit wasteful but this is an unsized pointer
-      void *NewPtr = malloc(Usable);
-      memcpy(NewPtr, ret, Usable);
-
-      FEX_malloc_free_on_host(ret);
-      ret = (decltype(ret))NewPtr;
-    }
-
-    return ret;
-  }
-
-  xcb_generic_event_t * xcb_wait_for_special_event(xcb_connection_t * a_0,xcb_special_event_t * a_1){
-    auto ret = fexfn_pack_xcb_wait_for_special_event(a_0, a_1);
-    if (ret) {
-      // Usable size
-      size_t Usable = FEX_malloc_usable_size(ret);
-
-      // This will be a bit wasteful but this is an unsized pointer
-      void *NewPtr = malloc(Usable);
-      memcpy(NewPtr, ret, Usable);
-
-      FEX_malloc_free_on_host(ret);
-      ret = (decltype(ret))NewPtr;
-    }
-
-    return ret;
-  }
-
-  xcb_generic_error_t * xcb_request_check(xcb_connection_t * a_0,xcb_void_cookie_t a_1){
-    auto ret = fexfn_pack_xcb_request_check(a_0, a_1);
-    if (ret) {
-      // This will be a bit wasteful but this is an unsized pointer
-      void *NewPtr = malloc(sizeof(xcb_generic_error_t));
-      memcpy(NewPtr, ret, sizeof(xcb_generic_error_t));
-
-      FEX_malloc_free_on_host(ret);
-      ret = (decltype(ret))NewPtr;
-    }
-    return ret;
-  }
-
   void * xcb_wait_for_reply(xcb_connection_t * a_0, uint32_t a_1,xcb_generic_error_t ** a_2){
     auto ret = fexfn_pack_xcb_wait_for_reply(a_0, a_1, a_2);
 
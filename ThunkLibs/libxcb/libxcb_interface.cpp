@@ -24,16 +24,16 @@ template<> struct fex_gen_config<FEX_GiveEvents> : fexgen::custom_host_impl, fex
 template<> struct fex_gen_config<xcb_flush> {};
 template<> struct fex_gen_config<xcb_get_maximum_request_length> {};
 template<> struct fex_gen_config<xcb_prefetch_maximum_request_length> {};
-template<> struct fex_gen_config<xcb_wait_for_event> : fexgen::custom_guest_entrypoint {};
-template<> struct fex_gen_config<xcb_poll_for_event> : fexgen::custom_guest_entrypoint {};
-template<> struct fex_gen_config<xcb_poll_for_queued_event> : fexgen::custom_guest_entrypoint {};
-template<> struct fex_gen_config<xcb_poll_for_special_event> : fexgen::custom_guest_entrypoint {};
-template<> struct fex_gen_config<xcb_wait_for_special_event> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<xcb_wait_for_event> : fexgen::returns_host_allocation {};
+template<> struct fex_gen_config<xcb_poll_for_event> : fexgen::returns_host_allocation {};
+template<> struct fex_gen_config<xcb_poll_for_queued_event> : fexgen::returns_host_allocation {};
+template<> struct fex_gen_config<xcb_poll_for_special_event> : fexgen::returns_host_allocation {};
+template<> struct fex_gen_config<xcb_wait_for_special_event> : fexgen::returns_host_allocation {};
 
 template<> struct fex_gen_config<xcb_register_for_special_xge> {};
 template<> struct fex_gen_config<xcb_unregister_for_special_event> {};
 
-template<> struct fex_gen_config<xcb_request_check> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<xcb_request_check> : fexgen::returns_host_allocation {};
 template<> struct fex_gen_config<xcb_discard_reply> {};
 template<> struct fex_gen_config<xcb_discard_reply64> {};
 template<> struct fex_gen_config<xcb_get_extension_data> {};
@@ -0,0 +1,58 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RSI": "0x0",
+    "RBP": "0x11111111",
+    "RDI": "0x5555",
+    "RAX": "0x33333333",
+    "RBX": "0x44444444",
+    "RCX": "0x11111111",
+    "RDX": "0x400"
+  },
+  "Mode": "32BIT"
+}
+%endif
+
+; A run of PUSH is folded into one stack adjustment with paired stores.
+; Same as the 64-bit test, with 4 byte slots and a 32-bit stack pointer.
+mov esp, 0xe0000100
+
+mov eax, 0x11111111
+mov ebx, 0x22222222
+mov ecx, 0x33333333
+mov edx, 0x44444444
+
+mov esi, esp
+mov dword [esp - 16], 0x5555
+
+push eax
+mov ebp, [esp]
+; DF is stored to the context in the middle of the run
+std
+pushfd
+cld
+push ebx
+; Not written yet
+mov edi, [esi - 16]
+push ecx
+mov eax, [esi - 16]
+push edx
+
+pop ebx
+pop ecx
+; Out of registers, check the middle slots in place
+cmp ecx, 0x33333333
+jne .fail
+pop ecx
+cmp ecx, 0x22222222
+jne .fail
+pop edx
+and edx, 0x400
+pop ecx
+
+sub esi, esp
+hlt
+
+.fail:
+mov esi, -1
+hlt
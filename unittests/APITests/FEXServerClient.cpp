@@ -0,0 +1,124 @@
+#include "Common/FEXServerClient.h"
+
+#include <catch2/catch.hpp>
+#include <cstring>
+#include <sys/socket.h>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+TEST_CASE("ProtocolVersion - Old server") {
+  int Sockets[2];
+  REQUIRE(socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, Sockets) == 0);
+
+  // An old FEXServer reads the request and never answers it
+  CHECK(FEXServerClient::RequestProtocolVersion(Sockets[0], 50) == 0);
+
+  FEXServerClient::FEXServerRequestPacket Req{};
+  CHECK(recv(Sockets[1], &Req, sizeof(Req), 0) == sizeof(Req.BasicRequest));
+  CHECK(Req.Header.Type == FEXServerClient::PacketType::TYPE_GET_PROTOCOL_VERSION);
+
+  close(Sockets[0]);
+  close(Sockets[1]);
+}
+
+TEST_CASE("ProtocolVersion - Current server") {
+  int Sockets[2];
+  REQUIRE(socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, Sockets) == 0);
+
+  std::thread Server([Socket = Sockets[1]] {
+    FEXServerClient::FEXServerRequestPacket Req{};
+    if (recv(Socket, &Req, sizeof(Req), 0) > 0 &&
+        Req.Header.Type == FEXServerClient::PacketType::TYPE_GET_PROTOCOL_VERSION) {
+      FEXServerClient::FEXServerResultPacket Res {
+        .ProtocolVersion {
+          .Header {
+            .Type = FEXServerClient::PacketType::TYPE_GET_PROTOCOL_VERSION,
+          },
+          .Version = FEXServerClient::PROTOCOL_VERSION,
+        },
+      };
+      send(Socket, &Res, sizeof(Res), 0);
+    }
+  });
+
+  CHECK(FEXServerClient::RequestProtocolVersion(Sockets[0], 5000) == FEXServerClient::PROTOCOL_VERSION);
+  Server.join();
+
+  close(Sockets[0]);
+  close(Sockets[1]);
+}
+
+TEST_CASE("ProtocolVersion - Gated requests") {
+  // Without SetupClient there is no negotiated version, none of the newer requests may be sent
+  int Sockets[2];
+  REQUIRE(socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC | SOCK_NONBLOCK, 0, Sockets) == 0);
+
+  REQUIRE(FEXServerClient::GetServerProtocolVersion() == 0);
+  CHECK(FEXServerClient::RequestRootFSEntriesFD(Sockets[0]) == -1);
+  CHECK(FEXServerClient::RequestCodeObjectFD(Sockets[0], "Test") == -1);
+  CHECK(FEXServerClient::RequestRootFSCacheFD(Sockets[0]) == -1);
+  CHECK(!FEXServerClient::RequestCacheRootFSFile(Sockets[0], "usr/lib/libc.so.6"));
+
+  int LogFD {-1};
+  CHECK(FEXServerClient::RequestLogRing(Sockets[0], &LogFD) == nullptr);
+  CHECK(LogFD == -1);
+
+  uint8_t Data[64];
+  CHECK(recv(Sockets[1], Data, sizeof(Data), 0) == -1);
+  CHECK(errno == EAGAIN);
+
+  close(Sockets[0]);
+  close(Sockets[1]);
+}
+
+namespace {
+  // Builds a TYPE_MSG packet the same way the client writes it to the ring
+  std::vector<uint8_t> MakeMsgPacket(const char *Message, size_t MessageLength) {
+    FEXServerClient::Logging::PacketMsg Msg {
+      .Header = FEXServerClient::Logging::FillHeader(FEXServerClient::Logging::PacketTypes::TYPE_MSG),
+      .MessageLength = MessageLength,
+    };
+
+    std::vector<uint8_t> Data(sizeof(Msg) + strlen(Message) + 1);
+    memcpy(Data.data(), &Msg, sizeof(Msg));
+    memcpy(Data.data() + sizeof(Msg), Message, strlen(Message) + 1);
+    return Data;
+  }
+}
+
+TEST_CASE("LogPacket - Valid") {
+  using namespace FEXServerClient::Logging;
+  auto Data = MakeMsgPacket("Hello", 6);
+  CHECK(GetPacketSize(Data.data(), Data.size()) == Data.size());
+
+  auto Wake = FillHeader(PacketTypes::TYPE_WAKE);
+  CHECK(GetPacketSize(reinterpret_cast<const uint8_t*>(&Wake), sizeof(Wake)) == sizeof(Wake));
+}
+
+TEST_CASE("LogPacket - Corrupt lengths") {
+  using namespace FEXServerClient::Logging;
+
+  // MessageLength past the end of the data, including one that would wrap the offset
+  auto Data = MakeMsgPacket("Hello", 7);
+  CHECK(GetPacketSize(Data.data(), Data.size()) == 0);
+  Data = MakeMsgPacket("Hello", ~0ULL);
+  CHECK(GetPacketSize(Data.data(), Data.size()) == 0);
+  Data = MakeMsgPacket("Hello", RING_DATA_SIZE + 1);
+  CHECK(GetPacketSize(Data.data(), Data.size()) == 0);
+
+  // Empty or unterminated message
+  Data = MakeMsgPacket("Hello", 0);
+  CHECK(GetPacketSize(Data.data(), Data.size()) == 0);
+  Data = MakeMsgPacket("Hello", 5);
+  CHECK(GetPacketSize(Data.data(), Data.size()) == 0);
+
+  // Truncated header
+  Data = MakeMsgPacket("Hello", 6);
+  CHECK(GetPacketSize(Data.data(), sizeof(PacketMsg) - 1) == 0);
+  CHECK(GetPacketSize(Data.data(), sizeof(PacketHeader) - 1) == 0);
+
+  // Unknown packet type
+  reinterpret_cast<PacketHeader*>(Data.data())->PacketType = static_cast<PacketTypes>(0xFF);
+  CHECK(GetPacketSize(Data.data(), Data.size()) == 0);
+}
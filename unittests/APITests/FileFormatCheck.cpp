@@ -0,0 +1,26 @@
+#include "Common/FileFormatCheck.h"
+
+#include <catch2/catch.hpp>
+
+TEST_CASE("IsSharedLibraryName - Libraries") {
+  auto Name = GENERATE("libc.so",
+    "libc.so.6",
+    "libstdc++.so.6.0.30",
+    "ld-linux-x86-64.so.2",
+    "libGL.so.1.7.0");
+
+  CHECK(FEX::FormatCheck::IsSharedLibraryName(Name));
+}
+
+TEST_CASE("IsSharedLibraryName - Not libraries") {
+  auto Name = GENERATE("",
+    "so",
+    "foo.sock",
+    "foo.sorted",
+    "foo.soname",
+    "libc.a",
+    "libfoo.sox",
+    "resolv.conf");
+
+  CHECK(!FEX::FormatCheck::IsSharedLibraryName(Name));
+}
@@ -0,0 +1,76 @@
+#include "LinuxSyscalls/PageBitmap.h"
+
+#include <catch2/catch.hpp>
+
+#include <memory>
+
+namespace {
+  // Matches the 32-bit allocator's reserved pages
+  constexpr uint64_t BASE_KEY = 16;
+  constexpr uint64_t TOP_KEY = 0xFFFF'F000ULL >> 12;
+
+  std::unique_ptr<FEX::HLE::PageBitmap> MakeBitmap() {
+    auto Bitmap = std::make_unique<FEX::HLE::PageBitmap>();
+    Bitmap->Set(0, BASE_KEY);
+    Bitmap->Set(TOP_KEY, 1);
+    return Bitmap;
+  }
+}
+
+TEST_CASE("PageBitmap - Bottom up") {
+  auto Bitmap = MakeBitmap();
+  CHECK(Bitmap->FindFreeRange(BASE_KEY, TOP_KEY, 4) == BASE_KEY);
+
+  Bitmap->Set(BASE_KEY, 4);
+  CHECK(Bitmap->FindFreeRange(BASE_KEY, TOP_KEY, 4) == BASE_KEY + 4);
+
+  // A single used page in the middle of the next candidate
+  Bitmap->Set(BASE_KEY + 6, 1);
+  CHECK(Bitmap->FindFreeRange(BASE_KEY, TOP_KEY, 4) == BASE_KEY + 7);
+  CHECK(Bitmap->FindFreeRange(BASE_KEY, TOP_KEY, 2) == BASE_KEY + 4);
+}
+
+TEST_CASE("PageBitmap - Top down") {
+  auto Bitmap = MakeBitmap();
+  CHECK(Bitmap->FindFreeRangeTopDown(TOP_KEY, BASE_KEY, 4) == TOP_KEY - 4);
+
+  Bitmap->Set(TOP_KEY - 4, 4);
+  CHECK(Bitmap->FindFreeRangeTopDown(TOP_KEY, BASE_KEY, 4) == TOP_KEY - 8);
+
+  Bitmap->Set(TOP_KEY - 6, 1);
+  CHECK(Bitmap->FindFreeRangeTopDown(TOP_KEY, BASE_KEY, 4) == TOP_KEY - 10);
+  CHECK(Bitmap->FindFreeRangeTopDown(TOP_KEY, BASE_KEY, 1) == TOP_KEY - 5);
+}
+
+TEST_CASE("PageBitmap - Skips full words") {
+  auto Bitmap = MakeBitmap();
+
+  // Fill everything below the top page except for one run that straddles a word boundary
+  Bitmap->Set(BASE_KEY, TOP_KEY - BASE_KEY);
+  Bitmap->Reset(0x8'0000 - 2, 4);
+
+  CHECK(Bitmap->FindFreeRange(BASE_KEY, TOP_KEY, 4) == 0x8'0000 - 2);
+  CHECK(Bitmap->FindFreeRangeTopDown(TOP_KEY, BASE_KEY, 4) == 0x8'0000 - 2);
+  CHECK(Bitmap->FindFreeRange(BASE_KEY, TOP_KEY, 5) == 0);
+  CHECK(Bitmap->FindFreeRangeTopDown(TOP_KEY, BASE_KEY, 5) == 0);
+
+  CHECK(Bitmap->IsRangeFree(0x8'0000 - 2, 4));
+  CHECK(!Bitmap->IsRangeFree(0x8'0000 - 3, 4));
+}
+
+TEST_CASE("PageBitmap - Retry below a rejected range") {
+  // When the host rejects a top down candidate, the allocator searches again from the page below it.
+  // The next candidate must not overlap the rejected range.
+  auto Bitmap = MakeBitmap();
+  constexpr size_t Pages = 8;
+
+  uint64_t Top = TOP_KEY;
+  for (size_t i = 0; i < 4; ++i) {
+    const uint64_t LowerPage = Bitmap->FindFreeRangeTopDown(Top, BASE_KEY, Pages);
+    REQUIRE(LowerPage == TOP_KEY - Pages * (i + 1));
+    Top = LowerPage - 1;
+  }
+
+  // Nothing left below the bottom
+  CHECK(Bitmap->FindFreeRangeTopDown(BASE_KEY + Pages - 2, BASE_KEY, Pages) == 0);
+}
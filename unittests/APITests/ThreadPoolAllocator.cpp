@@ -0,0 +1,114 @@
+#include <catch2/catch.hpp>
+#include <FEXCore/Utils/ThreadPoolAllocator.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+  constexpr size_t BufferSize = 4096;
+  // No pool time threshold is hit during the test, so every disown after the first has a cheap reown
+  using PoolAllocation = FEXCore::Utils::FixedSizePooledAllocation<uint32_t*, 5000, 500>;
+
+  // Claims, fills and checks a buffer so any two threads sharing a buffer is detected
+  bool ClaimRelease(FEXCore::Utils::IntrusivePooledAllocator &Allocator, uint32_t ThreadID, size_t Iterations) {
+    bool Success = true;
+    for (size_t i = 0; i < Iterations; ++i) {
+      PoolAllocation Object{Allocator, BufferSize};
+      auto Buffer = Object.ReownOrClaimBuffer();
+      std::fill(Buffer, Buffer + BufferSize / sizeof(uint32_t), ThreadID);
+      for (size_t j = 0; j < BufferSize / sizeof(uint32_t); j += 64) {
+        Success &= Buffer[j] == ThreadID;
+      }
+      Object.DelayedDisownBuffer();
+      Object.UnclaimBuffer();
+    }
+    return Success;
+  }
+}
+
+TEST_CASE("ClaimDisownReown") {
+  using FEXCore::Utils::IntrusivePooledAllocator;
+  FEXCore::Utils::PooledAllocatorMalloc Allocator;
+  IntrusivePooledAllocator::BufferOwnedFlag Flag {IntrusivePooledAllocator::ClientFlags::FLAG_FREE};
+  IntrusivePooledAllocator::BufferOwnedFlag Flag2 {IntrusivePooledAllocator::ClientFlags::FLAG_FREE};
+
+  auto Buffer = Allocator.ClaimBuffer(BufferSize, &Flag);
+  REQUIRE(IntrusivePooledAllocator::IsClientBufferOwned(Flag));
+
+  // Disowned buffer inside of the pool duration comes straight back
+  Allocator.DisownBuffer(Buffer);
+  REQUIRE(!IntrusivePooledAllocator::IsClientBufferOwned(Flag));
+  REQUIRE(Allocator.ReownOrClaimBuffer(Buffer, BufferSize, &Flag) == Buffer);
+  REQUIRE(IntrusivePooledAllocator::IsClientBufferOwned(Flag));
+
+  // A disowned buffer inside of the pool duration can't be claimed by another client
+  Allocator.DisownBuffer(Buffer);
+  auto Buffer2 = Allocator.ClaimBuffer(BufferSize, &Flag2);
+  REQUIRE(Buffer2 != Buffer);
+  REQUIRE(Allocator.ReownOrClaimBuffer(Buffer, BufferSize, &Flag) == Buffer);
+
+  Allocator.UnclaimBuffer(Buffer, &Flag);
+  Allocator.UnclaimBuffer(Buffer2, &Flag2);
+  REQUIRE(IntrusivePooledAllocator::IsClientBufferFree(Flag));
+  REQUIRE(IntrusivePooledAllocator::IsClientBufferFree(Flag2));
+}
+
+TEST_CASE("ClaimUnclaim") {
+  FEXCore::Utils::PooledAllocatorMalloc Allocator;
+
+  PoolAllocation Object{Allocator, BufferSize};
+  auto Buffer = Object.ReownOrClaimBuffer();
+  // The first disown starts the usage period, with no usage counted yet it also unclaims
+  Object.DelayedDisownBuffer();
+
+  // Unclaimed buffer of the same size gets reused by the next claim
+  REQUIRE(Object.ReownOrClaimBuffer() == Buffer);
+  // Inside of the period the buffer is only disowned
+  Object.DelayedDisownBuffer();
+
+  // The disowned buffer is still claimed, so another client gets a new buffer
+  PoolAllocation Object2{Allocator, BufferSize};
+  auto Buffer2 = Object2.ReownOrClaimBuffer();
+  REQUIRE(Buffer2 != Buffer);
+
+  // Disowned buffer inside of the pool duration is reowned
+  REQUIRE(Object.ReownOrClaimBuffer() == Buffer);
+  Object.DelayedDisownBuffer();
+  Object.UnclaimBuffer();
+  Object2.DelayedDisownBuffer();
+  Object2.UnclaimBuffer();
+
+  // Unclaimed buffers get reused by the next client
+  PoolAllocation Object3{Allocator, BufferSize};
+  auto Buffer3 = Object3.ReownOrClaimBuffer();
+  REQUIRE((Buffer3 == Buffer || Buffer3 == Buffer2));
+  Object3.DelayedDisownBuffer();
+  Object3.UnclaimBuffer();
+}
+
+// Threads sharing the allocator never get the same buffer.
+// Throughput of this is measured by the ThreadPoolAllocator host benchmark.
+TEST_CASE("ClaimReleaseThreads") {
+  constexpr size_t Threads = 8;
+  constexpr size_t Iterations = 2000;
+
+  FEXCore::Utils::PooledAllocatorMalloc Allocator;
+  std::atomic<bool> Success {true};
+  std::vector<std::thread> Workers;
+
+  for (size_t i = 0; i < Threads; ++i) {
+    Workers.emplace_back([&, i]() {
+      if (!ClaimRelease(Allocator, i, Iterations)) {
+        Success = false;
+      }
+    });
+  }
+
+  for (auto &Worker : Workers) {
+    Worker.join();
+  }
+
+  REQUIRE(Success);
+}
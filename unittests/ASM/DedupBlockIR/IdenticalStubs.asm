@@ -0,0 +1,57 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "R8":  "0x0",
+    "R9":  "0x1e",
+    "R10": "0x108"
+  },
+  "Env": { "FEX_DEDUPBLOCKIR" : "1" }
+}
+%endif
+
+; Byte identical stubs at different addresses share their IR.
+; Each copy has to see its own RIP, and load its own data through a RIP relative access.
+%macro Stub 2
+align 64
+%1:
+  lea rax, [rel %1]
+  mov edx, [rel %1 + 32]
+  ret
+align 32
+  dd %2
+%endmacro
+
+; R8 collects any difference between the RIP a copy saw and its address, R9 sums the data the copies loaded
+%macro CallStub 2
+  call %1
+  lea rcx, [rel %1]
+  sub rax, rcx
+  or r8, rax
+  add %2, edx
+%endmacro
+
+xor r8d, r8d
+xor r9d, r9d
+xor r10d, r10d
+
+; The first pass stores the IR, the second pass only hits the cache
+mov r12d, 2
+.Loop:
+CallStub StubA, r9d
+CallStub StubB, r9d
+CallStub StubC, r9d
+CallStub StubD, r9d
+dec r12d
+jnz .Loop
+
+; Patch the load in copy C to a ret. Only C changes, D still runs the shared IR.
+mov byte [rel StubC + 7], 0xC3
+mov edx, 0x100
+CallStub StubC, r10d
+CallStub StubD, r10d
+hlt
+
+Stub StubA, 1
+Stub StubB, 2
+Stub StubC, 4
+Stub StubD, 8
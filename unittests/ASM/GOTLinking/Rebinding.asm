@@ -0,0 +1,78 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "R8": "0x12331",
+    "R9": "0x1"
+  },
+  "Env": { "FEX_GOTLINKING" : "1" }
+}
+%endif
+
+; PLT style stubs jump through a GOT slot, the slot's value when the stub is compiled is linked directly.
+; Rewriting the slot afterwards has to reach the new target, without the stub being recompiled.
+; The slots are on their own page so writing them doesn't invalidate the stubs.
+%macro Record 0
+  shl r8, 4
+  or r8, rax
+%endmacro
+
+xor r8d, r8d
+xor r9d, r9d
+
+; Resolved before the stub is compiled
+lea rax, [rel TargetA]
+mov [rel GOT1], rax
+call Stub1
+Record
+
+; Rebound to another target
+lea rax, [rel TargetB]
+mov [rel GOT1], rax
+call Stub1
+Record
+
+; Lazily bound, the slot points at the resolver when the stub is compiled
+lea rax, [rel Resolver]
+mov [rel GOT2], rax
+call Stub2
+Record
+call Stub2
+Record
+
+; Back to the target the stub was compiled with
+lea rax, [rel TargetA]
+mov [rel GOT1], rax
+call Stub1
+Record
+hlt
+
+Stub1:
+jmp [rel GOT1]
+
+Stub2:
+jmp [rel GOT2]
+
+; Binds GOT2 on the first call, like the dynamic linker's lazy resolver
+Resolver:
+inc r9
+lea rax, [rel TargetC]
+mov [rel GOT2], rax
+jmp rax
+
+TargetA:
+mov eax, 1
+ret
+
+TargetB:
+mov eax, 2
+ret
+
+TargetC:
+mov eax, 3
+ret
+
+align 4096
+GOT1:
+dq 0
+GOT2:
+dq 0
@@ -0,0 +1,100 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "XMM1":  ["0x0000000000001064", "0x0000000000000000"],
+    "XMM2":  ["0x000000000000FFFF", "0x0000000000000000"],
+    "XMM3":  ["0x000000000000FFFF", "0x0000000000000000"],
+    "XMM4":  ["0xFFFFFFFF00FFFFFF", "0xFFFFFFFFFFFFFFFF"],
+    "XMM5":  ["0x00000000000000DB", "0x0000000000000000"],
+    "XMM6":  ["0x00000000000000E4", "0x0000000000000000"],
+    "XMM7":  ["0xFFFFFFFF0000FFFF", "0x0000000000000000"],
+    "XMM8":  ["0x0000FFFFFFFF0000", "0x000000000000FFFF"],
+    "XMM9":  ["0x08C1084108810001", "0x0041084100C108C1"],
+    "XMM10": ["0x0040000100C108C1", "0x0000000000000000"],
+    "R8":  "0x0",
+    "R9":  "0x3",
+    "R10": "0x2",
+    "R11": "0x8"
+  }
+}
+%endif
+
+; Strings where the NUL terminators decide the result: no NUL in either operand, an empty set or string,
+; and NULs at the same position in both. Covers the equal any and equal each modes with every polarity.
+; Each result's OF, SF, ZF and CF are stored to .flags.
+%macro StoreFlags 1
+  pushfq
+  pop rax
+  and eax, 0x8C1
+  mov [rel .flags + %1 * 2], ax
+%endmacro
+
+%macro CompareMask 5
+  movdqu xmm12, [rel %2]
+  movdqu xmm13, [rel %3]
+  pcmpistrm xmm12, xmm13, %4
+  StoreFlags %1
+  movaps xmm%5, xmm0
+%endmacro
+
+%macro CompareIndex 5
+  movdqu xmm12, [rel %2]
+  movdqu xmm13, [rel %3]
+  pcmpistri xmm12, xmm13, %4
+  StoreFlags %1
+  mov %5, rcx
+%endmacro
+
+; Equal any, neither operand has a NUL
+CompareMask 0, .set_full, .str_full, 0b00000000, 1
+; Equal any, empty set, negative masked
+CompareMask 1, .empty, .str_full, 0b00110000, 2
+; Equal each, empty string, negative
+CompareMask 2, .set_full, .empty, 0b00011000, 3
+; Equal each, NUL at the same position, byte mask
+CompareMask 3, .str_a, .str_b, 0b01001000, 4
+; Equal each words, NULs at different positions
+CompareMask 4, .words_a, .words_b, 0b00001001, 5
+; Equal each words, negative masked
+CompareMask 5, .words_a, .words_b, 0b00111001, 6
+; Equal any words, set without a NUL, word mask
+CompareMask 6, .words_set, .words_b, 0b01000001, 7
+; Equal any words, negative masked word mask
+CompareMask 7, .words_set, .words_a, 0b01110001, 8
+
+; Equal each, least significant index
+CompareIndex 8, .str_a, .str_b, 0b00001000, r8
+; Equal each, most significant index
+CompareIndex 9, .str_a, .str_b, 0b01011000, r9
+; Equal any, neither operand has a NUL
+CompareIndex 10, .set_full, .str_full, 0b00000000, r10
+; Equal any words, empty string has no match
+CompareIndex 11, .words_set, .empty, 0b00000001, r11
+
+movaps xmm9, [rel .flags]
+movaps xmm10, [rel .flags + 16]
+hlt
+
+align 16
+.set_full:
+db "aeiouAEIOUxyzXYZ"
+.str_full:
+db "The quick brown!"
+.empty:
+times 16 db 0
+.str_a:
+db "abcdefg"
+times 9 db 0
+.str_b:
+db "abcXefg"
+times 9 db 0
+.words_a:
+dw 0x3042, 0x3044, 0x3046, 0x3048, 0x304A, 0, 0, 0
+.words_b:
+dw 0x3042, 0x3044, 0x1234, 0x3048, 0x304A, 0x304C, 0, 0
+.words_set:
+dw 0x3048, 0x1234, 0x3042, 0x5555, 0x6666, 0x7777, 0x8888, 0x9999
+
+align 16
+.flags:
+times 32 db 0
@@ -0,0 +1,27 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RCX": "0x1010",
+    "RDX": "0x1030"
+  },
+  "Env": { "FEX_MULTIBLOCK" : "1", "FEX_TIEREDCOMPILATION" : "1", "FEX_TIERUPTHRESHOLD" : "0" }
+}
+%endif
+
+; The merge block is reached from a block laid out after it, which isn't a back edge.
+; Nothing defined in the entry block may be moved in to the block between it and the merge.
+mov rax, 1
+mov rcx, 0x1000
+cmp rax, 0
+jz c_path
+
+add rcx, 0x10
+
+merge:
+mov rdx, rcx
+add rdx, 0x20
+hlt
+
+c_path:
+add rcx, 0x100
+jmp merge
@@ -0,0 +1,46 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x8",
+    "RBX": "0x7FFF0000",
+    "RCX": "0xFFFFFF80",
+    "RDX": "0x8",
+    "RSI": "0x2",
+    "RDI": "0xFFFFFF02"
+  },
+  "Env": { "FEX_MULTIBLOCK" : "1" }
+}
+%endif
+
+; TEST followed by JL/JGE against the sign bit, branching back to the loop header.
+; These are lowered to tbnz/tbz when the target is already bound, the operands are 8-bit and 16-bit
+; with the bits above them set to the opposite sign.
+
+; 8-bit jge back edge, loops until the sign bit gets set
+mov ecx, 0xFFFFFF00
+mov eax, 0
+loop_jge:
+inc eax
+add cl, 0x10
+test cl, cl
+jge loop_jge
+
+; 16-bit jl back edge, loops while the sign bit is set
+mov ebx, 0x7FFF8000
+mov edx, 0
+loop_jl:
+inc edx
+add bx, 0x1000
+test bx, bx
+jl loop_jl
+
+; 8-bit jle back edge, zero keeps looping
+mov esi, 0
+mov edi, 0xFFFFFF00
+loop_jle:
+inc esi
+test dil, dil
+lea edi, [edi + 1]
+jle loop_jle
+
+hlt
@@ -0,0 +1,43 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0xEEEE43EE41EEEEEE",
+    "RBX": "0x4D4CEE4AEEEE4746",
+    "RCX": "0xEEEEEEEEEEEE4FEE",
+    "RSI": "0xEEEEEEEEEEEEEEEE"
+  }
+}
+%endif
+
+; Only the top bit of each mask byte selects it, and bytes that aren't selected keep their old value.
+; The destination isn't aligned, the selected bytes straddle 8-byte boundaries.
+mov rdx, 0xe0000000
+
+mov rax, 0x4847464544434241
+mov [rdx + 8 * 0], rax
+mov rax, 0x504F4E4D4C4B4A49
+mov [rdx + 8 * 1], rax
+
+mov rax, 0x40C0810100FF7F80
+mov [rdx + 8 * 2], rax
+mov rax, 0x10903FFE80008000
+mov [rdx + 8 * 3], rax
+
+mov rax, 0xEEEEEEEEEEEEEEEE
+mov [rdx + 8 * 4], rax
+mov [rdx + 8 * 5], rax
+mov [rdx + 8 * 6], rax
+mov [rdx + 8 * 7], rax
+
+movaps xmm0, [rdx + 8 * 0]
+movaps xmm1, [rdx + 8 * 2]
+
+lea rdi, [rdx + 8 * 4 + 3]
+maskmovdqu xmm0, xmm1
+
+mov rax, qword [rdx + 8 * 4]
+mov rbx, qword [rdx + 8 * 5]
+mov rcx, qword [rdx + 8 * 6]
+mov rsi, qword [rdx + 8 * 7]
+
+hlt
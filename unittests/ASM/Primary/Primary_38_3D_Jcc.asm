@@ -0,0 +1,110 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x0",
+    "R8":  "0x5",
+    "R9":  "0xA",
+    "R10": "0x5",
+    "R11": "0x2",
+    "R12": "0x1",
+    "R13": "0x12",
+    "R14": "0x1",
+    "R15": "0x6"
+  }
+}
+%endif
+
+; CMP and TEST followed by a flag consumer fold the operands into the select or branch.
+; Checks 8-bit and 16-bit signed and unsigned conditions, and that flags written by an
+; instruction between the CMP and the consumer aren't folded from the CMP operands.
+%macro check 3
+  %2 %%taken
+  jmp %%next
+%%taken:
+  or %1, %3
+%%next:
+%endmacro
+
+; r8: 8-bit, 0x80 is below 0x01 signed but above unsigned
+mov eax, 0x00000080
+mov ecx, 0xFFFFFF01
+xor r8d, r8d
+cmp al, cl
+check r8, jl, 1
+cmp al, cl
+check r8, jb, 2
+cmp al, cl
+check r8, ja, 4
+cmp al, cl
+check r8, jg, 8
+
+; r9: 16-bit, 0x7FFF is above 0x8000 signed but below unsigned
+mov eax, 0xFFFF7FFF
+mov ecx, 0x00008000
+xor r9d, r9d
+cmp ax, cx
+check r9, jl, 1
+cmp ax, cx
+check r9, jb, 2
+cmp ax, cx
+check r9, ja, 4
+cmp ax, cx
+check r9, jge, 8
+
+; r10: INC between the CMP and the branch. CF is kept from the CMP, ZF comes from the INC
+mov eax, 1
+mov ecx, 2
+xor r10d, r10d
+cmp eax, ecx
+inc eax
+check r10, jb, 1
+cmp eax, ecx
+inc ecx
+check r10, je, 2
+cmp eax, ecx
+add ecx, 0
+check r10, jne, 4
+
+; r11: ADD between the TEST and the branch
+mov eax, 0x80
+xor r11d, r11d
+test al, al
+add eax, eax
+check r11, js, 1
+test al, al
+add eax, 0
+check r11, jne, 2
+check r11, jbe, 4
+
+; r12, r13: SETcc and CMOVcc between the CMP and the branch still see the CMP flags
+mov eax, 0xFF
+mov ecx, 0x01
+xor r12d, r12d
+xor r13d, r13d
+mov edx, 2
+cmp al, cl
+setl r12b
+cmova r13d, edx
+check r13, jl, 0x10
+
+; r14: CLC between the CMP and the branch
+mov eax, 1
+mov ecx, 2
+xor r14d, r14d
+cmp eax, ecx
+clc
+check r14, jae, 1
+
+; r15: Flags of the CMP reach the branch in the next block
+mov eax, 0x7F
+mov ecx, 0x80
+xor r15d, r15d
+cmp al, cl
+jmp .next_block
+.next_block:
+check r15, jg, 2
+cmp al, cl
+check r15, jb, 4
+
+mov rax, 0
+hlt
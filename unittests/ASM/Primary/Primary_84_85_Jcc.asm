@@ -0,0 +1,118 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x0",
+    "RCX": "0x0",
+    "R8": "0x5",
+    "R9": "0xE",
+    "R10": "0x2",
+    "R11": "0x5",
+    "R12": "0xE",
+    "R13": "0x2",
+    "R14": "0x5"
+  }
+}
+%endif
+
+; 8-bit and 16-bit TEST followed by JL/JGE/JLE/JBE is folded into a compare of the sign extended result against zero.
+; Each case sets one bit in a result register for every branch taken.
+; The bits of the 32-bit register above the operand size have the opposite sign, so using the wrong sign bit is caught.
+%macro check 3
+  %2 %%taken
+  jmp %%next
+%%taken:
+  or %1, %3
+%%next:
+%endmacro
+
+; r8: 8-bit, sign set
+mov eax, 0x00000080
+xor r8d, r8d
+test al, al
+check r8, jl, 1
+test al, al
+check r8, jge, 2
+test al, al
+check r8, jle, 4
+test al, al
+check r8, jbe, 8
+
+; r9: 8-bit, result zero
+mov eax, 0xFFFFFF80
+xor r9d, r9d
+test al, 0x7F
+check r9, jl, 1
+test al, 0x7F
+check r9, jge, 2
+test al, 0x7F
+check r9, jle, 4
+test al, 0x7F
+check r9, jbe, 8
+
+; r10: 8-bit, positive with the upper bits set
+mov eax, 0xFFFFFF7F
+mov ecx, 0xFFFFFFFF
+xor r10d, r10d
+test al, cl
+check r10, jl, 1
+test al, cl
+check r10, jge, 2
+test al, cl
+check r10, jle, 4
+test al, cl
+check r10, jbe, 8
+
+; r11: 16-bit, sign set
+mov eax, 0x00008001
+xor r11d, r11d
+test ax, ax
+check r11, jl, 1
+test ax, ax
+check r11, jge, 2
+test ax, ax
+check r11, jle, 4
+test ax, ax
+check r11, jbe, 8
+
+; r12: 16-bit, result zero
+mov eax, 0xFFFF8000
+xor r12d, r12d
+test ax, 0x7FFF
+check r12, jl, 1
+test ax, 0x7FFF
+check r12, jge, 2
+test ax, 0x7FFF
+check r12, jle, 4
+test ax, 0x7FFF
+check r12, jbe, 8
+
+; r13: 16-bit, positive with the upper bits set
+mov eax, 0xFFFF7FFF
+mov ecx, 0xFFFF8001
+xor r13d, r13d
+test ax, cx
+check r13, jl, 1
+test ax, cx
+check r13, jge, 2
+test ax, cx
+check r13, jle, 4
+test ax, cx
+check r13, jbe, 8
+
+; r14: 16-bit memory operand, sign set
+mov dword [rsp - 8], 0x0000C000
+mov eax, 0x00008000
+xor r14d, r14d
+test word [rsp - 8], ax
+check r14, jl, 1
+test word [rsp - 8], ax
+check r14, jge, 2
+test word [rsp - 8], ax
+check r14, jle, 4
+test word [rsp - 8], ax
+check r14, jbe, 8
+
+mov rax, 0
+mov rcx, 0
+hlt
+
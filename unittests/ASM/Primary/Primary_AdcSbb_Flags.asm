@@ -0,0 +1,114 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x0",
+    "RBX": "0x91",
+    "RCX": "0x45",
+    "RDX": "0x894",
+    "RSI": "0x44",
+    "R8": "0x55",
+    "R9": "0x84",
+    "R10": "0x894",
+    "R11": "0x55",
+    "R12": "0x95",
+    "R13": "0x44",
+    "R14": "0x95",
+    "R15": "0x814"
+  }
+}
+%endif
+
+; 32-bit and 64-bit ADC and SBB take SF/ZF/CF/OF from a host adcs/sbcs with the carry passed in through the host carry.
+; Checks carry in and carry out for both, and that SBB's borrow is inverted on the way in and out of the host carry.
+; Each result is CF/PF/AF/ZF/SF/OF from rflags.
+%macro get_flags 1
+  pushfq
+  pop %1
+  and %1, 0x8D5
+%endmacro
+
+; 32-bit adc, the carry in alone causes the carry out
+mov eax, 0xFFFFFFFF
+stc
+adc eax, 0
+get_flags r8
+
+; 32-bit adc, no carry in and no carry out
+mov eax, 0xFFFFFFFE
+clc
+adc eax, 1
+get_flags r9
+
+; 64-bit adc, carry in makes the signed overflow
+mov rax, 0x7FFFFFFFFFFFFFFF
+mov rcx, 0
+stc
+adc rax, rcx
+get_flags r10
+
+; 64-bit adc, carry out and signed overflow with the carry in
+mov rax, 0x8000000000000000
+mov rcx, 0x7FFFFFFFFFFFFFFF
+stc
+adc rax, rcx
+get_flags r11
+
+; 32-bit sbb, the borrow in alone causes the borrow out
+mov eax, 0
+stc
+sbb eax, 0
+get_flags r12
+
+; 32-bit sbb, equal operands without borrow in. No borrow even though the host carry is set
+mov eax, 5
+clc
+sbb eax, 5
+get_flags r13
+
+; 32-bit sbb, equal operands with borrow in
+mov eax, 5
+stc
+sbb eax, 5
+get_flags r14
+
+; 64-bit sbb, borrow in makes the signed overflow
+mov rax, 0x8000000000000000
+mov rcx, 0
+stc
+sbb rax, rcx
+get_flags r15
+
+; 64-bit sbb, the borrow in doesn't affect an operation that would already borrow
+mov rax, 1
+mov rcx, 3
+stc
+sbb rax, rcx
+get_flags rbx
+
+; adcx only writes CF, the carry in alone causes the carry out. Define the other flags first
+mov rax, 0xFFFFFFFFFFFFFFFF
+xor ecx, ecx
+add ecx, 0
+stc
+adcx rax, rcx
+get_flags rcx
+
+; adox only writes OF and uses it as its carry. Set OF and clear CF first
+mov eax, 0x7FFFFFFF
+add eax, 1
+clc
+mov eax, 0xFFFFFFFF
+mov edx, 0
+adox eax, edx
+get_flags rdx
+
+; adox without carry in doesn't carry out
+mov eax, 0xFFFFFFFE
+xor esi, esi
+add esi, 0
+mov esi, 1
+adox eax, esi
+get_flags rsi
+
+mov rax, 0
+hlt
@@ -0,0 +1,108 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x0",
+    "RBX": "0x810",
+    "RCX": "0x885",
+    "RDX": "0x881",
+    "RSI": "0x44",
+    "RDI": "0x55",
+    "RBP": "0x810",
+    "R8": "0x845",
+    "R9": "0x55",
+    "R10": "0x894",
+    "R11": "0x805",
+    "R12": "0x95",
+    "R13": "0x814",
+    "R14": "0x44",
+    "R15": "0x95"
+  }
+}
+%endif
+
+; ADD, SUB, CMP, NEG, INC and DEC produce SF/ZF/CF/OF straight from a host compare when the backend supports flags.
+; Checks every operand size, since 8-bit and 16-bit operands get moved to the top of a 32-bit register first,
+; and that CF comes out as the x86 borrow for subtraction rather than the host carry.
+; Each result is CF/PF/AF/ZF/SF/OF from rflags.
+%macro get_flags 1
+  pushfq
+  pop %1
+  and %1, 0x8D5
+%endmacro
+
+; 8-bit add, carry out and signed overflow
+mov eax, 0x80
+add al, 0x80
+get_flags r8
+
+; 16-bit add, carry out without overflow
+mov eax, 0xFFFF
+add ax, 1
+get_flags r9
+
+; 32-bit add, signed overflow without carry
+mov eax, 0x7FFFFFFF
+add eax, 1
+get_flags r10
+
+; 64-bit add, carry out and signed overflow
+mov rax, -1
+mov rcx, 0x8000000000000000
+add rax, rcx
+get_flags r11
+
+; 8-bit sub, borrow
+mov eax, 0
+sub al, 1
+get_flags r12
+
+; 16-bit sub, signed overflow without borrow
+mov eax, 0x8000
+sub ax, 1
+get_flags r13
+
+; 32-bit sub, equal operands. No borrow even though the host carry is set
+mov eax, 5
+sub eax, 5
+get_flags r14
+
+; 64-bit sub, borrow
+mov rax, 1
+mov rcx, 2
+sub rax, rcx
+get_flags r15
+
+; 8-bit cmp, signed overflow without borrow
+mov eax, 0x80
+cmp al, 0x7F
+get_flags rbx
+
+; 64-bit cmp, borrow and signed overflow
+mov rax, 0x7FFFFFFFFFFFFFFF
+mov rcx, 0x8000000000000000
+cmp rax, rcx
+get_flags rcx
+
+; 8-bit neg, borrow and signed overflow
+mov eax, 0x80
+neg al
+get_flags rdx
+
+; 32-bit neg of zero, no borrow
+mov eax, 0
+neg eax
+get_flags rsi
+
+; inc and dec leave CF alone
+mov eax, -1
+stc
+inc eax
+get_flags rdi
+
+mov eax, 0x80
+clc
+dec al
+get_flags rbp
+
+mov rax, 0
+hlt
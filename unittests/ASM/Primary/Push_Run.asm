@@ -0,0 +1,51 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RSI": "0x0",
+    "R8":  "0x1111111111111111",
+    "R9":  "0x5555",
+    "R10": "0x3333333333333333",
+    "R11": "0x4444444444444444",
+    "R12": "0x3333333333333333",
+    "R13": "0x2222222222222222",
+    "R14": "0x400",
+    "R15": "0x1111111111111111"
+  }
+}
+%endif
+
+; A run of PUSH is folded into one stack adjustment with paired stores.
+; Checks a context store in the middle of the run, memory reads between the stores
+; and a read of a slot that a later PUSH of the same run overwrites.
+mov rax, 0x1111111111111111
+mov rbx, 0x2222222222222222
+mov rcx, 0x3333333333333333
+mov rdx, 0x4444444444444444
+
+mov rsi, rsp
+mov qword [rsp - 32], 0x5555
+
+push rax
+mov r8, [rsp]
+; DF is stored to the context in the middle of the run
+std
+pushfq
+cld
+push rbx
+; Not written yet
+mov r9, [rsi - 32]
+push rcx
+mov r10, [rsi - 32]
+push rdx
+
+pop r11
+pop r12
+pop r13
+pop r14
+and r14, 0x400
+pop r15
+
+; The balanced run leaves the stack pointer where it started
+sub rsi, rsp
+
+hlt
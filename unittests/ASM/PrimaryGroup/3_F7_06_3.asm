@@ -0,0 +1,236 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "R8":  "0x0",
+    "R9":  "0xC0",
+    "R10": "0x0"
+  }
+}
+%endif
+
+; 128bit divides with a non-zero upper half that still fit a 64bit quotient.
+; Each row is RDX, RAX, divisor, quotient, remainder. The rows cover divisors with the top bit set and a divisor of 1,
+; both ends of the normalization shift, and quotient digits that need zero, one and two corrections.
+; R8 counts the mismatching rows, R10 holds the row number + 1 of the last mismatch.
+lea rsi, [rel table]
+lea rdi, [rel table_end]
+xor r8, r8
+xor r9, r9
+xor r10, r10
+
+.loop:
+mov rdx, [rsi + 8 * 0]
+mov rax, [rsi + 8 * 1]
+div qword [rsi + 8 * 2]
+inc r9
+cmp rax, [rsi + 8 * 3]
+jne .mismatch
+cmp rdx, [rsi + 8 * 4]
+je .next
+
+.mismatch:
+inc r8
+mov r10, r9
+
+.next:
+add rsi, 8 * 5
+cmp rsi, rdi
+jne .loop
+
+hlt
+
+align 8
+table:
+dq 0x0000000000000001, 0x0000000000000000, 0xFFFFFFFFFFFFFFFF, 0x0000000000000001, 0x0000000000000001
+dq 0xFFFFFFFFFFFFFFFE, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFE
+dq 0x7FFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0x8000000000000000, 0xFFFFFFFFFFFFFFFF, 0x7FFFFFFFFFFFFFFF
+dq 0x0000000000000001, 0x0000000000000000, 0x0000000000000002, 0x8000000000000000, 0x0000000000000000
+dq 0x0000000000000000, 0xFFFFFFFFFFFFFFFF, 0x0000000000000003, 0x5555555555555555, 0x0000000000000000
+dq 0x0000000000000001, 0x0000000000000001, 0x0000000000000003, 0x5555555555555555, 0x0000000000000002
+dq 0x00000000FFFFFFFE, 0x0000000000000000, 0x00000000FFFFFFFF, 0xFFFFFFFEFFFFFFFE, 0x00000000FFFFFFFE
+dq 0x0000000000000001, 0x0000000000000000, 0x0000000100000000, 0x0000000100000000, 0x0000000000000000
+dq 0x0000000123456789, 0xABCDEF0123456789, 0x000000123456789A, 0x1000000000A5FFF1, 0x00000000007A788F
+dq 0x0000000000000001, 0x0000000000000000, 0x8000000000000001, 0x0000000000000001, 0x7FFFFFFFFFFFFFFF
+dq 0x0000000664796BB4, 0xECFE55124396A76F, 0x000000093BB4FC9E, 0xB13CCA29FC6B559B, 0x00000008E7173DC5
+dq 0x00002D1619C61EB2, 0x04E5D13801769E3E, 0x0000899324E3C0BE, 0x53E59CA89D1B7A96, 0x00003F82001F22EA
+dq 0x000B52ED0896E4AA, 0xFFFFFFFFFFFFFFFF, 0x0077CEE8E477E21C, 0x1832460F2F7DF646, 0x006E2815C8454457
+dq 0x000000042A4E2B55, 0x25E22C6B89E7E9F6, 0x00000005B63CBE3E, 0xBAAEBAF2C4CCF943, 0x00000000B18FD1BC
+dq 0x0000000000000000, 0x9188D1B60E0A619E, 0x0000000000000001, 0x9188D1B60E0A619E, 0x0000000000000000
+dq 0xBAD9B06BA12EB623, 0x0000000000000000, 0xD7DB850994A71B60, 0xDD9934A069700BAC, 0x514104D6978C7B80
+dq 0x000000000000014A, 0x758984BFD981BDEE, 0x000000000000026E, 0x8802476A7EB4112E, 0x000000000000002A
+dq 0x0006997E448F0A1F, 0x4D50208E1C6FA60A, 0x000975DBD3AFF6B6, 0xB29609C8D463F3C6, 0x0005950D3AC61346
+dq 0x00000088D7B7F5EC, 0x73CF6DDB52F9E815, 0x00000223878503E4, 0x3FFB3FC0B9B10569, 0x000001DBAFB3DB91
+dq 0x00000000376E49B7, 0x5D34D5224424721C, 0x000000009D1BB066, 0x5A525FDD2903B0CD, 0x000000000480106E
+dq 0x3D5AAC3BF2555E96, 0x9980A0C5455C2035, 0xBAA28196F0F6A7BF, 0x54284247B3F75066, 0x93A31A14C8609A1B
+dq 0x0029F1FC7109E6AB, 0x0000000000000000, 0x004057C95211FE4E, 0xA6E3082E019222DE, 0x0010203F1A231C5C
+dq 0x2A57F24552C00B43, 0xAFF2F050F33CA4F9, 0x33E4045148F171F8, 0xD0E64E760A0D2DE3, 0x1E3297645A83FE11
+dq 0x000000001C611E56, 0x59C763AD36ED67DE, 0x00000002B1449794, 0x0A8A53BB0C88DA06, 0x000000012F9DD266
+dq 0x000F0934F4013256, 0xB808EBB9938AD335, 0x005EF2906CC2AD1E, 0x288A5547C49DA351, 0x000F7D861251F2B7
+dq 0x000114B411554A19, 0x063DEA260FE255F4, 0x00084DCF0ECFA21F, 0x21526A77B527F658, 0x0006F112D4FFD14C
+dq 0x00091F1DCA7F2196, 0xEA22127F7E70CAA0, 0x0075DC98ABF412BE, 0x13CFF5A1182CB3A1, 0x0055870CA82E2722
+dq 0x0001DD00DE01CD40, 0xFFFFFFFFFFFFFFFF, 0x0002199BE7778DD3, 0xE32402C78809A710, 0x000026B176977DCF
+dq 0x2B91C074FFB818AC, 0x9DC683B97E905645, 0x405779BD430FF053, 0xAD5A11A5157982DF, 0x3862F20F9568D7F8
+dq 0x0000000000000008, 0x55DB234560FFDEE4, 0x000000000000001D, 0x4994CC402F7B94ED, 0x000000000000000B
+dq 0x0A19B19838E4B6B2, 0x0000000000000000, 0xBD6045F5F5F31DA2, 0x0DA75C3EDA4F3940, 0xAFCD6C4148A18580
+dq 0x8254D5ECD6374D14, 0xFF44D497B5E23F17, 0x9FB8F748EBA93B01, 0xD0E47A3ED56A638F, 0x190D59515D1EE688
+dq 0x0000000000002332, 0xB23A3294CD0268B4, 0x0000000000002AB3, 0xD306F6012343EACA, 0x0000000000001976
+dq 0x0000000000000001, 0xB081E9F264722379, 0x0000000000000006, 0x4815A6FDBB685B3E, 0x0000000000000005
+dq 0x000000000000000A, 0xFFCCEB1AF9496AD6, 0x000000000000000F, 0xBBB853F0BB492941, 0x0000000000000007
+dq 0x0168DEE6DBF3395C, 0xE6EBD61F5893DB65, 0x01998071D9A1249E, 0xE1992B276B6C547E, 0x0019FA51DE97FDA1
+dq 0x00000000001E8C8B, 0x83E3010EFCF0473B, 0x0000000000300D78, 0xA2BFE7E6289B405F, 0x00000000001547B3
+dq 0x00000021AFD60385, 0x4CFCF4B400000000, 0x00000029E30D79FE, 0xCDE23BC12A50D7A0, 0x0000001DFABF6F40
+dq 0x0000000000000001, 0x8AE352BDE92A87C4, 0x0000000000000003, 0x83A11B94A30E2D41, 0x0000000000000001
+dq 0x00011786FAAC36BF, 0xBA3C71B01A42498A, 0x00011F0CF7ABE944, 0xF94A593487F10357, 0x0000E6B77616376E
+dq 0x00000000D92B7D7B, 0xF61B32CBC732400C, 0x00000001ED6668A4, 0x70ADA6CF117156AA, 0x00000000A5A5AB24
+dq 0x00000000F6762484, 0xB832EE526712FE46, 0x00000001F6C8182C, 0x7D7D7AB756A3ADCD, 0x00000000647DE70A
+dq 0x48E8FF4EDCB8B3DA, 0x5097DB49FC40151A, 0x90631452DE207752, 0x814545C9FC1832F7, 0x89D97E116BEEF0FC
+dq 0x00000000000042FB, 0x1198202858B73B6D, 0x0000000000006CFF, 0x9D517539BCCA2DCF, 0x000000000000463C
+dq 0x0000006334148CBF, 0xF0C70DB0C1C3E032, 0x00000098B548BB02, 0xA64E0041ED701AB3, 0x0000000BF20AE9CC
+dq 0x0000000000001533, 0x0000000000000000, 0x0000000000005430, 0x407697A95617F250, 0x0000000000005100
+dq 0x03B23E9F14BB3D2E, 0x950F964F0B665125, 0x06BDDAEA71C3C93A, 0x8C5BCD989D87B8A4, 0x00AED941C1C1B7FD
+dq 0x00000005A99DF30B, 0x80E6C1F38E4EB15A, 0x0000001CA4532B2C, 0x329C9D0A52068274, 0x00000007C1AAC96A
+dq 0x000000000000382E, 0xC1F375E8FA8C73E2, 0x0000000000008598, 0x6BA9107E65BFA512, 0x0000000000001732
+dq 0x0000000002E53193, 0x1BEB26BFB4AC69D5, 0x00000000053B789C, 0x8DA836AAE18D1355, 0x00000000040DCA09
+dq 0x00000002C3CB6542, 0x775B036D5C815C1B, 0x00000024F510CB1A, 0x1326D5281C92073D, 0x00000010D51F40E9
+dq 0x0000000000073344, 0xFA19BA52CE1AEABB, 0x0000000000419BA2, 0x1C186040948BE0ED, 0x00000000003A15C1
+dq 0x0000000000006360, 0xD130944C2FFC7130, 0x0000000000008FBD, 0xB0FE7883C4F314A1, 0x0000000000004753
+dq 0x082AD2D68D461EE2, 0xAA43908200000000, 0x0BDFB23915FF0344, 0xB0164288350447E3, 0x07DF4B00A3E83EB4
+dq 0x000000138DF50B7E, 0x4FA2239900000000, 0x0000003B668FB49E, 0x5446444C3E51ADA8, 0x000000302AA4B250
+dq 0x00001360C087208D, 0xE89CEC2600000000, 0x000013F5BB0DC774, 0xF8893DC1F55DDE55, 0x00000D0178522E7C
+dq 0x005FDAE295C66226, 0xFCB0DD5CC5D3CE5B, 0x02EFD4E52225568D, 0x20A388AC77ED80AA, 0x0122E598C238D4B9
+dq 0x00000000000006D4, 0x4BECC1A63E2ACF42, 0x0000000000000749, 0xEFFB0C52095E0CBD, 0x000000000000025D
+dq 0x0000B359D82A457E, 0x4AB8DB1859FF2C7D, 0x0000DAB241F195CD, 0xD1F1815DCDC2DCC2, 0x0000C8D515D57B23
+dq 0x000536196890CDEF, 0xB590CC28C65EDF45, 0x00126D7E02BC6309, 0x486579D4F33A1328, 0x000BA120628BBADD
+dq 0x0000000000D37091, 0x0429D1F31C5BD122, 0x0000000002856467, 0x53DE87E077A70DC7, 0x0000000000608A11
+dq 0x000004EF2486F4EA, 0xB2B13BAD351A84EE, 0x0000065A92A64737, 0xC6CD171F665E8A1D, 0x00000645E5AECDB3
+dq 0x68ECB658C7664BED, 0xFFFFFFFFFFFFFFFF, 0x8C0F3FE0EBEC217C, 0xBFC7D75FF72C9E2A, 0x35A5C1952947F9A7
+dq 0x000000009E96DD6B, 0x8BA5290D880629C0, 0x000000009F00D477, 0xFF5564A4734A5F35, 0x000000006E9C041D
+dq 0x0000000038D2A8B4, 0x0000000000000000, 0x00000001408B1144, 0x2D619AEAADE3E11B, 0x00000000B3DC69D4
+dq 0x0000000003677CDA, 0xFFFFFFFFFFFFFFFF, 0x0000000003C83FA8, 0xE66ABA0E53AB5FB6, 0x0000000002CB668F
+dq 0x00099A8C5497AFE0, 0xB0598E72DB78CA4A, 0x000AAEF843CF875E, 0xE62051AE4EA32438, 0x00093655022FF5BA
+dq 0x00EFF0929536D59D, 0xCB34A21DD13EA930, 0x0195C9BCB534F471, 0x975EFEFF6D109CB3, 0x00D11ACC7432E22D
+dq 0x0000000000000000, 0xC6F0386F7E65C6DB, 0x0000000000000002, 0x63781C37BF32E36D, 0x0000000000000001
+dq 0x0000000000000006, 0x0000000000000000, 0x000000000000001E, 0x3333333333333333, 0x0000000000000006
+dq 0x00000000000B8127, 0xFFFFFFFFFFFFFFFF, 0x00000000002DE5C2, 0x402B0AA4337FFD0F, 0x000000000000CFA1
+dq 0x01398A69F26A8366, 0x531A0E95072074BA, 0x0149A0F4C6D72D85, 0xF381693A7D31D3A3, 0x002CD54B6A24DA0B
+dq 0x00000000000017B0, 0xFFFFFFFFFFFFFFFF, 0x0000000000002610, 0x9F57DB021A0FF946, 0x000000000000079F
+dq 0x0000049ACA31E119, 0x7A21F90900000000, 0x000004F7B7EEF938, 0xED4B1176CC8458CB, 0x000003BEDEF52098
+dq 0x000000183C8092BC, 0xFFFFFFFFFFFFFFFF, 0x000001E69087794C, 0x0CC06C4AF5FCBAC0, 0x000001A80973CEFF
+dq 0x00000008B3B827B9, 0x932E934D5AC2DB5A, 0x0000000E904102EC, 0x98F74CDAA6CDD924, 0x0000000D9728662A
+dq 0x0000000B4DC2BC33, 0x940DA5BB465DFD84, 0x0000003CC4FC9A72, 0x2F9E5FF7E17C6074, 0x0000003C48C541DC
+dq 0x00000000000494B5, 0x38E1D68B3A4EB0FE, 0x000000000005DB0B, 0xC84519C5E37C938B, 0x0000000000057105
+dq 0x0000000000000324, 0x18A2188A00000000, 0x00000000000008C4, 0x5BBB9F7F60836C26, 0x00000000000002E8
+dq 0x0000000000000004, 0x54D847E7BC2DC23D, 0x000000000000000B, 0x64CDD7FDCB49FA62, 0x0000000000000007
+dq 0x000000000000345A, 0xB5D2F96AD68B1F45, 0x0000000000003C2B, 0xDEC1418CA5846BF3, 0x0000000000000974
+dq 0x01003DC33F1C4371, 0x6178CB2D89654987, 0x33E019B0B25A1361, 0x04F0868F9930BCD3, 0x2BC6FBE8C7BC1494
+dq 0x000C317523D3FD2B, 0x0000000000000000, 0x001069B8E51FB348, 0xBE2EAA43C842A5B9, 0x0009DBA084FA08F8
+dq 0x000000000000011E, 0xBC7FA3AF4BE88851, 0x00000000000002C0, 0x68448B815704548E, 0x00000000000001D1
+dq 0x0000000009C3AFFE, 0x0000000000000000, 0x00000000B0AD4F46, 0x0E25FA1AC1F7AC4B, 0x00000000896CBE7E
+dq 0x0003D6E885520F41, 0x596EC6F000000000, 0x0004969D4B7218B1, 0xD63804C2C7EA3CAF, 0x0000D21C866DA301
+dq 0x0000000000000928, 0x1C8F9AFC44F427C2, 0x0000000000000FC9, 0x948041DC144A0DD1, 0x0000000000000FA9
+dq 0x00000030C51602AB, 0x33E3CC0253B3C349, 0x0000003818BE9BFD, 0xDE9055C8A1BC83CB, 0x000000207FEF9AAA
+dq 0x000091C52E127A3F, 0xAD9BF45E00000000, 0x0000BDDEE3AF976E, 0xC48A3D7AF448DCEA, 0x000014D38C6D0D74
+dq 0x00000A84A2812CFE, 0x73CD4DC6382A8018, 0x00001907A541701F, 0x6B93AE4F1D63F4AE, 0x0000037EA7D5BF06
+dq 0x0000000000000000, 0x4D8134AA2E461385, 0x0000000000000001, 0x4D8134AA2E461385, 0x0000000000000000
+dq 0x001734E180B67062, 0xA086378DDA901ECE, 0x001DA3B5A0340DF4, 0xC870226AAACB1BD5, 0x00080FF6F94BC6CA
+dq 0x0213904B8A875E90, 0xE6CEA2F10990F396, 0x023B1F4E7501A9F4, 0xEE44AA757E1AF6C6, 0x00019F7D962F08DE
+dq 0x8045D3F1531135C8, 0x5423162A00000000, 0xEE940020F5329597, 0x89A3C50C91BECE6B, 0x4733AABB4269F7E3
+dq 0x0000003B52BD77DB, 0x8A9CFA83327DA129, 0x000000721B92A40C, 0x85175DCAE60C3F1F, 0x0000002E4CCCCFB5
+dq 0x0000000779D240D0, 0x0000000000000000, 0x0000000E82823EB2, 0x83E6062ED52E3069, 0x00000006AED6E8FE
+dq 0x000000117008E75B, 0x41EC1C81705AE26D, 0x00000021E8777C5F, 0x83A6ADCCE286A35D, 0x00000020F10836EA
+dq 0xE2DF436F933C149B, 0xCD0108C5D527A240, 0xEC7D61E2C2596966, 0xF596C214C5714B6E, 0x6E2D6ADB1CD5766C
+dq 0x00056E1E9FE6412D, 0x8712031398C38413, 0x000736CE3EFAA374, 0xC0B1FA134FE936F5, 0x0006FA3CE3D69E0F
+dq 0x0000000002812B54, 0x0000000000000000, 0x000000000404BEF4, 0x9F8D86B216C59159, 0x00000000006D692C
+dq 0x000000C804854462, 0xAA7C722A00000000, 0x00000115421C1ECC, 0xB8AE833987BA767F, 0x0000000D49A2B0CC
+dq 0x00000172905B388F, 0xA263CDF551E16E97, 0x000003043C685054, 0x7AD7FF841AE16474, 0x0000014A11683887
+dq 0x0000433F557A2A13, 0xAAF3D5509A0DF8F5, 0x0001D1E7F54890EA, 0x24F341D43964020B, 0x00019C09C965EAE7
+dq 0x000000B92BD1A3BB, 0xB896CAFB677C0E1E, 0x000000FE5F5D7199, 0xBA5B1C0697AF73D3, 0x00000003ECD8B203
+dq 0x0000000000000001, 0xC6FC66675AF7F88E, 0x0000000000000004, 0x71BF1999D6BDFE23, 0x0000000000000002
+dq 0x00000000049C8169, 0xA4BF3C5100000000, 0x00000000067AE2A3, 0xB62D1B25FE0E55C8, 0x0000000003D4D1A8
+dq 0x0000000049F127F1, 0xBD647B2B642702FD, 0x000000009C4B010E, 0x791CFFEAB639BC3C, 0x000000007DAE7BB5
+dq 0x00E58D1C449982FA, 0xFC91AB1FF6F907A1, 0x01B0321B05B851B0, 0x87F7FFB0DE60280B, 0x002CD61CA94A0511
+dq 0x0000000007236AB3, 0x7EF146713FA18C37, 0x00000000154656FD, 0x55E55F06ED02C5B7, 0x00000000026EAC5C
+dq 0x00000000089CA3D9, 0x1A2430D2E014A048, 0x00000000CC78BA8E, 0x0AC839E50719885A, 0x00000000C0A99A5C
+dq 0x0000000000019746, 0x7619672A6C49EF3E, 0x000000000001A70E, 0xF6739559B65294BD, 0x00000000000181E8
+dq 0x000000000000010B, 0x1FB4403C6CD73386, 0x000000000000017E, 0xB303D298F438DB46, 0x0000000000000112
+dq 0xAF1098460646C5C4, 0xFFFFFFFFFFFFFFFF, 0xF3F49549D1E22B87, 0xB7B54910BF301A46, 0x7E875E2DC16C6315
+dq 0x0000044FFEC68BFB, 0x69E72C9A00000000, 0x0000076A456E747D, 0x94E261497953E561, 0x000000B6096B0BA3
+dq 0x0000000000000006, 0xE2D5970518D9DF08, 0x0000000000000007, 0xFBD55EB795D5FB4A, 0x0000000000000002
+dq 0x00000003416D65F2, 0x988533147FFF91F2, 0x000000050CC7F1EF, 0xA5099C09F11FD8C6, 0x000000049E47CB18
+dq 0x0000000735342ABD, 0x7A8719416A8795FB, 0x0000000B2C109DB7, 0xA5294DE91ABB811E, 0x00000007166EE389
+dq 0x51FB5E4D4340ACB0, 0xF9D67280151FFA7A, 0xD4D274E4F1822DB1, 0x629D57309B6BC135, 0x78BC29C3ACBF13D5
+dq 0x0000000000000001, 0xFFFFFFFFFFFFFFFF, 0x000000000000000D, 0x2762762762762762, 0x0000000000000005
+dq 0x00000011FD04BA0A, 0x5EB905EC00000000, 0x0000001647687731, 0xCEB2C37F8AA71EB6, 0x00000001D2CC852A
+dq 0x00000000102BB32B, 0x2BF99E4AD4232EE9, 0x000000005A07355A, 0x2DFB76A420C45C44, 0x000000003A24AB01
+dq 0x000002B229CCBF67, 0x30D2A2E37F1933BC, 0x00000473C3940B3A, 0x9B042107A7A98AD8, 0x000001246CD876CC
+dq 0x0000000004A887E8, 0x97C2F11600000000, 0x0000000006DB9B41, 0xADE4A4651CBBBC52, 0x000000000329892E
+dq 0x00012F52814A1C0D, 0x39BCD3F6E42CD8BE, 0x000198694A719816, 0xBE20D1E8424E100C, 0x0001589E4AA457B6
+dq 0x0000044947F75997, 0x8F4663FC63B43E82, 0x000006178F81ABF0, 0xB41E0CB2B8A278BE, 0x000002B7CAFE2262
+dq 0x0000000000000001, 0x0000000000000000, 0x0000000000000006, 0x2AAAAAAAAAAAAAAA, 0x0000000000000004
+dq 0x0000000000017EA0, 0x7342B7A6802C70E1, 0x000000000001E8E4, 0xC85B485F9C9693F7, 0x000000000001D0E5
+dq 0x0002D64B83A479AE, 0xFFFFFFFFFFFFFFFF, 0x0003E34F4413C826, 0xBACEC62695ACCA1D, 0x000059E1164C57B1
+dq 0x0000000000001096, 0x701D73F3A5692AC5, 0x0000000000001B84, 0x9A5407777E75F2AB, 0x0000000000000199
+dq 0x006CBEB3870D705C, 0x2762055052811A0C, 0x00872095F0E426C8, 0xCE04B2C56D69C7AB, 0x0010D8E7FFEDBA74
+dq 0x8E2AD2FDAD5760C2, 0xB553060503D7814C, 0x8F195AF4F3167672, 0xFE55465A5B4DA897, 0x3174B612BD92D40E
+dq 0x000B195AEC15F761, 0xAD6450D4163AAA45, 0x003B627108B59CC6, 0x2FD8C2769C3AF25E, 0x00085D25087BED91
+dq 0x000000A4794ADFBB, 0x21A232676664CEA7, 0x000001B59DDD2FE9, 0x60370B1F461B3D92, 0x00000090E641F6C5
+dq 0x001A0A498DB3E0F4, 0x3C764A1800000000, 0x003FDBC7649597E6, 0x68643AED28C8CAD3, 0x002B1ED97328516E
+dq 0x000000001253BF90, 0xFFFFFFFFFFFFFFFF, 0x000000002CCB44D8, 0x68BD91E64415C7E4, 0x0000000012BAC79F
+dq 0x00002ED49FF68415, 0x538911EEA8D75E70, 0x0000C1BC72CC8277, 0x3DE1969C8AF1B9C5, 0x000041958F27F9DD
+dq 0x000000180F23BF0B, 0xBA78874F0C9CE656, 0x0000007D03305A76, 0x3144A93CFCCA9A3A, 0x00000035B4216B9A
+dq 0x0000000000001816, 0xFFFFFFFFFFFFFFFF, 0x00000000000019FA, 0xED68044FC3A34D11, 0x0000000000001465
+dq 0x0681E34FBA41259A, 0x3382C38300000000, 0x0EA7C7AB34D53C26, 0x71ABB081DED02C94, 0x0516A0E3FB82B208
+dq 0x000000000000081A, 0x0000000000000000, 0x0000000000001422, 0x670412AD0D037A16, 0x0000000000001114
+dq 0x0000000000000032, 0x5AB8982B5348E3D2, 0x0000000000000076, 0x6D3E4F6429ED17A0, 0x0000000000000012
+dq 0x0000000000000011, 0x9B4FB0F9D02A797C, 0x0000000000000230, 0x080C7C33A56679D1, 0x000000000000004C
+dq 0x0000000000000006, 0x1F4AC85948450473, 0x0000000000000039, 0x1B7F10FD133B98C7, 0x0000000000000024
+dq 0x11DA5AFD39E4E1BC, 0xA36C14DD00000000, 0x1593A91EF29D1D44, 0xD3D16B52377C60F1, 0x10CE3293E62DF2FC
+dq 0x0000000009359EA3, 0x87B6E97CA2FD8C89, 0x0000000018DA87E2, 0x5EDC32EDD4A4D596, 0x000000000B1AE41D
+dq 0x0000018AC0843523, 0x0000000000000000, 0x0000039E103F0E5E, 0x6D1FF4C1C179F289, 0x0000008D0A3E73B2
+dq 0x79B7B904A9E47924, 0xCDF5792FBDF9CF39, 0x88C69003BCBC7DED, 0xE3D0FAC7337D1578, 0x15959E991B915721
+dq 0x000000003225BB0D, 0x8F0CC14EE3A59A92, 0x000000005C91FA33, 0x8AAE559F203508AB, 0x0000000051C2E281
+dq 0x0000000003F0710B, 0x725F496A33F71911, 0x000000000726F03B, 0x8CFFD28D4AE22770, 0x00000000023F0241
+dq 0x000000160E88277C, 0xE85F2F0579B45100, 0x000000172BD7D0CD, 0xF3AFD587AFA2B357, 0x0000001467A30455
+dq 0x286C5E791C432556, 0xFFFFFFFFFFFFFFFF, 0x36324E6709D5AB56, 0xBEF10DD120A443EA, 0x2F281CBB93C1E163
+dq 0x0000000C6C6E203B, 0x9F32C39717908320, 0x00000027C3A595DD, 0x4FFB6EBE5AF77E25, 0x0000001306A4142F
+dq 0x039ED006BB9295B9, 0x202DF12600000000, 0x045E628E49902ECC, 0xD4261768FDF3F3D5, 0x014637F2E6F96C44
+dq 0x000000012CECC501, 0xC6CF9E06BE4B4951, 0x0000000139EC165C, 0xF5669C3356D8BFA1, 0x0000000066829575
+dq 0x024118B36B7971C5, 0xABB9E9C514C27166, 0x0435432BA06401F6, 0x8924101222337BD2, 0x00051A7065C5A39A
+dq 0x00015427BDF1F555, 0x466404B187D65708, 0x0001F0B37B36CB35, 0xAF50F188151BB7AD, 0x0001B7B850F52137
+dq 0x19C8237BD68FA021, 0xC36B275E6B8C89D2, 0x28F3DFE7A5C54067, 0xA12A48DFF95D9F47, 0x0F7D08245A6CB441
+dq 0x00000001FAD28072, 0xB6A1D49022FF7FA9, 0x0000000CC3CD48DF, 0x27B45B5854B6DB97, 0x000000050D08BF20
+dq 0x00000000003390DD, 0x90602AAFE39A98F8, 0x000000000119C326, 0x2ED9DFCBACEACF22, 0x0000000000A6F3EC
+dq 0x000000000000015F, 0x0000000000000000, 0x00000000000001D6, 0xBF2ED7B190E29654, 0x00000000000001C8
+dq 0x0000000000000000, 0x34CFB7F0DE1BAF34, 0x0000000000000001, 0x34CFB7F0DE1BAF34, 0x0000000000000000
+dq 0x000292811D2B8F33, 0xFFFFFFFFFFFFFFFF, 0x00089CB141FE704D, 0x4C767EC8B0AF2FD4, 0x000305CBEE09DD3B
+dq 0x0002D1EF53EF68F6, 0xFFFFFFFFFFFFFFFF, 0x001DC8F31B46DED1, 0x183CFD06EB8C7C29, 0x000E50A8986D1486
+dq 0x0000000000260E3E, 0xF5B3BE147FE67BC2, 0x000000000029A9F9, 0xE9D440F5CFD30066, 0x000000000011C28C
+dq 0x0000000000006031, 0xA4711D676AC3453E, 0x0000000000039287, 0x1AED5BAA3AFEF71F, 0x00000000000245E5
+dq 0xD4079C7EFD474844, 0x0000000000000000, 0xE15C67C119DA5FA8, 0xF0DB37DCC4B01F05, 0xC525535AA9A6C9B8
+dq 0x0000000000022649, 0xB89A652858895E05, 0x000000000009C0E3, 0x386B74A5F1D8E98F, 0x0000000000000438
+dq 0x000000000001D229, 0xFFFFFFFFFFFFFFFF, 0x000000000018BEC9, 0x12D6A97C70BBFF87, 0x0000000000162D00
+dq 0x0000133777EAF5AD, 0x0000000000000000, 0x0000483A47451146, 0x441C502597D592DD, 0x000000456C482A92
+dq 0x00000B0365402DC9, 0x1ED2F851D16D2B8F, 0x00000BAF4C78DB6B, 0xF149CB22D790B8E5, 0x00000413426BFCD8
+dq 0x0000014AF122A041, 0x23E66EEB00000000, 0x00000190252A5981, 0xD3B9DAB67B404B0D, 0x000000685960A973
+dq 0x0000044971A33CB9, 0x7950B07FFAB6D2A6, 0x00014C89C3F458DA, 0x034CDA34426E327D, 0x000086C73160DC34
+dq 0x0000000000000003, 0xFFFFFFFFFFFFFFFF, 0x000000000000000A, 0x6666666666666666, 0x0000000000000003
+dq 0x000000005F35F348, 0xF1FEB832AE3DC7E3, 0x000000013E0A4180, 0x4CA353282D9AB17F, 0x00000000E8DDC963
+dq 0x00000001B3FCD7CD, 0x54845AC700000000, 0x00000003C92EF980, 0x732966CD8AABC0ED, 0x00000002DBE30480
+dq 0x9C07E80B54605771, 0x6BFB6C7E4A099C8E, 0xDB9CC2EE8DC5155A, 0xB5E23A1637D81357, 0x1C46494A2189ACF8
+dq 0x000000000001D034, 0x0000000000000000, 0x0000000000226873, 0x0D7DBB30BD114B9A, 0x00000000001079D2
+dq 0x01364ABB6D75A754, 0x5622E33C1B849258, 0x03FCF0FD2D635BA9, 0x4DCE2D798ADFBB6A, 0x024B0968CA352B5E
+dq 0x00000000021AE1F5, 0x4FD362D40D4DB981, 0x0000000036897D5E, 0x09E18B762471B7EB, 0x0000000025FB7237
+dq 0x0000000000000369, 0x726C4F500CF9CDBB, 0x0000000000000D24, 0x42781E28BCBB47AB, 0x0000000000000AAF
+dq 0x0000000328E5BE57, 0xAFCCC3D7D9DF4B34, 0x00000003C481D024, 0xD6B2B04351236CC6, 0x0000000040BD1F5C
+dq 0x0000000000000298, 0x64CD661E5F468352, 0x0000000000000AC9, 0x3D9A448E9D49A52E, 0x0000000000000634
+dq 0x000000000000005A, 0x7D8C364B3F1042D1, 0x0000000000000060, 0xF14ECB3B7352D607, 0x0000000000000031
+dq 0x0000000000007F08, 0xC5F62E55E13E5927, 0x000000000000D9C2, 0x9558017F76D8DA24, 0x00000000000085DF
+dq 0x00000000A666EC21, 0x841827C55028775A, 0x0000001B117BD4D7, 0x0625C1D0ABACC37E, 0x00000012C4A1F088
+dq 0x000000000272CE98, 0xAA7618E7AE29D6F5, 0x0000000004D0ED0F, 0x8225D59CFBE54CCE, 0x00000000043FA0E3
+dq 0x0000000000296D94, 0xA78D5D3FF6F631F2, 0x00000000023BE86F, 0x128B514F1CE0F6D7, 0x00000000002B52B9
+dq 0x000000000000573A, 0xFFFFFFFFFFFFFFFF, 0x00000000000089AF, 0xA230D2741B5689FB, 0x0000000000005A6A
+dq 0x0000001B8047B94B, 0xE400C0B6F95AF4B9, 0x00000057D41ACE7E, 0x5028CCA1F074C3FE, 0x000000086A6019B5
+dq 0x00000000000C178E, 0xFFFFFFFFFFFFFFFF, 0x00000000001AE2A1, 0x7323BB8000C33328, 0x00000000000383D7
+dq 0x0000000000000004, 0x9A66DC5000000000, 0x0000000000000006, 0xC4667A0D55555555, 0x0000000000000002
+dq 0x00000C81BA01CFE2, 0xEA0F17EA7AEFBFAB, 0x00001BD63B8A798F, 0x73047FF2C1B1585C, 0x000007E4A083E847
+table_end:
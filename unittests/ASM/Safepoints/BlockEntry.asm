@@ -0,0 +1,44 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x12c",
+    "RBX": "0x1111",
+    "RDX": "0x3b2e",
+    "RSI": "0x1",
+    "RDI": "0x4"
+  },
+  "Env": { "FEX_SAFEPOINTS" : "1" }
+}
+%endif
+
+; With Safepoints every block entry checks for a pause request before running the block.
+; Nothing requests a pause here, every poll has to fall through to the block with the guest state intact.
+mov rbx, 0x1111
+xor eax, eax
+xor edx, edx
+xor esi, esi
+mov ecx, 100
+
+.Loop:
+call func
+add rdx, rax
+dec ecx
+jnz .Loop
+
+; Flags set in one block and read in the next
+stc
+jmp .Next
+.Next:
+setc sil
+
+; Vector registers live across the polls
+mov edi, 4
+movq xmm0, rdi
+jmp .Vector
+.Vector:
+movq rdi, xmm0
+hlt
+
+func:
+add rax, 3
+ret
@@ -0,0 +1,64 @@
+%ifdef CONFIG
+{
+  "HostFeatures": ["AFP"],
+  "RegData": {
+    "R8":  "0x1",
+    "R9":  "0x1fc0",
+    "R10": "0x0",
+    "R11": "0x0",
+    "R12": "0x1fc0",
+    "R13": "0x1f80",
+    "R14": "0x1"
+  }
+}
+%endif
+
+; MXCSR.DAZ is only honoured on hosts that can flush denormal inputs to zero.
+; Checks that LDMXCSR, STMXCSR and FXSAVE round trip it and that it flushes denormal inputs.
+lea rdx, [rel .data]
+mov rsp, 0xe0000000
+
+; Denormal input without DAZ
+movd xmm0, [rdx]
+xorps xmm1, xmm1
+addss xmm0, xmm1
+movd r8d, xmm0
+
+; DAZ set
+ldmxcsr [rdx + 4]
+stmxcsr [rsp - 4]
+mov r9d, [rsp - 4]
+
+movd xmm0, [rdx]
+addss xmm0, xmm1
+movd r10d, xmm0
+
+; Double precision denormal input
+movq xmm2, [rdx + 8]
+mulsd xmm2, [rdx + 16]
+movq r11, xmm2
+
+; FXSAVE stores the MXCSR at offset 24
+sub rsp, 512
+and rsp, ~63
+fxsave [rsp]
+mov r12d, [rsp + 24]
+
+; Clearing DAZ again
+ldmxcsr [rdx + 24]
+stmxcsr [rsp - 4]
+mov r13d, [rsp - 4]
+
+movd xmm0, [rdx]
+addss xmm0, xmm1
+movd r14d, xmm0
+
+hlt
+
+align 8
+.data:
+dd 0x00000001
+dd 0x00001fc0
+dq 0x0000000000000001
+dq 2.0
+dd 0x00001f80
@@ -0,0 +1,39 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x2",
+    "RBX": "0x3",
+    "RDX": "0x4"
+  }
+}
+%endif
+
+; An indirect jump caches its last target in the block, tagged with the invalidation epoch of the target's page.
+; Patching the target invalidates its block, the jump mustn't keep running the stale code.
+lea r15, [rel target]
+
+; Warm up the cache of the jump
+xor ebx, ebx
+mov ecx, 3
+.Loop:
+call site
+add ebx, eax
+dec ecx
+jnz .Loop
+
+; Patch the mov eax, 1 to mov eax, 2
+mov byte [rel target + 1], 2
+call site
+mov edx, eax
+call site
+add edx, eax
+hlt
+
+site:
+jmp r15
+
+; The target is on another page, so the block with the jump isn't invalidated with it and keeps its cache
+align 4096
+target:
+mov eax, 1
+ret
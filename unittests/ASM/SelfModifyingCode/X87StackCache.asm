@@ -0,0 +1,31 @@
+%ifdef CONFIG
+{
+  "Match": "All",
+  "RegData": {
+    "RAX": "0x0",
+    "RBX": "0x2"
+  }
+}
+%endif
+
+; With full SMC checks every instruction gets its own check and the block can end after any of them.
+; The x87 stack cache can't carry dirty slots or TOP past those checks.
+mov rdx, 0xe0000000
+
+fninit
+fld1
+fld1
+
+; patch the fld1 after the pushes to fldz
+mov byte [rel patched_op + 1], 0xEE
+
+patched_op:
+fld1
+faddp
+faddp
+fistp dword [rdx]
+mov ebx, [rdx]
+
+fnstsw ax
+and eax, 0x3800
+hlt
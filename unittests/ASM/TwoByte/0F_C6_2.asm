@@ -0,0 +1,110 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x2222222211111111",
+    "RBX": "0x4444444433333333",
+    "XMM0":  ["0x1111111111111111", "0x1111111111111111"],
+    "XMM1":  ["0x2222222222222222", "0x2222222222222222"],
+    "XMM2":  ["0x3333333333333333", "0x3333333333333333"],
+    "XMM3":  ["0x4444444444444444", "0x4444444444444444"],
+    "XMM4":  ["0x2222222211111111", "0x2222222211111111"],
+    "XMM5":  ["0x4444444433333333", "0x4444444433333333"],
+    "XMM6":  ["0x1111111122222222", "0x3333333344444444"],
+    "XMM7":  ["0x3333333322222222", "0x1111111144444444"],
+    "XMM8":  ["0x4444444433333333", "0x2222222211111111"],
+    "XMM9":  ["0x1111111144444444", "0x3333333322222222"],
+    "XMM10": ["0x1111111111111111", "0x2222222222222222"],
+    "XMM11": ["0x3333333333333333", "0x4444444444444444"],
+    "XMM12": ["0x1111111111111111", "0x3333333333333333"],
+    "XMM13": ["0x2222222222222222", "0x4444444444444444"],
+    "XMM14": ["0x3333333311111111", "0x3333333311111111"],
+    "XMM15": ["0x4444444422222222", "0x4444444422222222"]
+  },
+  "MemoryRegions": {
+    "0x100000000": "4096"
+  }
+}
+%endif
+
+; shufps with the same register as both sources only reads one register, every shuffle that matches a single
+; permute gets lowered to it. Covers each of those mappings.
+
+mov rdx, 0xe0000000
+
+mov rax, 0x2222222211111111
+mov [rdx + 8 * 0], rax
+mov rax, 0x4444444433333333
+mov [rdx + 8 * 1], rax
+
+; Identity
+movaps xmm0, [rdx]
+shufps xmm0, xmm0, 0b11100100
+movaps [rdx + 8 * 2], xmm0
+mov rax, [rdx + 8 * 2]
+mov rbx, [rdx + 8 * 3]
+
+; Broadcast element 0
+movaps xmm0, [rdx]
+shufps xmm0, xmm0, 0b00000000
+
+; Broadcast element 1
+movaps xmm1, [rdx]
+shufps xmm1, xmm1, 0b01010101
+
+; Broadcast element 2
+movaps xmm2, [rdx]
+shufps xmm2, xmm2, 0b10101010
+
+; Broadcast element 3
+movaps xmm3, [rdx]
+shufps xmm3, xmm3, 0b11111111
+
+; Broadcast low 64 bits
+movaps xmm4, [rdx]
+shufps xmm4, xmm4, 0b01000100
+
+; Broadcast high 64 bits
+movaps xmm5, [rdx]
+shufps xmm5, xmm5, 0b11101110
+
+; Swap pairs
+movaps xmm6, [rdx]
+shufps xmm6, xmm6, 0b10110001
+
+; Rotate by one element
+movaps xmm7, [rdx]
+shufps xmm7, xmm7, 0b00111001
+
+; Rotate by two elements
+movaps xmm8, [rdx]
+shufps xmm8, xmm8, 0b01001110
+
+; Rotate by three elements
+movaps xmm9, [rdx]
+shufps xmm9, xmm9, 0b10010011
+
+; Zip low
+movaps xmm10, [rdx]
+shufps xmm10, xmm10, 0b01010000
+
+; Zip high
+movaps xmm11, [rdx]
+shufps xmm11, xmm11, 0b11111010
+
+; Transpose even
+movaps xmm12, [rdx]
+shufps xmm12, xmm12, 0b10100000
+
+; Transpose odd
+movaps xmm13, [rdx]
+shufps xmm13, xmm13, 0b11110101
+
+; Unzip even
+movaps xmm14, [rdx]
+shufps xmm14, xmm14, 0b10001000
+
+; Unzip odd
+movaps xmm15, [rdx]
+shufps xmm15, xmm15, 0b11011101
+
+hlt
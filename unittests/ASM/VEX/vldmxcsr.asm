@@ -14,6 +14,8 @@ lea rdx, [rel .data]
 
 ; Currently we only implement setting the rounding mode and FTZ bit,
 ; so load junk into all the bits and check if we set the mode
+; DAZ (bit 6) is left clear, it is only kept on hosts that support flushing
+; denormal inputs. 15_XX_2_DAZ.asm covers it.
 ;
 ; Result should be the default MXCSR (0x1F80) with the rounding
 ; mode bits (bits 13 and 14) and FTZ bit (bit 15) all set.
@@ -29,4 +31,4 @@ hlt
 
 align 4
 .data:
-dq 0x000000000000FFFF
+dq 0x000000000000FFBF
@@ -0,0 +1,126 @@
+%ifdef CONFIG
+{
+  "HostFeatures": ["AVX"],
+  "RegData": {
+    "XMM0": ["0xEEEEEEEE11110020", "0x111100251111001F", "0x1111001DEEEEEEEE", "0xEEEEEEEE11110022"],
+    "XMM1": ["0x0000000000000000", "0x0000000000000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM2": ["0xEEEEEEEE11110020", "0x1111002A1111001E", "0x0000000000000000", "0x0000000000000000"],
+    "XMM3": ["0x0000000000000000", "0x0000000000000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM4": ["0x1111002111110020", "0x1111002311110022", "0xEEEEEEEEEEEEEEEE", "0x1111002B1111002A"],
+    "XMM5": ["0x0000000000000000", "0x0000000000000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM6": ["0xEEEEEEEE11110023", "0x1111001111110026", "0x0000000000000000", "0x0000000000000000"],
+    "XMM7": ["0x0000000000000000", "0x0000000000000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM8": ["0x0000000100000000", "0x00000005FFFFFFFF", "0xFFFFFFFD00000007", "0x0000000F00000002"],
+    "XMM10":["0x0000000000000003", "0xFFFFFFFFFFFFFFFE", "0x0000000000000006", "0xFFFFFFFFFFFFFFF1"],
+    "XMM11":["0x1111002711110026", "0x1111001D1111001C", "0xEEEEEEEEEEEEEEEE", "0x1111000311110002"],
+    "XMM12":["0x0000000000000000", "0x0000000000000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM13":["0xEEEEEEEE11110023", "0x0000000000000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM14":["0x0000000000000000", "0x0000000000000000", "0x0000000000000000", "0x0000000000000000"]
+  }
+}
+%endif
+
+; Masked off elements keep the destination, the mask is cleared and the rest of the register is zeroed.
+; Indices are signed and the base points at the middle of the table.
+lea rdx, [rel .table + 128]
+
+vmovaps ymm8, [rel .index_d]
+vmovaps ymm9, [rel .index_d]
+vmovaps ymm10, [rel .index_q]
+
+; Dword indices and elements
+vmovaps ymm0, [rel .dest]
+vmovaps ymm1, [rel .mask_d]
+vpgatherdd ymm0, [rdx + ymm8*4], ymm1
+
+vmovaps ymm2, [rel .dest]
+vmovaps ymm3, [rel .mask_d]
+vpgatherdd xmm2, [rdx + xmm8*8], xmm3
+
+; Dword indices, qword elements
+vmovaps ymm4, [rel .dest]
+vmovaps ymm5, [rel .mask_q]
+vpgatherdq ymm4, [rdx + xmm9*8], ymm5
+
+; Qword indices, dword elements
+vmovaps ymm6, [rel .dest]
+vmovaps ymm7, [rel .mask_d]
+vpgatherqd xmm6, [rdx + ymm10*4], xmm7
+
+vmovaps ymm13, [rel .dest]
+vmovaps ymm14, [rel .mask_d]
+vpgatherqd xmm13, [rdx + xmm10*4], xmm14
+
+; Qword indices and elements
+vmovaps ymm11, [rel .dest]
+vmovaps ymm12, [rel .mask_q]
+vpgatherqq ymm11, [rdx + ymm10*8], ymm12
+
+hlt
+
+align 32
+.table:
+dq 0x1111000111110000
+dq 0x1111000311110002
+dq 0x1111000511110004
+dq 0x1111000711110006
+dq 0x1111000911110008
+dq 0x1111000B1111000A
+dq 0x1111000D1111000C
+dq 0x1111000F1111000E
+dq 0x1111001111110010
+dq 0x1111001311110012
+dq 0x1111001511110014
+dq 0x1111001711110016
+dq 0x1111001911110018
+dq 0x1111001B1111001A
+dq 0x1111001D1111001C
+dq 0x1111001F1111001E
+dq 0x1111002111110020
+dq 0x1111002311110022
+dq 0x1111002511110024
+dq 0x1111002711110026
+dq 0x1111002911110028
+dq 0x1111002B1111002A
+dq 0x1111002D1111002C
+dq 0x1111002F1111002E
+dq 0x1111003111110030
+dq 0x1111003311110032
+dq 0x1111003511110034
+dq 0x1111003711110036
+dq 0x1111003911110038
+dq 0x1111003B1111003A
+dq 0x1111003D1111003C
+dq 0x1111003F1111003E
+
+.dest:
+dq 0xEEEEEEEEEEEEEEEE
+dq 0xEEEEEEEEEEEEEEEE
+dq 0xEEEEEEEEEEEEEEEE
+dq 0xEEEEEEEEEEEEEEEE
+
+; Sign bits [1, 0, 1, 1, 0, 1, 1, 0], the other bits are set in masked off elements
+.mask_d:
+dq 0x7FFFFFFF80000000
+dq 0x8000000080000000
+dq 0x800000007FFFFFFF
+dq 0x7FFFFFFF80000000
+
+; Sign bits [1, 1, 0, 1]
+.mask_q:
+dq 0x8000000000000000
+dq 0x8000000000000000
+dq 0x7FFFFFFFFFFFFFFF
+dq 0x8000000000000000
+
+.index_d:
+dq 0x0000000100000000
+dq 0x00000005FFFFFFFF
+dq 0xFFFFFFFD00000007
+dq 0x0000000F00000002
+
+.index_q:
+dq 0x0000000000000003
+dq 0xFFFFFFFFFFFFFFFE
+dq 0x0000000000000006
+dq 0xFFFFFFFFFFFFFFF1
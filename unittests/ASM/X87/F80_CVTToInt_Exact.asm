@@ -0,0 +1,63 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "XMM0":  ["0x0", "0x0"],
+    "XMM1":  ["0x8000000000000000", "0x3fff"],
+    "XMM2":  ["0x8000000000000000", "0xbfff"],
+    "XMM3":  ["0xfffe000000000000", "0x400d"],
+    "XMM4":  ["0x8000000000000000", "0xc00e"],
+    "XMM5":  ["0xc0e4000000000000", "0x400c"],
+    "XMM6":  ["0x0", "0x0"],
+    "XMM7":  ["0x8000000000000000", "0x3fff"],
+    "XMM8":  ["0x8000000000000000", "0xbfff"],
+    "XMM9":  ["0xfffffffe00000000", "0x401d"],
+    "XMM10": ["0x8000000000000000", "0xc01e"],
+    "XMM11": ["0xf120000000000000", "0xc00f"],
+    "XMM12": ["0x8000000000000000", "0x400f"]
+  }
+}
+%endif
+
+; fild of a 16-bit or 32-bit integer is always exact, so it is done inline without a fallback.
+; Each result is stored as an 80-bit value and read back in to an XMM register.
+%macro load 3
+  ; %1 = size, %2 = integer, %3 = result slot
+  mov eax, %2
+  mov [rdx], eax
+  fild %1 [rdx]
+  fstp tword [rdx + 0x100 + %3 * 16]
+%endmacro
+
+mov rdx, 0xe0000000
+
+; 16-bit
+load word, 0x0000, 0 ; 0
+load word, 0x0001, 1 ; 1
+load word, 0xffff, 2 ; -1
+load word, 0x7fff, 3 ; Largest
+load word, 0x8000, 4 ; Smallest
+load word, 0x3039, 5 ; 12345
+
+; 32-bit
+load dword, 0x00000000, 6  ; 0
+load dword, 0x00000001, 7  ; 1
+load dword, 0xffffffff, 8  ; -1
+load dword, 0x7fffffff, 9  ; Largest
+load dword, 0x80000000, 10 ; Smallest
+load dword, 0xfffe1dc0, 11 ; -123456
+load dword, 0x00010000, 12 ; Only the upper half set
+
+movups xmm0,  [rdx + 0x100 + 0 * 16]
+movups xmm1,  [rdx + 0x100 + 1 * 16]
+movups xmm2,  [rdx + 0x100 + 2 * 16]
+movups xmm3,  [rdx + 0x100 + 3 * 16]
+movups xmm4,  [rdx + 0x100 + 4 * 16]
+movups xmm5,  [rdx + 0x100 + 5 * 16]
+movups xmm6,  [rdx + 0x100 + 6 * 16]
+movups xmm7,  [rdx + 0x100 + 7 * 16]
+movups xmm8,  [rdx + 0x100 + 8 * 16]
+movups xmm9,  [rdx + 0x100 + 9 * 16]
+movups xmm10, [rdx + 0x100 + 10 * 16]
+movups xmm11, [rdx + 0x100 + 11 * 16]
+movups xmm12, [rdx + 0x100 + 12 * 16]
+hlt
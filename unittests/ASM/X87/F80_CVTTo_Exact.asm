@@ -0,0 +1,73 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "XMM0":  ["0xc000000000000000", "0x3fff"],
+    "XMM1":  ["0x0", "0x8000"],
+    "XMM2":  ["0x8000000000000000", "0x3f81"],
+    "XMM3":  ["0xffffff0000000000", "0xc07e"],
+    "XMM4":  ["0x8000000000000000", "0x3f6a"],
+    "XMM5":  ["0x8000000000000000", "0x7fff"],
+    "XMM6":  ["0xc000010000000000", "0x7fff"],
+    "XMM7":  ["0x0", "0x0"],
+    "XMM8":  ["0x8000000000000000", "0x3fff"],
+    "XMM9":  ["0x0", "0x8000"],
+    "XMM10": ["0x8000000000000000", "0x3c01"],
+    "XMM11": ["0xfffffffffffff800", "0x43fe"],
+    "XMM12": ["0xfffffffffffff000", "0x3c00"],
+    "XMM13": ["0x8000000000000000", "0xffff"],
+    "XMM14": ["0xc000000000000800", "0x7fff"],
+    "XMM15": ["0xc90fdaa22168c000", "0xc000"]
+  }
+}
+%endif
+
+; fld of a float or double is done inline for normals and zeroes.
+; Denormals, infinities and NaNs take the SoftFloat fallback.
+; Each result is stored as an 80-bit value and read back in to an XMM register.
+%macro load 3
+  ; %1 = size, %2 = bits, %3 = result slot
+  mov rax, %2
+  mov [rdx], rax
+  fld %1 [rdx]
+  fstp tword [rdx + 0x100 + %3 * 16]
+%endmacro
+
+mov rdx, 0xe0000000
+
+; Floats
+load dword, 0x3fc00000, 0 ; 1.5
+load dword, 0x80000000, 1 ; -0.0
+load dword, 0x00800000, 2 ; Smallest normal
+load dword, 0xff7fffff, 3 ; Most negative normal
+load dword, 0x00000001, 4 ; Denormal
+load dword, 0x7f800000, 5 ; Infinity
+load dword, 0x7fc00001, 6 ; NaN
+load dword, 0x00000000, 7 ; 0.0
+
+; Doubles
+load qword, 0x3ff0000000000000, 8  ; 1.0
+load qword, 0x8000000000000000, 9  ; -0.0
+load qword, 0x0010000000000000, 10 ; Smallest normal
+load qword, 0x7fefffffffffffff, 11 ; Largest normal
+load qword, 0x000fffffffffffff, 12 ; Denormal
+load qword, 0xfff0000000000000, 13 ; -Infinity
+load qword, 0x7ff8000000000001, 14 ; NaN
+load qword, 0xc00921fb54442d18, 15 ; -pi
+
+movups xmm0,  [rdx + 0x100 + 0 * 16]
+movups xmm1,  [rdx + 0x100 + 1 * 16]
+movups xmm2,  [rdx + 0x100 + 2 * 16]
+movups xmm3,  [rdx + 0x100 + 3 * 16]
+movups xmm4,  [rdx + 0x100 + 4 * 16]
+movups xmm5,  [rdx + 0x100 + 5 * 16]
+movups xmm6,  [rdx + 0x100 + 6 * 16]
+movups xmm7,  [rdx + 0x100 + 7 * 16]
+movups xmm8,  [rdx + 0x100 + 8 * 16]
+movups xmm9,  [rdx + 0x100 + 9 * 16]
+movups xmm10, [rdx + 0x100 + 10 * 16]
+movups xmm11, [rdx + 0x100 + 11 * 16]
+movups xmm12, [rdx + 0x100 + 12 * 16]
+movups xmm13, [rdx + 0x100 + 13 * 16]
+movups xmm14, [rdx + 0x100 + 14 * 16]
+movups xmm15, [rdx + 0x100 + 15 * 16]
+hlt
@@ -0,0 +1,74 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "XMM0":  ["0x3fc00000", "0x0"],
+    "XMM1":  ["0x80000000", "0x0"],
+    "XMM2":  ["0x3f800000", "0x0"],
+    "XMM3":  ["0x7f800000", "0x0"],
+    "XMM4":  ["0x200", "0x0"],
+    "XMM5":  ["0x800000", "0x0"],
+    "XMM6":  ["0xff7fffff", "0x0"],
+    "XMM7":  ["0x7fc00000", "0x0"],
+    "XMM8":  ["0x3ff8000000000000", "0x0"],
+    "XMM9":  ["0x8000000000000000", "0x0"],
+    "XMM10": ["0x3ff0000000000000", "0x0"],
+    "XMM11": ["0x7ff0000000000000", "0x0"],
+    "XMM12": ["0x10000000000000", "0x0"],
+    "XMM13": ["0xc008000000000000", "0x0"],
+    "XMM14": ["0x1000000000", "0x0"],
+    "XMM15": ["0x0", "0x0"]
+  }
+}
+%endif
+
+; fst to a float or double is done inline when the value is a normal or zero that converts exactly.
+; Values that need rounding, overflow or underflow, and NaNs take the SoftFloat fallback.
+; Each result is read back in to an XMM register.
+%macro store 4
+  ; %1 = size, %2 = 80-bit mantissa, %3 = 80-bit sign and exponent, %4 = result slot
+  mov rax, %2
+  mov [rdx], rax
+  mov word [rdx + 8], %3
+  fld tword [rdx]
+  fstp %1 [rdx + 0x100 + %4 * 16]
+%endmacro
+
+mov rdx, 0xe0000000
+
+; Floats
+store dword, 0xc000000000000000, 0x3fff, 0 ; 1.5
+store dword, 0x0000000000000000, 0x8000, 1 ; -0.0
+store dword, 0x8000000400000000, 0x3fff, 2 ; 1 + 2^-29, rounds
+store dword, 0x8000000000000000, 0x40c7, 3 ; 2^200, overflows
+store dword, 0x8000000000000000, 0x3f73, 4 ; 2^-140, denormal result
+store dword, 0x8000000000000000, 0x3f81, 5 ; 2^-126, smallest normal
+store dword, 0xffffff0000000000, 0xc07e, 6 ; Most negative normal
+store dword, 0xc000000000000000, 0x7fff, 7 ; NaN
+
+; Doubles
+store qword, 0xc000000000000000, 0x3fff, 8  ; 1.5
+store qword, 0x0000000000000000, 0x8000, 9  ; -0.0
+store qword, 0x8000000000000001, 0x3fff, 10 ; 1 + 2^-63, rounds
+store qword, 0x8000000000000000, 0x43ff, 11 ; 2^1024, overflows
+store qword, 0x8000000000000000, 0x3c01, 12 ; 2^-1022, smallest normal
+store qword, 0xc000000000000000, 0xc000, 13 ; -3.0
+store qword, 0x8000000000000000, 0x3bf1, 14 ; 2^-1038, denormal result
+store qword, 0x0000000000000001, 0x0000, 15 ; 80-bit denormal
+
+movups xmm0,  [rdx + 0x100 + 0 * 16]
+movups xmm1,  [rdx + 0x100 + 1 * 16]
+movups xmm2,  [rdx + 0x100 + 2 * 16]
+movups xmm3,  [rdx + 0x100 + 3 * 16]
+movups xmm4,  [rdx + 0x100 + 4 * 16]
+movups xmm5,  [rdx + 0x100 + 5 * 16]
+movups xmm6,  [rdx + 0x100 + 6 * 16]
+movups xmm7,  [rdx + 0x100 + 7 * 16]
+movups xmm8,  [rdx + 0x100 + 8 * 16]
+movups xmm9,  [rdx + 0x100 + 9 * 16]
+movups xmm10, [rdx + 0x100 + 10 * 16]
+movups xmm11, [rdx + 0x100 + 11 * 16]
+movups xmm12, [rdx + 0x100 + 12 * 16]
+movups xmm13, [rdx + 0x100 + 13 * 16]
+movups xmm14, [rdx + 0x100 + 14 * 16]
+movups xmm15, [rdx + 0x100 + 15 * 16]
+hlt
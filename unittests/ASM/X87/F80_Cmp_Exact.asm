@@ -0,0 +1,83 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "R8":  "0x40",
+    "R9":  "0x0",
+    "R10": "0x1",
+    "R11": "0x0",
+    "R12": "0x1",
+    "R13": "0x45",
+    "R14": "0x0",
+    "R15": "0x1",
+    "RBX": "0x4000",
+    "RCX": "0x100",
+    "RSI": "0x0",
+    "RDI": "0x4500",
+    "RBP": "0x100"
+  }
+}
+%endif
+
+; Compares of zeroes and normals are done inline, anything else takes the SoftFloat fallback.
+; fcomi results are ZF/PF/CF from rflags, fcom results are C3/C2/C0 from the status word.
+%macro set_f80 2
+  mov rax, %1
+  mov [rdx], rax
+  mov word [rdx + 8], %2
+  fld tword [rdx]
+%endmacro
+
+%macro fcomi_check 5
+  ; Compares %1:%2 against %3:%4, result in %5
+  set_f80 %3, %4
+  set_f80 %1, %2
+  fcomi st0, st1
+  pushfq
+  pop %5
+  and %5, 0x45
+  fstp st0
+  fstp st0
+%endmacro
+
+%macro fcom_check 5
+  set_f80 %3, %4
+  set_f80 %1, %2
+  fcom st1
+  fnstsw ax
+  movzx %5, ax
+  and %5, 0x4500
+  fstp st0
+  fstp st0
+%endmacro
+
+mov rdx, 0xe0000000
+
+; +0 against -0 is equal
+fcomi_check 0x0000000000000000, 0x0000, 0x0000000000000000, 0x8000, r8
+; -1 against -2 is greater
+fcomi_check 0x8000000000000000, 0xbfff, 0x8000000000000000, 0xc000, r9
+; -2 against -1 is less
+fcomi_check 0x8000000000000000, 0xc000, 0x8000000000000000, 0xbfff, r10
+; 1.5 against 1.25 only differs in the mantissa
+fcomi_check 0xc000000000000000, 0x3fff, 0xa000000000000000, 0x3fff, r11
+; 2^-10 against 2^10 only differs in the exponent
+fcomi_check 0x8000000000000000, 0x3ff5, 0x8000000000000000, 0x4009, r12
+; 1.0 against NaN is unordered
+fcomi_check 0x8000000000000000, 0x3fff, 0xc000000000000000, 0x7fff, r13
+; Denormal against +0 is greater
+fcomi_check 0x0000000000000001, 0x0000, 0x0000000000000000, 0x0000, r14
+; -Infinity against -1 is less
+fcomi_check 0x8000000000000000, 0xffff, 0x8000000000000000, 0xbfff, r15
+
+; -0 against +0 is equal
+fcom_check 0x0000000000000000, 0x8000, 0x0000000000000000, 0x0000, rbx
+; -5 against 2 is less
+fcom_check 0xa000000000000000, 0xc001, 0x8000000000000000, 0x4000, rcx
+; 7 against -7 is greater
+fcom_check 0xe000000000000000, 0x4001, 0xe000000000000000, 0xc001, rsi
+; NaN against 1.0 is unordered
+fcom_check 0xc000000000000000, 0x7fff, 0x8000000000000000, 0x3fff, rdi
+; -1.5 against -1.25 is less
+fcom_check 0xc000000000000000, 0xbfff, 0xa000000000000000, 0xbfff, rbp
+
+hlt
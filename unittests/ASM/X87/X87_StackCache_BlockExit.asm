@@ -0,0 +1,76 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x0",
+    "RBX": "0x3",
+    "RCX": "0x0",
+    "RSI": "0x5",
+    "RDI": "0x1800",
+    "R8":  "0x2",
+    "R9":  "0x2"
+  }
+}
+%endif
+
+; The x87 stack cache is written back at every block exit.
+; Values and TOP changed by a run of x87 instructions have to be visible after a jump, a loop and a conditional branch.
+mov rdx, 0xe0000000
+
+fninit
+
+; Pushes before an unconditional jump
+fld1
+fld1
+fld1
+jmp .Jump
+
+.Jump:
+faddp
+faddp
+fistp dword [rdx]
+mov ebx, [rdx]
+
+; One push on each loop iteration, the loop branch ends each block
+mov ecx, 5
+.Loop:
+fld1
+dec ecx
+jnz .Loop
+
+; TOP is 3 after the five pushes
+fnstsw ax
+mov edi, eax
+and edi, 0x3800
+
+faddp
+faddp
+faddp
+faddp
+fistp dword [rdx]
+mov esi, [rdx]
+
+; Dirty slots across a taken branch
+fld1
+fld1
+cmp ecx, 0
+je .Taken
+fld1
+.Taken:
+faddp
+fistp dword [rdx]
+mov r8d, [rdx]
+
+; And across a branch that isn't taken
+fld1
+cmp ecx, 1
+je .NotTaken
+fld1
+.NotTaken:
+faddp
+fistp dword [rdx]
+mov r9d, [rdx]
+
+; Everything was popped again
+fnstsw ax
+and eax, 0x3800
+hlt
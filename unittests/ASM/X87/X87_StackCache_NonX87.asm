@@ -0,0 +1,52 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "R8":  "0xa000000000000000",
+    "R9":  "0xa000000000000000",
+    "R10": "0x4001",
+    "R11": "0x3800",
+    "R12": "0x7",
+    "R13": "0x0"
+  }
+}
+%endif
+
+; The x87 stack cache is written back and dropped before any non-x87 instruction.
+; MMX and FXSAVE have to see the values of the x87 run before them, and the run after FXRSTOR has to see the restored values.
+mov rdx, 0xe0000000
+mov dword [rdx], 3
+
+; MMX reads the register that TOP points at after the run
+fninit
+fild dword [rdx]
+fld1
+fld1
+faddp
+faddp
+movq r8, mm7
+
+; FXSAVE stores the dirty st(0) and TOP
+fninit
+fild dword [rdx]
+fld1
+fld1
+faddp
+faddp
+fxsave [rdx + 0x200]
+mov r9, [rdx + 0x200 + 32]
+movzx r10d, word [rdx + 0x200 + 40]
+movzx r11d, word [rdx + 0x200 + 2]
+and r11d, 0x3800
+
+; st(0) after FXRSTOR comes from the restored image, not the cached 5.0
+mov rax, 0xe000000000000000
+mov [rdx + 0x200 + 32], rax
+fxrstor [rdx + 0x200]
+fistp dword [rdx]
+mov r12d, [rdx]
+
+; The pop after FXRSTOR moved TOP back to 0
+fnstsw ax
+movzx r13d, ax
+and r13d, 0x3800
+hlt
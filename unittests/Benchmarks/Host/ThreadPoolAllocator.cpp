@@ -0,0 +1,69 @@
+#include <FEXCore/Utils/ThreadPoolAllocator.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+// Claim/release throughput of the thread pool allocator shared between threads.
+// Prints one JSON object per line, in the same format as the guest benchmarks.
+namespace {
+  constexpr size_t BufferSize = 4096;
+  constexpr size_t Iterations = 20000;
+  // No pool time threshold is hit during the run, so every disown has a cheap reown
+  using PoolAllocation = FEXCore::Utils::FixedSizePooledAllocation<uint32_t*, 5000, 500>;
+
+  // Claims, fills and checks a buffer so any two threads sharing a buffer is detected
+  bool ClaimRelease(FEXCore::Utils::IntrusivePooledAllocator &Allocator, uint32_t ThreadID) {
+    bool Success = true;
+    for (size_t i = 0; i < Iterations; ++i) {
+      PoolAllocation Object{Allocator, BufferSize};
+      auto Buffer = Object.ReownOrClaimBuffer();
+      std::fill(Buffer, Buffer + BufferSize / sizeof(uint32_t), ThreadID);
+      for (size_t j = 0; j < BufferSize / sizeof(uint32_t); j += 64) {
+        Success &= Buffer[j] == ThreadID;
+      }
+      Object.DelayedDisownBuffer();
+      Object.UnclaimBuffer();
+    }
+    return Success;
+  }
+}
+
+int main() {
+  bool Success = true;
+
+  for (size_t Threads : {1, 2, 4, 8, 16, 32, 64}) {
+    FEXCore::Utils::PooledAllocatorMalloc Allocator;
+    std::atomic<bool> ThreadSuccess {true};
+    std::vector<std::thread> Workers;
+
+    auto Begin = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < Threads; ++i) {
+      Workers.emplace_back([&, i]() {
+        if (!ClaimRelease(Allocator, i)) {
+          ThreadSuccess = false;
+        }
+      });
+    }
+
+    for (auto &Worker : Workers) {
+      Worker.join();
+    }
+    auto End = std::chrono::steady_clock::now();
+
+    if (!ThreadSuccess) {
+      fprintf(stderr, "%zu threads: a buffer was shared between threads\n", Threads);
+      Success = false;
+    }
+
+    const auto Nanoseconds = std::chrono::duration<double, std::nano>(End - Begin).count();
+    printf("{\"benchmark\": \"threadpoolallocator_claim_release_%zu\", \"iterations\": %zu, \"ns_per_iteration\": %.3f}\n",
+           Threads, Threads * Iterations, Nanoseconds / (Threads * Iterations));
+    fflush(stdout);
+  }
+
+  return Success ? 0 : 1;
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include <time.h>
+
+namespace Bench {
+  // Keeps the compiler from discarding a result that is otherwise unused
+  template<typename T>
+  inline void DoNotOptimize(T const &Value) {
+    asm volatile("" : : "r,m"(Value) : "memory");
+  }
+
+  inline uint64_t Now() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1'000'000'000ULL + ts.tv_nsec;
+  }
+
+  // FEX_BENCHMARK_SCALE scales every iteration count, lower for quick runs or higher for more stable results
+  inline uint64_t Scale(uint64_t Iterations) {
+    const char *Env = getenv("FEX_BENCHMARK_SCALE");
+    const double Factor = Env ? atof(Env) : 1.0;
+    const uint64_t Scaled = Iterations * Factor;
+    return Scaled ? Scaled : 1;
+  }
+
+  // One JSON object per line, guest_benchmark_runner.py collects these
+  inline void Report(const char *Name, uint64_t Iterations, uint64_t Nanoseconds) {
+    printf("{\"benchmark\": \"%s\", \"iterations\": %llu, \"ns_per_iteration\": %.3f}\n",
+           Name, static_cast<unsigned long long>(Iterations), static_cast<double>(Nanoseconds) / Iterations);
+    fflush(stdout);
+  }
+
+  // Runs Body(i) Iterations times and reports the time per iteration.
+  // A warmup pass runs first so that JIT compilation isn't part of the measurement.
+  template<typename F>
+  void Run(const char *Name, uint64_t Iterations, F &&Body) {
+    Iterations = Scale(Iterations);
+
+    const uint64_t Warmup = Iterations / 10 + 1;
+    for (uint64_t i = 0; i < Warmup; ++i) {
+      Body(i);
+    }
+
+    const uint64_t Begin = Now();
+    for (uint64_t i = 0; i < Iterations; ++i) {
+      Body(i);
+    }
+    Report(Name, Iterations, Now() - Begin);
+  }
+}
@@ -0,0 +1,58 @@
+// Lock prefixed atomics, uncontended and contended between threads
+#include "Benchmark.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Every thread runs Iterations operations, reported per operation across all threads
+template<typename F>
+static void RunContended(const char *Name, uint64_t Iterations, unsigned NumThreads, F &&Body) {
+  Iterations = Bench::Scale(Iterations);
+
+  std::atomic<unsigned> Ready {};
+  std::atomic<bool> Start {};
+  std::vector<std::thread> Threads;
+  for (unsigned t = 0; t < NumThreads; ++t) {
+    Threads.emplace_back([&] {
+      ++Ready;
+      while (!Start.load(std::memory_order_acquire));
+      for (uint64_t i = 0; i < Iterations; ++i) {
+        Body(i);
+      }
+    });
+  }
+
+  while (Ready.load() != NumThreads);
+  const uint64_t Begin = Bench::Now();
+  Start.store(true, std::memory_order_release);
+  for (auto &Thread : Threads) {
+    Thread.join();
+  }
+  Bench::Report(Name, Iterations * NumThreads, Bench::Now() - Begin);
+}
+
+int main() {
+  alignas(64) std::atomic<uint64_t> Counter {};
+
+  Bench::Run("lock_xadd", 20'000'000, [&](uint64_t) {
+    Counter.fetch_add(1);
+  });
+
+  Bench::Run("lock_cmpxchg", 20'000'000, [&](uint64_t i) {
+    uint64_t Expected = Counter.load(std::memory_order_relaxed);
+    Counter.compare_exchange_strong(Expected, Expected + i);
+  });
+
+  RunContended("lock_xadd_contended_4t", 5'000'000, 4, [&](uint64_t) {
+    Counter.fetch_add(1);
+  });
+
+  RunContended("lock_cmpxchg_contended_4t", 2'000'000, 4, [&](uint64_t) {
+    uint64_t Expected = Counter.load(std::memory_order_relaxed);
+    while (!Counter.compare_exchange_weak(Expected, Expected + 1));
+  });
+
+  Bench::DoNotOptimize(Counter.load());
+  return 0;
+}
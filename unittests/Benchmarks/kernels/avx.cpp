@@ -0,0 +1,45 @@
+// AVX2 and FMA vector math, skipped when the CPU doesn't report AVX2
+#include "Benchmark.h"
+
+#include <immintrin.h>
+#include <vector>
+
+__attribute__((target("avx2,fma")))
+static void Saxpy(float *Y, const float *X, size_t Size) {
+  const __m256 A = _mm256_set1_ps(1.0001f);
+  for (size_t i = 0; i < Size; i += 8) {
+    _mm256_storeu_ps(&Y[i], _mm256_fmadd_ps(A, _mm256_loadu_ps(&X[i]), _mm256_loadu_ps(&Y[i])));
+  }
+}
+
+__attribute__((target("avx2")))
+static uint32_t IntegerMix(uint32_t *Data, size_t Size) {
+  __m256i Acc = _mm256_setzero_si256();
+  for (size_t i = 0; i < Size; i += 8) {
+    __m256i Value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&Data[i]));
+    Value = _mm256_xor_si256(_mm256_slli_epi32(Value, 3), _mm256_srli_epi32(Value, 5));
+    Acc = _mm256_add_epi32(Acc, _mm256_shuffle_epi8(Value, _mm256_set1_epi32(0x00010203)));
+  }
+  return _mm256_extract_epi32(Acc, 0);
+}
+
+int main() {
+  if (!__builtin_cpu_supports("avx2") || !__builtin_cpu_supports("fma")) {
+    return 0;
+  }
+
+  constexpr size_t Size = 4096;
+  std::vector<float> X(Size, 1.5f), Y(Size, 2.5f);
+  std::vector<uint32_t> Ints(Size, 0x12345678);
+
+  Bench::Run("avx_fma_saxpy_4k", 200'000, [&](uint64_t) {
+    Saxpy(Y.data(), X.data(), Size);
+    Bench::DoNotOptimize(Y[0]);
+  });
+
+  Bench::Run("avx2_int_mix_4k", 200'000, [&](uint64_t) {
+    Bench::DoNotOptimize(IntegerMix(Ints.data(), Size));
+  });
+
+  return 0;
+}
@@ -0,0 +1,62 @@
+// CRC32 with a byte table, and CRC32C with the SSE4.2 crc32 instruction
+#include "Benchmark.h"
+
+#include <nmmintrin.h>
+#include <vector>
+
+static uint32_t Table[256];
+
+static void InitTable() {
+  for (uint32_t i = 0; i < 256; ++i) {
+    uint32_t c = i;
+    for (int k = 0; k < 8; ++k) {
+      c = (c & 1) ? (0xEDB88320U ^ (c >> 1)) : (c >> 1);
+    }
+    Table[i] = c;
+  }
+}
+
+static uint32_t CRC32Table(const uint8_t *Data, size_t Size) {
+  uint32_t CRC = ~0U;
+  for (size_t i = 0; i < Size; ++i) {
+    CRC = Table[(CRC ^ Data[i]) & 0xFF] ^ (CRC >> 8);
+  }
+  return ~CRC;
+}
+
+__attribute__((target("sse4.2")))
+static uint32_t CRC32CInstruction(const uint8_t *Data, size_t Size) {
+  uint64_t CRC = ~0U;
+  size_t i = 0;
+  for (; i + 8 <= Size; i += 8) {
+    uint64_t Value;
+    __builtin_memcpy(&Value, Data + i, sizeof(Value));
+    CRC = _mm_crc32_u64(CRC, Value);
+  }
+  for (; i < Size; ++i) {
+    CRC = _mm_crc32_u8(static_cast<uint32_t>(CRC), Data[i]);
+  }
+  return ~static_cast<uint32_t>(CRC);
+}
+
+int main() {
+  InitTable();
+
+  constexpr size_t Size = 64 * 1024;
+  std::vector<uint8_t> Data(Size);
+  for (size_t i = 0; i < Size; ++i) {
+    Data[i] = static_cast<uint8_t>(i * 31 + 7);
+  }
+
+  Bench::Run("crc32_table_64k", 2'000, [&](uint64_t) {
+    Bench::DoNotOptimize(CRC32Table(Data.data(), Size));
+  });
+
+  if (__builtin_cpu_supports("sse4.2")) {
+    Bench::Run("crc32c_sse42_64k", 20'000, [&](uint64_t) {
+      Bench::DoNotOptimize(CRC32CInstruction(Data.data(), Size));
+    });
+  }
+
+  return 0;
+}
@@ -0,0 +1,56 @@
+// Indirect calls and virtual dispatch, stressing block lookup and return prediction
+#include "Benchmark.h"
+
+#include <memory>
+#include <vector>
+
+#define TARGET(n) \
+  __attribute__((noinline)) static uint64_t Target##n(uint64_t Value) { \
+    return Value * (n + 3) + n; \
+  }
+TARGET(0) TARGET(1) TARGET(2) TARGET(3) TARGET(4) TARGET(5) TARGET(6) TARGET(7)
+#undef TARGET
+
+using TargetFn = uint64_t (*)(uint64_t);
+static TargetFn volatile Targets[8] = {
+  Target0, Target1, Target2, Target3, Target4, Target5, Target6, Target7,
+};
+
+struct Shape {
+  virtual ~Shape() = default;
+  virtual uint64_t Area(uint64_t Scale) const = 0;
+};
+struct Square final : Shape {
+  uint64_t Area(uint64_t Scale) const override { return Scale * Scale; }
+};
+struct Rect final : Shape {
+  uint64_t Area(uint64_t Scale) const override { return Scale * (Scale + 1); }
+};
+struct Triangle final : Shape {
+  uint64_t Area(uint64_t Scale) const override { return Scale * Scale / 2; }
+};
+
+int main() {
+  Bench::Run("indirect_call_mono", 50'000'000, [](uint64_t i) {
+    Bench::DoNotOptimize(Targets[0](i));
+  });
+
+  Bench::Run("indirect_call_poly8", 50'000'000, [](uint64_t i) {
+    Bench::DoNotOptimize(Targets[(i * 5) & 7](i));
+  });
+
+  std::vector<std::unique_ptr<Shape>> Shapes;
+  for (int i = 0; i < 64; ++i) {
+    switch (i % 3) {
+      case 0: Shapes.emplace_back(std::make_unique<Square>()); break;
+      case 1: Shapes.emplace_back(std::make_unique<Rect>()); break;
+      default: Shapes.emplace_back(std::make_unique<Triangle>()); break;
+    }
+  }
+
+  Bench::Run("virtual_call_poly3", 50'000'000, [&](uint64_t i) {
+    Bench::DoNotOptimize(Shapes[i & 63]->Area(i));
+  });
+
+  return 0;
+}
@@ -0,0 +1,31 @@
+// zlib inflate of compressible text, only built when the x86 toolchain has zlib
+#include "Benchmark.h"
+
+#include <vector>
+#include <zlib.h>
+
+int main() {
+  constexpr size_t Size = 1024 * 1024;
+  std::vector<uint8_t> Data(Size);
+  // Repetitive enough to compress, varied enough to exercise both literals and matches
+  uint32_t Seed = 1;
+  for (size_t i = 0; i < Size; ++i) {
+    Seed = Seed * 1103515245 + 12345;
+    Data[i] = "the quick brown fox jumps over the lazy dog "[(i + (Seed >> 28)) % 44];
+  }
+
+  uLongf CompressedSize = compressBound(Size);
+  std::vector<uint8_t> Compressed(CompressedSize);
+  if (compress2(Compressed.data(), &CompressedSize, Data.data(), Size, Z_DEFAULT_COMPRESSION) != Z_OK) {
+    return 1;
+  }
+
+  std::vector<uint8_t> Output(Size);
+  Bench::Run("zlib_inflate_1m", 200, [&](uint64_t) {
+    uLongf OutputSize = Size;
+    uncompress(Output.data(), &OutputSize, Compressed.data(), CompressedSize);
+    Bench::DoNotOptimize(Output[0]);
+  });
+
+  return 0;
+}
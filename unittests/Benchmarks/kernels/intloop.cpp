@@ -0,0 +1,32 @@
+// Integer ALU loops, flag heavy branches, and 64-bit division
+#include "Benchmark.h"
+
+static uint64_t Collatz(uint64_t Value) {
+  uint64_t Steps = 0;
+  while (Value != 1) {
+    Value = (Value & 1) ? Value * 3 + 1 : Value >> 1;
+    ++Steps;
+  }
+  return Steps;
+}
+
+int main() {
+  Bench::Run("int_alu", 50'000'000, [](uint64_t i) {
+    uint64_t Value = i * 0x9E3779B97F4A7C15ULL;
+    Value ^= Value >> 29;
+    Value += (Value << 7) | (i & 0xFF);
+    Value = __builtin_popcountll(Value) + __builtin_ctzll(Value | 1);
+    Bench::DoNotOptimize(Value);
+  });
+
+  Bench::Run("int_collatz", 2'000'000, [](uint64_t i) {
+    Bench::DoNotOptimize(Collatz(i + 1));
+  });
+
+  Bench::Run("int_div64", 20'000'000, [](uint64_t i) {
+    volatile uint64_t Divisor = (i & 0xFFF) + 3;
+    Bench::DoNotOptimize(0xFEDCBA9876543210ULL / Divisor + 0x123456789ULL % Divisor);
+  });
+
+  return 0;
+}
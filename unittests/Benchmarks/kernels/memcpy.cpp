@@ -0,0 +1,42 @@
+// memcpy through libc and through rep movsb, at sizes from inline copies to cache-exceeding ones
+#include "Benchmark.h"
+
+#include <cstring>
+#include <vector>
+
+static void RepMovsb(void *Dst, const void *Src, size_t Size) {
+  asm volatile("rep movsb" : "+D"(Dst), "+S"(Src), "+c"(Size) : : "memory");
+}
+
+int main() {
+  constexpr size_t MaxSize = 16 * 1024 * 1024;
+  std::vector<uint8_t> Src(MaxSize, 0x5A);
+  std::vector<uint8_t> Dst(MaxSize);
+
+  struct {
+    size_t Size;
+    uint64_t Iterations;
+  } const Cases[] = {
+    {16, 20'000'000},
+    {256, 5'000'000},
+    {4096, 500'000},
+    {64 * 1024, 20'000},
+    {MaxSize, 50},
+  };
+
+  for (const auto &Case : Cases) {
+    char Name[64];
+    snprintf(Name, sizeof(Name), "memcpy_%zu", Case.Size);
+    Bench::Run(Name, Case.Iterations, [&](uint64_t) {
+      memcpy(Dst.data(), Src.data(), Case.Size);
+      Bench::DoNotOptimize(Dst[0]);
+    });
+
+    snprintf(Name, sizeof(Name), "rep_movsb_%zu", Case.Size);
+    Bench::Run(Name, Case.Iterations, [&](uint64_t) {
+      RepMovsb(Dst.data(), Src.data(), Case.Size);
+    });
+  }
+
+  return 0;
+}
@@ -0,0 +1,41 @@
+// memset through libc and through rep stosb, at sizes from inline fills to cache-exceeding ones
+#include "Benchmark.h"
+
+#include <cstring>
+#include <vector>
+
+static void RepStosb(void *Dst, uint8_t Value, size_t Size) {
+  asm volatile("rep stosb" : "+D"(Dst), "+c"(Size) : "a"(Value) : "memory");
+}
+
+int main() {
+  constexpr size_t MaxSize = 16 * 1024 * 1024;
+  std::vector<uint8_t> Dst(MaxSize);
+
+  struct {
+    size_t Size;
+    uint64_t Iterations;
+  } const Cases[] = {
+    {16, 20'000'000},
+    {256, 5'000'000},
+    {4096, 500'000},
+    {64 * 1024, 20'000},
+    {MaxSize, 50},
+  };
+
+  for (const auto &Case : Cases) {
+    char Name[64];
+    snprintf(Name, sizeof(Name), "memset_%zu", Case.Size);
+    Bench::Run(Name, Case.Iterations, [&](uint64_t i) {
+      memset(Dst.data(), static_cast<int>(i), Case.Size);
+      Bench::DoNotOptimize(Dst[0]);
+    });
+
+    snprintf(Name, sizeof(Name), "rep_stosb_%zu", Case.Size);
+    Bench::Run(Name, Case.Iterations, [&](uint64_t i) {
+      RepStosb(Dst.data(), static_cast<uint8_t>(i), Case.Size);
+    });
+  }
+
+  return 0;
+}
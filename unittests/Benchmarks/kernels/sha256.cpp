@@ -0,0 +1,68 @@
+// SHA-256 in plain C++, rotate and add heavy integer code
+#include "Benchmark.h"
+
+#include <cstring>
+#include <vector>
+
+static constexpr uint32_t K[64] = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+static inline uint32_t Ror(uint32_t Value, int Shift) {
+  return (Value >> Shift) | (Value << (32 - Shift));
+}
+
+static void Compress(uint32_t State[8], const uint8_t Block[64]) {
+  uint32_t W[64];
+  for (int i = 0; i < 16; ++i) {
+    W[i] = (uint32_t(Block[i * 4]) << 24) | (uint32_t(Block[i * 4 + 1]) << 16) | (uint32_t(Block[i * 4 + 2]) << 8) | Block[i * 4 + 3];
+  }
+  for (int i = 16; i < 64; ++i) {
+    const uint32_t s0 = Ror(W[i - 15], 7) ^ Ror(W[i - 15], 18) ^ (W[i - 15] >> 3);
+    const uint32_t s1 = Ror(W[i - 2], 17) ^ Ror(W[i - 2], 19) ^ (W[i - 2] >> 10);
+    W[i] = W[i - 16] + s0 + W[i - 7] + s1;
+  }
+
+  uint32_t a = State[0], b = State[1], c = State[2], d = State[3];
+  uint32_t e = State[4], f = State[5], g = State[6], h = State[7];
+  for (int i = 0; i < 64; ++i) {
+    const uint32_t S1 = Ror(e, 6) ^ Ror(e, 11) ^ Ror(e, 25);
+    const uint32_t ch = (e & f) ^ (~e & g);
+    const uint32_t t1 = h + S1 + ch + K[i] + W[i];
+    const uint32_t S0 = Ror(a, 2) ^ Ror(a, 13) ^ Ror(a, 22);
+    const uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+    const uint32_t t2 = S0 + maj;
+    h = g; g = f; f = e; e = d + t1;
+    d = c; c = b; b = a; a = t1 + t2;
+  }
+
+  State[0] += a; State[1] += b; State[2] += c; State[3] += d;
+  State[4] += e; State[5] += f; State[6] += g; State[7] += h;
+}
+
+int main() {
+  constexpr size_t Size = 64 * 1024;
+  std::vector<uint8_t> Data(Size);
+  for (size_t i = 0; i < Size; ++i) {
+    Data[i] = static_cast<uint8_t>(i ^ (i >> 8));
+  }
+
+  Bench::Run("sha256_64k", 500, [&](uint64_t) {
+    uint32_t State[8] = {
+      0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+    };
+    for (size_t Offset = 0; Offset < Size; Offset += 64) {
+      Compress(State, Data.data() + Offset);
+    }
+    Bench::DoNotOptimize(State[0]);
+  });
+
+  return 0;
+}
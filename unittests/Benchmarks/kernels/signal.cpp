@@ -0,0 +1,55 @@
+// Signal round trips, delivery to a guest handler and the sigreturn back
+#include "Benchmark.h"
+
+#include <signal.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static volatile sig_atomic_t Delivered{};
+
+static void Handler(int) {
+  Delivered = Delivered + 1;
+}
+
+static void SigInfoHandler(int, siginfo_t *, void *) {
+  Delivered = Delivered + 1;
+}
+
+int main() {
+  struct sigaction Action {};
+  Action.sa_handler = Handler;
+  sigemptyset(&Action.sa_mask);
+  if (sigaction(SIGUSR1, &Action, nullptr) != 0) {
+    return 1;
+  }
+
+  Action.sa_sigaction = SigInfoHandler;
+  Action.sa_flags = SA_SIGINFO;
+  if (sigaction(SIGUSR2, &Action, nullptr) != 0) {
+    return 1;
+  }
+
+  const pid_t Pid = getpid();
+  const pid_t Tid = syscall(SYS_gettid);
+
+  Bench::Run("signal_tgkill", 200'000, [&](uint64_t) {
+    syscall(SYS_tgkill, Pid, Tid, SIGUSR1);
+  });
+
+  Bench::Run("signal_tgkill_siginfo", 200'000, [&](uint64_t) {
+    syscall(SYS_tgkill, Pid, Tid, SIGUSR2);
+  });
+
+  // Blocked and unblocked again, so delivery happens on the sigprocmask return
+  sigset_t Set;
+  sigemptyset(&Set);
+  sigaddset(&Set, SIGUSR1);
+  Bench::Run("signal_pending_unblock", 200'000, [&](uint64_t) {
+    sigprocmask(SIG_BLOCK, &Set, nullptr);
+    syscall(SYS_tgkill, Pid, Tid, SIGUSR1);
+    sigprocmask(SIG_UNBLOCK, &Set, nullptr);
+  });
+
+  Bench::DoNotOptimize(Delivered);
+  return 0;
+}
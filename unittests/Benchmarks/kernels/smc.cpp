@@ -0,0 +1,37 @@
+// Self modifying code, patching and running generated code like a guest JIT does
+#include "Benchmark.h"
+
+#include <cstring>
+#include <sys/mman.h>
+
+using CodeFn = uint32_t (*)();
+
+// mov eax, imm32; ret
+static void EmitReturn(uint8_t *Code, uint32_t Value) {
+  Code[0] = 0xB8;
+  memcpy(&Code[1], &Value, sizeof(Value));
+  Code[5] = 0xC3;
+}
+
+int main() {
+  auto Code = static_cast<uint8_t*>(mmap(nullptr, 4096 * 2, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+  if (Code == MAP_FAILED) {
+    return 1;
+  }
+
+  // Every iteration rewrites the code that is about to run
+  Bench::Run("smc_patch_and_run", 200'000, [&](uint64_t i) {
+    EmitReturn(Code, static_cast<uint32_t>(i));
+    Bench::DoNotOptimize(reinterpret_cast<CodeFn>(Code)());
+  });
+
+  // Data written next to code on the same page, without touching the code itself
+  EmitReturn(Code + 4096, 42);
+  Bench::Run("smc_data_on_code_page", 2'000'000, [&](uint64_t i) {
+    Code[4096 + 2048 + (i & 1023)] = static_cast<uint8_t>(i);
+    Bench::DoNotOptimize(reinterpret_cast<CodeFn>(Code + 4096)());
+  });
+
+  munmap(Code, 4096 * 2);
+  return 0;
+}
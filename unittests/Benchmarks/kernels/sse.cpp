@@ -0,0 +1,38 @@
+// SSE float and double vector math over cache resident arrays
+#include "Benchmark.h"
+
+#include <emmintrin.h>
+#include <vector>
+
+int main() {
+  constexpr size_t Size = 4096;
+  std::vector<float> X(Size, 1.5f), Y(Size, 2.5f);
+  std::vector<double> D(Size, 3.0);
+
+  Bench::Run("sse_saxpy_4k", 200'000, [&](uint64_t) {
+    const __m128 A = _mm_set1_ps(1.0001f);
+    for (size_t i = 0; i < Size; i += 4) {
+      __m128 x = _mm_loadu_ps(&X[i]);
+      __m128 y = _mm_loadu_ps(&Y[i]);
+      _mm_storeu_ps(&Y[i], _mm_add_ps(_mm_mul_ps(A, x), y));
+    }
+    Bench::DoNotOptimize(Y[0]);
+  });
+
+  Bench::Run("sse_dot_4k", 200'000, [&](uint64_t) {
+    __m128 Sum = _mm_setzero_ps();
+    for (size_t i = 0; i < Size; i += 4) {
+      Sum = _mm_add_ps(Sum, _mm_mul_ps(_mm_loadu_ps(&X[i]), _mm_loadu_ps(&Y[i])));
+    }
+    Bench::DoNotOptimize(_mm_cvtss_f32(Sum));
+  });
+
+  Bench::Run("sse_sqrt_pd_4k", 100'000, [&](uint64_t) {
+    for (size_t i = 0; i < Size; i += 2) {
+      _mm_storeu_pd(&D[i], _mm_sqrt_pd(_mm_add_pd(_mm_loadu_pd(&D[i]), _mm_set1_pd(1.0))));
+    }
+    Bench::DoNotOptimize(D[0]);
+  });
+
+  return 0;
+}
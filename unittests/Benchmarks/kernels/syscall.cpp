@@ -0,0 +1,111 @@
+// Syscall round trips, trivial and marshaled syscalls and a pipe ping-pong between two threads
+#include "Benchmark.h"
+
+#include <cstring>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+
+int main() {
+  Bench::Run("syscall_getppid", 2'000'000, [](uint64_t) {
+    Bench::DoNotOptimize(syscall(SYS_getppid));
+  });
+
+  Bench::Run("syscall_getpid", 2'000'000, [](uint64_t) {
+    Bench::DoNotOptimize(syscall(SYS_getpid));
+  });
+
+  // epoll_event is packed on x86-64, so the events are repacked for the host
+  int Epoll = epoll_create1(0);
+  int Event = eventfd(1, 0);
+  if (Epoll < 0 || Event < 0) {
+    return 1;
+  }
+
+  epoll_event Ready {
+    .events = EPOLLIN,
+    .data = { .u64 = 1 },
+  };
+  if (epoll_ctl(Epoll, EPOLL_CTL_ADD, Event, &Ready) != 0) {
+    return 1;
+  }
+
+  epoll_event Events[8];
+  Bench::Run("syscall_epoll_wait", 1'000'000, [&](uint64_t) {
+    Bench::DoNotOptimize(epoll_wait(Epoll, Events, 8, 0));
+  });
+  close(Event);
+  close(Epoll);
+
+  // An fd sent with SCM_RIGHTS every iteration, the control message is converted in both directions
+  int Sockets[2];
+  if (socketpair(AF_UNIX, SOCK_DGRAM, 0, Sockets) != 0) {
+    return 1;
+  }
+
+  Bench::Run("syscall_sendmsg_recvmsg_cmsg", 200'000, [&](uint64_t) {
+    char Byte = 'x';
+    iovec Vec { .iov_base = &Byte, .iov_len = 1 };
+    alignas(cmsghdr) char Control[CMSG_SPACE(sizeof(int))] {};
+
+    msghdr Msg {};
+    Msg.msg_iov = &Vec;
+    Msg.msg_iovlen = 1;
+    Msg.msg_control = Control;
+    Msg.msg_controllen = sizeof(Control);
+
+    auto Header = CMSG_FIRSTHDR(&Msg);
+    Header->cmsg_level = SOL_SOCKET;
+    Header->cmsg_type = SCM_RIGHTS;
+    Header->cmsg_len = CMSG_LEN(sizeof(int));
+    memcpy(CMSG_DATA(Header), &Sockets[0], sizeof(int));
+    if (sendmsg(Sockets[0], &Msg, 0) != 1) {
+      return;
+    }
+
+    memset(Control, 0, sizeof(Control));
+    Msg.msg_controllen = sizeof(Control);
+    if (recvmsg(Sockets[1], &Msg, 0) != 1) {
+      return;
+    }
+
+    Header = CMSG_FIRSTHDR(&Msg);
+    if (Header && Header->cmsg_type == SCM_RIGHTS) {
+      int Received;
+      memcpy(&Received, CMSG_DATA(Header), sizeof(int));
+      close(Received);
+    }
+  });
+  close(Sockets[0]);
+  close(Sockets[1]);
+
+  int Ping[2], Pong[2];
+  if (pipe(Ping) != 0 || pipe(Pong) != 0) {
+    return 1;
+  }
+
+  const uint64_t Iterations = Bench::Scale(200'000);
+  std::thread Echo([&] {
+    char Byte;
+    for (uint64_t i = 0; i < Iterations; ++i) {
+      if (read(Ping[0], &Byte, 1) != 1 || write(Pong[1], &Byte, 1) != 1) {
+        break;
+      }
+    }
+  });
+
+  const uint64_t Begin = Bench::Now();
+  char Byte = 'x';
+  for (uint64_t i = 0; i < Iterations; ++i) {
+    if (write(Ping[1], &Byte, 1) != 1 || read(Pong[0], &Byte, 1) != 1) {
+      break;
+    }
+  }
+  Bench::Report("pipe_ping_pong", Iterations, Bench::Now() - Begin);
+  Echo.join();
+
+  return 0;
+}
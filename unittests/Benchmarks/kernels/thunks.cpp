@@ -0,0 +1,87 @@
+// Guest <-> host transitions through a thunk library
+//
+// Loads libfex_thunk_bench, or the library in FEX_THUNK_BENCH_LIB. Pointing that at the guest thunk library
+// measures thunked calls, the native guest library measures the same calls emulated.
+#include "Benchmark.h"
+#include "../../../ThunkLibs/libfex_thunk_bench/fex_thunk_bench.h"
+
+#include <dlfcn.h>
+
+template<typename T>
+static T *Lookup(void *Handle, const char *Name) {
+  auto Symbol = reinterpret_cast<T*>(dlsym(Handle, Name));
+  if (!Symbol) {
+    fprintf(stderr, "Missing symbol %s\n", Name);
+    exit(1);
+  }
+  return Symbol;
+}
+
+static void Callback(void *Data) {
+  ++*static_cast<uint64_t*>(Data);
+}
+
+int main() {
+  const char *Library = getenv("FEX_THUNK_BENCH_LIB");
+  void *Handle = dlopen(Library ? Library : "libfex_thunk_bench.so.1", RTLD_NOW | RTLD_LOCAL);
+  if (!Handle) {
+    fprintf(stderr, "Couldn't load the benchmark library: %s\n", dlerror());
+    return 1;
+  }
+
+  auto Empty = Lookup<decltype(fex_thunk_bench_empty)>(Handle, "fex_thunk_bench_empty");
+  auto Scalars = Lookup<decltype(fex_thunk_bench_scalars)>(Handle, "fex_thunk_bench_scalars");
+  auto Args16 = Lookup<decltype(fex_thunk_bench_sum16)>(Handle, "fex_thunk_bench_sum16");
+  auto Args64 = Lookup<decltype(fex_thunk_bench_sum64)>(Handle, "fex_thunk_bench_sum64");
+  auto Args256 = Lookup<decltype(fex_thunk_bench_sum256)>(Handle, "fex_thunk_bench_sum256");
+  auto Invoke = Lookup<decltype(fex_thunk_bench_invoke)>(Handle, "fex_thunk_bench_invoke");
+  auto Batched = Lookup<decltype(fex_thunk_bench_batched)>(Handle, "fex_thunk_bench_batched");
+  auto BatchedResult = Lookup<decltype(fex_thunk_bench_batched_result)>(Handle, "fex_thunk_bench_batched_result");
+
+  Bench::Run("thunk_empty", 2'000'000, [&](uint64_t) {
+    Empty();
+  });
+
+  Bench::Run("thunk_scalars", 2'000'000, [&](uint64_t i) {
+    Bench::DoNotOptimize(Scalars(i, i + 1, i + 2, i + 3));
+  });
+
+  fex_thunk_bench_args16 Struct16 {};
+  Bench::Run("thunk_args16", 2'000'000, [&](uint64_t i) {
+    Struct16.values[0] = i;
+    Bench::DoNotOptimize(Args16(&Struct16));
+  });
+
+  fex_thunk_bench_args64 Struct64 {};
+  Bench::Run("thunk_args64", 2'000'000, [&](uint64_t i) {
+    Struct64.values[0] = i;
+    Bench::DoNotOptimize(Args64(&Struct64));
+  });
+
+  fex_thunk_bench_args256 Struct256 {};
+  Bench::Run("thunk_args256", 1'000'000, [&](uint64_t i) {
+    Struct256.values[0] = i;
+    Bench::DoNotOptimize(Args256(&Struct256));
+  });
+
+  // One thunk call per iteration, then only host -> guest callbacks
+  constexpr uint32_t CallbacksPerCall = 1000;
+  uint64_t Calls{};
+  const uint64_t CallbackIterations = Bench::Scale(1'000);
+  Invoke(Callback, &Calls, CallbacksPerCall);
+  const uint64_t CallbackBegin = Bench::Now();
+  for (uint64_t i = 0; i < CallbackIterations; ++i) {
+    Invoke(Callback, &Calls, CallbacksPerCall);
+  }
+  Bench::Report("thunk_callback", CallbackIterations * CallbacksPerCall, Bench::Now() - CallbackBegin);
+  Bench::DoNotOptimize(Calls);
+
+  // Deferred until the batch is full or the next unbatched call, which is part of the measurement
+  Bench::Run("thunk_batched", 2'000'000, [&](uint64_t i) {
+    Batched(i);
+  });
+  Bench::DoNotOptimize(BatchedResult());
+
+  dlclose(Handle);
+  return 0;
+}
@@ -0,0 +1,31 @@
+// x87 math, both compiler generated long double code and transcendental instructions
+#include "Benchmark.h"
+
+static long double Fsin(long double Value) {
+  asm("fsin" : "+t"(Value));
+  return Value;
+}
+
+static long double Fsqrt(long double Value) {
+  asm("fsqrt" : "+t"(Value));
+  return Value;
+}
+
+int main() {
+  Bench::Run("x87_arith", 20'000'000, [](uint64_t i) {
+    long double Value = static_cast<long double>(i);
+    Value = Value * 1.000001L + 0.5L;
+    Value = Value / 3.0L - Value * 0.25L;
+    Bench::DoNotOptimize(Value);
+  });
+
+  Bench::Run("x87_fsin", 5'000'000, [](uint64_t i) {
+    Bench::DoNotOptimize(Fsin(static_cast<long double>(i & 0xFFFF) * 0.001L));
+  });
+
+  Bench::Run("x87_fsqrt", 10'000'000, [](uint64_t i) {
+    Bench::DoNotOptimize(Fsqrt(static_cast<long double>(i)));
+  });
+
+  return 0;
+}
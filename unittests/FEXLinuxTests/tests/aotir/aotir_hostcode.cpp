@@ -0,0 +1,60 @@
+/*
+  Runs under Scripts/aotir_test_runner.py, once capturing an AOTIR cache with host code and once loading it.
+  The binary isn't position independent, so it's mapped at the same guest base in both runs and the host code is used.
+*/
+
+#include <cstdint>
+#include <cstring>
+
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include <catch2/catch.hpp>
+
+// mov eax, imm32; ret on a page of its own, so it can be patched without touching the rest of the text
+__asm__(R"(
+.pushsection .text.aotir_patch, "ax", @progbits
+.p2align 12
+.globl AOTIRPatchable
+AOTIRPatchable:
+  .byte 0xB8
+.globl AOTIRPatchableImm
+AOTIRPatchableImm:
+  .long 0x11223344
+  ret
+.p2align 12
+.popsection
+)");
+
+extern "C" uint32_t AOTIRPatchable();
+extern "C" char AOTIRPatchableImm[];
+
+__attribute__((noinline)) static uint32_t FNV1a(uint32_t Count) {
+  uint32_t Hash = 0x811C9DC5;
+  for (uint32_t i = 0; i < Count; ++i) {
+    Hash ^= (i * 7) & 0xFF;
+    Hash *= 0x01000193;
+  }
+  return Hash;
+}
+
+TEST_CASE("AOTIR: host code") {
+  CHECK(FNV1a(4096) == 0xC0944DC5);
+  CHECK(AOTIRPatchable() == 0x11223344);
+}
+
+TEST_CASE("AOTIR: host code after SMC") {
+  REQUIRE(AOTIRPatchable() == 0x11223344);
+
+  // The block was loaded from the cache, patching the file backed text has to invalidate it like a JIT compiled block
+  const auto PageSize = sysconf(_SC_PAGESIZE);
+  auto Page = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(&AOTIRPatchable) & ~(PageSize - 1));
+  REQUIRE(mprotect(Page, PageSize, PROT_READ | PROT_WRITE | PROT_EXEC) == 0);
+
+  const uint32_t NewImm = 0x55667788;
+  memcpy(AOTIRPatchableImm, &NewImm, sizeof(NewImm));
+  CHECK(AOTIRPatchable() == 0x55667788);
+
+  REQUIRE(mprotect(Page, PageSize, PROT_READ | PROT_EXEC) == 0);
+  CHECK(AOTIRPatchable() == 0x55667788);
+}
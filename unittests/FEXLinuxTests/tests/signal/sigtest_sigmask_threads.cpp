@@ -0,0 +1,126 @@
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+// FEX only emulates the signal mask until a syscall or a masked signal makes the host follow it.
+// These check that a masked signal neither gets stuck on the thread that masks it nor interrupts its syscalls.
+
+static std::atomic<pid_t> HandledTID{};
+
+static void Handler(int, siginfo_t *, void *) {
+  HandledTID = ::syscall(SYS_gettid);
+}
+
+static void InstallHandler() {
+  struct sigaction act{};
+  act.sa_flags = SA_SIGINFO;
+  act.sa_sigaction = &Handler;
+  REQUIRE(sigaction(SIGUSR1, &act, nullptr) == 0);
+  HandledTID = 0;
+}
+
+static void MaskSIGUSR1(int how) {
+  sigset_t Set;
+  sigemptyset(&Set);
+  sigaddset(&Set, SIGUSR1);
+  REQUIRE(pthread_sigmask(how, &Set, nullptr) == 0);
+}
+
+static std::atomic<bool> MainMasked{};
+static std::atomic<pid_t> WorkerTID{};
+
+static void *ProcessSignalWorker(void *) {
+  WorkerTID = ::syscall(SYS_gettid);
+
+  // Wait without syscalls so the main thread's host mask hasn't caught up yet
+  while (!MainMasked) {
+  }
+
+  kill(getpid(), SIGUSR1);
+
+  // The main thread masks it, so this thread has to be the one that takes it
+  while (HandledTID == 0) {
+    timespec Wait{0, 1000 * 1000};
+    nanosleep(&Wait, nullptr);
+  }
+  return nullptr;
+}
+
+TEST_CASE("Signals: process directed signal skips a thread that masks it") {
+  InstallHandler();
+  MainMasked = false;
+
+  pthread_t Worker;
+  REQUIRE(pthread_create(&Worker, nullptr, ProcessSignalWorker, nullptr) == 0);
+
+  MaskSIGUSR1(SIG_BLOCK);
+  MainMasked = true;
+
+  // No syscalls while waiting, a signal arriving here must be passed on to the worker rather than held
+  while (HandledTID == 0) {
+  }
+
+  REQUIRE(pthread_join(Worker, nullptr) == 0);
+  CHECK(HandledTID == WorkerTID);
+
+  MaskSIGUSR1(SIG_UNBLOCK);
+}
+
+static void *ThreadSignalWorker(void *Arg) {
+  const pid_t Target = *reinterpret_cast<pid_t*>(Arg);
+
+  // Give the main thread time to enter its blocking syscall
+  timespec Wait{0, 100 * 1000 * 1000};
+  nanosleep(&Wait, nullptr);
+  ::syscall(SYS_tgkill, getpid(), Target, SIGUSR1);
+  return nullptr;
+}
+
+TEST_CASE("Signals: masked signal doesn't interrupt nanosleep") {
+  InstallHandler();
+  pid_t Self = ::syscall(SYS_gettid);
+  MaskSIGUSR1(SIG_BLOCK);
+
+  pthread_t Worker;
+  REQUIRE(pthread_create(&Worker, nullptr, ThreadSignalWorker, &Self) == 0);
+
+  timespec Sleep{0, 500 * 1000 * 1000};
+  CHECK(nanosleep(&Sleep, nullptr) == 0);
+  REQUIRE(pthread_join(Worker, nullptr) == 0);
+
+  sigset_t Pending;
+  REQUIRE(sigpending(&Pending) == 0);
+  CHECK(sigismember(&Pending, SIGUSR1));
+  CHECK(HandledTID == 0);
+
+  // Delivered once unmasked
+  MaskSIGUSR1(SIG_UNBLOCK);
+  CHECK(HandledTID == Self);
+}
+
+TEST_CASE("Signals: masked signal doesn't interrupt epoll_wait") {
+  InstallHandler();
+  pid_t Self = ::syscall(SYS_gettid);
+  int EpollFD = epoll_create1(EPOLL_CLOEXEC);
+  REQUIRE(EpollFD != -1);
+  MaskSIGUSR1(SIG_BLOCK);
+
+  pthread_t Worker;
+  REQUIRE(pthread_create(&Worker, nullptr, ThreadSignalWorker, &Self) == 0);
+
+  epoll_event Event{};
+  CHECK(epoll_wait(EpollFD, &Event, 1, 500) == 0);
+  REQUIRE(pthread_join(Worker, nullptr) == 0);
+  CHECK(HandledTID == 0);
+
+  MaskSIGUSR1(SIG_UNBLOCK);
+  CHECK(HandledTID == Self);
+  close(EpollFD);
+}
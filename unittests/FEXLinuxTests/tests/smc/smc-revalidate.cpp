@@ -0,0 +1,131 @@
+/*
+  tests for W^X toggles of code pages, with SMCRevalidateBlocks the blocks come back without being recompiled
+  when the code is unchanged. The code has to be rechecked every time, whether or not it changed.
+*/
+
+#include <cstdint>
+#include <cstring>
+
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include <catch2/catch.hpp>
+
+namespace {
+  constexpr size_t PageSize = 4096;
+
+  // mov eax, imm32; ret at Offset, returns the pointer to the immediate
+  char *WriteFunction(char *Code, size_t Offset, uint32_t Imm) {
+    Code[Offset] = 0xB8;
+    memcpy(&Code[Offset + 1], &Imm, sizeof(Imm));
+    Code[Offset + 5] = 0xC3;
+    return &Code[Offset + 1];
+  }
+
+  void SetImm(char *ImmPtr, uint32_t Imm) {
+    memcpy(ImmPtr, &Imm, sizeof(Imm));
+  }
+
+  using FnType = uint32_t (*)();
+}
+
+TEST_CASE("SMC: W^X toggle") {
+  auto Code = (char *)mmap(0, PageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, 0, 0);
+  REQUIRE(Code != MAP_FAILED);
+  auto Imm = WriteFunction(Code, 0, 0x11111111);
+  auto fn = (FnType)Code;
+
+  REQUIRE(mprotect(Code, PageSize, PROT_READ | PROT_EXEC) == 0);
+  CHECK(fn() == 0x11111111);
+
+  // Unchanged
+  for (int i = 0; i < 4; ++i) {
+    REQUIRE(mprotect(Code, PageSize, PROT_READ | PROT_WRITE) == 0);
+    REQUIRE(mprotect(Code, PageSize, PROT_READ | PROT_EXEC) == 0);
+    CHECK(fn() == 0x11111111);
+  }
+
+  // Same bytes written back
+  REQUIRE(mprotect(Code, PageSize, PROT_READ | PROT_WRITE) == 0);
+  SetImm(Imm, 0x11111111);
+  REQUIRE(mprotect(Code, PageSize, PROT_READ | PROT_EXEC) == 0);
+  CHECK(fn() == 0x11111111);
+
+  // Changed
+  REQUIRE(mprotect(Code, PageSize, PROT_READ | PROT_WRITE) == 0);
+  SetImm(Imm, 0x22222222);
+  REQUIRE(mprotect(Code, PageSize, PROT_READ | PROT_EXEC) == 0);
+  CHECK(fn() == 0x22222222);
+
+  // Changed and changed back while writable, the first block is the right one again
+  REQUIRE(mprotect(Code, PageSize, PROT_READ | PROT_WRITE) == 0);
+  SetImm(Imm, 0x33333333);
+  SetImm(Imm, 0x22222222);
+  REQUIRE(mprotect(Code, PageSize, PROT_READ | PROT_EXEC) == 0);
+  CHECK(fn() == 0x22222222);
+
+  munmap(Code, PageSize);
+}
+
+TEST_CASE("SMC: Write fault") {
+  auto Code = (char *)mmap(0, PageSize, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANON, 0, 0);
+  REQUIRE(Code != MAP_FAILED);
+  auto Imm = WriteFunction(Code, 0, 0x44444444);
+  auto fn = (FnType)Code;
+  CHECK(fn() == 0x44444444);
+
+  // A write to another part of the page
+  Code[PageSize - 1] = 0xCC;
+  CHECK(fn() == 0x44444444);
+
+  // A write of the bytes already there
+  SetImm(Imm, 0x44444444);
+  CHECK(fn() == 0x44444444);
+
+  SetImm(Imm, 0x55555555);
+  CHECK(fn() == 0x55555555);
+
+  munmap(Code, PageSize);
+}
+
+TEST_CASE("SMC: W^X toggle of the second page of a block") {
+  auto Code = (char *)mmap(0, PageSize * 2, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, 0, 0);
+  REQUIRE(Code != MAP_FAILED);
+
+  // The immediate crosses in to the second page
+  auto Imm = WriteFunction(Code, PageSize - 3, 0x66666666);
+  auto fn = (FnType)&Code[PageSize - 3];
+  REQUIRE(mprotect(Code, PageSize * 2, PROT_READ | PROT_EXEC) == 0);
+  CHECK(fn() == 0x66666666);
+
+  // Unchanged
+  REQUIRE(mprotect(Code + PageSize, PageSize, PROT_READ | PROT_WRITE) == 0);
+  REQUIRE(mprotect(Code + PageSize, PageSize, PROT_READ | PROT_EXEC) == 0);
+  CHECK(fn() == 0x66666666);
+
+  // Only the bytes on the second page change
+  REQUIRE(mprotect(Code + PageSize, PageSize, PROT_READ | PROT_WRITE) == 0);
+  Imm[3] = 0x77;
+  REQUIRE(mprotect(Code + PageSize, PageSize, PROT_READ | PROT_EXEC) == 0);
+  CHECK(fn() == 0x77666666);
+
+  munmap(Code, PageSize * 2);
+}
+
+TEST_CASE("SMC: Remapped after a W^X toggle") {
+  auto Code = (char *)mmap(0, PageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, 0, 0);
+  REQUIRE(Code != MAP_FAILED);
+  WriteFunction(Code, 0, 0x88888888);
+  auto fn = (FnType)Code;
+  REQUIRE(mprotect(Code, PageSize, PROT_READ | PROT_EXEC) == 0);
+  CHECK(fn() == 0x88888888);
+
+  // The block is suspect after this, the new mapping at the same address has different code
+  REQUIRE(mprotect(Code, PageSize, PROT_READ | PROT_WRITE) == 0);
+  REQUIRE(mmap(Code, PageSize, PROT_READ | PROT_WRITE, MAP_FIXED | MAP_PRIVATE | MAP_ANON, 0, 0) == Code);
+  WriteFunction(Code, 0, 0x99999999);
+  REQUIRE(mprotect(Code, PageSize, PROT_READ | PROT_EXEC) == 0);
+  CHECK(fn() == 0x99999999);
+
+  munmap(Code, PageSize);
+}
@@ -0,0 +1,39 @@
+#include <cerrno>
+#include <cstdint>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <catch2/catch.hpp>
+
+// The time syscalls go through the host vDSO where possible.
+// A bad pointer given to the syscall instruction still needs to return EFAULT rather than crashing.
+static void *GetInaccessiblePage() {
+  static void *Page = ::mmap(nullptr, 4096, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  REQUIRE(Page != MAP_FAILED);
+  return Page;
+}
+
+TEST_CASE("time") {
+  REQUIRE(::syscall(SYS_time, nullptr) > 0);
+
+  errno = 0;
+  CHECK(::syscall(SYS_time, GetInaccessiblePage()) == -1);
+  CHECK(errno == EFAULT);
+}
+
+TEST_CASE("gettimeofday") {
+  struct timeval tv{};
+  REQUIRE(::syscall(SYS_gettimeofday, &tv, nullptr) == 0);
+  CHECK(tv.tv_sec > 0);
+
+  errno = 0;
+  CHECK(::syscall(SYS_gettimeofday, GetInaccessiblePage(), nullptr) == -1);
+  CHECK(errno == EFAULT);
+
+  errno = 0;
+  CHECK(::syscall(SYS_gettimeofday, &tv, GetInaccessiblePage()) == -1);
+  CHECK(errno == EFAULT);
+}
@@ -218,6 +218,8 @@ static void run_tool(clang::tooling::ToolAction& action, std::string_view code,
     const char* common_header_code = R"(namespace fexgen {
 struct returns_guest_pointer {};
 struct custom_host_impl {};
+struct batchable {};
+struct returns_host_allocation {};
 struct callback_annotation_base { bool prevent_multiple; };
 struct callback_stub : callback_annotation_base {};
 struct callback_guest : callback_annotation_base {};
@@ -284,7 +286,11 @@ SourceWithAST Fixture::run_thunkgen_guest(std::string_view prelude, std::string_
         "template<typename Target>\n"
         "Target *MakeHostTrampolineForGuestFunction(uint8_t HostPacker[32], void (*)(uintptr_t, void*), Target*);\n"
         "template<typename Target>\n"
-        "Target *AllocateHostTrampolineForGuestFunction(Target*);\n";
+        "Target *AllocateHostTrampolineForGuestFunction(Target*);\n"
+        "bool QueueBatchedCall(int (*)(void*), uint32_t, const void*, uint32_t);\n"
+        "void FlushBatchedCalls();\n"
+        "template<typename T>\n"
+        "T *AdoptHostAllocation(T*);\n";
     const auto& filename = output_filenames.guest;
     {
         std::ifstream file(filename);
@@ -333,6 +339,7 @@ SourceWithAST Fixture::run_thunkgen_host(std::string_view prelude, std::string_v
         "template<typename F>\n"
         "void FinalizeHostTrampolineForGuestFunction(F*);\n"
         "struct ExportEntry { uint8_t* sha256; void(*fn)(void *); };\n"
+        "void UnpackBatchedCalls(uint8_t*, uint32_t, void (*const *)(void*));\n"
         "void *dlsym_default(void* handle, const char* symbol);\n";
 
     auto& filename = output_filenames.host;
@@ -581,3 +588,83 @@ TEST_CASE_METHOD(Fixture, "VariadicFunctionsWithoutAnnotation") {
         "template<auto> struct fex_gen_config {};\n"
         "template<> struct fex_gen_config<func> {};\n", true));
 }
+
+TEST_CASE_METHOD(Fixture, "BatchableFunction") {
+    const auto output = run_thunkgen("",
+        "#include <thunks_common.h>\n"
+        "void func(int, float);\n"
+        "int func2();\n"
+        "template<auto> struct fex_gen_config {};\n"
+        "template<> struct fex_gen_config<func> : fexgen::batchable {};\n"
+        "template<> struct fex_gen_config<func2> {};\n");
+
+    // Batchable calls get queued, other calls flush the queue first
+    CHECK_THAT(output.guest,
+        matches(functionDecl(
+            hasName("fexfn_pack_func"),
+            hasDescendant(callExpr(callee(functionDecl(hasName("QueueBatchedCall")))))
+        )));
+
+    CHECK_THAT(output.guest,
+        matches(functionDecl(
+            hasName("fexfn_pack_func2"),
+            hasDescendant(callExpr(callee(functionDecl(hasName("FlushBatchedCalls")))))
+        )));
+
+    // Host exports an extra entry point for running the queue
+    CHECK_THAT(output.host,
+        matches(varDecl(
+            hasName("exports"),
+            hasType(constantArrayType(hasElementType(asString("struct ExportEntry")), hasSize(4)))
+            )));
+
+    CHECK_THAT(output.host,
+        matches(functionDecl(
+            hasName("fexfn_unpack_libtest_fexfn_batch_flush"),
+            hasDescendant(callExpr(callee(functionDecl(hasName("UnpackBatchedCalls")))))
+        )));
+}
+
+// Host allocations are handed over to the guest heap before returning
+TEST_CASE_METHOD(Fixture, "ReturnsHostAllocation") {
+    const auto output = run_thunkgen_guest("char* func();\n",
+        "#include <thunks_common.h>\n"
+        "template<auto> struct fex_gen_config {};\n"
+        "template<> struct fex_gen_config<func> : fexgen::returns_host_allocation {};\n");
+
+    CHECK_THAT(output,
+        matches(functionDecl(
+            hasName("fexfn_pack_func"),
+            hasDescendant(callExpr(callee(functionDecl(hasName("AdoptHostAllocation")))))
+        )));
+
+    REQUIRE_THROWS(run_thunkgen_guest("int func();\n",
+        "#include <thunks_common.h>\n"
+        "template<auto> struct fex_gen_config {};\n"
+        "template<> struct fex_gen_config<func> : fexgen::returns_host_allocation {};\n", true));
+}
+
+// Batched calls run after the guest continued, so they can't have results or refer to guest memory
+TEST_CASE_METHOD(Fixture, "BatchableFunctionRestrictions") {
+    REQUIRE_THROWS(run_thunkgen_guest("void func(int*);\n",
+        "#include <thunks_common.h>\n"
+        "template<auto> struct fex_gen_config {};\n"
+        "template<> struct fex_gen_config<func> : fexgen::batchable {};\n", true));
+
+    REQUIRE_THROWS(run_thunkgen_guest("int func(int);\n",
+        "#include <thunks_common.h>\n"
+        "template<auto> struct fex_gen_config {};\n"
+        "template<> struct fex_gen_config<func> : fexgen::batchable {};\n", true));
+
+    // Pointers to complete structs still refer to guest memory
+    REQUIRE_THROWS(run_thunkgen_guest("struct A { int a; };\nvoid func(A*);\n",
+        "#include <thunks_common.h>\n"
+        "template<auto> struct fex_gen_config {};\n"
+        "template<> struct fex_gen_config<func> : fexgen::batchable {};\n", true));
+
+    // Opaque handles are allowed
+    REQUIRE_NOTHROW(run_thunkgen_guest("struct Handle_T;\ntypedef Handle_T* Handle;\nvoid func(Handle, int);\n",
+        "#include <thunks_common.h>\n"
+        "template<auto> struct fex_gen_config {};\n"
+        "template<> struct fex_gen_config<func> : fexgen::batchable {};\n"));
+}